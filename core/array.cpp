@@ -30,6 +30,7 @@
 
 #include "array.h"
 
+#include "core/class_db.h"
 #include "core/hashfuncs.h"
 #include "core/object.h"
 #include "core/variant.h"
@@ -39,6 +40,45 @@ class ArrayPrivate {
 public:
 	SafeRefCount refcount;
 	Vector<Variant> array;
+
+	// Element type of a typed array, NIL when any value is accepted.
+	Variant::Type typed_builtin;
+	StringName typed_class_name;
+
+	_FORCE_INLINE_ bool validate(const Variant &p_value) const {
+
+		if (typed_builtin == Variant::NIL)
+			return true;
+
+		Variant::Type type = p_value.get_type();
+		if (type != typed_builtin) {
+			return (typed_builtin == Variant::REAL && type == Variant::INT) || (typed_builtin == Variant::OBJECT && type == Variant::NIL);
+		}
+		if (type == Variant::OBJECT && typed_class_name != StringName()) {
+			Object *obj = p_value;
+			return !obj || ClassDB::is_parent_class(obj->get_class_name(), typed_class_name);
+		}
+		return true;
+	}
+
+	_FORCE_INLINE_ Variant coerce(const Variant &p_value) const {
+
+		if (typed_builtin == Variant::REAL && p_value.get_type() == Variant::INT)
+			return p_value.operator double();
+		return p_value;
+	}
+
+	String get_type_name() const {
+
+		if (typed_builtin == Variant::NIL)
+			return "Array";
+		if (typed_class_name != StringName())
+			return "Array[" + String(typed_class_name) + "]";
+		return "Array[" + Variant::get_type_name(typed_builtin) + "]";
+	}
+
+	ArrayPrivate() :
+			typed_builtin(Variant::NIL) {}
 };
 
 void Array::_ref(const Array &p_from) const {
@@ -59,6 +99,15 @@ void Array::_ref(const Array &p_from) const {
 	_p = p_from._p;
 }
 
+bool Array::_typed_check(const Variant &p_value) const {
+
+	if (_p->validate(p_value))
+		return true;
+
+	ERR_EXPLAIN("Can't store a value of type '" + Variant::get_type_name(p_value.get_type()) + "' in an array of type '" + _p->get_type_name() + "'.");
+	ERR_FAIL_V(false);
+}
+
 void Array::_unref() const {
 
 	if (!_p)
@@ -114,17 +163,35 @@ void Array::operator=(const Array &p_array) {
 }
 void Array::push_back(const Variant &p_value) {
 
-	_p->array.push_back(p_value);
+	if (_p->typed_builtin == Variant::NIL) {
+		_p->array.push_back(p_value);
+	} else if (_typed_check(p_value)) {
+		_p->array.push_back(_p->coerce(p_value));
+	}
 }
 
 Error Array::resize(int p_new_size) {
 
-	return _p->array.resize(p_new_size);
+	int old_size = _p->array.size();
+	Error err = _p->array.resize(p_new_size);
+
+	if (err == OK && _p->typed_builtin != Variant::NIL && _p->typed_builtin != Variant::OBJECT) {
+		// Typed arrays grow with default values rather than nulls.
+		Variant::CallError ce;
+		for (int i = old_size; i < p_new_size; i++) {
+			_p->array.write[i] = Variant::construct(_p->typed_builtin, NULL, 0, ce);
+		}
+	}
+	return err;
 }
 
 void Array::insert(int p_pos, const Variant &p_value) {
 
-	_p->array.insert(p_pos, p_value);
+	if (_p->typed_builtin == Variant::NIL) {
+		_p->array.insert(p_pos, p_value);
+	} else if (_typed_check(p_value)) {
+		_p->array.insert(p_pos, _p->coerce(p_value));
+	}
 }
 
 void Array::erase(const Variant &p_value) {
@@ -203,7 +270,11 @@ void Array::remove(int p_pos) {
 
 void Array::set(int p_idx, const Variant &p_value) {
 
-	operator[](p_idx) = p_value;
+	if (_p->typed_builtin == Variant::NIL) {
+		operator[](p_idx) = p_value;
+	} else if (_typed_check(p_value)) {
+		operator[](p_idx) = _p->coerce(p_value);
+	}
 }
 
 const Variant &Array::get(int p_idx) const {
@@ -214,6 +285,8 @@ const Variant &Array::get(int p_idx) const {
 Array Array::duplicate(bool p_deep) const {
 
 	Array new_arr;
+	new_arr._p->typed_builtin = _p->typed_builtin;
+	new_arr._p->typed_class_name = _p->typed_class_name;
 	int element_count = size();
 	new_arr.resize(element_count);
 	for (int i = 0; i < element_count; i++) {
@@ -331,7 +404,7 @@ Array &Array::invert() {
 
 void Array::push_front(const Variant &p_value) {
 
-	_p->array.insert(0, p_value);
+	insert(0, p_value);
 }
 
 Variant Array::pop_back() {
@@ -401,6 +474,74 @@ Variant Array::max() const {
 	return maxval;
 }
 
+void Array::set_typed(uint32_t p_type, const StringName &p_class_name) {
+
+	ERR_EXPLAIN("Type can only be set on empty arrays.");
+	ERR_FAIL_COND(_p->array.size() > 0);
+	ERR_EXPLAIN("Type can only be set on arrays that aren't shared.");
+	ERR_FAIL_COND(_p->refcount.get() > 1);
+	ERR_FAIL_INDEX(p_type, Variant::VARIANT_MAX);
+	ERR_FAIL_COND(p_class_name != StringName() && p_type != Variant::OBJECT);
+
+	_p->typed_builtin = Variant::Type(p_type);
+	_p->typed_class_name = p_class_name;
+}
+
+bool Array::typed_assign(const Array &p_from) {
+
+	if (_p->typed_builtin == Variant::NIL || is_same_typed(p_from)) {
+		_ref(p_from);
+		return true;
+	}
+
+	// Otherwise refer to a new array holding the values converted to our type,
+	// leaving this one untouched if any of them doesn't fit.
+	ArrayPrivate *p = memnew(ArrayPrivate);
+	p->refcount.init();
+	p->typed_builtin = _p->typed_builtin;
+	p->typed_class_name = _p->typed_class_name;
+
+	const Vector<Variant> &from = p_from._p->array;
+	p->array.resize(from.size());
+	Variant *dst = p->array.ptrw();
+	for (int i = 0; i < from.size(); i++) {
+		if (!p->validate(from[i])) {
+			memdelete(p);
+			return false;
+		}
+		dst[i] = p->coerce(from[i]);
+	}
+
+	_unref();
+	_p = p;
+	return true;
+}
+
+bool Array::is_typed() const {
+
+	return _p->typed_builtin != Variant::NIL;
+}
+
+bool Array::is_same_typed(const Array &p_other) const {
+
+	return _p->typed_builtin == p_other._p->typed_builtin && _p->typed_class_name == p_other._p->typed_class_name;
+}
+
+bool Array::can_hold(const Variant &p_value) const {
+
+	return _p->validate(p_value);
+}
+
+uint32_t Array::get_typed_builtin() const {
+
+	return _p->typed_builtin;
+}
+
+StringName Array::get_typed_class_name() const {
+
+	return _p->typed_class_name;
+}
+
 Array::Array(const Array &p_from) {
 
 	_p = NULL;
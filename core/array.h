@@ -43,6 +43,7 @@ class Array {
 	mutable ArrayPrivate *_p;
 	void _ref(const Array &p_from) const;
 	void _unref() const;
+	bool _typed_check(const Variant &p_value) const;
 
 public:
 	Variant &operator[](int p_idx);
@@ -94,6 +95,16 @@ public:
 	Variant min() const;
 	Variant max() const;
 
+	// Typed arrays only hold values of one type (ints are stored as floats in
+	// float arrays). Values written through operator[] are not checked.
+	void set_typed(uint32_t p_type, const StringName &p_class_name);
+	bool typed_assign(const Array &p_from);
+	bool is_typed() const;
+	bool is_same_typed(const Array &p_other) const;
+	bool can_hold(const Variant &p_value) const;
+	uint32_t get_typed_builtin() const;
+	StringName get_typed_class_name() const;
+
 	Array(const Array &p_from);
 	Array();
 	~Array();
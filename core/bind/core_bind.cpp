@@ -81,6 +81,32 @@ RES _ResourceLoader::load(const String &p_path, const String &p_type_hint, bool
 	return ret;
 }
 
+Error _ResourceLoader::load_threaded_request(const String &p_path, const String &p_type_hint) {
+
+	return ResourceLoader::load_threaded_request(p_path, p_type_hint);
+}
+
+_ResourceLoader::ThreadLoadStatus _ResourceLoader::load_threaded_get_status(const String &p_path, Array r_progress) {
+
+	float progress = 0;
+	ThreadLoadStatus status = (ThreadLoadStatus)ResourceLoader::load_threaded_get_status(p_path, &progress);
+	r_progress.resize(1);
+	r_progress[0] = progress;
+	return status;
+}
+
+RES _ResourceLoader::load_threaded_get(const String &p_path) {
+
+	Error err = OK;
+	RES ret = ResourceLoader::load_threaded_get(p_path, &err);
+
+	if (err != OK) {
+		ERR_EXPLAIN("Error loading resource: '" + p_path + "'");
+		ERR_FAIL_COND_V(err != OK, ret);
+	}
+	return ret;
+}
+
 PoolVector<String> _ResourceLoader::get_recognized_extensions_for_type(const String &p_type) {
 
 	List<String> exts;
@@ -133,6 +159,9 @@ void _ResourceLoader::_bind_methods() {
 
 	ClassDB::bind_method(D_METHOD("load_interactive", "path", "type_hint"), &_ResourceLoader::load_interactive, DEFVAL(""));
 	ClassDB::bind_method(D_METHOD("load", "path", "type_hint", "no_cache"), &_ResourceLoader::load, DEFVAL(""), DEFVAL(false));
+	ClassDB::bind_method(D_METHOD("load_threaded_request", "path", "type_hint"), &_ResourceLoader::load_threaded_request, DEFVAL(""));
+	ClassDB::bind_method(D_METHOD("load_threaded_get_status", "path", "progress"), &_ResourceLoader::load_threaded_get_status, DEFVAL(Array()));
+	ClassDB::bind_method(D_METHOD("load_threaded_get", "path"), &_ResourceLoader::load_threaded_get);
 	ClassDB::bind_method(D_METHOD("get_recognized_extensions_for_type", "type"), &_ResourceLoader::get_recognized_extensions_for_type);
 	ClassDB::bind_method(D_METHOD("set_abort_on_missing_resources", "abort"), &_ResourceLoader::set_abort_on_missing_resources);
 	ClassDB::bind_method(D_METHOD("get_dependencies", "path"), &_ResourceLoader::get_dependencies);
@@ -141,6 +170,11 @@ void _ResourceLoader::_bind_methods() {
 #ifndef DISABLE_DEPRECATED
 	ClassDB::bind_method(D_METHOD("has", "path"), &_ResourceLoader::has);
 #endif // DISABLE_DEPRECATED
+
+	BIND_ENUM_CONSTANT(THREAD_LOAD_INVALID_RESOURCE);
+	BIND_ENUM_CONSTANT(THREAD_LOAD_IN_PROGRESS);
+	BIND_ENUM_CONSTANT(THREAD_LOAD_FAILED);
+	BIND_ENUM_CONSTANT(THREAD_LOAD_LOADED);
 }
 
 _ResourceLoader::_ResourceLoader() {
@@ -1496,6 +1530,17 @@ Vector<int> _Geometry::triangulate_polygon(const Vector<Vector2> &p_polygon) {
 	return Geometry::triangulate_polygon(p_polygon);
 }
 
+Vector<int> _Geometry::triangulate_polygon_with_holes(const Vector<Vector2> &p_polygon, const Array &p_holes) {
+
+	Vector<Vector<Vector2> > holes;
+	holes.resize(p_holes.size());
+	for (int i = 0; i < p_holes.size(); i++) {
+		holes.write[i] = p_holes[i];
+	}
+
+	return Geometry::triangulate_polygon_with_holes(p_polygon, holes);
+}
+
 Vector<Point2> _Geometry::convex_hull_2d(const Vector<Point2> &p_points) {
 
 	return Geometry::convex_hull_2d(p_points);
@@ -1567,6 +1612,7 @@ void _Geometry::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("point_is_inside_triangle", "point", "a", "b", "c"), &_Geometry::point_is_inside_triangle);
 
 	ClassDB::bind_method(D_METHOD("triangulate_polygon", "polygon"), &_Geometry::triangulate_polygon);
+	ClassDB::bind_method(D_METHOD("triangulate_polygon_with_holes", "polygon", "holes"), &_Geometry::triangulate_polygon_with_holes);
 	ClassDB::bind_method(D_METHOD("convex_hull_2d", "points"), &_Geometry::convex_hull_2d);
 	ClassDB::bind_method(D_METHOD("clip_polygon", "points", "plane"), &_Geometry::clip_polygon);
 
@@ -2945,6 +2991,7 @@ Variant JSONParseResult::get_result() const {
 void _JSON::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("print", "value", "indent", "sort_keys"), &_JSON::print, DEFVAL(String()), DEFVAL(false));
 	ClassDB::bind_method(D_METHOD("parse", "json"), &_JSON::parse);
+	ClassDB::bind_method(D_METHOD("parse_utf8", "json"), &_JSON::parse_utf8);
 }
 
 String _JSON::print(const Variant &p_value, const String &p_indent, bool p_sort_keys) {
@@ -2960,6 +3007,16 @@ Ref<JSONParseResult> _JSON::parse(const String &p_json) {
 	return result;
 }
 
+Ref<JSONParseResult> _JSON::parse_utf8(const PoolVector<uint8_t> &p_json) {
+	Ref<JSONParseResult> result;
+	result.instance();
+
+	PoolVector<uint8_t>::Read r = p_json.read();
+	result->error = JSON::parse_utf8(r.ptr(), p_json.size(), result->result, result->error_string, result->error_line);
+
+	return result;
+}
+
 _JSON *_JSON::singleton = NULL;
 
 _JSON::_JSON() {
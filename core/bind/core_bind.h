@@ -49,9 +49,19 @@ protected:
 	static _ResourceLoader *singleton;
 
 public:
+	enum ThreadLoadStatus {
+		THREAD_LOAD_INVALID_RESOURCE,
+		THREAD_LOAD_IN_PROGRESS,
+		THREAD_LOAD_FAILED,
+		THREAD_LOAD_LOADED
+	};
+
 	static _ResourceLoader *get_singleton() { return singleton; }
 	Ref<ResourceInteractiveLoader> load_interactive(const String &p_path, const String &p_type_hint = "");
 	RES load(const String &p_path, const String &p_type_hint = "", bool p_no_cache = false);
+	Error load_threaded_request(const String &p_path, const String &p_type_hint = "");
+	ThreadLoadStatus load_threaded_get_status(const String &p_path, Array r_progress = Array());
+	RES load_threaded_get(const String &p_path);
 	PoolVector<String> get_recognized_extensions_for_type(const String &p_type);
 	void set_abort_on_missing_resources(bool p_abort);
 	PoolStringArray get_dependencies(const String &p_path);
@@ -64,6 +74,8 @@ public:
 	_ResourceLoader();
 };
 
+VARIANT_ENUM_CAST(_ResourceLoader::ThreadLoadStatus);
+
 class _ResourceSaver : public Object {
 	GDCLASS(_ResourceSaver, Object);
 
@@ -403,6 +415,7 @@ public:
 	int get_uv84_normal_bit(const Vector3 &p_vector);
 
 	Vector<int> triangulate_polygon(const Vector<Vector2> &p_polygon);
+	Vector<int> triangulate_polygon_with_holes(const Vector<Vector2> &p_polygon, const Array &p_holes);
 	Vector<Point2> convex_hull_2d(const Vector<Point2> &p_points);
 	Vector<Vector3> clip_polygon(const Vector<Vector3> &p_points, const Plane &p_plane);
 
@@ -772,6 +785,7 @@ public:
 
 	String print(const Variant &p_value, const String &p_indent = "", bool p_sort_keys = false);
 	Ref<JSONParseResult> parse(const String &p_json);
+	Ref<JSONParseResult> parse_utf8(const PoolVector<uint8_t> &p_json);
 
 	_JSON();
 };
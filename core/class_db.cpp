@@ -260,6 +260,7 @@ ClassDB::ClassInfo::ClassInfo() {
 	inherits_ptr = NULL;
 	disabled = false;
 	exposed = false;
+	class_ptr = NULL;
 }
 
 ClassDB::ClassInfo::~ClassInfo() {
@@ -326,6 +327,15 @@ StringName ClassDB::get_parent_class(const StringName &p_class) {
 	return ti->inherits;
 }
 
+void *ClassDB::get_class_ptr(const StringName &p_class) {
+
+	OBJTYPE_RLOCK;
+
+	ClassInfo *ti = classes.getptr(p_class);
+	ERR_FAIL_COND_V(!ti, NULL);
+	return ti->class_ptr;
+}
+
 ClassDB::APIType ClassDB::get_api_type(const StringName &p_class) {
 
 	OBJTYPE_RLOCK;
@@ -530,7 +540,7 @@ bool ClassDB::can_instance(const StringName &p_class) {
 	return (!ti->disabled && ti->creation_func != NULL);
 }
 
-void ClassDB::_add_class2(const StringName &p_class, const StringName &p_inherits) {
+void ClassDB::_add_class2(const StringName &p_class, const StringName &p_inherits, void *p_class_ptr) {
 
 	OBJTYPE_WLOCK;
 
@@ -543,6 +553,7 @@ void ClassDB::_add_class2(const StringName &p_class, const StringName &p_inherit
 	ti.name = name;
 	ti.inherits = p_inherits;
 	ti.api = current_api;
+	ti.class_ptr = p_class_ptr;
 
 	if (ti.inherits) {
 
@@ -1137,6 +1148,25 @@ StringName ClassDB::get_property_setter(StringName p_class, const StringName p_p
 	return StringName();
 }
 
+MethodBind *ClassDB::get_property_setter_bind(const StringName &p_class, const StringName &p_property, int *r_index) {
+
+	ClassInfo *type = classes.getptr(p_class);
+	ClassInfo *check = type;
+	while (check) {
+		const PropertySetGet *psg = check->property_setget.getptr(p_property);
+		if (psg) {
+
+			if (r_index)
+				*r_index = psg->index;
+			return psg->_setptr;
+		}
+
+		check = check->inherits_ptr;
+	}
+
+	return NULL;
+}
+
 StringName ClassDB::get_property_getter(StringName p_class, const StringName p_property) {
 
 	ClassInfo *type = classes.getptr(p_class);
@@ -77,37 +77,57 @@ CommandQueueMT::SyncSemaphore *CommandQueueMT::_alloc_sync_sem() {
 	return &sync_sems[idx];
 }
 
-bool CommandQueueMT::dealloc_one() {
-tryagain:
-	if (dealloc_ptr == write_ptr) {
-		// The queue is empty
-		return false;
+bool CommandQueueMT::_grow() {
+
+	Chunk *chunk = free_chunks;
+	if (chunk) {
+		free_chunks = chunk->next;
+	} else {
+		if (chunk_count == COMMAND_MAX_CHUNKS)
+			return false;
+
+		chunk = memnew(Chunk);
+		chunk->mem = (uint8_t *)memalloc(COMMAND_CHUNK_SIZE);
+		chunk_count++;
 	}
 
-	uint32_t size = *(uint32_t *)&command_mem[dealloc_ptr];
+	chunk->next = NULL;
+	chunk->used = 0;
+	chunk->committed = 0;
+	chunk->sealed = 0;
 
-	if (size == 0) {
-		// End of command buffer wrap down
-		dealloc_ptr = 0;
-		goto tryagain;
-	}
-
-	if (size & 1) {
-		// Still used, nothing can be deallocated
-		return false;
-	}
+	write_chunk->next = chunk;
+	// the barrier publishes next, the consumer moves on once it read everything committed
+	atomic_increment(&write_chunk->sealed);
+	write_chunk = chunk;
 
-	dealloc_ptr += (size >> 1) + 8;
 	return true;
 }
 
+void CommandQueueMT::_recycle(Chunk *p_chunk) {
+
+	lock();
+	p_chunk->next = free_chunks;
+	free_chunks = p_chunk;
+	unlock();
+}
+
 CommandQueueMT::CommandQueueMT(bool p_sync) {
 
-	read_ptr = 0;
-	write_ptr = 0;
-	dealloc_ptr = 0;
+	write_chunk = memnew(Chunk);
+	write_chunk->next = NULL;
+	write_chunk->mem = (uint8_t *)memalloc(COMMAND_CHUNK_SIZE);
+	write_chunk->used = 0;
+	write_chunk->committed = 0;
+	write_chunk->sealed = 0;
+	free_chunks = NULL;
+	chunk_count = 1;
+
+	read_chunk = write_chunk;
+	read_pos = 0;
+	sleeping = 0;
+
 	mutex = Mutex::create();
-	command_mem = (uint8_t *)memalloc(COMMAND_MEM_SIZE);
 
 	for (int i = 0; i < SYNC_SEMAPHORES; i++) {
 
@@ -129,5 +149,15 @@ CommandQueueMT::~CommandQueueMT() {
 
 		memdelete(sync_sems[i].sem);
 	}
-	memfree(command_mem);
+
+	Chunk *lists[2] = { read_chunk, free_chunks };
+	for (int i = 0; i < 2; i++) {
+		Chunk *chunk = lists[i];
+		while (chunk) {
+			Chunk *next = chunk->next;
+			memfree(chunk->mem);
+			memdelete(chunk);
+			chunk = next;
+		}
+	}
 }
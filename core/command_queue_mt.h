@@ -34,6 +34,7 @@
 #include "core/os/memory.h"
 #include "core/os/mutex.h"
 #include "core/os/semaphore.h"
+#include "core/safe_refcount.h"
 #include "core/simple_type.h"
 #include "core/typedefs.h"
 
@@ -236,8 +237,7 @@
 		cmd->instance = p_instance;                                          \
 		cmd->method = p_method;                                              \
 		SEMIC_SEP_LIST(CMD_ASSIGN_PARAM, N);                                 \
-		unlock();                                                            \
-		if (sync) sync->post();                                              \
+		_commit_and_unlock();                                                \
 	}
 
 #define CMD_RET_TYPE(N) CommandRet##N<T, M, COMMA_SEP_LIST(TYPE_ARG, N) COMMA(N) R>
@@ -252,8 +252,7 @@
 		SEMIC_SEP_LIST(CMD_ASSIGN_PARAM, N);                                                   \
 		cmd->ret = r_ret;                                                                      \
 		cmd->sync_sem = ss;                                                                    \
-		unlock();                                                                              \
-		if (sync) sync->post();                                                                \
+		_commit_and_unlock();                                                                  \
 		ss->sem->wait();                                                                       \
 		ss->in_use = false;                                                                    \
 	}
@@ -269,8 +268,7 @@
 		cmd->method = p_method;                                                       \
 		SEMIC_SEP_LIST(CMD_ASSIGN_PARAM, N);                                          \
 		cmd->sync_sem = ss;                                                           \
-		unlock();                                                                     \
-		if (sync) sync->post();                                                       \
+		_commit_and_unlock();                                                         \
 		ss->sem->wait();                                                              \
 		ss->in_use = false;                                                           \
 	}
@@ -315,72 +313,59 @@ class CommandQueueMT {
 	/***** BASE *******/
 
 	enum {
-		COMMAND_MEM_SIZE_KB = 256,
-		COMMAND_MEM_SIZE = COMMAND_MEM_SIZE_KB * 1024,
+		COMMAND_CHUNK_SIZE_KB = 64,
+		COMMAND_CHUNK_SIZE = COMMAND_CHUNK_SIZE_KB * 1024,
+		COMMAND_MAX_CHUNKS = 256, // pushing waits for the consumer past this
+		CACHE_LINE_SIZE = 64,
 		SYNC_SEMAPHORES = 8
 	};
 
-	uint8_t *command_mem;
-	uint32_t read_ptr;
-	uint32_t write_ptr;
-	uint32_t dealloc_ptr;
+	// Commands are written to a list of chunks, which grows when the consumer
+	// falls behind. Pushing is serialized by the mutex, as any thread may push,
+	// but there is a single consumer (the server thread) and it never locks
+	// except to recycle a finished chunk.
+	struct Chunk {
+
+		Chunk *next;
+		uint8_t *mem;
+		uint32_t used; // producer side
+		volatile uint32_t committed; // bytes readable by the consumer
+		volatile uint32_t sealed; // set once the producer moved to next
+	};
+
+	// producer side
+	Chunk *write_chunk;
+	Chunk *free_chunks;
+	uint32_t chunk_count;
 	SyncSemaphore sync_sems[SYNC_SEMAPHORES];
 	Mutex *mutex;
 	Semaphore *sync;
 
-	template <class T>
-	T *allocate() {
-
-		// alloc size is size+T+safeguard
-		uint32_t alloc_size = ((sizeof(T) + 8 - 1) & ~(8 - 1)) + 8;
+	uint8_t _pad[CACHE_LINE_SIZE];
 
-	tryagain:
-
-		if (write_ptr < dealloc_ptr) {
-			// behind dealloc_ptr, check that there is room
-			if ((dealloc_ptr - write_ptr) <= alloc_size) {
-
-				// There is no more room, try to deallocate something
-				if (dealloc_one()) {
-					goto tryagain;
-				}
-				return NULL;
-			}
-		} else if (write_ptr >= dealloc_ptr) {
-			// ahead of dealloc_ptr, check that there is room
+	// consumer side
+	Chunk *read_chunk;
+	uint32_t read_pos;
+	volatile uint32_t sleeping;
 
-			if ((COMMAND_MEM_SIZE - write_ptr) < alloc_size + sizeof(uint32_t)) {
-				// no room at the end, wrap down;
+	bool _grow();
+	void _recycle(Chunk *p_chunk);
 
-				if (dealloc_ptr == 0) { // don't want write_ptr to become dealloc_ptr
-
-					// There is no more room, try to deallocate something
-					if (dealloc_one()) {
-						goto tryagain;
-					}
-					return NULL;
-				}
+	template <class T>
+	T *allocate() {
 
-				// if this happens, it's a bug
-				ERR_FAIL_COND_V((COMMAND_MEM_SIZE - write_ptr) < 8, NULL);
-				// zero means, wrap to beginning
+		// header (size) + command, 8 byte aligned
+		uint32_t size = (sizeof(T) + 8 - 1) & ~(8 - 1);
 
-				uint32_t *p = (uint32_t *)&command_mem[write_ptr];
-				*p = 0;
-				write_ptr = 0;
-				goto tryagain;
-			}
+		if (write_chunk->used + size + 8 > COMMAND_CHUNK_SIZE) {
+			if (!_grow())
+				return NULL;
 		}
-		// Allocate the size and the 'in use' bit.
-		// First bit used to mark if command is still in use (1)
-		// or if it has been destroyed and can be deallocated (0).
-		uint32_t size = (sizeof(T) + 8 - 1) & ~(8 - 1);
-		uint32_t *p = (uint32_t *)&command_mem[write_ptr];
-		*p = (size << 1) | 1;
-		write_ptr += 8;
-		// allocate the command
-		T *cmd = memnew_placement(&command_mem[write_ptr], T);
-		write_ptr += size;
+
+		uint8_t *p = &write_chunk->mem[write_chunk->used];
+		*(uint32_t *)p = size;
+		T *cmd = memnew_placement(p + 8, T);
+		write_chunk->used += size + 8;
 		return cmd;
 	}
 
@@ -401,38 +386,46 @@ class CommandQueueMT {
 		return ret;
 	}
 
-	bool flush_one(bool p_lock = true) {
-		if (p_lock) lock();
+	_FORCE_INLINE_ void _commit_and_unlock() {
+
+		// the barrier makes the command visible before the consumer can see it is there
+		atomic_add(&write_chunk->committed, write_chunk->used - write_chunk->committed);
+		unlock();
+
+		// only wake the consumer when it went to sleep, instead of once per command
+		if (sync && atomic_add(&sleeping, 0))
+			sync->post();
+	}
+
+	bool flush_one() {
+
 	tryagain:
+		Chunk *chunk = read_chunk;
 
-		// tried to read an empty queue
-		if (read_ptr == write_ptr)
-			return false;
+		if (read_pos == atomic_add(&chunk->committed, 0)) {
 
-		uint32_t size_ptr = read_ptr;
-		uint32_t size = *(uint32_t *)&command_mem[read_ptr] >> 1;
+			if (!atomic_add(&chunk->sealed, 0))
+				return false; // tried to read an empty queue
+
+			// sealed after the last commit, so check again before moving on
+			if (read_pos != atomic_add(&chunk->committed, 0))
+				goto tryagain;
 
-		if (size == 0) {
-			//end of ringbuffer, wrap
-			read_ptr = 0;
+			read_chunk = chunk->next;
+			read_pos = 0;
+			_recycle(chunk);
 			goto tryagain;
 		}
 
-		read_ptr += 8;
+		uint8_t *p = &chunk->mem[read_pos];
+		uint32_t size = *(uint32_t *)p;
+		read_pos += size + 8;
 
-		CommandBase *cmd = reinterpret_cast<CommandBase *>(&command_mem[read_ptr]);
-
-		read_ptr += size;
-
-		if (p_lock) unlock();
+		CommandBase *cmd = reinterpret_cast<CommandBase *>(p + 8);
 		cmd->call();
-		if (p_lock) lock();
-
 		cmd->post();
 		cmd->~CommandBase();
-		*(uint32_t *)&command_mem[size_ptr] &= ~1;
 
-		if (p_lock) unlock();
 		return true;
 	}
 
@@ -440,7 +433,6 @@ class CommandQueueMT {
 	void unlock();
 	void wait_for_flush();
 	SyncSemaphore *_alloc_sync_sem();
-	bool dealloc_one();
 
 public:
 	/* NORMAL PUSH COMMANDS */
@@ -457,17 +449,21 @@ public:
 
 	void wait_and_flush_one() {
 		ERR_FAIL_COND(!sync);
-		sync->wait();
-		flush_one();
+
+		if (flush_one())
+			return;
+
+		atomic_increment(&sleeping);
+		if (!flush_one()) {
+			sync->wait();
+		}
+		atomic_decrement(&sleeping);
 	}
 
 	void flush_all() {
 
-		//ERR_FAIL_COND(sync);
-		lock();
-		while (flush_one(false))
+		while (flush_one())
 			;
-		unlock();
 	}
 
 	CommandQueueMT(bool p_sync);
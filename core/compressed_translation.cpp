@@ -198,6 +198,7 @@ bool PHashTranslation::_set(const StringName &p_name, const Variant &p_value) {
 	} else
 		return false;
 
+	_messages_changed();
 	return true;
 }
 
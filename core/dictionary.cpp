@@ -30,14 +30,16 @@
 
 #include "dictionary.h"
 
-#include "core/ordered_hash_map.h"
+#include "core/ordered_oa_hash_map.h"
 #include "core/safe_refcount.h"
 #include "core/variant.h"
 
+typedef OrderedOAHashMap<Variant, Variant, VariantHasher, VariantComparator> DictionaryMap;
+
 struct DictionaryPrivate {
 
 	SafeRefCount refcount;
-	OrderedHashMap<Variant, Variant, VariantHasher, VariantComparator> variant_map;
+	DictionaryMap variant_map;
 };
 
 void Dictionary::get_key_list(List<Variant> *p_keys) const {
@@ -45,19 +47,18 @@ void Dictionary::get_key_list(List<Variant> *p_keys) const {
 	if (_p->variant_map.empty())
 		return;
 
-	for (OrderedHashMap<Variant, Variant, VariantHasher, VariantComparator>::Element E = _p->variant_map.front(); E; E = E.next()) {
-		p_keys->push_back(E.key());
+	for (DictionaryMap::Iterator it = _p->variant_map.iter(); it.valid; it = _p->variant_map.next_iter(it)) {
+		p_keys->push_back(*it.key);
 	}
 }
 
 Variant Dictionary::get_key_at_index(int p_index) const {
 
-	int index = 0;
-	for (OrderedHashMap<Variant, Variant, VariantHasher, VariantComparator>::Element E = _p->variant_map.front(); E; E = E.next()) {
-		if (index == p_index) {
-			return E.key();
-		}
-		index++;
+	ERR_FAIL_COND_V(p_index < 0, Variant());
+
+	DictionaryMap::Iterator it = _p->variant_map.iter_at(p_index);
+	if (it.valid) {
+		return *it.key;
 	}
 
 	return Variant();
@@ -65,12 +66,11 @@ Variant Dictionary::get_key_at_index(int p_index) const {
 
 Variant Dictionary::get_value_at_index(int p_index) const {
 
-	int index = 0;
-	for (OrderedHashMap<Variant, Variant, VariantHasher, VariantComparator>::Element E = _p->variant_map.front(); E; E = E.next()) {
-		if (index == p_index) {
-			return E.value();
-		}
-		index++;
+	ERR_FAIL_COND_V(p_index < 0, Variant());
+
+	DictionaryMap::Iterator it = _p->variant_map.iter_at(p_index);
+	if (it.valid) {
+		return *it.value;
 	}
 
 	return Variant();
@@ -83,33 +83,26 @@ Variant &Dictionary::operator[](const Variant &p_key) {
 
 const Variant &Dictionary::operator[](const Variant &p_key) const {
 
-	return _p->variant_map[p_key];
+	return ((const DictionaryMap *)&_p->variant_map)->operator[](p_key);
 }
 const Variant *Dictionary::getptr(const Variant &p_key) const {
 
-	OrderedHashMap<Variant, Variant, VariantHasher, VariantComparator>::ConstElement E = ((const OrderedHashMap<Variant, Variant, VariantHasher, VariantComparator> *)&_p->variant_map)->find(p_key);
-
-	if (!E)
-		return NULL;
-	return &E.get();
+	return ((const DictionaryMap *)&_p->variant_map)->getptr(p_key);
 }
 
 Variant *Dictionary::getptr(const Variant &p_key) {
 
-	OrderedHashMap<Variant, Variant, VariantHasher, VariantComparator>::Element E = _p->variant_map.find(p_key);
-
-	if (!E)
-		return NULL;
-	return &E.get();
+	return _p->variant_map.getptr(p_key);
 }
 
 Variant Dictionary::get_valid(const Variant &p_key) const {
 
-	OrderedHashMap<Variant, Variant, VariantHasher, VariantComparator>::ConstElement E = ((const OrderedHashMap<Variant, Variant, VariantHasher, VariantComparator> *)&_p->variant_map)->find(p_key);
-
-	if (!E)
+	const Variant *result = getptr(p_key);
+	if (!result) {
 		return Variant();
-	return E.get();
+	}
+
+	return *result;
 }
 
 Variant Dictionary::get(const Variant &p_key, const Variant &p_default) const {
@@ -192,13 +185,10 @@ uint32_t Dictionary::hash() const {
 
 	uint32_t h = hash_djb2_one_32(Variant::DICTIONARY);
 
-	List<Variant> keys;
-	get_key_list(&keys);
+	for (DictionaryMap::Iterator it = _p->variant_map.iter(); it.valid; it = _p->variant_map.next_iter(it)) {
 
-	for (List<Variant>::Element *E = keys.front(); E; E = E->next()) {
-
-		h = hash_djb2_one_32(E->get().hash(), h);
-		h = hash_djb2_one_32(operator[](E->get()).hash(), h);
+		h = hash_djb2_one_32(it.key->hash(), h);
+		h = hash_djb2_one_32(it.value->hash(), h);
 	}
 
 	return h;
@@ -212,8 +202,8 @@ Array Dictionary::keys() const {
 		return varr;
 
 	int i = 0;
-	for (OrderedHashMap<Variant, Variant, VariantHasher, VariantComparator>::Element E = _p->variant_map.front(); E; E = E.next()) {
-		varr[i] = E.key();
+	for (DictionaryMap::Iterator it = _p->variant_map.iter(); it.valid; it = _p->variant_map.next_iter(it)) {
+		varr[i] = *it.key;
 		i++;
 	}
 
@@ -228,8 +218,8 @@ Array Dictionary::values() const {
 		return varr;
 
 	int i = 0;
-	for (OrderedHashMap<Variant, Variant, VariantHasher, VariantComparator>::Element E = _p->variant_map.front(); E; E = E.next()) {
-		varr[i] = E.get();
+	for (DictionaryMap::Iterator it = _p->variant_map.iter(); it.valid; it = _p->variant_map.next_iter(it)) {
+		varr[i] = *it.value;
 		i++;
 	}
 
@@ -240,26 +230,26 @@ const Variant *Dictionary::next(const Variant *p_key) const {
 
 	if (p_key == NULL) {
 		// caller wants to get the first element
-		if (_p->variant_map.front())
-			return &_p->variant_map.front().key();
-		return NULL;
+		DictionaryMap::Iterator it = _p->variant_map.iter();
+		return it.valid ? it.key : NULL;
 	}
-	OrderedHashMap<Variant, Variant, VariantHasher, VariantComparator>::Element E = _p->variant_map.find(*p_key);
 
-	if (E && E.next())
-		return &E.next().key();
-	return NULL;
+	DictionaryMap::Iterator it = _p->variant_map.find_iter(*p_key);
+	it = _p->variant_map.next_iter(it);
+	return it.valid ? it.key : NULL;
 }
 
 Dictionary Dictionary::duplicate(bool p_deep) const {
 
 	Dictionary n;
 
-	List<Variant> keys;
-	get_key_list(&keys);
+	// Copies the entries in one go, reusing their stored hashes.
+	n._p->variant_map = _p->variant_map;
 
-	for (List<Variant>::Element *E = keys.front(); E; E = E->next()) {
-		n[E->get()] = p_deep ? operator[](E->get()).duplicate(p_deep) : operator[](E->get());
+	if (p_deep) {
+		for (DictionaryMap::Iterator it = n._p->variant_map.iter(); it.valid; it = n._p->variant_map.next_iter(it)) {
+			*it.value = it.value->duplicate(true);
+		}
 	}
 
 	return n;
@@ -0,0 +1,153 @@
+/*************************************************************************/
+/*  flat_map.h                                                           */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2019 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2019 Godot Engine contributors (cf. AUTHORS.md)    */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#ifndef FLAT_MAP_H
+#define FLAT_MAP_H
+
+#include "core/local_vector.h"
+#include "core/typedefs.h"
+
+/**
+ * Sorted map stored in a single LocalVector. Lookups are a binary search over
+ * contiguous memory and clearing keeps the capacity, which suits small maps
+ * that are rebuilt every frame. Iterates in key order like Map; inserting or
+ * erasing moves the following elements, so indices are only valid until then.
+ */
+
+template <class K, class V, class C = Comparator<K> >
+class FlatMap {
+
+	struct Pair {
+
+		K key;
+		V value;
+
+		_FORCE_INLINE_ Pair() {}
+		_FORCE_INLINE_ Pair(const K &p_key, const V &p_value) :
+				key(p_key),
+				value(p_value) {}
+	};
+
+	LocalVector<Pair> pairs;
+
+	_FORCE_INLINE_ int _find(const K &p_key, bool &r_exact) const {
+
+		r_exact = false;
+		int low = 0;
+		int high = pairs.size() - 1;
+		C less;
+
+		while (low <= high) {
+			int middle = (low + high) / 2;
+			if (less(p_key, pairs[middle].key)) {
+				high = middle - 1;
+			} else if (less(pairs[middle].key, p_key)) {
+				low = middle + 1;
+			} else {
+				r_exact = true;
+				return middle;
+			}
+		}
+
+		return low;
+	}
+
+public:
+	int insert(const K &p_key, const V &p_value) {
+
+		bool exact;
+		int pos = _find(p_key, exact);
+		if (exact) {
+			pairs[pos].value = p_value;
+		} else {
+			pairs.insert(pos, Pair(p_key, p_value));
+		}
+		return pos;
+	}
+
+	_FORCE_INLINE_ bool has(const K &p_key) const {
+
+		bool exact;
+		_find(p_key, exact);
+		return exact;
+	}
+
+	// returns -1 when the key is not in the map
+	_FORCE_INLINE_ int find(const K &p_key) const {
+
+		bool exact;
+		int pos = _find(p_key, exact);
+		return exact ? pos : -1;
+	}
+
+	void erase(const K &p_key) {
+
+		bool exact;
+		int pos = _find(p_key, exact);
+		if (exact) {
+			pairs.remove(pos);
+		}
+	}
+
+	void remove_at(int p_index) {
+
+		pairs.remove(p_index);
+	}
+
+	_FORCE_INLINE_ const K &getk(int p_index) const { return pairs[p_index].key; }
+	_FORCE_INLINE_ V &getv(int p_index) { return pairs[p_index].value; }
+	_FORCE_INLINE_ const V &getv(int p_index) const { return pairs[p_index].value; }
+
+	_FORCE_INLINE_ int size() const { return pairs.size(); }
+	_FORCE_INLINE_ bool empty() const { return pairs.empty(); }
+
+	// keeps the capacity, use reset() to free the memory
+	void clear() { pairs.clear(); }
+	void reset() { pairs.reset(); }
+
+	void swap(FlatMap &p_other) {
+
+		LocalVector<Pair> tmp = static_cast<LocalVector<Pair> &&>(pairs);
+		pairs = static_cast<LocalVector<Pair> &&>(p_other.pairs);
+		p_other.pairs = static_cast<LocalVector<Pair> &&>(tmp);
+	}
+
+	V &operator[](const K &p_key) {
+
+		bool exact;
+		int pos = _find(p_key, exact);
+		if (!exact) {
+			pairs.insert(pos, Pair(p_key, V()));
+		}
+		return pairs[pos].value;
+	}
+};
+
+#endif
@@ -35,6 +35,7 @@
 #include "core/io/resource_loader.h"
 #include "core/math/math_funcs.h"
 #include "core/os/copymem.h"
+#include "core/os/threaded_array_processor.h"
 #include "core/print_string.h"
 
 #include "thirdparty/misc/hq2x.h"
@@ -511,6 +512,52 @@ Image::Format Image::get_format() const {
 	return format;
 }
 
+// Destination images smaller than this are processed on the calling thread, as starting the workers would cost more.
+#define IMAGE_THREADED_MIN_PIXELS (512 * 512)
+
+template <class T>
+struct _ImageRowProcessJob {
+
+	void (*func)(const T *, T *, uint32_t, uint32_t, uint32_t, uint32_t, uint32_t, uint32_t);
+	const T *src;
+	T *dst;
+	uint32_t src_width;
+	uint32_t src_height;
+	uint32_t dst_width;
+	uint32_t dst_height;
+	uint32_t rows_per_band;
+
+	void process_band(uint32_t p_band, void *p_userdata) {
+
+		uint32_t from = p_band * rows_per_band;
+		func(src, dst, src_width, src_height, dst_width, dst_height, from, MIN(from + rows_per_band, dst_height));
+	}
+};
+
+// Every destination row only reads from the source, so large images are split into bands of rows processed in parallel.
+template <class T>
+static void _process_image_rows(void (*p_func)(const T *, T *, uint32_t, uint32_t, uint32_t, uint32_t, uint32_t, uint32_t), const T *p_src, T *p_dst, uint32_t p_src_width, uint32_t p_src_height, uint32_t p_dst_width, uint32_t p_dst_height) {
+
+	int bands = OS::get_singleton() ? OS::get_singleton()->get_processor_count() * 4 : 1;
+
+	if (uint64_t(p_dst_width) * p_dst_height < IMAGE_THREADED_MIN_PIXELS || bands <= 1 || p_dst_height < 2) {
+		p_func(p_src, p_dst, p_src_width, p_src_height, p_dst_width, p_dst_height, 0, p_dst_height);
+		return;
+	}
+
+	_ImageRowProcessJob<T> job;
+	job.func = p_func;
+	job.src = p_src;
+	job.dst = p_dst;
+	job.src_width = p_src_width;
+	job.src_height = p_src_height;
+	job.dst_width = p_dst_width;
+	job.dst_height = p_dst_height;
+	job.rows_per_band = (p_dst_height + bands - 1) / bands;
+
+	thread_process_array((p_dst_height + job.rows_per_band - 1) / job.rows_per_band, &job, &_ImageRowProcessJob<T>::process_band, (void *)NULL);
+}
+
 static double _bicubic_interp_kernel(double x) {
 
 	x = ABS(x);
@@ -526,7 +573,7 @@ static double _bicubic_interp_kernel(double x) {
 }
 
 template <int CC, class T>
-static void _scale_cubic(const uint8_t *__restrict p_src, uint8_t *__restrict p_dst, uint32_t p_src_width, uint32_t p_src_height, uint32_t p_dst_width, uint32_t p_dst_height) {
+static void _scale_cubic(const uint8_t *__restrict p_src, uint8_t *__restrict p_dst, uint32_t p_src_width, uint32_t p_src_height, uint32_t p_dst_width, uint32_t p_dst_height, uint32_t p_from_row, uint32_t p_to_row) {
 
 	// get source image size
 	int width = p_src_width;
@@ -542,7 +589,7 @@ static void _scale_cubic(const uint8_t *__restrict p_src, uint8_t *__restrict p_
 	int xmax = width - 1;
 	// temporary pointer
 
-	for (uint32_t y = 0; y < p_dst_height; y++) {
+	for (uint32_t y = p_from_row; y < p_to_row; y++) {
 		// Y coordinates
 		oy = (double)y * yfac - 0.5f;
 		oy1 = (int)oy;
@@ -610,7 +657,7 @@ static void _scale_cubic(const uint8_t *__restrict p_src, uint8_t *__restrict p_
 }
 
 template <int CC, class T>
-static void _scale_bilinear(const uint8_t *__restrict p_src, uint8_t *__restrict p_dst, uint32_t p_src_width, uint32_t p_src_height, uint32_t p_dst_width, uint32_t p_dst_height) {
+static void _scale_bilinear(const uint8_t *__restrict p_src, uint8_t *__restrict p_dst, uint32_t p_src_width, uint32_t p_src_height, uint32_t p_dst_width, uint32_t p_dst_height, uint32_t p_from_row, uint32_t p_to_row) {
 
 	enum {
 		FRAC_BITS = 8,
@@ -619,7 +666,7 @@ static void _scale_bilinear(const uint8_t *__restrict p_src, uint8_t *__restrict
 
 	};
 
-	for (uint32_t i = 0; i < p_dst_height; i++) {
+	for (uint32_t i = p_from_row; i < p_to_row; i++) {
 
 		uint32_t src_yofs_up_fp = (i * p_src_height * FRAC_LEN / p_dst_height);
 		uint32_t src_yofs_frac = src_yofs_up_fp & FRAC_MASK;
@@ -701,9 +748,9 @@ static void _scale_bilinear(const uint8_t *__restrict p_src, uint8_t *__restrict
 }
 
 template <int CC, class T>
-static void _scale_nearest(const uint8_t *__restrict p_src, uint8_t *__restrict p_dst, uint32_t p_src_width, uint32_t p_src_height, uint32_t p_dst_width, uint32_t p_dst_height) {
+static void _scale_nearest(const uint8_t *__restrict p_src, uint8_t *__restrict p_dst, uint32_t p_src_width, uint32_t p_src_height, uint32_t p_dst_width, uint32_t p_dst_height, uint32_t p_from_row, uint32_t p_to_row) {
 
-	for (uint32_t i = 0; i < p_dst_height; i++) {
+	for (uint32_t i = p_from_row; i < p_to_row; i++) {
 
 		uint32_t src_yofs = i * p_src_height / p_dst_height;
 		uint32_t y_ofs = src_yofs * p_src_width * CC;
@@ -821,25 +868,25 @@ void Image::resize(int p_width, int p_height, Interpolation p_interpolation) {
 
 			if (format >= FORMAT_L8 && format <= FORMAT_RGBA8) {
 				switch (get_format_pixel_size(format)) {
-					case 1: _scale_nearest<1, uint8_t>(r_ptr, w_ptr, width, height, p_width, p_height); break;
-					case 2: _scale_nearest<2, uint8_t>(r_ptr, w_ptr, width, height, p_width, p_height); break;
-					case 3: _scale_nearest<3, uint8_t>(r_ptr, w_ptr, width, height, p_width, p_height); break;
-					case 4: _scale_nearest<4, uint8_t>(r_ptr, w_ptr, width, height, p_width, p_height); break;
+					case 1: _process_image_rows(_scale_nearest<1, uint8_t>, r_ptr, w_ptr, width, height, p_width, p_height); break;
+					case 2: _process_image_rows(_scale_nearest<2, uint8_t>, r_ptr, w_ptr, width, height, p_width, p_height); break;
+					case 3: _process_image_rows(_scale_nearest<3, uint8_t>, r_ptr, w_ptr, width, height, p_width, p_height); break;
+					case 4: _process_image_rows(_scale_nearest<4, uint8_t>, r_ptr, w_ptr, width, height, p_width, p_height); break;
 				}
 			} else if (format >= FORMAT_RF && format <= FORMAT_RGBAF) {
 				switch (get_format_pixel_size(format)) {
-					case 4: _scale_nearest<1, float>(r_ptr, w_ptr, width, height, p_width, p_height); break;
-					case 8: _scale_nearest<2, float>(r_ptr, w_ptr, width, height, p_width, p_height); break;
-					case 12: _scale_nearest<3, float>(r_ptr, w_ptr, width, height, p_width, p_height); break;
-					case 16: _scale_nearest<4, float>(r_ptr, w_ptr, width, height, p_width, p_height); break;
+					case 4: _process_image_rows(_scale_nearest<1, float>, r_ptr, w_ptr, width, height, p_width, p_height); break;
+					case 8: _process_image_rows(_scale_nearest<2, float>, r_ptr, w_ptr, width, height, p_width, p_height); break;
+					case 12: _process_image_rows(_scale_nearest<3, float>, r_ptr, w_ptr, width, height, p_width, p_height); break;
+					case 16: _process_image_rows(_scale_nearest<4, float>, r_ptr, w_ptr, width, height, p_width, p_height); break;
 				}
 
 			} else if (format >= FORMAT_RH && format <= FORMAT_RGBAH) {
 				switch (get_format_pixel_size(format)) {
-					case 2: _scale_nearest<1, uint16_t>(r_ptr, w_ptr, width, height, p_width, p_height); break;
-					case 4: _scale_nearest<2, uint16_t>(r_ptr, w_ptr, width, height, p_width, p_height); break;
-					case 6: _scale_nearest<3, uint16_t>(r_ptr, w_ptr, width, height, p_width, p_height); break;
-					case 8: _scale_nearest<4, uint16_t>(r_ptr, w_ptr, width, height, p_width, p_height); break;
+					case 2: _process_image_rows(_scale_nearest<1, uint16_t>, r_ptr, w_ptr, width, height, p_width, p_height); break;
+					case 4: _process_image_rows(_scale_nearest<2, uint16_t>, r_ptr, w_ptr, width, height, p_width, p_height); break;
+					case 6: _process_image_rows(_scale_nearest<3, uint16_t>, r_ptr, w_ptr, width, height, p_width, p_height); break;
+					case 8: _process_image_rows(_scale_nearest<4, uint16_t>, r_ptr, w_ptr, width, height, p_width, p_height); break;
 				}
 			}
 
@@ -885,24 +932,24 @@ void Image::resize(int p_width, int p_height, Interpolation p_interpolation) {
 
 				if (format >= FORMAT_L8 && format <= FORMAT_RGBA8) {
 					switch (get_format_pixel_size(format)) {
-						case 1: _scale_bilinear<1, uint8_t>(src_ptr, w_ptr, src_width, src_height, p_width, p_height); break;
-						case 2: _scale_bilinear<2, uint8_t>(src_ptr, w_ptr, src_width, src_height, p_width, p_height); break;
-						case 3: _scale_bilinear<3, uint8_t>(src_ptr, w_ptr, src_width, src_height, p_width, p_height); break;
-						case 4: _scale_bilinear<4, uint8_t>(src_ptr, w_ptr, src_width, src_height, p_width, p_height); break;
+						case 1: _process_image_rows(_scale_bilinear<1, uint8_t>, src_ptr, w_ptr, src_width, src_height, p_width, p_height); break;
+						case 2: _process_image_rows(_scale_bilinear<2, uint8_t>, src_ptr, w_ptr, src_width, src_height, p_width, p_height); break;
+						case 3: _process_image_rows(_scale_bilinear<3, uint8_t>, src_ptr, w_ptr, src_width, src_height, p_width, p_height); break;
+						case 4: _process_image_rows(_scale_bilinear<4, uint8_t>, src_ptr, w_ptr, src_width, src_height, p_width, p_height); break;
 					}
 				} else if (format >= FORMAT_RF && format <= FORMAT_RGBAF) {
 					switch (get_format_pixel_size(format)) {
-						case 4: _scale_bilinear<1, float>(src_ptr, w_ptr, src_width, src_height, p_width, p_height); break;
-						case 8: _scale_bilinear<2, float>(src_ptr, w_ptr, src_width, src_height, p_width, p_height); break;
-						case 12: _scale_bilinear<3, float>(src_ptr, w_ptr, src_width, src_height, p_width, p_height); break;
-						case 16: _scale_bilinear<4, float>(src_ptr, w_ptr, src_width, src_height, p_width, p_height); break;
+						case 4: _process_image_rows(_scale_bilinear<1, float>, src_ptr, w_ptr, src_width, src_height, p_width, p_height); break;
+						case 8: _process_image_rows(_scale_bilinear<2, float>, src_ptr, w_ptr, src_width, src_height, p_width, p_height); break;
+						case 12: _process_image_rows(_scale_bilinear<3, float>, src_ptr, w_ptr, src_width, src_height, p_width, p_height); break;
+						case 16: _process_image_rows(_scale_bilinear<4, float>, src_ptr, w_ptr, src_width, src_height, p_width, p_height); break;
 					}
 				} else if (format >= FORMAT_RH && format <= FORMAT_RGBAH) {
 					switch (get_format_pixel_size(format)) {
-						case 2: _scale_bilinear<1, uint16_t>(src_ptr, w_ptr, src_width, src_height, p_width, p_height); break;
-						case 4: _scale_bilinear<2, uint16_t>(src_ptr, w_ptr, src_width, src_height, p_width, p_height); break;
-						case 6: _scale_bilinear<3, uint16_t>(src_ptr, w_ptr, src_width, src_height, p_width, p_height); break;
-						case 8: _scale_bilinear<4, uint16_t>(src_ptr, w_ptr, src_width, src_height, p_width, p_height); break;
+						case 2: _process_image_rows(_scale_bilinear<1, uint16_t>, src_ptr, w_ptr, src_width, src_height, p_width, p_height); break;
+						case 4: _process_image_rows(_scale_bilinear<2, uint16_t>, src_ptr, w_ptr, src_width, src_height, p_width, p_height); break;
+						case 6: _process_image_rows(_scale_bilinear<3, uint16_t>, src_ptr, w_ptr, src_width, src_height, p_width, p_height); break;
+						case 8: _process_image_rows(_scale_bilinear<4, uint16_t>, src_ptr, w_ptr, src_width, src_height, p_width, p_height); break;
 					}
 				}
 			}
@@ -918,24 +965,24 @@ void Image::resize(int p_width, int p_height, Interpolation p_interpolation) {
 
 			if (format >= FORMAT_L8 && format <= FORMAT_RGBA8) {
 				switch (get_format_pixel_size(format)) {
-					case 1: _scale_cubic<1, uint8_t>(r_ptr, w_ptr, width, height, p_width, p_height); break;
-					case 2: _scale_cubic<2, uint8_t>(r_ptr, w_ptr, width, height, p_width, p_height); break;
-					case 3: _scale_cubic<3, uint8_t>(r_ptr, w_ptr, width, height, p_width, p_height); break;
-					case 4: _scale_cubic<4, uint8_t>(r_ptr, w_ptr, width, height, p_width, p_height); break;
+					case 1: _process_image_rows(_scale_cubic<1, uint8_t>, r_ptr, w_ptr, width, height, p_width, p_height); break;
+					case 2: _process_image_rows(_scale_cubic<2, uint8_t>, r_ptr, w_ptr, width, height, p_width, p_height); break;
+					case 3: _process_image_rows(_scale_cubic<3, uint8_t>, r_ptr, w_ptr, width, height, p_width, p_height); break;
+					case 4: _process_image_rows(_scale_cubic<4, uint8_t>, r_ptr, w_ptr, width, height, p_width, p_height); break;
 				}
 			} else if (format >= FORMAT_RF && format <= FORMAT_RGBAF) {
 				switch (get_format_pixel_size(format)) {
-					case 4: _scale_cubic<1, float>(r_ptr, w_ptr, width, height, p_width, p_height); break;
-					case 8: _scale_cubic<2, float>(r_ptr, w_ptr, width, height, p_width, p_height); break;
-					case 12: _scale_cubic<3, float>(r_ptr, w_ptr, width, height, p_width, p_height); break;
-					case 16: _scale_cubic<4, float>(r_ptr, w_ptr, width, height, p_width, p_height); break;
+					case 4: _process_image_rows(_scale_cubic<1, float>, r_ptr, w_ptr, width, height, p_width, p_height); break;
+					case 8: _process_image_rows(_scale_cubic<2, float>, r_ptr, w_ptr, width, height, p_width, p_height); break;
+					case 12: _process_image_rows(_scale_cubic<3, float>, r_ptr, w_ptr, width, height, p_width, p_height); break;
+					case 16: _process_image_rows(_scale_cubic<4, float>, r_ptr, w_ptr, width, height, p_width, p_height); break;
 				}
 			} else if (format >= FORMAT_RH && format <= FORMAT_RGBAH) {
 				switch (get_format_pixel_size(format)) {
-					case 2: _scale_cubic<1, uint16_t>(r_ptr, w_ptr, width, height, p_width, p_height); break;
-					case 4: _scale_cubic<2, uint16_t>(r_ptr, w_ptr, width, height, p_width, p_height); break;
-					case 6: _scale_cubic<3, uint16_t>(r_ptr, w_ptr, width, height, p_width, p_height); break;
-					case 8: _scale_cubic<4, uint16_t>(r_ptr, w_ptr, width, height, p_width, p_height); break;
+					case 2: _process_image_rows(_scale_cubic<1, uint16_t>, r_ptr, w_ptr, width, height, p_width, p_height); break;
+					case 4: _process_image_rows(_scale_cubic<2, uint16_t>, r_ptr, w_ptr, width, height, p_width, p_height); break;
+					case 6: _process_image_rows(_scale_cubic<3, uint16_t>, r_ptr, w_ptr, width, height, p_width, p_height); break;
+					case 8: _process_image_rows(_scale_cubic<4, uint16_t>, r_ptr, w_ptr, width, height, p_width, p_height); break;
 				}
 			}
 		} break;
@@ -1138,16 +1185,15 @@ bool Image::_can_modify(Format p_format) const {
 template <class Component, int CC, bool renormalize,
 		void (*average_func)(Component &, const Component &, const Component &, const Component &, const Component &),
 		void (*renormalize_func)(Component *)>
-static void _generate_po2_mipmap(const Component *p_src, Component *p_dst, uint32_t p_width, uint32_t p_height) {
+static void _generate_po2_mipmap(const Component *p_src, Component *p_dst, uint32_t p_width, uint32_t p_height, uint32_t p_dst_width, uint32_t p_dst_height, uint32_t p_from_row, uint32_t p_to_row) {
 
 	//fast power of 2 mipmap generation
-	uint32_t dst_w = MAX(p_width >> 1, 1);
-	uint32_t dst_h = MAX(p_height >> 1, 1);
+	uint32_t dst_w = p_dst_width;
 
 	int right_step = (p_width == 1) ? 0 : CC;
 	int down_step = (p_height == 1) ? 0 : (p_width * CC);
 
-	for (uint32_t i = 0; i < dst_h; i++) {
+	for (uint32_t i = p_from_row; i < p_to_row; i++) {
 
 		const Component *rup_ptr = &p_src[i * 2 * down_step];
 		const Component *rdown_ptr = rup_ptr + down_step;
@@ -1249,23 +1295,23 @@ void Image::shrink_x2() {
 			switch (format) {
 
 				case FORMAT_L8:
-				case FORMAT_R8: _generate_po2_mipmap<uint8_t, 1, false, Image::average_4_uint8, Image::renormalize_uint8>(r.ptr(), w.ptr(), width, height); break;
-				case FORMAT_LA8: _generate_po2_mipmap<uint8_t, 2, false, Image::average_4_uint8, Image::renormalize_uint8>(r.ptr(), w.ptr(), width, height); break;
-				case FORMAT_RG8: _generate_po2_mipmap<uint8_t, 2, false, Image::average_4_uint8, Image::renormalize_uint8>(r.ptr(), w.ptr(), width, height); break;
-				case FORMAT_RGB8: _generate_po2_mipmap<uint8_t, 3, false, Image::average_4_uint8, Image::renormalize_uint8>(r.ptr(), w.ptr(), width, height); break;
-				case FORMAT_RGBA8: _generate_po2_mipmap<uint8_t, 4, false, Image::average_4_uint8, Image::renormalize_uint8>(r.ptr(), w.ptr(), width, height); break;
-
-				case FORMAT_RF: _generate_po2_mipmap<float, 1, false, Image::average_4_float, Image::renormalize_float>(reinterpret_cast<const float *>(r.ptr()), reinterpret_cast<float *>(w.ptr()), width, height); break;
-				case FORMAT_RGF: _generate_po2_mipmap<float, 2, false, Image::average_4_float, Image::renormalize_float>(reinterpret_cast<const float *>(r.ptr()), reinterpret_cast<float *>(w.ptr()), width, height); break;
-				case FORMAT_RGBF: _generate_po2_mipmap<float, 3, false, Image::average_4_float, Image::renormalize_float>(reinterpret_cast<const float *>(r.ptr()), reinterpret_cast<float *>(w.ptr()), width, height); break;
-				case FORMAT_RGBAF: _generate_po2_mipmap<float, 4, false, Image::average_4_float, Image::renormalize_float>(reinterpret_cast<const float *>(r.ptr()), reinterpret_cast<float *>(w.ptr()), width, height); break;
-
-				case FORMAT_RH: _generate_po2_mipmap<uint16_t, 1, false, Image::average_4_half, Image::renormalize_half>(reinterpret_cast<const uint16_t *>(r.ptr()), reinterpret_cast<uint16_t *>(w.ptr()), width, height); break;
-				case FORMAT_RGH: _generate_po2_mipmap<uint16_t, 2, false, Image::average_4_half, Image::renormalize_half>(reinterpret_cast<const uint16_t *>(r.ptr()), reinterpret_cast<uint16_t *>(w.ptr()), width, height); break;
-				case FORMAT_RGBH: _generate_po2_mipmap<uint16_t, 3, false, Image::average_4_half, Image::renormalize_half>(reinterpret_cast<const uint16_t *>(r.ptr()), reinterpret_cast<uint16_t *>(w.ptr()), width, height); break;
-				case FORMAT_RGBAH: _generate_po2_mipmap<uint16_t, 4, false, Image::average_4_half, Image::renormalize_half>(reinterpret_cast<const uint16_t *>(r.ptr()), reinterpret_cast<uint16_t *>(w.ptr()), width, height); break;
-
-				case FORMAT_RGBE9995: _generate_po2_mipmap<uint32_t, 1, false, Image::average_4_rgbe9995, Image::renormalize_rgbe9995>(reinterpret_cast<const uint32_t *>(r.ptr()), reinterpret_cast<uint32_t *>(w.ptr()), width, height); break;
+				case FORMAT_R8: _process_image_rows(_generate_po2_mipmap<uint8_t, 1, false, Image::average_4_uint8, Image::renormalize_uint8>, r.ptr(), w.ptr(), width, height, MAX(width >> 1, 1), MAX(height >> 1, 1)); break;
+				case FORMAT_LA8: _process_image_rows(_generate_po2_mipmap<uint8_t, 2, false, Image::average_4_uint8, Image::renormalize_uint8>, r.ptr(), w.ptr(), width, height, MAX(width >> 1, 1), MAX(height >> 1, 1)); break;
+				case FORMAT_RG8: _process_image_rows(_generate_po2_mipmap<uint8_t, 2, false, Image::average_4_uint8, Image::renormalize_uint8>, r.ptr(), w.ptr(), width, height, MAX(width >> 1, 1), MAX(height >> 1, 1)); break;
+				case FORMAT_RGB8: _process_image_rows(_generate_po2_mipmap<uint8_t, 3, false, Image::average_4_uint8, Image::renormalize_uint8>, r.ptr(), w.ptr(), width, height, MAX(width >> 1, 1), MAX(height >> 1, 1)); break;
+				case FORMAT_RGBA8: _process_image_rows(_generate_po2_mipmap<uint8_t, 4, false, Image::average_4_uint8, Image::renormalize_uint8>, r.ptr(), w.ptr(), width, height, MAX(width >> 1, 1), MAX(height >> 1, 1)); break;
+
+				case FORMAT_RF: _process_image_rows(_generate_po2_mipmap<float, 1, false, Image::average_4_float, Image::renormalize_float>, reinterpret_cast<const float *>(r.ptr()), reinterpret_cast<float *>(w.ptr()), width, height, MAX(width >> 1, 1), MAX(height >> 1, 1)); break;
+				case FORMAT_RGF: _process_image_rows(_generate_po2_mipmap<float, 2, false, Image::average_4_float, Image::renormalize_float>, reinterpret_cast<const float *>(r.ptr()), reinterpret_cast<float *>(w.ptr()), width, height, MAX(width >> 1, 1), MAX(height >> 1, 1)); break;
+				case FORMAT_RGBF: _process_image_rows(_generate_po2_mipmap<float, 3, false, Image::average_4_float, Image::renormalize_float>, reinterpret_cast<const float *>(r.ptr()), reinterpret_cast<float *>(w.ptr()), width, height, MAX(width >> 1, 1), MAX(height >> 1, 1)); break;
+				case FORMAT_RGBAF: _process_image_rows(_generate_po2_mipmap<float, 4, false, Image::average_4_float, Image::renormalize_float>, reinterpret_cast<const float *>(r.ptr()), reinterpret_cast<float *>(w.ptr()), width, height, MAX(width >> 1, 1), MAX(height >> 1, 1)); break;
+
+				case FORMAT_RH: _process_image_rows(_generate_po2_mipmap<uint16_t, 1, false, Image::average_4_half, Image::renormalize_half>, reinterpret_cast<const uint16_t *>(r.ptr()), reinterpret_cast<uint16_t *>(w.ptr()), width, height, MAX(width >> 1, 1), MAX(height >> 1, 1)); break;
+				case FORMAT_RGH: _process_image_rows(_generate_po2_mipmap<uint16_t, 2, false, Image::average_4_half, Image::renormalize_half>, reinterpret_cast<const uint16_t *>(r.ptr()), reinterpret_cast<uint16_t *>(w.ptr()), width, height, MAX(width >> 1, 1), MAX(height >> 1, 1)); break;
+				case FORMAT_RGBH: _process_image_rows(_generate_po2_mipmap<uint16_t, 3, false, Image::average_4_half, Image::renormalize_half>, reinterpret_cast<const uint16_t *>(r.ptr()), reinterpret_cast<uint16_t *>(w.ptr()), width, height, MAX(width >> 1, 1), MAX(height >> 1, 1)); break;
+				case FORMAT_RGBAH: _process_image_rows(_generate_po2_mipmap<uint16_t, 4, false, Image::average_4_half, Image::renormalize_half>, reinterpret_cast<const uint16_t *>(r.ptr()), reinterpret_cast<uint16_t *>(w.ptr()), width, height, MAX(width >> 1, 1), MAX(height >> 1, 1)); break;
+
+				case FORMAT_RGBE9995: _process_image_rows(_generate_po2_mipmap<uint32_t, 1, false, Image::average_4_rgbe9995, Image::renormalize_rgbe9995>, reinterpret_cast<const uint32_t *>(r.ptr()), reinterpret_cast<uint32_t *>(w.ptr()), width, height, MAX(width >> 1, 1), MAX(height >> 1, 1)); break;
 				default: {}
 			}
 		}
@@ -1335,67 +1381,67 @@ Error Image::generate_mipmaps(bool p_renormalize) {
 		switch (format) {
 
 			case FORMAT_L8:
-			case FORMAT_R8: _generate_po2_mipmap<uint8_t, 1, false, Image::average_4_uint8, Image::renormalize_uint8>(&wp[prev_ofs], &wp[ofs], prev_w, prev_h); break;
+			case FORMAT_R8: _process_image_rows(_generate_po2_mipmap<uint8_t, 1, false, Image::average_4_uint8, Image::renormalize_uint8>, &wp[prev_ofs], &wp[ofs], prev_w, prev_h, MAX(prev_w >> 1, 1), MAX(prev_h >> 1, 1)); break;
 			case FORMAT_LA8:
-			case FORMAT_RG8: _generate_po2_mipmap<uint8_t, 2, false, Image::average_4_uint8, Image::renormalize_uint8>(&wp[prev_ofs], &wp[ofs], prev_w, prev_h); break;
+			case FORMAT_RG8: _process_image_rows(_generate_po2_mipmap<uint8_t, 2, false, Image::average_4_uint8, Image::renormalize_uint8>, &wp[prev_ofs], &wp[ofs], prev_w, prev_h, MAX(prev_w >> 1, 1), MAX(prev_h >> 1, 1)); break;
 			case FORMAT_RGB8:
 				if (p_renormalize)
-					_generate_po2_mipmap<uint8_t, 3, true, Image::average_4_uint8, Image::renormalize_uint8>(&wp[prev_ofs], &wp[ofs], prev_w, prev_h);
+					_process_image_rows(_generate_po2_mipmap<uint8_t, 3, true, Image::average_4_uint8, Image::renormalize_uint8>, &wp[prev_ofs], &wp[ofs], prev_w, prev_h, MAX(prev_w >> 1, 1), MAX(prev_h >> 1, 1));
 				else
-					_generate_po2_mipmap<uint8_t, 3, false, Image::average_4_uint8, Image::renormalize_uint8>(&wp[prev_ofs], &wp[ofs], prev_w, prev_h);
+					_process_image_rows(_generate_po2_mipmap<uint8_t, 3, false, Image::average_4_uint8, Image::renormalize_uint8>, &wp[prev_ofs], &wp[ofs], prev_w, prev_h, MAX(prev_w >> 1, 1), MAX(prev_h >> 1, 1));
 
 				break;
 			case FORMAT_RGBA8:
 				if (p_renormalize)
-					_generate_po2_mipmap<uint8_t, 4, true, Image::average_4_uint8, Image::renormalize_uint8>(&wp[prev_ofs], &wp[ofs], prev_w, prev_h);
+					_process_image_rows(_generate_po2_mipmap<uint8_t, 4, true, Image::average_4_uint8, Image::renormalize_uint8>, &wp[prev_ofs], &wp[ofs], prev_w, prev_h, MAX(prev_w >> 1, 1), MAX(prev_h >> 1, 1));
 				else
-					_generate_po2_mipmap<uint8_t, 4, false, Image::average_4_uint8, Image::renormalize_uint8>(&wp[prev_ofs], &wp[ofs], prev_w, prev_h);
+					_process_image_rows(_generate_po2_mipmap<uint8_t, 4, false, Image::average_4_uint8, Image::renormalize_uint8>, &wp[prev_ofs], &wp[ofs], prev_w, prev_h, MAX(prev_w >> 1, 1), MAX(prev_h >> 1, 1));
 				break;
 			case FORMAT_RF:
-				_generate_po2_mipmap<float, 1, false, Image::average_4_float, Image::renormalize_float>(reinterpret_cast<const float *>(&wp[prev_ofs]), reinterpret_cast<float *>(&wp[ofs]), prev_w, prev_h);
+				_process_image_rows(_generate_po2_mipmap<float, 1, false, Image::average_4_float, Image::renormalize_float>, reinterpret_cast<const float *>(&wp[prev_ofs]), reinterpret_cast<float *>(&wp[ofs]), prev_w, prev_h, MAX(prev_w >> 1, 1), MAX(prev_h >> 1, 1));
 				break;
 			case FORMAT_RGF:
-				_generate_po2_mipmap<float, 2, false, Image::average_4_float, Image::renormalize_float>(reinterpret_cast<const float *>(&wp[prev_ofs]), reinterpret_cast<float *>(&wp[ofs]), prev_w, prev_h);
+				_process_image_rows(_generate_po2_mipmap<float, 2, false, Image::average_4_float, Image::renormalize_float>, reinterpret_cast<const float *>(&wp[prev_ofs]), reinterpret_cast<float *>(&wp[ofs]), prev_w, prev_h, MAX(prev_w >> 1, 1), MAX(prev_h >> 1, 1));
 				break;
 			case FORMAT_RGBF:
 				if (p_renormalize)
-					_generate_po2_mipmap<float, 3, true, Image::average_4_float, Image::renormalize_float>(reinterpret_cast<const float *>(&wp[prev_ofs]), reinterpret_cast<float *>(&wp[ofs]), prev_w, prev_h);
+					_process_image_rows(_generate_po2_mipmap<float, 3, true, Image::average_4_float, Image::renormalize_float>, reinterpret_cast<const float *>(&wp[prev_ofs]), reinterpret_cast<float *>(&wp[ofs]), prev_w, prev_h, MAX(prev_w >> 1, 1), MAX(prev_h >> 1, 1));
 				else
-					_generate_po2_mipmap<float, 3, false, Image::average_4_float, Image::renormalize_float>(reinterpret_cast<const float *>(&wp[prev_ofs]), reinterpret_cast<float *>(&wp[ofs]), prev_w, prev_h);
+					_process_image_rows(_generate_po2_mipmap<float, 3, false, Image::average_4_float, Image::renormalize_float>, reinterpret_cast<const float *>(&wp[prev_ofs]), reinterpret_cast<float *>(&wp[ofs]), prev_w, prev_h, MAX(prev_w >> 1, 1), MAX(prev_h >> 1, 1));
 
 				break;
 			case FORMAT_RGBAF:
 				if (p_renormalize)
-					_generate_po2_mipmap<float, 4, true, Image::average_4_float, Image::renormalize_float>(reinterpret_cast<const float *>(&wp[prev_ofs]), reinterpret_cast<float *>(&wp[ofs]), prev_w, prev_h);
+					_process_image_rows(_generate_po2_mipmap<float, 4, true, Image::average_4_float, Image::renormalize_float>, reinterpret_cast<const float *>(&wp[prev_ofs]), reinterpret_cast<float *>(&wp[ofs]), prev_w, prev_h, MAX(prev_w >> 1, 1), MAX(prev_h >> 1, 1));
 				else
-					_generate_po2_mipmap<float, 4, false, Image::average_4_float, Image::renormalize_float>(reinterpret_cast<const float *>(&wp[prev_ofs]), reinterpret_cast<float *>(&wp[ofs]), prev_w, prev_h);
+					_process_image_rows(_generate_po2_mipmap<float, 4, false, Image::average_4_float, Image::renormalize_float>, reinterpret_cast<const float *>(&wp[prev_ofs]), reinterpret_cast<float *>(&wp[ofs]), prev_w, prev_h, MAX(prev_w >> 1, 1), MAX(prev_h >> 1, 1));
 
 				break;
 			case FORMAT_RH:
-				_generate_po2_mipmap<uint16_t, 1, false, Image::average_4_half, Image::renormalize_half>(reinterpret_cast<const uint16_t *>(&wp[prev_ofs]), reinterpret_cast<uint16_t *>(&wp[ofs]), prev_w, prev_h);
+				_process_image_rows(_generate_po2_mipmap<uint16_t, 1, false, Image::average_4_half, Image::renormalize_half>, reinterpret_cast<const uint16_t *>(&wp[prev_ofs]), reinterpret_cast<uint16_t *>(&wp[ofs]), prev_w, prev_h, MAX(prev_w >> 1, 1), MAX(prev_h >> 1, 1));
 				break;
 			case FORMAT_RGH:
-				_generate_po2_mipmap<uint16_t, 2, false, Image::average_4_half, Image::renormalize_half>(reinterpret_cast<const uint16_t *>(&wp[prev_ofs]), reinterpret_cast<uint16_t *>(&wp[ofs]), prev_w, prev_h);
+				_process_image_rows(_generate_po2_mipmap<uint16_t, 2, false, Image::average_4_half, Image::renormalize_half>, reinterpret_cast<const uint16_t *>(&wp[prev_ofs]), reinterpret_cast<uint16_t *>(&wp[ofs]), prev_w, prev_h, MAX(prev_w >> 1, 1), MAX(prev_h >> 1, 1));
 				break;
 			case FORMAT_RGBH:
 				if (p_renormalize)
-					_generate_po2_mipmap<uint16_t, 3, true, Image::average_4_half, Image::renormalize_half>(reinterpret_cast<const uint16_t *>(&wp[prev_ofs]), reinterpret_cast<uint16_t *>(&wp[ofs]), prev_w, prev_h);
+					_process_image_rows(_generate_po2_mipmap<uint16_t, 3, true, Image::average_4_half, Image::renormalize_half>, reinterpret_cast<const uint16_t *>(&wp[prev_ofs]), reinterpret_cast<uint16_t *>(&wp[ofs]), prev_w, prev_h, MAX(prev_w >> 1, 1), MAX(prev_h >> 1, 1));
 				else
-					_generate_po2_mipmap<uint16_t, 3, false, Image::average_4_half, Image::renormalize_half>(reinterpret_cast<const uint16_t *>(&wp[prev_ofs]), reinterpret_cast<uint16_t *>(&wp[ofs]), prev_w, prev_h);
+					_process_image_rows(_generate_po2_mipmap<uint16_t, 3, false, Image::average_4_half, Image::renormalize_half>, reinterpret_cast<const uint16_t *>(&wp[prev_ofs]), reinterpret_cast<uint16_t *>(&wp[ofs]), prev_w, prev_h, MAX(prev_w >> 1, 1), MAX(prev_h >> 1, 1));
 
 				break;
 			case FORMAT_RGBAH:
 				if (p_renormalize)
-					_generate_po2_mipmap<uint16_t, 4, true, Image::average_4_half, Image::renormalize_half>(reinterpret_cast<const uint16_t *>(&wp[prev_ofs]), reinterpret_cast<uint16_t *>(&wp[ofs]), prev_w, prev_h);
+					_process_image_rows(_generate_po2_mipmap<uint16_t, 4, true, Image::average_4_half, Image::renormalize_half>, reinterpret_cast<const uint16_t *>(&wp[prev_ofs]), reinterpret_cast<uint16_t *>(&wp[ofs]), prev_w, prev_h, MAX(prev_w >> 1, 1), MAX(prev_h >> 1, 1));
 				else
-					_generate_po2_mipmap<uint16_t, 4, false, Image::average_4_half, Image::renormalize_half>(reinterpret_cast<const uint16_t *>(&wp[prev_ofs]), reinterpret_cast<uint16_t *>(&wp[ofs]), prev_w, prev_h);
+					_process_image_rows(_generate_po2_mipmap<uint16_t, 4, false, Image::average_4_half, Image::renormalize_half>, reinterpret_cast<const uint16_t *>(&wp[prev_ofs]), reinterpret_cast<uint16_t *>(&wp[ofs]), prev_w, prev_h, MAX(prev_w >> 1, 1), MAX(prev_h >> 1, 1));
 
 				break;
 			case FORMAT_RGBE9995:
 				if (p_renormalize)
-					_generate_po2_mipmap<uint32_t, 1, true, Image::average_4_rgbe9995, Image::renormalize_rgbe9995>(reinterpret_cast<const uint32_t *>(&wp[prev_ofs]), reinterpret_cast<uint32_t *>(&wp[ofs]), prev_w, prev_h);
+					_process_image_rows(_generate_po2_mipmap<uint32_t, 1, true, Image::average_4_rgbe9995, Image::renormalize_rgbe9995>, reinterpret_cast<const uint32_t *>(&wp[prev_ofs]), reinterpret_cast<uint32_t *>(&wp[ofs]), prev_w, prev_h, MAX(prev_w >> 1, 1), MAX(prev_h >> 1, 1));
 				else
-					_generate_po2_mipmap<uint32_t, 1, false, Image::average_4_rgbe9995, Image::renormalize_rgbe9995>(reinterpret_cast<const uint32_t *>(&wp[prev_ofs]), reinterpret_cast<uint32_t *>(&wp[ofs]), prev_w, prev_h);
+					_process_image_rows(_generate_po2_mipmap<uint32_t, 1, false, Image::average_4_rgbe9995, Image::renormalize_rgbe9995>, reinterpret_cast<const uint32_t *>(&wp[prev_ofs]), reinterpret_cast<uint32_t *>(&wp[ofs]), prev_w, prev_h, MAX(prev_w >> 1, 1), MAX(prev_h >> 1, 1));
 
 				break;
 			default: {}
@@ -2190,6 +2236,8 @@ PoolVector<uint8_t> (*Image::lossy_packer)(const Ref<Image> &, float) = NULL;
 Ref<Image> (*Image::lossy_unpacker)(const PoolVector<uint8_t> &) = NULL;
 PoolVector<uint8_t> (*Image::lossless_packer)(const Ref<Image> &) = NULL;
 Ref<Image> (*Image::lossless_unpacker)(const PoolVector<uint8_t> &) = NULL;
+PoolVector<uint8_t> (*Image::basis_universal_packer)(const Ref<Image> &, float) = NULL;
+Ref<Image> (*Image::basis_universal_unpacker)(const PoolVector<uint8_t> &) = NULL;
 
 void Image::_set_data(const Dictionary &p_data) {
 
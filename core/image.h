@@ -143,6 +143,9 @@ public:
 	static Ref<Image> (*lossy_unpacker)(const PoolVector<uint8_t> &p_buffer);
 	static PoolVector<uint8_t> (*lossless_packer)(const Ref<Image> &p_image);
 	static Ref<Image> (*lossless_unpacker)(const PoolVector<uint8_t> &p_buffer);
+	//the unpacker transcodes to the best compressed format the current renderer supports
+	static PoolVector<uint8_t> (*basis_universal_packer)(const Ref<Image> &p_image, float p_quality);
+	static Ref<Image> (*basis_universal_unpacker)(const PoolVector<uint8_t> &p_buffer);
 
 	PoolVector<uint8_t>::Write write_lock;
 
@@ -30,16 +30,63 @@
 
 #include "compression.h"
 
+#include "core/hashfuncs.h"
 #include "core/io/zip_io.h"
+#include "core/map.h"
 #include "core/os/copymem.h"
 #include "core/project_settings.h"
+#include "core/safe_refcount.h"
 
 #include "thirdparty/misc/fastlz.h"
 
 #include <zlib.h>
 #include <zstd.h>
 
-int Compression::compress(uint8_t *p_dst, const uint8_t *p_src, int p_src_size, Mode p_mode) {
+struct ZstdDictionary {
+	Vector<uint8_t> data;
+	ZSTD_CDict *cdict; // Created on first use, with the compression level set at that point.
+	ZSTD_DDict *ddict;
+};
+
+static Map<uint32_t, ZstdDictionary> *zstd_dictionaries = NULL;
+static volatile uint32_t zstd_dictionaries_lock = 0;
+
+static _FORCE_INLINE_ void _zstd_dictionaries_lock() {
+
+	while (zstd_dictionaries_lock || !atomic_compare_exchange(&zstd_dictionaries_lock, (uint32_t)0, (uint32_t)1)) {
+	}
+}
+
+static _FORCE_INLINE_ void _zstd_dictionaries_unlock() {
+
+	atomic_compare_exchange(&zstd_dictionaries_lock, (uint32_t)1, (uint32_t)0);
+}
+
+static const ZSTD_CDict *_get_zstd_cdict(uint32_t p_id) {
+
+	_zstd_dictionaries_lock();
+	ZSTD_CDict *cdict = NULL;
+	Map<uint32_t, ZstdDictionary>::Element *E = zstd_dictionaries ? zstd_dictionaries->find(p_id) : NULL;
+	if (E) {
+		if (!E->get().cdict) {
+			E->get().cdict = ZSTD_createCDict(E->get().data.ptr(), E->get().data.size(), Compression::zstd_level);
+		}
+		cdict = E->get().cdict;
+	}
+	_zstd_dictionaries_unlock();
+	return cdict;
+}
+
+static const ZSTD_DDict *_get_zstd_ddict(uint32_t p_id) {
+
+	_zstd_dictionaries_lock();
+	Map<uint32_t, ZstdDictionary>::Element *E = zstd_dictionaries ? zstd_dictionaries->find(p_id) : NULL;
+	ZSTD_DDict *ddict = E ? E->get().ddict : NULL;
+	_zstd_dictionaries_unlock();
+	return ddict;
+}
+
+int Compression::compress(uint8_t *p_dst, const uint8_t *p_src, int p_src_size, Mode p_mode, uint32_t p_zstd_dictionary) {
 
 	switch (p_mode) {
 		case MODE_FASTLZ: {
@@ -87,7 +134,19 @@ int Compression::compress(uint8_t *p_dst, const uint8_t *p_src, int p_src_size,
 				ZSTD_CCtx_setParameter(cctx, ZSTD_c_windowLog, zstd_window_log_size);
 			}
 			int max_dst_size = get_max_compressed_buffer_size(p_src_size, MODE_ZSTD);
-			int ret = ZSTD_compressCCtx(cctx, p_dst, max_dst_size, p_src, p_src_size, zstd_level);
+			int ret;
+			if (p_zstd_dictionary) {
+				const ZSTD_CDict *cdict = _get_zstd_cdict(p_zstd_dictionary);
+				if (!cdict) {
+					ZSTD_freeCCtx(cctx);
+					ERR_EXPLAIN("No Zstandard dictionary with ID " + itos(p_zstd_dictionary) + " was added.");
+					ERR_FAIL_V(-1);
+				}
+				ZSTD_CCtx_refCDict(cctx, cdict);
+				ret = ZSTD_compress2(cctx, p_dst, max_dst_size, p_src, p_src_size);
+			} else {
+				ret = ZSTD_compressCCtx(cctx, p_dst, max_dst_size, p_src, p_src_size, zstd_level);
+			}
 			ZSTD_freeCCtx(cctx);
 			return ret;
 		} break;
@@ -132,7 +191,7 @@ int Compression::get_max_compressed_buffer_size(int p_src_size, Mode p_mode) {
 	ERR_FAIL_V(-1);
 }
 
-int Compression::decompress(uint8_t *p_dst, int p_dst_max_size, const uint8_t *p_src, int p_src_size, Mode p_mode) {
+int Compression::decompress(uint8_t *p_dst, int p_dst_max_size, const uint8_t *p_src, int p_src_size, Mode p_mode, uint32_t p_zstd_dictionary) {
 
 	switch (p_mode) {
 		case MODE_FASTLZ: {
@@ -176,6 +235,15 @@ int Compression::decompress(uint8_t *p_dst, int p_dst_max_size, const uint8_t *p
 		case MODE_ZSTD: {
 			ZSTD_DCtx *dctx = ZSTD_createDCtx();
 			if (zstd_long_distance_matching) ZSTD_DCtx_setMaxWindowSize(dctx, (size_t)1 << zstd_window_log_size);
+			if (p_zstd_dictionary) {
+				const ZSTD_DDict *ddict = _get_zstd_ddict(p_zstd_dictionary);
+				if (!ddict) {
+					ZSTD_freeDCtx(dctx);
+					ERR_EXPLAIN("No Zstandard dictionary with ID " + itos(p_zstd_dictionary) + " was added.");
+					ERR_FAIL_V(-1);
+				}
+				ZSTD_DCtx_refDDict(dctx, ddict);
+			}
 			int ret = ZSTD_decompressDCtx(dctx, p_dst, p_dst_max_size, p_src, p_src_size);
 			ZSTD_freeDCtx(dctx);
 			return ret;
@@ -185,6 +253,215 @@ int Compression::decompress(uint8_t *p_dst, int p_dst_max_size, const uint8_t *p
 	ERR_FAIL_V(-1);
 }
 
+#define ZSTD_DICTIONARY_DMER_SIZE 8
+#define ZSTD_DICTIONARY_SEGMENT_SIZE 256
+#define ZSTD_DICTIONARY_HASH_BITS 20
+
+static _FORCE_INLINE_ uint32_t _hash_dmer(const uint8_t *p_data) {
+
+	uint64_t v;
+	memcpy(&v, p_data, ZSTD_DICTIONARY_DMER_SIZE);
+	return (uint32_t)((v * 0xCF1BBCDCB7A56463ULL) >> (64 - ZSTD_DICTIONARY_HASH_BITS));
+}
+
+Vector<uint8_t> Compression::train_zstd_dictionary(const Vector<Vector<uint8_t> > &p_samples, int p_max_size) {
+
+	Vector<uint8_t> dictionary;
+	ERR_FAIL_COND_V(p_max_size <= 0, dictionary);
+
+	const int d = ZSTD_DICTIONARY_DMER_SIZE;
+	const int k = ZSTD_DICTIONARY_SEGMENT_SIZE;
+
+	int total = 0;
+	for (int i = 0; i < p_samples.size(); i++) {
+		total += p_samples[i].size();
+	}
+	if (total < k * 2) {
+		return dictionary; // Not enough to learn anything from.
+	}
+
+	// Samples are joined, segments that span two of them just score lower.
+	Vector<uint8_t> data;
+	data.resize(total);
+	int ofs = 0;
+	for (int i = 0; i < p_samples.size(); i++) {
+		copymem(&data.ptrw()[ofs], p_samples[i].ptr(), p_samples[i].size());
+		ofs += p_samples[i].size();
+	}
+	const uint8_t *src = data.ptr();
+	const int dmer_count = total - d + 1;
+
+	// How often each d-mer (hashed, collisions are tolerated) appears across all samples.
+	Vector<uint32_t> freqs;
+	freqs.resize(1 << ZSTD_DICTIONARY_HASH_BITS);
+	uint32_t *freq = freqs.ptrw();
+	zeromem(freq, freqs.size() * sizeof(uint32_t));
+	for (int i = 0; i < dmer_count; i++) {
+		freq[_hash_dmer(&src[i])]++;
+	}
+
+	Vector<uint16_t> window_freqs;
+	window_freqs.resize(1 << ZSTD_DICTIONARY_HASH_BITS);
+	uint16_t *window_freq = window_freqs.ptrw();
+	zeromem(window_freq, window_freqs.size() * sizeof(uint16_t));
+
+	const int capacity = MIN(p_max_size, total);
+	dictionary.resize(capacity);
+	uint8_t *dict = dictionary.ptrw();
+	int tail = capacity;
+
+	// As in the COVER algorithm, the data is split in epochs and each one contributes its best
+	// segment in turn. Segments go from the end of the dictionary to the front, as zstd finds
+	// matches closest to the data cheaper.
+	int epochs = MAX(1, capacity / k / 4);
+	if (dmer_count / epochs < k) {
+		epochs = MAX(1, dmer_count / k);
+	}
+	const int epoch_size = dmer_count / epochs;
+	const int window_dmers = k - d + 1;
+
+	int fails = 0;
+	for (int epoch = 0; tail > 0 && fails < epochs; epoch = (epoch + 1) % epochs) {
+
+		int begin = epoch * epoch_size;
+		int end = epoch == epochs - 1 ? dmer_count : begin + epoch_size;
+
+		// Slide a segment sized window over the epoch, counting every d-mer in it once.
+		uint64_t score = 0;
+		uint64_t best_score = 0;
+		int best_begin = begin;
+		int best_end = begin;
+		int window_begin = begin;
+
+		for (int pos = begin; pos < end; pos++) {
+
+			uint32_t h = _hash_dmer(&src[pos]);
+			if (window_freq[h] == 0) {
+				score += freq[h];
+			}
+			window_freq[h]++;
+
+			if (pos - window_begin + 1 > window_dmers) {
+				uint32_t oh = _hash_dmer(&src[window_begin]);
+				window_freq[oh]--;
+				if (window_freq[oh] == 0) {
+					score -= freq[oh];
+				}
+				window_begin++;
+			}
+
+			if (score > best_score) {
+				best_score = score;
+				best_begin = window_begin;
+				best_end = pos + 1;
+			}
+		}
+
+		for (int pos = window_begin; pos < end; pos++) {
+			window_freq[_hash_dmer(&src[pos])] = 0;
+		}
+
+		// Trim d-mers the dictionary already covers.
+		while (best_begin < best_end && freq[_hash_dmer(&src[best_begin])] == 0) {
+			best_begin++;
+		}
+		while (best_end > best_begin && freq[_hash_dmer(&src[best_end - 1])] == 0) {
+			best_end--;
+		}
+		if (best_score == 0 || best_begin == best_end) {
+			fails++;
+			continue;
+		}
+		fails = 0;
+
+		for (int pos = best_begin; pos < best_end; pos++) {
+			freq[_hash_dmer(&src[pos])] = 0;
+		}
+
+		int segment_size = MIN(best_end - best_begin + d - 1, tail);
+		tail -= segment_size;
+		copymem(&dict[tail], &src[best_begin], segment_size);
+	}
+
+	if (tail > 0) {
+		Vector<uint8_t> trimmed;
+		trimmed.resize(capacity - tail);
+		copymem(trimmed.ptrw(), &dict[tail], capacity - tail);
+		return trimmed;
+	}
+
+	return dictionary;
+}
+
+uint32_t Compression::get_zstd_dictionary_id(const Vector<uint8_t> &p_dictionary) {
+
+	uint32_t id = hash_djb2_buffer(p_dictionary.ptr(), p_dictionary.size());
+	return id ? id : 1;
+}
+
+void Compression::add_zstd_dictionary(uint32_t p_id, const Vector<uint8_t> &p_dictionary) {
+
+	ERR_FAIL_COND(p_id == 0);
+	ERR_FAIL_COND(p_dictionary.empty());
+
+	ZSTD_DDict *ddict = ZSTD_createDDict(p_dictionary.ptr(), p_dictionary.size());
+	ERR_FAIL_COND(!ddict);
+
+	_zstd_dictionaries_lock();
+	if (!zstd_dictionaries) {
+		zstd_dictionaries = memnew((Map<uint32_t, ZstdDictionary>));
+	}
+	if (zstd_dictionaries->has(p_id)) {
+		// Same ID, same content.
+		_zstd_dictionaries_unlock();
+		ZSTD_freeDDict(ddict);
+		return;
+	}
+	ZstdDictionary &dictionary = (*zstd_dictionaries)[p_id];
+	dictionary.data = p_dictionary;
+	dictionary.cdict = NULL;
+	dictionary.ddict = ddict;
+	_zstd_dictionaries_unlock();
+}
+
+bool Compression::has_zstd_dictionary(uint32_t p_id) {
+
+	_zstd_dictionaries_lock();
+	bool found = zstd_dictionaries && zstd_dictionaries->has(p_id);
+	_zstd_dictionaries_unlock();
+	return found;
+}
+
+void Compression::remove_zstd_dictionary(uint32_t p_id) {
+
+	_zstd_dictionaries_lock();
+	Map<uint32_t, ZstdDictionary>::Element *E = zstd_dictionaries ? zstd_dictionaries->find(p_id) : NULL;
+	if (E) {
+		if (E->get().cdict) {
+			ZSTD_freeCDict(E->get().cdict);
+		}
+		ZSTD_freeDDict(E->get().ddict);
+		zstd_dictionaries->erase(E);
+	}
+	_zstd_dictionaries_unlock();
+}
+
+void Compression::clear_zstd_dictionaries() {
+
+	_zstd_dictionaries_lock();
+	if (zstd_dictionaries) {
+		for (Map<uint32_t, ZstdDictionary>::Element *E = zstd_dictionaries->front(); E; E = E->next()) {
+			if (E->get().cdict) {
+				ZSTD_freeCDict(E->get().cdict);
+			}
+			ZSTD_freeDDict(E->get().ddict);
+		}
+		memdelete(zstd_dictionaries);
+		zstd_dictionaries = NULL;
+	}
+	_zstd_dictionaries_unlock();
+}
+
 int Compression::zlib_level = Z_DEFAULT_COMPRESSION;
 int Compression::gzip_level = Z_DEFAULT_COMPRESSION;
 int Compression::zstd_level = 3;
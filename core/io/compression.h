@@ -32,6 +32,7 @@
 #define COMPRESSION_H
 
 #include "core/typedefs.h"
+#include "core/vector.h"
 
 class Compression {
 
@@ -49,9 +50,21 @@ public:
 		MODE_GZIP
 	};
 
-	static int compress(uint8_t *p_dst, const uint8_t *p_src, int p_src_size, Mode p_mode = MODE_ZSTD);
+	// p_zstd_dictionary is the id of a dictionary added with add_zstd_dictionary(), only used by MODE_ZSTD.
+	// Data compressed with a dictionary can only be decompressed with the same one.
+	static int compress(uint8_t *p_dst, const uint8_t *p_src, int p_src_size, Mode p_mode = MODE_ZSTD, uint32_t p_zstd_dictionary = 0);
 	static int get_max_compressed_buffer_size(int p_src_size, Mode p_mode = MODE_ZSTD);
-	static int decompress(uint8_t *p_dst, int p_dst_max_size, const uint8_t *p_src, int p_src_size, Mode p_mode = MODE_ZSTD);
+	static int decompress(uint8_t *p_dst, int p_dst_max_size, const uint8_t *p_src, int p_src_size, Mode p_mode = MODE_ZSTD, uint32_t p_zstd_dictionary = 0);
+
+	// Builds a raw content dictionary out of the byte sequences that are most common across the samples.
+	static Vector<uint8_t> train_zstd_dictionary(const Vector<Vector<uint8_t> > &p_samples, int p_max_size);
+	static uint32_t get_zstd_dictionary_id(const Vector<uint8_t> &p_dictionary); ///< derived from the content, never zero
+
+	// Dictionaries must not be removed while something still compresses with them.
+	static void add_zstd_dictionary(uint32_t p_id, const Vector<uint8_t> &p_dictionary);
+	static bool has_zstd_dictionary(uint32_t p_id);
+	static void remove_zstd_dictionary(uint32_t p_id);
+	static void clear_zstd_dictionaries();
 
 	Compression();
 };
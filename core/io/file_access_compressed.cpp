@@ -32,7 +32,7 @@
 
 #include "core/print_string.h"
 
-void FileAccessCompressed::configure(const String &p_magic, Compression::Mode p_mode, int p_block_size) {
+void FileAccessCompressed::configure(const String &p_magic, Compression::Mode p_mode, int p_block_size, uint32_t p_zstd_dictionary) {
 
 	magic = p_magic.ascii().get_data();
 	if (magic.length() > 4)
@@ -44,6 +44,7 @@ void FileAccessCompressed::configure(const String &p_magic, Compression::Mode p_
 
 	cmode = p_mode;
 	block_size = p_block_size;
+	zstd_dictionary = p_mode == Compression::MODE_ZSTD ? p_zstd_dictionary : 0;
 }
 
 #define WRITE_FIT(m_bytes)                                  \
@@ -61,7 +62,13 @@ void FileAccessCompressed::configure(const String &p_magic, Compression::Mode p_
 Error FileAccessCompressed::open_after_magic(FileAccess *p_base) {
 
 	f = p_base;
-	cmode = (Compression::Mode)f->get_32();
+	uint32_t mode = f->get_32();
+	zstd_dictionary = 0;
+	if (mode & MODE_FLAG_ZSTD_DICTIONARY) {
+		zstd_dictionary = f->get_32();
+		mode &= ~MODE_FLAG_ZSTD_DICTIONARY;
+	}
+	cmode = (Compression::Mode)mode;
 	block_size = f->get_32();
 	read_total = f->get_32();
 	int bc = (read_total / block_size) + 1;
@@ -86,7 +93,7 @@ Error FileAccessCompressed::open_after_magic(FileAccess *p_base) {
 	read_block_count = bc;
 	read_block_size = read_blocks.size() == 1 ? read_total : block_size;
 
-	Compression::decompress(buffer.ptrw(), read_block_size, comp_buffer.ptr(), read_blocks[0].csize, cmode);
+	Compression::decompress(buffer.ptrw(), read_block_size, comp_buffer.ptr(), read_blocks[0].csize, cmode, zstd_dictionary);
 	read_block = 0;
 	read_pos = 0;
 
@@ -146,7 +153,12 @@ void FileAccessCompressed::close() {
 
 		CharString mgc = magic.utf8();
 		f->store_buffer((const uint8_t *)mgc.get_data(), mgc.length()); //write header 4
-		f->store_32(cmode); //write compression mode 4
+		if (zstd_dictionary) {
+			f->store_32(cmode | MODE_FLAG_ZSTD_DICTIONARY); //write compression mode 4
+			f->store_32(zstd_dictionary); //write dictionary ID 4
+		} else {
+			f->store_32(cmode); //write compression mode 4
+		}
 		f->store_32(block_size); //write block size 4
 		f->store_32(write_max); //max amount of data written 4
 		int bc = (write_max / block_size) + 1;
@@ -163,13 +175,13 @@ void FileAccessCompressed::close() {
 
 			Vector<uint8_t> cblock;
 			cblock.resize(Compression::get_max_compressed_buffer_size(bl, cmode));
-			int s = Compression::compress(cblock.ptrw(), bp, bl, cmode);
+			int s = Compression::compress(cblock.ptrw(), bp, bl, cmode, zstd_dictionary);
 
 			f->store_buffer(cblock.ptr(), s);
 			block_sizes.push_back(s);
 		}
 
-		f->seek(16); //ok write block sizes
+		f->seek(zstd_dictionary ? 20 : 16); //ok write block sizes
 		for (int i = 0; i < bc; i++)
 			f->store_32(block_sizes[i]);
 		f->seek_end();
@@ -215,7 +227,7 @@ void FileAccessCompressed::seek(size_t p_position) {
 				read_block = block_idx;
 				f->seek(read_blocks[read_block].offset);
 				f->get_buffer(comp_buffer.ptrw(), read_blocks[read_block].csize);
-				Compression::decompress(buffer.ptrw(), read_blocks.size() == 1 ? read_total : block_size, comp_buffer.ptr(), read_blocks[read_block].csize, cmode);
+				Compression::decompress(buffer.ptrw(), read_blocks.size() == 1 ? read_total : block_size, comp_buffer.ptr(), read_blocks[read_block].csize, cmode, zstd_dictionary);
 				read_block_size = read_block == read_block_count - 1 ? read_total % block_size : block_size;
 			}
 
@@ -286,7 +298,7 @@ uint8_t FileAccessCompressed::get_8() const {
 		if (read_block < read_block_count) {
 			//read another block of compressed data
 			f->get_buffer(comp_buffer.ptrw(), read_blocks[read_block].csize);
-			Compression::decompress(buffer.ptrw(), read_blocks.size() == 1 ? read_total : block_size, comp_buffer.ptr(), read_blocks[read_block].csize, cmode);
+			Compression::decompress(buffer.ptrw(), read_blocks.size() == 1 ? read_total : block_size, comp_buffer.ptr(), read_blocks[read_block].csize, cmode, zstd_dictionary);
 			read_block_size = read_block == read_block_count - 1 ? read_total % block_size : block_size;
 			read_pos = 0;
 
@@ -318,7 +330,7 @@ int FileAccessCompressed::get_buffer(uint8_t *p_dst, int p_length) const {
 			if (read_block < read_block_count) {
 				//read another block of compressed data
 				f->get_buffer(comp_buffer.ptrw(), read_blocks[read_block].csize);
-				Compression::decompress(buffer.ptrw(), read_blocks.size() == 1 ? read_total : block_size, comp_buffer.ptr(), read_blocks[read_block].csize, cmode);
+				Compression::decompress(buffer.ptrw(), read_blocks.size() == 1 ? read_total : block_size, comp_buffer.ptr(), read_blocks[read_block].csize, cmode, zstd_dictionary);
 				read_block_size = read_block == read_block_count - 1 ? read_total % block_size : block_size;
 				read_pos = 0;
 
@@ -375,6 +387,7 @@ uint64_t FileAccessCompressed::_get_modified_time(const String &p_file) {
 
 FileAccessCompressed::FileAccessCompressed() :
 		cmode(Compression::MODE_ZSTD),
+		zstd_dictionary(0),
 		writing(false),
 		write_ptr(0),
 		write_buffer_size(0),
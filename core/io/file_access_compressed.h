@@ -36,7 +36,14 @@
 
 class FileAccessCompressed : public FileAccess {
 
+public:
+	enum {
+		MODE_FLAG_ZSTD_DICTIONARY = 0x80000000 // the dictionary ID follows the mode
+	};
+
+private:
 	Compression::Mode cmode;
+	uint32_t zstd_dictionary;
 	bool writing;
 	uint32_t write_pos;
 	uint8_t *write_ptr;
@@ -65,7 +72,7 @@ class FileAccessCompressed : public FileAccess {
 	FileAccess *f;
 
 public:
-	void configure(const String &p_magic, Compression::Mode p_mode = Compression::MODE_ZSTD, int p_block_size = 4096);
+	void configure(const String &p_magic, Compression::Mode p_mode = Compression::MODE_ZSTD, int p_block_size = 4096, uint32_t p_zstd_dictionary = 0);
 
 	Error open_after_magic(FileAccess *p_base);
 
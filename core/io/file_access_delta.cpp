@@ -0,0 +1,335 @@
+/*************************************************************************/
+/*  file_access_delta.cpp                                                */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2019 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2019 Godot Engine contributors (cf. AUTHORS.md)    */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#include "file_access_delta.h"
+
+#include "core/hash_map.h"
+#include "core/io/marshalls.h"
+
+#define DELTA_BLOCK_SIZE 64
+#define DELTA_HASH_PRIME 16777619
+#define DELTA_OP_SIZE 32
+
+static void _delta_add_op(Vector<uint8_t> &r_ops, int &r_op_count, uint64_t p_target_ofs, uint64_t p_length, uint64_t p_source_ofs, bool p_literal) {
+
+	if (p_length == 0)
+		return;
+
+	int ofs = r_ops.size();
+	r_ops.resize(ofs + DELTA_OP_SIZE);
+	uint8_t *w = &r_ops.ptrw()[ofs];
+	encode_uint64(p_target_ofs, &w[0]);
+	encode_uint64(p_length, &w[8]);
+	encode_uint64(p_source_ofs, &w[16]);
+	encode_uint32(p_literal ? 1 : 0, &w[24]);
+	encode_uint32(0, &w[28]);
+	r_op_count++;
+}
+
+Vector<uint8_t> FileAccessDelta::make_delta(const Vector<uint8_t> &p_base, const Vector<uint8_t> &p_target) {
+
+	const uint8_t *base_ptr = p_base.ptr();
+	const uint8_t *target_ptr = p_target.ptr();
+	int base_size = p_base.size();
+	int target_size = p_target.size();
+
+	uint32_t roll_out = 1; //weight of the byte leaving the window
+	for (int i = 0; i < DELTA_BLOCK_SIZE - 1; i++) {
+		roll_out *= DELTA_HASH_PRIME;
+	}
+
+	//index the base in aligned blocks, matches are then looked up at every target offset
+	HashMap<uint32_t, uint32_t> blocks;
+	for (int ofs = 0; ofs + DELTA_BLOCK_SIZE <= base_size; ofs += DELTA_BLOCK_SIZE) {
+
+		uint32_t h = 0;
+		for (int i = 0; i < DELTA_BLOCK_SIZE; i++) {
+			h = h * DELTA_HASH_PRIME + base_ptr[ofs + i];
+		}
+		if (!blocks.has(h)) {
+			blocks[h] = ofs;
+		}
+	}
+
+	Vector<uint8_t> ops;
+	Vector<uint8_t> literals;
+	int op_count = 0;
+
+	int pos = 0;
+	int literal_start = 0;
+	uint32_t h = 0;
+	bool hash_valid = false;
+
+	while (pos + DELTA_BLOCK_SIZE <= target_size) {
+
+		if (!hash_valid) {
+			h = 0;
+			for (int i = 0; i < DELTA_BLOCK_SIZE; i++) {
+				h = h * DELTA_HASH_PRIME + target_ptr[pos + i];
+			}
+			hash_valid = true;
+		}
+
+		const uint32_t *match = blocks.getptr(h);
+		if (match && memcmp(&base_ptr[*match], &target_ptr[pos], DELTA_BLOCK_SIZE) == 0) {
+
+			int len = DELTA_BLOCK_SIZE;
+			while (pos + len < target_size && int(*match) + len < base_size && base_ptr[*match + len] == target_ptr[pos + len]) {
+				len++;
+			}
+
+			if (pos > literal_start) {
+				_delta_add_op(ops, op_count, literal_start, pos - literal_start, literals.size(), true);
+				int lofs = literals.size();
+				literals.resize(lofs + pos - literal_start);
+				copymem(&literals.ptrw()[lofs], &target_ptr[literal_start], pos - literal_start);
+			}
+			_delta_add_op(ops, op_count, pos, len, *match, false);
+
+			pos += len;
+			literal_start = pos;
+			hash_valid = false;
+			continue;
+		}
+
+		if (pos + DELTA_BLOCK_SIZE < target_size) {
+			h = (h - target_ptr[pos] * roll_out) * DELTA_HASH_PRIME + target_ptr[pos + DELTA_BLOCK_SIZE];
+		}
+		pos++;
+	}
+
+	if (target_size > literal_start) {
+		_delta_add_op(ops, op_count, literal_start, target_size - literal_start, literals.size(), true);
+		int lofs = literals.size();
+		literals.resize(lofs + target_size - literal_start);
+		copymem(&literals.ptrw()[lofs], &target_ptr[literal_start], target_size - literal_start);
+	}
+
+	Vector<uint8_t> out;
+	out.resize(24 + ops.size() + literals.size());
+	uint8_t *w = out.ptrw();
+	copymem(w, "GDDL", 4);
+	encode_uint32(op_count, &w[4]);
+	encode_uint64(base_size, &w[8]);
+	encode_uint64(target_size, &w[16]);
+	if (ops.size()) {
+		copymem(&w[24], ops.ptr(), ops.size());
+	}
+	if (literals.size()) {
+		copymem(&w[24 + ops.size()], literals.ptr(), literals.size());
+	}
+
+	return out;
+}
+
+Error FileAccessDelta::open_delta(FileAccess *p_base, FileAccess *p_delta) {
+
+	base = p_base;
+	delta = p_delta;
+
+	uint8_t magic[4];
+	delta->get_buffer(magic, 4);
+	if (memcmp(magic, "GDDL", 4) != 0) {
+		close();
+		ERR_FAIL_V(ERR_FILE_UNRECOGNIZED);
+	}
+
+	uint32_t op_count = delta->get_32();
+	uint64_t base_size = delta->get_64();
+	length = delta->get_64();
+
+	if (base->get_len() != base_size) {
+		close();
+		ERR_EXPLAIN("Delta was made against a different base file.");
+		ERR_FAIL_V(ERR_FILE_CORRUPT);
+	}
+
+	ops.resize(op_count);
+	for (uint32_t i = 0; i < op_count; i++) {
+
+		Op &op = ops.write[i];
+		op.target_ofs = delta->get_64();
+		op.length = delta->get_64();
+		op.source_ofs = delta->get_64();
+		op.literal = delta->get_32() != 0;
+		delta->get_32(); //reserved
+	}
+
+	literal_ofs = delta->get_position();
+	pos = 0;
+	eof = false;
+
+	return OK;
+}
+
+int FileAccessDelta::_find_op(uint64_t p_pos) const {
+
+	int low = 0;
+	int high = ops.size() - 1;
+
+	while (low <= high) {
+
+		int mid = (low + high) / 2;
+		const Op &op = ops[mid];
+		if (p_pos < op.target_ofs) {
+			high = mid - 1;
+		} else if (p_pos >= op.target_ofs + op.length) {
+			low = mid + 1;
+		} else {
+			return mid;
+		}
+	}
+
+	return -1;
+}
+
+Error FileAccessDelta::_open(const String &p_path, int p_mode_flags) {
+
+	ERR_FAIL_V(ERR_UNAVAILABLE);
+}
+
+void FileAccessDelta::close() {
+
+	if (base) {
+		memdelete(base);
+		base = NULL;
+	}
+	if (delta) {
+		memdelete(delta);
+		delta = NULL;
+	}
+	ops.clear();
+}
+
+bool FileAccessDelta::is_open() const {
+
+	return delta != NULL;
+}
+
+void FileAccessDelta::seek(size_t p_position) {
+
+	ERR_FAIL_COND(!delta);
+	eof = p_position > length;
+	pos = p_position;
+}
+
+void FileAccessDelta::seek_end(int64_t p_position) {
+
+	seek(length + p_position);
+}
+
+size_t FileAccessDelta::get_position() const {
+
+	return pos;
+}
+
+size_t FileAccessDelta::get_len() const {
+
+	return length;
+}
+
+bool FileAccessDelta::eof_reached() const {
+
+	return eof;
+}
+
+uint8_t FileAccessDelta::get_8() const {
+
+	uint8_t b = 0;
+	get_buffer(&b, 1);
+	return b;
+}
+
+int FileAccessDelta::get_buffer(uint8_t *p_dst, int p_length) const {
+
+	ERR_FAIL_COND_V(!delta, -1);
+
+	int read = 0;
+	while (read < p_length) {
+
+		if (pos >= length) {
+			eof = true;
+			break;
+		}
+
+		int idx = _find_op(pos);
+		ERR_FAIL_COND_V(idx < 0, read);
+
+		const Op &op = ops[idx];
+		uint64_t in_op = pos - op.target_ofs;
+		int n = MIN(uint64_t(p_length - read), op.length - in_op);
+
+		FileAccess *src = op.literal ? delta : base;
+		src->seek((op.literal ? literal_ofs : 0) + op.source_ofs + in_op);
+		int got = src->get_buffer(&p_dst[read], n);
+		if (got <= 0)
+			break;
+
+		read += got;
+		pos += got;
+	}
+
+	return read;
+}
+
+Error FileAccessDelta::get_error() const {
+
+	return eof ? ERR_FILE_EOF : OK;
+}
+
+void FileAccessDelta::flush() {
+
+	ERR_FAIL();
+}
+
+void FileAccessDelta::store_8(uint8_t p_dest) {
+
+	ERR_FAIL();
+}
+
+bool FileAccessDelta::file_exists(const String &p_name) {
+
+	return false;
+}
+
+FileAccessDelta::FileAccessDelta() {
+
+	base = NULL;
+	delta = NULL;
+	literal_ofs = 0;
+	length = 0;
+	pos = 0;
+	eof = false;
+}
+
+FileAccessDelta::~FileAccessDelta() {
+
+	close();
+}
@@ -0,0 +1,91 @@
+/*************************************************************************/
+/*  file_access_delta.h                                                  */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2019 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2019 Godot Engine contributors (cf. AUTHORS.md)    */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#ifndef FILE_ACCESS_DELTA_H
+#define FILE_ACCESS_DELTA_H
+
+#include "core/os/file_access.h"
+
+// Reads a file rebuilt from a base file and a binary delta against it. The delta is a
+// list of operations copying ranges either from the base or from literal bytes stored
+// after them, so reads are resolved lazily and nothing is patched in place.
+class FileAccessDelta : public FileAccess {
+
+	struct Op {
+		uint64_t target_ofs;
+		uint64_t length;
+		uint64_t source_ofs;
+		bool literal;
+	};
+
+	FileAccess *base;
+	FileAccess *delta;
+	Vector<Op> ops;
+	uint64_t literal_ofs;
+	uint64_t length;
+
+	mutable uint64_t pos;
+	mutable bool eof;
+
+	int _find_op(uint64_t p_pos) const;
+
+public:
+	static Vector<uint8_t> make_delta(const Vector<uint8_t> &p_base, const Vector<uint8_t> &p_target);
+
+	Error open_delta(FileAccess *p_base, FileAccess *p_delta); ///< takes ownership of both files, the delta positioned at its magic
+
+	virtual Error _open(const String &p_path, int p_mode_flags); ///< open a file
+	virtual void close(); ///< close a file
+	virtual bool is_open() const; ///< true when file is open
+
+	virtual void seek(size_t p_position); ///< seek to a given position
+	virtual void seek_end(int64_t p_position = 0); ///< seek from the end of file
+	virtual size_t get_position() const; ///< get position in the file
+	virtual size_t get_len() const; ///< get size of the file
+
+	virtual bool eof_reached() const; ///< reading passed EOF
+
+	virtual uint8_t get_8() const; ///< get a byte
+	virtual int get_buffer(uint8_t *p_dst, int p_length) const;
+
+	virtual Error get_error() const; ///< get last error
+
+	virtual void flush();
+	virtual void store_8(uint8_t p_dest); ///< store a byte
+
+	virtual bool file_exists(const String &p_name); ///< return true if a file exists
+
+	virtual uint64_t _get_modified_time(const String &p_file) { return 0; }
+
+	FileAccessDelta();
+	virtual ~FileAccessDelta();
+};
+
+#endif // FILE_ACCESS_DELTA_H
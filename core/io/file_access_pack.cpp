@@ -30,11 +30,14 @@
 
 #include "file_access_pack.h"
 
+#include "core/io/compression.h"
+#include "core/io/file_access_compressed.h"
+#include "core/io/file_access_delta.h"
+#include "core/io/marshalls.h"
 #include "core/version.h"
 
 #include <stdio.h>
-
-#define PACK_VERSION 1
+#include <string.h>
 
 Error PackedData::add_pack(const String &p_path) {
 
@@ -63,38 +66,164 @@ void PackedData::add_path(const String &pkg_path, const String &path, uint64_t o
 	for (int i = 0; i < 16; i++)
 		pf.md5[i] = p_md5[i];
 	pf.src = p_src;
+	pf.compressed = false;
+	pf.delta = false;
+	pf.delta_base = NULL;
 
 	files[pmd5] = pf;
 
 	if (!exists) {
-		//search for dir
-		String p = path.replace_first("res://", "");
-		PackedDir *cd = root;
+		_add_dir_path(path);
+	}
+}
+
+void PackedData::_add_dir_path(const String &p_path) {
+
+	//search for dir
+	String p = p_path.replace_first("res://", "");
+	PackedDir *cd = root;
+
+	if (p.find("/") != -1) { //in a subdir
+
+		Vector<String> ds = p.get_base_dir().split("/");
+
+		for (int j = 0; j < ds.size(); j++) {
+
+			if (!cd->subdirs.has(ds[j])) {
+
+				PackedDir *pd = memnew(PackedDir);
+				pd->name = ds[j];
+				pd->parent = cd;
+				cd->subdirs[pd->name] = pd;
+				cd = pd;
+			} else {
+				cd = cd->subdirs[ds[j]];
+			}
+		}
+	}
+	String filename = p_path.get_file();
+	// Don't add as a file if the path points to a directoryy
+	if (!filename.empty()) {
+		cd->files.insert(filename);
+	}
+}
+
+void PackedData::add_pack_index(PackIndex *p_index) {
 
-		if (p.find("/") != -1) { //in a subdir
+	//deltas apply on whatever the path resolves to right now, so resolve once here
+	for (uint32_t i = 0; i < p_index->count; i++) {
 
-			Vector<String> ds = p.get_base_dir().split("/");
+		const uint8_t *e = p_index->entries + i * PACK_INDEX_ENTRY_SIZE;
+		if (!(decode_uint32(&e[32]) & PACK_FILE_DELTA))
+			continue;
 
-			for (int j = 0; j < ds.size(); j++) {
+		Vector<uint8_t> md5;
+		md5.resize(16);
+		copymem(md5.ptrw(), e, 16);
 
-				if (!cd->subdirs.has(ds[j])) {
+		PackedFile base;
+		Map<PathMD5, PackedFile>::Element *E = files.find(PathMD5(md5));
+		if (E) {
+			base = E->get();
+		} else if (!_find_indexed(md5, &base)) {
+			ERR_PRINTS("Pack '" + p_index->pack + "' has a delta for a file that is not in any pack mounted before it.");
+			continue;
+		}
+		if (base.offset == 0) {
+			continue; //erased
+		}
+
+		p_index->delta_bases[i] = base;
+	}
 
-					PackedDir *pd = memnew(PackedDir);
-					pd->name = ds[j];
-					pd->parent = cd;
-					cd->subdirs[pd->name] = pd;
-					cd = pd;
-				} else {
-					cd = cd->subdirs[ds[j]];
+	//entries of this pack override the ones added before it
+	if (!files.empty()) {
+		for (uint32_t i = 0; i < p_index->count; i++) {
+			const uint8_t *e = p_index->entries + i * PACK_INDEX_ENTRY_SIZE;
+			Vector<uint8_t> md5;
+			md5.resize(16);
+			copymem(md5.ptrw(), e, 16);
+			files.erase(PathMD5(md5));
+		}
+	}
+
+	p_index->dirs_added = false;
+	indexes.push_back(p_index);
+}
+
+bool PackedData::_find_indexed(const Vector<uint8_t> &p_path_md5, PackedFile *r_file) const {
+
+	//newest pack first, as it overrides the older ones
+	for (int i = indexes.size() - 1; i >= 0; i--) {
+
+		const PackIndex *index = indexes[i];
+		uint32_t low = 0;
+		uint32_t high = index->count;
+
+		while (low < high) {
+
+			uint32_t mid = (low + high) / 2;
+			const uint8_t *e = index->entries + mid * PACK_INDEX_ENTRY_SIZE;
+			int cmp = memcmp(e, p_path_md5.ptr(), 16);
+
+			if (cmp < 0) {
+				low = mid + 1;
+			} else if (cmp > 0) {
+				high = mid;
+			} else {
+
+				if (r_file) {
+					r_file->pack = index->pack;
+					r_file->offset = decode_uint64(&e[16]);
+					r_file->size = decode_uint64(&e[24]);
+					uint32_t flags = decode_uint32(&e[32]);
+					r_file->compressed = flags & PACK_FILE_COMPRESSED;
+					r_file->delta = flags & PACK_FILE_DELTA;
+					r_file->delta_base = NULL;
+					if (r_file->delta) {
+						const Map<uint32_t, PackedFile>::Element *B = index->delta_bases.find(mid);
+						if (B) {
+							r_file->delta_base = &B->get();
+						}
+					}
+					copymem(r_file->md5, &e[48], 16);
+					r_file->src = index->src;
 				}
+				return true;
 			}
 		}
-		String filename = path.get_file();
-		// Don't add as a file if the path points to a directoryy
-		if (!filename.empty()) {
-			cd->files.insert(filename);
+	}
+
+	return false;
+}
+
+void PackedData::_update_packed_dirs() {
+
+	//directories of indexed packs are only built once something lists them
+	dirs_mutex->lock();
+
+	for (int i = 0; i < indexes.size(); i++) {
+
+		PackIndex *index = indexes[i];
+		if (index->dirs_added)
+			continue;
+
+		for (uint32_t j = 0; j < index->count; j++) {
+
+			const uint8_t *e = index->entries + j * PACK_INDEX_ENTRY_SIZE;
+			uint32_t path_ofs = decode_uint32(&e[36]);
+			uint32_t path_len = decode_uint32(&e[40]);
+			ERR_CONTINUE(path_ofs + path_len > index->paths_size);
+
+			String path;
+			path.parse_utf8((const char *)&index->paths[path_ofs], path_len);
+			_add_dir_path(path);
 		}
+
+		index->dirs_added = true;
 	}
+
+	dirs_mutex->unlock();
 }
 
 void PackedData::add_pack_source(PackSource *p_source) {
@@ -112,6 +241,7 @@ PackedData::PackedData() {
 	root = memnew(PackedDir);
 	root->parent = NULL;
 	disabled = false;
+	dirs_mutex = Mutex::create();
 
 	add_pack_source(memnew(PackedSourcePCK));
 }
@@ -128,7 +258,14 @@ PackedData::~PackedData() {
 	for (int i = 0; i < sources.size(); i++) {
 		memdelete(sources[i]);
 	}
+	for (int i = 0; i < indexes.size(); i++) {
+		if (indexes[i]->mapping) {
+			memdelete(indexes[i]->mapping);
+		}
+		memdelete(indexes[i]);
+	}
 	_free_packed_dirs(root);
+	memdelete(dirs_mutex);
 }
 
 //////////////////////////////////////////////////////////////////
@@ -171,8 +308,11 @@ bool PackedSourcePCK::try_open_pack(const String &p_path) {
 	uint32_t ver_minor = f->get_32();
 	f->get_32(); // ver_rev
 
-	ERR_EXPLAIN("Pack version unsupported: " + itos(version));
-	ERR_FAIL_COND_V(version != PACK_VERSION, false);
+	if (version != 1 && version != PACK_FORMAT_VERSION) {
+		memdelete(f);
+		ERR_EXPLAIN("Pack version unsupported: " + itos(version));
+		ERR_FAIL_V(false);
+	}
 	ERR_EXPLAIN("Pack created with a newer version of the engine: " + itos(ver_major) + "." + itos(ver_minor));
 	ERR_FAIL_COND_V(ver_major > VERSION_MAJOR || (ver_major == VERSION_MAJOR && ver_minor > VERSION_MINOR), false);
 
@@ -183,6 +323,40 @@ bool PackedSourcePCK::try_open_pack(const String &p_path) {
 
 	int file_count = f->get_32();
 
+	if (version == PACK_FORMAT_VERSION) {
+
+		uint32_t paths_size = f->get_32();
+		uint64_t table_size = uint64_t(file_count) * PACK_INDEX_ENTRY_SIZE + paths_size;
+
+		PackedData::PackIndex *index = memnew(PackedData::PackIndex);
+		index->pack = p_path;
+		index->src = this;
+		index->count = file_count;
+		index->paths_size = paths_size;
+		index->mapping = NULL;
+
+		const uint8_t *table = f->map_buffer(table_size, &index->mapping);
+		if (!table) {
+			index->data.resize(table_size);
+			int read = f->get_buffer(index->data.ptrw(), table_size);
+			if (uint64_t(read) != table_size) {
+				memdelete(index);
+				memdelete(f);
+				ERR_EXPLAIN("Pack directory is truncated: " + p_path);
+				ERR_FAIL_V(false);
+			}
+			table = index->data.ptr();
+		}
+
+		index->entries = table;
+		index->paths = table + uint64_t(file_count) * PACK_INDEX_ENTRY_SIZE;
+
+		memdelete(f);
+		PackedData::get_singleton()->add_pack_index(index);
+		_load_zstd_dictionaries();
+		return true;
+	}
+
 	for (int i = 0; i < file_count; i++) {
 
 		uint32_t sl = f->get_32();
@@ -201,12 +375,81 @@ bool PackedSourcePCK::try_open_pack(const String &p_path) {
 		PackedData::get_singleton()->add_path(p_path, path, ofs, size, md5, this);
 	};
 
+	_load_zstd_dictionaries();
+
 	return true;
 };
 
+void PackedSourcePCK::_load_zstd_dictionaries() {
+
+	//looked up after the pack was added, so this finds the one it carries, if any
+	FileAccess *f = PackedData::get_singleton()->try_open_path(PACK_ZSTD_DICTIONARIES_PATH);
+	if (!f)
+		return;
+
+	uint32_t count = f->get_32();
+	for (uint32_t i = 0; i < count; i++) {
+
+		uint32_t id = f->get_32();
+		uint32_t size = f->get_32();
+		Vector<uint8_t> data;
+		data.resize(size);
+		if (f->eof_reached() || f->get_buffer(data.ptrw(), size) != int(size)) {
+			ERR_PRINT("Zstandard dictionaries in pack are truncated.");
+			break;
+		}
+		Compression::add_zstd_dictionary(id, data);
+	}
+
+	memdelete(f);
+}
+
+FileAccess *PackedSourcePCK::_open_stored(const String &p_path, PackedData::PackedFile *p_file) {
+
+	FileAccess *fa = memnew(FileAccessPack(p_path, *p_file));
+	if (!p_file->compressed)
+		return fa;
+
+	//stored as compressed blocks, so seeking only inflates the block it lands on
+	uint8_t magic[4];
+	fa->get_buffer(magic, 4);
+	if (memcmp(magic, "GCPF", 4) != 0) {
+		memdelete(fa);
+		ERR_EXPLAIN("Corrupt compressed file in pack: " + p_path);
+		ERR_FAIL_V(NULL);
+	}
+
+	FileAccessCompressed *fac = memnew(FileAccessCompressed);
+	fac->configure("GCPF");
+	fac->open_after_magic(fa);
+	return fac;
+};
+
 FileAccess *PackedSourcePCK::get_file(const String &p_path, PackedData::PackedFile *p_file) {
 
-	return memnew(FileAccessPack(p_path, *p_file));
+	FileAccess *fa = _open_stored(p_path, p_file);
+	if (!fa || !p_file->delta)
+		return fa;
+
+	if (!p_file->delta_base) {
+		memdelete(fa);
+		ERR_EXPLAIN("Delta in pack has no base file to apply on: " + p_path);
+		ERR_FAIL_V(NULL);
+	}
+
+	PackedData::PackedFile base_file = *p_file->delta_base;
+	FileAccess *base = base_file.src->get_file(p_path, &base_file);
+	if (!base) {
+		memdelete(fa);
+		return NULL;
+	}
+
+	FileAccessDelta *fad = memnew(FileAccessDelta);
+	if (fad->open_delta(base, fa) != OK) {
+		memdelete(fad);
+		return NULL;
+	}
+	return fad;
 };
 
 //////////////////////////////////////////////////////////////////
@@ -287,6 +530,37 @@ int FileAccessPack::get_buffer(uint8_t *p_dst, int p_length) const {
 	return to_read;
 }
 
+uint8_t *FileAccessPack::map_buffer(uint64_t p_length, MemoryPool::ExternalMemory **r_owner) const {
+
+	if (eof || pos + p_length > pf.size)
+		return NULL;
+
+	uint8_t *mem = f->map_buffer(p_length, r_owner);
+	if (mem) {
+		pos += p_length;
+	}
+	return mem;
+}
+
+Error FileAccessPack::_read_async(AsyncRead *p_read) {
+
+	if (p_read->file_offset >= pf.size) {
+		_complete_async_read(p_read, 0);
+		return OK;
+	}
+
+	// The read goes straight to the pack, so many can be in flight.
+	p_read->file_length = MIN(uint64_t(p_read->file_length), pf.size - p_read->file_offset);
+	p_read->file_offset += pf.offset;
+	p_read->file = f;
+	return f->_read_async(p_read);
+}
+
+bool FileAccessPack::is_async_read_supported() const {
+
+	return f->is_async_read_supported();
+}
+
 void FileAccessPack::set_endian_swap(bool p_swap) {
 	FileAccess::set_endian_swap(p_swap);
 	f->set_endian_swap(p_swap);
@@ -342,6 +616,8 @@ FileAccessPack::~FileAccessPack() {
 
 Error DirAccessPack::list_dir_begin() {
 
+	PackedData::get_singleton()->_update_packed_dirs();
+
 	list_dirs.clear();
 	list_files.clear();
 
@@ -399,6 +675,8 @@ String DirAccessPack::get_drive(int p_drive) {
 
 Error DirAccessPack::change_dir(String p_dir) {
 
+	PackedData::get_singleton()->_update_packed_dirs();
+
 	String nd = p_dir.replace("\\", "/");
 	bool absolute = false;
 	if (nd.begins_with("res://")) {
@@ -496,6 +774,7 @@ String DirAccessPack::get_filesystem_type() const {
 
 DirAccessPack::DirAccessPack() {
 
+	PackedData::get_singleton()->_update_packed_dirs();
 	current = PackedData::get_singleton()->root;
 	cdir = false;
 }
@@ -35,8 +35,17 @@
 #include "core/map.h"
 #include "core/os/dir_access.h"
 #include "core/os/file_access.h"
+#include "core/os/mutex.h"
 #include "core/print_string.h"
 
+// Version 2 packs store the directory as a table of fixed size entries sorted by
+// path MD5, followed by the path strings, so it can be mapped and searched in place.
+#define PACK_FORMAT_VERSION 2
+#define PACK_INDEX_ENTRY_SIZE 64
+
+// Zstandard dictionaries compressed files were made with: count, then ID, size and data of each.
+#define PACK_ZSTD_DICTIONARIES_PATH "res://.zstd_dictionaries"
+
 class PackSource;
 
 class PackedData {
@@ -52,6 +61,29 @@ public:
 		uint64_t size;
 		uint8_t md5[16];
 		PackSource *src;
+		bool compressed; //stored as a FileAccessCompressed stream
+		bool delta; //stored as a FileAccessDelta against the file it overrides
+		const PackedFile *delta_base; //resolved when the pack is added
+	};
+
+	enum {
+		PACK_FILE_COMPRESSED = 1,
+		PACK_FILE_DELTA = 2
+	};
+
+	// Entry layout: path MD5 (16), offset (8), size (8), flags (4), path offset (4),
+	// path length (4), reserved (4), file MD5 (16). Integers are little endian.
+	struct PackIndex {
+		String pack;
+		PackSource *src;
+		const uint8_t *entries;
+		uint32_t count;
+		const uint8_t *paths;
+		uint32_t paths_size;
+		Vector<uint8_t> data; //table copy, when it could not be mapped
+		MemoryPool::ExternalMemory *mapping;
+		bool dirs_added;
+		Map<uint32_t, PackedFile> delta_bases; //by entry, what each delta applies on
 	};
 
 private:
@@ -89,6 +121,7 @@ private:
 	};
 
 	Map<PathMD5, PackedFile> files;
+	Vector<PackIndex *> indexes;
 
 	Vector<PackSource *> sources;
 
@@ -98,10 +131,16 @@ private:
 	static PackedData *singleton;
 	bool disabled;
 
+	Mutex *dirs_mutex;
+
 	void _free_packed_dirs(PackedDir *p_dir);
+	void _add_dir_path(const String &p_path);
+	void _update_packed_dirs();
+	bool _find_indexed(const Vector<uint8_t> &p_path_md5, PackedFile *r_file) const;
 
 public:
 	void add_pack_source(PackSource *p_source);
+	void add_pack_index(PackIndex *p_index); // for PackSource, takes ownership
 	void add_path(const String &pkg_path, const String &path, uint64_t ofs, uint64_t size, const uint8_t *p_md5, PackSource *p_src); // for PackSource
 
 	void set_disabled(bool p_disabled) { disabled = p_disabled; }
@@ -127,6 +166,9 @@ public:
 
 class PackedSourcePCK : public PackSource {
 
+	FileAccess *_open_stored(const String &p_path, PackedData::PackedFile *p_file);
+	void _load_zstd_dictionaries();
+
 public:
 	virtual bool try_open_pack(const String &p_path);
 	virtual FileAccess *get_file(const String &p_path, PackedData::PackedFile *p_file);
@@ -157,6 +199,9 @@ public:
 	virtual uint8_t get_8() const;
 
 	virtual int get_buffer(uint8_t *p_dst, int p_length) const;
+	virtual uint8_t *map_buffer(uint64_t p_length, MemoryPool::ExternalMemory **r_owner) const;
+	virtual Error _read_async(AsyncRead *p_read);
+	virtual bool is_async_read_supported() const;
 
 	virtual void set_endian_swap(bool p_swap);
 
@@ -175,10 +220,17 @@ public:
 
 FileAccess *PackedData::try_open_path(const String &p_path) {
 
-	PathMD5 pmd5(p_path.md5_buffer());
-	Map<PathMD5, PackedFile>::Element *E = files.find(pmd5);
-	if (!E)
-		return NULL; //not found
+	Vector<uint8_t> md5 = p_path.md5_buffer();
+	Map<PathMD5, PackedFile>::Element *E = files.find(PathMD5(md5));
+	if (!E) {
+		PackedFile pf;
+		if (!_find_indexed(md5, &pf))
+			return NULL; //not found
+		if (pf.offset == 0)
+			return NULL; //was erased
+
+		return pf.src->get_file(p_path, &pf);
+	}
 	if (E->get().offset == 0)
 		return NULL; //was erased
 
@@ -187,7 +239,8 @@ FileAccess *PackedData::try_open_path(const String &p_path) {
 
 bool PackedData::has_path(const String &p_path) {
 
-	return files.has(PathMD5(p_path.md5_buffer()));
+	Vector<uint8_t> md5 = p_path.md5_buffer();
+	return files.has(PathMD5(md5)) || _find_indexed(md5, NULL);
 }
 
 class DirAccessPack : public DirAccess {
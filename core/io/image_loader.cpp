@@ -30,6 +30,8 @@
 
 #include "image_loader.h"
 
+#include "core/message_queue.h"
+#include "core/os/threaded_array_processor.h"
 #include "core/print_string.h"
 
 bool ImageFormatLoader::recognize(const String &p_extension) const {
@@ -81,6 +83,101 @@ Error ImageLoader::load_image(String p_file, Ref<Image> p_image, FileAccess *p_c
 	return ERR_FILE_UNRECOGNIZED;
 }
 
+void ImageLoader::AsyncBatch::decode(uint32_t p_index, void *p_userdata) {
+
+	AsyncLoad &load = loads[p_index];
+	load.image.instance();
+	load.error = load_image(load.file, load.image, NULL, load.force_linear, load.scale);
+	if (load.error != OK) {
+		load.image.unref();
+	}
+}
+
+void ImageLoader::_async_deliver(Vector<AsyncLoad> &p_loads) {
+
+	//decode the whole batch at once, one image per worker
+	AsyncBatch batch;
+	batch.loads = p_loads.ptrw();
+	thread_process_array(p_loads.size(), &batch, &AsyncBatch::decode, (void *)NULL);
+
+	for (int i = 0; i < p_loads.size(); i++) {
+		const AsyncLoad &load = p_loads[i];
+		MessageQueue::get_singleton()->push_call(load.target, load.method, load.file, load.image, load.error);
+	}
+}
+
+void ImageLoader::_async_thread_function(void *p_userdata) {
+
+	while (true) {
+
+		async_semaphore->wait();
+
+		async_mutex->lock();
+		if (async_exit) {
+			async_mutex->unlock();
+			break;
+		}
+		Vector<AsyncLoad> batch = async_queue;
+		async_queue.clear();
+		async_mutex->unlock();
+
+		if (batch.size()) {
+			_async_deliver(batch);
+		}
+	}
+}
+
+Error ImageLoader::load_image_async(const String &p_file, Object *p_target, const StringName &p_method, bool p_force_linear, float p_scale) {
+
+	ERR_FAIL_NULL_V(p_target, ERR_INVALID_PARAMETER);
+
+	AsyncLoad load;
+	load.file = p_file;
+	load.target = p_target->get_instance_id();
+	load.method = p_method;
+	load.force_linear = p_force_linear;
+	load.scale = p_scale;
+	load.error = OK;
+
+#ifdef NO_THREADS
+	Vector<AsyncLoad> batch;
+	batch.push_back(load);
+	_async_deliver(batch);
+#else
+	async_mutex->lock();
+	if (!async_thread) {
+		async_thread = Thread::create(_async_thread_function, NULL);
+	}
+	async_queue.push_back(load);
+	async_mutex->unlock();
+
+	async_semaphore->post();
+#endif
+
+	return OK;
+}
+
+void ImageLoader::clear_async_loads() {
+
+	if (!async_mutex)
+		return;
+
+	async_mutex->lock();
+	async_exit = true;
+	async_queue.clear();
+	Thread *thread = async_thread;
+	async_thread = NULL;
+	async_mutex->unlock();
+
+	if (thread) {
+		async_semaphore->post();
+		Thread::wait_to_finish(thread);
+		memdelete(thread);
+	}
+
+	async_exit = false;
+}
+
 void ImageLoader::get_recognized_extensions(List<String> *p_extensions) {
 
 	for (int i = 0; i < loader.size(); i++) {
@@ -102,6 +199,12 @@ ImageFormatLoader *ImageLoader::recognize(const String &p_extension) {
 
 Vector<ImageFormatLoader *> ImageLoader::loader;
 
+Mutex *ImageLoader::async_mutex = NULL;
+Semaphore *ImageLoader::async_semaphore = NULL;
+Thread *ImageLoader::async_thread = NULL;
+bool ImageLoader::async_exit = false;
+Vector<ImageLoader::AsyncLoad> ImageLoader::async_queue;
+
 void ImageLoader::add_image_format_loader(ImageFormatLoader *p_loader) {
 
 	loader.push_back(p_loader);
@@ -119,11 +222,28 @@ const Vector<ImageFormatLoader *> &ImageLoader::get_image_format_loaders() {
 
 void ImageLoader::cleanup() {
 
+	clear_async_loads();
+
 	while (loader.size()) {
 		remove_image_format_loader(loader[0]);
 	}
 }
 
+void ImageLoader::initialize() {
+
+	async_mutex = Mutex::create();
+	async_semaphore = Semaphore::create();
+}
+
+void ImageLoader::finalize() {
+
+	clear_async_loads();
+	memdelete(async_mutex);
+	async_mutex = NULL;
+	memdelete(async_semaphore);
+	async_semaphore = NULL;
+}
+
 /////////////////
 
 RES ResourceFormatLoaderImage::load(const String &p_path, const String &p_original_path, Error *r_error) {
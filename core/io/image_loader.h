@@ -35,6 +35,9 @@
 #include "core/io/resource_loader.h"
 #include "core/list.h"
 #include "core/os/file_access.h"
+#include "core/os/mutex.h"
+#include "core/os/semaphore.h"
+#include "core/os/thread.h"
 #include "core/ustring.h"
 
 /**
@@ -73,9 +76,38 @@ class ImageLoader {
 	static Vector<ImageFormatLoader *> loader;
 	friend class ResourceFormatLoaderImage;
 
+	//images requested with load_image_async(), decoded in batches on the worker threads
+	struct AsyncLoad {
+		String file;
+		ObjectID target;
+		StringName method;
+		bool force_linear;
+		float scale;
+		Ref<Image> image;
+		Error error;
+	};
+
+	struct AsyncBatch {
+		AsyncLoad *loads;
+
+		void decode(uint32_t p_index, void *p_userdata);
+	};
+
+	static Mutex *async_mutex;
+	static Semaphore *async_semaphore;
+	static Thread *async_thread;
+	static bool async_exit;
+	static Vector<AsyncLoad> async_queue;
+
+	static void _async_deliver(Vector<AsyncLoad> &p_loads);
+	static void _async_thread_function(void *p_userdata);
+
 protected:
 public:
 	static Error load_image(String p_file, Ref<Image> p_image, FileAccess *p_custom = NULL, bool p_force_linear = false, float p_scale = 1.0);
+	// Decodes p_file in the background, then calls p_method(file, image, error) on p_target from the main thread.
+	static Error load_image_async(const String &p_file, Object *p_target, const StringName &p_method, bool p_force_linear = false, float p_scale = 1.0);
+	static void clear_async_loads();
 	static void get_recognized_extensions(List<String> *p_extensions);
 	static ImageFormatLoader *recognize(const String &p_extension);
 
@@ -85,6 +117,9 @@ public:
 	static const Vector<ImageFormatLoader *> &get_image_format_loaders();
 
 	static void cleanup();
+
+	static void initialize();
+	static void finalize();
 };
 
 class ResourceFormatLoaderImage : public ResourceFormatLoader {
@@ -30,8 +30,11 @@
 
 #include "json.h"
 
+#include "core/os/file_access.h"
 #include "core/print_string.h"
 
+#include <stdlib.h>
+
 const char *JSON::tk_name[TK_MAX] = {
 	"'{'",
 	"'}'",
@@ -45,82 +48,126 @@ const char *JSON::tk_name[TK_MAX] = {
 	"EOF",
 };
 
-static String _make_indent(const String &p_indent, int p_size) {
+// Powers of ten that are exact as doubles.
+static const double _pow10[] = {
+	1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+	1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
 
-	String indent_text = "";
-	if (!p_indent.empty()) {
-		for (int i = 0; i < p_size; i++)
-			indent_text += p_indent;
+// Length of the number at p_str, -?digits(.digits)?([eE][+-]?digits)?.
+template <class C>
+static int _number_length(const C *p_str, int p_len) {
+
+	int i = 0;
+	if (i < p_len && p_str[i] == '-')
+		i++;
+	while (i < p_len && p_str[i] >= '0' && p_str[i] <= '9')
+		i++;
+	if (i < p_len && p_str[i] == '.') {
+		i++;
+		while (i < p_len && p_str[i] >= '0' && p_str[i] <= '9')
+			i++;
+	}
+	if (i < p_len && (p_str[i] == 'e' || p_str[i] == 'E')) {
+		i++;
+		if (i < p_len && (p_str[i] == '+' || p_str[i] == '-'))
+			i++;
+		while (i < p_len && p_str[i] >= '0' && p_str[i] <= '9')
+			i++;
 	}
-	return indent_text;
+	return i;
 }
 
-String JSON::_print_var(const Variant &p_var, const String &p_indent, int p_cur_indent, bool p_sort_keys) {
-
-	String colon = ":";
-	String end_statement = "";
-
-	if (!p_indent.empty()) {
-		colon += " ";
-		end_statement += "\n";
+// Correctly rounded conversion of a number matched by _number_length(). Up to
+// 15 significant digits and exponents within +-22, a single multiplication or
+// division by an exact power of ten is exact. Anything else goes to strtod(),
+// which is correctly rounded and sees the "C" numeric locale in the engine.
+template <class C>
+static double _parse_number(const C *p_begin, const C *p_end) {
+
+	const C *c = p_begin;
+	bool negative = false;
+	if (c < p_end && *c == '-') {
+		negative = true;
+		c++;
 	}
 
-	switch (p_var.get_type()) {
-
-		case Variant::NIL: return "null";
-		case Variant::BOOL: return p_var.operator bool() ? "true" : "false";
-		case Variant::INT: return itos(p_var);
-		case Variant::REAL: return rtos(p_var);
-		case Variant::POOL_INT_ARRAY:
-		case Variant::POOL_REAL_ARRAY:
-		case Variant::POOL_STRING_ARRAY:
-		case Variant::ARRAY: {
+	uint64_t mantissa = 0;
+	int digits = 0;
+	int exponent = 0;
+	bool truncated = false;
 
-			String s = "[";
-			s += end_statement;
-			Array a = p_var;
-			for (int i = 0; i < a.size(); i++) {
-				if (i > 0) {
-					s += ",";
-					s += end_statement;
-				}
-				s += _make_indent(p_indent, p_cur_indent + 1) + _print_var(a[i], p_indent, p_cur_indent + 1, p_sort_keys);
+	for (; c < p_end && *c >= '0' && *c <= '9'; c++) {
+		if (digits < 19) {
+			mantissa = mantissa * 10 + (*c - '0');
+			if (mantissa)
+				digits++;
+		} else {
+			exponent++;
+			truncated = truncated || *c != '0';
+		}
+	}
+	if (c < p_end && *c == '.') {
+		for (c++; c < p_end && *c >= '0' && *c <= '9'; c++) {
+			if (digits < 19) {
+				mantissa = mantissa * 10 + (*c - '0');
+				if (mantissa)
+					digits++;
+				exponent--;
+			} else {
+				truncated = truncated || *c != '0';
 			}
-			s += end_statement + _make_indent(p_indent, p_cur_indent) + "]";
-			return s;
-		};
-		case Variant::DICTIONARY: {
-
-			String s = "{";
-			s += end_statement;
-			Dictionary d = p_var;
-			List<Variant> keys;
-			d.get_key_list(&keys);
-
-			if (p_sort_keys)
-				keys.sort();
-
-			for (List<Variant>::Element *E = keys.front(); E; E = E->next()) {
+		}
+	}
+	if (c < p_end && (*c == 'e' || *c == 'E')) {
+		c++;
+		bool exponent_negative = false;
+		if (c < p_end && (*c == '+' || *c == '-')) {
+			exponent_negative = *c == '-';
+			c++;
+		}
+		int e = 0;
+		for (; c < p_end && *c >= '0' && *c <= '9'; c++) {
+			if (e < 100000)
+				e = e * 10 + (*c - '0');
+		}
+		exponent += exponent_negative ? -e : e;
+	}
 
-				if (E != keys.front()) {
-					s += ",";
-					s += end_statement;
-				}
-				s += _make_indent(p_indent, p_cur_indent + 1) + _print_var(String(E->get()), p_indent, p_cur_indent + 1, p_sort_keys);
-				s += colon;
-				s += _print_var(d[E->get()], p_indent, p_cur_indent + 1, p_sort_keys);
-			}
+	if (!truncated && mantissa == 0) {
+		return negative ? -0.0 : 0.0;
+	}
+	if (!truncated && mantissa <= (uint64_t(1) << 53) && exponent >= -22 && exponent <= 22) {
+		double number = (double)mantissa;
+		if (exponent < 0) {
+			number /= _pow10[-exponent];
+		} else {
+			number *= _pow10[exponent];
+		}
+		return negative ? -number : number;
+	}
 
-			s += end_statement + _make_indent(p_indent, p_cur_indent) + "}";
-			return s;
-		};
-		default: return "\"" + String(p_var).json_escape() + "\"";
+	const int len = p_end - p_begin;
+	char small[64];
+	char *ascii = len < 64 ? small : (char *)memalloc(len + 1);
+	for (int i = 0; i < len; i++) {
+		ascii[i] = (char)p_begin[i];
 	}
+	ascii[len] = 0;
+	double number = strtod(ascii, NULL);
+	if (ascii != small) {
+		memfree(ascii);
+	}
+	return number;
 }
 
 String JSON::print(const Variant &p_var, const String &p_indent, bool p_sort_keys) {
 
-	return _print_var(p_var, p_indent, 0, p_sort_keys);
+	JSONWriter writer;
+	writer.set_indent(p_indent);
+	writer.set_sort_keys(p_sort_keys);
+	writer.write_value(p_var);
+	return writer.get_string();
 }
 
 Error JSON::_get_token(const CharType *p_str, int &index, int p_len, Token &r_token, int &line, String &r_err_str) {
@@ -178,14 +225,20 @@ Error JSON::_get_token(const CharType *p_str, int &index, int p_len, Token &r_to
 
 				index++;
 				String str;
+				// Plain runs are appended in one go, escapes one by one.
+				int run_start = index;
 				while (true) {
 					if (p_str[index] == 0) {
 						r_err_str = "Unterminated String";
 						return ERR_PARSE_ERROR;
 					} else if (p_str[index] == '"') {
+						if (index > run_start)
+							str += String(&p_str[run_start], index - run_start);
 						index++;
 						break;
 					} else if (p_str[index] == '\\') {
+						if (index > run_start)
+							str += String(&p_str[run_start], index - run_start);
 						//escaped characters...
 						index++;
 						CharType next = p_str[index];
@@ -247,11 +300,10 @@ Error JSON::_get_token(const CharType *p_str, int &index, int p_len, Token &r_to
 						}
 
 						str += res;
+						run_start = index + 1;
 
-					} else {
-						if (p_str[index] == '\n')
-							line++;
-						str += p_str[index];
+					} else if (p_str[index] == '\n') {
+						line++;
 					}
 					index++;
 				}
@@ -270,25 +322,23 @@ Error JSON::_get_token(const CharType *p_str, int &index, int p_len, Token &r_to
 
 				if (p_str[index] == '-' || (p_str[index] >= '0' && p_str[index] <= '9')) {
 					//a number
-					const CharType *rptr;
-					double number = String::to_double(&p_str[index], &rptr);
-					index += (rptr - &p_str[index]);
+					int number_len = _number_length(&p_str[index], p_len - index);
 					r_token.type = TK_NUMBER;
-					r_token.value = number;
+					r_token.value = _parse_number(&p_str[index], &p_str[index + number_len]);
+					index += number_len;
 					return OK;
 
 				} else if ((p_str[index] >= 'A' && p_str[index] <= 'Z') || (p_str[index] >= 'a' && p_str[index] <= 'z')) {
 
-					String id;
+					int id_start = index;
 
 					while ((p_str[index] >= 'A' && p_str[index] <= 'Z') || (p_str[index] >= 'a' && p_str[index] <= 'z')) {
 
-						id += p_str[index];
 						index++;
 					}
 
 					r_token.type = TK_IDENTIFIER;
-					r_token.value = id;
+					r_token.value = String(&p_str[id_start], index - id_start);
 					return OK;
 				} else {
 					r_err_str = "Unexpected character.";
@@ -475,3 +525,828 @@ Error JSON::parse(const String &p_json, Variant &r_ret, String &r_err_str, int &
 
 	return err;
 }
+
+Error JSON::parse_utf8(const uint8_t *p_utf8, int p_len, Variant &r_ret, String &r_err_str, int &r_err_line) {
+
+	JSONReader reader;
+	reader.open_buffer(p_utf8, p_len);
+	Error err = reader.read_value(r_ret);
+	r_err_line = reader.get_line();
+	if (err != OK) {
+		r_err_str = reader.get_error();
+	}
+	return err;
+}
+
+/////////////////////////////
+
+JSONReader::JSONReader() {
+
+	file = NULL;
+	data = NULL;
+	pos = 0;
+	len = 0;
+	input_ended = false;
+	string_escaped = false;
+	string_lines = 0;
+	_reset();
+}
+
+void JSONReader::_reset() {
+
+	stack.clear();
+	state = STATE_VALUE;
+	token = TOKEN_NONE;
+	value = Variant();
+	line = 0;
+	error = String();
+	string_resume = -1;
+}
+
+void JSONReader::open_file(FileAccess *p_file) {
+
+	file = p_file;
+	stream.unref();
+	data = NULL;
+	pos = len = 0;
+	input_ended = false;
+	_reset();
+}
+
+void JSONReader::open_stream(const Ref<StreamPeer> &p_stream) {
+
+	file = NULL;
+	stream = p_stream;
+	data = NULL;
+	pos = len = 0;
+	input_ended = false;
+	_reset();
+}
+
+void JSONReader::open_buffer(const uint8_t *p_data, int p_len) {
+
+	file = NULL;
+	stream.unref();
+	data = p_data;
+	pos = 0;
+	len = p_len;
+	input_ended = true;
+	_reset();
+}
+
+Error JSONReader::_fill() {
+
+	if (input_ended) {
+		return ERR_FILE_EOF;
+	}
+
+	// Keep the unconsumed tail, a token is always scanned from one contiguous
+	// range so the buffer grows when a single token outgrows it.
+	const int keep = len - pos;
+	if (buffer.size() - keep < CHUNK_SIZE) {
+		buffer.resize(MAX(buffer.size() * 2, keep + CHUNK_SIZE));
+	}
+	uint8_t *w = buffer.ptrw();
+	if (keep && pos) {
+		movemem(w, w + pos, keep);
+	}
+	if (string_resume >= 0) {
+		string_resume -= pos;
+	}
+	pos = 0;
+	len = keep;
+	data = w;
+
+	int received = 0;
+	if (file) {
+		received = file->get_buffer(w + len, buffer.size() - len);
+		if (received <= 0) {
+			input_ended = true;
+			return ERR_FILE_EOF;
+		}
+	} else if (stream.is_valid()) {
+		if (stream->get_partial_data(w + len, buffer.size() - len, received) != OK) {
+			input_ended = true;
+			return ERR_FILE_EOF;
+		}
+		if (received == 0) {
+			return ERR_BUSY;
+		}
+	} else {
+		input_ended = true;
+		return ERR_FILE_EOF;
+	}
+
+	len += received;
+	return OK;
+}
+
+JSONReader::Scan JSONReader::_fail(const String &p_error) {
+
+	error = p_error;
+	string_resume = -1;
+	return SCAN_ERROR;
+}
+
+void JSONReader::_close_container() {
+
+	token = stack[stack.size() - 1] == '{' ? TOKEN_OBJECT_END : TOKEN_ARRAY_END;
+	value = Variant();
+	stack.resize(stack.size() - 1);
+	state = stack.empty() ? STATE_DONE : STATE_COMMA_OR_END;
+}
+
+JSONReader::Scan JSONReader::_scan_string(String &r_string) {
+
+	// First find the closing quote, resuming where the last pass ran out of data.
+	int i = string_resume >= 0 ? string_resume : pos + 1;
+	bool escaped = string_resume >= 0 && string_escaped;
+	int lines = string_resume >= 0 ? string_lines : 0;
+
+	while (true) {
+		while (i < len && data[i] != '"' && data[i] != '\\' && data[i] != '\n') {
+			i++;
+		}
+
+		// An escape needs its whole sequence buffered.
+		const int need = i < len && data[i] == '\\' ? (i + 1 < len && data[i + 1] == 'u' ? 6 : 2) : 1;
+		if (i + need > len) {
+			if (input_ended) {
+				return _fail("Unterminated String");
+			}
+			string_resume = i;
+			string_escaped = escaped;
+			string_lines = lines;
+			return SCAN_MORE;
+		}
+
+		if (data[i] == '"') {
+			break;
+		} else if (data[i] == '\n') {
+			lines++;
+		} else {
+			escaped = true;
+		}
+		i += need;
+	}
+	string_resume = -1;
+
+	const int begin = pos + 1;
+	const int end = i;
+
+	if (!escaped) {
+		if (end == begin) {
+			r_string = String();
+		} else if (r_string.parse_utf8((const char *)data + begin, end - begin)) {
+			return _fail("Invalid UTF-8 in string");
+		}
+		pos = end + 1;
+		line += lines;
+		return SCAN_OK;
+	}
+
+	// Decoding never makes the text longer.
+	scratch.resize(end - begin);
+	char *out = scratch.ptrw();
+	int out_len = 0;
+
+	for (int j = begin; j < end; j++) {
+
+		if (data[j] != '\\') {
+			out[out_len++] = data[j];
+			continue;
+		}
+
+		j++;
+		uint32_t res = 0;
+		switch (data[j]) {
+			case 'b': res = 8; break;
+			case 't': res = 9; break;
+			case 'n': res = 10; break;
+			case 'f': res = 12; break;
+			case 'r': res = 13; break;
+			case 'u': {
+
+				for (int k = 1; k <= 4; k++) {
+					uint8_t c = data[j + k];
+					uint32_t v;
+					if (c >= '0' && c <= '9') {
+						v = c - '0';
+					} else if (c >= 'a' && c <= 'f') {
+						v = c - 'a' + 10;
+					} else if (c >= 'A' && c <= 'F') {
+						v = c - 'A' + 10;
+					} else {
+						return _fail("Malformed hex constant in string");
+					}
+					res = (res << 4) | v;
+				}
+				j += 4;
+
+				// Join surrogate pairs into one code point.
+				if (res >= 0xD800 && res <= 0xDBFF && j + 6 < end && data[j + 1] == '\\' && data[j + 2] == 'u') {
+					uint32_t low = 0;
+					int k = 3;
+					for (; k <= 6; k++) {
+						uint8_t c = data[j + k];
+						if (c >= '0' && c <= '9') {
+							low = (low << 4) | (c - '0');
+						} else if (c >= 'a' && c <= 'f') {
+							low = (low << 4) | (c - 'a' + 10);
+						} else if (c >= 'A' && c <= 'F') {
+							low = (low << 4) | (c - 'A' + 10);
+						} else {
+							break;
+						}
+					}
+					if (k == 7 && low >= 0xDC00 && low <= 0xDFFF) {
+						res = 0x10000 + ((res - 0xD800) << 10) + (low - 0xDC00);
+						j += 6;
+					}
+				}
+
+				if (res < 0x80) {
+					out[out_len++] = res;
+				} else if (res < 0x800) {
+					out[out_len++] = 0xC0 | (res >> 6);
+					out[out_len++] = 0x80 | (res & 0x3F);
+				} else if (res < 0x10000) {
+					out[out_len++] = 0xE0 | (res >> 12);
+					out[out_len++] = 0x80 | ((res >> 6) & 0x3F);
+					out[out_len++] = 0x80 | (res & 0x3F);
+				} else {
+					out[out_len++] = 0xF0 | (res >> 18);
+					out[out_len++] = 0x80 | ((res >> 12) & 0x3F);
+					out[out_len++] = 0x80 | ((res >> 6) & 0x3F);
+					out[out_len++] = 0x80 | (res & 0x3F);
+				}
+				continue;
+			} break;
+			default: {
+				res = data[j];
+			} break;
+		}
+		out[out_len++] = res;
+	}
+
+	if (out_len == 0) {
+		r_string = String();
+	} else if (r_string.parse_utf8(out, out_len)) {
+		return _fail("Invalid UTF-8 in string");
+	}
+	pos = end + 1;
+	line += lines;
+	return SCAN_OK;
+}
+
+JSONReader::Scan JSONReader::_scan_number(double &r_number) {
+
+	const int number_len = _number_length(data + pos, len - pos);
+	if (pos + number_len == len && !input_ended) {
+		return SCAN_MORE;
+	}
+	r_number = _parse_number(data + pos, data + pos + number_len);
+	pos += number_len;
+	return SCAN_OK;
+}
+
+JSONReader::Scan JSONReader::_scan_literal(Variant &r_value) {
+
+	int i = pos;
+	while (i < len && ((data[i] >= 'A' && data[i] <= 'Z') || (data[i] >= 'a' && data[i] <= 'z'))) {
+		i++;
+	}
+	if (i == len && !input_ended) {
+		return SCAN_MORE;
+	}
+
+	const char *id = (const char *)data + pos;
+	const int id_len = i - pos;
+	if (id_len == 4 && !strncmp(id, "true", 4)) {
+		r_value = true;
+	} else if (id_len == 5 && !strncmp(id, "false", 5)) {
+		r_value = false;
+	} else if (id_len == 4 && !strncmp(id, "null", 4)) {
+		r_value = Variant();
+	} else {
+		String got;
+		got.parse_utf8(id, id_len);
+		return _fail("Expected 'true','false' or 'null', got '" + got + "'.");
+	}
+	pos = i;
+	return SCAN_OK;
+}
+
+JSONReader::Scan JSONReader::_scan_token() {
+
+	// Separators only change the state once the token after them is complete,
+	// so a scan that runs out of data can simply start over.
+	State scan_state = state;
+
+	while (true) {
+
+		while (pos < len && data[pos] <= 32) {
+			if (data[pos] == '\n')
+				line++;
+			pos++;
+		}
+		if (pos == len) {
+			if (!input_ended)
+				return SCAN_MORE;
+			return _fail("Unexpected end of input");
+		}
+
+		const uint8_t c = data[pos];
+		const uint8_t top = stack.empty() ? 0 : stack[stack.size() - 1];
+
+		switch (scan_state) {
+
+			case STATE_COMMA_OR_END: {
+
+				if (c == (top == '{' ? '}' : ']')) {
+					pos++;
+					_close_container();
+					return SCAN_OK;
+				}
+				if (c != ',') {
+					return _fail(top == '{' ? "Expected '}' or ','" : "Expected ','");
+				}
+				pos++;
+				// Trailing commas are accepted, like JSON.parse() does.
+				scan_state = top == '{' ? STATE_KEY_OR_END : STATE_VALUE_OR_END;
+			} break;
+			case STATE_COLON: {
+
+				if (c != ':') {
+					return _fail("Expected ':'");
+				}
+				pos++;
+				scan_state = STATE_VALUE;
+			} break;
+			case STATE_KEY_OR_END: {
+
+				if (c == '}') {
+					pos++;
+					_close_container();
+					return SCAN_OK;
+				}
+				if (c != '"') {
+					return _fail("Expected key");
+				}
+				String key;
+				Scan scan = _scan_string(key);
+				if (scan != SCAN_OK) {
+					return scan;
+				}
+				token = TOKEN_KEY;
+				value = key;
+				state = STATE_COLON;
+				return SCAN_OK;
+			} break;
+			case STATE_VALUE_OR_END:
+			case STATE_VALUE: {
+
+				if (scan_state == STATE_VALUE_OR_END && c == ']') {
+					pos++;
+					_close_container();
+					return SCAN_OK;
+				}
+
+				if (c == '{' || c == '[') {
+					pos++;
+					stack.push_back(c);
+					token = c == '{' ? TOKEN_OBJECT_BEGIN : TOKEN_ARRAY_BEGIN;
+					value = Variant();
+					state = c == '{' ? STATE_KEY_OR_END : STATE_VALUE_OR_END;
+					return SCAN_OK;
+				}
+
+				if (c == 0xEF && stack.empty() && pos + 2 < len && data[pos + 1] == 0xBB && data[pos + 2] == 0xBF) {
+					pos += 3; // Byte order mark.
+					continue;
+				}
+
+				Scan scan;
+				if (c == '"') {
+					String str;
+					scan = _scan_string(str);
+					value = str;
+				} else if (c == '-' || (c >= '0' && c <= '9')) {
+					double number = 0;
+					scan = _scan_number(number);
+					value = number;
+				} else if ((c >= 'A' && c <= 'Z') || (c >= 'a' && c <= 'z')) {
+					scan = _scan_literal(value);
+				} else {
+					return _fail("Unexpected character.");
+				}
+				if (scan != SCAN_OK) {
+					return scan;
+				}
+				token = TOKEN_VALUE;
+				state = stack.empty() ? STATE_DONE : STATE_COMMA_OR_END;
+				return SCAN_OK;
+			} break;
+			default: {
+				return _fail("Unexpected token.");
+			}
+		}
+	}
+}
+
+Error JSONReader::next() {
+
+	if (state == STATE_ERROR) {
+		return ERR_PARSE_ERROR;
+	}
+	if (state == STATE_DONE) {
+		token = TOKEN_END;
+		value = Variant();
+		return OK;
+	}
+
+	while (true) {
+
+		const int token_start = pos;
+		const int token_line = line;
+
+		Scan scan = _scan_token();
+		if (scan == SCAN_OK) {
+			return OK;
+		}
+		if (scan == SCAN_ERROR) {
+			state = STATE_ERROR;
+			token = TOKEN_NONE;
+			value = Variant();
+			return ERR_PARSE_ERROR;
+		}
+
+		pos = token_start;
+		line = token_line;
+		Error err = _fill();
+		if (err == ERR_BUSY) {
+			return ERR_BUSY;
+		}
+		// On ERR_FILE_EOF the next scan reports whatever is left as truncated.
+	}
+}
+
+Error JSONReader::_read_current(Variant &r_value) {
+
+	switch (token) {
+
+		case TOKEN_VALUE: {
+
+			r_value = value;
+			return OK;
+		} break;
+		case TOKEN_ARRAY_BEGIN: {
+
+			Array array;
+			while (true) {
+				Error err = next();
+				if (err != OK)
+					return err;
+				if (token == TOKEN_ARRAY_END)
+					break;
+				Variant v;
+				err = _read_current(v);
+				if (err != OK)
+					return err;
+				array.push_back(v);
+			}
+			r_value = array;
+			return OK;
+		} break;
+		case TOKEN_OBJECT_BEGIN: {
+
+			Dictionary object;
+			while (true) {
+				Error err = next();
+				if (err != OK)
+					return err;
+				if (token == TOKEN_OBJECT_END)
+					break;
+				String key = value;
+				err = next();
+				if (err != OK)
+					return err;
+				err = _read_current(object[key]);
+				if (err != OK)
+					return err;
+			}
+			r_value = object;
+			return OK;
+		} break;
+		default: {
+
+			error = "Expected value.";
+			return ERR_PARSE_ERROR;
+		}
+	}
+}
+
+Error JSONReader::read_value(Variant &r_value) {
+
+	Error err = next();
+	if (err != OK)
+		return err;
+	return _read_current(r_value);
+}
+
+Error JSONReader::skip_value() {
+
+	Error err = next();
+	if (err != OK)
+		return err;
+	if (token != TOKEN_OBJECT_BEGIN && token != TOKEN_ARRAY_BEGIN)
+		return token == TOKEN_VALUE ? OK : ERR_PARSE_ERROR;
+
+	const int depth = stack.size();
+	while (stack.size() >= depth) {
+		err = next();
+		if (err != OK)
+			return err;
+	}
+	return OK;
+}
+
+/////////////////////////////
+
+JSONWriter::JSONWriter() {
+
+	file = NULL;
+	sort_keys = true;
+	buffer_used = 0;
+	error = OK;
+}
+
+JSONWriter::~JSONWriter() {
+
+	flush();
+}
+
+void JSONWriter::open_file(FileAccess *p_file) {
+
+	flush();
+	file = p_file;
+	stream.unref();
+}
+
+void JSONWriter::open_stream(const Ref<StreamPeer> &p_stream) {
+
+	flush();
+	file = NULL;
+	stream = p_stream;
+}
+
+Error JSONWriter::flush() {
+
+	if (!buffer_used || (!file && stream.is_null())) {
+		return error;
+	}
+
+	if (file) {
+		file->store_buffer(buffer.ptr(), buffer_used);
+	} else {
+		Error err = stream->put_data(buffer.ptr(), buffer_used);
+		if (err != OK) {
+			error = err;
+		}
+	}
+	buffer_used = 0;
+	return error;
+}
+
+void JSONWriter::_put(const char *p_str, int p_len) {
+
+	if (buffer_used + p_len > buffer.size()) {
+		if (file || stream.is_valid()) {
+			flush();
+		}
+		if (buffer_used + p_len > buffer.size()) {
+			buffer.resize(next_power_of_2(MAX(buffer_used + p_len, (int)FLUSH_SIZE)));
+		}
+	}
+	copymem(buffer.ptrw() + buffer_used, p_str, p_len);
+	buffer_used += p_len;
+}
+
+void JSONWriter::_put(const char *p_str) {
+
+	_put(p_str, strlen(p_str));
+}
+
+void JSONWriter::_put_string(const String &p_string) {
+
+	// Escapes the same characters as String::json_escape() while encoding to
+	// UTF-8, without building intermediate strings.
+	uint8_t chunk[1024];
+	int used = 0;
+	chunk[used++] = '"';
+
+	const CharType *str = p_string.c_str();
+	for (int i = 0; str[i]; i++) {
+
+		if (used > (int)sizeof(chunk) - 8) {
+			_put((const char *)chunk, used);
+			used = 0;
+		}
+
+		const uint32_t c = str[i];
+		const char *escape = NULL;
+		switch (c) {
+			case '\\': escape = "\\\\"; break;
+			case '\b': escape = "\\b"; break;
+			case '\f': escape = "\\f"; break;
+			case '\n': escape = "\\n"; break;
+			case '\r': escape = "\\r"; break;
+			case '\t': escape = "\\t"; break;
+			case '\v': escape = "\\v"; break;
+			case '"': escape = "\\\""; break;
+		}
+
+		if (escape) {
+			chunk[used++] = escape[0];
+			chunk[used++] = escape[1];
+		} else if (c <= 0x7F) {
+			chunk[used++] = c;
+		} else if (c <= 0x7FF) {
+			chunk[used++] = 0xC0 | (c >> 6);
+			chunk[used++] = 0x80 | (c & 0x3F);
+		} else if (c <= 0xFFFF) {
+			chunk[used++] = 0xE0 | (c >> 12);
+			chunk[used++] = 0x80 | ((c >> 6) & 0x3F);
+			chunk[used++] = 0x80 | (c & 0x3F);
+		} else {
+			chunk[used++] = 0xF0 | ((c >> 18) & 0x07);
+			chunk[used++] = 0x80 | ((c >> 12) & 0x3F);
+			chunk[used++] = 0x80 | ((c >> 6) & 0x3F);
+			chunk[used++] = 0x80 | (c & 0x3F);
+		}
+	}
+
+	chunk[used++] = '"';
+	_put((const char *)chunk, used);
+}
+
+void JSONWriter::_put_line_break() {
+
+	if (indent.length()) {
+		_put("\n", 1);
+	}
+}
+
+void JSONWriter::_put_indent(int p_depth) {
+
+	for (int i = 0; i < p_depth; i++) {
+		_put(indent.get_data(), indent.length());
+	}
+}
+
+void JSONWriter::_before_value() {
+
+	if (stack.empty()) {
+		return;
+	}
+
+	Level &top = stack.write[stack.size() - 1];
+	if (top.object) {
+		return; // Follows its key.
+	}
+	if (top.count) {
+		_put(",", 1);
+		_put_line_break();
+	}
+	_put_indent(stack.size());
+	top.count++;
+}
+
+void JSONWriter::begin_object() {
+
+	_before_value();
+	_put("{", 1);
+	_put_line_break();
+
+	Level level;
+	level.object = true;
+	level.count = 0;
+	stack.push_back(level);
+}
+
+void JSONWriter::end_object() {
+
+	ERR_FAIL_COND(stack.empty() || !stack[stack.size() - 1].object);
+	stack.resize(stack.size() - 1);
+	_put_line_break();
+	_put_indent(stack.size());
+	_put("}", 1);
+}
+
+void JSONWriter::begin_array() {
+
+	_before_value();
+	_put("[", 1);
+	_put_line_break();
+
+	Level level;
+	level.object = false;
+	level.count = 0;
+	stack.push_back(level);
+}
+
+void JSONWriter::end_array() {
+
+	ERR_FAIL_COND(stack.empty() || stack[stack.size() - 1].object);
+	stack.resize(stack.size() - 1);
+	_put_line_break();
+	_put_indent(stack.size());
+	_put("]", 1);
+}
+
+void JSONWriter::write_key(const String &p_key) {
+
+	ERR_FAIL_COND(stack.empty() || !stack[stack.size() - 1].object);
+
+	Level &top = stack.write[stack.size() - 1];
+	if (top.count) {
+		_put(",", 1);
+		_put_line_break();
+	}
+	_put_indent(stack.size());
+	_put_string(p_key);
+	if (indent.length()) {
+		_put(": ", 2);
+	} else {
+		_put(":", 1);
+	}
+	top.count++;
+}
+
+void JSONWriter::write_value(const Variant &p_value) {
+
+	switch (p_value.get_type()) {
+
+		case Variant::NIL: {
+			_before_value();
+			_put("null", 4);
+		} break;
+		case Variant::BOOL: {
+			_before_value();
+			if (p_value.operator bool()) {
+				_put("true", 4);
+			} else {
+				_put("false", 5);
+			}
+		} break;
+		case Variant::INT: {
+			_before_value();
+			CharString number = itos(p_value).ascii();
+			_put(number.get_data(), number.length());
+		} break;
+		case Variant::REAL: {
+			_before_value();
+			CharString number = rtos(p_value).ascii();
+			_put(number.get_data(), number.length());
+		} break;
+		case Variant::POOL_INT_ARRAY:
+		case Variant::POOL_REAL_ARRAY:
+		case Variant::POOL_STRING_ARRAY:
+		case Variant::ARRAY: {
+			Array array = p_value;
+			begin_array();
+			for (int i = 0; i < array.size(); i++) {
+				write_value(array[i]);
+			}
+			end_array();
+		} break;
+		case Variant::DICTIONARY: {
+			Dictionary object = p_value;
+			List<Variant> keys;
+			object.get_key_list(&keys);
+
+			if (sort_keys)
+				keys.sort();
+
+			begin_object();
+			for (List<Variant>::Element *E = keys.front(); E; E = E->next()) {
+				write_key(String(E->get()));
+				write_value(object[E->get()]);
+			}
+			end_object();
+		} break;
+		default: {
+			_before_value();
+			_put_string(String(p_value));
+		} break;
+	}
+}
+
+String JSONWriter::get_string() const {
+
+	String str;
+	if (buffer_used) {
+		str.parse_utf8((const char *)buffer.ptr(), buffer_used);
+	}
+	return str;
+}
@@ -31,8 +31,11 @@
 #ifndef JSON_H
 #define JSON_H
 
+#include "core/io/stream_peer.h"
 #include "core/variant.h"
 
+class FileAccess;
+
 class JSON {
 
 	enum TokenType {
@@ -65,8 +68,6 @@ class JSON {
 
 	static const char *tk_name[TK_MAX];
 
-	static String _print_var(const Variant &p_var, const String &p_indent, int p_cur_indent, bool p_sort_keys);
-
 	static Error _get_token(const CharType *p_str, int &index, int p_len, Token &r_token, int &line, String &r_err_str);
 	static Error _parse_value(Variant &value, Token &token, const CharType *p_str, int &index, int p_len, int &line, String &r_err_str);
 	static Error _parse_array(Array &array, const CharType *p_str, int &index, int p_len, int &line, String &r_err_str);
@@ -75,6 +76,151 @@ class JSON {
 public:
 	static String print(const Variant &p_var, const String &p_indent = "", bool p_sort_keys = true);
 	static Error parse(const String &p_json, Variant &r_ret, String &r_err_str, int &r_err_line);
+	// Parses UTF-8 directly, without first decoding the whole text into a String.
+	static Error parse_utf8(const uint8_t *p_utf8, int p_len, Variant &r_ret, String &r_err_str, int &r_err_line);
+};
+
+// Pull parser reading UTF-8 JSON from a file, a stream peer or memory in
+// chunks. Each next() call advances by one token, values can also be read
+// whole with read_value() or skipped, so large documents don't have to be
+// held in memory at once.
+class JSONReader {
+public:
+	enum Token {
+		TOKEN_NONE,
+		TOKEN_OBJECT_BEGIN,
+		TOKEN_OBJECT_END,
+		TOKEN_ARRAY_BEGIN,
+		TOKEN_ARRAY_END,
+		TOKEN_KEY, // get_value() is the key String.
+		TOKEN_VALUE, // get_value() is a String, number, bool or null.
+		TOKEN_END, // The top level value is complete.
+	};
+
+private:
+	enum State {
+		STATE_VALUE,
+		STATE_VALUE_OR_END,
+		STATE_KEY_OR_END,
+		STATE_COLON,
+		STATE_COMMA_OR_END,
+		STATE_DONE,
+		STATE_ERROR,
+	};
+
+	enum Scan {
+		SCAN_OK,
+		SCAN_MORE, // The token runs past the buffered data.
+		SCAN_ERROR,
+	};
+
+	enum {
+		CHUNK_SIZE = 16384
+	};
+
+	FileAccess *file;
+	Ref<StreamPeer> stream;
+
+	Vector<uint8_t> buffer;
+	const uint8_t *data;
+	int pos;
+	int len;
+	bool input_ended;
+
+	Vector<uint8_t> stack; // '{' or '[' for each open container.
+	State state;
+	Token token;
+	Variant value;
+	int line;
+	String error;
+	Vector<char> scratch;
+
+	// Where an unfinished string scan continues once more data arrives.
+	int string_resume;
+	bool string_escaped;
+	int string_lines;
+
+	Error _fill();
+	Scan _scan_token();
+	Scan _scan_string(String &r_string);
+	Scan _scan_number(double &r_number);
+	Scan _scan_literal(Variant &r_value);
+	Scan _fail(const String &p_error);
+	void _reset();
+	void _close_container();
+	Error _read_current(Variant &r_value);
+
+public:
+	void open_file(FileAccess *p_file);
+	void open_stream(const Ref<StreamPeer> &p_stream);
+	void open_buffer(const uint8_t *p_data, int p_len); // p_data must outlive the reader.
+
+	// ERR_BUSY means a stream peer has no data available yet, call again later.
+	Error next();
+	Token get_token() const { return token; }
+	const Variant &get_value() const { return value; }
+	int get_depth() const { return stack.size(); }
+	int get_line() const { return line; }
+	String get_error() const { return error; }
+
+	// Reads the value starting at the next token, containers included. With a
+	// stream peer the whole value must already be available.
+	Error read_value(Variant &r_value);
+	Error skip_value();
+
+	JSONReader();
+};
+
+// Streaming writer producing the same layout as JSON::print(), flushing to a
+// file or stream peer as it goes, or collecting into memory.
+class JSONWriter {
+
+	struct Level {
+		bool object;
+		int count;
+	};
+
+	FileAccess *file;
+	Ref<StreamPeer> stream;
+	CharString indent;
+	bool sort_keys;
+
+	Vector<uint8_t> buffer;
+	int buffer_used;
+	Vector<Level> stack;
+	Error error;
+
+	void _put(const char *p_str, int p_len);
+	void _put(const char *p_str);
+	void _put_string(const String &p_string);
+	void _put_line_break();
+	void _put_indent(int p_depth);
+	void _before_value();
+
+public:
+	enum {
+		FLUSH_SIZE = 16384
+	};
+
+	void open_file(FileAccess *p_file);
+	void open_stream(const Ref<StreamPeer> &p_stream);
+	void set_indent(const String &p_indent) { indent = p_indent.utf8(); }
+	void set_sort_keys(bool p_sort_keys) { sort_keys = p_sort_keys; }
+
+	void begin_object();
+	void end_object();
+	void begin_array();
+	void end_array();
+	void write_key(const String &p_key);
+	void write_value(const Variant &p_value); // Containers are written whole.
+
+	Error flush();
+	Error get_error() const { return error; }
+	// Everything written so far, when not writing to a file or stream.
+	String get_string() const;
+
+	JSONWriter();
+	~JSONWriter();
 };
 
 #endif // JSON_H
@@ -31,8 +31,12 @@
 #include "logger.h"
 
 #include "core/os/dir_access.h"
+#include "core/os/mutex.h"
 #include "core/os/os.h"
+#include "core/os/semaphore.h"
+#include "core/os/thread.h"
 #include "core/print_string.h"
+#include "core/safe_refcount.h"
 
 // va_copy was defined in the C99, but not in C++ standards before C++11.
 // When you compile C++ without --std=c++<XX> option, compilers still define
@@ -53,19 +57,23 @@ bool Logger::should_log(bool p_err) {
 	return (!p_err || _print_error_enabled) && (p_err || _print_line_enabled);
 }
 
+const char *Logger::get_error_type_string(ErrorType p_type) {
+	switch (p_type) {
+		case ERR_ERROR: return "**ERROR**";
+		case ERR_WARNING: return "**WARNING**";
+		case ERR_SCRIPT: return "**SCRIPT ERROR**";
+		case ERR_SHADER: return "**SHADER ERROR**";
+		default: ERR_PRINT("Unknown error type"); break;
+	}
+	return "**ERROR**";
+}
+
 void Logger::log_error(const char *p_function, const char *p_file, int p_line, const char *p_code, const char *p_rationale, ErrorType p_type) {
 	if (!should_log(true)) {
 		return;
 	}
 
-	const char *err_type = "**ERROR**";
-	switch (p_type) {
-		case ERR_ERROR: err_type = "**ERROR**"; break;
-		case ERR_WARNING: err_type = "**WARNING**"; break;
-		case ERR_SCRIPT: err_type = "**SCRIPT ERROR**"; break;
-		case ERR_SHADER: err_type = "**SHADER ERROR**"; break;
-		default: ERR_PRINT("Unknown error type"); break;
-	}
+	const char *err_type = get_error_type_string(p_type);
 
 	const char *err_details;
 	if (p_rationale && *p_rationale)
@@ -77,6 +85,14 @@ void Logger::log_error(const char *p_function, const char *p_file, int p_line, c
 	logf_error("   At: %s:%i:%s() - %s\n", p_file, p_line, p_function, p_code);
 }
 
+void Logger::log_buffer(const char *p_buffer, int p_length, bool p_err) {
+	if (p_err) {
+		logf_error("%.*s", p_length, p_buffer);
+	} else {
+		logf("%.*s", p_length, p_buffer);
+	}
+}
+
 void Logger::logf(const char *p_format, ...) {
 	if (!should_log(false)) {
 		return;
@@ -203,18 +219,26 @@ void RotatedFileLogger::logv(const char *p_format, va_list p_list, bool p_err) {
 			vsnprintf(buf, len + 1, p_format, list_copy);
 		}
 		va_end(list_copy);
-		file->store_buffer((uint8_t *)buf, len);
+		log_buffer(buf, len, p_err);
 		if (len >= static_buf_size) {
 			Memory::free_static(buf);
 		}
+	}
+}
+
+void RotatedFileLogger::log_buffer(const char *p_buffer, int p_length, bool p_err) {
+	if (!file || p_length <= 0) {
+		return;
+	}
+
+	file->store_buffer((const uint8_t *)p_buffer, p_length);
 #ifdef DEBUG_ENABLED
-		const bool need_flush = true;
+	const bool need_flush = true;
 #else
-		bool need_flush = p_err;
+	bool need_flush = p_err;
 #endif
-		if (need_flush) {
-			file->flush();
-		}
+	if (need_flush) {
+		file->flush();
 	}
 }
 
@@ -237,6 +261,17 @@ void StdLogger::logv(const char *p_format, va_list p_list, bool p_err) {
 	}
 }
 
+void StdLogger::log_buffer(const char *p_buffer, int p_length, bool p_err) {
+	if (p_err) {
+		fwrite(p_buffer, 1, p_length, stderr);
+	} else {
+		fwrite(p_buffer, 1, p_length, stdout);
+#ifdef DEBUG_ENABLED
+		fflush(stdout);
+#endif
+	}
+}
+
 StdLogger::~StdLogger() {}
 
 CompositeLogger::CompositeLogger(Vector<Logger *> p_loggers) :
@@ -275,3 +310,545 @@ CompositeLogger::~CompositeLogger() {
 		memdelete(loggers[i]);
 	}
 }
+
+static uint64_t async_logger_count = 0;
+
+#ifndef NO_THREADS
+// Rings used by the calling thread, looked up by logger id so a destroyed logger is never matched.
+struct AsyncLoggerThreadCache {
+	uint64_t logger;
+	void *ring;
+};
+
+static thread_local AsyncLoggerThreadCache async_logger_cache[4] = {};
+static thread_local uint32_t async_logger_cache_next = 0;
+#endif
+
+static _FORCE_INLINE_ void _ring_lock(volatile uint32_t *p_lock) {
+
+	while (*p_lock || !atomic_compare_exchange(p_lock, (uint32_t)0, (uint32_t)1)) {
+	}
+}
+
+static _FORCE_INLINE_ void _ring_unlock(volatile uint32_t *p_lock) {
+
+	atomic_compare_exchange(p_lock, (uint32_t)1, (uint32_t)0);
+}
+
+AsyncLogger::Ring *AsyncLogger::_create_ring(uint64_t p_owner) {
+
+	Ring *ring = memnew(Ring);
+	ring->data = (uint8_t *)memalloc(ring_size);
+	ring->write_pos = 0;
+	ring->read_pos = 0;
+	ring->lock = 0;
+	ring->owner = p_owner;
+	ring->next = NULL;
+	return ring;
+}
+
+AsyncLogger::Ring *AsyncLogger::_get_ring() {
+
+#ifndef NO_THREADS
+	for (int i = 0; i < 4; i++) {
+		if (async_logger_cache[i].logger == id) {
+			return (Ring *)async_logger_cache[i].ring;
+		}
+	}
+	return _register_thread();
+#else
+	return shared_ring;
+#endif
+}
+
+AsyncLogger::Ring *AsyncLogger::_register_thread() {
+
+	MutexLock lock(rings_mutex);
+
+	// Thread IDs are only reused once a thread has exited, so its ring can be taken over.
+	uint64_t caller = Thread::get_caller_id();
+	Ring *ring = rings;
+	while (ring && ring->owner != caller) {
+		ring = ring->next;
+	}
+
+	if (!ring) {
+		if (ring_count < MAX_RINGS) {
+			// Prepended, so the writer can walk the list it saw without locking.
+			ring = _create_ring(caller);
+			ring->next = rings;
+			rings = ring;
+			ring_count++;
+		} else {
+			ring = shared_ring;
+		}
+	}
+
+#ifndef NO_THREADS
+	AsyncLoggerThreadCache &cache = async_logger_cache[async_logger_cache_next++ & 3];
+	cache.logger = id;
+	cache.ring = ring;
+#endif
+
+	return ring;
+}
+
+void AsyncLogger::_wake() {
+
+	if (atomic_compare_exchange(&wake_pending, (uint32_t)0, (uint32_t)1)) {
+		semaphore->post();
+	}
+}
+
+bool AsyncLogger::_push(Ring *p_ring, const char *p_text, uint32_t p_length, bool p_err) {
+
+	uint32_t size = (sizeof(Entry) + p_length + ENTRY_ALIGN - 1) & ~(uint32_t)(ENTRY_ALIGN - 1);
+	if (size > ring_size / 2) {
+		return false;
+	}
+
+	_ring_lock(&p_ring->lock);
+
+	uint32_t write = p_ring->write_pos;
+	uint32_t offset;
+	uint32_t tail;
+	while (true) {
+		uint32_t read = atomic_add(&p_ring->read_pos, (uint32_t)0);
+		offset = write & (ring_size - 1);
+		tail = ring_size - offset;
+		uint32_t needed = tail < size ? tail + size : size;
+		if (needed <= ring_size - (write - read)) {
+			break;
+		}
+
+		if (!p_err) {
+			atomic_increment(&dropped);
+			_ring_unlock(&p_ring->lock);
+			return true;
+		}
+
+		// Errors are never dropped, wait for the writer to make room.
+		_wake();
+		OS::get_singleton()->delay_usec(100);
+	}
+
+	if (tail < size) {
+		// The reader skips a tail too short for an entry on its own.
+		if (tail >= sizeof(Entry)) {
+			Entry *padding = (Entry *)(p_ring->data + offset);
+			padding->size = tail;
+			padding->flags = FLAG_PADDING;
+		}
+		write += tail;
+		offset = 0;
+	}
+
+	Entry *entry = (Entry *)(p_ring->data + offset);
+	entry->size = size;
+	entry->length = p_length;
+	entry->flags = p_err ? FLAG_ERROR : 0;
+	entry->sequence = atomic_increment(&sequence);
+	entry->time_usec = OS::get_singleton()->get_ticks_usec();
+	entry->thread = p_ring->owner;
+	memcpy(entry + 1, p_text, p_length);
+
+	// Only the owning thread moves write_pos, the atomic add publishes the entry.
+	atomic_add(&p_ring->write_pos, write + size - p_ring->write_pos);
+
+	_ring_unlock(&p_ring->lock);
+
+	_wake();
+	return true;
+}
+
+void AsyncLogger::_write_direct(const char *p_text, int p_length, bool p_err) {
+
+	MutexLock lock(sink_mutex);
+	sink->log_buffer(p_text, p_length, p_err);
+}
+
+void AsyncLogger::logv(const char *p_format, va_list p_list, bool p_err) {
+	if (!should_log(p_err)) {
+		return;
+	}
+
+	const int static_buf_size = 512;
+	char static_buf[static_buf_size];
+	char *buf = static_buf;
+	va_list list_copy;
+	va_copy(list_copy, p_list);
+	int len = vsnprintf(buf, static_buf_size, p_format, p_list);
+	if (len >= static_buf_size) {
+		buf = (char *)Memory::alloc_static(len + 1);
+		vsnprintf(buf, len + 1, p_format, list_copy);
+	}
+	va_end(list_copy);
+
+	if (len > 0) {
+		log_buffer(buf, len, p_err);
+	}
+
+	if (len >= static_buf_size) {
+		Memory::free_static(buf);
+	}
+}
+
+void AsyncLogger::log_error(const char *p_function, const char *p_file, int p_line, const char *p_code, const char *p_rationale, ErrorType p_type) {
+	if (!should_log(true)) {
+		return;
+	}
+
+	const char *err_details;
+	if (p_rationale && *p_rationale)
+		err_details = p_rationale;
+	else
+		err_details = p_code;
+
+	// Both lines as one message, so repeated errors can be collapsed.
+	logf_error("%s: %s\n   At: %s:%i:%s() - %s\n", get_error_type_string(p_type), err_details, p_file, p_line, p_function, p_code);
+}
+
+void AsyncLogger::log_buffer(const char *p_buffer, int p_length, bool p_err) {
+
+	if (!thread || Thread::get_caller_id() == thread_id) {
+		// Messages logged by the sink itself are written straight away.
+		_write_direct(p_buffer, p_length, p_err);
+		return;
+	}
+
+	if (!_push(_get_ring(), p_buffer, p_length, p_err)) {
+		// Too big for the ring, write it once everything before it is out.
+		flush();
+		_write_direct(p_buffer, p_length, p_err);
+	}
+}
+
+AsyncLogger::Entry *AsyncLogger::_peek(Ring *p_ring) {
+
+	while (true) {
+		uint32_t read = p_ring->read_pos;
+		uint32_t write = atomic_add(&p_ring->write_pos, (uint32_t)0);
+		if (read == write) {
+			return NULL;
+		}
+
+		uint32_t offset = read & (ring_size - 1);
+		uint32_t tail = ring_size - offset;
+		if (tail < sizeof(Entry)) {
+			atomic_add(&p_ring->read_pos, tail);
+			continue;
+		}
+
+		Entry *entry = (Entry *)(p_ring->data + offset);
+		if (entry->flags & FLAG_PADDING) {
+			atomic_add(&p_ring->read_pos, entry->size);
+			continue;
+		}
+		return entry;
+	}
+}
+
+void AsyncLogger::_flush_batch() {
+
+	if (batch_length) {
+		sink->log_buffer(batch, batch_length, batch_err);
+		batch_length = 0;
+	}
+}
+
+void AsyncLogger::_append(const char *p_text, int p_length, bool p_err) {
+
+	if (batch_length && (p_err != batch_err || batch_length + p_length > 64 * 1024)) {
+		_flush_batch();
+	}
+
+	if (batch_length + p_length > batch_capacity) {
+		batch_capacity = next_power_of_2(batch_length + p_length);
+		batch = (char *)memrealloc(batch, batch_capacity);
+	}
+
+	memcpy(batch + batch_length, p_text, p_length);
+	batch_length += p_length;
+	batch_err = p_err;
+}
+
+void AsyncLogger::_append_json(const char *p_text, int p_length, bool p_err, uint64_t p_time_usec, uint64_t p_thread) {
+
+	char head[128];
+	int head_length = snprintf(head, sizeof(head), "{\"time_usec\":%llu,\"thread\":%llu,\"level\":\"%s\",\"message\":\"", (unsigned long long)p_time_usec, (unsigned long long)p_thread, p_err ? "error" : "info");
+	_append(head, head_length, p_err);
+
+	// Every message becomes one line, its own trailing newline is implied.
+	if (p_length && p_text[p_length - 1] == '\n') {
+		p_length--;
+	}
+
+	int run = 0;
+	for (int i = 0; i < p_length; i++) {
+		uint8_t c = p_text[i];
+		if (c >= 0x20 && c != '"' && c != '\\') {
+			continue;
+		}
+
+		_append(p_text + run, i - run, p_err);
+		run = i + 1;
+
+		char escape[8];
+		int escape_length = 2;
+		escape[0] = '\\';
+		switch (c) {
+			case '"': escape[1] = '"'; break;
+			case '\\': escape[1] = '\\'; break;
+			case '\n': escape[1] = 'n'; break;
+			case '\r': escape[1] = 'r'; break;
+			case '\t': escape[1] = 't'; break;
+			default: escape_length = snprintf(escape, sizeof(escape), "\\u%04x", c); break;
+		}
+		_append(escape, escape_length, p_err);
+	}
+	_append(p_text + run, p_length - run, p_err);
+
+	_append("\"}\n", 3, p_err);
+}
+
+void AsyncLogger::_emit_notice(const char *p_what, int p_count, bool p_err) {
+
+	char text[128];
+	int length = snprintf(text, sizeof(text), "[%d %s]\n", p_count, p_what);
+	if (json_lines) {
+		_append_json(text, length, p_err, last_time_usec, thread_id);
+	} else {
+		_append(text, length, p_err);
+	}
+}
+
+void AsyncLogger::_emit(const Entry *p_entry, const char *p_text) {
+
+	bool err = p_entry->flags & FLAG_ERROR;
+	int length = p_entry->length;
+	last_time_usec = p_entry->time_usec;
+
+	if (collapse_repeated) {
+		if (err == last_err && length == last_message.size() && memcmp(p_text, last_message.ptr(), length) == 0) {
+			repeat_count++;
+			return;
+		}
+
+		if (repeat_count) {
+			_emit_notice("more of the previous message", repeat_count, last_err);
+			repeat_count = 0;
+		}
+		last_message.resize(length);
+		memcpy(last_message.ptrw(), p_text, length);
+		last_err = err;
+	}
+
+	if (max_messages_per_second > 0 && !err) {
+		if (p_entry->time_usec - rate_window_start >= 1000000) {
+			if (rate_dropped) {
+				_emit_notice("messages dropped, rate limit exceeded", rate_dropped, false);
+			}
+			rate_window_start = p_entry->time_usec;
+			rate_window_count = 0;
+			rate_dropped = 0;
+		}
+
+		if (rate_window_count >= max_messages_per_second) {
+			rate_dropped++;
+			return;
+		}
+		rate_window_count++;
+	}
+
+	if (json_lines) {
+		_append_json(p_text, length, err, p_entry->time_usec, p_entry->thread);
+	} else {
+		_append(p_text, length, err);
+	}
+}
+
+bool AsyncLogger::_drain() {
+
+	MutexLock lock(sink_mutex);
+
+	Ring *first;
+	{
+		MutexLock rings_lock(rings_mutex);
+		first = rings;
+	}
+
+	bool any = false;
+	while (true) {
+		// Rings are merged in the order messages were logged.
+		Ring *next_ring = NULL;
+		Entry *next_entry = NULL;
+		for (Ring *ring = first; ring; ring = ring->next) {
+			Entry *entry = _peek(ring);
+			if (entry && (!next_entry || entry->sequence < next_entry->sequence)) {
+				next_ring = ring;
+				next_entry = entry;
+			}
+		}
+
+		if (!next_entry) {
+			break;
+		}
+
+		_emit(next_entry, (const char *)(next_entry + 1));
+		atomic_add(&next_ring->read_pos, next_entry->size);
+		any = true;
+	}
+
+	uint32_t dropped_count = dropped;
+	if (dropped_count) {
+		atomic_sub(&dropped, dropped_count);
+		_emit_notice("messages dropped, log buffer full", dropped_count, false);
+	}
+
+	_flush_batch();
+	return any;
+}
+
+void AsyncLogger::_thread_func(void *p_user) {
+
+	AsyncLogger *self = (AsyncLogger *)p_user;
+	self->thread_id = Thread::get_caller_id();
+	Thread::set_name("Log writer");
+
+	while (true) {
+		self->semaphore->wait();
+		atomic_compare_exchange(&self->wake_pending, (uint32_t)1, (uint32_t)0);
+
+		while (self->_drain()) {
+		}
+
+		if (self->exit_thread) {
+			break;
+		}
+	}
+}
+
+void AsyncLogger::flush() {
+
+	if (!thread || Thread::get_caller_id() == thread_id) {
+		return;
+	}
+
+	while (true) {
+		Ring *first;
+		{
+			MutexLock rings_lock(rings_mutex);
+			first = rings;
+		}
+
+		bool pending = false;
+		for (Ring *ring = first; ring && !pending; ring = ring->next) {
+			pending = ring->read_pos != atomic_add(&ring->write_pos, (uint32_t)0);
+		}
+		if (!pending) {
+			break;
+		}
+
+		_wake();
+		OS::get_singleton()->delay_usec(100);
+	}
+
+	// The writer holds the sink until the batch it took out of the rings is written.
+	MutexLock lock(sink_mutex);
+}
+
+void AsyncLogger::set_json_lines(bool p_enable) {
+	json_lines = p_enable;
+}
+
+void AsyncLogger::set_collapse_repeated(bool p_enable) {
+	collapse_repeated = p_enable;
+}
+
+void AsyncLogger::set_max_messages_per_second(int p_max) {
+	max_messages_per_second = p_max;
+}
+
+AsyncLogger::AsyncLogger(Logger *p_sink, int p_ring_size_kb) :
+		sink(p_sink),
+		rings(NULL),
+		ring_count(0),
+		thread(NULL),
+		thread_id(0),
+		semaphore(NULL),
+		wake_pending(0),
+		exit_thread(0),
+		sequence(0),
+		dropped(0),
+		json_lines(false),
+		collapse_repeated(false),
+		max_messages_per_second(0),
+		batch(NULL),
+		batch_length(0),
+		batch_capacity(0),
+		batch_err(false),
+		last_err(false),
+		repeat_count(0),
+		last_time_usec(0),
+		rate_window_start(0),
+		rate_window_count(0),
+		rate_dropped(0) {
+
+	id = atomic_increment(&async_logger_count);
+	ring_size = next_power_of_2(MAX(p_ring_size_kb, 4) * 1024);
+
+	rings_mutex = Mutex::create();
+	sink_mutex = Mutex::create();
+
+	// Threads that don't get a ring of their own share this one.
+	shared_ring = _create_ring(0);
+	rings = shared_ring;
+	ring_count = 1;
+
+	semaphore = Semaphore::create();
+	if (semaphore) {
+		thread = Thread::create(_thread_func, this);
+	}
+}
+
+AsyncLogger::~AsyncLogger() {
+
+	if (thread) {
+		exit_thread = 1;
+		semaphore->post();
+		Thread::wait_to_finish(thread);
+		memdelete(thread);
+		thread = NULL;
+	}
+
+	// Whatever was logged while the writer was stopping.
+	_drain();
+	if (repeat_count) {
+		_emit_notice("more of the previous message", repeat_count, last_err);
+	}
+	if (rate_dropped) {
+		_emit_notice("messages dropped, rate limit exceeded", rate_dropped, false);
+	}
+	_flush_batch();
+
+	while (rings) {
+		Ring *next = rings->next;
+		memfree(rings->data);
+		memdelete(rings);
+		rings = next;
+	}
+
+	if (batch) {
+		memfree(batch);
+	}
+	if (semaphore) {
+		memdelete(semaphore);
+	}
+	if (rings_mutex) {
+		memdelete(rings_mutex);
+	}
+	if (sink_mutex) {
+		memdelete(sink_mutex);
+	}
+	memdelete(sink);
+}
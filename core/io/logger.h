@@ -37,6 +37,10 @@
 
 #include <stdarg.h>
 
+class Mutex;
+class Semaphore;
+class Thread;
+
 class Logger {
 protected:
 	bool should_log(bool p_err);
@@ -49,9 +53,16 @@ public:
 		ERR_SHADER
 	};
 
+protected:
+	static const char *get_error_type_string(ErrorType p_type);
+
+public:
 	virtual void logv(const char *p_format, va_list p_list, bool p_err) _PRINTF_FORMAT_ATTRIBUTE_2_0 = 0;
 	virtual void log_error(const char *p_function, const char *p_file, int p_line, const char *p_code, const char *p_rationale, ErrorType p_type = ERR_ERROR);
 
+	// Writes already formatted text, used to hand over batches of messages.
+	virtual void log_buffer(const char *p_buffer, int p_length, bool p_err);
+
 	void logf(const char *p_format, ...) _PRINTF_FORMAT_ATTRIBUTE_2_3;
 	void logf_error(const char *p_format, ...) _PRINTF_FORMAT_ATTRIBUTE_2_3;
 
@@ -65,6 +76,7 @@ class StdLogger : public Logger {
 
 public:
 	virtual void logv(const char *p_format, va_list p_list, bool p_err) _PRINTF_FORMAT_ATTRIBUTE_2_0;
+	virtual void log_buffer(const char *p_buffer, int p_length, bool p_err);
 	virtual ~StdLogger();
 };
 
@@ -89,10 +101,116 @@ public:
 	RotatedFileLogger(const String &p_base_path, int p_max_files = 10);
 
 	virtual void logv(const char *p_format, va_list p_list, bool p_err) _PRINTF_FORMAT_ATTRIBUTE_2_0;
+	virtual void log_buffer(const char *p_buffer, int p_length, bool p_err);
 
 	virtual ~RotatedFileLogger();
 };
 
+/**
+ * Formats messages on the calling thread and hands them to a background thread,
+ * which writes them to the wrapped logger in batches. Every thread gets its own
+ * ring buffer, so logging from several threads takes no lock. Optionally collapses
+ * repeated messages, limits the number of messages written per second and writes
+ * them as JSON lines. Errors are never dropped; plain messages are dropped (and
+ * counted) when a ring is full or the rate limit is hit.
+ */
+class AsyncLogger : public Logger {
+
+	enum {
+		MAX_RINGS = 64,
+		ENTRY_ALIGN = 16,
+		FLAG_ERROR = 1,
+		FLAG_PADDING = 2
+	};
+
+	struct Entry {
+		uint32_t size; // Entry and text, rounded up to ENTRY_ALIGN.
+		uint32_t length;
+		uint32_t flags;
+		uint32_t pad;
+		uint64_t sequence;
+		uint64_t time_usec;
+		uint64_t thread;
+		uint64_t pad2;
+	};
+
+	struct Ring {
+		uint8_t *data;
+		volatile uint32_t write_pos;
+		volatile uint32_t read_pos;
+		volatile uint32_t lock; // Only contended when threads share the overflow ring.
+		uint64_t owner;
+		Ring *next;
+	};
+
+	Logger *sink;
+	uint64_t id;
+	uint32_t ring_size;
+
+	Ring *rings;
+	int ring_count;
+	Ring *shared_ring;
+	Mutex *rings_mutex;
+	Mutex *sink_mutex;
+
+	Thread *thread;
+	uint64_t thread_id;
+	Semaphore *semaphore;
+	volatile uint32_t wake_pending;
+	volatile uint32_t exit_thread;
+	volatile uint64_t sequence;
+	volatile uint32_t dropped;
+
+	bool json_lines;
+	bool collapse_repeated;
+	int max_messages_per_second;
+
+	char *batch;
+	int batch_length;
+	int batch_capacity;
+	bool batch_err;
+
+	CharString last_message;
+	bool last_err;
+	int repeat_count;
+	uint64_t last_time_usec;
+	uint64_t rate_window_start;
+	int rate_window_count;
+	int rate_dropped;
+
+	Ring *_create_ring(uint64_t p_owner);
+	Ring *_get_ring();
+	Ring *_register_thread();
+	Entry *_peek(Ring *p_ring);
+	void _wake();
+	bool _push(Ring *p_ring, const char *p_text, uint32_t p_length, bool p_err);
+	void _write_direct(const char *p_text, int p_length, bool p_err);
+
+	static void _thread_func(void *p_user);
+	bool _drain();
+	void _emit(const Entry *p_entry, const char *p_text);
+	void _emit_notice(const char *p_what, int p_count, bool p_err);
+	void _append(const char *p_text, int p_length, bool p_err);
+	void _append_json(const char *p_text, int p_length, bool p_err, uint64_t p_time_usec, uint64_t p_thread);
+	void _flush_batch();
+
+public:
+	AsyncLogger(Logger *p_sink, int p_ring_size_kb = 64);
+
+	void set_json_lines(bool p_enable);
+	void set_collapse_repeated(bool p_enable);
+	void set_max_messages_per_second(int p_max);
+
+	virtual void logv(const char *p_format, va_list p_list, bool p_err) _PRINTF_FORMAT_ATTRIBUTE_2_0;
+	virtual void log_error(const char *p_function, const char *p_file, int p_line, const char *p_code, const char *p_rationale, ErrorType p_type = ERR_ERROR);
+	virtual void log_buffer(const char *p_buffer, int p_length, bool p_err);
+
+	// Blocks until everything logged so far was handed to the wrapped logger.
+	void flush();
+
+	virtual ~AsyncLogger();
+};
+
 class CompositeLogger : public Logger {
 	Vector<Logger *> loggers;
 
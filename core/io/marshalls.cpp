@@ -1390,3 +1390,415 @@ Error encode_variant(const Variant &p_variant, uint8_t *r_buffer, int &r_len, bo
 
 	return OK;
 }
+
+#define COMPACT_TYPE_MASK 0x1F
+#define COMPACT_FLAG_HALF (1 << 5)
+#define COMPACT_FLAG_64 (1 << 6)
+#define COMPACT_FLAG_TRUE (1 << 7)
+
+// Flattens the float based math types, so they can share one component loop.
+static int _get_compact_components(const Variant &p_variant, real_t *r_comp) {
+
+	switch (p_variant.get_type()) {
+		case Variant::VECTOR2: {
+			Vector2 v = p_variant;
+			r_comp[0] = v.x;
+			r_comp[1] = v.y;
+			return 2;
+		} break;
+		case Variant::RECT2: {
+			Rect2 r = p_variant;
+			r_comp[0] = r.position.x;
+			r_comp[1] = r.position.y;
+			r_comp[2] = r.size.x;
+			r_comp[3] = r.size.y;
+			return 4;
+		} break;
+		case Variant::VECTOR3: {
+			Vector3 v = p_variant;
+			for (int i = 0; i < 3; i++)
+				r_comp[i] = v[i];
+			return 3;
+		} break;
+		case Variant::TRANSFORM2D: {
+			Transform2D t = p_variant;
+			for (int i = 0; i < 3; i++) {
+				r_comp[i * 2 + 0] = t.elements[i].x;
+				r_comp[i * 2 + 1] = t.elements[i].y;
+			}
+			return 6;
+		} break;
+		case Variant::PLANE: {
+			Plane p = p_variant;
+			r_comp[0] = p.normal.x;
+			r_comp[1] = p.normal.y;
+			r_comp[2] = p.normal.z;
+			r_comp[3] = p.d;
+			return 4;
+		} break;
+		case Variant::QUAT: {
+			Quat q = p_variant;
+			r_comp[0] = q.x;
+			r_comp[1] = q.y;
+			r_comp[2] = q.z;
+			r_comp[3] = q.w;
+			return 4;
+		} break;
+		case Variant::AABB: {
+			AABB aabb = p_variant;
+			for (int i = 0; i < 3; i++) {
+				r_comp[i] = aabb.position[i];
+				r_comp[i + 3] = aabb.size[i];
+			}
+			return 6;
+		} break;
+		case Variant::BASIS: {
+			Basis b = p_variant;
+			for (int i = 0; i < 3; i++) {
+				for (int j = 0; j < 3; j++)
+					r_comp[i * 3 + j] = b.elements[i][j];
+			}
+			return 9;
+		} break;
+		case Variant::TRANSFORM: {
+			Transform t = p_variant;
+			for (int i = 0; i < 3; i++) {
+				for (int j = 0; j < 3; j++)
+					r_comp[i * 3 + j] = t.basis.elements[i][j];
+				r_comp[9 + i] = t.origin[i];
+			}
+			return 12;
+		} break;
+		case Variant::COLOR: {
+			Color c = p_variant;
+			for (int i = 0; i < 4; i++)
+				r_comp[i] = c.components[i];
+			return 4;
+		} break;
+		default: {
+		}
+	}
+
+	return 0;
+}
+
+static int _get_compact_component_count(Variant::Type p_type) {
+
+	switch (p_type) {
+		case Variant::VECTOR2: return 2;
+		case Variant::VECTOR3: return 3;
+		case Variant::RECT2:
+		case Variant::PLANE:
+		case Variant::QUAT:
+		case Variant::COLOR: return 4;
+		case Variant::TRANSFORM2D:
+		case Variant::AABB: return 6;
+		case Variant::BASIS: return 9;
+		case Variant::TRANSFORM: return 12;
+		default: {
+		}
+	}
+
+	return 0;
+}
+
+static Variant _make_from_compact_components(Variant::Type p_type, const real_t *p_comp) {
+
+	switch (p_type) {
+		case Variant::VECTOR2: {
+			return Vector2(p_comp[0], p_comp[1]);
+		} break;
+		case Variant::RECT2: {
+			return Rect2(p_comp[0], p_comp[1], p_comp[2], p_comp[3]);
+		} break;
+		case Variant::VECTOR3: {
+			return Vector3(p_comp[0], p_comp[1], p_comp[2]);
+		} break;
+		case Variant::TRANSFORM2D: {
+			Transform2D t;
+			for (int i = 0; i < 3; i++)
+				t.elements[i] = Vector2(p_comp[i * 2 + 0], p_comp[i * 2 + 1]);
+			return t;
+		} break;
+		case Variant::PLANE: {
+			return Plane(p_comp[0], p_comp[1], p_comp[2], p_comp[3]);
+		} break;
+		case Variant::QUAT: {
+			return Quat(p_comp[0], p_comp[1], p_comp[2], p_comp[3]);
+		} break;
+		case Variant::AABB: {
+			return AABB(Vector3(p_comp[0], p_comp[1], p_comp[2]), Vector3(p_comp[3], p_comp[4], p_comp[5]));
+		} break;
+		case Variant::BASIS: {
+			return Basis(p_comp[0], p_comp[1], p_comp[2], p_comp[3], p_comp[4], p_comp[5], p_comp[6], p_comp[7], p_comp[8]);
+		} break;
+		case Variant::TRANSFORM: {
+			Basis b(p_comp[0], p_comp[1], p_comp[2], p_comp[3], p_comp[4], p_comp[5], p_comp[6], p_comp[7], p_comp[8]);
+			return Transform(b, Vector3(p_comp[9], p_comp[10], p_comp[11]));
+		} break;
+		case Variant::COLOR: {
+			return Color(p_comp[0], p_comp[1], p_comp[2], p_comp[3]);
+		} break;
+		default: {
+		}
+	}
+
+	return Variant();
+}
+
+Error decode_variant_compact(Variant &r_variant, const uint8_t *p_buffer, int p_len, int *r_len, bool p_allow_objects) {
+
+	const uint8_t *buf = p_buffer;
+	int len = p_len;
+
+	ERR_FAIL_COND_V(len < 1, ERR_INVALID_DATA);
+
+	uint8_t header = *buf;
+	int type = header & COMPACT_TYPE_MASK;
+	ERR_FAIL_COND_V(type >= Variant::VARIANT_MAX, ERR_INVALID_DATA);
+	buf++;
+	len--;
+
+	switch (type) {
+
+		case Variant::NIL: {
+
+			r_variant = Variant();
+		} break;
+		case Variant::BOOL: {
+
+			r_variant = (header & COMPACT_FLAG_TRUE) != 0;
+		} break;
+		case Variant::INT: {
+
+			uint64_t zz;
+			int used = decode_varint(buf, len, zz);
+			ERR_FAIL_COND_V(used == 0, ERR_INVALID_DATA);
+			r_variant = (int64_t)(zz >> 1) ^ -(int64_t)(zz & 1);
+			buf += used;
+			len -= used;
+		} break;
+		case Variant::REAL: {
+
+			if (header & COMPACT_FLAG_64) {
+				ERR_FAIL_COND_V(len < 8, ERR_INVALID_DATA);
+				r_variant = decode_double(buf);
+				buf += 8;
+				len -= 8;
+			} else if (header & COMPACT_FLAG_HALF) {
+				ERR_FAIL_COND_V(len < 2, ERR_INVALID_DATA);
+				r_variant = Math::half_to_float(decode_uint16(buf));
+				buf += 2;
+				len -= 2;
+			} else {
+				ERR_FAIL_COND_V(len < 4, ERR_INVALID_DATA);
+				r_variant = decode_float(buf);
+				buf += 4;
+				len -= 4;
+			}
+		} break;
+		case Variant::STRING: {
+
+			uint64_t slen;
+			int used = decode_varint(buf, len, slen);
+			ERR_FAIL_COND_V(used == 0 || slen > uint64_t(len - used), ERR_INVALID_DATA);
+			buf += used;
+			len -= used;
+
+			// Parsed straight out of the packet buffer.
+			String str;
+			ERR_FAIL_COND_V(str.parse_utf8((const char *)buf, slen), ERR_INVALID_DATA);
+			r_variant = str;
+			buf += slen;
+			len -= slen;
+		} break;
+		case Variant::ARRAY: {
+
+			uint64_t count;
+			int used = decode_varint(buf, len, count);
+			ERR_FAIL_COND_V(used == 0 || count > uint64_t(len - used), ERR_INVALID_DATA); // Every element takes at least one byte.
+			buf += used;
+			len -= used;
+
+			Array array;
+			array.resize(count);
+			for (uint64_t i = 0; i < count; i++) {
+				Error err = decode_variant_compact(array[i], buf, len, &used, p_allow_objects);
+				ERR_FAIL_COND_V(err, err);
+				buf += used;
+				len -= used;
+			}
+			r_variant = array;
+		} break;
+		case Variant::DICTIONARY: {
+
+			uint64_t count;
+			int used = decode_varint(buf, len, count);
+			ERR_FAIL_COND_V(used == 0 || count * 2 > uint64_t(len - used), ERR_INVALID_DATA);
+			buf += used;
+			len -= used;
+
+			Dictionary dict;
+			for (uint64_t i = 0; i < count; i++) {
+				Variant key, value;
+				Error err = decode_variant_compact(key, buf, len, &used, p_allow_objects);
+				ERR_FAIL_COND_V(err, err);
+				buf += used;
+				len -= used;
+				err = decode_variant_compact(value, buf, len, &used, p_allow_objects);
+				ERR_FAIL_COND_V(err, err);
+				buf += used;
+				len -= used;
+				dict[key] = value;
+			}
+			r_variant = dict;
+		} break;
+		default: {
+
+			int count = _get_compact_component_count(Variant::Type(type));
+			if (count) {
+				int size = (header & COMPACT_FLAG_HALF) ? 2 : 4;
+				ERR_FAIL_COND_V(len < count * size, ERR_INVALID_DATA);
+
+				real_t comp[12];
+				for (int i = 0; i < count; i++) {
+					comp[i] = size == 2 ? Math::half_to_float(decode_uint16(&buf[i * 2])) : decode_float(&buf[i * 4]);
+				}
+				r_variant = _make_from_compact_components(Variant::Type(type), comp);
+				buf += count * size;
+				len -= count * size;
+			} else {
+				// Everything else is wrapped in the regular encoding.
+				uint64_t vlen;
+				int used = decode_varint(buf, len, vlen);
+				ERR_FAIL_COND_V(used == 0 || vlen > uint64_t(len - used), ERR_INVALID_DATA);
+				buf += used;
+				len -= used;
+
+				Error err = decode_variant(r_variant, buf, vlen, NULL, p_allow_objects);
+				ERR_FAIL_COND_V(err, err);
+				buf += vlen;
+				len -= vlen;
+			}
+		}
+	}
+
+	if (r_len)
+		*r_len = p_len - len;
+
+	return OK;
+}
+
+Error encode_variant_compact(const Variant &p_variant, uint8_t *r_buffer, int &r_len, bool p_full_objects, bool p_half_floats) {
+
+	uint8_t *buf = r_buffer;
+	Variant::Type type = p_variant.get_type();
+	uint8_t header = type;
+
+	r_len = 1;
+
+	switch (type) {
+
+		case Variant::NIL: {
+		} break;
+		case Variant::BOOL: {
+
+			if (bool(p_variant))
+				header |= COMPACT_FLAG_TRUE;
+		} break;
+		case Variant::INT: {
+
+			int64_t val = p_variant;
+			uint64_t zz = ((uint64_t)val << 1) ^ (uint64_t)(val >> 63);
+			r_len += encode_varint(zz, buf ? buf + 1 : NULL);
+		} break;
+		case Variant::REAL: {
+
+			double d = p_variant;
+			if (p_half_floats) {
+				header |= COMPACT_FLAG_HALF;
+				if (buf)
+					encode_uint16(Math::make_half_float(d), buf + 1);
+				r_len += 2;
+			} else if (double(float(d)) != d) {
+				header |= COMPACT_FLAG_64;
+				if (buf)
+					encode_double(d, buf + 1);
+				r_len += 8;
+			} else {
+				if (buf)
+					encode_float(d, buf + 1);
+				r_len += 4;
+			}
+		} break;
+		case Variant::STRING: {
+
+			CharString utf8 = p_variant.operator String().utf8();
+			int slen = utf8.length();
+			int used = encode_varint(slen, buf ? buf + 1 : NULL);
+			if (buf)
+				copymem(buf + 1 + used, utf8.get_data(), slen);
+			r_len += used + slen;
+		} break;
+		case Variant::ARRAY: {
+
+			Array array = p_variant;
+			r_len += encode_varint(array.size(), buf ? buf + 1 : NULL);
+			for (int i = 0; i < array.size(); i++) {
+				int used;
+				Error err = encode_variant_compact(array[i], buf ? buf + r_len : NULL, used, p_full_objects, p_half_floats);
+				ERR_FAIL_COND_V(err, err);
+				r_len += used;
+			}
+		} break;
+		case Variant::DICTIONARY: {
+
+			Dictionary dict = p_variant;
+			List<Variant> keys;
+			dict.get_key_list(&keys);
+			r_len += encode_varint(keys.size(), buf ? buf + 1 : NULL);
+			for (List<Variant>::Element *E = keys.front(); E; E = E->next()) {
+				int used;
+				Error err = encode_variant_compact(E->get(), buf ? buf + r_len : NULL, used, p_full_objects, p_half_floats);
+				ERR_FAIL_COND_V(err, err);
+				r_len += used;
+				err = encode_variant_compact(dict[E->get()], buf ? buf + r_len : NULL, used, p_full_objects, p_half_floats);
+				ERR_FAIL_COND_V(err, err);
+				r_len += used;
+			}
+		} break;
+		default: {
+
+			real_t comp[12];
+			int count = _get_compact_components(p_variant, comp);
+			if (count) {
+				if (p_half_floats)
+					header |= COMPACT_FLAG_HALF;
+				for (int i = 0; i < count; i++) {
+					if (p_half_floats) {
+						if (buf)
+							encode_uint16(Math::make_half_float(comp[i]), buf + r_len);
+						r_len += 2;
+					} else {
+						if (buf)
+							encode_float(comp[i], buf + r_len);
+						r_len += 4;
+					}
+				}
+			} else {
+				int vlen;
+				Error err = encode_variant(p_variant, NULL, vlen, p_full_objects);
+				ERR_FAIL_COND_V(err, err);
+				int used = encode_varint(vlen, buf ? buf + 1 : NULL);
+				if (buf)
+					encode_variant(p_variant, buf + 1 + used, vlen, p_full_objects);
+				r_len += used + vlen;
+			}
+		}
+	}
+
+	if (buf)
+		*buf = header;
+
+	return OK;
+}
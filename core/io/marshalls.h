@@ -184,6 +184,35 @@ static inline double decode_double(const uint8_t *p_arr) {
 	return md.d;
 }
 
+static inline int encode_varint(uint64_t p_uint, uint8_t *p_arr) {
+
+	int len = 0;
+	do {
+		uint8_t byte = p_uint & 0x7F;
+		p_uint >>= 7;
+		if (p_arr) {
+			*p_arr = byte | (p_uint ? 0x80 : 0);
+			p_arr++;
+		}
+		len++;
+	} while (p_uint);
+
+	return len;
+}
+
+// Returns the amount of bytes read, or 0 if p_len was too small to hold the value.
+static inline int decode_varint(const uint8_t *p_arr, int p_len, uint64_t &r_uint) {
+
+	r_uint = 0;
+	for (int i = 0; i < p_len && i < 10; i++) {
+		r_uint |= (uint64_t)(p_arr[i] & 0x7F) << (7 * i);
+		if (!(p_arr[i] & 0x80))
+			return i + 1;
+	}
+
+	return 0;
+}
+
 class EncodedObjectAsID : public Reference {
 	GDCLASS(EncodedObjectAsID, Reference);
 
@@ -202,4 +231,8 @@ public:
 Error decode_variant(Variant &r_variant, const uint8_t *p_buffer, int p_len, int *r_len = NULL, bool p_allow_objects = false);
 Error encode_variant(const Variant &p_variant, uint8_t *r_buffer, int &r_len, bool p_full_objects = false);
 
+// Tighter encoding for network messages: one byte header, varints and no padding.
+Error decode_variant_compact(Variant &r_variant, const uint8_t *p_buffer, int p_len, int *r_len = NULL, bool p_allow_objects = false);
+Error encode_variant_compact(const Variant &p_variant, uint8_t *r_buffer, int &r_len, bool p_full_objects = false, bool p_half_floats = false);
+
 #endif
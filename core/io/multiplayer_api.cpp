@@ -31,8 +31,15 @@
 #include "multiplayer_api.h"
 
 #include "core/io/marshalls.h"
+#include "core/os/os.h"
 #include "scene/main/node.h"
 
+#define REPLICATION_HISTORY_SIZE 64
+
+// Set on RPC/RSET commands when the name is sent as a negotiated id.
+#define NETWORK_COMMAND_NAME_ID_FLAG 0x80
+#define NETWORK_COMMAND_MASK 0x7F
+
 _FORCE_INLINE_ bool _should_call_local(MultiplayerAPI::RPCMode mode, bool is_master, bool &r_skip_rpc) {
 
 	switch (mode) {
@@ -87,33 +94,423 @@ _FORCE_INLINE_ bool _can_call_mode(MultiplayerAPI::RPCMode mode, int p_node_mast
 	return false;
 }
 
+// Bit level packing used by state replication. Values are stored LSB first.
+
+class ReplicationBitWriter {
+
+	Vector<uint8_t> &data;
+	uint32_t bit_pos;
+
+public:
+	void put_bits(uint64_t p_value, int p_count) {
+
+		while (p_count > 0) {
+			int used = bit_pos & 7;
+			if (used == 0)
+				data.push_back(0);
+			int n = MIN(8 - used, p_count);
+			data.write[bit_pos >> 3] |= (uint8_t)((p_value & ((1 << n) - 1)) << used);
+			p_value >>= n;
+			p_count -= n;
+			bit_pos += n;
+		}
+	}
+
+	void put_varint(uint64_t p_value) {
+
+		do {
+			uint64_t group = p_value & 0x7F;
+			p_value >>= 7;
+			put_bits(group | (p_value ? 0x80 : 0), 8);
+		} while (p_value);
+	}
+
+	void put_float(float p_value) {
+
+		union {
+			float f;
+			uint32_t i;
+		} u;
+		u.f = p_value;
+		put_bits(u.i, 32);
+	}
+
+	void put_writer(const ReplicationBitWriter &p_other) {
+
+		const uint8_t *r = p_other.data.ptr();
+		uint32_t full = p_other.bit_pos >> 3;
+		for (uint32_t i = 0; i < full; i++) {
+			put_bits(r[i], 8);
+		}
+		if (p_other.bit_pos & 7) {
+			put_bits(r[full], p_other.bit_pos & 7);
+		}
+	}
+
+	uint32_t get_bit_count() const { return bit_pos; }
+
+	ReplicationBitWriter(Vector<uint8_t> &p_data) :
+			data(p_data),
+			bit_pos(p_data.size() * 8) {}
+};
+
+class ReplicationBitReader {
+
+	const uint8_t *data;
+	uint32_t bit_size;
+	uint32_t bit_pos;
+	bool error;
+
+public:
+	uint64_t get_bits(int p_count) {
+
+		if (error || bit_pos + p_count > bit_size) {
+			error = true;
+			return 0;
+		}
+
+		uint64_t value = 0;
+		int shift = 0;
+		while (p_count > 0) {
+			int used = bit_pos & 7;
+			int n = MIN(8 - used, p_count);
+			value |= (uint64_t)((data[bit_pos >> 3] >> used) & ((1 << n) - 1)) << shift;
+			shift += n;
+			p_count -= n;
+			bit_pos += n;
+		}
+		return value;
+	}
+
+	uint64_t get_varint() {
+
+		uint64_t value = 0;
+		for (int shift = 0; shift < 64; shift += 7) {
+			uint64_t group = get_bits(8);
+			value |= (group & 0x7F) << shift;
+			if (!(group & 0x80))
+				break;
+		}
+		return value;
+	}
+
+	float get_float() {
+
+		union {
+			float f;
+			uint32_t i;
+		} u;
+		u.i = get_bits(32);
+		return u.f;
+	}
+
+	// Byte aligned payloads (variant fallback) are read through this.
+	bool get_bytes(uint8_t *p_dst, int p_len) {
+
+		for (int i = 0; i < p_len; i++) {
+			p_dst[i] = get_bits(8);
+		}
+		return !error;
+	}
+
+	void skip(uint32_t p_bits) {
+
+		if (bit_pos + p_bits > bit_size) {
+			error = true;
+			return;
+		}
+		bit_pos += p_bits;
+	}
+
+	uint32_t get_position() const { return bit_pos; }
+	uint32_t get_bits_left() const { return bit_size - bit_pos; }
+	bool has_error() const { return error; }
+
+	ReplicationBitReader(const uint8_t *p_data, int p_len) :
+			data(p_data),
+			bit_size(p_len * 8),
+			bit_pos(0),
+			error(false) {}
+};
+
+_FORCE_INLINE_ uint64_t _zigzag_encode(int64_t p_value) {
+	return ((uint64_t)p_value << 1) ^ (uint64_t)(p_value >> 63);
+}
+
+_FORCE_INLINE_ int64_t _zigzag_decode(uint64_t p_value) {
+	return (int64_t)(p_value >> 1) ^ -(int64_t)(p_value & 1);
+}
+
+_FORCE_INLINE_ real_t _quantize_real(real_t p_value, float p_step) {
+	return p_step > 0 ? Math::round(p_value / p_step) * p_step : p_value;
+}
+
+// Snaps the numeric components of p_value to the quantization step, so deltas ignore sub-step noise.
+static Variant _quantize_replicated_value(const Variant &p_value, float p_step) {
+
+	if (p_step <= 0)
+		return p_value;
+
+	switch (p_value.get_type()) {
+		case Variant::REAL: {
+			return _quantize_real(p_value, p_step);
+		} break;
+		case Variant::VECTOR2: {
+			Vector2 v = p_value;
+			return Vector2(_quantize_real(v.x, p_step), _quantize_real(v.y, p_step));
+		} break;
+		case Variant::VECTOR3: {
+			Vector3 v = p_value;
+			return Vector3(_quantize_real(v.x, p_step), _quantize_real(v.y, p_step), _quantize_real(v.z, p_step));
+		} break;
+		case Variant::QUAT: {
+			Quat q = p_value;
+			return Quat(_quantize_real(q.x, p_step), _quantize_real(q.y, p_step), _quantize_real(q.z, p_step), _quantize_real(q.w, p_step));
+		} break;
+		case Variant::COLOR: {
+			Color c = p_value;
+			return Color(_quantize_real(c.r, p_step), _quantize_real(c.g, p_step), _quantize_real(c.b, p_step), _quantize_real(c.a, p_step));
+		} break;
+		case Variant::TRANSFORM2D: {
+			// Only the origin is quantized, the step has no meaning for the basis.
+			Transform2D t = p_value;
+			t.elements[2] = Vector2(_quantize_real(t.elements[2].x, p_step), _quantize_real(t.elements[2].y, p_step));
+			return t;
+		} break;
+		case Variant::TRANSFORM: {
+			Transform t = p_value;
+			t.origin = Vector3(_quantize_real(t.origin.x, p_step), _quantize_real(t.origin.y, p_step), _quantize_real(t.origin.z, p_step));
+			return t;
+		} break;
+		default: {
+		}
+	}
+
+	return p_value;
+}
+
+static void _put_replicated_real(ReplicationBitWriter &w, real_t p_value, float p_step) {
+
+	if (p_step > 0) {
+		w.put_varint(_zigzag_encode((int64_t)Math::round(p_value / p_step)));
+	} else {
+		w.put_float(p_value);
+	}
+}
+
+static real_t _get_replicated_real(ReplicationBitReader &r, float p_step) {
+
+	if (p_step > 0) {
+		return _zigzag_decode(r.get_varint()) * p_step;
+	}
+	return r.get_float();
+}
+
+static void _encode_replicated_value(ReplicationBitWriter &w, const Variant &p_value, float p_step, bool p_allow_objects) {
+
+	w.put_bits(p_value.get_type(), 5);
+
+	switch (p_value.get_type()) {
+		case Variant::NIL: {
+		} break;
+		case Variant::BOOL: {
+			w.put_bits(bool(p_value) ? 1 : 0, 1);
+		} break;
+		case Variant::INT: {
+			w.put_varint(_zigzag_encode(p_value));
+		} break;
+		case Variant::REAL: {
+			_put_replicated_real(w, p_value, p_step);
+		} break;
+		case Variant::VECTOR2: {
+			Vector2 v = p_value;
+			_put_replicated_real(w, v.x, p_step);
+			_put_replicated_real(w, v.y, p_step);
+		} break;
+		case Variant::VECTOR3: {
+			Vector3 v = p_value;
+			for (int i = 0; i < 3; i++) {
+				_put_replicated_real(w, v[i], p_step);
+			}
+		} break;
+		case Variant::QUAT: {
+			Quat q = p_value;
+			_put_replicated_real(w, q.x, p_step);
+			_put_replicated_real(w, q.y, p_step);
+			_put_replicated_real(w, q.z, p_step);
+			_put_replicated_real(w, q.w, p_step);
+		} break;
+		case Variant::COLOR: {
+			Color c = p_value;
+			for (int i = 0; i < 4; i++) {
+				_put_replicated_real(w, c.components[i], p_step);
+			}
+		} break;
+		case Variant::TRANSFORM2D: {
+			Transform2D t = p_value;
+			for (int i = 0; i < 2; i++) {
+				w.put_float(t.elements[i].x);
+				w.put_float(t.elements[i].y);
+			}
+			_put_replicated_real(w, t.elements[2].x, p_step);
+			_put_replicated_real(w, t.elements[2].y, p_step);
+		} break;
+		case Variant::TRANSFORM: {
+			Transform t = p_value;
+			for (int i = 0; i < 3; i++) {
+				for (int j = 0; j < 3; j++) {
+					w.put_float(t.basis.elements[i][j]);
+				}
+			}
+			for (int i = 0; i < 3; i++) {
+				_put_replicated_real(w, t.origin[i], p_step);
+			}
+		} break;
+		default: {
+			// Anything else is sent with the regular variant marshalling.
+			int len;
+			Error err = encode_variant(p_value, NULL, len, p_allow_objects);
+			ERR_FAIL_COND(err != OK);
+
+			Vector<uint8_t> buf;
+			buf.resize(len);
+			encode_variant(p_value, buf.ptrw(), len, p_allow_objects);
+
+			w.put_varint(len);
+			for (int i = 0; i < len; i++) {
+				w.put_bits(buf[i], 8);
+			}
+		}
+	}
+}
+
+static bool _decode_replicated_value(ReplicationBitReader &r, Variant &r_value, float p_step, bool p_allow_objects) {
+
+	int type = r.get_bits(5);
+	ERR_FAIL_COND_V(type >= Variant::VARIANT_MAX, false);
+
+	switch (type) {
+		case Variant::NIL: {
+			r_value = Variant();
+		} break;
+		case Variant::BOOL: {
+			r_value = r.get_bits(1) != 0;
+		} break;
+		case Variant::INT: {
+			r_value = _zigzag_decode(r.get_varint());
+		} break;
+		case Variant::REAL: {
+			r_value = _get_replicated_real(r, p_step);
+		} break;
+		case Variant::VECTOR2: {
+			Vector2 v;
+			v.x = _get_replicated_real(r, p_step);
+			v.y = _get_replicated_real(r, p_step);
+			r_value = v;
+		} break;
+		case Variant::VECTOR3: {
+			Vector3 v;
+			for (int i = 0; i < 3; i++) {
+				v[i] = _get_replicated_real(r, p_step);
+			}
+			r_value = v;
+		} break;
+		case Variant::QUAT: {
+			Quat q;
+			q.x = _get_replicated_real(r, p_step);
+			q.y = _get_replicated_real(r, p_step);
+			q.z = _get_replicated_real(r, p_step);
+			q.w = _get_replicated_real(r, p_step);
+			r_value = q;
+		} break;
+		case Variant::COLOR: {
+			Color c;
+			for (int i = 0; i < 4; i++) {
+				c.components[i] = _get_replicated_real(r, p_step);
+			}
+			r_value = c;
+		} break;
+		case Variant::TRANSFORM2D: {
+			Transform2D t;
+			for (int i = 0; i < 2; i++) {
+				t.elements[i].x = r.get_float();
+				t.elements[i].y = r.get_float();
+			}
+			t.elements[2].x = _get_replicated_real(r, p_step);
+			t.elements[2].y = _get_replicated_real(r, p_step);
+			r_value = t;
+		} break;
+		case Variant::TRANSFORM: {
+			Transform t;
+			for (int i = 0; i < 3; i++) {
+				for (int j = 0; j < 3; j++) {
+					t.basis.elements[i][j] = r.get_float();
+				}
+			}
+			for (int i = 0; i < 3; i++) {
+				t.origin[i] = _get_replicated_real(r, p_step);
+			}
+			r_value = t;
+		} break;
+		default: {
+			uint64_t len = r.get_varint();
+			ERR_FAIL_COND_V(r.has_error() || len * 8 > r.get_bits_left(), false);
+
+			Vector<uint8_t> buf;
+			buf.resize(len);
+			r.get_bytes(buf.ptrw(), len);
+
+			Error err = decode_variant(r_value, buf.ptr(), len, NULL, p_allow_objects);
+			ERR_FAIL_COND_V(err != OK, false);
+		}
+	}
+
+	return !r.has_error();
+}
+
 void MultiplayerAPI::poll() {
 
-	if (!network_peer.is_valid() || network_peer->get_connection_status() == NetworkedMultiplayerPeer::CONNECTION_DISCONNECTED)
-		return;
+	if (network_thread) {
+		_process_network_events();
+	} else {
+
+		if (!network_peer.is_valid() || network_peer->get_connection_status() == NetworkedMultiplayerPeer::CONNECTION_DISCONNECTED)
+			return;
 
-	network_peer->poll();
+		network_peer->poll();
 
-	if (!network_peer.is_valid()) // It's possible that polling might have resulted in a disconnection, so check here.
-		return;
+		if (!network_peer.is_valid()) // It's possible that polling might have resulted in a disconnection, so check here.
+			return;
+
+		while (network_peer->get_available_packet_count()) {
+
+			int sender = network_peer->get_packet_peer();
+			const uint8_t *packet;
+			int len;
 
-	while (network_peer->get_available_packet_count()) {
+			Error err = network_peer->get_packet(&packet, len);
+			if (err != OK) {
+				ERR_PRINT("Error getting packet!");
+			}
 
-		int sender = network_peer->get_packet_peer();
-		const uint8_t *packet;
-		int len;
+			rpc_sender_id = sender;
+			_process_packet(sender, packet, len);
+			rpc_sender_id = 0;
 
-		Error err = network_peer->get_packet(&packet, len);
-		if (err != OK) {
-			ERR_PRINT("Error getting packet!");
+			if (!network_peer.is_valid()) {
+				break; // It's also possible that a packet or RPC caused a disconnection, so also check here.
+			}
 		}
+	}
 
-		rpc_sender_id = sender;
-		_process_packet(sender, packet, len);
-		rpc_sender_id = 0;
+	if (network_peer.is_valid() && replication_tick_rate > 0 && !replicated_nodes.empty()) {
 
-		if (!network_peer.is_valid()) {
-			break; // It's also possible that a packet or RPC caused a disconnection, so also check here.
+		uint64_t interval = 1000000 / replication_tick_rate;
+		uint64_t now = OS::get_singleton()->get_ticks_usec();
+		if (now - replication_last_tick_usec >= interval) {
+			// Keep a steady rate, but don't try to catch up after a long stall.
+			replication_last_tick_usec = (now - replication_last_tick_usec >= interval * 2) ? now : replication_last_tick_usec + interval;
+			replicate();
 		}
 	}
 }
@@ -124,6 +521,11 @@ void MultiplayerAPI::clear() {
 	path_send_cache.clear();
 	packet_cache.clear();
 	last_send_cache_id = 1;
+	name_send_cache.clear();
+	last_name_cache_id = 1;
+	replication_history.clear();
+	replication_peers.clear();
+	replication_tick = 0;
 }
 
 void MultiplayerAPI::set_root_node(Node *p_node) {
@@ -135,11 +537,15 @@ void MultiplayerAPI::set_network_peer(const Ref<NetworkedMultiplayerPeer> &p_pee
 	if (p_peer == network_peer) return; // Nothing to do
 
 	if (network_peer.is_valid()) {
-		network_peer->disconnect("peer_connected", this, "_add_peer");
-		network_peer->disconnect("peer_disconnected", this, "_del_peer");
-		network_peer->disconnect("connection_succeeded", this, "_connected_to_server");
-		network_peer->disconnect("connection_failed", this, "_connection_failed");
-		network_peer->disconnect("server_disconnected", this, "_server_disconnected");
+		if (network_thread) {
+			_stop_network_thread();
+		} else {
+			network_peer->disconnect("peer_connected", this, "_add_peer");
+			network_peer->disconnect("peer_disconnected", this, "_del_peer");
+			network_peer->disconnect("connection_succeeded", this, "_connected_to_server");
+			network_peer->disconnect("connection_failed", this, "_connection_failed");
+			network_peer->disconnect("server_disconnected", this, "_server_disconnected");
+		}
 		clear();
 	}
 
@@ -149,11 +555,15 @@ void MultiplayerAPI::set_network_peer(const Ref<NetworkedMultiplayerPeer> &p_pee
 	ERR_FAIL_COND(p_peer.is_valid() && p_peer->get_connection_status() == NetworkedMultiplayerPeer::CONNECTION_DISCONNECTED);
 
 	if (network_peer.is_valid()) {
-		network_peer->connect("peer_connected", this, "_add_peer");
-		network_peer->connect("peer_disconnected", this, "_del_peer");
-		network_peer->connect("connection_succeeded", this, "_connected_to_server");
-		network_peer->connect("connection_failed", this, "_connection_failed");
-		network_peer->connect("server_disconnected", this, "_server_disconnected");
+		if (threaded_polling) {
+			_start_network_thread();
+		} else {
+			network_peer->connect("peer_connected", this, "_add_peer");
+			network_peer->connect("peer_disconnected", this, "_del_peer");
+			network_peer->connect("connection_succeeded", this, "_connected_to_server");
+			network_peer->connect("connection_failed", this, "_connection_failed");
+			network_peer->connect("server_disconnected", this, "_server_disconnected");
+		}
 	}
 }
 
@@ -168,7 +578,9 @@ void MultiplayerAPI::_process_packet(int p_from, const uint8_t *p_packet, int p_
 	ERR_EXPLAIN("Invalid packet received. Size too small.");
 	ERR_FAIL_COND(p_packet_len < 1);
 
-	uint8_t packet_type = p_packet[0];
+	bytes_received += p_packet_len;
+
+	uint8_t packet_type = p_packet[0] & NETWORK_COMMAND_MASK;
 
 	switch (packet_type) {
 
@@ -182,6 +594,16 @@ void MultiplayerAPI::_process_packet(int p_from, const uint8_t *p_packet, int p_
 			_process_confirm_path(p_from, p_packet, p_packet_len);
 		} break;
 
+		case NETWORK_COMMAND_SIMPLIFY_NAME: {
+
+			_process_simplify_name(p_from, p_packet, p_packet_len);
+		} break;
+
+		case NETWORK_COMMAND_CONFIRM_NAME: {
+
+			_process_confirm_name(p_from, p_packet, p_packet_len);
+		} break;
+
 		case NETWORK_COMMAND_REMOTE_CALL:
 		case NETWORK_COMMAND_REMOTE_SET: {
 
@@ -193,18 +615,37 @@ void MultiplayerAPI::_process_packet(int p_from, const uint8_t *p_packet, int p_
 			ERR_EXPLAIN("Invalid packet received. Requested node was not found.");
 			ERR_FAIL_COND(node == NULL);
 
-			// Detect cstring end.
-			int len_end = 5;
-			for (; len_end < p_packet_len; len_end++) {
-				if (p_packet[len_end] == 0) {
-					break;
+			StringName name;
+			int len_end;
+
+			if (p_packet[0] & NETWORK_COMMAND_NAME_ID_FLAG) {
+
+				uint64_t name_id;
+				int used = decode_varint(&p_packet[5], p_packet_len - 5, name_id);
+				ERR_EXPLAIN("Invalid packet received. Size too small.");
+				ERR_FAIL_COND(used == 0);
+
+				const Map<int, StringName>::Element *N = path_get_cache[p_from].names.find(name_id);
+				ERR_EXPLAIN("Invalid packet received. Unable to find requested cached name.");
+				ERR_FAIL_COND(!N);
+
+				name = N->get();
+				len_end = 5 + used - 1;
+			} else {
+
+				// Detect cstring end.
+				len_end = 5;
+				for (; len_end < p_packet_len; len_end++) {
+					if (p_packet[len_end] == 0) {
+						break;
+					}
 				}
-			}
 
-			ERR_EXPLAIN("Invalid packet received. Size too small.");
-			ERR_FAIL_COND(len_end >= p_packet_len);
+				ERR_EXPLAIN("Invalid packet received. Size too small.");
+				ERR_FAIL_COND(len_end >= p_packet_len);
 
-			StringName name = String::utf8((const char *)&p_packet[5]);
+				name = String::utf8((const char *)&p_packet[5]);
+			}
 
 			if (packet_type == NETWORK_COMMAND_REMOTE_CALL) {
 
@@ -221,6 +662,16 @@ void MultiplayerAPI::_process_packet(int p_from, const uint8_t *p_packet, int p_
 
 			_process_raw(p_from, p_packet, p_packet_len);
 		} break;
+
+		case NETWORK_COMMAND_REPLICATION_SNAPSHOT: {
+
+			_process_replication_snapshot(p_from, p_packet, p_packet_len);
+		} break;
+
+		case NETWORK_COMMAND_REPLICATION_ACK: {
+
+			_process_replication_ack(p_from, p_packet, p_packet_len);
+		} break;
 	}
 }
 
@@ -273,6 +724,10 @@ void MultiplayerAPI::_process_rpc(Node *p_node, const StringName &p_name, int p_
 	ERR_EXPLAIN("Invalid packet received. Size too small.");
 	ERR_FAIL_COND(p_offset >= p_packet_len);
 
+	if (profiling) {
+		_profile_rpc(p_node, p_name, false, true, p_packet_len);
+	}
+
 	// Check that remote can call the RPC on this node.
 	RPCMode rpc_mode = RPC_MODE_DISABLED;
 	const Map<StringName, RPCMode>::Element *E = p_node->get_node_rpc_mode(p_name);
@@ -300,7 +755,7 @@ void MultiplayerAPI::_process_rpc(Node *p_node, const StringName &p_name, int p_
 		ERR_FAIL_COND(p_offset >= p_packet_len);
 
 		int vlen;
-		Error err = decode_variant(args.write[i], &p_packet[p_offset], p_packet_len - p_offset, &vlen, allow_object_decoding || network_peer->is_object_decoding_allowed());
+		Error err = decode_variant_compact(args.write[i], &p_packet[p_offset], p_packet_len - p_offset, &vlen, allow_object_decoding || network_peer->is_object_decoding_allowed());
 		ERR_EXPLAIN("Invalid packet received. Unable to decode RPC argument.");
 		ERR_FAIL_COND(err != OK);
 
@@ -323,6 +778,10 @@ void MultiplayerAPI::_process_rset(Node *p_node, const StringName &p_name, int p
 	ERR_EXPLAIN("Invalid packet received. Size too small.");
 	ERR_FAIL_COND(p_offset >= p_packet_len);
 
+	if (profiling) {
+		_profile_rpc(p_node, p_name, true, true, p_packet_len);
+	}
+
 	// Check that remote can call the RSET on this node.
 	RPCMode rset_mode = RPC_MODE_DISABLED;
 	const Map<StringName, RPCMode>::Element *E = p_node->get_node_rset_mode(p_name);
@@ -337,7 +796,7 @@ void MultiplayerAPI::_process_rset(Node *p_node, const StringName &p_name, int p
 	ERR_FAIL_COND(!_can_call_mode(rset_mode, p_from, node_master_id));
 
 	Variant value;
-	Error err = decode_variant(value, &p_packet[p_offset], p_packet_len - p_offset, NULL, allow_object_decoding || network_peer->is_object_decoding_allowed());
+	Error err = decode_variant_compact(value, &p_packet[p_offset], p_packet_len - p_offset, NULL, allow_object_decoding || network_peer->is_object_decoding_allowed());
 
 	ERR_EXPLAIN("Invalid packet received. Unable to decode RSET value.");
 	ERR_FAIL_COND(err != OK);
@@ -382,9 +841,7 @@ void MultiplayerAPI::_process_simplify_path(int p_from, const uint8_t *p_packet,
 	packet.write[0] = NETWORK_COMMAND_CONFIRM_PATH;
 	encode_cstring(pname.get_data(), &packet.write[1]);
 
-	network_peer->set_transfer_mode(NetworkedMultiplayerPeer::TRANSFER_MODE_RELIABLE);
-	network_peer->set_target_peer(p_from);
-	network_peer->put_packet(packet.ptr(), packet.size());
+	_put_packet(p_from, NetworkedMultiplayerPeer::TRANSFER_MODE_RELIABLE, packet.ptr(), packet.size());
 }
 
 void MultiplayerAPI::_process_confirm_path(int p_from, const uint8_t *p_packet, int p_packet_len) {
@@ -407,7 +864,44 @@ void MultiplayerAPI::_process_confirm_path(int p_from, const uint8_t *p_packet,
 	E->get() = true;
 }
 
-bool MultiplayerAPI::_send_confirm_path(NodePath p_path, PathSentCache *psc, int p_target) {
+void MultiplayerAPI::_process_simplify_name(int p_from, const uint8_t *p_packet, int p_packet_len) {
+
+	ERR_EXPLAIN("Invalid packet received. Size too small.");
+	ERR_FAIL_COND(p_packet_len < 6);
+	int id = decode_uint32(&p_packet[1]);
+
+	String names;
+	names.parse_utf8((const char *)&p_packet[5], p_packet_len - 5);
+
+	path_get_cache[p_from].names[id] = names;
+
+	Vector<uint8_t> packet;
+	packet.resize(1 + p_packet_len - 5);
+	packet.write[0] = NETWORK_COMMAND_CONFIRM_NAME;
+	memcpy(&packet.write[1], &p_packet[5], p_packet_len - 5);
+
+	_put_packet(p_from, NetworkedMultiplayerPeer::TRANSFER_MODE_RELIABLE, packet.ptr(), packet.size());
+}
+
+void MultiplayerAPI::_process_confirm_name(int p_from, const uint8_t *p_packet, int p_packet_len) {
+
+	ERR_EXPLAIN("Invalid packet received. Size too small.");
+	ERR_FAIL_COND(p_packet_len < 2);
+
+	String names;
+	names.parse_utf8((const char *)&p_packet[1], p_packet_len - 1);
+
+	PathSentCache *nsc = name_send_cache.getptr(names);
+	ERR_EXPLAIN("Invalid packet received. Tries to confirm a name which was not found in cache.");
+	ERR_FAIL_COND(!nsc);
+
+	Map<int, bool>::Element *E = nsc->confirmed_peers.find(p_from);
+	ERR_EXPLAIN("Invalid packet received. Source peer was not found in cache for the given name.");
+	ERR_FAIL_COND(!E);
+	E->get() = true;
+}
+
+bool MultiplayerAPI::_send_confirm_cache(PathSentCache *psc, int p_target, uint8_t p_command, const String &p_value) {
 	bool has_all_peers = true;
 	List<int> peers_to_add; // If one is missing, take note to add it.
 
@@ -436,20 +930,18 @@ bool MultiplayerAPI::_send_confirm_path(NodePath p_path, PathSentCache *psc, int
 
 	for (List<int>::Element *E = peers_to_add.front(); E; E = E->next()) {
 
-		// Encode function name.
-		CharString pname = String(p_path).utf8();
+		// Encode path or name.
+		CharString pname = p_value.utf8();
 		int len = encode_cstring(pname.get_data(), NULL);
 
 		Vector<uint8_t> packet;
 
 		packet.resize(1 + 4 + len);
-		packet.write[0] = NETWORK_COMMAND_SIMPLIFY_PATH;
+		packet.write[0] = p_command;
 		encode_uint32(psc->id, &packet.write[1]);
 		encode_cstring(pname.get_data(), &packet.write[5]);
 
-		network_peer->set_target_peer(E->get()); // To all of you.
-		network_peer->set_transfer_mode(NetworkedMultiplayerPeer::TRANSFER_MODE_RELIABLE);
-		network_peer->put_packet(packet.ptr(), packet.size());
+		_put_packet(E->get(), NetworkedMultiplayerPeer::TRANSFER_MODE_RELIABLE, packet.ptr(), packet.size());
 
 		psc->confirmed_peers.insert(E->get(), false); // Insert into confirmed, but as false since it was not confirmed.
 	}
@@ -457,6 +949,46 @@ bool MultiplayerAPI::_send_confirm_path(NodePath p_path, PathSentCache *psc, int
 	return has_all_peers;
 }
 
+bool MultiplayerAPI::_send_confirm_path(NodePath p_path, PathSentCache *psc, int p_target) {
+
+	return _send_confirm_cache(psc, p_target, NETWORK_COMMAND_SIMPLIFY_PATH, String(p_path));
+}
+
+Error MultiplayerAPI::_put_packet(int p_to, NetworkedMultiplayerPeer::TransferMode p_mode, const uint8_t *p_data, int p_len) {
+
+	bytes_sent += (uint64_t)p_len * _get_target_count(p_to);
+
+	// Target and mode are peer state, so they must be set under the same lock as the send.
+	MutexLock lock(network_mutex);
+	network_peer->set_target_peer(p_to);
+	network_peer->set_transfer_mode(p_mode);
+	return network_peer->put_packet(p_data, p_len);
+}
+
+MultiplayerAPI::PathSentCache *MultiplayerAPI::_get_path_send_cache(const NodePath &p_path) {
+
+	// See if the path is cached.
+	PathSentCache *psc = path_send_cache.getptr(p_path);
+	if (!psc) {
+		// Path is not cached, create.
+		path_send_cache[p_path] = PathSentCache();
+		psc = path_send_cache.getptr(p_path);
+		psc->id = last_send_cache_id++;
+	}
+	return psc;
+}
+
+MultiplayerAPI::PathSentCache *MultiplayerAPI::_get_name_send_cache(const StringName &p_name) {
+
+	PathSentCache *nsc = name_send_cache.getptr(p_name);
+	if (!nsc) {
+		name_send_cache[p_name] = PathSentCache();
+		nsc = name_send_cache.getptr(p_name);
+		nsc->id = last_name_cache_id++;
+	}
+	return nsc;
+}
+
 void MultiplayerAPI::_send_rpc(Node *p_from, int p_to, bool p_unreliable, bool p_set, const StringName &p_name, const Variant **p_arg, int p_argcount) {
 
 	if (network_peer.is_null()) {
@@ -493,14 +1025,7 @@ void MultiplayerAPI::_send_rpc(Node *p_from, int p_to, bool p_unreliable, bool p
 	ERR_EXPLAIN("Unable to send RPC. Relative path is empty. THIS IS LIKELY A BUG IN THE ENGINE!");
 	ERR_FAIL_COND(from_path.is_empty());
 
-	// See if the path is cached.
-	PathSentCache *psc = path_send_cache.getptr(from_path);
-	if (!psc) {
-		// Path is not cached, create.
-		path_send_cache[from_path] = PathSentCache();
-		psc = path_send_cache.getptr(from_path);
-		psc->id = last_send_cache_id++;
-	}
+	PathSentCache *psc = _get_path_send_cache(from_path);
 
 	// Create base packet, lots of hardcode because it must be tight.
 
@@ -519,20 +1044,29 @@ void MultiplayerAPI::_send_rpc(Node *p_from, int p_to, bool p_unreliable, bool p
 	encode_uint32(psc->id, &(packet_cache.write[ofs]));
 	ofs += 4;
 
-	// Encode function name.
-	CharString name = String(p_name).utf8();
-	int len = encode_cstring(name.get_data(), NULL);
-	MAKE_ROOM(ofs + len);
-	encode_cstring(name.get_data(), &(packet_cache.write[ofs]));
+	// Encode function name, as an id once every target knows it.
+	int len;
+	PathSentCache *nsc = _get_name_send_cache(p_name);
+	if (_send_confirm_cache(nsc, p_to, NETWORK_COMMAND_SIMPLIFY_NAME, p_name)) {
+		packet_cache.write[0] |= NETWORK_COMMAND_NAME_ID_FLAG;
+		len = encode_varint(nsc->id, NULL);
+		MAKE_ROOM(ofs + len);
+		encode_varint(nsc->id, &(packet_cache.write[ofs]));
+	} else {
+		CharString name = String(p_name).utf8();
+		len = encode_cstring(name.get_data(), NULL);
+		MAKE_ROOM(ofs + len);
+		encode_cstring(name.get_data(), &(packet_cache.write[ofs]));
+	}
 	ofs += len;
 
 	if (p_set) {
 		// Set argument.
-		Error err = encode_variant(*p_arg[0], NULL, len, allow_object_decoding || network_peer->is_object_decoding_allowed());
+		Error err = encode_variant_compact(*p_arg[0], NULL, len, allow_object_decoding || network_peer->is_object_decoding_allowed(), rpc_half_floats);
 		ERR_EXPLAIN("Unable to encode RSET value. THIS IS LIKELY A BUG IN THE ENGINE!");
 		ERR_FAIL_COND(err != OK);
 		MAKE_ROOM(ofs + len);
-		encode_variant(*p_arg[0], &(packet_cache.write[ofs]), len, allow_object_decoding || network_peer->is_object_decoding_allowed());
+		encode_variant_compact(*p_arg[0], &(packet_cache.write[ofs]), len, allow_object_decoding || network_peer->is_object_decoding_allowed(), rpc_half_floats);
 		ofs += len;
 
 	} else {
@@ -541,11 +1075,11 @@ void MultiplayerAPI::_send_rpc(Node *p_from, int p_to, bool p_unreliable, bool p
 		packet_cache.write[ofs] = p_argcount;
 		ofs += 1;
 		for (int i = 0; i < p_argcount; i++) {
-			Error err = encode_variant(*p_arg[i], NULL, len, allow_object_decoding || network_peer->is_object_decoding_allowed());
+			Error err = encode_variant_compact(*p_arg[i], NULL, len, allow_object_decoding || network_peer->is_object_decoding_allowed(), rpc_half_floats);
 			ERR_EXPLAIN("Unable to encode RPC argument. THIS IS LIKELY A BUG IN THE ENGINE!");
 			ERR_FAIL_COND(err != OK);
 			MAKE_ROOM(ofs + len);
-			encode_variant(*p_arg[i], &(packet_cache.write[ofs]), len, allow_object_decoding || network_peer->is_object_decoding_allowed());
+			encode_variant_compact(*p_arg[i], &(packet_cache.write[ofs]), len, allow_object_decoding || network_peer->is_object_decoding_allowed(), rpc_half_floats);
 			ofs += len;
 		}
 	}
@@ -553,14 +1087,15 @@ void MultiplayerAPI::_send_rpc(Node *p_from, int p_to, bool p_unreliable, bool p
 	// See if all peers have cached path (is so, call can be fast).
 	bool has_all_peers = _send_confirm_path(from_path, psc, p_to);
 
-	// Take chance and set transfer mode, since all send methods will use it.
-	network_peer->set_transfer_mode(p_unreliable ? NetworkedMultiplayerPeer::TRANSFER_MODE_UNRELIABLE : NetworkedMultiplayerPeer::TRANSFER_MODE_RELIABLE);
+	NetworkedMultiplayerPeer::TransferMode mode = p_unreliable ? NetworkedMultiplayerPeer::TRANSFER_MODE_UNRELIABLE : NetworkedMultiplayerPeer::TRANSFER_MODE_RELIABLE;
+
+	int sent = 0;
 
 	if (has_all_peers) {
 
 		// They all have verified paths, so send fast.
-		network_peer->set_target_peer(p_to); // To all of you.
-		network_peer->put_packet(packet_cache.ptr(), ofs); // A message with love.
+		_put_packet(p_to, mode, packet_cache.ptr(), ofs); // A message with love.
+		sent = ofs * _get_target_count(p_to);
 	} else {
 		// Not all verified path, so send one by one.
 
@@ -581,19 +1116,23 @@ void MultiplayerAPI::_send_rpc(Node *p_from, int p_to, bool p_unreliable, bool p
 			Map<int, bool>::Element *F = psc->confirmed_peers.find(E->get());
 			ERR_CONTINUE(!F); // Should never happen.
 
-			network_peer->set_target_peer(E->get()); // To this one specifically.
-
 			if (F->get()) {
 				// This one confirmed path, so use id.
 				encode_uint32(psc->id, &(packet_cache.write[1]));
-				network_peer->put_packet(packet_cache.ptr(), ofs);
+				_put_packet(E->get(), mode, packet_cache.ptr(), ofs);
+				sent += ofs;
 			} else {
 				// This one did not confirm path yet, so use entire path (sorry!).
 				encode_uint32(0x80000000 | ofs, &(packet_cache.write[1])); // Offset to path and flag.
-				network_peer->put_packet(packet_cache.ptr(), ofs + path_len);
+				_put_packet(E->get(), mode, packet_cache.ptr(), ofs + path_len);
+				sent += ofs + path_len;
 			}
 		}
 	}
+
+	if (profiling) {
+		_profile_rpc(p_from, p_name, p_set, false, sent);
+	}
 }
 
 void MultiplayerAPI::_add_peer(int p_id) {
@@ -605,6 +1144,7 @@ void MultiplayerAPI::_add_peer(int p_id) {
 void MultiplayerAPI::_del_peer(int p_id) {
 	connected_peers.erase(p_id);
 	path_get_cache.erase(p_id); // I no longer need your cache, sorry.
+	replication_peers.erase(p_id);
 	emit_signal("network_peer_disconnected", p_id);
 }
 
@@ -757,10 +1297,7 @@ Error MultiplayerAPI::send_bytes(PoolVector<uint8_t> p_data, int p_to, Networked
 	packet_cache.write[0] = NETWORK_COMMAND_RAW;
 	memcpy(&packet_cache.write[1], &r[0], p_data.size());
 
-	network_peer->set_target_peer(p_to);
-	network_peer->set_transfer_mode(p_mode);
-
-	return network_peer->put_packet(packet_cache.ptr(), p_data.size() + 1);
+	return _put_packet(p_to, p_mode, packet_cache.ptr(), p_data.size() + 1);
 }
 
 void MultiplayerAPI::_process_raw(int p_from, const uint8_t *p_packet, int p_packet_len) {
@@ -797,6 +1334,7 @@ void MultiplayerAPI::set_refuse_new_network_connections(bool p_refuse) {
 
 	ERR_EXPLAIN("No network peer is assigned. Unable to set 'refuse_new_connections'.");
 	ERR_FAIL_COND(!network_peer.is_valid());
+	MutexLock lock(network_mutex);
 	network_peer->set_refuse_new_connections(p_refuse);
 }
 
@@ -830,6 +1368,641 @@ bool MultiplayerAPI::is_object_decoding_allowed() const {
 	return allow_object_decoding;
 }
 
+void MultiplayerAPI::replicate_property(Node *p_node, const StringName &p_property, float p_quantization) {
+
+	ERR_FAIL_NULL(p_node);
+
+	Vector<ReplicatedProperty> &props = replicated_nodes[p_node->get_instance_id()];
+	for (int i = 0; i < props.size(); i++) {
+		if (props[i].name == p_property) {
+			props.write[i].quantization = p_quantization;
+			return;
+		}
+	}
+
+	ReplicatedProperty rp;
+	rp.name = p_property;
+	rp.quantization = p_quantization;
+	props.push_back(rp);
+}
+
+void MultiplayerAPI::stop_replicating_property(Node *p_node, const StringName &p_property) {
+
+	ERR_FAIL_NULL(p_node);
+
+	Map<ObjectID, Vector<ReplicatedProperty> >::Element *E = replicated_nodes.find(p_node->get_instance_id());
+	if (!E)
+		return;
+
+	for (int i = 0; i < E->get().size(); i++) {
+		if (E->get()[i].name == p_property) {
+			E->get().remove(i);
+			break;
+		}
+	}
+
+	if (E->get().empty()) {
+		replicated_nodes.erase(E);
+	}
+}
+
+void MultiplayerAPI::stop_replicating(Node *p_node) {
+
+	ERR_FAIL_NULL(p_node);
+	replicated_nodes.erase(p_node->get_instance_id());
+}
+
+bool MultiplayerAPI::is_replicating_property(Node *p_node, const StringName &p_property) const {
+
+	ERR_FAIL_NULL_V(p_node, false);
+
+	const Map<ObjectID, Vector<ReplicatedProperty> >::Element *E = replicated_nodes.find(p_node->get_instance_id());
+	if (!E)
+		return false;
+
+	for (int i = 0; i < E->get().size(); i++) {
+		if (E->get()[i].name == p_property)
+			return true;
+	}
+	return false;
+}
+
+void MultiplayerAPI::set_replication_tick_rate(int p_rate) {
+
+	ERR_FAIL_COND(p_rate < 0);
+	replication_tick_rate = p_rate;
+}
+
+void MultiplayerAPI::_network_thread_func(void *p_ud) {
+
+	MultiplayerAPI *mp = (MultiplayerAPI *)p_ud;
+
+	while (!mp->network_thread_exit) {
+
+		mp->network_mutex->lock();
+
+		Ref<NetworkedMultiplayerPeer> peer = mp->network_peer;
+		if (peer.is_valid() && peer->get_connection_status() != NetworkedMultiplayerPeer::CONNECTION_DISCONNECTED) {
+
+			// Connection signals fire from inside poll() and get queued in order with the packets.
+			peer->poll();
+
+			while (peer->get_available_packet_count()) {
+
+				NetworkEvent ev;
+				ev.type = NetworkEvent::TYPE_PACKET;
+				ev.from = peer->get_packet_peer();
+
+				const uint8_t *packet;
+				int len;
+				if (peer->get_packet(&packet, len) != OK) {
+					ERR_PRINT("Error getting packet!");
+					continue;
+				}
+
+				ev.data.resize(len);
+				if (len) {
+					copymem(ev.data.ptrw(), packet, len);
+				}
+				mp->network_events.push_back(ev);
+			}
+		}
+
+		mp->network_mutex->unlock();
+
+		OS::get_singleton()->delay_usec(1000);
+	}
+}
+
+void MultiplayerAPI::_start_network_thread() {
+
+	network_thread_exit = false;
+	network_peer->connect("peer_connected", this, "_queue_peer_event", varray(NetworkEvent::TYPE_PEER_CONNECTED));
+	network_peer->connect("peer_disconnected", this, "_queue_peer_event", varray(NetworkEvent::TYPE_PEER_DISCONNECTED));
+	network_peer->connect("connection_succeeded", this, "_queue_connection_event", varray(NetworkEvent::TYPE_CONNECTION_SUCCEEDED));
+	network_peer->connect("connection_failed", this, "_queue_connection_event", varray(NetworkEvent::TYPE_CONNECTION_FAILED));
+	network_peer->connect("server_disconnected", this, "_queue_connection_event", varray(NetworkEvent::TYPE_SERVER_DISCONNECTED));
+	network_thread = Thread::create(_network_thread_func, this);
+}
+
+void MultiplayerAPI::_stop_network_thread() {
+
+	network_thread_exit = true;
+	Thread::wait_to_finish(network_thread);
+	memdelete(network_thread);
+	network_thread = NULL;
+
+	network_peer->disconnect("peer_connected", this, "_queue_peer_event");
+	network_peer->disconnect("peer_disconnected", this, "_queue_peer_event");
+	network_peer->disconnect("connection_succeeded", this, "_queue_connection_event");
+	network_peer->disconnect("connection_failed", this, "_queue_connection_event");
+	network_peer->disconnect("server_disconnected", this, "_queue_connection_event");
+
+	network_events.clear();
+}
+
+void MultiplayerAPI::_queue_peer_event(int p_id, int p_type) {
+
+	// Called from the network thread, which already holds the lock.
+	NetworkEvent ev;
+	ev.type = NetworkEvent::Type(p_type);
+	ev.from = p_id;
+	network_events.push_back(ev);
+}
+
+void MultiplayerAPI::_queue_connection_event(int p_type) {
+
+	_queue_peer_event(0, p_type);
+}
+
+void MultiplayerAPI::_process_network_events() {
+
+	List<NetworkEvent> events;
+	network_mutex->lock();
+	for (List<NetworkEvent>::Element *E = network_events.front(); E; E = E->next()) {
+		events.push_back(E->get());
+	}
+	network_events.clear();
+	network_mutex->unlock();
+
+	// Handlers may drop the peer, which stops the thread, so no lock is held from here on.
+	for (List<NetworkEvent>::Element *E = events.front(); E && network_thread; E = E->next()) {
+
+		const NetworkEvent &ev = E->get();
+		switch (ev.type) {
+			case NetworkEvent::TYPE_PACKET: {
+				rpc_sender_id = ev.from;
+				_process_packet(ev.from, ev.data.ptr(), ev.data.size());
+				rpc_sender_id = 0;
+			} break;
+			case NetworkEvent::TYPE_PEER_CONNECTED: {
+				_add_peer(ev.from);
+			} break;
+			case NetworkEvent::TYPE_PEER_DISCONNECTED: {
+				_del_peer(ev.from);
+			} break;
+			case NetworkEvent::TYPE_CONNECTION_SUCCEEDED: {
+				_connected_to_server();
+			} break;
+			case NetworkEvent::TYPE_CONNECTION_FAILED: {
+				_connection_failed();
+			} break;
+			case NetworkEvent::TYPE_SERVER_DISCONNECTED: {
+				_server_disconnected();
+			} break;
+		}
+	}
+}
+
+void MultiplayerAPI::set_threaded_polling(bool p_enable) {
+
+	ERR_EXPLAIN("Threaded polling must be set before assigning a network peer.");
+	ERR_FAIL_COND(network_peer.is_valid());
+#ifdef NO_THREADS
+	ERR_EXPLAIN("Threaded polling is not available, this build has no thread support.");
+	ERR_FAIL_COND(p_enable);
+#endif
+	if (p_enable == threaded_polling)
+		return;
+
+	threaded_polling = p_enable;
+	if (threaded_polling) {
+		network_mutex = Mutex::create();
+	} else {
+		memdelete(network_mutex);
+		network_mutex = NULL;
+	}
+}
+
+bool MultiplayerAPI::is_threaded_polling() const {
+
+	return threaded_polling;
+}
+
+int MultiplayerAPI::get_network_send_queue_size(bool p_bytes) const {
+
+	if (!network_peer.is_valid())
+		return 0;
+
+	// The network thread may be servicing the peer's queues.
+	MutexLock lock(network_mutex);
+	return p_bytes ? network_peer->get_send_queue_byte_count() : network_peer->get_send_queue_packet_count();
+}
+
+void MultiplayerAPI::set_rpc_half_floats(bool p_enable) {
+
+	rpc_half_floats = p_enable;
+}
+
+bool MultiplayerAPI::is_using_rpc_half_floats() const {
+
+	return rpc_half_floats;
+}
+
+int MultiplayerAPI::get_replication_tick_rate() const {
+
+	return replication_tick_rate;
+}
+
+int MultiplayerAPI::_get_target_count(int p_to) const {
+
+	// Clients only talk to the server, which relays to the other peers.
+	if (p_to > 0 || !network_peer.is_valid() || !network_peer->is_server())
+		return 1;
+	if (p_to < 0 && connected_peers.has(-p_to))
+		return connected_peers.size() - 1;
+	return connected_peers.size();
+}
+
+void MultiplayerAPI::_profile_rpc(Node *p_node, const StringName &p_name, bool p_set, bool p_incoming, int p_bytes) {
+
+	ProfilingKey key;
+	key.node = p_node->get_instance_id();
+	key.name = p_name;
+
+	Map<ProfilingKey, ProfilingInfo>::Element *E = profiling_frame.find(key);
+	if (!E) {
+		// Only resolve the path the first time a node shows up in a frame.
+		ProfilingInfo info;
+		info.path = p_node->get_path();
+		info.set = p_set;
+		info.incoming_calls = 0;
+		info.incoming_bytes = 0;
+		info.outgoing_calls = 0;
+		info.outgoing_bytes = 0;
+		E = profiling_frame.insert(key, info);
+	}
+
+	ProfilingInfo &info = E->get();
+	if (p_incoming) {
+		info.incoming_calls++;
+		info.incoming_bytes += p_bytes;
+	} else {
+		info.outgoing_calls++;
+		info.outgoing_bytes += p_bytes;
+	}
+}
+
+void MultiplayerAPI::profiling_start() {
+
+	profiling_frame.clear();
+	profiling = true;
+}
+
+void MultiplayerAPI::profiling_end() {
+
+	profiling = false;
+	profiling_frame.clear();
+}
+
+Array MultiplayerAPI::get_profiling_frame() {
+
+	Array frame;
+	for (Map<ProfilingKey, ProfilingInfo>::Element *E = profiling_frame.front(); E; E = E->next()) {
+
+		const ProfilingInfo &info = E->get();
+		Dictionary d;
+		d["node"] = info.path;
+		d["name"] = E->key().name;
+		d["property"] = info.set;
+		d["incoming_calls"] = info.incoming_calls;
+		d["incoming_bytes"] = info.incoming_bytes;
+		d["outgoing_calls"] = info.outgoing_calls;
+		d["outgoing_bytes"] = info.outgoing_bytes;
+		frame.push_back(d);
+	}
+	profiling_frame.clear();
+	return frame;
+}
+
+Dictionary MultiplayerAPI::get_peer_statistics(int p_peer) const {
+
+	Dictionary stats;
+	ERR_FAIL_COND_V(!network_peer.is_valid(), stats);
+
+	// The network thread may be servicing the peer.
+	MutexLock lock(network_mutex);
+	stats["rtt"] = network_peer->get_peer_rtt(p_peer);
+	stats["packet_loss"] = network_peer->get_peer_packet_loss(p_peer);
+	return stats;
+}
+
+const MultiplayerAPI::ReplicationSnapshot *MultiplayerAPI::_find_replication_snapshot(const List<ReplicationSnapshot> &p_list, uint32_t p_tick) const {
+
+	if (p_tick == 0)
+		return NULL;
+
+	// Recent ticks are the likely baselines, so search from the back.
+	for (const List<ReplicationSnapshot>::Element *E = p_list.back(); E; E = E->prev()) {
+		if (E->get().tick == p_tick)
+			return &E->get();
+		if (E->get().tick < p_tick)
+			break;
+	}
+	return NULL;
+}
+
+void MultiplayerAPI::_take_replication_snapshot() {
+
+	ReplicationSnapshot snapshot;
+	snapshot.tick = ++replication_tick;
+
+	List<ObjectID> freed;
+
+	for (Map<ObjectID, Vector<ReplicatedProperty> >::Element *E = replicated_nodes.front(); E; E = E->next()) {
+
+		Node *node = Object::cast_to<Node>(ObjectDB::get_instance(E->key()));
+		if (!node) {
+			freed.push_back(E->key());
+			continue;
+		}
+
+		// Only the network master of a node is the authority on its state.
+		if (!node->is_inside_tree() || !node->is_network_master() || !root_node->is_a_parent_of(node))
+			continue;
+
+		NodePath path = root_node->get_path().rel_path_to(node->get_path());
+		int id = _get_path_send_cache(path)->id;
+
+		const Vector<ReplicatedProperty> &props = E->get();
+		Vector<Variant> values;
+		values.resize(props.size());
+		for (int i = 0; i < props.size(); i++) {
+			values.write[i] = _quantize_replicated_value(node->get(props[i].name), props[i].quantization);
+		}
+		snapshot.nodes[id] = values;
+	}
+
+	for (List<ObjectID>::Element *E = freed.front(); E; E = E->next()) {
+		replicated_nodes.erase(E->get());
+	}
+
+	replication_history.push_back(snapshot);
+	while (replication_history.size() > REPLICATION_HISTORY_SIZE) {
+		replication_history.pop_front();
+	}
+}
+
+void MultiplayerAPI::_send_replication_snapshot(int p_peer, const Map<int, NodePath> &p_paths) {
+
+	ReplicationPeer &peer = replication_peers[p_peer];
+	const ReplicationSnapshot &current = replication_history.back()->get();
+	// Deltas are always computed against the last state the peer confirmed, so lost packets need no resend.
+	const ReplicationSnapshot *baseline = _find_replication_snapshot(replication_history, peer.acked_tick);
+	bool allow_objects = allow_object_decoding || network_peer->is_object_decoding_allowed();
+
+	packet_cache.resize(9);
+	packet_cache.write[0] = NETWORK_COMMAND_REPLICATION_SNAPSHOT;
+	encode_uint32(current.tick, &packet_cache.write[1]);
+	encode_uint32(baseline ? baseline->tick : 0, &packet_cache.write[5]);
+
+	Vector<uint8_t> stream;
+	ReplicationBitWriter w(stream);
+	Vector<uint8_t> block_data;
+	Vector<bool> dirty;
+	bool wrote = false;
+
+	for (const Map<int, Vector<Variant> >::Element *E = current.nodes.front(); E; E = E->next()) {
+
+		const NodePath &path = p_paths[E->key()];
+		if (!_send_confirm_path(path, path_send_cache.getptr(path), p_peer))
+			continue; // Peer can't resolve the id yet, the node goes out once the path is confirmed.
+
+		const Vector<Variant> &values = E->get();
+		const Vector<Variant> *base_values = NULL;
+		if (baseline) {
+			const Map<int, Vector<Variant> >::Element *F = baseline->nodes.find(E->key());
+			if (F && F->get().size() == values.size())
+				base_values = &F->get();
+		}
+
+		Node *node = root_node->get_node_or_null(path);
+		const Map<ObjectID, Vector<ReplicatedProperty> >::Element *P = node ? replicated_nodes.find(node->get_instance_id()) : NULL;
+		if (!P || P->get().size() != values.size())
+			continue; // Registration changed since the snapshot was taken.
+		const Vector<ReplicatedProperty> &props = P->get();
+
+		dirty.resize(values.size());
+		bool changed = false;
+		for (int i = 0; i < values.size(); i++) {
+			dirty.write[i] = !base_values || (*base_values)[i].get_type() != values[i].get_type() || (*base_values)[i] != values[i];
+			changed = changed || dirty[i];
+		}
+		if (!changed)
+			continue;
+
+		block_data.clear();
+		ReplicationBitWriter block(block_data);
+		block.put_varint(values.size());
+		for (int i = 0; i < values.size(); i++) {
+			block.put_bits(dirty[i] ? 1 : 0, 1);
+		}
+		for (int i = 0; i < values.size(); i++) {
+			if (dirty[i]) {
+				_encode_replicated_value(block, values[i], props[i].quantization, allow_objects);
+			}
+		}
+
+		// Blocks are length prefixed, so receivers can skip nodes they don't know about.
+		w.put_bits(1, 1);
+		w.put_varint(E->key());
+		w.put_varint(block.get_bit_count());
+		w.put_writer(block);
+		wrote = true;
+	}
+
+	if (!wrote) {
+		// Nothing changed. Still send an empty update from time to time, so the acked baseline doesn't fall out of the history.
+		if (!baseline || current.tick - baseline->tick < REPLICATION_HISTORY_SIZE / 2)
+			return;
+	}
+
+	w.put_bits(0, 1);
+
+	int ofs = packet_cache.size();
+	packet_cache.resize(ofs + stream.size());
+	if (stream.size()) {
+		memcpy(&packet_cache.write[ofs], stream.ptr(), stream.size());
+	}
+
+	_put_packet(p_peer, NetworkedMultiplayerPeer::TRANSFER_MODE_UNRELIABLE, packet_cache.ptr(), packet_cache.size());
+}
+
+void MultiplayerAPI::replicate() {
+
+	ERR_EXPLAIN("Trying to replicate state while no network peer is active.");
+	ERR_FAIL_COND(!network_peer.is_valid());
+	ERR_EXPLAIN("Multiplayer root node was not initialized. If you are using custom multiplayer, remember to set the root node via MultiplayerAPI.set_root_node before using it");
+	ERR_FAIL_COND(root_node == NULL);
+
+	if (network_peer->get_connection_status() != NetworkedMultiplayerPeer::CONNECTION_CONNECTED)
+		return;
+
+	_take_replication_snapshot();
+
+	const ReplicationSnapshot &current = replication_history.back()->get();
+	if (current.nodes.empty())
+		return;
+
+	Map<int, NodePath> paths;
+	for (const NodePath *K = path_send_cache.next(NULL); K; K = path_send_cache.next(K)) {
+		int id = path_send_cache[*K].id;
+		if (current.nodes.has(id)) {
+			paths[id] = *K;
+		}
+	}
+
+	// One packet per peer per tick, carrying every node that changed since the peer's baseline.
+	for (Set<int>::Element *E = connected_peers.front(); E; E = E->next()) {
+		_send_replication_snapshot(E->get(), paths);
+	}
+}
+
+Node *MultiplayerAPI::_get_replicated_node(int p_from, int p_id) const {
+
+	const Map<int, PathGetCache>::Element *E = path_get_cache.find(p_from);
+	if (!E)
+		return NULL;
+
+	const Map<int, PathGetCache::NodeInfo>::Element *F = E->get().nodes.find(p_id);
+	if (!F)
+		return NULL;
+
+	return root_node->get_node_or_null(F->get().path);
+}
+
+void MultiplayerAPI::_process_replication_snapshot(int p_from, const uint8_t *p_packet, int p_packet_len) {
+
+	ERR_EXPLAIN("Invalid packet received. Size too small.");
+	ERR_FAIL_COND(p_packet_len < 9);
+
+	uint32_t tick = decode_uint32(&p_packet[1]);
+	uint32_t baseline_tick = decode_uint32(&p_packet[5]);
+
+	ReplicationPeer &peer = replication_peers[p_from];
+	if (tick <= peer.last_received_tick)
+		return; // Late or duplicated, a newer state was already applied.
+
+	ReplicationSnapshot snapshot;
+	snapshot.tick = tick;
+
+	if (baseline_tick) {
+		const ReplicationSnapshot *baseline = _find_replication_snapshot(peer.received, baseline_tick);
+		if (!baseline)
+			return; // Can't rebuild the state, wait for the sender to move to a baseline we have.
+		snapshot.nodes = baseline->nodes;
+	}
+
+	bool allow_objects = allow_object_decoding || network_peer->is_object_decoding_allowed();
+	ReplicationBitReader r(&p_packet[9], p_packet_len - 9);
+
+	while (r.get_bits(1)) {
+
+		int id = r.get_varint();
+		uint32_t block_bits = r.get_varint();
+		ERR_EXPLAIN("Invalid packet received. Replication block is larger than the packet.");
+		ERR_FAIL_COND(r.has_error() || block_bits > r.get_bits_left());
+		uint32_t block_end = r.get_position() + block_bits;
+
+		Node *node = _get_replicated_node(p_from, id);
+		const Map<ObjectID, Vector<ReplicatedProperty> >::Element *P = node ? replicated_nodes.find(node->get_instance_id()) : NULL;
+		int count = r.get_varint();
+
+		if (!P || P->get().size() != count) {
+			// Unknown here, or registered differently on both ends.
+			r.skip(block_end - r.get_position());
+			continue;
+		}
+
+		const Vector<ReplicatedProperty> &props = P->get();
+		Vector<Variant> &values = snapshot.nodes[id];
+		if (values.size() != count) {
+			values.resize(count);
+		}
+
+		Vector<bool> dirty;
+		dirty.resize(count);
+		for (int i = 0; i < count; i++) {
+			dirty.write[i] = r.get_bits(1);
+		}
+
+		for (int i = 0; i < count; i++) {
+			if (!dirty[i])
+				continue;
+			Variant value;
+			ERR_EXPLAIN("Invalid packet received. Unable to decode replicated value.");
+			ERR_FAIL_COND(!_decode_replicated_value(r, value, props[i].quantization, allow_objects));
+			values.write[i] = value;
+		}
+
+		ERR_EXPLAIN("Invalid packet received. Replication block size mismatch.");
+		ERR_FAIL_COND(r.get_position() != block_end);
+	}
+
+	ERR_EXPLAIN("Invalid packet received. Truncated replication data.");
+	ERR_FAIL_COND(r.has_error());
+
+	// Apply whatever differs from the state currently shown, which isn't necessarily the baseline.
+	const ReplicationSnapshot *previous = peer.received.size() ? &peer.received.back()->get() : NULL;
+
+	for (const Map<int, Vector<Variant> >::Element *E = snapshot.nodes.front(); E; E = E->next()) {
+
+		const Vector<Variant> *old_values = NULL;
+		if (previous) {
+			const Map<int, Vector<Variant> >::Element *F = previous->nodes.find(E->key());
+			if (F && F->get().size() == E->get().size())
+				old_values = &F->get();
+		}
+
+		Node *node = NULL;
+		const Vector<Variant> &values = E->get();
+		for (int i = 0; i < values.size(); i++) {
+
+			if (old_values && (*old_values)[i].get_type() == values[i].get_type() && (*old_values)[i] == values[i])
+				continue;
+
+			if (!node) {
+				node = _get_replicated_node(p_from, E->key());
+				if (!node || node->get_network_master() != p_from)
+					break; // Only the master may push state for its node.
+			}
+
+			const Map<ObjectID, Vector<ReplicatedProperty> >::Element *P = replicated_nodes.find(node->get_instance_id());
+			if (!P || P->get().size() != values.size())
+				break;
+
+			node->set(P->get()[i].name, values[i]);
+		}
+	}
+
+	peer.last_received_tick = tick;
+	peer.received.push_back(snapshot);
+	while (peer.received.size() > REPLICATION_HISTORY_SIZE) {
+		peer.received.pop_front();
+	}
+
+	uint8_t ack[5];
+	ack[0] = NETWORK_COMMAND_REPLICATION_ACK;
+	encode_uint32(tick, &ack[1]);
+
+	_put_packet(p_from, NetworkedMultiplayerPeer::TRANSFER_MODE_UNRELIABLE, ack, 5);
+}
+
+void MultiplayerAPI::_process_replication_ack(int p_from, const uint8_t *p_packet, int p_packet_len) {
+
+	ERR_EXPLAIN("Invalid packet received. Size too small.");
+	ERR_FAIL_COND(p_packet_len < 5);
+
+	uint32_t tick = decode_uint32(&p_packet[1]);
+	ERR_EXPLAIN("Invalid packet received. Acknowledges a replication tick that was never sent.");
+	ERR_FAIL_COND(tick > replication_tick);
+
+	ReplicationPeer &peer = replication_peers[p_from];
+	if (tick > peer.acked_tick) {
+		peer.acked_tick = tick;
+	}
+}
+
 void MultiplayerAPI::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("set_root_node", "node"), &MultiplayerAPI::set_root_node);
 	ClassDB::bind_method(D_METHOD("send_bytes", "bytes", "id", "mode"), &MultiplayerAPI::send_bytes, DEFVAL(NetworkedMultiplayerPeer::TARGET_PEER_BROADCAST), DEFVAL(NetworkedMultiplayerPeer::TRANSFER_MODE_RELIABLE));
@@ -852,9 +2025,32 @@ void MultiplayerAPI::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("is_refusing_new_network_connections"), &MultiplayerAPI::is_refusing_new_network_connections);
 	ClassDB::bind_method(D_METHOD("set_allow_object_decoding", "enable"), &MultiplayerAPI::set_allow_object_decoding);
 	ClassDB::bind_method(D_METHOD("is_object_decoding_allowed"), &MultiplayerAPI::is_object_decoding_allowed);
+	ClassDB::bind_method(D_METHOD("_queue_peer_event", "id", "type"), &MultiplayerAPI::_queue_peer_event);
+	ClassDB::bind_method(D_METHOD("_queue_connection_event", "type"), &MultiplayerAPI::_queue_connection_event);
+	ClassDB::bind_method(D_METHOD("set_threaded_polling", "enable"), &MultiplayerAPI::set_threaded_polling);
+	ClassDB::bind_method(D_METHOD("is_threaded_polling"), &MultiplayerAPI::is_threaded_polling);
+	ClassDB::bind_method(D_METHOD("set_rpc_half_floats", "enable"), &MultiplayerAPI::set_rpc_half_floats);
+	ClassDB::bind_method(D_METHOD("is_using_rpc_half_floats"), &MultiplayerAPI::is_using_rpc_half_floats);
+	ClassDB::bind_method(D_METHOD("replicate_property", "node", "property", "quantization"), &MultiplayerAPI::replicate_property, DEFVAL(0.0));
+	ClassDB::bind_method(D_METHOD("stop_replicating_property", "node", "property"), &MultiplayerAPI::stop_replicating_property);
+	ClassDB::bind_method(D_METHOD("stop_replicating", "node"), &MultiplayerAPI::stop_replicating);
+	ClassDB::bind_method(D_METHOD("is_replicating_property", "node", "property"), &MultiplayerAPI::is_replicating_property);
+	ClassDB::bind_method(D_METHOD("set_replication_tick_rate", "rate"), &MultiplayerAPI::set_replication_tick_rate);
+	ClassDB::bind_method(D_METHOD("get_replication_tick_rate"), &MultiplayerAPI::get_replication_tick_rate);
+	ClassDB::bind_method(D_METHOD("replicate"), &MultiplayerAPI::replicate);
+	ClassDB::bind_method(D_METHOD("profiling_start"), &MultiplayerAPI::profiling_start);
+	ClassDB::bind_method(D_METHOD("profiling_end"), &MultiplayerAPI::profiling_end);
+	ClassDB::bind_method(D_METHOD("is_profiling"), &MultiplayerAPI::is_profiling);
+	ClassDB::bind_method(D_METHOD("get_profiling_frame"), &MultiplayerAPI::get_profiling_frame);
+	ClassDB::bind_method(D_METHOD("get_network_bytes_received"), &MultiplayerAPI::get_network_bytes_received);
+	ClassDB::bind_method(D_METHOD("get_network_bytes_sent"), &MultiplayerAPI::get_network_bytes_sent);
+	ClassDB::bind_method(D_METHOD("get_peer_statistics", "id"), &MultiplayerAPI::get_peer_statistics);
 
 	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "allow_object_decoding"), "set_allow_object_decoding", "is_object_decoding_allowed");
 	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "refuse_new_network_connections"), "set_refuse_new_network_connections", "is_refusing_new_network_connections");
+	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "threaded_polling"), "set_threaded_polling", "is_threaded_polling");
+	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "rpc_half_floats"), "set_rpc_half_floats", "is_using_rpc_half_floats");
+	ADD_PROPERTY(PropertyInfo(Variant::INT, "replication_tick_rate", PROPERTY_HINT_RANGE, "0,128,1"), "set_replication_tick_rate", "get_replication_tick_rate");
 	ADD_PROPERTY(PropertyInfo(Variant::OBJECT, "network_peer", PROPERTY_HINT_RESOURCE_TYPE, "NetworkedMultiplayerPeer", 0), "set_network_peer", "get_network_peer");
 
 	ADD_SIGNAL(MethodInfo("network_peer_connected", PropertyInfo(Variant::INT, "id")));
@@ -876,12 +2072,28 @@ void MultiplayerAPI::_bind_methods() {
 }
 
 MultiplayerAPI::MultiplayerAPI() :
-		allow_object_decoding(false) {
+		allow_object_decoding(false),
+		rpc_half_floats(false) {
 	rpc_sender_id = 0;
 	root_node = NULL;
+	replication_tick_rate = 20;
+	replication_last_tick_usec = 0;
+	threaded_polling = false;
+	profiling = false;
+	bytes_received = 0;
+	bytes_sent = 0;
+	network_thread = NULL;
+	network_mutex = NULL;
+	network_thread_exit = false;
 	clear();
 }
 
 MultiplayerAPI::~MultiplayerAPI() {
+	if (network_thread) {
+		_stop_network_thread();
+	}
+	if (network_mutex) {
+		memdelete(network_mutex);
+	}
 	clear();
 }
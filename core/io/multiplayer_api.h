@@ -32,6 +32,8 @@
 #define MULTIPLAYER_PROTOCOL_H
 
 #include "core/io/networked_multiplayer_peer.h"
+#include "core/os/mutex.h"
+#include "core/os/thread.h"
 #include "core/reference.h"
 
 class MultiplayerAPI : public Reference {
@@ -53,6 +55,7 @@ private:
 		};
 
 		Map<int, NodeInfo> nodes;
+		Map<int, StringName> names;
 	};
 
 	Ref<NetworkedMultiplayerPeer> network_peer;
@@ -61,9 +64,95 @@ private:
 	HashMap<NodePath, PathSentCache> path_send_cache;
 	Map<int, PathGetCache> path_get_cache;
 	int last_send_cache_id;
+	HashMap<StringName, PathSentCache> name_send_cache; // RPC and RSET names, negotiated like paths.
+	int last_name_cache_id;
 	Vector<uint8_t> packet_cache;
 	Node *root_node;
 	bool allow_object_decoding;
+	bool rpc_half_floats;
+
+	//state replication
+	struct ReplicatedProperty {
+		StringName name;
+		float quantization;
+	};
+
+	struct ReplicationSnapshot {
+		uint32_t tick;
+		Map<int, Vector<Variant> > nodes; // Keyed by the sender's path cache id.
+	};
+
+	struct ReplicationPeer {
+		uint32_t acked_tick;
+		uint32_t last_received_tick;
+		List<ReplicationSnapshot> received;
+
+		ReplicationPeer() {
+			acked_tick = 0;
+			last_received_tick = 0;
+		}
+	};
+
+	Map<ObjectID, Vector<ReplicatedProperty> > replicated_nodes;
+	List<ReplicationSnapshot> replication_history;
+	Map<int, ReplicationPeer> replication_peers;
+	uint32_t replication_tick;
+	int replication_tick_rate;
+	uint64_t replication_last_tick_usec;
+
+	//profiling
+	struct ProfilingKey {
+		ObjectID node;
+		StringName name;
+
+		bool operator<(const ProfilingKey &p_key) const { return node == p_key.node ? name < p_key.name : node < p_key.node; }
+	};
+
+	struct ProfilingInfo {
+		NodePath path;
+		bool set;
+		int incoming_calls;
+		int incoming_bytes;
+		int outgoing_calls;
+		int outgoing_bytes;
+	};
+
+	bool profiling;
+	Map<ProfilingKey, ProfilingInfo> profiling_frame;
+	uint64_t bytes_received;
+	uint64_t bytes_sent;
+
+	void _profile_rpc(Node *p_node, const StringName &p_name, bool p_set, bool p_incoming, int p_bytes);
+	int _get_target_count(int p_to) const;
+
+	//threaded polling
+	struct NetworkEvent {
+		enum Type {
+			TYPE_PACKET,
+			TYPE_PEER_CONNECTED,
+			TYPE_PEER_DISCONNECTED,
+			TYPE_CONNECTION_SUCCEEDED,
+			TYPE_CONNECTION_FAILED,
+			TYPE_SERVER_DISCONNECTED,
+		};
+
+		Type type;
+		int from;
+		Vector<uint8_t> data;
+	};
+
+	bool threaded_polling;
+	Thread *network_thread;
+	Mutex *network_mutex;
+	volatile bool network_thread_exit;
+	List<NetworkEvent> network_events;
+
+	static void _network_thread_func(void *p_ud);
+	void _start_network_thread();
+	void _stop_network_thread();
+	void _queue_peer_event(int p_id, int p_type);
+	void _queue_connection_event(int p_type);
+	void _process_network_events();
 
 protected:
 	static void _bind_methods();
@@ -71,13 +160,26 @@ protected:
 	void _process_packet(int p_from, const uint8_t *p_packet, int p_packet_len);
 	void _process_simplify_path(int p_from, const uint8_t *p_packet, int p_packet_len);
 	void _process_confirm_path(int p_from, const uint8_t *p_packet, int p_packet_len);
+	void _process_simplify_name(int p_from, const uint8_t *p_packet, int p_packet_len);
+	void _process_confirm_name(int p_from, const uint8_t *p_packet, int p_packet_len);
 	Node *_process_get_node(int p_from, const uint8_t *p_packet, int p_packet_len);
 	void _process_rpc(Node *p_node, const StringName &p_name, int p_from, const uint8_t *p_packet, int p_packet_len, int p_offset);
 	void _process_rset(Node *p_node, const StringName &p_name, int p_from, const uint8_t *p_packet, int p_packet_len, int p_offset);
 	void _process_raw(int p_from, const uint8_t *p_packet, int p_packet_len);
+	void _process_replication_snapshot(int p_from, const uint8_t *p_packet, int p_packet_len);
+	void _process_replication_ack(int p_from, const uint8_t *p_packet, int p_packet_len);
 
 	void _send_rpc(Node *p_from, int p_to, bool p_unreliable, bool p_set, const StringName &p_name, const Variant **p_arg, int p_argcount);
+	Error _put_packet(int p_to, NetworkedMultiplayerPeer::TransferMode p_mode, const uint8_t *p_data, int p_len);
+	bool _send_confirm_cache(PathSentCache *psc, int p_target, uint8_t p_command, const String &p_value);
 	bool _send_confirm_path(NodePath p_path, PathSentCache *psc, int p_from);
+	PathSentCache *_get_path_send_cache(const NodePath &p_path);
+	PathSentCache *_get_name_send_cache(const StringName &p_name);
+
+	const ReplicationSnapshot *_find_replication_snapshot(const List<ReplicationSnapshot> &p_list, uint32_t p_tick) const;
+	void _take_replication_snapshot();
+	void _send_replication_snapshot(int p_peer, const Map<int, NodePath> &p_paths);
+	Node *_get_replicated_node(int p_from, int p_id) const;
 
 public:
 	enum NetworkCommands {
@@ -86,6 +188,10 @@ public:
 		NETWORK_COMMAND_SIMPLIFY_PATH,
 		NETWORK_COMMAND_CONFIRM_PATH,
 		NETWORK_COMMAND_RAW,
+		NETWORK_COMMAND_REPLICATION_SNAPSHOT,
+		NETWORK_COMMAND_REPLICATION_ACK,
+		NETWORK_COMMAND_SIMPLIFY_NAME,
+		NETWORK_COMMAND_CONFIRM_NAME,
 	};
 
 	enum RPCMode {
@@ -130,6 +236,30 @@ public:
 	void set_allow_object_decoding(bool p_enable);
 	bool is_object_decoding_allowed() const;
 
+	void set_threaded_polling(bool p_enable);
+	bool is_threaded_polling() const;
+	int get_network_send_queue_size(bool p_bytes) const;
+
+	void set_rpc_half_floats(bool p_enable);
+	bool is_using_rpc_half_floats() const;
+
+	void replicate_property(Node *p_node, const StringName &p_property, float p_quantization = 0.0);
+	void stop_replicating_property(Node *p_node, const StringName &p_property);
+	void stop_replicating(Node *p_node);
+	bool is_replicating_property(Node *p_node, const StringName &p_property) const;
+
+	void profiling_start();
+	void profiling_end();
+	bool is_profiling() const { return profiling; }
+	Array get_profiling_frame();
+	uint64_t get_network_bytes_received() const { return bytes_received; }
+	uint64_t get_network_bytes_sent() const { return bytes_sent; }
+	Dictionary get_peer_statistics(int p_peer) const;
+
+	void set_replication_tick_rate(int p_rate);
+	int get_replication_tick_rate() const;
+	void replicate();
+
 	MultiplayerAPI();
 	~MultiplayerAPI();
 };
@@ -76,4 +76,36 @@ public:
 	virtual void set_reuse_address_enabled(bool p_enabled) = 0;
 };
 
+// Waits on many sockets at once, so idle connections cost nothing to watch.
+class NetSocketPoller : public Reference {
+
+protected:
+	static NetSocketPoller *(*_create)();
+
+public:
+	static NetSocketPoller *create();
+
+	enum EventFlags {
+		EVENT_IN = 1,
+		EVENT_OUT = 2,
+		EVENT_HANGUP = 4,
+		EVENT_ERROR = 8,
+	};
+
+	struct Event {
+		uint64_t id;
+		int flags;
+	};
+
+	// p_events is a combination of EVENT_IN and EVENT_OUT, hangups and errors are always reported.
+	// Sockets must be removed before they are closed.
+	virtual Error add_socket(const Ref<NetSocket> &p_sock, int p_events, uint64_t p_id) = 0;
+	virtual Error modify_socket(const Ref<NetSocket> &p_sock, int p_events, uint64_t p_id) = 0;
+	virtual void remove_socket(const Ref<NetSocket> &p_sock) = 0;
+	virtual int get_socket_count() const = 0;
+
+	// Waits up to p_timeout milliseconds (-1 blocks, 0 returns immediately) and fills r_events with the ready sockets.
+	virtual Error wait(Vector<Event> &r_events, int p_timeout) = 0;
+};
+
 #endif // NET_SOCKET_H
@@ -46,6 +46,11 @@ void NetworkedMultiplayerPeer::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("set_refuse_new_connections", "enable"), &NetworkedMultiplayerPeer::set_refuse_new_connections);
 	ClassDB::bind_method(D_METHOD("is_refusing_new_connections"), &NetworkedMultiplayerPeer::is_refusing_new_connections);
 
+	ClassDB::bind_method(D_METHOD("get_send_queue_packet_count", "id"), &NetworkedMultiplayerPeer::get_send_queue_packet_count, DEFVAL(0));
+	ClassDB::bind_method(D_METHOD("get_send_queue_byte_count", "id"), &NetworkedMultiplayerPeer::get_send_queue_byte_count, DEFVAL(0));
+	ClassDB::bind_method(D_METHOD("get_peer_rtt", "id"), &NetworkedMultiplayerPeer::get_peer_rtt);
+	ClassDB::bind_method(D_METHOD("get_peer_packet_loss", "id"), &NetworkedMultiplayerPeer::get_peer_packet_loss);
+
 	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "refuse_new_connections"), "set_refuse_new_connections", "is_refusing_new_connections");
 	ADD_PROPERTY(PropertyInfo(Variant::INT, "transfer_mode", PROPERTY_HINT_ENUM, "Unreliable,Unreliable Ordered,Reliable"), "set_transfer_mode", "get_transfer_mode");
 
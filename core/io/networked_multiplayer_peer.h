@@ -74,6 +74,14 @@ public:
 
 	virtual ConnectionStatus get_connection_status() const = 0;
 
+	// Outgoing data not yet handed to the network, for one peer or all of them (p_peer_id == 0).
+	virtual int get_send_queue_packet_count(int p_peer_id = 0) const { return 0; }
+	virtual int get_send_queue_byte_count(int p_peer_id = 0) const { return 0; }
+
+	// Link quality of a connected peer, -1 when the peer type does not measure it.
+	virtual int get_peer_rtt(int p_peer_id) const { return -1; }
+	virtual float get_peer_packet_loss(int p_peer_id) const { return -1; }
+
 	NetworkedMultiplayerPeer();
 };
 
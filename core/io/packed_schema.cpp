@@ -0,0 +1,432 @@
+/*************************************************************************/
+/*  packed_schema.cpp                                                    */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2019 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2019 Godot Engine contributors (cf. AUTHORS.md)    */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#include "packed_schema.h"
+
+#include "core/io/marshalls.h"
+
+int PackedSchema::get_field_type_size(FieldType p_type) {
+
+	switch (p_type) {
+		case FIELD_BOOL:
+		case FIELD_INT8:
+		case FIELD_UINT8: return 1;
+		case FIELD_INT16:
+		case FIELD_UINT16: return 2;
+		case FIELD_INT32:
+		case FIELD_UINT32:
+		case FIELD_FLOAT: return 4;
+		case FIELD_INT64:
+		case FIELD_DOUBLE:
+		case FIELD_VECTOR2: return 8;
+		case FIELD_VECTOR3: return 12;
+		case FIELD_QUAT:
+		case FIELD_COLOR: return 16;
+		default: return -1; // Variable size.
+	}
+}
+
+void PackedSchema::_update_layout() {
+
+	fixed_size = 0;
+	variable_count = 0;
+
+	for (int i = 0; i < fields.size(); i++) {
+		int size = get_field_type_size(fields[i].type);
+		if (size < 0) {
+			fields.write[i].offset = -1;
+			variable_count++;
+		} else {
+			fields.write[i].offset = fixed_size;
+			fixed_size += size;
+		}
+	}
+}
+
+void PackedSchema::add_field(const StringName &p_name, FieldType p_type) {
+
+	ERR_FAIL_INDEX(p_type, FIELD_MAX);
+	for (int i = 0; i < fields.size(); i++) {
+		if (fields[i].name == p_name) {
+			ERR_EXPLAIN("Field already exists: " + String(p_name));
+			ERR_FAIL();
+		}
+	}
+
+	Field f;
+	f.name = p_name;
+	f.type = p_type;
+	f.offset = -1;
+	fields.push_back(f);
+
+	_update_layout();
+	emit_changed();
+}
+
+void PackedSchema::clear() {
+
+	fields.clear();
+	_update_layout();
+	emit_changed();
+}
+
+int PackedSchema::get_field_count() const {
+
+	return fields.size();
+}
+
+StringName PackedSchema::get_field_name(int p_idx) const {
+
+	ERR_FAIL_INDEX_V(p_idx, fields.size(), StringName());
+	return fields[p_idx].name;
+}
+
+PackedSchema::FieldType PackedSchema::get_field_type(int p_idx) const {
+
+	ERR_FAIL_INDEX_V(p_idx, fields.size(), FIELD_MAX);
+	return fields[p_idx].type;
+}
+
+int PackedSchema::get_fixed_size() const {
+
+	return fixed_size;
+}
+
+Error PackedSchema::_encode(const Dictionary *p_values, const Object *p_object, Vector<uint8_t> &r_buffer) const {
+
+	r_buffer.resize(fixed_size);
+	uint8_t *w = r_buffer.ptrw();
+
+	for (int i = 0; i < fields.size(); i++) {
+
+		const Field &f = fields[i];
+		if (f.offset < 0)
+			continue;
+
+		Variant v;
+		if (p_values) {
+			const Variant *vp = p_values->getptr(f.name);
+			if (vp)
+				v = *vp;
+		} else {
+			v = p_object->get(f.name);
+		}
+
+		uint8_t *dst = &w[f.offset];
+		switch (f.type) {
+			case FIELD_BOOL: *dst = bool(v) ? 1 : 0; break;
+			case FIELD_INT8:
+			case FIELD_UINT8: *dst = uint8_t(int64_t(v)); break;
+			case FIELD_INT16:
+			case FIELD_UINT16: encode_uint16(uint16_t(int64_t(v)), dst); break;
+			case FIELD_INT32:
+			case FIELD_UINT32: encode_uint32(uint32_t(int64_t(v)), dst); break;
+			case FIELD_INT64: encode_uint64(uint64_t(int64_t(v)), dst); break;
+			case FIELD_FLOAT: encode_float(float(v), dst); break;
+			case FIELD_DOUBLE: encode_double(double(v), dst); break;
+			case FIELD_VECTOR2: {
+				Vector2 v2 = v;
+				encode_float(v2.x, &dst[0]);
+				encode_float(v2.y, &dst[4]);
+			} break;
+			case FIELD_VECTOR3: {
+				Vector3 v3 = v;
+				encode_float(v3.x, &dst[0]);
+				encode_float(v3.y, &dst[4]);
+				encode_float(v3.z, &dst[8]);
+			} break;
+			case FIELD_QUAT: {
+				Quat q = v;
+				encode_float(q.x, &dst[0]);
+				encode_float(q.y, &dst[4]);
+				encode_float(q.z, &dst[8]);
+				encode_float(q.w, &dst[12]);
+			} break;
+			case FIELD_COLOR: {
+				Color c = v;
+				encode_float(c.r, &dst[0]);
+				encode_float(c.g, &dst[4]);
+				encode_float(c.b, &dst[8]);
+				encode_float(c.a, &dst[12]);
+			} break;
+			default: {
+				ERR_FAIL_V(ERR_BUG);
+			}
+		}
+	}
+
+	if (variable_count == 0)
+		return OK;
+
+	for (int i = 0; i < fields.size(); i++) {
+
+		const Field &f = fields[i];
+		if (f.offset >= 0)
+			continue;
+
+		Variant v;
+		if (p_values) {
+			const Variant *vp = p_values->getptr(f.name);
+			if (vp)
+				v = *vp;
+		} else {
+			v = p_object->get(f.name);
+		}
+
+		int pos = r_buffer.size();
+		if (f.type == FIELD_STRING) {
+			CharString utf8 = String(v).utf8();
+			r_buffer.resize(pos + 4 + utf8.length());
+			encode_uint32(utf8.length(), &r_buffer.write[pos]);
+			copymem(&r_buffer.write[pos + 4], utf8.get_data(), utf8.length());
+		} else {
+			PoolVector<uint8_t> bytes = v;
+			r_buffer.resize(pos + 4 + bytes.size());
+			encode_uint32(bytes.size(), &r_buffer.write[pos]);
+			if (bytes.size()) {
+				PoolVector<uint8_t>::Read r = bytes.read();
+				copymem(&r_buffer.write[pos + 4], r.ptr(), bytes.size());
+			}
+		}
+	}
+
+	return OK;
+}
+
+Error PackedSchema::_decode(const uint8_t *p_buffer, int p_len, Dictionary *r_values, Object *r_object) const {
+
+	ERR_FAIL_COND_V(p_len < fixed_size, ERR_INVALID_DATA);
+
+	for (int i = 0; i < fields.size(); i++) {
+
+		const Field &f = fields[i];
+		if (f.offset < 0)
+			continue;
+
+		const uint8_t *src = &p_buffer[f.offset];
+		Variant v;
+		switch (f.type) {
+			case FIELD_BOOL: v = *src != 0; break;
+			case FIELD_INT8: v = int8_t(*src); break;
+			case FIELD_UINT8: v = *src; break;
+			case FIELD_INT16: v = int16_t(decode_uint16(src)); break;
+			case FIELD_UINT16: v = decode_uint16(src); break;
+			case FIELD_INT32: v = int32_t(decode_uint32(src)); break;
+			case FIELD_UINT32: v = (int64_t)decode_uint32(src); break;
+			case FIELD_INT64: v = int64_t(decode_uint64(src)); break;
+			case FIELD_FLOAT: v = decode_float(src); break;
+			case FIELD_DOUBLE: v = decode_double(src); break;
+			case FIELD_VECTOR2: v = Vector2(decode_float(&src[0]), decode_float(&src[4])); break;
+			case FIELD_VECTOR3: v = Vector3(decode_float(&src[0]), decode_float(&src[4]), decode_float(&src[8])); break;
+			case FIELD_QUAT: v = Quat(decode_float(&src[0]), decode_float(&src[4]), decode_float(&src[8]), decode_float(&src[12])); break;
+			case FIELD_COLOR: v = Color(decode_float(&src[0]), decode_float(&src[4]), decode_float(&src[8]), decode_float(&src[12])); break;
+			default: {
+				ERR_FAIL_V(ERR_BUG);
+			}
+		}
+
+		if (r_values)
+			(*r_values)[f.name] = v;
+		else
+			r_object->set(f.name, v);
+	}
+
+	int pos = fixed_size;
+	for (int i = 0; i < fields.size() && variable_count > 0; i++) {
+
+		const Field &f = fields[i];
+		if (f.offset >= 0)
+			continue;
+
+		ERR_FAIL_COND_V(pos + 4 > p_len, ERR_INVALID_DATA);
+		uint32_t len = decode_uint32(&p_buffer[pos]);
+		pos += 4;
+		ERR_FAIL_COND_V(len > (uint32_t)(p_len - pos), ERR_INVALID_DATA);
+
+		Variant v;
+		if (f.type == FIELD_STRING) {
+			String str;
+			str.parse_utf8((const char *)&p_buffer[pos], len);
+			v = str;
+		} else {
+			PoolVector<uint8_t> bytes;
+			bytes.resize(len);
+			if (len) {
+				PoolVector<uint8_t>::Write w = bytes.write();
+				copymem(w.ptr(), &p_buffer[pos], len);
+			}
+			v = bytes;
+		}
+		pos += len;
+
+		if (r_values)
+			(*r_values)[f.name] = v;
+		else
+			r_object->set(f.name, v);
+	}
+
+	return OK;
+}
+
+Error PackedSchema::encode(const Dictionary &p_values, Vector<uint8_t> &r_buffer) const {
+
+	return _encode(&p_values, NULL, r_buffer);
+}
+
+Error PackedSchema::encode_object(const Object *p_object, Vector<uint8_t> &r_buffer) const {
+
+	ERR_FAIL_NULL_V(p_object, ERR_INVALID_PARAMETER);
+	return _encode(NULL, p_object, r_buffer);
+}
+
+Error PackedSchema::decode(const uint8_t *p_buffer, int p_len, Dictionary &r_values) const {
+
+	return _decode(p_buffer, p_len, &r_values, NULL);
+}
+
+Error PackedSchema::decode_object(const uint8_t *p_buffer, int p_len, Object *r_object) const {
+
+	ERR_FAIL_NULL_V(r_object, ERR_INVALID_PARAMETER);
+	return _decode(p_buffer, p_len, NULL, r_object);
+}
+
+PoolVector<uint8_t> PackedSchema::_encode_bind(const Dictionary &p_values) const {
+
+	Vector<uint8_t> buffer;
+	PoolVector<uint8_t> ret;
+	ERR_FAIL_COND_V(encode(p_values, buffer) != OK, ret);
+
+	ret.resize(buffer.size());
+	if (buffer.size()) {
+		PoolVector<uint8_t>::Write w = ret.write();
+		copymem(w.ptr(), buffer.ptr(), buffer.size());
+	}
+	return ret;
+}
+
+PoolVector<uint8_t> PackedSchema::_encode_object_bind(Object *p_object) const {
+
+	Vector<uint8_t> buffer;
+	PoolVector<uint8_t> ret;
+	ERR_FAIL_COND_V(encode_object(p_object, buffer) != OK, ret);
+
+	ret.resize(buffer.size());
+	if (buffer.size()) {
+		PoolVector<uint8_t>::Write w = ret.write();
+		copymem(w.ptr(), buffer.ptr(), buffer.size());
+	}
+	return ret;
+}
+
+Dictionary PackedSchema::_decode_bind(const PoolVector<uint8_t> &p_buffer) const {
+
+	Dictionary ret;
+	PoolVector<uint8_t>::Read r = p_buffer.read();
+	decode(r.ptr(), p_buffer.size(), ret);
+	return ret;
+}
+
+Error PackedSchema::_decode_into_bind(const PoolVector<uint8_t> &p_buffer, Object *p_object) const {
+
+	PoolVector<uint8_t>::Read r = p_buffer.read();
+	return decode_object(r.ptr(), p_buffer.size(), p_object);
+}
+
+void PackedSchema::_set_data(const Array &p_data) {
+
+	ERR_FAIL_COND(p_data.size() % 2 != 0);
+
+	fields.clear();
+	for (int i = 0; i < p_data.size(); i += 2) {
+		Field f;
+		f.name = p_data[i];
+		f.type = FieldType(int(p_data[i + 1]));
+		f.offset = -1;
+		ERR_CONTINUE(f.type < 0 || f.type >= FIELD_MAX);
+		fields.push_back(f);
+	}
+
+	_update_layout();
+	emit_changed();
+}
+
+Array PackedSchema::_get_data() const {
+
+	Array data;
+	for (int i = 0; i < fields.size(); i++) {
+		data.push_back(fields[i].name);
+		data.push_back(fields[i].type);
+	}
+	return data;
+}
+
+void PackedSchema::_bind_methods() {
+
+	ClassDB::bind_method(D_METHOD("add_field", "name", "type"), &PackedSchema::add_field);
+	ClassDB::bind_method(D_METHOD("clear"), &PackedSchema::clear);
+	ClassDB::bind_method(D_METHOD("get_field_count"), &PackedSchema::get_field_count);
+	ClassDB::bind_method(D_METHOD("get_field_name", "idx"), &PackedSchema::get_field_name);
+	ClassDB::bind_method(D_METHOD("get_field_type", "idx"), &PackedSchema::get_field_type);
+	ClassDB::bind_method(D_METHOD("get_fixed_size"), &PackedSchema::get_fixed_size);
+
+	ClassDB::bind_method(D_METHOD("encode", "values"), &PackedSchema::_encode_bind);
+	ClassDB::bind_method(D_METHOD("encode_object", "object"), &PackedSchema::_encode_object_bind);
+	ClassDB::bind_method(D_METHOD("decode", "bytes"), &PackedSchema::_decode_bind);
+	ClassDB::bind_method(D_METHOD("decode_into", "bytes", "object"), &PackedSchema::_decode_into_bind);
+
+	ClassDB::bind_method(D_METHOD("_set_data", "data"), &PackedSchema::_set_data);
+	ClassDB::bind_method(D_METHOD("_get_data"), &PackedSchema::_get_data);
+
+	ADD_PROPERTY(PropertyInfo(Variant::ARRAY, "_data", PROPERTY_HINT_NONE, "", PROPERTY_USAGE_NOEDITOR | PROPERTY_USAGE_INTERNAL), "_set_data", "_get_data");
+
+	BIND_ENUM_CONSTANT(FIELD_BOOL);
+	BIND_ENUM_CONSTANT(FIELD_INT8);
+	BIND_ENUM_CONSTANT(FIELD_UINT8);
+	BIND_ENUM_CONSTANT(FIELD_INT16);
+	BIND_ENUM_CONSTANT(FIELD_UINT16);
+	BIND_ENUM_CONSTANT(FIELD_INT32);
+	BIND_ENUM_CONSTANT(FIELD_UINT32);
+	BIND_ENUM_CONSTANT(FIELD_INT64);
+	BIND_ENUM_CONSTANT(FIELD_FLOAT);
+	BIND_ENUM_CONSTANT(FIELD_DOUBLE);
+	BIND_ENUM_CONSTANT(FIELD_VECTOR2);
+	BIND_ENUM_CONSTANT(FIELD_VECTOR3);
+	BIND_ENUM_CONSTANT(FIELD_QUAT);
+	BIND_ENUM_CONSTANT(FIELD_COLOR);
+	BIND_ENUM_CONSTANT(FIELD_STRING);
+	BIND_ENUM_CONSTANT(FIELD_BYTES);
+	BIND_ENUM_CONSTANT(FIELD_MAX);
+}
+
+PackedSchema::PackedSchema() {
+
+	fixed_size = 0;
+	variable_count = 0;
+}
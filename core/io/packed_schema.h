@@ -0,0 +1,113 @@
+/*************************************************************************/
+/*  packed_schema.h                                                      */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2019 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2019 Godot Engine contributors (cf. AUTHORS.md)    */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#ifndef PACKED_SCHEMA_H
+#define PACKED_SCHEMA_H
+
+#include "core/resource.h"
+
+// Describes a list of typed fields which are packed into a fixed binary layout.
+// Fixed size fields come first, at offsets computed once, then the variable size
+// fields (strings and byte arrays), each prefixed with its 32 bits length.
+class PackedSchema : public Resource {
+
+	GDCLASS(PackedSchema, Resource);
+
+public:
+	enum FieldType {
+		FIELD_BOOL,
+		FIELD_INT8,
+		FIELD_UINT8,
+		FIELD_INT16,
+		FIELD_UINT16,
+		FIELD_INT32,
+		FIELD_UINT32,
+		FIELD_INT64,
+		FIELD_FLOAT,
+		FIELD_DOUBLE,
+		FIELD_VECTOR2,
+		FIELD_VECTOR3,
+		FIELD_QUAT,
+		FIELD_COLOR,
+		FIELD_STRING,
+		FIELD_BYTES,
+		FIELD_MAX
+	};
+
+private:
+	struct Field {
+		StringName name;
+		FieldType type;
+		int offset; // -1 for variable size fields.
+	};
+
+	Vector<Field> fields;
+	int fixed_size;
+	int variable_count;
+
+	void _update_layout();
+
+	Error _encode(const Dictionary *p_values, const Object *p_object, Vector<uint8_t> &r_buffer) const;
+	Error _decode(const uint8_t *p_buffer, int p_len, Dictionary *r_values, Object *r_object) const;
+
+	PoolVector<uint8_t> _encode_bind(const Dictionary &p_values) const;
+	PoolVector<uint8_t> _encode_object_bind(Object *p_object) const;
+	Dictionary _decode_bind(const PoolVector<uint8_t> &p_buffer) const;
+	Error _decode_into_bind(const PoolVector<uint8_t> &p_buffer, Object *p_object) const;
+
+protected:
+	void _set_data(const Array &p_data);
+	Array _get_data() const;
+	static void _bind_methods();
+
+public:
+	static int get_field_type_size(FieldType p_type);
+
+	void add_field(const StringName &p_name, FieldType p_type);
+	void clear();
+
+	int get_field_count() const;
+	StringName get_field_name(int p_idx) const;
+	FieldType get_field_type(int p_idx) const;
+	int get_fixed_size() const;
+
+	// Encode into r_buffer, which is resized as needed and can be reused between calls.
+	Error encode(const Dictionary &p_values, Vector<uint8_t> &r_buffer) const;
+	Error encode_object(const Object *p_object, Vector<uint8_t> &r_buffer) const;
+
+	Error decode(const uint8_t *p_buffer, int p_len, Dictionary &r_values) const;
+	Error decode_object(const uint8_t *p_buffer, int p_len, Object *r_object) const;
+
+	PackedSchema();
+};
+
+VARIANT_ENUM_CAST(PackedSchema::FieldType);
+
+#endif // PACKED_SCHEMA_H
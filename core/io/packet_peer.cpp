@@ -108,6 +108,58 @@ Error PacketPeer::put_var(const Variant &p_packet, bool p_full_objects) {
 	return put_packet(buf, len);
 }
 
+Error PacketPeer::get_packed(const Ref<PackedSchema> &p_schema, Dictionary &r_values) {
+
+	ERR_FAIL_COND_V(p_schema.is_null(), ERR_INVALID_PARAMETER);
+
+	const uint8_t *buffer;
+	int buffer_size;
+	Error err = get_packet(&buffer, buffer_size);
+	if (err)
+		return err;
+
+	return p_schema->decode(buffer, buffer_size, r_values);
+}
+
+Error PacketPeer::put_packed(const Ref<PackedSchema> &p_schema, const Variant &p_values) {
+
+	ERR_FAIL_COND_V(p_schema.is_null(), ERR_INVALID_PARAMETER);
+
+	Error err;
+	if (p_values.get_type() == Variant::OBJECT) {
+		err = p_schema->encode_object(p_values, packed_buffer);
+	} else {
+		ERR_FAIL_COND_V(p_values.get_type() != Variant::DICTIONARY, ERR_INVALID_PARAMETER);
+		err = p_schema->encode(p_values, packed_buffer);
+	}
+	ERR_FAIL_COND_V(err, err);
+
+	if (packed_buffer.size() == 0)
+		return OK;
+
+	return put_packet(packed_buffer.ptr(), packed_buffer.size());
+}
+
+Dictionary PacketPeer::_bnd_get_packed(const Ref<PackedSchema> &p_schema) {
+
+	Dictionary values;
+	last_get_error = get_packed(p_schema, values);
+	return values;
+}
+
+Error PacketPeer::_bnd_get_packed_into(const Ref<PackedSchema> &p_schema, Object *p_object) {
+
+	ERR_FAIL_COND_V(p_schema.is_null(), ERR_INVALID_PARAMETER);
+
+	const uint8_t *buffer;
+	int buffer_size;
+	Error err = get_packet(&buffer, buffer_size);
+	if (err)
+		return err;
+
+	return p_schema->decode_object(buffer, buffer_size, p_object);
+}
+
 Variant PacketPeer::_bnd_get_var(bool p_allow_objects) {
 	Variant var;
 	get_var(var, p_allow_objects);
@@ -134,6 +186,9 @@ void PacketPeer::_bind_methods() {
 
 	ClassDB::bind_method(D_METHOD("get_var", "allow_objects"), &PacketPeer::_bnd_get_var, DEFVAL(false));
 	ClassDB::bind_method(D_METHOD("put_var", "var", "full_objects"), &PacketPeer::put_var, DEFVAL(false));
+	ClassDB::bind_method(D_METHOD("get_packed", "schema"), &PacketPeer::_bnd_get_packed);
+	ClassDB::bind_method(D_METHOD("get_packed_into", "schema", "object"), &PacketPeer::_bnd_get_packed_into);
+	ClassDB::bind_method(D_METHOD("put_packed", "schema", "values"), &PacketPeer::put_packed);
 	ClassDB::bind_method(D_METHOD("get_packet"), &PacketPeer::_get_packet);
 	ClassDB::bind_method(D_METHOD("put_packet", "buffer"), &PacketPeer::_put_packet);
 	ClassDB::bind_method(D_METHOD("get_packet_error"), &PacketPeer::_get_packet_error);
@@ -33,6 +33,7 @@
 
 #include "core/io/stream_peer.h"
 #include "core/object.h"
+#include "core/io/packed_schema.h"
 #include "core/ring_buffer.h"
 
 class PacketPeer : public Reference {
@@ -40,6 +41,8 @@ class PacketPeer : public Reference {
 	GDCLASS(PacketPeer, Reference);
 
 	Variant _bnd_get_var(bool p_allow_objects = false);
+	Dictionary _bnd_get_packed(const Ref<PackedSchema> &p_schema);
+	Error _bnd_get_packed_into(const Ref<PackedSchema> &p_schema, Object *p_object);
 
 	static void _bind_methods();
 
@@ -51,6 +54,8 @@ class PacketPeer : public Reference {
 
 	bool allow_object_decoding;
 
+	Vector<uint8_t> packed_buffer; // Reused by put_packed.
+
 public:
 	virtual int get_available_packet_count() const = 0;
 	virtual Error get_packet(const uint8_t **r_buffer, int &r_buffer_size) = 0; ///< buffer is GONE after next get_packet
@@ -66,6 +71,9 @@ public:
 	virtual Error get_var(Variant &r_variant, bool p_allow_objects = false);
 	virtual Error put_var(const Variant &p_packet, bool p_full_objects = false);
 
+	Error get_packed(const Ref<PackedSchema> &p_schema, Dictionary &r_values);
+	Error put_packed(const Ref<PackedSchema> &p_schema, const Variant &p_values);
+
 	void set_allow_object_decoding(bool p_enable);
 	bool is_object_decoding_allowed() const;
 
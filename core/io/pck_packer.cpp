@@ -30,6 +30,8 @@
 
 #include "pck_packer.h"
 
+#include "core/io/file_access_delta.h"
+#include "core/io/file_access_pack.h"
 #include "core/os/file_access.h"
 #include "core/version.h"
 
@@ -57,6 +59,7 @@ void PCKPacker::_bind_methods() {
 
 	ClassDB::bind_method(D_METHOD("pck_start", "pck_name", "alignment"), &PCKPacker::pck_start);
 	ClassDB::bind_method(D_METHOD("add_file", "pck_path", "source_path"), &PCKPacker::add_file);
+	ClassDB::bind_method(D_METHOD("add_file_delta", "pck_path", "source_path", "base_path"), &PCKPacker::add_file_delta);
 	ClassDB::bind_method(D_METHOD("flush", "verbose"), &PCKPacker::flush);
 };
 
@@ -71,7 +74,7 @@ Error PCKPacker::pck_start(const String &p_file, int p_alignment) {
 	alignment = p_alignment;
 
 	file->store_32(0x43504447); // MAGIC
-	file->store_32(1); // # version
+	file->store_32(PACK_FORMAT_VERSION); // # version
 	file->store_32(VERSION_MAJOR); // # major
 	file->store_32(VERSION_MINOR); // # minor
 	file->store_32(0); // # revision
@@ -98,6 +101,7 @@ Error PCKPacker::add_file(const String &p_file, const String &p_src) {
 	pf.src_path = p_src;
 	pf.size = f->get_len();
 	pf.offset_offset = 0;
+	pf.path_md5 = p_file.md5_buffer();
 
 	files.push_back(pf);
 
@@ -107,6 +111,18 @@ Error PCKPacker::add_file(const String &p_file, const String &p_src) {
 	return OK;
 };
 
+Error PCKPacker::add_file_delta(const String &p_file, const String &p_src, const String &p_base) {
+
+	ERR_FAIL_COND_V(!FileAccess::exists(p_base), ERR_FILE_NOT_FOUND);
+
+	Error err = add_file(p_file, p_src);
+	if (err != OK)
+		return err;
+
+	files.write[files.size() - 1].base_path = p_base;
+	return OK;
+};
+
 Error PCKPacker::flush(bool p_verbose) {
 
 	if (!file) {
@@ -114,24 +130,46 @@ Error PCKPacker::flush(bool p_verbose) {
 		return ERR_INVALID_PARAMETER;
 	};
 
-	// write the index
+	// write the index, sorted by path MD5 so it can be searched in place
+
+	files.sort();
+
+	uint32_t paths_size = 0;
+	for (int i = 0; i < files.size(); i++) {
+		paths_size += files[i].path.utf8().length();
+	}
 
 	file->store_32(files.size());
+	file->store_32(paths_size);
 
+	uint32_t path_ofs = 0;
 	for (int i = 0; i < files.size(); i++) {
 
-		file->store_pascal_string(files[i].path);
+		uint32_t path_len = files[i].path.utf8().length();
+
+		file->store_buffer(files[i].path_md5.ptr(), 16);
 		files.write[i].offset_offset = file->get_position();
 		file->store_64(0); // offset
-		file->store_64(files[i].size); // size
+		file->store_64(0); // size
+		file->store_32(files[i].base_path != String() ? PackedData::PACK_FILE_DELTA : 0);
+		file->store_32(path_ofs);
+		file->store_32(path_len);
+		file->store_32(0); // reserved
 
 		// # empty md5
 		file->store_32(0);
 		file->store_32(0);
 		file->store_32(0);
 		file->store_32(0);
+
+		path_ofs += path_len;
 	};
 
+	for (int i = 0; i < files.size(); i++) {
+		CharString cs = files[i].path.utf8();
+		file->store_buffer((const uint8_t *)cs.get_data(), cs.length());
+	}
+
 	uint64_t ofs = file->get_position();
 	ofs = _align(ofs, alignment);
 
@@ -143,25 +181,37 @@ Error PCKPacker::flush(bool p_verbose) {
 	int count = 0;
 	for (int i = 0; i < files.size(); i++) {
 
-		FileAccess *src = FileAccess::open(files[i].src_path, FileAccess::READ);
-		uint64_t to_write = files[i].size;
-		while (to_write > 0) {
+		uint64_t size = files[i].size;
 
-			int read = src->get_buffer(buf, MIN(to_write, buf_max));
-			file->store_buffer(buf, read);
-			to_write -= read;
-		};
+		if (files[i].base_path != String()) {
+
+			Vector<uint8_t> delta = FileAccessDelta::make_delta(FileAccess::get_file_as_array(files[i].base_path), FileAccess::get_file_as_array(files[i].src_path));
+			file->store_buffer(delta.ptr(), delta.size());
+			size = delta.size();
+		} else {
+
+			FileAccess *src = FileAccess::open(files[i].src_path, FileAccess::READ);
+			uint64_t to_write = size;
+			while (to_write > 0) {
+
+				int read = src->get_buffer(buf, MIN(to_write, buf_max));
+				file->store_buffer(buf, read);
+				to_write -= read;
+			};
+
+			src->close();
+			memdelete(src);
+		}
 
 		uint64_t pos = file->get_position();
-		file->seek(files[i].offset_offset); // go back to store the file's offset
+		file->seek(files[i].offset_offset); // go back to store the file's offset and size
 		file->store_64(ofs);
+		file->store_64(size);
 		file->seek(pos);
 
-		ofs = _align(ofs + files[i].size, alignment);
+		ofs = _align(ofs + size, alignment);
 		_pad(file, ofs - pos);
 
-		src->close();
-		memdelete(src);
 		count += 1;
 		if (p_verbose) {
 			if (count % 100 == 0) {
@@ -48,14 +48,21 @@ class PCKPacker : public Reference {
 
 		String path;
 		String src_path;
-		int size;
+		String base_path;
+		uint64_t size;
 		uint64_t offset_offset;
+		Vector<uint8_t> path_md5;
+
+		bool operator<(const File &p_file) const {
+			return memcmp(path_md5.ptr(), p_file.path_md5.ptr(), 16) < 0;
+		}
 	};
 	Vector<File> files;
 
 public:
 	Error pck_start(const String &p_file, int p_alignment);
 	Error add_file(const String &p_file, const String &p_src);
+	Error add_file_delta(const String &p_file, const String &p_src, const String &p_base);
 	Error flush(bool p_verbose = false);
 
 	PCKPacker();
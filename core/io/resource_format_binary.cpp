@@ -30,6 +30,7 @@
 
 #include "resource_format_binary.h"
 
+#include "core/engine.h"
 #include "core/image.h"
 #include "core/io/file_access_compressed.h"
 #include "core/io/marshalls.h"
@@ -86,9 +87,17 @@ enum {
 	OBJECT_EXTERNAL_RESOURCE_INDEX = 3,
 	//version 2: added 64 bits support for float and int
 	//version 3: changed nodepath encoding
-	FORMAT_VERSION = 3,
+	//version 4: large plain arrays are page aligned, so they can be mapped
+	FORMAT_VERSION = 4,
 	FORMAT_VERSION_CAN_RENAME_DEPS = 1,
 	FORMAT_VERSION_NO_NODEPATH_PROPERTY = 3,
+	FORMAT_VERSION_ALIGNED_ARRAYS = 4,
+
+	ARRAY_ALIGNMENT = 4096,
+	ARRAY_ALIGN_MIN_SIZE = 65536,
+
+	ASYNC_READ_MIN_SIZE = 1024 * 1024,
+	ASYNC_READ_CHUNK_SIZE = 256 * 1024,
 
 };
 
@@ -101,6 +110,66 @@ void ResourceInteractiveLoaderBinary::_advance_padding(uint32_t p_len) {
 	}
 }
 
+void ResourceInteractiveLoaderBinary::_advance_alignment() {
+
+	if (ver_format < FORMAT_VERSION_ALIGNED_ARRAYS)
+		return;
+
+	uint32_t extra = f->get_32();
+	if (extra)
+		f->seek(f->get_position() + extra);
+}
+
+template <class T>
+bool ResourceInteractiveLoaderBinary::_map_array(PoolVector<T> &r_array, uint32_t p_len) {
+
+#ifdef BIG_ENDIAN_ENABLED
+	return false; //needs swapping
+#else
+	uint64_t bytes = uint64_t(p_len) * sizeof(T);
+	if (!use_mmap || bytes < ARRAY_ALIGN_MIN_SIZE || f->get_endian_swap())
+		return false;
+
+	size_t pos = f->get_position();
+	MemoryPool::ExternalMemory *owner = NULL;
+	uint8_t *mem = f->map_buffer(bytes, &owner);
+	if (!mem)
+		return false;
+
+	if (r_array.set_external(owner, (T *)mem, p_len) != OK) {
+		f->seek(pos);
+		return false;
+	}
+	return true;
+#endif
+}
+
+void ResourceInteractiveLoaderBinary::_read_buffer(uint8_t *p_dst, uint64_t p_bytes) {
+
+	if (p_bytes < ASYNC_READ_MIN_SIZE || !f->is_async_read_supported()) {
+		f->get_buffer(p_dst, p_bytes);
+		return;
+	}
+
+	// Big arrays are read in chunks that are all in flight at once.
+	size_t pos = f->get_position();
+	int chunks = (p_bytes + ASYNC_READ_CHUNK_SIZE - 1) / ASYNC_READ_CHUNK_SIZE;
+	FileAccess::AsyncRead *reads = memnew_arr(FileAccess::AsyncRead, chunks);
+	for (int i = 0; i < chunks; i++) {
+		uint64_t from = uint64_t(i) * ASYNC_READ_CHUNK_SIZE;
+		reads[i].offset = pos + from;
+		reads[i].dst = p_dst + from;
+		reads[i].length = MIN(uint64_t(ASYNC_READ_CHUNK_SIZE), p_bytes - from);
+		f->read_async(&reads[i]);
+	}
+	for (int i = 0; i < chunks; i++) {
+		FileAccess::wait_async_read(&reads[i]);
+	}
+	memdelete_arr(reads);
+
+	f->seek(pos + p_bytes);
+}
+
 StringName ResourceInteractiveLoaderBinary::_get_string() {
 
 	uint32_t id = f->get_32();
@@ -404,24 +473,31 @@ Error ResourceInteractiveLoaderBinary::parse_variant(Variant &r_v) {
 		case VARIANT_RAW_ARRAY: {
 
 			uint32_t len = f->get_32();
+			_advance_alignment();
 
 			PoolVector<uint8_t> array;
-			array.resize(len);
-			PoolVector<uint8_t>::Write w = array.write();
-			f->get_buffer(w.ptr(), len);
+			if (!_map_array(array, len)) {
+				array.resize(len);
+				PoolVector<uint8_t>::Write w = array.write();
+				_read_buffer(w.ptr(), len);
+			}
 			_advance_padding(len);
-			w = PoolVector<uint8_t>::Write();
 			r_v = array;
 
 		} break;
 		case VARIANT_INT_ARRAY: {
 
 			uint32_t len = f->get_32();
+			_advance_alignment();
 
 			PoolVector<int> array;
+			if (_map_array(array, len)) {
+				r_v = array;
+				break;
+			}
 			array.resize(len);
 			PoolVector<int>::Write w = array.write();
-			f->get_buffer((uint8_t *)w.ptr(), len * 4);
+			_read_buffer((uint8_t *)w.ptr(), uint64_t(len) * 4);
 #ifdef BIG_ENDIAN_ENABLED
 			{
 				uint32_t *ptr = (uint32_t *)w.ptr();
@@ -438,11 +514,16 @@ Error ResourceInteractiveLoaderBinary::parse_variant(Variant &r_v) {
 		case VARIANT_REAL_ARRAY: {
 
 			uint32_t len = f->get_32();
+			_advance_alignment();
 
 			PoolVector<real_t> array;
+			if (_map_array(array, len)) {
+				r_v = array;
+				break;
+			}
 			array.resize(len);
 			PoolVector<real_t>::Write w = array.write();
-			f->get_buffer((uint8_t *)w.ptr(), len * sizeof(real_t));
+			_read_buffer((uint8_t *)w.ptr(), uint64_t(len) * sizeof(real_t));
 #ifdef BIG_ENDIAN_ENABLED
 			{
 				uint32_t *ptr = (uint32_t *)w.ptr();
@@ -472,12 +553,17 @@ Error ResourceInteractiveLoaderBinary::parse_variant(Variant &r_v) {
 		case VARIANT_VECTOR2_ARRAY: {
 
 			uint32_t len = f->get_32();
+			_advance_alignment();
 
 			PoolVector<Vector2> array;
+			if (_map_array(array, len)) {
+				r_v = array;
+				break;
+			}
 			array.resize(len);
 			PoolVector<Vector2>::Write w = array.write();
 			if (sizeof(Vector2) == 8) {
-				f->get_buffer((uint8_t *)w.ptr(), len * sizeof(real_t) * 2);
+				_read_buffer((uint8_t *)w.ptr(), uint64_t(len) * sizeof(real_t) * 2);
 #ifdef BIG_ENDIAN_ENABLED
 				{
 					uint32_t *ptr = (uint32_t *)w.ptr();
@@ -500,12 +586,17 @@ Error ResourceInteractiveLoaderBinary::parse_variant(Variant &r_v) {
 		case VARIANT_VECTOR3_ARRAY: {
 
 			uint32_t len = f->get_32();
+			_advance_alignment();
 
 			PoolVector<Vector3> array;
+			if (_map_array(array, len)) {
+				r_v = array;
+				break;
+			}
 			array.resize(len);
 			PoolVector<Vector3>::Write w = array.write();
 			if (sizeof(Vector3) == 12) {
-				f->get_buffer((uint8_t *)w.ptr(), len * sizeof(real_t) * 3);
+				_read_buffer((uint8_t *)w.ptr(), uint64_t(len) * sizeof(real_t) * 3);
 #ifdef BIG_ENDIAN_ENABLED
 				{
 					uint32_t *ptr = (uint32_t *)w.ptr();
@@ -528,12 +619,17 @@ Error ResourceInteractiveLoaderBinary::parse_variant(Variant &r_v) {
 		case VARIANT_COLOR_ARRAY: {
 
 			uint32_t len = f->get_32();
+			_advance_alignment();
 
 			PoolVector<Color> array;
+			if (_map_array(array, len)) {
+				r_v = array;
+				break;
+			}
 			array.resize(len);
 			PoolVector<Color>::Write w = array.write();
 			if (sizeof(Color) == 16) {
-				f->get_buffer((uint8_t *)w.ptr(), len * sizeof(real_t) * 4);
+				_read_buffer((uint8_t *)w.ptr(), uint64_t(len) * sizeof(real_t) * 4);
 #ifdef BIG_ENDIAN_ENABLED
 				{
 					uint32_t *ptr = (uint32_t *)w.ptr();
@@ -975,6 +1071,9 @@ ResourceInteractiveLoaderBinary::ResourceInteractiveLoaderBinary() :
 		f(NULL),
 		error(OK),
 		stage(0) {
+
+	//the editor may rewrite imported files while they are in use
+	use_mmap = !Engine::get_singleton()->is_editor_hint();
 }
 
 ResourceInteractiveLoaderBinary::~ResourceInteractiveLoaderBinary() {
@@ -1285,6 +1384,20 @@ void ResourceFormatSaverBinaryInstance::_pad_buffer(FileAccess *f, int p_bytes)
 	}
 }
 
+void ResourceFormatSaverBinaryInstance::_align_buffer(FileAccess *f, uint64_t p_bytes) {
+
+	//padding size goes first, so it can be skipped even if the file is moved around later
+	uint32_t extra = 0;
+	if (p_bytes >= ARRAY_ALIGN_MIN_SIZE) {
+		uint64_t data_pos = f->get_position() + 4;
+		extra = (ARRAY_ALIGNMENT - data_pos % ARRAY_ALIGNMENT) % ARRAY_ALIGNMENT;
+	}
+
+	f->store_32(extra);
+	for (uint32_t i = 0; i < extra; i++)
+		f->store_8(0);
+}
+
 void ResourceFormatSaverBinaryInstance::_write_variant(const Variant &p_property, const PropertyInfo &p_hint) {
 
 	write_variant(f, p_property, resource_set, external_resources, string_map, p_hint);
@@ -1549,6 +1662,7 @@ void ResourceFormatSaverBinaryInstance::write_variant(FileAccess *f, const Varia
 			PoolVector<uint8_t> arr = p_property;
 			int len = arr.size();
 			f->store_32(len);
+			_align_buffer(f, len);
 			PoolVector<uint8_t>::Read r = arr.read();
 			f->store_buffer(r.ptr(), len);
 			_pad_buffer(f, len);
@@ -1560,6 +1674,7 @@ void ResourceFormatSaverBinaryInstance::write_variant(FileAccess *f, const Varia
 			PoolVector<int> arr = p_property;
 			int len = arr.size();
 			f->store_32(len);
+			_align_buffer(f, uint64_t(len) * 4);
 			PoolVector<int>::Read r = arr.read();
 			for (int i = 0; i < len; i++)
 				f->store_32(r[i]);
@@ -1571,6 +1686,7 @@ void ResourceFormatSaverBinaryInstance::write_variant(FileAccess *f, const Varia
 			PoolVector<real_t> arr = p_property;
 			int len = arr.size();
 			f->store_32(len);
+			_align_buffer(f, uint64_t(len) * sizeof(real_t));
 			PoolVector<real_t>::Read r = arr.read();
 			for (int i = 0; i < len; i++) {
 				f->store_real(r[i]);
@@ -1595,6 +1711,7 @@ void ResourceFormatSaverBinaryInstance::write_variant(FileAccess *f, const Varia
 			PoolVector<Vector3> arr = p_property;
 			int len = arr.size();
 			f->store_32(len);
+			_align_buffer(f, uint64_t(len) * sizeof(real_t) * 3);
 			PoolVector<Vector3>::Read r = arr.read();
 			for (int i = 0; i < len; i++) {
 				f->store_real(r[i].x);
@@ -1609,6 +1726,7 @@ void ResourceFormatSaverBinaryInstance::write_variant(FileAccess *f, const Varia
 			PoolVector<Vector2> arr = p_property;
 			int len = arr.size();
 			f->store_32(len);
+			_align_buffer(f, uint64_t(len) * sizeof(real_t) * 2);
 			PoolVector<Vector2>::Read r = arr.read();
 			for (int i = 0; i < len; i++) {
 				f->store_real(r[i].x);
@@ -1622,6 +1740,7 @@ void ResourceFormatSaverBinaryInstance::write_variant(FileAccess *f, const Varia
 			PoolVector<Color> arr = p_property;
 			int len = arr.size();
 			f->store_32(len);
+			_align_buffer(f, uint64_t(len) * sizeof(real_t) * 4);
 			PoolVector<Color>::Read r = arr.read();
 			for (int i = 0; i < len; i++) {
 				f->store_real(r[i].r);
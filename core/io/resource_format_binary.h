@@ -72,6 +72,12 @@ class ResourceInteractiveLoaderBinary : public ResourceInteractiveLoader {
 
 	String get_unicode_string();
 	void _advance_padding(uint32_t p_len);
+	void _advance_alignment();
+
+	bool use_mmap;
+	template <class T>
+	bool _map_array(PoolVector<T> &r_array, uint32_t p_len);
+	void _read_buffer(uint8_t *p_dst, uint64_t p_bytes);
 
 	Map<String, String> remaps;
 	Error error;
@@ -151,6 +157,7 @@ class ResourceFormatSaverBinaryInstance {
 	};
 
 	static void _pad_buffer(FileAccess *f, int p_bytes);
+	static void _align_buffer(FileAccess *f, uint64_t p_bytes);
 	void _write_variant(const Variant &p_property, const PropertyInfo &p_hint = PropertyInfo());
 	void _find_resources(const Variant &p_variant, bool p_main = false);
 	static void save_unicode_string(FileAccess *f, const String &p_string, bool p_bit_on_len = false);
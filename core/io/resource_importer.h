@@ -103,6 +103,8 @@ public:
 	virtual String get_resource_type() const = 0;
 	virtual float get_priority() const { return 1.0; }
 	virtual int get_import_order() const { return 0; }
+	// Importers that only touch their own source and output files can run on worker threads during a reimport.
+	virtual bool can_import_threaded() const { return false; }
 
 	struct ImportOption {
 		PropertyInfo option;
@@ -33,6 +33,7 @@
 #include "core/io/resource_importer.h"
 #include "core/os/file_access.h"
 #include "core/os/os.h"
+#include "core/os/trace.h"
 #include "core/path_remap.h"
 #include "core/print_string.h"
 #include "core/project_settings.h"
@@ -260,6 +261,8 @@ void ResourceFormatLoader::_bind_methods() {
 
 RES ResourceLoader::_load(const String &p_path, const String &p_original_path, const String &p_type_hint, bool p_no_cache, Error *r_error) {
 
+	TRACE_SCOPE("ResourceLoader::load");
+
 	bool found = false;
 
 	// Try all loaders and pick the first match for the type hint
@@ -345,6 +348,8 @@ void ResourceLoader::_remove_from_loading_map_and_thread(const String &p_path, T
 
 RES ResourceLoader::load(const String &p_path, const String &p_type_hint, bool p_no_cache, Error *r_error) {
 
+	MemoryTagScope tag_scope(MEMORY_TAG_RESOURCES);
+
 	if (r_error)
 		*r_error = ERR_CANT_OPEN;
 
@@ -389,6 +394,13 @@ RES ResourceLoader::load(const String &p_path, const String &p_type_hint, bool p
 		if (ResourceCache::lock) {
 			ResourceCache::lock->read_unlock();
 		}
+
+		//a background load may already be reading it, use that one instead
+		RES res;
+		if (_thread_load_wait_in_flight(local_path, res, r_error)) {
+			_remove_from_loading_map(local_path);
+			return res;
+		}
 	}
 
 	bool xl_remapped = false;
@@ -546,6 +558,445 @@ Ref<ResourceInteractiveLoader> ResourceLoader::load_interactive(const String &p_
 	return Ref<ResourceInteractiveLoader>();
 }
 
+String ResourceLoader::_localize_path(const String &p_path) {
+
+	if (p_path.is_rel_path())
+		return "res://" + p_path;
+	return ProjectSettings::get_singleton()->localize_path(p_path);
+}
+
+RES ResourceLoader::_get_cached(const String &p_local_path) {
+
+	RES res;
+	if (ResourceCache::lock) {
+		ResourceCache::lock->read_lock();
+	}
+
+	Resource **rptr = ResourceCache::resources.getptr(p_local_path);
+	if (rptr) {
+		//null if it was just freed in another thread
+		res = RES(*rptr);
+	}
+
+	if (ResourceCache::lock) {
+		ResourceCache::lock->read_unlock();
+	}
+	return res;
+}
+
+bool ResourceLoader::_thread_load_needs_main_thread(const String &p_type) {
+
+	if (OS::get_singleton()->get_render_thread_mode() == OS::RENDER_THREAD_UNSAFE) {
+		return true; //servers can't be called from other threads, and almost any resource may use them
+	}
+
+	//script languages are not thread safe while compiling
+	return p_type != String() && ClassDB::is_parent_class(p_type, "Script");
+}
+
+bool ResourceLoader::_thread_load_depends_on(const String &p_path, const String &p_dependency) {
+
+	Set<String> visited;
+	List<String> to_visit;
+	to_visit.push_back(p_path);
+
+	while (to_visit.size()) {
+
+		String path = to_visit.front()->get();
+		to_visit.pop_front();
+
+		if (path == p_dependency)
+			return true;
+		if (visited.has(path))
+			continue;
+		visited.insert(path);
+
+		const ThreadLoadTask *task = thread_load_tasks.getptr(path);
+		if (!task)
+			continue;
+		for (int i = 0; i < task->dependencies.size(); i++) {
+			to_visit.push_back(task->dependencies[i]);
+		}
+	}
+
+	return false;
+}
+
+void ResourceLoader::_thread_load_notify() {
+
+	while (thread_load_waiters) {
+		thread_load_waiters--;
+		thread_load_done_semaphore->post();
+	}
+}
+
+void ResourceLoader::_thread_load_wait() {
+
+	//must be called with thread_load_mutex held, returns after any task changed stage
+	thread_load_waiters++;
+	thread_load_mutex->unlock();
+	thread_load_done_semaphore->wait();
+	thread_load_mutex->lock();
+}
+
+ResourceLoader::ThreadLoadTask *ResourceLoader::_thread_load_add_task(const String &p_local_path, const String &p_type_hint) {
+
+	ThreadLoadTask task;
+	task.type_hint = p_type_hint;
+	task.resource = _get_cached(p_local_path);
+	if (task.resource.is_valid()) {
+		task.stage = THREAD_LOAD_STAGE_DONE;
+	}
+
+	thread_load_tasks[p_local_path] = task;
+
+	if (task.stage != THREAD_LOAD_STAGE_DONE) {
+		thread_load_queue.push_back(p_local_path);
+		thread_load_semaphore->post();
+	}
+
+	return thread_load_tasks.getptr(p_local_path);
+}
+
+void ResourceLoader::_thread_load_release(const String &p_local_path) {
+
+	ThreadLoadTask *task = thread_load_tasks.getptr(p_local_path);
+	ERR_FAIL_COND(!task);
+
+	task->users--;
+	if (task->users == 0 && task->stage == THREAD_LOAD_STAGE_DONE) {
+		thread_load_tasks.erase(p_local_path);
+	}
+}
+
+void ResourceLoader::_thread_load_schedule(const String &p_local_path) {
+
+	ThreadLoadTask *task = thread_load_tasks.getptr(p_local_path);
+	task->stage = THREAD_LOAD_STAGE_READY;
+
+	if (task->main_thread) {
+		thread_load_main_queue.push_back(p_local_path);
+		_thread_load_notify(); //the main thread may be blocked in load_threaded_get()
+	} else {
+		thread_load_queue.push_back(p_local_path);
+		thread_load_semaphore->post();
+	}
+}
+
+void ResourceLoader::_thread_load_process(const String &p_local_path) {
+
+	thread_load_mutex->lock();
+	const ThreadLoadTask *task = thread_load_tasks.getptr(p_local_path);
+	ThreadLoadStage stage = task ? task->stage : THREAD_LOAD_STAGE_DONE;
+	thread_load_mutex->unlock();
+
+	if (stage == THREAD_LOAD_STAGE_QUEUED) {
+		_thread_load_scan(p_local_path);
+	} else if (stage == THREAD_LOAD_STAGE_READY) {
+		_thread_load_run(p_local_path);
+	}
+}
+
+void ResourceLoader::_thread_load_scan(const String &p_local_path) {
+
+	List<String> dependencies;
+	get_dependencies(p_local_path, &dependencies);
+	String type = get_resource_type(p_local_path);
+
+	thread_load_mutex->lock();
+
+	ThreadLoadTask *task = thread_load_tasks.getptr(p_local_path);
+	task->main_thread = _thread_load_needs_main_thread(type);
+
+	for (List<String>::Element *E = dependencies.front(); E; E = E->next()) {
+
+		String dependency = _localize_path(E->get());
+		if (dependency == p_local_path)
+			continue;
+
+		ThreadLoadTask *dep_task = thread_load_tasks.getptr(dependency);
+		if (!dep_task) {
+			dep_task = _thread_load_add_task(dependency, String());
+		} else if (_thread_load_depends_on(dependency, p_local_path)) {
+			continue; //cyclic, leave it to the regular loader to report
+		}
+
+		dep_task->users++;
+		task->dependencies.push_back(dependency);
+		if (dep_task->stage != THREAD_LOAD_STAGE_DONE) {
+			dep_task->dependants.push_back(p_local_path);
+			task->pending_dependencies++;
+		}
+	}
+
+	bool run_now = false;
+	if (task->pending_dependencies) {
+		task->stage = THREAD_LOAD_STAGE_WAITING;
+	} else if (task->main_thread) {
+		_thread_load_schedule(p_local_path);
+	} else {
+		task->stage = THREAD_LOAD_STAGE_READY;
+		run_now = true;
+	}
+
+	thread_load_mutex->unlock();
+
+	if (run_now) {
+		_thread_load_run(p_local_path);
+	}
+}
+
+void ResourceLoader::_thread_load_run(const String &p_local_path) {
+
+	thread_load_mutex->lock();
+	ThreadLoadTask *task = thread_load_tasks.getptr(p_local_path);
+	task->stage = THREAD_LOAD_STAGE_LOADING;
+	task->thread = Thread::get_caller_id();
+	String type_hint = task->type_hint;
+	thread_load_mutex->unlock();
+
+	Error err = OK;
+	RES res = load(p_local_path, type_hint, false, &err);
+
+	thread_load_mutex->lock();
+
+	task = thread_load_tasks.getptr(p_local_path);
+	task->resource = res;
+	task->error = res.is_valid() ? OK : (err != OK ? err : FAILED);
+	task->stage = THREAD_LOAD_STAGE_DONE;
+
+	//dependencies are in the cache now, referenced by the resource itself
+	for (int i = 0; i < task->dependencies.size(); i++) {
+		_thread_load_release(task->dependencies[i]);
+	}
+	task->dependencies.clear();
+
+	for (int i = 0; i < task->dependants.size(); i++) {
+		ThreadLoadTask *dependant = thread_load_tasks.getptr(task->dependants[i]);
+		if (dependant && --dependant->pending_dependencies == 0) {
+			_thread_load_schedule(task->dependants[i]);
+		}
+	}
+	task->dependants.clear();
+
+	_thread_load_notify();
+	thread_load_mutex->unlock();
+}
+
+bool ResourceLoader::_thread_load_wait_in_flight(const String &p_local_path, RES &r_res, Error *r_error) {
+
+	if (!thread_load_mutex)
+		return false;
+
+	thread_load_mutex->lock();
+
+	Thread::ID caller = Thread::get_caller_id();
+	const ThreadLoadTask *task = thread_load_tasks.getptr(p_local_path);
+	while (task && task->stage == THREAD_LOAD_STAGE_LOADING && task->thread != caller) {
+		_thread_load_wait();
+		task = thread_load_tasks.getptr(p_local_path);
+	}
+
+	bool found = task && task->stage == THREAD_LOAD_STAGE_DONE && task->resource.is_valid();
+	if (found) {
+		r_res = task->resource;
+		if (r_error)
+			*r_error = OK;
+	}
+
+	thread_load_mutex->unlock();
+	return found;
+}
+
+void ResourceLoader::_thread_load_function(void *p_userdata) {
+
+	while (true) {
+
+		thread_load_semaphore->wait();
+
+		thread_load_mutex->lock();
+		if (thread_load_exit) {
+			thread_load_mutex->unlock();
+			break;
+		}
+		if (thread_load_queue.empty()) {
+			thread_load_mutex->unlock();
+			continue;
+		}
+		String path = thread_load_queue.front()->get();
+		thread_load_queue.pop_front();
+		thread_load_mutex->unlock();
+
+		_thread_load_process(path);
+	}
+}
+
+void ResourceLoader::_thread_load_start() {
+
+#ifndef NO_THREADS
+	if (thread_load_threads.size())
+		return;
+
+	int count = CLAMP(OS::get_singleton()->get_processor_count() - 1, 1, 4);
+	for (int i = 0; i < count; i++) {
+		thread_load_threads.push_back(Thread::create(_thread_load_function, NULL));
+	}
+#endif
+}
+
+Error ResourceLoader::load_threaded_request(const String &p_path, const String &p_type_hint) {
+
+	String local_path = _localize_path(p_path);
+
+	thread_load_mutex->lock();
+
+	_thread_load_start();
+
+	ThreadLoadTask *task = thread_load_tasks.getptr(local_path);
+	if (!task) {
+		task = _thread_load_add_task(local_path, p_type_hint);
+	}
+	if (!task->requested) {
+		task->requested = true;
+		task->users++;
+	}
+
+	bool inline_load = thread_load_threads.empty();
+	thread_load_mutex->unlock();
+
+	//without threads the whole graph is loaded right away
+	while (inline_load) {
+
+		thread_load_mutex->lock();
+		List<String> &queue = thread_load_main_queue.empty() ? thread_load_queue : thread_load_main_queue;
+		if (queue.empty()) {
+			thread_load_mutex->unlock();
+			break;
+		}
+		String path = queue.front()->get();
+		queue.pop_front();
+		thread_load_mutex->unlock();
+
+		_thread_load_process(path);
+	}
+
+	return OK;
+}
+
+ResourceLoader::ThreadLoadStatus ResourceLoader::load_threaded_get_status(const String &p_path, float *r_progress) {
+
+	String local_path = _localize_path(p_path);
+
+	thread_load_mutex->lock();
+
+	if (Thread::get_caller_id() == Thread::get_main_id() && !thread_load_main_queue.empty()) {
+		//advance main thread work a step at a time, so polling every frame doesn't stall
+		String path = thread_load_main_queue.front()->get();
+		thread_load_main_queue.pop_front();
+		thread_load_mutex->unlock();
+		_thread_load_process(path);
+		thread_load_mutex->lock();
+	}
+
+	const ThreadLoadTask *task = thread_load_tasks.getptr(local_path);
+	if (!task || !task->requested) {
+		thread_load_mutex->unlock();
+		if (r_progress)
+			*r_progress = 0;
+		return THREAD_LOAD_INVALID_RESOURCE;
+	}
+
+	ThreadLoadStatus status;
+	float progress;
+	if (task->stage == THREAD_LOAD_STAGE_DONE) {
+		status = task->resource.is_valid() ? THREAD_LOAD_LOADED : THREAD_LOAD_FAILED;
+		progress = 1.0;
+	} else {
+		int done = 0;
+		for (int i = 0; i < task->dependencies.size(); i++) {
+			const ThreadLoadTask *dep_task = thread_load_tasks.getptr(task->dependencies[i]);
+			if (dep_task && dep_task->stage == THREAD_LOAD_STAGE_DONE)
+				done++;
+		}
+		status = THREAD_LOAD_IN_PROGRESS;
+		progress = float(done) / float(task->dependencies.size() + 1);
+	}
+
+	thread_load_mutex->unlock();
+
+	if (r_progress)
+		*r_progress = progress;
+	return status;
+}
+
+RES ResourceLoader::load_threaded_get(const String &p_path, Error *r_error) {
+
+	String local_path = _localize_path(p_path);
+	bool main_thread = Thread::get_caller_id() == Thread::get_main_id();
+
+	thread_load_mutex->lock();
+
+	ThreadLoadTask *task = thread_load_tasks.getptr(local_path);
+	if (!task || !task->requested) {
+		thread_load_mutex->unlock();
+		if (r_error)
+			*r_error = ERR_INVALID_PARAMETER;
+		ERR_EXPLAIN("Resource was not requested for threaded loading: " + local_path);
+		ERR_FAIL_V(RES());
+	}
+
+	while (task->stage != THREAD_LOAD_STAGE_DONE) {
+
+		if (main_thread && !thread_load_main_queue.empty()) {
+			String path = thread_load_main_queue.front()->get();
+			thread_load_main_queue.pop_front();
+			thread_load_mutex->unlock();
+			_thread_load_process(path);
+			thread_load_mutex->lock();
+		} else {
+			_thread_load_wait();
+		}
+
+		task = thread_load_tasks.getptr(local_path);
+	}
+
+	RES res = task->resource;
+	Error err = task->error;
+
+	task->requested = false;
+	_thread_load_release(local_path);
+
+	thread_load_mutex->unlock();
+
+	if (r_error)
+		*r_error = err;
+	return res;
+}
+
+void ResourceLoader::clear_thread_load_tasks() {
+
+	if (!thread_load_mutex)
+		return;
+
+	thread_load_mutex->lock();
+	thread_load_exit = true;
+	thread_load_mutex->unlock();
+
+	for (int i = 0; i < thread_load_threads.size(); i++) {
+		thread_load_semaphore->post();
+	}
+	for (int i = 0; i < thread_load_threads.size(); i++) {
+		Thread::wait_to_finish(thread_load_threads[i]);
+		memdelete(thread_load_threads[i]);
+	}
+	thread_load_threads.clear();
+
+	thread_load_exit = false;
+	thread_load_queue.clear();
+	thread_load_main_queue.clear();
+	thread_load_tasks.clear();
+}
+
 void ResourceLoader::add_resource_format_loader(Ref<ResourceFormatLoader> p_format_loader, bool p_at_front) {
 
 	ERR_FAIL_COND(p_format_loader.is_null());
@@ -972,13 +1423,34 @@ void ResourceLoader::remove_custom_loaders() {
 Mutex *ResourceLoader::loading_map_mutex = NULL;
 HashMap<ResourceLoader::LoadingMapKey, int, ResourceLoader::LoadingMapKeyHasher> ResourceLoader::loading_map;
 
+Mutex *ResourceLoader::thread_load_mutex = NULL;
+Semaphore *ResourceLoader::thread_load_semaphore = NULL;
+Semaphore *ResourceLoader::thread_load_done_semaphore = NULL;
+int ResourceLoader::thread_load_waiters = 0;
+bool ResourceLoader::thread_load_exit = false;
+Vector<Thread *> ResourceLoader::thread_load_threads;
+HashMap<String, ResourceLoader::ThreadLoadTask> ResourceLoader::thread_load_tasks;
+List<String> ResourceLoader::thread_load_queue;
+List<String> ResourceLoader::thread_load_main_queue;
+
 void ResourceLoader::initialize() {
 #ifndef NO_THREADS
 	loading_map_mutex = Mutex::create();
 #endif
+	thread_load_mutex = Mutex::create();
+	thread_load_semaphore = Semaphore::create();
+	thread_load_done_semaphore = Semaphore::create();
 }
 
 void ResourceLoader::finalize() {
+	clear_thread_load_tasks();
+	memdelete(thread_load_mutex);
+	thread_load_mutex = NULL;
+	memdelete(thread_load_semaphore);
+	thread_load_semaphore = NULL;
+	memdelete(thread_load_done_semaphore);
+	thread_load_done_semaphore = NULL;
+
 #ifndef NO_THREADS
 	const LoadingMapKey *K = NULL;
 	while ((K = loading_map.next(K))) {
@@ -31,6 +31,7 @@
 #ifndef RESOURCE_LOADER_H
 #define RESOURCE_LOADER_H
 
+#include "core/os/semaphore.h"
 #include "core/os/thread.h"
 #include "core/resource.h"
 /**
@@ -97,6 +98,16 @@ class ResourceLoader {
 		MAX_LOADERS = 64
 	};
 
+public:
+	enum ThreadLoadStatus {
+		THREAD_LOAD_INVALID_RESOURCE,
+		THREAD_LOAD_IN_PROGRESS,
+		THREAD_LOAD_FAILED,
+		THREAD_LOAD_LOADED
+	};
+
+private:
+
 	static Ref<ResourceFormatLoader> loader[MAX_LOADERS];
 	static int loader_count;
 	static bool timestamp_on_load;
@@ -143,7 +154,71 @@ class ResourceLoader {
 	static void _remove_from_loading_map(const String &p_path);
 	static void _remove_from_loading_map_and_thread(const String &p_path, Thread::ID p_thread);
 
+	//background loads requested with load_threaded_request(), plus the dependencies they pulled in
+	enum ThreadLoadStage {
+		THREAD_LOAD_STAGE_QUEUED, //waiting for its dependencies to be scanned
+		THREAD_LOAD_STAGE_WAITING, //waiting for its dependencies to finish
+		THREAD_LOAD_STAGE_READY, //queued to be loaded
+		THREAD_LOAD_STAGE_LOADING,
+		THREAD_LOAD_STAGE_DONE
+	};
+
+	struct ThreadLoadTask {
+		String type_hint;
+		ThreadLoadStage stage;
+		Thread::ID thread;
+		bool requested; //by the user, released by load_threaded_get()
+		bool main_thread; //must be loaded from the main thread
+		int users;
+		int pending_dependencies;
+		Vector<String> dependencies;
+		Vector<String> dependants;
+		Error error;
+		RES resource;
+
+		ThreadLoadTask() {
+			stage = THREAD_LOAD_STAGE_QUEUED;
+			thread = 0;
+			requested = false;
+			main_thread = false;
+			users = 0;
+			pending_dependencies = 0;
+			error = OK;
+		}
+	};
+
+	static Mutex *thread_load_mutex;
+	static Semaphore *thread_load_semaphore; //work available
+	static Semaphore *thread_load_done_semaphore; //a task changed stage
+	static int thread_load_waiters;
+	static bool thread_load_exit;
+	static Vector<Thread *> thread_load_threads;
+	static HashMap<String, ThreadLoadTask> thread_load_tasks;
+	static List<String> thread_load_queue;
+	static List<String> thread_load_main_queue;
+
+	static String _localize_path(const String &p_path);
+	static RES _get_cached(const String &p_local_path);
+	static bool _thread_load_needs_main_thread(const String &p_type);
+	static bool _thread_load_depends_on(const String &p_path, const String &p_dependency);
+	static void _thread_load_notify();
+	static void _thread_load_wait();
+	static ThreadLoadTask *_thread_load_add_task(const String &p_local_path, const String &p_type_hint);
+	static void _thread_load_release(const String &p_local_path);
+	static void _thread_load_schedule(const String &p_local_path);
+	static void _thread_load_process(const String &p_local_path);
+	static void _thread_load_scan(const String &p_local_path);
+	static void _thread_load_run(const String &p_local_path);
+	static bool _thread_load_wait_in_flight(const String &p_local_path, RES &r_res, Error *r_error);
+	static void _thread_load_function(void *p_userdata);
+	static void _thread_load_start();
+
 public:
+	static Error load_threaded_request(const String &p_path, const String &p_type_hint = "");
+	static ThreadLoadStatus load_threaded_get_status(const String &p_path, float *r_progress = NULL);
+	static RES load_threaded_get(const String &p_path, Error *r_error = NULL);
+	static void clear_thread_load_tasks();
+
 	static Ref<ResourceInteractiveLoader> load_interactive(const String &p_path, const String &p_type_hint = "", bool p_no_cache = false, Error *r_error = NULL);
 	static RES load(const String &p_path, const String &p_type_hint = "", bool p_no_cache = false, Error *r_error = NULL);
 	static bool exists(const String &p_path, const String &p_type_hint = "");
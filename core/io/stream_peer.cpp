@@ -232,6 +232,23 @@ void StreamPeer::put_var(const Variant &p_variant, bool p_full_objects) {
 	put_data(buf.ptr(), buf.size());
 }
 
+Error StreamPeer::put_packed(const Ref<PackedSchema> &p_schema, const Variant &p_values) {
+
+	ERR_FAIL_COND_V(p_schema.is_null(), ERR_INVALID_PARAMETER);
+
+	Error err;
+	if (p_values.get_type() == Variant::OBJECT) {
+		err = p_schema->encode_object(p_values, packed_buffer);
+	} else {
+		ERR_FAIL_COND_V(p_values.get_type() != Variant::DICTIONARY, ERR_INVALID_PARAMETER);
+		err = p_schema->encode(p_values, packed_buffer);
+	}
+	ERR_FAIL_COND_V(err, err);
+
+	put_32(packed_buffer.size());
+	return put_data(packed_buffer.ptr(), packed_buffer.size());
+}
+
 uint8_t StreamPeer::get_u8() {
 
 	uint8_t buf[1];
@@ -373,6 +390,34 @@ Variant StreamPeer::get_var(bool p_allow_objects) {
 	return ret;
 }
 
+Error StreamPeer::_get_packed_buffer() {
+
+	int len = get_32();
+	ERR_FAIL_COND_V(len < 0, ERR_INVALID_DATA);
+	Error err = packed_buffer.resize(len);
+	ERR_FAIL_COND_V(err != OK, err);
+	return get_data(packed_buffer.ptrw(), len);
+}
+
+Dictionary StreamPeer::get_packed(const Ref<PackedSchema> &p_schema) {
+
+	Dictionary ret;
+	ERR_FAIL_COND_V(p_schema.is_null(), ret);
+	ERR_FAIL_COND_V(_get_packed_buffer() != OK, ret);
+
+	p_schema->decode(packed_buffer.ptr(), packed_buffer.size(), ret);
+	return ret;
+}
+
+Error StreamPeer::get_packed_into(const Ref<PackedSchema> &p_schema, Object *p_object) {
+
+	ERR_FAIL_COND_V(p_schema.is_null(), ERR_INVALID_PARAMETER);
+	Error err = _get_packed_buffer();
+	ERR_FAIL_COND_V(err != OK, err);
+
+	return p_schema->decode_object(packed_buffer.ptr(), packed_buffer.size(), p_object);
+}
+
 void StreamPeer::_bind_methods() {
 
 	ClassDB::bind_method(D_METHOD("put_data", "data"), &StreamPeer::_put_data);
@@ -399,6 +444,7 @@ void StreamPeer::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("put_string", "value"), &StreamPeer::put_string);
 	ClassDB::bind_method(D_METHOD("put_utf8_string", "value"), &StreamPeer::put_utf8_string);
 	ClassDB::bind_method(D_METHOD("put_var", "value", "full_objects"), &StreamPeer::put_var, DEFVAL(false));
+	ClassDB::bind_method(D_METHOD("put_packed", "schema", "values"), &StreamPeer::put_packed);
 
 	ClassDB::bind_method(D_METHOD("get_8"), &StreamPeer::get_8);
 	ClassDB::bind_method(D_METHOD("get_u8"), &StreamPeer::get_u8);
@@ -413,6 +459,8 @@ void StreamPeer::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("get_string", "bytes"), &StreamPeer::get_string, DEFVAL(-1));
 	ClassDB::bind_method(D_METHOD("get_utf8_string", "bytes"), &StreamPeer::get_utf8_string, DEFVAL(-1));
 	ClassDB::bind_method(D_METHOD("get_var", "allow_objects"), &StreamPeer::get_var, DEFVAL(false));
+	ClassDB::bind_method(D_METHOD("get_packed", "schema"), &StreamPeer::get_packed);
+	ClassDB::bind_method(D_METHOD("get_packed_into", "schema", "object"), &StreamPeer::get_packed_into);
 
 	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "big_endian"), "set_big_endian", "is_big_endian_enabled");
 }
@@ -31,6 +31,7 @@
 #ifndef STREAM_PEER_H
 #define STREAM_PEER_H
 
+#include "core/io/packed_schema.h"
 #include "core/reference.h"
 
 class StreamPeer : public Reference {
@@ -49,6 +50,10 @@ protected:
 
 	bool big_endian;
 
+	Vector<uint8_t> packed_buffer; // Reused by put_packed and get_packed.
+
+	Error _get_packed_buffer();
+
 public:
 	virtual Error put_data(const uint8_t *p_data, int p_bytes) = 0; ///< put a whole chunk of data, blocking until it sent
 	virtual Error put_partial_data(const uint8_t *p_data, int p_bytes, int &r_sent) = 0; ///< put as much data as possible, without blocking.
@@ -74,6 +79,7 @@ public:
 	void put_string(const String &p_string);
 	void put_utf8_string(const String &p_string);
 	void put_var(const Variant &p_variant, bool p_full_objects = false);
+	Error put_packed(const Ref<PackedSchema> &p_schema, const Variant &p_values);
 
 	uint8_t get_u8();
 	int8_t get_8();
@@ -88,6 +94,8 @@ public:
 	String get_string(int p_bytes = -1);
 	String get_utf8_string(int p_bytes = -1);
 	Variant get_var(bool p_allow_objects = false);
+	Dictionary get_packed(const Ref<PackedSchema> &p_schema);
+	Error get_packed_into(const Ref<PackedSchema> &p_schema, Object *p_object);
 
 	StreamPeer() { big_endian = false; }
 };
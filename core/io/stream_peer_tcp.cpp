@@ -271,8 +271,26 @@ StreamPeerTCP::Status StreamPeerTCP::get_status() {
 	return status;
 }
 
+void StreamPeerTCP::set_poller(const Ref<NetSocketPoller> &p_poller, uint64_t p_id) {
+
+	ERR_FAIL_COND(!_sock.is_valid() || !_sock->is_open());
+
+	if (_poller.is_valid())
+		_poller->remove_socket(_sock);
+
+	_poller = p_poller;
+
+	if (_poller.is_valid() && _poller->add_socket(_sock, NetSocketPoller::EVENT_IN, p_id) != OK)
+		_poller.unref();
+}
+
 void StreamPeerTCP::disconnect_from_host() {
 
+	if (_poller.is_valid()) {
+		_poller->remove_socket(_sock); // Must happen before the descriptor can be reused.
+		_poller.unref();
+	}
+
 	if (_sock.is_valid() && _sock->is_open())
 		_sock->close();
 
@@ -52,6 +52,7 @@ public:
 
 protected:
 	Ref<NetSocket> _sock;
+	Ref<NetSocketPoller> _poller;
 	Status status;
 	IP_Address peer_host;
 	uint16_t peer_port;
@@ -65,6 +66,7 @@ protected:
 
 public:
 	void accept_socket(Ref<NetSocket> p_sock, IP_Address p_host, uint16_t p_port);
+	void set_poller(const Ref<NetSocketPoller> &p_poller, uint64_t p_id);
 
 	Error connect_to_host(const IP_Address &p_host, uint16_t p_port);
 	bool is_connected_to_host() const;
@@ -35,6 +35,7 @@ void TCP_Server::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("listen", "port", "bind_address"), &TCP_Server::listen, DEFVAL("*"));
 	ClassDB::bind_method(D_METHOD("is_connection_available"), &TCP_Server::is_connection_available);
 	ClassDB::bind_method(D_METHOD("take_connection"), &TCP_Server::take_connection);
+	ClassDB::bind_method(D_METHOD("poll_connections", "timeout_msec"), &TCP_Server::poll_connections, DEFVAL(0));
 	ClassDB::bind_method(D_METHOD("stop"), &TCP_Server::stop);
 }
 
@@ -72,6 +73,11 @@ Error TCP_Server::listen(uint16_t p_port, const IP_Address &p_bind_address) {
 		_sock->close();
 		return FAILED;
 	}
+
+	if (_poller.is_valid()) {
+		// Id 0 is never a valid instance, so it marks the listening socket.
+		_poller->add_socket(_sock, NetSocketPoller::EVENT_IN, 0);
+	}
 	return OK;
 }
 
@@ -106,18 +112,47 @@ Ref<StreamPeerTCP> TCP_Server::take_connection() {
 
 	conn = Ref<StreamPeerTCP>(memnew(StreamPeerTCP));
 	conn->accept_socket(ns, ip, port);
+	if (_poller.is_valid()) {
+		conn->set_poller(_poller, conn->get_instance_id());
+	}
 	return conn;
 }
 
+Array TCP_Server::poll_connections(int p_timeout_msec) {
+
+	Array ret;
+	ERR_FAIL_COND_V(!_poller.is_valid(), ret);
+
+	Error err = _poller->wait(_events, p_timeout_msec);
+	ERR_FAIL_COND_V(err != OK, ret);
+
+	for (int i = 0; i < _events.size(); i++) {
+
+		if (_events[i].id == 0)
+			continue; // Listening socket, is_connection_available() will report it.
+
+		StreamPeerTCP *conn = Object::cast_to<StreamPeerTCP>(ObjectDB::get_instance(_events[i].id));
+		if (conn) {
+			ret.push_back(Ref<StreamPeerTCP>(conn));
+		}
+	}
+
+	return ret;
+}
+
 void TCP_Server::stop() {
 
 	if (_sock.is_valid()) {
+		if (_poller.is_valid()) {
+			_poller->remove_socket(_sock);
+		}
 		_sock->close();
 	}
 }
 
 TCP_Server::TCP_Server() :
-		_sock(Ref<NetSocket>(NetSocket::create())) {
+		_sock(Ref<NetSocket>(NetSocket::create())),
+		_poller(Ref<NetSocketPoller>(NetSocketPoller::create())) {
 }
 
 TCP_Server::~TCP_Server() {
@@ -46,12 +46,15 @@ protected:
 	};
 
 	Ref<NetSocket> _sock;
+	Ref<NetSocketPoller> _poller;
+	Vector<NetSocketPoller::Event> _events;
 	static void _bind_methods();
 
 public:
 	Error listen(uint16_t p_port, const IP_Address &p_bind_address = IP_Address("*"));
 	bool is_connection_available() const;
 	Ref<StreamPeerTCP> take_connection();
+	Array poll_connections(int p_timeout_msec = 0);
 
 	void stop(); // Stop listening
 
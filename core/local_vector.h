@@ -0,0 +1,304 @@
+/*************************************************************************/
+/*  local_vector.h                                                       */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2019 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2019 Godot Engine contributors (cf. AUTHORS.md)    */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+
+#ifndef LOCAL_VECTOR_H
+#define LOCAL_VECTOR_H
+
+#include "core/error_macros.h"
+#include "core/os/copymem.h"
+#include "core/os/memory.h"
+#include "core/sort_array.h"
+#include "core/vector.h"
+
+/**
+ * Growable array owned by a single user: no reference count, no copy on write,
+ * and capacity is kept when the size shrinks, so a vector that is cleared and
+ * refilled every frame stops allocating. Meant for engine internals, use Vector
+ * for anything that is shared or exposed to the API.
+ */
+
+template <class T>
+class LocalVector {
+
+	T *data;
+	int count;
+	int capacity;
+
+	void _realloc(int p_capacity) {
+
+		if (__has_trivial_copy(T)) {
+			data = (T *)memrealloc(data, p_capacity * sizeof(T));
+		} else {
+			T *new_data = (T *)memalloc(p_capacity * sizeof(T));
+			for (int i = 0; i < count; i++) {
+				memnew_placement(&new_data[i], T(static_cast<T &&>(data[i])));
+				data[i].~T();
+			}
+			if (data) {
+				memfree(data);
+			}
+			data = new_data;
+		}
+		capacity = p_capacity;
+	}
+
+	// the element was taken out first, it may have referenced the old storage
+	void _grow_push_back(T &&p_elem) {
+
+		_realloc(capacity ? capacity * 2 : 4);
+		memnew_placement(&data[count], T(static_cast<T &&>(p_elem)));
+		count++;
+	}
+
+	void _free() {
+
+		if (!data)
+			return;
+		clear();
+		memfree(data);
+		data = NULL;
+		capacity = 0;
+	}
+
+public:
+	_FORCE_INLINE_ T *ptr() { return data; }
+	_FORCE_INLINE_ const T *ptr() const { return data; }
+	// same as ptr(), so code written for Vector keeps working
+	_FORCE_INLINE_ T *ptrw() { return data; }
+
+	_FORCE_INLINE_ int size() const { return count; }
+	_FORCE_INLINE_ bool empty() const { return count == 0; }
+	_FORCE_INLINE_ int get_capacity() const { return capacity; }
+
+	_FORCE_INLINE_ T &operator[](int p_index) {
+		CRASH_BAD_INDEX(p_index, count);
+		return data[p_index];
+	}
+	_FORCE_INLINE_ const T &operator[](int p_index) const {
+		CRASH_BAD_INDEX(p_index, count);
+		return data[p_index];
+	}
+
+	void reserve(int p_size) {
+
+		if (p_size > capacity) {
+			_realloc(next_power_of_2(p_size));
+		}
+	}
+
+	_FORCE_INLINE_ void push_back(const T &p_elem) {
+
+		if (unlikely(count == capacity)) {
+			_grow_push_back(T(p_elem));
+			return;
+		}
+		memnew_placement(&data[count], T(p_elem));
+		count++;
+	}
+
+	_FORCE_INLINE_ void push_back(T &&p_elem) {
+
+		if (unlikely(count == capacity)) {
+			_grow_push_back(T(static_cast<T &&>(p_elem)));
+			return;
+		}
+		memnew_placement(&data[count], T(static_cast<T &&>(p_elem)));
+		count++;
+	}
+
+	void remove(int p_index) {
+
+		ERR_FAIL_INDEX(p_index, count);
+		for (int i = p_index; i < count - 1; i++) {
+			data[i] = static_cast<T &&>(data[i + 1]);
+		}
+		count--;
+		data[count].~T();
+	}
+
+	// faster than remove(), but the last element takes the place of the removed one
+	void remove_unordered(int p_index) {
+
+		ERR_FAIL_INDEX(p_index, count);
+		count--;
+		if (p_index < count) {
+			data[p_index] = static_cast<T &&>(data[count]);
+		}
+		data[count].~T();
+	}
+
+	void erase(const T &p_val) {
+
+		int idx = find(p_val);
+		if (idx >= 0) {
+			remove(idx);
+		}
+	}
+
+	int find(const T &p_val, int p_from = 0) const {
+
+		for (int i = p_from; i < count; i++) {
+			if (data[i] == p_val) {
+				return i;
+			}
+		}
+		return -1;
+	}
+
+	void insert(int p_pos, const T &p_val) {
+
+		ERR_FAIL_INDEX(p_pos, count + 1);
+		if (p_pos == count) {
+			push_back(p_val);
+			return;
+		}
+		T val = p_val; // may reference an element that moves
+		push_back(static_cast<T &&>(data[count - 1]));
+		for (int i = count - 2; i > p_pos; i--) {
+			data[i] = static_cast<T &&>(data[i - 1]);
+		}
+		data[p_pos] = static_cast<T &&>(val);
+	}
+
+	void resize(int p_size) {
+
+		ERR_FAIL_COND(p_size < 0);
+		if (p_size < count) {
+			if (!__has_trivial_destructor(T)) {
+				for (int i = p_size; i < count; i++) {
+					data[i].~T();
+				}
+			}
+			count = p_size;
+		} else if (p_size > count) {
+			reserve(p_size);
+			if (!__has_trivial_constructor(T)) {
+				for (int i = count; i < p_size; i++) {
+					memnew_placement(&data[i], T);
+				}
+			}
+			count = p_size;
+		}
+	}
+
+	// keeps the capacity, use reset() to free the memory
+	void clear() { resize(0); }
+	void reset() { _free(); }
+
+	void invert() {
+
+		for (int i = 0; i < count / 2; i++) {
+			SWAP(data[i], data[count - i - 1]);
+		}
+	}
+
+	template <class C>
+	void sort_custom() {
+
+		if (count < 2)
+			return;
+		SortArray<T, C> sorter;
+		sorter.sort(data, count);
+	}
+
+	void sort() {
+
+		sort_custom<_DefaultComparator<T> >();
+	}
+
+	operator Vector<T>() const {
+
+		Vector<T> ret;
+		ret.resize(count);
+		T *w = ret.ptrw();
+		for (int i = 0; i < count; i++) {
+			w[i] = data[i];
+		}
+		return ret;
+	}
+
+	void operator=(const LocalVector &p_from) {
+
+		if (this == &p_from)
+			return;
+		clear();
+		reserve(p_from.count);
+		for (int i = 0; i < p_from.count; i++) {
+			memnew_placement(&data[i], T(p_from.data[i]));
+		}
+		count = p_from.count;
+	}
+
+	void operator=(LocalVector &&p_from) {
+
+		if (this == &p_from)
+			return;
+		_free();
+		data = p_from.data;
+		count = p_from.count;
+		capacity = p_from.capacity;
+		p_from.data = NULL;
+		p_from.count = 0;
+		p_from.capacity = 0;
+	}
+
+	LocalVector(const LocalVector &p_from) {
+
+		data = NULL;
+		count = 0;
+		capacity = 0;
+		*this = p_from;
+	}
+
+	LocalVector(LocalVector &&p_from) {
+
+		data = p_from.data;
+		count = p_from.count;
+		capacity = p_from.capacity;
+		p_from.data = NULL;
+		p_from.count = 0;
+		p_from.capacity = 0;
+	}
+
+	_FORCE_INLINE_ LocalVector() {
+
+		data = NULL;
+		count = 0;
+		capacity = 0;
+	}
+
+	_FORCE_INLINE_ ~LocalVector() {
+
+		_free();
+	}
+};
+
+#endif // LOCAL_VECTOR_H
@@ -32,6 +32,7 @@
 
 #include "core/math/geometry.h"
 #include "core/script_language.h"
+#include "core/sort_array.h"
 #include "scene/scene_string_names.h"
 
 int AStar::get_available_point_id() const {
@@ -53,9 +54,9 @@ void AStar::add_point(int p_id, const Vector3 &p_pos, real_t p_weight_scale) {
 		pt->id = p_id;
 		pt->pos = p_pos;
 		pt->weight_scale = p_weight_scale;
-		pt->prev_point = NULL;
-		pt->last_pass = 0;
+		pt->index = point_list.size();
 		points[p_id] = pt;
+		point_list.push_back(pt);
 	} else {
 		points[p_id]->pos = p_pos;
 		points[p_id]->weight_scale = p_weight_scale;
@@ -97,16 +98,29 @@ void AStar::remove_point(int p_id) {
 
 	Point *p = points[p_id];
 
-	Map<int, Point *>::Element *PE = points.front();
-	while (PE) {
-		for (Set<Point *>::Element *E = PE->get()->neighbours.front(); E; E = E->next()) {
-			Segment s(p_id, E->get()->id);
-			segments.erase(s);
-			E->get()->neighbours.erase(p);
+	for (int i = 0; i < p->neighbours.size(); i++) {
+		segments.erase(Segment(p_id, p->neighbours[i]->id));
+	}
+
+	// Connections may be one way, so points linking to this one have to be looked for
+	for (int i = 0; i < point_list.size(); i++) {
+		Point *q = point_list[i];
+		int idx = q->neighbours.find(p);
+		if (idx != -1) {
+			q->neighbours.remove(idx);
+			segments.erase(Segment(p_id, q->id));
 		}
-		PE = PE->next();
 	}
 
+	// Move the last point into the hole, so point_list stays contiguous
+	int last = point_list.size() - 1;
+	if (p->index != last) {
+		Point *moved = point_list[last];
+		moved->index = p->index;
+		point_list.write[p->index] = moved;
+	}
+	point_list.resize(last);
+
 	memdelete(p);
 	points.erase(p_id);
 }
@@ -119,10 +133,11 @@ void AStar::connect_points(int p_id, int p_with_id, bool bidirectional) {
 
 	Point *a = points[p_id];
 	Point *b = points[p_with_id];
-	a->neighbours.insert(b);
+	if (a->neighbours.find(b) == -1)
+		a->neighbours.push_back(b);
 
-	if (bidirectional)
-		b->neighbours.insert(a);
+	if (bidirectional && b->neighbours.find(a) == -1)
+		b->neighbours.push_back(a);
 
 	Segment s(p_id, p_with_id);
 	if (s.from == p_id) {
@@ -172,8 +187,8 @@ PoolVector<int> AStar::get_point_connections(int p_id) {
 
 	Point *p = points[p_id];
 
-	for (Set<Point *>::Element *E = p->neighbours.front(); E; E = E->next()) {
-		point_list.push_back(E->get()->id);
+	for (int i = 0; i < p->neighbours.size(); i++) {
+		point_list.push_back(p->neighbours[i]->id);
 	}
 
 	return point_list;
@@ -193,6 +208,7 @@ void AStar::clear() {
 	}
 	segments.clear();
 	points.clear();
+	point_list.clear();
 }
 
 int AStar::get_closest_point(const Vector3 &p_point) const {
@@ -238,83 +254,91 @@ Vector3 AStar::get_closest_position_in_segment(const Vector3 &p_point) const {
 	return closest_point;
 }
 
-bool AStar::_solve(Point *begin_point, Point *end_point) {
+void AStar::_push_open_entry(SearchState &r_state, int &r_open_count, const OpenEntry &p_entry) {
 
-	pass++;
+	if (r_open_count == r_state.open_list.size()) {
+		r_state.open_list.resize(MAX(r_open_count * 2, 64));
+	}
 
-	SelfList<Point>::List open_list;
+	OpenEntry *open_list = r_state.open_list.ptrw();
+	open_list[r_open_count] = p_entry;
+	SortArray<OpenEntry, OpenEntryComparator>().push_heap(0, r_open_count, 0, p_entry, open_list);
+	r_open_count++;
+}
 
-	bool found_route = false;
+bool AStar::_solve(Point *begin_point, Point *end_point, SearchState &r_state) {
 
-	for (Set<Point *>::Element *E = begin_point->neighbours.front(); E; E = E->next()) {
+	uint64_t pass = ++r_state.pass;
 
-		Point *n = E->get();
-		n->prev_point = begin_point;
-		n->distance = _compute_cost(begin_point->id, n->id) * n->weight_scale;
-		n->last_pass = pass;
-		open_list.add(&n->list);
+	if (r_state.points.size() < point_list.size()) {
+		r_state.points.resize(point_list.size());
 	}
+	PointState *states = r_state.points.ptrw();
 
-	while (true) {
+	// Binary heap ordered by estimated total cost. Improved points are pushed again
+	// rather than moved, stale entries are skipped once their point is closed.
+	int open_count = 0;
 
-		if (open_list.first() == NULL) {
-			// No path found
-			break;
-		}
-		// Check open list
+	states[begin_point->index].closed_pass = pass;
+
+	for (int i = 0; i < begin_point->neighbours.size(); i++) {
 
-		SelfList<Point> *least_cost_point = open_list.first();
-		real_t least_cost = Math_INF;
+		Point *n = begin_point->neighbours[i];
+		PointState &ns = states[n->index];
+		ns.prev_point = begin_point;
+		ns.distance = _compute_cost(begin_point->id, n->id) * n->weight_scale;
+		ns.open_pass = pass;
 
-		// TODO: Cache previous results
-		for (SelfList<Point> *E = open_list.first(); E; E = E->next()) {
+		OpenEntry entry;
+		entry.f_score = ns.distance + _estimate_cost(n->id, end_point->id);
+		entry.point = n;
+		_push_open_entry(r_state, open_count, entry);
+	}
+
+	bool found_route = false;
 
-			Point *p = E->self();
+	while (open_count > 0) {
 
-			real_t cost = p->distance;
-			cost += _estimate_cost(p->id, end_point->id);
+		OpenEntry *open_list = r_state.open_list.ptrw();
+		SortArray<OpenEntry, OpenEntryComparator>().pop_heap(0, open_count, open_list);
+		open_count--;
 
-			if (cost < least_cost) {
-				least_cost_point = E;
-				least_cost = cost;
-			}
+		Point *p = open_list[open_count].point;
+		PointState &ps = states[p->index];
+
+		if (ps.closed_pass == pass) {
+			continue; // Stale entry, a cheaper one was already taken
 		}
 
-		Point *p = least_cost_point->self();
 		if (p == end_point) {
 			found_route = true;
 			break;
 		}
 
-		for (Set<Point *>::Element *E = p->neighbours.front(); E; E = E->next()) {
+		ps.closed_pass = pass;
 
-			Point *e = E->get();
+		for (int i = 0; i < p->neighbours.size(); i++) {
 
-			real_t distance = _compute_cost(p->id, e->id) * e->weight_scale + p->distance;
+			Point *e = p->neighbours[i];
+			PointState &es = states[e->index];
 
-			if (e->last_pass == pass) {
-				// Already visited, is this cheaper?
+			if (es.closed_pass == pass)
+				continue;
 
-				if (e->distance > distance) {
-					e->prev_point = p;
-					e->distance = distance;
-				}
-			} else {
-				// Add to open neighbours
+			real_t distance = _compute_cost(p->id, e->id) * e->weight_scale + ps.distance;
 
-				e->prev_point = p;
-				e->distance = distance;
-				e->last_pass = pass; // Mark as used
-				open_list.add(&e->list);
-			}
-		}
+			if (es.open_pass == pass && es.distance <= distance)
+				continue; // Already reached in a cheaper way
 
-		open_list.remove(least_cost_point);
-	}
+			es.prev_point = p;
+			es.distance = distance;
+			es.open_pass = pass;
 
-	// Clear the openf list
-	while (open_list.first()) {
-		open_list.remove(open_list.first());
+			OpenEntry entry;
+			entry.f_score = distance + _estimate_cost(e->id, end_point->id);
+			entry.point = e;
+			_push_open_entry(r_state, open_count, entry);
+		}
 	}
 
 	return found_route;
@@ -341,8 +365,6 @@ PoolVector<Vector3> AStar::get_point_path(int p_from_id, int p_to_id) {
 	ERR_FAIL_COND_V(!points.has(p_from_id), PoolVector<Vector3>());
 	ERR_FAIL_COND_V(!points.has(p_to_id), PoolVector<Vector3>());
 
-	pass++;
-
 	Point *a = points[p_from_id];
 	Point *b = points[p_to_id];
 
@@ -355,17 +377,19 @@ PoolVector<Vector3> AStar::get_point_path(int p_from_id, int p_to_id) {
 	Point *begin_point = a;
 	Point *end_point = b;
 
-	bool found_route = _solve(begin_point, end_point);
+	bool found_route = _solve(begin_point, end_point, search);
 
 	if (!found_route)
 		return PoolVector<Vector3>();
 
+	const PointState *states = search.points.ptr();
+
 	// Midpoints
 	Point *p = end_point;
 	int pc = 1; // Begin point
 	while (p != begin_point) {
 		pc++;
-		p = p->prev_point;
+		p = states[p->index].prev_point;
 	}
 
 	PoolVector<Vector3> path;
@@ -378,7 +402,7 @@ PoolVector<Vector3> AStar::get_point_path(int p_from_id, int p_to_id) {
 		int idx = pc - 1;
 		while (p2 != begin_point) {
 			w[idx--] = p2->pos;
-			p2 = p2->prev_point;
+			p2 = states[p2->index].prev_point;
 		}
 
 		w[0] = p2->pos; // Assign first
@@ -387,15 +411,15 @@ PoolVector<Vector3> AStar::get_point_path(int p_from_id, int p_to_id) {
 	return path;
 }
 
-PoolVector<int> AStar::get_id_path(int p_from_id, int p_to_id) {
-
-	ERR_FAIL_COND_V(!points.has(p_from_id), PoolVector<int>());
-	ERR_FAIL_COND_V(!points.has(p_to_id), PoolVector<int>());
+PoolVector<int> AStar::_get_id_path(int p_from_id, int p_to_id, SearchState &r_state) {
 
-	pass++;
+	const Map<int, Point *>::Element *A = points.find(p_from_id);
+	const Map<int, Point *>::Element *B = points.find(p_to_id);
+	ERR_FAIL_COND_V(!A, PoolVector<int>());
+	ERR_FAIL_COND_V(!B, PoolVector<int>());
 
-	Point *a = points[p_from_id];
-	Point *b = points[p_to_id];
+	Point *a = A->get();
+	Point *b = B->get();
 
 	if (a == b) {
 		PoolVector<int> ret;
@@ -406,17 +430,19 @@ PoolVector<int> AStar::get_id_path(int p_from_id, int p_to_id) {
 	Point *begin_point = a;
 	Point *end_point = b;
 
-	bool found_route = _solve(begin_point, end_point);
+	bool found_route = _solve(begin_point, end_point, r_state);
 
 	if (!found_route)
 		return PoolVector<int>();
 
+	const PointState *states = r_state.points.ptr();
+
 	// Midpoints
 	Point *p = end_point;
 	int pc = 1; // Begin point
 	while (p != begin_point) {
 		pc++;
-		p = p->prev_point;
+		p = states[p->index].prev_point;
 	}
 
 	PoolVector<int> path;
@@ -429,7 +455,7 @@ PoolVector<int> AStar::get_id_path(int p_from_id, int p_to_id) {
 		int idx = pc - 1;
 		while (p != begin_point) {
 			w[idx--] = p->id;
-			p = p->prev_point;
+			p = states[p->index].prev_point;
 		}
 
 		w[0] = p->id; // Assign first
@@ -438,6 +464,63 @@ PoolVector<int> AStar::get_id_path(int p_from_id, int p_to_id) {
 	return path;
 }
 
+PoolVector<int> AStar::get_id_path(int p_from_id, int p_to_id) {
+
+	return _get_id_path(p_from_id, p_to_id, search);
+}
+
+void AStar::_solve_path_batch(uint32_t p_chunk, PathBatch *p_batch) {
+
+	// Each chunk owns its search state, so its queries do not need any reset between them
+	SearchState state;
+
+	for (uint32_t i = p_chunk; i < p_batch->path_count; i += p_batch->chunk_count) {
+		p_batch->paths[i] = _get_id_path(p_batch->from_ids[i], p_batch->to_ids[i], state);
+	}
+}
+
+Array AStar::get_id_paths_batch(const PoolVector<int> &p_from_ids, const PoolVector<int> &p_to_ids) {
+
+	ERR_FAIL_COND_V(p_from_ids.size() != p_to_ids.size(), Array());
+
+	int count = p_from_ids.size();
+
+	Vector<PoolVector<int> > paths;
+	paths.resize(count);
+
+	PoolVector<int>::Read from_ids = p_from_ids.read();
+	PoolVector<int>::Read to_ids = p_to_ids.read();
+
+	PathBatch batch;
+	batch.from_ids = from_ids.ptr();
+	batch.to_ids = to_ids.ptr();
+	batch.paths = paths.ptrw();
+	batch.path_count = count;
+	batch.chunk_count = 1;
+
+	// Costs computed by a script can only be evaluated on the calling thread
+	ScriptInstance *si = get_script_instance();
+	bool threaded = !si || (!si->has_method(SceneStringNames::get_singleton()->_estimate_cost) && !si->has_method(SceneStringNames::get_singleton()->_compute_cost));
+
+	if (threaded && count > 1) {
+		if (!batch_pool.is_initialized()) {
+			batch_pool.init();
+		}
+		batch.chunk_count = MIN(count, batch_pool.get_thread_count() + 1);
+		batch_pool.do_work(batch.chunk_count, this, &AStar::_solve_path_batch, &batch);
+	} else {
+		_solve_path_batch(0, &batch);
+	}
+
+	Array ret;
+	ret.resize(count);
+	for (int i = 0; i < count; i++) {
+		ret[i] = paths[i];
+	}
+
+	return ret;
+}
+
 void AStar::_bind_methods() {
 
 	ClassDB::bind_method(D_METHOD("get_available_point_id"), &AStar::get_available_point_id);
@@ -463,18 +546,16 @@ void AStar::_bind_methods() {
 
 	ClassDB::bind_method(D_METHOD("get_point_path", "from_id", "to_id"), &AStar::get_point_path);
 	ClassDB::bind_method(D_METHOD("get_id_path", "from_id", "to_id"), &AStar::get_id_path);
+	ClassDB::bind_method(D_METHOD("get_id_paths_batch", "from_ids", "to_ids"), &AStar::get_id_paths_batch);
 
 	BIND_VMETHOD(MethodInfo(Variant::REAL, "_estimate_cost", PropertyInfo(Variant::INT, "from_id"), PropertyInfo(Variant::INT, "to_id")));
 	BIND_VMETHOD(MethodInfo(Variant::REAL, "_compute_cost", PropertyInfo(Variant::INT, "from_id"), PropertyInfo(Variant::INT, "to_id")));
 }
 
 AStar::AStar() {
-
-	pass = 1;
 }
 
 AStar::~AStar() {
 
-	pass = 1;
 	clear();
 }
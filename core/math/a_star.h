@@ -31,8 +31,8 @@
 #ifndef ASTAR_H
 #define ASTAR_H
 
+#include "core/os/thread_work_pool.h"
 #include "core/reference.h"
-#include "core/self_list.h"
 
 /**
 	A* pathfinding algorithm
@@ -44,28 +44,18 @@ class AStar : public Reference {
 
 	GDCLASS(AStar, Reference)
 
-	uint64_t pass;
-
 	struct Point {
 
-		SelfList<Point> list;
-
 		int id;
+		int index; // position in point_list, addresses the search state of a query
 		Vector3 pos;
 		real_t weight_scale;
-		uint64_t last_pass;
 
-		Set<Point *> neighbours;
-
-		// Used for pathfinding
-		Point *prev_point;
-		real_t distance;
-
-		Point() :
-				list(this) {}
+		Vector<Point *> neighbours;
 	};
 
 	Map<int, Point *> points;
+	Vector<Point *> point_list;
 
 	struct Segment {
 		union {
@@ -93,7 +83,60 @@ class AStar : public Reference {
 
 	Set<Segment> segments;
 
-	bool _solve(Point *begin_point, Point *end_point);
+	// Pathfinding data is kept apart from the points, so several queries can run at once.
+	// Pass counters tell which entries belong to the current query, nothing is reset between them.
+	struct PointState {
+
+		Point *prev_point;
+		real_t distance;
+		uint64_t open_pass;
+		uint64_t closed_pass;
+
+		PointState() {
+			prev_point = NULL;
+			distance = 0;
+			open_pass = 0;
+			closed_pass = 0;
+		}
+	};
+
+	struct OpenEntry {
+
+		real_t f_score;
+		Point *point;
+	};
+
+	struct OpenEntryComparator {
+
+		_FORCE_INLINE_ bool operator()(const OpenEntry &a, const OpenEntry &b) const { return a.f_score > b.f_score; }
+	};
+
+	struct SearchState {
+
+		uint64_t pass;
+		Vector<PointState> points;
+		Vector<OpenEntry> open_list;
+
+		SearchState() { pass = 1; }
+	};
+
+	SearchState search;
+
+	static void _push_open_entry(SearchState &r_state, int &r_open_count, const OpenEntry &p_entry);
+	bool _solve(Point *begin_point, Point *end_point, SearchState &r_state);
+	PoolVector<int> _get_id_path(int p_from_id, int p_to_id, SearchState &r_state);
+
+	struct PathBatch {
+
+		const int *from_ids;
+		const int *to_ids;
+		PoolVector<int> *paths;
+		uint32_t path_count;
+		uint32_t chunk_count;
+	};
+
+	ThreadWorkPool batch_pool;
+	void _solve_path_batch(uint32_t p_chunk, PathBatch *p_batch);
 
 protected:
 	static void _bind_methods();
@@ -125,6 +168,7 @@ public:
 
 	PoolVector<Vector3> get_point_path(int p_from_id, int p_to_id);
 	PoolVector<int> get_id_path(int p_from_id, int p_to_id);
+	Array get_id_paths_batch(const PoolVector<int> &p_from_ids, const PoolVector<int> &p_to_ids);
 
 	AStar();
 	~AStar();
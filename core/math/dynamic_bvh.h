@@ -0,0 +1,975 @@
+/*************************************************************************/
+/*  dynamic_bvh.h                                                        */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2019 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2019 Godot Engine contributors (cf. AUTHORS.md)    */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#ifndef DYNAMIC_BVH_H
+#define DYNAMIC_BVH_H
+
+#include "core/list.h"
+#include "core/math/aabb.h"
+#include "core/math/octree.h"
+#include "core/vector.h"
+
+/**
+	Dynamic AABB tree, with the same interface (and pairing rules) as Octree.
+
+	Leaves keep a fattened AABB, so elements moving around a little only need their
+	existing pairs rechecked. Pairable and non-pairable elements are kept in separate
+	trees, so moving a non-pairable element only queries the pairable one.
+*/
+
+template <class T, bool use_pairs = false, class AL = DefaultAllocator>
+class DynamicBVH {
+public:
+	typedef void *(*PairCallback)(void *, OctreeElementID, T *, int, OctreeElementID, T *, int);
+	typedef void (*UnpairCallback)(void *, OctreeElementID, T *, int, OctreeElementID, T *, int, void *);
+
+private:
+	enum {
+		TREE_NON_PAIRABLE,
+		TREE_PAIRABLE,
+		TREE_MAX
+	};
+
+	enum {
+		INVALID_NODE = -1,
+		STACK_SIZE = 128 // balanced, so this is way more than the tree height can ever be
+	};
+
+	struct PairData;
+
+	struct Element {
+
+		T *userdata;
+		int subindex;
+		bool pairable;
+		uint32_t pairable_mask;
+		uint32_t pairable_type;
+
+		uint64_t last_pass;
+		OctreeElementID _id;
+
+		AABB aabb;
+		int tree;
+		int node;
+
+		List<PairData *, AL> pair_list;
+
+		Element() {
+			userdata = NULL;
+			subindex = 0;
+			pairable = false;
+			pairable_mask = 0;
+			pairable_type = 0;
+			last_pass = 0;
+			_id = 0;
+			tree = TREE_NON_PAIRABLE;
+			node = INVALID_NODE;
+		}
+	};
+
+	struct PairData {
+
+		bool intersect;
+		Element *A, *B;
+		void *ud;
+		typename List<PairData *, AL>::Element *eA, *eB;
+	};
+
+	struct Node {
+
+		AABB aabb; // fattened for leaves
+		int parent; // next free node when unused
+		int children[2];
+		int height;
+		Element *element;
+
+		_FORCE_INLINE_ bool is_leaf() const { return children[0] == INVALID_NODE; }
+	};
+
+	struct Tree {
+
+		Vector<Node> nodes;
+		int root;
+		int free_node;
+
+		Tree() {
+			root = INVALID_NODE;
+			free_node = INVALID_NODE;
+		}
+	};
+
+	Tree trees[TREE_MAX];
+
+	Vector<Element *> elements; // indexed by id - 1
+	Vector<OctreeElementID> free_ids;
+
+	PairCallback pair_callback;
+	UnpairCallback unpair_callback;
+	void *pair_callback_userdata;
+	void *unpair_callback_userdata;
+
+	uint64_t pass;
+	real_t fat_margin;
+	int element_count;
+	int pair_count;
+
+	static _FORCE_INLINE_ real_t _surface(const AABB &p_aabb) {
+
+		return (p_aabb.size.x * p_aabb.size.y + p_aabb.size.y * p_aabb.size.z + p_aabb.size.z * p_aabb.size.x) * 2.0;
+	}
+
+	_FORCE_INLINE_ Element *_get_element(OctreeElementID p_id) const {
+
+		if (p_id == 0 || p_id > (OctreeElementID)elements.size())
+			return NULL;
+		return elements[p_id - 1];
+	}
+
+	int _alloc_node(Tree &p_tree);
+	void _free_node(Tree &p_tree, int p_node);
+	int _balance(Tree &p_tree, int p_node);
+	void _refit_up(Tree &p_tree, int p_node);
+	void _insert_leaf(Tree &p_tree, int p_leaf);
+	void _remove_leaf(Tree &p_tree, int p_leaf);
+
+	void _insert_element(Element *p_element);
+	void _remove_element(Element *p_element);
+
+	_FORCE_INLINE_ bool _can_pair(const Element *p_A, const Element *p_B) const {
+
+		if (p_A == p_B || (p_A->userdata == p_B->userdata && p_A->userdata))
+			return false;
+
+		if (!p_A->pairable && !p_B->pairable)
+			return false;
+
+		return (p_A->pairable_type & p_B->pairable_mask) || (p_B->pairable_type & p_A->pairable_mask);
+	}
+
+	void _pair_check(PairData *p_pair);
+	void _pair_add(Element *p_A, Element *p_B);
+	void _pair_remove(PairData *p_pair);
+	void _element_update_pairs(Element *p_element);
+	void _element_clear_pairs(Element *p_element);
+
+	_FORCE_INLINE_ void _element_check_pairs(Element *p_element) {
+
+		for (typename List<PairData *, AL>::Element *E = p_element->pair_list.front(); E; E = E->next()) {
+			_pair_check(E->get());
+		}
+	}
+
+	struct _CullConvexTest {
+		const Plane *planes;
+		int plane_count;
+		_FORCE_INLINE_ bool test(const AABB &p_aabb) const { return p_aabb.intersects_convex_shape(planes, plane_count); }
+	};
+
+	struct _CullAABBTest {
+		AABB aabb;
+		_FORCE_INLINE_ bool test(const AABB &p_aabb) const { return aabb.intersects_inclusive(p_aabb); }
+	};
+
+	struct _CullSegmentTest {
+		Vector3 from;
+		Vector3 to;
+		_FORCE_INLINE_ bool test(const AABB &p_aabb) const { return p_aabb.intersects_segment(from, to); }
+	};
+
+	struct _CullPointTest {
+		Vector3 point;
+		_FORCE_INLINE_ bool test(const AABB &p_aabb) const { return p_aabb.has_point(point); }
+	};
+
+	template <class C>
+	int _cull(const C &p_test, T **p_result_array, int p_result_max, int *p_subindex_array, uint32_t p_mask) const;
+
+#ifdef DEBUG_ENABLED
+	static bool _is_aabb_valid(const AABB &p_aabb) {
+
+		return !(p_aabb.position.x > OCTREE_SIZE_LIMIT || p_aabb.position.x < -OCTREE_SIZE_LIMIT ||
+				 p_aabb.position.y > OCTREE_SIZE_LIMIT || p_aabb.position.y < -OCTREE_SIZE_LIMIT ||
+				 p_aabb.position.z > OCTREE_SIZE_LIMIT || p_aabb.position.z < -OCTREE_SIZE_LIMIT ||
+				 p_aabb.size.x > OCTREE_SIZE_LIMIT || p_aabb.size.x < 0.0 ||
+				 p_aabb.size.y > OCTREE_SIZE_LIMIT || p_aabb.size.y < 0.0 ||
+				 p_aabb.size.z > OCTREE_SIZE_LIMIT || p_aabb.size.z < 0.0 ||
+				 Math::is_nan(p_aabb.size.x) || Math::is_nan(p_aabb.size.y) || Math::is_nan(p_aabb.size.z));
+	}
+#endif
+
+public:
+	OctreeElementID create(T *p_userdata, const AABB &p_aabb = AABB(), int p_subindex = 0, bool p_pairable = false, uint32_t p_pairable_type = 0, uint32_t pairable_mask = 1);
+	void move(OctreeElementID p_id, const AABB &p_aabb);
+	void set_pairable(OctreeElementID p_id, bool p_pairable = false, uint32_t p_pairable_type = 0, uint32_t pairable_mask = 1);
+	void erase(OctreeElementID p_id);
+
+	bool is_pairable(OctreeElementID p_id) const;
+	T *get(OctreeElementID p_id) const;
+	int get_subindex(OctreeElementID p_id) const;
+
+	int cull_convex(const Vector<Plane> &p_convex, T **p_result_array, int p_result_max, uint32_t p_mask = 0xFFFFFFFF);
+	int cull_convex(const Plane *p_planes, int p_plane_count, T **p_result_array, int p_result_max, uint32_t p_mask = 0xFFFFFFFF);
+	int cull_aabb(const AABB &p_aabb, T **p_result_array, int p_result_max, int *p_subindex_array = NULL, uint32_t p_mask = 0xFFFFFFFF);
+	int cull_segment(const Vector3 &p_from, const Vector3 &p_to, T **p_result_array, int p_result_max, int *p_subindex_array = NULL, uint32_t p_mask = 0xFFFFFFFF);
+
+	int cull_point(const Vector3 &p_point, T **p_result_array, int p_result_max, int *p_subindex_array = NULL, uint32_t p_mask = 0xFFFFFFFF);
+
+	void set_pair_callback(PairCallback p_callback, void *p_userdata);
+	void set_unpair_callback(UnpairCallback p_callback, void *p_userdata);
+
+	void set_fat_margin(real_t p_margin) { fat_margin = p_margin; }
+	real_t get_fat_margin() const { return fat_margin; }
+
+	int get_node_count() const { return trees[TREE_NON_PAIRABLE].nodes.size() + trees[TREE_PAIRABLE].nodes.size(); }
+	int get_elem_count() const { return element_count; }
+	int get_pair_count() const { return pair_count; }
+
+	DynamicBVH(real_t p_fat_margin = 0.1);
+	~DynamicBVH();
+};
+
+/* TREE */
+
+template <class T, bool use_pairs, class AL>
+int DynamicBVH<T, use_pairs, AL>::_alloc_node(Tree &p_tree) {
+
+	int idx;
+	if (p_tree.free_node != INVALID_NODE) {
+		idx = p_tree.free_node;
+		p_tree.free_node = p_tree.nodes[idx].parent;
+	} else {
+		idx = p_tree.nodes.size();
+		p_tree.nodes.resize(idx + 1);
+	}
+
+	Node &n = p_tree.nodes.write[idx];
+	n.parent = INVALID_NODE;
+	n.children[0] = INVALID_NODE;
+	n.children[1] = INVALID_NODE;
+	n.height = 0;
+	n.element = NULL;
+	return idx;
+}
+
+template <class T, bool use_pairs, class AL>
+void DynamicBVH<T, use_pairs, AL>::_free_node(Tree &p_tree, int p_node) {
+
+	Node &n = p_tree.nodes.write[p_node];
+	n.parent = p_tree.free_node;
+	n.height = -1;
+	n.element = NULL;
+	p_tree.free_node = p_node;
+}
+
+//AVL style rotation, returns the node now at p_node's place
+template <class T, bool use_pairs, class AL>
+int DynamicBVH<T, use_pairs, AL>::_balance(Tree &p_tree, int p_node) {
+
+	Node *nodes = p_tree.nodes.ptrw();
+	Node &A = nodes[p_node];
+
+	if (A.is_leaf() || A.height < 2)
+		return p_node;
+
+	int iB = A.children[0];
+	int iC = A.children[1];
+	Node &B = nodes[iB];
+	Node &C = nodes[iC];
+
+	int balance = C.height - B.height;
+
+	if (balance > 1) {
+		//rotate C up
+		int iF = C.children[0];
+		int iG = C.children[1];
+		Node &F = nodes[iF];
+		Node &G = nodes[iG];
+
+		C.children[0] = p_node;
+		C.parent = A.parent;
+		A.parent = iC;
+
+		if (C.parent != INVALID_NODE) {
+			Node &P = nodes[C.parent];
+			if (P.children[0] == p_node)
+				P.children[0] = iC;
+			else
+				P.children[1] = iC;
+		} else {
+			p_tree.root = iC;
+		}
+
+		if (F.height > G.height) {
+			C.children[1] = iF;
+			A.children[1] = iG;
+			G.parent = p_node;
+			A.aabb = B.aabb.merge(G.aabb);
+			C.aabb = A.aabb.merge(F.aabb);
+			A.height = 1 + MAX(B.height, G.height);
+			C.height = 1 + MAX(A.height, F.height);
+		} else {
+			C.children[1] = iG;
+			A.children[1] = iF;
+			F.parent = p_node;
+			A.aabb = B.aabb.merge(F.aabb);
+			C.aabb = A.aabb.merge(G.aabb);
+			A.height = 1 + MAX(B.height, F.height);
+			C.height = 1 + MAX(A.height, G.height);
+		}
+
+		return iC;
+	}
+
+	if (balance < -1) {
+		//rotate B up
+		int iD = B.children[0];
+		int iE = B.children[1];
+		Node &D = nodes[iD];
+		Node &E = nodes[iE];
+
+		B.children[0] = p_node;
+		B.parent = A.parent;
+		A.parent = iB;
+
+		if (B.parent != INVALID_NODE) {
+			Node &P = nodes[B.parent];
+			if (P.children[0] == p_node)
+				P.children[0] = iB;
+			else
+				P.children[1] = iB;
+		} else {
+			p_tree.root = iB;
+		}
+
+		if (D.height > E.height) {
+			B.children[1] = iD;
+			A.children[0] = iE;
+			E.parent = p_node;
+			A.aabb = C.aabb.merge(E.aabb);
+			B.aabb = A.aabb.merge(D.aabb);
+			A.height = 1 + MAX(C.height, E.height);
+			B.height = 1 + MAX(A.height, D.height);
+		} else {
+			B.children[1] = iE;
+			A.children[0] = iD;
+			D.parent = p_node;
+			A.aabb = C.aabb.merge(D.aabb);
+			B.aabb = A.aabb.merge(E.aabb);
+			A.height = 1 + MAX(C.height, D.height);
+			B.height = 1 + MAX(A.height, E.height);
+		}
+
+		return iB;
+	}
+
+	return p_node;
+}
+
+template <class T, bool use_pairs, class AL>
+void DynamicBVH<T, use_pairs, AL>::_refit_up(Tree &p_tree, int p_node) {
+
+	while (p_node != INVALID_NODE) {
+
+		p_node = _balance(p_tree, p_node);
+
+		Node *nodes = p_tree.nodes.ptrw();
+		Node &n = nodes[p_node];
+		const Node &c0 = nodes[n.children[0]];
+		const Node &c1 = nodes[n.children[1]];
+
+		n.height = 1 + MAX(c0.height, c1.height);
+		n.aabb = c0.aabb.merge(c1.aabb);
+
+		p_node = n.parent;
+	}
+}
+
+template <class T, bool use_pairs, class AL>
+void DynamicBVH<T, use_pairs, AL>::_insert_leaf(Tree &p_tree, int p_leaf) {
+
+	if (p_tree.root == INVALID_NODE) {
+		p_tree.root = p_leaf;
+		p_tree.nodes.write[p_leaf].parent = INVALID_NODE;
+		return;
+	}
+
+	//allocate first, as it may move the node array
+	int new_parent = _alloc_node(p_tree);
+
+	Node *nodes = p_tree.nodes.ptrw();
+	const AABB leaf_aabb = nodes[p_leaf].aabb;
+
+	//find the best sibling, by surface area heuristic
+	int sibling = p_tree.root;
+	while (!nodes[sibling].is_leaf()) {
+
+		const Node &n = nodes[sibling];
+		real_t area = _surface(n.aabb);
+		real_t combined_area = _surface(n.aabb.merge(leaf_aabb));
+
+		real_t cost = 2.0 * combined_area;
+		real_t inheritance_cost = 2.0 * (combined_area - area);
+
+		real_t child_cost[2];
+		for (int i = 0; i < 2; i++) {
+			const Node &c = nodes[n.children[i]];
+			real_t merged_area = _surface(c.aabb.merge(leaf_aabb));
+			child_cost[i] = (c.is_leaf() ? merged_area : merged_area - _surface(c.aabb)) + inheritance_cost;
+		}
+
+		if (cost < child_cost[0] && cost < child_cost[1])
+			break;
+
+		sibling = child_cost[0] < child_cost[1] ? n.children[0] : n.children[1];
+	}
+
+	int old_parent = nodes[sibling].parent;
+
+	Node &np = nodes[new_parent];
+	np.parent = old_parent;
+	np.aabb = nodes[sibling].aabb.merge(leaf_aabb);
+	np.height = nodes[sibling].height + 1;
+	np.children[0] = sibling;
+	np.children[1] = p_leaf;
+
+	nodes[sibling].parent = new_parent;
+	nodes[p_leaf].parent = new_parent;
+
+	if (old_parent != INVALID_NODE) {
+		Node &op = nodes[old_parent];
+		if (op.children[0] == sibling)
+			op.children[0] = new_parent;
+		else
+			op.children[1] = new_parent;
+	} else {
+		p_tree.root = new_parent;
+	}
+
+	_refit_up(p_tree, new_parent);
+}
+
+template <class T, bool use_pairs, class AL>
+void DynamicBVH<T, use_pairs, AL>::_remove_leaf(Tree &p_tree, int p_leaf) {
+
+	if (p_leaf == p_tree.root) {
+		p_tree.root = INVALID_NODE;
+		return;
+	}
+
+	Node *nodes = p_tree.nodes.ptrw();
+
+	int parent = nodes[p_leaf].parent;
+	int grand_parent = nodes[parent].parent;
+	int sibling = nodes[parent].children[0] == p_leaf ? nodes[parent].children[1] : nodes[parent].children[0];
+
+	if (grand_parent != INVALID_NODE) {
+		Node &gp = nodes[grand_parent];
+		if (gp.children[0] == parent)
+			gp.children[0] = sibling;
+		else
+			gp.children[1] = sibling;
+		nodes[sibling].parent = grand_parent;
+		_free_node(p_tree, parent);
+
+		_refit_up(p_tree, grand_parent);
+	} else {
+		p_tree.root = sibling;
+		nodes[sibling].parent = INVALID_NODE;
+		_free_node(p_tree, parent);
+	}
+
+	nodes = p_tree.nodes.ptrw();
+	nodes[p_leaf].parent = INVALID_NODE;
+}
+
+template <class T, bool use_pairs, class AL>
+void DynamicBVH<T, use_pairs, AL>::_insert_element(Element *p_element) {
+
+	p_element->tree = (use_pairs && p_element->pairable) ? TREE_PAIRABLE : TREE_NON_PAIRABLE;
+	Tree &tree = trees[p_element->tree];
+
+	int leaf = _alloc_node(tree);
+	Node &n = tree.nodes.write[leaf];
+	n.aabb = p_element->aabb.grow(fat_margin);
+	n.element = p_element;
+	p_element->node = leaf;
+
+	_insert_leaf(tree, leaf);
+}
+
+template <class T, bool use_pairs, class AL>
+void DynamicBVH<T, use_pairs, AL>::_remove_element(Element *p_element) {
+
+	Tree &tree = trees[p_element->tree];
+	_remove_leaf(tree, p_element->node);
+	_free_node(tree, p_element->node);
+	p_element->node = INVALID_NODE;
+}
+
+/* PAIRS */
+
+template <class T, bool use_pairs, class AL>
+void DynamicBVH<T, use_pairs, AL>::_pair_check(PairData *p_pair) {
+
+	bool intersect = p_pair->A->aabb.intersects_inclusive(p_pair->B->aabb);
+
+	if (intersect != p_pair->intersect) {
+
+		if (intersect) {
+
+			if (pair_callback) {
+				p_pair->ud = pair_callback(pair_callback_userdata, p_pair->A->_id, p_pair->A->userdata, p_pair->A->subindex, p_pair->B->_id, p_pair->B->userdata, p_pair->B->subindex);
+			}
+			pair_count++;
+		} else {
+
+			if (unpair_callback) {
+				unpair_callback(unpair_callback_userdata, p_pair->A->_id, p_pair->A->userdata, p_pair->A->subindex, p_pair->B->_id, p_pair->B->userdata, p_pair->B->subindex, p_pair->ud);
+			}
+			pair_count--;
+		}
+
+		p_pair->intersect = intersect;
+	}
+}
+
+template <class T, bool use_pairs, class AL>
+void DynamicBVH<T, use_pairs, AL>::_pair_add(Element *p_A, Element *p_B) {
+
+	PairData *pair = memnew_allocator(PairData, AL);
+	pair->intersect = false;
+	pair->A = p_A;
+	pair->B = p_B;
+	pair->ud = NULL;
+	pair->eA = p_A->pair_list.push_back(pair);
+	pair->eB = p_B->pair_list.push_back(pair);
+}
+
+template <class T, bool use_pairs, class AL>
+void DynamicBVH<T, use_pairs, AL>::_pair_remove(PairData *p_pair) {
+
+	if (p_pair->intersect) {
+		if (unpair_callback) {
+			unpair_callback(unpair_callback_userdata, p_pair->A->_id, p_pair->A->userdata, p_pair->A->subindex, p_pair->B->_id, p_pair->B->userdata, p_pair->B->subindex, p_pair->ud);
+		}
+		pair_count--;
+	}
+
+	p_pair->A->pair_list.erase(p_pair->eA);
+	p_pair->B->pair_list.erase(p_pair->eB);
+	memdelete_allocator<PairData, AL>(p_pair);
+}
+
+//pairs exist between compatible elements whose fattened AABBs overlap, so this only runs when the leaf changes
+template <class T, bool use_pairs, class AL>
+void DynamicBVH<T, use_pairs, AL>::_element_update_pairs(Element *p_element) {
+
+	uint64_t paired_pass = ++pass;
+	for (typename List<PairData *, AL>::Element *E = p_element->pair_list.front(); E; E = E->next()) {
+		PairData *pair = E->get();
+		(pair->A == p_element ? pair->B : pair->A)->last_pass = paired_pass;
+	}
+
+	uint64_t seen_pass = ++pass;
+	const AABB fat_aabb = trees[p_element->tree].nodes[p_element->node].aabb;
+
+	for (int t = 0; t < TREE_MAX; t++) {
+
+		if (t == TREE_NON_PAIRABLE && !p_element->pairable)
+			continue; // nothing to pair with there
+
+		const Tree &tree = trees[t];
+		if (tree.root == INVALID_NODE)
+			continue;
+
+		const Node *nodes = tree.nodes.ptr();
+		int stack[STACK_SIZE];
+		int stack_size = 0;
+		stack[stack_size++] = tree.root;
+
+		while (stack_size) {
+
+			const Node &n = nodes[stack[--stack_size]];
+			if (!n.aabb.intersects_inclusive(fat_aabb))
+				continue;
+
+			if (!n.is_leaf()) {
+				ERR_CONTINUE(stack_size + 2 > STACK_SIZE);
+				stack[stack_size++] = n.children[0];
+				stack[stack_size++] = n.children[1];
+				continue;
+			}
+
+			Element *e = n.element;
+			if (e->last_pass == seen_pass) {
+				continue;
+			}
+
+			if (e->last_pass == paired_pass) {
+				e->last_pass = seen_pass; //still overlapping
+			} else if (_can_pair(p_element, e)) {
+				e->last_pass = seen_pass;
+				_pair_add(p_element, e);
+			}
+		}
+	}
+
+	//drop pairs that no longer overlap, check the rest
+	typename List<PairData *, AL>::Element *E = p_element->pair_list.front();
+	while (E) {
+		typename List<PairData *, AL>::Element *N = E->next();
+		PairData *pair = E->get();
+
+		if ((pair->A == p_element ? pair->B : pair->A)->last_pass != seen_pass) {
+			_pair_remove(pair);
+		} else {
+			_pair_check(pair);
+		}
+
+		E = N;
+	}
+}
+
+template <class T, bool use_pairs, class AL>
+void DynamicBVH<T, use_pairs, AL>::_element_clear_pairs(Element *p_element) {
+
+	while (p_element->pair_list.front()) {
+		_pair_remove(p_element->pair_list.front()->get());
+	}
+}
+
+/* CULLING */
+
+template <class T, bool use_pairs, class AL>
+template <class C>
+int DynamicBVH<T, use_pairs, AL>::_cull(const C &p_test, T **p_result_array, int p_result_max, int *p_subindex_array, uint32_t p_mask) const {
+
+	int result_count = 0;
+
+	for (int t = 0; t < TREE_MAX; t++) {
+
+		const Tree &tree = trees[t];
+		if (tree.root == INVALID_NODE)
+			continue;
+
+		const Node *nodes = tree.nodes.ptr();
+		int stack[STACK_SIZE];
+		int stack_size = 0;
+		stack[stack_size++] = tree.root;
+
+		while (stack_size) {
+
+			const Node &n = nodes[stack[--stack_size]];
+
+			if (!n.is_leaf()) {
+				if (p_test.test(n.aabb)) {
+					ERR_CONTINUE(stack_size + 2 > STACK_SIZE);
+					stack[stack_size++] = n.children[1];
+					stack[stack_size++] = n.children[0];
+				}
+				continue;
+			}
+
+			const Element *e = n.element;
+			if (use_pairs && !(e->pairable_type & p_mask))
+				continue;
+
+			if (!p_test.test(e->aabb))
+				continue;
+
+			if (result_count == p_result_max)
+				return result_count; // pointless to continue
+
+			p_result_array[result_count] = e->userdata;
+			if (p_subindex_array)
+				p_subindex_array[result_count] = e->subindex;
+			result_count++;
+		}
+	}
+
+	return result_count;
+}
+
+/* API */
+
+template <class T, bool use_pairs, class AL>
+OctreeElementID DynamicBVH<T, use_pairs, AL>::create(T *p_userdata, const AABB &p_aabb, int p_subindex, bool p_pairable, uint32_t p_pairable_type, uint32_t p_pairable_mask) {
+
+#ifdef DEBUG_ENABLED
+	ERR_FAIL_COND_V(!_is_aabb_valid(p_aabb), 0);
+#endif
+
+	OctreeElementID id;
+	if (free_ids.size()) {
+		id = free_ids[free_ids.size() - 1];
+		free_ids.resize(free_ids.size() - 1);
+	} else {
+		elements.push_back(NULL);
+		id = elements.size();
+	}
+
+	Element *e = memnew_allocator(Element, AL);
+	elements.write[id - 1] = e;
+	element_count++;
+
+	e->aabb = p_aabb;
+	e->userdata = p_userdata;
+	e->subindex = p_subindex;
+	e->pairable = p_pairable;
+	e->pairable_type = p_pairable_type;
+	e->pairable_mask = p_pairable_mask;
+	e->_id = id;
+
+	if (!e->aabb.has_no_surface()) {
+		_insert_element(e);
+		if (use_pairs)
+			_element_update_pairs(e);
+	}
+
+	return id;
+}
+
+template <class T, bool use_pairs, class AL>
+void DynamicBVH<T, use_pairs, AL>::move(OctreeElementID p_id, const AABB &p_aabb) {
+
+#ifdef DEBUG_ENABLED
+	ERR_FAIL_COND(!_is_aabb_valid(p_aabb));
+#endif
+	Element *e = _get_element(p_id);
+	ERR_FAIL_COND(!e);
+
+	bool old_has_surf = !e->aabb.has_no_surface();
+	bool new_has_surf = !p_aabb.has_no_surface();
+
+	if (old_has_surf != new_has_surf) {
+
+		if (old_has_surf) {
+			if (use_pairs)
+				_element_clear_pairs(e);
+			_remove_element(e);
+			e->aabb = AABB();
+		} else {
+			e->aabb = p_aabb;
+			_insert_element(e);
+			if (use_pairs)
+				_element_update_pairs(e);
+		}
+
+		return;
+	}
+
+	if (!old_has_surf) // doing nothing
+		return;
+
+	e->aabb = p_aabb;
+
+	Tree &tree = trees[e->tree];
+
+	// still inside the fattened leaf, the set of pairs can't change
+	if (tree.nodes[e->node].aabb.encloses(p_aabb)) {
+
+		if (use_pairs)
+			_element_check_pairs(e);
+
+		return;
+	}
+
+	_remove_leaf(tree, e->node);
+	tree.nodes.write[e->node].aabb = p_aabb.grow(fat_margin);
+	_insert_leaf(tree, e->node);
+
+	if (use_pairs)
+		_element_update_pairs(e);
+}
+
+template <class T, bool use_pairs, class AL>
+void DynamicBVH<T, use_pairs, AL>::set_pairable(OctreeElementID p_id, bool p_pairable, uint32_t p_pairable_type, uint32_t p_pairable_mask) {
+
+	Element *e = _get_element(p_id);
+	ERR_FAIL_COND(!e);
+
+	if (p_pairable == e->pairable && e->pairable_type == p_pairable_type && e->pairable_mask == p_pairable_mask)
+		return; // no changes, return
+
+	bool has_surf = !e->aabb.has_no_surface();
+
+	if (has_surf) {
+		if (use_pairs)
+			_element_clear_pairs(e);
+		_remove_element(e);
+	}
+
+	e->pairable = p_pairable;
+	e->pairable_type = p_pairable_type;
+	e->pairable_mask = p_pairable_mask;
+
+	if (has_surf) {
+		_insert_element(e);
+		if (use_pairs)
+			_element_update_pairs(e);
+	}
+}
+
+template <class T, bool use_pairs, class AL>
+void DynamicBVH<T, use_pairs, AL>::erase(OctreeElementID p_id) {
+
+	Element *e = _get_element(p_id);
+	ERR_FAIL_COND(!e);
+
+	if (!e->aabb.has_no_surface()) {
+		if (use_pairs)
+			_element_clear_pairs(e);
+		_remove_element(e);
+	}
+
+	elements.write[p_id - 1] = NULL;
+	free_ids.push_back(p_id);
+	element_count--;
+
+	memdelete_allocator<Element, AL>(e);
+}
+
+template <class T, bool use_pairs, class AL>
+bool DynamicBVH<T, use_pairs, AL>::is_pairable(OctreeElementID p_id) const {
+
+	const Element *e = _get_element(p_id);
+	ERR_FAIL_COND_V(!e, false);
+	return e->pairable;
+}
+
+template <class T, bool use_pairs, class AL>
+T *DynamicBVH<T, use_pairs, AL>::get(OctreeElementID p_id) const {
+
+	const Element *e = _get_element(p_id);
+	ERR_FAIL_COND_V(!e, NULL);
+	return e->userdata;
+}
+
+template <class T, bool use_pairs, class AL>
+int DynamicBVH<T, use_pairs, AL>::get_subindex(OctreeElementID p_id) const {
+
+	const Element *e = _get_element(p_id);
+	ERR_FAIL_COND_V(!e, -1);
+	return e->subindex;
+}
+
+template <class T, bool use_pairs, class AL>
+int DynamicBVH<T, use_pairs, AL>::cull_convex(const Vector<Plane> &p_convex, T **p_result_array, int p_result_max, uint32_t p_mask) {
+
+	return cull_convex(p_convex.ptr(), p_convex.size(), p_result_array, p_result_max, p_mask);
+}
+
+template <class T, bool use_pairs, class AL>
+int DynamicBVH<T, use_pairs, AL>::cull_convex(const Plane *p_planes, int p_plane_count, T **p_result_array, int p_result_max, uint32_t p_mask) {
+
+	_CullConvexTest test;
+	test.planes = p_planes;
+	test.plane_count = p_plane_count;
+
+	return _cull(test, p_result_array, p_result_max, NULL, p_mask);
+}
+
+template <class T, bool use_pairs, class AL>
+int DynamicBVH<T, use_pairs, AL>::cull_aabb(const AABB &p_aabb, T **p_result_array, int p_result_max, int *p_subindex_array, uint32_t p_mask) {
+
+	_CullAABBTest test;
+	test.aabb = p_aabb;
+
+	return _cull(test, p_result_array, p_result_max, p_subindex_array, p_mask);
+}
+
+template <class T, bool use_pairs, class AL>
+int DynamicBVH<T, use_pairs, AL>::cull_segment(const Vector3 &p_from, const Vector3 &p_to, T **p_result_array, int p_result_max, int *p_subindex_array, uint32_t p_mask) {
+
+	_CullSegmentTest test;
+	test.from = p_from;
+	test.to = p_to;
+
+	return _cull(test, p_result_array, p_result_max, p_subindex_array, p_mask);
+}
+
+template <class T, bool use_pairs, class AL>
+int DynamicBVH<T, use_pairs, AL>::cull_point(const Vector3 &p_point, T **p_result_array, int p_result_max, int *p_subindex_array, uint32_t p_mask) {
+
+	_CullPointTest test;
+	test.point = p_point;
+
+	return _cull(test, p_result_array, p_result_max, p_subindex_array, p_mask);
+}
+
+template <class T, bool use_pairs, class AL>
+void DynamicBVH<T, use_pairs, AL>::set_pair_callback(PairCallback p_callback, void *p_userdata) {
+
+	pair_callback = p_callback;
+	pair_callback_userdata = p_userdata;
+}
+
+template <class T, bool use_pairs, class AL>
+void DynamicBVH<T, use_pairs, AL>::set_unpair_callback(UnpairCallback p_callback, void *p_userdata) {
+
+	unpair_callback = p_callback;
+	unpair_callback_userdata = p_userdata;
+}
+
+template <class T, bool use_pairs, class AL>
+DynamicBVH<T, use_pairs, AL>::DynamicBVH(real_t p_fat_margin) {
+
+	pass = 1;
+	fat_margin = p_fat_margin;
+	element_count = 0;
+	pair_count = 0;
+
+	pair_callback = NULL;
+	unpair_callback = NULL;
+	pair_callback_userdata = NULL;
+	unpair_callback_userdata = NULL;
+}
+
+template <class T, bool use_pairs, class AL>
+DynamicBVH<T, use_pairs, AL>::~DynamicBVH() {
+
+	//owners are expected to erase their elements, this only frees what was left over (without callbacks)
+	for (int i = 0; i < elements.size(); i++) {
+
+		Element *e = elements[i];
+		if (!e)
+			continue;
+
+		while (e->pair_list.front()) {
+			PairData *pair = e->pair_list.front()->get();
+			pair->A->pair_list.erase(pair->eA);
+			pair->B->pair_list.erase(pair->eB);
+			memdelete_allocator<PairData, AL>(pair);
+		}
+		memdelete_allocator<Element, AL>(e);
+	}
+}
+
+#endif // DYNAMIC_BVH_H
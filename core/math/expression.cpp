@@ -1866,6 +1866,21 @@ bool Expression::_compile_expression() {
 	return false;
 }
 
+// Call arguments live on the stack so evaluating calls doesn't allocate.
+void Expression::_init_arguments(Variant *p_args, int p_count) {
+
+	for (int i = 0; i < p_count; i++) {
+		memnew_placement(&p_args[i], Variant);
+	}
+}
+
+void Expression::_free_arguments(Variant *p_args, int p_count) {
+
+	for (int i = 0; i < p_count; i++) {
+		p_args[i].~Variant();
+	}
+}
+
 bool Expression::_execute(const Array &p_inputs, Object *p_instance, Expression::ENode *p_node, Variant &r_ret, String &r_error_str) {
 
 	switch (p_node->type) {
@@ -2001,24 +2016,23 @@ bool Expression::_execute(const Array &p_inputs, Object *p_instance, Expression:
 
 			const Expression::ConstructorNode *constructor = static_cast<const Expression::ConstructorNode *>(p_node);
 
-			Vector<Variant> arr;
-			Vector<const Variant *> argp;
-			arr.resize(constructor->arguments.size());
-			argp.resize(constructor->arguments.size());
-
-			for (int i = 0; i < constructor->arguments.size(); i++) {
+			int argc = constructor->arguments.size();
+			Variant *args = (Variant *)alloca(sizeof(Variant) * (argc + 1));
+			_init_arguments(args, argc);
+			const Variant **argp = (const Variant **)alloca(sizeof(Variant *) * (argc + 1));
 
-				Variant value;
-				bool ret = _execute(p_inputs, p_instance, constructor->arguments[i], value, r_error_str);
+			for (int i = 0; i < argc; i++) {
 
-				if (ret)
+				argp[i] = &args[i];
+				if (_execute(p_inputs, p_instance, constructor->arguments[i], args[i], r_error_str)) {
+					_free_arguments(args, argc);
 					return true;
-				arr.write[i] = value;
-				argp.write[i] = &arr[i];
+				}
 			}
 
 			Variant::CallError ce;
-			r_ret = Variant::construct(constructor->data_type, (const Variant **)argp.ptr(), argp.size(), ce);
+			r_ret = Variant::construct(constructor->data_type, argp, argc, ce);
+			_free_arguments(args, argc);
 
 			if (ce.error != Variant::CallError::CALL_OK) {
 				r_error_str = vformat(RTR("Invalid arguments to construct '%s'"), Variant::get_type_name(constructor->data_type));
@@ -2030,23 +2044,23 @@ bool Expression::_execute(const Array &p_inputs, Object *p_instance, Expression:
 
 			const Expression::BuiltinFuncNode *bifunc = static_cast<const Expression::BuiltinFuncNode *>(p_node);
 
-			Vector<Variant> arr;
-			Vector<const Variant *> argp;
-			arr.resize(bifunc->arguments.size());
-			argp.resize(bifunc->arguments.size());
+			int argc = bifunc->arguments.size();
+			Variant *args = (Variant *)alloca(sizeof(Variant) * (argc + 1));
+			_init_arguments(args, argc);
+			const Variant **argp = (const Variant **)alloca(sizeof(Variant *) * (argc + 1));
 
-			for (int i = 0; i < bifunc->arguments.size(); i++) {
+			for (int i = 0; i < argc; i++) {
 
-				Variant value;
-				bool ret = _execute(p_inputs, p_instance, bifunc->arguments[i], value, r_error_str);
-				if (ret)
+				argp[i] = &args[i];
+				if (_execute(p_inputs, p_instance, bifunc->arguments[i], args[i], r_error_str)) {
+					_free_arguments(args, argc);
 					return true;
-				arr.write[i] = value;
-				argp.write[i] = &arr[i];
+				}
 			}
 
 			Variant::CallError ce;
-			exec_func(bifunc->func, (const Variant **)argp.ptr(), &r_ret, ce, r_error_str);
+			exec_func(bifunc->func, argp, &r_ret, ce, r_error_str);
+			_free_arguments(args, argc);
 
 			if (ce.error != Variant::CallError::CALL_OK) {
 				r_error_str = "Builtin Call Failed. " + r_error_str;
@@ -2064,24 +2078,23 @@ bool Expression::_execute(const Array &p_inputs, Object *p_instance, Expression:
 			if (ret)
 				return true;
 
-			Vector<Variant> arr;
-			Vector<const Variant *> argp;
-			arr.resize(call->arguments.size());
-			argp.resize(call->arguments.size());
+			int argc = call->arguments.size();
+			Variant *args = (Variant *)alloca(sizeof(Variant) * (argc + 1));
+			_init_arguments(args, argc);
+			const Variant **argp = (const Variant **)alloca(sizeof(Variant *) * (argc + 1));
 
-			for (int i = 0; i < call->arguments.size(); i++) {
-
-				Variant value;
-				ret = _execute(p_inputs, p_instance, call->arguments[i], value, r_error_str);
+			for (int i = 0; i < argc; i++) {
 
-				if (ret)
+				argp[i] = &args[i];
+				if (_execute(p_inputs, p_instance, call->arguments[i], args[i], r_error_str)) {
+					_free_arguments(args, argc);
 					return true;
-				arr.write[i] = value;
-				argp.write[i] = &arr[i];
+				}
 			}
 
 			Variant::CallError ce;
-			r_ret = base.call(call->method, (const Variant **)argp.ptr(), argp.size(), ce);
+			r_ret = base.call(call->method, argp, argc, ce);
+			_free_arguments(args, argc);
 
 			if (ce.error != Variant::CallError::CALL_OK) {
 				r_error_str = vformat(RTR("On call to '%s':"), String(call->method));
@@ -2093,8 +2106,167 @@ bool Expression::_execute(const Array &p_inputs, Object *p_instance, Expression:
 	return false;
 }
 
+Expression::ENode *Expression::_fold_constants(ENode *p_node) {
+
+	switch (p_node->type) {
+		case ENode::TYPE_OPERATOR: {
+
+			OperatorNode *op = static_cast<OperatorNode *>(p_node);
+			op->nodes[0] = _fold_constants(op->nodes[0]);
+			if (op->nodes[1]) {
+				op->nodes[1] = _fold_constants(op->nodes[1]);
+			}
+
+			if (op->nodes[0]->type != ENode::TYPE_CONSTANT || (op->nodes[1] && op->nodes[1]->type != ENode::TYPE_CONSTANT)) {
+				return p_node;
+			}
+
+			Variant b;
+			if (op->nodes[1]) {
+				b = static_cast<ConstantNode *>(op->nodes[1])->value;
+			}
+
+			Variant r;
+			bool valid = true;
+			Variant::evaluate(op->op, static_cast<ConstantNode *>(op->nodes[0])->value, b, r, valid);
+			if (!valid) {
+				return p_node; // Leave it so execute() reports the error.
+			}
+			return _make_constant(p_node, r);
+		} break;
+		case ENode::TYPE_INDEX: {
+
+			IndexNode *index = static_cast<IndexNode *>(p_node);
+			index->base = _fold_constants(index->base);
+			index->index = _fold_constants(index->index);
+
+			if (index->base->type != ENode::TYPE_CONSTANT || index->index->type != ENode::TYPE_CONSTANT) {
+				return p_node;
+			}
+
+			bool valid;
+			Variant r = static_cast<ConstantNode *>(index->base)->value.get(static_cast<ConstantNode *>(index->index)->value, &valid);
+			if (!valid) {
+				return p_node;
+			}
+			return _make_constant(p_node, r);
+		} break;
+		case ENode::TYPE_NAMED_INDEX: {
+
+			NamedIndexNode *index = static_cast<NamedIndexNode *>(p_node);
+			index->base = _fold_constants(index->base);
+
+			if (index->base->type != ENode::TYPE_CONSTANT) {
+				return p_node;
+			}
+
+			bool valid;
+			Variant r = static_cast<ConstantNode *>(index->base)->value.get_named(index->name, &valid);
+			if (!valid) {
+				return p_node;
+			}
+			return _make_constant(p_node, r);
+		} break;
+		case ENode::TYPE_ARRAY: {
+
+			ArrayNode *array = static_cast<ArrayNode *>(p_node);
+			for (int i = 0; i < array->array.size(); i++) {
+				array->array.write[i] = _fold_constants(array->array[i]);
+			}
+		} break;
+		case ENode::TYPE_DICTIONARY: {
+
+			DictionaryNode *dictionary = static_cast<DictionaryNode *>(p_node);
+			for (int i = 0; i < dictionary->dict.size(); i++) {
+				dictionary->dict.write[i] = _fold_constants(dictionary->dict[i]);
+			}
+		} break;
+		case ENode::TYPE_CONSTRUCTOR: {
+
+			ConstructorNode *constructor = static_cast<ConstructorNode *>(p_node);
+			int argc = constructor->arguments.size();
+			const Variant **argp = (const Variant **)alloca(sizeof(Variant *) * (argc + 1));
+			bool all_constant = true;
+
+			for (int i = 0; i < argc; i++) {
+				constructor->arguments.write[i] = _fold_constants(constructor->arguments[i]);
+				if (constructor->arguments[i]->type == ENode::TYPE_CONSTANT) {
+					argp[i] = &static_cast<ConstantNode *>(constructor->arguments[i])->value;
+				} else {
+					all_constant = false;
+				}
+			}
+
+			if (!all_constant) {
+				return p_node;
+			}
+
+			Variant::CallError ce;
+			Variant r = Variant::construct(constructor->data_type, argp, argc, ce);
+			if (ce.error != Variant::CallError::CALL_OK) {
+				return p_node;
+			}
+			return _make_constant(p_node, r);
+		} break;
+		case ENode::TYPE_BUILTIN_FUNC: {
+
+			// Builtins are not folded, some are random or have side effects.
+			BuiltinFuncNode *bifunc = static_cast<BuiltinFuncNode *>(p_node);
+			for (int i = 0; i < bifunc->arguments.size(); i++) {
+				bifunc->arguments.write[i] = _fold_constants(bifunc->arguments[i]);
+			}
+		} break;
+		case ENode::TYPE_CALL: {
+
+			// Neither are method calls, they may modify the base.
+			CallNode *call = static_cast<CallNode *>(p_node);
+			call->base = _fold_constants(call->base);
+			for (int i = 0; i < call->arguments.size(); i++) {
+				call->arguments.write[i] = _fold_constants(call->arguments[i]);
+			}
+		} break;
+		default: {
+		}
+	}
+
+	return p_node;
+}
+
+Expression::ENode *Expression::_make_constant(ENode *p_node, const Variant &p_value) {
+
+	switch (p_value.get_type()) {
+		case Variant::OBJECT:
+		case Variant::ARRAY:
+		case Variant::DICTIONARY: {
+			// Shared by reference, every execution must get a new one.
+			return p_node;
+		} break;
+		default: {
+		}
+	}
+
+	ConstantNode *constant = alloc_node<ConstantNode>();
+	constant->value = p_value;
+	return constant;
+}
+
 Error Expression::parse(const String &p_expression, const Vector<String> &p_input_names) {
 
+	if (root && !error_set && p_expression == expression && p_input_names.size() == input_names.size()) {
+		// Same source as last time, keep the parsed tree.
+		bool same_inputs = true;
+		for (int i = 0; i < p_input_names.size(); i++) {
+			if (p_input_names[i] != input_names[i]) {
+				same_inputs = false;
+				break;
+			}
+		}
+		if (same_inputs) {
+			error_str = String();
+			return OK;
+		}
+	}
+
 	if (nodes) {
 		memdelete(nodes);
 		nodes = NULL;
@@ -2118,6 +2290,8 @@ Error Expression::parse(const String &p_expression, const Vector<String> &p_inpu
 		return ERR_INVALID_PARAMETER;
 	}
 
+	root = _fold_constants(root);
+
 	return OK;
 }
 
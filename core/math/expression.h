@@ -338,6 +338,12 @@ private:
 
 	Vector<String> input_names;
 
+	ENode *_fold_constants(ENode *p_node);
+	ENode *_make_constant(ENode *p_node, const Variant &p_value);
+
+	static void _init_arguments(Variant *p_args, int p_count);
+	static void _free_arguments(Variant *p_args, int p_count);
+
 	bool execution_error;
 	bool _execute(const Array &p_inputs, Object *p_instance, Expression::ENode *p_node, Variant &r_ret, String &r_error_str);
 
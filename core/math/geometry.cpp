@@ -30,8 +30,8 @@
 
 #include "geometry.h"
 
+#include "core/hash_map.h"
 #include "core/print_string.h"
-#include "thirdparty/misc/triangulator.h"
 
 /* this implementation is very inefficient, commenting unless bugs happen. See the other one.
 bool Geometry::is_point_in_polygon(const Vector2 &p_point, const Vector<Vector2> &p_polygon) {
@@ -739,34 +739,118 @@ PoolVector<Face3> Geometry::wrap_geometry(PoolVector<Face3> p_array, real_t *p_e
 }
 
 Vector<Vector<Vector2> > Geometry::decompose_polygon_in_convex(Vector<Point2> polygon) {
+
+	return decompose_polygon_in_convex(polygon, Vector<Vector<Point2> >());
+}
+
+Vector<Vector<Vector2> > Geometry::decompose_polygon_in_convex(const Vector<Point2> &p_polygon, const Vector<Vector<Point2> > &p_holes) {
+
 	Vector<Vector<Vector2> > decomp;
-	List<TriangulatorPoly> in_poly, out_poly;
 
-	TriangulatorPoly inp;
-	inp.Init(polygon.size());
-	for (int i = 0; i < polygon.size(); i++) {
-		inp.GetPoint(i) = polygon[i];
-	}
-	inp.SetOrientation(TRIANGULATOR_CCW);
-	in_poly.push_back(inp);
-	TriangulatorPartition tpart;
-	if (tpart.ConvexPartition_HM(&in_poly, &out_poly) == 0) { //failed!
+	Vector<int> triangles;
+	if (!Triangulate::triangulate_with_holes(p_polygon, p_holes, triangles)) {
 		ERR_PRINT("Convex decomposing failed!");
 		return decomp;
 	}
 
-	decomp.resize(out_poly.size());
-	int idx = 0;
-	for (List<TriangulatorPoly>::Element *I = out_poly.front(); I; I = I->next()) {
-		TriangulatorPoly &tp = I->get();
+	Vector<Point2> points = p_polygon;
+	for (int i = 0; i < p_holes.size(); i++) {
+		points.append_array(p_holes[i]);
+	}
+	const Point2 *r = points.ptr();
+
+	// Hertel-Mehlhorn: starting from the triangles, remove every diagonal
+	// whose two ends stay convex once the parts on both sides are joined.
+	// Each corner is a node in the ring of its part, and stands for the
+	// edge going from it to the next corner.
+	struct Corner {
+		int vertex;
+		int prev;
+		int next;
+		bool removed;
+	};
 
-		decomp.write[idx].resize(tp.GetNumPoints());
+	int corner_count = triangles.size();
+	Vector<Corner> corner_pool;
+	corner_pool.resize(corner_count);
+	Corner *corners = corner_pool.ptrw();
 
-		for (int i = 0; i < tp.GetNumPoints(); i++) {
-			decomp.write[idx].write[i] = tp.GetPoint(i);
-		}
+	HashMap<uint64_t, int> edges;
+
+	for (int i = 0; i < corner_count; i++) {
+
+		int tri = i - i % 3;
+		Corner &c = corners[i];
+		c.vertex = triangles[i];
+		c.next = tri + (i + 1) % 3;
+		c.prev = tri + (i + 2) % 3;
+		c.removed = false;
+	}
+
+	for (int i = 0; i < corner_count; i++) {
+		edges.set((uint64_t(corners[i].vertex) << 32) | uint32_t(corners[corners[i].next].vertex), i);
+	}
+
+	for (int i = 0; i < corner_count; i++) {
+
+		if (corners[i].removed)
+			continue;
+
+		int a = corners[i].vertex;
+		int b = corners[corners[i].next].vertex;
+		if (a >= b)
+			continue; // the twin edge handles this diagonal
+
+		const int *twin = edges.getptr((uint64_t(b) << 32) | uint32_t(a));
+		if (!twin || corners[*twin].removed)
+			continue; // outline edge
+
+		int x = i; // a -> b
+		int y = *twin; // b -> a
+
+		const Point2 &pa = r[a];
+		const Point2 &pb = r[b];
+		const Point2 &a_prev = r[corners[corners[x].prev].vertex];
+		const Point2 &a_next = r[corners[corners[corners[y].next].next].vertex];
+		const Point2 &b_prev = r[corners[corners[y].prev].vertex];
+		const Point2 &b_next = r[corners[corners[corners[x].next].next].vertex];
+
+		if ((pa - a_prev).cross(a_next - pa) < 0 || (pb - b_prev).cross(b_next - pb) < 0)
+			continue; // merged part would be concave
+
+		int a_out = corners[y].next;
+		int b_out = corners[x].next;
+
+		corners[corners[x].prev].next = a_out;
+		corners[a_out].prev = corners[x].prev;
+		corners[corners[y].prev].next = b_out;
+		corners[b_out].prev = corners[y].prev;
+
+		corners[x].removed = true;
+		corners[y].removed = true;
+	}
+
+	Vector<bool> visited;
+	visited.resize(corner_count);
+	bool *v = visited.ptrw();
+	for (int i = 0; i < corner_count; i++) {
+		v[i] = corners[i].removed;
+	}
+
+	for (int i = 0; i < corner_count; i++) {
+
+		if (v[i])
+			continue;
+
+		Vector<Vector2> part;
+		int c = i;
+		do {
+			v[c] = true;
+			part.push_back(r[corners[c].vertex]);
+			c = corners[c].next;
+		} while (c != i);
 
-		idx++;
+		decomp.push_back(part);
 	}
 
 	return decomp;
@@ -791,6 +791,15 @@ public:
 		return triangles;
 	}
 
+	// Indices count the polygon points first, then the points of each hole in order.
+	static Vector<int> triangulate_polygon_with_holes(const Vector<Vector2> &p_polygon, const Vector<Vector<Vector2> > &p_holes) {
+
+		Vector<int> triangles;
+		if (!Triangulate::triangulate_with_holes(p_polygon, p_holes, triangles))
+			return Vector<int>(); //fail
+		return triangles;
+	}
+
 	static Vector<Vector<Vector2> > (*_decompose_func)(const Vector<Vector2> &p_polygon);
 	static Vector<Vector<Vector2> > decompose_polygon(const Vector<Vector2> &p_polygon) {
 
@@ -951,6 +960,7 @@ public:
 	}
 
 	static Vector<Vector<Vector2> > decompose_polygon_in_convex(Vector<Point2> polygon);
+	static Vector<Vector<Vector2> > decompose_polygon_in_convex(const Vector<Point2> &p_polygon, const Vector<Vector<Point2> > &p_holes);
 
 	static MeshData build_convex_mesh(const PoolVector<Plane> &p_planes);
 	static PoolVector<Plane> build_sphere_planes(real_t p_radius, int p_lats, int p_lons, Vector3::Axis p_axis = Vector3::AXIS_Z);
@@ -0,0 +1,329 @@
+/*************************************************************************/
+/*  math_batch.cpp                                                       */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2019 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2019 Godot Engine contributors (cf. AUTHORS.md)    */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#include "math_batch.h"
+
+// The vector paths only exist for single precision builds. SSE2 is part of the
+// x86_64 baseline and NEON of AArch64, so no runtime detection is needed.
+#if !defined(REAL_T_IS_DOUBLE) && defined(__SSE2__)
+#define MATH_BATCH_SSE2
+#include <emmintrin.h>
+#elif !defined(REAL_T_IS_DOUBLE) && defined(__aarch64__) && defined(__ARM_NEON)
+#define MATH_BATCH_NEON
+#include <arm_neon.h>
+#endif
+
+#if defined(MATH_BATCH_SSE2)
+
+typedef __m128 _Vec4f;
+
+static _FORCE_INLINE_ _Vec4f _vload(const float *p_ptr) { return _mm_loadu_ps(p_ptr); }
+static _FORCE_INLINE_ void _vstore(float *p_ptr, _Vec4f p_v) { _mm_storeu_ps(p_ptr, p_v); }
+static _FORCE_INLINE_ _Vec4f _vset1(float p_f) { return _mm_set1_ps(p_f); }
+static _FORCE_INLINE_ _Vec4f _vsetr(float p_a, float p_b, float p_c, float p_d) { return _mm_setr_ps(p_a, p_b, p_c, p_d); }
+static _FORCE_INLINE_ _Vec4f _vadd(_Vec4f p_a, _Vec4f p_b) { return _mm_add_ps(p_a, p_b); }
+static _FORCE_INLINE_ _Vec4f _vsub(_Vec4f p_a, _Vec4f p_b) { return _mm_sub_ps(p_a, p_b); }
+static _FORCE_INLINE_ _Vec4f _vmul(_Vec4f p_a, _Vec4f p_b) { return _mm_mul_ps(p_a, p_b); }
+static _FORCE_INLINE_ _Vec4f _vdiv(_Vec4f p_a, _Vec4f p_b) { return _mm_div_ps(p_a, p_b); }
+static _FORCE_INLINE_ _Vec4f _vsqrt(_Vec4f p_v) { return _mm_sqrt_ps(p_v); }
+// Lanes where p_a > p_b have all bits set.
+static _FORCE_INLINE_ _Vec4f _vgt(_Vec4f p_a, _Vec4f p_b) { return _mm_cmpgt_ps(p_a, p_b); }
+static _FORCE_INLINE_ _Vec4f _vor(_Vec4f p_a, _Vec4f p_b) { return _mm_or_ps(p_a, p_b); }
+// Keeps p_v where p_mask is set, zero elsewhere.
+static _FORCE_INLINE_ _Vec4f _vkeep(_Vec4f p_mask, _Vec4f p_v) { return _mm_and_ps(p_mask, p_v); }
+static _FORCE_INLINE_ int _vmask_bits(_Vec4f p_mask) { return _mm_movemask_ps(p_mask); }
+
+static _FORCE_INLINE_ void _vtranspose(_Vec4f &r_0, _Vec4f &r_1, _Vec4f &r_2, _Vec4f &r_3) {
+	_MM_TRANSPOSE4_PS(r_0, r_1, r_2, r_3);
+}
+
+// Splits four packed Vector3 (12 floats) into x, y and z lanes.
+static _FORCE_INLINE_ void _vload3(const float *p_ptr, _Vec4f &r_x, _Vec4f &r_y, _Vec4f &r_z) {
+	__m128 a = _mm_loadu_ps(p_ptr);
+	__m128 b = _mm_loadu_ps(p_ptr + 4);
+	__m128 c = _mm_loadu_ps(p_ptr + 8);
+	r_x = _mm_shuffle_ps(a, _mm_shuffle_ps(b, c, _MM_SHUFFLE(1, 1, 2, 2)), _MM_SHUFFLE(2, 0, 3, 0));
+	r_y = _mm_shuffle_ps(_mm_shuffle_ps(a, b, _MM_SHUFFLE(0, 0, 1, 1)), _mm_shuffle_ps(b, c, _MM_SHUFFLE(2, 2, 3, 3)), _MM_SHUFFLE(2, 0, 2, 0));
+	r_z = _mm_shuffle_ps(_mm_shuffle_ps(a, b, _MM_SHUFFLE(1, 1, 2, 2)), c, _MM_SHUFFLE(3, 0, 2, 0));
+}
+
+static _FORCE_INLINE_ void _vstore3(float *p_ptr, _Vec4f p_x, _Vec4f p_y, _Vec4f p_z) {
+	_mm_storeu_ps(p_ptr, _mm_shuffle_ps(_mm_shuffle_ps(p_x, p_y, _MM_SHUFFLE(0, 0, 0, 0)), _mm_shuffle_ps(p_z, p_x, _MM_SHUFFLE(1, 1, 0, 0)), _MM_SHUFFLE(2, 0, 2, 0)));
+	_mm_storeu_ps(p_ptr + 4, _mm_shuffle_ps(_mm_shuffle_ps(p_y, p_z, _MM_SHUFFLE(1, 1, 1, 1)), _mm_shuffle_ps(p_x, p_y, _MM_SHUFFLE(2, 2, 2, 2)), _MM_SHUFFLE(2, 0, 2, 0)));
+	_mm_storeu_ps(p_ptr + 8, _mm_shuffle_ps(_mm_shuffle_ps(p_z, p_x, _MM_SHUFFLE(3, 3, 2, 2)), _mm_shuffle_ps(p_y, p_z, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(2, 0, 2, 0)));
+}
+
+#elif defined(MATH_BATCH_NEON)
+
+typedef float32x4_t _Vec4f;
+
+static _FORCE_INLINE_ _Vec4f _vload(const float *p_ptr) { return vld1q_f32(p_ptr); }
+static _FORCE_INLINE_ void _vstore(float *p_ptr, _Vec4f p_v) { vst1q_f32(p_ptr, p_v); }
+static _FORCE_INLINE_ _Vec4f _vset1(float p_f) { return vdupq_n_f32(p_f); }
+static _FORCE_INLINE_ _Vec4f _vsetr(float p_a, float p_b, float p_c, float p_d) {
+	float lanes[4] = { p_a, p_b, p_c, p_d };
+	return vld1q_f32(lanes);
+}
+// Separate multiply and add, vmlaq/vfmaq would round differently from the scalar code.
+static _FORCE_INLINE_ _Vec4f _vadd(_Vec4f p_a, _Vec4f p_b) { return vaddq_f32(p_a, p_b); }
+static _FORCE_INLINE_ _Vec4f _vsub(_Vec4f p_a, _Vec4f p_b) { return vsubq_f32(p_a, p_b); }
+static _FORCE_INLINE_ _Vec4f _vmul(_Vec4f p_a, _Vec4f p_b) { return vmulq_f32(p_a, p_b); }
+static _FORCE_INLINE_ _Vec4f _vdiv(_Vec4f p_a, _Vec4f p_b) { return vdivq_f32(p_a, p_b); }
+static _FORCE_INLINE_ _Vec4f _vsqrt(_Vec4f p_v) { return vsqrtq_f32(p_v); }
+static _FORCE_INLINE_ _Vec4f _vgt(_Vec4f p_a, _Vec4f p_b) { return vreinterpretq_f32_u32(vcgtq_f32(p_a, p_b)); }
+static _FORCE_INLINE_ _Vec4f _vor(_Vec4f p_a, _Vec4f p_b) { return vreinterpretq_f32_u32(vorrq_u32(vreinterpretq_u32_f32(p_a), vreinterpretq_u32_f32(p_b))); }
+static _FORCE_INLINE_ _Vec4f _vkeep(_Vec4f p_mask, _Vec4f p_v) { return vreinterpretq_f32_u32(vandq_u32(vreinterpretq_u32_f32(p_mask), vreinterpretq_u32_f32(p_v))); }
+static _FORCE_INLINE_ int _vmask_bits(_Vec4f p_mask) {
+	static const uint32_t weights[4] = { 1, 2, 4, 8 };
+	return vaddvq_u32(vandq_u32(vreinterpretq_u32_f32(p_mask), vld1q_u32(weights)));
+}
+
+static _FORCE_INLINE_ void _vtranspose(_Vec4f &r_0, _Vec4f &r_1, _Vec4f &r_2, _Vec4f &r_3) {
+	float32x4x2_t t01 = vtrnq_f32(r_0, r_1);
+	float32x4x2_t t23 = vtrnq_f32(r_2, r_3);
+	r_0 = vcombine_f32(vget_low_f32(t01.val[0]), vget_low_f32(t23.val[0]));
+	r_1 = vcombine_f32(vget_low_f32(t01.val[1]), vget_low_f32(t23.val[1]));
+	r_2 = vcombine_f32(vget_high_f32(t01.val[0]), vget_high_f32(t23.val[0]));
+	r_3 = vcombine_f32(vget_high_f32(t01.val[1]), vget_high_f32(t23.val[1]));
+}
+
+static _FORCE_INLINE_ void _vload3(const float *p_ptr, _Vec4f &r_x, _Vec4f &r_y, _Vec4f &r_z) {
+	float32x4x3_t v = vld3q_f32(p_ptr);
+	r_x = v.val[0];
+	r_y = v.val[1];
+	r_z = v.val[2];
+}
+
+static _FORCE_INLINE_ void _vstore3(float *p_ptr, _Vec4f p_x, _Vec4f p_y, _Vec4f p_z) {
+	float32x4x3_t v;
+	v.val[0] = p_x;
+	v.val[1] = p_y;
+	v.val[2] = p_z;
+	vst3q_f32(p_ptr, v);
+}
+
+#endif
+
+#if defined(MATH_BATCH_SSE2) || defined(MATH_BATCH_NEON)
+
+// A Transform is 12 consecutive floats: the basis rows, then the origin.
+// These turn four of them into one register per component and back.
+static _FORCE_INLINE_ void _vload_transforms(const Transform *p_xforms, _Vec4f *r_c) {
+	const float *t0 = &p_xforms[0].basis.elements[0].x;
+	const float *t1 = &p_xforms[1].basis.elements[0].x;
+	const float *t2 = &p_xforms[2].basis.elements[0].x;
+	const float *t3 = &p_xforms[3].basis.elements[0].x;
+	for (int i = 0; i < 12; i += 4) {
+		r_c[i + 0] = _vload(t0 + i);
+		r_c[i + 1] = _vload(t1 + i);
+		r_c[i + 2] = _vload(t2 + i);
+		r_c[i + 3] = _vload(t3 + i);
+		_vtranspose(r_c[i + 0], r_c[i + 1], r_c[i + 2], r_c[i + 3]);
+	}
+}
+
+static _FORCE_INLINE_ void _vstore_transforms(Transform *p_xforms, _Vec4f *p_c) {
+	float *t0 = &p_xforms[0].basis.elements[0].x;
+	float *t1 = &p_xforms[1].basis.elements[0].x;
+	float *t2 = &p_xforms[2].basis.elements[0].x;
+	float *t3 = &p_xforms[3].basis.elements[0].x;
+	for (int i = 0; i < 12; i += 4) {
+		_vtranspose(p_c[i + 0], p_c[i + 1], p_c[i + 2], p_c[i + 3]);
+		_vstore(t0 + i, p_c[i + 0]);
+		_vstore(t1 + i, p_c[i + 1]);
+		_vstore(t2 + i, p_c[i + 2]);
+		_vstore(t3 + i, p_c[i + 3]);
+	}
+}
+
+// p_a * p_b on component registers, same operation order as Transform::operator*.
+static _FORCE_INLINE_ void _vmultiply(const _Vec4f *p_a, const _Vec4f *p_b, _Vec4f *r_c) {
+	for (int i = 0; i < 3; i++) {
+		const _Vec4f ax = p_a[i * 3 + 0];
+		const _Vec4f ay = p_a[i * 3 + 1];
+		const _Vec4f az = p_a[i * 3 + 2];
+		for (int j = 0; j < 3; j++) {
+			r_c[i * 3 + j] = _vadd(_vadd(_vmul(p_b[j], ax), _vmul(p_b[3 + j], ay)), _vmul(p_b[6 + j], az));
+		}
+		r_c[9 + i] = _vadd(_vadd(_vadd(_vmul(ax, p_b[9]), _vmul(ay, p_b[10])), _vmul(az, p_b[11])), p_a[9 + i]);
+	}
+}
+
+#endif
+
+void MathBatch::xform_points(const Transform &p_xform, const Vector3 *p_src, Vector3 *r_dst, int p_count) {
+
+	int i = 0;
+#if defined(MATH_BATCH_SSE2) || defined(MATH_BATCH_NEON)
+	const Basis &b = p_xform.basis;
+	const _Vec4f m00 = _vset1(b[0][0]), m01 = _vset1(b[0][1]), m02 = _vset1(b[0][2]);
+	const _Vec4f m10 = _vset1(b[1][0]), m11 = _vset1(b[1][1]), m12 = _vset1(b[1][2]);
+	const _Vec4f m20 = _vset1(b[2][0]), m21 = _vset1(b[2][1]), m22 = _vset1(b[2][2]);
+	const _Vec4f ox = _vset1(p_xform.origin.x), oy = _vset1(p_xform.origin.y), oz = _vset1(p_xform.origin.z);
+	for (; i + 4 <= p_count; i += 4) {
+		_Vec4f x, y, z;
+		_vload3(&p_src[i].x, x, y, z);
+		_Vec4f rx = _vadd(_vadd(_vadd(_vmul(m00, x), _vmul(m01, y)), _vmul(m02, z)), ox);
+		_Vec4f ry = _vadd(_vadd(_vadd(_vmul(m10, x), _vmul(m11, y)), _vmul(m12, z)), oy);
+		_Vec4f rz = _vadd(_vadd(_vadd(_vmul(m20, x), _vmul(m21, y)), _vmul(m22, z)), oz);
+		_vstore3(&r_dst[i].x, rx, ry, rz);
+	}
+#endif
+	for (; i < p_count; i++) {
+		r_dst[i] = p_xform.xform(p_src[i]);
+	}
+}
+
+void MathBatch::xform_normals(const Basis &p_basis, const Vector3 *p_src, Vector3 *r_dst, int p_count, bool p_normalize) {
+
+	int i = 0;
+#if defined(MATH_BATCH_SSE2) || defined(MATH_BATCH_NEON)
+	const Basis &b = p_basis;
+	const _Vec4f m00 = _vset1(b[0][0]), m01 = _vset1(b[0][1]), m02 = _vset1(b[0][2]);
+	const _Vec4f m10 = _vset1(b[1][0]), m11 = _vset1(b[1][1]), m12 = _vset1(b[1][2]);
+	const _Vec4f m20 = _vset1(b[2][0]), m21 = _vset1(b[2][1]), m22 = _vset1(b[2][2]);
+	const _Vec4f zero = _vset1(0);
+	for (; i + 4 <= p_count; i += 4) {
+		_Vec4f x, y, z;
+		_vload3(&p_src[i].x, x, y, z);
+		_Vec4f rx = _vadd(_vadd(_vmul(m00, x), _vmul(m01, y)), _vmul(m02, z));
+		_Vec4f ry = _vadd(_vadd(_vmul(m10, x), _vmul(m11, y)), _vmul(m12, z));
+		_Vec4f rz = _vadd(_vadd(_vmul(m20, x), _vmul(m21, y)), _vmul(m22, z));
+		if (p_normalize) {
+			_Vec4f len = _vsqrt(_vadd(_vadd(_vmul(rx, rx), _vmul(ry, ry)), _vmul(rz, rz)));
+			// Vector3::normalize() leaves zero length vectors at zero.
+			_Vec4f nonzero = _vgt(len, zero);
+			rx = _vkeep(nonzero, _vdiv(rx, len));
+			ry = _vkeep(nonzero, _vdiv(ry, len));
+			rz = _vkeep(nonzero, _vdiv(rz, len));
+		}
+		_vstore3(&r_dst[i].x, rx, ry, rz);
+	}
+#endif
+	for (; i < p_count; i++) {
+		Vector3 n = p_basis.xform(p_src[i]);
+		if (p_normalize) {
+			n.normalize();
+		}
+		r_dst[i] = n;
+	}
+}
+
+void MathBatch::multiply_transforms(const Transform *p_a, const Transform *p_b, Transform *r_dst, int p_count) {
+
+	int i = 0;
+#if defined(MATH_BATCH_SSE2) || defined(MATH_BATCH_NEON)
+	for (; i + 4 <= p_count; i += 4) {
+		_Vec4f a[12], b[12], c[12];
+		_vload_transforms(p_a + i, a);
+		_vload_transforms(p_b + i, b);
+		_vmultiply(a, b, c);
+		_vstore_transforms(r_dst + i, c);
+	}
+#endif
+	for (; i < p_count; i++) {
+		r_dst[i] = p_a[i] * p_b[i];
+	}
+}
+
+void MathBatch::multiply_transforms(const Transform &p_parent, const Transform *p_src, Transform *r_dst, int p_count) {
+
+	int i = 0;
+#if defined(MATH_BATCH_SSE2) || defined(MATH_BATCH_NEON)
+	_Vec4f a[12];
+	const float *parent = &p_parent.basis.elements[0].x;
+	for (int j = 0; j < 12; j++) {
+		a[j] = _vset1(parent[j]);
+	}
+	for (; i + 4 <= p_count; i += 4) {
+		_Vec4f b[12], c[12];
+		_vload_transforms(p_src + i, b);
+		_vmultiply(a, b, c);
+		_vstore_transforms(r_dst + i, c);
+	}
+#endif
+	for (; i < p_count; i++) {
+		r_dst[i] = p_parent * p_src[i];
+	}
+}
+
+int MathBatch::cull_aabbs(const Plane *p_planes, int p_plane_count, const AABB *p_aabbs, int p_count, uint8_t *r_inside) {
+
+	int passed = 0;
+	int i = 0;
+#if defined(MATH_BATCH_SSE2) || defined(MATH_BATCH_NEON)
+	const _Vec4f half = _vset1(0.5);
+	for (; i + 4 <= p_count; i += 4) {
+		const AABB *b = p_aabbs + i;
+		_Vec4f hx = _vmul(_vsetr(b[0].size.x, b[1].size.x, b[2].size.x, b[3].size.x), half);
+		_Vec4f hy = _vmul(_vsetr(b[0].size.y, b[1].size.y, b[2].size.y, b[3].size.y), half);
+		_Vec4f hz = _vmul(_vsetr(b[0].size.z, b[1].size.z, b[2].size.z, b[3].size.z), half);
+		_Vec4f cx = _vadd(_vsetr(b[0].position.x, b[1].position.x, b[2].position.x, b[3].position.x), hx);
+		_Vec4f cy = _vadd(_vsetr(b[0].position.y, b[1].position.y, b[2].position.y, b[3].position.y), hy);
+		_Vec4f cz = _vadd(_vsetr(b[0].position.z, b[1].position.z, b[2].position.z, b[3].position.z), hz);
+		// Two candidate corners per axis, the plane normal's sign picks one.
+		_Vec4f lx = _vsub(cx, hx), ly = _vsub(cy, hy), lz = _vsub(cz, hz);
+		_Vec4f gx = _vadd(hx, cx), gy = _vadd(hy, cy), gz = _vadd(hz, cz);
+		_Vec4f outside = _vset1(0);
+		for (int j = 0; j < p_plane_count; j++) {
+			const Plane &p = p_planes[j];
+			_Vec4f px = p.normal.x > 0 ? lx : gx;
+			_Vec4f py = p.normal.y > 0 ? ly : gy;
+			_Vec4f pz = p.normal.z > 0 ? lz : gz;
+			_Vec4f dist = _vadd(_vadd(_vmul(_vset1(p.normal.x), px), _vmul(_vset1(p.normal.y), py)), _vmul(_vset1(p.normal.z), pz));
+			outside = _vor(outside, _vgt(dist, _vset1(p.d)));
+			if (_vmask_bits(outside) == 0xF) {
+				break;
+			}
+		}
+		int bits = _vmask_bits(outside);
+		for (int k = 0; k < 4; k++) {
+			bool inside = !(bits & (1 << k));
+			r_inside[i + k] = inside;
+			passed += inside;
+		}
+	}
+#endif
+	for (; i < p_count; i++) {
+		bool inside = p_aabbs[i].intersects_convex_shape(p_planes, p_plane_count);
+		r_inside[i] = inside;
+		passed += inside;
+	}
+	return passed;
+}
+
+bool MathBatch::is_vectorized() {
+
+#if defined(MATH_BATCH_SSE2) || defined(MATH_BATCH_NEON)
+	return true;
+#else
+	return false;
+#endif
+}
@@ -0,0 +1,60 @@
+/*************************************************************************/
+/*  math_batch.h                                                         */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2019 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2019 Godot Engine contributors (cf. AUTHORS.md)    */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#ifndef MATH_BATCH_H
+#define MATH_BATCH_H
+
+#include "core/math/aabb.h"
+#include "core/math/plane.h"
+#include "core/math/transform.h"
+
+// Batched versions of the per-element math used in hot loops (skinning,
+// debug mesh generation, culling). Results match the scalar operators bit for
+// bit; when real_t is float and the target has SSE2 or NEON, four elements are
+// processed per step in structure-of-arrays form.
+class MathBatch {
+	MathBatch();
+
+public:
+	// r_dst[i] = p_xform.xform(p_src[i]). p_src and r_dst may be the same array.
+	static void xform_points(const Transform &p_xform, const Vector3 *p_src, Vector3 *r_dst, int p_count);
+	// r_dst[i] = p_basis.xform(p_src[i]), optionally normalized.
+	static void xform_normals(const Basis &p_basis, const Vector3 *p_src, Vector3 *r_dst, int p_count, bool p_normalize = false);
+	// r_dst[i] = p_a[i] * p_b[i]. r_dst may alias either input.
+	static void multiply_transforms(const Transform *p_a, const Transform *p_b, Transform *r_dst, int p_count);
+	// r_dst[i] = p_parent * p_src[i]. r_dst may alias p_src.
+	static void multiply_transforms(const Transform &p_parent, const Transform *p_src, Transform *r_dst, int p_count);
+	// r_inside[i] = p_aabbs[i].intersects_convex_shape(p_planes, p_plane_count), returns how many passed.
+	static int cull_aabbs(const Plane *p_planes, int p_plane_count, const AABB *p_aabbs, int p_count, uint8_t *r_inside);
+
+	static bool is_vectorized();
+};
+
+#endif // MATH_BATCH_H
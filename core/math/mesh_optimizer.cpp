@@ -0,0 +1,396 @@
+/*************************************************************************/
+/*  mesh_optimizer.cpp                                                   */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2019 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2019 Godot Engine contributors (cf. AUTHORS.md)    */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#include "mesh_optimizer.h"
+
+#define CACHE_SIZE 32
+
+// Tuning constants from Forsyth, "Linear-Speed Vertex Cache Optimisation".
+#define CACHE_DECAY_POWER 1.5
+#define LAST_TRIANGLE_SCORE 0.75
+#define VALENCE_BOOST_SCALE 2.0
+#define VALENCE_BOOST_POWER 0.5
+
+float MeshOptimizer::_vertex_score(int p_cache_position, int p_remaining_triangles) {
+
+	if (p_remaining_triangles == 0)
+		return -1.0;
+
+	float score = 0;
+	if (p_cache_position >= 0) {
+		if (p_cache_position < 3) {
+			// the triangle that was just drawn, don't favour it to avoid strips
+			score = LAST_TRIANGLE_SCORE;
+		} else {
+			float scaler = 1.0 / (CACHE_SIZE - 3);
+			score = Math::pow(1.0 - (p_cache_position - 3) * scaler, CACHE_DECAY_POWER);
+		}
+	}
+
+	// vertices with few triangles left get a boost, so lone triangles aren't left behind
+	score += VALENCE_BOOST_SCALE * Math::pow((float)p_remaining_triangles, -(float)VALENCE_BOOST_POWER);
+	return score;
+}
+
+void MeshOptimizer::_reset_fifo(Vector<int> &r_cache_time, int &r_time) {
+
+	int *cache_time = r_cache_time.ptrw();
+	for (int i = 0; i < r_cache_time.size(); i++) {
+		cache_time[i] = -CACHE_SIZE;
+	}
+	r_time = 0;
+}
+
+int MeshOptimizer::_fifo_misses(const int *p_triangle, Vector<int> &r_cache_time, int &r_time) {
+
+	int misses = 0;
+	for (int i = 0; i < 3; i++) {
+		int v = p_triangle[i];
+		if (r_time - r_cache_time[v] >= CACHE_SIZE) {
+			r_cache_time.write[v] = r_time++;
+			misses++;
+		}
+	}
+	return misses;
+}
+
+void MeshOptimizer::optimize_vertex_cache(Vector<int> &r_indices, int p_vertex_count) {
+
+	int index_count = r_indices.size();
+	ERR_FAIL_COND(index_count % 3 != 0);
+
+	int triangle_count = index_count / 3;
+	if (triangle_count < 2)
+		return;
+
+	const int *indices = r_indices.ptr();
+
+	// vertex to triangle adjacency, as offsets into a flat list
+	Vector<int> adjacency_offset;
+	adjacency_offset.resize(p_vertex_count + 1);
+	Vector<int> live_triangles;
+	live_triangles.resize(p_vertex_count);
+	for (int i = 0; i < p_vertex_count; i++) {
+		live_triangles.write[i] = 0;
+	}
+	for (int i = 0; i < index_count; i++) {
+		ERR_FAIL_INDEX(indices[i], p_vertex_count);
+		live_triangles.write[indices[i]]++;
+	}
+	adjacency_offset.write[0] = 0;
+	for (int i = 0; i < p_vertex_count; i++) {
+		adjacency_offset.write[i + 1] = adjacency_offset[i] + live_triangles[i];
+	}
+
+	Vector<int> adjacency;
+	adjacency.resize(index_count);
+	{
+		Vector<int> fill = adjacency_offset;
+		for (int i = 0; i < index_count; i++) {
+			adjacency.write[fill.write[indices[i]]++] = i / 3;
+		}
+	}
+
+	Vector<int> cache_position;
+	cache_position.resize(p_vertex_count);
+	Vector<float> vertex_score;
+	vertex_score.resize(p_vertex_count);
+	for (int i = 0; i < p_vertex_count; i++) {
+		cache_position.write[i] = -1;
+		vertex_score.write[i] = _vertex_score(-1, live_triangles[i]);
+	}
+
+	Vector<float> triangle_score;
+	triangle_score.resize(triangle_count);
+	Vector<bool> emitted;
+	emitted.resize(triangle_count);
+	for (int i = 0; i < triangle_count; i++) {
+		triangle_score.write[i] = vertex_score[indices[i * 3]] + vertex_score[indices[i * 3 + 1]] + vertex_score[indices[i * 3 + 2]];
+		emitted.write[i] = false;
+	}
+
+	Vector<int> result;
+	result.resize(index_count);
+
+	int cache[CACHE_SIZE + 3];
+	int cache_count = 0;
+
+	int best_triangle = -1;
+	int input_cursor = 0;
+
+	for (int t = 0; t < triangle_count; t++) {
+
+		if (best_triangle < 0) {
+			// nothing in the cache is connected to what's left, continue in input order
+			while (emitted[input_cursor]) {
+				input_cursor++;
+			}
+			best_triangle = input_cursor;
+		}
+
+		const int *tri = &indices[best_triangle * 3];
+		result.write[t * 3 + 0] = tri[0];
+		result.write[t * 3 + 1] = tri[1];
+		result.write[t * 3 + 2] = tri[2];
+		emitted.write[best_triangle] = true;
+
+		// Drop the triangle from the adjacency of its vertices, only live triangles are kept there.
+		for (int i = 0; i < 3; i++) {
+
+			int v = tri[i];
+			int *list = &adjacency.write[adjacency_offset[v]];
+			int count = live_triangles[v];
+			for (int j = 0; j < count; j++) {
+				if (list[j] == best_triangle) {
+					list[j] = list[count - 1];
+					break;
+				}
+			}
+			live_triangles.write[v]--;
+		}
+
+		// Move the triangle vertices to the front of the LRU cache.
+		int new_cache[CACHE_SIZE + 3];
+		int new_cache_count = 0;
+		for (int i = 0; i < 3; i++) {
+			if (i > 0 && (tri[i] == tri[0] || (i == 2 && tri[i] == tri[1])))
+				continue;
+			new_cache[new_cache_count++] = tri[i];
+		}
+		for (int i = 0; i < cache_count; i++) {
+			int v = cache[i];
+			if (v != tri[0] && v != tri[1] && v != tri[2])
+				new_cache[new_cache_count++] = v;
+		}
+
+		// Rescore everything that was touched, vertices pushed out of the cache included.
+		for (int i = 0; i < new_cache_count; i++) {
+
+			int v = new_cache[i];
+			int position = i < CACHE_SIZE ? i : -1;
+			cache_position.write[v] = position;
+
+			float score = _vertex_score(position, live_triangles[v]);
+			float delta = score - vertex_score[v];
+			vertex_score.write[v] = score;
+
+			const int *list = &adjacency[adjacency_offset[v]];
+			for (int j = 0; j < live_triangles[v]; j++) {
+				triangle_score.write[list[j]] += delta;
+			}
+		}
+
+		cache_count = MIN(new_cache_count, CACHE_SIZE);
+		for (int i = 0; i < cache_count; i++) {
+			cache[i] = new_cache[i];
+		}
+
+		best_triangle = -1;
+		float best_score = 0;
+		for (int i = 0; i < cache_count; i++) {
+
+			int v = cache[i];
+			const int *list = &adjacency[adjacency_offset[v]];
+			for (int j = 0; j < live_triangles[v]; j++) {
+				if (best_triangle < 0 || triangle_score[list[j]] > best_score) {
+					best_triangle = list[j];
+					best_score = triangle_score[list[j]];
+				}
+			}
+		}
+	}
+
+	r_indices = result;
+}
+
+void MeshOptimizer::optimize_overdraw(Vector<int> &r_indices, const PoolVector<Vector3> &p_vertices, float p_threshold) {
+
+	int index_count = r_indices.size();
+	ERR_FAIL_COND(index_count % 3 != 0);
+
+	int triangle_count = index_count / 3;
+	int vertex_count = p_vertices.size();
+	if (triangle_count < 2)
+		return;
+
+	const int *indices = r_indices.ptr();
+	PoolVector<Vector3>::Read vr = p_vertices.read();
+	const Vector3 *vertices = vr.ptr();
+
+	for (int i = 0; i < index_count; i++) {
+		ERR_FAIL_INDEX(indices[i], vertex_count);
+	}
+
+	Vector<int> cache_time;
+	cache_time.resize(vertex_count);
+	int time = 0;
+
+	// Hard boundaries are where the cache optimizer had to start over, all three vertices missed.
+	Vector<int> hard_boundaries;
+	_reset_fifo(cache_time, time);
+	for (int i = 0; i < triangle_count; i++) {
+
+		int misses = _fifo_misses(&indices[i * 3], cache_time, time);
+		if (i == 0 || misses == 3)
+			hard_boundaries.push_back(i);
+	}
+	hard_boundaries.push_back(triangle_count);
+
+	// Split further wherever the part drawn so far is already about as cache friendly as its
+	// whole hard cluster, so reordering clusters costs at most p_threshold times the misses.
+	Vector<Cluster> clusters;
+	for (int i = 0; i < hard_boundaries.size() - 1; i++) {
+
+		int from = hard_boundaries[i];
+		int to = hard_boundaries[i + 1];
+
+		_reset_fifo(cache_time, time);
+		int cluster_misses = 0;
+		for (int j = from; j < to; j++) {
+			cluster_misses += _fifo_misses(&indices[j * 3], cache_time, time);
+		}
+		float target = float(cluster_misses) / (to - from) * p_threshold;
+
+		_reset_fifo(cache_time, time);
+		int start = from;
+		int misses_so_far = 0;
+		for (int j = from; j < to; j++) {
+
+			misses_so_far += _fifo_misses(&indices[j * 3], cache_time, time);
+
+			if (j + 1 < to && float(misses_so_far) / (j + 1 - start) <= target) {
+
+				Cluster c;
+				c.from = start;
+				c.to = j + 1;
+				clusters.push_back(c);
+
+				start = j + 1;
+				misses_so_far = 0;
+				_reset_fifo(cache_time, time);
+			}
+		}
+
+		Cluster c;
+		c.from = start;
+		c.to = to;
+		clusters.push_back(c);
+	}
+
+	if (clusters.size() < 2)
+		return;
+
+	// Area weighted centroid of the whole mesh.
+	Vector3 mesh_centroid;
+	real_t mesh_area = 0;
+	for (int i = 0; i < triangle_count; i++) {
+
+		const Vector3 &a = vertices[indices[i * 3 + 0]];
+		const Vector3 &b = vertices[indices[i * 3 + 1]];
+		const Vector3 &c = vertices[indices[i * 3 + 2]];
+		real_t area = (b - a).cross(c - a).length();
+		mesh_centroid += (a + b + c) * (area / 3.0);
+		mesh_area += area;
+	}
+	if (mesh_area > CMP_EPSILON)
+		mesh_centroid /= mesh_area;
+
+	// Clusters facing away from the center are most likely in front, so they are drawn first.
+	for (int i = 0; i < clusters.size(); i++) {
+
+		Cluster &cluster = clusters.write[i];
+		Vector3 centroid;
+		Vector3 normal;
+		real_t area = 0;
+		for (int j = cluster.from; j < cluster.to; j++) {
+
+			const Vector3 &a = vertices[indices[j * 3 + 0]];
+			const Vector3 &b = vertices[indices[j * 3 + 1]];
+			const Vector3 &c = vertices[indices[j * 3 + 2]];
+			Vector3 n = (b - a).cross(c - a);
+			real_t tri_area = n.length();
+			centroid += (a + b + c) * (tri_area / 3.0);
+			normal += n;
+			area += tri_area;
+		}
+
+		if (area > CMP_EPSILON)
+			centroid /= area;
+		real_t normal_length = normal.length();
+		if (normal_length > CMP_EPSILON)
+			normal /= normal_length;
+
+		cluster.sort_key = (centroid - mesh_centroid).dot(normal);
+	}
+
+	clusters.sort();
+
+	Vector<int> result;
+	result.resize(index_count);
+	int write = 0;
+	for (int i = 0; i < clusters.size(); i++) {
+		for (int j = clusters[i].from * 3; j < clusters[i].to * 3; j++) {
+			result.write[write++] = indices[j];
+		}
+	}
+
+	r_indices = result;
+}
+
+Vector<int> MeshOptimizer::optimize_vertex_fetch(Vector<int> &r_indices, int p_vertex_count) {
+
+	Vector<int> remap;
+	remap.resize(p_vertex_count);
+	for (int i = 0; i < p_vertex_count; i++) {
+		remap.write[i] = -1;
+	}
+
+	int index_count = r_indices.size();
+	for (int i = 0; i < index_count; i++) {
+		ERR_FAIL_INDEX_V(r_indices[i], p_vertex_count, Vector<int>());
+	}
+
+	int *indices = r_indices.ptrw();
+	int next = 0;
+	for (int i = 0; i < index_count; i++) {
+
+		int v = indices[i];
+		if (remap[v] < 0)
+			remap.write[v] = next++;
+		indices[i] = remap[v];
+	}
+
+	for (int i = 0; i < p_vertex_count; i++) {
+		if (remap[i] < 0)
+			remap.write[i] = next++;
+	}
+
+	return remap;
+}
@@ -0,0 +1,66 @@
+/*************************************************************************/
+/*  mesh_optimizer.h                                                     */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2019 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2019 Godot Engine contributors (cf. AUTHORS.md)    */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#ifndef MESH_OPTIMIZER_H
+#define MESH_OPTIMIZER_H
+
+#include "core/math/vector3.h"
+#include "core/pool_vector.h"
+#include "core/vector.h"
+
+// Reorders indexed triangle lists so they render faster without changing what is drawn:
+// triangles for post-transform vertex cache hits and less overdraw, vertices for fetch locality.
+class MeshOptimizer {
+
+	struct Cluster {
+
+		int from;
+		int to;
+		real_t sort_key;
+
+		bool operator<(const Cluster &p_cluster) const { return sort_key > p_cluster.sort_key; }
+	};
+
+	static float _vertex_score(int p_cache_position, int p_remaining_triangles);
+	static void _reset_fifo(Vector<int> &r_cache_time, int &r_time);
+	static int _fifo_misses(const int *p_triangle, Vector<int> &r_cache_time, int &r_time);
+
+public:
+	// Triangle order for vertex cache reuse (Forsyth's linear-speed optimizer).
+	static void optimize_vertex_cache(Vector<int> &r_indices, int p_vertex_count);
+	// Splits a cache optimized list into clusters and draws those facing away from the center first,
+	// giving up at most p_threshold times the cache misses (Sander et al.).
+	static void optimize_overdraw(Vector<int> &r_indices, const PoolVector<Vector3> &p_vertices, float p_threshold = 1.05);
+	// Renumbers vertices in order of first use, so the vertex buffer is read sequentially.
+	// Returns the new position of each old vertex, unused vertices are moved to the end.
+	static Vector<int> optimize_vertex_fetch(Vector<int> &r_indices, int p_vertex_count);
+};
+
+#endif // MESH_OPTIMIZER_H
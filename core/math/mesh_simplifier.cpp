@@ -0,0 +1,371 @@
+/*************************************************************************/
+/*  mesh_simplifier.cpp                                                  */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2019 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2019 Godot Engine contributors (cf. AUTHORS.md)    */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#include "mesh_simplifier.h"
+
+#include "core/hash_map.h"
+#include "core/map.h"
+#include "core/math/aabb.h"
+
+#define MIN_LOD_INDICES (3 * 16)
+
+void MeshSimplifier::Quadric::add_plane(const Vector3 &p_normal, real_t p_d) {
+
+	a2 += p_normal.x * p_normal.x;
+	ab += p_normal.x * p_normal.y;
+	ac += p_normal.x * p_normal.z;
+	ad += p_normal.x * p_d;
+	b2 += p_normal.y * p_normal.y;
+	bc += p_normal.y * p_normal.z;
+	bd += p_normal.y * p_d;
+	c2 += p_normal.z * p_normal.z;
+	cd += p_normal.z * p_d;
+	d2 += p_d * p_d;
+}
+
+void MeshSimplifier::Quadric::operator+=(const Quadric &p_q) {
+
+	a2 += p_q.a2;
+	ab += p_q.ab;
+	ac += p_q.ac;
+	ad += p_q.ad;
+	b2 += p_q.b2;
+	bc += p_q.bc;
+	bd += p_q.bd;
+	c2 += p_q.c2;
+	cd += p_q.cd;
+	d2 += p_q.d2;
+}
+
+double MeshSimplifier::Quadric::evaluate(const Vector3 &p_pos) const {
+
+	double x = p_pos.x;
+	double y = p_pos.y;
+	double z = p_pos.z;
+
+	double r = a2 * x * x + 2 * ab * x * y + 2 * ac * x * z + 2 * ad * x + b2 * y * y + 2 * bc * y * z + 2 * bd * y + c2 * z * z + 2 * cd * z + d2;
+	return MAX(r, 0.0);
+}
+
+MeshSimplifier::Quadric::Quadric() {
+
+	a2 = ab = ac = ad = 0;
+	b2 = bc = bd = 0;
+	c2 = cd = 0;
+	d2 = 0;
+}
+
+int MeshSimplifier::_collapse_pass(const Vector3 *p_vertices, int p_vertex_count, Vector<int> &r_indices, const Vector<int> &p_positions, const Vector<bool> &p_locked, Vector<Quadric> &r_quadrics, int p_target_index_count, double p_max_cost, double &r_error) {
+
+	int index_count = r_indices.size();
+	int *indices = r_indices.ptrw();
+
+	// vertex to triangle adjacency, as offsets into a flat list
+	Vector<int> adjacency_offset;
+	adjacency_offset.resize(p_vertex_count + 1);
+	for (int i = 0; i <= p_vertex_count; i++) {
+		adjacency_offset.write[i] = 0;
+	}
+	for (int i = 0; i < index_count; i++) {
+		adjacency_offset.write[indices[i] + 1]++;
+	}
+	for (int i = 0; i < p_vertex_count; i++) {
+		adjacency_offset.write[i + 1] += adjacency_offset[i];
+	}
+
+	Vector<int> adjacency;
+	adjacency.resize(index_count);
+	{
+		Vector<int> fill = adjacency_offset;
+		for (int i = 0; i < index_count; i++) {
+			adjacency.write[fill.write[indices[i]]++] = i / 3;
+		}
+	}
+
+	Vector<Collapse> collapses;
+	for (int i = 0; i < index_count; i++) {
+
+		int from = indices[i];
+		int to = indices[(i % 3 == 2) ? i - 2 : i + 1];
+
+		for (int j = 0; j < 2; j++) {
+
+			if (!p_locked[from] && p_positions[from] != p_positions[to]) {
+
+				Quadric q = r_quadrics[p_positions[from]];
+				q += r_quadrics[p_positions[to]];
+
+				Collapse c;
+				c.from = from;
+				c.to = to;
+				c.cost = q.evaluate(p_vertices[to]);
+				if (c.cost <= p_max_cost)
+					collapses.push_back(c);
+			}
+
+			SWAP(from, to);
+		}
+	}
+
+	if (collapses.empty())
+		return 0;
+
+	collapses.sort();
+
+	Vector<bool> touched;
+	touched.resize(p_vertex_count);
+	for (int i = 0; i < p_vertex_count; i++) {
+		touched.write[i] = false;
+	}
+
+	int triangles_to_remove = (index_count - p_target_index_count) / 3;
+	int removed = 0;
+	int collapsed = 0;
+
+	for (int i = 0; i < collapses.size() && removed < triangles_to_remove; i++) {
+
+		const Collapse &c = collapses[i];
+
+		if (touched[c.from] || touched[c.to])
+			continue;
+
+		// Reject collapses that would flip a triangle around the removed vertex.
+		bool valid = true;
+		bool shares_edge = false;
+		for (int j = adjacency_offset[c.from]; j < adjacency_offset[c.from + 1] && valid; j++) {
+
+			const int *tri = &indices[adjacency[j] * 3];
+			if (tri[0] == c.to || tri[1] == c.to || tri[2] == c.to) {
+				shares_edge = true;
+				continue;
+			}
+
+			Vector3 v[3];
+			Vector3 nv[3];
+			for (int k = 0; k < 3; k++) {
+				v[k] = p_vertices[tri[k]];
+				nv[k] = tri[k] == c.from ? p_vertices[c.to] : v[k];
+			}
+
+			Vector3 n = (v[1] - v[0]).cross(v[2] - v[0]);
+			Vector3 nn = (nv[1] - nv[0]).cross(nv[2] - nv[0]);
+			valid = n.dot(nn) > 0;
+		}
+
+		// Only collapse along an existing edge, seam wedges may share positions without being connected.
+		if (!valid || !shares_edge)
+			continue;
+
+		for (int j = adjacency_offset[c.from]; j < adjacency_offset[c.from + 1]; j++) {
+
+			int *tri = &indices[adjacency[j] * 3];
+
+			bool degenerate = false;
+			for (int k = 0; k < 3; k++) {
+				degenerate = degenerate || tri[k] == c.to;
+				touched.write[tri[k]] = true;
+			}
+			for (int k = 0; k < 3; k++) {
+				if (tri[k] == c.from)
+					tri[k] = c.to;
+			}
+			if (degenerate)
+				removed++;
+		}
+
+		r_quadrics.write[p_positions[c.to]] += r_quadrics[p_positions[c.from]];
+		r_error = MAX(r_error, c.cost);
+		collapsed++;
+	}
+
+	// Drop the triangles that collapsed into edges.
+	int write = 0;
+	for (int i = 0; i < index_count; i += 3) {
+
+		if (indices[i] == indices[i + 1] || indices[i + 1] == indices[i + 2] || indices[i] == indices[i + 2])
+			continue;
+
+		indices[write++] = indices[i];
+		indices[write++] = indices[i + 1];
+		indices[write++] = indices[i + 2];
+	}
+
+	r_indices.resize(write);
+
+	return collapsed;
+}
+
+Vector<MeshSimplifier::LOD> MeshSimplifier::build_lods(const PoolVector<Vector3> &p_vertices, const PoolVector<int> &p_indices, int p_max_lods, float p_reduction, float p_max_error) {
+
+	Vector<LOD> lods;
+
+	int vertex_count = p_vertices.size();
+	int index_count = p_indices.size();
+
+	ERR_FAIL_COND_V(index_count % 3 != 0, lods);
+	ERR_FAIL_COND_V(p_reduction <= 0 || p_reduction >= 1, lods);
+
+	if (index_count < MIN_LOD_INDICES * 2)
+		return lods;
+
+	PoolVector<Vector3>::Read vr = p_vertices.read();
+	PoolVector<int>::Read ir = p_indices.read();
+	const Vector3 *vertices = vr.ptr();
+
+	Vector<int> indices;
+	indices.resize(index_count);
+
+	AABB bounds;
+	Vector<bool> referenced;
+	referenced.resize(vertex_count);
+	for (int i = 0; i < vertex_count; i++) {
+		referenced.write[i] = false;
+	}
+
+	for (int i = 0; i < index_count; i++) {
+
+		int idx = ir[i];
+		ERR_FAIL_INDEX_V(idx, vertex_count, lods);
+		indices.write[i] = idx;
+
+		if (i == 0)
+			bounds.position = vertices[idx];
+		else
+			bounds.expand_to(vertices[idx]);
+		referenced.write[idx] = true;
+	}
+
+	real_t diagonal = bounds.size.length();
+	if (diagonal <= CMP_EPSILON)
+		return lods;
+
+	// Weld vertices by position, so UV and normal seams don't look like open borders.
+	Vector<int> positions;
+	positions.resize(vertex_count);
+	Vector<int> wedge_count;
+	{
+		Map<Vector3, int> position_map;
+		for (int i = 0; i < vertex_count; i++) {
+
+			Map<Vector3, int>::Element *E = position_map.find(vertices[i]);
+			if (!E) {
+				E = position_map.insert(vertices[i], wedge_count.size());
+				wedge_count.push_back(0);
+			}
+			positions.write[i] = E->get();
+			if (referenced[i])
+				wedge_count.write[E->get()]++;
+		}
+	}
+
+	// Seam vertices, open borders and non manifold edges keep their place, which keeps
+	// silhouettes and texture seams intact between levels.
+	Vector<bool> locked;
+	locked.resize(vertex_count);
+	{
+		HashMap<uint64_t, int> edge_use;
+		for (int i = 0; i < index_count; i++) {
+
+			uint64_t a = positions[indices[i]];
+			uint64_t b = positions[indices[(i % 3 == 2) ? i - 2 : i + 1]];
+			if (a > b)
+				SWAP(a, b);
+			uint64_t key = (a << 32) | b;
+
+			int *count = edge_use.getptr(key);
+			if (count)
+				(*count)++;
+			else
+				edge_use.set(key, 1);
+		}
+
+		Vector<bool> border;
+		border.resize(wedge_count.size());
+		for (int i = 0; i < wedge_count.size(); i++) {
+			border.write[i] = wedge_count[i] > 1;
+		}
+
+		for (const uint64_t *K = edge_use.next(NULL); K; K = edge_use.next(K)) {
+			if (edge_use[*K] != 2) {
+				border.write[*K >> 32] = true;
+				border.write[*K & 0xFFFFFFFF] = true;
+			}
+		}
+
+		for (int i = 0; i < vertex_count; i++) {
+			locked.write[i] = border[positions[i]];
+		}
+	}
+
+	Vector<Quadric> quadrics;
+	quadrics.resize(wedge_count.size());
+	for (int i = 0; i < index_count; i += 3) {
+
+		const Vector3 &v0 = vertices[indices[i]];
+		Vector3 n = (vertices[indices[i + 1]] - v0).cross(vertices[indices[i + 2]] - v0);
+		real_t len = n.length();
+		if (len <= CMP_EPSILON * CMP_EPSILON)
+			continue;
+		n /= len;
+		real_t d = -n.dot(v0);
+
+		for (int j = 0; j < 3; j++) {
+			quadrics.write[positions[indices[i + j]]].add_plane(n, d);
+		}
+	}
+
+	double max_cost = p_max_error * diagonal;
+	max_cost *= max_cost;
+	double error = 0;
+
+	for (int i = 0; i < p_max_lods; i++) {
+
+		int previous_count = indices.size();
+		int target = int(previous_count * p_reduction) / 3 * 3;
+		if (target < MIN_LOD_INDICES)
+			break;
+
+		while (indices.size() > target) {
+			if (!_collapse_pass(vertices, vertex_count, indices, positions, locked, quadrics, target, max_cost, error))
+				break;
+		}
+
+		// Levels that barely reduce anything aren't worth the memory or a draw switch.
+		if (indices.size() > previous_count * 0.8)
+			break;
+
+		LOD lod;
+		lod.indices = indices;
+		lod.error = Math::sqrt(error) / diagonal;
+		lods.push_back(lod);
+	}
+
+	return lods;
+}
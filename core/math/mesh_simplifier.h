@@ -0,0 +1,79 @@
+/*************************************************************************/
+/*  mesh_simplifier.h                                                    */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2019 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2019 Godot Engine contributors (cf. AUTHORS.md)    */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#ifndef MESH_SIMPLIFIER_H
+#define MESH_SIMPLIFIER_H
+
+#include "core/math/vector3.h"
+#include "core/pool_vector.h"
+#include "core/vector.h"
+
+// Builds a chain of reduced index buffers for an indexed triangle mesh by collapsing edges
+// onto existing vertices, ordered by quadric error. Vertices are never moved or added, so
+// every level can be drawn with the original vertex buffer.
+class MeshSimplifier {
+
+public:
+	struct LOD {
+		Vector<int> indices;
+		float error; // largest collapse error, relative to the diagonal of the mesh bounds
+	};
+
+private:
+	struct Quadric {
+
+		double a2, ab, ac, ad;
+		double b2, bc, bd;
+		double c2, cd;
+		double d2;
+
+		void add_plane(const Vector3 &p_normal, real_t p_d);
+		void operator+=(const Quadric &p_q);
+		double evaluate(const Vector3 &p_pos) const;
+
+		Quadric();
+	};
+
+	struct Collapse {
+
+		int from;
+		int to;
+		double cost;
+
+		bool operator<(const Collapse &p_collapse) const { return cost < p_collapse.cost; }
+	};
+
+	static int _collapse_pass(const Vector3 *p_vertices, int p_vertex_count, Vector<int> &r_indices, const Vector<int> &p_positions, const Vector<bool> &p_locked, Vector<Quadric> &r_quadrics, int p_target_index_count, double p_max_cost, double &r_error);
+
+public:
+	static Vector<LOD> build_lods(const PoolVector<Vector3> &p_vertices, const PoolVector<int> &p_indices, int p_max_lods = 4, float p_reduction = 0.5, float p_max_error = 0.05);
+};
+
+#endif // MESH_SIMPLIFIER_H
@@ -381,6 +381,7 @@ public:
 	int get_subindex(OctreeElementID p_id) const;
 
 	int cull_convex(const Vector<Plane> &p_convex, T **p_result_array, int p_result_max, uint32_t p_mask = 0xFFFFFFFF);
+	int cull_convex(const Plane *p_planes, int p_plane_count, T **p_result_array, int p_result_max, uint32_t p_mask = 0xFFFFFFFF);
 	int cull_aabb(const AABB &p_aabb, T **p_result_array, int p_result_max, int *p_subindex_array = NULL, uint32_t p_mask = 0xFFFFFFFF);
 	int cull_segment(const Vector3 &p_from, const Vector3 &p_to, T **p_result_array, int p_result_max, int *p_subindex_array = NULL, uint32_t p_mask = 0xFFFFFFFF);
 
@@ -391,6 +392,7 @@ public:
 
 	int get_octant_count() const { return octant_count; }
 	int get_pair_count() const { return pair_count; }
+	int get_elem_count() const { return element_map.size(); }
 	Octree(real_t p_unit_size = 1.0);
 	~Octree() { _remove_tree(root); }
 };
@@ -1295,14 +1297,20 @@ void Octree<T, use_pairs, AL>::_cull_point(Octant *p_octant, const Vector3 &p_po
 template <class T, bool use_pairs, class AL>
 int Octree<T, use_pairs, AL>::cull_convex(const Vector<Plane> &p_convex, T **p_result_array, int p_result_max, uint32_t p_mask) {
 
+	return cull_convex(p_convex.ptr(), p_convex.size(), p_result_array, p_result_max, p_mask);
+}
+
+template <class T, bool use_pairs, class AL>
+int Octree<T, use_pairs, AL>::cull_convex(const Plane *p_planes, int p_plane_count, T **p_result_array, int p_result_max, uint32_t p_mask) {
+
 	if (!root)
 		return 0;
 
 	int result_count = 0;
 	pass++;
 	_CullConvexData cdata;
-	cdata.planes = &p_convex[0];
-	cdata.plane_count = p_convex.size();
+	cdata.planes = p_planes;
+	cdata.plane_count = p_plane_count;
 	cdata.result_array = p_result_array;
 	cdata.result_max = p_result_max;
 	cdata.result_idx = &result_count;
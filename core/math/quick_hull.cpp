@@ -30,6 +30,7 @@
 
 #include "quick_hull.h"
 
+#include "core/hash_map.h"
 #include "core/map.h"
 
 uint32_t QuickHull::debug_stop_after = 0xFFFFFFFF;
@@ -54,7 +55,7 @@ Error QuickHull::build(const Vector<Vector3> &p_points, Geometry::MeshData &r_me
 
 	Vector<bool> valid_points;
 	valid_points.resize(p_points.size());
-	Set<Vector3> valid_cache;
+	HashMap<Vector3, bool, PointHasher> valid_cache;
 
 	for (int i = 0; i < p_points.size(); i++) {
 
@@ -63,7 +64,7 @@ Error QuickHull::build(const Vector<Vector3> &p_points, Geometry::MeshData &r_me
 			valid_points.write[i] = false;
 		} else {
 			valid_points.write[i] = true;
-			valid_cache.insert(sp);
+			valid_cache.set(sp, true);
 		}
 	}
 
@@ -149,7 +150,13 @@ Error QuickHull::build(const Vector<Vector3> &p_points, Geometry::MeshData &r_me
 
 	//add faces
 
-	List<Face> faces;
+	// Faces live in a flat pool, slots of removed faces are recycled through a free list.
+	// Each face owns its three directed edges (in winding order), so the faces lit by a
+	// point can be found by walking over neighbors instead of testing the whole hull.
+	Vector<Face> faces;
+	Vector<uint32_t> face_mark; // FACE_REMOVED, or the iteration that last visited the face
+	Vector<int> free_faces;
+	HashMap<uint64_t, int> edge_owner;
 
 	for (int i = 0; i < 4; i++) {
 
@@ -175,7 +182,12 @@ Error QuickHull::build(const Vector<Vector3> &p_points, Geometry::MeshData &r_me
 
 		f.plane = p;
 
+		for (int j = 0; j < 3; j++) {
+			edge_owner.set(_directed_edge(f.vertices[j], f.vertices[(j + 1) % 3]), i);
+		}
+
 		faces.push_back(f);
+		face_mark.push_back(0);
 	}
 
 	real_t over_tolerance = 3 * UNIT_EPSILON * (aabb.size.x + aabb.size.y + aabb.size.z);
@@ -195,33 +207,59 @@ Error QuickHull::build(const Vector<Vector3> &p_points, Geometry::MeshData &r_me
 		if (!valid_points[i])
 			continue;
 
-		for (List<Face>::Element *E = faces.front(); E; E = E->next()) {
+		for (int j = 0; j < faces.size(); j++) {
 
-			if (E->get().plane.distance_to(p_points[i]) > over_tolerance) {
+			if (faces[j].plane.distance_to(p_points[i]) > over_tolerance) {
 
-				E->get().points_over.push_back(i);
+				faces.write[j].points_over.push_back(i);
 				break;
 			}
 		}
 	}
 
-	faces.sort(); // sort them, so the ones with points are in the back
+	// faces that still have points over them, the last one is processed first
+	Vector<int> pending;
+	for (int i = 0; i < faces.size(); i++) {
+		if (faces[i].points_over.size()) {
+			pending.push_back(i);
+		}
+	}
+
+	for (int i = 1; i < pending.size(); i++) {
+		// sort them, so the ones with most points are in the back
+		for (int j = i; j > 0 && faces[pending[j - 1]].points_over.size() > faces[pending[j]].points_over.size(); j--) {
+			SWAP(pending.write[j - 1], pending.write[j]);
+		}
+	}
 
 	/* BUILD HULL */
 
 	//poop face (while still remain)
 	//find further away point
-	//find lit faces
+	//find lit faces, flooding from the popped face
 	//determine horizon edges
 	//build new faces with horizon edges, them assign points side from all lit faces
 	//remove lit faces
 
 	uint32_t debug_stop = debug_stop_after;
+	uint32_t pass = 0;
+
+	Vector<int> lit_faces; //lit face is a death sentence
+	Vector<uint64_t> horizon;
+	Vector<int> new_faces;
 
-	while (debug_stop > 0 && faces.back()->get().points_over.size()) {
+	while (debug_stop > 0 && pending.size()) {
+
+		int fi = pending[pending.size() - 1];
+		pending.resize(pending.size() - 1);
+
+		if (face_mark[fi] == FACE_REMOVED || faces[fi].points_over.size() == 0) {
+			continue; // stale entry, the face was lit meanwhile
+		}
 
 		debug_stop--;
-		Face &f = faces.back()->get();
+		pass += 2; // visited faces are marked lit with pass, unlit with pass + 1
+		const Face &f = faces[fi];
 
 		//find vertex most outside
 		int next = -1;
@@ -239,55 +277,65 @@ Error QuickHull::build(const Vector<Vector3> &p_points, Geometry::MeshData &r_me
 
 		ERR_FAIL_COND_V(next == -1, ERR_BUG);
 
-		Vector3 v = p_points[f.points_over[next]];
+		int v_idx = f.points_over[next];
+		Vector3 v = p_points[v_idx];
 
-		//find lit faces and lit edges
-		List<List<Face>::Element *> lit_faces; //lit face is a death sentence
+		//find lit faces and horizon edges, the lit region is connected and contains the popped face
+		lit_faces.clear();
+		horizon.clear();
 
-		Map<Edge, FaceConnect> lit_edges; //create this on the flight, should not be that bad for performance and simplifies code a lot
+		lit_faces.push_back(fi);
+		face_mark.write[fi] = pass;
 
-		for (List<Face>::Element *E = faces.front(); E; E = E->next()) {
+		for (int i = 0; i < lit_faces.size(); i++) {
 
-			if (E->get().plane.distance_to(v) > 0) {
+			const Face &lf = faces[lit_faces[i]];
 
-				lit_faces.push_back(E);
+			for (int j = 0; j < 3; j++) {
+				uint32_t a = lf.vertices[j];
+				uint32_t b = lf.vertices[(j + 1) % 3];
 
-				for (int i = 0; i < 3; i++) {
-					uint32_t a = E->get().vertices[i];
-					uint32_t b = E->get().vertices[(i + 1) % 3];
-					Edge e(a, b);
+				const int *N = edge_owner.getptr(_directed_edge(b, a));
+				if (!N) {
+					horizon.push_back(_directed_edge(a, b)); //should not happen, only on degenerate input
+					continue;
+				}
 
-					Map<Edge, FaceConnect>::Element *F = lit_edges.find(e);
-					if (!F) {
-						F = lit_edges.insert(e, FaceConnect());
-					}
-					if (e.vertices[0] == a) {
-						//left
-						F->get().left = E;
-					} else {
+				int n = *N;
+				if (face_mark[n] == pass) {
+					continue; //edge is uninteresting, not on horizont
+				}
 
-						F->get().right = E;
+				if (face_mark[n] != pass + 1) {
+					if (faces[n].plane.distance_to(v) > 0) {
+						face_mark.write[n] = pass;
+						lit_faces.push_back(n);
+						continue;
 					}
+					face_mark.write[n] = pass + 1;
 				}
+
+				horizon.push_back(_directed_edge(a, b));
 			}
 		}
 
-		//create new faces from horizon edges
-		List<List<Face>::Element *> new_faces; //new faces
-
-		for (Map<Edge, FaceConnect>::Element *E = lit_edges.front(); E; E = E->next()) {
+		for (int i = 0; i < lit_faces.size(); i++) {
 
-			FaceConnect &fc = E->get();
-			if (fc.left && fc.right) {
-				continue; //edge is uninteresting, not on horizont
+			const Face &lf = faces[lit_faces[i]];
+			for (int j = 0; j < 3; j++) {
+				edge_owner.erase(_directed_edge(lf.vertices[j], lf.vertices[(j + 1) % 3]));
 			}
+		}
+
+		//create new faces from horizon edges, keeping the winding of the lit face they replace
+		new_faces.clear();
 
-			//create new face!
+		for (int i = 0; i < horizon.size(); i++) {
 
 			Face face;
-			face.vertices[0] = f.points_over[next];
-			face.vertices[1] = E->key().vertices[0];
-			face.vertices[2] = E->key().vertices[1];
+			face.vertices[0] = v_idx;
+			face.vertices[1] = uint32_t(horizon[i] >> 32);
+			face.vertices[2] = uint32_t(horizon[i] & 0xFFFFFFFF);
 
 			Plane p(p_points[face.vertices[0]], p_points[face.vertices[1]], p_points[face.vertices[2]]);
 
@@ -298,26 +346,43 @@ Error QuickHull::build(const Vector<Vector3> &p_points, Geometry::MeshData &r_me
 			}
 
 			face.plane = p;
-			new_faces.push_back(faces.push_back(face));
+
+			int idx;
+			if (free_faces.size()) {
+				idx = free_faces[free_faces.size() - 1];
+				free_faces.resize(free_faces.size() - 1);
+				faces.write[idx] = face;
+				face_mark.write[idx] = 0;
+			} else {
+				idx = faces.size();
+				faces.push_back(face);
+				face_mark.push_back(0);
+			}
+
+			for (int j = 0; j < 3; j++) {
+				edge_owner.set(_directed_edge(face.vertices[j], face.vertices[(j + 1) % 3]), idx);
+			}
+
+			new_faces.push_back(idx);
 		}
 
 		//distribute points into new faces
 
-		for (List<List<Face>::Element *>::Element *F = lit_faces.front(); F; F = F->next()) {
+		for (int i = 0; i < lit_faces.size(); i++) {
 
-			Face &lf = F->get()->get();
+			const Vector<int> &points_over = faces[lit_faces[i]].points_over;
 
-			for (int i = 0; i < lf.points_over.size(); i++) {
+			for (int j = 0; j < points_over.size(); j++) {
 
-				if (lf.points_over[i] == f.points_over[next]) //do not add current one
+				if (points_over[j] == v_idx) //do not add current one
 					continue;
 
-				Vector3 p = p_points[lf.points_over[i]];
-				for (List<List<Face>::Element *>::Element *E = new_faces.front(); E; E = E->next()) {
+				Vector3 p = p_points[points_over[j]];
+				for (int k = 0; k < new_faces.size(); k++) {
 
-					Face &f2 = E->get()->get();
+					Face &f2 = faces.write[new_faces[k]];
 					if (f2.plane.distance_to(p) > over_tolerance) {
-						f2.points_over.push_back(lf.points_over[i]);
+						f2.points_over.push_back(points_over[j]);
 						break;
 					}
 				}
@@ -326,19 +391,19 @@ Error QuickHull::build(const Vector<Vector3> &p_points, Geometry::MeshData &r_me
 
 		//erase lit faces
 
-		while (lit_faces.size()) {
+		for (int i = 0; i < lit_faces.size(); i++) {
 
-			faces.erase(lit_faces.front()->get());
-			lit_faces.pop_front();
+			faces.write[lit_faces[i]].points_over.clear();
+			face_mark.write[lit_faces[i]] = FACE_REMOVED;
+			free_faces.push_back(lit_faces[i]);
 		}
 
-		//put faces that contain no points on the front
+		//queue new faces that contain points
 
-		for (List<List<Face>::Element *>::Element *E = new_faces.front(); E; E = E->next()) {
+		for (int i = 0; i < new_faces.size(); i++) {
 
-			Face &f2 = E->get()->get();
-			if (f2.points_over.size() == 0) {
-				faces.move_to_front(E->get());
+			if (faces[new_faces[i]].points_over.size()) {
+				pending.push_back(new_faces[i]);
 			}
 		}
 
@@ -351,21 +416,27 @@ Error QuickHull::build(const Vector<Vector3> &p_points, Geometry::MeshData &r_me
 	Map<Edge, RetFaceConnect> ret_edges;
 	List<Geometry::MeshData::Face> ret_faces;
 
-	for (List<Face>::Element *E = faces.front(); E; E = E->next()) {
+	for (int fi = 0; fi < faces.size(); fi++) {
+
+		if (face_mark[fi] == FACE_REMOVED) {
+			continue;
+		}
+
+		const Face &face = faces[fi];
 
 		Geometry::MeshData::Face f;
-		f.plane = E->get().plane;
+		f.plane = face.plane;
 
 		for (int i = 0; i < 3; i++) {
-			f.indices.push_back(E->get().vertices[i]);
+			f.indices.push_back(face.vertices[i]);
 		}
 
 		List<Geometry::MeshData::Face>::Element *F = ret_faces.push_back(f);
 
 		for (int i = 0; i < 3; i++) {
 
-			uint32_t a = E->get().vertices[i];
-			uint32_t b = E->get().vertices[(i + 1) % 3];
+			uint32_t a = face.vertices[i];
+			uint32_t b = face.vertices[(i + 1) % 3];
 			Edge e(a, b);
 
 			Map<Edge, RetFaceConnect>::Element *G = ret_edges.find(e);
@@ -437,8 +508,13 @@ Error QuickHull::build(const Vector<Vector3> &p_points, Geometry::MeshData &r_me
 					}
 				}
 
-				// remove all edge connections to this face
-				for (Map<Edge, RetFaceConnect>::Element *G = ret_edges.front(); G; G = G->next()) {
+				// remove remaining edge connections to this face, only its own edges can point to it
+				for (int j = 0; j < ois; j++) {
+					Edge e2(O->get().indices[j], O->get().indices[(j + 1) % ois]);
+
+					Map<Edge, RetFaceConnect>::Element *G = ret_edges.find(e2);
+					if (!G)
+						continue;
 					if (G->get().left == O)
 						G->get().left = NULL;
 
@@ -474,3 +550,35 @@ Error QuickHull::build(const Vector<Vector3> &p_points, Geometry::MeshData &r_me
 
 	return OK;
 }
+
+Error QuickHull::build_vertices(const Vector<Vector3> &p_points, Vector<Vector3> &r_vertices) {
+
+	Geometry::MeshData md;
+	Error err = build(p_points, md);
+	if (err != OK) {
+		return err;
+	}
+
+	Vector<int> remap;
+	remap.resize(md.vertices.size());
+	for (int i = 0; i < remap.size(); i++) {
+		remap.write[i] = -1;
+	}
+
+	r_vertices.clear();
+
+	for (int i = 0; i < md.faces.size(); i++) {
+
+		const Geometry::MeshData::Face &f = md.faces[i];
+		for (int j = 0; j < f.indices.size(); j++) {
+
+			int idx = f.indices[j];
+			if (remap[idx] == -1) {
+				remap.write[idx] = r_vertices.size();
+				r_vertices.push_back(md.vertices[idx]);
+			}
+		}
+	}
+
+	return OK;
+}
@@ -34,7 +34,7 @@
 #include "core/list.h"
 #include "core/math/aabb.h"
 #include "core/math/geometry.h"
-#include "core/set.h"
+#include "core/hashfuncs.h"
 
 class QuickHull {
 
@@ -66,21 +66,25 @@ public:
 		Plane plane;
 		uint32_t vertices[3];
 		Vector<int> points_over;
-
-		bool operator<(const Face &p_face) const {
-
-			return points_over.size() < p_face.points_over.size();
-		}
 	};
 
 private:
-	struct FaceConnect {
-		List<Face>::Element *left, *right;
-		FaceConnect() {
-			left = NULL;
-			right = NULL;
+	enum {
+		FACE_REMOVED = 0xFFFFFFFF
+	};
+
+	struct PointHasher {
+		static _FORCE_INLINE_ uint32_t hash(const Vector3 &p_point) {
+			uint32_t h = hash_djb2_one_float(p_point.x);
+			h = hash_djb2_one_float(p_point.y, h);
+			return hash_djb2_one_float(p_point.z, h);
 		}
 	};
+
+	static _FORCE_INLINE_ uint64_t _directed_edge(uint32_t p_from, uint32_t p_to) {
+		return (uint64_t(p_from) << 32) | p_to;
+	}
+
 	struct RetFaceConnect {
 		List<Geometry::MeshData::Face>::Element *left, *right;
 		RetFaceConnect() {
@@ -92,6 +96,8 @@ private:
 public:
 	static uint32_t debug_stop_after;
 	static Error build(const Vector<Vector3> &p_points, Geometry::MeshData &r_mesh);
+	// Only keeps the points that end up as hull vertices, for shapes that store a point cloud.
+	static Error build_vertices(const Vector<Vector3> &p_points, Vector<Vector3> &r_vertices);
 };
 
 #endif // QUICK_HULL_H
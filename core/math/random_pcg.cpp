@@ -31,6 +31,10 @@
 #include "random_pcg.h"
 
 #include "core/os/os.h"
+#include "core/safe_refcount.h"
+
+bool RandomPCG::randomize_fixed = false;
+uint64_t RandomPCG::randomize_counter = 0;
 
 RandomPCG::RandomPCG(uint64_t p_seed, uint64_t p_inc) :
 		pcg(),
@@ -39,7 +43,13 @@ RandomPCG::RandomPCG(uint64_t p_seed, uint64_t p_inc) :
 }
 
 void RandomPCG::randomize() {
-	seed(OS::get_singleton()->get_ticks_usec() * pcg.state + PCG_DEFAULT_INC_64);
+	uint64_t base = randomize_fixed ? atomic_increment(&randomize_counter) : OS::get_singleton()->get_ticks_usec();
+	seed(base * pcg.state + PCG_DEFAULT_INC_64);
+}
+
+void RandomPCG::set_randomize_seed(uint64_t p_seed) {
+	randomize_counter = p_seed;
+	randomize_fixed = true;
 }
 
 double RandomPCG::random(double p_from, double p_to) {
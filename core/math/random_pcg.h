@@ -40,6 +40,9 @@ class RandomPCG {
 	uint64_t current_seed; // seed with this to get the same state
 	uint64_t current_inc;
 
+	static bool randomize_fixed;
+	static uint64_t randomize_counter;
+
 public:
 	static const uint64_t DEFAULT_SEED = 12047754176567800795U;
 	static const uint64_t DEFAULT_INC = PCG_DEFAULT_INC_64;
@@ -54,6 +57,8 @@ public:
 	_FORCE_INLINE_ uint64_t get_seed() { return current_seed; }
 
 	void randomize();
+	// Makes randomize() derive seeds from p_seed instead of the clock, so a run can be reproduced.
+	static void set_randomize_seed(uint64_t p_seed);
 	_FORCE_INLINE_ uint32_t rand() {
 		current_seed = pcg.state;
 		return pcg32_random_r(&pcg);
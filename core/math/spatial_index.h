@@ -0,0 +1,150 @@
+/*************************************************************************/
+/*  spatial_index.h                                                      */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2019 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2019 Godot Engine contributors (cf. AUTHORS.md)    */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#ifndef SPATIAL_INDEX_H
+#define SPATIAL_INDEX_H
+
+#include "core/math/dynamic_bvh.h"
+#include "core/math/octree.h"
+
+/**
+	Selects between Octree and DynamicBVH at runtime, forwarding the (shared) interface.
+	The backend can only be changed while empty.
+*/
+
+template <class T, bool use_pairs = false, class AL = DefaultAllocator>
+class SpatialIndex {
+public:
+	typedef typename Octree<T, use_pairs, AL>::PairCallback PairCallback;
+	typedef typename Octree<T, use_pairs, AL>::UnpairCallback UnpairCallback;
+
+private:
+	Octree<T, use_pairs, AL> octree;
+	DynamicBVH<T, use_pairs, AL> bvh;
+	bool use_bvh;
+
+public:
+	void set_use_bvh(bool p_enable) {
+		ERR_FAIL_COND(octree.get_elem_count() || bvh.get_elem_count());
+		use_bvh = p_enable;
+	}
+	bool is_using_bvh() const { return use_bvh; }
+
+	void set_bvh_fat_margin(real_t p_margin) { bvh.set_fat_margin(p_margin); }
+
+	_FORCE_INLINE_ OctreeElementID create(T *p_userdata, const AABB &p_aabb = AABB(), int p_subindex = 0, bool p_pairable = false, uint32_t p_pairable_type = 0, uint32_t p_pairable_mask = 1) {
+		if (use_bvh)
+			return bvh.create(p_userdata, p_aabb, p_subindex, p_pairable, p_pairable_type, p_pairable_mask);
+		return octree.create(p_userdata, p_aabb, p_subindex, p_pairable, p_pairable_type, p_pairable_mask);
+	}
+
+	_FORCE_INLINE_ void move(OctreeElementID p_id, const AABB &p_aabb) {
+		if (use_bvh)
+			bvh.move(p_id, p_aabb);
+		else
+			octree.move(p_id, p_aabb);
+	}
+
+	_FORCE_INLINE_ void set_pairable(OctreeElementID p_id, bool p_pairable = false, uint32_t p_pairable_type = 0, uint32_t p_pairable_mask = 1) {
+		if (use_bvh)
+			bvh.set_pairable(p_id, p_pairable, p_pairable_type, p_pairable_mask);
+		else
+			octree.set_pairable(p_id, p_pairable, p_pairable_type, p_pairable_mask);
+	}
+
+	_FORCE_INLINE_ void erase(OctreeElementID p_id) {
+		if (use_bvh)
+			bvh.erase(p_id);
+		else
+			octree.erase(p_id);
+	}
+
+	_FORCE_INLINE_ bool is_pairable(OctreeElementID p_id) const {
+		return use_bvh ? bvh.is_pairable(p_id) : octree.is_pairable(p_id);
+	}
+
+	_FORCE_INLINE_ T *get(OctreeElementID p_id) const {
+		return use_bvh ? bvh.get(p_id) : octree.get(p_id);
+	}
+
+	_FORCE_INLINE_ int get_subindex(OctreeElementID p_id) const {
+		return use_bvh ? bvh.get_subindex(p_id) : octree.get_subindex(p_id);
+	}
+
+	_FORCE_INLINE_ int cull_convex(const Vector<Plane> &p_convex, T **p_result_array, int p_result_max, uint32_t p_mask = 0xFFFFFFFF) {
+		if (use_bvh)
+			return bvh.cull_convex(p_convex, p_result_array, p_result_max, p_mask);
+		return octree.cull_convex(p_convex, p_result_array, p_result_max, p_mask);
+	}
+
+	_FORCE_INLINE_ int cull_convex(const Plane *p_planes, int p_plane_count, T **p_result_array, int p_result_max, uint32_t p_mask = 0xFFFFFFFF) {
+		if (use_bvh)
+			return bvh.cull_convex(p_planes, p_plane_count, p_result_array, p_result_max, p_mask);
+		return octree.cull_convex(p_planes, p_plane_count, p_result_array, p_result_max, p_mask);
+	}
+
+	_FORCE_INLINE_ int cull_aabb(const AABB &p_aabb, T **p_result_array, int p_result_max, int *p_subindex_array = NULL, uint32_t p_mask = 0xFFFFFFFF) {
+		if (use_bvh)
+			return bvh.cull_aabb(p_aabb, p_result_array, p_result_max, p_subindex_array, p_mask);
+		return octree.cull_aabb(p_aabb, p_result_array, p_result_max, p_subindex_array, p_mask);
+	}
+
+	_FORCE_INLINE_ int cull_segment(const Vector3 &p_from, const Vector3 &p_to, T **p_result_array, int p_result_max, int *p_subindex_array = NULL, uint32_t p_mask = 0xFFFFFFFF) {
+		if (use_bvh)
+			return bvh.cull_segment(p_from, p_to, p_result_array, p_result_max, p_subindex_array, p_mask);
+		return octree.cull_segment(p_from, p_to, p_result_array, p_result_max, p_subindex_array, p_mask);
+	}
+
+	_FORCE_INLINE_ int cull_point(const Vector3 &p_point, T **p_result_array, int p_result_max, int *p_subindex_array = NULL, uint32_t p_mask = 0xFFFFFFFF) {
+		if (use_bvh)
+			return bvh.cull_point(p_point, p_result_array, p_result_max, p_subindex_array, p_mask);
+		return octree.cull_point(p_point, p_result_array, p_result_max, p_subindex_array, p_mask);
+	}
+
+	void set_pair_callback(PairCallback p_callback, void *p_userdata) {
+		octree.set_pair_callback(p_callback, p_userdata);
+		bvh.set_pair_callback(p_callback, p_userdata);
+	}
+
+	void set_unpair_callback(UnpairCallback p_callback, void *p_userdata) {
+		octree.set_unpair_callback(p_callback, p_userdata);
+		bvh.set_unpair_callback(p_callback, p_userdata);
+	}
+
+	int get_elem_count() const { return use_bvh ? bvh.get_elem_count() : octree.get_elem_count(); }
+	int get_pair_count() const { return use_bvh ? bvh.get_pair_count() : octree.get_pair_count(); }
+
+	SpatialIndex(real_t p_unit_size = 1.0) :
+			octree(p_unit_size) {
+		use_bvh = false;
+	}
+};
+
+#endif // SPATIAL_INDEX_H
@@ -30,63 +30,162 @@
 
 #include "triangle_mesh.h"
 
-#include "core/sort_array.h"
+#include "core/os/mutex.h"
+#include "core/os/thread_work_pool.h"
 
-int TriangleMesh::_create_bvh(BVH *p_bvh, BVH **p_bb, int p_from, int p_size, int p_depth, int &max_depth, int &max_alloc) {
+ThreadWorkPool *TriangleMesh::build_pool = NULL;
+Mutex *TriangleMesh::build_mutex = NULL;
 
-	if (p_depth > max_depth) {
-		max_depth = p_depth;
-	}
+struct TriangleMesh::BVHBuild {
+
+	BVH *nodes;
+	int *faces;
+	const AABB *face_aabbs;
+	const Vector3 *face_centers;
+	Vector<BVHBuildTask> tasks;
+};
 
-	if (p_size == 1) {
+static _FORCE_INLINE_ real_t _bvh_half_area(const AABB &p_aabb) {
+
+	const Vector3 &s = p_aabb.size;
+	return s.x * s.y + s.y * s.z + s.z * s.x;
+}
 
-		return p_bb[p_from] - p_bvh;
-	} else if (p_size == 0) {
+// A subtree over p_count faces never takes more than 2 * p_count - 1 nodes, so
+// every subtree gets that many slots starting at p_node and the right child
+// goes right after the slots of the left one. Subtrees never share slots, which
+// lets them be built in parallel; unused slots are compacted out afterwards.
+void TriangleMesh::_create_bvh(BVHBuild &p_build, int p_from, int p_count, int p_node, int p_task_depth) {
 
-		return -1;
+	int *faces = &p_build.faces[p_from];
+
+	if (p_task_depth == 0) {
+
+		BVHBuildTask task;
+		task.from = p_from;
+		task.count = p_count;
+		task.node = p_node;
+		p_build.tasks.push_back(task);
+		return;
 	}
 
-	AABB aabb;
-	aabb = p_bb[p_from]->aabb;
-	for (int i = 1; i < p_size; i++) {
+	AABB aabb = p_build.face_aabbs[faces[0]];
+	AABB centers(p_build.face_centers[faces[0]], Vector3());
+	for (int i = 1; i < p_count; i++) {
 
-		aabb.merge_with(p_bb[p_from + i]->aabb);
+		aabb.merge_with(p_build.face_aabbs[faces[i]]);
+		centers.expand_to(p_build.face_centers[faces[i]]);
 	}
 
-	int li = aabb.get_longest_axis_index();
-
-	switch (li) {
-
-		case Vector3::AXIS_X: {
-			SortArray<BVH *, BVHCmpX> sort_x;
-			sort_x.nth_element(0, p_size, p_size / 2, &p_bb[p_from]);
-			//sort_x.sort(&p_bb[p_from],p_size);
-		} break;
-		case Vector3::AXIS_Y: {
-			SortArray<BVH *, BVHCmpY> sort_y;
-			sort_y.nth_element(0, p_size, p_size / 2, &p_bb[p_from]);
-			//sort_y.sort(&p_bb[p_from],p_size);
-		} break;
-		case Vector3::AXIS_Z: {
-			SortArray<BVH *, BVHCmpZ> sort_z;
-			sort_z.nth_element(0, p_size, p_size / 2, &p_bb[p_from]);
-			//sort_z.sort(&p_bb[p_from],p_size);
-
-		} break;
+	BVH &node = p_build.nodes[p_node];
+	node.aabb = aabb;
+	node.escape = p_node + p_count * 2 - 1;
+
+	int best_axis = -1;
+	int best_bin = 0;
+
+	if (p_count > 1) {
+
+		// binned surface area heuristic, with traversal and triangle tests costing the same
+		real_t best_cost = 1e20;
+		real_t area = _bvh_half_area(aabb);
+		real_t inv_area = area > CMP_EPSILON ? 1.0 / area : 0.0;
+
+		for (int axis = 0; axis < 3; axis++) {
+
+			real_t extent = centers.size[axis];
+			if (extent <= CMP_EPSILON) {
+				continue;
+			}
+
+			AABB bin_aabbs[BVH_BINS];
+			int bin_counts[BVH_BINS] = {};
+			real_t bin_scale = BVH_BINS / extent;
+
+			for (int i = 0; i < p_count; i++) {
+
+				int bin = MIN(int((p_build.face_centers[faces[i]][axis] - centers.position[axis]) * bin_scale), BVH_BINS - 1);
+				if (bin_counts[bin]++ == 0) {
+					bin_aabbs[bin] = p_build.face_aabbs[faces[i]];
+				} else {
+					bin_aabbs[bin].merge_with(p_build.face_aabbs[faces[i]]);
+				}
+			}
+
+			// sweep from the right to get the cost of everything past each plane
+			real_t right_cost[BVH_BINS];
+			AABB right_aabb;
+			int right_count = 0;
+			for (int i = BVH_BINS - 1; i > 0; i--) {
+
+				if (bin_counts[i]) {
+					right_aabb = right_count ? right_aabb.merge(bin_aabbs[i]) : bin_aabbs[i];
+					right_count += bin_counts[i];
+				}
+				right_cost[i] = _bvh_half_area(right_aabb) * right_count;
+			}
+
+			AABB left_aabb;
+			int left_count = 0;
+			for (int i = 0; i < BVH_BINS - 1; i++) {
+
+				if (bin_counts[i]) {
+					left_aabb = left_count ? left_aabb.merge(bin_aabbs[i]) : bin_aabbs[i];
+					left_count += bin_counts[i];
+				}
+				if (left_count == 0 || left_count == p_count) {
+					continue;
+				}
+
+				real_t cost = 1.0 + (_bvh_half_area(left_aabb) * left_count + right_cost[i + 1]) * inv_area;
+				if (cost < best_cost) {
+					best_cost = cost;
+					best_axis = axis;
+					best_bin = i;
+				}
+			}
+		}
+
+		if (p_count > BVH_MAX_LEAF_FACES || (best_axis != -1 && best_cost < p_count)) {
+
+			int left_count = 0;
+
+			if (best_axis != -1) {
+
+				real_t bin_scale = BVH_BINS / centers.size[best_axis];
+				for (int i = 0; i < p_count; i++) {
+
+					int bin = MIN(int((p_build.face_centers[faces[i]][best_axis] - centers.position[best_axis]) * bin_scale), BVH_BINS - 1);
+					if (bin <= best_bin) {
+						SWAP(faces[i], faces[left_count]);
+						left_count++;
+					}
+				}
+			}
+
+			if (left_count == 0 || left_count == p_count) {
+				// every center is in the same spot, any split is as good as another
+				left_count = p_count / 2;
+			}
+
+			node.face_index = -1;
+			node.face_count = 0;
+
+			int child_task_depth = p_task_depth > 0 ? p_task_depth - 1 : p_task_depth;
+			_create_bvh(p_build, p_from, left_count, p_node + 1, child_task_depth);
+			_create_bvh(p_build, p_from + left_count, p_count - left_count, p_node + left_count * 2, child_task_depth);
+			return;
+		}
 	}
 
-	int left = _create_bvh(p_bvh, p_bb, p_from, p_size / 2, p_depth + 1, max_depth, max_alloc);
-	int right = _create_bvh(p_bvh, p_bb, p_from + p_size / 2, p_size - p_size / 2, p_depth + 1, max_depth, max_alloc);
+	node.face_index = p_from;
+	node.face_count = p_count;
+}
 
-	int index = max_alloc++;
-	BVH *_new = &p_bvh[index];
-	_new->aabb = aabb;
-	_new->center = aabb.position + aabb.size * 0.5;
-	_new->face_index = -1;
-	_new->left = left;
-	_new->right = right;
+void TriangleMesh::_build_bvh_task(uint32_t p_index, BVHBuild *p_build) {
 
-	return index;
+	const BVHBuildTask &task = p_build->tasks[p_index];
+	_create_bvh(*p_build, task.from, task.count, task.node, -1);
 }
 
 void TriangleMesh::get_indices(PoolVector<int> *r_triangles_indices) const {
@@ -118,163 +217,200 @@ void TriangleMesh::create(const PoolVector<Vector3> &p_faces) {
 	fc /= 3;
 	triangles.resize(fc);
 
-	bvh.resize(fc * 3); //will never be larger than this (todo make better)
-	PoolVector<BVH>::Write bw = bvh.write();
+	Vector<AABB> face_aabbs;
+	Vector<Vector3> face_centers;
+	face_aabbs.resize(fc);
+	face_centers.resize(fc);
 
 	{
 
-		//create faces and indices and base bvh
-		//except for the Set for repeated triangles, everything
-		//goes in-place.
+		//create faces and indices, merging repeated vertices by sorting them
+		//and numbering them in order of first appearance
+
+		struct VertexSort {
+
+			Vector3 vertex;
+			int index;
+
+			bool operator<(const VertexSort &p_other) const {
+
+				if (vertex == p_other.vertex) {
+					return index < p_other.index;
+				}
+				return vertex < p_other.vertex;
+			}
+		};
 
 		PoolVector<Vector3>::Read r = p_faces.read();
+		int vc = fc * 3;
+
+		Vector<VertexSort> sorted;
+		sorted.resize(vc);
+		for (int i = 0; i < vc; i++) {
+
+			sorted.write[i].vertex = r[i].snapped(Vector3(0.0001, 0.0001, 0.0001));
+			sorted.write[i].index = i;
+		}
+		sorted.sort();
+
+		// first[i] is the first place the vertex at i appears in
+		Vector<int> first;
+		first.resize(vc);
+		for (int i = 0; i < vc; i++) {
+
+			first.write[sorted[i].index] = (i > 0 && sorted[i].vertex == sorted[i - 1].vertex) ? first[sorted[i - 1].index] : sorted[i].index;
+		}
+
+		Vector<int> ids;
+		ids.resize(vc);
+		int vertex_count = 0;
+		for (int i = 0; i < vc; i++) {
+
+			ids.write[i] = first[i] == i ? vertex_count++ : ids[first[i]];
+		}
+
+		vertices.resize(vertex_count);
+		PoolVector<Vector3>::Write vw = vertices.write();
 		PoolVector<Triangle>::Write w = triangles.write();
-		Map<Vector3, int> db;
 
 		for (int i = 0; i < fc; i++) {
 
 			Triangle &f = w[i];
-			const Vector3 *v = &r[i * 3];
 
 			for (int j = 0; j < 3; j++) {
 
-				int vidx = -1;
-				Vector3 vs = v[j].snapped(Vector3(0.0001, 0.0001, 0.0001));
-				Map<Vector3, int>::Element *E = db.find(vs);
-				if (E) {
-					vidx = E->get();
-				} else {
-					vidx = db.size();
-					db[vs] = vidx;
-				}
+				int vidx = ids[i * 3 + j];
+				Vector3 vs = r[i * 3 + j].snapped(Vector3(0.0001, 0.0001, 0.0001));
+				vw[vidx] = vs;
 
 				f.indices[j] = vidx;
 				if (j == 0)
-					bw[i].aabb.position = vs;
+					face_aabbs.write[i].position = vs;
 				else
-					bw[i].aabb.expand_to(vs);
+					face_aabbs.write[i].expand_to(vs);
 			}
 
 			f.normal = Face3(r[i * 3 + 0], r[i * 3 + 1], r[i * 3 + 2]).get_plane().get_normal();
+			face_centers.write[i] = face_aabbs[i].position + face_aabbs[i].size * 0.5;
+		}
+	}
+
+	PoolVector<BVH> nodes;
+	nodes.resize(fc * 2 - 1);
+	bvh_faces.resize(fc);
 
-			bw[i].left = -1;
-			bw[i].right = -1;
-			bw[i].face_index = i;
-			bw[i].center = bw[i].aabb.position + bw[i].aabb.size * 0.5;
+	{
+		PoolVector<BVH>::Write nw = nodes.write();
+		PoolVector<int>::Write fw = bvh_faces.write();
+
+		for (int i = 0; i < fc * 2 - 1; i++) {
+			nw[i].face_count = -1; // unused slot
+		}
+		for (int i = 0; i < fc; i++) {
+			fw[i] = i;
 		}
 
-		vertices.resize(db.size());
-		PoolVector<Vector3>::Write vw = vertices.write();
-		for (Map<Vector3, int>::Element *E = db.front(); E; E = E->next()) {
-			vw[E->get()] = E->key();
+		BVHBuild build;
+		build.nodes = nw.ptr();
+		build.faces = fw.ptr();
+		build.face_aabbs = face_aabbs.ptr();
+		build.face_centers = face_centers.ptr();
+
+		bool threaded = fc >= BVH_THREADED_MIN_FACES && build_mutex && build_mutex->try_lock() == OK;
+
+		if (threaded) {
+
+			// split the top levels here, then build the subtrees on the pool
+			int task_depth = 1;
+			while ((1 << task_depth) < build_pool->get_thread_count() * 4) {
+				task_depth++;
+			}
+			_create_bvh(build, 0, fc, 0, task_depth);
+			build_pool->do_work(build.tasks.size(), this, &TriangleMesh::_build_bvh_task, &build);
+			build_mutex->unlock();
+		} else {
+			_create_bvh(build, 0, fc, 0, -1);
 		}
 	}
 
-	PoolVector<BVH *> bwptrs;
-	bwptrs.resize(fc);
-	PoolVector<BVH *>::Write bwp = bwptrs.write();
-	for (int i = 0; i < fc; i++) {
+	{
+		// compact the used slots, escape indices may point at unused slots so
+		// they are remapped to the first used one after them
 
-		bwp[i] = &bw[i];
-	}
+		PoolVector<BVH>::Write nw = nodes.write();
+
+		Vector<int> remap;
+		remap.resize(fc * 2);
+		int node_count = 0;
+		for (int i = 0; i < fc * 2 - 1; i++) {
+
+			remap.write[i] = node_count;
+			if (nw[i].face_count >= 0) {
+				node_count++;
+			}
+		}
+		remap.write[fc * 2 - 1] = node_count;
 
-	max_depth = 0;
-	int max_alloc = fc;
-	_create_bvh(bw.ptr(), bwp.ptr(), 0, fc, 1, max_depth, max_alloc);
+		bvh.resize(node_count);
+		PoolVector<BVH>::Write bw = bvh.write();
+		for (int i = 0; i < fc * 2 - 1; i++) {
 
-	bw = PoolVector<BVH>::Write(); //clearup
-	bvh.resize(max_alloc); //resize back
+			if (nw[i].face_count >= 0) {
+				BVH &b = bw[remap[i]];
+				b = nw[i];
+				b.escape = remap[b.escape];
+			}
+		}
+	}
 
 	valid = true;
 }
 
 Vector3 TriangleMesh::get_area_normal(const AABB &p_aabb) const {
 
-	uint32_t *stack = (uint32_t *)alloca(sizeof(int) * max_depth);
-
-	enum {
-		TEST_AABB_BIT = 0,
-		VISIT_LEFT_BIT = 1,
-		VISIT_RIGHT_BIT = 2,
-		VISIT_DONE_BIT = 3,
-		VISITED_BIT_SHIFT = 29,
-		NODE_IDX_MASK = (1 << VISITED_BIT_SHIFT) - 1,
-		VISITED_BIT_MASK = ~NODE_IDX_MASK,
-
-	};
-
 	int n_count = 0;
 	Vector3 n;
 
-	int level = 0;
-
 	PoolVector<Triangle>::Read trianglesr = triangles.read();
 	PoolVector<Vector3>::Read verticesr = vertices.read();
 	PoolVector<BVH>::Read bvhr = bvh.read();
+	PoolVector<int>::Read facesr = bvh_faces.read();
 
 	const Triangle *triangleptr = trianglesr.ptr();
-	int pos = bvh.size() - 1;
+	const Vector3 *vertexptr = verticesr.ptr();
 	const BVH *bvhptr = bvhr.ptr();
+	const int *faceptr = facesr.ptr();
+	int node_count = bvh.size();
 
-	stack[0] = pos;
-	while (true) {
+	int node = 0;
+	while (node < node_count) {
 
-		uint32_t node = stack[level] & NODE_IDX_MASK;
 		const BVH &b = bvhptr[node];
-		bool done = false;
-
-		switch (stack[level] >> VISITED_BIT_SHIFT) {
-			case TEST_AABB_BIT: {
-
-				bool valid = b.aabb.intersects(p_aabb);
-				if (!valid) {
-
-					stack[level] = (VISIT_DONE_BIT << VISITED_BIT_SHIFT) | node;
-
-				} else {
 
-					if (b.face_index >= 0) {
-
-						const Triangle &s = triangleptr[b.face_index];
-						n += s.normal;
-						n_count++;
-
-						stack[level] = (VISIT_DONE_BIT << VISITED_BIT_SHIFT) | node;
-
-					} else {
+		if (!b.aabb.intersects(p_aabb)) {
+			node = b.escape;
+			continue;
+		}
 
-						stack[level] = (VISIT_LEFT_BIT << VISITED_BIT_SHIFT) | node;
-					}
-				}
-				continue;
-			}
-			case VISIT_LEFT_BIT: {
+		if (b.face_count == 0) {
+			node++;
+			continue;
+		}
 
-				stack[level] = (VISIT_RIGHT_BIT << VISITED_BIT_SHIFT) | node;
-				stack[level + 1] = b.left | TEST_AABB_BIT;
-				level++;
-				continue;
-			}
-			case VISIT_RIGHT_BIT: {
+		for (int i = 0; i < b.face_count; i++) {
 
-				stack[level] = (VISIT_DONE_BIT << VISITED_BIT_SHIFT) | node;
-				stack[level + 1] = b.right | TEST_AABB_BIT;
-				level++;
-				continue;
-			}
-			case VISIT_DONE_BIT: {
+			const Triangle &s = triangleptr[faceptr[b.face_index + i]];
+			AABB face_aabb(vertexptr[s.indices[0]], Vector3());
+			face_aabb.expand_to(vertexptr[s.indices[1]]);
+			face_aabb.expand_to(vertexptr[s.indices[2]]);
 
-				if (level == 0) {
-					done = true;
-					break;
-				} else
-					level--;
-				continue;
+			if (face_aabb.intersects(p_aabb)) {
+				n += s.normal;
+				n_count++;
 			}
 		}
 
-		if (done)
-			break;
+		node = b.escape;
 	}
 
 	if (n_count > 0)
@@ -283,110 +419,100 @@ Vector3 TriangleMesh::get_area_normal(const AABB &p_aabb) const {
 	return n;
 }
 
-bool TriangleMesh::intersect_segment(const Vector3 &p_begin, const Vector3 &p_end, Vector3 &r_point, Vector3 &r_normal) const {
+// Slab test against a segment given as origin + direction * t, with the
+// reciprocal of the direction computed once per query.
+struct _TriangleMeshRayTest {
+
+	Vector3 from;
+	Vector3 inv_dir;
+
+	_FORCE_INLINE_ bool intersects(const AABB &p_aabb, real_t p_max) const {
+
+		real_t t_min = 0;
+		real_t t_max = p_max;
+
+		for (int i = 0; i < 3; i++) {
+
+			real_t t0 = (p_aabb.position[i] - from[i]) * inv_dir[i];
+			real_t t1 = (p_aabb.position[i] + p_aabb.size[i] - from[i]) * inv_dir[i];
+			t_min = MAX(t_min, MIN(t0, t1));
+			t_max = MIN(t_max, MAX(t0, t1));
+		}
 
-	uint32_t *stack = (uint32_t *)alloca(sizeof(int) * max_depth);
+		return t_min <= t_max;
+	}
 
-	enum {
-		TEST_AABB_BIT = 0,
-		VISIT_LEFT_BIT = 1,
-		VISIT_RIGHT_BIT = 2,
-		VISIT_DONE_BIT = 3,
-		VISITED_BIT_SHIFT = 29,
-		NODE_IDX_MASK = (1 << VISITED_BIT_SHIFT) - 1,
-		VISITED_BIT_MASK = ~NODE_IDX_MASK,
+	_TriangleMeshRayTest(const Vector3 &p_from, const Vector3 &p_dir) {
 
-	};
+		from = p_from;
+		for (int i = 0; i < 3; i++) {
+			// a huge value instead of infinity keeps zero times zero out of the slab test
+			inv_dir[i] = Math::abs(p_dir[i]) > CMP_EPSILON ? 1.0 / p_dir[i] : (p_dir[i] < 0 ? -1e30 : 1e30);
+		}
+	}
+};
+
+bool TriangleMesh::intersect_segment(const Vector3 &p_begin, const Vector3 &p_end, Vector3 &r_point, Vector3 &r_normal) const {
 
 	Vector3 n = (p_end - p_begin).normalized();
 	real_t d = 1e10;
 	bool inters = false;
 
-	int level = 0;
-
 	PoolVector<Triangle>::Read trianglesr = triangles.read();
 	PoolVector<Vector3>::Read verticesr = vertices.read();
 	PoolVector<BVH>::Read bvhr = bvh.read();
+	PoolVector<int>::Read facesr = bvh_faces.read();
 
 	const Triangle *triangleptr = trianglesr.ptr();
 	const Vector3 *vertexptr = verticesr.ptr();
-	int pos = bvh.size() - 1;
 	const BVH *bvhptr = bvhr.ptr();
+	const int *faceptr = facesr.ptr();
+	int node_count = bvh.size();
 
-	stack[0] = pos;
-	while (true) {
+	// nodes further away than the closest hit so far are skipped
+	_TriangleMeshRayTest test(p_begin, p_end - p_begin);
+	real_t max_t = 1.0;
+	real_t length = p_begin.distance_to(p_end);
 
-		uint32_t node = stack[level] & NODE_IDX_MASK;
-		const BVH &b = bvhptr[node];
-		bool done = false;
-
-		switch (stack[level] >> VISITED_BIT_SHIFT) {
-			case TEST_AABB_BIT: {
-
-				bool valid = b.aabb.intersects_segment(p_begin, p_end);
-				//bool valid = b.aabb.intersects(ray_aabb);
-
-				if (!valid) {
-
-					stack[level] = (VISIT_DONE_BIT << VISITED_BIT_SHIFT) | node;
-
-				} else {
+	int node = 0;
+	while (node < node_count) {
 
-					if (b.face_index >= 0) {
+		const BVH &b = bvhptr[node];
 
-						const Triangle &s = triangleptr[b.face_index];
-						Face3 f3(vertexptr[s.indices[0]], vertexptr[s.indices[1]], vertexptr[s.indices[2]]);
+		if (!test.intersects(b.aabb, max_t)) {
+			node = b.escape;
+			continue;
+		}
 
-						Vector3 res;
+		if (b.face_count == 0) {
+			node++;
+			continue;
+		}
 
-						if (f3.intersects_segment(p_begin, p_end, &res)) {
+		for (int i = 0; i < b.face_count; i++) {
 
-							real_t nd = n.dot(res);
-							if (nd < d) {
+			const Triangle &s = triangleptr[faceptr[b.face_index + i]];
+			Face3 f3(vertexptr[s.indices[0]], vertexptr[s.indices[1]], vertexptr[s.indices[2]]);
 
-								d = nd;
-								r_point = res;
-								r_normal = f3.get_plane().get_normal();
-								inters = true;
-							}
-						}
+			Vector3 res;
 
-						stack[level] = (VISIT_DONE_BIT << VISITED_BIT_SHIFT) | node;
+			if (f3.intersects_segment(p_begin, p_end, &res)) {
 
-					} else {
+				real_t nd = n.dot(res);
+				if (nd < d) {
 
-						stack[level] = (VISIT_LEFT_BIT << VISITED_BIT_SHIFT) | node;
+					d = nd;
+					r_point = res;
+					r_normal = f3.get_plane().get_normal();
+					inters = true;
+					if (length > CMP_EPSILON) {
+						max_t = MIN(max_t, p_begin.distance_to(res) / length + CMP_EPSILON);
 					}
 				}
-				continue;
-			}
-			case VISIT_LEFT_BIT: {
-
-				stack[level] = (VISIT_RIGHT_BIT << VISITED_BIT_SHIFT) | node;
-				stack[level + 1] = b.left | TEST_AABB_BIT;
-				level++;
-				continue;
-			}
-			case VISIT_RIGHT_BIT: {
-
-				stack[level] = (VISIT_DONE_BIT << VISITED_BIT_SHIFT) | node;
-				stack[level + 1] = b.right | TEST_AABB_BIT;
-				level++;
-				continue;
-			}
-			case VISIT_DONE_BIT: {
-
-				if (level == 0) {
-					done = true;
-					break;
-				} else
-					level--;
-				continue;
 			}
 		}
 
-		if (done)
-			break;
+		node = b.escape;
 	}
 
 	if (inters) {
@@ -400,106 +526,64 @@ bool TriangleMesh::intersect_segment(const Vector3 &p_begin, const Vector3 &p_en
 
 bool TriangleMesh::intersect_ray(const Vector3 &p_begin, const Vector3 &p_dir, Vector3 &r_point, Vector3 &r_normal) const {
 
-	uint32_t *stack = (uint32_t *)alloca(sizeof(int) * max_depth);
-
-	enum {
-		TEST_AABB_BIT = 0,
-		VISIT_LEFT_BIT = 1,
-		VISIT_RIGHT_BIT = 2,
-		VISIT_DONE_BIT = 3,
-		VISITED_BIT_SHIFT = 29,
-		NODE_IDX_MASK = (1 << VISITED_BIT_SHIFT) - 1,
-		VISITED_BIT_MASK = ~NODE_IDX_MASK,
-
-	};
-
 	Vector3 n = p_dir;
 	real_t d = 1e20;
 	bool inters = false;
 
-	int level = 0;
-
 	PoolVector<Triangle>::Read trianglesr = triangles.read();
 	PoolVector<Vector3>::Read verticesr = vertices.read();
 	PoolVector<BVH>::Read bvhr = bvh.read();
+	PoolVector<int>::Read facesr = bvh_faces.read();
 
 	const Triangle *triangleptr = trianglesr.ptr();
 	const Vector3 *vertexptr = verticesr.ptr();
-	int pos = bvh.size() - 1;
 	const BVH *bvhptr = bvhr.ptr();
+	const int *faceptr = facesr.ptr();
+	int node_count = bvh.size();
 
-	stack[0] = pos;
-	while (true) {
-
-		uint32_t node = stack[level] & NODE_IDX_MASK;
-		const BVH &b = bvhptr[node];
-		bool done = false;
+	_TriangleMeshRayTest test(p_begin, p_dir);
+	real_t max_t = 1e20;
+	real_t dir_length_squared = p_dir.length_squared();
 
-		switch (stack[level] >> VISITED_BIT_SHIFT) {
-			case TEST_AABB_BIT: {
+	int node = 0;
+	while (node < node_count) {
 
-				bool valid = b.aabb.intersects_ray(p_begin, p_dir);
-				if (!valid) {
-
-					stack[level] = (VISIT_DONE_BIT << VISITED_BIT_SHIFT) | node;
+		const BVH &b = bvhptr[node];
 
-				} else {
+		if (!test.intersects(b.aabb, max_t)) {
+			node = b.escape;
+			continue;
+		}
 
-					if (b.face_index >= 0) {
+		if (b.face_count == 0) {
+			node++;
+			continue;
+		}
 
-						const Triangle &s = triangleptr[b.face_index];
-						Face3 f3(vertexptr[s.indices[0]], vertexptr[s.indices[1]], vertexptr[s.indices[2]]);
+		for (int i = 0; i < b.face_count; i++) {
 
-						Vector3 res;
+			const Triangle &s = triangleptr[faceptr[b.face_index + i]];
+			Face3 f3(vertexptr[s.indices[0]], vertexptr[s.indices[1]], vertexptr[s.indices[2]]);
 
-						if (f3.intersects_ray(p_begin, p_dir, &res)) {
+			Vector3 res;
 
-							real_t nd = n.dot(res);
-							if (nd < d) {
+			if (f3.intersects_ray(p_begin, p_dir, &res)) {
 
-								d = nd;
-								r_point = res;
-								r_normal = f3.get_plane().get_normal();
-								inters = true;
-							}
-						}
+				real_t nd = n.dot(res);
+				if (nd < d) {
 
-						stack[level] = (VISIT_DONE_BIT << VISITED_BIT_SHIFT) | node;
-
-					} else {
-
-						stack[level] = (VISIT_LEFT_BIT << VISITED_BIT_SHIFT) | node;
+					d = nd;
+					r_point = res;
+					r_normal = f3.get_plane().get_normal();
+					inters = true;
+					if (dir_length_squared > CMP_EPSILON) {
+						max_t = MIN(max_t, p_dir.dot(res - p_begin) / dir_length_squared * (1.0 + CMP_EPSILON) + CMP_EPSILON);
 					}
 				}
-				continue;
-			}
-			case VISIT_LEFT_BIT: {
-
-				stack[level] = (VISIT_RIGHT_BIT << VISITED_BIT_SHIFT) | node;
-				stack[level + 1] = b.left | TEST_AABB_BIT;
-				level++;
-				continue;
-			}
-			case VISIT_RIGHT_BIT: {
-
-				stack[level] = (VISIT_DONE_BIT << VISITED_BIT_SHIFT) | node;
-				stack[level + 1] = b.right | TEST_AABB_BIT;
-				level++;
-				continue;
-			}
-			case VISIT_DONE_BIT: {
-
-				if (level == 0) {
-					done = true;
-					break;
-				} else
-					level--;
-				continue;
 			}
 		}
 
-		if (done)
-			break;
+		node = b.escape;
 	}
 
 	if (inters) {
@@ -512,216 +596,120 @@ bool TriangleMesh::intersect_ray(const Vector3 &p_begin, const Vector3 &p_dir, V
 }
 
 bool TriangleMesh::intersect_convex_shape(const Plane *p_planes, int p_plane_count) const {
-	uint32_t *stack = (uint32_t *)alloca(sizeof(int) * max_depth);
-
-	//p_fully_inside = true;
-
-	enum {
-		TEST_AABB_BIT = 0,
-		VISIT_LEFT_BIT = 1,
-		VISIT_RIGHT_BIT = 2,
-		VISIT_DONE_BIT = 3,
-		VISITED_BIT_SHIFT = 29,
-		NODE_IDX_MASK = (1 << VISITED_BIT_SHIFT) - 1,
-		VISITED_BIT_MASK = ~NODE_IDX_MASK,
-
-	};
-
-	int level = 0;
 
 	PoolVector<Triangle>::Read trianglesr = triangles.read();
 	PoolVector<Vector3>::Read verticesr = vertices.read();
 	PoolVector<BVH>::Read bvhr = bvh.read();
+	PoolVector<int>::Read facesr = bvh_faces.read();
 
 	const Triangle *triangleptr = trianglesr.ptr();
 	const Vector3 *vertexptr = verticesr.ptr();
-	int pos = bvh.size() - 1;
 	const BVH *bvhptr = bvhr.ptr();
+	const int *faceptr = facesr.ptr();
+	int node_count = bvh.size();
 
-	stack[0] = pos;
-	while (true) {
+	int node = 0;
+	while (node < node_count) {
 
-		uint32_t node = stack[level] & NODE_IDX_MASK;
 		const BVH &b = bvhptr[node];
-		bool done = false;
-
-		switch (stack[level] >> VISITED_BIT_SHIFT) {
-			case TEST_AABB_BIT: {
 
-				bool valid = b.aabb.intersects_convex_shape(p_planes, p_plane_count);
-				if (!valid) {
-
-					stack[level] = (VISIT_DONE_BIT << VISITED_BIT_SHIFT) | node;
+		if (!b.aabb.intersects_convex_shape(p_planes, p_plane_count)) {
+			node = b.escape;
+			continue;
+		}
 
-				} else {
+		if (b.face_count == 0) {
+			node++;
+			continue;
+		}
 
-					if (b.face_index >= 0) {
-
-						const Triangle &s = triangleptr[b.face_index];
-
-						for (int j = 0; j < 3; ++j) {
-							const Vector3 &point = vertexptr[s.indices[j]];
-							const Vector3 &next_point = vertexptr[s.indices[(j + 1) % 3]];
-							Vector3 res;
-							bool over = true;
-							for (int i = 0; i < p_plane_count; i++) {
-								const Plane &p = p_planes[i];
-
-								if (p.intersects_segment(point, next_point, &res)) {
-									bool inisde = true;
-									for (int k = 0; k < p_plane_count; k++) {
-										if (k == i) continue;
-										const Plane &pp = p_planes[k];
-										if (pp.is_point_over(res)) {
-											inisde = false;
-											break;
-										}
-									}
-									if (inisde) return true;
-								}
-
-								if (p.is_point_over(point)) {
-									over = false;
-									break;
-								}
+		for (int f = 0; f < b.face_count; f++) {
+
+			const Triangle &s = triangleptr[faceptr[b.face_index + f]];
+
+			for (int j = 0; j < 3; ++j) {
+				const Vector3 &point = vertexptr[s.indices[j]];
+				const Vector3 &next_point = vertexptr[s.indices[(j + 1) % 3]];
+				Vector3 res;
+				bool over = true;
+				for (int i = 0; i < p_plane_count; i++) {
+					const Plane &p = p_planes[i];
+
+					if (p.intersects_segment(point, next_point, &res)) {
+						bool inisde = true;
+						for (int k = 0; k < p_plane_count; k++) {
+							if (k == i) continue;
+							const Plane &pp = p_planes[k];
+							if (pp.is_point_over(res)) {
+								inisde = false;
+								break;
 							}
-							if (over) return true;
 						}
+						if (inisde) return true;
+					}
 
-						stack[level] = (VISIT_DONE_BIT << VISITED_BIT_SHIFT) | node;
-
-					} else {
-
-						stack[level] = (VISIT_LEFT_BIT << VISITED_BIT_SHIFT) | node;
+					if (p.is_point_over(point)) {
+						over = false;
+						break;
 					}
 				}
-				continue;
-			}
-			case VISIT_LEFT_BIT: {
-
-				stack[level] = (VISIT_RIGHT_BIT << VISITED_BIT_SHIFT) | node;
-				stack[level + 1] = b.left | TEST_AABB_BIT;
-				level++;
-				continue;
-			}
-			case VISIT_RIGHT_BIT: {
-
-				stack[level] = (VISIT_DONE_BIT << VISITED_BIT_SHIFT) | node;
-				stack[level + 1] = b.right | TEST_AABB_BIT;
-				level++;
-				continue;
-			}
-			case VISIT_DONE_BIT: {
-
-				if (level == 0) {
-					done = true;
-					break;
-				} else
-					level--;
-				continue;
+				if (over) return true;
 			}
 		}
 
-		if (done)
-			break;
+		node = b.escape;
 	}
 
 	return false;
 }
 
 bool TriangleMesh::inside_convex_shape(const Plane *p_planes, int p_plane_count, Vector3 p_scale) const {
-	uint32_t *stack = (uint32_t *)alloca(sizeof(int) * max_depth);
-
-	enum {
-		TEST_AABB_BIT = 0,
-		VISIT_LEFT_BIT = 1,
-		VISIT_RIGHT_BIT = 2,
-		VISIT_DONE_BIT = 3,
-		VISITED_BIT_SHIFT = 29,
-		NODE_IDX_MASK = (1 << VISITED_BIT_SHIFT) - 1,
-		VISITED_BIT_MASK = ~NODE_IDX_MASK,
-
-	};
-
-	int level = 0;
 
 	PoolVector<Triangle>::Read trianglesr = triangles.read();
 	PoolVector<Vector3>::Read verticesr = vertices.read();
 	PoolVector<BVH>::Read bvhr = bvh.read();
+	PoolVector<int>::Read facesr = bvh_faces.read();
 
 	Transform scale(Basis().scaled(p_scale));
 
 	const Triangle *triangleptr = trianglesr.ptr();
 	const Vector3 *vertexptr = verticesr.ptr();
-	int pos = bvh.size() - 1;
 	const BVH *bvhptr = bvhr.ptr();
+	const int *faceptr = facesr.ptr();
+	int node_count = bvh.size();
 
-	stack[0] = pos;
-	while (true) {
+	int node = 0;
+	while (node < node_count) {
 
-		uint32_t node = stack[level] & NODE_IDX_MASK;
 		const BVH &b = bvhptr[node];
-		bool done = false;
-
-		switch (stack[level] >> VISITED_BIT_SHIFT) {
-			case TEST_AABB_BIT: {
-
-				bool intersects = scale.xform(b.aabb).intersects_convex_shape(p_planes, p_plane_count);
-				if (!intersects) return false;
-
-				bool inside = scale.xform(b.aabb).inside_convex_shape(p_planes, p_plane_count);
-				if (inside) {
+		AABB aabb = scale.xform(b.aabb);
 
-					stack[level] = (VISIT_DONE_BIT << VISITED_BIT_SHIFT) | node;
+		if (!aabb.intersects_convex_shape(p_planes, p_plane_count))
+			return false;
 
-				} else {
-
-					if (b.face_index >= 0) {
-						const Triangle &s = triangleptr[b.face_index];
-						for (int j = 0; j < 3; ++j) {
-							Vector3 point = scale.xform(vertexptr[s.indices[j]]);
-							for (int i = 0; i < p_plane_count; i++) {
-								const Plane &p = p_planes[i];
-								if (p.is_point_over(point)) return false;
-							}
-						}
+		if (aabb.inside_convex_shape(p_planes, p_plane_count)) {
+			node = b.escape;
+			continue;
+		}
 
-						stack[level] = (VISIT_DONE_BIT << VISITED_BIT_SHIFT) | node;
+		if (b.face_count == 0) {
+			node++;
+			continue;
+		}
 
-					} else {
+		for (int f = 0; f < b.face_count; f++) {
 
-						stack[level] = (VISIT_LEFT_BIT << VISITED_BIT_SHIFT) | node;
-					}
+			const Triangle &s = triangleptr[faceptr[b.face_index + f]];
+			for (int j = 0; j < 3; ++j) {
+				Vector3 point = scale.xform(vertexptr[s.indices[j]]);
+				for (int i = 0; i < p_plane_count; i++) {
+					const Plane &p = p_planes[i];
+					if (p.is_point_over(point)) return false;
 				}
-				continue;
-			}
-			case VISIT_LEFT_BIT: {
-
-				stack[level] = (VISIT_RIGHT_BIT << VISITED_BIT_SHIFT) | node;
-				stack[level + 1] = b.left | TEST_AABB_BIT;
-				level++;
-				continue;
-			}
-			case VISIT_RIGHT_BIT: {
-
-				stack[level] = (VISIT_DONE_BIT << VISITED_BIT_SHIFT) | node;
-				stack[level + 1] = b.right | TEST_AABB_BIT;
-				level++;
-				continue;
-			}
-			case VISIT_DONE_BIT: {
-
-				if (level == 0) {
-					done = true;
-					break;
-				} else
-					level--;
-				continue;
 			}
 		}
 
-		if (done)
-			break;
+		node = b.escape;
 	}
 
 	return true;
@@ -755,8 +743,23 @@ PoolVector<Face3> TriangleMesh::get_faces() const {
 	return faces;
 }
 
+void TriangleMesh::set_threaded_build(bool p_enable) {
+
+#ifndef NO_THREADS
+	if (p_enable && !build_pool) {
+		build_pool = memnew(ThreadWorkPool);
+		build_pool->init();
+		build_mutex = Mutex::create();
+	} else if (!p_enable && build_pool) {
+		memdelete(build_mutex);
+		build_mutex = NULL;
+		memdelete(build_pool);
+		build_pool = NULL;
+	}
+#endif
+}
+
 TriangleMesh::TriangleMesh() {
 
 	valid = false;
-	max_depth = 0;
 }
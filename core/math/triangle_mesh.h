@@ -34,6 +34,9 @@
 #include "core/math/face3.h"
 #include "core/reference.h"
 
+class Mutex;
+class ThreadWorkPool;
+
 class TriangleMesh : public Reference {
 
 	GDCLASS(TriangleMesh, Reference);
@@ -47,45 +50,42 @@ class TriangleMesh : public Reference {
 	PoolVector<Triangle> triangles;
 	PoolVector<Vector3> vertices;
 
+	// Nodes are stored in depth first order, so the first child of an internal
+	// node is the next one. Queries walk the array without a stack: on a miss,
+	// or after a leaf, they jump to the escape index, which is the first node
+	// after the subtree.
 	struct BVH {
 
 		AABB aabb;
-		Vector3 center; //used for sorting
-		int left;
-		int right;
-
-		int face_index;
+		int escape;
+		int face_index; // first entry in bvh_faces, leaves only
+		int face_count; // 0 for internal nodes
 	};
 
-	struct BVHCmpX {
-
-		bool operator()(const BVH *p_left, const BVH *p_right) const {
-
-			return p_left->center.x < p_right->center.x;
-		}
+	enum {
+		BVH_BINS = 12,
+		BVH_MAX_LEAF_FACES = 4,
+		BVH_THREADED_MIN_FACES = 16384,
 	};
 
-	struct BVHCmpY {
-
-		bool operator()(const BVH *p_left, const BVH *p_right) const {
+	struct BVHBuild;
+	struct BVHBuildTask {
 
-			return p_left->center.y < p_right->center.y;
-		}
+		int from;
+		int count;
+		int node;
 	};
-	struct BVHCmpZ {
 
-		bool operator()(const BVH *p_left, const BVH *p_right) const {
-
-			return p_left->center.z < p_right->center.z;
-		}
-	};
-
-	int _create_bvh(BVH *p_bvh, BVH **p_bb, int p_from, int p_size, int p_depth, int &max_depth, int &max_alloc);
+	static void _create_bvh(BVHBuild &p_build, int p_from, int p_count, int p_node, int p_task_depth);
+	void _build_bvh_task(uint32_t p_index, BVHBuild *p_build);
 
 	PoolVector<BVH> bvh;
-	int max_depth;
+	PoolVector<int> bvh_faces;
 	bool valid;
 
+	static ThreadWorkPool *build_pool;
+	static Mutex *build_mutex;
+
 public:
 	bool is_valid() const;
 	bool intersect_segment(const Vector3 &p_begin, const Vector3 &p_end, Vector3 &r_point, Vector3 &r_normal) const;
@@ -100,6 +100,9 @@ public:
 	void get_indices(PoolVector<int> *p_triangles_indices) const;
 
 	void create(const PoolVector<Vector3> &p_faces);
+
+	static void set_threaded_build(bool p_enable);
+
 	TriangleMesh();
 };
 
@@ -30,6 +30,9 @@
 
 #include "triangulate.h"
 
+#include "core/math/rect2.h"
+#include "core/sort_array.h"
+
 real_t Triangulate::get_area(const Vector<Vector2> &contour) {
 
 	int n = contour.size();
@@ -82,114 +85,523 @@ bool Triangulate::is_inside_triangle(real_t Ax, real_t Ay,
 	}
 };
 
-bool Triangulate::snip(const Vector<Vector2> &p_contour, int u, int v, int w, int n, const Vector<int> &V, bool relaxed) {
-	int p;
-	real_t Ax, Ay, Bx, By, Cx, Cy, Px, Py;
-	const Vector2 *contour = &p_contour[0];
+// Vertices of the polygon being clipped, kept in a ring. Large polygons
+// also link their vertices in z-order, so ear tests only visit the vertices
+// near the candidate triangle.
+class EarClipper {
+
+	struct Node {
+		int i; // index of the vertex in the input
+		real_t x;
+		real_t y;
+		int prev;
+		int next;
+		uint32_t z;
+		int prev_z;
+		int next_z;
+		bool steiner;
+	};
+
+	struct NodeCompareZ {
+		const Node *nodes;
+		_FORCE_INLINE_ bool operator()(int p_a, int p_b) const { return nodes[p_a].z < nodes[p_b].z; }
+	};
+
+	struct NodeCompareX {
+		const Node *nodes;
+		_FORCE_INLINE_ bool operator()(int p_a, int p_b) const { return nodes[p_a].x < nodes[p_b].x; }
+	};
+
+	Vector<Node> node_pool;
+	Node *nodes;
+	int node_count;
+
+	bool hashed;
+	real_t min_x;
+	real_t min_y;
+	real_t inv_size;
+
+	// Twice the signed area of the triangle, negative when p, q, r turn counter-clockwise.
+	_FORCE_INLINE_ real_t area(int p, int q, int r) const {
+		return (nodes[q].y - nodes[p].y) * (nodes[r].x - nodes[q].x) - (nodes[q].x - nodes[p].x) * (nodes[r].y - nodes[q].y);
+	}
 
-	Ax = contour[V[u]].x;
-	Ay = contour[V[u]].y;
+	_FORCE_INLINE_ bool equals(int p_a, int p_b) const {
+		return nodes[p_a].x == nodes[p_b].x && nodes[p_a].y == nodes[p_b].y;
+	}
+
+	_FORCE_INLINE_ static bool point_in_triangle(real_t ax, real_t ay, real_t bx, real_t by, real_t cx, real_t cy, real_t px, real_t py) {
+		return (cx - px) * (ay - py) - (ax - px) * (cy - py) >= 0 &&
+			   (ax - px) * (by - py) - (bx - px) * (ay - py) >= 0 &&
+			   (bx - px) * (cy - py) - (cx - px) * (by - py) >= 0;
+	}
 
-	Bx = contour[V[v]].x;
-	By = contour[V[v]].y;
+	uint32_t z_order(real_t p_x, real_t p_y) const {
 
-	Cx = contour[V[w]].x;
-	Cy = contour[V[w]].y;
+		uint32_t x = uint32_t((p_x - min_x) * inv_size);
+		uint32_t y = uint32_t((p_y - min_y) * inv_size);
 
-	// It can happen that the triangulation ends up with three aligned vertices to deal with.
-	// In this scenario, making the check below strict may reject the possibility of
-	// forming a last triangle with these aligned vertices, preventing the triangulatiom
-	// from completing.
-	// To avoid that we allow zero-area triangles if all else failed.
-	float threshold = relaxed ? -CMP_EPSILON : CMP_EPSILON;
+		x = (x | (x << 8)) & 0x00FF00FF;
+		x = (x | (x << 4)) & 0x0F0F0F0F;
+		x = (x | (x << 2)) & 0x33333333;
+		x = (x | (x << 1)) & 0x55555555;
 
-	if (threshold > (((Bx - Ax) * (Cy - Ay)) - ((By - Ay) * (Cx - Ax)))) return false;
+		y = (y | (y << 8)) & 0x00FF00FF;
+		y = (y | (y << 4)) & 0x0F0F0F0F;
+		y = (y | (y << 2)) & 0x33333333;
+		y = (y | (y << 1)) & 0x55555555;
 
-	for (p = 0; p < n; p++) {
-		if ((p == u) || (p == v) || (p == w)) continue;
-		Px = contour[V[p]].x;
-		Py = contour[V[p]].y;
-		if (is_inside_triangle(Ax, Ay, Bx, By, Cx, Cy, Px, Py, relaxed)) return false;
+		return x | (y << 1);
 	}
 
-	return true;
-}
+	int insert_node(int p_index, const Vector2 &p_pos, int p_last) {
+
+		int n = node_count++;
+		Node &node = nodes[n];
+		node.i = p_index;
+		node.x = p_pos.x;
+		node.y = p_pos.y;
+		node.z = 0;
+		node.prev_z = -1;
+		node.next_z = -1;
+		node.steiner = false;
+
+		if (p_last < 0) {
+			node.prev = n;
+			node.next = n;
+		} else {
+			node.next = nodes[p_last].next;
+			node.prev = p_last;
+			nodes[nodes[p_last].next].prev = n;
+			nodes[p_last].next = n;
+		}
+		return n;
+	}
 
-bool Triangulate::triangulate(const Vector<Vector2> &contour, Vector<int> &result) {
-	/* allocate and initialize list of Vertices in polygon */
+	void remove_node(int p) {
 
-	int n = contour.size();
-	if (n < 3) return false;
+		Node &node = nodes[p];
+		nodes[node.next].prev = node.prev;
+		nodes[node.prev].next = node.next;
+
+		if (node.prev_z >= 0)
+			nodes[node.prev_z].next_z = node.next_z;
+		if (node.next_z >= 0)
+			nodes[node.next_z].prev_z = node.prev_z;
+	}
+
+	int filter_points(int p_start, int p_end) {
+
+		if (p_start < 0)
+			return p_start;
+		if (p_end < 0)
+			p_end = p_start;
+
+		int p = p_start;
+		bool again;
+		do {
+			again = false;
+
+			if (!nodes[p].steiner && (equals(p, nodes[p].next) || area(nodes[p].prev, p, nodes[p].next) == 0)) {
+				remove_node(p);
+				p = p_end = nodes[p].prev;
+				if (p == nodes[p].next)
+					break;
+				again = true;
+			} else {
+				p = nodes[p].next;
+			}
+		} while (again || p != p_end);
+
+		return p_end;
+	}
+
+	bool is_ear(int p_ear) const {
+
+		int a = nodes[p_ear].prev;
+		int b = p_ear;
+		int c = nodes[p_ear].next;
 
-	Vector<int> V;
-	V.resize(n);
+		if (area(a, b, c) >= 0)
+			return false; // reflex, can't be an ear
 
-	/* we want a counter-clockwise polygon in V */
+		// Only reflex vertices can lie inside the ear.
+		int p = nodes[c].next;
+		while (p != a) {
+			if (point_in_triangle(nodes[a].x, nodes[a].y, nodes[b].x, nodes[b].y, nodes[c].x, nodes[c].y, nodes[p].x, nodes[p].y) &&
+					area(nodes[p].prev, p, nodes[p].next) >= 0)
+				return false;
+			p = nodes[p].next;
+		}
+
+		return true;
+	}
 
-	if (0.0 < get_area(contour))
-		for (int v = 0; v < n; v++)
-			V.write[v] = v;
-	else
-		for (int v = 0; v < n; v++)
-			V.write[v] = (n - 1) - v;
+	bool is_ear_hashed(int p_ear) const {
 
-	bool relaxed = false;
+		int a = nodes[p_ear].prev;
+		int b = p_ear;
+		int c = nodes[p_ear].next;
 
-	int nv = n;
+		if (area(a, b, c) >= 0)
+			return false;
 
-	/*  remove nv-2 Vertices, creating 1 triangle every time */
-	int count = 2 * nv; /* error detection */
+		const Node &na = nodes[a];
+		const Node &nb = nodes[b];
+		const Node &nc = nodes[c];
 
-	for (int v = nv - 1; nv > 2;) {
-		/* if we loop, it is probably a non-simple polygon */
-		if (0 >= (count--)) {
-			if (relaxed) {
-				//** Triangulate: ERROR - probable bad polygon!
+		real_t min_tx = MIN(na.x, MIN(nb.x, nc.x));
+		real_t min_ty = MIN(na.y, MIN(nb.y, nc.y));
+		real_t max_tx = MAX(na.x, MAX(nb.x, nc.x));
+		real_t max_ty = MAX(na.y, MAX(nb.y, nc.y));
+
+		uint32_t min_z = z_order(min_tx, min_ty);
+		uint32_t max_z = z_order(max_tx, max_ty);
+
+		// Walk the z-order curve both ways from the ear, within the triangle's box.
+		int p = nb.prev_z;
+		int n = nb.next_z;
+
+		while (p >= 0 && nodes[p].z >= min_z && n >= 0 && nodes[n].z <= max_z) {
+
+			if (p != a && p != c && point_in_triangle(na.x, na.y, nb.x, nb.y, nc.x, nc.y, nodes[p].x, nodes[p].y) && area(nodes[p].prev, p, nodes[p].next) >= 0)
 				return false;
-			} else {
-				// There may be aligned vertices that the strict
-				// checks prevent from triangulating. In this situation
-				// we are better off adding flat triangles than
-				// failing, so we relax the checks and try one last
-				// round.
-				// Only relaxing the constraints as a last resort avoids
-				// degenerate triangles when they aren't necessary.
-				count = 2 * nv;
-				relaxed = true;
+			p = nodes[p].prev_z;
+
+			if (n != a && n != c && point_in_triangle(na.x, na.y, nb.x, nb.y, nc.x, nc.y, nodes[n].x, nodes[n].y) && area(nodes[n].prev, n, nodes[n].next) >= 0)
+				return false;
+			n = nodes[n].next_z;
+		}
+
+		while (p >= 0 && nodes[p].z >= min_z) {
+
+			if (p != a && p != c && point_in_triangle(na.x, na.y, nb.x, nb.y, nc.x, nc.y, nodes[p].x, nodes[p].y) && area(nodes[p].prev, p, nodes[p].next) >= 0)
+				return false;
+			p = nodes[p].prev_z;
+		}
+
+		while (n >= 0 && nodes[n].z <= max_z) {
+
+			if (n != a && n != c && point_in_triangle(na.x, na.y, nb.x, nb.y, nc.x, nc.y, nodes[n].x, nodes[n].y) && area(nodes[n].prev, n, nodes[n].next) >= 0)
+				return false;
+			n = nodes[n].next_z;
+		}
+
+		return true;
+	}
+
+	void index_curve(int p_start) {
+
+		Vector<int> order;
+		int p = p_start;
+		do {
+			nodes[p].z = z_order(nodes[p].x, nodes[p].y);
+			order.push_back(p);
+			p = nodes[p].next;
+		} while (p != p_start);
+
+		SortArray<int, NodeCompareZ> sorter;
+		sorter.compare.nodes = nodes;
+		sorter.sort(order.ptrw(), order.size());
+
+		for (int i = 0; i < order.size(); i++) {
+			nodes[order[i]].prev_z = i > 0 ? order[i - 1] : -1;
+			nodes[order[i]].next_z = i < order.size() - 1 ? order[i + 1] : -1;
+		}
+	}
+
+	bool locally_inside(int a, int b) const {
+
+		return area(nodes[a].prev, a, nodes[a].next) < 0 ?
+					   area(a, b, nodes[a].next) >= 0 && area(a, nodes[a].prev, b) >= 0 :
+					   area(a, b, nodes[a].prev) < 0 || area(a, nodes[a].next, b) < 0;
+	}
+
+	bool sector_contains_sector(int m, int p) const {
+
+		return area(nodes[m].prev, m, nodes[p].prev) < 0 && area(nodes[p].next, m, nodes[m].next) < 0;
+	}
+
+	// Finds a vertex of the outline that the leftmost hole vertex can be joined to.
+	int find_hole_bridge(int p_hole, int p_outer) const {
+
+		int p = p_outer;
+		real_t hx = nodes[p_hole].x;
+		real_t hy = nodes[p_hole].y;
+		real_t qx = -1e30;
+		int m = -1;
+
+		// Segment intersecting the ray cast to the left of the hole, closest to it.
+		do {
+			const Node &np = nodes[p];
+			const Node &nn = nodes[np.next];
+			if (hy <= np.y && hy >= nn.y && nn.y != np.y) {
+				real_t x = np.x + (hy - np.y) * (nn.x - np.x) / (nn.y - np.y);
+				if (x <= hx && x > qx) {
+					qx = x;
+					m = np.x < nn.x ? p : np.next;
+					if (x == hx)
+						return m; // hole touches the outline, this is the bridge
+				}
+			}
+			p = np.next;
+		} while (p != p_outer);
+
+		if (m < 0)
+			return -1;
+
+		// Other outline vertices inside the triangle (hole, intersection,
+		// segment end) would block the bridge, pick the one at the smallest
+		// angle to the ray instead.
+		int stop = m;
+		real_t mx = nodes[m].x;
+		real_t my = nodes[m].y;
+		real_t tan_min = 1e30;
+
+		p = m;
+		do {
+			const Node &np = nodes[p];
+			if (hx >= np.x && np.x >= mx && hx != np.x &&
+					point_in_triangle(hy < my ? hx : qx, hy, mx, my, hy < my ? qx : hx, hy, np.x, np.y)) {
+
+				real_t tan = Math::abs(hy - np.y) / (hx - np.x);
+
+				if (locally_inside(p, p_hole) &&
+						(tan < tan_min || (tan == tan_min && (np.x > nodes[m].x || (np.x == nodes[m].x && sector_contains_sector(m, p)))))) {
+					m = p;
+					tan_min = tan;
+				}
+			}
+			p = np.next;
+		} while (p != stop);
+
+		return m;
+	}
+
+	// Links a to b with a two-way edge, duplicating both vertices.
+	int split_polygon(int a, int b) {
+
+		int a2 = node_count++;
+		int b2 = node_count++;
+		nodes[a2] = nodes[a];
+		nodes[b2] = nodes[b];
+		nodes[a2].prev_z = nodes[a2].next_z = -1;
+		nodes[b2].prev_z = nodes[b2].next_z = -1;
+		nodes[a2].steiner = nodes[b2].steiner = false;
+
+		int an = nodes[a].next;
+		int bp = nodes[b].prev;
+
+		nodes[a].next = b;
+		nodes[b].prev = a;
+
+		nodes[a2].next = an;
+		nodes[an].prev = a2;
+
+		nodes[b2].next = a2;
+		nodes[a2].prev = b2;
+
+		nodes[bp].next = b2;
+		nodes[b2].prev = bp;
+
+		return b2;
+	}
+
+public:
+	void init(int p_max_nodes) {
+
+		node_pool.resize(p_max_nodes);
+		nodes = node_pool.ptrw();
+		node_count = 0;
+		hashed = false;
+	}
+
+	// Builds a ring from the points, counter-clockwise for outlines and clockwise for holes.
+	int add_ring(const Vector<Vector2> &p_points, int p_index_offset, bool p_ccw) {
+
+		int n = p_points.size();
+		const Vector2 *r = p_points.ptr();
+
+		real_t sum = 0;
+		for (int p = n - 1, q = 0; q < n; p = q++) {
+			sum += r[p].cross(r[q]);
+		}
+
+		int last = -1;
+		if (p_ccw == (sum > 0)) {
+			for (int i = 0; i < n; i++) {
+				last = insert_node(p_index_offset + i, r[i], last);
 			}
+		} else {
+			for (int i = n - 1; i >= 0; i--) {
+				last = insert_node(p_index_offset + i, r[i], last);
+			}
+		}
+
+		if (last >= 0 && equals(last, nodes[last].next)) {
+			int next = nodes[last].next;
+			remove_node(last);
+			last = next;
 		}
 
-		/* three consecutive vertices in current polygon, <u,v,w> */
-		int u = v;
-		if (nv <= u) u = 0; /* previous */
-		v = u + 1;
-		if (nv <= v) v = 0; /* new v    */
-		int w = v + 1;
-		if (nv <= w) w = 0; /* next     */
+		return last;
+	}
+
+	int eliminate_holes(const Vector<int> &p_holes, int p_outer) {
+
+		Vector<int> queue;
+		for (int i = 0; i < p_holes.size(); i++) {
 
-		if (snip(contour, u, v, w, nv, V, relaxed)) {
-			int a, b, c, s, t;
+			int list = p_holes[i];
+			if (list == nodes[list].next)
+				nodes[list].steiner = true;
 
-			/* true names of the vertices */
-			a = V[u];
-			b = V[v];
-			c = V[w];
+			int leftmost = list;
+			int p = list;
+			do {
+				if (nodes[p].x < nodes[leftmost].x || (nodes[p].x == nodes[leftmost].x && nodes[p].y < nodes[leftmost].y))
+					leftmost = p;
+				p = nodes[p].next;
+			} while (p != list);
 
-			/* output Triangle */
-			result.push_back(a);
-			result.push_back(b);
-			result.push_back(c);
+			queue.push_back(leftmost);
+		}
+
+		SortArray<int, NodeCompareX> sorter;
+		sorter.compare.nodes = nodes;
+		sorter.sort(queue.ptrw(), queue.size());
+
+		for (int i = 0; i < queue.size(); i++) {
 
-			/* remove v from remaining polygon */
-			for (s = v, t = v + 1; t < nv; s++, t++)
-				V.write[s] = V[t];
+			int bridge = find_hole_bridge(queue[i], p_outer);
+			if (bridge < 0)
+				continue;
 
-			nv--;
+			int bridge_reverse = split_polygon(bridge, queue[i]);
 
-			/* reset error detection counter */
-			count = 2 * nv;
+			// Filter collinear points around the cuts.
+			int filtered_bridge = filter_points(bridge, nodes[bridge].next);
+			filter_points(bridge_reverse, nodes[bridge_reverse].next);
+
+			if (p_outer == bridge)
+				p_outer = filtered_bridge;
 		}
+
+		return p_outer;
+	}
+
+	void enable_hashing(const Rect2 &p_bounds) {
+
+		min_x = p_bounds.position.x;
+		min_y = p_bounds.position.y;
+		real_t size = MAX(p_bounds.size.x, p_bounds.size.y);
+		inv_size = size != 0 ? 32767 / size : 0;
+		hashed = true;
+	}
+
+	bool clip(int p_ear, Vector<int> &r_result) {
+
+		if (p_ear < 0)
+			return false;
+
+		if (hashed)
+			index_curve(p_ear);
+
+		int ear = p_ear;
+		int stop = ear;
+		bool filtered = false;
+
+		while (nodes[ear].prev != nodes[ear].next) {
+
+			int prev = nodes[ear].prev;
+			int next = nodes[ear].next;
+
+			if (hashed ? is_ear_hashed(ear) : is_ear(ear)) {
+
+				r_result.push_back(nodes[prev].i);
+				r_result.push_back(nodes[ear].i);
+				r_result.push_back(nodes[next].i);
+
+				remove_node(ear);
+
+				// skipping the next vertex leads to less sliver triangles
+				ear = nodes[next].next;
+				stop = ear;
+				continue;
+			}
+
+			ear = next;
+
+			if (ear == stop) {
+				if (filtered) {
+					//** Triangulate: ERROR - probable bad polygon!
+					return false;
+				}
+
+				// Duplicate or aligned vertices may leave no valid ear,
+				// drop them and go around once more.
+				ear = filter_points(ear, -1);
+				stop = ear;
+				filtered = true;
+			}
+		}
+
+		return true;
+	}
+};
+
+bool Triangulate::triangulate(const Vector<Vector2> &contour, Vector<int> &result) {
+
+	return triangulate_with_holes(contour, Vector<Vector<Vector2> >(), result);
+}
+
+bool Triangulate::triangulate_with_holes(const Vector<Vector2> &p_contour, const Vector<Vector<Vector2> > &p_holes, Vector<int> &r_result) {
+
+	int n = p_contour.size();
+	if (n < 3)
+		return false;
+
+	int max_nodes = n;
+	for (int i = 0; i < p_holes.size(); i++) {
+		max_nodes += p_holes[i].size() + 2; // each bridge duplicates two vertices
+	}
+
+	EarClipper clipper;
+	clipper.init(max_nodes);
+
+	int outer = clipper.add_ring(p_contour, 0, true);
+
+	if (p_holes.size()) {
+
+		Vector<int> holes;
+		int offset = n;
+		for (int i = 0; i < p_holes.size(); i++) {
+			if (p_holes[i].size() >= 3) {
+				int hole = clipper.add_ring(p_holes[i], offset, false);
+				if (hole >= 0)
+					holes.push_back(hole);
+			}
+			offset += p_holes[i].size();
+		}
+
+		outer = clipper.eliminate_holes(holes, outer);
+	}
+
+	// z-order lookups only pay off past a few dozen vertices
+	if (max_nodes > 80) {
+
+		Rect2 bounds(p_contour[0], Size2());
+		for (int i = 1; i < n; i++) {
+			bounds.expand_to(p_contour[i]);
+		}
+		for (int i = 0; i < p_holes.size(); i++) {
+			for (int j = 0; j < p_holes[i].size(); j++) {
+				bounds.expand_to(p_holes[i][j]);
+			}
+		}
+
+		clipper.enable_hashing(bounds);
 	}
 
-	return true;
+	return clipper.clip(outer, r_result);
 }
@@ -34,7 +34,8 @@
 #include "core/math/vector2.h"
 
 /*
-http://www.flipcode.com/archives/Efficient_Polygon_Triangulation.shtml
+Ear clipping over a linked list of vertices, after Mapbox's earcut:
+https://github.com/mapbox/earcut
 */
 
 class Triangulate {
@@ -43,6 +44,10 @@ public:
 	// as series of triangles.
 	static bool triangulate(const Vector<Vector2> &contour, Vector<int> &result);
 
+	// same, cutting out the given holes. Result indices count the contour
+	// points first, then the points of each hole in order.
+	static bool triangulate_with_holes(const Vector<Vector2> &p_contour, const Vector<Vector<Vector2> > &p_holes, Vector<int> &r_result);
+
 	// compute area of a contour/polygon
 	static real_t get_area(const Vector<Vector2> &contour);
 
@@ -53,9 +58,6 @@ public:
 			real_t Cx, real_t Cy,
 			real_t Px, real_t Py,
 			bool include_edges);
-
-private:
-	static bool snip(const Vector<Vector2> &p_contour, int u, int v, int w, int n, const Vector<int> &V, bool relaxed);
 };
 
 #endif
@@ -40,23 +40,149 @@ MessageQueue *MessageQueue::get_singleton() {
 	return singleton;
 }
 
-Error MessageQueue::push_call(ObjectID p_id, const StringName &p_method, const Variant **p_args, int p_argcount, bool p_show_error) {
+// Bumped by every queue, so a thread never keeps using a bucket of a queue that was destroyed.
+static uint64_t queue_generation = 0;
+
+#ifndef NO_THREADS
+thread_local MessageQueue::Bucket *MessageQueue::thread_bucket = NULL;
+thread_local uint64_t MessageQueue::thread_generation = 0;
+
+MessageQueue::BucketGuard::~BucketGuard() {
+
+	MessageQueue *mq = singleton;
+	if (!mq || thread_generation != mq->generation)
+		return;
+
+	// Pending messages stay in the bucket until the next flush, then another thread can take it over.
+	mq->__thread__safe__.lock();
+	thread_bucket->owned = false;
+	mq->__thread__safe__.unlock();
+	thread_bucket = NULL;
+}
+#endif
+
+static _FORCE_INLINE_ void _bucket_lock(volatile uint32_t *p_lock) {
+
+	while (*p_lock || !atomic_compare_exchange(p_lock, (uint32_t)0, (uint32_t)1)) {
+	}
+}
+
+static _FORCE_INLINE_ void _bucket_unlock(volatile uint32_t *p_lock) {
+
+	atomic_compare_exchange(p_lock, (uint32_t)1, (uint32_t)0);
+}
+
+MessageQueue::Bucket *MessageQueue::_get_bucket() {
+
+#ifndef NO_THREADS
+	if (likely(thread_generation == generation)) {
+		return thread_bucket;
+	}
+	return _register_thread();
+#else
+	return buckets;
+#endif
+}
+
+MessageQueue::Bucket *MessageQueue::_register_thread() {
+
+	_THREAD_SAFE_METHOD_
+
+	Bucket *bucket = buckets;
+	while (bucket && bucket->owned) {
+		bucket = bucket->next;
+	}
+
+	if (!bucket) {
+		bucket = memnew(Bucket);
+		bucket->first = NULL;
+		bucket->last = NULL;
+		bucket->next = NULL;
+		bucket->lock = 0;
+		if (buckets_last) {
+			buckets_last->next = bucket;
+		} else {
+			buckets = bucket;
+		}
+		buckets_last = bucket;
+	}
+	bucket->owned = true;
+
+#ifndef NO_THREADS
+	static thread_local BucketGuard guard;
+	thread_bucket = bucket;
+	thread_generation = generation;
+#endif
+
+	return bucket;
+}
+
+MessageQueue::Page *MessageQueue::_take_page(uint32_t p_size) {
+
+	Page *page = NULL;
+
+	if (p_size <= PAGE_SIZE) {
+		_THREAD_SAFE_METHOD_
+		if (free_pages) {
+			page = free_pages;
+			free_pages = page->next;
+			free_size -= page->size;
+		}
+	}
+
+	if (!page) {
+		// Messages bigger than a page get a page of their own.
+		uint32_t size = MAX(p_size, (uint32_t)PAGE_SIZE);
+		page = (Page *)memalloc(sizeof(Page) + size);
+		page->size = size;
+	}
+
+	page->next = NULL;
+	page->end = 0;
+	return page;
+}
+
+void MessageQueue::_release_pages(Page *p_pages) {
 
 	_THREAD_SAFE_METHOD_
 
-	int room_needed = sizeof(Message) + sizeof(Variant) * p_argcount;
+	while (p_pages) {
+		Page *next = p_pages->next;
+		if (p_pages->size == PAGE_SIZE && free_size + PAGE_SIZE <= keep_size) {
+			p_pages->next = free_pages;
+			free_pages = p_pages;
+			free_size += PAGE_SIZE;
+		} else {
+			memfree(p_pages);
+		}
+		p_pages = next;
+	}
+}
+
+uint8_t *MessageQueue::_alloc(Bucket *p_bucket, uint32_t p_size) {
 
-	if ((buffer_end + room_needed) >= buffer_size) {
-		String type;
-		if (ObjectDB::get_instance(p_id))
-			type = ObjectDB::get_instance(p_id)->get_class();
-		print_line("Failed method: " + type + ":" + p_method + " target ID: " + itos(p_id));
-		statistics();
-		ERR_EXPLAIN("Message queue out of memory. Try increasing 'message_queue_size_kb' in project settings.");
-		ERR_FAIL_V(ERR_OUT_OF_MEMORY);
+	Page *page = p_bucket->last;
+	if (!page || page->end + p_size > page->size) {
+		page = _take_page(p_size);
+		if (p_bucket->last) {
+			p_bucket->last->next = page;
+		} else {
+			p_bucket->first = page;
+		}
+		p_bucket->last = page;
 	}
 
-	Message *msg = memnew_placement(&buffer[buffer_end], Message);
+	uint8_t *ptr = (uint8_t *)(page + 1) + page->end;
+	page->end += p_size;
+	return ptr;
+}
+
+Error MessageQueue::push_call(ObjectID p_id, const StringName &p_method, const Variant **p_args, int p_argcount, bool p_show_error) {
+
+	Bucket *bucket = _get_bucket();
+	_bucket_lock(&bucket->lock);
+
+	Message *msg = memnew_placement(_alloc(bucket, sizeof(Message) + sizeof(Variant) * p_argcount), Message);
 	msg->args = p_argcount;
 	msg->instance_ID = p_id;
 	msg->target = p_method;
@@ -64,15 +190,37 @@ Error MessageQueue::push_call(ObjectID p_id, const StringName &p_method, const V
 	if (p_show_error)
 		msg->type |= FLAG_SHOW_ERROR;
 
-	buffer_end += sizeof(Message);
-
+	Variant *args = (Variant *)(msg + 1);
 	for (int i = 0; i < p_argcount; i++) {
+		memnew_placement(&args[i], Variant(*p_args[i]));
+	}
 
-		Variant *v = memnew_placement(&buffer[buffer_end], Variant);
-		buffer_end += sizeof(Variant);
-		*v = *p_args[i];
+	_bucket_unlock(&bucket->lock);
+	return OK;
+}
+
+Error MessageQueue::push_call_move(ObjectID p_id, const StringName &p_method, Variant *p_args, int p_argcount, bool p_show_error) {
+
+	Bucket *bucket = _get_bucket();
+	_bucket_lock(&bucket->lock);
+
+	Message *msg = memnew_placement(_alloc(bucket, sizeof(Message) + sizeof(Variant) * p_argcount), Message);
+	msg->args = p_argcount;
+	msg->instance_ID = p_id;
+	msg->target = p_method;
+	msg->type = TYPE_CALL;
+	if (p_show_error)
+		msg->type |= FLAG_SHOW_ERROR;
+
+	// Variants hold no pointers into themselves, so their bits can be moved
+	// as they are. The source is then reset without releasing what it held.
+	Variant *args = (Variant *)(msg + 1);
+	for (int i = 0; i < p_argcount; i++) {
+		memcpy((void *)&args[i], (const void *)&p_args[i], sizeof(Variant));
+		memnew_placement(&p_args[i], Variant);
 	}
 
+	_bucket_unlock(&bucket->lock);
 	return OK;
 }
 
@@ -93,62 +241,36 @@ Error MessageQueue::push_call(ObjectID p_id, const StringName &p_method, VARIANT
 
 Error MessageQueue::push_set(ObjectID p_id, const StringName &p_prop, const Variant &p_value) {
 
-	_THREAD_SAFE_METHOD_
-
-	uint8_t room_needed = sizeof(Message) + sizeof(Variant);
-
-	if ((buffer_end + room_needed) >= buffer_size) {
-		String type;
-		if (ObjectDB::get_instance(p_id))
-			type = ObjectDB::get_instance(p_id)->get_class();
-		print_line("Failed set: " + type + ":" + p_prop + " target ID: " + itos(p_id));
-		statistics();
-		ERR_EXPLAIN("Message queue out of memory. Try increasing 'message_queue_size_kb' in project settings.");
-		ERR_FAIL_V(ERR_OUT_OF_MEMORY);
-	}
+	Bucket *bucket = _get_bucket();
+	_bucket_lock(&bucket->lock);
 
-	Message *msg = memnew_placement(&buffer[buffer_end], Message);
+	Message *msg = memnew_placement(_alloc(bucket, sizeof(Message) + sizeof(Variant)), Message);
 	msg->args = 1;
 	msg->instance_ID = p_id;
 	msg->target = p_prop;
 	msg->type = TYPE_SET;
 
-	buffer_end += sizeof(Message);
-
-	Variant *v = memnew_placement(&buffer[buffer_end], Variant);
-	buffer_end += sizeof(Variant);
-	*v = p_value;
+	memnew_placement(msg + 1, Variant(p_value));
 
+	_bucket_unlock(&bucket->lock);
 	return OK;
 }
 
 Error MessageQueue::push_notification(ObjectID p_id, int p_notification) {
 
-	_THREAD_SAFE_METHOD_
-
 	ERR_FAIL_COND_V(p_notification < 0, ERR_INVALID_PARAMETER);
 
-	uint8_t room_needed = sizeof(Message);
-
-	if ((buffer_end + room_needed) >= buffer_size) {
-		String type;
-		if (ObjectDB::get_instance(p_id))
-			type = ObjectDB::get_instance(p_id)->get_class();
-		print_line("Failed notification: " + itos(p_notification) + " target ID: " + itos(p_id));
-		statistics();
-		ERR_EXPLAIN("Message queue out of memory. Try increasing 'message_queue_size_kb' in project settings.");
-		ERR_FAIL_V(ERR_OUT_OF_MEMORY);
-	}
+	Bucket *bucket = _get_bucket();
+	_bucket_lock(&bucket->lock);
 
-	Message *msg = memnew_placement(&buffer[buffer_end], Message);
+	Message *msg = memnew_placement(_alloc(bucket, sizeof(Message)), Message);
 
 	msg->type = TYPE_NOTIFICATION;
 	msg->instance_ID = p_id;
 	//msg->target;
 	msg->notification = p_notification;
 
-	buffer_end += sizeof(Message);
-
+	_bucket_unlock(&bucket->lock);
 	return OK;
 }
 
@@ -173,55 +295,70 @@ void MessageQueue::statistics() {
 	Map<StringName, int> call_count;
 	int null_count = 0;
 
-	uint32_t read_pos = 0;
-	while (read_pos < buffer_end) {
-		Message *message = (Message *)&buffer[read_pos];
+	uint64_t total_bytes = 0;
 
-		Object *target = ObjectDB::get_instance(message->instance_ID);
+	for (Bucket *bucket = buckets; bucket; bucket = bucket->next) {
 
-		if (target != NULL) {
+		_bucket_lock(&bucket->lock);
 
-			switch (message->type & FLAG_MASK) {
+		for (Page *page = bucket->first; page; page = page->next) {
 
-				case TYPE_CALL: {
+			total_bytes += page->end;
 
-					if (!call_count.has(message->target))
-						call_count[message->target] = 0;
+			uint8_t *data = (uint8_t *)(page + 1);
+			uint32_t read_pos = 0;
+			while (read_pos < page->end) {
+				Message *message = (Message *)&data[read_pos];
 
-					call_count[message->target]++;
+				Object *target = ObjectDB::get_instance(message->instance_ID);
 
-				} break;
-				case TYPE_NOTIFICATION: {
+				if (target != NULL) {
 
-					if (!notify_count.has(message->notification))
-						notify_count[message->notification] = 0;
+					switch (message->type & FLAG_MASK) {
 
-					notify_count[message->notification]++;
+						case TYPE_CALL: {
 
-				} break;
-				case TYPE_SET: {
+							if (!call_count.has(message->target))
+								call_count[message->target] = 0;
 
-					if (!set_count.has(message->target))
-						set_count[message->target] = 0;
+							call_count[message->target]++;
 
-					set_count[message->target]++;
+						} break;
+						case TYPE_NOTIFICATION: {
 
-				} break;
-			}
+							if (!notify_count.has(message->notification))
+								notify_count[message->notification] = 0;
 
-		} else {
-			//object was deleted
-			print_line("Object was deleted while awaiting a callback");
+							notify_count[message->notification]++;
 
-			null_count++;
+						} break;
+						case TYPE_SET: {
+
+							if (!set_count.has(message->target))
+								set_count[message->target] = 0;
+
+							set_count[message->target]++;
+
+						} break;
+					}
+
+				} else {
+					//object was deleted
+					print_line("Object was deleted while awaiting a callback");
+
+					null_count++;
+				}
+
+				read_pos += sizeof(Message);
+				if ((message->type & FLAG_MASK) != TYPE_NOTIFICATION)
+					read_pos += sizeof(Variant) * message->args;
+			}
 		}
 
-		read_pos += sizeof(Message);
-		if ((message->type & FLAG_MASK) != TYPE_NOTIFICATION)
-			read_pos += sizeof(Variant) * message->args;
+		_bucket_unlock(&bucket->lock);
 	}
 
-	print_line("TOTAL BYTES: " + itos(buffer_end));
+	print_line("TOTAL BYTES: " + itos(total_bytes));
 	print_line("NULL count: " + itos(null_count));
 
 	for (Map<StringName, int>::Element *E = set_count.front(); E; E = E->next()) {
@@ -262,78 +399,134 @@ void MessageQueue::_call_function(Object *p_target, const StringName &p_func, co
 
 void MessageQueue::flush() {
 
-	if (buffer_end > buffer_max_used) {
-		buffer_max_used = buffer_end;
-	}
+	_THREAD_SAFE_LOCK_
+	bool was_flushing = flushing;
+	flushing = true;
+	_THREAD_SAFE_UNLOCK_
 
-	uint32_t read_pos = 0;
+	ERR_FAIL_COND(was_flushing); //already flushing, you did something odd
 
-	//using reverse locking strategy
-	_THREAD_SAFE_LOCK_
+	uint32_t used = 0;
 
-	ERR_FAIL_COND(flushing); //already flushing, you did something odd
-	flushing = true;
+	// Messages pushed while flushing, by the calls themselves or by other
+	// threads, land in fresh pages and are picked up by the next round.
+	bool pending = true;
+	while (pending) {
 
-	while (read_pos < buffer_end) {
+		pending = false;
 
-		//lock on each iteration, so a call can re-add itself to the message queue
+		_THREAD_SAFE_LOCK_
+		Bucket *bucket = buckets;
+		_THREAD_SAFE_UNLOCK_
 
-		Message *message = (Message *)&buffer[read_pos];
+		while (bucket) {
 
-		uint32_t advance = sizeof(Message);
-		if ((message->type & FLAG_MASK) != TYPE_NOTIFICATION)
-			advance += sizeof(Variant) * message->args;
+			_bucket_lock(&bucket->lock);
+			Page *pages = bucket->first;
+			bucket->first = NULL;
+			bucket->last = NULL;
+			_bucket_unlock(&bucket->lock);
 
-		//pre-advance so this function is reentrant
-		read_pos += advance;
+			if (pages) {
+				pending = true;
 
-		_THREAD_SAFE_UNLOCK_
+				for (Page *page = pages; page; page = page->next) {
 
-		Object *target = ObjectDB::get_instance(message->instance_ID);
+					used += page->end;
 
-		if (target != NULL) {
+					uint8_t *data = (uint8_t *)(page + 1);
+					uint32_t read_pos = 0;
+					while (read_pos < page->end) {
 
-			switch (message->type & FLAG_MASK) {
-				case TYPE_CALL: {
+						Message *message = (Message *)&data[read_pos];
 
-					Variant *args = (Variant *)(message + 1);
+						read_pos += sizeof(Message);
+						if ((message->type & FLAG_MASK) != TYPE_NOTIFICATION)
+							read_pos += sizeof(Variant) * message->args;
 
-					// messages don't expect a return value
+						Object *target = ObjectDB::get_instance(message->instance_ID);
 
-					_call_function(target, message->target, args, message->args, message->type & FLAG_SHOW_ERROR);
+						if (target != NULL) {
 
-					for (int i = 0; i < message->args; i++) {
-						args[i].~Variant();
-					}
+							switch (message->type & FLAG_MASK) {
+								case TYPE_CALL: {
 
-				} break;
-				case TYPE_NOTIFICATION: {
+									Variant *args = (Variant *)(message + 1);
 
-					// messages don't expect a return value
-					target->notification(message->notification);
+									// messages don't expect a return value
 
-				} break;
-				case TYPE_SET: {
+									_call_function(target, message->target, args, message->args, message->type & FLAG_SHOW_ERROR);
 
-					Variant *arg = (Variant *)(message + 1);
-					// messages don't expect a return value
-					target->set(message->target, *arg);
+									for (int i = 0; i < message->args; i++) {
+										args[i].~Variant();
+									}
 
-					arg->~Variant();
-				} break;
-			}
-		}
+								} break;
+								case TYPE_NOTIFICATION: {
 
-		message->~Message();
+									// messages don't expect a return value
+									target->notification(message->notification);
 
-		_THREAD_SAFE_LOCK_
+								} break;
+								case TYPE_SET: {
+
+									Variant *arg = (Variant *)(message + 1);
+									// messages don't expect a return value
+									target->set(message->target, *arg);
+
+									arg->~Variant();
+								} break;
+							}
+						} else if ((message->type & FLAG_MASK) != TYPE_NOTIFICATION) {
+
+							Variant *args = (Variant *)(message + 1);
+							for (int i = 0; i < message->args; i++) {
+								args[i].~Variant();
+							}
+						}
+
+						message->~Message();
+					}
+				}
+
+				_release_pages(pages);
+			}
+
+			_THREAD_SAFE_LOCK_
+			bucket = bucket->next;
+			_THREAD_SAFE_UNLOCK_
+		}
 	}
 
-	buffer_end = 0; // reset buffer
+	_THREAD_SAFE_LOCK_
+	if (used > buffer_max_used) {
+		buffer_max_used = used;
+	}
 	flushing = false;
 	_THREAD_SAFE_UNLOCK_
 }
 
+void MessageQueue::_destroy_messages(Page *p_page) {
+
+	uint8_t *data = (uint8_t *)(p_page + 1);
+	uint32_t read_pos = 0;
+
+	while (read_pos < p_page->end) {
+
+		Message *message = (Message *)&data[read_pos];
+		read_pos += sizeof(Message);
+
+		if ((message->type & FLAG_MASK) != TYPE_NOTIFICATION) {
+			Variant *args = (Variant *)(message + 1);
+			for (int i = 0; i < message->args; i++)
+				args[i].~Variant();
+			read_pos += sizeof(Variant) * message->args;
+		}
+		message->~Message();
+	}
+	p_page->end = 0;
+}
+
 bool MessageQueue::is_flushing() const {
 
 	return flushing;
@@ -345,34 +538,44 @@ MessageQueue::MessageQueue() {
 	singleton = this;
 	flushing = false;
 
-	buffer_end = 0;
+	buckets = NULL;
+	buckets_last = NULL;
+	free_pages = NULL;
+	free_size = 0;
 	buffer_max_used = 0;
-	buffer_size = GLOBAL_DEF_RST("memory/limits/message_queue/max_size_kb", DEFAULT_QUEUE_SIZE_KB);
+	generation = ++queue_generation;
+
+	keep_size = GLOBAL_DEF_RST("memory/limits/message_queue/max_size_kb", DEFAULT_QUEUE_SIZE_KB);
 	ProjectSettings::get_singleton()->set_custom_property_info("memory/limits/message_queue/max_size_kb", PropertyInfo(Variant::INT, "memory/limits/message_queue/max_size_kb", PROPERTY_HINT_RANGE, "0,2048,1,or_greater"));
-	buffer_size *= 1024;
-	buffer = memnew_arr(uint8_t, buffer_size);
+	keep_size *= 1024;
+
+	// The thread creating the queue is the main one, its bucket is flushed first.
+	_register_thread();
 }
 
 MessageQueue::~MessageQueue() {
 
-	uint32_t read_pos = 0;
+	Bucket *bucket = buckets;
+	while (bucket) {
 
-	while (read_pos < buffer_end) {
-
-		Message *message = (Message *)&buffer[read_pos];
-		Variant *args = (Variant *)(message + 1);
-		int argc = message->args;
-		if ((message->type & FLAG_MASK) != TYPE_NOTIFICATION) {
-			for (int i = 0; i < argc; i++)
-				args[i].~Variant();
+		Page *page = bucket->first;
+		while (page) {
+			Page *next = page->next;
+			_destroy_messages(page);
+			memfree(page);
+			page = next;
 		}
-		message->~Message();
 
-		read_pos += sizeof(Message);
-		if ((message->type & FLAG_MASK) != TYPE_NOTIFICATION)
-			read_pos += sizeof(Variant) * message->args;
+		Bucket *next = bucket->next;
+		memdelete(bucket);
+		bucket = next;
+	}
+
+	while (free_pages) {
+		Page *next = free_pages->next;
+		memfree(free_pages);
+		free_pages = next;
 	}
 
 	singleton = NULL;
-	memdelete_arr(buffer);
 }
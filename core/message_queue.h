@@ -34,13 +34,22 @@
 #include "core/object.h"
 #include "core/os/thread_safe.h"
 
+/**
+	Messages are appended to a bucket owned by the pushing thread, so
+	producers on different threads never wait on each other. Buckets are
+	made of pages that are allocated as needed and recycled after a flush.
+	flush() runs the main thread's messages first, then those of every
+	other thread in the order those threads first pushed a message.
+*/
+
 class MessageQueue {
 
 	_THREAD_SAFE_CLASS_
 
 	enum {
 
-		DEFAULT_QUEUE_SIZE_KB = 1024
+		DEFAULT_QUEUE_SIZE_KB = 1024,
+		PAGE_SIZE = 64 * 1024
 	};
 
 	enum {
@@ -63,10 +72,46 @@ class MessageQueue {
 		};
 	};
 
-	uint8_t *buffer;
-	uint32_t buffer_end;
+	struct Page {
+
+		Page *next;
+		uint32_t end;
+		uint32_t size;
+		// messages follow
+	};
+
+	struct Bucket {
+
+		Page *first;
+		Page *last;
+		Bucket *next;
+		volatile uint32_t lock;
+		bool owned; // false once the thread that pushed into it has exited
+	};
+
+	struct BucketGuard {
+		~BucketGuard();
+	};
+
+	Bucket *buckets;
+	Bucket *buckets_last;
+	Page *free_pages;
+	uint32_t free_size;
+	uint32_t keep_size;
 	uint32_t buffer_max_used;
-	uint32_t buffer_size;
+	uint64_t generation;
+
+#ifndef NO_THREADS
+	static thread_local Bucket *thread_bucket;
+	static thread_local uint64_t thread_generation;
+#endif
+
+	_FORCE_INLINE_ Bucket *_get_bucket();
+	Bucket *_register_thread();
+	uint8_t *_alloc(Bucket *p_bucket, uint32_t p_size);
+	Page *_take_page(uint32_t p_size);
+	void _release_pages(Page *p_pages);
+	static void _destroy_messages(Page *p_page);
 
 	void _call_function(Object *p_target, const StringName &p_func, const Variant *p_args, int p_argcount, bool p_show_error);
 
@@ -78,6 +123,8 @@ public:
 	static MessageQueue *get_singleton();
 
 	Error push_call(ObjectID p_id, const StringName &p_method, const Variant **p_args, int p_argcount, bool p_show_error = false);
+	// Takes the values out of p_args instead of copying them, leaving them null.
+	Error push_call_move(ObjectID p_id, const StringName &p_method, Variant *p_args, int p_argcount, bool p_show_error = false);
 	Error push_call(ObjectID p_id, const StringName &p_method, VARIANT_ARG_LIST);
 	Error push_notification(ObjectID p_id, int p_notification);
 	Error push_set(ObjectID p_id, const StringName &p_prop, const Variant &p_value);
@@ -36,6 +36,7 @@
 #include "core/os/os.h"
 #include "core/print_string.h"
 #include "core/resource.h"
+#include "core/safe_refcount.h"
 #include "core/script_language.h"
 #include "core/translation.h"
 
@@ -1181,9 +1182,11 @@ Error Object::emit_signal(const StringName &p_name, const Variant **p_args, int
 	//copy on write will ensure that disconnecting the signal or even deleting the object will not affect the signal calling.
 	//this happens automatically and will not change the performance of calling.
 	//awesome, isn't it?
-	VMap<Signal::Target, Signal::Slot> slot_map = s->slot_map;
+	//the copy must stay const, non-const access would duplicate the slots on every emit.
+	const VMap<Signal::Target, Signal::Slot> slot_map = s->slot_map;
 
 	int ssize = slot_map.size();
+	const VMap<Signal::Target, Signal::Slot>::Pair *slot_list = slot_map.get_array();
 
 	OBJ_DEBUG_LOCK
 
@@ -1193,11 +1196,12 @@ Error Object::emit_signal(const StringName &p_name, const Variant **p_args, int
 
 	for (int i = 0; i < ssize; i++) {
 
-		const Connection &c = slot_map.getv(i).conn;
+		const Signal::Slot &slot = slot_list[i].value;
+		const Connection &c = slot.conn;
 
 		Object *target;
 #ifdef DEBUG_ENABLED
-		target = ObjectDB::get_instance(slot_map.getk(i)._id);
+		target = ObjectDB::get_instance(slot_list[i].key._id);
 		ERR_CONTINUE(!target);
 #else
 		target = c.target;
@@ -1225,7 +1229,15 @@ Error Object::emit_signal(const StringName &p_name, const Variant **p_args, int
 			MessageQueue::get_singleton()->push_call(target->get_instance_id(), c.method, args, argc, true);
 		} else {
 			Variant::CallError ce;
-			target->call(c.method, args, argc, ce);
+			if (slot.method_bind && !target->script_instance) {
+				// Skip the method lookup in Object::call(), scripts may still override it.
+#ifdef DEBUG_ENABLED
+				_ObjectDebugLock target_lock(target);
+#endif
+				slot.method_bind->call(target, args, argc, ce);
+			} else {
+				target->call(c.method, args, argc, ce);
+			}
 
 			if (ce.error != Variant::CallError::CALL_OK) {
 #ifdef DEBUG_ENABLED
@@ -1485,6 +1497,7 @@ Error Object::connect(const StringName &p_signal, Object *p_to_object, const Str
 	conn.binds = p_binds;
 	slot.conn = conn;
 	slot.cE = p_to_object->connections.push_back(conn);
+	slot.method_bind = ClassDB::get_method(p_to_object->get_class_name(), p_to_method);
 	if (p_flags & CONNECT_REFERENCE_COUNTED) {
 		slot.reference_count = 1;
 	}
@@ -2015,54 +2028,138 @@ void postinitialize_handler(Object *p_object) {
 	p_object->_postinitialize();
 }
 
-HashMap<ObjectID, Object *> ObjectDB::instances;
-ObjectID ObjectDB::instance_counter = 1;
-HashMap<Object *, ObjectID, ObjectDB::ObjectPtrHash> ObjectDB::instance_checks;
+ObjectDB::Slot *volatile ObjectDB::blocks[ObjectDB::BLOCK_MAX] = {};
+volatile uint32_t ObjectDB::slots_used = 0;
+volatile uint64_t ObjectDB::free_head = 0;
+volatile uint32_t ObjectDB::object_count = 0;
+Mutex *ObjectDB::block_mutex = NULL;
+ObjectDB::CheckShard ObjectDB::check_shards[ObjectDB::CHECK_SHARDS];
+
+uint32_t ObjectDB::_alloc_slot() {
+
+	// Pop a recycled slot from the free list.
+	while (true) {
+		uint64_t head = free_head;
+		uint32_t idx = head & 0xFFFFFFFF;
+		if (idx == 0)
+			break;
+
+		uint32_t next = _get_slot(idx - 1).next_free;
+		uint64_t new_head = (((head >> 32) + 1) << 32) | next;
+		if (atomic_compare_exchange(&free_head, head, new_head))
+			return idx - 1;
+	}
+
+	// None free, take a new one.
+	uint32_t slot = atomic_increment(&slots_used) - 1;
+	if (slot >= SLOT_MAX) {
+		ERR_EXPLAIN("Too many objects, the maximum is " + itos(SLOT_MAX) + ".");
+		ERR_FAIL_V(SLOT_MAX);
+	}
+
+	uint32_t block = slot >> BLOCK_BITS;
+	if (!blocks[block]) {
+		block_mutex->lock();
+		if (!blocks[block]) {
+			Slot *new_block = memnew_arr(Slot, BLOCK_SIZE);
+			for (int i = 0; i < BLOCK_SIZE; i++) {
+				new_block[i].validator = 1;
+				new_block[i].object = NULL;
+				new_block[i].next_free = 0;
+			}
+			blocks[block] = new_block;
+		}
+		block_mutex->unlock();
+	}
+
+	return slot;
+}
+
+void ObjectDB::_free_slot(uint32_t p_slot) {
+
+	Slot &s = _get_slot(p_slot);
+
+	while (true) {
+		uint64_t head = free_head;
+		s.next_free = head & 0xFFFFFFFF;
+		uint64_t new_head = (((head >> 32) + 1) << 32) | (p_slot + 1);
+		if (atomic_compare_exchange(&free_head, head, new_head))
+			return;
+	}
+}
+
 ObjectID ObjectDB::add_instance(Object *p_object) {
 
 	ERR_FAIL_COND_V(p_object->get_instance_id() != 0, 0);
 
-	rw_lock->write_lock();
-	ObjectID instance_id = ++instance_counter;
-	instances[instance_id] = p_object;
-	instance_checks[p_object] = instance_id;
+	uint32_t slot = _alloc_slot();
+	ERR_FAIL_COND_V(slot == SLOT_MAX, 0);
 
-	rw_lock->write_unlock();
+	Slot &s = _get_slot(slot);
+	s.object = p_object;
+	ObjectID instance_id = (s.validator << SLOT_BITS) | slot;
+	atomic_increment(&object_count);
+
+	CheckShard &shard = _get_check_shard(p_object);
+	shard.lock->write_lock();
+	shard.checks[p_object] = instance_id;
+	shard.lock->write_unlock();
 
 	return instance_id;
 }
 
 void ObjectDB::remove_instance(Object *p_object) {
 
-	rw_lock->write_lock();
+	CheckShard &shard = _get_check_shard(p_object);
+	shard.lock->write_lock();
+	shard.checks.erase(p_object);
+	shard.lock->write_unlock();
+
+	ObjectID instance_id = p_object->get_instance_id();
+	if (instance_id == 0)
+		return; // Never added, e.g. too many objects.
+
+	uint32_t slot = instance_id & SLOT_MASK;
+	Slot &s = _get_slot(slot);
+	ERR_FAIL_COND(s.object != p_object);
 
-	instances.erase(p_object->get_instance_id());
-	instance_checks.erase(p_object);
+	// Invalidate the ID before the slot can be reused.
+	uint64_t validator = s.validator;
+	atomic_compare_exchange(&s.validator, validator, validator < VALIDATOR_MAX ? validator + 1 : 1);
+	s.object = NULL;
 
-	rw_lock->write_unlock();
+	_free_slot(slot);
+	atomic_decrement(&object_count);
 }
+
 Object *ObjectDB::get_instance(ObjectID p_instance_ID) {
 
-	rw_lock->read_lock();
-	Object **obj = instances.getptr(p_instance_ID);
-	rw_lock->read_unlock();
+	uint32_t slot = p_instance_ID & SLOT_MASK;
+	Slot *block = blocks[slot >> BLOCK_BITS];
+	if (!block)
+		return NULL;
 
-	if (!obj)
+	const Slot &s = block[slot & BLOCK_MASK];
+	Object *obj = s.object;
+	if (s.validator != (p_instance_ID >> SLOT_BITS))
 		return NULL;
-	return *obj;
+
+	return obj;
 }
 
 void ObjectDB::debug_objects(DebugFunc p_func) {
 
-	rw_lock->read_lock();
+	uint32_t used = MIN(slots_used, (uint32_t)SLOT_MAX);
+	for (uint32_t i = 0; i < used; i++) {
 
-	const ObjectID *K = NULL;
-	while ((K = instances.next(K))) {
+		Slot *block = blocks[i >> BLOCK_BITS];
+		if (!block)
+			continue;
 
-		p_func(instances[*K]);
+		Object *obj = block[i & BLOCK_MASK].object;
+		if (obj)
+			p_func(obj);
 	}
-
-	rw_lock->read_unlock();
 }
 
 void Object::get_argument_options(const StringName &p_function, int p_idx, List<String> *r_options) const {
@@ -2070,41 +2167,55 @@ void Object::get_argument_options(const StringName &p_function, int p_idx, List<
 
 int ObjectDB::get_object_count() {
 
-	rw_lock->read_lock();
-	int count = instances.size();
-	rw_lock->read_unlock();
-
-	return count;
+	return object_count;
 }
 
-RWLock *ObjectDB::rw_lock = NULL;
-
 void ObjectDB::setup() {
 
-	rw_lock = RWLock::create();
+	block_mutex = Mutex::create();
+	for (int i = 0; i < CHECK_SHARDS; i++) {
+		check_shards[i].lock = RWLock::create();
+	}
 }
 
 void ObjectDB::cleanup() {
 
-	rw_lock->write_lock();
-	if (instances.size()) {
+	if (object_count) {
 
 		WARN_PRINT("ObjectDB Instances still exist!");
 		if (OS::get_singleton()->is_stdout_verbose()) {
-			const ObjectID *K = NULL;
-			while ((K = instances.next(K))) {
+			uint32_t used = MIN(slots_used, (uint32_t)SLOT_MAX);
+			for (uint32_t i = 0; i < used; i++) {
+
+				Object *obj = _get_slot(i).object;
+				if (!obj)
+					continue;
 
 				String node_name;
-				if (instances[*K]->is_class("Node"))
-					node_name = " - Node name: " + String(instances[*K]->call("get_name"));
-				if (instances[*K]->is_class("Resource"))
-					node_name = " - Resource name: " + String(instances[*K]->call("get_name")) + " Path: " + String(instances[*K]->call("get_path"));
-				print_line("Leaked instance: " + String(instances[*K]->get_class()) + ":" + itos(*K) + node_name);
+				if (obj->is_class("Node"))
+					node_name = " - Node name: " + String(obj->call("get_name"));
+				if (obj->is_class("Resource"))
+					node_name = " - Resource name: " + String(obj->call("get_name")) + " Path: " + String(obj->call("get_path"));
+				print_line("Leaked instance: " + String(obj->get_class()) + ":" + itos(obj->get_instance_id()) + node_name);
 			}
 		}
 	}
-	instances.clear();
-	instance_checks.clear();
-	rw_lock->write_unlock();
-	memdelete(rw_lock);
+
+	for (int i = 0; i < BLOCK_MAX; i++) {
+		if (blocks[i]) {
+			memdelete_arr(blocks[i]);
+			blocks[i] = NULL;
+		}
+	}
+	slots_used = 0;
+	free_head = 0;
+	object_count = 0;
+
+	for (int i = 0; i < CHECK_SHARDS; i++) {
+		check_shards[i].checks.clear();
+		memdelete(check_shards[i].lock);
+		check_shards[i].lock = NULL;
+	}
+	memdelete(block_mutex);
+	block_mutex = NULL;
 }
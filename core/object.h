@@ -34,6 +34,7 @@
 #include "core/hash_map.h"
 #include "core/list.h"
 #include "core/map.h"
+#include "core/os/mutex.h"
 #include "core/os/rw_lock.h"
 #include "core/set.h"
 #include "core/variant.h"
@@ -383,6 +384,7 @@ public:                                                        \
                                                                \
 private:
 
+class MethodBind;
 class ScriptInstance;
 typedef uint64_t ObjectID;
 
@@ -447,7 +449,12 @@ private:
 			int reference_count;
 			Connection conn;
 			List<Connection>::Element *cE;
-			Slot() { reference_count = 0; }
+			MethodBind *method_bind; // Resolved at connect time, used while the target has no script.
+			Slot() {
+				reference_count = 0;
+				cE = NULL;
+				method_bind = NULL;
+			}
 		};
 
 		MethodInfo user;
@@ -757,14 +764,57 @@ class ObjectDB {
 		}
 	};
 
-	static HashMap<ObjectID, Object *> instances;
-	static HashMap<Object *, ObjectID, ObjectPtrHash> instance_checks;
+	// Objects are kept in slots, allocated in blocks that are never moved or freed until
+	// cleanup, so looking up an ObjectID is a plain array access without locking.
+	// An ObjectID is the slot index in the low bits, and the slot validator in the high
+	// bits. The validator is bumped when the slot is freed, invalidating old IDs.
+	enum {
+		SLOT_BITS = 24,
+		SLOT_MASK = (1 << SLOT_BITS) - 1,
+		SLOT_MAX = 1 << SLOT_BITS,
+		BLOCK_BITS = 12,
+		BLOCK_MASK = (1 << BLOCK_BITS) - 1,
+		BLOCK_SIZE = 1 << BLOCK_BITS,
+		BLOCK_MAX = SLOT_MAX / BLOCK_SIZE,
+		CHECK_SHARDS = 16
+	};
+
+	static const uint64_t VALIDATOR_MAX = (uint64_t(1) << (63 - SLOT_BITS)) - 1; // IDs stay positive as int64.
+
+	struct Slot {
+		volatile uint64_t validator;
+		Object *volatile object;
+		volatile uint32_t next_free; // Index + 1 of the next free slot, 0 for none.
+	};
+
+	static Slot *volatile blocks[BLOCK_MAX];
+	static volatile uint32_t slots_used;
+	static volatile uint64_t free_head; // ABA tag in the high 32 bits, index + 1 of the first free slot in the low ones.
+	static volatile uint32_t object_count;
+	static Mutex *block_mutex;
+
+	// Validating a raw pointer can't dereference it, so it still needs a hash lookup.
+	// It is split by pointer hash, each shard with its own lock, to reduce contention.
+	struct CheckShard {
+		HashMap<Object *, ObjectID, ObjectPtrHash> checks;
+		RWLock *lock;
+	};
+
+	static CheckShard check_shards[CHECK_SHARDS];
+
+	_FORCE_INLINE_ static CheckShard &_get_check_shard(Object *p_obj) {
+		return check_shards[ObjectPtrHash::hash(p_obj) & (CHECK_SHARDS - 1)];
+	}
+	_FORCE_INLINE_ static Slot &_get_slot(uint32_t p_slot) {
+		return blocks[p_slot >> BLOCK_BITS][p_slot & BLOCK_MASK];
+	}
+
+	static uint32_t _alloc_slot();
+	static void _free_slot(uint32_t p_slot);
 
-	static ObjectID instance_counter;
 	friend class Object;
 	friend void unregister_core_types();
 
-	static RWLock *rw_lock;
 	static void cleanup();
 	static ObjectID add_instance(Object *p_object);
 	static void remove_instance(Object *p_object);
@@ -780,7 +830,11 @@ public:
 
 	_FORCE_INLINE_ static bool instance_validate(Object *p_ptr) {
 
-		return instance_checks.has(p_ptr);
+		CheckShard &shard = _get_check_shard(p_ptr);
+		shard.lock->read_lock();
+		bool valid = shard.checks.has(p_ptr);
+		shard.lock->read_unlock();
+		return valid;
 	}
 };
 
@@ -0,0 +1,540 @@
+/*************************************************************************/
+/*  ordered_oa_hash_map.h                                                */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2019 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2019 Godot Engine contributors (cf. AUTHORS.md)    */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#ifndef ORDERED_OA_HASH_MAP_H
+#define ORDERED_OA_HASH_MAP_H
+
+#include "core/hashfuncs.h"
+#include "core/os/copymem.h"
+#include "core/os/memory.h"
+
+/**
+ * An insertion-ordered hash map laid out for many small maps, such as the
+ * ones backing Dictionary.
+ *
+ * Entries are stored in a slab made of blocks that double in size and never
+ * move, so references to keys and values stay valid until that entry is
+ * erased. Insertion order is a separate array of slab indices; erasing only
+ * leaves a hole in it, and holes are squeezed out when the array would grow.
+ *
+ * Maps of up to SMALL_SIZE entries are searched linearly and never hash their
+ * keys. Bigger maps build an open addressing index (linear probing) over the
+ * slab. The hash of each key is kept with its entry, so growing the index or
+ * copying the map does not hash anything again.
+ */
+template <class TKey, class TValue,
+		class Hasher = HashMapHasherDefault,
+		class Comparator = HashMapComparatorDefault<TKey> >
+class OrderedOAHashMap {
+public:
+	enum {
+		SMALL_SIZE = 8
+	};
+
+private:
+	enum {
+		FIRST_BLOCK_SHIFT = 2,
+		FIRST_BLOCK_SIZE = 1 << FIRST_BLOCK_SHIFT,
+		MAX_BLOCKS = 31 - FIRST_BLOCK_SHIFT,
+		MIN_INDEX_CAPACITY = 32
+	};
+
+	static const uint32_t INVALID = 0xFFFFFFFF;
+	static const uint32_t INDEX_EMPTY = 0;
+	static const uint32_t INDEX_DELETED = 0xFFFFFFFF;
+
+	struct Entry {
+		TKey key;
+		TValue value;
+		uint32_t hash;
+		uint32_t order_pos; // Position in order, or the next free slot once erased.
+	};
+
+	// The first block also holds the order array while it fits, so a small
+	// map needs a single allocation.
+	Entry *first_block;
+	Entry **blocks;
+	uint32_t *order;
+	uint32_t *index;
+
+	uint32_t num_elements;
+	uint32_t num_slots;
+	uint32_t free_slot;
+	uint32_t order_size;
+	uint32_t order_capacity;
+	uint32_t order_erased;
+	uint32_t index_capacity;
+	uint32_t index_used;
+
+	static _FORCE_INLINE_ uint32_t _floor_log2(uint32_t p_value) {
+#if defined(__GNUC__)
+		return 31 - __builtin_clz(p_value);
+#else
+		return nearest_shift(p_value) - 1;
+#endif
+	}
+
+	_FORCE_INLINE_ Entry &_get_entry(uint32_t p_slot) const {
+
+		if (p_slot < FIRST_BLOCK_SIZE) {
+			return first_block[p_slot];
+		}
+		uint32_t shift = _floor_log2(p_slot);
+		return blocks[shift - FIRST_BLOCK_SHIFT][p_slot - (1 << shift)];
+	}
+
+	_FORCE_INLINE_ uint32_t *_get_inline_order() const {
+
+		return (uint32_t *)(first_block + FIRST_BLOCK_SIZE);
+	}
+
+	uint32_t _alloc_slot() {
+
+		if (free_slot != INVALID) {
+			uint32_t slot = free_slot;
+			free_slot = _get_entry(slot).order_pos;
+			return slot;
+		}
+
+		uint32_t slot = num_slots;
+
+		if (!first_block) {
+			first_block = (Entry *)memalloc(sizeof(Entry) * FIRST_BLOCK_SIZE + sizeof(uint32_t) * FIRST_BLOCK_SIZE);
+			order = _get_inline_order();
+			order_capacity = FIRST_BLOCK_SIZE;
+		} else if (slot >= FIRST_BLOCK_SIZE && (slot & (slot - 1)) == 0) {
+			// First slot of a new block, which is as big as all previous ones.
+			if (!blocks) {
+				blocks = (Entry **)memalloc(sizeof(Entry *) * MAX_BLOCKS);
+				zeromem(blocks, sizeof(Entry *) * MAX_BLOCKS);
+			}
+			blocks[_floor_log2(slot) - FIRST_BLOCK_SHIFT] = (Entry *)memalloc(sizeof(Entry) * slot);
+		}
+
+		num_slots++;
+		return slot;
+	}
+
+	void _compact_order() {
+
+		uint32_t dst = 0;
+		for (uint32_t i = 0; i < order_size; i++) {
+			uint32_t slot = order[i];
+			if (slot == INVALID) {
+				continue;
+			}
+			order[dst] = slot;
+			_get_entry(slot).order_pos = dst;
+			dst++;
+		}
+		order_size = dst;
+		order_erased = 0;
+	}
+
+	void _push_order(uint32_t p_slot) {
+
+		if (order_size == order_capacity) {
+			if (order_erased > order_size / 2) {
+				_compact_order();
+			} else {
+				uint32_t *new_order = (uint32_t *)memalloc(sizeof(uint32_t) * order_capacity * 2);
+				copymem(new_order, order, sizeof(uint32_t) * order_size);
+				if (order != _get_inline_order()) {
+					memfree(order);
+				}
+				order = new_order;
+				order_capacity *= 2;
+			}
+		}
+
+		_get_entry(p_slot).order_pos = order_size;
+		order[order_size++] = p_slot;
+	}
+
+	void _index_insert(uint32_t p_hash, uint32_t p_slot) {
+
+		uint32_t mask = index_capacity - 1;
+		uint32_t pos = p_hash & mask;
+		while (index[pos] != INDEX_EMPTY && index[pos] != INDEX_DELETED) {
+			pos = (pos + 1) & mask;
+		}
+		if (index[pos] == INDEX_EMPTY) {
+			index_used++;
+		}
+		index[pos] = p_slot + 1;
+	}
+
+	void _rebuild_index() {
+
+		uint32_t capacity = next_power_of_2(num_elements * 4);
+		if (capacity < MIN_INDEX_CAPACITY) {
+			capacity = MIN_INDEX_CAPACITY;
+		}
+
+		if (index) {
+			memfree(index);
+		}
+		index = (uint32_t *)memalloc(sizeof(uint32_t) * capacity);
+		zeromem(index, sizeof(uint32_t) * capacity);
+		index_capacity = capacity;
+		index_used = 0;
+
+		for (uint32_t i = 0; i < order_size; i++) {
+			uint32_t slot = order[i];
+			if (slot != INVALID) {
+				_index_insert(_get_entry(slot).hash, slot);
+			}
+		}
+	}
+
+	// Returns the slot holding p_key, or INVALID. When the map is indexed,
+	// r_hash receives the key's hash and r_index_pos its index position.
+	uint32_t _find_slot(const TKey &p_key, uint32_t *r_hash = NULL, uint32_t *r_index_pos = NULL) const {
+
+		if (!index) {
+			for (uint32_t i = 0; i < order_size; i++) {
+				uint32_t slot = order[i];
+				if (slot != INVALID && Comparator::compare(_get_entry(slot).key, p_key)) {
+					return slot;
+				}
+			}
+			return INVALID;
+		}
+
+		uint32_t hash = Hasher::hash(p_key);
+		if (r_hash) {
+			*r_hash = hash;
+		}
+
+		uint32_t mask = index_capacity - 1;
+		uint32_t pos = hash & mask;
+		while (true) {
+			uint32_t idx = index[pos];
+			if (idx == INDEX_EMPTY) {
+				return INVALID;
+			}
+			if (idx != INDEX_DELETED) {
+				const Entry &e = _get_entry(idx - 1);
+				if (e.hash == hash && Comparator::compare(e.key, p_key)) {
+					if (r_index_pos) {
+						*r_index_pos = pos;
+					}
+					return idx - 1;
+				}
+			}
+			pos = (pos + 1) & mask;
+		}
+	}
+
+	TValue &_insert_new(const TKey &p_key, const TValue &p_value, uint32_t p_hash) {
+
+		uint32_t slot = _alloc_slot();
+		Entry &e = _get_entry(slot);
+		memnew_placement(&e.key, TKey(p_key));
+		memnew_placement(&e.value, TValue(p_value));
+		_push_order(slot);
+		num_elements++;
+
+		if (index) {
+			e.hash = p_hash;
+			if ((index_used + 1) * 2 > index_capacity) {
+				_rebuild_index();
+			} else {
+				_index_insert(p_hash, slot);
+			}
+		} else if (num_elements > SMALL_SIZE) {
+			// Small maps never hashed their keys, do it once now.
+			for (uint32_t i = 0; i < order_size; i++) {
+				if (order[i] != INVALID) {
+					Entry &f = _get_entry(order[i]);
+					f.hash = Hasher::hash(f.key);
+				}
+			}
+			_rebuild_index();
+		}
+
+		return e.value;
+	}
+
+	void _erase_slot(uint32_t p_slot, uint32_t p_index_pos) {
+
+		Entry &e = _get_entry(p_slot);
+
+		if (index) {
+			index[p_index_pos] = INDEX_DELETED;
+		}
+
+		order[e.order_pos] = INVALID;
+		order_erased++;
+		while (order_size && order[order_size - 1] == INVALID) {
+			order_size--;
+			order_erased--;
+		}
+
+		e.key.~TKey();
+		e.value.~TValue();
+		e.order_pos = free_slot;
+		free_slot = p_slot;
+		num_elements--;
+	}
+
+	void _copy_from(const OrderedOAHashMap &p_from) {
+
+		for (uint32_t i = 0; i < p_from.order_size; i++) {
+			uint32_t from_slot = p_from.order[i];
+			if (from_slot == INVALID) {
+				continue;
+			}
+			const Entry &from = p_from._get_entry(from_slot);
+			uint32_t slot = _alloc_slot();
+			Entry &e = _get_entry(slot);
+			memnew_placement(&e.key, TKey(from.key));
+			memnew_placement(&e.value, TValue(from.value));
+			e.hash = from.hash;
+			_push_order(slot);
+			num_elements++;
+		}
+
+		if (num_elements > SMALL_SIZE) {
+			_rebuild_index();
+		}
+	}
+
+	void _init() {
+
+		first_block = NULL;
+		blocks = NULL;
+		order = NULL;
+		index = NULL;
+		num_elements = 0;
+		num_slots = 0;
+		free_slot = INVALID;
+		order_size = 0;
+		order_capacity = 0;
+		order_erased = 0;
+		index_capacity = 0;
+		index_used = 0;
+	}
+
+public:
+	struct Iterator {
+		bool valid;
+
+		const TKey *key;
+		TValue *value;
+
+	private:
+		uint32_t pos;
+		friend class OrderedOAHashMap;
+	};
+
+private:
+	Iterator _iter_from(uint32_t p_pos) {
+
+		Iterator it;
+		it.valid = false;
+		it.key = NULL;
+		it.value = NULL;
+		it.pos = p_pos;
+
+		for (uint32_t i = p_pos; i < order_size; i++) {
+			if (order[i] == INVALID) {
+				continue;
+			}
+			Entry &e = _get_entry(order[i]);
+			it.valid = true;
+			it.key = &e.key;
+			it.value = &e.value;
+			it.pos = i;
+			break;
+		}
+
+		return it;
+	}
+
+public:
+	_FORCE_INLINE_ uint32_t size() const { return num_elements; }
+	_FORCE_INLINE_ bool empty() const { return num_elements == 0; }
+
+	const TValue *getptr(const TKey &p_key) const {
+
+		uint32_t slot = _find_slot(p_key);
+		return slot == INVALID ? NULL : &_get_entry(slot).value;
+	}
+
+	TValue *getptr(const TKey &p_key) {
+
+		uint32_t slot = _find_slot(p_key);
+		return slot == INVALID ? NULL : &_get_entry(slot).value;
+	}
+
+	_FORCE_INLINE_ bool has(const TKey &p_key) const {
+
+		return _find_slot(p_key) != INVALID;
+	}
+
+	void set(const TKey &p_key, const TValue &p_value) {
+
+		uint32_t hash = 0;
+		uint32_t slot = _find_slot(p_key, &hash);
+		if (slot != INVALID) {
+			_get_entry(slot).value = p_value;
+		} else {
+			_insert_new(p_key, p_value, hash);
+		}
+	}
+
+	bool erase(const TKey &p_key) {
+
+		uint32_t index_pos = 0;
+		uint32_t slot = _find_slot(p_key, NULL, &index_pos);
+		if (slot == INVALID) {
+			return false;
+		}
+		_erase_slot(slot, index_pos);
+		return true;
+	}
+
+	const TValue &operator[](const TKey &p_key) const {
+
+		uint32_t slot = _find_slot(p_key);
+		CRASH_COND(slot == INVALID);
+		return _get_entry(slot).value;
+	}
+
+	TValue &operator[](const TKey &p_key) {
+
+		uint32_t hash = 0;
+		uint32_t slot = _find_slot(p_key, &hash);
+		if (slot != INVALID) {
+			return _get_entry(slot).value;
+		}
+		// consistent with Map behaviour
+		return _insert_new(p_key, TValue(), hash);
+	}
+
+	Iterator iter() {
+
+		return _iter_from(0);
+	}
+
+	Iterator next_iter(const Iterator &p_iter) {
+
+		if (!p_iter.valid) {
+			return p_iter;
+		}
+		return _iter_from(p_iter.pos + 1);
+	}
+
+	Iterator find_iter(const TKey &p_key) {
+
+		uint32_t slot = _find_slot(p_key);
+		if (slot == INVALID) {
+			return _iter_from(order_size);
+		}
+		return _iter_from(_get_entry(slot).order_pos);
+	}
+
+	// Returns the p_index-th entry in insertion order. Constant time unless
+	// entries were erased since the order array was last compacted.
+	Iterator iter_at(uint32_t p_index) {
+
+		if (p_index >= num_elements) {
+			return _iter_from(order_size);
+		}
+		if (order_erased == 0) {
+			return _iter_from(p_index);
+		}
+
+		Iterator it = iter();
+		for (uint32_t i = 0; i < p_index; i++) {
+			it = next_iter(it);
+		}
+		return it;
+	}
+
+	void clear() {
+
+		for (uint32_t i = 0; i < order_size; i++) {
+			if (order[i] != INVALID) {
+				Entry &e = _get_entry(order[i]);
+				e.key.~TKey();
+				e.value.~TValue();
+			}
+		}
+
+		if (blocks) {
+			for (uint32_t i = 0; i < MAX_BLOCKS; i++) {
+				if (blocks[i]) {
+					memfree(blocks[i]);
+				}
+			}
+			memfree(blocks);
+		}
+		if (order && order != _get_inline_order()) {
+			memfree(order);
+		}
+		if (first_block) {
+			memfree(first_block);
+		}
+		if (index) {
+			memfree(index);
+		}
+
+		_init();
+	}
+
+	void operator=(const OrderedOAHashMap &p_from) {
+
+		if (this == &p_from) {
+			return;
+		}
+		clear();
+		_copy_from(p_from);
+	}
+
+	OrderedOAHashMap(const OrderedOAHashMap &p_from) {
+
+		_init();
+		_copy_from(p_from);
+	}
+
+	OrderedOAHashMap() {
+
+		_init();
+	}
+
+	~OrderedOAHashMap() {
+
+		clear();
+	}
+};
+
+#endif // ORDERED_OA_HASH_MAP_H
@@ -32,7 +32,10 @@
 
 #include "core/io/file_access_pack.h"
 #include "core/io/marshalls.h"
+#include "core/os/mutex.h"
 #include "core/os/os.h"
+#include "core/os/semaphore.h"
+#include "core/os/thread.h"
 #include "core/project_settings.h"
 
 #include "thirdparty/misc/md5.h"
@@ -44,6 +47,14 @@ FileAccess::FileCloseFailNotify FileAccess::close_fail_notify = NULL;
 
 bool FileAccess::backup_save = false;
 
+Mutex *FileAccess::async_mutex = NULL;
+Semaphore *FileAccess::async_semaphore = NULL;
+Thread *FileAccess::async_threads[ASYNC_READ_THREADS];
+bool FileAccess::async_threads_started = false;
+bool FileAccess::async_exit = false;
+FileAccess::AsyncRead *FileAccess::async_queue = NULL;
+FileAccess::AsyncRead *FileAccess::async_queue_last = NULL;
+
 FileAccess *FileAccess::create(AccessType p_access) {
 
 	ERR_FAIL_INDEX_V(p_access, ACCESS_MAX, 0);
@@ -673,6 +684,152 @@ String FileAccess::get_sha256(const String &p_file) {
 	return String::hex_encode_buffer(hash, 32);
 }
 
+Error FileAccess::read_async(AsyncRead *p_read) {
+
+	ERR_FAIL_COND_V(!p_read, ERR_INVALID_PARAMETER);
+
+	p_read->done = 0;
+	p_read->result = 0;
+	p_read->file = this;
+	p_read->file_offset = p_read->offset;
+	p_read->file_length = p_read->length;
+	p_read->next = NULL;
+
+	if (p_read->length < 0 || (p_read->length && !p_read->dst)) {
+		_complete_async_read(p_read, -1);
+		ERR_FAIL_V(ERR_INVALID_PARAMETER);
+	}
+
+	return _read_async(p_read);
+}
+
+Error FileAccess::_read_async(AsyncRead *p_read) {
+
+	// Nothing can read next to the cursor, so read right away and put it back.
+	size_t pos = get_position();
+	seek(p_read->file_offset);
+	int read = get_buffer(p_read->dst, p_read->file_length);
+	seek(pos);
+
+	_complete_async_read(p_read, read);
+	return OK;
+}
+
+int FileAccess::wait_async_read(AsyncRead *p_read) {
+
+	int spins = 0;
+	while (!p_read->is_done()) {
+		if (++spins > 64) {
+			OS::get_singleton()->delay_usec(50);
+		}
+	}
+	return p_read->result;
+}
+
+void FileAccess::_complete_async_read(AsyncRead *p_read, int p_result) {
+
+	p_read->result = p_result;
+	if (p_read->callback) {
+		p_read->callback(p_read);
+	}
+	// The request may be freed as soon as this is seen.
+	atomic_increment(&p_read->done);
+}
+
+void FileAccess::_async_thread_function(void *p_user) {
+
+	while (true) {
+		async_semaphore->wait();
+
+		async_mutex->lock();
+		AsyncRead *read = async_queue;
+		if (read) {
+			async_queue = read->next;
+			if (!async_queue) {
+				async_queue_last = NULL;
+			}
+		}
+		bool exit = async_exit && !async_queue;
+		async_mutex->unlock();
+
+		if (read) {
+			_complete_async_read(read, read->file->_read_at(read->file_offset, read->dst, read->file_length));
+		}
+		if (exit) {
+			break;
+		}
+	}
+}
+
+void FileAccess::_queue_async_read(AsyncRead *p_read) {
+
+	if (!async_mutex) {
+		_complete_async_read(p_read, p_read->file->_read_at(p_read->file_offset, p_read->dst, p_read->file_length));
+		return;
+	}
+
+	async_mutex->lock();
+	if (!async_threads_started) {
+		// Started with the first read, most runs never need them.
+		for (int i = 0; i < ASYNC_READ_THREADS; i++) {
+			async_threads[i] = Thread::create(_async_thread_function, NULL);
+		}
+		async_threads_started = true;
+	}
+
+	p_read->next = NULL;
+	if (async_queue_last) {
+		async_queue_last->next = p_read;
+	} else {
+		async_queue = p_read;
+	}
+	async_queue_last = p_read;
+	async_mutex->unlock();
+
+	async_semaphore->post();
+}
+
+void FileAccess::setup_async_reads() {
+
+#ifndef NO_THREADS
+	async_mutex = Mutex::create();
+	async_semaphore = Semaphore::create();
+	if (!async_semaphore && async_mutex) {
+		memdelete(async_mutex);
+		async_mutex = NULL;
+	}
+#endif
+}
+
+void FileAccess::finish_async_reads() {
+
+	if (!async_mutex) {
+		return;
+	}
+
+	if (async_threads_started) {
+		async_mutex->lock();
+		async_exit = true;
+		async_mutex->unlock();
+
+		for (int i = 0; i < ASYNC_READ_THREADS; i++) {
+			async_semaphore->post();
+		}
+		for (int i = 0; i < ASYNC_READ_THREADS; i++) {
+			if (async_threads[i]) {
+				Thread::wait_to_finish(async_threads[i]);
+				memdelete(async_threads[i]);
+			}
+		}
+		async_threads_started = false;
+	}
+
+	memdelete(async_semaphore);
+	async_semaphore = NULL;
+	memdelete(async_mutex);
+	async_mutex = NULL;
+}
+
 FileAccess::FileAccess() {
 
 	endian_swap = false;
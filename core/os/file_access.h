@@ -33,9 +33,15 @@
 
 #include "core/math/math_defs.h"
 #include "core/os/memory.h"
+#include "core/pool_vector.h"
+#include "core/safe_refcount.h"
 #include "core/typedefs.h"
 #include "core/ustring.h"
 
+class Mutex;
+class Semaphore;
+class Thread;
+
 /**
  * Multi-Platform abstraction for accessing to files.
  */
@@ -110,6 +116,8 @@ public:
 	virtual real_t get_real() const;
 
 	virtual int get_buffer(uint8_t *p_dst, int p_length) const; ///< get an array of bytes
+	virtual uint8_t *map_buffer(uint64_t p_length, MemoryPool::ExternalMemory **r_owner) const { return NULL; } ///< map the next bytes copy-on-write and advance like get_buffer, NULL if unsupported
+
 	virtual String get_line() const;
 	virtual String get_token() const;
 	virtual Vector<String> get_csv_line(const String &p_delim = ",") const;
@@ -150,6 +158,56 @@ public:
 
 	virtual Error _chmod(const String &p_path, int p_mod) { return ERR_UNAVAILABLE; }
 
+	/**
+	 * A read running in the background. Set offset, dst and length (and optionally
+	 * callback and userdata), pass it to read_async() and keep it alive, along with
+	 * the file, until it is done.
+	 */
+	struct AsyncRead {
+		uint64_t offset;
+		uint8_t *dst;
+		int length;
+		void (*callback)(AsyncRead *p_read); ///< called from the thread completing the read, right before it is done
+		void *userdata;
+
+		volatile uint32_t done;
+		int result; ///< bytes read, -1 on error
+
+		// Used by the file while the read is in flight.
+		FileAccess *file;
+		uint64_t file_offset;
+		int file_length;
+		AsyncRead *next;
+		uint64_t backend_data[4];
+
+		_FORCE_INLINE_ bool is_done() { return atomic_add(&done, (uint32_t)0) != 0; }
+
+		AsyncRead() {
+			offset = 0;
+			dst = NULL;
+			length = 0;
+			callback = NULL;
+			userdata = NULL;
+			done = 0;
+			result = 0;
+			file = NULL;
+			file_offset = 0;
+			file_length = 0;
+			next = NULL;
+		}
+	};
+
+	Error read_async(AsyncRead *p_read); ///< read without moving the cursor, on error the read is done right away with a result of -1
+	static int wait_async_read(AsyncRead *p_read); ///< block until the read is done, returns its result
+	virtual Error _read_async(AsyncRead *p_read); ///< reads right away unless overridden, uses file_offset and file_length
+	virtual bool is_async_read_supported() const { return false; } ///< true when read_async() returns before the read is done
+
+protected:
+	virtual int _read_at(uint64_t p_offset, uint8_t *p_dst, int p_length) const { return -1; } ///< read without moving the cursor, callable from any thread
+	static void _queue_async_read(AsyncRead *p_read); ///< complete the read with _read_at() on an I/O thread
+	static void _complete_async_read(AsyncRead *p_read, int p_result);
+
+public:
 	static FileAccess *create(AccessType p_access); /// Create a file access (for the current platform) this is the only portable way of accessing files.
 	static FileAccess *create_for_path(const String &p_path);
 	static FileAccess *open(const String &p_path, int p_mode_flags, Error *r_error = NULL); /// Create a file access (for the current platform) this is the only portable way of accessing files.
@@ -166,12 +224,31 @@ public:
 
 	static Vector<uint8_t> get_file_as_array(const String &p_path);
 
+	static void setup_async_reads();
+	static void finish_async_reads();
+
 	template <class T>
 	static void make_default(AccessType p_access) {
 
 		create_func[p_access] = _create_builtin<T>;
 	}
 
+private:
+	enum {
+		ASYNC_READ_THREADS = 4
+	};
+
+	static Mutex *async_mutex;
+	static Semaphore *async_semaphore;
+	static Thread *async_threads[ASYNC_READ_THREADS];
+	static bool async_threads_started;
+	static bool async_exit;
+	static AsyncRead *async_queue;
+	static AsyncRead *async_queue_last;
+
+	static void _async_thread_function(void *p_user);
+
+public:
 	FileAccess();
 	virtual ~FileAccess() {}
 };
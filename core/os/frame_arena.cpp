@@ -0,0 +1,184 @@
+/*************************************************************************/
+/*  frame_arena.cpp                                                      */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2019 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2019 Godot Engine contributors (cf. AUTHORS.md)    */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#include "frame_arena.h"
+
+#include "core/os/memory.h"
+
+struct OverflowBlock {
+	OverflowBlock *next;
+	size_t size;
+};
+
+#define OVERFLOW_HEADER_SIZE ((sizeof(OverflowBlock) + FrameArena::ALIGNMENT - 1) & ~(size_t)(FrameArena::ALIGNMENT - 1))
+
+static uint8_t *block = NULL;
+static size_t block_size = 0;
+static size_t block_used = 0;
+static OverflowBlock *overflow = NULL;
+static size_t overflow_used = 0;
+static uint64_t peak_usage = 0;
+
+#ifdef NO_THREADS
+static bool arena_thread = false;
+#else
+static thread_local bool arena_thread = false;
+#endif
+
+static _FORCE_INLINE_ size_t _align(size_t p_bytes) {
+
+	return (p_bytes + FrameArena::ALIGNMENT - 1) & ~(size_t)(FrameArena::ALIGNMENT - 1);
+}
+
+void *FrameArena::alloc(size_t p_bytes) {
+
+	if (unlikely(!arena_thread)) {
+		return Memory::alloc_static(p_bytes);
+	}
+
+	size_t size = _align(p_bytes ? p_bytes : 1);
+
+	if (likely(block_used + size <= block_size)) {
+		void *ptr = block + block_used;
+		block_used += size;
+		return ptr;
+	}
+
+	// Does not fit this frame, give it a block of its own. The main block is
+	// resized on reset so the next frame does not spill again.
+	OverflowBlock *ob = (OverflowBlock *)Memory::alloc_static(OVERFLOW_HEADER_SIZE + size);
+	ERR_FAIL_COND_V(!ob, NULL);
+	ob->next = overflow;
+	ob->size = OVERFLOW_HEADER_SIZE + size;
+	overflow = ob;
+	overflow_used += size;
+	return (uint8_t *)ob + OVERFLOW_HEADER_SIZE;
+}
+
+void FrameArena::free(void *p_ptr) {
+
+	if (!p_ptr || owns(p_ptr)) {
+		return;
+	}
+
+	Memory::free_static(p_ptr);
+}
+
+bool FrameArena::owns(const void *p_ptr) {
+
+	const uint8_t *ptr = (const uint8_t *)p_ptr;
+	if (ptr >= block && ptr < block + block_size) {
+		return true;
+	}
+
+	for (OverflowBlock *ob = overflow; ob; ob = ob->next) {
+		if (ptr >= (const uint8_t *)ob && ptr < (const uint8_t *)ob + ob->size) {
+			return true;
+		}
+	}
+	return false;
+}
+
+bool FrameArena::is_available() {
+
+	return arena_thread;
+}
+
+void FrameArena::reset() {
+
+	ERR_FAIL_COND(!arena_thread);
+
+	size_t used = block_used + overflow_used;
+	if (used > peak_usage) {
+		peak_usage = used;
+	}
+
+	if (overflow) {
+		while (overflow) {
+			OverflowBlock *next = overflow->next;
+			Memory::free_static(overflow);
+			overflow = next;
+		}
+		overflow_used = 0;
+
+		size_t new_size = block_size;
+		while (new_size < used) {
+			new_size <<= 1;
+		}
+		Memory::free_static(block);
+		block = (uint8_t *)Memory::alloc_static(new_size);
+		block_size = block ? new_size : 0;
+	}
+
+	block_used = 0;
+}
+
+uint64_t FrameArena::get_capacity() {
+
+	return block_size;
+}
+
+uint64_t FrameArena::get_peak_usage() {
+
+	return peak_usage;
+}
+
+void FrameArena::setup() {
+
+	ERR_FAIL_COND(block);
+
+	block = (uint8_t *)Memory::alloc_static(DEFAULT_BLOCK_SIZE);
+	ERR_FAIL_COND(!block);
+	block_size = DEFAULT_BLOCK_SIZE;
+	block_used = 0;
+	arena_thread = true;
+}
+
+void FrameArena::cleanup() {
+
+	if (!block) {
+		return;
+	}
+
+	// Anything still using arena memory at this point would be a bug, so the
+	// blocks can be released outright.
+	block_used = 0;
+	while (overflow) {
+		OverflowBlock *next = overflow->next;
+		Memory::free_static(overflow);
+		overflow = next;
+	}
+	overflow_used = 0;
+
+	Memory::free_static(block);
+	block = NULL;
+	block_size = 0;
+	arena_thread = false;
+}
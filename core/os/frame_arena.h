@@ -0,0 +1,78 @@
+/*************************************************************************/
+/*  frame_arena.h                                                        */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2019 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2019 Godot Engine contributors (cf. AUTHORS.md)    */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#ifndef FRAME_ARENA_H
+#define FRAME_ARENA_H
+
+#include "core/typedefs.h"
+
+#include <stddef.h>
+
+/**
+	Scratch memory for temporaries that do not outlive the current frame.
+
+	Allocations on the main thread are bumped from a single block that is
+	rewound when Main::iteration() finishes, so they cost no heap traffic and
+	free() is a no-op. Requests that do not fit spill into overflow blocks,
+	and the main block is grown at the next reset to hold them. On any other
+	thread the arena falls back to Memory::alloc_static(), so code using it
+	does not need to know where it runs.
+
+	FrameArena has the same static alloc()/free() interface as
+	DefaultAllocator and can be passed as the allocator of List, Map and Set:
+
+		List<Node *, FrameArena> pending;
+*/
+
+class FrameArena {
+public:
+	enum {
+		ALIGNMENT = 16,
+		DEFAULT_BLOCK_SIZE = 64 * 1024,
+	};
+
+	static void *alloc(size_t p_bytes);
+	static void free(void *p_ptr);
+
+	static bool owns(const void *p_ptr);
+	static bool is_available();
+
+	// Rewinds the arena. Only valid once every allocation made since the
+	// previous reset is dead, which Main::iteration() guarantees.
+	static void reset();
+
+	static uint64_t get_capacity();
+	static uint64_t get_peak_usage();
+
+	static void setup();
+	static void cleanup();
+};
+
+#endif // FRAME_ARENA_H
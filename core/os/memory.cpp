@@ -32,6 +32,7 @@
 
 #include "core/error_macros.h"
 #include "core/os/copymem.h"
+#include "core/os/small_object_allocator.h"
 #include "core/safe_refcount.h"
 
 #include <stdio.h>
@@ -67,12 +68,215 @@ void operator delete(void *p_mem, void *p_pointer, size_t check, const char *p_d
 }
 #endif
 
+/* Raw allocation, small blocks go to the size-class allocator */
+
+static _FORCE_INLINE_ void *_raw_alloc(size_t p_bytes) {
+
+#ifndef NO_SMALL_OBJECT_ALLOCATOR
+	if (p_bytes <= SmallObjectAllocator::MAX_SIZE) {
+		void *mem = SmallObjectAllocator::alloc(p_bytes);
+		if (likely(mem)) {
+			return mem;
+		}
+	}
+#endif
+	return malloc(p_bytes);
+}
+
+static _FORCE_INLINE_ void _raw_free(void *p_mem) {
+
+#ifndef NO_SMALL_OBJECT_ALLOCATOR
+	if (SmallObjectAllocator::owns(p_mem)) {
+		SmallObjectAllocator::free(p_mem);
+		return;
+	}
+#endif
+	free(p_mem);
+}
+
+static void *_raw_realloc(void *p_mem, size_t p_bytes) {
+
+#ifndef NO_SMALL_OBJECT_ALLOCATOR
+	if (SmallObjectAllocator::owns(p_mem)) {
+
+		size_t block_size = SmallObjectAllocator::get_block_size(p_mem);
+		if (p_bytes == 0) {
+			SmallObjectAllocator::free(p_mem);
+			return NULL;
+		}
+		if (p_bytes <= block_size) {
+			return p_mem;
+		}
+
+		void *mem = _raw_alloc(p_bytes);
+		if (!mem) {
+			return NULL;
+		}
+		copymem(mem, p_mem, block_size);
+		SmallObjectAllocator::free(p_mem);
+		return mem;
+	}
+#endif
+	return realloc(p_mem, p_bytes);
+}
+
+/* Usage statistics */
+
 #ifdef DEBUG_ENABLED
-uint64_t Memory::mem_usage = 0;
-uint64_t Memory::max_usage = 0;
+
+// Usage is accumulated per thread and only summed when queried, so tracking an
+// allocation costs a thread-local add instead of contended atomics. As a
+// consequence the peak usage is sampled on each query rather than exact.
+
+struct ThreadMemoryStats {
+	int64_t usage[MEMORY_TAG_MAX];
+	int64_t count[MEMORY_TAG_MAX];
+	ThreadMemoryStats *next;
+	ThreadMemoryStats *prev;
+};
+
+static volatile uint32_t stats_lock = 0;
+static ThreadMemoryStats *stats_list = NULL;
+static int64_t retired_usage[MEMORY_TAG_MAX];
+static int64_t retired_count[MEMORY_TAG_MAX];
+
+static _FORCE_INLINE_ void _stats_lock() {
+
+	while (stats_lock || !atomic_compare_exchange(&stats_lock, (uint32_t)0, (uint32_t)1)) {
+	}
+}
+
+static _FORCE_INLINE_ void _stats_unlock() {
+
+	atomic_compare_exchange(&stats_lock, (uint32_t)1, (uint32_t)0);
+}
+
+static void _register_stats(ThreadMemoryStats *p_stats) {
+
+	_stats_lock();
+	p_stats->prev = NULL;
+	p_stats->next = stats_list;
+	if (stats_list) {
+		stats_list->prev = p_stats;
+	}
+	stats_list = p_stats;
+	_stats_unlock();
+}
+
+#ifdef NO_THREADS
+
+static ThreadMemoryStats thread_stats;
+static bool thread_stats_registered = false;
+static uint8_t thread_tag = MEMORY_TAG_DEFAULT;
+
+static _FORCE_INLINE_ ThreadMemoryStats *_get_thread_stats() {
+
+	if (unlikely(!thread_stats_registered)) {
+		_register_stats(&thread_stats);
+		thread_stats_registered = true;
+	}
+	return &thread_stats;
+}
+
+#else
+
+enum {
+	STATS_UNUSED,
+	STATS_ACTIVE,
+	STATS_RELEASED
+};
+
+static thread_local ThreadMemoryStats thread_stats;
+static thread_local uint8_t thread_stats_state = STATS_UNUSED;
+static thread_local uint8_t thread_tag = MEMORY_TAG_DEFAULT;
+
+struct ThreadMemoryStatsGuard {
+
+	~ThreadMemoryStatsGuard() {
+
+		_stats_lock();
+		for (int i = 0; i < MEMORY_TAG_MAX; i++) {
+			retired_usage[i] += thread_stats.usage[i];
+			retired_count[i] += thread_stats.count[i];
+		}
+		if (thread_stats.prev) {
+			thread_stats.prev->next = thread_stats.next;
+		} else {
+			stats_list = thread_stats.next;
+		}
+		if (thread_stats.next) {
+			thread_stats.next->prev = thread_stats.prev;
+		}
+		thread_stats_state = STATS_RELEASED;
+		_stats_unlock();
+	}
+};
+
+static ThreadMemoryStats *_activate_thread_stats() {
+
+	if (thread_stats_state == STATS_RELEASED) {
+		return NULL;
+	}
+
+	static thread_local ThreadMemoryStatsGuard guard;
+	_register_stats(&thread_stats);
+	thread_stats_state = STATS_ACTIVE;
+	return &thread_stats;
+}
+
+static _FORCE_INLINE_ ThreadMemoryStats *_get_thread_stats() {
+
+	if (likely(thread_stats_state == STATS_ACTIVE)) {
+		return &thread_stats;
+	}
+	return _activate_thread_stats();
+}
+
 #endif
 
-uint64_t Memory::alloc_count = 0;
+static _FORCE_INLINE_ void _track_usage(uint64_t p_tag, int64_t p_delta, int64_t p_count) {
+
+	ThreadMemoryStats *stats = _get_thread_stats();
+	if (likely(stats)) {
+		stats->usage[p_tag] += p_delta;
+		stats->count[p_tag] += p_count;
+	} else {
+		_stats_lock();
+		retired_usage[p_tag] += p_delta;
+		retired_count[p_tag] += p_count;
+		_stats_unlock();
+	}
+}
+
+// Sums bytes, or live allocations when p_count is set, for one tag or all
+// of them if p_tag is negative.
+static int64_t _sum_usage(int p_tag, bool p_count = false) {
+
+	int64_t total = 0;
+
+	_stats_lock();
+	for (int i = 0; i < MEMORY_TAG_MAX; i++) {
+		if (p_tag >= 0 && p_tag != i) {
+			continue;
+		}
+		total += p_count ? retired_count[i] : retired_usage[i];
+		for (ThreadMemoryStats *E = stats_list; E; E = E->next) {
+			total += p_count ? E->count[i] : E->usage[i];
+		}
+	}
+	_stats_unlock();
+
+	return total > 0 ? total : 0;
+}
+
+uint64_t Memory::max_usage = 0;
+
+// The second word of the pad header belongs to CowData (refcount and size), so
+// the tag is kept in the top byte of the size word.
+#define PAD_TAG_SHIFT 56
+#define PAD_SIZE_MASK ((uint64_t(1) << PAD_TAG_SHIFT) - 1)
+
+#endif
 
 void *Memory::alloc_static(size_t p_bytes, bool p_pad_align) {
 
@@ -82,12 +286,10 @@ void *Memory::alloc_static(size_t p_bytes, bool p_pad_align) {
 	bool prepad = p_pad_align;
 #endif
 
-	void *mem = malloc(p_bytes + (prepad ? PAD_ALIGN : 0));
+	void *mem = _raw_alloc(p_bytes + (prepad ? PAD_ALIGN : 0));
 
 	ERR_FAIL_COND_V(!mem, NULL);
 
-	atomic_increment(&alloc_count);
-
 	if (prepad) {
 		uint64_t *s = (uint64_t *)mem;
 		*s = p_bytes;
@@ -95,8 +297,8 @@ void *Memory::alloc_static(size_t p_bytes, bool p_pad_align) {
 		uint8_t *s8 = (uint8_t *)mem;
 
 #ifdef DEBUG_ENABLED
-		atomic_add(&mem_usage, p_bytes);
-		atomic_exchange_if_greater(&max_usage, mem_usage);
+		*s |= (uint64_t)thread_tag << PAD_TAG_SHIFT;
+		_track_usage(thread_tag, p_bytes, 1);
 #endif
 		return s8 + PAD_ALIGN;
 	} else {
@@ -121,34 +323,32 @@ void *Memory::realloc_static(void *p_memory, size_t p_bytes, bool p_pad_align) {
 	if (prepad) {
 		mem -= PAD_ALIGN;
 		uint64_t *s = (uint64_t *)mem;
+		uint64_t header = p_bytes;
 
 #ifdef DEBUG_ENABLED
-		if (p_bytes > *s) {
-			atomic_add(&mem_usage, p_bytes - *s);
-			atomic_exchange_if_greater(&max_usage, mem_usage);
-		} else {
-			atomic_sub(&mem_usage, *s - p_bytes);
-		}
+		uint64_t tag = *s >> PAD_TAG_SHIFT;
+		_track_usage(tag, (int64_t)p_bytes - (int64_t)(*s & PAD_SIZE_MASK), p_bytes == 0 ? -1 : 0);
+		header |= tag << PAD_TAG_SHIFT;
 #endif
 
 		if (p_bytes == 0) {
-			free(mem);
+			_raw_free(mem);
 			return NULL;
 		} else {
-			*s = p_bytes;
+			*s = header;
 
-			mem = (uint8_t *)realloc(mem, p_bytes + PAD_ALIGN);
+			mem = (uint8_t *)_raw_realloc(mem, p_bytes + PAD_ALIGN);
 			ERR_FAIL_COND_V(!mem, NULL);
 
 			s = (uint64_t *)mem;
 
-			*s = p_bytes;
+			*s = header;
 
 			return mem + PAD_ALIGN;
 		}
 	} else {
 
-		mem = (uint8_t *)realloc(mem, p_bytes);
+		mem = (uint8_t *)_raw_realloc(mem, p_bytes);
 
 		ERR_FAIL_COND_V(mem == NULL && p_bytes > 0, NULL);
 
@@ -168,20 +368,18 @@ void Memory::free_static(void *p_ptr, bool p_pad_align) {
 	bool prepad = p_pad_align;
 #endif
 
-	atomic_decrement(&alloc_count);
-
 	if (prepad) {
 		mem -= PAD_ALIGN;
 
 #ifdef DEBUG_ENABLED
 		uint64_t *s = (uint64_t *)mem;
-		atomic_sub(&mem_usage, *s);
+		_track_usage(*s >> PAD_TAG_SHIFT, -(int64_t)(*s & PAD_SIZE_MASK), -1);
 #endif
 
-		free(mem);
+		_raw_free(mem);
 	} else {
 
-		free(mem);
+		_raw_free(mem);
 	}
 }
 
@@ -192,7 +390,11 @@ uint64_t Memory::get_mem_available() {
 
 uint64_t Memory::get_mem_usage() {
 #ifdef DEBUG_ENABLED
-	return mem_usage;
+	uint64_t usage = _sum_usage(-1);
+	if (usage > max_usage) {
+		max_usage = usage;
+	}
+	return usage;
 #else
 	return 0;
 #endif
@@ -200,12 +402,65 @@ uint64_t Memory::get_mem_usage() {
 
 uint64_t Memory::get_mem_max_usage() {
 #ifdef DEBUG_ENABLED
+	get_mem_usage();
 	return max_usage;
 #else
 	return 0;
 #endif
 }
 
+MemoryTag Memory::set_thread_tag(MemoryTag p_tag) {
+#ifdef DEBUG_ENABLED
+	MemoryTag previous = (MemoryTag)thread_tag;
+	thread_tag = p_tag;
+	return previous;
+#else
+	return MEMORY_TAG_DEFAULT;
+#endif
+}
+
+uint64_t Memory::get_tag_usage(MemoryTag p_tag) {
+#ifdef DEBUG_ENABLED
+	ERR_FAIL_INDEX_V(p_tag, MEMORY_TAG_MAX, 0);
+	return _sum_usage(p_tag);
+#else
+	return 0;
+#endif
+}
+
+uint64_t Memory::get_tag_allocation_count(MemoryTag p_tag) {
+#ifdef DEBUG_ENABLED
+	ERR_FAIL_INDEX_V(p_tag, MEMORY_TAG_MAX, 0);
+	return _sum_usage(p_tag, true);
+#else
+	return 0;
+#endif
+}
+
+const char *Memory::get_tag_name(MemoryTag p_tag) {
+
+	static const char *names[MEMORY_TAG_MAX] = {
+		"default",
+		"resources",
+		"scene",
+		"physics",
+		"rendering",
+		"audio",
+		"script",
+	};
+
+	ERR_FAIL_INDEX_V(p_tag, MEMORY_TAG_MAX, "");
+	return names[p_tag];
+}
+
+uint64_t Memory::get_small_object_memory() {
+#ifndef NO_SMALL_OBJECT_ALLOCATOR
+	return SmallObjectAllocator::get_reserved_memory();
+#else
+	return 0;
+#endif
+}
+
 _GlobalNil::_GlobalNil() {
 
 	color = 1;
@@ -43,16 +43,26 @@
 #define PAD_ALIGN 16 //must always be greater than this at much
 #endif
 
+// Subsystems whose static memory usage is reported separately. The tag is
+// per thread and set with MemoryTagScope; usage is only tracked in debug builds.
+enum MemoryTag {
+	MEMORY_TAG_DEFAULT,
+	MEMORY_TAG_RESOURCES,
+	MEMORY_TAG_SCENE,
+	MEMORY_TAG_PHYSICS,
+	MEMORY_TAG_RENDERING,
+	MEMORY_TAG_AUDIO,
+	MEMORY_TAG_SCRIPT,
+	MEMORY_TAG_MAX
+};
+
 class Memory {
 
 	Memory();
 #ifdef DEBUG_ENABLED
-	static uint64_t mem_usage;
 	static uint64_t max_usage;
 #endif
 
-	static uint64_t alloc_count;
-
 public:
 	static void *alloc_static(size_t p_bytes, bool p_pad_align = false);
 	static void *realloc_static(void *p_memory, size_t p_bytes, bool p_pad_align = false);
@@ -61,6 +71,21 @@ public:
 	static uint64_t get_mem_available();
 	static uint64_t get_mem_usage();
 	static uint64_t get_mem_max_usage();
+
+	static MemoryTag set_thread_tag(MemoryTag p_tag);
+	static uint64_t get_tag_usage(MemoryTag p_tag);
+	static uint64_t get_tag_allocation_count(MemoryTag p_tag);
+	static const char *get_tag_name(MemoryTag p_tag);
+	static uint64_t get_small_object_memory();
+};
+
+class MemoryTagScope {
+
+	MemoryTag previous;
+
+public:
+	_FORCE_INLINE_ MemoryTagScope(MemoryTag p_tag) { previous = Memory::set_thread_tag(p_tag); }
+	_FORCE_INLINE_ ~MemoryTagScope() { Memory::set_thread_tag(previous); }
 };
 
 class DefaultAllocator {
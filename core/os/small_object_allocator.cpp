@@ -0,0 +1,378 @@
+/*************************************************************************/
+/*  small_object_allocator.cpp                                           */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2019 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2019 Godot Engine contributors (cf. AUTHORS.md)    */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#include "small_object_allocator.h"
+
+#include "core/safe_refcount.h"
+
+#include <stdint.h>
+#include <stdlib.h>
+
+// The page map has one bit per chunk-sized page of address space. Two levels
+// cover a 48-bit address space; arenas placed above it are simply not used.
+#define PAGE_MAP_LEAF_BITS 18
+#define PAGE_MAP_TOP_BITS 14
+#define PAGE_MAP_LEAF_MASK ((1 << PAGE_MAP_LEAF_BITS) - 1)
+
+// Blocks move between a thread cache and the shared pool in batches.
+#define BATCH_SIZE 32
+#define MAX_CACHED_BLOCKS (BATCH_SIZE * 2)
+
+struct ChunkHeader {
+	uint32_t size_class;
+	uint32_t block_size;
+};
+
+struct FreeBlock {
+	FreeBlock *next;
+};
+
+struct ClassPool {
+	volatile uint32_t lock;
+	FreeBlock *free_list;
+	uint8_t *carve_pos;
+	uint8_t *carve_end;
+};
+
+struct ThreadCache {
+	FreeBlock *bins[SmallObjectAllocator::CLASS_COUNT];
+	uint32_t counts[SmallObjectAllocator::CLASS_COUNT];
+};
+
+static ClassPool class_pools[SmallObjectAllocator::CLASS_COUNT];
+
+static volatile uint32_t arena_lock = 0;
+static uint8_t *arena_pos = NULL;
+static uint8_t *arena_end = NULL;
+static bool arena_failed = false;
+static uint64_t reserved_memory = 0;
+
+static uint32_t *volatile page_map[1 << PAGE_MAP_TOP_BITS];
+
+static _FORCE_INLINE_ void _spin_lock(volatile uint32_t *p_lock) {
+
+	while (*p_lock || !atomic_compare_exchange(p_lock, (uint32_t)0, (uint32_t)1)) {
+	}
+}
+
+static _FORCE_INLINE_ void _spin_unlock(volatile uint32_t *p_lock) {
+
+	atomic_compare_exchange(p_lock, (uint32_t)1, (uint32_t)0);
+}
+
+/* Thread cache */
+
+#ifdef NO_THREADS
+
+static ThreadCache thread_cache;
+
+static _FORCE_INLINE_ ThreadCache *_get_thread_cache() {
+
+	return &thread_cache;
+}
+
+#else
+
+enum {
+	CACHE_UNUSED,
+	CACHE_ACTIVE,
+	CACHE_RELEASED
+};
+
+// Both are trivially destructible, so they stay usable while other
+// thread_local destructors run after the cache has been released.
+static thread_local ThreadCache thread_cache;
+static thread_local uint8_t thread_cache_state = CACHE_UNUSED;
+
+struct ThreadCacheGuard {
+
+	~ThreadCacheGuard() {
+
+		SmallObjectAllocator::flush_thread_cache();
+		thread_cache_state = CACHE_RELEASED;
+	}
+};
+
+static ThreadCache *_activate_thread_cache() {
+
+	if (thread_cache_state == CACHE_RELEASED) {
+		// The thread is exiting, blocks go straight to the shared pools.
+		return NULL;
+	}
+
+	static thread_local ThreadCacheGuard guard;
+	thread_cache_state = CACHE_ACTIVE;
+	return &thread_cache;
+}
+
+static _FORCE_INLINE_ ThreadCache *_get_thread_cache() {
+
+	if (likely(thread_cache_state == CACHE_ACTIVE)) {
+		return &thread_cache;
+	}
+	return _activate_thread_cache();
+}
+
+#endif
+
+/* Chunks */
+
+static _FORCE_INLINE_ ChunkHeader *_get_chunk(const void *p_ptr) {
+
+	return (ChunkHeader *)((uintptr_t)p_ptr & ~(uintptr_t)(SmallObjectAllocator::CHUNK_SIZE - 1));
+}
+
+static bool _page_map_add(const uint8_t *p_chunk) {
+
+	uintptr_t key = (uintptr_t)p_chunk >> SmallObjectAllocator::CHUNK_BITS;
+	uintptr_t top = key >> PAGE_MAP_LEAF_BITS;
+	if (top >= (1 << PAGE_MAP_TOP_BITS)) {
+		return false;
+	}
+
+	uint32_t *leaf = page_map[top];
+	if (!leaf) {
+		leaf = (uint32_t *)calloc(1 << (PAGE_MAP_LEAF_BITS - 5), sizeof(uint32_t));
+		if (!leaf) {
+			return false;
+		}
+		page_map[top] = leaf;
+	}
+
+	uint32_t bit = key & PAGE_MAP_LEAF_MASK;
+	leaf[bit >> 5] |= 1u << (bit & 31);
+	return true;
+}
+
+static uint8_t *_new_chunk() {
+
+	_spin_lock(&arena_lock);
+
+	if (arena_pos == arena_end && !arena_failed) {
+
+		const size_t arena_size = (size_t)SmallObjectAllocator::ARENA_CHUNKS * SmallObjectAllocator::CHUNK_SIZE;
+		uint8_t *raw = (uint8_t *)malloc(arena_size + SmallObjectAllocator::CHUNK_SIZE);
+
+		if (raw) {
+			uint8_t *aligned = (uint8_t *)_get_chunk(raw + SmallObjectAllocator::CHUNK_SIZE - 1);
+			int usable = 0;
+			while (usable < SmallObjectAllocator::ARENA_CHUNKS && _page_map_add(aligned + usable * SmallObjectAllocator::CHUNK_SIZE)) {
+				usable++;
+			}
+
+			if (usable) {
+				arena_pos = aligned;
+				arena_end = aligned + usable * SmallObjectAllocator::CHUNK_SIZE;
+				reserved_memory += arena_size + SmallObjectAllocator::CHUNK_SIZE;
+			} else {
+				::free(raw);
+				arena_failed = true;
+			}
+		} else {
+			arena_failed = true;
+		}
+	}
+
+	uint8_t *chunk = NULL;
+	if (arena_pos != arena_end) {
+		chunk = arena_pos;
+		arena_pos += SmallObjectAllocator::CHUNK_SIZE;
+	}
+
+	_spin_unlock(&arena_lock);
+	return chunk;
+}
+
+// Must be called with the pool lock held.
+static FreeBlock *_pool_take(ClassPool &p_pool, uint32_t p_class) {
+
+	FreeBlock *block = p_pool.free_list;
+	if (block) {
+		p_pool.free_list = block->next;
+		return block;
+	}
+
+	const uint32_t block_size = (p_class + 1) * SmallObjectAllocator::GRANULARITY;
+
+	if (p_pool.carve_pos + block_size > p_pool.carve_end) {
+		uint8_t *chunk = _new_chunk();
+		if (!chunk) {
+			return NULL;
+		}
+
+		ChunkHeader *header = (ChunkHeader *)chunk;
+		header->size_class = p_class;
+		header->block_size = block_size;
+
+		// The header takes exactly one granule, keeping blocks 16-byte aligned.
+		p_pool.carve_pos = chunk + SmallObjectAllocator::GRANULARITY;
+		p_pool.carve_end = chunk + SmallObjectAllocator::CHUNK_SIZE;
+	}
+
+	block = (FreeBlock *)p_pool.carve_pos;
+	p_pool.carve_pos += block_size;
+	return block;
+}
+
+static void _pool_put(ClassPool &p_pool, FreeBlock *p_first, FreeBlock *p_last) {
+
+	_spin_lock(&p_pool.lock);
+	p_last->next = p_pool.free_list;
+	p_pool.free_list = p_first;
+	_spin_unlock(&p_pool.lock);
+}
+
+static void _refill(ThreadCache *p_cache, uint32_t p_class) {
+
+	ClassPool &pool = class_pools[p_class];
+
+	_spin_lock(&pool.lock);
+	for (int i = 0; i < BATCH_SIZE; i++) {
+		FreeBlock *block = _pool_take(pool, p_class);
+		if (!block) {
+			break;
+		}
+		block->next = p_cache->bins[p_class];
+		p_cache->bins[p_class] = block;
+		p_cache->counts[p_class]++;
+	}
+	_spin_unlock(&pool.lock);
+}
+
+static void _release(ThreadCache *p_cache, uint32_t p_class, uint32_t p_count) {
+
+	FreeBlock *first = p_cache->bins[p_class];
+	if (!first || !p_count) {
+		return;
+	}
+
+	FreeBlock *last = first;
+	uint32_t count = 1;
+	while (count < p_count && last->next) {
+		last = last->next;
+		count++;
+	}
+
+	p_cache->bins[p_class] = last->next;
+	p_cache->counts[p_class] -= count;
+	_pool_put(class_pools[p_class], first, last);
+}
+
+/* Public API */
+
+void *SmallObjectAllocator::alloc(size_t p_bytes) {
+
+	if (p_bytes > MAX_SIZE) {
+		return NULL;
+	}
+
+	uint32_t size_class = p_bytes ? (p_bytes - 1) / GRANULARITY : 0;
+	ThreadCache *cache = _get_thread_cache();
+
+	if (unlikely(!cache)) {
+		ClassPool &pool = class_pools[size_class];
+		_spin_lock(&pool.lock);
+		FreeBlock *block = _pool_take(pool, size_class);
+		_spin_unlock(&pool.lock);
+		return block;
+	}
+
+	FreeBlock *block = cache->bins[size_class];
+	if (unlikely(!block)) {
+		_refill(cache, size_class);
+		block = cache->bins[size_class];
+		if (!block) {
+			return NULL;
+		}
+	}
+
+	cache->bins[size_class] = block->next;
+	cache->counts[size_class]--;
+	return block;
+}
+
+void SmallObjectAllocator::free(void *p_ptr) {
+
+	uint32_t size_class = _get_chunk(p_ptr)->size_class;
+	FreeBlock *block = (FreeBlock *)p_ptr;
+	ThreadCache *cache = _get_thread_cache();
+
+	if (unlikely(!cache)) {
+		_pool_put(class_pools[size_class], block, block);
+		return;
+	}
+
+	// Blocks freed on another thread than the one that allocated them simply
+	// migrate to this thread's cache.
+	block->next = cache->bins[size_class];
+	cache->bins[size_class] = block;
+	if (unlikely(++cache->counts[size_class] > MAX_CACHED_BLOCKS)) {
+		_release(cache, size_class, BATCH_SIZE);
+	}
+}
+
+bool SmallObjectAllocator::owns(const void *p_ptr) {
+
+	uintptr_t key = (uintptr_t)p_ptr >> CHUNK_BITS;
+	uintptr_t top = key >> PAGE_MAP_LEAF_BITS;
+	if (top >= (1 << PAGE_MAP_TOP_BITS)) {
+		return false;
+	}
+
+	const uint32_t *leaf = page_map[top];
+	if (!leaf) {
+		return false;
+	}
+
+	uint32_t bit = key & PAGE_MAP_LEAF_MASK;
+	return leaf[bit >> 5] & (1u << (bit & 31));
+}
+
+size_t SmallObjectAllocator::get_block_size(const void *p_ptr) {
+
+	return _get_chunk(p_ptr)->block_size;
+}
+
+void SmallObjectAllocator::flush_thread_cache() {
+
+	ThreadCache *cache = _get_thread_cache();
+	if (!cache) {
+		return;
+	}
+
+	for (uint32_t i = 0; i < CLASS_COUNT; i++) {
+		_release(cache, i, cache->counts[i]);
+	}
+}
+
+uint64_t SmallObjectAllocator::get_reserved_memory() {
+
+	return reserved_memory;
+}
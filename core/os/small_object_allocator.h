@@ -0,0 +1,78 @@
+/*************************************************************************/
+/*  small_object_allocator.h                                             */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2019 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2019 Godot Engine contributors (cf. AUTHORS.md)    */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#ifndef SMALL_OBJECT_ALLOCATOR_H
+#define SMALL_OBJECT_ALLOCATOR_H
+
+#include "core/typedefs.h"
+
+#include <stddef.h>
+
+/**
+	Size-class allocator used by Memory for small blocks (Variant internals,
+	List/Map elements, StringName data and the like).
+
+	Blocks are carved from 64 KiB chunks, each chunk serving a single size
+	class. Every thread keeps a cache of free blocks per size class, so the
+	common alloc/free path takes no lock and does no atomic operation; the
+	shared per-class pools are only touched to move whole batches in and out
+	of a thread cache. Chunk memory is kept for reuse and never given back to
+	the system.
+
+	Chunk membership is tracked in a page map, so free() can tell blocks of
+	this allocator apart from plain malloc() memory without a header.
+*/
+
+class SmallObjectAllocator {
+public:
+	enum {
+		GRANULARITY = 16,
+		MAX_SIZE = 256,
+		CLASS_COUNT = MAX_SIZE / GRANULARITY,
+		CHUNK_BITS = 16,
+		CHUNK_SIZE = 1 << CHUNK_BITS,
+		ARENA_CHUNKS = 16,
+	};
+
+	// Returns NULL when the request is too big or no chunk could be obtained,
+	// in which case the caller is expected to fall back to malloc().
+	static void *alloc(size_t p_bytes);
+	static void free(void *p_ptr);
+
+	static bool owns(const void *p_ptr);
+	static size_t get_block_size(const void *p_ptr);
+
+	// Gives the calling thread's cached blocks back to the shared pools.
+	static void flush_thread_cache();
+
+	static uint64_t get_reserved_memory();
+};
+
+#endif // SMALL_OBJECT_ALLOCATOR_H
@@ -0,0 +1,232 @@
+/*************************************************************************/
+/*  thread_work_pool.cpp                                                 */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2019 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2019 Godot Engine contributors (cf. AUTHORS.md)    */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#include "thread_work_pool.h"
+
+#include "core/os/memory.h"
+#include "core/os/os.h"
+
+Mutex *ThreadWorkPool::mutex = NULL;
+Semaphore *ThreadWorkPool::work_posted = NULL;
+Thread **ThreadWorkPool::threads = NULL;
+uint32_t ThreadWorkPool::shared_thread_count = 0;
+bool ThreadWorkPool::exit_threads = false;
+ThreadWorkPool::BaseWork *ThreadWorkPool::queue = NULL;
+Semaphore *ThreadWorkPool::semaphore_pool[MAX_POOLED_SEMAPHORES];
+int ThreadWorkPool::semaphore_pool_size = 0;
+ThreadWorkPool *ThreadWorkPool::singleton = NULL;
+
+void ThreadWorkPool::_thread_function(void *p_user) {
+
+	while (true) {
+		work_posted->wait();
+
+		mutex->lock();
+		if (exit_threads) {
+			mutex->unlock();
+			break;
+		}
+
+		// Newest jobs are first, so nested do_work() calls get help before
+		// the jobs waiting on them.
+		BaseWork *work = queue;
+		while (work && (work->helpers >= work->max_helpers || work->index >= work->max_elements)) {
+			work = work->next;
+		}
+		if (work) {
+			work->helpers++;
+			work->active++;
+		}
+		mutex->unlock();
+
+		if (!work) {
+			continue; // Someone else took it.
+		}
+
+		work->work();
+
+		mutex->lock();
+		work->active--;
+		if (work->active == 0 && work->completed) {
+			work->completed->post();
+		}
+		mutex->unlock();
+	}
+}
+
+void ThreadWorkPool::_run(BaseWork *p_work) {
+
+	p_work->helpers = 0;
+	p_work->active = 0;
+	p_work->completed = NULL;
+
+	mutex->lock();
+	p_work->next = queue;
+	queue = p_work;
+	mutex->unlock();
+
+	for (uint32_t i = 0; i < p_work->max_helpers; i++) {
+		work_posted->post();
+	}
+
+	p_work->work();
+
+	// Take the job out of the queue so no more workers join, then wait for
+	// the ones that are still on their last element.
+	mutex->lock();
+	BaseWork **prev = &queue;
+	while (*prev != p_work) {
+		prev = &(*prev)->next;
+	}
+	*prev = p_work->next;
+
+	bool wait = p_work->active > 0;
+	if (wait) {
+		p_work->completed = semaphore_pool_size ? semaphore_pool[--semaphore_pool_size] : Semaphore::create();
+	}
+	mutex->unlock();
+
+	if (wait) {
+		p_work->completed->wait();
+
+		mutex->lock();
+		if (semaphore_pool_size < MAX_POOLED_SEMAPHORES) {
+			semaphore_pool[semaphore_pool_size++] = p_work->completed;
+		} else {
+			memdelete(p_work->completed);
+		}
+		mutex->unlock();
+	}
+}
+
+void ThreadWorkPool::init(int p_thread_count) {
+
+	ERR_FAIL_COND(initialized);
+
+	initialized = true;
+	thread_count = 0;
+
+#ifndef NO_THREADS
+	if (!mutex) {
+		return; // setup() not called, everything runs on the calling thread
+	}
+
+	if (p_thread_count < 0) {
+		p_thread_count = OS::get_singleton()->get_processor_count() - 1;
+	}
+
+	if (p_thread_count <= 0) {
+		return;
+	}
+
+	mutex->lock();
+	if (!threads) {
+		shared_thread_count = MAX(OS::get_singleton()->get_processor_count() - 1, 0);
+		if (shared_thread_count) {
+			threads = memnew_arr(Thread *, shared_thread_count);
+			for (uint32_t i = 0; i < shared_thread_count; i++) {
+				threads[i] = Thread::create(&ThreadWorkPool::_thread_function, NULL);
+			}
+		}
+	}
+	thread_count = MIN(uint32_t(p_thread_count), shared_thread_count);
+	mutex->unlock();
+#endif
+}
+
+void ThreadWorkPool::finish() {
+
+	initialized = false;
+	thread_count = 0;
+}
+
+void ThreadWorkPool::setup() {
+
+#ifndef NO_THREADS
+	mutex = Mutex::create();
+	work_posted = Semaphore::create();
+#endif
+
+	singleton = memnew(ThreadWorkPool);
+	singleton->init();
+}
+
+void ThreadWorkPool::cleanup() {
+
+	if (singleton) {
+		memdelete(singleton);
+		singleton = NULL;
+	}
+
+	if (!mutex) {
+		return;
+	}
+
+	if (threads) {
+		mutex->lock();
+		exit_threads = true;
+		mutex->unlock();
+
+		for (uint32_t i = 0; i < shared_thread_count; i++) {
+			work_posted->post();
+		}
+
+		for (uint32_t i = 0; i < shared_thread_count; i++) {
+			Thread::wait_to_finish(threads[i]);
+			memdelete(threads[i]);
+		}
+
+		memdelete_arr(threads);
+		threads = NULL;
+		shared_thread_count = 0;
+		exit_threads = false;
+	}
+
+	for (int i = 0; i < semaphore_pool_size; i++) {
+		memdelete(semaphore_pool[i]);
+	}
+	semaphore_pool_size = 0;
+
+	memdelete(work_posted);
+	work_posted = NULL;
+	memdelete(mutex);
+	mutex = NULL;
+}
+
+ThreadWorkPool::ThreadWorkPool() {
+
+	thread_count = 0;
+	initialized = false;
+}
+
+ThreadWorkPool::~ThreadWorkPool() {
+
+	finish();
+}
@@ -0,0 +1,143 @@
+/*************************************************************************/
+/*  thread_work_pool.h                                                   */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2019 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2019 Godot Engine contributors (cf. AUTHORS.md)    */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#ifndef THREAD_WORK_POOL_H
+#define THREAD_WORK_POOL_H
+
+#include "core/os/mutex.h"
+#include "core/os/semaphore.h"
+#include "core/os/thread.h"
+#include "core/safe_refcount.h"
+
+/**
+	Persistent version of thread_process_array (see threaded_array_processor.h).
+	The worker threads are shared by every pool in the engine: they are
+	created with the first init() and live until cleanup(), so having many
+	pools doesn't oversubscribe the CPU. A pool only records how many of the
+	shared workers its jobs may use.
+	do_work() may be called from several threads at once, and from inside
+	another job. The calling thread takes part in the work, and do_work()
+	returns once every element has been processed.
+*/
+
+class ThreadWorkPool {
+
+	struct BaseWork {
+		volatile uint32_t index;
+		uint32_t max_elements;
+		uint32_t max_helpers; // workers allowed to join, besides the caller
+		uint32_t helpers; // workers that joined
+		uint32_t active; // workers still running work()
+		Semaphore *completed;
+		BaseWork *next;
+		virtual void work() = 0;
+		virtual ~BaseWork() {}
+	};
+
+	template <class C, class M, class U>
+	struct Work : public BaseWork {
+		C *instance;
+		M method;
+		U userdata;
+
+		virtual void work() {
+
+			while (true) {
+				uint32_t work_index = atomic_increment(&this->index) - 1;
+				if (work_index >= this->max_elements)
+					break;
+				(instance->*method)(work_index, userdata);
+			}
+		}
+	};
+
+	enum {
+		MAX_POOLED_SEMAPHORES = 16
+	};
+
+	uint32_t thread_count;
+	bool initialized;
+
+	static Mutex *mutex;
+	static Semaphore *work_posted;
+	static Thread **threads;
+	static uint32_t shared_thread_count;
+	static bool exit_threads;
+	static BaseWork *queue;
+	static Semaphore *semaphore_pool[MAX_POOLED_SEMAPHORES];
+	static int semaphore_pool_size;
+	static ThreadWorkPool *singleton;
+
+	static void _thread_function(void *p_user);
+	static void _run(BaseWork *p_work);
+
+public:
+	// p_max_threads includes the calling thread, -1 uses all of them
+	template <class C, class M, class U>
+	void do_work(uint32_t p_elements, C *p_instance, M p_method, U p_userdata, int p_max_threads = -1) {
+
+		uint32_t workers = (p_max_threads < 0) ? thread_count : MIN(thread_count, uint32_t(MAX(p_max_threads - 1, 0)));
+
+		if (!workers || p_elements < 2 || !threads) {
+			for (uint32_t i = 0; i < p_elements; i++) {
+				(p_instance->*p_method)(i, p_userdata);
+			}
+			return;
+		}
+
+		Work<C, M, U> w;
+		w.index = 0;
+		w.max_elements = p_elements;
+		w.max_helpers = MIN(workers, p_elements - 1);
+		w.instance = p_instance;
+		w.method = p_method;
+		w.userdata = p_userdata;
+
+		_run(&w);
+	}
+
+	bool is_initialized() const { return initialized; }
+	int get_thread_count() const { return thread_count; }
+
+	// -1 uses one thread per processor, besides the calling one
+	void init(int p_thread_count = -1);
+	void finish();
+
+	// A pool using all the workers, for code that has no pool of its own.
+	static ThreadWorkPool *get_singleton() { return singleton; }
+
+	static void setup();
+	static void cleanup();
+
+	ThreadWorkPool();
+	~ThreadWorkPool();
+};
+
+#endif // THREAD_WORK_POOL_H
@@ -35,6 +35,7 @@
 #include "core/os/os.h"
 #include "core/os/thread.h"
 #include "core/os/thread_safe.h"
+#include "core/os/thread_work_pool.h"
 #include "core/safe_refcount.h"
 
 template <class C, class U>
@@ -67,6 +68,13 @@ void process_array_thread(void *ud) {
 template <class C, class M, class U>
 void thread_process_array(uint32_t p_elements, C *p_instance, M p_method, U p_userdata) {
 
+	ThreadWorkPool *pool = ThreadWorkPool::get_singleton();
+	if (pool) {
+		// Reuse the engine's worker threads instead of spawning new ones.
+		pool->do_work(p_elements, p_instance, p_method, p_userdata);
+		return;
+	}
+
 	ThreadArrayProcessData<C, U> data;
 	data.method = p_method;
 	data.instance = p_instance;
@@ -0,0 +1,328 @@
+/*************************************************************************/
+/*  trace.cpp                                                            */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2019 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2019 Godot Engine contributors (cf. AUTHORS.md)    */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#include "trace.h"
+
+#include "core/map.h"
+#include "core/os/file_access.h"
+#include "core/os/memory.h"
+#include "core/os/os.h"
+#include "core/os/thread.h"
+#include "core/safe_refcount.h"
+#include "core/script_language.h"
+#include "core/vector.h"
+
+#include <stdio.h>
+
+struct TraceEvent {
+	const char *name;
+	uint64_t begin;
+	uint64_t end;
+};
+
+// Written by its owning thread only; flush() is the single reader. A buffer
+// is never freed while the engine runs, threads that exit hand it over to
+// the next thread that starts tracing.
+struct TraceBuffer {
+	TraceBuffer *next;
+	uint64_t thread_id;
+	volatile uint32_t write;
+	volatile uint32_t read;
+	volatile uint32_t released;
+	TraceEvent events[Trace::THREAD_BUFFER_SIZE];
+};
+
+struct TraceHistoryEvent {
+	const char *name;
+	uint64_t begin;
+	uint64_t end;
+	uint64_t thread_id;
+};
+
+struct TraceHistoryFrame {
+	Vector<TraceHistoryEvent> events;
+	int count;
+
+	TraceHistoryFrame() { count = 0; }
+};
+
+struct TraceBufferOwner {
+	TraceBuffer *buffer;
+
+	TraceBufferOwner() { buffer = NULL; }
+	~TraceBufferOwner() {
+		if (buffer) {
+			atomic_increment(&buffer->released);
+		}
+	}
+};
+
+bool Trace::enabled = false;
+
+static TraceBuffer *volatile buffers = NULL;
+static volatile uint64_t dropped_events = 0;
+static FileAccess *capture = NULL;
+static bool capture_first_event = true;
+static Vector<TraceHistoryFrame> history;
+static int history_frame = 0;
+
+#ifdef NO_THREADS
+static TraceBufferOwner thread_owner;
+#else
+static thread_local TraceBufferOwner thread_owner;
+#endif
+
+static TraceBuffer *_acquire_buffer() {
+
+	uint64_t thread_id = Thread::get_caller_id();
+
+	for (TraceBuffer *b = buffers; b; b = b->next) {
+		if (b->released && b->read == b->write && atomic_compare_exchange(&b->released, (uint32_t)1, (uint32_t)0)) {
+			b->thread_id = thread_id;
+			return b;
+		}
+	}
+
+	TraceBuffer *b = (TraceBuffer *)Memory::alloc_static(sizeof(TraceBuffer));
+	ERR_FAIL_COND_V(!b, NULL);
+	b->thread_id = thread_id;
+	b->write = 0;
+	b->read = 0;
+	b->released = 0;
+
+	TraceBuffer *head;
+	do {
+		head = buffers;
+		b->next = head;
+	} while (!atomic_compare_exchange(&buffers, head, b));
+
+	return b;
+}
+
+uint64_t Trace::get_ticks() {
+
+	return OS::get_singleton()->get_ticks_usec();
+}
+
+void Trace::record(const char *p_name, uint64_t p_begin, uint64_t p_end) {
+
+	TraceBuffer *b = thread_owner.buffer;
+	if (unlikely(!b)) {
+		b = _acquire_buffer();
+		if (!b) {
+			return;
+		}
+		thread_owner.buffer = b;
+	}
+
+	uint32_t w = b->write;
+	if (w - b->read >= THREAD_BUFFER_SIZE) {
+		atomic_increment(&dropped_events);
+		return;
+	}
+
+	TraceEvent &e = b->events[w % THREAD_BUFFER_SIZE];
+	e.name = p_name;
+	e.begin = p_begin;
+	e.end = p_end;
+
+	// Publishes the event to flush(), the increment is a full barrier.
+	atomic_increment(&b->write);
+}
+
+static void _store_event(FileAccess *p_file, bool p_first, const char *p_name, uint64_t p_begin, uint64_t p_end, uint64_t p_thread_id) {
+
+	char line[512];
+	CharString name = String(p_name).json_escape().utf8();
+	snprintf(line, sizeof(line), "%s{\"name\":\"%s\",\"ph\":\"X\",\"ts\":%llu,\"dur\":%llu,\"pid\":0,\"tid\":%llu}\n", p_first ? "" : ",", name.get_data(), (unsigned long long)p_begin, (unsigned long long)(p_end - p_begin), (unsigned long long)p_thread_id);
+	p_file->store_string(line);
+}
+
+Error Trace::start_capture(const String &p_path) {
+
+	ERR_FAIL_COND_V(capture, ERR_ALREADY_IN_USE);
+
+	Error err;
+	capture = FileAccess::open(p_path, FileAccess::WRITE, &err);
+	ERR_FAIL_COND_V(!capture, err);
+
+	capture->store_string("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+	capture_first_event = true;
+	enabled = true;
+	return OK;
+}
+
+void Trace::stop_capture() {
+
+	if (!capture) {
+		return;
+	}
+
+	flush();
+
+	capture->store_string("]}\n");
+	capture->close();
+	memdelete(capture);
+	capture = NULL;
+
+	// The next flush() turns tracing back on if the profiler still needs it.
+	enabled = false;
+}
+
+bool Trace::is_capturing() {
+
+	return capture != NULL;
+}
+
+void Trace::set_history_frames(int p_frames) {
+
+	ERR_FAIL_COND(p_frames < 0);
+
+	history.clear();
+	history.resize(p_frames);
+	history_frame = 0;
+	enabled = capture || p_frames > 0;
+}
+
+int Trace::get_history_frames() {
+
+	return history.size();
+}
+
+Error Trace::dump_history(const String &p_path) {
+
+	ERR_FAIL_COND_V(history.empty(), ERR_UNCONFIGURED);
+
+	Error err;
+	FileAccess *f = FileAccess::open(p_path, FileAccess::WRITE, &err);
+	ERR_FAIL_COND_V(!f, err);
+
+	f->store_string("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+	bool first = true;
+
+	// Oldest frame first, history_frame is the slot the next flush() fills.
+	for (int i = 0; i < history.size(); i++) {
+		const TraceHistoryFrame &frame = history[(history_frame + i) % history.size()];
+		for (int j = 0; j < frame.count; j++) {
+			const TraceHistoryEvent &e = frame.events[j];
+			_store_event(f, first, e.name, e.begin, e.end, e.thread_id);
+			first = false;
+		}
+	}
+
+	f->store_string("]}\n");
+	f->close();
+	memdelete(f);
+	return OK;
+}
+
+void Trace::flush() {
+
+	bool profiling = ScriptDebugger::get_singleton() && ScriptDebugger::get_singleton()->is_profiling();
+	Map<const char *, uint64_t> totals;
+
+	TraceHistoryFrame *frame = NULL;
+	if (history.size()) {
+		frame = &history.write[history_frame];
+		frame->count = 0;
+		history_frame = (history_frame + 1) % history.size();
+	}
+
+	for (TraceBuffer *b = buffers; b; b = b->next) {
+
+		uint32_t w = atomic_add(&b->write, (uint32_t)0);
+		uint32_t r = b->read;
+		if (r == w) {
+			continue;
+		}
+
+		for (; r != w; r++) {
+			const TraceEvent &e = b->events[r % THREAD_BUFFER_SIZE];
+
+			if (capture) {
+				_store_event(capture, capture_first_event, e.name, e.begin, e.end, b->thread_id);
+				capture_first_event = false;
+			}
+
+			if (frame) {
+				if (frame->count == frame->events.size()) {
+					frame->events.resize(MAX(64, frame->count * 2));
+				}
+				TraceHistoryEvent &h = frame->events.write[frame->count++];
+				h.name = e.name;
+				h.begin = e.begin;
+				h.end = e.end;
+				h.thread_id = b->thread_id;
+			}
+
+			if (profiling) {
+				Map<const char *, uint64_t>::Element *E = totals.find(e.name);
+				if (E) {
+					E->get() += e.end - e.begin;
+				} else {
+					totals.insert(e.name, e.end - e.begin);
+				}
+			}
+		}
+
+		// Frees the slots only once they have been read.
+		atomic_add(&b->read, w - b->read);
+	}
+
+	if (profiling && totals.size()) {
+		Array values;
+		for (Map<const char *, uint64_t>::Element *E = totals.front(); E; E = E->next()) {
+			values.push_back(String(E->key()));
+			values.push_back(USEC_TO_SEC(E->get()));
+		}
+		ScriptDebugger::get_singleton()->add_profiling_frame_data("trace", values);
+	}
+
+	enabled = capture || profiling || frame != NULL;
+}
+
+uint64_t Trace::get_dropped_events() {
+
+	return dropped_events;
+}
+
+void Trace::cleanup() {
+
+	stop_capture();
+	history.clear();
+
+	// Every other thread that traced has exited by now.
+	thread_owner.buffer = NULL;
+	while (buffers) {
+		TraceBuffer *b = buffers;
+		buffers = b->next;
+		Memory::free_static(b);
+	}
+}
@@ -0,0 +1,114 @@
+/*************************************************************************/
+/*  trace.h                                                              */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2019 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2019 Godot Engine contributors (cf. AUTHORS.md)    */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#ifndef TRACE_H
+#define TRACE_H
+
+#include "core/typedefs.h"
+#include "core/ustring.h"
+
+/**
+	Scoped CPU trace events.
+
+	TRACE_SCOPE("name") records the wall time spent until the end of the
+	enclosing scope. Each thread appends to its own ring buffer without
+	taking a lock, and Main::iteration() drains all buffers once per frame:
+	events are written to the capture file started with --trace (Chrome
+	trace JSON, which chrome://tracing and Perfetto both open) and, while
+	the script debugger is profiling, summed per name and sent to the
+	editor profiler under the "trace" category.
+
+	With set_history_frames(), flush() also keeps the events of the last
+	frames in memory so dump_history() can write them out after the fact,
+	which is how Performance captures hitches.
+
+	Names must be string literals, only the pointer is stored. Nothing is
+	recorded unless a capture, the history or the profiler is running, and
+	the macro compiles to nothing in release builds.
+*/
+
+class Trace {
+public:
+	enum {
+		THREAD_BUFFER_SIZE = 4096,
+	};
+
+private:
+	static bool enabled;
+
+public:
+	static _FORCE_INLINE_ bool is_enabled() { return enabled; }
+
+	static uint64_t get_ticks();
+	static void record(const char *p_name, uint64_t p_begin, uint64_t p_end);
+
+	static Error start_capture(const String &p_path);
+	static void stop_capture();
+	static bool is_capturing();
+
+	static void set_history_frames(int p_frames);
+	static int get_history_frames();
+	static Error dump_history(const String &p_path);
+
+	// Main thread only.
+	static void flush();
+
+	static uint64_t get_dropped_events();
+
+	static void cleanup();
+};
+
+class TraceScope {
+
+	const char *name;
+	uint64_t begin;
+
+public:
+	_FORCE_INLINE_ TraceScope(const char *p_name) {
+		name = p_name;
+		begin = Trace::is_enabled() ? Trace::get_ticks() : 0;
+	}
+	_FORCE_INLINE_ ~TraceScope() {
+		if (begin) {
+			Trace::record(name, begin, Trace::get_ticks());
+		}
+	}
+};
+
+#define _TRACE_CONCAT_IMPL(m_a, m_b) m_a##m_b
+#define _TRACE_CONCAT(m_a, m_b) _TRACE_CONCAT_IMPL(m_a, m_b)
+
+#ifdef DEBUG_ENABLED
+#define TRACE_SCOPE(m_name) TraceScope _TRACE_CONCAT(_trace_scope_, __LINE__)(m_name)
+#else
+#define TRACE_SCOPE(m_name)
+#endif
+
+#endif // TRACE_H
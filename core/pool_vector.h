@@ -34,7 +34,6 @@
 #include "core/os/copymem.h"
 #include "core/os/memory.h"
 #include "core/os/rw_lock.h"
-#include "core/pool_allocator.h"
 #include "core/safe_refcount.h"
 #include "core/ustring.h"
 
@@ -42,38 +41,51 @@ struct MemoryPool {
 
 	//avoid accessing these directly, must be public for template access
 
-	static PoolAllocator *memory_pool;
-	static uint8_t *pool_memory;
-	static size_t *pool_size;
+	//memory not allocated by the pool (such as a mapped file), deleted once the last alloc using it is freed
+	struct ExternalMemory {
+
+		SafeRefCount refcount;
+
+		ExternalMemory() { refcount.init(); }
+		virtual ~ExternalMemory() {}
+	};
 
 	struct Alloc {
 
 		SafeRefCount refcount;
 		uint32_t lock;
 		void *mem;
-		PoolAllocator::ID pool_id;
 		size_t size;
-
-		Alloc *free_list;
+		ExternalMemory *external;
 
 		Alloc() :
 				lock(0),
 				mem(NULL),
-				pool_id(POOL_ALLOCATOR_INVALID_ID),
 				size(0),
-				free_list(NULL) {
+				external(NULL) {
+			refcount.init();
 		}
 	};
 
-	static Alloc *allocs;
-	static Alloc *free_list;
-	static uint32_t alloc_count;
+	//every array gets its own Alloc, so there is no table to run out of and no lock to take
 	static uint32_t allocs_used;
-	static Mutex *alloc_mutex;
 	static size_t total_memory;
 	static size_t max_memory;
 
-	static void setup(uint32_t p_max_allocs = (1 << 16));
+	static Alloc *alloc();
+	static void release(Alloc *p_alloc);
+	static void free_mem(Alloc *p_alloc);
+
+	_FORCE_INLINE_ static void track_memory(size_t p_old_size, size_t p_new_size) {
+#ifdef DEBUG_ENABLED
+		if (p_new_size > p_old_size) {
+			atomic_exchange_if_greater(&max_memory, atomic_add(&total_memory, p_new_size - p_old_size));
+		} else if (p_new_size < p_old_size) {
+			atomic_sub(&total_memory, p_old_size - p_new_size);
+		}
+#endif
+	}
+
 	static void cleanup();
 };
 
@@ -97,43 +109,12 @@ class PoolVector {
 		if (alloc->refcount.get() == 1)
 			return; //nothing to do
 
-		//must allocate something
-
-		MemoryPool::alloc_mutex->lock();
-		if (MemoryPool::allocs_used == MemoryPool::alloc_count) {
-			MemoryPool::alloc_mutex->unlock();
-			ERR_EXPLAINC("All memory pool allocations are in use, can't COW.");
-			ERR_FAIL();
-		}
-
 		MemoryPool::Alloc *old_alloc = alloc;
 
-		//take one from the free list
-		alloc = MemoryPool::free_list;
-		MemoryPool::free_list = alloc->free_list;
-		//increment the used counter
-		MemoryPool::allocs_used++;
-
-		//copy the alloc data
+		alloc = MemoryPool::alloc();
 		alloc->size = old_alloc->size;
-		alloc->refcount.init();
-		alloc->pool_id = POOL_ALLOCATOR_INVALID_ID;
-		alloc->lock = 0;
-
-#ifdef DEBUG_ENABLED
-		MemoryPool::total_memory += alloc->size;
-		if (MemoryPool::total_memory > MemoryPool::max_memory) {
-			MemoryPool::max_memory = MemoryPool::total_memory;
-		}
-#endif
-
-		MemoryPool::alloc_mutex->unlock();
-
-		if (MemoryPool::memory_pool) {
-
-		} else {
-			alloc->mem = memalloc(alloc->size);
-		}
+		alloc->mem = memalloc(alloc->size);
+		MemoryPool::track_memory(0, alloc->size);
 
 		{
 			Write w;
@@ -152,11 +133,7 @@ class PoolVector {
 		if (old_alloc->refcount.unref()) {
 			//this should never happen but..
 
-#ifdef DEBUG_ENABLED
-			MemoryPool::alloc_mutex->lock();
-			MemoryPool::total_memory -= old_alloc->size;
-			MemoryPool::alloc_mutex->unlock();
-#endif
+			MemoryPool::track_memory(old_alloc->size, 0);
 
 			{
 				Write w;
@@ -169,22 +146,8 @@ class PoolVector {
 				}
 			}
 
-			if (MemoryPool::memory_pool) {
-				//resize memory pool
-				//if none, create
-				//if some resize
-			} else {
-
-				memfree(old_alloc->mem);
-				old_alloc->mem = NULL;
-				old_alloc->size = 0;
-
-				MemoryPool::alloc_mutex->lock();
-				old_alloc->free_list = MemoryPool::free_list;
-				MemoryPool::free_list = old_alloc;
-				MemoryPool::allocs_used--;
-				MemoryPool::alloc_mutex->unlock();
-			}
+			MemoryPool::free_mem(old_alloc);
+			MemoryPool::release(old_alloc);
 		}
 	}
 
@@ -231,28 +194,10 @@ class PoolVector {
 			}
 		}
 
-#ifdef DEBUG_ENABLED
-		MemoryPool::alloc_mutex->lock();
-		MemoryPool::total_memory -= alloc->size;
-		MemoryPool::alloc_mutex->unlock();
-#endif
+		MemoryPool::track_memory(alloc->size, 0);
 
-		if (MemoryPool::memory_pool) {
-			//resize memory pool
-			//if none, create
-			//if some resize
-		} else {
-
-			memfree(alloc->mem);
-			alloc->mem = NULL;
-			alloc->size = 0;
-
-			MemoryPool::alloc_mutex->lock();
-			alloc->free_list = MemoryPool::free_list;
-			MemoryPool::free_list = alloc;
-			MemoryPool::allocs_used--;
-			MemoryPool::alloc_mutex->unlock();
-		}
+		MemoryPool::free_mem(alloc);
+		MemoryPool::release(alloc);
 
 		alloc = NULL;
 	}
@@ -268,12 +213,7 @@ public:
 		_FORCE_INLINE_ void _ref(MemoryPool::Alloc *p_alloc) {
 			alloc = p_alloc;
 			if (alloc) {
-				if (atomic_increment(&alloc->lock) == 1) {
-					if (MemoryPool::memory_pool) {
-						//lock it and get mem
-					}
-				}
-
+				atomic_increment(&alloc->lock);
 				mem = (T *)alloc->mem;
 			}
 		}
@@ -281,12 +221,7 @@ public:
 		_FORCE_INLINE_ void _unref() {
 
 			if (alloc) {
-				if (atomic_decrement(&alloc->lock) == 0) {
-					if (MemoryPool::memory_pool) {
-						//put mem back
-					}
-				}
-
+				atomic_decrement(&alloc->lock);
 				mem = NULL;
 				alloc = NULL;
 			}
@@ -454,6 +389,9 @@ public:
 
 	bool is_locked() const { return alloc && alloc->lock > 0; }
 
+	Error set_external(MemoryPool::ExternalMemory *p_external, T *p_mem, int p_size);
+	bool is_external() const { return alloc && alloc->external; }
+
 	inline const T operator[](int p_index) const;
 
 	Error resize(int p_size);
@@ -516,25 +454,7 @@ Error PoolVector<T>::resize(int p_size) {
 		if (p_size == 0)
 			return OK; //nothing to do here
 
-		//must allocate something
-		MemoryPool::alloc_mutex->lock();
-		if (MemoryPool::allocs_used == MemoryPool::alloc_count) {
-			MemoryPool::alloc_mutex->unlock();
-			ERR_EXPLAINC("All memory pool allocations are in use.");
-			ERR_FAIL_V(ERR_OUT_OF_MEMORY);
-		}
-
-		//take one from the free list
-		alloc = MemoryPool::free_list;
-		MemoryPool::free_list = alloc->free_list;
-		//increment the used counter
-		MemoryPool::allocs_used++;
-
-		//cleanup the alloc
-		alloc->size = 0;
-		alloc->refcount.init();
-		alloc->pool_id = POOL_ALLOCATOR_INVALID_ID;
-		MemoryPool::alloc_mutex->unlock();
+		alloc = MemoryPool::alloc();
 
 	} else {
 
@@ -553,31 +473,24 @@ Error PoolVector<T>::resize(int p_size) {
 
 	_copy_on_write(); // make it unique
 
-#ifdef DEBUG_ENABLED
-	MemoryPool::alloc_mutex->lock();
-	MemoryPool::total_memory -= alloc->size;
-	MemoryPool::total_memory += new_size;
-	if (MemoryPool::total_memory > MemoryPool::max_memory) {
-		MemoryPool::max_memory = MemoryPool::total_memory;
+	if (alloc->external) {
+		//external memory can't be reallocated, move it to our own (only plain types are ever external)
+		void *mem = memalloc(alloc->size);
+		copymem(mem, alloc->mem, alloc->size);
+		MemoryPool::free_mem(alloc);
+		alloc->mem = mem;
 	}
-	MemoryPool::alloc_mutex->unlock();
-#endif
+
+	MemoryPool::track_memory(alloc->size, new_size);
 
 	int cur_elements = alloc->size / sizeof(T);
 
 	if (p_size > cur_elements) {
 
-		if (MemoryPool::memory_pool) {
-			//resize memory pool
-			//if none, create
-			//if some resize
+		if (alloc->size == 0) {
+			alloc->mem = memalloc(new_size);
 		} else {
-
-			if (alloc->size == 0) {
-				alloc->mem = memalloc(new_size);
-			} else {
-				alloc->mem = memrealloc(alloc->mem, new_size);
-			}
+			alloc->mem = memrealloc(alloc->mem, new_size);
 		}
 
 		alloc->size = new_size;
@@ -599,29 +512,25 @@ Error PoolVector<T>::resize(int p_size) {
 			}
 		}
 
-		if (MemoryPool::memory_pool) {
-			//resize memory pool
-			//if none, create
-			//if some resize
-		} else {
+		alloc->mem = memrealloc(alloc->mem, new_size);
+		alloc->size = new_size;
+	}
+
+	return OK;
+}
 
-			if (new_size == 0) {
-				memfree(alloc->mem);
-				alloc->mem = NULL;
-				alloc->size = 0;
+template <class T>
+Error PoolVector<T>::set_external(MemoryPool::ExternalMemory *p_external, T *p_mem, int p_size) {
 
-				MemoryPool::alloc_mutex->lock();
-				alloc->free_list = MemoryPool::free_list;
-				MemoryPool::free_list = alloc;
-				MemoryPool::allocs_used--;
-				MemoryPool::alloc_mutex->unlock();
+	//takes ownership of p_external, even on failure
+	_unreference();
 
-			} else {
-				alloc->mem = memrealloc(alloc->mem, new_size);
-				alloc->size = new_size;
-			}
-		}
-	}
+	alloc = MemoryPool::alloc();
+	alloc->size = sizeof(T) * p_size;
+	alloc->mem = p_mem;
+	alloc->external = p_external;
+
+	MemoryPool::track_memory(0, alloc->size);
 
 	return OK;
 }
@@ -37,12 +37,14 @@
 #include "core/engine.h"
 #include "core/func_ref.h"
 #include "core/input_map.h"
+#include "core/io/compression.h"
 #include "core/io/config_file.h"
 #include "core/io/http_client.h"
 #include "core/io/image_loader.h"
 #include "core/io/marshalls.h"
 #include "core/io/multiplayer_api.h"
 #include "core/io/networked_multiplayer_peer.h"
+#include "core/io/packed_schema.h"
 #include "core/io/packet_peer.h"
 #include "core/io/packet_peer_udp.h"
 #include "core/io/pck_packer.h"
@@ -57,8 +59,10 @@
 #include "core/math/geometry.h"
 #include "core/math/random_number_generator.h"
 #include "core/math/triangle_mesh.h"
+#include "core/os/file_access.h"
 #include "core/os/input.h"
 #include "core/os/main_loop.h"
+#include "core/os/thread_work_pool.h"
 #include "core/packed_data_container.h"
 #include "core/path_remap.h"
 #include "core/project_settings.h"
@@ -94,12 +98,14 @@ void register_core_types() {
 
 	ObjectDB::setup();
 	ResourceCache::setup();
-	MemoryPool::setup();
 
 	_global_mutex = Mutex::create();
+	ThreadWorkPool::setup();
+	FileAccess::setup_async_reads();
 
 	StringName::setup();
 	ResourceLoader::initialize();
+	ImageLoader::initialize();
 
 	register_global_constants();
 	register_variant_methods();
@@ -155,6 +161,7 @@ void register_core_types() {
 	ClassDB::register_virtual_class<IP>();
 	ClassDB::register_virtual_class<PacketPeer>();
 	ClassDB::register_class<PacketPeerStream>();
+	ClassDB::register_class<PackedSchema>();
 	ClassDB::register_virtual_class<NetworkedMultiplayerPeer>();
 	ClassDB::register_class<MultiplayerAPI>();
 	ClassDB::register_class<MainLoop>();
@@ -270,6 +277,7 @@ void unregister_core_types() {
 	if (ip)
 		memdelete(ip);
 
+	ImageLoader::finalize();
 	ResourceLoader::finalize();
 
 	ObjectDB::cleanup();
@@ -282,6 +290,10 @@ void unregister_core_types() {
 	CoreStringNames::free();
 	StringName::cleanup();
 
+	ThreadWorkPool::cleanup();
+	FileAccess::finish_async_reads();
+	Compression::clear_zstd_dictionaries();
+
 	if (_global_mutex) {
 		memdelete(_global_mutex);
 		_global_mutex = NULL; //still needed at a few places
@@ -143,6 +143,10 @@ uint32_t atomic_exchange_if_greater(volatile uint32_t *pw, volatile uint32_t val
 	return _atomic_exchange_if_greater_impl(pw, val);
 }
 
+bool atomic_compare_exchange(volatile uint32_t *pw, uint32_t expected, uint32_t desired) {
+	return (uint32_t)InterlockedCompareExchange((LONG volatile *)pw, desired, expected) == expected;
+}
+
 uint64_t atomic_conditional_increment(volatile uint64_t *pw) {
 	return _atomic_conditional_increment_impl(pw);
 }
@@ -166,4 +170,8 @@ uint64_t atomic_add(volatile uint64_t *pw, volatile uint64_t val) {
 uint64_t atomic_exchange_if_greater(volatile uint64_t *pw, volatile uint64_t val) {
 	return _atomic_exchange_if_greater_impl(pw, val);
 }
+
+bool atomic_compare_exchange(volatile uint64_t *pw, uint64_t expected, uint64_t desired) {
+	return (uint64_t)InterlockedCompareExchange64((LONGLONG volatile *)pw, desired, expected) == expected;
+}
 #endif
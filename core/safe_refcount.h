@@ -93,6 +93,17 @@ static _ALWAYS_INLINE_ T atomic_exchange_if_greater(volatile T *pw, volatile V v
 	return *pw;
 }
 
+template <class T>
+static _ALWAYS_INLINE_ bool atomic_compare_exchange(volatile T *pw, T expected, T desired) {
+
+	if (*pw != expected)
+		return false;
+
+	*pw = desired;
+
+	return true;
+}
+
 #elif defined(__GNUC__)
 
 /* Implementation for GCC & Clang */
@@ -148,6 +159,12 @@ static _ALWAYS_INLINE_ T atomic_exchange_if_greater(volatile T *pw, volatile V v
 	}
 }
 
+template <class T>
+static _ALWAYS_INLINE_ bool atomic_compare_exchange(volatile T *pw, T expected, T desired) {
+
+	return __sync_bool_compare_and_swap(pw, expected, desired);
+}
+
 #elif defined(_MSC_VER)
 // For MSVC use a separate compilation unit to prevent windows.h from polluting
 // the global namespace.
@@ -157,6 +174,7 @@ uint32_t atomic_increment(volatile uint32_t *pw);
 uint32_t atomic_sub(volatile uint32_t *pw, volatile uint32_t val);
 uint32_t atomic_add(volatile uint32_t *pw, volatile uint32_t val);
 uint32_t atomic_exchange_if_greater(volatile uint32_t *pw, volatile uint32_t val);
+bool atomic_compare_exchange(volatile uint32_t *pw, uint32_t expected, uint32_t desired);
 
 uint64_t atomic_conditional_increment(volatile uint64_t *pw);
 uint64_t atomic_decrement(volatile uint64_t *pw);
@@ -164,6 +182,7 @@ uint64_t atomic_increment(volatile uint64_t *pw);
 uint64_t atomic_sub(volatile uint64_t *pw, volatile uint64_t val);
 uint64_t atomic_add(volatile uint64_t *pw, volatile uint64_t val);
 uint64_t atomic_exchange_if_greater(volatile uint64_t *pw, volatile uint64_t val);
+bool atomic_compare_exchange(volatile uint64_t *pw, uint64_t expected, uint64_t desired);
 
 #else
 //no threads supported?
@@ -31,6 +31,7 @@
 #include "script_debugger_remote.h"
 
 #include "core/engine.h"
+#include "core/io/compression.h"
 #include "core/io/ip.h"
 #include "core/io/marshalls.h"
 #include "core/os/input.h"
@@ -280,7 +281,7 @@ void ScriptDebuggerRemote::debug(ScriptLanguage *p_script, bool p_can_continue)
 			} else if (command == "request_scene_tree") {
 
 				if (request_scene_tree)
-					request_scene_tree(request_scene_tree_ud);
+					request_scene_tree(request_scene_tree_ud, cmd.size() < 2 || bool(cmd[1]));
 
 			} else if (command == "request_video_mem") {
 
@@ -288,7 +289,7 @@ void ScriptDebuggerRemote::debug(ScriptLanguage *p_script, bool p_can_continue)
 			} else if (command == "inspect_object") {
 
 				ObjectID id = cmd[1];
-				_send_object_id(id);
+				_send_object_id(id, cmd.size() > 2 && bool(cmd[2]));
 			} else if (command == "set_object_property") {
 
 				_set_object_property(cmd[1], cmd[2], cmd[3]);
@@ -348,11 +349,7 @@ void ScriptDebuggerRemote::_get_output() {
 
 	while (messages.size()) {
 		locking = true;
-		packet_peer_stream->put_var("message:" + messages.front()->get().message);
-		packet_peer_stream->put_var(messages.front()->get().data.size());
-		for (int i = 0; i < messages.front()->get().data.size(); i++) {
-			packet_peer_stream->put_var(messages.front()->get().data[i]);
-		}
+		_put_message(messages.front()->get().message, messages.front()->get().data);
 		messages.pop_front();
 		locking = false;
 	}
@@ -526,7 +523,46 @@ bool ScriptDebuggerRemote::_parse_live_edit(const Array &p_command) {
 	return true;
 }
 
-void ScriptDebuggerRemote::_send_object_id(ObjectID p_id) {
+void ScriptDebuggerRemote::_put_message(const String &p_message, const Array &p_data) {
+
+	if (compress_threshold > 0 && p_data.size() > 1) {
+
+		int len = 0;
+		Error err = encode_variant(p_data, NULL, len);
+		if (err == OK && len > compress_threshold) {
+
+			// big messages (such as whole scene trees) are sent as a single compressed buffer
+			Vector<uint8_t> encoded;
+			encoded.resize(len);
+			encode_variant(p_data, encoded.ptrw(), len);
+
+			PoolVector<uint8_t> compressed;
+			compressed.resize(Compression::get_max_compressed_buffer_size(len, Compression::MODE_ZSTD));
+			int compressed_len;
+			{
+				PoolVector<uint8_t>::Write w = compressed.write();
+				compressed_len = Compression::compress(w.ptr(), encoded.ptr(), len, Compression::MODE_ZSTD);
+			}
+
+			if (compressed_len > 0 && compressed_len < len && compressed_len + 64 < packet_peer_stream->get_output_buffer_max_size()) {
+				compressed.resize(compressed_len);
+				packet_peer_stream->put_var("compressed:" + p_message);
+				packet_peer_stream->put_var(2);
+				packet_peer_stream->put_var(len);
+				packet_peer_stream->put_var(compressed);
+				return;
+			}
+		}
+	}
+
+	packet_peer_stream->put_var("message:" + p_message);
+	packet_peer_stream->put_var(p_data.size());
+	for (int i = 0; i < p_data.size(); i++) {
+		packet_peer_stream->put_var(p_data[i]);
+	}
+}
+
+void ScriptDebuggerRemote::_send_object_id(ObjectID p_id, bool p_only_if_changed) {
 
 	Object *obj = ObjectDB::get_instance(p_id);
 	if (!obj)
@@ -616,9 +652,9 @@ void ScriptDebuggerRemote::_send_object_id(ObjectID p_id) {
 	}
 
 	Array send_props;
-	for (int i = 0; i < properties.size(); i++) {
-		const PropertyInfo &pi = properties[i].first;
-		Variant &var = properties[i].second;
+	for (List<PropertyDesc>::Element *E = properties.front(); E; E = E->next()) {
+		const PropertyInfo &pi = E->get().first;
+		Variant &var = E->get().second;
 
 		WeakRef *ref = Object::cast_to<WeakRef>(var);
 		if (ref) {
@@ -653,11 +689,19 @@ void ScriptDebuggerRemote::_send_object_id(ObjectID p_id) {
 		send_props.push_back(prop);
 	}
 
-	packet_peer_stream->put_var("message:inspect_object");
-	packet_peer_stream->put_var(3);
-	packet_peer_stream->put_var(p_id);
-	packet_peer_stream->put_var(obj->get_class());
-	packet_peer_stream->put_var(send_props);
+	// the editor polls the inspected object, don't send it again when nothing changed
+	uint32_t props_hash = send_props.hash();
+	if (p_only_if_changed && p_id == inspected_object_id && props_hash == inspected_object_hash)
+		return;
+
+	inspected_object_id = p_id;
+	inspected_object_hash = props_hash;
+
+	Array msg;
+	msg.push_back(p_id);
+	msg.push_back(obj->get_class());
+	msg.push_back(send_props);
+	_put_message("inspect_object", msg);
 }
 
 void ScriptDebuggerRemote::_set_object_property(ObjectID p_id, const String &p_property, const Variant &p_value) {
@@ -707,14 +751,14 @@ void ScriptDebuggerRemote::_poll_events() {
 		} else if (command == "request_scene_tree") {
 
 			if (request_scene_tree)
-				request_scene_tree(request_scene_tree_ud);
+				request_scene_tree(request_scene_tree_ud, cmd.size() < 2 || bool(cmd[1]));
 		} else if (command == "request_video_mem") {
 
 			_send_video_memory();
 		} else if (command == "inspect_object") {
 
 			ObjectID id = cmd[1];
-			_send_object_id(id);
+			_send_object_id(id, cmd.size() > 2 && bool(cmd[2]));
 		} else if (command == "set_object_property") {
 
 			_set_object_property(cmd[1], cmd[2], cmd[3]);
@@ -743,6 +787,33 @@ void ScriptDebuggerRemote::_poll_events() {
 			profiling = false;
 			_send_profiling_data(false);
 			print_line("PROFILING END!");
+		} else if (command == "start_network_profiling") {
+
+			network_profiling = true;
+			last_network_time = 0;
+			if (multiplayer.is_valid()) {
+				multiplayer->profiling_start();
+			}
+		} else if (command == "start_sampling") {
+
+			for (int i = 0; i < ScriptServer::get_language_count(); i++) {
+				ScriptServer::get_language(i)->profiling_sampling_start(cmd[1]);
+			}
+			sampling = true;
+			last_sample_time = OS::get_singleton()->get_ticks_msec();
+		} else if (command == "stop_sampling") {
+
+			_send_stack_samples();
+			for (int i = 0; i < ScriptServer::get_language_count(); i++) {
+				ScriptServer::get_language(i)->profiling_sampling_stop();
+			}
+			sampling = false;
+		} else if (command == "stop_network_profiling") {
+
+			network_profiling = false;
+			if (multiplayer.is_valid()) {
+				multiplayer->profiling_end();
+			}
 		} else if (command == "reload_scripts") {
 			reload_all_scripts = true;
 		} else if (command == "breakpoint") {
@@ -848,6 +919,65 @@ void ScriptDebuggerRemote::_send_profiling_data(bool p_for_frame) {
 	}
 }
 
+void ScriptDebuggerRemote::_send_network_profiling_data() {
+
+	Array frame = multiplayer->get_profiling_frame();
+	if (frame.empty())
+		return;
+
+	packet_peer_stream->put_var("network_profile");
+	packet_peer_stream->put_var(1);
+	packet_peer_stream->put_var(frame);
+}
+
+void ScriptDebuggerRemote::_send_network_bandwidth_data() {
+
+	Array peers;
+	Vector<int> ids = multiplayer->has_network_peer() ? multiplayer->get_network_connected_peers() : Vector<int>();
+	for (int i = 0; i < ids.size(); i++) {
+		Dictionary stats = multiplayer->get_peer_statistics(ids[i]);
+		peers.push_back(ids[i]);
+		peers.push_back(stats["rtt"]);
+		peers.push_back(stats["packet_loss"]);
+	}
+
+	packet_peer_stream->put_var("network_bandwidth");
+	packet_peer_stream->put_var(3);
+	packet_peer_stream->put_var(multiplayer->get_network_bytes_received());
+	packet_peer_stream->put_var(multiplayer->get_network_bytes_sent());
+	packet_peer_stream->put_var(peers);
+}
+
+void ScriptDebuggerRemote::_send_stack_samples() {
+
+	List<ScriptLanguage::ProfilingStackSample> samples;
+	for (int i = 0; i < ScriptServer::get_language_count(); i++) {
+		ScriptServer::get_language(i)->profiling_get_stack_samples(&samples);
+	}
+
+	if (samples.empty())
+		return;
+
+	Array arr;
+	for (List<ScriptLanguage::ProfilingStackSample>::Element *E = samples.front(); E; E = E->next()) {
+
+		PoolStringArray stack;
+		stack.resize(E->get().stack.size());
+		{
+			PoolStringArray::Write w = stack.write();
+			for (int i = 0; i < E->get().stack.size(); i++) {
+				w[i] = E->get().stack[i];
+			}
+		}
+		arr.push_back(E->get().count);
+		arr.push_back(stack);
+	}
+
+	packet_peer_stream->put_var("stack_samples");
+	packet_peer_stream->put_var(1);
+	packet_peer_stream->put_var(arr);
+}
+
 void ScriptDebuggerRemote::idle_poll() {
 
 	// this function is called every frame, except when there is a debugger break (::debug() in this class)
@@ -890,6 +1020,28 @@ void ScriptDebuggerRemote::idle_poll() {
 		}
 	}
 
+	if (sampling) {
+
+		// Samples are merged by stack, sending them in batches keeps the traffic small.
+		uint64_t pt = OS::get_singleton()->get_ticks_msec();
+		if (pt - last_sample_time > 500) {
+			last_sample_time = pt;
+			_send_stack_samples();
+		}
+	}
+
+	if (network_profiling && multiplayer.is_valid()) {
+
+		// Per RPC counts are cheap to send every frame, link statistics need a short interval to mean anything.
+		_send_network_profiling_data();
+
+		uint64_t pt = OS::get_singleton()->get_ticks_msec();
+		if (pt - last_network_time > 500) {
+			last_network_time = pt;
+			_send_network_bandwidth_data();
+		}
+	}
+
 	if (reload_all_scripts) {
 
 		for (int i = 0; i < ScriptServer::get_language_count(); i++) {
@@ -1014,6 +1166,17 @@ void ScriptDebuggerRemote::set_live_edit_funcs(LiveEditFuncs *p_funcs) {
 	live_edit_funcs = p_funcs;
 }
 
+void ScriptDebuggerRemote::set_multiplayer(const Ref<MultiplayerAPI> &p_multiplayer) {
+
+	if (multiplayer.is_valid() && network_profiling) {
+		multiplayer->profiling_end();
+	}
+	multiplayer = p_multiplayer;
+	if (multiplayer.is_valid() && network_profiling) {
+		multiplayer->profiling_start();
+	}
+}
+
 bool ScriptDebuggerRemote::is_profiling() const {
 
 	return profiling;
@@ -1066,6 +1229,10 @@ ScriptDebuggerRemote::ScriptDebuggerRemote() :
 		packet_peer_stream(Ref<PacketPeerStream>(memnew(PacketPeerStream))),
 		last_perf_time(0),
 		performance(Engine::get_singleton()->get_singleton_object("Performance")),
+		network_profiling(false),
+		last_network_time(0),
+		sampling(false),
+		last_sample_time(0),
 		requested_quit(false),
 		mutex(Mutex::create()),
 		max_messages_per_frame(GLOBAL_GET("network/limits/debugger_stdout/max_messages_per_frame")),
@@ -1079,6 +1246,9 @@ ScriptDebuggerRemote::ScriptDebuggerRemote() :
 		locking(false),
 		poll_every(0),
 		request_scene_tree(NULL),
+		inspected_object_id(0),
+		inspected_object_hash(0),
+		compress_threshold(int(GLOBAL_GET("network/limits/debugger/compress_messages_over_kb")) * 1024),
 		live_edit_funcs(NULL) {
 
 	packet_peer_stream->set_stream_peer(tcp_client);
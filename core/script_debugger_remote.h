@@ -68,6 +68,13 @@ class ScriptDebuggerRemote : public ScriptDebugger {
 
 	uint64_t last_perf_time;
 	Object *performance;
+
+	Ref<MultiplayerAPI> multiplayer;
+	bool network_profiling;
+	uint64_t last_network_time;
+
+	bool sampling;
+	uint64_t last_sample_time;
 	bool requested_quit;
 	Mutex *mutex;
 
@@ -115,7 +122,12 @@ class ScriptDebuggerRemote : public ScriptDebugger {
 
 	void _set_object_property(ObjectID p_id, const String &p_property, const Variant &p_value);
 
-	void _send_object_id(ObjectID p_id);
+	ObjectID inspected_object_id;
+	uint32_t inspected_object_hash;
+	int compress_threshold;
+
+	void _put_message(const String &p_message, const Array &p_data);
+	void _send_object_id(ObjectID p_id, bool p_only_if_changed = false);
 	void _send_video_memory();
 	LiveEditFuncs *live_edit_funcs;
 
@@ -123,6 +135,9 @@ class ScriptDebuggerRemote : public ScriptDebugger {
 	static void _err_handler(void *, const char *, const char *, int p_line, const char *, const char *, ErrorHandlerType p_type);
 
 	void _send_profiling_data(bool p_for_frame);
+	void _send_network_profiling_data();
+	void _send_network_bandwidth_data();
+	void _send_stack_samples();
 
 	struct FrameData {
 
@@ -164,6 +179,7 @@ public:
 
 	virtual void set_request_scene_tree_message_func(RequestSceneTreeMessageFunc p_func, void *p_udata);
 	virtual void set_live_edit_funcs(LiveEditFuncs *p_funcs);
+	virtual void set_multiplayer(const Ref<MultiplayerAPI> &p_multiplayer);
 
 	virtual bool is_profiling() const;
 	virtual void add_profiling_frame_data(const StringName &p_name, const Array &p_data);
@@ -319,6 +319,17 @@ public:
 	virtual int profiling_get_accumulated_data(ProfilingInfo *p_info_arr, int p_info_max) = 0;
 	virtual int profiling_get_frame_data(ProfilingInfo *p_info_arr, int p_info_max) = 0;
 
+	struct ProfilingStackSample {
+		Vector<StringName> stack; // Function signatures, outermost call first.
+		int count;
+	};
+
+	// Sampling profiler, a background thread records the script call stack p_frequency times per second.
+	virtual void profiling_sampling_start(int p_frequency) {}
+	virtual void profiling_sampling_stop() {}
+	// Returns the stacks sampled since the last call, merged by identical stack.
+	virtual void profiling_get_stack_samples(List<ProfilingStackSample> *r_samples) {}
+
 	virtual void *alloc_instance_binding_data(Object *p_object) { return NULL; } //optional, not used by all languages
 	virtual void free_instance_binding_data(void *p_data) {} //optional, not used by all languages
 	virtual void refcount_incremented_instance_binding(Object *p_object) {} //optional, not used by all languages
@@ -391,7 +402,7 @@ class ScriptDebugger {
 	ScriptLanguage *break_lang;
 
 public:
-	typedef void (*RequestSceneTreeMessageFunc)(void *);
+	typedef void (*RequestSceneTreeMessageFunc)(void *, bool p_full);
 
 	struct LiveEditFuncs {
 
@@ -446,6 +457,7 @@ public:
 
 	virtual void set_request_scene_tree_message_func(RequestSceneTreeMessageFunc p_func, void *p_udata) {}
 	virtual void set_live_edit_funcs(LiveEditFuncs *p_funcs) {}
+	virtual void set_multiplayer(const Ref<MultiplayerAPI> &p_multiplayer) {}
 
 	virtual bool is_profiling() const = 0;
 	virtual void add_profiling_frame_data(const StringName &p_name, const Array &p_data) = 0;
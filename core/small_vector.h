@@ -0,0 +1,188 @@
+/*************************************************************************/
+/*  small_vector.h                                                       */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2019 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2019 Godot Engine contributors (cf. AUTHORS.md)    */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+
+#ifndef SMALL_VECTOR_H
+#define SMALL_VECTOR_H
+
+#include "core/error_macros.h"
+#include "core/os/memory.h"
+#include "core/vector.h"
+
+/**
+ * Array that keeps up to N elements inside the object itself and only moves to
+ * the heap when it grows past that. Meant for short temporaries on hot paths
+ * (frustum planes, small result lists), where a Vector would allocate every time.
+ */
+
+template <class T, int N>
+class SmallVector {
+
+	alignas(T) uint8_t inline_data[N * sizeof(T)];
+	T *data;
+	int count;
+	int capacity;
+
+	_FORCE_INLINE_ T *_inline() { return reinterpret_cast<T *>(inline_data); }
+	_FORCE_INLINE_ bool _is_inline() const { return data == reinterpret_cast<const T *>(inline_data); }
+
+	void _realloc(int p_capacity) {
+
+		T *new_data = (T *)memalloc(p_capacity * sizeof(T));
+		for (int i = 0; i < count; i++) {
+			memnew_placement(&new_data[i], T(static_cast<T &&>(data[i])));
+			data[i].~T();
+		}
+		if (!_is_inline()) {
+			memfree(data);
+		}
+		data = new_data;
+		capacity = p_capacity;
+	}
+
+	void _grow_push_back(T &&p_elem) {
+
+		_realloc(capacity * 2);
+		memnew_placement(&data[count], T(static_cast<T &&>(p_elem)));
+		count++;
+	}
+
+public:
+	_FORCE_INLINE_ T *ptr() { return data; }
+	_FORCE_INLINE_ const T *ptr() const { return data; }
+	_FORCE_INLINE_ T *ptrw() { return data; }
+
+	_FORCE_INLINE_ int size() const { return count; }
+	_FORCE_INLINE_ bool empty() const { return count == 0; }
+	_FORCE_INLINE_ bool is_inline() const { return _is_inline(); }
+
+	_FORCE_INLINE_ T &operator[](int p_index) {
+		CRASH_BAD_INDEX(p_index, count);
+		return data[p_index];
+	}
+	_FORCE_INLINE_ const T &operator[](int p_index) const {
+		CRASH_BAD_INDEX(p_index, count);
+		return data[p_index];
+	}
+
+	void reserve(int p_size) {
+
+		if (p_size > capacity) {
+			_realloc(next_power_of_2(p_size));
+		}
+	}
+
+	_FORCE_INLINE_ void push_back(const T &p_elem) {
+
+		if (unlikely(count == capacity)) {
+			_grow_push_back(T(p_elem));
+			return;
+		}
+		memnew_placement(&data[count], T(p_elem));
+		count++;
+	}
+
+	void remove_unordered(int p_index) {
+
+		ERR_FAIL_INDEX(p_index, count);
+		count--;
+		if (p_index < count) {
+			data[p_index] = static_cast<T &&>(data[count]);
+		}
+		data[count].~T();
+	}
+
+	void resize(int p_size) {
+
+		ERR_FAIL_COND(p_size < 0);
+		if (p_size < count) {
+			for (int i = p_size; i < count; i++) {
+				data[i].~T();
+			}
+			count = p_size;
+		} else if (p_size > count) {
+			reserve(p_size);
+			for (int i = count; i < p_size; i++) {
+				memnew_placement(&data[i], T);
+			}
+			count = p_size;
+		}
+	}
+
+	void clear() { resize(0); }
+
+	operator Vector<T>() const {
+
+		Vector<T> ret;
+		ret.resize(count);
+		T *w = ret.ptrw();
+		for (int i = 0; i < count; i++) {
+			w[i] = data[i];
+		}
+		return ret;
+	}
+
+	void operator=(const SmallVector &p_from) {
+
+		if (this == &p_from)
+			return;
+		clear();
+		reserve(p_from.count);
+		for (int i = 0; i < p_from.count; i++) {
+			memnew_placement(&data[i], T(p_from.data[i]));
+		}
+		count = p_from.count;
+	}
+
+	SmallVector(const SmallVector &p_from) {
+
+		data = _inline();
+		count = 0;
+		capacity = N;
+		*this = p_from;
+	}
+
+	_FORCE_INLINE_ SmallVector() {
+
+		data = _inline();
+		count = 0;
+		capacity = N;
+	}
+
+	~SmallVector() {
+
+		clear();
+		if (!_is_inline()) {
+			memfree(data);
+		}
+	}
+};
+
+#endif // SMALL_VECTOR_H
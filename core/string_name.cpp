@@ -33,13 +33,18 @@
 #include "core/os/os.h"
 #include "core/print_string.h"
 
-StaticCString StaticCString::create(const char *p_ptr) {
+StaticCString StaticCString::create(const char *p_ptr, uint32_t p_hash) {
 	StaticCString scs;
 	scs.ptr = p_ptr;
+	scs.hash = p_hash;
 	return scs;
 }
 
-StringName::_Data *StringName::_table[STRING_TABLE_LEN];
+StringName::_Table *volatile StringName::_table = NULL;
+StringName::_Table *StringName::retired_table = NULL;
+StringName::_Data *StringName::retired_data = NULL;
+uint32_t StringName::entry_count = 0;
+StringName::_ReaderSlot StringName::reader_slots[StringName::READER_SLOTS];
 
 StringName _scs_create(const char *p_chr) {
 
@@ -49,15 +54,201 @@ StringName _scs_create(const char *p_chr) {
 bool StringName::configured = false;
 Mutex *StringName::lock = NULL;
 
+// Every atomic in safe_refcount.h is a full barrier. Writers use this to make
+// an entry or table fully visible before the pointer to it is published.
+static _FORCE_INLINE_ void _publish_barrier() {
+
+	static volatile uint32_t fence = 0;
+	atomic_increment(&fence);
+}
+
+bool StringName::_Data::matches(const char *p_name) const {
+
+	if (!cname)
+		return name == p_name;
+
+	const char *c = cname;
+	while (*c && *c == *p_name) {
+		c++;
+		p_name++;
+	}
+	return *c == *p_name;
+}
+
+bool StringName::_Data::matches(const CharType *p_name) const {
+
+	return get_name() == p_name;
+}
+
+bool StringName::_Data::matches(const String &p_name) const {
+
+	return cname ? p_name == cname : name == p_name;
+}
+
+StringName::_ReaderSlot &StringName::_get_reader_slot() {
+
+#ifdef NO_THREADS
+	return reader_slots[0];
+#else
+	static volatile uint32_t next_slot = 0;
+	static thread_local uint32_t slot = 0; // Slot index + 1, 0 until first use.
+	if (unlikely(!slot)) {
+		slot = (atomic_increment(&next_slot) - 1) % READER_SLOTS + 1;
+	}
+	return reader_slots[slot - 1];
+#endif
+}
+
+template <class T>
+StringName::_Data *StringName::_find(const T &p_name, uint32_t p_hash) {
+
+	_ReaderSlot &reader = _get_reader_slot();
+	atomic_increment(&reader.count);
+
+	_Table *table = _table;
+	_Data *found = NULL;
+	for (_Data *d = table->buckets[p_hash & table->mask]; d; d = d->next[table->links]) {
+		// An entry whose refcount already dropped to zero is being removed,
+		// a live duplicate may follow it in the chain.
+		if (d->hash == p_hash && d->matches(p_name) && d->refcount.ref()) {
+			found = d;
+			break;
+		}
+	}
+
+	atomic_decrement(&reader.count);
+	return found;
+}
+
+template <class T>
+StringName::_Data *StringName::_intern(const T &p_name, uint32_t p_hash, const char *p_cname, bool p_static) {
+
+	_Data *data = _find(p_name, p_hash);
+	if (data) {
+		if (p_static) {
+			data->is_static = true;
+		}
+		return data;
+	}
+
+	lock->lock();
+
+	// The lock-free pass may have raced with another thread interning the same name.
+	_Table *table = _table;
+	uint32_t idx = p_hash & table->mask;
+	for (data = table->buckets[idx]; data; data = data->next[table->links]) {
+		if (data->hash == p_hash && data->matches(p_name) && data->refcount.ref()) {
+			if (p_static) {
+				data->is_static = true;
+			}
+			lock->unlock();
+			return data;
+		}
+	}
+
+	if (entry_count >= table->mask + 1) {
+		_grow();
+		table = _table;
+		idx = p_hash & table->mask;
+	}
+
+	data = memnew(_Data);
+	if (p_cname) {
+		data->cname = p_cname;
+	} else {
+		data->name = p_name;
+	}
+	data->refcount.init();
+	data->hash = p_hash;
+	data->is_static = p_static;
+	data->next[table->links] = table->buckets[idx];
+	entry_count++;
+
+	_publish_barrier();
+	table->buckets[idx] = data;
+
+	lock->unlock();
+	return data;
+}
+
+StringName::_Table *StringName::_create_table(uint32_t p_bits, uint32_t p_links) {
+
+	_Table *table = memnew(_Table);
+	table->mask = (1 << p_bits) - 1;
+	table->links = p_links;
+	table->buckets = (_Data * volatile *)memalloc(sizeof(_Data *) << p_bits);
+	for (uint32_t i = 0; i <= table->mask; i++) {
+		table->buckets[i] = NULL;
+	}
+	return table;
+}
+
+void StringName::_grow() {
+
+	// The other link set is still in use until the previous table is freed,
+	// keep the longer chains until then.
+	_reclaim();
+	if (retired_table) {
+		return;
+	}
+
+	_Table *old_table = _table;
+	uint32_t bits = 0;
+	while ((1u << bits) <= old_table->mask) {
+		bits++;
+	}
+	_Table *table = _create_table(bits + 1, old_table->links ^ 1);
+
+	for (uint32_t i = 0; i <= old_table->mask; i++) {
+		for (_Data *d = old_table->buckets[i]; d; d = d->next[old_table->links]) {
+			uint32_t idx = d->hash & table->mask;
+			d->next[table->links] = table->buckets[idx];
+			table->buckets[idx] = d;
+		}
+	}
+
+	_publish_barrier();
+	_table = table;
+	retired_table = old_table;
+}
+
+void StringName::_reclaim() {
+
+	if (!retired_table && !retired_data) {
+		return;
+	}
+
+	// Anything retired was unlinked before this point, so a reader entering
+	// after its slot was seen empty can no longer reach it.
+	_publish_barrier();
+	for (int i = 0; i < READER_SLOTS; i++) {
+		if (reader_slots[i].count) {
+			return;
+		}
+	}
+
+	if (retired_table) {
+		memfree((void *)retired_table->buckets);
+		memdelete(retired_table);
+		retired_table = NULL;
+	}
+
+	while (retired_data) {
+		_Data *d = retired_data;
+		retired_data = d->retired_next;
+		memdelete(d);
+	}
+}
+
 void StringName::setup() {
 
 	lock = Mutex::create();
 
 	ERR_FAIL_COND(configured);
-	for (int i = 0; i < STRING_TABLE_LEN; i++) {
-
-		_table[i] = NULL;
+	for (int i = 0; i < READER_SLOTS; i++) {
+		reader_slots[i].count = 0;
 	}
+	_table = _create_table(STRING_TABLE_MIN_BITS, 0);
 	configured = true;
 }
 
@@ -66,27 +257,43 @@ void StringName::cleanup() {
 	lock->lock();
 
 	int lost_strings = 0;
-	for (int i = 0; i < STRING_TABLE_LEN; i++) {
-
-		while (_table[i]) {
-
-			_Data *d = _table[i];
-			lost_strings++;
-			if (OS::get_singleton()->is_stdout_verbose()) {
-				if (d->cname) {
-					print_line("Orphan StringName: " + String(d->cname));
-				} else {
-					print_line("Orphan StringName: " + String(d->name));
+	_Table *table = _table;
+	for (uint32_t i = 0; i <= table->mask; i++) {
+
+		while (table->buckets[i]) {
+
+			_Data *d = table->buckets[i];
+			// SNAME() literals keep their reference until static destruction.
+			if (!d->is_static) {
+				lost_strings++;
+				if (OS::get_singleton()->is_stdout_verbose()) {
+					if (d->cname) {
+						print_line("Orphan StringName: " + String(d->cname));
+					} else {
+						print_line("Orphan StringName: " + String(d->name));
+					}
 				}
 			}
 
-			_table[i] = _table[i]->next;
+			table->buckets[i] = d->next[table->links];
 			memdelete(d);
 		}
 	}
 	if (lost_strings) {
 		print_verbose("StringName: " + itos(lost_strings) + " unclaimed string names at exit.");
 	}
+
+	// Nothing else can be reading at this point.
+	for (int i = 0; i < READER_SLOTS; i++) {
+		reader_slots[i].count = 0;
+	}
+	_reclaim();
+	memfree((void *)table->buckets);
+	memdelete(table);
+	_table = NULL;
+	entry_count = 0;
+	configured = false;
+
 	lock->unlock();
 
 	memdelete(lock);
@@ -100,19 +307,23 @@ void StringName::unref() {
 
 		lock->lock();
 
-		if (_data->prev) {
-			_data->prev->next = _data->next;
-		} else {
-			if (_table[_data->idx] != _data) {
-				ERR_PRINT("BUG!");
-			}
-			_table[_data->idx] = _data->next;
+		_Table *table = _table;
+		_Data *volatile *link = &table->buckets[_data->hash & table->mask];
+		while (*link && *link != _data) {
+			link = &(*link)->next[table->links];
 		}
 
-		if (_data->next) {
-			_data->next->prev = _data->prev;
+		if (*link) {
+			*link = _data->next[table->links];
+			entry_count--;
+		} else {
+			ERR_PRINT("BUG!");
 		}
-		memdelete(_data);
+
+		_data->retired_next = retired_data;
+		retired_data = _data;
+		_reclaim();
+
 		lock->unlock();
 	}
 
@@ -126,7 +337,7 @@ bool StringName::operator==(const String &p_name) const {
 		return (p_name.length() == 0);
 	}
 
-	return (_data->get_name() == p_name);
+	return _data->matches(p_name);
 }
 
 bool StringName::operator==(const char *p_name) const {
@@ -136,7 +347,7 @@ bool StringName::operator==(const char *p_name) const {
 		return (p_name[0] == 0);
 	}
 
-	return (_data->get_name() == p_name);
+	return _data->matches(p_name);
 }
 
 bool StringName::operator!=(const String &p_name) const {
@@ -184,47 +395,10 @@ StringName::StringName(const char *p_name) {
 	if (!p_name || p_name[0] == 0)
 		return; //empty, ignore
 
-	lock->lock();
-
-	uint32_t hash = String::hash(p_name);
-
-	uint32_t idx = hash & STRING_TABLE_MASK;
-
-	_data = _table[idx];
-
-	while (_data) {
-
-		// compare hash first
-		if (_data->hash == hash && _data->get_name() == p_name)
-			break;
-		_data = _data->next;
-	}
-
-	if (_data) {
-		if (_data->refcount.ref()) {
-			// exists
-			lock->unlock();
-			return;
-		} else {
-		}
-	}
-
-	_data = memnew(_Data);
-	_data->name = p_name;
-	_data->refcount.init();
-	_data->hash = hash;
-	_data->idx = idx;
-	_data->cname = NULL;
-	_data->next = _table[idx];
-	_data->prev = NULL;
-	if (_table[idx])
-		_table[idx]->prev = _data;
-	_table[idx] = _data;
-
-	lock->unlock();
+	_data = _intern(p_name, String::hash(p_name), NULL, false);
 }
 
-StringName::StringName(const StaticCString &p_static_string) {
+StringName::StringName(const StaticCString &p_static_string, bool p_static) {
 
 	_data = NULL;
 
@@ -232,44 +406,8 @@ StringName::StringName(const StaticCString &p_static_string) {
 
 	ERR_FAIL_COND(!p_static_string.ptr || !p_static_string.ptr[0]);
 
-	lock->lock();
-
-	uint32_t hash = String::hash(p_static_string.ptr);
-
-	uint32_t idx = hash & STRING_TABLE_MASK;
-
-	_data = _table[idx];
-
-	while (_data) {
-
-		// compare hash first
-		if (_data->hash == hash && _data->get_name() == p_static_string.ptr)
-			break;
-		_data = _data->next;
-	}
-
-	if (_data) {
-		if (_data->refcount.ref()) {
-			// exists
-			lock->unlock();
-			return;
-		} else {
-		}
-	}
-
-	_data = memnew(_Data);
-
-	_data->refcount.init();
-	_data->hash = hash;
-	_data->idx = idx;
-	_data->cname = p_static_string.ptr;
-	_data->next = _table[idx];
-	_data->prev = NULL;
-	if (_table[idx])
-		_table[idx]->prev = _data;
-	_table[idx] = _data;
-
-	lock->unlock();
+	uint32_t hash = p_static_string.hash ? p_static_string.hash : String::hash(p_static_string.ptr);
+	_data = _intern(p_static_string.ptr, hash, p_static_string.ptr, p_static);
 }
 
 StringName::StringName(const String &p_name) {
@@ -281,43 +419,19 @@ StringName::StringName(const String &p_name) {
 	if (p_name == String())
 		return;
 
-	lock->lock();
-
-	uint32_t hash = p_name.hash();
-
-	uint32_t idx = hash & STRING_TABLE_MASK;
-
-	_data = _table[idx];
+	_data = _intern(p_name, p_name.hash(), NULL, false);
+}
 
-	while (_data) {
+StringName::StringName(const String &p_name, uint32_t p_hash) {
 
-		if (_data->hash == hash && _data->get_name() == p_name)
-			break;
-		_data = _data->next;
-	}
+	_data = NULL;
 
-	if (_data) {
-		if (_data->refcount.ref()) {
-			// exists
-			lock->unlock();
-			return;
-		} else {
-		}
-	}
+	ERR_FAIL_COND(!configured);
 
-	_data = memnew(_Data);
-	_data->name = p_name;
-	_data->refcount.init();
-	_data->hash = hash;
-	_data->idx = idx;
-	_data->cname = NULL;
-	_data->next = _table[idx];
-	_data->prev = NULL;
-	if (_table[idx])
-		_table[idx]->prev = _data;
-	_table[idx] = _data;
+	if (p_name == String())
+		return;
 
-	lock->unlock();
+	_data = _intern(p_name, p_hash, NULL, false);
 }
 
 StringName StringName::search(const char *p_name) {
@@ -328,30 +442,7 @@ StringName StringName::search(const char *p_name) {
 	if (!p_name[0])
 		return StringName();
 
-	lock->lock();
-
-	uint32_t hash = String::hash(p_name);
-
-	uint32_t idx = hash & STRING_TABLE_MASK;
-
-	_Data *_data = _table[idx];
-
-	while (_data) {
-
-		// compare hash first
-		if (_data->hash == hash && _data->get_name() == p_name)
-			break;
-		_data = _data->next;
-	}
-
-	if (_data && _data->refcount.ref()) {
-		lock->unlock();
-
-		return StringName(_data);
-	}
-
-	lock->unlock();
-	return StringName(); //does not exist
+	return StringName(_find(p_name, String::hash(p_name)));
 }
 
 StringName StringName::search(const CharType *p_name) {
@@ -362,57 +453,13 @@ StringName StringName::search(const CharType *p_name) {
 	if (!p_name[0])
 		return StringName();
 
-	lock->lock();
-
-	uint32_t hash = String::hash(p_name);
-
-	uint32_t idx = hash & STRING_TABLE_MASK;
-
-	_Data *_data = _table[idx];
-
-	while (_data) {
-
-		// compare hash first
-		if (_data->hash == hash && _data->get_name() == p_name)
-			break;
-		_data = _data->next;
-	}
-
-	if (_data && _data->refcount.ref()) {
-		lock->unlock();
-		return StringName(_data);
-	}
-
-	lock->unlock();
-	return StringName(); //does not exist
+	return StringName(_find(p_name, String::hash(p_name)));
 }
 StringName StringName::search(const String &p_name) {
 
 	ERR_FAIL_COND_V(p_name == "", StringName());
 
-	lock->lock();
-
-	uint32_t hash = p_name.hash();
-
-	uint32_t idx = hash & STRING_TABLE_MASK;
-
-	_Data *_data = _table[idx];
-
-	while (_data) {
-
-		// compare hash first
-		if (_data->hash == hash && p_name == _data->get_name())
-			break;
-		_data = _data->next;
-	}
-
-	if (_data && _data->refcount.ref()) {
-		lock->unlock();
-		return StringName(_data);
-	}
-
-	lock->unlock();
-	return StringName(); //does not exist
+	return StringName(_find(p_name, p_name.hash()));
 }
 
 StringName::StringName() {
@@ -422,5 +469,8 @@ StringName::StringName() {
 
 StringName::~StringName() {
 
-	unref();
+	// SNAME() statics are destroyed after cleanup() already freed the table.
+	if (configured) {
+		unref();
+	}
 }
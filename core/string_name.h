@@ -41,16 +41,21 @@
 struct StaticCString {
 
 	const char *ptr;
-	static StaticCString create(const char *p_ptr);
+	uint32_t hash; // String::hash() of ptr, or 0 if it has to be computed.
+	static StaticCString create(const char *p_ptr, uint32_t p_hash = 0);
 };
 
+// Compile-time djb2, matches String::hash(const char *) so SNAME() literals never hash at runtime.
+constexpr uint32_t _sname_hash(const char *p_str, uint32_t p_hash = 5381) {
+	return *p_str ? _sname_hash(p_str + 1, ((p_hash << 5) + p_hash) + (uint32_t)*p_str) : p_hash;
+}
+
 class StringName {
 
 	enum {
 
-		STRING_TABLE_BITS = 12,
-		STRING_TABLE_LEN = 1 << STRING_TABLE_BITS,
-		STRING_TABLE_MASK = STRING_TABLE_LEN - 1
+		STRING_TABLE_MIN_BITS = 12,
+		READER_SLOTS = 16
 	};
 
 	struct _Data {
@@ -59,19 +64,46 @@ class StringName {
 		String name;
 
 		String get_name() const { return cname ? String(cname) : name; }
-		int idx;
 		uint32_t hash;
-		_Data *prev;
-		_Data *next;
+		bool is_static;
+		// Chain links, one set per table generation. A resize relinks every
+		// entry through the set the old table does not use, so readers still
+		// walking the old table are never redirected.
+		_Data *volatile next[2];
+		_Data *retired_next;
+
+		bool matches(const char *p_name) const;
+		bool matches(const CharType *p_name) const;
+		bool matches(const String &p_name) const;
+
 		_Data() {
 			cname = NULL;
-			next = prev = NULL;
-			idx = 0;
+			next[0] = next[1] = NULL;
+			retired_next = NULL;
 			hash = 0;
+			is_static = false;
 		}
 	};
 
-	static _Data *_table[STRING_TABLE_LEN];
+	struct _Table {
+		uint32_t mask;
+		uint32_t links; // Which _Data::next set chains this table.
+		_Data *volatile *buckets;
+	};
+
+	// Lookups don't lock; they only announce themselves in a per-thread
+	// reader slot. Unlinked entries and replaced tables are freed once every
+	// slot has been seen empty, so a concurrent reader never touches freed memory.
+	struct _ReaderSlot {
+		volatile uint32_t count;
+		uint8_t pad[64 - sizeof(uint32_t)];
+	};
+
+	static _Table *volatile _table;
+	static _Table *retired_table;
+	static _Data *retired_data;
+	static uint32_t entry_count;
+	static _ReaderSlot reader_slots[READER_SLOTS];
 
 	_Data *_data;
 
@@ -81,6 +113,15 @@ class StringName {
 		uint32_t hash;
 	};
 
+	static _ReaderSlot &_get_reader_slot();
+	template <class T>
+	static _Data *_find(const T &p_name, uint32_t p_hash);
+	template <class T>
+	static _Data *_intern(const T &p_name, uint32_t p_hash, const char *p_cname, bool p_static);
+	static _Table *_create_table(uint32_t p_bits, uint32_t p_links);
+	static void _grow();
+	static void _reclaim();
+
 	void unref();
 	friend void register_core_types();
 	friend void unregister_core_types();
@@ -162,11 +203,20 @@ public:
 	StringName(const char *p_name);
 	StringName(const StringName &p_name);
 	StringName(const String &p_name);
-	StringName(const StaticCString &p_static_string);
+	StringName(const String &p_name, uint32_t p_hash);
+	StringName(const StaticCString &p_static_string, bool p_static = false);
 	StringName();
 	~StringName();
 };
 
 StringName _scs_create(const char *p_chr);
 
+// Interns a string literal once and returns a reference to the cached
+// StringName, so hot paths can pass literals without a table lookup per call.
+#define SNAME(m_arg) ([]() -> const StringName & {                                  \
+	constexpr uint32_t sname_hash = _sname_hash(m_arg);                              \
+	static const StringName sname(StaticCString::create(m_arg, sname_hash), true); \
+	return sname;                                                                    \
+})()
+
 #endif // STRING_NAME_H
@@ -32,7 +32,9 @@
 
 #include "core/io/resource_loader.h"
 #include "core/os/os.h"
+#include "core/os/thread.h"
 #include "core/project_settings.h"
+#include "core/safe_refcount.h"
 
 // ISO 639-1 language codes, with the addition of glibc locales with their
 // regional identifiers. This list must match the language names (in English)
@@ -842,14 +844,24 @@ void Translation::set_locale(const String &p_locale) {
 		locale = univ_locale;
 	}
 
+	_messages_changed();
+
 	if (OS::get_singleton()->get_main_loop()) {
 		OS::get_singleton()->get_main_loop()->notification(MainLoop::NOTIFICATION_TRANSLATION_CHANGED);
 	}
 }
 
+void Translation::_messages_changed() {
+
+	if (TranslationServer::get_singleton()) {
+		TranslationServer::get_singleton()->translations_changed();
+	}
+}
+
 void Translation::add_message(const StringName &p_src_text, const StringName &p_xlated_text) {
 
 	translation_map[p_src_text] = p_xlated_text;
+	_messages_changed();
 }
 StringName Translation::get_message(const StringName &p_src_text) const {
 
@@ -863,6 +875,7 @@ StringName Translation::get_message(const StringName &p_src_text) const {
 void Translation::erase_message(const StringName &p_src_text) {
 
 	translation_map.erase(p_src_text);
+	_messages_changed();
 }
 
 void Translation::get_message_list(List<StringName> *r_messages) const {
@@ -950,6 +963,8 @@ void TranslationServer::set_locale(const String &p_locale) {
 		locale = univ_locale;
 	}
 
+	translations_changed();
+
 	if (OS::get_singleton()->get_main_loop()) {
 		OS::get_singleton()->get_main_loop()->notification(MainLoop::NOTIFICATION_TRANSLATION_CHANGED);
 	}
@@ -999,24 +1014,51 @@ Vector<String> TranslationServer::get_all_locale_names() {
 void TranslationServer::add_translation(const Ref<Translation> &p_translation) {
 
 	translations.insert(p_translation);
+	translations_changed();
 }
 void TranslationServer::remove_translation(const Ref<Translation> &p_translation) {
 
 	translations.erase(p_translation);
+	translations_changed();
 }
 
 void TranslationServer::clear() {
 
 	translations.clear();
+	translations_changed();
 };
 
-StringName TranslationServer::translate(const StringName &p_message) const {
+void TranslationServer::translations_changed() {
 
-	//translate using locale
+	atomic_increment(&translations_version);
+}
+
+StringName TranslationServer::translate(const StringName &p_message) const {
 
 	if (!enabled)
 		return p_message;
 
+	if (Thread::get_caller_id() != Thread::get_main_id())
+		return _translate(p_message);
+
+	if (translate_cache_version != translations_version || translate_cache.size() >= MAX_CACHED_MESSAGES) {
+		translate_cache.clear();
+		translate_cache_version = translations_version;
+	}
+
+	const StringName *cached = translate_cache.getptr(p_message);
+	if (cached)
+		return *cached;
+
+	StringName res = _translate(p_message);
+	translate_cache.set(p_message, res);
+	return res;
+}
+
+StringName TranslationServer::_translate(const StringName &p_message) const {
+
+	//translate using locale
+
 	StringName res;
 	bool near_match = false;
 	const CharType *lptr = &locale[0];
@@ -1121,6 +1163,7 @@ void TranslationServer::setup() {
 	else
 		set_locale(OS::get_singleton()->get_locale());
 	fallback = GLOBAL_DEF("locale/fallback", "en");
+	translations_changed();
 #ifdef TOOLS_ENABLED
 
 	{
@@ -1183,7 +1226,9 @@ void TranslationServer::load_translations() {
 
 TranslationServer::TranslationServer() :
 		locale("en"),
-		enabled(true) {
+		enabled(true),
+		translate_cache_version(0),
+		translations_version(1) {
 	singleton = this;
 
 	for (int i = 0; locale_list[i]; ++i) {
@@ -31,6 +31,7 @@
 #ifndef TRANSLATION_H
 #define TRANSLATION_H
 
+#include "core/hash_map.h"
 #include "core/resource.h"
 
 class Translation : public Resource {
@@ -50,6 +51,8 @@ class Translation : public Resource {
 protected:
 	static void _bind_methods();
 
+	void _messages_changed();
+
 public:
 	void set_locale(const String &p_locale);
 	_FORCE_INLINE_ String get_locale() const { return locale; }
@@ -78,8 +81,20 @@ class TranslationServer : public Object {
 
 	bool enabled;
 
+	// Results of translate() for the current locale, found through the precomputed
+	// StringName hash instead of searching every translation. Only the main thread,
+	// which does the UI translation, uses it.
+	enum {
+		MAX_CACHED_MESSAGES = 65536 // dynamic texts passed through tr() would grow it forever
+	};
+
+	mutable HashMap<StringName, StringName> translate_cache;
+	mutable uint32_t translate_cache_version;
+	volatile uint32_t translations_version;
+
 	static TranslationServer *singleton;
 	bool _load_translations(const String &p_from);
+	StringName _translate(const StringName &p_message) const;
 
 	static void _bind_methods();
 
@@ -99,6 +114,9 @@ public:
 
 	StringName translate(const StringName &p_message) const;
 
+	// Drops the cached translate() results, called whenever a translation changes.
+	void translations_changed();
+
 	static Vector<String> get_all_locales();
 	static Vector<String> get_all_locale_names();
 	static bool is_locale_valid(const String &p_locale);
@@ -58,6 +58,246 @@
 #define IS_DIGIT(m_d) ((m_d) >= '0' && (m_d) <= '9')
 #define IS_HEX_DIGIT(m_d) (((m_d) >= '0' && (m_d) <= '9') || ((m_d) >= 'a' && (m_d) <= 'f') || ((m_d) >= 'A' && (m_d) <= 'F'))
 
+// Vectorized helpers for the hot String paths (UTF-8 conversion, search and
+// ASCII case mapping). They work on 32-bit CharType only, platforms with a
+// 16-bit wchar_t keep the scalar loops.
+#if WCHAR_MAX > 0xFFFF && defined(__SSE2__)
+#define STRING_SIMD_SSE2
+#include <emmintrin.h>
+#elif WCHAR_MAX > 0xFFFF && defined(__aarch64__) && defined(__ARM_NEON)
+#define STRING_SIMD_NEON
+#include <arm_neon.h>
+#endif
+
+#if defined(STRING_SIMD_SSE2)
+
+typedef __m128i _Vec4;
+
+static _FORCE_INLINE_ _Vec4 _vload(const CharType *p_str) { return _mm_loadu_si128((const __m128i *)p_str); }
+static _FORCE_INLINE_ void _vstore(CharType *p_str, _Vec4 p_v) { _mm_storeu_si128((__m128i *)p_str, p_v); }
+static _FORCE_INLINE_ _Vec4 _vor(_Vec4 p_a, _Vec4 p_b) { return _mm_or_si128(p_a, p_b); }
+static _FORCE_INLINE_ bool _vis_ascii(_Vec4 p_v) { return _mm_movemask_epi8(_mm_cmpeq_epi32(_mm_and_si128(p_v, _mm_set1_epi32(~0x7F)), _mm_setzero_si128())) == 0xFFFF; }
+static _FORCE_INLINE_ _Vec4 _veq(_Vec4 p_v, CharType p_c) { return _mm_cmpeq_epi32(p_v, _mm_set1_epi32(p_c)); }
+// Only valid on ASCII lanes, the compares are signed.
+static _FORCE_INLINE_ _Vec4 _vin_range(_Vec4 p_v, int p_from, int p_to) { return _mm_and_si128(_mm_cmpgt_epi32(p_v, _mm_set1_epi32(p_from - 1)), _mm_cmplt_epi32(p_v, _mm_set1_epi32(p_to + 1))); }
+static _FORCE_INLINE_ _Vec4 _vadd_masked(_Vec4 p_v, _Vec4 p_mask, int p_delta) { return _mm_add_epi32(p_v, _mm_and_si128(p_mask, _mm_set1_epi32(p_delta))); }
+static _FORCE_INLINE_ int _vfirst(_Vec4 p_mask) {
+	int bits = _mm_movemask_epi8(p_mask);
+	return bits ? __builtin_ctz(bits) >> 2 : -1;
+}
+
+static _FORCE_INLINE_ void _narrow16(const CharType *p_src, uint8_t *p_dst) {
+	__m128i lo = _mm_packs_epi32(_vload(p_src), _vload(p_src + 4));
+	__m128i hi = _mm_packs_epi32(_vload(p_src + 8), _vload(p_src + 12));
+	_mm_storeu_si128((__m128i *)p_dst, _mm_packus_epi16(lo, hi));
+}
+
+static _FORCE_INLINE_ void _widen16(const uint8_t *p_src, CharType *p_dst) {
+	const __m128i zero = _mm_setzero_si128();
+	__m128i v = _mm_loadu_si128((const __m128i *)p_src);
+	__m128i lo = _mm_unpacklo_epi8(v, zero);
+	__m128i hi = _mm_unpackhi_epi8(v, zero);
+	_vstore(p_dst, _mm_unpacklo_epi16(lo, zero));
+	_vstore(p_dst + 4, _mm_unpackhi_epi16(lo, zero));
+	_vstore(p_dst + 8, _mm_unpacklo_epi16(hi, zero));
+	_vstore(p_dst + 12, _mm_unpackhi_epi16(hi, zero));
+}
+
+// True if all 16 bytes are in 1..0x7F.
+static _FORCE_INLINE_ bool _is_ascii16(const uint8_t *p_src) {
+	__m128i v = _mm_loadu_si128((const __m128i *)p_src);
+	return (_mm_movemask_epi8(v) | _mm_movemask_epi8(_mm_cmpeq_epi8(v, _mm_setzero_si128()))) == 0;
+}
+
+#elif defined(STRING_SIMD_NEON)
+
+typedef uint32x4_t _Vec4;
+
+static _FORCE_INLINE_ _Vec4 _vload(const CharType *p_str) { return vld1q_u32((const uint32_t *)p_str); }
+static _FORCE_INLINE_ void _vstore(CharType *p_str, _Vec4 p_v) { vst1q_u32((uint32_t *)p_str, p_v); }
+static _FORCE_INLINE_ _Vec4 _vor(_Vec4 p_a, _Vec4 p_b) { return vorrq_u32(p_a, p_b); }
+static _FORCE_INLINE_ bool _vis_ascii(_Vec4 p_v) { return vmaxvq_u32(p_v) <= 0x7F; }
+static _FORCE_INLINE_ _Vec4 _veq(_Vec4 p_v, CharType p_c) { return vceqq_u32(p_v, vdupq_n_u32(p_c)); }
+static _FORCE_INLINE_ _Vec4 _vin_range(_Vec4 p_v, int p_from, int p_to) { return vandq_u32(vcgeq_u32(p_v, vdupq_n_u32(p_from)), vcleq_u32(p_v, vdupq_n_u32(p_to))); }
+static _FORCE_INLINE_ _Vec4 _vadd_masked(_Vec4 p_v, _Vec4 p_mask, int p_delta) { return vaddq_u32(p_v, vandq_u32(p_mask, vdupq_n_u32((uint32_t)p_delta))); }
+static _FORCE_INLINE_ int _vfirst(_Vec4 p_mask) {
+	if (!vmaxvq_u32(p_mask)) {
+		return -1;
+	}
+	uint32_t lanes[4];
+	vst1q_u32(lanes, p_mask);
+	for (int i = 0; i < 3; i++) {
+		if (lanes[i]) {
+			return i;
+		}
+	}
+	return 3;
+}
+
+static _FORCE_INLINE_ void _narrow16(const CharType *p_src, uint8_t *p_dst) {
+	uint16x8_t lo = vcombine_u16(vmovn_u32(_vload(p_src)), vmovn_u32(_vload(p_src + 4)));
+	uint16x8_t hi = vcombine_u16(vmovn_u32(_vload(p_src + 8)), vmovn_u32(_vload(p_src + 12)));
+	vst1q_u8(p_dst, vcombine_u8(vmovn_u16(lo), vmovn_u16(hi)));
+}
+
+static _FORCE_INLINE_ void _widen16(const uint8_t *p_src, CharType *p_dst) {
+	uint8x16_t v = vld1q_u8(p_src);
+	uint16x8_t lo = vmovl_u8(vget_low_u8(v));
+	uint16x8_t hi = vmovl_u8(vget_high_u8(v));
+	_vstore(p_dst, vmovl_u16(vget_low_u16(lo)));
+	_vstore(p_dst + 4, vmovl_u16(vget_high_u16(lo)));
+	_vstore(p_dst + 8, vmovl_u16(vget_low_u16(hi)));
+	_vstore(p_dst + 12, vmovl_u16(vget_high_u16(hi)));
+}
+
+static _FORCE_INLINE_ bool _is_ascii16(const uint8_t *p_src) {
+	uint8x16_t v = vld1q_u8(p_src);
+	return vmaxvq_u8(v) <= 0x7F && vminvq_u8(v) != 0;
+}
+
+#endif
+
+// Length of the run of 7-bit characters at the start of p_str.
+static _FORCE_INLINE_ int _ascii_run(const CharType *p_str, int p_len) {
+
+	int i = 0;
+#if defined(STRING_SIMD_SSE2) || defined(STRING_SIMD_NEON)
+	for (; i + 8 <= p_len; i += 8) {
+		if (!_vis_ascii(_vor(_vload(p_str + i), _vload(p_str + i + 4)))) {
+			break;
+		}
+	}
+#endif
+	while (i < p_len && (uint32_t)p_str[i] <= 0x7F) {
+		i++;
+	}
+	return i;
+}
+
+// Length of the run of bytes in 1..0x7F at the start of p_str.
+static _FORCE_INLINE_ int _ascii_byte_run(const char *p_str, int p_len) {
+
+	const uint8_t *str = (const uint8_t *)p_str;
+	int i = 0;
+#if defined(STRING_SIMD_SSE2) || defined(STRING_SIMD_NEON)
+	while (i + 16 <= p_len && _is_ascii16(str + i)) {
+		i += 16;
+	}
+#endif
+	while (i < p_len && str[i] && str[i] <= 0x7F) {
+		i++;
+	}
+	return i;
+}
+
+// Copies 7-bit characters to bytes.
+static _FORCE_INLINE_ void _narrow_ascii(const CharType *p_src, uint8_t *p_dst, int p_len) {
+
+	int i = 0;
+#if defined(STRING_SIMD_SSE2) || defined(STRING_SIMD_NEON)
+	for (; i + 16 <= p_len; i += 16) {
+		_narrow16(p_src + i, p_dst + i);
+	}
+#endif
+	for (; i < p_len; i++) {
+		p_dst[i] = p_src[i];
+	}
+}
+
+// Copies 7-bit bytes to characters.
+static _FORCE_INLINE_ void _widen_ascii(const char *p_src, CharType *p_dst, int p_len) {
+
+	const uint8_t *src = (const uint8_t *)p_src;
+	int i = 0;
+#if defined(STRING_SIMD_SSE2) || defined(STRING_SIMD_NEON)
+	for (; i + 16 <= p_len; i += 16) {
+		_widen16(src + i, p_dst + i);
+	}
+#endif
+	for (; i < p_len; i++) {
+		p_dst[i] = src[i];
+	}
+}
+
+// Index of the first p_char in [p_from, p_to), or -1.
+static _FORCE_INLINE_ int _find_char(const CharType *p_str, int p_from, int p_to, CharType p_char) {
+
+	int i = p_from;
+#if defined(STRING_SIMD_SSE2) || defined(STRING_SIMD_NEON)
+	for (; i + 4 <= p_to; i += 4) {
+		int lane = _vfirst(_veq(_vload(p_str + i), p_char));
+		if (lane >= 0) {
+			return i + lane;
+		}
+	}
+#endif
+	for (; i < p_to; i++) {
+		if (p_str[i] == p_char) {
+			return i;
+		}
+	}
+	return -1;
+}
+
+// Index of the first character p_map would change, or p_len. ASCII blocks
+// are checked against the p_first..p_first + 25 letter range directly.
+static int _find_case_change(const CharType *p_str, int p_len, int p_first, int (*p_map)(int)) {
+
+	int i = 0;
+#if defined(STRING_SIMD_SSE2) || defined(STRING_SIMD_NEON)
+	for (; i + 4 <= p_len; i += 4) {
+		_Vec4 v = _vload(p_str + i);
+		if (!_vis_ascii(v) || _vfirst(_vin_range(v, p_first, p_first + 25)) >= 0) {
+			break;
+		}
+	}
+#endif
+	for (; i < p_len; i++) {
+		if (p_map(p_str[i]) != p_str[i]) {
+			return i;
+		}
+	}
+	return p_len;
+}
+
+// Applies p_map to every character, ASCII blocks just shift the letter range.
+static void _convert_case(CharType *p_str, int p_len, int p_first, int (*p_map)(int)) {
+
+	const int delta = p_first == 'A' ? 'a' - 'A' : 'A' - 'a';
+	int i = 0;
+#if defined(STRING_SIMD_SSE2) || defined(STRING_SIMD_NEON)
+	for (; i + 4 <= p_len; i += 4) {
+		_Vec4 v = _vload(p_str + i);
+		if (_vis_ascii(v)) {
+			_vstore(p_str + i, _vadd_masked(v, _vin_range(v, p_first, p_first + 25), delta));
+		} else {
+			for (int j = i; j < i + 4; j++) {
+				p_str[j] = p_map(p_str[j]);
+			}
+		}
+	}
+#endif
+	for (; i < p_len; i++) {
+		p_str[i] = p_map(p_str[i]);
+	}
+}
+
+// djb2 four characters at a time, h * 33^4 + c0 * 33^3 + c1 * 33^2 + c2 * 33 + c3
+// equals four steps of the per-character loop with a much shorter dependency chain.
+template <class T>
+static _FORCE_INLINE_ uint32_t _hash_djb2(const T *p_str, int p_len) {
+
+	uint32_t hashv = 5381;
+	int i = 0;
+	for (; i + 4 <= p_len; i += 4) {
+		hashv = hashv * 1185921 + (uint32_t)p_str[i] * 35937 + (uint32_t)p_str[i + 1] * 1089 + (uint32_t)p_str[i + 2] * 33 + (uint32_t)p_str[i + 3];
+	}
+	for (; i < p_len; i++) {
+		hashv = ((hashv << 5) + hashv) + (uint32_t)p_str[i]; /* hash * 33 + c */
+	}
+	return hashv;
+}
+
 const char CharString::_null = 0;
 const CharType String::_null = 0;
 
@@ -949,12 +1189,10 @@ String String::to_upper() const {
 
 	String upper = *this;
 
-	for (int i = 0; i < upper.size(); i++) {
-
-		const CharType s = upper[i];
-		const CharType t = _find_upper(s);
-		if (s != t) // avoid copy on write
-			upper[i] = t;
+	const int len = length();
+	const int from = _find_case_change(c_str(), len, 'a', _find_upper);
+	if (from < len) { // avoid copy on write
+		_convert_case(upper.ptrw() + from, len - from, 'a', _find_upper);
 	}
 
 	return upper;
@@ -964,12 +1202,10 @@ String String::to_lower() const {
 
 	String lower = *this;
 
-	for (int i = 0; i < lower.size(); i++) {
-
-		const CharType s = lower[i];
-		const CharType t = _find_lower(s);
-		if (s != t) // avoid copy on write
-			lower[i] = t;
+	const int len = length();
+	const int from = _find_case_change(c_str(), len, 'A', _find_lower);
+	if (from < len) { // avoid copy on write
+		_convert_case(lower.ptrw() + from, len - from, 'A', _find_lower);
 	}
 
 	return lower;
@@ -1362,20 +1598,25 @@ bool String::parse_utf8(const char *p_utf8, int p_len) {
 	if (!p_utf8)
 		return true;
 
+	if (p_len < 0) {
+		p_len = 0;
+		while (p_utf8[p_len])
+			p_len++;
+	}
+
 	String aux;
 
 	int cstr_size = 0;
 	int str_size = 0;
 
 	/* HANDLE BOM (Byte Order Mark) */
-	if (p_len < 0 || p_len >= 3) {
+	if (p_len >= 3) {
 
 		bool has_bom = uint8_t(p_utf8[0]) == 0xEF && uint8_t(p_utf8[1]) == 0xBB && uint8_t(p_utf8[2]) == 0xBF;
 		if (has_bom) {
 
 			//just skip it
-			if (p_len >= 0)
-				p_len -= 3;
+			p_len -= 3;
 			p_utf8 += 3;
 		}
 	}
@@ -1390,10 +1631,17 @@ bool String::parse_utf8(const char *p_utf8, int p_len) {
 
 				uint8_t c = *ptrtmp;
 
+				if ((c & 0x80) == 0) {
+					// Count the whole ASCII run at once.
+					int run = _ascii_byte_run(ptrtmp, ptrtmp_limit - ptrtmp);
+					str_size += run;
+					cstr_size += run;
+					ptrtmp += run;
+					continue;
+				}
+
 				/* Determine the number of characters in sequence */
-				if ((c & 0x80) == 0)
-					skip = 0;
-				else if ((c & 0xE0) == 0xC0)
+				if ((c & 0xE0) == 0xC0)
 					skip = 1;
 				else if ((c & 0xF0) == 0xE0)
 					skip = 2;
@@ -1444,10 +1692,17 @@ bool String::parse_utf8(const char *p_utf8, int p_len) {
 
 		int len = 0;
 
+		if ((*p_utf8 & 0x80) == 0) {
+			int run = _ascii_byte_run(p_utf8, cstr_size);
+			_widen_ascii(p_utf8, dst, run);
+			dst += run;
+			cstr_size -= run;
+			p_utf8 += run;
+			continue;
+		}
+
 		/* Determine the number of characters in sequence */
-		if ((*p_utf8 & 0x80) == 0)
-			len = 1;
-		else if ((*p_utf8 & 0xE0) == 0xC0)
+		if ((*p_utf8 & 0xE0) == 0xC0)
 			len = 2;
 		else if ((*p_utf8 & 0xF0) == 0xE0)
 			len = 3;
@@ -1522,9 +1777,11 @@ CharString String::utf8() const {
 	for (int i = 0; i < l; i++) {
 
 		uint32_t c = d[i];
-		if (c <= 0x7f) // 7 bits.
-			fl += 1;
-		else if (c <= 0x7ff) { // 11 bits
+		if (c <= 0x7f) { // 7 bits, take the whole run.
+			int run = _ascii_run(d + i, l - i);
+			fl += run;
+			i += run - 1;
+		} else if (c <= 0x7ff) { // 11 bits
 			fl += 2;
 		} else if (c <= 0xffff) { // 16 bits
 			fl += 3;
@@ -1552,9 +1809,12 @@ CharString String::utf8() const {
 
 		uint32_t c = d[i];
 
-		if (c <= 0x7f) // 7 bits.
-			APPEND_CHAR(c);
-		else if (c <= 0x7ff) { // 11 bits
+		if (c <= 0x7f) { // 7 bits.
+			int run = _ascii_run(d + i, l - i);
+			_narrow_ascii(d + i, cdst, run);
+			cdst += run;
+			i += run - 1;
+		} else if (c <= 0x7ff) { // 11 bits
 
 			APPEND_CHAR(uint32_t(0xc0 | ((c >> 6) & 0x1f))); // Top 5 bits.
 			APPEND_CHAR(uint32_t(0x80 | (c & 0x3f))); // Bottom 6 bits.
@@ -2138,20 +2398,12 @@ uint32_t String::hash(const char *p_cstr) {
 
 uint32_t String::hash(const char *p_cstr, int p_len) {
 
-	uint32_t hashv = 5381;
-	for (int i = 0; i < p_len; i++)
-		hashv = ((hashv << 5) + hashv) + p_cstr[i]; /* hash * 33 + c */
-
-	return hashv;
+	return _hash_djb2(p_cstr, p_len);
 }
 
 uint32_t String::hash(const CharType *p_cstr, int p_len) {
 
-	uint32_t hashv = 5381;
-	for (int i = 0; i < p_len; i++)
-		hashv = ((hashv << 5) + hashv) + p_cstr[i]; /* hash * 33 + c */
-
-	return hashv;
+	return _hash_djb2(p_cstr, p_len);
 }
 
 uint32_t String::hash(const CharType *p_cstr) {
@@ -2169,14 +2421,7 @@ uint32_t String::hash() const {
 
 	/* simple djb2 hashing */
 
-	const CharType *chr = c_str();
-	uint32_t hashv = 5381;
-	uint32_t c;
-
-	while ((c = *chr++))
-		hashv = ((hashv << 5) + hashv) + c; /* hash * 33 + c */
-
-	return hashv;
+	return _hash_djb2(c_str(), length());
 }
 
 uint64_t String::hash64() const {
@@ -2316,18 +2561,15 @@ int String::find(const String &p_str, int p_from) const {
 
 	for (int i = p_from; i <= (len - src_len); i++) {
 
-		bool found = true;
-		for (int j = 0; j < src_len; j++) {
-
-			int read_pos = i + j;
-
-			if (read_pos >= len) {
+		// Jump to the next occurrence of the first character.
+		i = _find_char(src, i, len - src_len + 1, str[0]);
+		if (i < 0)
+			break;
 
-				ERR_PRINT("read_pos>=len");
-				return -1;
-			};
+		bool found = true;
+		for (int j = 1; j < src_len; j++) {
 
-			if (src[read_pos] != str[j]) {
+			if (src[i + j] != str[j]) {
 				found = false;
 				break;
 			}
@@ -2356,41 +2598,27 @@ int String::find(const char *p_str, int p_from) const {
 	while (p_str[src_len] != '\0')
 		src_len++;
 
-	if (src_len == 1) {
-
-		const char needle = p_str[0];
-
-		for (int i = p_from; i < len; i++) {
-
-			if (src[i] == needle) {
-				return i;
-			}
-		}
-
-	} else {
-
-		for (int i = p_from; i <= (len - src_len); i++) {
-
-			bool found = true;
-			for (int j = 0; j < src_len; j++) {
+	if (src_len == 0)
+		return p_from <= len ? p_from : -1; // the empty string matches right away
 
-				int read_pos = i + j;
+	for (int i = p_from; i <= (len - src_len); i++) {
 
-				if (read_pos >= len) {
+		// Jump to the next occurrence of the first character.
+		i = _find_char(src, i, len - src_len + 1, p_str[0]);
+		if (i < 0)
+			break;
 
-					ERR_PRINT("read_pos>=len");
-					return -1;
-				};
+		bool found = true;
+		for (int j = 1; j < src_len; j++) {
 
-				if (src[read_pos] != p_str[j]) {
-					found = false;
-					break;
-				}
+			if (src[i + j] != p_str[j]) {
+				found = false;
+				break;
 			}
-
-			if (found)
-				return i;
 		}
+
+		if (found)
+			return i;
 	}
 
 	return -1;
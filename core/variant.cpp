@@ -39,6 +39,12 @@
 #include "scene/gui/control.h"
 #include "scene/main/node.h"
 
+#ifdef VARIANT_INLINE_TRANSFORMS
+#define _VARIANT_STORE(m_member, m_type, m_value) memnew_placement(_data._mem, m_type(m_value))
+#else
+#define _VARIANT_STORE(m_member, m_type, m_value) _data.m_member = memnew(m_type(m_value))
+#endif
+
 String Variant::get_type_name(Variant::Type p_type) {
 
 	switch (p_type) {
@@ -737,7 +743,7 @@ bool Variant::is_zero() const {
 		} break;
 		case TRANSFORM2D: {
 
-			return *_data._transform2d == Transform2D();
+			return *_get_transform2d() == Transform2D();
 
 		} break;
 		case VECTOR3: {
@@ -757,7 +763,7 @@ bool Variant::is_zero() const {
 		} break;*/
 		case AABB: {
 
-			return *_data._aabb == ::AABB();
+			return *_get_aabb() == ::AABB();
 		} break;
 		case QUAT: {
 
@@ -766,12 +772,12 @@ bool Variant::is_zero() const {
 		} break;
 		case BASIS: {
 
-			return *_data._basis == Basis();
+			return *_get_basis() == Basis();
 
 		} break;
 		case TRANSFORM: {
 
-			return *_data._transform == Transform();
+			return *_get_transform() == Transform();
 
 		} break;
 
@@ -930,6 +936,7 @@ void Variant::reference(const Variant &p_variant) {
 		case STRING: {
 
 			memnew_placement(_data._mem, String(*reinterpret_cast<const String *>(p_variant._data._mem)));
+			_string_hash() = p_variant._string_hash();
 		} break;
 
 		// math types
@@ -943,7 +950,7 @@ void Variant::reference(const Variant &p_variant) {
 		} break;
 		case TRANSFORM2D: {
 
-			_data._transform2d = memnew(Transform2D(*p_variant._data._transform2d));
+			_VARIANT_STORE(_transform2d, Transform2D, *p_variant._get_transform2d());
 		} break;
 		case VECTOR3: {
 
@@ -956,7 +963,7 @@ void Variant::reference(const Variant &p_variant) {
 
 		case AABB: {
 
-			_data._aabb = memnew(::AABB(*p_variant._data._aabb));
+			_VARIANT_STORE(_aabb, ::AABB, *p_variant._get_aabb());
 		} break;
 		case QUAT: {
 
@@ -965,12 +972,12 @@ void Variant::reference(const Variant &p_variant) {
 		} break;
 		case BASIS: {
 
-			_data._basis = memnew(Basis(*p_variant._data._basis));
+			_VARIANT_STORE(_basis, Basis, *p_variant._get_basis());
 
 		} break;
 		case TRANSFORM: {
 
-			_data._transform = memnew(Transform(*p_variant._data._transform));
+			_VARIANT_STORE(_transform, Transform, *p_variant._get_transform());
 		} break;
 
 		// misc types
@@ -1075,6 +1082,7 @@ void Variant::clear() {
 		VECTOR2,
 		RECT2
 	*/
+#ifndef VARIANT_INLINE_TRANSFORMS
 		case TRANSFORM2D: {
 
 			memdelete(_data._transform2d);
@@ -1091,6 +1099,7 @@ void Variant::clear() {
 
 			memdelete(_data._transform);
 		} break;
+#endif
 
 		// misc types
 		case NODE_PATH: {
@@ -1392,6 +1401,9 @@ Variant::operator StringName() const {
 	if (type == NODE_PATH) {
 		return reinterpret_cast<const NodePath *>(_data._mem)->get_sname();
 	}
+	if (type == STRING) {
+		return StringName(*reinterpret_cast<const String *>(_data._mem), _get_string_hash());
+	}
 	return StringName(operator String());
 }
 
@@ -1623,7 +1635,7 @@ Variant::operator Plane() const {
 Variant::operator ::AABB() const {
 
 	if (type == AABB)
-		return *_data._aabb;
+		return *_get_aabb();
 	else
 		return ::AABB();
 }
@@ -1631,13 +1643,13 @@ Variant::operator ::AABB() const {
 Variant::operator Basis() const {
 
 	if (type == BASIS)
-		return *_data._basis;
+		return *_get_basis();
 	else if (type == QUAT)
 		return *reinterpret_cast<const Quat *>(_data._mem);
 	else if (type == VECTOR3) {
 		return Basis(*reinterpret_cast<const Vector3 *>(_data._mem));
 	} else if (type == TRANSFORM) // unexposed in Variant::can_convert?
-		return _data._transform->basis;
+		return _get_transform()->basis;
 	else
 		return Basis();
 }
@@ -1647,9 +1659,9 @@ Variant::operator Quat() const {
 	if (type == QUAT)
 		return *reinterpret_cast<const Quat *>(_data._mem);
 	else if (type == BASIS)
-		return *_data._basis;
+		return *_get_basis();
 	else if (type == TRANSFORM)
-		return _data._transform->basis;
+		return _get_transform()->basis;
 	else
 		return Quat();
 }
@@ -1657,13 +1669,13 @@ Variant::operator Quat() const {
 Variant::operator Transform() const {
 
 	if (type == TRANSFORM)
-		return *_data._transform;
+		return *_get_transform();
 	else if (type == BASIS)
-		return Transform(*_data._basis, Vector3());
+		return Transform(*_get_basis(), Vector3());
 	else if (type == QUAT)
 		return Transform(Basis(*reinterpret_cast<const Quat *>(_data._mem)), Vector3());
 	else if (type == TRANSFORM2D) {
-		const Transform2D &t = *_data._transform2d;
+		const Transform2D &t = *_get_transform2d();
 		Transform m;
 		m.basis.elements[0][0] = t.elements[0][0];
 		m.basis.elements[1][0] = t.elements[0][1];
@@ -1679,9 +1691,9 @@ Variant::operator Transform() const {
 Variant::operator Transform2D() const {
 
 	if (type == TRANSFORM2D) {
-		return *_data._transform2d;
+		return *_get_transform2d();
 	} else if (type == TRANSFORM) {
-		const Transform &t = *_data._transform;
+		const Transform &t = *_get_transform();
 		Transform2D m;
 		m.elements[0][0] = t.basis.elements[0][0];
 		m.elements[0][1] = t.basis.elements[1][0];
@@ -2185,23 +2197,27 @@ Variant::Variant(const StringName &p_string) {
 
 	type = STRING;
 	memnew_placement(_data._mem, String(p_string.operator String()));
+	_string_hash() = p_string.hash();
 }
 Variant::Variant(const String &p_string) {
 
 	type = STRING;
 	memnew_placement(_data._mem, String(p_string));
+	_string_hash() = 0;
 }
 
 Variant::Variant(const char *const p_cstring) {
 
 	type = STRING;
 	memnew_placement(_data._mem, String((const char *)p_cstring));
+	_string_hash() = 0;
 }
 
 Variant::Variant(const CharType *p_wstring) {
 
 	type = STRING;
 	memnew_placement(_data._mem, String(p_wstring));
+	_string_hash() = 0;
 }
 Variant::Variant(const Vector3 &p_vector3) {
 
@@ -2227,13 +2243,13 @@ Variant::Variant(const Plane &p_plane) {
 Variant::Variant(const ::AABB &p_aabb) {
 
 	type = AABB;
-	_data._aabb = memnew(::AABB(p_aabb));
+	_VARIANT_STORE(_aabb, ::AABB, p_aabb);
 }
 
 Variant::Variant(const Basis &p_matrix) {
 
 	type = BASIS;
-	_data._basis = memnew(Basis(p_matrix));
+	_VARIANT_STORE(_basis, Basis, p_matrix);
 }
 
 Variant::Variant(const Quat &p_quat) {
@@ -2244,13 +2260,13 @@ Variant::Variant(const Quat &p_quat) {
 Variant::Variant(const Transform &p_transform) {
 
 	type = TRANSFORM;
-	_data._transform = memnew(Transform(p_transform));
+	_VARIANT_STORE(_transform, Transform, p_transform);
 }
 
 Variant::Variant(const Transform2D &p_transform) {
 
 	type = TRANSFORM2D;
-	_data._transform2d = memnew(Transform2D(p_transform));
+	_VARIANT_STORE(_transform2d, Transform2D, p_transform);
 }
 Variant::Variant(const Color &p_color) {
 
@@ -2546,6 +2562,7 @@ void Variant::operator=(const Variant &p_variant) {
 		case STRING: {
 
 			*reinterpret_cast<String *>(_data._mem) = *reinterpret_cast<const String *>(p_variant._data._mem);
+			_string_hash() = p_variant._string_hash();
 		} break;
 
 		// math types
@@ -2559,7 +2576,7 @@ void Variant::operator=(const Variant &p_variant) {
 		} break;
 		case TRANSFORM2D: {
 
-			*_data._transform2d = *(p_variant._data._transform2d);
+			*_get_transform2d() = *(p_variant._get_transform2d());
 		} break;
 		case VECTOR3: {
 
@@ -2572,7 +2589,7 @@ void Variant::operator=(const Variant &p_variant) {
 
 		case AABB: {
 
-			*_data._aabb = *(p_variant._data._aabb);
+			*_get_aabb() = *(p_variant._get_aabb());
 		} break;
 		case QUAT: {
 
@@ -2580,11 +2597,11 @@ void Variant::operator=(const Variant &p_variant) {
 		} break;
 		case BASIS: {
 
-			*_data._basis = *(p_variant._data._basis);
+			*_get_basis() = *(p_variant._get_basis());
 		} break;
 		case TRANSFORM: {
 
-			*_data._transform = *(p_variant._data._transform);
+			*_get_transform() = *(p_variant._get_transform());
 		} break;
 
 		// misc types
@@ -2650,6 +2667,7 @@ Variant::Variant(const IP_Address &p_address) {
 
 	type = STRING;
 	memnew_placement(_data._mem, String(p_address));
+	_string_hash() = 0;
 }
 
 Variant::Variant(const Variant &p_variant) {
@@ -2664,6 +2682,15 @@ Variant::~Variant() {
 	clear();
 }*/
 
+uint32_t Variant::_get_string_hash() const {
+
+	uint32_t &hash = _string_hash();
+	if (!hash) {
+		hash = reinterpret_cast<const String *>(_data._mem)->hash();
+	}
+	return hash;
+}
+
 uint32_t Variant::hash() const {
 
 	switch (type) {
@@ -2685,7 +2712,7 @@ uint32_t Variant::hash() const {
 		} break;
 		case STRING: {
 
-			return reinterpret_cast<const String *>(_data._mem)->hash();
+			return _get_string_hash();
 		} break;
 
 		// math types
@@ -2707,7 +2734,7 @@ uint32_t Variant::hash() const {
 			for (int i = 0; i < 3; i++) {
 
 				for (int j = 0; j < 2; j++) {
-					hash = hash_djb2_one_float(_data._transform2d->elements[i][j], hash);
+					hash = hash_djb2_one_float(_get_transform2d()->elements[i][j], hash);
 				}
 			}
 
@@ -2737,8 +2764,8 @@ uint32_t Variant::hash() const {
 			uint32_t hash = 5831;
 			for (int i = 0; i < 3; i++) {
 
-				hash = hash_djb2_one_float(_data._aabb->position[i], hash);
-				hash = hash_djb2_one_float(_data._aabb->size[i], hash);
+				hash = hash_djb2_one_float(_get_aabb()->position[i], hash);
+				hash = hash_djb2_one_float(_get_aabb()->size[i], hash);
 			}
 
 			return hash;
@@ -2758,7 +2785,7 @@ uint32_t Variant::hash() const {
 			for (int i = 0; i < 3; i++) {
 
 				for (int j = 0; j < 3; j++) {
-					hash = hash_djb2_one_float(_data._basis->elements[i][j], hash);
+					hash = hash_djb2_one_float(_get_basis()->elements[i][j], hash);
 				}
 			}
 
@@ -2771,9 +2798,9 @@ uint32_t Variant::hash() const {
 			for (int i = 0; i < 3; i++) {
 
 				for (int j = 0; j < 3; j++) {
-					hash = hash_djb2_one_float(_data._transform->basis.elements[i][j], hash);
+					hash = hash_djb2_one_float(_get_transform()->basis.elements[i][j], hash);
 				}
-				hash = hash_djb2_one_float(_data._transform->origin[i], hash);
+				hash = hash_djb2_one_float(_get_transform()->origin[i], hash);
 			}
 
 			return hash;
@@ -2991,8 +3018,8 @@ bool Variant::hash_compare(const Variant &p_variant) const {
 		} break;
 
 		case TRANSFORM2D: {
-			Transform2D *l = _data._transform2d;
-			Transform2D *r = p_variant._data._transform2d;
+			Transform2D *l = _get_transform2d();
+			Transform2D *r = p_variant._get_transform2d();
 
 			for (int i = 0; i < 3; i++) {
 				if (!(hash_compare_vector2(l->elements[i], r->elements[i])))
@@ -3018,8 +3045,8 @@ bool Variant::hash_compare(const Variant &p_variant) const {
 		} break;
 
 		case AABB: {
-			const ::AABB *l = _data._aabb;
-			const ::AABB *r = p_variant._data._aabb;
+			const ::AABB *l = _get_aabb();
+			const ::AABB *r = p_variant._get_aabb();
 
 			return (hash_compare_vector3(l->position, r->position) &&
 					(hash_compare_vector3(l->size, r->size)));
@@ -3034,8 +3061,8 @@ bool Variant::hash_compare(const Variant &p_variant) const {
 		} break;
 
 		case BASIS: {
-			const Basis *l = _data._basis;
-			const Basis *r = p_variant._data._basis;
+			const Basis *l = _get_basis();
+			const Basis *r = p_variant._get_basis();
 
 			for (int i = 0; i < 3; i++) {
 				if (!(hash_compare_vector3(l->elements[i], r->elements[i])))
@@ -3046,8 +3073,8 @@ bool Variant::hash_compare(const Variant &p_variant) const {
 		} break;
 
 		case TRANSFORM: {
-			const Transform *l = _data._transform;
-			const Transform *r = p_variant._data._transform;
+			const Transform *l = _get_transform();
+			const Transform *r = p_variant._get_transform();
 
 			for (int i = 0; i < 3; i++) {
 				if (!(hash_compare_vector3(l->basis.elements[i], r->basis.elements[i])))
@@ -124,8 +124,10 @@ public:
 
 private:
 	friend struct _VariantCall;
+	friend class VariantInternal;
 	// Variant takes 20 bytes when real_t is float, and 36 if double
-	// it only allocates extra memory for aabb/matrix.
+	// it only allocates extra memory for aabb/matrix, unless built with
+	// VARIANT_INLINE_TRANSFORMS, which grows it to hold a Transform inline.
 
 	Type type;
 
@@ -142,14 +144,37 @@ private:
 		bool _bool;
 		int64_t _int;
 		double _real;
+#ifndef VARIANT_INLINE_TRANSFORMS
 		Transform2D *_transform2d;
 		::AABB *_aabb;
 		Basis *_basis;
 		Transform *_transform;
+#endif
 		void *_ptr; //generic pointer
+#ifdef VARIANT_INLINE_TRANSFORMS
+		uint8_t _mem[sizeof(ObjData) > sizeof(Transform) ? sizeof(ObjData) : sizeof(Transform)];
+#else
 		uint8_t _mem[sizeof(ObjData) > (sizeof(real_t) * 4) ? sizeof(ObjData) : (sizeof(real_t) * 4)];
+#endif
 	} _data GCC_ALIGNED_8;
 
+	// Transform2D, AABB, Basis and Transform live behind a pointer or inline
+	// in _mem depending on the build; always reach them through these.
+#ifdef VARIANT_INLINE_TRANSFORMS
+	_FORCE_INLINE_ void *_get_ptr_storage() const { return const_cast<uint8_t *>(_data._mem); }
+#else
+	_FORCE_INLINE_ void *_get_ptr_storage() const { return _data._ptr; }
+#endif
+	_FORCE_INLINE_ Transform2D *_get_transform2d() const { return reinterpret_cast<Transform2D *>(_get_ptr_storage()); }
+	_FORCE_INLINE_ ::AABB *_get_aabb() const { return reinterpret_cast< ::AABB *>(_get_ptr_storage()); }
+	_FORCE_INLINE_ Basis *_get_basis() const { return reinterpret_cast<Basis *>(_get_ptr_storage()); }
+	_FORCE_INLINE_ Transform *_get_transform() const { return reinterpret_cast<Transform *>(_get_ptr_storage()); }
+
+	// STRING keeps its String::hash() in the unused tail of _mem, 0 until computed,
+	// so hashing and StringName conversion don't rescan the string.
+	_FORCE_INLINE_ uint32_t &_string_hash() const { return *reinterpret_cast<uint32_t *>(const_cast<uint8_t *>(&_data._mem[sizeof(String)])); }
+	uint32_t _get_string_hash() const;
+
 	void reference(const Variant &p_variant);
 	void clear();
 
@@ -344,6 +369,14 @@ public:
 		return res;
 	}
 
+	// Evaluators for operand type pairs where the operator can't fail, so
+	// callers that have the types at hand skip the checks in evaluate().
+	// NULL when a pair is not covered. The second type is ignored for unary
+	// operators.
+	typedef void (*ValidatedOperatorEvaluator)(const Variant *p_a, const Variant *p_b, Variant *r_ret);
+	static ValidatedOperatorEvaluator get_validated_operator_evaluator(Operator p_op, Type p_a, Type p_b);
+	static void register_validated_operators();
+
 	void zero();
 	Variant duplicate(bool deep = false) const;
 	static void blend(const Variant &a, const Variant &b, float c, Variant &r_dst);
@@ -270,7 +270,13 @@ struct _VariantCall {
 	VCALL_LOCALMEM0R(String, get_basename);
 	VCALL_LOCALMEM1R(String, plus_file);
 	VCALL_LOCALMEM1R(String, ord_at);
-	VCALL_LOCALMEM2(String, erase);
+
+	static void _call_String_erase(Variant &r_ret, Variant &p_self, const Variant **p_args) {
+
+		reinterpret_cast<String *>(p_self._data._mem)->erase(*p_args[0], *p_args[1]);
+		p_self._string_hash() = 0; // Modified in place.
+	}
+
 	VCALL_LOCALMEM0R(String, hash);
 	VCALL_LOCALMEM0R(String, md5_text);
 	VCALL_LOCALMEM0R(String, sha256_text);
@@ -518,6 +524,9 @@ struct _VariantCall {
 	VCALL_LOCALMEM0(Array, invert);
 	VCALL_LOCALMEM0R(Array, max);
 	VCALL_LOCALMEM0R(Array, min);
+	VCALL_LOCALMEM0R(Array, is_typed);
+	VCALL_LOCALMEM0R(Array, get_typed_builtin);
+	VCALL_LOCALMEM0R(Array, get_typed_class_name);
 
 	static void _call_PoolByteArray_get_string_from_ascii(Variant &r_ret, Variant &p_self, const Variant **p_args) {
 
@@ -664,29 +673,29 @@ struct _VariantCall {
 	VCALL_LOCALMEM0(PoolColorArray, invert);
 
 #define VCALL_PTR0(m_type, m_method) \
-	static void _call_##m_type##_##m_method(Variant &r_ret, Variant &p_self, const Variant **p_args) { reinterpret_cast<m_type *>(p_self._data._ptr)->m_method(); }
+	static void _call_##m_type##_##m_method(Variant &r_ret, Variant &p_self, const Variant **p_args) { reinterpret_cast<m_type *>(p_self._get_ptr_storage())->m_method(); }
 #define VCALL_PTR0R(m_type, m_method) \
-	static void _call_##m_type##_##m_method(Variant &r_ret, Variant &p_self, const Variant **p_args) { r_ret = reinterpret_cast<m_type *>(p_self._data._ptr)->m_method(); }
+	static void _call_##m_type##_##m_method(Variant &r_ret, Variant &p_self, const Variant **p_args) { r_ret = reinterpret_cast<m_type *>(p_self._get_ptr_storage())->m_method(); }
 #define VCALL_PTR1(m_type, m_method) \
-	static void _call_##m_type##_##m_method(Variant &r_ret, Variant &p_self, const Variant **p_args) { reinterpret_cast<m_type *>(p_self._data._ptr)->m_method(*p_args[0]); }
+	static void _call_##m_type##_##m_method(Variant &r_ret, Variant &p_self, const Variant **p_args) { reinterpret_cast<m_type *>(p_self._get_ptr_storage())->m_method(*p_args[0]); }
 #define VCALL_PTR1R(m_type, m_method) \
-	static void _call_##m_type##_##m_method(Variant &r_ret, Variant &p_self, const Variant **p_args) { r_ret = reinterpret_cast<m_type *>(p_self._data._ptr)->m_method(*p_args[0]); }
+	static void _call_##m_type##_##m_method(Variant &r_ret, Variant &p_self, const Variant **p_args) { r_ret = reinterpret_cast<m_type *>(p_self._get_ptr_storage())->m_method(*p_args[0]); }
 #define VCALL_PTR2(m_type, m_method) \
-	static void _call_##m_type##_##m_method(Variant &r_ret, Variant &p_self, const Variant **p_args) { reinterpret_cast<m_type *>(p_self._data._ptr)->m_method(*p_args[0], *p_args[1]); }
+	static void _call_##m_type##_##m_method(Variant &r_ret, Variant &p_self, const Variant **p_args) { reinterpret_cast<m_type *>(p_self._get_ptr_storage())->m_method(*p_args[0], *p_args[1]); }
 #define VCALL_PTR2R(m_type, m_method) \
-	static void _call_##m_type##_##m_method(Variant &r_ret, Variant &p_self, const Variant **p_args) { r_ret = reinterpret_cast<m_type *>(p_self._data._ptr)->m_method(*p_args[0], *p_args[1]); }
+	static void _call_##m_type##_##m_method(Variant &r_ret, Variant &p_self, const Variant **p_args) { r_ret = reinterpret_cast<m_type *>(p_self._get_ptr_storage())->m_method(*p_args[0], *p_args[1]); }
 #define VCALL_PTR3(m_type, m_method) \
-	static void _call_##m_type##_##m_method(Variant &r_ret, Variant &p_self, const Variant **p_args) { reinterpret_cast<m_type *>(p_self._data._ptr)->m_method(*p_args[0], *p_args[1], *p_args[2]); }
+	static void _call_##m_type##_##m_method(Variant &r_ret, Variant &p_self, const Variant **p_args) { reinterpret_cast<m_type *>(p_self._get_ptr_storage())->m_method(*p_args[0], *p_args[1], *p_args[2]); }
 #define VCALL_PTR3R(m_type, m_method) \
-	static void _call_##m_type##_##m_method(Variant &r_ret, Variant &p_self, const Variant **p_args) { r_ret = reinterpret_cast<m_type *>(p_self._data._ptr)->m_method(*p_args[0], *p_args[1], *p_args[2]); }
+	static void _call_##m_type##_##m_method(Variant &r_ret, Variant &p_self, const Variant **p_args) { r_ret = reinterpret_cast<m_type *>(p_self._get_ptr_storage())->m_method(*p_args[0], *p_args[1], *p_args[2]); }
 #define VCALL_PTR4(m_type, m_method) \
-	static void _call_##m_type##_##m_method(Variant &r_ret, Variant &p_self, const Variant **p_args) { reinterpret_cast<m_type *>(p_self._data._ptr)->m_method(*p_args[0], *p_args[1], *p_args[2], *p_args[3]); }
+	static void _call_##m_type##_##m_method(Variant &r_ret, Variant &p_self, const Variant **p_args) { reinterpret_cast<m_type *>(p_self._get_ptr_storage())->m_method(*p_args[0], *p_args[1], *p_args[2], *p_args[3]); }
 #define VCALL_PTR4R(m_type, m_method) \
-	static void _call_##m_type##_##m_method(Variant &r_ret, Variant &p_self, const Variant **p_args) { r_ret = reinterpret_cast<m_type *>(p_self._data._ptr)->m_method(*p_args[0], *p_args[1], *p_args[2], *p_args[3]); }
+	static void _call_##m_type##_##m_method(Variant &r_ret, Variant &p_self, const Variant **p_args) { r_ret = reinterpret_cast<m_type *>(p_self._get_ptr_storage())->m_method(*p_args[0], *p_args[1], *p_args[2], *p_args[3]); }
 #define VCALL_PTR5(m_type, m_method) \
-	static void _call_##m_type##_##m_method(Variant &r_ret, Variant &p_self, const Variant **p_args) { reinterpret_cast<m_type *>(p_self._data._ptr)->m_method(*p_args[0], *p_args[1], *p_args[2], *p_args[3], *p_args[4]); }
+	static void _call_##m_type##_##m_method(Variant &r_ret, Variant &p_self, const Variant **p_args) { reinterpret_cast<m_type *>(p_self._get_ptr_storage())->m_method(*p_args[0], *p_args[1], *p_args[2], *p_args[3], *p_args[4]); }
 #define VCALL_PTR5R(m_type, m_method) \
-	static void _call_##m_type##_##m_method(Variant &r_ret, Variant &p_self, const Variant **p_args) { r_ret = reinterpret_cast<m_type *>(p_self._data._ptr)->m_method(*p_args[0], *p_args[1], *p_args[2], *p_args[3], *p_args[4]); }
+	static void _call_##m_type##_##m_method(Variant &r_ret, Variant &p_self, const Variant **p_args) { r_ret = reinterpret_cast<m_type *>(p_self._get_ptr_storage())->m_method(*p_args[0], *p_args[1], *p_args[2], *p_args[3], *p_args[4]); }
 
 	VCALL_PTR0R(AABB, get_area);
 	VCALL_PTR0R(AABB, has_no_area);
@@ -724,8 +733,8 @@ struct _VariantCall {
 
 		switch (p_args[0]->type) {
 
-			case Variant::VECTOR2: r_ret = reinterpret_cast<Transform2D *>(p_self._data._ptr)->xform(p_args[0]->operator Vector2()); return;
-			case Variant::RECT2: r_ret = reinterpret_cast<Transform2D *>(p_self._data._ptr)->xform(p_args[0]->operator Rect2()); return;
+			case Variant::VECTOR2: r_ret = p_self._get_transform2d()->xform(p_args[0]->operator Vector2()); return;
+			case Variant::RECT2: r_ret = p_self._get_transform2d()->xform(p_args[0]->operator Rect2()); return;
 			default: r_ret = Variant();
 		}
 	}
@@ -734,8 +743,8 @@ struct _VariantCall {
 
 		switch (p_args[0]->type) {
 
-			case Variant::VECTOR2: r_ret = reinterpret_cast<Transform2D *>(p_self._data._ptr)->xform_inv(p_args[0]->operator Vector2()); return;
-			case Variant::RECT2: r_ret = reinterpret_cast<Transform2D *>(p_self._data._ptr)->xform_inv(p_args[0]->operator Rect2()); return;
+			case Variant::VECTOR2: r_ret = p_self._get_transform2d()->xform_inv(p_args[0]->operator Vector2()); return;
+			case Variant::RECT2: r_ret = p_self._get_transform2d()->xform_inv(p_args[0]->operator Rect2()); return;
 			default: r_ret = Variant();
 		}
 	}
@@ -744,7 +753,7 @@ struct _VariantCall {
 
 		switch (p_args[0]->type) {
 
-			case Variant::VECTOR2: r_ret = reinterpret_cast<Transform2D *>(p_self._data._ptr)->basis_xform(p_args[0]->operator Vector2()); return;
+			case Variant::VECTOR2: r_ret = p_self._get_transform2d()->basis_xform(p_args[0]->operator Vector2()); return;
 			default: r_ret = Variant();
 		}
 	}
@@ -753,7 +762,7 @@ struct _VariantCall {
 
 		switch (p_args[0]->type) {
 
-			case Variant::VECTOR2: r_ret = reinterpret_cast<Transform2D *>(p_self._data._ptr)->basis_xform_inv(p_args[0]->operator Vector2()); return;
+			case Variant::VECTOR2: r_ret = p_self._get_transform2d()->basis_xform_inv(p_args[0]->operator Vector2()); return;
 			default: r_ret = Variant();
 		}
 	}
@@ -789,9 +798,9 @@ struct _VariantCall {
 
 		switch (p_args[0]->type) {
 
-			case Variant::VECTOR3: r_ret = reinterpret_cast<Transform *>(p_self._data._ptr)->xform(p_args[0]->operator Vector3()); return;
-			case Variant::PLANE: r_ret = reinterpret_cast<Transform *>(p_self._data._ptr)->xform(p_args[0]->operator Plane()); return;
-			case Variant::AABB: r_ret = reinterpret_cast<Transform *>(p_self._data._ptr)->xform(p_args[0]->operator ::AABB()); return;
+			case Variant::VECTOR3: r_ret = p_self._get_transform()->xform(p_args[0]->operator Vector3()); return;
+			case Variant::PLANE: r_ret = p_self._get_transform()->xform(p_args[0]->operator Plane()); return;
+			case Variant::AABB: r_ret = p_self._get_transform()->xform(p_args[0]->operator ::AABB()); return;
 			default: r_ret = Variant();
 		}
 	}
@@ -800,9 +809,9 @@ struct _VariantCall {
 
 		switch (p_args[0]->type) {
 
-			case Variant::VECTOR3: r_ret = reinterpret_cast<Transform *>(p_self._data._ptr)->xform_inv(p_args[0]->operator Vector3()); return;
-			case Variant::PLANE: r_ret = reinterpret_cast<Transform *>(p_self._data._ptr)->xform_inv(p_args[0]->operator Plane()); return;
-			case Variant::AABB: r_ret = reinterpret_cast<Transform *>(p_self._data._ptr)->xform_inv(p_args[0]->operator ::AABB()); return;
+			case Variant::VECTOR3: r_ret = p_self._get_transform()->xform_inv(p_args[0]->operator Vector3()); return;
+			case Variant::PLANE: r_ret = p_self._get_transform()->xform_inv(p_args[0]->operator Plane()); return;
+			case Variant::AABB: r_ret = p_self._get_transform()->xform_inv(p_args[0]->operator ::AABB()); return;
 			default: r_ret = Variant();
 		}
 	}
@@ -1424,6 +1433,8 @@ Variant Variant::get_constant_value(Variant::Type p_type, const StringName &p_va
 
 void register_variant_methods() {
 
+	Variant::register_validated_operators();
+
 	_VariantCall::type_funcs = memnew_arr(_VariantCall::TypeFunc, Variant::VARIANT_MAX);
 
 	_VariantCall::construct_funcs = memnew_arr(_VariantCall::ConstructFunc, Variant::VARIANT_MAX);
@@ -1713,6 +1724,9 @@ void register_variant_methods() {
 	ADDFUNC1R(ARRAY, ARRAY, Array, duplicate, BOOL, "deep", varray(false));
 	ADDFUNC0R(ARRAY, NIL, Array, max, varray());
 	ADDFUNC0R(ARRAY, NIL, Array, min, varray());
+	ADDFUNC0R(ARRAY, BOOL, Array, is_typed, varray());
+	ADDFUNC0R(ARRAY, INT, Array, get_typed_builtin, varray());
+	ADDFUNC0R(ARRAY, STRING, Array, get_typed_class_name, varray());
 
 	ADDFUNC0R(POOL_BYTE_ARRAY, INT, PoolByteArray, size, varray());
 	ADDFUNC2(POOL_BYTE_ARRAY, NIL, PoolByteArray, set, INT, "idx", INT, "byte", varray());
@@ -0,0 +1,98 @@
+/*************************************************************************/
+/*  variant_internal.h                                                   */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2019 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2019 Godot Engine contributors (cf. AUTHORS.md)    */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#ifndef VARIANT_INTERNAL_H
+#define VARIANT_INTERNAL_H
+
+#include "core/variant.h"
+
+// Unchecked access to the value held by a Variant, for interpreter hot paths.
+// Getters require the caller to have checked get_type() first; setters write
+// in place when the type already matches and assign a new Variant otherwise.
+
+class VariantInternal {
+public:
+	_FORCE_INLINE_ static bool get_bool(const Variant *p_v) { return p_v->_data._bool; }
+	_FORCE_INLINE_ static int64_t get_int(const Variant *p_v) { return p_v->_data._int; }
+	_FORCE_INLINE_ static double get_real(const Variant *p_v) { return p_v->_data._real; }
+	_FORCE_INLINE_ static const Vector2 &get_vector2(const Variant *p_v) { return *reinterpret_cast<const Vector2 *>(p_v->_data._mem); }
+	_FORCE_INLINE_ static const Vector3 &get_vector3(const Variant *p_v) { return *reinterpret_cast<const Vector3 *>(p_v->_data._mem); }
+	_FORCE_INLINE_ static const Quat &get_quat(const Variant *p_v) { return *reinterpret_cast<const Quat *>(p_v->_data._mem); }
+	_FORCE_INLINE_ static const Color &get_color(const Variant *p_v) { return *reinterpret_cast<const Color *>(p_v->_data._mem); }
+	_FORCE_INLINE_ static const String &get_string(const Variant *p_v) { return *reinterpret_cast<const String *>(p_v->_data._mem); }
+	_FORCE_INLINE_ static const Array *get_array(const Variant *p_v) { return reinterpret_cast<const Array *>(p_v->_data._mem); }
+
+	_FORCE_INLINE_ static Object *get_object(const Variant *p_v) { return p_v->_get_obj().obj; }
+
+	_FORCE_INLINE_ static Vector2 &get_vector2_ref(Variant *p_v) { return *reinterpret_cast<Vector2 *>(p_v->_data._mem); }
+	_FORCE_INLINE_ static Vector3 &get_vector3_ref(Variant *p_v) { return *reinterpret_cast<Vector3 *>(p_v->_data._mem); }
+	_FORCE_INLINE_ static Array *get_array_ref(Variant *p_v) { return reinterpret_cast<Array *>(p_v->_data._mem); }
+
+	// INT and REAL read as a double, the way Variant::evaluate() mixes them.
+	_FORCE_INLINE_ static double get_number(const Variant *p_v) { return p_v->type == Variant::INT ? double(p_v->_data._int) : p_v->_data._real; }
+	_FORCE_INLINE_ static bool is_number(const Variant *p_v) { return p_v->type == Variant::INT || p_v->type == Variant::REAL; }
+
+	_FORCE_INLINE_ static void set_bool(Variant *p_v, bool p_value) {
+		if (p_v->type == Variant::BOOL)
+			p_v->_data._bool = p_value;
+		else
+			*p_v = p_value;
+	}
+
+	_FORCE_INLINE_ static void set_int(Variant *p_v, int64_t p_value) {
+		if (p_v->type == Variant::INT)
+			p_v->_data._int = p_value;
+		else
+			*p_v = p_value;
+	}
+
+	_FORCE_INLINE_ static void set_real(Variant *p_v, double p_value) {
+		if (p_v->type == Variant::REAL)
+			p_v->_data._real = p_value;
+		else
+			*p_v = p_value;
+	}
+
+	_FORCE_INLINE_ static void set_vector2(Variant *p_v, const Vector2 &p_value) {
+		if (p_v->type == Variant::VECTOR2)
+			get_vector2_ref(p_v) = p_value;
+		else
+			*p_v = p_value;
+	}
+
+	_FORCE_INLINE_ static void set_vector3(Variant *p_v, const Vector3 &p_value) {
+		if (p_v->type == Variant::VECTOR3)
+			get_vector3_ref(p_v) = p_value;
+		else
+			*p_v = p_value;
+	}
+};
+
+#endif // VARIANT_INTERNAL_H
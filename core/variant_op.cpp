@@ -33,6 +33,7 @@
 #include "core/core_string_names.h"
 #include "core/object.h"
 #include "core/script_language.h"
+#include "core/variant_internal.h"
 
 #define CASE_TYPE_ALL(PREFIX, OP) \
 	CASE_TYPE(PREFIX, OP, INT)    \
@@ -313,7 +314,7 @@ bool Variant::booleanize() const {
 #define DEFAULT_OP_PTRREF(m_prefix, m_op_name, m_name, m_op, m_sub) \
 	CASE_TYPE(m_prefix, m_op_name, m_name) {                        \
 		if (p_b.type == m_name)                                     \
-			_RETURN(*p_a._data.m_sub m_op *p_b._data.m_sub);        \
+			_RETURN(*p_a._get##m_sub() m_op *p_b._get##m_sub());    \
                                                                     \
 		_RETURN_FAIL                                                \
 	}
@@ -321,7 +322,7 @@ bool Variant::booleanize() const {
 #define DEFAULT_OP_PTRREF_NULL(m_prefix, m_op_name, m_name, m_op, m_sub) \
 	CASE_TYPE(m_prefix, m_op_name, m_name) {                             \
 		if (p_b.type == m_name)                                          \
-			_RETURN(*p_a._data.m_sub m_op *p_b._data.m_sub);             \
+			_RETURN(*p_a._get##m_sub() m_op *p_b._get##m_sub());         \
 		if (p_b.type == NIL)                                             \
 			_RETURN(!(p_b.type m_op NIL));                               \
                                                                          \
@@ -865,10 +866,10 @@ void Variant::evaluate(const Operator &p_op, const Variant &p_a,
 			CASE_TYPE(math, OP_MULTIPLY, TRANSFORM2D) {
 				switch (p_b.type) {
 					case TRANSFORM2D: {
-						_RETURN(*p_a._data._transform2d * *p_b._data._transform2d);
+						_RETURN(*p_a._get_transform2d() * *p_b._get_transform2d());
 					}
 					case VECTOR2: {
-						_RETURN(p_a._data._transform2d->xform(*(const Vector2 *)p_b._data._mem));
+						_RETURN(p_a._get_transform2d()->xform(*(const Vector2 *)p_b._data._mem));
 					}
 					default: _RETURN_FAIL;
 				}
@@ -892,10 +893,10 @@ void Variant::evaluate(const Operator &p_op, const Variant &p_a,
 			CASE_TYPE(math, OP_MULTIPLY, BASIS) {
 				switch (p_b.type) {
 					case VECTOR3: {
-						_RETURN(p_a._data._basis->xform(*(const Vector3 *)p_b._data._mem));
+						_RETURN(p_a._get_basis()->xform(*(const Vector3 *)p_b._data._mem));
 					}
 					case BASIS: {
-						_RETURN(*p_a._data._basis * *p_b._data._basis);
+						_RETURN(*p_a._get_basis() * *p_b._get_basis());
 					}
 					default: _RETURN_FAIL;
 				}
@@ -904,10 +905,10 @@ void Variant::evaluate(const Operator &p_op, const Variant &p_a,
 			CASE_TYPE(math, OP_MULTIPLY, TRANSFORM) {
 				switch (p_b.type) {
 					case VECTOR3: {
-						_RETURN(p_a._data._transform->xform(*(const Vector3 *)p_b._data._mem));
+						_RETURN(p_a._get_transform()->xform(*(const Vector3 *)p_b._data._mem));
 					}
 					case TRANSFORM: {
-						_RETURN(*p_a._data._transform * *p_b._data._transform);
+						_RETURN(*p_a._get_transform() * *p_b._get_transform());
 					}
 					default: _RETURN_FAIL;
 				}
@@ -1265,7 +1266,7 @@ void Variant::set_named(const StringName &p_index, const Variant &p_value, bool
 		case TRANSFORM2D: {
 
 			if (p_value.type == Variant::VECTOR2) {
-				Transform2D *v = _data._transform2d;
+				Transform2D *v = _get_transform2d();
 				if (p_index == CoreStringNames::singleton->x) {
 					v->elements[0] = *reinterpret_cast<const Vector2 *>(p_value._data._mem);
 					valid = true;
@@ -1388,7 +1389,7 @@ void Variant::set_named(const StringName &p_index, const Variant &p_value, bool
 		case AABB: {
 
 			if (p_value.type == Variant::VECTOR3) {
-				::AABB *v = _data._aabb;
+				::AABB *v = _get_aabb();
 				//scalar name
 				if (p_index == CoreStringNames::singleton->position) {
 					v->position = *reinterpret_cast<const Vector3 *>(p_value._data._mem);
@@ -1405,7 +1406,7 @@ void Variant::set_named(const StringName &p_index, const Variant &p_value, bool
 		case BASIS: {
 
 			if (p_value.type == Variant::VECTOR3) {
-				Basis *v = _data._basis;
+				Basis *v = _get_basis();
 				//scalar name
 				if (p_index == CoreStringNames::singleton->x) {
 					v->set_axis(0, *reinterpret_cast<const Vector3 *>(p_value._data._mem));
@@ -1422,10 +1423,10 @@ void Variant::set_named(const StringName &p_index, const Variant &p_value, bool
 		case TRANSFORM: {
 
 			if (p_value.type == Variant::BASIS && p_index == CoreStringNames::singleton->basis) {
-				_data._transform->basis = *p_value._data._basis;
+				_get_transform()->basis = *p_value._get_basis();
 				valid = true;
 			} else if (p_value.type == Variant::VECTOR3 && p_index == CoreStringNames::singleton->origin) {
-				_data._transform->origin = *reinterpret_cast<const Vector3 *>(p_value._data._mem);
+				_get_transform()->origin = *reinterpret_cast<const Vector3 *>(p_value._data._mem);
 				valid = true;
 			}
 
@@ -1558,7 +1559,7 @@ Variant Variant::get_named(const StringName &p_index, bool *r_valid) const {
 		} break;
 		case TRANSFORM2D: {
 
-			const Transform2D *v = _data._transform2d;
+			const Transform2D *v = _get_transform2d();
 			if (p_index == CoreStringNames::singleton->x) {
 				return v->elements[0];
 			} else if (p_index == CoreStringNames::singleton->y) {
@@ -1612,7 +1613,7 @@ Variant Variant::get_named(const StringName &p_index, bool *r_valid) const {
 		} break; // 10
 		case AABB: {
 
-			const ::AABB *v = _data._aabb;
+			const ::AABB *v = _get_aabb();
 			//scalar name
 			if (p_index == CoreStringNames::singleton->position) {
 				return v->position;
@@ -1624,7 +1625,7 @@ Variant Variant::get_named(const StringName &p_index, bool *r_valid) const {
 		} break;
 		case BASIS: {
 
-			const Basis *v = _data._basis;
+			const Basis *v = _get_basis();
 			//scalar name
 			if (p_index == CoreStringNames::singleton->x) {
 				return v->get_axis(0);
@@ -1638,9 +1639,9 @@ Variant Variant::get_named(const StringName &p_index, bool *r_valid) const {
 		case TRANSFORM: {
 
 			if (p_index == CoreStringNames::singleton->basis) {
-				return _data._transform->basis;
+				return _get_transform()->basis;
 			} else if (p_index == CoreStringNames::singleton->origin) {
-				return _data._transform->origin;
+				return _get_transform()->origin;
 			}
 
 		} break;
@@ -1771,6 +1772,7 @@ void Variant::set(const Variant &p_index, const Variant &p_value, bool *r_valid)
 			}
 
 			*str = str->substr(0, idx) + chr + str->substr(idx + 1, len);
+			_string_hash() = 0;
 			valid = true;
 			return;
 
@@ -1847,7 +1849,7 @@ void Variant::set(const Variant &p_index, const Variant &p_value, bool *r_valid)
 				if (index < 0)
 					index += 3;
 				if (index >= 0 && index < 3) {
-					Transform2D *v = _data._transform2d;
+					Transform2D *v = _get_transform2d();
 
 					valid = true;
 					v->elements[index] = p_value;
@@ -1857,7 +1859,7 @@ void Variant::set(const Variant &p_index, const Variant &p_value, bool *r_valid)
 
 				//scalar name
 				const String *str = reinterpret_cast<const String *>(p_index._data._mem);
-				Transform2D *v = _data._transform2d;
+				Transform2D *v = _get_transform2d();
 				if (*str == "x") {
 					valid = true;
 					v->elements[0] = p_value;
@@ -1992,7 +1994,7 @@ void Variant::set(const Variant &p_index, const Variant &p_value, bool *r_valid)
 				//scalar name
 
 				const String *str = reinterpret_cast<const String *>(p_index._data._mem);
-				::AABB *v = _data._aabb;
+				::AABB *v = _get_aabb();
 				if (*str == "position") {
 					valid = true;
 					v->position = p_value;
@@ -2020,7 +2022,7 @@ void Variant::set(const Variant &p_index, const Variant &p_value, bool *r_valid)
 				if (index < 0)
 					index += 3;
 				if (index >= 0 && index < 3) {
-					Basis *v = _data._basis;
+					Basis *v = _get_basis();
 
 					valid = true;
 					v->set_axis(index, p_value);
@@ -2029,7 +2031,7 @@ void Variant::set(const Variant &p_index, const Variant &p_value, bool *r_valid)
 			} else if (p_index.get_type() == Variant::STRING) {
 
 				const String *str = reinterpret_cast<const String *>(p_index._data._mem);
-				Basis *v = _data._basis;
+				Basis *v = _get_basis();
 
 				if (*str == "x") {
 					valid = true;
@@ -2059,7 +2061,7 @@ void Variant::set(const Variant &p_index, const Variant &p_value, bool *r_valid)
 				if (index < 0)
 					index += 4;
 				if (index >= 0 && index < 4) {
-					Transform *v = _data._transform;
+					Transform *v = _get_transform();
 					valid = true;
 					if (index == 3)
 						v->origin = p_value;
@@ -2069,7 +2071,7 @@ void Variant::set(const Variant &p_index, const Variant &p_value, bool *r_valid)
 				}
 			} else if (p_index.get_type() == Variant::STRING) {
 
-				Transform *v = _data._transform;
+				Transform *v = _get_transform();
 				const String *str = reinterpret_cast<const String *>(p_index._data._mem);
 
 				if (*str == "basis") {
@@ -2193,7 +2195,7 @@ void Variant::set(const Variant &p_index, const Variant &p_value, bool *r_valid)
 			valid = true; //always valid, i guess? should this really be ok?
 			return;
 		} break;
-			DEFAULT_OP_ARRAY_CMD(ARRAY, Array, ;, (*arr)[index] = p_value; return ) // 20
+			DEFAULT_OP_ARRAY_CMD(ARRAY, Array, ;, if (!arr->can_hold(p_value)) { valid = false; return; } arr->set(index, p_value); return ) // 20
 			DEFAULT_OP_DVECTOR_SET(POOL_BYTE_ARRAY, uint8_t, p_value.type != Variant::REAL && p_value.type != Variant::INT)
 			DEFAULT_OP_DVECTOR_SET(POOL_INT_ARRAY, int, p_value.type != Variant::REAL && p_value.type != Variant::INT)
 			DEFAULT_OP_DVECTOR_SET(POOL_REAL_ARRAY, real_t, p_value.type != Variant::REAL && p_value.type != Variant::INT)
@@ -2331,7 +2333,7 @@ Variant Variant::get(const Variant &p_index, bool *r_valid) const {
 				if (index < 0)
 					index += 3;
 				if (index >= 0 && index < 3) {
-					const Transform2D *v = _data._transform2d;
+					const Transform2D *v = _get_transform2d();
 
 					valid = true;
 					return v->elements[index];
@@ -2340,7 +2342,7 @@ Variant Variant::get(const Variant &p_index, bool *r_valid) const {
 
 				//scalar name
 				const String *str = reinterpret_cast<const String *>(p_index._data._mem);
-				const Transform2D *v = _data._transform2d;
+				const Transform2D *v = _get_transform2d();
 				if (*str == "x") {
 					valid = true;
 					return v->elements[0];
@@ -2407,7 +2409,7 @@ Variant Variant::get(const Variant &p_index, bool *r_valid) const {
 				//scalar name
 
 				const String *str = reinterpret_cast<const String *>(p_index._data._mem);
-				const ::AABB *v = _data._aabb;
+				const ::AABB *v = _get_aabb();
 				if (*str == "position") {
 					valid = true;
 					return v->position;
@@ -2428,7 +2430,7 @@ Variant Variant::get(const Variant &p_index, bool *r_valid) const {
 				if (index < 0)
 					index += 3;
 				if (index >= 0 && index < 3) {
-					const Basis *v = _data._basis;
+					const Basis *v = _get_basis();
 
 					valid = true;
 					return v->get_axis(index);
@@ -2436,7 +2438,7 @@ Variant Variant::get(const Variant &p_index, bool *r_valid) const {
 			} else if (p_index.get_type() == Variant::STRING) {
 
 				const String *str = reinterpret_cast<const String *>(p_index._data._mem);
-				const Basis *v = _data._basis;
+				const Basis *v = _get_basis();
 
 				if (*str == "x") {
 					valid = true;
@@ -2459,13 +2461,13 @@ Variant Variant::get(const Variant &p_index, bool *r_valid) const {
 				if (index < 0)
 					index += 4;
 				if (index >= 0 && index < 4) {
-					const Transform *v = _data._transform;
+					const Transform *v = _get_transform();
 					valid = true;
 					return index == 3 ? v->origin : v->basis.get_axis(index);
 				}
 			} else if (p_index.get_type() == Variant::STRING) {
 
-				const Transform *v = _data._transform;
+				const Transform *v = _get_transform();
 				const String *str = reinterpret_cast<const String *>(p_index._data._mem);
 
 				if (*str == "basis") {
@@ -3605,7 +3607,7 @@ void Variant::interpolate(const Variant &a, const Variant &b, float c, Variant &
 		}
 			return;
 		case TRANSFORM2D: {
-			r_dst = a._data._transform2d->interpolate_with(*b._data._transform2d, c);
+			r_dst = a._get_transform2d()->interpolate_with(*b._get_transform2d(), c);
 		}
 			return;
 		case PLANE: {
@@ -3617,15 +3619,15 @@ void Variant::interpolate(const Variant &a, const Variant &b, float c, Variant &
 		}
 			return;
 		case AABB: {
-			r_dst = ::AABB(a._data._aabb->position.linear_interpolate(b._data._aabb->position, c), a._data._aabb->size.linear_interpolate(b._data._aabb->size, c));
+			r_dst = ::AABB(a._get_aabb()->position.linear_interpolate(b._get_aabb()->position, c), a._get_aabb()->size.linear_interpolate(b._get_aabb()->size, c));
 		}
 			return;
 		case BASIS: {
-			r_dst = Transform(*a._data._basis).interpolate_with(Transform(*b._data._basis), c).basis;
+			r_dst = Transform(*a._get_basis()).interpolate_with(Transform(*b._get_basis()), c).basis;
 		}
 			return;
 		case TRANSFORM: {
-			r_dst = a._data._transform->interpolate_with(*b._data._transform, c);
+			r_dst = a._get_transform()->interpolate_with(*b._get_transform(), c);
 		}
 			return;
 		case COLOR: {
@@ -3825,3 +3827,169 @@ String Variant::get_operator_name(Operator p_op) {
 	ERR_FAIL_INDEX_V(p_op, OP_MAX, "");
 	return _op_names[p_op];
 }
+
+/* Validated operators */
+
+static Variant::ValidatedOperatorEvaluator validated_operator_evaluators[Variant::OP_MAX][Variant::VARIANT_MAX][Variant::VARIANT_MAX] = {};
+
+Variant::ValidatedOperatorEvaluator Variant::get_validated_operator_evaluator(Operator p_op, Type p_a, Type p_b) {
+
+	return validated_operator_evaluators[p_op][p_a][p_b];
+}
+
+template <class T>
+class VariantOperand;
+
+#define VARIANT_OPERAND_SET(m_type, m_get, m_set)                                                          \
+	template <>                                                                                            \
+	class VariantOperand<m_type> {                                                                         \
+	public:                                                                                                \
+		static _FORCE_INLINE_ m_type get(const Variant *p_v) { return VariantInternal::m_get(p_v); }       \
+		static _FORCE_INLINE_ void set(Variant *p_v, const m_type &p_value) { VariantInternal::m_set(p_v, p_value); } \
+	};
+
+#define VARIANT_OPERAND_ASSIGN(m_type, m_get)                                                               \
+	template <>                                                                                             \
+	class VariantOperand<m_type> {                                                                          \
+	public:                                                                                                 \
+		static _FORCE_INLINE_ const m_type &get(const Variant *p_v) { return VariantInternal::m_get(p_v); } \
+		static _FORCE_INLINE_ void set(Variant *p_v, const m_type &p_value) { *p_v = p_value; }            \
+	};
+
+VARIANT_OPERAND_SET(bool, get_bool, set_bool)
+VARIANT_OPERAND_SET(int64_t, get_int, set_int)
+VARIANT_OPERAND_SET(double, get_real, set_real)
+VARIANT_OPERAND_SET(Vector2, get_vector2, set_vector2)
+VARIANT_OPERAND_SET(Vector3, get_vector3, set_vector3)
+VARIANT_OPERAND_ASSIGN(Color, get_color)
+VARIANT_OPERAND_ASSIGN(String, get_string)
+
+// The result is computed before it is stored, so r_ret may alias an operand.
+#define VALIDATED_BINARY_OPERATOR(m_name, m_op)                                                                 \
+	template <class R, class A, class B>                                                                        \
+	class m_name {                                                                                              \
+	public:                                                                                                     \
+		static void evaluate(const Variant *p_a, const Variant *p_b, Variant *r_ret) {                          \
+			R result = VariantOperand<A>::get(p_a) m_op VariantOperand<B>::get(p_b);                            \
+			VariantOperand<R>::set(r_ret, result);                                                              \
+		}                                                                                                       \
+	};
+
+#define VALIDATED_UNARY_OPERATOR(m_name, m_op)                                         \
+	template <class R, class A>                                                        \
+	class m_name {                                                                     \
+	public:                                                                            \
+		static void evaluate(const Variant *p_a, const Variant *p_b, Variant *r_ret) { \
+			R result = m_op VariantOperand<A>::get(p_a);                               \
+			VariantOperand<R>::set(r_ret, result);                                     \
+		}                                                                              \
+	};
+
+VALIDATED_BINARY_OPERATOR(OperatorEvaluatorAdd, +)
+VALIDATED_BINARY_OPERATOR(OperatorEvaluatorSubtract, -)
+VALIDATED_BINARY_OPERATOR(OperatorEvaluatorMultiply, *)
+VALIDATED_BINARY_OPERATOR(OperatorEvaluatorDivide, /)
+VALIDATED_BINARY_OPERATOR(OperatorEvaluatorEqual, ==)
+VALIDATED_BINARY_OPERATOR(OperatorEvaluatorNotEqual, !=)
+VALIDATED_BINARY_OPERATOR(OperatorEvaluatorLess, <)
+VALIDATED_BINARY_OPERATOR(OperatorEvaluatorLessEqual, <=)
+VALIDATED_BINARY_OPERATOR(OperatorEvaluatorGreater, >)
+VALIDATED_BINARY_OPERATOR(OperatorEvaluatorGreaterEqual, >=)
+VALIDATED_BINARY_OPERATOR(OperatorEvaluatorBitAnd, &)
+VALIDATED_BINARY_OPERATOR(OperatorEvaluatorBitOr, |)
+VALIDATED_BINARY_OPERATOR(OperatorEvaluatorBitXor, ^)
+VALIDATED_BINARY_OPERATOR(OperatorEvaluatorShiftLeft, <<)
+VALIDATED_BINARY_OPERATOR(OperatorEvaluatorShiftRight, >>)
+VALIDATED_BINARY_OPERATOR(OperatorEvaluatorAnd, &&)
+VALIDATED_BINARY_OPERATOR(OperatorEvaluatorOr, ||)
+VALIDATED_UNARY_OPERATOR(OperatorEvaluatorNegate, -)
+VALIDATED_UNARY_OPERATOR(OperatorEvaluatorPositive, +)
+VALIDATED_UNARY_OPERATOR(OperatorEvaluatorBitNegate, ~)
+VALIDATED_UNARY_OPERATOR(OperatorEvaluatorNot, !)
+
+template <class T>
+static void _register_binary_operator(Variant::Operator p_op, Variant::Type p_a, Variant::Type p_b) {
+	validated_operator_evaluators[p_op][p_a][p_b] = T::evaluate;
+}
+
+template <class T>
+static void _register_unary_operator(Variant::Operator p_op, Variant::Type p_a) {
+	for (int i = 0; i < Variant::VARIANT_MAX; i++) {
+		validated_operator_evaluators[p_op][p_a][i] = T::evaluate;
+	}
+}
+
+// Only pairs whose result matches evaluate() exactly and can't fail are
+// listed. Integer and real division are left out so division by zero is
+// still reported.
+#define REGISTER_NUMERIC_OPERATOR(m_op, m_evaluator)                                                        \
+	_register_binary_operator<m_evaluator<int64_t, int64_t, int64_t> >(m_op, Variant::INT, Variant::INT); \
+	_register_binary_operator<m_evaluator<double, int64_t, double> >(m_op, Variant::INT, Variant::REAL);  \
+	_register_binary_operator<m_evaluator<double, double, int64_t> >(m_op, Variant::REAL, Variant::INT);  \
+	_register_binary_operator<m_evaluator<double, double, double> >(m_op, Variant::REAL, Variant::REAL);
+
+#define REGISTER_COMPARISON_OPERATOR(m_op, m_evaluator)                                                  \
+	_register_binary_operator<m_evaluator<bool, int64_t, int64_t> >(m_op, Variant::INT, Variant::INT); \
+	_register_binary_operator<m_evaluator<bool, int64_t, double> >(m_op, Variant::INT, Variant::REAL); \
+	_register_binary_operator<m_evaluator<bool, double, int64_t> >(m_op, Variant::REAL, Variant::INT); \
+	_register_binary_operator<m_evaluator<bool, double, double> >(m_op, Variant::REAL, Variant::REAL);
+
+#define REGISTER_VECTOR_OPERATORS(m_type, m_vtype)                                                                             \
+	_register_binary_operator<OperatorEvaluatorAdd<m_type, m_type, m_type> >(Variant::OP_ADD, m_vtype, m_vtype);               \
+	_register_binary_operator<OperatorEvaluatorSubtract<m_type, m_type, m_type> >(Variant::OP_SUBTRACT, m_vtype, m_vtype);     \
+	_register_binary_operator<OperatorEvaluatorMultiply<m_type, m_type, m_type> >(Variant::OP_MULTIPLY, m_vtype, m_vtype);     \
+	_register_binary_operator<OperatorEvaluatorDivide<m_type, m_type, m_type> >(Variant::OP_DIVIDE, m_vtype, m_vtype);         \
+	_register_binary_operator<OperatorEvaluatorMultiply<m_type, m_type, int64_t> >(Variant::OP_MULTIPLY, m_vtype, Variant::INT); \
+	_register_binary_operator<OperatorEvaluatorMultiply<m_type, m_type, double> >(Variant::OP_MULTIPLY, m_vtype, Variant::REAL); \
+	_register_binary_operator<OperatorEvaluatorDivide<m_type, m_type, int64_t> >(Variant::OP_DIVIDE, m_vtype, Variant::INT);   \
+	_register_binary_operator<OperatorEvaluatorDivide<m_type, m_type, double> >(Variant::OP_DIVIDE, m_vtype, Variant::REAL);   \
+	_register_binary_operator<OperatorEvaluatorEqual<bool, m_type, m_type> >(Variant::OP_EQUAL, m_vtype, m_vtype);            \
+	_register_binary_operator<OperatorEvaluatorNotEqual<bool, m_type, m_type> >(Variant::OP_NOT_EQUAL, m_vtype, m_vtype);     \
+	_register_unary_operator<OperatorEvaluatorNegate<m_type, m_type> >(Variant::OP_NEGATE, m_vtype);
+
+void Variant::register_validated_operators() {
+
+	REGISTER_NUMERIC_OPERATOR(OP_ADD, OperatorEvaluatorAdd);
+	REGISTER_NUMERIC_OPERATOR(OP_SUBTRACT, OperatorEvaluatorSubtract);
+	REGISTER_NUMERIC_OPERATOR(OP_MULTIPLY, OperatorEvaluatorMultiply);
+
+	REGISTER_COMPARISON_OPERATOR(OP_EQUAL, OperatorEvaluatorEqual);
+	REGISTER_COMPARISON_OPERATOR(OP_NOT_EQUAL, OperatorEvaluatorNotEqual);
+	REGISTER_COMPARISON_OPERATOR(OP_LESS, OperatorEvaluatorLess);
+	REGISTER_COMPARISON_OPERATOR(OP_LESS_EQUAL, OperatorEvaluatorLessEqual);
+	REGISTER_COMPARISON_OPERATOR(OP_GREATER, OperatorEvaluatorGreater);
+	REGISTER_COMPARISON_OPERATOR(OP_GREATER_EQUAL, OperatorEvaluatorGreaterEqual);
+
+	_register_unary_operator<OperatorEvaluatorNegate<int64_t, int64_t> >(OP_NEGATE, INT);
+	_register_unary_operator<OperatorEvaluatorNegate<double, double> >(OP_NEGATE, REAL);
+	_register_unary_operator<OperatorEvaluatorPositive<int64_t, int64_t> >(OP_POSITIVE, INT);
+	_register_unary_operator<OperatorEvaluatorPositive<double, double> >(OP_POSITIVE, REAL);
+
+	_register_binary_operator<OperatorEvaluatorBitAnd<int64_t, int64_t, int64_t> >(OP_BIT_AND, INT, INT);
+	_register_binary_operator<OperatorEvaluatorBitOr<int64_t, int64_t, int64_t> >(OP_BIT_OR, INT, INT);
+	_register_binary_operator<OperatorEvaluatorBitXor<int64_t, int64_t, int64_t> >(OP_BIT_XOR, INT, INT);
+	_register_binary_operator<OperatorEvaluatorShiftLeft<int64_t, int64_t, int64_t> >(OP_SHIFT_LEFT, INT, INT);
+	_register_binary_operator<OperatorEvaluatorShiftRight<int64_t, int64_t, int64_t> >(OP_SHIFT_RIGHT, INT, INT);
+	_register_unary_operator<OperatorEvaluatorBitNegate<int64_t, int64_t> >(OP_BIT_NEGATE, INT);
+
+	_register_binary_operator<OperatorEvaluatorEqual<bool, bool, bool> >(OP_EQUAL, BOOL, BOOL);
+	_register_binary_operator<OperatorEvaluatorNotEqual<bool, bool, bool> >(OP_NOT_EQUAL, BOOL, BOOL);
+	_register_binary_operator<OperatorEvaluatorAnd<bool, bool, bool> >(OP_AND, BOOL, BOOL);
+	_register_binary_operator<OperatorEvaluatorOr<bool, bool, bool> >(OP_OR, BOOL, BOOL);
+	_register_binary_operator<OperatorEvaluatorNotEqual<bool, bool, bool> >(OP_XOR, BOOL, BOOL);
+	_register_unary_operator<OperatorEvaluatorNot<bool, bool> >(OP_NOT, BOOL);
+
+	_register_binary_operator<OperatorEvaluatorAdd<String, String, String> >(OP_ADD, STRING, STRING);
+	_register_binary_operator<OperatorEvaluatorEqual<bool, String, String> >(OP_EQUAL, STRING, STRING);
+	_register_binary_operator<OperatorEvaluatorNotEqual<bool, String, String> >(OP_NOT_EQUAL, STRING, STRING);
+	_register_binary_operator<OperatorEvaluatorLess<bool, String, String> >(OP_LESS, STRING, STRING);
+	_register_binary_operator<OperatorEvaluatorLessEqual<bool, String, String> >(OP_LESS_EQUAL, STRING, STRING);
+
+	REGISTER_VECTOR_OPERATORS(Vector2, VECTOR2);
+	REGISTER_VECTOR_OPERATORS(Vector3, VECTOR3);
+	REGISTER_VECTOR_OPERATORS(Color, COLOR);
+	_register_binary_operator<OperatorEvaluatorMultiply<Vector2, int64_t, Vector2> >(OP_MULTIPLY, INT, VECTOR2);
+	_register_binary_operator<OperatorEvaluatorMultiply<Vector2, double, Vector2> >(OP_MULTIPLY, REAL, VECTOR2);
+	_register_binary_operator<OperatorEvaluatorMultiply<Vector3, int64_t, Vector3> >(OP_MULTIPLY, INT, VECTOR3);
+	_register_binary_operator<OperatorEvaluatorMultiply<Vector3, double, Vector3> >(OP_MULTIPLY, REAL, VECTOR3);
+}
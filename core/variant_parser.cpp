@@ -35,34 +35,66 @@
 #include "core/os/keyboard.h"
 #include "core/string_buffer.h"
 
-CharType VariantParser::StreamFile::get_char() {
+CharType VariantParser::Stream::_refill() {
 
-	return f->get_8();
+	if (eof) {
+		return 0;
+	}
+
+	if (!readahead_enabled) {
+		CharType c;
+		if (_read_buffer(&c, 1) == 0) {
+			eof = true;
+			return 0;
+		}
+		return c;
+	}
+
+	readahead_pos = 0;
+	readahead_filled = _read_buffer(readahead_buffer, READAHEAD_SIZE);
+	if (readahead_filled == 0) {
+		eof = true;
+		return 0;
+	}
+	return readahead_buffer[readahead_pos++];
 }
 
-bool VariantParser::StreamFile::is_utf8() const {
+uint32_t VariantParser::StreamFile::_read_buffer(CharType *p_buffer, uint32_t p_num_chars) {
 
-	return true;
+	// Read the bytes into the start of the buffer, then widen them from the back so none is overwritten before use.
+	uint8_t *bytes = (uint8_t *)p_buffer;
+	int read = f->get_buffer(bytes, p_num_chars);
+	if (read <= 0) {
+		return 0;
+	}
+
+	for (int i = read - 1; i >= 0; i--) {
+		p_buffer[i] = bytes[i];
+	}
+	return read;
 }
-bool VariantParser::StreamFile::is_eof() const {
 
-	return f->eof_reached();
+bool VariantParser::StreamFile::is_utf8() const {
+
+	return true;
 }
 
-CharType VariantParser::StreamString::get_char() {
+uint32_t VariantParser::StreamString::_read_buffer(CharType *p_buffer, uint32_t p_num_chars) {
 
-	if (pos >= s.length())
+	int available = s.length() - pos;
+	if (available <= 0) {
 		return 0;
-	else
-		return s[pos++];
+	}
+
+	uint32_t count = MIN(p_num_chars, uint32_t(available));
+	copymem(p_buffer, s.ptr() + pos, count * sizeof(CharType));
+	pos += count;
+	return count;
 }
 
 bool VariantParser::StreamString::is_utf8() const {
 	return false;
 }
-bool VariantParser::StreamString::is_eof() const {
-	return pos > s.length();
-}
 
 /////////////////////////////////////////////////////////////////////////////////////////////////
 
@@ -85,6 +117,136 @@ const char *VariantParser::tk_name[TK_MAX] = {
 	"ERROR"
 };
 
+#define READING_SIGN 0
+#define READING_INT 1
+#define READING_DEC 2
+#define READING_EXP 3
+#define READING_DONE 4
+
+// Lexes a number starting with p_first into a char buffer and converts it without going
+// through String, returns the first character after it.
+static CharType _read_number(VariantParser::Stream *p_stream, CharType p_first, bool &r_is_float, double &r_float, int64_t &r_int) {
+
+	char buf[128];
+	int len = 0;
+	String overflow; // Only used for unreasonably long numbers.
+
+	int64_t integer = 0;
+	bool negative = false;
+	int reading = READING_INT;
+
+	CharType c = p_first;
+	if (c == '-') {
+		buf[len++] = '-';
+		negative = true;
+		c = p_stream->get_char();
+	}
+
+	bool exp_sign = false;
+	bool exp_beg = false;
+	bool is_float = false;
+
+	while (true) {
+
+		switch (reading) {
+			case READING_INT: {
+
+				if (c >= '0' && c <= '9') {
+					//pass
+				} else if (c == '.') {
+					reading = READING_DEC;
+					is_float = true;
+				} else if (c == 'e') {
+					reading = READING_EXP;
+					is_float = true;
+				} else {
+					reading = READING_DONE;
+				}
+
+			} break;
+			case READING_DEC: {
+
+				if (c >= '0' && c <= '9') {
+
+				} else if (c == 'e') {
+					reading = READING_EXP;
+				} else {
+					reading = READING_DONE;
+				}
+
+			} break;
+			case READING_EXP: {
+
+				if (c >= '0' && c <= '9') {
+					exp_beg = true;
+
+				} else if ((c == '-' || c == '+') && !exp_sign && !exp_beg) {
+					exp_sign = true;
+
+				} else {
+					reading = READING_DONE;
+				}
+			} break;
+		}
+
+		if (reading == READING_DONE)
+			break;
+
+		if (!is_float) {
+			integer = integer * 10 + (c - '0');
+		}
+		if (len < (int)sizeof(buf) - 1) {
+			buf[len++] = c;
+		} else {
+			overflow += c;
+		}
+		c = p_stream->get_char();
+	}
+
+	buf[len] = 0;
+	r_is_float = is_float;
+	if (is_float) {
+		r_float = overflow.empty() ? String::to_double(buf) : (String(buf) + overflow).to_double();
+	} else {
+		r_int = negative ? -integer : integer;
+	}
+
+	return c;
+}
+
+// Returns the next character that is not whitespace or part of a comment, like get_token() skips them.
+static CharType _skip_whitespace(VariantParser::Stream *p_stream, int &line) {
+
+	while (true) {
+
+		CharType c;
+		if (p_stream->saved) {
+			c = p_stream->saved;
+			p_stream->saved = 0;
+		} else {
+			c = p_stream->get_char();
+			if (p_stream->is_eof()) {
+				return 0;
+			}
+		}
+
+		if (c == '\n') {
+			line++;
+		} else if (c == ';') {
+			while (true) {
+				CharType ch = p_stream->get_char();
+				if (p_stream->is_eof()) {
+					return 0;
+				}
+				if (ch == '\n')
+					break;
+			}
+		} else if (c == 0 || c > 32) {
+			return c;
+		}
+	}
+}
+
 Error VariantParser::get_token(Stream *p_stream, Token &r_token, int &line, String &r_err_str) {
 
 	while (true) {
@@ -200,7 +362,7 @@ Error VariantParser::get_token(Stream *p_stream, Token &r_token, int &line, Stri
 			};
 			case '"': {
 
-				String str;
+				StringBuffer<> str;
 				while (true) {
 
 					CharType ch = p_stream->get_char();
@@ -282,11 +444,12 @@ Error VariantParser::get_token(Stream *p_stream, Token &r_token, int &line, Stri
 					}
 				}
 
+				String string = str.as_string();
 				if (p_stream->is_utf8()) {
-					str.parse_utf8(str.ascii(true).get_data());
+					string.parse_utf8(string.ascii(true).get_data());
 				}
 				r_token.type = TK_STRING;
-				r_token.value = str;
+				r_token.value = string;
 				return OK;
 
 			} break;
@@ -299,81 +462,17 @@ Error VariantParser::get_token(Stream *p_stream, Token &r_token, int &line, Stri
 				if (cchar == '-' || (cchar >= '0' && cchar <= '9')) {
 					//a number
 
-					StringBuffer<> num;
-#define READING_SIGN 0
-#define READING_INT 1
-#define READING_DEC 2
-#define READING_EXP 3
-#define READING_DONE 4
-					int reading = READING_INT;
-
-					if (cchar == '-') {
-						num += '-';
-						cchar = p_stream->get_char();
-					}
-
-					CharType c = cchar;
-					bool exp_sign = false;
-					bool exp_beg = false;
-					bool is_float = false;
-
-					while (true) {
-
-						switch (reading) {
-							case READING_INT: {
-
-								if (c >= '0' && c <= '9') {
-									//pass
-								} else if (c == '.') {
-									reading = READING_DEC;
-									is_float = true;
-								} else if (c == 'e') {
-									reading = READING_EXP;
-									is_float = true;
-								} else {
-									reading = READING_DONE;
-								}
-
-							} break;
-							case READING_DEC: {
-
-								if (c >= '0' && c <= '9') {
-
-								} else if (c == 'e') {
-									reading = READING_EXP;
-								} else {
-									reading = READING_DONE;
-								}
-
-							} break;
-							case READING_EXP: {
-
-								if (c >= '0' && c <= '9') {
-									exp_beg = true;
-
-								} else if ((c == '-' || c == '+') && !exp_sign && !exp_beg) {
-									exp_sign = true;
-
-								} else {
-									reading = READING_DONE;
-								}
-							} break;
-						}
-
-						if (reading == READING_DONE)
-							break;
-						num += c;
-						c = p_stream->get_char();
-					}
-
-					p_stream->saved = c;
+					bool is_float;
+					double float_value;
+					int64_t int_value;
+					p_stream->saved = _read_number(p_stream, cchar, is_float, float_value, int_value);
 
 					r_token.type = TK_NUMBER;
 
 					if (is_float)
-						r_token.value = num.as_double();
+						r_token.value = float_value;
 					else
-						r_token.value = num.as_int();
+						r_token.value = int_value;
 					return OK;
 
 				} else if ((cchar >= 'A' && cchar <= 'Z') || (cchar >= 'a' && cchar <= 'z') || cchar == '_') {
@@ -450,30 +549,36 @@ Error VariantParser::_parse_construct(Stream *p_stream, Vector<T> &r_construct,
 		return ERR_PARSE_ERROR;
 	}
 
+	// Numbers are read straight from the stream, skipping tokens and Variants, as pool arrays can hold a lot of them.
 	bool first = true;
 	while (true) {
 
+		CharType c = _skip_whitespace(p_stream, line);
+
 		if (!first) {
-			get_token(p_stream, token, line, r_err_str);
-			if (token.type == TK_COMMA) {
-				//do none
-			} else if (token.type == TK_PARENTHESIS_CLOSE) {
+			if (c == ',') {
+				c = _skip_whitespace(p_stream, line);
+			} else if (c == ')') {
 				break;
 			} else {
 				r_err_str = "Expected ',' or ')' in constructor";
 				return ERR_PARSE_ERROR;
 			}
 		}
-		get_token(p_stream, token, line, r_err_str);
 
-		if (first && token.type == TK_PARENTHESIS_CLOSE) {
+		if (first && c == ')') {
 			break;
-		} else if (token.type != TK_NUMBER) {
+		} else if (c != '-' && !(c >= '0' && c <= '9')) {
 			r_err_str = "Expected float in constructor";
 			return ERR_PARSE_ERROR;
 		}
 
-		r_construct.push_back(token.value);
+		bool is_float;
+		double float_value;
+		int64_t int_value;
+		p_stream->saved = _read_number(p_stream, c, is_float, float_value, int_value);
+
+		r_construct.push_back(is_float ? T(float_value) : T(int_value));
 		first = false;
 	}
 
@@ -39,14 +39,42 @@ class VariantParser {
 public:
 	struct Stream {
 
-		virtual CharType get_char() = 0;
-		virtual bool is_utf8() const = 0;
-		virtual bool is_eof() const = 0;
+		enum {
+			READAHEAD_SIZE = 4096
+		};
+
+	private:
+		// Characters are read in blocks, so get_char() is a plain array access most of the time.
+		CharType readahead_buffer[READAHEAD_SIZE];
+		uint32_t readahead_pos;
+		uint32_t readahead_filled;
+		bool eof;
+
+		CharType _refill();
+
+	protected:
+		virtual uint32_t _read_buffer(CharType *p_buffer, uint32_t p_num_chars) = 0; ///< returns how many were read, 0 at the end
 
+	public:
 		CharType saved;
+		bool readahead_enabled; ///< disable to keep the underlying file positioned right after the last character read
+
+		_FORCE_INLINE_ CharType get_char() {
+			if (readahead_pos < readahead_filled) {
+				return readahead_buffer[readahead_pos++];
+			}
+			return _refill();
+		}
+
+		virtual bool is_utf8() const = 0;
+		bool is_eof() const { return eof; }
 
 		Stream() :
-				saved(0) {}
+				readahead_pos(0),
+				readahead_filled(0),
+				eof(false),
+				saved(0),
+				readahead_enabled(true) {}
 		virtual ~Stream() {}
 	};
 
@@ -54,9 +82,8 @@ public:
 
 		FileAccess *f;
 
-		virtual CharType get_char();
+		virtual uint32_t _read_buffer(CharType *p_buffer, uint32_t p_num_chars);
 		virtual bool is_utf8() const;
-		virtual bool is_eof() const;
 
 		StreamFile() { f = NULL; }
 	};
@@ -66,9 +93,8 @@ public:
 		String s;
 		int pos;
 
-		virtual CharType get_char();
+		virtual uint32_t _read_buffer(CharType *p_buffer, uint32_t p_num_chars);
 		virtual bool is_utf8() const;
-		virtual bool is_eof() const;
 
 		StreamString() { pos = 0; }
 	};
@@ -137,6 +137,7 @@ public:
 		PoolVector<uint8_t> index_array;
 		int index_count;
 		AABB aabb;
+		Rect2 uv_range;
 		Vector<PoolVector<uint8_t> > blend_shapes;
 		Vector<AABB> bone_aabbs;
 	};
@@ -165,7 +166,9 @@ public:
 		t->flags = p_flags;
 		t->format = p_format;
 		t->image = Ref<Image>(memnew(Image));
-		t->image->create(p_width, p_height, false, p_format);
+		if (!VS::get_singleton()->is_null_mode()) {
+			t->image->create(p_width, p_height, false, p_format);
+		}
 	}
 	void texture_set_data(RID p_texture, const Ref<Image> &p_image, int p_level) {
 		DummyTexture *t = texture_owner.getornull(p_texture);
@@ -173,6 +176,9 @@ public:
 		t->width = p_image->get_width();
 		t->height = p_image->get_height();
 		t->format = p_image->get_format();
+		if (VS::get_singleton()->is_null_mode()) {
+			return; // only the size is kept, the pixels are never read back
+		}
 		t->image->create(t->width, t->height, false, t->format, p_image->get_data());
 	}
 
@@ -186,6 +192,10 @@ public:
 		ERR_FAIL_COND(src_x < 0 || src_y < 0 || src_x + src_w > p_image->get_width() || src_y + src_h > p_image->get_height());
 		ERR_FAIL_COND(dst_x < 0 || dst_y < 0 || dst_x + src_w > t->width || dst_y + src_h > t->height);
 
+		if (t->image->empty()) {
+			return;
+		}
+
 		t->image->blit_rect(p_image, Rect2(src_x, src_y, src_w, src_h), Vector2(dst_x, dst_y));
 	}
 
@@ -260,6 +270,9 @@ public:
 	void shader_set_default_texture_param(RID p_shader, const StringName &p_name, RID p_texture) {}
 	RID shader_get_default_texture_param(RID p_shader, const StringName &p_name) const { return RID(); }
 
+	PoolIntArray shader_get_compiled_variants(RID p_shader) const { return PoolIntArray(); }
+	void shader_precompile_variants(RID p_shader, const PoolIntArray &p_variants) {}
+
 	/* COMMON MATERIAL API */
 
 	RID material_create() { return RID(); }
@@ -292,7 +305,7 @@ public:
 		return mesh_owner.make_rid(mesh);
 	}
 
-	void mesh_add_surface(RID p_mesh, uint32_t p_format, VS::PrimitiveType p_primitive, const PoolVector<uint8_t> &p_array, int p_vertex_count, const PoolVector<uint8_t> &p_index_array, int p_index_count, const AABB &p_aabb, const Vector<PoolVector<uint8_t> > &p_blend_shapes = Vector<PoolVector<uint8_t> >(), const Vector<AABB> &p_bone_aabbs = Vector<AABB>()) {
+	void mesh_add_surface(RID p_mesh, uint32_t p_format, VS::PrimitiveType p_primitive, const PoolVector<uint8_t> &p_array, int p_vertex_count, const PoolVector<uint8_t> &p_index_array, int p_index_count, const AABB &p_aabb, const Vector<PoolVector<uint8_t> > &p_blend_shapes = Vector<PoolVector<uint8_t> >(), const Vector<AABB> &p_bone_aabbs = Vector<AABB>(), const Rect2 &p_uv_range = Rect2(0, 0, 1, 1)) {
 		DummyMesh *m = mesh_owner.getornull(p_mesh);
 		ERR_FAIL_COND(!m);
 
@@ -307,6 +320,7 @@ public:
 		s->aabb = p_aabb;
 		s->blend_shapes = p_blend_shapes;
 		s->bone_aabbs = p_bone_aabbs;
+		s->uv_range = p_uv_range;
 	}
 
 	void mesh_set_blend_shape_count(RID p_mesh, int p_amount) {
@@ -332,6 +346,7 @@ public:
 	}
 
 	void mesh_surface_update_region(RID p_mesh, int p_surface, int p_offset, const PoolVector<uint8_t> &p_data) {}
+	void mesh_surface_set_lods(RID p_mesh, int p_surface, const Vector<PoolVector<uint8_t> > &p_lod_indices, const Vector<float> &p_lod_errors) {}
 
 	void mesh_surface_set_material(RID p_mesh, int p_surface, RID p_material) {}
 	RID mesh_surface_get_material(RID p_mesh, int p_surface) const { return RID(); }
@@ -381,6 +396,12 @@ public:
 
 		return m->surfaces[p_surface].aabb;
 	}
+	Rect2 mesh_surface_get_uv_range(RID p_mesh, int p_surface) const {
+		DummyMesh *m = mesh_owner.getornull(p_mesh);
+		ERR_FAIL_COND_V(!m, Rect2());
+
+		return m->surfaces[p_surface].uv_range;
+	}
 	Vector<PoolVector<uint8_t> > mesh_surface_get_blend_shapes(RID p_mesh, int p_surface) const {
 		DummyMesh *m = mesh_owner.getornull(p_mesh);
 		ERR_FAIL_COND_V(!m, Vector<PoolVector<uint8_t> >());
@@ -434,6 +455,7 @@ public:
 	Color multimesh_instance_get_custom_data(RID p_multimesh, int p_index) const { return Color(); }
 
 	void multimesh_set_as_bulk_array(RID p_multimesh, const PoolVector<float> &p_array) {}
+	void multimesh_set_as_bulk_array_range(RID p_multimesh, int p_from_instance, const PoolVector<float> &p_array) {}
 
 	void multimesh_set_visible_instances(RID p_multimesh, int p_visible) {}
 	int multimesh_get_visible_instances(RID p_multimesh) const { return 0; }
@@ -465,6 +487,7 @@ public:
 	int skeleton_get_bone_count(RID p_skeleton) const { return 0; }
 	void skeleton_bone_set_transform(RID p_skeleton, int p_bone, const Transform &p_transform) {}
 	Transform skeleton_bone_get_transform(RID p_skeleton, int p_bone) const { return Transform(); }
+	void skeleton_set_bone_transforms(RID p_skeleton, const PoolVector<float> &p_transforms) {}
 	void skeleton_bone_set_transform_2d(RID p_skeleton, int p_bone, const Transform2D &p_transform) {}
 	Transform2D skeleton_bone_get_transform_2d(RID p_skeleton, int p_bone) const { return Transform2D(); }
 
@@ -784,6 +807,7 @@ public:
 	void restore_render_target() {}
 	void clear_render_target(const Color &p_color) {}
 	void blit_render_target_to_screen(RID p_render_target, const Rect2 &p_screen_rect, int p_screen = 0) {}
+	void blit_render_target_to_current(RID p_render_target, float p_sharpness) {}
 	void output_lens_distorted_to_screen(RID p_render_target, const Rect2 &p_screen_rect, float p_k1, float p_k2, const Vector2 &p_eye_center, float p_oversample) {}
 	void end_frame(bool p_swap_buffers) {}
 	void finalize() {}
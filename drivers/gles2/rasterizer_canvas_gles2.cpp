@@ -433,6 +433,325 @@ void RasterizerCanvasGLES2::_draw_gui_primitive(int p_points, const Vector2 *p_v
 	glBindBuffer(GL_ARRAY_BUFFER, 0);
 }
 
+bool RasterizerCanvasGLES2::_batch_reserve(const RID &p_texture, int p_vertex_count, int p_index_count) {
+
+	if (p_vertex_count > batch.max_vertices || p_index_count > batch.max_indices)
+		return false;
+
+	if (batch.texture != p_texture || batch.vertex_count + p_vertex_count > batch.max_vertices || batch.index_count + p_index_count > batch.max_indices) {
+		_batch_flush();
+		batch.texture = p_texture;
+	}
+
+	return true;
+}
+
+void RasterizerCanvasGLES2::_batch_push_quad(const Vector2 *p_points, const Vector2 *p_uvs, const Color &p_color) {
+
+	Transform2D xform = state.uniforms.modelview_matrix * state.uniforms.extra_matrix;
+	Color color = p_color * state.uniforms.final_modulate;
+
+	uint16_t base = batch.vertex_count;
+	BatchVertex *v = &batch.vertices[base];
+
+	for (int i = 0; i < 4; i++) {
+		v[i].pos = xform.xform(p_points[i]);
+		v[i].uv = p_uvs[i];
+		v[i].color = color;
+	}
+
+	uint16_t *idx = &batch.indices[batch.index_count];
+	idx[0] = base + 0;
+	idx[1] = base + 1;
+	idx[2] = base + 2;
+	idx[3] = base + 2;
+	idx[4] = base + 3;
+	idx[5] = base + 0;
+
+	batch.vertex_count += 4;
+	batch.index_count += 6;
+}
+
+bool RasterizerCanvasGLES2::_batch_add_rect(const Item::CommandRect *p_rect) {
+
+	if (p_rect->normal_map.is_valid() || p_rect->flags & CANVAS_RECT_CLIP_UV)
+		return false;
+
+	Size2 texpixel_size(1, 1);
+
+	if (p_rect->texture.is_valid()) {
+
+		RasterizerStorageGLES2::Texture *texture = storage->texture_owner.getornull(p_rect->texture);
+		if (!texture)
+			return false;
+
+		texture = texture->get_ptr();
+		if (!texture->width || !texture->height)
+			return false;
+
+		if (p_rect->flags & CANVAS_RECT_TILE)
+			return false; //needs wrap mode switched around the draw, or forced repeat in the shader
+
+		texpixel_size = Size2(1.0 / texture->width, 1.0 / texture->height);
+	}
+
+	if (!_batch_reserve(p_rect->texture, 4, 6))
+		return false;
+
+	Vector2 points[4] = {
+		p_rect->rect.position,
+		p_rect->rect.position + Vector2(p_rect->rect.size.x, 0.0),
+		p_rect->rect.position + p_rect->rect.size,
+		p_rect->rect.position + Vector2(0.0, p_rect->rect.size.y),
+	};
+
+	if (p_rect->rect.size.x < 0) {
+		SWAP(points[0], points[1]);
+		SWAP(points[2], points[3]);
+	}
+	if (p_rect->rect.size.y < 0) {
+		SWAP(points[0], points[3]);
+		SWAP(points[1], points[2]);
+	}
+
+	Rect2 src_rect = (p_rect->texture.is_valid() && p_rect->flags & CANVAS_RECT_REGION) ? Rect2(p_rect->source.position * texpixel_size, p_rect->source.size * texpixel_size) : Rect2(0, 0, 1, 1);
+
+	Vector2 uvs[4] = {
+		src_rect.position,
+		src_rect.position + Vector2(src_rect.size.x, 0.0),
+		src_rect.position + src_rect.size,
+		src_rect.position + Vector2(0.0, src_rect.size.y),
+	};
+
+	if (p_rect->flags & CANVAS_RECT_TRANSPOSE) {
+		SWAP(uvs[1], uvs[3]);
+	}
+
+	if (p_rect->flags & CANVAS_RECT_FLIP_H) {
+		SWAP(uvs[0], uvs[1]);
+		SWAP(uvs[2], uvs[3]);
+	}
+	if (p_rect->flags & CANVAS_RECT_FLIP_V) {
+		SWAP(uvs[0], uvs[3]);
+		SWAP(uvs[1], uvs[2]);
+	}
+
+	_batch_push_quad(points, uvs, p_rect->modulate);
+
+	return true;
+}
+
+bool RasterizerCanvasGLES2::_batch_add_ninepatch(const Item::CommandNinePatch *p_np) {
+
+	if (p_np->normal_map.is_valid())
+		return false;
+
+	RasterizerStorageGLES2::Texture *texture = storage->texture_owner.getornull(p_np->texture);
+	if (!texture)
+		return false;
+
+	texture = texture->get_ptr();
+	if (!texture->width || !texture->height)
+		return false;
+
+	if (!_batch_reserve(p_np->texture, 16, 9 * 6))
+		return false;
+
+	Size2 texpixel_size(1.0 / texture->width, 1.0 / texture->height);
+
+	Rect2 source = p_np->source;
+	if (source.size.x == 0 && source.size.y == 0) {
+		source.size.x = texture->width;
+		source.size.y = texture->height;
+	}
+
+	const Rect2 &rect = p_np->rect;
+
+	const real_t x[4] = {
+		rect.position.x,
+		rect.position.x + p_np->margin[MARGIN_LEFT],
+		rect.position.x + rect.size.x - p_np->margin[MARGIN_RIGHT],
+		rect.position.x + rect.size.x
+	};
+	const real_t y[4] = {
+		rect.position.y,
+		rect.position.y + p_np->margin[MARGIN_TOP],
+		rect.position.y + rect.size.y - p_np->margin[MARGIN_BOTTOM],
+		rect.position.y + rect.size.y
+	};
+	const real_t u[4] = {
+		source.position.x * texpixel_size.x,
+		(source.position.x + p_np->margin[MARGIN_LEFT]) * texpixel_size.x,
+		(source.position.x + source.size.x - p_np->margin[MARGIN_RIGHT]) * texpixel_size.x,
+		(source.position.x + source.size.x) * texpixel_size.x
+	};
+	const real_t v[4] = {
+		source.position.y * texpixel_size.y,
+		(source.position.y + p_np->margin[MARGIN_TOP]) * texpixel_size.y,
+		(source.position.y + source.size.y - p_np->margin[MARGIN_BOTTOM]) * texpixel_size.y,
+		(source.position.y + source.size.y) * texpixel_size.y
+	};
+
+	Transform2D xform = state.uniforms.modelview_matrix * state.uniforms.extra_matrix;
+	Color color = p_np->color * state.uniforms.final_modulate;
+
+	uint16_t base = batch.vertex_count;
+	BatchVertex *bv = &batch.vertices[base];
+
+	for (int j = 0; j < 4; j++) {
+		for (int i = 0; i < 4; i++) {
+			BatchVertex &vtx = bv[j * 4 + i];
+			vtx.pos = xform.xform(Vector2(x[i], y[j]));
+			vtx.uv = Vector2(u[i], v[j]);
+			vtx.color = color;
+		}
+	}
+
+	uint16_t *idx = &batch.indices[batch.index_count];
+	int index_count = 0;
+
+	for (int j = 0; j < 3; j++) {
+		for (int i = 0; i < 3; i++) {
+
+			if (i == 1 && j == 1 && !p_np->draw_center)
+				continue;
+
+			uint16_t corner = base + j * 4 + i;
+			idx[index_count++] = corner;
+			idx[index_count++] = corner + 1;
+			idx[index_count++] = corner + 5;
+			idx[index_count++] = corner + 5;
+			idx[index_count++] = corner + 4;
+			idx[index_count++] = corner;
+		}
+	}
+
+	batch.vertex_count += 16;
+	batch.index_count += index_count;
+
+	return true;
+}
+
+bool RasterizerCanvasGLES2::_batch_add_polygon(const Item::CommandPolygon *p_polygon) {
+
+	if (p_polygon->normal_map.is_valid() || p_polygon->bones.size() || p_polygon->antialiased)
+		return false;
+
+	int vertex_count = p_polygon->points.size();
+	if (!vertex_count || !p_polygon->count)
+		return false;
+
+	if (p_polygon->texture.is_valid() && !storage->texture_owner.getornull(p_polygon->texture))
+		return false;
+
+	if (!_batch_reserve(p_polygon->texture, vertex_count, p_polygon->count))
+		return false;
+
+	Transform2D xform = state.uniforms.modelview_matrix * state.uniforms.extra_matrix;
+
+	const Vector2 *points = p_polygon->points.ptr();
+	const Vector2 *uvs = p_polygon->uvs.size() == vertex_count ? p_polygon->uvs.ptr() : NULL;
+	const Color *colors = p_polygon->colors.ptr();
+	bool single_color = p_polygon->colors.size() != vertex_count;
+	Color color = p_polygon->colors.size() == 1 ? colors[0] * state.uniforms.final_modulate : state.uniforms.final_modulate;
+
+	uint16_t base = batch.vertex_count;
+	BatchVertex *bv = &batch.vertices[base];
+
+	for (int i = 0; i < vertex_count; i++) {
+		bv[i].pos = xform.xform(points[i]);
+		bv[i].uv = uvs ? uvs[i] : Vector2();
+		bv[i].color = single_color ? color : colors[i] * state.uniforms.final_modulate;
+	}
+
+	const int *indices = p_polygon->indices.ptr();
+	uint16_t *idx = &batch.indices[batch.index_count];
+
+	for (int i = 0; i < p_polygon->count; i++) {
+		idx[i] = base + indices[i];
+	}
+
+	batch.vertex_count += vertex_count;
+	batch.index_count += p_polygon->count;
+
+	return true;
+}
+
+bool RasterizerCanvasGLES2::_batch_can_join(const Item *p_item) const {
+
+	const Item *prev = batch.item;
+
+	if (!batch.join_items || !prev || prev == p_item)
+		return false;
+
+	if (p_item->final_clip_owner != prev->final_clip_owner || p_item->copy_back_buffer || p_item->distance_field != prev->distance_field)
+		return false;
+
+	if (p_item->skeleton.is_valid() || prev->skeleton.is_valid())
+		return false;
+
+	//items using a material may bind a custom shader, which expects local vertex coordinates
+	const Item *material_owner = p_item->material_owner ? p_item->material_owner : p_item;
+	const Item *prev_material_owner = prev->material_owner ? prev->material_owner : prev;
+
+	return !material_owner->material.is_valid() && !prev_material_owner->material.is_valid();
+}
+
+void RasterizerCanvasGLES2::_batch_flush() {
+
+	if (!batch.index_count) {
+		batch.vertex_count = 0;
+		return;
+	}
+
+	state.canvas_shader.set_conditional(CanvasShaderGLES2::USE_TEXTURE_RECT, false);
+	if (state.canvas_shader.bind()) {
+		_set_uniforms();
+	}
+
+	RasterizerStorageGLES2::Texture *texture = _bind_canvas_texture(batch.texture, RID());
+
+	if (texture) {
+		Size2 texpixel_size(1.0 / texture->width, 1.0 / texture->height);
+		state.canvas_shader.set_uniform(CanvasShaderGLES2::COLOR_TEXPIXEL_SIZE, texpixel_size);
+	}
+
+	//vertices are already in canvas space and modulated
+	state.canvas_shader.set_uniform(CanvasShaderGLES2::FINAL_MODULATE, Color(1, 1, 1, 1));
+	state.canvas_shader.set_uniform(CanvasShaderGLES2::MODELVIEW_MATRIX, Transform2D());
+	state.canvas_shader.set_uniform(CanvasShaderGLES2::EXTRA_MATRIX, Transform2D());
+
+	glBindBuffer(GL_ARRAY_BUFFER, data.batch_vertex_buffer);
+	glBufferSubData(GL_ARRAY_BUFFER, 0, sizeof(BatchVertex) * batch.vertex_count, batch.vertices);
+
+	glEnableVertexAttribArray(VS::ARRAY_VERTEX);
+	glVertexAttribPointer(VS::ARRAY_VERTEX, 2, GL_FLOAT, GL_FALSE, sizeof(BatchVertex), CAST_INT_TO_UCHAR_PTR(offsetof(BatchVertex, pos)));
+	glEnableVertexAttribArray(VS::ARRAY_TEX_UV);
+	glVertexAttribPointer(VS::ARRAY_TEX_UV, 2, GL_FLOAT, GL_FALSE, sizeof(BatchVertex), CAST_INT_TO_UCHAR_PTR(offsetof(BatchVertex, uv)));
+	glEnableVertexAttribArray(VS::ARRAY_COLOR);
+	glVertexAttribPointer(VS::ARRAY_COLOR, 4, GL_FLOAT, GL_FALSE, sizeof(BatchVertex), CAST_INT_TO_UCHAR_PTR(offsetof(BatchVertex, color)));
+
+	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, data.batch_index_buffer);
+	glBufferSubData(GL_ELEMENT_ARRAY_BUFFER, 0, sizeof(uint16_t) * batch.index_count, batch.indices);
+
+	glDrawElements(GL_TRIANGLES, batch.index_count, GL_UNSIGNED_SHORT, 0);
+
+	glDisableVertexAttribArray(VS::ARRAY_COLOR);
+	glDisableVertexAttribArray(VS::ARRAY_TEX_UV);
+
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+
+	storage->info.render.canvas_batch_count++;
+
+	state.canvas_shader.set_uniform(CanvasShaderGLES2::FINAL_MODULATE, state.uniforms.final_modulate);
+	state.canvas_shader.set_uniform(CanvasShaderGLES2::MODELVIEW_MATRIX, state.uniforms.modelview_matrix);
+	state.canvas_shader.set_uniform(CanvasShaderGLES2::EXTRA_MATRIX, state.uniforms.extra_matrix);
+
+	batch.vertex_count = 0;
+	batch.index_count = 0;
+}
+
 static const GLenum gl_primitive[] = {
 	GL_POINTS,
 	GL_LINES,
@@ -448,10 +767,39 @@ void RasterizerCanvasGLES2::_canvas_item_render_commands(Item *p_item, Item *cur
 	int command_count = p_item->commands.size();
 	Item::Command **commands = p_item->commands.ptrw();
 
+	batch.item = p_item;
+
 	for (int i = 0; i < command_count; i++) {
 
 		Item::Command *command = commands[i];
 
+		if (batch.active) {
+
+			bool batched = false;
+
+			switch (command->type) {
+				case Item::Command::TYPE_RECT: {
+					batched = _batch_add_rect(static_cast<Item::CommandRect *>(command));
+				} break;
+				case Item::Command::TYPE_NINEPATCH: {
+					batched = _batch_add_ninepatch(static_cast<Item::CommandNinePatch *>(command));
+				} break;
+				case Item::Command::TYPE_POLYGON: {
+					batched = _batch_add_polygon(static_cast<Item::CommandPolygon *>(command));
+				} break;
+				default: {
+				}
+			}
+
+			if (batched)
+				continue;
+
+			if (command->type != Item::Command::TYPE_TRANSFORM) {
+				//extra matrix is applied when vertices are added, so transforms don't break the batch
+				_batch_flush();
+			}
+		}
+
 		switch (command->type) {
 
 			case Item::Command::TYPE_LINE: {
@@ -1244,6 +1592,8 @@ void RasterizerCanvasGLES2::_copy_screen(const Rect2 &p_rect) {
 
 void RasterizerCanvasGLES2::_copy_texscreen(const Rect2 &p_rect) {
 
+	_batch_flush();
+
 	state.canvas_texscreen_used = true;
 
 	_copy_screen(p_rect);
@@ -1277,10 +1627,17 @@ void RasterizerCanvasGLES2::canvas_render_items(Item *p_item_list, int p_z, cons
 
 	RID canvas_last_material = RID();
 
+	batch.item = NULL;
+	batch.texture = RID();
+
 	while (p_item_list) {
 
 		Item *ci = p_item_list;
 
+		if (!_batch_can_join(ci)) {
+			_batch_flush();
+		}
+
 		if (current_clip != ci->final_clip_owner) {
 
 			current_clip = ci->final_clip_owner;
@@ -1504,6 +1861,8 @@ void RasterizerCanvasGLES2::canvas_render_items(Item *p_item_list, int p_z, cons
 
 		_set_uniforms();
 
+		batch.active = batch.enabled && !shader_cache && !skeleton;
+
 		if (unshaded || (state.uniforms.final_modulate.a > 0.001 && (!shader_cache || shader_cache->canvas_item.light_mode != RasterizerStorageGLES2::Shader::CanvasItem::LIGHT_MODE_LIGHT_ONLY) && !ci->light_masked))
 			_canvas_item_render_commands(p_item_list, NULL, reclip, material_ptr);
 
@@ -1522,6 +1881,11 @@ void RasterizerCanvasGLES2::canvas_render_items(Item *p_item_list, int p_z, cons
 
 					//intersects this light
 
+					if (!light_used) {
+						//the unlit pass must reach the screen before blending changes
+						_batch_flush();
+					}
+
 					if (!light_used || mode != light->mode) {
 
 						mode = light->mode;
@@ -1584,6 +1948,7 @@ void RasterizerCanvasGLES2::canvas_render_items(Item *p_item_list, int p_z, cons
 
 					glActiveTexture(GL_TEXTURE0);
 					_canvas_item_render_commands(p_item_list, NULL, reclip, material_ptr); //redraw using light
+					_batch_flush();
 
 					state.using_light = NULL;
 				}
@@ -1633,6 +1998,7 @@ void RasterizerCanvasGLES2::canvas_render_items(Item *p_item_list, int p_z, cons
 		}
 
 		if (reclip) {
+			_batch_flush();
 			glEnable(GL_SCISSOR_TEST);
 			int y = storage->frame.current_rt->height - (current_clip->final_clip_rect.position.y + current_clip->final_clip_rect.size.y);
 			if (storage->frame.current_rt->flags[RasterizerStorage::RENDER_TARGET_VFLIP])
@@ -1643,6 +2009,9 @@ void RasterizerCanvasGLES2::canvas_render_items(Item *p_item_list, int p_z, cons
 		p_item_list = p_item_list->next;
 	}
 
+	_batch_flush();
+	batch.item = NULL;
+
 	if (current_clip) {
 		glDisable(GL_SCISSOR_TEST);
 	}
@@ -2014,6 +2383,36 @@ void RasterizerCanvasGLES2::initialize() {
 		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
 	}
 
+	// batching buffers
+	{
+		batch.enabled = GLOBAL_DEF("rendering/quality/2d/use_batching", true);
+		batch.join_items = GLOBAL_DEF("rendering/quality/2d/batch_join_items", true);
+
+		uint32_t batch_size = GLOBAL_DEF("rendering/limits/buffers/canvas_batch_buffer_size_kb", 256);
+		ProjectSettings::get_singleton()->set_custom_property_info("rendering/limits/buffers/canvas_batch_buffer_size_kb", PropertyInfo(Variant::INT, "rendering/limits/buffers/canvas_batch_buffer_size_kb", PROPERTY_HINT_RANGE, "0,1024,1,or_greater"));
+		batch_size *= 1024; // kb
+
+		// indices are 16 bits, and any batch must at least fit a nine-patch
+		batch.max_vertices = CLAMP(int(batch_size / sizeof(BatchVertex)), 16, 65536);
+		batch.max_indices = batch.max_vertices * 3;
+		batch.vertices = memnew_arr(BatchVertex, batch.max_vertices);
+		batch.indices = memnew_arr(uint16_t, batch.max_indices);
+		batch.vertex_count = 0;
+		batch.index_count = 0;
+		batch.item = NULL;
+		batch.active = false;
+
+		glGenBuffers(1, &data.batch_vertex_buffer);
+		glBindBuffer(GL_ARRAY_BUFFER, data.batch_vertex_buffer);
+		glBufferData(GL_ARRAY_BUFFER, sizeof(BatchVertex) * batch.max_vertices, NULL, GL_DYNAMIC_DRAW);
+		glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+		glGenBuffers(1, &data.batch_index_buffer);
+		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, data.batch_index_buffer);
+		glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(uint16_t) * batch.max_indices, NULL, GL_DYNAMIC_DRAW);
+		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+	}
+
 	state.canvas_shadow_shader.init();
 
 	state.canvas_shader.init();
@@ -2033,9 +2432,29 @@ void RasterizerCanvasGLES2::initialize() {
 }
 
 void RasterizerCanvasGLES2::finalize() {
+
+	glDeleteBuffers(1, &data.batch_vertex_buffer);
+	glDeleteBuffers(1, &data.batch_index_buffer);
+
+	memdelete_arr(batch.vertices);
+	memdelete_arr(batch.indices);
+	batch.vertices = NULL;
+	batch.indices = NULL;
 }
 
 RasterizerCanvasGLES2::RasterizerCanvasGLES2() {
+
+	batch.vertices = NULL;
+	batch.indices = NULL;
+	batch.vertex_count = 0;
+	batch.index_count = 0;
+	batch.max_vertices = 0;
+	batch.max_indices = 0;
+	batch.item = NULL;
+	batch.enabled = false;
+	batch.join_items = false;
+	batch.active = false;
+
 #ifdef GLES_OVER_GL
 	use_nvidia_rect_workaround = GLOBAL_GET("rendering/quality/2d/gles2_use_nvidia_rect_flicker_workaround");
 #else
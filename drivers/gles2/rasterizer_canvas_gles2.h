@@ -69,6 +69,9 @@ public:
 		GLuint ninepatch_vertices;
 		GLuint ninepatch_elements;
 
+		GLuint batch_vertex_buffer;
+		GLuint batch_index_buffer;
+
 	} data;
 
 	struct State {
@@ -97,6 +100,33 @@ public:
 
 	} state;
 
+	struct BatchVertex {
+
+		Vector2 pos;
+		Vector2 uv;
+		Color color;
+	};
+
+	// Consecutive rects, nine-patches and polygons sharing texture and item state are
+	// transformed on the CPU and drawn with a single glDrawElements call.
+	struct Batch {
+
+		BatchVertex *vertices;
+		uint16_t *indices;
+		int vertex_count;
+		int index_count;
+		int max_vertices;
+		int max_indices;
+
+		RID texture;
+		Item *item;
+
+		bool enabled;
+		bool join_items;
+		bool active;
+
+	} batch;
+
 	typedef void Texture;
 
 	RasterizerSceneGLES2 *scene_render;
@@ -118,6 +148,14 @@ public:
 	_FORCE_INLINE_ void _draw_polygon(const int *p_indices, int p_index_count, int p_vertex_count, const Vector2 *p_vertices, const Vector2 *p_uvs, const Color *p_colors, bool p_singlecolor, const float *p_weights = NULL, const int *p_bones = NULL);
 	_FORCE_INLINE_ void _draw_generic(GLuint p_primitive, int p_vertex_count, const Vector2 *p_vertices, const Vector2 *p_uvs, const Color *p_colors, bool p_singlecolor);
 
+	_FORCE_INLINE_ bool _batch_reserve(const RID &p_texture, int p_vertex_count, int p_index_count);
+	_FORCE_INLINE_ void _batch_push_quad(const Vector2 *p_points, const Vector2 *p_uvs, const Color &p_color);
+	bool _batch_add_rect(const Item::CommandRect *p_rect);
+	bool _batch_add_ninepatch(const Item::CommandNinePatch *p_np);
+	bool _batch_add_polygon(const Item::CommandPolygon *p_polygon);
+	bool _batch_can_join(const Item *p_item) const;
+	void _batch_flush();
+
 	_FORCE_INLINE_ void _canvas_item_render_commands(Item *p_item, Item *current_clip, bool &reclip, RasterizerStorageGLES2::Material *p_material);
 	void _copy_screen(const Rect2 &p_rect);
 	_FORCE_INLINE_ void _copy_texscreen(const Rect2 &p_rect);
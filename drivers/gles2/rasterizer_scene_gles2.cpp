@@ -1342,6 +1342,65 @@ bool RasterizerSceneGLES2::_setup_material(RasterizerStorageGLES2::Material *p_m
 	return shader_rebind;
 }
 
+void RasterizerSceneGLES2::_skin_vertices_block(uint32_t p_block, SkinningJob *p_job) {
+
+	static const float identity[12] = { 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0 };
+
+	int from = p_block * SKINNING_BLOCK_SIZE;
+	int to = MIN(from + SKINNING_BLOCK_SIZE, p_job->vertex_count);
+
+	for (int i = from; i < to; i++) {
+
+		int bones[4];
+		float bone_weight[4];
+
+		if (p_job->bones_short) {
+			const uint16_t *bones_ptr = (const uint16_t *)(p_job->vertex_data + p_job->bones_offset + (i * p_job->bones_stride));
+			bones[0] = bones_ptr[0];
+			bones[1] = bones_ptr[1];
+			bones[2] = bones_ptr[2];
+			bones[3] = bones_ptr[3];
+		} else {
+			const uint8_t *bones_ptr = p_job->vertex_data + p_job->bones_offset + (i * p_job->bones_stride);
+			bones[0] = bones_ptr[0];
+			bones[1] = bones_ptr[1];
+			bones[2] = bones_ptr[2];
+			bones[3] = bones_ptr[3];
+		}
+
+		if (p_job->weights_float) {
+			const float *weight_ptr = (const float *)(p_job->vertex_data + p_job->weights_offset + (i * p_job->weights_stride));
+			bone_weight[0] = weight_ptr[0];
+			bone_weight[1] = weight_ptr[1];
+			bone_weight[2] = weight_ptr[2];
+			bone_weight[3] = weight_ptr[3];
+		} else {
+			// read as half
+			const uint16_t *weight_ptr = (const uint16_t *)(p_job->vertex_data + p_job->weights_offset + (i * p_job->weights_stride));
+			bone_weight[0] = (weight_ptr[0] / (float)0xFFFF);
+			bone_weight[1] = (weight_ptr[1] / (float)0xFFFF);
+			bone_weight[2] = (weight_ptr[2] / (float)0xFFFF);
+			bone_weight[3] = (weight_ptr[3] / (float)0xFFFF);
+		}
+
+		// bone data is already stored as the three rows the shader expects, so they can be blended directly
+		float *row = &p_job->transform_buffer[i * 12];
+
+		for (int k = 0; k < 12; k++) {
+			row[k] = 0;
+		}
+
+		for (int j = 0; j < 4; j++) {
+
+			const float *bone = bones[j] < p_job->bone_count ? &p_job->bone_data[bones[j] * 12] : identity;
+
+			for (int k = 0; k < 12; k++) {
+				row[k] += bone[k] * bone_weight[j];
+			}
+		}
+	}
+}
+
 void RasterizerSceneGLES2::_setup_geometry(RenderList::Element *p_element, RasterizerStorageGLES2::Skeleton *p_skeleton) {
 
 	switch (p_element->instance->base_type) {
@@ -1352,7 +1411,8 @@ void RasterizerSceneGLES2::_setup_geometry(RenderList::Element *p_element, Raste
 			glBindBuffer(GL_ARRAY_BUFFER, s->vertex_id);
 
 			if (s->index_array_len > 0) {
-				glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, s->index_id);
+				bool use_lod = s->get_lod(p_element->instance->lod_error_limit) >= 0;
+				glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, use_lod ? s->lod_index_id : s->index_id);
 			}
 
 			for (int i = 0; i < VS::ARRAY_MAX - 1; i++) {
@@ -1374,14 +1434,17 @@ void RasterizerSceneGLES2::_setup_geometry(RenderList::Element *p_element, Raste
 				}
 			}
 
-			bool clear_skeleton_buffer = !storage->config.float_texture_supported;
+			bool clear_skeleton_buffer = !storage->config.use_skeleton_texture;
 
 			if (p_skeleton) {
 
-				if (storage->config.float_texture_supported) {
+				if (storage->config.use_skeleton_texture) {
 					//use float texture workflow
 					glActiveTexture(GL_TEXTURE0 + storage->config.max_texture_image_units - 1);
 					glBindTexture(GL_TEXTURE_2D, p_skeleton->tex_id);
+				} else if (_use_skeleton_uniforms(p_skeleton)) {
+					//bone palette goes in a uniform array, uploaded once the shader is bound
+					ERR_FAIL_COND(p_skeleton->use_2d);
 				} else {
 					//use transform buffer workflow
 					ERR_FAIL_COND(p_skeleton->use_2d);
@@ -1397,88 +1460,25 @@ void RasterizerSceneGLES2::_setup_geometry(RenderList::Element *p_element, Raste
 						transform_buffer.resize(s->array_len * 12);
 					}
 
-					const size_t bones_offset = s->attribs[VS::ARRAY_BONES].offset;
-					const size_t bones_stride = s->attribs[VS::ARRAY_BONES].stride;
-					const size_t bone_weight_offset = s->attribs[VS::ARRAY_WEIGHTS].offset;
-					const size_t bone_weight_stride = s->attribs[VS::ARRAY_WEIGHTS].stride;
-
 					{
 						PoolVector<float>::Write write = transform_buffer.write();
-						float *buffer = write.ptr();
-
 						PoolVector<uint8_t>::Read vertex_array_read = s->data.read();
-						const uint8_t *vertex_data = vertex_array_read.ptr();
-
-						for (int i = 0; i < s->array_len; i++) {
-
-							// do magic
-
-							size_t bones[4];
-							float bone_weight[4];
-
-							if (s->attribs[VS::ARRAY_BONES].type == GL_UNSIGNED_BYTE) {
-								// read as byte
-								const uint8_t *bones_ptr = vertex_data + bones_offset + (i * bones_stride);
-								bones[0] = bones_ptr[0];
-								bones[1] = bones_ptr[1];
-								bones[2] = bones_ptr[2];
-								bones[3] = bones_ptr[3];
-							} else {
-								// read as short
-								const uint16_t *bones_ptr = (const uint16_t *)(vertex_data + bones_offset + (i * bones_stride));
-								bones[0] = bones_ptr[0];
-								bones[1] = bones_ptr[1];
-								bones[2] = bones_ptr[2];
-								bones[3] = bones_ptr[3];
-							}
-
-							if (s->attribs[VS::ARRAY_WEIGHTS].type == GL_FLOAT) {
-								// read as float
-								const float *weight_ptr = (const float *)(vertex_data + bone_weight_offset + (i * bone_weight_stride));
-								bone_weight[0] = weight_ptr[0];
-								bone_weight[1] = weight_ptr[1];
-								bone_weight[2] = weight_ptr[2];
-								bone_weight[3] = weight_ptr[3];
-							} else {
-								// read as half
-								const uint16_t *weight_ptr = (const uint16_t *)(vertex_data + bone_weight_offset + (i * bone_weight_stride));
-								bone_weight[0] = (weight_ptr[0] / (float)0xFFFF);
-								bone_weight[1] = (weight_ptr[1] / (float)0xFFFF);
-								bone_weight[2] = (weight_ptr[2] / (float)0xFFFF);
-								bone_weight[3] = (weight_ptr[3] / (float)0xFFFF);
-							}
-
-							Transform transform;
-
-							Transform bone_transforms[4] = {
-								storage->skeleton_bone_get_transform(p_element->instance->skeleton, bones[0]),
-								storage->skeleton_bone_get_transform(p_element->instance->skeleton, bones[1]),
-								storage->skeleton_bone_get_transform(p_element->instance->skeleton, bones[2]),
-								storage->skeleton_bone_get_transform(p_element->instance->skeleton, bones[3]),
-							};
-
-							transform.origin =
-									bone_weight[0] * bone_transforms[0].origin +
-									bone_weight[1] * bone_transforms[1].origin +
-									bone_weight[2] * bone_transforms[2].origin +
-									bone_weight[3] * bone_transforms[3].origin;
-
-							transform.basis =
-									bone_transforms[0].basis * bone_weight[0] +
-									bone_transforms[1].basis * bone_weight[1] +
-									bone_transforms[2].basis * bone_weight[2] +
-									bone_transforms[3].basis * bone_weight[3];
-
-							float row[3][4] = {
-								{ transform.basis[0][0], transform.basis[0][1], transform.basis[0][2], transform.origin[0] },
-								{ transform.basis[1][0], transform.basis[1][1], transform.basis[1][2], transform.origin[1] },
-								{ transform.basis[2][0], transform.basis[2][1], transform.basis[2][2], transform.origin[2] },
-							};
-
-							size_t transform_buffer_offset = i * 12;
-
-							copymem(&buffer[transform_buffer_offset], row, sizeof(row));
-						}
+
+						SkinningJob job;
+						job.vertex_data = vertex_array_read.ptr();
+						job.transform_buffer = write.ptr();
+						job.bone_data = p_skeleton->bone_data.ptr();
+						job.bone_count = p_skeleton->size;
+						job.vertex_count = s->array_len;
+						job.bones_offset = s->attribs[VS::ARRAY_BONES].offset;
+						job.bones_stride = s->attribs[VS::ARRAY_BONES].stride;
+						job.bones_short = s->attribs[VS::ARRAY_BONES].type != GL_UNSIGNED_BYTE;
+						job.weights_offset = s->attribs[VS::ARRAY_WEIGHTS].offset;
+						job.weights_stride = s->attribs[VS::ARRAY_WEIGHTS].stride;
+						job.weights_float = s->attribs[VS::ARRAY_WEIGHTS].type == GL_FLOAT;
+
+						uint32_t blocks = (s->array_len + SKINNING_BLOCK_SIZE - 1) / SKINNING_BLOCK_SIZE;
+						skinning_pool.do_work(blocks, this, &RasterizerSceneGLES2::_skin_vertices_block, &job);
 					}
 
 					storage->_update_skeleton_transform_buffer(transform_buffer, s->array_len * 12);
@@ -1565,7 +1565,13 @@ void RasterizerSceneGLES2::_render_geometry(RenderList::Element *p_element) {
 			// drawing
 
 			if (s->index_array_len > 0) {
-				glDrawElements(gl_primitive[s->primitive], s->index_array_len, (s->array_len >= (1 << 16)) ? GL_UNSIGNED_INT : GL_UNSIGNED_SHORT, 0);
+				int lod = s->get_lod(p_element->instance->lod_error_limit);
+				if (lod >= 0) {
+					const RasterizerStorageGLES2::Surface::LOD &l = s->lods[lod];
+					glDrawElements(gl_primitive[s->primitive], l.index_count, (s->array_len >= (1 << 16)) ? GL_UNSIGNED_INT : GL_UNSIGNED_SHORT, CAST_INT_TO_UCHAR_PTR(l.index_offset));
+				} else {
+					glDrawElements(gl_primitive[s->primitive], s->index_array_len, (s->array_len >= (1 << 16)) ? GL_UNSIGNED_INT : GL_UNSIGNED_SHORT, 0);
+				}
 			} else {
 				glDrawArrays(gl_primitive[s->primitive], 0, s->array_len);
 			}
@@ -2141,6 +2147,7 @@ void RasterizerSceneGLES2::_render_render_list(RenderList::Element **p_elements,
 
 	bool prev_unshaded = false;
 	bool prev_instancing = false;
+	bool prev_octahedral_normals = false;
 	bool prev_depth_prepass = false;
 	state.scene_shader.set_conditional(SceneShaderGLES2::SHADELESS, false);
 	RasterizerStorageGLES2::Material *prev_material = NULL;
@@ -2372,15 +2379,32 @@ void RasterizerSceneGLES2::_render_render_list(RenderList::Element **p_elements,
 			rebind = true;
 		}
 
+		const RasterizerStorageGLES2::Surface *surface = NULL;
+		if (e->geometry->type == RasterizerStorageGLES2::Geometry::GEOMETRY_SURFACE) {
+			surface = static_cast<const RasterizerStorageGLES2::Surface *>(e->geometry);
+		}
+		uint32_t surface_format = surface ? surface->format : 0;
+
+		bool octahedral_normals = surface_format & VS::ARRAY_FLAG_USE_OCTAHEDRAL_NORMALS;
+
+		if (octahedral_normals != prev_octahedral_normals) {
+
+			state.scene_shader.set_conditional(SceneShaderGLES2::USE_OCTAHEDRAL_NORMALS, octahedral_normals);
+			rebind = true;
+		}
+
 		RasterizerStorageGLES2::Skeleton *skeleton = storage->skeleton_owner.getornull(e->instance->skeleton);
 
 		if (skeleton != prev_skeleton) {
 
 			if (skeleton) {
+				bool use_uniforms = _use_skeleton_uniforms(skeleton);
 				state.scene_shader.set_conditional(SceneShaderGLES2::USE_SKELETON, true);
-				state.scene_shader.set_conditional(SceneShaderGLES2::USE_SKELETON_SOFTWARE, !storage->config.float_texture_supported);
+				state.scene_shader.set_conditional(SceneShaderGLES2::USE_SKELETON_UNIFORMS, use_uniforms);
+				state.scene_shader.set_conditional(SceneShaderGLES2::USE_SKELETON_SOFTWARE, !storage->config.use_skeleton_texture && !use_uniforms);
 			} else {
 				state.scene_shader.set_conditional(SceneShaderGLES2::USE_SKELETON, false);
+				state.scene_shader.set_conditional(SceneShaderGLES2::USE_SKELETON_UNIFORMS, false);
 				state.scene_shader.set_conditional(SceneShaderGLES2::USE_SKELETON_SOFTWARE, false);
 			}
 
@@ -2486,10 +2510,30 @@ void RasterizerSceneGLES2::_render_render_list(RenderList::Element **p_elements,
 
 		state.scene_shader.set_uniform(SceneShaderGLES2::WORLD_TRANSFORM, e->instance->transform);
 
+		if (surface_format & VS::ARRAY_FLAG_USE_QUANTIZED_VERTICES) {
+			state.scene_shader.set_uniform(SceneShaderGLES2::VERTEX_QUANTIZE_OFFSET, surface->aabb.position);
+			state.scene_shader.set_uniform(SceneShaderGLES2::VERTEX_QUANTIZE_SCALE, surface->aabb.size);
+		} else {
+			state.scene_shader.set_uniform(SceneShaderGLES2::VERTEX_QUANTIZE_OFFSET, Vector3());
+			state.scene_shader.set_uniform(SceneShaderGLES2::VERTEX_QUANTIZE_SCALE, Vector3(1, 1, 1));
+		}
+
+		if (surface_format & VS::ARRAY_FLAG_USE_QUANTIZED_UV) {
+			state.scene_shader.set_uniform(SceneShaderGLES2::UV_QUANTIZE_OFFSET, surface->uv_range.position);
+			state.scene_shader.set_uniform(SceneShaderGLES2::UV_QUANTIZE_SCALE, surface->uv_range.size);
+		} else {
+			state.scene_shader.set_uniform(SceneShaderGLES2::UV_QUANTIZE_OFFSET, Vector2());
+			state.scene_shader.set_uniform(SceneShaderGLES2::UV_QUANTIZE_SCALE, Vector2(1, 1));
+		}
+
 		if (skeleton) {
 			state.scene_shader.set_uniform(SceneShaderGLES2::SKELETON_IN_WORLD_COORDS, skeleton->use_world_transform);
 			state.scene_shader.set_uniform(SceneShaderGLES2::SKELETON_TRANSFORM, skeleton->world_transform);
 			state.scene_shader.set_uniform(SceneShaderGLES2::SKELETON_TRANSFORM_INVERSE, skeleton->world_transform_inverse);
+
+			if ((skeleton != prev_skeleton || shader_rebind) && skeleton->size && _use_skeleton_uniforms(skeleton)) {
+				glUniform4fv(state.scene_shader.get_uniform_location(SceneShaderGLES2::SKELETON_BONES), skeleton->size * 3, skeleton->bone_data.ptr());
+			}
 		}
 
 		if (use_lightmap_capture) { //this is per instance, must be set always if present
@@ -2504,6 +2548,7 @@ void RasterizerSceneGLES2::_render_render_list(RenderList::Element **p_elements,
 		prev_material = material;
 		prev_skeleton = skeleton;
 		prev_instancing = instancing;
+		prev_octahedral_normals = octahedral_normals;
 		prev_light = light;
 		prev_refprobe_1 = refprobe_1;
 		prev_refprobe_2 = refprobe_2;
@@ -2513,9 +2558,12 @@ void RasterizerSceneGLES2::_render_render_list(RenderList::Element **p_elements,
 
 	_setup_light_type(NULL, NULL); //clear light stuff
 	state.scene_shader.set_conditional(SceneShaderGLES2::USE_SKELETON, false);
+	state.scene_shader.set_conditional(SceneShaderGLES2::USE_SKELETON_UNIFORMS, false);
+	state.scene_shader.set_conditional(SceneShaderGLES2::USE_SKELETON_SOFTWARE, false);
 	state.scene_shader.set_conditional(SceneShaderGLES2::SHADELESS, false);
 	state.scene_shader.set_conditional(SceneShaderGLES2::BASE_PASS, false);
 	state.scene_shader.set_conditional(SceneShaderGLES2::USE_INSTANCING, false);
+	state.scene_shader.set_conditional(SceneShaderGLES2::USE_OCTAHEDRAL_NORMALS, false);
 	state.scene_shader.set_conditional(SceneShaderGLES2::USE_RADIANCE_MAP, false);
 	state.scene_shader.set_conditional(SceneShaderGLES2::LIGHT_USE_PSSM4, false);
 	state.scene_shader.set_conditional(SceneShaderGLES2::LIGHT_USE_PSSM2, false);
@@ -3207,6 +3255,7 @@ void RasterizerSceneGLES2::set_debug_draw_mode(VS::ViewportDebugDraw p_debug_dra
 }
 
 void RasterizerSceneGLES2::initialize() {
+	state.scene_shader.add_custom_define("#define MAX_SKELETON_UNIFORM_VECTORS " + itos(MAX(storage->config.max_skeleton_uniform_bones, 1) * 3) + "\n");
 	state.scene_shader.init();
 
 	state.scene_shader.set_conditional(SceneShaderGLES2::USE_RGBA_SHADOWS, storage->config.use_rgba_3d_shadows);
@@ -3214,6 +3263,11 @@ void RasterizerSceneGLES2::initialize() {
 
 	render_list.init();
 
+	if (!storage->config.use_skeleton_texture) {
+		// only needed when skinning falls back to the CPU
+		skinning_pool.init();
+	}
+
 	render_pass = 1;
 
 	shadow_atlas_realloc_tolerance_msec = 500;
@@ -3366,6 +3420,7 @@ void RasterizerSceneGLES2::iteration() {
 }
 
 void RasterizerSceneGLES2::finalize() {
+	skinning_pool.finish();
 }
 
 RasterizerSceneGLES2::RasterizerSceneGLES2() {
@@ -34,6 +34,8 @@
 /* Must come before shaders or the Windows build fails... */
 #include "rasterizer_storage_gles2.h"
 
+#include "core/os/thread_work_pool.h"
+
 #include "shaders/cube_to_dp.glsl.gen.h"
 #include "shaders/scene.glsl.gen.h"
 /*
@@ -663,6 +665,33 @@ public:
 
 	_FORCE_INLINE_ bool _setup_material(RasterizerStorageGLES2::Material *p_material, bool p_reverse_cull, bool p_alpha_pass, Size2i p_skeleton_tex_size = Size2i(0, 0));
 	_FORCE_INLINE_ void _setup_geometry(RenderList::Element *p_element, RasterizerStorageGLES2::Skeleton *p_skeleton);
+
+	enum {
+		SKINNING_BLOCK_SIZE = 256 // vertices blended per software skinning job
+	};
+
+	struct SkinningJob {
+		const uint8_t *vertex_data;
+		float *transform_buffer;
+		const float *bone_data;
+		int bone_count;
+		int vertex_count;
+		size_t bones_offset;
+		size_t bones_stride;
+		bool bones_short;
+		size_t weights_offset;
+		size_t weights_stride;
+		bool weights_float;
+	};
+
+	ThreadWorkPool skinning_pool;
+
+	void _skin_vertices_block(uint32_t p_block, SkinningJob *p_job);
+
+	_FORCE_INLINE_ bool _use_skeleton_uniforms(const RasterizerStorageGLES2::Skeleton *p_skeleton) const {
+		return !storage->config.use_skeleton_texture && p_skeleton->size <= storage->config.max_skeleton_uniform_bones;
+	}
+
 	_FORCE_INLINE_ void _setup_light_type(LightInstance *p_light, ShadowAtlas *shadow_atlas);
 	_FORCE_INLINE_ void _setup_light(LightInstance *p_light, ShadowAtlas *shadow_atlas, const Transform &p_view_transform);
 	_FORCE_INLINE_ void _setup_refprobes(ReflectionProbeInstance *p_refprobe1, ReflectionProbeInstance *p_refprobe2, const Transform &p_view_transform, Environment *p_env);
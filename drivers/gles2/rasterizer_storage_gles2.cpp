@@ -1643,6 +1643,14 @@ RID RasterizerStorageGLES2::shader_get_default_texture_param(RID p_shader, const
 	return E->get();
 }
 
+PoolIntArray RasterizerStorageGLES2::shader_get_compiled_variants(RID p_shader) const {
+
+	return PoolIntArray();
+}
+
+void RasterizerStorageGLES2::shader_precompile_variants(RID p_shader, const PoolIntArray &p_variants) {
+}
+
 /* COMMON MATERIAL API */
 
 void RasterizerStorageGLES2::_material_make_dirty(Material *p_material) const {
@@ -1964,7 +1972,10 @@ static PoolVector<uint8_t> _unpack_half_floats(const PoolVector<uint8_t> &array,
 
 			case VS::ARRAY_VERTEX: {
 
-				if (p_format & VS::ARRAY_COMPRESS_VERTEX) {
+				if (p_format & VS::ARRAY_FLAG_USE_QUANTIZED_VERTICES) {
+					src_size[i] = 8;
+					dst_size[i] = 8;
+				} else if (p_format & VS::ARRAY_COMPRESS_VERTEX) {
 
 					if (p_format & VS::ARRAY_FLAG_USE_2D_VERTICES) {
 						src_size[i] = 4;
@@ -1991,7 +2002,7 @@ static PoolVector<uint8_t> _unpack_half_floats(const PoolVector<uint8_t> &array,
 			} break;
 			case VS::ARRAY_NORMAL: {
 
-				if (p_format & VS::ARRAY_COMPRESS_NORMAL) {
+				if (p_format & (VS::ARRAY_COMPRESS_NORMAL | VS::ARRAY_FLAG_USE_OCTAHEDRAL_NORMALS)) {
 					src_size[i] = 4;
 					dst_size[i] = 4;
 				} else {
@@ -2002,7 +2013,10 @@ static PoolVector<uint8_t> _unpack_half_floats(const PoolVector<uint8_t> &array,
 			} break;
 			case VS::ARRAY_TANGENT: {
 
-				if (p_format & VS::ARRAY_COMPRESS_TANGENT) {
+				if (p_format & VS::ARRAY_FLAG_USE_OCTAHEDRAL_NORMALS) {
+					src_size[i] = 0;
+					dst_size[i] = 0;
+				} else if (p_format & VS::ARRAY_COMPRESS_TANGENT) {
 					src_size[i] = 4;
 					dst_size[i] = 4;
 				} else {
@@ -2024,16 +2038,19 @@ static PoolVector<uint8_t> _unpack_half_floats(const PoolVector<uint8_t> &array,
 			} break;
 			case VS::ARRAY_TEX_UV: {
 
-				if (p_format & VS::ARRAY_COMPRESS_TEX_UV) {
+				if (p_format & VS::ARRAY_FLAG_USE_QUANTIZED_UV) {
+					src_size[i] = 4;
+					dst_size[i] = 4;
+				} else if (p_format & VS::ARRAY_COMPRESS_TEX_UV) {
 					src_size[i] = 4;
+					dst_size[i] = 8;
 					to_convert[i] = 2;
 					format &= ~VS::ARRAY_COMPRESS_TEX_UV;
 				} else {
 					src_size[i] = 8;
+					dst_size[i] = 8;
 				}
 
-				dst_size[i] = 8;
-
 			} break;
 			case VS::ARRAY_TEX_UV2: {
 
@@ -2129,7 +2146,7 @@ static PoolVector<uint8_t> _unpack_half_floats(const PoolVector<uint8_t> &array,
 	return ret;
 }
 
-void RasterizerStorageGLES2::mesh_add_surface(RID p_mesh, uint32_t p_format, VS::PrimitiveType p_primitive, const PoolVector<uint8_t> &p_array, int p_vertex_count, const PoolVector<uint8_t> &p_index_array, int p_index_count, const AABB &p_aabb, const Vector<PoolVector<uint8_t> > &p_blend_shapes, const Vector<AABB> &p_bone_aabbs) {
+void RasterizerStorageGLES2::mesh_add_surface(RID p_mesh, uint32_t p_format, VS::PrimitiveType p_primitive, const PoolVector<uint8_t> &p_array, int p_vertex_count, const PoolVector<uint8_t> &p_index_array, int p_index_count, const AABB &p_aabb, const Vector<PoolVector<uint8_t> > &p_blend_shapes, const Vector<AABB> &p_bone_aabbs, const Rect2 &p_uv_range) {
 
 	Mesh *mesh = mesh_owner.getornull(p_mesh);
 	ERR_FAIL_COND(!mesh);
@@ -2174,7 +2191,14 @@ void RasterizerStorageGLES2::mesh_add_surface(RID p_mesh, uint32_t p_format, VS:
 					attribs[i].size = (p_format & VS::ARRAY_COMPRESS_VERTEX) ? 4 : 3;
 				}
 
-				if (p_format & VS::ARRAY_COMPRESS_VERTEX) {
+				attribs[i].normalized = GL_FALSE;
+
+				if (p_format & VS::ARRAY_FLAG_USE_QUANTIZED_VERTICES) {
+					//relative to the surface AABB, padded to 4 components
+					attribs[i].type = GL_UNSIGNED_SHORT;
+					attribs[i].normalized = GL_TRUE;
+					stride += 8;
+				} else if (p_format & VS::ARRAY_COMPRESS_VERTEX) {
 					attribs[i].type = _GL_HALF_FLOAT_OES;
 					stride += attribs[i].size * 2;
 					uses_half_float = true;
@@ -2183,14 +2207,18 @@ void RasterizerStorageGLES2::mesh_add_surface(RID p_mesh, uint32_t p_format, VS:
 					stride += attribs[i].size * 4;
 				}
 
-				attribs[i].normalized = GL_FALSE;
-
 			} break;
 			case VS::ARRAY_NORMAL: {
 
 				attribs[i].size = 3;
 
-				if (p_format & VS::ARRAY_COMPRESS_NORMAL) {
+				if (p_format & VS::ARRAY_FLAG_USE_OCTAHEDRAL_NORMALS) {
+					//normal and tangent packed in two words, unpacked by the shader
+					attribs[i].size = 2;
+					attribs[i].type = GL_UNSIGNED_SHORT;
+					stride += 4;
+					attribs[i].normalized = GL_FALSE;
+				} else if (p_format & VS::ARRAY_COMPRESS_NORMAL) {
 					attribs[i].type = GL_BYTE;
 					stride += 4; //pad extra byte
 					attribs[i].normalized = GL_TRUE;
@@ -2205,7 +2233,9 @@ void RasterizerStorageGLES2::mesh_add_surface(RID p_mesh, uint32_t p_format, VS:
 
 				attribs[i].size = 4;
 
-				if (p_format & VS::ARRAY_COMPRESS_TANGENT) {
+				if (p_format & VS::ARRAY_FLAG_USE_OCTAHEDRAL_NORMALS) {
+					attribs[i].enabled = false; //comes with the normal
+				} else if (p_format & VS::ARRAY_COMPRESS_TANGENT) {
 					attribs[i].type = GL_BYTE;
 					stride += 4;
 					attribs[i].normalized = GL_TRUE;
@@ -2234,8 +2264,13 @@ void RasterizerStorageGLES2::mesh_add_surface(RID p_mesh, uint32_t p_format, VS:
 			case VS::ARRAY_TEX_UV: {
 
 				attribs[i].size = 2;
+				attribs[i].normalized = GL_FALSE;
 
-				if (p_format & VS::ARRAY_COMPRESS_TEX_UV) {
+				if (p_format & VS::ARRAY_FLAG_USE_QUANTIZED_UV) {
+					attribs[i].type = GL_UNSIGNED_SHORT;
+					attribs[i].normalized = GL_TRUE;
+					stride += 4;
+				} else if (p_format & VS::ARRAY_COMPRESS_TEX_UV) {
 					attribs[i].type = _GL_HALF_FLOAT_OES;
 					stride += 4;
 					uses_half_float = true;
@@ -2244,8 +2279,6 @@ void RasterizerStorageGLES2::mesh_add_surface(RID p_mesh, uint32_t p_format, VS:
 					stride += 8;
 				}
 
-				attribs[i].normalized = GL_FALSE;
-
 			} break;
 			case VS::ARRAY_TEX_UV2: {
 
@@ -2354,7 +2387,7 @@ void RasterizerStorageGLES2::mesh_add_surface(RID p_mesh, uint32_t p_format, VS:
 		uint32_t new_format = p_format;
 		PoolVector<uint8_t> unpacked_array = _unpack_half_floats(array, new_format, p_vertex_count);
 
-		mesh_add_surface(p_mesh, new_format, p_primitive, unpacked_array, p_vertex_count, p_index_array, p_index_count, p_aabb, p_blend_shapes, p_bone_aabbs);
+		mesh_add_surface(p_mesh, new_format, p_primitive, unpacked_array, p_vertex_count, p_index_array, p_index_count, p_aabb, p_blend_shapes, p_bone_aabbs, p_uv_range);
 		return; //do not go any further, above function used unpacked stuff will be used instead.
 	}
 
@@ -2387,6 +2420,7 @@ void RasterizerStorageGLES2::mesh_add_surface(RID p_mesh, uint32_t p_format, VS:
 	surface->skeleton_bone_used.resize(surface->skeleton_bone_aabb.size());
 
 	surface->aabb = p_aabb;
+	surface->uv_range = p_uv_range;
 	surface->max_bone = p_bone_aabbs.size();
 #ifdef TOOLS_ENABLED
 	surface->blend_shape_data = p_blend_shapes;
@@ -2504,6 +2538,63 @@ void RasterizerStorageGLES2::mesh_surface_update_region(RID p_mesh, int p_surfac
 	glBindBuffer(GL_ARRAY_BUFFER, 0); //unbind
 }
 
+void RasterizerStorageGLES2::mesh_surface_set_lods(RID p_mesh, int p_surface, const Vector<PoolVector<uint8_t> > &p_lod_indices, const Vector<float> &p_lod_errors) {
+	Mesh *mesh = mesh_owner.getornull(p_mesh);
+
+	ERR_FAIL_COND(!mesh);
+	ERR_FAIL_INDEX(p_surface, mesh->surfaces.size());
+	ERR_FAIL_COND(p_lod_indices.size() != p_lod_errors.size());
+
+	Surface *surface = mesh->surfaces[p_surface];
+	ERR_FAIL_COND(!surface->index_id);
+
+	int index_size = surface->array_len >= (1 << 16) ? 4 : 2;
+	int total_size = 0;
+	for (int i = 0; i < p_lod_indices.size(); i++) {
+		ERR_FAIL_COND(p_lod_indices[i].size() % index_size != 0);
+		total_size += p_lod_indices[i].size();
+	}
+
+	int old_size = 0;
+	for (int i = 0; i < surface->lods.size(); i++) {
+		old_size += surface->lods[i].index_count * index_size;
+	}
+
+	if (surface->lod_index_id) {
+		glDeleteBuffers(1, &surface->lod_index_id);
+		surface->lod_index_id = 0;
+	}
+	surface->lods.clear();
+
+	if (total_size) {
+
+		// GLES2 can't copy between buffers, so the levels live in their own index buffer.
+		glGenBuffers(1, &surface->lod_index_id);
+		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, surface->lod_index_id);
+		glBufferData(GL_ELEMENT_ARRAY_BUFFER, total_size, NULL, GL_STATIC_DRAW);
+
+		int offset = 0;
+		for (int i = 0; i < p_lod_indices.size(); i++) {
+
+			PoolVector<uint8_t>::Read r = p_lod_indices[i].read();
+			glBufferSubData(GL_ELEMENT_ARRAY_BUFFER, offset, p_lod_indices[i].size(), r.ptr());
+
+			Surface::LOD lod;
+			lod.index_offset = offset;
+			lod.index_count = p_lod_indices[i].size() / index_size;
+			lod.error = p_lod_errors[i];
+			surface->lods.push_back(lod);
+
+			offset += p_lod_indices[i].size();
+		}
+
+		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+	}
+
+	info.vertex_mem += total_size - old_size;
+	surface->total_data_size += total_size - old_size;
+}
+
 void RasterizerStorageGLES2::mesh_surface_set_material(RID p_mesh, int p_surface, RID p_material) {
 	Mesh *mesh = mesh_owner.getornull(p_mesh);
 	ERR_FAIL_COND(!mesh);
@@ -2597,6 +2688,15 @@ AABB RasterizerStorageGLES2::mesh_surface_get_aabb(RID p_mesh, int p_surface) co
 	return mesh->surfaces[p_surface]->aabb;
 }
 
+Rect2 RasterizerStorageGLES2::mesh_surface_get_uv_range(RID p_mesh, int p_surface) const {
+
+	const Mesh *mesh = mesh_owner.getornull(p_mesh);
+	ERR_FAIL_COND_V(!mesh, Rect2());
+	ERR_FAIL_INDEX_V(p_surface, mesh->surfaces.size(), Rect2());
+
+	return mesh->surfaces[p_surface]->uv_range;
+}
+
 Vector<PoolVector<uint8_t> > RasterizerStorageGLES2::mesh_surface_get_blend_shapes(RID p_mesh, int p_surface) const {
 	const Mesh *mesh = mesh_owner.getornull(p_mesh);
 	ERR_FAIL_COND_V(!mesh, Vector<PoolVector<uint8_t> >());
@@ -2631,6 +2731,9 @@ void RasterizerStorageGLES2::mesh_remove_surface(RID p_mesh, int p_surface) {
 	if (surface->index_id) {
 		glDeleteBuffers(1, &surface->index_id);
 	}
+	if (surface->lod_index_id) {
+		glDeleteBuffers(1, &surface->lod_index_id);
+	}
 
 	for (int i = 0; i < surface->blend_shapes.size(); i++) {
 		glDeleteBuffers(1, &surface->blend_shapes[i].vertex_id);
@@ -3206,6 +3309,26 @@ void RasterizerStorageGLES2::multimesh_set_as_bulk_array(RID p_multimesh, const
 	}
 }
 
+void RasterizerStorageGLES2::multimesh_set_as_bulk_array_range(RID p_multimesh, int p_from_instance, const PoolVector<float> &p_array) {
+	MultiMesh *multimesh = multimesh_owner.getornull(p_multimesh);
+	ERR_FAIL_COND(!multimesh);
+
+	int stride = multimesh->color_floats + multimesh->xform_floats + multimesh->custom_data_floats;
+	ERR_FAIL_COND(stride == 0 || p_array.size() % stride != 0);
+	int count = p_array.size() / stride;
+	ERR_FAIL_COND(p_from_instance < 0 || p_from_instance + count > multimesh->size);
+
+	PoolVector<float>::Read r = p_array.read();
+	copymem(multimesh->data.ptrw() + p_from_instance * stride, r.ptr(), p_array.size() * sizeof(float));
+
+	multimesh->dirty_data = true;
+	multimesh->dirty_aabb = true;
+
+	if (!multimesh->update_list.in_list()) {
+		multimesh_update_list.add(&multimesh->update_list);
+	}
+}
+
 void RasterizerStorageGLES2::multimesh_set_visible_instances(RID p_multimesh, int p_visible) {
 	MultiMesh *multimesh = multimesh_owner.getornull(p_multimesh);
 	ERR_FAIL_COND(!multimesh);
@@ -3563,6 +3686,22 @@ Transform RasterizerStorageGLES2::skeleton_bone_get_transform(RID p_skeleton, in
 
 	return ret;
 }
+void RasterizerStorageGLES2::skeleton_set_bone_transforms(RID p_skeleton, const PoolVector<float> &p_transforms) {
+	Skeleton *skeleton = skeleton_owner.getornull(p_skeleton);
+	ERR_FAIL_COND(!skeleton);
+
+	ERR_FAIL_COND(skeleton->use_2d);
+	ERR_FAIL_COND(p_transforms.size() != skeleton->size * 12);
+
+	// Same layout as bone_data, three rows of four floats per bone.
+	PoolVector<float>::Read r = p_transforms.read();
+	copymem(skeleton->bone_data.ptrw(), r.ptr(), sizeof(float) * p_transforms.size());
+
+	if (!skeleton->update_list.in_list()) {
+		skeleton_update_list.add(&skeleton->update_list);
+	}
+}
+
 void RasterizerStorageGLES2::skeleton_bone_set_transform_2d(RID p_skeleton, int p_bone, const Transform2D &p_transform) {
 	Skeleton *skeleton = skeleton_owner.getornull(p_skeleton);
 	ERR_FAIL_COND(!skeleton);
@@ -5219,7 +5358,13 @@ int RasterizerStorageGLES2::get_captured_render_info(VS::RenderInfo p_info) {
 }
 
 int RasterizerStorageGLES2::get_render_info(VS::RenderInfo p_info) {
-	return 0;
+
+	switch (p_info) {
+		case VS::INFO_2D_BATCHES_IN_FRAME:
+			return info.render_final.canvas_batch_count;
+		default:
+			return 0;
+	}
 }
 
 void RasterizerStorageGLES2::initialize() {
@@ -5349,6 +5494,21 @@ void RasterizerStorageGLES2::initialize() {
 	glGetIntegerv(GL_MAX_COMBINED_TEXTURE_IMAGE_UNITS, &config.max_texture_image_units);
 	glGetIntegerv(GL_MAX_TEXTURE_SIZE, &config.max_texture_size);
 
+	// skinning reads bones from a float texture, from a uniform array when the vertex shader
+	// can't sample one, and only falls back to blending on the CPU if the skeleton is too big
+	GLint max_vertex_texture_image_units = 0;
+	glGetIntegerv(GL_MAX_VERTEX_TEXTURE_IMAGE_UNITS, &max_vertex_texture_image_units);
+	config.use_skeleton_texture = config.float_texture_supported && max_vertex_texture_image_units > 0;
+
+	GLint max_vertex_uniform_vectors = 0;
+#ifdef GLES_OVER_GL
+	glGetIntegerv(GL_MAX_VERTEX_UNIFORM_COMPONENTS, &max_vertex_uniform_vectors);
+	max_vertex_uniform_vectors /= 4;
+#else
+	glGetIntegerv(GL_MAX_VERTEX_UNIFORM_VECTORS, &max_vertex_uniform_vectors);
+#endif
+	config.max_skeleton_uniform_bones = CLAMP((max_vertex_uniform_vectors - SKELETON_UNIFORM_RESERVED_VECTORS) / 3, 0, MAX_SKELETON_UNIFORM_BONES);
+
 	shaders.copy.init();
 	shaders.cubemap_filter.init();
 	bool ggx_hq = GLOBAL_GET("rendering/quality/reflections/high_quality_ggx");
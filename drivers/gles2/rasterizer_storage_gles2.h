@@ -70,6 +70,8 @@ public:
 		Set<String> extensions;
 
 		bool float_texture_supported;
+		bool use_skeleton_texture;
+		int max_skeleton_uniform_bones;
 		bool s3tc_supported;
 		bool etc1_supported;
 		bool pvrtc_supported;
@@ -143,6 +145,7 @@ public:
 			uint32_t surface_switch_count;
 			uint32_t shader_rebind_count;
 			uint32_t vertices_count;
+			uint32_t canvas_batch_count;
 
 			void reset() {
 				object_count = 0;
@@ -151,6 +154,7 @@ public:
 				surface_switch_count = 0;
 				shader_rebind_count = 0;
 				vertices_count = 0;
+				canvas_batch_count = 0;
 			}
 		} render, render_final, snap;
 
@@ -518,6 +522,9 @@ public:
 	virtual void shader_set_default_texture_param(RID p_shader, const StringName &p_name, RID p_texture);
 	virtual RID shader_get_default_texture_param(RID p_shader, const StringName &p_name) const;
 
+	virtual PoolIntArray shader_get_compiled_variants(RID p_shader) const;
+	virtual void shader_precompile_variants(RID p_shader, const PoolIntArray &p_variants);
+
 	void _update_shader(Shader *p_shader) const;
 	void update_dirty_shaders();
 
@@ -621,6 +628,7 @@ public:
 		Vector<BlendShape> blend_shapes;
 
 		AABB aabb;
+		Rect2 uv_range; // used to dequantize ARRAY_FLAG_USE_QUANTIZED_UV
 
 		int array_len;
 		int index_array_len;
@@ -631,6 +639,26 @@ public:
 
 		VS::PrimitiveType primitive;
 
+		GLuint lod_index_id;
+		struct LOD {
+			int index_offset; // in bytes, into lod_index_id
+			int index_count;
+			float error; // relative to the surface bounds
+		};
+
+		Vector<LOD> lods;
+
+		// Levels are sorted by error, the coarsest one within the limit computed by the cull pass is drawn.
+		// Returns -1 when the base indices are used.
+		_FORCE_INLINE_ int get_lod(float p_error_limit) const {
+
+			int lod = -1;
+			while (lod + 1 < lods.size() && lods[lod + 1].error <= p_error_limit) {
+				lod++;
+			}
+			return lod;
+		}
+
 		Vector<AABB> skeleton_bone_aabb;
 		Vector<bool> skeleton_bone_used;
 
@@ -649,6 +677,7 @@ public:
 				array_byte_size(0),
 				index_array_byte_size(0),
 				primitive(VS::PRIMITIVE_POINTS),
+				lod_index_id(0),
 				active(false),
 				total_data_size(0) {
 		}
@@ -690,7 +719,7 @@ public:
 
 	virtual RID mesh_create();
 
-	virtual void mesh_add_surface(RID p_mesh, uint32_t p_format, VS::PrimitiveType p_primitive, const PoolVector<uint8_t> &p_array, int p_vertex_count, const PoolVector<uint8_t> &p_index_array, int p_index_count, const AABB &p_aabb, const Vector<PoolVector<uint8_t> > &p_blend_shapes = Vector<PoolVector<uint8_t> >(), const Vector<AABB> &p_bone_aabbs = Vector<AABB>());
+	virtual void mesh_add_surface(RID p_mesh, uint32_t p_format, VS::PrimitiveType p_primitive, const PoolVector<uint8_t> &p_array, int p_vertex_count, const PoolVector<uint8_t> &p_index_array, int p_index_count, const AABB &p_aabb, const Vector<PoolVector<uint8_t> > &p_blend_shapes = Vector<PoolVector<uint8_t> >(), const Vector<AABB> &p_bone_aabbs = Vector<AABB>(), const Rect2 &p_uv_range = Rect2(0, 0, 1, 1));
 
 	virtual void mesh_set_blend_shape_count(RID p_mesh, int p_amount);
 	virtual int mesh_get_blend_shape_count(RID p_mesh) const;
@@ -699,6 +728,7 @@ public:
 	virtual VS::BlendShapeMode mesh_get_blend_shape_mode(RID p_mesh) const;
 
 	virtual void mesh_surface_update_region(RID p_mesh, int p_surface, int p_offset, const PoolVector<uint8_t> &p_data);
+	virtual void mesh_surface_set_lods(RID p_mesh, int p_surface, const Vector<PoolVector<uint8_t> > &p_lod_indices, const Vector<float> &p_lod_errors);
 
 	virtual void mesh_surface_set_material(RID p_mesh, int p_surface, RID p_material);
 	virtual RID mesh_surface_get_material(RID p_mesh, int p_surface) const;
@@ -713,6 +743,7 @@ public:
 	virtual VS::PrimitiveType mesh_surface_get_primitive_type(RID p_mesh, int p_surface) const;
 
 	virtual AABB mesh_surface_get_aabb(RID p_mesh, int p_surface) const;
+	virtual Rect2 mesh_surface_get_uv_range(RID p_mesh, int p_surface) const;
 	virtual Vector<PoolVector<uint8_t> > mesh_surface_get_blend_shapes(RID p_mesh, int p_surface) const;
 	virtual Vector<AABB> mesh_surface_get_skeleton_aabb(RID p_mesh, int p_surface) const;
 
@@ -791,6 +822,7 @@ public:
 	virtual Color multimesh_instance_get_custom_data(RID p_multimesh, int p_index) const;
 
 	virtual void multimesh_set_as_bulk_array(RID p_multimesh, const PoolVector<float> &p_array);
+	virtual void multimesh_set_as_bulk_array_range(RID p_multimesh, int p_from_instance, const PoolVector<float> &p_array);
 
 	virtual void multimesh_set_visible_instances(RID p_multimesh, int p_visible);
 	virtual int multimesh_get_visible_instances(RID p_multimesh) const;
@@ -849,6 +881,11 @@ public:
 
 	/* SKELETON API */
 
+	enum {
+		SKELETON_UNIFORM_RESERVED_VECTORS = 128, // left to the rest of the scene vertex shader
+		MAX_SKELETON_UNIFORM_BONES = 128
+	};
+
 	struct Skeleton : RID_Data {
 
 		bool use_2d;
@@ -889,6 +926,7 @@ public:
 	virtual int skeleton_get_bone_count(RID p_skeleton) const;
 	virtual void skeleton_bone_set_transform(RID p_skeleton, int p_bone, const Transform &p_transform);
 	virtual Transform skeleton_bone_get_transform(RID p_skeleton, int p_bone) const;
+	virtual void skeleton_set_bone_transforms(RID p_skeleton, const PoolVector<float> &p_transforms);
 	virtual void skeleton_bone_set_transform_2d(RID p_skeleton, int p_bone, const Transform2D &p_transform);
 	virtual Transform2D skeleton_bone_get_transform_2d(RID p_skeleton, int p_bone) const;
 	virtual void skeleton_set_base_transform_2d(RID p_skeleton, const Transform2D &p_base_transform);
@@ -194,6 +194,11 @@ ShaderGLES2::Version *ShaderGLES2::get_current_version() {
 		}
 	}
 
+	for (int j = 0; j < custom_defines.size(); j++) {
+		strings.push_back(custom_defines[j].get_data());
+		define_line_ofs++;
+	}
+
 	// keep them around during the function
 	CharString code_string;
 	CharString code_string2;
@@ -23,7 +23,11 @@ precision highp int;
 
 attribute highp vec4 vertex_attrib; // attrib:0
 /* clang-format on */
+#ifdef USE_OCTAHEDRAL_NORMALS
+attribute highp vec2 normal_attrib; // attrib:1
+#else
 attribute vec3 normal_attrib; // attrib:1
+#endif
 
 #if defined(ENABLE_TANGENT_INTERP) || defined(ENABLE_NORMALMAP)
 attribute vec4 tangent_attrib; // attrib:2
@@ -41,6 +45,13 @@ attribute vec2 uv_attrib; // attrib:4
 attribute vec2 uv2_attrib; // attrib:5
 #endif
 
+#if defined(ENABLE_BONE_ATTRIBS) || (defined(USE_SKELETON) && !defined(USE_SKELETON_SOFTWARE))
+
+attribute vec4 bone_ids; // attrib:6
+attribute highp vec4 bone_weights; // attrib:7
+
+#endif
+
 #ifdef USE_SKELETON
 
 #ifdef USE_SKELETON_SOFTWARE
@@ -51,14 +62,19 @@ attribute highp vec4 bone_transform_row_2; // attrib:15
 
 #else
 
-attribute vec4 bone_ids; // attrib:6
-attribute highp vec4 bone_weights; // attrib:7
+#ifdef USE_SKELETON_UNIFORMS
+
+uniform highp vec4 skeleton_bones[MAX_SKELETON_UNIFORM_VECTORS];
+
+#else
 
 uniform highp sampler2D bone_transforms; // texunit:-1
 uniform ivec2 skeleton_texture_size;
 
 #endif
 
+#endif
+
 uniform highp mat4 skeleton_transform;
 uniform highp mat4 skeleton_transform_inverse;
 uniform bool skeleton_in_world_coords;
@@ -87,6 +103,12 @@ uniform highp mat4 projection_inverse_matrix;
 
 uniform highp mat4 world_transform;
 
+// dequantization of ARRAY_FLAG_USE_QUANTIZED_VERTICES and ARRAY_FLAG_USE_QUANTIZED_UV, identity otherwise
+uniform highp vec3 vertex_quantize_offset;
+uniform highp vec3 vertex_quantize_scale;
+uniform highp vec2 uv_quantize_offset;
+uniform highp vec2 uv_quantize_scale;
+
 uniform highp float time;
 
 uniform highp vec2 viewport_size;
@@ -322,9 +344,42 @@ uniform mediump float fog_height_curve;
 
 #endif //fog
 
+#ifdef USE_OCTAHEDRAL_NORMALS
+
+// Two 16-bit words: 10 bits per octahedral axis, 11 bits of tangent angle around the normal and the binormal sign.
+void decode_octahedral_normal(highp vec2 p_packed, out vec3 r_normal, out vec3 r_tangent, out float r_binormalf) {
+
+	highp vec2 high = floor(p_packed / 1024.0);
+	highp vec2 low = p_packed - high * 1024.0;
+
+	vec2 f = low / 1023.0 * 2.0 - 1.0;
+	vec3 n = vec3(f, 1.0 - abs(f.x) - abs(f.y));
+	float t = max(-n.z, 0.0);
+	n.x += n.x >= 0.0 ? -t : t;
+	n.y += n.y >= 0.0 ? -t : t;
+	r_normal = normalize(n);
+
+	// same basis as the encoder, the hemisphere is taken from the integer code
+	highp vec2 c = abs(low * 2.0 - 1023.0);
+	float s = c.x + c.y <= 1023.0 ? 1.0 : -1.0;
+	float a = -1.0 / (s + r_normal.z);
+	float b = r_normal.x * r_normal.y * a;
+	vec3 b1 = vec3(1.0 + s * r_normal.x * r_normal.x * a, s * b, -s * r_normal.x);
+	vec3 b2 = vec3(b, s + r_normal.y * r_normal.y * a, -r_normal.y);
+
+	highp float sign_bit = floor(high.y / 32.0);
+	highp float angle_bits = high.x + (high.y - sign_bit * 32.0) * 64.0;
+	float angle = (angle_bits / 2047.0 * 2.0 - 1.0) * M_PI;
+	r_tangent = b1 * cos(angle) + b2 * sin(angle);
+	r_binormalf = sign_bit > 0.5 ? -1.0 : 1.0;
+}
+
+#endif
+
 void main() {
 
 	highp vec4 vertex = vertex_attrib;
+	vertex.xyz = vertex_quantize_offset + vertex.xyz * vertex_quantize_scale;
 
 	mat4 world_matrix = world_transform;
 
@@ -340,11 +395,21 @@ void main() {
 
 #endif
 
+#ifdef USE_OCTAHEDRAL_NORMALS
+	vec3 normal;
+	vec3 tangent;
+	float binormalf;
+	decode_octahedral_normal(normal_attrib, normal, tangent, binormalf);
+#else
 	vec3 normal = normal_attrib;
 
 #if defined(ENABLE_TANGENT_INTERP) || defined(ENABLE_NORMALMAP)
 	vec3 tangent = tangent_attrib.xyz;
 	float binormalf = tangent_attrib.a;
+#endif
+#endif
+
+#if defined(ENABLE_TANGENT_INTERP) || defined(ENABLE_NORMALMAP)
 	vec3 binormal = normalize(cross(normal, tangent) * binormalf);
 #endif
 
@@ -356,7 +421,7 @@ void main() {
 #endif
 
 #if defined(ENABLE_UV_INTERP)
-	uv_interp = uv_attrib;
+	uv_interp = uv_quantize_offset + uv_attrib * uv_quantize_scale;
 #endif
 
 #if defined(ENABLE_UV2_INTERP) || defined(USE_LIGHTMAP)
@@ -389,6 +454,23 @@ void main() {
 	bone_transform[2] = vec4(bone_transform_row_0.z, bone_transform_row_1.z, bone_transform_row_2.z, 0.0);
 	bone_transform[3] = vec4(bone_transform_row_0.w, bone_transform_row_1.w, bone_transform_row_2.w, 1.0);
 
+#elif defined(USE_SKELETON_UNIFORMS)
+	// look up transform from the uniform bone palette
+	{
+
+		for (int i = 0; i < 4; i++) {
+			int bone_ofs = int(bone_ids[i]) * 3;
+
+			highp mat4 b = mat4(
+					skeleton_bones[bone_ofs + 0],
+					skeleton_bones[bone_ofs + 1],
+					skeleton_bones[bone_ofs + 2],
+					vec4(0.0, 0.0, 0.0, 1.0));
+
+			bone_transform += transpose(b) * bone_weights[i];
+		}
+	}
+
 #else
 	// look up transform from the "pose texture"
 	{
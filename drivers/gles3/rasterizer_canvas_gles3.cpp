@@ -319,25 +319,67 @@ void RasterizerCanvasGLES3::_set_texture_rect_mode(bool p_enable, bool p_ninepat
 	state.using_ninepatch = p_ninepatch;
 }
 
+uint32_t RasterizerCanvasGLES3::_stream_buffer_reserve(GLenum p_target, uint32_t p_buffer_size, uint32_t &r_cursor, uint32_t p_size, uint32_t p_align) {
+
+	uint32_t ofs = r_cursor;
+	if (ofs % p_align) {
+		ofs += p_align - ofs % p_align;
+	}
+
+	if (ofs + p_size > p_buffer_size) {
+		//full, orphan the storage (draws still in flight keep the old one) and start over
+		glBufferData(p_target, p_buffer_size, NULL, GL_DYNAMIC_DRAW);
+		ofs = 0;
+	}
+
+	r_cursor = ofs + p_size;
+	return ofs;
+}
+
+void RasterizerCanvasGLES3::_stream_buffer_write(GLenum p_target, uint32_t p_offset, const void *p_data, uint32_t p_size) {
+
+	//the range was just reserved, nothing can be using it, so no need to wait for the GPU
+	void *ptr = glMapBufferRange(p_target, p_offset, p_size, GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT | GL_MAP_UNSYNCHRONIZED_BIT);
+	if (ptr) {
+		copymem(ptr, p_data, p_size);
+		glUnmapBuffer(p_target);
+	} else {
+		glBufferSubData(p_target, p_offset, p_size, p_data);
+	}
+}
+
 void RasterizerCanvasGLES3::_draw_polygon(const int *p_indices, int p_index_count, int p_vertex_count, const Vector2 *p_vertices, const Vector2 *p_uvs, const Color *p_colors, bool p_singlecolor, const int *p_bones, const float *p_weights) {
 
+	bool use_colors = p_colors && !p_singlecolor;
+	bool use_bones = p_bones && p_weights;
+
+	uint32_t total_size = sizeof(Vector2) * p_vertex_count;
+	if (use_colors) {
+		total_size += sizeof(Color) * p_vertex_count;
+	}
+	if (p_uvs) {
+		total_size += sizeof(Vector2) * p_vertex_count;
+	}
+	if (use_bones) {
+		total_size += (sizeof(int) + sizeof(float)) * 4 * p_vertex_count;
+	}
+
+#ifdef DEBUG_ENABLED
+	ERR_FAIL_COND(total_size > data.polygon_buffer_size);
+	ERR_FAIL_COND(sizeof(int) * p_index_count > data.polygon_index_buffer_size);
+#endif
+
 	glBindVertexArray(data.polygon_buffer_pointer_array);
 	glBindBuffer(GL_ARRAY_BUFFER, data.polygon_buffer);
 
-	uint32_t buffer_ofs = 0;
+	uint32_t buffer_ofs = _stream_buffer_reserve(GL_ARRAY_BUFFER, data.polygon_buffer_size, data.polygon_buffer_cursor, total_size, 16);
 
 	//vertex
-#ifdef DEBUG_ENABLED
-	ERR_FAIL_COND(buffer_ofs > data.polygon_buffer_size);
-#endif
-	glBufferSubData(GL_ARRAY_BUFFER, buffer_ofs, sizeof(Vector2) * p_vertex_count, p_vertices);
+	_stream_buffer_write(GL_ARRAY_BUFFER, buffer_ofs, p_vertices, sizeof(Vector2) * p_vertex_count);
 	glEnableVertexAttribArray(VS::ARRAY_VERTEX);
 	glVertexAttribPointer(VS::ARRAY_VERTEX, 2, GL_FLOAT, false, sizeof(Vector2), CAST_INT_TO_UCHAR_PTR(buffer_ofs));
 	buffer_ofs += sizeof(Vector2) * p_vertex_count;
 	//color
-#ifdef DEBUG_ENABLED
-	ERR_FAIL_COND(buffer_ofs > data.polygon_buffer_size);
-#endif
 
 	if (p_singlecolor) {
 		glDisableVertexAttribArray(VS::ARRAY_COLOR);
@@ -348,19 +390,15 @@ void RasterizerCanvasGLES3::_draw_polygon(const int *p_indices, int p_index_coun
 		glVertexAttrib4f(VS::ARRAY_COLOR, 1, 1, 1, 1);
 	} else {
 
-		glBufferSubData(GL_ARRAY_BUFFER, buffer_ofs, sizeof(Color) * p_vertex_count, p_colors);
+		_stream_buffer_write(GL_ARRAY_BUFFER, buffer_ofs, p_colors, sizeof(Color) * p_vertex_count);
 		glEnableVertexAttribArray(VS::ARRAY_COLOR);
 		glVertexAttribPointer(VS::ARRAY_COLOR, 4, GL_FLOAT, false, sizeof(Color), CAST_INT_TO_UCHAR_PTR(buffer_ofs));
 		buffer_ofs += sizeof(Color) * p_vertex_count;
 	}
 
-#ifdef DEBUG_ENABLED
-	ERR_FAIL_COND(buffer_ofs > data.polygon_buffer_size);
-#endif
-
 	if (p_uvs) {
 
-		glBufferSubData(GL_ARRAY_BUFFER, buffer_ofs, sizeof(Vector2) * p_vertex_count, p_uvs);
+		_stream_buffer_write(GL_ARRAY_BUFFER, buffer_ofs, p_uvs, sizeof(Vector2) * p_vertex_count);
 		glEnableVertexAttribArray(VS::ARRAY_TEX_UV);
 		glVertexAttribPointer(VS::ARRAY_TEX_UV, 2, GL_FLOAT, false, sizeof(Vector2), CAST_INT_TO_UCHAR_PTR(buffer_ofs));
 		buffer_ofs += sizeof(Vector2) * p_vertex_count;
@@ -369,19 +407,15 @@ void RasterizerCanvasGLES3::_draw_polygon(const int *p_indices, int p_index_coun
 		glDisableVertexAttribArray(VS::ARRAY_TEX_UV);
 	}
 
-#ifdef DEBUG_ENABLED
-	ERR_FAIL_COND(buffer_ofs > data.polygon_buffer_size);
-#endif
-
-	if (p_bones && p_weights) {
+	if (use_bones) {
 
-		glBufferSubData(GL_ARRAY_BUFFER, buffer_ofs, sizeof(int) * 4 * p_vertex_count, p_bones);
+		_stream_buffer_write(GL_ARRAY_BUFFER, buffer_ofs, p_bones, sizeof(int) * 4 * p_vertex_count);
 		glEnableVertexAttribArray(VS::ARRAY_BONES);
 		//glVertexAttribPointer(VS::ARRAY_BONES, 4, GL_UNSIGNED_INT, false, sizeof(int) * 4, ((uint8_t *)0) + buffer_ofs);
 		glVertexAttribIPointer(VS::ARRAY_BONES, 4, GL_UNSIGNED_INT, sizeof(int) * 4, CAST_INT_TO_UCHAR_PTR(buffer_ofs));
 		buffer_ofs += sizeof(int) * 4 * p_vertex_count;
 
-		glBufferSubData(GL_ARRAY_BUFFER, buffer_ofs, sizeof(float) * 4 * p_vertex_count, p_weights);
+		_stream_buffer_write(GL_ARRAY_BUFFER, buffer_ofs, p_weights, sizeof(float) * 4 * p_vertex_count);
 		glEnableVertexAttribArray(VS::ARRAY_WEIGHTS);
 		glVertexAttribPointer(VS::ARRAY_WEIGHTS, 4, GL_FLOAT, false, sizeof(float) * 4, CAST_INT_TO_UCHAR_PTR(buffer_ofs));
 		buffer_ofs += sizeof(float) * 4 * p_vertex_count;
@@ -391,20 +425,17 @@ void RasterizerCanvasGLES3::_draw_polygon(const int *p_indices, int p_index_coun
 		glVertexAttrib4f(VS::ARRAY_WEIGHTS, 0, 0, 0, 0);
 	}
 
-#ifdef DEBUG_ENABLED
-	ERR_FAIL_COND(buffer_ofs > data.polygon_buffer_size);
-#endif
-
 	//bind the indices buffer.
 	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, data.polygon_index_buffer);
-	glBufferSubData(GL_ELEMENT_ARRAY_BUFFER, 0, sizeof(int) * p_index_count, p_indices);
+	uint32_t index_ofs = _stream_buffer_reserve(GL_ELEMENT_ARRAY_BUFFER, data.polygon_index_buffer_size, data.polygon_index_buffer_cursor, sizeof(int) * p_index_count, sizeof(int));
+	_stream_buffer_write(GL_ELEMENT_ARRAY_BUFFER, index_ofs, p_indices, sizeof(int) * p_index_count);
 
 	//draw the triangles.
-	glDrawElements(GL_TRIANGLES, p_index_count, GL_UNSIGNED_INT, 0);
+	glDrawElements(GL_TRIANGLES, p_index_count, GL_UNSIGNED_INT, CAST_INT_TO_UCHAR_PTR(index_ofs));
 
 	storage->frame.canvas_draw_commands++;
 
-	if (p_bones && p_weights) {
+	if (use_bones) {
 		//not used so often, so disable when used
 		glDisableVertexAttribArray(VS::ARRAY_BONES);
 		glDisableVertexAttribArray(VS::ARRAY_WEIGHTS);
@@ -415,13 +446,21 @@ void RasterizerCanvasGLES3::_draw_polygon(const int *p_indices, int p_index_coun
 
 void RasterizerCanvasGLES3::_draw_generic(GLuint p_primitive, int p_vertex_count, const Vector2 *p_vertices, const Vector2 *p_uvs, const Color *p_colors, bool p_singlecolor) {
 
+	uint32_t total_size = sizeof(Vector2) * p_vertex_count;
+	if (p_colors && !p_singlecolor) {
+		total_size += sizeof(Color) * p_vertex_count;
+	}
+	if (p_uvs) {
+		total_size += sizeof(Vector2) * p_vertex_count;
+	}
+
 	glBindVertexArray(data.polygon_buffer_pointer_array);
 	glBindBuffer(GL_ARRAY_BUFFER, data.polygon_buffer);
 
-	uint32_t buffer_ofs = 0;
+	uint32_t buffer_ofs = _stream_buffer_reserve(GL_ARRAY_BUFFER, data.polygon_buffer_size, data.polygon_buffer_cursor, total_size, 16);
 
 	//vertex
-	glBufferSubData(GL_ARRAY_BUFFER, buffer_ofs, sizeof(Vector2) * p_vertex_count, p_vertices);
+	_stream_buffer_write(GL_ARRAY_BUFFER, buffer_ofs, p_vertices, sizeof(Vector2) * p_vertex_count);
 	glEnableVertexAttribArray(VS::ARRAY_VERTEX);
 	glVertexAttribPointer(VS::ARRAY_VERTEX, 2, GL_FLOAT, false, sizeof(Vector2), CAST_INT_TO_UCHAR_PTR(buffer_ofs));
 	buffer_ofs += sizeof(Vector2) * p_vertex_count;
@@ -436,7 +475,7 @@ void RasterizerCanvasGLES3::_draw_generic(GLuint p_primitive, int p_vertex_count
 		glVertexAttrib4f(VS::ARRAY_COLOR, 1, 1, 1, 1);
 	} else {
 
-		glBufferSubData(GL_ARRAY_BUFFER, buffer_ofs, sizeof(Color) * p_vertex_count, p_colors);
+		_stream_buffer_write(GL_ARRAY_BUFFER, buffer_ofs, p_colors, sizeof(Color) * p_vertex_count);
 		glEnableVertexAttribArray(VS::ARRAY_COLOR);
 		glVertexAttribPointer(VS::ARRAY_COLOR, 4, GL_FLOAT, false, sizeof(Color), CAST_INT_TO_UCHAR_PTR(buffer_ofs));
 		buffer_ofs += sizeof(Color) * p_vertex_count;
@@ -444,7 +483,7 @@ void RasterizerCanvasGLES3::_draw_generic(GLuint p_primitive, int p_vertex_count
 
 	if (p_uvs) {
 
-		glBufferSubData(GL_ARRAY_BUFFER, buffer_ofs, sizeof(Vector2) * p_vertex_count, p_uvs);
+		_stream_buffer_write(GL_ARRAY_BUFFER, buffer_ofs, p_uvs, sizeof(Vector2) * p_vertex_count);
 		glEnableVertexAttribArray(VS::ARRAY_TEX_UV);
 		glVertexAttribPointer(VS::ARRAY_TEX_UV, 2, GL_FLOAT, false, sizeof(Vector2), CAST_INT_TO_UCHAR_PTR(buffer_ofs));
 		buffer_ofs += sizeof(Vector2) * p_vertex_count;
@@ -509,13 +548,322 @@ void RasterizerCanvasGLES3::_draw_gui_primitive(int p_points, const Vector2 *p_v
 	}
 
 	glBindBuffer(GL_ARRAY_BUFFER, data.polygon_buffer);
-	glBufferSubData(GL_ARRAY_BUFFER, 0, p_points * stride * 4, &b[0]);
+	//the quad arrays point at the start of the buffer, so keep the data aligned to whole vertices and offset the first one instead
+	uint32_t buffer_ofs = _stream_buffer_reserve(GL_ARRAY_BUFFER, data.polygon_buffer_size, data.polygon_buffer_cursor, p_points * stride * 4, stride * 4);
+	_stream_buffer_write(GL_ARRAY_BUFFER, buffer_ofs, &b[0], p_points * stride * 4);
 	glBindVertexArray(data.polygon_buffer_quad_arrays[version]);
-	glDrawArrays(prim[p_points], 0, p_points);
+	glDrawArrays(prim[p_points], buffer_ofs / (stride * 4), p_points);
+	glBindVertexArray(0);
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+	storage->frame.canvas_draw_commands++;
+}
+
+bool RasterizerCanvasGLES3::_batch_reserve(const RID &p_texture, int p_vertex_count, int p_index_count) {
+
+	if (p_vertex_count > batch.max_vertices || p_index_count > batch.max_indices)
+		return false;
+
+	if (batch.texture != p_texture || batch.vertex_count + p_vertex_count > batch.max_vertices || batch.index_count + p_index_count > batch.max_indices) {
+		_batch_flush();
+		batch.texture = p_texture;
+	}
+
+	return true;
+}
+
+void RasterizerCanvasGLES3::_batch_push_quad(const Vector2 *p_points, const Vector2 *p_uvs, const Color &p_color) {
+
+	Transform2D xform = state.final_transform * state.extra_matrix;
+	Color color = p_color * state.canvas_item_modulate;
+
+	uint16_t base = batch.vertex_count;
+	BatchVertex *v = &batch.vertices[base];
+
+	for (int i = 0; i < 4; i++) {
+		v[i].pos = xform.xform(p_points[i]);
+		v[i].uv = p_uvs[i];
+		v[i].color = color;
+	}
+
+	uint16_t *idx = &batch.indices[batch.index_count];
+	idx[0] = base + 0;
+	idx[1] = base + 1;
+	idx[2] = base + 2;
+	idx[3] = base + 2;
+	idx[4] = base + 3;
+	idx[5] = base + 0;
+
+	batch.vertex_count += 4;
+	batch.index_count += 6;
+}
+
+bool RasterizerCanvasGLES3::_batch_add_rect(const Item::CommandRect *p_rect) {
+
+	if (p_rect->normal_map.is_valid() || p_rect->flags & CANVAS_RECT_CLIP_UV)
+		return false;
+
+	Size2 texpixel_size(1, 1);
+
+	if (p_rect->texture.is_valid()) {
+
+		RasterizerStorageGLES3::Texture *texture = storage->texture_owner.getornull(p_rect->texture);
+		if (!texture)
+			return false;
+
+		texture = texture->get_ptr();
+		if (!texture->width || !texture->height)
+			return false;
+
+		if (p_rect->flags & CANVAS_RECT_TILE && !(texture->flags & VS::TEXTURE_FLAG_REPEAT))
+			return false; //needs wrap mode switched around the draw
+
+		texpixel_size = Size2(1.0 / texture->width, 1.0 / texture->height);
+	}
+
+	if (!_batch_reserve(p_rect->texture, 4, 6))
+		return false;
+
+	Vector2 points[4] = {
+		p_rect->rect.position,
+		p_rect->rect.position + Vector2(p_rect->rect.size.x, 0.0),
+		p_rect->rect.position + p_rect->rect.size,
+		p_rect->rect.position + Vector2(0.0, p_rect->rect.size.y),
+	};
+
+	if (p_rect->rect.size.x < 0) {
+		SWAP(points[0], points[1]);
+		SWAP(points[2], points[3]);
+	}
+	if (p_rect->rect.size.y < 0) {
+		SWAP(points[0], points[3]);
+		SWAP(points[1], points[2]);
+	}
+
+	Rect2 src_rect = (p_rect->texture.is_valid() && p_rect->flags & CANVAS_RECT_REGION) ? Rect2(p_rect->source.position * texpixel_size, p_rect->source.size * texpixel_size) : Rect2(0, 0, 1, 1);
+
+	Vector2 uvs[4] = {
+		src_rect.position,
+		src_rect.position + Vector2(src_rect.size.x, 0.0),
+		src_rect.position + src_rect.size,
+		src_rect.position + Vector2(0.0, src_rect.size.y),
+	};
+
+	if (p_rect->flags & CANVAS_RECT_TRANSPOSE) {
+		SWAP(uvs[1], uvs[3]);
+	}
+
+	if (p_rect->flags & CANVAS_RECT_FLIP_H) {
+		SWAP(uvs[0], uvs[1]);
+		SWAP(uvs[2], uvs[3]);
+	}
+	if (p_rect->flags & CANVAS_RECT_FLIP_V) {
+		SWAP(uvs[0], uvs[3]);
+		SWAP(uvs[1], uvs[2]);
+	}
+
+	_batch_push_quad(points, uvs, p_rect->modulate);
+
+	return true;
+}
+
+bool RasterizerCanvasGLES3::_batch_add_ninepatch(const Item::CommandNinePatch *p_np) {
+
+	//only stretched patches can be expressed as plain geometry, tiling is resolved in the shader
+	if (p_np->normal_map.is_valid() || p_np->axis_x != VS::NINE_PATCH_STRETCH || p_np->axis_y != VS::NINE_PATCH_STRETCH)
+		return false;
+
+	RasterizerStorageGLES3::Texture *texture = storage->texture_owner.getornull(p_np->texture);
+	if (!texture)
+		return false;
+
+	texture = texture->get_ptr();
+	if (!texture->width || !texture->height)
+		return false;
+
+	if (!_batch_reserve(p_np->texture, 16, 9 * 6))
+		return false;
+
+	Size2 texpixel_size(1.0 / texture->width, 1.0 / texture->height);
+
+	Rect2 source = p_np->source;
+	if (source == Rect2()) {
+		source.size = Size2(texture->width, texture->height);
+	}
+
+	const Rect2 &rect = p_np->rect;
+
+	const real_t x[4] = {
+		rect.position.x,
+		rect.position.x + p_np->margin[MARGIN_LEFT],
+		rect.position.x + rect.size.x - p_np->margin[MARGIN_RIGHT],
+		rect.position.x + rect.size.x
+	};
+	const real_t y[4] = {
+		rect.position.y,
+		rect.position.y + p_np->margin[MARGIN_TOP],
+		rect.position.y + rect.size.y - p_np->margin[MARGIN_BOTTOM],
+		rect.position.y + rect.size.y
+	};
+	const real_t u[4] = {
+		source.position.x * texpixel_size.x,
+		(source.position.x + p_np->margin[MARGIN_LEFT]) * texpixel_size.x,
+		(source.position.x + source.size.x - p_np->margin[MARGIN_RIGHT]) * texpixel_size.x,
+		(source.position.x + source.size.x) * texpixel_size.x
+	};
+	const real_t v[4] = {
+		source.position.y * texpixel_size.y,
+		(source.position.y + p_np->margin[MARGIN_TOP]) * texpixel_size.y,
+		(source.position.y + source.size.y - p_np->margin[MARGIN_BOTTOM]) * texpixel_size.y,
+		(source.position.y + source.size.y) * texpixel_size.y
+	};
+
+	Transform2D xform = state.final_transform * state.extra_matrix;
+	Color color = p_np->color * state.canvas_item_modulate;
+
+	uint16_t base = batch.vertex_count;
+	BatchVertex *bv = &batch.vertices[base];
+
+	for (int j = 0; j < 4; j++) {
+		for (int i = 0; i < 4; i++) {
+			BatchVertex &vtx = bv[j * 4 + i];
+			vtx.pos = xform.xform(Vector2(x[i], y[j]));
+			vtx.uv = Vector2(u[i], v[j]);
+			vtx.color = color;
+		}
+	}
+
+	uint16_t *idx = &batch.indices[batch.index_count];
+	int index_count = 0;
+
+	for (int j = 0; j < 3; j++) {
+		for (int i = 0; i < 3; i++) {
+
+			if (i == 1 && j == 1 && !p_np->draw_center)
+				continue;
+
+			uint16_t corner = base + j * 4 + i;
+			idx[index_count++] = corner;
+			idx[index_count++] = corner + 1;
+			idx[index_count++] = corner + 5;
+			idx[index_count++] = corner + 5;
+			idx[index_count++] = corner + 4;
+			idx[index_count++] = corner;
+		}
+	}
+
+	batch.vertex_count += 16;
+	batch.index_count += index_count;
+
+	return true;
+}
+
+bool RasterizerCanvasGLES3::_batch_add_polygon(const Item::CommandPolygon *p_polygon) {
+
+	if (p_polygon->normal_map.is_valid() || p_polygon->bones.size() || p_polygon->antialiased)
+		return false;
+
+	int vertex_count = p_polygon->points.size();
+	if (!vertex_count || !p_polygon->count)
+		return false;
+
+	if (p_polygon->texture.is_valid() && !storage->texture_owner.getornull(p_polygon->texture))
+		return false;
+
+	if (!_batch_reserve(p_polygon->texture, vertex_count, p_polygon->count))
+		return false;
+
+	Transform2D xform = state.final_transform * state.extra_matrix;
+
+	const Vector2 *points = p_polygon->points.ptr();
+	const Vector2 *uvs = p_polygon->uvs.size() == vertex_count ? p_polygon->uvs.ptr() : NULL;
+	const Color *colors = p_polygon->colors.ptr();
+	bool single_color = p_polygon->colors.size() != vertex_count;
+	Color color = p_polygon->colors.size() == 1 ? colors[0] * state.canvas_item_modulate : state.canvas_item_modulate;
+
+	uint16_t base = batch.vertex_count;
+	BatchVertex *bv = &batch.vertices[base];
+
+	for (int i = 0; i < vertex_count; i++) {
+		bv[i].pos = xform.xform(points[i]);
+		bv[i].uv = uvs ? uvs[i] : Vector2();
+		bv[i].color = single_color ? color : colors[i] * state.canvas_item_modulate;
+	}
+
+	const int *indices = p_polygon->indices.ptr();
+	uint16_t *idx = &batch.indices[batch.index_count];
+
+	for (int i = 0; i < p_polygon->count; i++) {
+		idx[i] = base + indices[i];
+	}
+
+	batch.vertex_count += vertex_count;
+	batch.index_count += p_polygon->count;
+
+	return true;
+}
+
+bool RasterizerCanvasGLES3::_batch_can_join(const Item *p_item) const {
+
+	const Item *prev = batch.item;
+
+	if (!batch.join_items || !prev || prev == p_item)
+		return false;
+
+	if (p_item->final_clip_owner != prev->final_clip_owner || p_item->copy_back_buffer || p_item->distance_field != prev->distance_field)
+		return false;
+
+	if (p_item->skeleton.is_valid() || prev->skeleton.is_valid())
+		return false;
+
+	//items using a material may bind a custom shader, which expects local vertex coordinates
+	const Item *material_owner = p_item->material_owner ? p_item->material_owner : p_item;
+	const Item *prev_material_owner = prev->material_owner ? prev->material_owner : prev;
+
+	return !material_owner->material.is_valid() && !prev_material_owner->material.is_valid();
+}
+
+void RasterizerCanvasGLES3::_batch_flush() {
+
+	if (!batch.index_count) {
+		batch.vertex_count = 0;
+		return;
+	}
+
+	_set_texture_rect_mode(false);
+
+	RasterizerStorageGLES3::Texture *texture = _bind_canvas_texture(batch.texture, RID());
+
+	if (texture) {
+		Size2 texpixel_size(1.0 / texture->width, 1.0 / texture->height);
+		state.canvas_shader.set_uniform(CanvasShaderGLES3::COLOR_TEXPIXEL_SIZE, texpixel_size);
+	}
+
+	//vertices are already in canvas space and modulated
+	state.canvas_shader.set_uniform(CanvasShaderGLES3::FINAL_MODULATE, Color(1, 1, 1, 1));
+	state.canvas_shader.set_uniform(CanvasShaderGLES3::MODELVIEW_MATRIX, Transform2D());
+	state.canvas_shader.set_uniform(CanvasShaderGLES3::EXTRA_MATRIX, Transform2D());
+
+	glBindVertexArray(data.batch_vertex_array);
+
+	glBindBuffer(GL_ARRAY_BUFFER, data.batch_vertex_buffer);
+	glBufferSubData(GL_ARRAY_BUFFER, 0, sizeof(BatchVertex) * batch.vertex_count, batch.vertices);
+	glBufferSubData(GL_ELEMENT_ARRAY_BUFFER, 0, sizeof(uint16_t) * batch.index_count, batch.indices);
+
+	glDrawElements(GL_TRIANGLES, batch.index_count, GL_UNSIGNED_SHORT, 0);
+
 	glBindVertexArray(0);
 	glBindBuffer(GL_ARRAY_BUFFER, 0);
 
 	storage->frame.canvas_draw_commands++;
+	storage->info.render.canvas_batch_count++;
+
+	state.canvas_shader.set_uniform(CanvasShaderGLES3::FINAL_MODULATE, state.canvas_item_modulate);
+	state.canvas_shader.set_uniform(CanvasShaderGLES3::MODELVIEW_MATRIX, state.final_transform);
+	state.canvas_shader.set_uniform(CanvasShaderGLES3::EXTRA_MATRIX, state.extra_matrix);
+
+	batch.vertex_count = 0;
+	batch.index_count = 0;
 }
 
 static const GLenum gl_primitive[] = {
@@ -533,10 +881,39 @@ void RasterizerCanvasGLES3::_canvas_item_render_commands(Item *p_item, Item *cur
 	int cc = p_item->commands.size();
 	Item::Command **commands = p_item->commands.ptrw();
 
+	batch.item = p_item;
+
 	for (int i = 0; i < cc; i++) {
 
 		Item::Command *c = commands[i];
 
+		if (batch.active) {
+
+			bool batched = false;
+
+			switch (c->type) {
+				case Item::Command::TYPE_RECT: {
+					batched = _batch_add_rect(static_cast<Item::CommandRect *>(c));
+				} break;
+				case Item::Command::TYPE_NINEPATCH: {
+					batched = _batch_add_ninepatch(static_cast<Item::CommandNinePatch *>(c));
+				} break;
+				case Item::Command::TYPE_POLYGON: {
+					batched = _batch_add_polygon(static_cast<Item::CommandPolygon *>(c));
+				} break;
+				default: {
+				}
+			}
+
+			if (batched)
+				continue;
+
+			if (c->type != Item::Command::TYPE_TRANSFORM) {
+				//extra matrix is applied when vertices are added, so transforms don't break the batch
+				_batch_flush();
+			}
+		}
+
 		switch (c->type) {
 			case Item::Command::TYPE_LINE: {
 
@@ -1153,6 +1530,8 @@ void RasterizerCanvasGLES3::_canvas_item_render_commands(Item *p_item, Item *cur
 
 void RasterizerCanvasGLES3::_copy_texscreen(const Rect2 &p_rect) {
 
+	_batch_flush();
+
 	if (storage->frame.current_rt->effects.mip_maps[0].sizes.size() == 0) {
 		ERR_EXPLAIN("Can't use screen texture copying in a render target configured without copy buffers");
 		ERR_FAIL();
@@ -1234,6 +1613,13 @@ void RasterizerCanvasGLES3::_copy_texscreen(const Rect2 &p_rect) {
 
 void RasterizerCanvasGLES3::canvas_render_items(Item *p_item_list, int p_z, const Color &p_modulate, Light *p_light, const Transform2D &p_transform) {
 
+	int canvas_timer = storage->gpu_timer_begin(RasterizerStorageGLES3::GPU_TIMER_CANVAS);
+	_canvas_render_items(p_item_list, p_z, p_modulate, p_light, p_transform);
+	storage->gpu_timer_end(canvas_timer);
+}
+
+void RasterizerCanvasGLES3::_canvas_render_items(Item *p_item_list, int p_z, const Color &p_modulate, Light *p_light, const Transform2D &p_transform) {
+
 	Item *current_clip = NULL;
 	RasterizerStorageGLES3::Shader *shader_cache = NULL;
 
@@ -1256,10 +1642,17 @@ void RasterizerCanvasGLES3::canvas_render_items(Item *p_item_list, int p_z, cons
 	bool prev_distance_field = false;
 	bool prev_use_skeleton = false;
 
+	batch.item = NULL;
+	batch.texture = RID();
+
 	while (p_item_list) {
 
 		Item *ci = p_item_list;
 
+		if (!_batch_can_join(ci)) {
+			_batch_flush();
+		}
+
 		if (prev_distance_field != ci->distance_field) {
 
 			state.canvas_shader.set_conditional(CanvasShaderGLES3::USE_DISTANCE_FIELD, ci->distance_field);
@@ -1518,6 +1911,8 @@ void RasterizerCanvasGLES3::canvas_render_items(Item *p_item_list, int p_z, cons
 		} else {
 			state.canvas_shader.set_uniform(CanvasShaderGLES3::SCREEN_PIXEL_SIZE, Vector2(1.0, 1.0));
 		}
+		batch.active = batch.enabled && !shader_cache && !skeleton;
+
 		if (unshaded || (state.canvas_item_modulate.a > 0.001 && (!shader_cache || shader_cache->canvas_item.light_mode != RasterizerStorageGLES3::Shader::CanvasItem::LIGHT_MODE_LIGHT_ONLY) && !ci->light_masked))
 			_canvas_item_render_commands(ci, current_clip, reclip);
 
@@ -1534,6 +1929,11 @@ void RasterizerCanvasGLES3::canvas_render_items(Item *p_item_list, int p_z, cons
 
 					//intersects this light
 
+					if (!light_used) {
+						//the unlit pass must reach the screen before blending changes
+						_batch_flush();
+					}
+
 					if (!light_used || mode != light->mode) {
 
 						mode = light->mode;
@@ -1611,6 +2011,7 @@ void RasterizerCanvasGLES3::canvas_render_items(Item *p_item_list, int p_z, cons
 
 					glActiveTexture(GL_TEXTURE0);
 					_canvas_item_render_commands(ci, current_clip, reclip); //redraw using light
+					_batch_flush();
 				}
 
 				light = light->next_ptr;
@@ -1659,6 +2060,7 @@ void RasterizerCanvasGLES3::canvas_render_items(Item *p_item_list, int p_z, cons
 
 		if (reclip) {
 
+			_batch_flush();
 			glEnable(GL_SCISSOR_TEST);
 			int y = storage->frame.current_rt->height - (current_clip->final_clip_rect.position.y + current_clip->final_clip_rect.size.y);
 			if (storage->frame.current_rt->flags[RasterizerStorage::RENDER_TARGET_VFLIP])
@@ -1669,6 +2071,9 @@ void RasterizerCanvasGLES3::canvas_render_items(Item *p_item_list, int p_z, cons
 		p_item_list = p_item_list->next;
 	}
 
+	_batch_flush();
+	batch.item = NULL;
+
 	if (current_clip) {
 		glDisable(GL_SCISSOR_TEST);
 	}
@@ -2058,6 +2463,7 @@ void RasterizerCanvasGLES3::initialize() {
 		glBufferData(GL_ARRAY_BUFFER, poly_size, NULL, GL_DYNAMIC_DRAW); //allocate max size
 		glBindBuffer(GL_ARRAY_BUFFER, 0);
 		data.polygon_buffer_size = poly_size;
+		data.polygon_buffer_cursor = 0;
 
 		//quad arrays
 		for (int i = 0; i < 4; i++) {
@@ -2104,6 +2510,51 @@ void RasterizerCanvasGLES3::initialize() {
 		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, data.polygon_index_buffer);
 		glBufferData(GL_ELEMENT_ARRAY_BUFFER, index_size, NULL, GL_DYNAMIC_DRAW); //allocate max size
 		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+		data.polygon_index_buffer_size = index_size;
+		data.polygon_index_buffer_cursor = 0;
+	}
+
+	{
+		//batching buffers
+
+		batch.enabled = GLOBAL_DEF("rendering/quality/2d/use_batching", true);
+		batch.join_items = GLOBAL_DEF("rendering/quality/2d/batch_join_items", true);
+
+		uint32_t batch_size = GLOBAL_DEF_RST("rendering/limits/buffers/canvas_batch_buffer_size_kb", 256);
+		ProjectSettings::get_singleton()->set_custom_property_info("rendering/limits/buffers/canvas_batch_buffer_size_kb", PropertyInfo(Variant::INT, "rendering/limits/buffers/canvas_batch_buffer_size_kb", PROPERTY_HINT_RANGE, "0,1024,1,or_greater"));
+		batch_size *= 1024; //kb
+
+		//indices are 16 bits, and any batch must at least fit a nine-patch
+		batch.max_vertices = CLAMP(int(batch_size / sizeof(BatchVertex)), 16, 65536);
+		batch.max_indices = batch.max_vertices * 3;
+		batch.vertices = memnew_arr(BatchVertex, batch.max_vertices);
+		batch.indices = memnew_arr(uint16_t, batch.max_indices);
+		batch.vertex_count = 0;
+		batch.index_count = 0;
+		batch.item = NULL;
+		batch.active = false;
+
+		glGenBuffers(1, &data.batch_vertex_buffer);
+		glBindBuffer(GL_ARRAY_BUFFER, data.batch_vertex_buffer);
+		glBufferData(GL_ARRAY_BUFFER, sizeof(BatchVertex) * batch.max_vertices, NULL, GL_DYNAMIC_DRAW);
+
+		glGenVertexArrays(1, &data.batch_vertex_array);
+		glBindVertexArray(data.batch_vertex_array);
+
+		glEnableVertexAttribArray(VS::ARRAY_VERTEX);
+		glVertexAttribPointer(VS::ARRAY_VERTEX, 2, GL_FLOAT, GL_FALSE, sizeof(BatchVertex), CAST_INT_TO_UCHAR_PTR(offsetof(BatchVertex, pos)));
+		glEnableVertexAttribArray(VS::ARRAY_TEX_UV);
+		glVertexAttribPointer(VS::ARRAY_TEX_UV, 2, GL_FLOAT, GL_FALSE, sizeof(BatchVertex), CAST_INT_TO_UCHAR_PTR(offsetof(BatchVertex, uv)));
+		glEnableVertexAttribArray(VS::ARRAY_COLOR);
+		glVertexAttribPointer(VS::ARRAY_COLOR, 4, GL_FLOAT, GL_FALSE, sizeof(BatchVertex), CAST_INT_TO_UCHAR_PTR(offsetof(BatchVertex, color)));
+
+		glGenBuffers(1, &data.batch_index_buffer);
+		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, data.batch_index_buffer);
+		glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(uint16_t) * batch.max_indices, NULL, GL_DYNAMIC_DRAW);
+
+		glBindVertexArray(0);
+		glBindBuffer(GL_ARRAY_BUFFER, 0);
+		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
 	}
 
 	store_transform(Transform(), state.canvas_item_ubo_data.projection_matrix);
@@ -2133,7 +2584,27 @@ void RasterizerCanvasGLES3::finalize() {
 	glDeleteVertexArrays(1, &data.canvas_quad_array);
 
 	glDeleteVertexArrays(1, &data.polygon_buffer_pointer_array);
+
+	glDeleteBuffers(1, &data.batch_vertex_buffer);
+	glDeleteBuffers(1, &data.batch_index_buffer);
+	glDeleteVertexArrays(1, &data.batch_vertex_array);
+
+	memdelete_arr(batch.vertices);
+	memdelete_arr(batch.indices);
+	batch.vertices = NULL;
+	batch.indices = NULL;
 }
 
 RasterizerCanvasGLES3::RasterizerCanvasGLES3() {
+
+	batch.vertices = NULL;
+	batch.indices = NULL;
+	batch.vertex_count = 0;
+	batch.index_count = 0;
+	batch.max_vertices = 0;
+	batch.max_indices = 0;
+	batch.item = NULL;
+	batch.enabled = false;
+	batch.join_items = false;
+	batch.active = false;
 }
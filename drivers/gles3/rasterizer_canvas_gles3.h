@@ -64,6 +64,15 @@ public:
 		GLuint particle_quad_array;
 
 		uint32_t polygon_buffer_size;
+		uint32_t polygon_index_buffer_size;
+		// Polygon buffers are filled front to back and only orphaned once full, so a draw never
+		// writes over data that a previous one may still be reading.
+		uint32_t polygon_buffer_cursor;
+		uint32_t polygon_index_buffer_cursor;
+
+		GLuint batch_vertex_buffer;
+		GLuint batch_index_buffer;
+		GLuint batch_vertex_array;
 
 	} data;
 
@@ -93,6 +102,33 @@ public:
 
 	} state;
 
+	struct BatchVertex {
+
+		Vector2 pos;
+		Vector2 uv;
+		Color color;
+	};
+
+	// Consecutive rects, nine-patches and polygons sharing texture and item state are
+	// transformed on the CPU and drawn with a single glDrawElements call.
+	struct Batch {
+
+		BatchVertex *vertices;
+		uint16_t *indices;
+		int vertex_count;
+		int index_count;
+		int max_vertices;
+		int max_indices;
+
+		RID texture;
+		Item *item;
+
+		bool enabled;
+		bool join_items;
+		bool active;
+
+	} batch;
+
 	RasterizerStorageGLES3 *storage;
 
 	struct LightInternal : public RID_Data {
@@ -128,13 +164,24 @@ public:
 	_FORCE_INLINE_ void _set_texture_rect_mode(bool p_enable, bool p_ninepatch = false);
 	_FORCE_INLINE_ RasterizerStorageGLES3::Texture *_bind_canvas_texture(const RID &p_texture, const RID &p_normal_map, bool p_force = false);
 
+	_FORCE_INLINE_ uint32_t _stream_buffer_reserve(GLenum p_target, uint32_t p_buffer_size, uint32_t &r_cursor, uint32_t p_size, uint32_t p_align);
+	_FORCE_INLINE_ void _stream_buffer_write(GLenum p_target, uint32_t p_offset, const void *p_data, uint32_t p_size);
 	_FORCE_INLINE_ void _draw_gui_primitive(int p_points, const Vector2 *p_vertices, const Color *p_colors, const Vector2 *p_uvs);
 	_FORCE_INLINE_ void _draw_polygon(const int *p_indices, int p_index_count, int p_vertex_count, const Vector2 *p_vertices, const Vector2 *p_uvs, const Color *p_colors, bool p_singlecolor, const int *p_bones, const float *p_weights);
 	_FORCE_INLINE_ void _draw_generic(GLuint p_primitive, int p_vertex_count, const Vector2 *p_vertices, const Vector2 *p_uvs, const Color *p_colors, bool p_singlecolor);
 
+	_FORCE_INLINE_ bool _batch_reserve(const RID &p_texture, int p_vertex_count, int p_index_count);
+	_FORCE_INLINE_ void _batch_push_quad(const Vector2 *p_points, const Vector2 *p_uvs, const Color &p_color);
+	bool _batch_add_rect(const Item::CommandRect *p_rect);
+	bool _batch_add_ninepatch(const Item::CommandNinePatch *p_np);
+	bool _batch_add_polygon(const Item::CommandPolygon *p_polygon);
+	bool _batch_can_join(const Item *p_item) const;
+	void _batch_flush();
+
 	_FORCE_INLINE_ void _canvas_item_render_commands(Item *p_item, Item *current_clip, bool &reclip);
 	_FORCE_INLINE_ void _copy_texscreen(const Rect2 &p_rect);
 
+	void _canvas_render_items(Item *p_item_list, int p_z, const Color &p_modulate, Light *p_light, const Transform2D &p_transform);
 	virtual void canvas_render_items(Item *p_item_list, int p_z, const Color &p_modulate, Light *p_light, const Transform2D &p_transform);
 	virtual void canvas_debug_viewport_shadows(Light *p_lights_with_shadow);
 
@@ -189,6 +189,7 @@ void RasterizerGLES3::initialize() {
 
 	const GLubyte *renderer = glGetString(GL_RENDERER);
 	print_line("OpenGL ES 3.0 Renderer: " + String((const char *)renderer));
+	ShaderGLES3::init_shader_cache();
 	storage->initialize();
 	canvas->initialize();
 	scene->initialize();
@@ -219,6 +220,8 @@ void RasterizerGLES3::begin_frame(double frame_step) {
 	storage->info.render_final = storage->info.render;
 	storage->info.render.reset();
 
+	storage->gpu_timers_begin_frame();
+
 	scene->iteration();
 }
 
@@ -360,6 +363,42 @@ void RasterizerGLES3::blit_render_target_to_screen(RID p_render_target, const Re
 #endif
 }
 
+void RasterizerGLES3::blit_render_target_to_current(RID p_render_target, float p_sharpness) {
+
+	ERR_FAIL_COND(!storage->frame.current_rt);
+
+	RasterizerStorageGLES3::RenderTarget *rt = storage->render_target_owner.getornull(p_render_target);
+	ERR_FAIL_COND(!rt);
+
+	glBindFramebuffer(GL_FRAMEBUFFER, storage->frame.current_rt->fbo);
+	glViewport(0, 0, storage->frame.current_rt->width, storage->frame.current_rt->height);
+
+	glDepthMask(GL_FALSE);
+	glDisable(GL_DEPTH_TEST);
+	glDisable(GL_CULL_FACE);
+	glDisable(GL_BLEND);
+
+	glActiveTexture(GL_TEXTURE0);
+	glBindTexture(GL_TEXTURE_2D, rt->color);
+	// the source is never exposed as a texture, so the filter can stay linear
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+
+	bool sharpen = p_sharpness > 0.0;
+	storage->shaders.copy.set_conditional(CopyShaderGLES3::USE_SHARPEN, sharpen);
+	storage->shaders.copy.bind();
+	if (sharpen) {
+		storage->shaders.copy.set_uniform(CopyShaderGLES3::PIXEL_SIZE, Vector2(1.0 / rt->width, 1.0 / rt->height));
+		storage->shaders.copy.set_uniform(CopyShaderGLES3::SHARPNESS, p_sharpness);
+	}
+
+	glBindVertexArray(storage->resources.quadie_array);
+	glDrawArrays(GL_TRIANGLE_FAN, 0, 4);
+	glBindVertexArray(0);
+
+	storage->shaders.copy.set_conditional(CopyShaderGLES3::USE_SHARPEN, false);
+}
+
 void RasterizerGLES3::output_lens_distorted_to_screen(RID p_render_target, const Rect2 &p_screen_rect, float p_k1, float p_k2, const Vector2 &p_eye_center, float p_oversample) {
 	ERR_FAIL_COND(storage->frame.current_rt);
 
@@ -430,6 +469,7 @@ void RasterizerGLES3::register_config() {
 	ProjectSettings::get_singleton()->set_custom_property_info("rendering/quality/filters/anisotropic_filter_level", PropertyInfo(Variant::INT, "rendering/quality/filters/anisotropic_filter_level", PROPERTY_HINT_RANGE, "1,16,1"));
 	GLOBAL_DEF("rendering/limits/time/time_rollover_secs", 3600);
 	ProjectSettings::get_singleton()->set_custom_property_info("rendering/limits/time/time_rollover_secs", PropertyInfo(Variant::REAL, "rendering/limits/time/time_rollover_secs", PROPERTY_HINT_RANGE, "0,10000,1,or_greater"));
+	GLOBAL_DEF("rendering/gles3/shaders/shader_cache", true);
 }
 
 RasterizerGLES3::RasterizerGLES3() {
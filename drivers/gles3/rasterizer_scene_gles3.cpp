@@ -97,6 +97,22 @@ RID RasterizerSceneGLES3::shadow_atlas_create() {
 	return shadow_atlas_owner.make_rid(shadow_atlas);
 }
 
+// Depth atlases are GL_DEPTH_COMPONENT24, which drivers store in 32 bits.
+static uint64_t _shadow_atlas_bytes(int p_size) {
+
+	return uint64_t(p_size) * p_size * 4;
+}
+
+// Reflection atlases are RGBA16F with a fixed chain of 6 mipmaps.
+static uint64_t _reflection_atlas_bytes(int p_size) {
+
+	uint64_t bytes = 0;
+	for (int i = 0; i < 6; i++) {
+		bytes += uint64_t(p_size >> i) * (p_size >> i) * 8;
+	}
+	return bytes;
+}
+
 void RasterizerSceneGLES3::shadow_atlas_set_size(RID p_atlas, int p_size) {
 
 	ShadowAtlas *shadow_atlas = shadow_atlas_owner.getornull(p_atlas);
@@ -112,6 +128,7 @@ void RasterizerSceneGLES3::shadow_atlas_set_size(RID p_atlas, int p_size) {
 	if (shadow_atlas->fbo) {
 		glDeleteTextures(1, &shadow_atlas->depth);
 		glDeleteFramebuffers(1, &shadow_atlas->fbo);
+		storage->info.shadow_mem -= _shadow_atlas_bytes(shadow_atlas->size);
 
 		shadow_atlas->depth = 0;
 		shadow_atlas->fbo = 0;
@@ -158,6 +175,7 @@ void RasterizerSceneGLES3::shadow_atlas_set_size(RID p_atlas, int p_size) {
 		glClear(GL_DEPTH_BUFFER_BIT);
 
 		glBindFramebuffer(GL_FRAMEBUFFER, 0);
+		storage->info.shadow_mem += _shadow_atlas_bytes(shadow_atlas->size);
 	}
 }
 
@@ -475,6 +493,7 @@ void RasterizerSceneGLES3::reflection_atlas_set_size(RID p_ref_atlas, int p_size
 		}
 		glDeleteTextures(1, &reflection_atlas->color);
 		reflection_atlas->color = 0;
+		storage->info.reflection_mem -= _reflection_atlas_bytes(reflection_atlas->size);
 	}
 
 	reflection_atlas->size = size;
@@ -507,6 +526,7 @@ void RasterizerSceneGLES3::reflection_atlas_set_size(RID p_ref_atlas, int p_size
 
 		int mmsize = reflection_atlas->size;
 		glTexStorage2DCustom(GL_TEXTURE_2D, 6, internal_format, mmsize, mmsize, format, type);
+		storage->info.reflection_mem += _reflection_atlas_bytes(reflection_atlas->size);
 
 		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
 		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
@@ -1178,7 +1198,12 @@ bool RasterizerSceneGLES3::_setup_material(RasterizerStorageGLES3::Material *p_m
 
 	if (p_material->ubo_id) {
 
-		glBindBufferBase(GL_UNIFORM_BUFFER, 1, p_material->ubo_id);
+		if (state.material_bound_ubo != p_material->ubo_id) {
+			glBindBufferBase(GL_UNIFORM_BUFFER, 1, p_material->ubo_id);
+			state.material_bound_ubo = p_material->ubo_id;
+		} else {
+			storage->info.render.redundant_state_change_count++;
+		}
 	}
 
 	int tc = p_material->textures.size();
@@ -1190,8 +1215,6 @@ bool RasterizerSceneGLES3::_setup_material(RasterizerStorageGLES3::Material *p_m
 
 	for (int i = 0; i < tc; i++) {
 
-		glActiveTexture(GL_TEXTURE0 + i);
-
 		GLenum target = GL_TEXTURE_2D;
 		GLuint tex = 0;
 
@@ -1282,7 +1305,18 @@ bool RasterizerSceneGLES3::_setup_material(RasterizerStorageGLES3::Material *p_m
 			}
 		}
 
-		glBindTexture(target, tex);
+		//the highest units are also bound for lights, probes and skeletons, so those are never cached
+		if (i >= State::MATERIAL_TEXTURE_CACHE_SIZE || i >= storage->config.max_texture_image_units - 10) {
+			glActiveTexture(GL_TEXTURE0 + i);
+			glBindTexture(target, tex);
+		} else if (state.material_bound_tex[i] != tex || state.material_bound_target[i] != target) {
+			glActiveTexture(GL_TEXTURE0 + i);
+			glBindTexture(target, tex);
+			state.material_bound_tex[i] = tex;
+			state.material_bound_target[i] = target;
+		} else {
+			storage->info.render.redundant_state_change_count++;
+		}
 
 		if (t && storage->config.srgb_decode_supported) {
 			//if SRGB decode extension is present, simply switch the texture to whathever is needed
@@ -1293,6 +1327,7 @@ bool RasterizerSceneGLES3::_setup_material(RasterizerStorageGLES3::Material *p_m
 			}
 
 			if (t->using_srgb != must_srgb) {
+				glActiveTexture(GL_TEXTURE0 + i); //the bind above may have been skipped
 				if (must_srgb) {
 					glTexParameteri(t->target, _TEXTURE_SRGB_DECODE_EXT, _DECODE_EXT);
 #ifdef TOOLS_ENABLED
@@ -1557,9 +1592,15 @@ void RasterizerSceneGLES3::_render_geometry(RenderList::Element *e) {
 #endif
 					if (s->index_array_len > 0) {
 
-				glDrawElements(gl_primitive[s->primitive], s->index_array_len, (s->array_len >= (1 << 16)) ? GL_UNSIGNED_INT : GL_UNSIGNED_SHORT, 0);
-
-				storage->info.render.vertices_count += s->index_array_len;
+				int lod = s->get_lod(e->instance->lod_error_limit);
+				if (lod >= 0) {
+					const RasterizerStorageGLES3::Surface::LOD &l = s->lods[lod];
+					glDrawElements(gl_primitive[s->primitive], l.index_count, (s->array_len >= (1 << 16)) ? GL_UNSIGNED_INT : GL_UNSIGNED_SHORT, CAST_INT_TO_UCHAR_PTR(l.index_offset));
+					storage->info.render.vertices_count += l.index_count;
+				} else {
+					glDrawElements(gl_primitive[s->primitive], s->index_array_len, (s->array_len >= (1 << 16)) ? GL_UNSIGNED_INT : GL_UNSIGNED_SHORT, 0);
+					storage->info.render.vertices_count += s->index_array_len;
+				}
 
 			} else {
 
@@ -1728,6 +1769,9 @@ void RasterizerSceneGLES3::_render_geometry(RenderList::Element *e) {
 				glBindTexture(GL_TEXTURE_2D, state.current_main_tex);
 				restore_tex = false;
 			}
+
+			//the main texture is restored as a 2D texture, which may not match what the material bound
+			state.material_bound_tex[0] = 0;
 		} break;
 		case VS::INSTANCE_PARTICLES: {
 
@@ -1851,6 +1895,42 @@ void RasterizerSceneGLES3::_render_geometry(RenderList::Element *e) {
 	}
 }
 
+// Rough estimate of how much a light contributes at the object's origin, used to pick
+// which lights to keep when more of them touch an object than the per-object limit.
+static _FORCE_INLINE_ float _light_importance(const RasterizerSceneGLES3::LightInstance *p_light, const Vector3 &p_pos) {
+
+	float range = p_light->light_ptr->param[VS::LIGHT_PARAM_RANGE];
+	float energy = p_light->light_ptr->param[VS::LIGHT_PARAM_ENERGY];
+	if (range <= 0.0)
+		return 0.0;
+
+	float falloff = MAX(1.0 - p_light->transform.origin.distance_to(p_pos) / range, 0.0);
+	// keep lights that barely reach the object above zero, so they still sort by energy
+	return energy * (falloff * falloff + 0.001);
+}
+
+// Inserts p_index into a list kept sorted by decreasing importance, dropping the least
+// important entry once the list holds p_max items.
+static _FORCE_INLINE_ void _insert_light_by_importance(int *r_indices, float *r_importance, int &r_count, int p_max, int p_index, float p_importance) {
+
+	if (r_count == p_max) {
+		if (p_importance <= r_importance[r_count - 1])
+			return;
+		r_count--;
+	}
+
+	int pos = r_count;
+	while (pos > 0 && r_importance[pos - 1] < p_importance) {
+		r_indices[pos] = r_indices[pos - 1];
+		r_importance[pos] = r_importance[pos - 1];
+		pos--;
+	}
+
+	r_indices[pos] = p_index;
+	r_importance[pos] = p_importance;
+	r_count++;
+}
+
 void RasterizerSceneGLES3::_setup_light(RenderList::Element *e, const Transform &p_view_transform) {
 
 	int omni_indices[16];
@@ -1867,20 +1947,41 @@ void RasterizerSceneGLES3::_setup_light(RenderList::Element *e, const Transform
 
 		const RID *lights = e->instance->light_instances.ptr();
 
-		for (int i = 0; i < lc; i++) {
-			LightInstance *li = light_instance_owner.getptr(lights[i]);
-			if (li->last_pass != render_pass) //not visible
-				continue;
+		if (lc <= maxobj) {
+
+			for (int i = 0; i < lc; i++) {
+				LightInstance *li = light_instance_owner.getptr(lights[i]);
+				if (li->last_pass != render_pass) //not visible
+					continue;
+
+				if (!(e->instance->layer_mask & li->light_ptr->cull_mask))
+					continue;
 
-			if (li->light_ptr->type == VS::LIGHT_OMNI) {
-				if (omni_count < maxobj && e->instance->layer_mask & li->light_ptr->cull_mask) {
+				if (li->light_ptr->type == VS::LIGHT_OMNI) {
 					omni_indices[omni_count++] = li->light_index;
+				} else if (li->light_ptr->type == VS::LIGHT_SPOT) {
+					spot_indices[spot_count++] = li->light_index;
 				}
 			}
+		} else {
 
-			if (li->light_ptr->type == VS::LIGHT_SPOT) {
-				if (spot_count < maxobj && e->instance->layer_mask & li->light_ptr->cull_mask) {
-					spot_indices[spot_count++] = li->light_index;
+			// More lights than fit, keep the ones that matter most instead of the first ones found.
+			float omni_importance[16];
+			float spot_importance[16];
+			const Vector3 &origin = e->instance->transform.origin;
+
+			for (int i = 0; i < lc; i++) {
+				LightInstance *li = light_instance_owner.getptr(lights[i]);
+				if (li->last_pass != render_pass) //not visible
+					continue;
+
+				if (!(e->instance->layer_mask & li->light_ptr->cull_mask))
+					continue;
+
+				if (li->light_ptr->type == VS::LIGHT_OMNI) {
+					_insert_light_by_importance(omni_indices, omni_importance, omni_count, maxobj, li->light_index, _light_importance(li, origin));
+				} else if (li->light_ptr->type == VS::LIGHT_SPOT) {
+					_insert_light_by_importance(spot_indices, spot_importance, spot_count, maxobj, li->light_index, _light_importance(li, origin));
 				}
 			}
 		}
@@ -1992,7 +2093,282 @@ void RasterizerSceneGLES3::_set_cull(bool p_front, bool p_disabled, bool p_rever
 	}
 }
 
-void RasterizerSceneGLES3::_render_list(RenderList::Element **p_elements, int p_element_count, const Transform &p_view_transform, const CameraMatrix &p_projection, GLuint p_base_env, bool p_reverse_cull, bool p_alpha_pass, bool p_shadow, bool p_directional_add, bool p_directional_shadows) {
+/* RENDER LIST */
+
+static _FORCE_INLINE_ uint32_t _depth_sort_key(real_t p_depth) {
+
+	// Maps float ordering onto unsigned integer ordering, negative values included.
+	union {
+		float f;
+		uint32_t u;
+	} d;
+
+	d.f = p_depth;
+	return (d.u & 0x80000000) ? ~d.u : (d.u | 0x80000000);
+}
+
+RasterizerSceneGLES3::RenderList::Element *RasterizerSceneGLES3::RenderList::_grow(Element *p_elements, int &r_capacity) {
+
+	r_capacity = MAX(r_capacity * 2, 1024);
+	return (Element *)memrealloc(p_elements, sizeof(Element) * r_capacity);
+}
+
+void RasterizerSceneGLES3::RenderList::sort(bool p_alpha, SortMode p_mode) {
+
+	Element *list = p_alpha ? alpha_elements : elements;
+	int count = p_alpha ? alpha_element_count : element_count;
+
+	if (count < 2)
+		return;
+
+	if (count > sort_capacity) {
+		sort_capacity = MAX(count, sort_capacity * 2);
+		sort_entries = (SortEntry *)memrealloc(sort_entries, sizeof(SortEntry) * sort_capacity);
+		sort_entries_tmp = (SortEntry *)memrealloc(sort_entries_tmp, sizeof(SortEntry) * sort_capacity);
+		sort_elements_tmp = (Element *)memrealloc(sort_elements_tmp, sizeof(Element) * sort_capacity);
+	}
+
+	for (int i = 0; i < count; i++) {
+
+		uint64_t key;
+		switch (p_mode) {
+			case SORT_MODE_KEY: {
+				key = list[i].sort_key;
+			} break;
+			case SORT_MODE_DEPTH: {
+				key = _depth_sort_key(list[i].instance->depth);
+			} break;
+			default: {
+				uint64_t priority = list[i].sort_key >> SORT_KEY_PRIORITY_SHIFT;
+				key = (priority << 32) | uint64_t(~_depth_sort_key(list[i].instance->depth));
+			}
+		}
+
+		sort_entries[i].key = key;
+		sort_entries[i].index = i;
+	}
+
+	// LSD radix sort, one byte per pass. All histograms are counted up front so
+	// that bytes shared by every key (most of them, for depth keys) cost no pass.
+
+	uint32_t histograms[8][256];
+	zeromem(histograms, sizeof(histograms));
+
+	for (int i = 0; i < count; i++) {
+		uint64_t key = sort_entries[i].key;
+		for (int j = 0; j < 8; j++) {
+			histograms[j][(key >> (j * 8)) & 0xFF]++;
+		}
+	}
+
+	SortEntry *src = sort_entries;
+	SortEntry *dst = sort_entries_tmp;
+
+	for (int j = 0; j < 8; j++) {
+
+		uint32_t *histogram = histograms[j];
+		uint64_t first_byte = (src[0].key >> (j * 8)) & 0xFF;
+		if (histogram[first_byte] == uint32_t(count))
+			continue;
+
+		uint32_t offset = 0;
+		for (int k = 0; k < 256; k++) {
+			uint32_t c = histogram[k];
+			histogram[k] = offset;
+			offset += c;
+		}
+
+		for (int i = 0; i < count; i++) {
+			dst[histogram[(src[i].key >> (j * 8)) & 0xFF]++] = src[i];
+		}
+
+		SWAP(src, dst);
+	}
+
+	for (int i = 0; i < count; i++) {
+		sort_elements_tmp[i] = list[src[i].index];
+	}
+
+	copymem(list, sort_elements_tmp, sizeof(Element) * count);
+}
+
+void RasterizerSceneGLES3::RenderList::init() {
+
+	element_count = 0;
+	alpha_element_count = 0;
+
+	element_capacity = initial_elements;
+	elements = (Element *)memrealloc(elements, sizeof(Element) * element_capacity);
+	alpha_element_capacity = initial_elements;
+	alpha_elements = (Element *)memrealloc(alpha_elements, sizeof(Element) * alpha_element_capacity);
+}
+
+RasterizerSceneGLES3::RenderList::RenderList() {
+
+	initial_elements = DEFAULT_INITIAL_ELEMENTS;
+
+	elements = NULL;
+	alpha_elements = NULL;
+	element_count = 0;
+	alpha_element_count = 0;
+	element_capacity = 0;
+	alpha_element_capacity = 0;
+
+	sort_entries = NULL;
+	sort_entries_tmp = NULL;
+	sort_elements_tmp = NULL;
+	sort_capacity = 0;
+}
+
+RasterizerSceneGLES3::RenderList::~RenderList() {
+
+	if (elements)
+		memfree(elements);
+	if (alpha_elements)
+		memfree(alpha_elements);
+	if (sort_entries)
+		memfree(sort_entries);
+	if (sort_entries_tmp)
+		memfree(sort_entries_tmp);
+	if (sort_elements_tmp)
+		memfree(sort_elements_tmp);
+}
+
+// Two elements can share an instanced draw when only their transform differs.
+bool RasterizerSceneGLES3::_can_auto_instance(const RenderList::Element *e, const RenderList::Element *p_next, bool p_lighting) const {
+
+	if (p_next->instance->base_type != VS::INSTANCE_MESH || p_next->geometry != e->geometry || p_next->material != e->material || p_next->owner != e->owner || p_next->sort_key != e->sort_key) {
+		return false;
+	}
+
+	const InstanceBase *a = e->instance;
+	const InstanceBase *b = p_next->instance;
+
+	if (b->skeleton.is_valid() || b->layer_mask != a->layer_mask) {
+		return false;
+	}
+
+	const RasterizerStorageGLES3::Surface *s = static_cast<const RasterizerStorageGLES3::Surface *>(e->geometry);
+	if (s->blend_shapes.size() && b->blend_values.size()) {
+		return false;
+	}
+
+	if (s->lods.size() && s->get_lod(a->lod_error_limit) != s->get_lod(b->lod_error_limit)) {
+		return false;
+	}
+
+	if (!p_lighting) {
+		return true;
+	}
+
+	// lights, probes and baked lighting are set up per object, they must match exactly
+	if (b->gi_probe_instances.size() || b->lightmap.is_valid() || !b->lightmap_capture_data.empty()) {
+		return false;
+	}
+
+	int lc = a->light_instances.size();
+	if (lc != b->light_instances.size() || lc > state.max_forward_lights_per_object) {
+		return false;
+	}
+	for (int i = 0; i < lc; i++) {
+		if (a->light_instances[i] != b->light_instances[i]) {
+			return false;
+		}
+	}
+
+	int rc = a->reflection_probe_instances.size();
+	if (rc != b->reflection_probe_instances.size()) {
+		return false;
+	}
+	for (int i = 0; i < rc; i++) {
+		if (a->reflection_probe_instances[i] != b->reflection_probe_instances[i]) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+void RasterizerSceneGLES3::_setup_auto_instancing(RenderList::Element *p_elements, int p_count) {
+
+	RasterizerStorageGLES3::Surface *s = static_cast<RasterizerStorageGLES3::Surface *>(p_elements->geometry);
+	glBindVertexArray(s->instancing_array_id);
+
+	const uint32_t stride = 12 * sizeof(float);
+	uint32_t size = p_count * stride;
+
+	glBindBuffer(GL_ARRAY_BUFFER, state.auto_instancing_buffer);
+
+	uint32_t ofs = state.auto_instancing_buffer_cursor;
+	if (ofs + size > state.auto_instancing_buffer_size) {
+		//full, orphan the storage (draws still in flight keep the old one) and start over
+		glBufferData(GL_ARRAY_BUFFER, state.auto_instancing_buffer_size, NULL, GL_DYNAMIC_DRAW);
+		ofs = 0;
+	}
+	state.auto_instancing_buffer_cursor = ofs + size;
+
+	//the range was just reserved, nothing can be using it, so no need to wait for the GPU
+	float *data = (float *)glMapBufferRange(GL_ARRAY_BUFFER, ofs, size, GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT | GL_MAP_UNSYNCHRONIZED_BIT);
+	ERR_FAIL_COND(!data);
+
+	//same layout as multimesh 3D transforms
+	for (int i = 0; i < p_count; i++) {
+		const Transform &xf = p_elements[i].instance->transform;
+		float *dataptr = &data[i * 12];
+
+		dataptr[0] = xf.basis.elements[0][0];
+		dataptr[1] = xf.basis.elements[0][1];
+		dataptr[2] = xf.basis.elements[0][2];
+		dataptr[3] = xf.origin.x;
+		dataptr[4] = xf.basis.elements[1][0];
+		dataptr[5] = xf.basis.elements[1][1];
+		dataptr[6] = xf.basis.elements[1][2];
+		dataptr[7] = xf.origin.y;
+		dataptr[8] = xf.basis.elements[2][0];
+		dataptr[9] = xf.basis.elements[2][1];
+		dataptr[10] = xf.basis.elements[2][2];
+		dataptr[11] = xf.origin.z;
+	}
+
+	glUnmapBuffer(GL_ARRAY_BUFFER);
+
+	for (int i = 0; i < 3; i++) {
+		glEnableVertexAttribArray(8 + i);
+		glVertexAttribPointer(8 + i, 4, GL_FLOAT, GL_FALSE, stride, CAST_INT_TO_UCHAR_PTR(ofs + i * 4 * sizeof(float)));
+		glVertexAttribDivisor(8 + i, 1);
+	}
+
+	glDisableVertexAttribArray(11);
+	glVertexAttrib4f(11, 1, 1, 1, 1);
+	glDisableVertexAttribArray(12);
+	glVertexAttrib4f(12, 1, 1, 1, 1);
+}
+
+void RasterizerSceneGLES3::_render_auto_instanced(RenderList::Element *e, int p_count) {
+
+	RasterizerStorageGLES3::Surface *s = static_cast<RasterizerStorageGLES3::Surface *>(e->geometry);
+
+	if (s->index_array_len > 0) {
+
+		GLenum index_type = (s->array_len >= (1 << 16)) ? GL_UNSIGNED_INT : GL_UNSIGNED_SHORT;
+		int lod = s->get_lod(e->instance->lod_error_limit);
+		if (lod >= 0) {
+			const RasterizerStorageGLES3::Surface::LOD &l = s->lods[lod];
+			glDrawElementsInstanced(gl_primitive[s->primitive], l.index_count, index_type, CAST_INT_TO_UCHAR_PTR(l.index_offset), p_count);
+			storage->info.render.vertices_count += l.index_count * p_count;
+		} else {
+			glDrawElementsInstanced(gl_primitive[s->primitive], s->index_array_len, index_type, 0, p_count);
+			storage->info.render.vertices_count += s->index_array_len * p_count;
+		}
+
+	} else {
+
+		glDrawArraysInstanced(gl_primitive[s->primitive], 0, s->array_len, p_count);
+		storage->info.render.vertices_count += s->array_len * p_count;
+	}
+}
+
+void RasterizerSceneGLES3::_render_list(RenderList::Element *p_elements, int p_element_count, const Transform &p_view_transform, const CameraMatrix &p_projection, GLuint p_base_env, bool p_reverse_cull, bool p_alpha_pass, bool p_shadow, bool p_directional_add, bool p_directional_shadows) {
 
 	glBindBufferBase(GL_UNIFORM_BUFFER, 0, state.scene_ubo); //bind globals ubo
 
@@ -2035,6 +2411,13 @@ void RasterizerSceneGLES3::_render_list(RenderList::Element **p_elements, int p_
 	state.current_line_width = -1;
 	state.current_depth_draw = -1;
 
+	//other passes bind textures and buffers freely, so start each list with no assumptions
+	for (int i = 0; i < State::MATERIAL_TEXTURE_CACHE_SIZE; i++) {
+		state.material_bound_tex[i] = 0;
+		state.material_bound_target[i] = GL_NONE;
+	}
+	state.material_bound_ubo = 0;
+
 	RasterizerStorageGLES3::Material *prev_material = NULL;
 	RasterizerStorageGLES3::Geometry *prev_geometry = NULL;
 	RasterizerStorageGLES3::GeometryOwner *prev_owner = NULL;
@@ -2049,19 +2432,38 @@ void RasterizerSceneGLES3::_render_list(RenderList::Element **p_elements, int p_
 
 	bool first = true;
 	bool prev_use_instancing = false;
+	bool prev_octahedral_normals = false;
 
 	storage->info.render.draw_call_count += p_element_count;
 	bool prev_opaque_prepass = false;
 
+	bool auto_instancing = state.auto_instancing;
+#ifdef DEBUG_ENABLED
+	if (state.debug_draw == VS::VIEWPORT_DEBUG_DRAW_WIREFRAME) {
+		auto_instancing = false;
+	}
+#endif
+	int max_auto_instances = state.auto_instancing_buffer_size / (12 * sizeof(float));
+	bool prev_auto_instanced = false;
+
 	for (int i = 0; i < p_element_count; i++) {
 
-		RenderList::Element *e = p_elements[i];
+		RenderList::Element *e = &p_elements[i];
 		RasterizerStorageGLES3::Material *material = e->material;
 		RasterizerStorageGLES3::Skeleton *skeleton = NULL;
 		if (e->instance->skeleton.is_valid()) {
 			skeleton = storage->skeleton_owner.getornull(e->instance->skeleton);
 		}
 
+		int instance_count = 1;
+		if (auto_instancing && e->instance->base_type == VS::INSTANCE_MESH && !skeleton) {
+			//the directional add pass skips elements by unshaded flag and layer, both are part of the match
+			bool lighting = !p_shadow && !p_directional_add && !(e->sort_key & SORT_KEY_UNSHADED_FLAG);
+			while (i + instance_count < p_element_count && instance_count < max_auto_instances && _can_auto_instance(e, &p_elements[i + instance_count], lighting)) {
+				instance_count++;
+			}
+		}
+
 		bool rebind = first;
 
 		int shading = (e->sort_key >> RenderList::SORT_KEY_SHADING_SHIFT) & RenderList::SORT_KEY_SHADING_MASK;
@@ -2199,13 +2601,26 @@ void RasterizerSceneGLES3::_render_list(RenderList::Element **p_elements, int p_
 			rebind = true;
 		}
 
-		bool use_instancing = e->instance->base_type == VS::INSTANCE_MULTIMESH || e->instance->base_type == VS::INSTANCE_PARTICLES;
+		bool use_instancing = e->instance->base_type == VS::INSTANCE_MULTIMESH || e->instance->base_type == VS::INSTANCE_PARTICLES || instance_count > 1;
 
 		if (use_instancing != prev_use_instancing) {
 			state.scene_shader.set_conditional(SceneShaderGLES3::USE_INSTANCING, use_instancing);
 			rebind = true;
 		}
 
+		const RasterizerStorageGLES3::Surface *surface = NULL;
+		if (e->geometry->type == RasterizerStorageGLES3::Geometry::GEOMETRY_SURFACE) {
+			surface = static_cast<const RasterizerStorageGLES3::Surface *>(e->geometry);
+		}
+		uint32_t surface_format = surface ? surface->format : 0;
+
+		bool octahedral_normals = surface_format & VS::ARRAY_FLAG_USE_OCTAHEDRAL_NORMALS;
+
+		if (octahedral_normals != prev_octahedral_normals) {
+			state.scene_shader.set_conditional(SceneShaderGLES3::USE_OCTAHEDRAL_NORMALS, octahedral_normals);
+			rebind = true;
+		}
+
 		if (prev_skeleton != skeleton) {
 			if ((prev_skeleton == NULL) != (skeleton == NULL)) {
 				state.scene_shader.set_conditional(SceneShaderGLES3::USE_SKELETON, skeleton != NULL);
@@ -2233,7 +2648,11 @@ void RasterizerSceneGLES3::_render_list(RenderList::Element **p_elements, int p_
 			_setup_light(e, p_view_transform);
 		}
 
-		if (e->owner != prev_owner || prev_base_type != e->instance->base_type || prev_geometry != e->geometry) {
+		if (instance_count > 1) {
+
+			_setup_auto_instancing(e, instance_count);
+			storage->info.render.surface_switch_count++;
+		} else if (e->owner != prev_owner || prev_base_type != e->instance->base_type || prev_geometry != e->geometry || prev_auto_instanced) {
 
 			_setup_geometry(e, p_view_transform);
 			storage->info.render.surface_switch_count++;
@@ -2246,9 +2665,35 @@ void RasterizerSceneGLES3::_render_list(RenderList::Element **p_elements, int p_
 			state.scene_shader.set_uniform(SceneShaderGLES3::SKELETON_IN_WORLD_COORDS, skeleton->use_world_transform);
 		}
 
-		state.scene_shader.set_uniform(SceneShaderGLES3::WORLD_TRANSFORM, e->instance->transform);
+		if (surface_format & VS::ARRAY_FLAG_USE_QUANTIZED_VERTICES) {
+			state.scene_shader.set_uniform(SceneShaderGLES3::VERTEX_QUANTIZE_OFFSET, surface->aabb.position);
+			state.scene_shader.set_uniform(SceneShaderGLES3::VERTEX_QUANTIZE_SCALE, surface->aabb.size);
+		} else {
+			state.scene_shader.set_uniform(SceneShaderGLES3::VERTEX_QUANTIZE_OFFSET, Vector3());
+			state.scene_shader.set_uniform(SceneShaderGLES3::VERTEX_QUANTIZE_SCALE, Vector3(1, 1, 1));
+		}
+
+		if (surface_format & VS::ARRAY_FLAG_USE_QUANTIZED_UV) {
+			state.scene_shader.set_uniform(SceneShaderGLES3::UV_QUANTIZE_OFFSET, surface->uv_range.position);
+			state.scene_shader.set_uniform(SceneShaderGLES3::UV_QUANTIZE_SCALE, surface->uv_range.size);
+		} else {
+			state.scene_shader.set_uniform(SceneShaderGLES3::UV_QUANTIZE_OFFSET, Vector2());
+			state.scene_shader.set_uniform(SceneShaderGLES3::UV_QUANTIZE_SCALE, Vector2(1, 1));
+		}
 
-		_render_geometry(e);
+		if (instance_count > 1) {
+			//transforms come from the instance buffer
+			state.scene_shader.set_uniform(SceneShaderGLES3::WORLD_TRANSFORM, Transform());
+
+			_render_auto_instanced(e, instance_count);
+
+			storage->info.render.draw_call_count -= instance_count - 1;
+			i += instance_count - 1;
+		} else {
+			state.scene_shader.set_uniform(SceneShaderGLES3::WORLD_TRANSFORM, e->instance->transform);
+
+			_render_geometry(e);
+		}
 
 		prev_material = material;
 		prev_base_type = e->instance->base_type;
@@ -2257,6 +2702,8 @@ void RasterizerSceneGLES3::_render_list(RenderList::Element **p_elements, int p_
 		prev_shading = shading;
 		prev_skeleton = skeleton;
 		prev_use_instancing = use_instancing;
+		prev_octahedral_normals = octahedral_normals;
+		prev_auto_instanced = instance_count > 1;
 		prev_opaque_prepass = use_opaque_prepass;
 		first = false;
 	}
@@ -2264,6 +2711,7 @@ void RasterizerSceneGLES3::_render_list(RenderList::Element **p_elements, int p_
 	glBindVertexArray(0);
 
 	state.scene_shader.set_conditional(SceneShaderGLES3::USE_INSTANCING, false);
+	state.scene_shader.set_conditional(SceneShaderGLES3::USE_OCTAHEDRAL_NORMALS, false);
 	state.scene_shader.set_conditional(SceneShaderGLES3::USE_SKELETON, false);
 	state.scene_shader.set_conditional(SceneShaderGLES3::USE_RADIANCE_MAP, false);
 	state.scene_shader.set_conditional(SceneShaderGLES3::USE_FORWARD_LIGHTING, false);
@@ -2374,9 +2822,6 @@ void RasterizerSceneGLES3::_add_geometry_with_material(RasterizerStorageGLES3::G
 
 	RenderList::Element *e = has_alpha ? render_list.add_alpha_element() : render_list.add_element();
 
-	if (!e)
-		return;
-
 	e->geometry = p_geometry;
 	e->material = p_material;
 	e->instance = p_instance;
@@ -3309,7 +3754,7 @@ void RasterizerSceneGLES3::_bind_depth_texture() {
 	}
 }
 
-void RasterizerSceneGLES3::_render_mrts(Environment *env, const CameraMatrix &p_cam_projection) {
+void RasterizerSceneGLES3::_render_mrts(Environment *env, const Transform &p_cam_transform, const CameraMatrix &p_cam_projection) {
 
 	glDepthMask(GL_FALSE);
 	glDisable(GL_DEPTH_TEST);
@@ -3328,6 +3773,9 @@ void RasterizerSceneGLES3::_render_mrts(Environment *env, const CameraMatrix &p_
 	}
 
 	if (env->ssao_enabled) {
+
+		int ssao_timer = storage->gpu_timer_begin(RasterizerStorageGLES3::GPU_TIMER_SSAO);
+
 		//copy diffuse to front buffer
 		glBindFramebuffer(GL_READ_FRAMEBUFFER, storage->frame.current_rt->buffers.fbo);
 		glReadBuffer(GL_COLOR_ATTACHMENT0);
@@ -3337,6 +3785,23 @@ void RasterizerSceneGLES3::_render_mrts(Environment *env, const CameraMatrix &p_
 		glBindFramebuffer(GL_READ_FRAMEBUFFER, 0);
 		glBindFramebuffer(GL_DRAW_FRAMEBUFFER, 0);
 
+		RasterizerStorageGLES3::RenderTarget::Effects::SSAO &ssao = storage->frame.current_rt->effects.ssao;
+
+		int ao_shift = ssao_resolution_shift;
+		bool ao_accumulate = ssao_temporal_accumulation;
+		if (!storage->render_target_prepare_ssao_buffers(storage->frame.current_rt, ao_shift, ao_accumulate)) {
+			ao_shift = 0;
+			ao_accumulate = false;
+		}
+
+		// AO and its blur run at 1 / (1 << ao_shift) resolution, ping-ponging between these
+		GLuint ao_fbo[2];
+		GLuint ao_red[2];
+		for (int i = 0; i < 2; i++) {
+			ao_fbo[i] = ao_shift > 0 ? ssao.reduced_fbo[i] : ssao.blur_fbo[i];
+			ao_red[i] = ao_shift > 0 ? ssao.reduced_red[i] : ssao.blur_red[i];
+		}
+
 		//copy from depth, convert to linear
 		GLint ss[2];
 		ss[0] = storage->frame.current_rt->width;
@@ -3369,8 +3834,13 @@ void RasterizerSceneGLES3::_render_mrts(Environment *env, const CameraMatrix &p_
 		ss[0] = storage->frame.current_rt->width;
 		ss[1] = storage->frame.current_rt->height;
 
-		glViewport(0, 0, ss[0], ss[1]);
+		GLint ao_ss[2];
+		ao_ss[0] = MAX(1, ss[0] >> ao_shift);
+		ao_ss[1] = MAX(1, ss[1] >> ao_shift);
+
+		glViewport(0, 0, ao_ss[0], ao_ss[1]);
 
+		// the reduced buffers have no depth attachment, so the test always passes there
 		glEnable(GL_DEPTH_TEST);
 		glDepthFunc(GL_GREATER);
 		// do SSAO!
@@ -3407,6 +3877,9 @@ void RasterizerSceneGLES3::_render_mrts(Environment *env, const CameraMatrix &p_
 
 		state.ssao_shader.set_uniform(SsaoShaderGLES3::PROJ_SCALE, pixels_per_meter);
 		state.ssao_shader.set_uniform(SsaoShaderGLES3::BIAS, env->ssao_bias);
+		state.ssao_shader.set_uniform(SsaoShaderGLES3::RESOLUTION_SHIFT, ao_shift);
+		// spin the tap pattern by the golden angle every frame, so the accumulated history sees new taps
+		state.ssao_shader.set_uniform(SsaoShaderGLES3::ROTATION_OFFSET, ao_accumulate ? float(storage->frame.count % 64) * 2.39996f : 0.0f);
 
 		glActiveTexture(GL_TEXTURE0);
 		glBindTexture(GL_TEXTURE_2D, storage->frame.current_rt->depth);
@@ -3415,7 +3888,7 @@ void RasterizerSceneGLES3::_render_mrts(Environment *env, const CameraMatrix &p_
 		glActiveTexture(GL_TEXTURE2);
 		glBindTexture(GL_TEXTURE_2D, storage->frame.current_rt->buffers.effect);
 
-		glBindFramebuffer(GL_FRAMEBUFFER, storage->frame.current_rt->effects.ssao.blur_fbo[0]); //copy to front first
+		glBindFramebuffer(GL_FRAMEBUFFER, ao_fbo[0]); //copy to front first
 		Color white(1, 1, 1, 1);
 		glClearBufferfv(GL_COLOR, 0, white.components); // specular
 
@@ -3435,15 +3908,16 @@ void RasterizerSceneGLES3::_render_mrts(Environment *env, const CameraMatrix &p_
 
 				GLint axis[2] = { i, 1 - i };
 				glUniform2iv(state.ssao_blur_shader.get_uniform(SsaoBlurShaderGLES3::AXIS), 1, axis);
-				glUniform2iv(state.ssao_blur_shader.get_uniform(SsaoBlurShaderGLES3::SCREEN_SIZE), 1, ss);
+				glUniform2iv(state.ssao_blur_shader.get_uniform(SsaoBlurShaderGLES3::SCREEN_SIZE), 1, ao_ss);
+				state.ssao_blur_shader.set_uniform(SsaoBlurShaderGLES3::RESOLUTION_SHIFT, ao_shift);
 
 				glActiveTexture(GL_TEXTURE0);
-				glBindTexture(GL_TEXTURE_2D, storage->frame.current_rt->effects.ssao.blur_red[i]);
+				glBindTexture(GL_TEXTURE_2D, ao_red[i]);
 				glActiveTexture(GL_TEXTURE1);
 				glBindTexture(GL_TEXTURE_2D, storage->frame.current_rt->depth);
 				glActiveTexture(GL_TEXTURE2);
 				glBindTexture(GL_TEXTURE_2D, storage->frame.current_rt->buffers.effect);
-				glBindFramebuffer(GL_FRAMEBUFFER, storage->frame.current_rt->effects.ssao.blur_fbo[1 - i]);
+				glBindFramebuffer(GL_FRAMEBUFFER, ao_fbo[1 - i]);
 				if (i == 0) {
 					glClearBufferfv(GL_COLOR, 0, white.components); // specular
 				}
@@ -3451,6 +3925,62 @@ void RasterizerSceneGLES3::_render_mrts(Environment *env, const CameraMatrix &p_
 			}
 		}
 
+		GLuint ao_result = ao_red[0];
+
+		if (ao_accumulate) {
+
+			CameraMatrix view_projection = p_cam_projection * CameraMatrix(p_cam_transform.affine_inverse());
+			int next = 1 - ssao.history_current;
+
+			state.ssao_blur_shader.set_conditional(SsaoBlurShaderGLES3::SSAO_TEMPORAL, true);
+			state.ssao_blur_shader.bind();
+			state.ssao_blur_shader.set_uniform(SsaoBlurShaderGLES3::REPROJECTION, ssao.history_view_projection * view_projection.inverse());
+			state.ssao_blur_shader.set_uniform(SsaoBlurShaderGLES3::HISTORY_BLEND, ssao.history_valid ? 0.9f : 0.0f);
+			state.ssao_blur_shader.set_uniform(SsaoBlurShaderGLES3::RESOLUTION_SHIFT, ao_shift);
+			glUniform2iv(state.ssao_blur_shader.get_uniform(SsaoBlurShaderGLES3::SCREEN_SIZE), 1, ao_ss);
+
+			glActiveTexture(GL_TEXTURE0);
+			glBindTexture(GL_TEXTURE_2D, ao_result);
+			glActiveTexture(GL_TEXTURE1);
+			glBindTexture(GL_TEXTURE_2D, storage->frame.current_rt->depth);
+			glActiveTexture(GL_TEXTURE2);
+			glBindTexture(GL_TEXTURE_2D, ssao.history_red[ssao.history_current]);
+			glBindFramebuffer(GL_FRAMEBUFFER, ssao.history_fbo[next]);
+
+			_copy_screen(true);
+
+			state.ssao_blur_shader.set_conditional(SsaoBlurShaderGLES3::SSAO_TEMPORAL, false);
+
+			ssao.history_current = next;
+			ssao.history_valid = true;
+			ssao.history_view_projection = view_projection;
+			ao_result = ssao.history_red[next];
+		}
+
+		glViewport(0, 0, ss[0], ss[1]);
+
+		if (ao_shift > 0) {
+			// bring the AO back to full resolution, following depth edges
+			state.ssao_blur_shader.set_conditional(SsaoBlurShaderGLES3::SSAO_UPSAMPLE, true);
+			state.ssao_blur_shader.bind();
+			state.ssao_blur_shader.set_uniform(SsaoBlurShaderGLES3::CAMERA_Z_FAR, p_cam_projection.get_z_far());
+			state.ssao_blur_shader.set_uniform(SsaoBlurShaderGLES3::CAMERA_Z_NEAR, p_cam_projection.get_z_near());
+			state.ssao_blur_shader.set_uniform(SsaoBlurShaderGLES3::RESOLUTION_SHIFT, ao_shift);
+			glUniform2iv(state.ssao_blur_shader.get_uniform(SsaoBlurShaderGLES3::SCREEN_SIZE), 1, ao_ss);
+
+			glActiveTexture(GL_TEXTURE0);
+			glBindTexture(GL_TEXTURE_2D, ao_result);
+			glActiveTexture(GL_TEXTURE1);
+			glBindTexture(GL_TEXTURE_2D, storage->frame.current_rt->depth);
+			glBindFramebuffer(GL_FRAMEBUFFER, ssao.blur_fbo[0]);
+			glClearBufferfv(GL_COLOR, 0, white.components);
+
+			_copy_screen(true);
+
+			state.ssao_blur_shader.set_conditional(SsaoBlurShaderGLES3::SSAO_UPSAMPLE, false);
+			ao_result = ssao.blur_red[0];
+		}
+
 		glDisable(GL_DEPTH_TEST);
 		glDepthFunc(GL_LEQUAL);
 
@@ -3462,11 +3992,13 @@ void RasterizerSceneGLES3::_render_mrts(Environment *env, const CameraMatrix &p_
 		glActiveTexture(GL_TEXTURE0);
 		glBindTexture(GL_TEXTURE_2D, storage->frame.current_rt->color); //previous level, since mipmaps[0] starts one level bigger
 		glActiveTexture(GL_TEXTURE1);
-		glBindTexture(GL_TEXTURE_2D, storage->frame.current_rt->effects.ssao.blur_red[0]); //previous level, since mipmaps[0] starts one level bigger
+		glBindTexture(GL_TEXTURE_2D, ao_result);
 		glBindFramebuffer(GL_FRAMEBUFFER, storage->frame.current_rt->effects.mip_maps[0].sizes[0].fbo); // copy to base level
 		_copy_screen(true);
 		state.effect_blur_shader.set_conditional(EffectBlurShaderGLES3::SSAO_MERGE, false);
 
+		storage->gpu_timer_end(ssao_timer);
+
 	} else {
 
 		//copy diffuse to effect buffer
@@ -3534,6 +4066,8 @@ void RasterizerSceneGLES3::_render_mrts(Environment *env, const CameraMatrix &p_
 
 	if (env->ssr_enabled) {
 
+		int ssr_timer = storage->gpu_timer_begin(RasterizerStorageGLES3::GPU_TIMER_SSR);
+
 		//blur diffuse into effect mipmaps using separatable convolution
 		//storage->shaders.copy.set_conditional(CopyShaderGLES3::GAUSSIAN_HORIZONTAL,true);
 		_blur_effect_buffer();
@@ -3545,8 +4079,10 @@ void RasterizerSceneGLES3::_render_mrts(Environment *env, const CameraMatrix &p_
 
 		state.ssr_shader.bind();
 
-		int ssr_w = storage->frame.current_rt->effects.mip_maps[1].sizes[0].width;
-		int ssr_h = storage->frame.current_rt->effects.mip_maps[1].sizes[0].height;
+		// level 0 of the second chain is half resolution, level 1 a quarter
+		int ssr_level = (ssr_quarter_resolution && storage->frame.current_rt->effects.mip_maps[1].sizes.size() > 1) ? 1 : 0;
+		int ssr_w = storage->frame.current_rt->effects.mip_maps[1].sizes[ssr_level].width;
+		int ssr_h = storage->frame.current_rt->effects.mip_maps[1].sizes[ssr_level].height;
 
 		state.ssr_shader.set_uniform(ScreenSpaceReflectionShaderGLES3::PIXEL_SIZE, Vector2(1.0 / (ssr_w * 0.5), 1.0 / (ssr_h * 0.5)));
 		state.ssr_shader.set_uniform(ScreenSpaceReflectionShaderGLES3::CAMERA_Z_NEAR, p_cam_projection.get_z_near());
@@ -3569,11 +4105,13 @@ void RasterizerSceneGLES3::_render_mrts(Environment *env, const CameraMatrix &p_
 		glBindTexture(GL_TEXTURE_2D, storage->frame.current_rt->depth);
 		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_COMPARE_MODE, GL_NONE);
 
-		glBindFramebuffer(GL_FRAMEBUFFER, storage->frame.current_rt->effects.mip_maps[1].sizes[0].fbo);
+		glBindFramebuffer(GL_FRAMEBUFFER, storage->frame.current_rt->effects.mip_maps[1].sizes[ssr_level].fbo);
 		glViewport(0, 0, ssr_w, ssr_h);
 
 		_copy_screen(true);
 		glViewport(0, 0, storage->frame.current_rt->width, storage->frame.current_rt->height);
+
+		storage->gpu_timer_end(ssr_timer);
 	}
 
 	glBindFramebuffer(GL_READ_FRAMEBUFFER, storage->frame.current_rt->buffers.fbo);
@@ -3590,6 +4128,7 @@ void RasterizerSceneGLES3::_render_mrts(Environment *env, const CameraMatrix &p_
 	state.resolve_shader.set_conditional(ResolveShaderGLES3::USE_SSR, env->ssr_enabled);
 	state.resolve_shader.bind();
 	state.resolve_shader.set_uniform(ResolveShaderGLES3::PIXEL_SIZE, Vector2(1.0 / storage->frame.current_rt->width, 1.0 / storage->frame.current_rt->height));
+	state.resolve_shader.set_uniform(ResolveShaderGLES3::SSR_LOD, (ssr_quarter_resolution && storage->frame.current_rt->effects.mip_maps[1].sizes.size() > 1) ? 1.0f : 0.0f);
 
 	glActiveTexture(GL_TEXTURE0);
 	glBindTexture(GL_TEXTURE_2D, storage->frame.current_rt->color);
@@ -3927,6 +4466,8 @@ void RasterizerSceneGLES3::_post_process(Environment *env, const CameraMatrix &p
 
 	if (env->glow_enabled) {
 
+		int glow_timer = storage->gpu_timer_begin(RasterizerStorageGLES3::GPU_TIMER_GLOW);
+
 		for (int i = 0; i < VS::MAX_GLOW_LEVELS; i++) {
 			if (env->glow_levels & (1 << i)) {
 
@@ -4001,6 +4542,8 @@ void RasterizerSceneGLES3::_post_process(Environment *env, const CameraMatrix &p
 		}
 
 		glViewport(0, 0, storage->frame.current_rt->width, storage->frame.current_rt->height);
+
+		storage->gpu_timer_end(glow_timer);
 	}
 
 	glBindFramebuffer(GL_FRAMEBUFFER, storage->frame.current_rt->fbo);
@@ -4437,6 +4980,8 @@ void RasterizerSceneGLES3::render_scene(const Transform &p_cam_transform, const
 
 	render_list.sort_by_key(false);
 
+	int opaque_timer = storage->gpu_timer_begin(RasterizerStorageGLES3::GPU_TIMER_OPAQUE);
+
 	if (state.directional_light_count == 0) {
 		directional_light = NULL;
 		_render_list(render_list.elements, render_list.element_count, p_cam_transform, p_cam_projection, env_radiance_tex, false, false, false, false, shadow_atlas != NULL);
@@ -4451,6 +4996,8 @@ void RasterizerSceneGLES3::render_scene(const Transform &p_cam_transform, const
 		}
 	}
 
+	storage->gpu_timer_end(opaque_timer);
+
 	state.scene_shader.set_conditional(SceneShaderGLES3::USE_MULTIPLE_RENDER_TARGETS, false);
 
 	if (use_mrt) {
@@ -4476,7 +5023,7 @@ void RasterizerSceneGLES3::render_scene(const Transform &p_cam_transform, const
 
 	if (use_mrt) {
 
-		_render_mrts(env, p_cam_projection);
+		_render_mrts(env, p_cam_transform, p_cam_projection);
 	} else {
 		// Here we have to do the blits/resolves that otherwise are done in the MRT rendering, in particular
 		// - prepare screen texture for any geometry that uses a shader with screen texture
@@ -4523,23 +5070,29 @@ void RasterizerSceneGLES3::render_scene(const Transform &p_cam_transform, const
 
 	render_list.sort_by_reverse_depth_and_priority(true);
 
+	int alpha_timer = storage->gpu_timer_begin(RasterizerStorageGLES3::GPU_TIMER_ALPHA);
+
 	if (state.directional_light_count == 0) {
 		directional_light = NULL;
-		_render_list(&render_list.elements[render_list.max_elements - render_list.alpha_element_count], render_list.alpha_element_count, p_cam_transform, p_cam_projection, env_radiance_tex, false, true, false, false, shadow_atlas != NULL);
+		_render_list(render_list.alpha_elements, render_list.alpha_element_count, p_cam_transform, p_cam_projection, env_radiance_tex, false, true, false, false, shadow_atlas != NULL);
 	} else {
 		for (int i = 0; i < state.directional_light_count; i++) {
 			directional_light = directional_lights[i];
 			_setup_directional_light(i, p_cam_transform.affine_inverse(), shadow_atlas != NULL && shadow_atlas->size > 0);
-			_render_list(&render_list.elements[render_list.max_elements - render_list.alpha_element_count], render_list.alpha_element_count, p_cam_transform, p_cam_projection, env_radiance_tex, false, true, false, i > 0, shadow_atlas != NULL);
+			_render_list(render_list.alpha_elements, render_list.alpha_element_count, p_cam_transform, p_cam_projection, env_radiance_tex, false, true, false, i > 0, shadow_atlas != NULL);
 		}
 	}
 
+	storage->gpu_timer_end(alpha_timer);
+
 	if (probe) {
 		//rendering a probe, do no more!
 		return;
 	}
 
+	int post_process_timer = storage->gpu_timer_begin(RasterizerStorageGLES3::GPU_TIMER_POST_PROCESS);
 	_post_process(env, p_cam_projection);
+	storage->gpu_timer_end(post_process_timer);
 
 	if (false && shadow_atlas) {
 
@@ -4598,6 +5151,13 @@ void RasterizerSceneGLES3::render_scene(const Transform &p_cam_transform, const
 
 void RasterizerSceneGLES3::render_shadow(RID p_light, RID p_shadow_atlas, int p_pass, InstanceBase **p_cull_result, int p_cull_count) {
 
+	int shadow_timer = storage->gpu_timer_begin(RasterizerStorageGLES3::GPU_TIMER_SHADOWS);
+	_render_shadow(p_light, p_shadow_atlas, p_pass, p_cull_result, p_cull_count);
+	storage->gpu_timer_end(shadow_timer);
+}
+
+void RasterizerSceneGLES3::_render_shadow(RID p_light, RID p_shadow_atlas, int p_pass, InstanceBase **p_cull_result, int p_cull_count) {
+
 	render_pass++;
 
 	directional_light = NULL;
@@ -4870,6 +5430,48 @@ void RasterizerSceneGLES3::set_scene_pass(uint64_t p_pass) {
 	scene_pass = p_pass;
 }
 
+void RasterizerSceneGLES3::video_memory_debug_usage(List<VS::VideoMemoryInfo> *r_info) {
+
+	List<RID> owned;
+
+	shadow_atlas_owner.get_owned_list(&owned);
+	for (List<RID>::Element *E = owned.front(); E; E = E->next()) {
+
+		ShadowAtlas *shadow_atlas = shadow_atlas_owner.getornull(E->get());
+		if (!shadow_atlas || !shadow_atlas->size)
+			continue;
+		VS::VideoMemoryInfo vinfo;
+		vinfo.rid = E->get();
+		vinfo.type = "ShadowAtlas";
+		vinfo.format = itos(shadow_atlas->size) + "x" + itos(shadow_atlas->size) + " DEPTH24";
+		vinfo.bytes = _shadow_atlas_bytes(shadow_atlas->size);
+		r_info->push_back(vinfo);
+	}
+
+	owned.clear();
+	reflection_atlas_owner.get_owned_list(&owned);
+	for (List<RID>::Element *E = owned.front(); E; E = E->next()) {
+
+		ReflectionAtlas *reflection_atlas = reflection_atlas_owner.getornull(E->get());
+		if (!reflection_atlas || !reflection_atlas->size)
+			continue;
+		VS::VideoMemoryInfo vinfo;
+		vinfo.rid = E->get();
+		vinfo.type = "ReflectionAtlas";
+		vinfo.format = itos(reflection_atlas->size) + "x" + itos(reflection_atlas->size) + " RGBAH";
+		vinfo.bytes = _reflection_atlas_bytes(reflection_atlas->size);
+		r_info->push_back(vinfo);
+	}
+
+	if (directional_shadow.size) {
+		VS::VideoMemoryInfo vinfo;
+		vinfo.type = "DirectionalShadow";
+		vinfo.format = itos(directional_shadow.size) + "x" + itos(directional_shadow.size) + " DEPTH24";
+		vinfo.bytes = _shadow_atlas_bytes(directional_shadow.size);
+		r_info->push_back(vinfo);
+	}
+}
+
 bool RasterizerSceneGLES3::free(RID p_rid) {
 
 	if (light_instance_owner.owns(p_rid)) {
@@ -4974,7 +5576,7 @@ void RasterizerSceneGLES3::initialize() {
 	glBufferData(GL_UNIFORM_BUFFER, sizeof(State::EnvironmentRadianceUBO), &state.env_radiance_ubo, GL_DYNAMIC_DRAW);
 	glBindBuffer(GL_UNIFORM_BUFFER, 0);
 
-	render_list.max_elements = GLOBAL_DEF_RST("rendering/limits/rendering/max_renderable_elements", (int)RenderList::DEFAULT_MAX_ELEMENTS);
+	render_list.initial_elements = GLOBAL_DEF_RST("rendering/limits/rendering/max_renderable_elements", (int)RenderList::DEFAULT_INITIAL_ELEMENTS);
 	ProjectSettings::get_singleton()->set_custom_property_info("rendering/limits/rendering/max_renderable_elements", PropertyInfo(Variant::INT, "rendering/limits/rendering/max_renderable_elements", PROPERTY_HINT_RANGE, "1024,1000000,1"));
 
 	{
@@ -5061,6 +5663,7 @@ void RasterizerSceneGLES3::initialize() {
 		if (status != GL_FRAMEBUFFER_COMPLETE) {
 			ERR_PRINT("Directional shadow framebuffer status invalid");
 		}
+		storage->info.shadow_mem += _shadow_atlas_bytes(directional_shadow.size);
 	}
 
 	{
@@ -5090,7 +5693,8 @@ void RasterizerSceneGLES3::initialize() {
 		glBufferData(GL_UNIFORM_BUFFER, sizeof(LightDataUBO), NULL, GL_DYNAMIC_DRAW);
 		glBindBuffer(GL_UNIFORM_BUFFER, 0);
 
-		state.max_forward_lights_per_object = 8;
+		state.max_forward_lights_per_object = CLAMP(int(GLOBAL_DEF_RST("rendering/limits/rendering/max_lights_per_object", 8)), 1, 16);
+		ProjectSettings::get_singleton()->set_custom_property_info("rendering/limits/rendering/max_lights_per_object", PropertyInfo(Variant::INT, "rendering/limits/rendering/max_lights_per_object", PROPERTY_HINT_RANGE, "1,16,1"));
 
 		state.scene_shader.add_custom_define("#define MAX_LIGHT_DATA_STRUCTS " + itos(state.max_ubo_lights) + "\n");
 		state.scene_shader.add_custom_define("#define MAX_FORWARD_LIGHTS " + itos(state.max_forward_lights_per_object) + "\n");
@@ -5184,6 +5788,21 @@ void RasterizerSceneGLES3::initialize() {
 		glGenVertexArrays(1, &state.immediate_array);
 	}
 
+	{
+
+		state.auto_instancing = GLOBAL_DEF("rendering/quality/auto_instancing/enabled", true);
+		uint32_t auto_instancing_buffer_size = GLOBAL_DEF("rendering/limits/buffers/auto_instancing_buffer_size_kb", 256);
+		ProjectSettings::get_singleton()->set_custom_property_info("rendering/limits/buffers/auto_instancing_buffer_size_kb", PropertyInfo(Variant::INT, "rendering/limits/buffers/auto_instancing_buffer_size_kb", PROPERTY_HINT_RANGE, "1,4096,1,or_greater"));
+
+		state.auto_instancing_buffer_size = MAX(auto_instancing_buffer_size, 1u) * 1024;
+		state.auto_instancing_buffer_cursor = 0;
+
+		glGenBuffers(1, &state.auto_instancing_buffer);
+		glBindBuffer(GL_ARRAY_BUFFER, state.auto_instancing_buffer);
+		glBufferData(GL_ARRAY_BUFFER, state.auto_instancing_buffer_size, NULL, GL_DYNAMIC_DRAW);
+		glBindBuffer(GL_ARRAY_BUFFER, 0);
+	}
+
 #ifdef GLES_OVER_GL
 	//"desktop" opengl needs this.
 	glEnable(GL_PROGRAM_POINT_SIZE);
@@ -5209,6 +5828,12 @@ void RasterizerSceneGLES3::initialize() {
 		GLOBAL_DEF("rendering/quality/subsurface_scattering/weight_samples", true);
 
 		GLOBAL_DEF("rendering/quality/voxel_cone_tracing/high_quality", true);
+
+		GLOBAL_DEF("rendering/quality/ssao/resolution", 0);
+		ProjectSettings::get_singleton()->set_custom_property_info("rendering/quality/ssao/resolution", PropertyInfo(Variant::INT, "rendering/quality/ssao/resolution", PROPERTY_HINT_ENUM, "Full,Half,Quarter"));
+		GLOBAL_DEF("rendering/quality/ssao/temporal_accumulation", false);
+		GLOBAL_DEF("rendering/quality/screen_space_reflection/resolution", 0);
+		ProjectSettings::get_singleton()->set_custom_property_info("rendering/quality/screen_space_reflection/resolution", PropertyInfo(Variant::INT, "rendering/quality/screen_space_reflection/resolution", PROPERTY_HINT_ENUM, "Half,Quarter"));
 	}
 
 	exposure_shrink_size = 243;
@@ -5258,6 +5883,10 @@ void RasterizerSceneGLES3::iteration() {
 	subsurface_scatter_quality = SubSurfaceScatterQuality(int(GLOBAL_GET("rendering/quality/subsurface_scattering/quality")));
 	subsurface_scatter_size = GLOBAL_GET("rendering/quality/subsurface_scattering/scale");
 
+	ssao_resolution_shift = CLAMP(int(GLOBAL_GET("rendering/quality/ssao/resolution")), 0, 2);
+	ssao_temporal_accumulation = GLOBAL_GET("rendering/quality/ssao/temporal_accumulation");
+	ssr_quarter_resolution = int(GLOBAL_GET("rendering/quality/screen_space_reflection/resolution")) == 1;
+
 	state.scene_shader.set_conditional(SceneShaderGLES3::VCT_QUALITY_HIGH, GLOBAL_GET("rendering/quality/voxel_cone_tracing/high_quality"));
 }
 
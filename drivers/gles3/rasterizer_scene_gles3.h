@@ -69,6 +69,10 @@ public:
 	bool subsurface_scatter_follow_surface;
 	bool subsurface_scatter_weight_samples;
 
+	int ssao_resolution_shift;
+	bool ssao_temporal_accumulation;
+	bool ssr_quarter_resolution;
+
 	uint64_t render_pass;
 	uint64_t scene_pass;
 	uint32_t current_material_index;
@@ -101,6 +105,14 @@ public:
 		bool current_depth_test;
 		GLuint current_main_tex;
 
+		//what _setup_material left bound, so redundant binds can be skipped within a render list
+		enum {
+			MATERIAL_TEXTURE_CACHE_SIZE = 16
+		};
+		GLuint material_bound_tex[MATERIAL_TEXTURE_CACHE_SIZE];
+		GLenum material_bound_target[MATERIAL_TEXTURE_CACHE_SIZE];
+		GLuint material_bound_ubo;
+
 		SceneShaderGLES3 scene_shader;
 		CubeToDpShaderGLES3 cube_to_dp_shader;
 		ResolveShaderGLES3 resolve_shader;
@@ -183,6 +195,12 @@ public:
 		GLuint immediate_buffer;
 		GLuint immediate_array;
 
+		// runs of identical mesh surfaces are drawn instanced, with their transforms streamed here
+		bool auto_instancing;
+		GLuint auto_instancing_buffer;
+		uint32_t auto_instancing_buffer_size;
+		uint32_t auto_instancing_buffer_cursor;
+
 		uint32_t ubo_light_size;
 		uint8_t *spot_array_tmp;
 		uint8_t *omni_array_tmp;
@@ -661,7 +679,7 @@ public:
 	struct RenderList {
 
 		enum {
-			DEFAULT_MAX_ELEMENTS = 65536,
+			DEFAULT_INITIAL_ELEMENTS = 65536,
 			SORT_FLAG_SKELETON = 1,
 			SORT_FLAG_INSTANCING = 2,
 			MAX_DIRECTIONAL_LIGHTS = 16,
@@ -696,7 +714,7 @@ public:
 
 		};
 
-		int max_elements;
+		int initial_elements;
 
 		struct Element {
 
@@ -707,11 +725,27 @@ public:
 			uint64_t sort_key;
 		};
 
-		Element *base_elements;
-		Element **elements;
+		/* Elements live in per-frame arrays that are cleared, but never shrunk, every frame.
+		 * They grow on demand and are sorted in place, so the render loop walks them linearly.
+		 */
+
+		Element *elements;
+		Element *alpha_elements;
 
 		int element_count;
 		int alpha_element_count;
+		int element_capacity;
+		int alpha_element_capacity;
+
+		struct SortEntry {
+			uint64_t key;
+			uint32_t index;
+		};
+
+		SortEntry *sort_entries;
+		SortEntry *sort_entries_tmp;
+		Element *sort_elements_tmp;
+		int sort_capacity;
 
 		void clear() {
 
@@ -719,102 +753,46 @@ public:
 			alpha_element_count = 0;
 		}
 
-		//should eventually be replaced by radix
-
-		struct SortByKey {
-
-			_FORCE_INLINE_ bool operator()(const Element *A, const Element *B) const {
-				return A->sort_key < B->sort_key;
-			}
+		enum SortMode {
+			SORT_MODE_KEY,
+			SORT_MODE_DEPTH, //used for shadows
+			SORT_MODE_REVERSE_DEPTH_AND_PRIORITY, //used for alpha
 		};
 
-		void sort_by_key(bool p_alpha) {
+		void sort(bool p_alpha, SortMode p_mode);
 
-			SortArray<Element *, SortByKey> sorter;
-			if (p_alpha) {
-				sorter.sort(&elements[max_elements - alpha_element_count], alpha_element_count);
-			} else {
-				sorter.sort(elements, element_count);
-			}
+		void sort_by_key(bool p_alpha) {
+			sort(p_alpha, SORT_MODE_KEY);
 		}
 
-		struct SortByDepth {
-
-			_FORCE_INLINE_ bool operator()(const Element *A, const Element *B) const {
-				return A->instance->depth < B->instance->depth;
-			}
-		};
-
-		void sort_by_depth(bool p_alpha) { //used for shadows
-
-			SortArray<Element *, SortByDepth> sorter;
-			if (p_alpha) {
-				sorter.sort(&elements[max_elements - alpha_element_count], alpha_element_count);
-			} else {
-				sorter.sort(elements, element_count);
-			}
+		void sort_by_depth(bool p_alpha) {
+			sort(p_alpha, SORT_MODE_DEPTH);
 		}
 
-		struct SortByReverseDepthAndPriority {
-
-			_FORCE_INLINE_ bool operator()(const Element *A, const Element *B) const {
-				uint32_t layer_A = uint32_t(A->sort_key >> SORT_KEY_PRIORITY_SHIFT);
-				uint32_t layer_B = uint32_t(B->sort_key >> SORT_KEY_PRIORITY_SHIFT);
-				if (layer_A == layer_B) {
-					return A->instance->depth > B->instance->depth;
-				} else {
-					return layer_A < layer_B;
-				}
-			}
-		};
-
-		void sort_by_reverse_depth_and_priority(bool p_alpha) { //used for alpha
-
-			SortArray<Element *, SortByReverseDepthAndPriority> sorter;
-			if (p_alpha) {
-				sorter.sort(&elements[max_elements - alpha_element_count], alpha_element_count);
-			} else {
-				sorter.sort(elements, element_count);
-			}
+		void sort_by_reverse_depth_and_priority(bool p_alpha) {
+			sort(p_alpha, SORT_MODE_REVERSE_DEPTH_AND_PRIORITY);
 		}
 
+		static Element *_grow(Element *p_elements, int &r_capacity);
+
 		_FORCE_INLINE_ Element *add_element() {
 
-			if (element_count + alpha_element_count >= max_elements)
-				return NULL;
-			elements[element_count] = &base_elements[element_count];
-			return elements[element_count++];
+			if (unlikely(element_count == element_capacity))
+				elements = _grow(elements, element_capacity);
+			return &elements[element_count++];
 		}
 
 		_FORCE_INLINE_ Element *add_alpha_element() {
 
-			if (element_count + alpha_element_count >= max_elements)
-				return NULL;
-			int idx = max_elements - alpha_element_count - 1;
-			elements[idx] = &base_elements[idx];
-			alpha_element_count++;
-			return elements[idx];
+			if (unlikely(alpha_element_count == alpha_element_capacity))
+				alpha_elements = _grow(alpha_elements, alpha_element_capacity);
+			return &alpha_elements[alpha_element_count++];
 		}
 
-		void init() {
-
-			element_count = 0;
-			alpha_element_count = 0;
-			elements = memnew_arr(Element *, max_elements);
-			base_elements = memnew_arr(Element, max_elements);
-			for (int i = 0; i < max_elements; i++)
-				elements[i] = &base_elements[i]; // assign elements
-		}
+		void init();
 
-		RenderList() {
-
-			max_elements = DEFAULT_MAX_ELEMENTS;
-		}
-
-		~RenderList() {
-			memdelete_arr(elements);
-			memdelete_arr(base_elements);
-		}
+		RenderList();
+		~RenderList();
 	};
 
 	LightInstance *directional_light;
@@ -827,9 +805,12 @@ public:
 	_FORCE_INLINE_ bool _setup_material(RasterizerStorageGLES3::Material *p_material, bool p_alpha_pass);
 	_FORCE_INLINE_ void _setup_geometry(RenderList::Element *e, const Transform &p_view_transform);
 	_FORCE_INLINE_ void _render_geometry(RenderList::Element *e);
+	_FORCE_INLINE_ bool _can_auto_instance(const RenderList::Element *e, const RenderList::Element *p_next, bool p_lighting) const;
+	_FORCE_INLINE_ void _setup_auto_instancing(RenderList::Element *p_elements, int p_count);
+	_FORCE_INLINE_ void _render_auto_instanced(RenderList::Element *e, int p_count);
 	_FORCE_INLINE_ void _setup_light(RenderList::Element *e, const Transform &p_view_transform);
 
-	void _render_list(RenderList::Element **p_elements, int p_element_count, const Transform &p_view_transform, const CameraMatrix &p_projection, GLuint p_base_env, bool p_reverse_cull, bool p_alpha_pass, bool p_shadow, bool p_directional_add, bool p_directional_shadows);
+	void _render_list(RenderList::Element *p_elements, int p_element_count, const Transform &p_view_transform, const CameraMatrix &p_projection, GLuint p_base_env, bool p_reverse_cull, bool p_alpha_pass, bool p_shadow, bool p_directional_add, bool p_directional_shadows);
 
 	_FORCE_INLINE_ void _add_geometry(RasterizerStorageGLES3::Geometry *p_geometry, InstanceBase *p_instance, RasterizerStorageGLES3::GeometryOwner *p_owner, int p_material, bool p_depth_pass, bool p_shadow_pass);
 
@@ -848,15 +829,17 @@ public:
 	void _fill_render_list(InstanceBase **p_cull_result, int p_cull_count, bool p_depth_pass, bool p_shadow_pass);
 
 	void _blur_effect_buffer();
-	void _render_mrts(Environment *env, const CameraMatrix &p_cam_projection);
+	void _render_mrts(Environment *env, const Transform &p_cam_transform, const CameraMatrix &p_cam_projection);
 	void _post_process(Environment *env, const CameraMatrix &p_cam_projection);
 
 	void _prepare_depth_texture();
 	void _bind_depth_texture();
 
 	virtual void render_scene(const Transform &p_cam_transform, const CameraMatrix &p_cam_projection, bool p_cam_ortogonal, InstanceBase **p_cull_result, int p_cull_count, RID *p_light_cull_result, int p_light_cull_count, RID *p_reflection_probe_cull_result, int p_reflection_probe_cull_count, RID p_environment, RID p_shadow_atlas, RID p_reflection_atlas, RID p_reflection_probe, int p_reflection_probe_pass);
+	void _render_shadow(RID p_light, RID p_shadow_atlas, int p_pass, InstanceBase **p_cull_result, int p_cull_count);
 	virtual void render_shadow(RID p_light, RID p_shadow_atlas, int p_pass, InstanceBase **p_cull_result, int p_cull_count);
 	virtual bool free(RID p_rid);
+	virtual void video_memory_debug_usage(List<VS::VideoMemoryInfo> *r_info);
 
 	virtual void set_scene_pass(uint64_t p_pass);
 	virtual void set_debug_draw_mode(VS::ViewportDebugDraw p_debug_draw);
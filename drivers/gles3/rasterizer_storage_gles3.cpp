@@ -2328,6 +2328,48 @@ RID RasterizerStorageGLES3::shader_get_default_texture_param(RID p_shader, const
 	return E->get();
 }
 
+PoolIntArray RasterizerStorageGLES3::shader_get_compiled_variants(RID p_shader) const {
+
+	const Shader *shader = shader_owner.get(p_shader);
+	ERR_FAIL_COND_V(!shader, PoolIntArray());
+
+	PoolIntArray variants;
+	if (!shader->shader || !shader->custom_code_id) {
+		return variants;
+	}
+
+	List<uint32_t> versions;
+	shader->shader->get_custom_shader_versions(shader->custom_code_id, &versions);
+
+	variants.resize(versions.size());
+	PoolIntArray::Write w = variants.write();
+	int idx = 0;
+	for (List<uint32_t>::Element *E = versions.front(); E; E = E->next()) {
+		w[idx++] = E->get();
+	}
+
+	return variants;
+}
+
+void RasterizerStorageGLES3::shader_precompile_variants(RID p_shader, const PoolIntArray &p_variants) {
+
+	Shader *shader = shader_owner.get(p_shader);
+	ERR_FAIL_COND(!shader);
+
+	if (shader->dirty_list.in_list()) {
+		_update_shader(shader);
+	}
+
+	if (!shader->valid || !shader->shader) {
+		return;
+	}
+
+	PoolIntArray::Read r = p_variants.read();
+	for (int i = 0; i < p_variants.size(); i++) {
+		shader->shader->precompile_custom_shader_version(shader->custom_code_id, r[i]);
+	}
+}
+
 /* COMMON MATERIAL API */
 
 void RasterizerStorageGLES3::_material_make_dirty(Material *p_material) const {
@@ -3165,7 +3207,7 @@ RID RasterizerStorageGLES3::mesh_create() {
 	return mesh_owner.make_rid(mesh);
 }
 
-void RasterizerStorageGLES3::mesh_add_surface(RID p_mesh, uint32_t p_format, VS::PrimitiveType p_primitive, const PoolVector<uint8_t> &p_array, int p_vertex_count, const PoolVector<uint8_t> &p_index_array, int p_index_count, const AABB &p_aabb, const Vector<PoolVector<uint8_t> > &p_blend_shapes, const Vector<AABB> &p_bone_aabbs) {
+void RasterizerStorageGLES3::mesh_add_surface(RID p_mesh, uint32_t p_format, VS::PrimitiveType p_primitive, const PoolVector<uint8_t> &p_array, int p_vertex_count, const PoolVector<uint8_t> &p_index_array, int p_index_count, const AABB &p_aabb, const Vector<PoolVector<uint8_t> > &p_blend_shapes, const Vector<AABB> &p_bone_aabbs, const Rect2 &p_uv_range) {
 
 	PoolVector<uint8_t> array = p_array;
 
@@ -3211,7 +3253,14 @@ void RasterizerStorageGLES3::mesh_add_surface(RID p_mesh, uint32_t p_format, VS:
 					attribs[i].size = (p_format & VS::ARRAY_COMPRESS_VERTEX) ? 4 : 3;
 				}
 
-				if (p_format & VS::ARRAY_COMPRESS_VERTEX) {
+				attribs[i].normalized = GL_FALSE;
+
+				if (p_format & VS::ARRAY_FLAG_USE_QUANTIZED_VERTICES) {
+					//relative to the surface AABB, padded to 4 components
+					attribs[i].type = GL_UNSIGNED_SHORT;
+					attribs[i].normalized = GL_TRUE;
+					stride += 8;
+				} else if (p_format & VS::ARRAY_COMPRESS_VERTEX) {
 					attribs[i].type = GL_HALF_FLOAT;
 					stride += attribs[i].size * 2;
 				} else {
@@ -3219,14 +3268,18 @@ void RasterizerStorageGLES3::mesh_add_surface(RID p_mesh, uint32_t p_format, VS:
 					stride += attribs[i].size * 4;
 				}
 
-				attribs[i].normalized = GL_FALSE;
-
 			} break;
 			case VS::ARRAY_NORMAL: {
 
 				attribs[i].size = 3;
 
-				if (p_format & VS::ARRAY_COMPRESS_NORMAL) {
+				if (p_format & VS::ARRAY_FLAG_USE_OCTAHEDRAL_NORMALS) {
+					//normal and tangent packed in two words, unpacked by the shader
+					attribs[i].size = 2;
+					attribs[i].type = GL_UNSIGNED_SHORT;
+					stride += 4;
+					attribs[i].normalized = GL_FALSE;
+				} else if (p_format & VS::ARRAY_COMPRESS_NORMAL) {
 					attribs[i].type = GL_BYTE;
 					stride += 4; //pad extra byte
 					attribs[i].normalized = GL_TRUE;
@@ -3241,7 +3294,9 @@ void RasterizerStorageGLES3::mesh_add_surface(RID p_mesh, uint32_t p_format, VS:
 
 				attribs[i].size = 4;
 
-				if (p_format & VS::ARRAY_COMPRESS_TANGENT) {
+				if (p_format & VS::ARRAY_FLAG_USE_OCTAHEDRAL_NORMALS) {
+					attribs[i].enabled = false; //comes with the normal
+				} else if (p_format & VS::ARRAY_COMPRESS_TANGENT) {
 					attribs[i].type = GL_BYTE;
 					stride += 4;
 					attribs[i].normalized = GL_TRUE;
@@ -3270,8 +3325,13 @@ void RasterizerStorageGLES3::mesh_add_surface(RID p_mesh, uint32_t p_format, VS:
 			case VS::ARRAY_TEX_UV: {
 
 				attribs[i].size = 2;
+				attribs[i].normalized = GL_FALSE;
 
-				if (p_format & VS::ARRAY_COMPRESS_TEX_UV) {
+				if (p_format & VS::ARRAY_FLAG_USE_QUANTIZED_UV) {
+					attribs[i].type = GL_UNSIGNED_SHORT;
+					attribs[i].normalized = GL_TRUE;
+					stride += 4;
+				} else if (p_format & VS::ARRAY_COMPRESS_TEX_UV) {
 					attribs[i].type = GL_HALF_FLOAT;
 					stride += 4;
 				} else {
@@ -3279,8 +3339,6 @@ void RasterizerStorageGLES3::mesh_add_surface(RID p_mesh, uint32_t p_format, VS:
 					stride += 8;
 				}
 
-				attribs[i].normalized = GL_FALSE;
-
 			} break;
 			case VS::ARRAY_TEX_UV2: {
 
@@ -3410,6 +3468,7 @@ void RasterizerStorageGLES3::mesh_add_surface(RID p_mesh, uint32_t p_format, VS:
 	surface->skeleton_bone_aabb = p_bone_aabbs;
 	surface->skeleton_bone_used.resize(surface->skeleton_bone_aabb.size());
 	surface->aabb = p_aabb;
+	surface->uv_range = p_uv_range;
 	surface->max_bone = p_bone_aabbs.size();
 	surface->total_data_size += surface->array_byte_size + surface->index_array_byte_size;
 
@@ -3686,6 +3745,69 @@ void RasterizerStorageGLES3::mesh_surface_update_region(RID p_mesh, int p_surfac
 	glBindBuffer(GL_ARRAY_BUFFER, 0); //unbind
 }
 
+void RasterizerStorageGLES3::mesh_surface_set_lods(RID p_mesh, int p_surface, const Vector<PoolVector<uint8_t> > &p_lod_indices, const Vector<float> &p_lod_errors) {
+
+	Mesh *mesh = mesh_owner.getornull(p_mesh);
+	ERR_FAIL_COND(!mesh);
+	ERR_FAIL_INDEX(p_surface, mesh->surfaces.size());
+	ERR_FAIL_COND(p_lod_indices.size() != p_lod_errors.size());
+
+	Surface *surface = mesh->surfaces[p_surface];
+	ERR_FAIL_COND(!surface->index_id);
+
+	int index_size = surface->array_len >= (1 << 16) ? 4 : 2;
+	int total_size = surface->index_array_byte_size;
+	for (int i = 0; i < p_lod_indices.size(); i++) {
+		ERR_FAIL_COND(p_lod_indices[i].size() % index_size != 0);
+		total_size += p_lod_indices[i].size();
+	}
+
+	// All levels go after the base indices in one buffer, so the VAOs keep working and a level is just a draw offset.
+	GLuint index_id;
+	glGenBuffers(1, &index_id);
+	glBindBuffer(GL_COPY_WRITE_BUFFER, index_id);
+	glBufferData(GL_COPY_WRITE_BUFFER, total_size, NULL, GL_STATIC_DRAW);
+	glBindBuffer(GL_COPY_READ_BUFFER, surface->index_id);
+	glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, 0, 0, surface->index_array_byte_size);
+
+	int old_size = surface->index_array_byte_size;
+	for (int i = 0; i < surface->lods.size(); i++) {
+		old_size += surface->lods[i].index_count * index_size;
+	}
+
+	surface->lods.clear();
+	int offset = surface->index_array_byte_size;
+	for (int i = 0; i < p_lod_indices.size(); i++) {
+
+		PoolVector<uint8_t>::Read r = p_lod_indices[i].read();
+		glBufferSubData(GL_COPY_WRITE_BUFFER, offset, p_lod_indices[i].size(), r.ptr());
+
+		Surface::LOD lod;
+		lod.index_offset = offset;
+		lod.index_count = p_lod_indices[i].size() / index_size;
+		lod.error = p_lod_errors[i];
+		surface->lods.push_back(lod);
+
+		offset += p_lod_indices[i].size();
+	}
+
+	glBindBuffer(GL_COPY_READ_BUFFER, 0);
+	glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+
+	glBindVertexArray(surface->array_id);
+	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, index_id);
+	glBindVertexArray(surface->instancing_array_id);
+	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, index_id);
+	glBindVertexArray(0);
+	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+
+	glDeleteBuffers(1, &surface->index_id);
+	surface->index_id = index_id;
+
+	info.vertex_mem += total_size - old_size;
+	surface->total_data_size += total_size - old_size;
+}
+
 void RasterizerStorageGLES3::mesh_surface_set_material(RID p_mesh, int p_surface, RID p_material) {
 
 	Mesh *mesh = mesh_owner.getornull(p_mesh);
@@ -3823,6 +3945,15 @@ AABB RasterizerStorageGLES3::mesh_surface_get_aabb(RID p_mesh, int p_surface) co
 
 	return mesh->surfaces[p_surface]->aabb;
 }
+
+Rect2 RasterizerStorageGLES3::mesh_surface_get_uv_range(RID p_mesh, int p_surface) const {
+
+	const Mesh *mesh = mesh_owner.getornull(p_mesh);
+	ERR_FAIL_COND_V(!mesh, Rect2());
+	ERR_FAIL_INDEX_V(p_surface, mesh->surfaces.size(), Rect2());
+
+	return mesh->surfaces[p_surface]->uv_range;
+}
 Vector<PoolVector<uint8_t> > RasterizerStorageGLES3::mesh_surface_get_blend_shapes(RID p_mesh, int p_surface) const {
 
 	const Mesh *mesh = mesh_owner.getornull(p_mesh);
@@ -4290,6 +4421,7 @@ void RasterizerStorageGLES3::multimesh_allocate(RID p_multimesh, int p_instances
 
 	if (multimesh->buffer) {
 		glDeleteBuffers(1, &multimesh->buffer);
+		info.multimesh_mem -= multimesh->data.size() * sizeof(float);
 		multimesh->data.resize(0);
 	}
 
@@ -4406,8 +4538,16 @@ void RasterizerStorageGLES3::multimesh_allocate(RID p_multimesh, int p_instances
 		glBindBuffer(GL_ARRAY_BUFFER, multimesh->buffer);
 		glBufferData(GL_ARRAY_BUFFER, multimesh->data.size() * sizeof(float), NULL, GL_STATIC_DRAW);
 		glBindBuffer(GL_ARRAY_BUFFER, 0);
+		info.multimesh_mem += multimesh->data.size() * sizeof(float);
 	}
 
+	multimesh->dirty_regions.resize((p_instances + MultiMesh::DIRTY_REGION_INSTANCES - 1) / MultiMesh::DIRTY_REGION_INSTANCES);
+	for (int i = 0; i < multimesh->dirty_regions.size(); i++) {
+		multimesh->dirty_regions[i] = false;
+	}
+	multimesh->dirty_region_count = 0;
+	multimesh->full_uploads = 0;
+
 	multimesh->dirty_data = true;
 	multimesh->dirty_aabb = true;
 
@@ -4452,6 +4592,28 @@ void RasterizerStorageGLES3::multimesh_set_mesh(RID p_multimesh, RID p_mesh) {
 	}
 }
 
+void RasterizerStorageGLES3::_multimesh_mark_dirty(MultiMesh *p_multimesh, int p_from, int p_to, bool p_aabb) {
+
+	if (!p_multimesh->dirty_data) {
+		int from = p_from / MultiMesh::DIRTY_REGION_INSTANCES;
+		int to = (p_to - 1) / MultiMesh::DIRTY_REGION_INSTANCES;
+		for (int i = from; i <= to; i++) {
+			if (!p_multimesh->dirty_regions[i]) {
+				p_multimesh->dirty_regions[i] = true;
+				p_multimesh->dirty_region_count++;
+			}
+		}
+	}
+
+	if (p_aabb) {
+		p_multimesh->dirty_aabb = true;
+	}
+
+	if (!p_multimesh->update_list.in_list()) {
+		multimesh_update_list.add(&p_multimesh->update_list);
+	}
+}
+
 void RasterizerStorageGLES3::multimesh_instance_set_transform(RID p_multimesh, int p_index, const Transform &p_transform) {
 
 	MultiMesh *multimesh = multimesh_owner.getornull(p_multimesh);
@@ -4475,12 +4637,7 @@ void RasterizerStorageGLES3::multimesh_instance_set_transform(RID p_multimesh, i
 	dataptr[10] = p_transform.basis.elements[2][2];
 	dataptr[11] = p_transform.origin.z;
 
-	multimesh->dirty_data = true;
-	multimesh->dirty_aabb = true;
-
-	if (!multimesh->update_list.in_list()) {
-		multimesh_update_list.add(&multimesh->update_list);
-	}
+	_multimesh_mark_dirty(multimesh, p_index, p_index + 1, true);
 }
 
 void RasterizerStorageGLES3::multimesh_instance_set_transform_2d(RID p_multimesh, int p_index, const Transform2D &p_transform) {
@@ -4502,12 +4659,7 @@ void RasterizerStorageGLES3::multimesh_instance_set_transform_2d(RID p_multimesh
 	dataptr[6] = 0;
 	dataptr[7] = p_transform.elements[2][1];
 
-	multimesh->dirty_data = true;
-	multimesh->dirty_aabb = true;
-
-	if (!multimesh->update_list.in_list()) {
-		multimesh_update_list.add(&multimesh->update_list);
-	}
+	_multimesh_mark_dirty(multimesh, p_index, p_index + 1, true);
 }
 void RasterizerStorageGLES3::multimesh_instance_set_color(RID p_multimesh, int p_index, const Color &p_color) {
 
@@ -4534,12 +4686,7 @@ void RasterizerStorageGLES3::multimesh_instance_set_color(RID p_multimesh, int p
 		dataptr[3] = p_color.a;
 	}
 
-	multimesh->dirty_data = true;
-	multimesh->dirty_aabb = true;
-
-	if (!multimesh->update_list.in_list()) {
-		multimesh_update_list.add(&multimesh->update_list);
-	}
+	_multimesh_mark_dirty(multimesh, p_index, p_index + 1, false);
 }
 
 void RasterizerStorageGLES3::multimesh_instance_set_custom_data(RID p_multimesh, int p_index, const Color &p_custom_data) {
@@ -4567,12 +4714,7 @@ void RasterizerStorageGLES3::multimesh_instance_set_custom_data(RID p_multimesh,
 		dataptr[3] = p_custom_data.a;
 	}
 
-	multimesh->dirty_data = true;
-	multimesh->dirty_aabb = true;
-
-	if (!multimesh->update_list.in_list()) {
-		multimesh_update_list.add(&multimesh->update_list);
-	}
+	_multimesh_mark_dirty(multimesh, p_index, p_index + 1, false);
 }
 RID RasterizerStorageGLES3::multimesh_get_mesh(RID p_multimesh) const {
 
@@ -4717,6 +4859,24 @@ void RasterizerStorageGLES3::multimesh_set_as_bulk_array(RID p_multimesh, const
 	}
 }
 
+void RasterizerStorageGLES3::multimesh_set_as_bulk_array_range(RID p_multimesh, int p_from_instance, const PoolVector<float> &p_array) {
+
+	MultiMesh *multimesh = multimesh_owner.getornull(p_multimesh);
+	ERR_FAIL_COND(!multimesh);
+
+	int stride = multimesh->color_floats + multimesh->xform_floats + multimesh->custom_data_floats;
+	ERR_FAIL_COND(stride == 0 || p_array.size() % stride != 0);
+	int count = p_array.size() / stride;
+	ERR_FAIL_COND(p_from_instance < 0 || p_from_instance + count > multimesh->size);
+	if (count == 0)
+		return;
+
+	PoolVector<float>::Read r = p_array.read();
+	copymem(multimesh->data.ptrw() + p_from_instance * stride, r.ptr(), p_array.size() * sizeof(float));
+
+	_multimesh_mark_dirty(multimesh, p_from_instance, p_from_instance + count, true);
+}
+
 void RasterizerStorageGLES3::multimesh_set_visible_instances(RID p_multimesh, int p_visible) {
 
 	MultiMesh *multimesh = multimesh_owner.getornull(p_multimesh);
@@ -4748,11 +4908,49 @@ void RasterizerStorageGLES3::update_dirty_multimeshes() {
 
 		MultiMesh *multimesh = multimesh_update_list.first()->self();
 
-		if (multimesh->size && multimesh->dirty_data) {
+		if (multimesh->size && (multimesh->dirty_data || multimesh->dirty_region_count)) {
 
+			int region_count = multimesh->dirty_regions.size();
 			glBindBuffer(GL_ARRAY_BUFFER, multimesh->buffer);
-			glBufferSubData(GL_ARRAY_BUFFER, 0, multimesh->data.size() * sizeof(float), multimesh->data.ptr());
+
+			if (multimesh->dirty_data || multimesh->dirty_region_count * 2 > region_count) {
+
+				// respecify the whole buffer, so the driver hands out new storage instead of
+				// waiting for draws still reading the old one; data that keeps being replaced
+				// every frame is hinted as streamed
+				multimesh->full_uploads++;
+				glBufferData(GL_ARRAY_BUFFER, multimesh->data.size() * sizeof(float), multimesh->data.ptr(), multimesh->full_uploads > 1 ? GL_STREAM_DRAW : GL_DYNAMIC_DRAW);
+			} else {
+
+				multimesh->full_uploads = 0;
+
+				int stride = multimesh->color_floats + multimesh->xform_floats + multimesh->custom_data_floats;
+				const float *data = multimesh->data.ptr();
+
+				for (int i = 0; i < region_count; i++) {
+
+					if (!multimesh->dirty_regions[i])
+						continue;
+
+					int from = i;
+					while (i + 1 < region_count && multimesh->dirty_regions[i + 1]) {
+						i++;
+					}
+
+					int from_instance = from * MultiMesh::DIRTY_REGION_INSTANCES;
+					int to_instance = MIN((i + 1) * MultiMesh::DIRTY_REGION_INSTANCES, multimesh->size);
+					glBufferSubData(GL_ARRAY_BUFFER, from_instance * stride * sizeof(float), (to_instance - from_instance) * stride * sizeof(float), &data[from_instance * stride]);
+				}
+			}
+
 			glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+			if (multimesh->dirty_region_count) {
+				for (int i = 0; i < region_count; i++) {
+					multimesh->dirty_regions[i] = false;
+				}
+				multimesh->dirty_region_count = 0;
+			}
 		}
 
 		if (multimesh->size && multimesh->dirty_aabb) {
@@ -5086,6 +5284,33 @@ Transform RasterizerStorageGLES3::skeleton_bone_get_transform(RID p_skeleton, in
 
 	return ret;
 }
+void RasterizerStorageGLES3::skeleton_set_bone_transforms(RID p_skeleton, const PoolVector<float> &p_transforms) {
+
+	Skeleton *skeleton = skeleton_owner.getornull(p_skeleton);
+
+	ERR_FAIL_COND(!skeleton);
+	ERR_FAIL_COND(skeleton->use_2d);
+	ERR_FAIL_COND(p_transforms.size() != skeleton->size * 12);
+
+	float *texture = skeleton->skel_texture.ptrw();
+	PoolVector<float>::Read r = p_transforms.read();
+	const float *src = r.ptr();
+
+	// Bones are packed as three rows of four floats, the texture stores each row 256 bones apart.
+	for (int i = 0; i < skeleton->size; i++) {
+
+		float *dst = &texture[((i / 256) * 256) * 3 * 4 + (i % 256) * 4];
+		copymem(dst, src, sizeof(float) * 4);
+		copymem(dst + 256 * 4, src + 4, sizeof(float) * 4);
+		copymem(dst + 256 * 4 * 2, src + 8, sizeof(float) * 4);
+		src += 12;
+	}
+
+	if (!skeleton->update_list.in_list()) {
+		skeleton_update_list.add(&skeleton->update_list);
+	}
+}
+
 void RasterizerStorageGLES3::skeleton_bone_set_transform_2d(RID p_skeleton, int p_bone, const Transform2D &p_transform) {
 
 	Skeleton *skeleton = skeleton_owner.getornull(p_skeleton);
@@ -5873,8 +6098,10 @@ RID RasterizerStorageGLES3::gi_probe_dynamic_data_create(int p_width, int p_heig
 		if (gipd->compression == GI_PROBE_S3TC) {
 			int size = p_width * p_height * p_depth;
 			glCompressedTexImage3D(GL_TEXTURE_3D, level, _EXT_COMPRESSED_RGBA_S3TC_DXT5_EXT, p_width, p_height, p_depth, 0, size, NULL);
+			gipd->vram_bytes += size;
 		} else {
 			glTexImage3D(GL_TEXTURE_3D, level, GL_RGBA8, p_width, p_height, p_depth, 0, GL_RGBA, GL_UNSIGNED_BYTE, NULL);
+			gipd->vram_bytes += p_width * p_height * p_depth * 4;
 		}
 
 		if (p_width <= min_size || p_height <= min_size || p_depth <= min_size)
@@ -5894,6 +6121,7 @@ RID RasterizerStorageGLES3::gi_probe_dynamic_data_create(int p_width, int p_heig
 	glTexParameteri(GL_TEXTURE_3D, GL_TEXTURE_MAX_LEVEL, level);
 
 	gipd->levels = level + 1;
+	info.gi_probe_mem += gipd->vram_bytes;
 
 	return gi_probe_data_owner.make_rid(gipd);
 }
@@ -6789,11 +7017,17 @@ void RasterizerStorageGLES3::_render_target_clear(RenderTarget *rt) {
 		rt->effects.ssao.blur_fbo[1] = 0;
 	}
 
+	_render_target_clear_ssao_reduced(rt);
+
 	if (rt->exposure.fbo) {
 		glDeleteFramebuffers(1, &rt->exposure.fbo);
 		glDeleteTextures(1, &rt->exposure.color);
 		rt->exposure.fbo = 0;
 	}
+
+	info.render_target_mem -= rt->vram_bytes;
+	rt->vram_bytes = 0;
+
 	Texture *tex = texture_owner.get(rt->texture);
 	tex->alloc_height = 0;
 	tex->alloc_width = 0;
@@ -6823,6 +7057,106 @@ void RasterizerStorageGLES3::_render_target_clear(RenderTarget *rt) {
 */
 }
 
+void RasterizerStorageGLES3::_render_target_clear_ssao_reduced(RenderTarget *rt) {
+
+	for (int i = 0; i < 2; i++) {
+		if (rt->effects.ssao.reduced_fbo[i]) {
+			glDeleteFramebuffers(1, &rt->effects.ssao.reduced_fbo[i]);
+			glDeleteTextures(1, &rt->effects.ssao.reduced_red[i]);
+			rt->effects.ssao.reduced_fbo[i] = 0;
+			rt->effects.ssao.reduced_red[i] = 0;
+		}
+		if (rt->effects.ssao.history_fbo[i]) {
+			glDeleteFramebuffers(1, &rt->effects.ssao.history_fbo[i]);
+			glDeleteTextures(1, &rt->effects.ssao.history_red[i]);
+			rt->effects.ssao.history_fbo[i] = 0;
+			rt->effects.ssao.history_red[i] = 0;
+		}
+	}
+
+	rt->effects.ssao.reduced_shift = 0;
+	rt->effects.ssao.history_valid = false;
+}
+
+bool RasterizerStorageGLES3::render_target_prepare_ssao_buffers(RenderTarget *rt, int p_shift, bool p_history) {
+
+	bool has_reduced = rt->effects.ssao.reduced_fbo[0] != 0;
+	bool has_history = rt->effects.ssao.history_fbo[0] != 0;
+
+	if ((has_reduced || has_history) && rt->effects.ssao.reduced_shift == p_shift && has_reduced == (p_shift > 0) && has_history == p_history) {
+		return true;
+	}
+
+	_render_target_clear_ssao_reduced(rt);
+
+	if (p_shift == 0 && !p_history) {
+		return true;
+	}
+
+	int w = MAX(1, rt->width >> p_shift);
+	int h = MAX(1, rt->height >> p_shift);
+
+	rt->effects.ssao.reduced_shift = p_shift;
+
+	for (int i = 0; i < 2; i++) {
+
+		if (p_shift > 0) {
+			// no depth attachment, the AO shaders skip the sky themselves at this size
+			glGenFramebuffers(1, &rt->effects.ssao.reduced_fbo[i]);
+			glBindFramebuffer(GL_FRAMEBUFFER, rt->effects.ssao.reduced_fbo[i]);
+
+			glGenTextures(1, &rt->effects.ssao.reduced_red[i]);
+			glBindTexture(GL_TEXTURE_2D, rt->effects.ssao.reduced_red[i]);
+			glTexImage2D(GL_TEXTURE_2D, 0, GL_R8, w, h, 0, GL_RED, GL_UNSIGNED_BYTE, NULL);
+			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+			glTexParameterf(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+			glTexParameterf(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+			glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, rt->effects.ssao.reduced_red[i], 0);
+
+			GLenum status = glCheckFramebufferStatus(GL_FRAMEBUFFER);
+			if (status != GL_FRAMEBUFFER_COMPLETE) {
+				_render_target_clear_ssao_reduced(rt);
+				glBindFramebuffer(GL_FRAMEBUFFER, RasterizerStorageGLES3::system_fbo);
+				ERR_FAIL_COND_V(status != GL_FRAMEBUFFER_COMPLETE, false);
+			}
+		}
+
+		if (p_history) {
+			glGenFramebuffers(1, &rt->effects.ssao.history_fbo[i]);
+			glBindFramebuffer(GL_FRAMEBUFFER, rt->effects.ssao.history_fbo[i]);
+
+			glGenTextures(1, &rt->effects.ssao.history_red[i]);
+			glBindTexture(GL_TEXTURE_2D, rt->effects.ssao.history_red[i]);
+			// 8 bits can't hold the small per frame changes of the running average
+			if (config.framebuffer_half_float_supported) {
+				glTexImage2D(GL_TEXTURE_2D, 0, GL_R16F, w, h, 0, GL_RED, GL_HALF_FLOAT, NULL);
+			} else {
+				glTexImage2D(GL_TEXTURE_2D, 0, GL_R8, w, h, 0, GL_RED, GL_UNSIGNED_BYTE, NULL);
+			}
+			// history is read back at reprojected, non texel aligned positions
+			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+			glTexParameterf(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+			glTexParameterf(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+			glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, rt->effects.ssao.history_red[i], 0);
+
+			GLenum status = glCheckFramebufferStatus(GL_FRAMEBUFFER);
+			if (status != GL_FRAMEBUFFER_COMPLETE) {
+				_render_target_clear_ssao_reduced(rt);
+				glBindFramebuffer(GL_FRAMEBUFFER, RasterizerStorageGLES3::system_fbo);
+				ERR_FAIL_COND_V(status != GL_FRAMEBUFFER_COMPLETE, false);
+			}
+		}
+	}
+
+	rt->effects.ssao.history_current = 0;
+	rt->effects.ssao.history_valid = false;
+
+	glBindFramebuffer(GL_FRAMEBUFFER, RasterizerStorageGLES3::system_fbo);
+	return true;
+}
+
 void RasterizerStorageGLES3::_render_target_allocate(RenderTarget *rt) {
 
 	if (rt->width <= 0 || rt->height <= 0)
@@ -7196,6 +7530,49 @@ void RasterizerStorageGLES3::_render_target_allocate(RenderTarget *rt) {
 			glTexParameterf(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
 		}
 	}
+
+	rt->vram_bytes = _render_target_estimate_size(rt, color_internal_format);
+	info.render_target_mem += rt->vram_bytes;
+}
+
+uint64_t RasterizerStorageGLES3::_render_target_estimate_size(RenderTarget *rt, GLuint p_color_internal_format) const {
+
+	static const int msaa_value[] = { 1, 2, 4, 8, 16 };
+
+	uint64_t pixels = uint64_t(rt->width) * rt->height;
+	uint64_t color_bpp = p_color_internal_format == GL_RGBA16F ? 8 : 4;
+	uint64_t size = 0;
+
+	if (rt->fbo) {
+		size += pixels * color_bpp;
+	}
+	if (rt->depth) {
+		size += pixels * 4;
+	}
+
+	if (rt->buffers.active) {
+		uint64_t samples = msaa_value[rt->msaa]; // GL_MAX_SAMPLES may have clamped this lower
+		uint64_t per_sample = 4 + color_bpp; // depth + diffuse
+		if (rt->buffers.effects_active) {
+			per_sample += color_bpp + 4 + 1; // specular + normal_rough + sss
+			size += pixels * color_bpp; // resolved effect buffer
+		}
+		size += pixels * samples * per_sample;
+	}
+
+	if (rt->effects.ssao.blur_fbo[0]) {
+		size += pixels * 2; // two R8 blur buffers
+		size += pixels / 4 * 2 * 4 / 3; // R16UI linear depth, half size, mipmapped
+	}
+
+	for (int i = 0; i < 2; i++) {
+		if (rt->effects.mip_maps[i].color) {
+			// a full mipmap chain adds a third on top of the base level
+			size += (i == 0 ? pixels : pixels / 4) * color_bpp * 4 / 3;
+		}
+	}
+
+	return size;
 }
 
 RID RasterizerStorageGLES3::render_target_create() {
@@ -7681,6 +8058,7 @@ bool RasterizerStorageGLES3::free(RID p_rid) {
 		GIProbeData *gi_probe_data = gi_probe_data_owner.get(p_rid);
 
 		glDeleteTextures(1, &gi_probe_data->tex_id);
+		info.gi_probe_mem -= gi_probe_data->vram_bytes;
 		gi_probe_data_owner.free(p_rid);
 		memdelete(gi_probe_data);
 	} else if (lightmap_capture_data_owner.owns(p_rid)) {
@@ -7765,6 +8143,8 @@ void RasterizerStorageGLES3::render_info_end_capture() {
 	info.snap.surface_switch_count = info.render.surface_switch_count - info.snap.surface_switch_count;
 	info.snap.shader_rebind_count = info.render.shader_rebind_count - info.snap.shader_rebind_count;
 	info.snap.vertices_count = info.render.vertices_count - info.snap.vertices_count;
+	info.snap.canvas_batch_count = info.render.canvas_batch_count - info.snap.canvas_batch_count;
+	info.snap.redundant_state_change_count = info.render.redundant_state_change_count - info.snap.redundant_state_change_count;
 }
 
 int RasterizerStorageGLES3::get_captured_render_info(VS::RenderInfo p_info) {
@@ -7790,12 +8170,85 @@ int RasterizerStorageGLES3::get_captured_render_info(VS::RenderInfo p_info) {
 		case VS::INFO_DRAW_CALLS_IN_FRAME: {
 			return info.snap.draw_call_count;
 		} break;
+		case VS::INFO_2D_BATCHES_IN_FRAME: {
+			return info.snap.canvas_batch_count;
+		} break;
+		case VS::INFO_REDUNDANT_STATE_CHANGES_IN_FRAME: {
+			return info.snap.redundant_state_change_count;
+		} break;
 		default: {
 			return get_render_info(p_info);
 		}
 	}
 }
 
+void RasterizerStorageGLES3::video_memory_debug_usage(List<VS::VideoMemoryInfo> *r_info) {
+
+	List<RID> owned;
+
+	mesh_owner.get_owned_list(&owned);
+	for (List<RID>::Element *E = owned.front(); E; E = E->next()) {
+
+		Mesh *mesh = mesh_owner.getornull(E->get());
+		if (!mesh)
+			continue;
+		VS::VideoMemoryInfo vinfo;
+		vinfo.rid = E->get();
+		vinfo.type = "Mesh";
+		vinfo.format = itos(mesh->surfaces.size()) + " surfaces";
+		vinfo.bytes = 0;
+		for (int i = 0; i < mesh->surfaces.size(); i++) {
+			vinfo.bytes += mesh->surfaces[i]->total_data_size;
+		}
+		r_info->push_back(vinfo);
+	}
+
+	owned.clear();
+	multimesh_owner.get_owned_list(&owned);
+	for (List<RID>::Element *E = owned.front(); E; E = E->next()) {
+
+		MultiMesh *multimesh = multimesh_owner.getornull(E->get());
+		if (!multimesh || !multimesh->buffer)
+			continue;
+		VS::VideoMemoryInfo vinfo;
+		vinfo.rid = E->get();
+		vinfo.type = "MultiMesh";
+		vinfo.format = itos(multimesh->size) + " instances";
+		vinfo.bytes = multimesh->data.size() * sizeof(float);
+		r_info->push_back(vinfo);
+	}
+
+	owned.clear();
+	render_target_owner.get_owned_list(&owned);
+	for (List<RID>::Element *E = owned.front(); E; E = E->next()) {
+
+		RenderTarget *rt = render_target_owner.getornull(E->get());
+		if (!rt || !rt->vram_bytes)
+			continue;
+		VS::VideoMemoryInfo vinfo;
+		vinfo.rid = E->get();
+		vinfo.type = "RenderTarget";
+		vinfo.format = itos(rt->width) + "x" + itos(rt->height) + (rt->flags[RENDER_TARGET_HDR] ? " HDR" : "");
+		vinfo.bytes = rt->vram_bytes;
+		r_info->push_back(vinfo);
+	}
+
+	owned.clear();
+	gi_probe_data_owner.get_owned_list(&owned);
+	for (List<RID>::Element *E = owned.front(); E; E = E->next()) {
+
+		GIProbeData *gipd = gi_probe_data_owner.getornull(E->get());
+		if (!gipd)
+			continue;
+		VS::VideoMemoryInfo vinfo;
+		vinfo.rid = E->get();
+		vinfo.type = "GIProbeData";
+		vinfo.format = itos(gipd->width) + "x" + itos(gipd->height) + "x" + itos(gipd->depth) + (gipd->compression == GI_PROBE_S3TC ? " S3TC" : " RGBA8");
+		vinfo.bytes = gipd->vram_bytes;
+		r_info->push_back(vinfo);
+	}
+}
+
 int RasterizerStorageGLES3::get_render_info(VS::RenderInfo p_info) {
 
 	switch (p_info) {
@@ -7814,11 +8267,41 @@ int RasterizerStorageGLES3::get_render_info(VS::RenderInfo p_info) {
 		case VS::INFO_USAGE_VIDEO_MEM_TOTAL:
 			return 0; //no idea
 		case VS::INFO_VIDEO_MEM_USED:
-			return info.vertex_mem + info.texture_mem;
+			return info.vertex_mem + info.texture_mem + info.render_target_mem + info.shadow_mem + info.reflection_mem + info.gi_probe_mem + info.multimesh_mem;
 		case VS::INFO_TEXTURE_MEM_USED:
 			return info.texture_mem;
 		case VS::INFO_VERTEX_MEM_USED:
 			return info.vertex_mem;
+		case VS::INFO_RENDER_TARGET_MEM_USED:
+			return info.render_target_mem;
+		case VS::INFO_SHADOW_MEM_USED:
+			return info.shadow_mem;
+		case VS::INFO_REFLECTION_MEM_USED:
+			return info.reflection_mem;
+		case VS::INFO_GI_PROBE_MEM_USED:
+			return info.gi_probe_mem;
+		case VS::INFO_MULTIMESH_MEM_USED:
+			return info.multimesh_mem;
+		case VS::INFO_2D_BATCHES_IN_FRAME:
+			return info.render_final.canvas_batch_count;
+		case VS::INFO_REDUNDANT_STATE_CHANGES_IN_FRAME:
+			return info.render_final.redundant_state_change_count;
+		case VS::INFO_GPU_SHADOWS_TIME_USEC:
+			return gpu_timers.usec[GPU_TIMER_SHADOWS];
+		case VS::INFO_GPU_OPAQUE_TIME_USEC:
+			return gpu_timers.usec[GPU_TIMER_OPAQUE];
+		case VS::INFO_GPU_ALPHA_TIME_USEC:
+			return gpu_timers.usec[GPU_TIMER_ALPHA];
+		case VS::INFO_GPU_SSAO_TIME_USEC:
+			return gpu_timers.usec[GPU_TIMER_SSAO];
+		case VS::INFO_GPU_SSR_TIME_USEC:
+			return gpu_timers.usec[GPU_TIMER_SSR];
+		case VS::INFO_GPU_POST_PROCESS_TIME_USEC:
+			return gpu_timers.usec[GPU_TIMER_POST_PROCESS];
+		case VS::INFO_GPU_GLOW_TIME_USEC:
+			return gpu_timers.usec[GPU_TIMER_GLOW];
+		case VS::INFO_GPU_CANVAS_TIME_USEC:
+			return gpu_timers.usec[GPU_TIMER_CANVAS];
 		default:
 			return 0; //no idea either
 	}
@@ -8057,6 +8540,25 @@ void RasterizerStorageGLES3::initialize() {
 			}
 		}
 	}
+
+	gpu_timers.current = 0;
+	for (int i = 0; i < GPU_TIMER_MAX; i++) {
+		gpu_timers.usec[i] = 0;
+	}
+	for (int i = 0; i < GPUTimers::FRAMES; i++) {
+		gpu_timers.frames[i].count = 0;
+	}
+
+#ifdef GLES_OVER_GL
+	// Timer queries are core since OpenGL 3.3, OpenGL ES only has them through
+	// EXT_disjoint_timer_query.
+	gpu_timers.supported = true;
+	for (int i = 0; i < GPUTimers::FRAMES; i++) {
+		glGenQueries(GPUTimers::MAX_SCOPES * 2, gpu_timers.frames[i].queries);
+	}
+#else
+	gpu_timers.supported = false;
+#endif
 }
 
 void RasterizerStorageGLES3::finalize() {
@@ -8064,6 +8566,79 @@ void RasterizerStorageGLES3::finalize() {
 	glDeleteTextures(1, &resources.white_tex);
 	glDeleteTextures(1, &resources.black_tex);
 	glDeleteTextures(1, &resources.normal_tex);
+
+	if (gpu_timers.supported) {
+		for (int i = 0; i < GPUTimers::FRAMES; i++) {
+			glDeleteQueries(GPUTimers::MAX_SCOPES * 2, gpu_timers.frames[i].queries);
+		}
+	}
+}
+
+int RasterizerStorageGLES3::gpu_timer_begin(GPUTimerStage p_stage) {
+
+	if (!gpu_timers.supported) {
+		return -1;
+	}
+
+	GPUTimers::Frame &f = gpu_timers.frames[gpu_timers.current];
+	if (f.count == GPUTimers::MAX_SCOPES) {
+		return -1;
+	}
+
+#ifdef GLES_OVER_GL
+	glQueryCounter(f.queries[f.count * 2], GL_TIMESTAMP);
+#endif
+	f.stages[f.count] = p_stage;
+	return f.count++;
+}
+
+void RasterizerStorageGLES3::gpu_timer_end(int p_scope) {
+
+	if (p_scope < 0) {
+		return;
+	}
+
+#ifdef GLES_OVER_GL
+	glQueryCounter(gpu_timers.frames[gpu_timers.current].queries[p_scope * 2 + 1], GL_TIMESTAMP);
+#endif
+}
+
+void RasterizerStorageGLES3::gpu_timers_begin_frame() {
+
+	if (!gpu_timers.supported) {
+		return;
+	}
+
+	gpu_timers.current = (gpu_timers.current + 1) % GPUTimers::FRAMES;
+	GPUTimers::Frame &f = gpu_timers.frames[gpu_timers.current];
+
+#ifdef GLES_OVER_GL
+	if (f.count) {
+		// Timestamps complete in order, if the last one is not ready the GPU
+		// is more than FRAMES behind and this frame's results are dropped
+		// rather than waited for.
+		GLint available = 0;
+		glGetQueryObjectiv(f.queries[f.count * 2 - 1], GL_QUERY_RESULT_AVAILABLE, &available);
+
+		if (available) {
+			uint64_t ns[GPU_TIMER_MAX] = {};
+			for (int i = 0; i < f.count; i++) {
+				GLuint64 begin = 0;
+				GLuint64 end = 0;
+				glGetQueryObjectui64v(f.queries[i * 2], GL_QUERY_RESULT, &begin);
+				glGetQueryObjectui64v(f.queries[i * 2 + 1], GL_QUERY_RESULT, &end);
+				if (end > begin) {
+					ns[f.stages[i]] += end - begin;
+				}
+			}
+			for (int i = 0; i < GPU_TIMER_MAX; i++) {
+				gpu_timers.usec[i] = ns[i] / 1000;
+			}
+		}
+	}
+#endif
+
+	f.count = 0;
 }
 
 void RasterizerStorageGLES3::update_dirty_resources() {
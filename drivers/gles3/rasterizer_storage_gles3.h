@@ -31,6 +31,7 @@
 #ifndef RASTERIZERSTORAGEGLES3_H
 #define RASTERIZERSTORAGEGLES3_H
 
+#include "core/local_vector.h"
 #include "core/self_list.h"
 #include "servers/visual/rasterizer.h"
 #include "servers/visual/shader_language.h"
@@ -146,6 +147,11 @@ public:
 
 		uint64_t texture_mem;
 		uint64_t vertex_mem;
+		uint64_t render_target_mem;
+		uint64_t shadow_mem;
+		uint64_t reflection_mem;
+		uint64_t gi_probe_mem;
+		uint64_t multimesh_mem;
 
 		struct Render {
 			uint32_t object_count;
@@ -154,6 +160,8 @@ public:
 			uint32_t surface_switch_count;
 			uint32_t shader_rebind_count;
 			uint32_t vertices_count;
+			uint32_t canvas_batch_count;
+			uint32_t redundant_state_change_count;
 
 			void reset() {
 				object_count = 0;
@@ -162,6 +170,8 @@ public:
 				surface_switch_count = 0;
 				shader_rebind_count = 0;
 				vertices_count = 0;
+				canvas_batch_count = 0;
+				redundant_state_change_count = 0;
 			}
 		} render, render_final, snap;
 
@@ -169,6 +179,11 @@ public:
 
 			texture_mem = 0;
 			vertex_mem = 0;
+			render_target_mem = 0;
+			shadow_mem = 0;
+			reflection_mem = 0;
+			gi_probe_mem = 0;
+			multimesh_mem = 0;
 			render.reset();
 			render_final.reset();
 		}
@@ -528,6 +543,9 @@ public:
 	virtual void shader_set_default_texture_param(RID p_shader, const StringName &p_name, RID p_texture);
 	virtual RID shader_get_default_texture_param(RID p_shader, const StringName &p_name) const;
 
+	virtual PoolIntArray shader_get_compiled_variants(RID p_shader) const;
+	virtual void shader_precompile_variants(RID p_shader, const PoolIntArray &p_variants);
+
 	void _update_shader(Shader *p_shader) const;
 
 	void update_dirty_shaders();
@@ -648,6 +666,7 @@ public:
 		Vector<BlendShape> blend_shapes;
 
 		AABB aabb;
+		Rect2 uv_range; // used to dequantize ARRAY_FLAG_USE_QUANTIZED_UV
 
 		int array_len;
 		int index_array_len;
@@ -658,6 +677,25 @@ public:
 
 		VS::PrimitiveType primitive;
 
+		struct LOD {
+			int index_offset; // in bytes, into index_id, after the base level
+			int index_count;
+			float error; // relative to the surface bounds
+		};
+
+		Vector<LOD> lods;
+
+		// Levels are sorted by error, the coarsest one within the limit computed by the cull pass is drawn.
+		// Returns -1 when the base indices are used.
+		_FORCE_INLINE_ int get_lod(float p_error_limit) const {
+
+			int lod = -1;
+			while (lod + 1 < lods.size() && lods[lod + 1].error <= p_error_limit) {
+				lod++;
+			}
+			return lod;
+		}
+
 		bool active;
 
 		virtual void material_changed_notify() {
@@ -723,7 +761,7 @@ public:
 
 	virtual RID mesh_create();
 
-	virtual void mesh_add_surface(RID p_mesh, uint32_t p_format, VS::PrimitiveType p_primitive, const PoolVector<uint8_t> &p_array, int p_vertex_count, const PoolVector<uint8_t> &p_index_array, int p_index_count, const AABB &p_aabb, const Vector<PoolVector<uint8_t> > &p_blend_shapes = Vector<PoolVector<uint8_t> >(), const Vector<AABB> &p_bone_aabbs = Vector<AABB>());
+	virtual void mesh_add_surface(RID p_mesh, uint32_t p_format, VS::PrimitiveType p_primitive, const PoolVector<uint8_t> &p_array, int p_vertex_count, const PoolVector<uint8_t> &p_index_array, int p_index_count, const AABB &p_aabb, const Vector<PoolVector<uint8_t> > &p_blend_shapes = Vector<PoolVector<uint8_t> >(), const Vector<AABB> &p_bone_aabbs = Vector<AABB>(), const Rect2 &p_uv_range = Rect2(0, 0, 1, 1));
 
 	virtual void mesh_set_blend_shape_count(RID p_mesh, int p_amount);
 	virtual int mesh_get_blend_shape_count(RID p_mesh) const;
@@ -732,6 +770,7 @@ public:
 	virtual VS::BlendShapeMode mesh_get_blend_shape_mode(RID p_mesh) const;
 
 	virtual void mesh_surface_update_region(RID p_mesh, int p_surface, int p_offset, const PoolVector<uint8_t> &p_data);
+	virtual void mesh_surface_set_lods(RID p_mesh, int p_surface, const Vector<PoolVector<uint8_t> > &p_lod_indices, const Vector<float> &p_lod_errors);
 
 	virtual void mesh_surface_set_material(RID p_mesh, int p_surface, RID p_material);
 	virtual RID mesh_surface_get_material(RID p_mesh, int p_surface) const;
@@ -746,6 +785,7 @@ public:
 	virtual VS::PrimitiveType mesh_surface_get_primitive_type(RID p_mesh, int p_surface) const;
 
 	virtual AABB mesh_surface_get_aabb(RID p_mesh, int p_surface) const;
+	virtual Rect2 mesh_surface_get_uv_range(RID p_mesh, int p_surface) const;
 	virtual Vector<PoolVector<uint8_t> > mesh_surface_get_blend_shapes(RID p_mesh, int p_surface) const;
 	virtual Vector<AABB> mesh_surface_get_skeleton_aabb(RID p_mesh, int p_surface) const;
 
@@ -763,6 +803,11 @@ public:
 	/* MULTIMESH API */
 
 	struct MultiMesh : public GeometryOwner {
+
+		enum {
+			DIRTY_REGION_INSTANCES = 64
+		};
+
 		RID mesh;
 		int size;
 		VS::MultimeshTransformFormat transform_format;
@@ -780,7 +825,12 @@ public:
 		int custom_data_floats;
 
 		bool dirty_aabb;
-		bool dirty_data;
+		bool dirty_data; // everything has to be uploaded
+
+		// instances changed one at a time are uploaded per region of DIRTY_REGION_INSTANCES
+		LocalVector<bool> dirty_regions;
+		int dirty_region_count;
+		int full_uploads; // consecutive frames that uploaded the whole buffer
 
 		MultiMesh() :
 				size(0),
@@ -795,7 +845,9 @@ public:
 				color_floats(0),
 				custom_data_floats(0),
 				dirty_aabb(true),
-				dirty_data(true) {
+				dirty_data(true),
+				dirty_region_count(0),
+				full_uploads(0) {
 		}
 	};
 
@@ -803,6 +855,8 @@ public:
 
 	SelfList<MultiMesh>::List multimesh_update_list;
 
+	void _multimesh_mark_dirty(MultiMesh *p_multimesh, int p_from, int p_to, bool p_aabb);
+
 	void update_dirty_multimeshes();
 
 	virtual RID multimesh_create();
@@ -824,6 +878,7 @@ public:
 	virtual Color multimesh_instance_get_custom_data(RID p_multimesh, int p_index) const;
 
 	virtual void multimesh_set_as_bulk_array(RID p_multimesh, const PoolVector<float> &p_array);
+	virtual void multimesh_set_as_bulk_array_range(RID p_multimesh, int p_from_instance, const PoolVector<float> &p_array);
 
 	virtual void multimesh_set_visible_instances(RID p_multimesh, int p_visible);
 	virtual int multimesh_get_visible_instances(RID p_multimesh) const;
@@ -913,6 +968,7 @@ public:
 	virtual int skeleton_get_bone_count(RID p_skeleton) const;
 	virtual void skeleton_bone_set_transform(RID p_skeleton, int p_bone, const Transform &p_transform);
 	virtual Transform skeleton_bone_get_transform(RID p_skeleton, int p_bone) const;
+	virtual void skeleton_set_bone_transforms(RID p_skeleton, const PoolVector<float> &p_transforms);
 	virtual void skeleton_bone_set_transform_2d(RID p_skeleton, int p_bone, const Transform2D &p_transform);
 	virtual Transform2D skeleton_bone_get_transform_2d(RID p_skeleton, int p_bone) const;
 	virtual void skeleton_set_base_transform_2d(RID p_skeleton, const Transform2D &p_base_transform);
@@ -1087,8 +1143,10 @@ public:
 		int levels;
 		GLuint tex_id;
 		GIProbeCompression compression;
+		uint64_t vram_bytes;
 
-		GIProbeData() {
+		GIProbeData() :
+				vram_bytes(0) {
 		}
 	};
 
@@ -1326,10 +1384,31 @@ public:
 
 				Vector<GLuint> depth_mipmap_fbos; //fbos for depth mipmapsla ver
 
+				// AO buffers at 1 / (1 << reduced_shift) resolution, allocated on demand
+				int reduced_shift;
+				GLuint reduced_fbo[2];
+				GLuint reduced_red[2];
+
+				// temporal accumulation history, at the same resolution as the AO pass
+				GLuint history_fbo[2];
+				GLuint history_red[2];
+				int history_current;
+				bool history_valid;
+				CameraMatrix history_view_projection;
+
 				SSAO() :
-						linear_depth(0) {
+						linear_depth(0),
+						reduced_shift(0),
+						history_current(0),
+						history_valid(false) {
 					blur_fbo[0] = 0;
 					blur_fbo[1] = 0;
+					for (int i = 0; i < 2; i++) {
+						reduced_fbo[i] = 0;
+						reduced_red[i] = 0;
+						history_fbo[i] = 0;
+						history_red[i] = 0;
+					}
 				}
 			} ssao;
 
@@ -1354,6 +1433,8 @@ public:
 		bool used_in_frame;
 		VS::ViewportMSAA msaa;
 
+		uint64_t vram_bytes; // estimated, drivers may pad or compress
+
 		RID texture;
 
 		RenderTarget() :
@@ -1363,7 +1444,8 @@ public:
 				width(0),
 				height(0),
 				used_in_frame(false),
-				msaa(VS::VIEWPORT_MSAA_DISABLED) {
+				msaa(VS::VIEWPORT_MSAA_DISABLED),
+				vram_bytes(0) {
 			exposure.fbo = 0;
 			buffers.fbo = 0;
 			for (int i = 0; i < RENDER_TARGET_FLAG_MAX; i++) {
@@ -1379,6 +1461,9 @@ public:
 
 	void _render_target_clear(RenderTarget *rt);
 	void _render_target_allocate(RenderTarget *rt);
+	void _render_target_clear_ssao_reduced(RenderTarget *rt);
+	bool render_target_prepare_ssao_buffers(RenderTarget *rt, int p_shift, bool p_history);
+	uint64_t _render_target_estimate_size(RenderTarget *rt, GLuint p_color_internal_format) const;
 
 	virtual RID render_target_create();
 	virtual void render_target_set_size(RID p_render_target, int p_width, int p_height);
@@ -1423,6 +1508,7 @@ public:
 	virtual VS::InstanceType get_base_type(RID p_rid) const;
 
 	virtual bool free(RID p_rid);
+	virtual void video_memory_debug_usage(List<VS::VideoMemoryInfo> *r_info);
 
 	struct Frame {
 
@@ -1437,6 +1523,46 @@ public:
 
 	} frame;
 
+	/* GPU TIMERS */
+
+	enum GPUTimerStage {
+		GPU_TIMER_SHADOWS,
+		GPU_TIMER_OPAQUE,
+		GPU_TIMER_ALPHA,
+		GPU_TIMER_SSAO,
+		GPU_TIMER_SSR,
+		GPU_TIMER_POST_PROCESS,
+		GPU_TIMER_GLOW,
+		GPU_TIMER_CANVAS,
+		GPU_TIMER_MAX
+	};
+
+	struct GPUTimers {
+
+		// Timestamps are read back FRAMES frames after they were issued, so
+		// the CPU never waits for the GPU to get them.
+		enum {
+			FRAMES = 4,
+			MAX_SCOPES = 128,
+		};
+
+		struct Frame {
+			GLuint queries[MAX_SCOPES * 2];
+			GPUTimerStage stages[MAX_SCOPES];
+			int count;
+		};
+
+		bool supported;
+		int current;
+		Frame frames[FRAMES];
+		uint64_t usec[GPU_TIMER_MAX];
+
+	} gpu_timers;
+
+	int gpu_timer_begin(GPUTimerStage p_stage);
+	void gpu_timer_end(int p_scope);
+	void gpu_timers_begin_frame();
+
 	void initialize();
 	void finalize();
 
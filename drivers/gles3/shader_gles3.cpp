@@ -30,7 +30,12 @@
 
 #include "shader_gles3.h"
 
+#include "core/engine.h"
+#include "core/os/dir_access.h"
+#include "core/os/file_access.h"
+#include "core/os/os.h"
 #include "core/print_string.h"
+#include "core/project_settings.h"
 
 //#define DEBUG_OPENGL
 
@@ -51,6 +56,11 @@
 
 ShaderGLES3 *ShaderGLES3::active = NULL;
 
+bool ShaderGLES3::shader_cache_enabled = false;
+String ShaderGLES3::shader_cache_dir;
+
+#define PROGRAM_CACHE_MAGIC 0x42504C47 // "GLPB"
+
 //#define DEBUG_SHADER
 
 #ifdef DEBUG_SHADER
@@ -164,6 +174,135 @@ static void _display_error_with_code(const String &p_error, const Vector<const c
 	ERR_PRINTS(p_error);
 }
 
+void ShaderGLES3::init_shader_cache() {
+
+	shader_cache_enabled = false;
+
+	if (!GLOBAL_GET("rendering/gles3/shaders/shader_cache") || Engine::get_singleton()->is_editor_hint()) {
+		return;
+	}
+
+#if defined(GLAD_ENABLED)
+	if (!GLAD_GL_ARB_get_program_binary) {
+		return;
+	}
+#elif defined(JAVASCRIPT_ENABLED)
+	return; //WebGL 2.0 has no program binaries
+#endif
+
+	GLint format_count = 0;
+	glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &format_count);
+	if (format_count <= 0) {
+		return;
+	}
+
+	//binaries are only valid for the exact driver that produced them, so each driver gets its own directory
+	String driver = String((const char *)glGetString(GL_VENDOR)) + "|" + String((const char *)glGetString(GL_RENDERER)) + "|" + String((const char *)glGetString(GL_VERSION));
+	shader_cache_dir = OS::get_singleton()->get_user_data_dir().plus_file("shader_cache").plus_file(String::num_uint64(driver.hash64(), 16));
+
+	DirAccess *da = DirAccess::create(DirAccess::ACCESS_FILESYSTEM);
+	Error err = da->make_dir_recursive(shader_cache_dir);
+	memdelete(da);
+
+	if (err != OK) {
+		WARN_PRINTS("Unable to create shader cache directory, shader cache disabled: " + shader_cache_dir);
+		return;
+	}
+
+	shader_cache_enabled = true;
+}
+
+static uint64_t _hash_code_strings(const Vector<const char *> &p_strings, uint64_t p_hash) {
+
+	for (int i = 0; i < p_strings.size(); i++) {
+
+		for (const char *c = p_strings[i]; *c; c++) {
+			p_hash = hash_djb2_one_64(*c, p_hash);
+		}
+	}
+
+	return p_hash;
+}
+
+String ShaderGLES3::_get_program_cache_path(const Vector<const char *> &p_vertex_strings, const Vector<const char *> &p_fragment_strings) const {
+
+	uint64_t hash = _hash_code_strings(p_vertex_strings, 5381);
+	hash = _hash_code_strings(p_fragment_strings, hash);
+
+	//attribute locations and feedback varyings are baked into the binary too
+	for (int i = 0; i < attribute_pair_count; i++) {
+		hash = hash_djb2_one_64(attribute_pairs[i].index, hash);
+	}
+	for (int i = 0; i < feedback_count; i++) {
+		hash = hash_djb2_one_64(feedbacks[i].conditional, hash);
+	}
+
+	return shader_cache_dir.plus_file(get_shader_name() + "_" + String::num_uint64(conditional_version.version, 16) + "_" + String::num_uint64(hash, 16) + ".bin");
+}
+
+bool ShaderGLES3::_load_program_binary(GLuint p_id, const String &p_path) const {
+
+	FileAccess *f = FileAccess::open(p_path, FileAccess::READ);
+	if (!f) {
+		return false;
+	}
+
+	bool ok = false;
+
+	if (f->get_32() == PROGRAM_CACHE_MAGIC) {
+
+		GLenum format = f->get_32();
+		uint32_t length = f->get_32();
+
+		if (length > 0 && length <= f->get_len() - f->get_position()) {
+
+			Vector<uint8_t> binary;
+			binary.resize(length);
+
+			if (f->get_buffer(binary.ptrw(), length) == (int)length) {
+
+				glProgramBinary(p_id, format, binary.ptr(), length);
+
+				//drivers reject binaries from older versions of themselves, fall back to compiling
+				GLint status;
+				glGetProgramiv(p_id, GL_LINK_STATUS, &status);
+				ok = status == GL_TRUE;
+			}
+		}
+	}
+
+	memdelete(f);
+	return ok;
+}
+
+void ShaderGLES3::_save_program_binary(GLuint p_id, const String &p_path) const {
+
+	GLint length = 0;
+	glGetProgramiv(p_id, GL_PROGRAM_BINARY_LENGTH, &length);
+	if (length <= 0) {
+		return;
+	}
+
+	Vector<uint8_t> binary;
+	binary.resize(length);
+
+	GLenum format = 0;
+	GLsizei written = 0;
+	glGetProgramBinary(p_id, length, &written, &format, binary.ptrw());
+	if (written <= 0) {
+		return;
+	}
+
+	FileAccess *f = FileAccess::open(p_path, FileAccess::WRITE);
+	ERR_FAIL_COND(!f);
+
+	f->store_32(PROGRAM_CACHE_MAGIC);
+	f->store_32(format);
+	f->store_32(written);
+	f->store_buffer(binary.ptr(), written);
+	memdelete(f);
+}
+
 ShaderGLES3::Version *ShaderGLES3::get_current_version() {
 
 	Version *_v = version_map.getptr(conditional_version);
@@ -226,10 +365,12 @@ ShaderGLES3::Version *ShaderGLES3::get_current_version() {
 	}
 
 	//keep them around during the function
-	CharString code_string;
-	CharString code_string2;
-	CharString code_globals;
 	CharString material_string;
+	CharString vertex_globals_string;
+	CharString vertex_code_string;
+	CharString fragment_globals_string;
+	CharString light_code_string;
+	CharString fragment_code_string;
 
 	CustomCode *cc = NULL;
 
@@ -241,267 +382,297 @@ ShaderGLES3::Version *ShaderGLES3::get_current_version() {
 		v.code_version = cc->version;
 	}
 
-	/* CREATE PROGRAM */
-
-	v.id = glCreateProgram();
-
-	ERR_FAIL_COND_V(v.id == 0, NULL);
-
-	/* VERTEX SHADER */
-
 	if (cc) {
 		for (int i = 0; i < cc->custom_defines.size(); i++) {
 
 			strings.push_back(cc->custom_defines[i].get_data());
 			DEBUG_PRINT("CD #" + itos(i) + ": " + String(cc->custom_defines[i]));
 		}
+
+		material_string = cc->uniforms.ascii();
+		vertex_globals_string = cc->vertex_globals.ascii();
+		vertex_code_string = cc->vertex.ascii();
+		fragment_globals_string = cc->fragment_globals.ascii();
+		light_code_string = cc->light.ascii();
+		fragment_code_string = cc->fragment.ascii();
 	}
 
-	int strings_base_size = strings.size();
+	/* VERTEX SHADER */
+
+	Vector<const char *> vertex_strings = strings;
 
 	//vertex precision is high
-	strings.push_back("precision highp float;\n");
-	strings.push_back("precision highp int;\n");
+	vertex_strings.push_back("precision highp float;\n");
+	vertex_strings.push_back("precision highp int;\n");
 #ifndef GLES_OVER_GL
-	strings.push_back("precision highp sampler2D;\n");
-	strings.push_back("precision highp samplerCube;\n");
-	strings.push_back("precision highp sampler2DArray;\n");
+	vertex_strings.push_back("precision highp sampler2D;\n");
+	vertex_strings.push_back("precision highp samplerCube;\n");
+	vertex_strings.push_back("precision highp sampler2DArray;\n");
 #endif
 
-	strings.push_back(vertex_code0.get_data());
+	vertex_strings.push_back(vertex_code0.get_data());
 
 	if (cc) {
-		material_string = cc->uniforms.ascii();
-		strings.push_back(material_string.get_data());
+		vertex_strings.push_back(material_string.get_data());
 	}
 
-	strings.push_back(vertex_code1.get_data());
+	vertex_strings.push_back(vertex_code1.get_data());
 
 	if (cc) {
-		code_globals = cc->vertex_globals.ascii();
-		strings.push_back(code_globals.get_data());
+		vertex_strings.push_back(vertex_globals_string.get_data());
 	}
 
-	strings.push_back(vertex_code2.get_data());
+	vertex_strings.push_back(vertex_code2.get_data());
 
 	if (cc) {
-		code_string = cc->vertex.ascii();
-		strings.push_back(code_string.get_data());
+		vertex_strings.push_back(vertex_code_string.get_data());
 	}
 
-	strings.push_back(vertex_code3.get_data());
+	vertex_strings.push_back(vertex_code3.get_data());
 #ifdef DEBUG_SHADER
 
-	DEBUG_PRINT("\nVertex Code:\n\n" + String(code_string.get_data()));
-	for (int i = 0; i < strings.size(); i++) {
+	DEBUG_PRINT("\nVertex Code:\n\n" + String(vertex_code_string.get_data()));
+	for (int i = 0; i < vertex_strings.size(); i++) {
 
-		//print_line("vert strings "+itos(i)+":"+String(strings[i]));
+		//print_line("vert strings "+itos(i)+":"+String(vertex_strings[i]));
 	}
 #endif
 
-	v.vert_id = glCreateShader(GL_VERTEX_SHADER);
-	glShaderSource(v.vert_id, strings.size(), &strings[0], NULL);
-	glCompileShader(v.vert_id);
-
-	GLint status;
-
-	glGetShaderiv(v.vert_id, GL_COMPILE_STATUS, &status);
-	if (status == GL_FALSE) {
-		// error compiling
-		GLsizei iloglen;
-		glGetShaderiv(v.vert_id, GL_INFO_LOG_LENGTH, &iloglen);
-
-		if (iloglen < 0) {
-
-			glDeleteShader(v.vert_id);
-			glDeleteProgram(v.id);
-			v.id = 0;
-
-			ERR_PRINT("Vertex shader compilation failed with empty log");
-		} else {
-
-			if (iloglen == 0) {
-
-				iloglen = 4096; //buggy driver (Adreno 220+....)
-			}
-
-			char *ilogmem = (char *)memalloc(iloglen + 1);
-			ilogmem[iloglen] = 0;
-			glGetShaderInfoLog(v.vert_id, iloglen, &iloglen, ilogmem);
-
-			String err_string = get_shader_name() + ": Vertex Program Compilation Failed:\n";
-
-			err_string += ilogmem;
-			_display_error_with_code(err_string, strings);
-			memfree(ilogmem);
-			glDeleteShader(v.vert_id);
-			glDeleteProgram(v.id);
-			v.id = 0;
-		}
-
-		ERR_FAIL_V(NULL);
-	}
-
-	//_display_error_with_code("pepo", strings);
-
 	/* FRAGMENT SHADER */
 
-	strings.resize(strings_base_size);
+	Vector<const char *> fragment_strings = strings;
+
 	//fragment precision is medium
-	strings.push_back("precision highp float;\n");
-	strings.push_back("precision highp int;\n");
+	fragment_strings.push_back("precision highp float;\n");
+	fragment_strings.push_back("precision highp int;\n");
 #ifndef GLES_OVER_GL
-	strings.push_back("precision highp sampler2D;\n");
-	strings.push_back("precision highp samplerCube;\n");
-	strings.push_back("precision highp sampler2DArray;\n");
+	fragment_strings.push_back("precision highp sampler2D;\n");
+	fragment_strings.push_back("precision highp samplerCube;\n");
+	fragment_strings.push_back("precision highp sampler2DArray;\n");
 #endif
 
-	strings.push_back(fragment_code0.get_data());
+	fragment_strings.push_back(fragment_code0.get_data());
 	if (cc) {
-		material_string = cc->uniforms.ascii();
-		strings.push_back(material_string.get_data());
+		fragment_strings.push_back(material_string.get_data());
 	}
 
-	strings.push_back(fragment_code1.get_data());
+	fragment_strings.push_back(fragment_code1.get_data());
 
 	if (cc) {
-		code_globals = cc->fragment_globals.ascii();
-		strings.push_back(code_globals.get_data());
+		fragment_strings.push_back(fragment_globals_string.get_data());
 	}
 
-	strings.push_back(fragment_code2.get_data());
+	fragment_strings.push_back(fragment_code2.get_data());
 
 	if (cc) {
-		code_string = cc->light.ascii();
-		strings.push_back(code_string.get_data());
+		fragment_strings.push_back(light_code_string.get_data());
 	}
 
-	strings.push_back(fragment_code3.get_data());
+	fragment_strings.push_back(fragment_code3.get_data());
 
 	if (cc) {
-		code_string2 = cc->fragment.ascii();
-		strings.push_back(code_string2.get_data());
+		fragment_strings.push_back(fragment_code_string.get_data());
 	}
 
-	strings.push_back(fragment_code4.get_data());
+	fragment_strings.push_back(fragment_code4.get_data());
 
 #ifdef DEBUG_SHADER
-	DEBUG_PRINT("\nFragment Globals:\n\n" + String(code_globals.get_data()));
-	DEBUG_PRINT("\nFragment Code:\n\n" + String(code_string2.get_data()));
-	for (int i = 0; i < strings.size(); i++) {
+	DEBUG_PRINT("\nFragment Globals:\n\n" + String(fragment_globals_string.get_data()));
+	DEBUG_PRINT("\nFragment Code:\n\n" + String(fragment_code_string.get_data()));
+	for (int i = 0; i < fragment_strings.size(); i++) {
 
-		//print_line("frag strings "+itos(i)+":"+String(strings[i]));
+		//print_line("frag strings "+itos(i)+":"+String(fragment_strings[i]));
 	}
 #endif
 
-	v.frag_id = glCreateShader(GL_FRAGMENT_SHADER);
-	glShaderSource(v.frag_id, strings.size(), &strings[0], NULL);
-	glCompileShader(v.frag_id);
+	/* CREATE PROGRAM */
 
-	glGetShaderiv(v.frag_id, GL_COMPILE_STATUS, &status);
-	if (status == GL_FALSE) {
-		// error compiling
-		GLsizei iloglen;
-		glGetShaderiv(v.frag_id, GL_INFO_LOG_LENGTH, &iloglen);
+	v.id = glCreateProgram();
 
-		if (iloglen < 0) {
+	ERR_FAIL_COND_V(v.id == 0, NULL);
 
-			glDeleteShader(v.frag_id);
-			glDeleteShader(v.vert_id);
-			glDeleteProgram(v.id);
-			v.id = 0;
-			ERR_PRINT("Fragment shader compilation failed with empty log");
+	String cache_path;
+	bool from_cache = false;
+
+	if (shader_cache_enabled) {
+
+		cache_path = _get_program_cache_path(vertex_strings, fragment_strings);
+		from_cache = _load_program_binary(v.id, cache_path);
+
+		if (from_cache) {
+			//linked straight from the binary, no shader objects involved
+			v.vert_id = 0;
+			v.frag_id = 0;
 		} else {
+			//stale or missing, start over with a fresh program and compile it
+			glDeleteProgram(v.id);
+			v.id = glCreateProgram();
+			ERR_FAIL_COND_V(v.id == 0, NULL);
+		}
+	}
 
-			if (iloglen == 0) {
+	if (!from_cache) {
 
-				iloglen = 4096; //buggy driver (Adreno 220+....)
+		v.vert_id = glCreateShader(GL_VERTEX_SHADER);
+		glShaderSource(v.vert_id, vertex_strings.size(), &vertex_strings[0], NULL);
+		glCompileShader(v.vert_id);
+
+		GLint status;
+
+		glGetShaderiv(v.vert_id, GL_COMPILE_STATUS, &status);
+		if (status == GL_FALSE) {
+			// error compiling
+			GLsizei iloglen;
+			glGetShaderiv(v.vert_id, GL_INFO_LOG_LENGTH, &iloglen);
+
+			if (iloglen < 0) {
+
+				glDeleteShader(v.vert_id);
+				glDeleteProgram(v.id);
+				v.id = 0;
+
+				ERR_PRINT("Vertex shader compilation failed with empty log");
+			} else {
+
+				if (iloglen == 0) {
+
+					iloglen = 4096; //buggy driver (Adreno 220+....)
+				}
+
+				char *ilogmem = (char *)memalloc(iloglen + 1);
+				ilogmem[iloglen] = 0;
+				glGetShaderInfoLog(v.vert_id, iloglen, &iloglen, ilogmem);
+
+				String err_string = get_shader_name() + ": Vertex Program Compilation Failed:\n";
+
+				err_string += ilogmem;
+				_display_error_with_code(err_string, vertex_strings);
+				memfree(ilogmem);
+				glDeleteShader(v.vert_id);
+				glDeleteProgram(v.id);
+				v.id = 0;
 			}
 
-			char *ilogmem = (char *)memalloc(iloglen + 1);
-			ilogmem[iloglen] = 0;
-			glGetShaderInfoLog(v.frag_id, iloglen, &iloglen, ilogmem);
+			ERR_FAIL_V(NULL);
+		}
 
-			String err_string = get_shader_name() + ": Fragment Program Compilation Failed:\n";
+		v.frag_id = glCreateShader(GL_FRAGMENT_SHADER);
+		glShaderSource(v.frag_id, fragment_strings.size(), &fragment_strings[0], NULL);
+		glCompileShader(v.frag_id);
 
-			err_string += ilogmem;
-			_display_error_with_code(err_string, strings);
-			ERR_PRINT(err_string.ascii().get_data());
-			memfree(ilogmem);
-			glDeleteShader(v.frag_id);
-			glDeleteShader(v.vert_id);
-			glDeleteProgram(v.id);
-			v.id = 0;
+		glGetShaderiv(v.frag_id, GL_COMPILE_STATUS, &status);
+		if (status == GL_FALSE) {
+			// error compiling
+			GLsizei iloglen;
+			glGetShaderiv(v.frag_id, GL_INFO_LOG_LENGTH, &iloglen);
+
+			if (iloglen < 0) {
+
+				glDeleteShader(v.frag_id);
+				glDeleteShader(v.vert_id);
+				glDeleteProgram(v.id);
+				v.id = 0;
+				ERR_PRINT("Fragment shader compilation failed with empty log");
+			} else {
+
+				if (iloglen == 0) {
+
+					iloglen = 4096; //buggy driver (Adreno 220+....)
+				}
+
+				char *ilogmem = (char *)memalloc(iloglen + 1);
+				ilogmem[iloglen] = 0;
+				glGetShaderInfoLog(v.frag_id, iloglen, &iloglen, ilogmem);
+
+				String err_string = get_shader_name() + ": Fragment Program Compilation Failed:\n";
+
+				err_string += ilogmem;
+				_display_error_with_code(err_string, fragment_strings);
+				ERR_PRINT(err_string.ascii().get_data());
+				memfree(ilogmem);
+				glDeleteShader(v.frag_id);
+				glDeleteShader(v.vert_id);
+				glDeleteProgram(v.id);
+				v.id = 0;
+			}
+
+			ERR_FAIL_V(NULL);
 		}
 
-		ERR_FAIL_V(NULL);
-	}
+		glAttachShader(v.id, v.frag_id);
+		glAttachShader(v.id, v.vert_id);
 
-	glAttachShader(v.id, v.frag_id);
-	glAttachShader(v.id, v.vert_id);
+		// bind attributes before linking
+		for (int i = 0; i < attribute_pair_count; i++) {
 
-	// bind attributes before linking
-	for (int i = 0; i < attribute_pair_count; i++) {
+			glBindAttribLocation(v.id, attribute_pairs[i].index, attribute_pairs[i].name);
+		}
 
-		glBindAttribLocation(v.id, attribute_pairs[i].index, attribute_pairs[i].name);
-	}
+		//if feedback exists, set it up
 
-	//if feedback exists, set it up
+		if (feedback_count) {
+			Vector<const char *> feedback;
+			for (int i = 0; i < feedback_count; i++) {
 
-	if (feedback_count) {
-		Vector<const char *> feedback;
-		for (int i = 0; i < feedback_count; i++) {
+				if (feedbacks[i].conditional == -1 || (1 << feedbacks[i].conditional) & conditional_version.version) {
+					//conditional for this feedback is enabled
+					feedback.push_back(feedbacks[i].name);
+				}
+			}
 
-			if (feedbacks[i].conditional == -1 || (1 << feedbacks[i].conditional) & conditional_version.version) {
-				//conditional for this feedback is enabled
-				feedback.push_back(feedbacks[i].name);
+			if (feedback.size()) {
+				glTransformFeedbackVaryings(v.id, feedback.size(), feedback.ptr(), GL_INTERLEAVED_ATTRIBS);
 			}
 		}
 
-		if (feedback.size()) {
-			glTransformFeedbackVaryings(v.id, feedback.size(), feedback.ptr(), GL_INTERLEAVED_ATTRIBS);
+		if (shader_cache_enabled) {
+			glProgramParameteri(v.id, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
 		}
-	}
 
-	glLinkProgram(v.id);
+		glLinkProgram(v.id);
+
+		glGetProgramiv(v.id, GL_LINK_STATUS, &status);
+
+		if (status == GL_FALSE) {
+			// error linking
+			GLsizei iloglen;
+			glGetProgramiv(v.id, GL_INFO_LOG_LENGTH, &iloglen);
+
+			if (iloglen < 0) {
+
+				glDeleteShader(v.frag_id);
+				glDeleteShader(v.vert_id);
+				glDeleteProgram(v.id);
+				v.id = 0;
+				ERR_FAIL_COND_V(iloglen <= 0, NULL);
+			}
+
+			if (iloglen == 0) {
 
-	glGetProgramiv(v.id, GL_LINK_STATUS, &status);
+				iloglen = 4096; //buggy driver (Adreno 220+....)
+			}
 
-	if (status == GL_FALSE) {
-		// error linking
-		GLsizei iloglen;
-		glGetProgramiv(v.id, GL_INFO_LOG_LENGTH, &iloglen);
+			char *ilogmem = (char *)Memory::alloc_static(iloglen + 1);
+			ilogmem[iloglen] = 0;
+			glGetProgramInfoLog(v.id, iloglen, &iloglen, ilogmem);
 
-		if (iloglen < 0) {
+			String err_string = get_shader_name() + ": Program LINK FAILED:\n";
 
+			err_string += ilogmem;
+			_display_error_with_code(err_string, fragment_strings);
+			ERR_PRINT(err_string.ascii().get_data());
+			Memory::free_static(ilogmem);
 			glDeleteShader(v.frag_id);
 			glDeleteShader(v.vert_id);
 			glDeleteProgram(v.id);
 			v.id = 0;
-			ERR_FAIL_COND_V(iloglen <= 0, NULL);
-		}
-
-		if (iloglen == 0) {
 
-			iloglen = 4096; //buggy driver (Adreno 220+....)
+			ERR_FAIL_V(NULL);
 		}
 
-		char *ilogmem = (char *)Memory::alloc_static(iloglen + 1);
-		ilogmem[iloglen] = 0;
-		glGetProgramInfoLog(v.id, iloglen, &iloglen, ilogmem);
-
-		String err_string = get_shader_name() + ": Program LINK FAILED:\n";
-
-		err_string += ilogmem;
-		_display_error_with_code(err_string, strings);
-		ERR_PRINT(err_string.ascii().get_data());
-		Memory::free_static(ilogmem);
-		glDeleteShader(v.frag_id);
-		glDeleteShader(v.vert_id);
-		glDeleteProgram(v.id);
-		v.id = 0;
-
-		ERR_FAIL_V(NULL);
+		if (shader_cache_enabled) {
+			_save_program_binary(v.id, cache_path);
+		}
 	}
 
 	/* UNIFORMS */
@@ -759,6 +930,31 @@ void ShaderGLES3::free_custom_shader(uint32_t p_code_id) {
 	custom_code_map.erase(p_code_id);
 }
 
+void ShaderGLES3::get_custom_shader_versions(uint32_t p_code_id, List<uint32_t> *r_versions) const {
+
+	const CustomCode *cc = custom_code_map.getptr(p_code_id);
+	ERR_FAIL_COND(!cc);
+
+	for (const Set<uint32_t>::Element *E = cc->versions.front(); E; E = E->next()) {
+		r_versions->push_back(E->get());
+	}
+}
+
+void ShaderGLES3::precompile_custom_shader_version(uint32_t p_code_id, uint32_t p_version) {
+
+	ERR_FAIL_COND(!custom_code_map.has(p_code_id));
+
+	VersionKey prev_version = conditional_version;
+
+	conditional_version.code_version = p_code_id;
+	conditional_version.version = p_version & uint32_t((uint64_t(1) << conditional_count) - 1);
+	get_current_version();
+	conditional_version = prev_version;
+
+	//compiling leaves no program in use, so the next bind() must not be skipped
+	active = NULL;
+}
+
 void ShaderGLES3::set_base_material_tex_index(int p_idx) {
 
 	base_material_tex_index = p_idx;
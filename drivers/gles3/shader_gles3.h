@@ -194,6 +194,13 @@ private:
 
 	static ShaderGLES3 *active;
 
+	static bool shader_cache_enabled;
+	static String shader_cache_dir;
+
+	String _get_program_cache_path(const Vector<const char *> &p_vertex_strings, const Vector<const char *> &p_fragment_strings) const;
+	bool _load_program_binary(GLuint p_id, const String &p_path) const;
+	void _save_program_binary(GLuint p_id, const String &p_path) const;
+
 	int max_image_units;
 
 	_FORCE_INLINE_ void _set_uniform_variant(GLint p_uniform, const Variant &p_value) {
@@ -313,6 +320,7 @@ public:
 	GLint get_uniform_location(int p_index) const;
 
 	static _FORCE_INLINE_ ShaderGLES3 *get_active() { return active; };
+	static void init_shader_cache();
 	bool bind();
 	void unbind();
 	void bind_uniforms();
@@ -325,6 +333,8 @@ public:
 	void set_custom_shader_code(uint32_t p_code_id, const String &p_vertex, const String &p_vertex_globals, const String &p_fragment, const String &p_light, const String &p_fragment_globals, const String &p_uniforms, const Vector<StringName> &p_texture_uniforms, const Vector<CharString> &p_custom_defines);
 	void set_custom_shader(uint32_t p_code_id);
 	void free_custom_shader(uint32_t p_code_id);
+	void get_custom_shader_versions(uint32_t p_code_id, List<uint32_t> *r_versions) const;
+	void precompile_custom_shader_version(uint32_t p_code_id, uint32_t p_version);
 
 	void set_uniform_default(int p_idx, const Variant &p_value) {
 
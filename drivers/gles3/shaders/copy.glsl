@@ -129,6 +129,12 @@ uniform sampler2D color_correction; //texunit:1
 
 #endif
 
+#ifdef USE_SHARPEN
+
+uniform float sharpness;
+
+#endif
+
 layout(location = 0) out vec4 frag_color;
 
 void main() {
@@ -181,6 +187,21 @@ void main() {
 	color.rgb = mix(pow((color.rgb + vec3(0.055)) * (1.0 / (1.0 + 0.055)), vec3(2.4)), color.rgb * (1.0 / 12.92), lessThan(color.rgb, vec3(0.04045)));
 #endif
 
+#ifdef USE_SHARPEN
+	// contrast adaptive sharpening, pixel_size is the size of a source texel
+	vec3 sharpen_n = textureLod(source, uv_interp + vec2(0.0, -pixel_size.y), 0.0).rgb;
+	vec3 sharpen_s = textureLod(source, uv_interp + vec2(0.0, pixel_size.y), 0.0).rgb;
+	vec3 sharpen_w = textureLod(source, uv_interp + vec2(-pixel_size.x, 0.0), 0.0).rgb;
+	vec3 sharpen_e = textureLod(source, uv_interp + vec2(pixel_size.x, 0.0), 0.0).rgb;
+
+	vec3 sharpen_min = min(color.rgb, min(min(sharpen_n, sharpen_s), min(sharpen_w, sharpen_e)));
+	vec3 sharpen_max = max(color.rgb, max(max(sharpen_n, sharpen_s), max(sharpen_w, sharpen_e)));
+	// sharpen less where the local contrast is already high, to avoid ringing
+	vec3 sharpen_amount = sqrt(clamp(min(sharpen_min, vec3(1.0) - sharpen_max) / max(sharpen_max, vec3(0.0001)), 0.0, 1.0));
+	vec3 sharpen_weight = -sharpen_amount * 0.2 * sharpness;
+	color.rgb = clamp((color.rgb + (sharpen_n + sharpen_s + sharpen_w + sharpen_e) * sharpen_weight) / (vec3(1.0) + 4.0 * sharpen_weight), 0.0, 1.0);
+#endif
+
 #ifdef DEBUG_GRADIENT
 	color.rg = uv_interp;
 	color.b = 0.0;
@@ -24,6 +24,8 @@ precision mediump float;
 in vec2 uv_interp;
 uniform sampler2D source_specular; // texunit:0
 uniform sampler2D source_ssr; // texunit:1
+// mip level of source_ssr the reflections were traced into
+uniform float ssr_lod;
 
 uniform vec2 pixel_size;
 
@@ -36,7 +38,7 @@ void main() {
 	vec4 specular = texture(source_specular, uv_interp);
 
 #ifdef USE_SSR
-	vec4 ssr = textureLod(source_ssr, uv_interp, 0.0);
+	vec4 ssr = textureLod(source_ssr, uv_interp, ssr_lod);
 	specular.rgb = mix(specular.rgb, ssr.rgb * specular.a, ssr.a);
 #endif
 
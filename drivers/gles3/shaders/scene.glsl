@@ -25,7 +25,11 @@ ARRAY_INDEX=8,
 
 layout(location = 0) in highp vec4 vertex_attrib;
 /* clang-format on */
+#ifdef USE_OCTAHEDRAL_NORMALS
+layout(location = 1) in highp vec2 normal_attrib; // normal and tangent, packed
+#else
 layout(location = 1) in vec3 normal_attrib;
+#endif
 #if defined(ENABLE_TANGENT_INTERP) || defined(ENABLE_NORMALMAP) || defined(LIGHT_USE_ANISOTROPY)
 layout(location = 2) in vec4 tangent_attrib;
 #endif
@@ -42,7 +46,7 @@ layout(location = 4) in vec2 uv_attrib;
 layout(location = 5) in vec2 uv2_attrib;
 #endif
 
-#ifdef USE_SKELETON
+#if defined(USE_SKELETON) || defined(ENABLE_BONE_ATTRIBS)
 layout(location = 6) in uvec4 bone_indices; // attrib:6
 layout(location = 7) in highp vec4 bone_weights; // attrib:7
 #endif
@@ -109,6 +113,44 @@ layout(std140) uniform SceneData { // ubo:0
 
 uniform highp mat4 world_transform;
 
+// dequantization of ARRAY_FLAG_USE_QUANTIZED_VERTICES and ARRAY_FLAG_USE_QUANTIZED_UV, identity otherwise
+uniform highp vec3 vertex_quantize_offset;
+uniform highp vec3 vertex_quantize_scale;
+uniform highp vec2 uv_quantize_offset;
+uniform highp vec2 uv_quantize_scale;
+
+#ifdef USE_OCTAHEDRAL_NORMALS
+
+// Two 16-bit words: 10 bits per octahedral axis, 11 bits of tangent angle around the normal and the binormal sign.
+void decode_octahedral_normal(highp vec2 p_packed, out vec3 r_normal, out vec3 r_tangent, out float r_binormalf) {
+
+	highp vec2 high = floor(p_packed / 1024.0);
+	highp vec2 low = p_packed - high * 1024.0;
+
+	vec2 f = low / 1023.0 * 2.0 - 1.0;
+	vec3 n = vec3(f, 1.0 - abs(f.x) - abs(f.y));
+	float t = max(-n.z, 0.0);
+	n.x += n.x >= 0.0 ? -t : t;
+	n.y += n.y >= 0.0 ? -t : t;
+	r_normal = normalize(n);
+
+	// same basis as the encoder, the hemisphere is taken from the integer code
+	highp vec2 c = abs(low * 2.0 - 1023.0);
+	float s = c.x + c.y <= 1023.0 ? 1.0 : -1.0;
+	float a = -1.0 / (s + r_normal.z);
+	float b = r_normal.x * r_normal.y * a;
+	vec3 b1 = vec3(1.0 + s * r_normal.x * r_normal.x * a, s * b, -s * r_normal.x);
+	vec3 b2 = vec3(b, s + r_normal.y * r_normal.y * a, -r_normal.y);
+
+	highp float sign_bit = floor(high.y / 32.0);
+	highp float angle_bits = high.x + (high.y - sign_bit * 32.0) * 64.0;
+	float angle = (angle_bits / 2047.0 * 2.0 - 1.0) * M_PI;
+	r_tangent = b1 * cos(angle) + b2 * sin(angle);
+	r_binormalf = sign_bit > 0.5 ? -1.0 : 1.0;
+}
+
+#endif
+
 #ifdef USE_LIGHT_DIRECTIONAL
 
 layout(std140) uniform DirectionalLightData { //ubo:3
@@ -315,6 +357,7 @@ out highp vec4 position_interp;
 void main() {
 
 	highp vec4 vertex = vertex_attrib; // vec4(vertex_attrib.xyz * data_attrib.x,1.0);
+	vertex.xyz = vertex_quantize_offset + vertex.xyz * vertex_quantize_scale;
 
 	highp mat4 world_matrix = world_transform;
 
@@ -326,12 +369,19 @@ void main() {
 	}
 #endif
 
+#ifdef USE_OCTAHEDRAL_NORMALS
+	vec3 normal;
+	vec3 tangent;
+	float binormalf;
+	decode_octahedral_normal(normal_attrib, normal, tangent, binormalf);
+#else
 	vec3 normal = normal_attrib;
 
 #if defined(ENABLE_TANGENT_INTERP) || defined(ENABLE_NORMALMAP) || defined(LIGHT_USE_ANISOTROPY)
 	vec3 tangent = tangent_attrib.xyz;
 	float binormalf = tangent_attrib.a;
 #endif
+#endif
 
 #if defined(ENABLE_COLOR_INTERP)
 	color_interp = color_attrib;
@@ -347,7 +397,7 @@ void main() {
 #endif
 
 #if defined(ENABLE_UV_INTERP)
-	uv_interp = uv_attrib;
+	uv_interp = uv_quantize_offset + uv_attrib * uv_quantize_scale;
 #endif
 
 #if defined(ENABLE_UV2_INTERP) || defined(USE_LIGHTMAP)
@@ -60,6 +60,10 @@ uniform highp usampler2D source_depth_mipmaps; //texunit:1
 uniform sampler2D source_normal; //texunit:2
 
 uniform ivec2 screen_size;
+// the pass may run at a fraction of screen_size, every fragment then stands for a (1 << resolution_shift) pixel block
+uniform int resolution_shift;
+// changes every frame when AO is accumulated over time, so each frame contributes different taps
+uniform float rotation_offset;
 uniform float camera_z_far;
 uniform float camera_z_near;
 
@@ -201,7 +205,7 @@ float sampleAO(in ivec2 ssC, in vec3 C, in vec3 n_C, in float ssDiskRadius, in f
 
 void main() {
 	// Pixel being shaded
-	ivec2 ssC = ivec2(gl_FragCoord.xy);
+	ivec2 ssC = ivec2(gl_FragCoord.xy) << resolution_shift;
 
 	// World space point being shaded
 	vec3 C = getPosition(ssC);
@@ -224,7 +228,7 @@ void main() {
 #endif
 
 	// Hash function used in the HPG12 AlchemyAO paper
-	float randomPatternRotationAngle = mod(float((3 * ssC.x ^ ssC.y + ssC.x * ssC.y) * 10), TWO_PI);
+	float randomPatternRotationAngle = mod(float((3 * ssC.x ^ ssC.y + ssC.x * ssC.y) * 10), TWO_PI) + rotation_offset;
 
 	// Reconstruct normals from positions. These will lead to 1-pixel black lines
 	// at depth discontinuities, however the blur will wipe those out so they are not visible
@@ -247,7 +251,7 @@ void main() {
 #ifdef ENABLE_RADIUS2
 
 	//go again for radius2
-	randomPatternRotationAngle = mod(float((5 * ssC.x ^ ssC.y + ssC.x * ssC.y) * 11), TWO_PI);
+	randomPatternRotationAngle = mod(float((5 * ssC.x ^ ssC.y + ssC.x * ssC.y) * 11), TWO_PI) + rotation_offset;
 
 	// Reconstruct normals from positions. These will lead to 1-pixel black lines
 	// at depth discontinuities, however the blur will wipe those out so they are not visible
@@ -266,11 +270,17 @@ void main() {
 #endif
 	// Bilateral box-filter over a quad for free, respecting depth edges
 	// (the difference that this makes is subtle)
+	ivec2 quad_pos = ivec2(gl_FragCoord.xy);
 	if (abs(dFdx(C.z)) < 0.02) {
-		A -= dFdx(A) * (float(ssC.x & 1) - 0.5);
+		A -= dFdx(A) * (float(quad_pos.x & 1) - 0.5);
 	}
 	if (abs(dFdy(C.z)) < 0.02) {
-		A -= dFdy(A) * (float(ssC.y & 1) - 0.5);
+		A -= dFdy(A) * (float(quad_pos.y & 1) - 0.5);
+	}
+
+	// reduced resolution buffers have no depth attachment to mask the sky out
+	if (texelFetch(source_depth, ssC, 0).r >= 1.0) {
+		A = 1.0;
 	}
 
 	visibility = A;
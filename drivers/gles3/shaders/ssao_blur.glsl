@@ -18,6 +18,13 @@ uniform sampler2D source_ssao; //texunit:0
 uniform sampler2D source_depth; //texunit:1
 uniform sampler2D source_normal; //texunit:3
 
+#ifdef SSAO_TEMPORAL
+uniform sampler2D source_history; //texunit:2
+// maps the current clip space position of a pixel to where it was in the previous frame
+uniform highp mat4 reprojection;
+uniform float history_blend;
+#endif
+
 layout(location = 0) out float visibility;
 
 //////////////////////////////////////////////////////////////////////////////////////////////
@@ -56,20 +63,80 @@ uniform float camera_z_far;
 uniform float camera_z_near;
 
 uniform ivec2 screen_size;
+// source_ssao may be smaller than source_depth, by this power of two
+uniform int resolution_shift;
+
+float get_linear_depth(ivec2 p_pos) {
+
+	float depth = texelFetch(source_depth, p_pos, 0).r;
+	depth = depth * 2.0 - 1.0;
+	return 2.0 * camera_z_near * camera_z_far / (camera_z_far + camera_z_near - depth * (camera_z_far - camera_z_near));
+}
 
 void main() {
 
 	ivec2 ssC = ivec2(gl_FragCoord.xy);
 
-	float depth = texelFetch(source_depth, ssC, 0).r;
-	//vec3 normal = texelFetch(source_normal, ssC, 0).rgb * 2.0 - 1.0;
+#ifdef SSAO_UPSAMPLE
 
-	depth = depth * 2.0 - 1.0;
-	depth = 2.0 * camera_z_near * camera_z_far / (camera_z_far + camera_z_near - depth * (camera_z_far - camera_z_near));
+	// joint bilateral upsample: bilinear weights over the four nearest AO texels,
+	// scaled down for the texels whose depth differs from this pixel's
+	float depth = get_linear_depth(ssC);
 
-	float depth_divide = 1.0 / camera_z_far;
+	vec2 low_pos = (vec2(ssC) + vec2(0.5)) / float(1 << resolution_shift) - vec2(0.5);
+	ivec2 low_base = ivec2(floor(low_pos));
+	vec2 low_frac = low_pos - vec2(low_base);
+	ivec2 clamp_limit = screen_size - ivec2(1);
+
+	float sum = 0.0;
+	float total_weight = 0.0;
+
+	for (int y = 0; y < 2; y++) {
+		for (int x = 0; x < 2; x++) {
+
+			ivec2 low_sample = clamp(low_base + ivec2(x, y), ivec2(0), clamp_limit);
+			float weight = (x == 0 ? 1.0 - low_frac.x : low_frac.x) * (y == 0 ? 1.0 - low_frac.y : low_frac.y);
+			weight *= 1.0 / (0.0001 + abs(get_linear_depth(low_sample << resolution_shift) - depth));
+
+			sum += texelFetch(source_ssao, low_sample, 0).r * weight;
+			total_weight += weight;
+		}
+	}
 
-	//depth *= depth_divide;
+	visibility = sum / total_weight;
+
+#else
+#ifdef SSAO_TEMPORAL
+
+	float current = texelFetch(source_ssao, ssC, 0).r;
+
+	// clamp the history to the current neighborhood so disocclusions don't leave trails
+	ivec2 clamp_limit = screen_size - ivec2(1);
+	float neighbor_min = current;
+	float neighbor_max = current;
+	for (int y = -1; y <= 1; y++) {
+		for (int x = -1; x <= 1; x++) {
+			float v = texelFetch(source_ssao, clamp(ssC + ivec2(x, y), ivec2(0), clamp_limit), 0).r;
+			neighbor_min = min(neighbor_min, v);
+			neighbor_max = max(neighbor_max, v);
+		}
+	}
+
+	float raw_depth = texelFetch(source_depth, ssC << resolution_shift, 0).r;
+	vec4 clip = vec4((vec2(ssC) + vec2(0.5)) / vec2(screen_size) * 2.0 - vec2(1.0), raw_depth * 2.0 - 1.0, 1.0);
+	vec4 prev_clip = reprojection * clip;
+	vec2 prev_uv = (prev_clip.xy / prev_clip.w) * 0.5 + vec2(0.5);
+
+	if (any(lessThan(prev_uv, vec2(0.0))) || any(greaterThan(prev_uv, vec2(1.0)))) {
+		visibility = current;
+	} else {
+		float history = clamp(textureLod(source_history, prev_uv, 0.0).r, neighbor_min, neighbor_max);
+		visibility = mix(current, history, history_blend);
+	}
+
+#else
+
+	float depth = get_linear_depth(ssC << resolution_shift);
 
 	/*
 	if (depth > camera_z_far * 0.999) {
@@ -93,18 +160,12 @@ void main() {
 		if (r != 0) {
 
 			ivec2 ppos = ssC + axis * (r * filter_scale);
-			float value = texelFetch(source_ssao, clamp(ppos, ivec2(0), clamp_limit), 0).r;
 			ivec2 rpos = clamp(ppos, ivec2(0), clamp_limit);
-			float temp_depth = texelFetch(source_depth, rpos, 0).r;
-			//vec3 temp_normal = texelFetch(source_normal, rpos, 0).rgb * 2.0 - 1.0;
-
-			temp_depth = temp_depth * 2.0 - 1.0;
-			temp_depth = 2.0 * camera_z_near * camera_z_far / (camera_z_far + camera_z_near - temp_depth * (camera_z_far - camera_z_near));
-			//temp_depth *= depth_divide;
+			float value = texelFetch(source_ssao, rpos, 0).r;
+			float temp_depth = get_linear_depth(rpos << resolution_shift);
 
 			// spatial domain: offset gaussian tap
 			float weight = 0.3 + gaussian[abs(r)];
-			//weight *= max(0.0, dot(temp_normal, normal));
 
 			// range domain (the "bilateral" weight). As depth difference increases, decrease weight.
 			weight *= max(0.0, 1.0 - edge_sharpness * abs(temp_depth - depth));
@@ -116,4 +177,6 @@ void main() {
 
 	const float epsilon = 0.0001;
 	visibility = sum / (totalWeight + epsilon);
+#endif
+#endif
 }
@@ -34,6 +34,9 @@
 
 #include "core/os/os.h"
 #include "core/print_string.h"
+#include "drivers/unix/file_access_unix_uring.h"
+
+#include <errno.h>
 
 #include <sys/stat.h>
 #include <sys/types.h>
@@ -42,6 +45,11 @@
 #include <unistd.h>
 #endif
 
+#if defined(UNIX_ENABLED) && !defined(JAVASCRIPT_ENABLED)
+#include <sys/mman.h>
+#define FILE_ACCESS_UNIX_MMAP_ENABLED
+#endif
+
 #ifndef ANDROID_ENABLED
 #include <sys/statvfs.h>
 #endif
@@ -227,6 +235,101 @@ int FileAccessUnix::get_buffer(uint8_t *p_dst, int p_length) const {
 	return read;
 };
 
+#ifdef FILE_ACCESS_UNIX_MMAP_ENABLED
+struct FileAccessUnixMapping : public MemoryPool::ExternalMemory {
+
+	void *mem;
+	size_t len;
+
+	FileAccessUnixMapping(void *p_mem, size_t p_len) :
+			mem(p_mem),
+			len(p_len) {}
+	~FileAccessUnixMapping() { munmap(mem, len); }
+};
+#endif
+
+uint8_t *FileAccessUnix::map_buffer(uint64_t p_length, MemoryPool::ExternalMemory **r_owner) const {
+
+#ifdef FILE_ACCESS_UNIX_MMAP_ENABLED
+	ERR_FAIL_COND_V(!f, NULL);
+
+	if (flags != READ || p_length == 0)
+		return NULL;
+
+	size_t pos = get_position();
+	if (pos + p_length > get_len())
+		return NULL;
+
+	//mappings start on a page boundary, the payload may not
+	size_t page_size = sysconf(_SC_PAGESIZE);
+	size_t map_offset = pos - pos % page_size;
+	size_t map_len = p_length + (pos - map_offset);
+
+	//private, so writes to the array stay in memory and only copy the pages touched
+	void *mem = mmap(NULL, map_len, PROT_READ | PROT_WRITE, MAP_PRIVATE, fileno(f), map_offset);
+	if (mem == MAP_FAILED)
+		return NULL;
+
+	fseek(f, pos + p_length, SEEK_SET);
+	check_errors();
+
+	*r_owner = memnew(FileAccessUnixMapping(mem, map_len));
+	return (uint8_t *)mem + (pos - map_offset);
+#else
+	return NULL;
+#endif
+}
+
+int FileAccessUnix::_read_at(uint64_t p_offset, uint8_t *p_dst, int p_length) const {
+
+#if defined(UNIX_ENABLED)
+	ERR_FAIL_COND_V(!f, -1);
+
+	int fd = fileno(f);
+	int total = 0;
+	while (total < p_length) {
+		ssize_t read = pread(fd, p_dst + total, p_length - total, p_offset + total);
+		if (read < 0) {
+			if (errno == EINTR)
+				continue;
+			return -1;
+		}
+		if (read == 0)
+			break; //eof
+		total += read;
+	}
+	return total;
+#else
+	return -1;
+#endif
+}
+
+Error FileAccessUnix::_read_async(AsyncRead *p_read) {
+
+#if defined(UNIX_ENABLED)
+	// Reads go straight to the descriptor, only safe while nothing is buffered for writing.
+	if (f && flags == READ) {
+#ifdef FILE_ACCESS_UNIX_URING_ENABLED
+		if (FileAccessUnixUring::submit(fileno(f), p_read))
+			return OK;
+#endif
+		_queue_async_read(p_read);
+		return OK;
+	}
+#endif
+
+	return FileAccess::_read_async(p_read);
+}
+
+bool FileAccessUnix::is_async_read_supported() const {
+
+#if defined(UNIX_ENABLED)
+	return f && flags == READ;
+#else
+	return false;
+#endif
+}
+
 Error FileAccessUnix::get_error() const {
 
 	return last_error;
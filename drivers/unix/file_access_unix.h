@@ -56,6 +56,11 @@ class FileAccessUnix : public FileAccess {
 
 	static FileAccess *create_libc();
 
+	friend class FileAccessUnixUring;
+
+protected:
+	virtual int _read_at(uint64_t p_offset, uint8_t *p_dst, int p_length) const;
+
 public:
 	static CloseNotificationFunc close_notification_func;
 
@@ -75,6 +80,9 @@ public:
 
 	virtual uint8_t get_8() const; ///< get a byte
 	virtual int get_buffer(uint8_t *p_dst, int p_length) const;
+	virtual uint8_t *map_buffer(uint64_t p_length, MemoryPool::ExternalMemory **r_owner) const;
+	virtual Error _read_async(AsyncRead *p_read);
+	virtual bool is_async_read_supported() const;
 
 	virtual Error get_error() const; ///< get last error
 
@@ -0,0 +1,315 @@
+/*************************************************************************/
+/*  file_access_unix_uring.cpp                                           */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2019 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2019 Godot Engine contributors (cf. AUTHORS.md)    */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+
+#include "file_access_unix_uring.h"
+
+#ifdef FILE_ACCESS_UNIX_URING_ENABLED
+
+#include "core/os/os.h"
+#include "core/os/thread.h"
+#include "drivers/unix/file_access_unix.h"
+
+#include <errno.h>
+#include <linux/io_uring.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+// Not every libc knows the syscalls yet, the numbers are the same on all architectures.
+#ifndef __NR_io_uring_setup
+#define __NR_io_uring_setup 425
+#endif
+#ifndef __NR_io_uring_enter
+#define __NR_io_uring_enter 426
+#endif
+
+static struct {
+	int fd;
+	Thread *thread;
+	volatile uint32_t lock;
+	volatile uint32_t in_flight;
+	bool exit;
+
+	void *sq_ptr;
+	size_t sq_size;
+	void *cq_ptr;
+	size_t cq_size;
+	struct io_uring_sqe *sqes;
+	size_t sqes_size;
+
+	uint32_t *sq_head;
+	uint32_t *sq_tail;
+	uint32_t sq_mask;
+	uint32_t sq_entries;
+	uint32_t *sq_array;
+
+	uint32_t *cq_head;
+	uint32_t *cq_tail;
+	uint32_t cq_mask;
+	uint32_t cq_entries;
+	struct io_uring_cqe *cqes;
+} uring;
+
+volatile uint32_t FileAccessUnixUring::state = STATE_NONE;
+
+static_assert(sizeof(struct iovec) <= sizeof(((FileAccess::AsyncRead *)NULL)->backend_data), "iovec must fit in AsyncRead::backend_data");
+
+static int _io_uring_enter(unsigned int p_to_submit, unsigned int p_min_complete, unsigned int p_flags) {
+
+	return syscall(__NR_io_uring_enter, uring.fd, p_to_submit, p_min_complete, p_flags, NULL, 0);
+}
+
+static void _uring_lock() {
+
+	while (uring.lock || !atomic_compare_exchange(&uring.lock, (uint32_t)0, (uint32_t)1)) {
+	}
+}
+
+static void _uring_unlock() {
+
+	atomic_compare_exchange(&uring.lock, (uint32_t)1, (uint32_t)0);
+}
+
+static void _uring_release() {
+
+	if (uring.sqes) {
+		munmap(uring.sqes, uring.sqes_size);
+	}
+	if (uring.cq_ptr && uring.cq_ptr != uring.sq_ptr) {
+		munmap(uring.cq_ptr, uring.cq_size);
+	}
+	if (uring.sq_ptr) {
+		munmap(uring.sq_ptr, uring.sq_size);
+	}
+	close(uring.fd);
+	uring.fd = -1;
+}
+
+// Must be called with the lock held. Returns the entry to fill, or NULL if the queue is full.
+static struct io_uring_sqe *_get_sqe() {
+
+	uint32_t tail = *uring.sq_tail;
+	uint32_t head = __atomic_load_n(uring.sq_head, __ATOMIC_ACQUIRE);
+	if (tail - head >= uring.sq_entries) {
+		return NULL;
+	}
+
+	uint32_t index = tail & uring.sq_mask;
+	struct io_uring_sqe *sqe = &uring.sqes[index];
+	memset(sqe, 0, sizeof(struct io_uring_sqe));
+	uring.sq_array[index] = index;
+	return sqe;
+}
+
+// Must be called with the lock held, after filling the entry from _get_sqe().
+static void _submit_sqe() {
+
+	uint32_t tail = *uring.sq_tail + 1;
+	__atomic_store_n(uring.sq_tail, tail, __ATOMIC_RELEASE);
+
+	// Entries left over from a failed call are submitted along.
+	uint32_t pending = tail - __atomic_load_n(uring.sq_head, __ATOMIC_ACQUIRE);
+	while (_io_uring_enter(pending, 0, 0) < 0 && (errno == EINTR || errno == EAGAIN)) {
+	}
+}
+
+bool FileAccessUnixUring::_init() {
+
+	struct io_uring_params params;
+	memset(&params, 0, sizeof(params));
+	memset(&uring, 0, sizeof(uring));
+
+	uring.fd = syscall(__NR_io_uring_setup, QUEUE_DEPTH, &params);
+	if (uring.fd < 0) {
+		return false;
+	}
+
+	uring.sq_size = params.sq_off.array + params.sq_entries * sizeof(uint32_t);
+	uring.cq_size = params.cq_off.cqes + params.cq_entries * sizeof(struct io_uring_cqe);
+	bool single_mmap = false;
+#ifdef IORING_FEAT_SINGLE_MMAP
+	single_mmap = params.features & IORING_FEAT_SINGLE_MMAP;
+	if (single_mmap) {
+		uring.sq_size = MAX(uring.sq_size, uring.cq_size);
+	}
+#endif
+
+	uring.sq_ptr = mmap(NULL, uring.sq_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, uring.fd, IORING_OFF_SQ_RING);
+	if (uring.sq_ptr == MAP_FAILED) {
+		uring.sq_ptr = NULL;
+		_uring_release();
+		return false;
+	}
+
+	if (single_mmap) {
+		uring.cq_ptr = uring.sq_ptr;
+	} else {
+		uring.cq_ptr = mmap(NULL, uring.cq_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, uring.fd, IORING_OFF_CQ_RING);
+		if (uring.cq_ptr == MAP_FAILED) {
+			uring.cq_ptr = NULL;
+			_uring_release();
+			return false;
+		}
+	}
+
+	uring.sqes_size = params.sq_entries * sizeof(struct io_uring_sqe);
+	uring.sqes = (struct io_uring_sqe *)mmap(NULL, uring.sqes_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, uring.fd, IORING_OFF_SQES);
+	if (uring.sqes == MAP_FAILED) {
+		uring.sqes = NULL;
+		_uring_release();
+		return false;
+	}
+
+	uint8_t *sq = (uint8_t *)uring.sq_ptr;
+	uring.sq_head = (uint32_t *)(sq + params.sq_off.head);
+	uring.sq_tail = (uint32_t *)(sq + params.sq_off.tail);
+	uring.sq_mask = *(uint32_t *)(sq + params.sq_off.ring_mask);
+	uring.sq_entries = *(uint32_t *)(sq + params.sq_off.ring_entries);
+	uring.sq_array = (uint32_t *)(sq + params.sq_off.array);
+
+	uint8_t *cq = (uint8_t *)uring.cq_ptr;
+	uring.cq_head = (uint32_t *)(cq + params.cq_off.head);
+	uring.cq_tail = (uint32_t *)(cq + params.cq_off.tail);
+	uring.cq_mask = *(uint32_t *)(cq + params.cq_off.ring_mask);
+	uring.cq_entries = *(uint32_t *)(cq + params.cq_off.ring_entries);
+	uring.cqes = (struct io_uring_cqe *)(cq + params.cq_off.cqes);
+
+	uring.thread = Thread::create(_thread_function, NULL);
+	if (!uring.thread) {
+		_uring_release();
+		return false;
+	}
+
+	return true;
+}
+
+void FileAccessUnixUring::_thread_function(void *p_user) {
+
+	while (true) {
+		if (_io_uring_enter(0, 1, IORING_ENTER_GETEVENTS) < 0 && errno != EINTR) {
+			ERR_PRINT("io_uring wait failed, async reads stall.");
+			break;
+		}
+
+		uint32_t head = *uring.cq_head;
+		uint32_t tail = __atomic_load_n(uring.cq_tail, __ATOMIC_ACQUIRE);
+		while (head != tail) {
+			struct io_uring_cqe *cqe = &uring.cqes[head & uring.cq_mask];
+			FileAccess::AsyncRead *read = (FileAccess::AsyncRead *)(uintptr_t)cqe->user_data;
+			int result = cqe->res;
+			head++;
+			__atomic_store_n(uring.cq_head, head, __ATOMIC_RELEASE);
+
+			if (!read) {
+				uring.exit = true; // The no-op posted by finish().
+				continue;
+			}
+
+			atomic_decrement(&uring.in_flight);
+			FileAccessUnix::_complete_async_read(read, result < 0 ? -1 : result);
+		}
+
+		if (uring.exit && !uring.in_flight) {
+			break;
+		}
+	}
+}
+
+bool FileAccessUnixUring::submit(int p_fd, FileAccess::AsyncRead *p_read) {
+
+	if (state != STATE_READY) {
+		if (state == STATE_NONE && atomic_compare_exchange(&state, (uint32_t)STATE_NONE, (uint32_t)STATE_STARTING)) {
+			atomic_compare_exchange(&state, (uint32_t)STATE_STARTING, (uint32_t)(_init() ? STATE_READY : STATE_UNAVAILABLE));
+		}
+		if (atomic_add(&state, (uint32_t)0) != STATE_READY) {
+			return false;
+		}
+	}
+
+	_uring_lock();
+
+	// Never more in flight than the completion queue holds.
+	struct io_uring_sqe *sqe = uring.in_flight < uring.cq_entries ? _get_sqe() : NULL;
+	if (!sqe) {
+		_uring_unlock();
+		return false;
+	}
+
+	struct iovec *iov = (struct iovec *)p_read->backend_data;
+	iov->iov_base = p_read->dst;
+	iov->iov_len = p_read->file_length;
+
+	sqe->opcode = IORING_OP_READV;
+	sqe->fd = p_fd;
+	sqe->off = p_read->file_offset;
+	sqe->addr = (uint64_t)(uintptr_t)iov;
+	sqe->len = 1;
+	sqe->user_data = (uint64_t)(uintptr_t)p_read;
+
+	atomic_increment(&uring.in_flight);
+	_submit_sqe();
+
+	_uring_unlock();
+	return true;
+}
+
+void FileAccessUnixUring::finish() {
+
+	if (!atomic_compare_exchange(&state, (uint32_t)STATE_READY, (uint32_t)STATE_UNAVAILABLE)) {
+		return;
+	}
+
+	// Wakes the thread, which leaves once the reads still in flight are done.
+	struct io_uring_sqe *sqe = NULL;
+	while (true) {
+		_uring_lock();
+		sqe = _get_sqe();
+		if (sqe) {
+			break;
+		}
+		_uring_unlock();
+		OS::get_singleton()->delay_usec(100);
+	}
+	sqe->opcode = IORING_OP_NOP;
+	sqe->user_data = 0;
+	_submit_sqe();
+	_uring_unlock();
+
+	Thread::wait_to_finish(uring.thread);
+	memdelete(uring.thread);
+	uring.thread = NULL;
+
+	_uring_release();
+}
+
+#endif
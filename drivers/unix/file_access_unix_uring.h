@@ -0,0 +1,77 @@
+/*************************************************************************/
+/*  file_access_unix_uring.h                                             */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2019 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2019 Godot Engine contributors (cf. AUTHORS.md)    */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+
+#ifndef FILE_ACCESS_UNIX_URING_H
+#define FILE_ACCESS_UNIX_URING_H
+
+#include "core/os/file_access.h"
+
+#if defined(__linux__) && !defined(ANDROID_ENABLED) && !defined(NO_THREADS) && defined(__has_include)
+#if __has_include(<linux/io_uring.h>)
+#define FILE_ACCESS_UNIX_URING_ENABLED
+#endif
+#endif
+
+#ifdef FILE_ACCESS_UNIX_URING_ENABLED
+
+/**
+	Submits FileAccessUnix async reads to an io_uring, so any number of them
+	can be in flight without a thread each. One thread reaps the completions.
+	The ring is set up with the first read. If the kernel has no io_uring, or
+	the ring is full, submit() fails and the read goes to the I/O threads.
+*/
+
+class FileAccessUnixUring {
+
+	enum {
+		QUEUE_DEPTH = 256
+	};
+
+	enum State {
+		STATE_NONE,
+		STATE_STARTING,
+		STATE_READY,
+		STATE_UNAVAILABLE
+	};
+
+	static volatile uint32_t state;
+
+	static bool _init();
+	static void _thread_function(void *p_user);
+
+public:
+	static bool submit(int p_fd, FileAccess::AsyncRead *p_read);
+	static void finish();
+};
+
+#endif
+
+#endif // FILE_ACCESS_UNIX_URING_H
@@ -55,6 +55,13 @@
 
 #include <netinet/tcp.h>
 
+#if defined(NET_SOCKET_POLLER_EPOLL)
+#include <sys/epoll.h>
+#elif defined(NET_SOCKET_POLLER_KQUEUE)
+#include <sys/event.h>
+#include <sys/time.h>
+#endif
+
 #if defined(__APPLE__)
 #define MSG_NOSIGNAL SO_NOSIGPIPE
 #endif
@@ -65,6 +72,7 @@
 #define SOCK_CBUF(x) x
 #define SOCK_IOCTL ioctl
 #define SOCK_CLOSE ::close
+#define SOCK_POLL ::poll
 
 /* Windows */
 #elif defined(WINDOWS_ENABLED)
@@ -78,6 +86,7 @@
 #define SOCK_CBUF(x) (const char *)(x)
 #define SOCK_IOCTL ioctlsocket
 #define SOCK_CLOSE closesocket
+#define SOCK_POLL WSAPoll
 
 // Windows doesn't have this flag
 #ifndef MSG_NOSIGNAL
@@ -156,6 +165,7 @@ void NetSocketPosix::make_default() {
 	}
 #endif
 	_create = _create_func;
+	NetSocketPollerPosix::make_default();
 }
 
 void NetSocketPosix::cleanup() {
@@ -614,3 +624,331 @@ Ref<NetSocket> NetSocketPosix::accept(IP_Address &r_ip, uint16_t &r_port) {
 	ns->set_blocking_enabled(false);
 	return Ref<NetSocket>(ns);
 }
+
+NetSocketPoller *NetSocketPollerPosix::_create_func() {
+	return memnew(NetSocketPollerPosix);
+}
+
+void NetSocketPollerPosix::make_default() {
+	_create = _create_func;
+}
+
+SOCKET_TYPE NetSocketPollerPosix::_get_fd(const Ref<NetSocket> &p_sock) {
+
+	ERR_FAIL_COND_V(p_sock.is_null(), SOCK_EMPTY);
+	// NetSocketPosix is the only socket implementation when this poller is the default.
+	return static_cast<const NetSocketPosix *>(p_sock.ptr())->_sock;
+}
+
+#if defined(NET_SOCKET_POLLER_EPOLL)
+
+static uint32_t _epoll_events(int p_events) {
+
+	uint32_t events = EPOLLRDHUP;
+	if (p_events & NetSocketPoller::EVENT_IN)
+		events |= EPOLLIN;
+	if (p_events & NetSocketPoller::EVENT_OUT)
+		events |= EPOLLOUT;
+	return events;
+}
+
+Error NetSocketPollerPosix::add_socket(const Ref<NetSocket> &p_sock, int p_events, uint64_t p_id) {
+
+	SOCKET_TYPE fd = _get_fd(p_sock);
+	ERR_FAIL_COND_V(fd == SOCK_EMPTY, ERR_INVALID_PARAMETER);
+	ERR_FAIL_COND_V(_registered.has(fd), ERR_ALREADY_EXISTS);
+
+	struct epoll_event ev;
+	ev.events = _epoll_events(p_events);
+	ev.data.u64 = p_id;
+	ERR_FAIL_COND_V(epoll_ctl(_queue, EPOLL_CTL_ADD, fd, &ev) != 0, FAILED);
+
+	_registered[fd] = p_events;
+	return OK;
+}
+
+Error NetSocketPollerPosix::modify_socket(const Ref<NetSocket> &p_sock, int p_events, uint64_t p_id) {
+
+	SOCKET_TYPE fd = _get_fd(p_sock);
+	ERR_FAIL_COND_V(!_registered.has(fd), ERR_DOES_NOT_EXIST);
+
+	struct epoll_event ev;
+	ev.events = _epoll_events(p_events);
+	ev.data.u64 = p_id;
+	ERR_FAIL_COND_V(epoll_ctl(_queue, EPOLL_CTL_MOD, fd, &ev) != 0, FAILED);
+
+	_registered[fd] = p_events;
+	return OK;
+}
+
+void NetSocketPollerPosix::remove_socket(const Ref<NetSocket> &p_sock) {
+
+	SOCKET_TYPE fd = _get_fd(p_sock);
+	if (!_registered.has(fd))
+		return;
+
+	struct epoll_event ev; // Ignored, but kernels before 2.6.9 require it.
+	epoll_ctl(_queue, EPOLL_CTL_DEL, fd, &ev);
+	_registered.erase(fd);
+}
+
+Error NetSocketPollerPosix::wait(Vector<Event> &r_events, int p_timeout) {
+
+	r_events.clear();
+	if (_registered.empty())
+		return OK;
+
+	struct epoll_event ready[64];
+	int ret = epoll_wait(_queue, ready, 64, p_timeout);
+	if (ret < 0)
+		return errno == EINTR ? OK : FAILED;
+
+	r_events.resize(ret);
+	for (int i = 0; i < ret; i++) {
+		int flags = 0;
+		if (ready[i].events & EPOLLIN)
+			flags |= EVENT_IN;
+		if (ready[i].events & EPOLLOUT)
+			flags |= EVENT_OUT;
+		if (ready[i].events & (EPOLLHUP | EPOLLRDHUP))
+			flags |= EVENT_HANGUP;
+		if (ready[i].events & EPOLLERR)
+			flags |= EVENT_ERROR;
+		r_events.write[i].id = ready[i].data.u64;
+		r_events.write[i].flags = flags;
+	}
+	return OK;
+}
+
+NetSocketPollerPosix::NetSocketPollerPosix() {
+	_queue = epoll_create1(EPOLL_CLOEXEC);
+	ERR_FAIL_COND(_queue < 0);
+}
+
+NetSocketPollerPosix::~NetSocketPollerPosix() {
+	if (_queue >= 0)
+		::close(_queue);
+}
+
+#elif defined(NET_SOCKET_POLLER_KQUEUE)
+
+// Read and write readiness are separate filters, so changing the mask is a diff of both.
+static int _kqueue_apply(int p_queue, SOCKET_TYPE p_fd, int p_old, int p_new, uint64_t p_id) {
+
+	struct kevent changes[2];
+	int count = 0;
+
+	if ((p_old ^ p_new) & NetSocketPoller::EVENT_IN) {
+		EV_SET(&changes[count++], p_fd, EVFILT_READ, (p_new & NetSocketPoller::EVENT_IN) ? EV_ADD : EV_DELETE, 0, 0, (void *)(uintptr_t)p_id);
+	}
+	if ((p_old ^ p_new) & NetSocketPoller::EVENT_OUT) {
+		EV_SET(&changes[count++], p_fd, EVFILT_WRITE, (p_new & NetSocketPoller::EVENT_OUT) ? EV_ADD : EV_DELETE, 0, 0, (void *)(uintptr_t)p_id);
+	}
+
+	if (!count)
+		return 0;
+	return kevent(p_queue, changes, count, NULL, 0, NULL);
+}
+
+Error NetSocketPollerPosix::add_socket(const Ref<NetSocket> &p_sock, int p_events, uint64_t p_id) {
+
+	SOCKET_TYPE fd = _get_fd(p_sock);
+	ERR_FAIL_COND_V(fd == SOCK_EMPTY, ERR_INVALID_PARAMETER);
+	ERR_FAIL_COND_V(_registered.has(fd), ERR_ALREADY_EXISTS);
+
+	// Without a filter kqueue can't report hangups, so always watch reads.
+	int events = p_events | EVENT_IN;
+	ERR_FAIL_COND_V(_kqueue_apply(_queue, fd, 0, events, p_id) != 0, FAILED);
+
+	_registered[fd] = events;
+	return OK;
+}
+
+Error NetSocketPollerPosix::modify_socket(const Ref<NetSocket> &p_sock, int p_events, uint64_t p_id) {
+
+	SOCKET_TYPE fd = _get_fd(p_sock);
+	ERR_FAIL_COND_V(!_registered.has(fd), ERR_DOES_NOT_EXIST);
+
+	// EV_ADD on an existing filter only updates its user data.
+	int events = p_events | EVENT_IN;
+	ERR_FAIL_COND_V(_kqueue_apply(_queue, fd, 0, events, p_id) != 0, FAILED);
+	if ((_registered[fd] & EVENT_OUT) && !(events & EVENT_OUT))
+		_kqueue_apply(_queue, fd, EVENT_OUT, 0, p_id);
+
+	_registered[fd] = events;
+	return OK;
+}
+
+void NetSocketPollerPosix::remove_socket(const Ref<NetSocket> &p_sock) {
+
+	SOCKET_TYPE fd = _get_fd(p_sock);
+	if (!_registered.has(fd))
+		return;
+
+	_kqueue_apply(_queue, fd, _registered[fd], 0, 0);
+	_registered.erase(fd);
+}
+
+Error NetSocketPollerPosix::wait(Vector<Event> &r_events, int p_timeout) {
+
+	r_events.clear();
+	if (_registered.empty())
+		return OK;
+
+	struct timespec ts;
+	struct timespec *tsp = NULL;
+	if (p_timeout >= 0) {
+		ts.tv_sec = p_timeout / 1000;
+		ts.tv_nsec = (p_timeout % 1000) * 1000000;
+		tsp = &ts;
+	}
+
+	struct kevent ready[64];
+	int ret = kevent(_queue, NULL, 0, ready, 64, tsp);
+	if (ret < 0)
+		return errno == EINTR ? OK : FAILED;
+
+	// A socket can show up once per filter, merge them.
+	HashMap<uint64_t, int> merged;
+	for (int i = 0; i < ret; i++) {
+		uint64_t id = (uint64_t)(uintptr_t)ready[i].udata;
+		int *flags = merged.getptr(id);
+		if (!flags) {
+			Event ev;
+			ev.id = id;
+			ev.flags = 0;
+			merged[id] = r_events.size();
+			r_events.push_back(ev);
+			flags = merged.getptr(id);
+		}
+
+		Event &ev = r_events.write[*flags];
+		if (ready[i].filter == EVFILT_READ)
+			ev.flags |= EVENT_IN;
+		if (ready[i].filter == EVFILT_WRITE)
+			ev.flags |= EVENT_OUT;
+		if (ready[i].flags & EV_EOF)
+			ev.flags |= EVENT_HANGUP;
+		if (ready[i].flags & EV_ERROR)
+			ev.flags |= EVENT_ERROR;
+	}
+	return OK;
+}
+
+NetSocketPollerPosix::NetSocketPollerPosix() {
+	_queue = kqueue();
+	ERR_FAIL_COND(_queue < 0);
+}
+
+NetSocketPollerPosix::~NetSocketPollerPosix() {
+	if (_queue >= 0)
+		::close(_queue);
+}
+
+#else
+
+static short _poll_events(int p_events) {
+
+	short events = 0;
+	if (p_events & NetSocketPoller::EVENT_IN)
+		events |= POLLIN;
+	if (p_events & NetSocketPoller::EVENT_OUT)
+		events |= POLLOUT;
+	return events;
+}
+
+Error NetSocketPollerPosix::add_socket(const Ref<NetSocket> &p_sock, int p_events, uint64_t p_id) {
+
+	SOCKET_TYPE fd = _get_fd(p_sock);
+	ERR_FAIL_COND_V(fd == SOCK_EMPTY, ERR_INVALID_PARAMETER);
+	ERR_FAIL_COND_V(_indices.has(fd), ERR_ALREADY_EXISTS);
+
+	struct pollfd pfd;
+	pfd.fd = fd;
+	pfd.events = _poll_events(p_events);
+	pfd.revents = 0;
+
+	_indices[fd] = _fds.size();
+	_fds.push_back(pfd);
+	_ids.push_back(p_id);
+	return OK;
+}
+
+Error NetSocketPollerPosix::modify_socket(const Ref<NetSocket> &p_sock, int p_events, uint64_t p_id) {
+
+	SOCKET_TYPE fd = _get_fd(p_sock);
+	const int *idx = _indices.getptr(fd);
+	ERR_FAIL_COND_V(!idx, ERR_DOES_NOT_EXIST);
+
+	_fds.write[*idx].events = _poll_events(p_events);
+	_ids.write[*idx] = p_id;
+	return OK;
+}
+
+void NetSocketPollerPosix::remove_socket(const Ref<NetSocket> &p_sock) {
+
+	SOCKET_TYPE fd = _get_fd(p_sock);
+	const int *idx = _indices.getptr(fd);
+	if (!idx)
+		return;
+
+	// Swap with the last entry to keep removal O(1).
+	int index = *idx;
+	int last = _fds.size() - 1;
+	if (index != last) {
+		_fds.write[index] = _fds[last];
+		_ids.write[index] = _ids[last];
+		_indices[_fds[index].fd] = index;
+	}
+	_fds.resize(last);
+	_ids.resize(last);
+	_indices.erase(fd);
+}
+
+Error NetSocketPollerPosix::wait(Vector<Event> &r_events, int p_timeout) {
+
+	r_events.clear();
+	if (_fds.empty())
+		return OK;
+
+	int ret = SOCK_POLL(_fds.ptrw(), _fds.size(), p_timeout);
+	if (ret < 0)
+		return FAILED;
+
+	for (int i = 0; i < _fds.size() && r_events.size() < ret; i++) {
+		short revents = _fds[i].revents;
+		if (!revents)
+			continue;
+
+		Event ev;
+		ev.id = _ids[i];
+		ev.flags = 0;
+		if (revents & POLLIN)
+			ev.flags |= EVENT_IN;
+		if (revents & POLLOUT)
+			ev.flags |= EVENT_OUT;
+		if (revents & POLLHUP)
+			ev.flags |= EVENT_HANGUP;
+		if (revents & (POLLERR | POLLNVAL))
+			ev.flags |= EVENT_ERROR;
+		r_events.push_back(ev);
+	}
+	return OK;
+}
+
+NetSocketPollerPosix::NetSocketPollerPosix() {
+}
+
+NetSocketPollerPosix::~NetSocketPollerPosix() {
+}
+
+#endif
+
+int NetSocketPollerPosix::get_socket_count() const {
+
+#if defined(NET_SOCKET_POLLER_EPOLL) || defined(NET_SOCKET_POLLER_KQUEUE)
+	return _registered.size();
+#else
+	return _fds.size();
+#endif
+}
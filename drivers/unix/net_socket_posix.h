@@ -44,8 +44,24 @@
 
 #endif
 
+#include "core/hash_map.h"
+
+#if defined(__linux__)
+#define NET_SOCKET_POLLER_EPOLL
+#elif defined(__APPLE__) || defined(__FreeBSD__) || defined(__OpenBSD__) || defined(__NetBSD__) || defined(__DragonFly__)
+#define NET_SOCKET_POLLER_KQUEUE
+#else
+// Plain poll() array, WSAPoll() on Windows.
+#define NET_SOCKET_POLLER_POLL
+#if !defined(WINDOWS_ENABLED)
+#include <poll.h>
+#endif
+#endif
+
 class NetSocketPosix : public NetSocket {
 
+	friend class NetSocketPollerPosix;
+
 private:
 	SOCKET_TYPE _sock;
 	IP::Type _ip_type;
@@ -98,4 +114,35 @@ public:
 	~NetSocketPosix();
 };
 
+class NetSocketPollerPosix : public NetSocketPoller {
+
+private:
+#if defined(NET_SOCKET_POLLER_EPOLL) || defined(NET_SOCKET_POLLER_KQUEUE)
+	int _queue;
+	HashMap<SOCKET_TYPE, int> _registered; // fd -> events.
+#else
+	Vector<struct pollfd> _fds;
+	Vector<uint64_t> _ids;
+	HashMap<SOCKET_TYPE, int> _indices; // fd -> index in _fds.
+#endif
+
+	static SOCKET_TYPE _get_fd(const Ref<NetSocket> &p_sock);
+
+protected:
+	static NetSocketPoller *_create_func();
+
+public:
+	static void make_default();
+
+	virtual Error add_socket(const Ref<NetSocket> &p_sock, int p_events, uint64_t p_id);
+	virtual Error modify_socket(const Ref<NetSocket> &p_sock, int p_events, uint64_t p_id);
+	virtual void remove_socket(const Ref<NetSocket> &p_sock);
+	virtual int get_socket_count() const;
+
+	virtual Error wait(Vector<Event> &r_events, int p_timeout);
+
+	NetSocketPollerPosix();
+	~NetSocketPollerPosix();
+};
+
 #endif
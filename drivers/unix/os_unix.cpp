@@ -36,6 +36,7 @@
 #include "core/project_settings.h"
 #include "drivers/unix/dir_access_unix.h"
 #include "drivers/unix/file_access_unix.h"
+#include "drivers/unix/file_access_unix_uring.h"
 #include "drivers/unix/mutex_posix.h"
 #include "drivers/unix/net_socket_posix.h"
 #include "drivers/unix/rw_lock_posix.h"
@@ -166,6 +167,9 @@ void OS_Unix::initialize_core() {
 
 void OS_Unix::finalize_core() {
 
+#ifdef FILE_ACCESS_UNIX_URING_ENABLED
+	FileAccessUnixUring::finish();
+#endif
 	NetSocketPosix::cleanup();
 }
 
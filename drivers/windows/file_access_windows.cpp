@@ -33,6 +33,7 @@
 #include "file_access_windows.h"
 
 #include "core/os/os.h"
+#include "core/os/thread.h"
 #include "core/print_string.h"
 
 #include <shlwapi.h>
@@ -47,6 +48,17 @@
 #define S_ISREG(m) ((m)&_S_IFREG)
 #endif
 
+enum {
+	COMPLETION_PORT_NONE,
+	COMPLETION_PORT_STARTING,
+	COMPLETION_PORT_READY,
+	COMPLETION_PORT_UNAVAILABLE
+};
+
+void *FileAccessWindows::completion_port = NULL;
+Thread *FileAccessWindows::completion_thread = NULL;
+volatile uint32_t FileAccessWindows::completion_state = COMPLETION_PORT_NONE;
+
 void FileAccessWindows::check_errors() const {
 
 	ERR_FAIL_COND(!f);
@@ -127,6 +139,11 @@ Error FileAccessWindows::_open(const String &p_path, int p_mode_flags) {
 }
 void FileAccessWindows::close() {
 
+	if (async_handle) {
+		CloseHandle((HANDLE)async_handle);
+		async_handle = NULL;
+	}
+
 	if (!f)
 		return;
 
@@ -256,6 +273,89 @@ Error FileAccessWindows::get_error() const {
 	return last_error;
 }
 
+bool FileAccessWindows::_start_completion_port() {
+
+#ifdef UWP_ENABLED
+	return false;
+#else
+	if (completion_state == COMPLETION_PORT_NONE && atomic_compare_exchange(&completion_state, (uint32_t)COMPLETION_PORT_NONE, (uint32_t)COMPLETION_PORT_STARTING)) {
+		bool ready = false;
+		completion_port = CreateIoCompletionPort(INVALID_HANDLE_VALUE, NULL, 0, 1);
+		if (completion_port) {
+			completion_thread = Thread::create(_completion_thread_function, NULL);
+			ready = completion_thread != NULL;
+			if (!ready) {
+				CloseHandle((HANDLE)completion_port);
+				completion_port = NULL;
+			}
+		}
+		atomic_compare_exchange(&completion_state, (uint32_t)COMPLETION_PORT_STARTING, (uint32_t)(ready ? COMPLETION_PORT_READY : COMPLETION_PORT_UNAVAILABLE));
+	}
+	return atomic_add(&completion_state, (uint32_t)0) == COMPLETION_PORT_READY;
+#endif
+}
+
+void FileAccessWindows::_completion_thread_function(void *p_user) {
+
+#ifndef UWP_ENABLED
+	while (true) {
+		DWORD bytes = 0;
+		ULONG_PTR key = 0;
+		OVERLAPPED *overlapped = NULL;
+		BOOL ok = GetQueuedCompletionStatus((HANDLE)completion_port, &bytes, &key, &overlapped, INFINITE);
+		if (!overlapped) {
+			break; // Posted by finish_async_reads(), or the port is gone.
+		}
+
+		AsyncRead *read = (AsyncRead *)((uint8_t *)overlapped - offsetof(AsyncRead, backend_data));
+		_complete_async_read(read, ok ? int(bytes) : (GetLastError() == ERROR_HANDLE_EOF ? 0 : -1));
+	}
+#endif
+}
+
+Error FileAccessWindows::_read_async(AsyncRead *p_read) {
+
+#ifndef UWP_ENABLED
+	static_assert(sizeof(OVERLAPPED) <= sizeof(p_read->backend_data), "OVERLAPPED must fit in AsyncRead::backend_data");
+
+	// A second handle, the one behind the FILE can't do overlapped reads.
+	if (f && flags == READ && !async_handle && _start_completion_port()) {
+		HANDLE handle = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, NULL, OPEN_EXISTING, FILE_FLAG_OVERLAPPED, NULL);
+		if (handle != INVALID_HANDLE_VALUE) {
+			if (CreateIoCompletionPort(handle, (HANDLE)completion_port, 0, 0)) {
+				async_handle = handle;
+			} else {
+				CloseHandle(handle);
+			}
+		}
+	}
+
+	if (async_handle) {
+		OVERLAPPED *overlapped = (OVERLAPPED *)p_read->backend_data;
+		ZeroMemory(overlapped, sizeof(OVERLAPPED));
+		overlapped->Offset = DWORD(p_read->file_offset & 0xFFFFFFFF);
+		overlapped->OffsetHigh = DWORD(p_read->file_offset >> 32);
+
+		if (ReadFile((HANDLE)async_handle, p_read->dst, p_read->file_length, NULL, overlapped) || GetLastError() == ERROR_IO_PENDING) {
+			return OK; // Completed through the port, even when done right away.
+		}
+		_complete_async_read(p_read, GetLastError() == ERROR_HANDLE_EOF ? 0 : -1);
+		return OK;
+	}
+#endif
+
+	return FileAccess::_read_async(p_read);
+}
+
+bool FileAccessWindows::is_async_read_supported() const {
+
+#ifdef UWP_ENABLED
+	return false;
+#else
+	return f && flags == READ && completion_state != COMPLETION_PORT_UNAVAILABLE;
+#endif
+}
+
 void FileAccessWindows::flush() {
 
 	ERR_FAIL_COND(!f);
@@ -307,10 +407,28 @@ uint64_t FileAccessWindows::_get_modified_time(const String &p_file) {
 	}
 }
 
+void FileAccessWindows::finish_async_reads() {
+
+#ifndef UWP_ENABLED
+	if (!atomic_compare_exchange(&completion_state, (uint32_t)COMPLETION_PORT_READY, (uint32_t)COMPLETION_PORT_UNAVAILABLE)) {
+		return;
+	}
+
+	PostQueuedCompletionStatus((HANDLE)completion_port, 0, 0, NULL);
+	Thread::wait_to_finish(completion_thread);
+	memdelete(completion_thread);
+	completion_thread = NULL;
+
+	CloseHandle((HANDLE)completion_port);
+	completion_port = NULL;
+#endif
+}
+
 FileAccessWindows::FileAccessWindows() :
 		f(NULL),
 		flags(0),
-		last_error(OK) {
+		last_error(OK),
+		async_handle(NULL) {
 }
 FileAccessWindows::~FileAccessWindows() {
 
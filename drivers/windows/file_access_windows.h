@@ -52,6 +52,15 @@ class FileAccessWindows : public FileAccess {
 	String path_src;
 	String save_path;
 
+	void *async_handle; // Opened for overlapped reads with the first async read.
+
+	static void *completion_port;
+	static Thread *completion_thread;
+	static volatile uint32_t completion_state;
+
+	static bool _start_completion_port();
+	static void _completion_thread_function(void *p_user);
+
 public:
 	virtual Error _open(const String &p_path, int p_mode_flags); ///< open a file
 	virtual void close(); ///< close a file
@@ -69,6 +78,8 @@ public:
 
 	virtual uint8_t get_8() const; ///< get a byte
 	virtual int get_buffer(uint8_t *p_dst, int p_length) const;
+	virtual Error _read_async(AsyncRead *p_read);
+	virtual bool is_async_read_supported() const;
 
 	virtual Error get_error() const; ///< get last error
 
@@ -80,6 +91,8 @@ public:
 
 	uint64_t _get_modified_time(const String &p_file);
 
+	static void finish_async_reads();
+
 	FileAccessWindows();
 	virtual ~FileAccessWindows();
 };
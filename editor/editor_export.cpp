@@ -30,11 +30,16 @@
 
 #include "editor_export.h"
 
+#include "core/io/compression.h"
 #include "core/io/config_file.h"
+#include "core/io/file_access_compressed.h"
+#include "core/io/file_access_pack.h"
+#include "core/io/marshalls.h"
 #include "core/io/resource_loader.h"
 #include "core/io/resource_saver.h"
 #include "core/io/zip_io.h"
 #include "core/os/file_access.h"
+#include "core/os/threaded_array_processor.h"
 #include "core/project_settings.h"
 #include "core/script_language.h"
 #include "core/version.h"
@@ -57,6 +62,50 @@ static int _get_pad(int p_alignment, int p_n) {
 }
 
 #define PCK_PADDING 16
+#define PCK_COMPRESSION_BLOCK_SIZE 65536
+
+#define PCK_DICTIONARY_MAX_FILE_SIZE (64 * 1024)
+#define PCK_DICTIONARY_MAX_PENDING_BYTES (256 * 1024 * 1024)
+#define PCK_DICTIONARY_MIN_SAMPLES 8
+#define PCK_DICTIONARY_MIN_SIZE 1024
+#define PCK_DICTIONARY_MAX_SIZE (112 * 1024)
+
+//same layout FileAccessCompressed writes, so the pack reader can open it with open_after_magic()
+static Vector<uint8_t> _compress_pack_file(const Vector<uint8_t> &p_data, Compression::Mode p_mode, uint32_t p_zstd_dictionary) {
+
+	int total = p_data.size();
+	int block_count = (total / PCK_COMPRESSION_BLOCK_SIZE) + 1;
+	int header_size = p_zstd_dictionary ? 20 : 16;
+
+	Vector<uint8_t> out;
+	out.resize(header_size + block_count * 4);
+	uint8_t *w = out.ptrw();
+	copymem(w, "GCPF", 4);
+	if (p_zstd_dictionary) {
+		encode_uint32(p_mode | FileAccessCompressed::MODE_FLAG_ZSTD_DICTIONARY, &w[4]);
+		encode_uint32(p_zstd_dictionary, &w[8]);
+	} else {
+		encode_uint32(p_mode, &w[4]);
+	}
+	encode_uint32(PCK_COMPRESSION_BLOCK_SIZE, &w[header_size - 8]);
+	encode_uint32(total, &w[header_size - 4]);
+
+	Vector<uint8_t> cblock;
+	for (int i = 0; i < block_count; i++) {
+
+		int bl = i == (block_count - 1) ? total % PCK_COMPRESSION_BLOCK_SIZE : PCK_COMPRESSION_BLOCK_SIZE;
+		cblock.resize(Compression::get_max_compressed_buffer_size(bl, p_mode));
+		int cs = Compression::compress(cblock.ptrw(), &p_data.ptr()[i * PCK_COMPRESSION_BLOCK_SIZE], bl, p_mode, p_zstd_dictionary);
+
+		int ofs = out.size();
+		out.resize(ofs + cs);
+		w = out.ptrw();
+		encode_uint32(cs, &w[header_size + i * 4]);
+		copymem(&w[ofs], cblock.ptr(), cs);
+	}
+
+	return out;
+}
 
 bool EditorExportPreset::_set(const StringName &p_name, const Variant &p_value) {
 
@@ -307,34 +356,188 @@ void EditorExportPlatform::gen_debug_flags(Vector<String> &r_flags, int p_flags)
 	}
 }
 
+#define PCK_BATCH_MAX_FILES 256
+#define PCK_BATCH_MAX_BYTES (64 * 1024 * 1024)
+
+void EditorExportPlatform::PackData::process_pending(uint32_t p_index, void *p_userdata) {
+
+	PendingPackFile &pf = pending.write[p_index];
+
+	MD5_CTX ctx;
+	MD5Init(&ctx);
+	MD5Update(&ctx, (unsigned char *)pf.data.ptr(), pf.data.size());
+	MD5Final(&ctx);
+	pf.sd.md5.resize(16);
+	for (int i = 0; i < 16; i++) {
+		pf.sd.md5.write[i] = ctx.digest[i];
+	}
+
+	if (compression > 0) {
+		pf.cdata = _compress_pack_file(pf.data, compression == 1 ? Compression::MODE_FASTLZ : Compression::MODE_ZSTD, pf.zstd_dictionary);
+		//not worth inflating on every load if it barely shrinks, as with already compressed media
+		pf.sd.compressed = pf.cdata.size() <= pf.data.size() - pf.data.size() / 8;
+	}
+}
+
+void EditorExportPlatform::_flush_pack_files(PackData *p_pd) {
+
+	if (p_pd->pending.empty())
+		return;
+
+	thread_process_array(p_pd->pending.size(), p_pd, &PackData::process_pending, (void *)NULL);
+
+	for (int i = 0; i < p_pd->pending.size(); i++) {
+
+		PendingPackFile &pf = p_pd->pending.write[i];
+		SavedData &sd = pf.sd;
+
+		String key = String::md5(sd.md5.ptr()) + "_" + itos(pf.data.size());
+		Map<String, int>::Element *E = p_pd->stored_content.find(key);
+		if (E) {
+			//same content already in the pack, point at it instead of storing it again
+			const SavedData &stored = p_pd->file_ofs[E->get()];
+			sd.ofs = stored.ofs;
+			sd.size = stored.size;
+			sd.compressed = stored.compressed;
+			p_pd->file_ofs.push_back(sd);
+			p_pd->deduplicated++;
+			continue;
+		}
+
+		sd.ofs = p_pd->f->get_position();
+		if (sd.compressed) {
+			sd.size = pf.cdata.size();
+			p_pd->f->store_buffer(pf.cdata.ptr(), pf.cdata.size());
+		} else {
+			sd.size = pf.data.size();
+			p_pd->f->store_buffer(pf.data.ptr(), pf.data.size());
+		}
+		int pad = _get_pad(PCK_PADDING, sd.size);
+		for (int j = 0; j < pad; j++) {
+			p_pd->f->store_8(0);
+		}
+
+		p_pd->stored_content[key] = p_pd->file_ofs.size();
+		p_pd->file_ofs.push_back(sd);
+	}
+
+	p_pd->pending.clear();
+	p_pd->pending_bytes = 0;
+}
+
+void EditorExportPlatform::_flush_dictionary_files(PackData *p_pd) {
+
+	if (p_pd->dictionary_files.empty())
+		return;
+
+	//files of one resource type share most of their structure, the extension tells the type apart
+	Map<String, Vector<int> > by_type;
+	for (int i = 0; i < p_pd->dictionary_files.size(); i++) {
+		String path = String::utf8(p_pd->dictionary_files[i].sd.path_utf8.get_data());
+		by_type[path.get_extension().to_lower()].push_back(i);
+	}
+
+	Vector<uint8_t> dictionaries;
+	dictionaries.resize(4);
+	uint32_t dictionary_count = 0;
+
+	for (Map<String, Vector<int> >::Element *E = by_type.front(); E; E = E->next()) {
+
+		const Vector<int> &files = E->get();
+		if (files.size() < PCK_DICTIONARY_MIN_SAMPLES)
+			continue;
+
+		Vector<Vector<uint8_t> > samples;
+		int total = 0;
+		for (int i = 0; i < files.size(); i++) {
+			samples.push_back(p_pd->dictionary_files[files[i]].data);
+			total += samples[i].size();
+		}
+
+		//a dictionary much bigger than a fraction of what it's trained on only learns noise
+		int max_size = MIN(PCK_DICTIONARY_MAX_SIZE, total / 8);
+		if (max_size < PCK_DICTIONARY_MIN_SIZE)
+			continue;
+
+		Vector<uint8_t> dictionary = Compression::train_zstd_dictionary(samples, max_size);
+		if (dictionary.empty())
+			continue;
+
+		uint32_t id = Compression::get_zstd_dictionary_id(dictionary);
+		Compression::add_zstd_dictionary(id, dictionary);
+		p_pd->dictionary_ids.push_back(id);
+
+		for (int i = 0; i < files.size(); i++) {
+			p_pd->dictionary_files.write[files[i]].zstd_dictionary = id;
+		}
+
+		int ofs = dictionaries.size();
+		dictionaries.resize(ofs + 8 + dictionary.size());
+		encode_uint32(id, &dictionaries.write[ofs]);
+		encode_uint32(dictionary.size(), &dictionaries.write[ofs + 4]);
+		copymem(&dictionaries.write[ofs + 8], dictionary.ptr(), dictionary.size());
+		dictionary_count++;
+
+		print_verbose("Export: trained a " + itos(dictionary.size()) + " bytes dictionary for " + itos(files.size()) + " '" + E->key() + "' files.");
+	}
+
+	for (int i = 0; i < p_pd->dictionary_files.size(); i++) {
+
+		p_pd->pending.push_back(p_pd->dictionary_files[i]);
+		p_pd->pending_bytes += p_pd->dictionary_files[i].data.size();
+
+		if (p_pd->pending.size() >= PCK_BATCH_MAX_FILES || p_pd->pending_bytes >= PCK_BATCH_MAX_BYTES) {
+			_flush_pack_files(p_pd);
+		}
+	}
+	p_pd->dictionary_files.clear();
+	p_pd->dictionary_bytes = 0;
+
+	if (dictionary_count > 0) {
+
+		encode_uint32(dictionary_count, dictionaries.ptrw());
+
+		PendingPackFile pf;
+		pf.data = dictionaries;
+		pf.zstd_dictionary = 0; //read before any dictionary is known
+		pf.sd.path_utf8 = String(PACK_ZSTD_DICTIONARIES_PATH).utf8();
+		pf.sd.path_md5 = String(PACK_ZSTD_DICTIONARIES_PATH).md5_buffer();
+		pf.sd.ofs = 0;
+		pf.sd.size = dictionaries.size();
+		pf.sd.compressed = false;
+		p_pd->pending.push_back(pf);
+		p_pd->pending_bytes += dictionaries.size();
+	}
+
+	_flush_pack_files(p_pd);
+}
+
 Error EditorExportPlatform::_save_pack_file(void *p_userdata, const String &p_path, const Vector<uint8_t> &p_data, int p_file, int p_total) {
 
 	PackData *pd = (PackData *)p_userdata;
 
-	SavedData sd;
-	sd.path_utf8 = p_path.utf8();
-	sd.ofs = pd->f->get_position();
-	sd.size = p_data.size();
-
-	pd->f->store_buffer(p_data.ptr(), p_data.size());
-	int pad = _get_pad(PCK_PADDING, sd.size);
-	for (int i = 0; i < pad; i++) {
-		pd->f->store_8(0);
-	}
-
-	{
-		MD5_CTX ctx;
-		MD5Init(&ctx);
-		MD5Update(&ctx, (unsigned char *)p_data.ptr(), p_data.size());
-		MD5Final(&ctx);
-		sd.md5.resize(16);
-		for (int i = 0; i < 16; i++) {
-			sd.md5.write[i] = ctx.digest[i];
+	PendingPackFile pf;
+	pf.data = p_data;
+	pf.sd.path_utf8 = p_path.utf8();
+	pf.sd.path_md5 = p_path.md5_buffer();
+	pf.sd.ofs = 0;
+	pf.sd.size = p_data.size();
+	pf.sd.compressed = false;
+	pf.zstd_dictionary = 0;
+
+	if (pd->train_dictionaries && p_data.size() <= PCK_DICTIONARY_MAX_FILE_SIZE && pd->dictionary_bytes + p_data.size() <= PCK_DICTIONARY_MAX_PENDING_BYTES) {
+		//small files compress poorly on their own, these are compressed last with a dictionary
+		pd->dictionary_files.push_back(pf);
+		pd->dictionary_bytes += p_data.size();
+	} else {
+		pd->pending.push_back(pf);
+		pd->pending_bytes += p_data.size();
+
+		if (pd->pending.size() >= PCK_BATCH_MAX_FILES || pd->pending_bytes >= PCK_BATCH_MAX_BYTES) {
+			_flush_pack_files(pd);
 		}
 	}
 
-	pd->file_ofs.push_back(sd);
-
 	pd->ep->step(TTR("Storing File:") + " " + p_path, 2 + p_file * 100 / p_total, false);
 
 	return OK;
@@ -767,6 +970,18 @@ Error EditorExportPlatform::export_project_files(const Ref<EditorExportPreset> &
 				}
 			}
 
+			//files the importer generated inside the import folder are read at runtime too (e.g. streamed audio)
+			if (config->has_section_key("deps", "files")) {
+				Array gen_files = config->get_value("deps", "files");
+				for (int j = 0; j < gen_files.size(); j++) {
+					String gen_file = gen_files[j];
+					if (gen_file.begins_with("res://.import/")) {
+						Vector<uint8_t> array = FileAccess::get_file_as_array(gen_file);
+						p_func(p_udata, gen_file, array, idx, total);
+					}
+				}
+			}
+
 			//also save the .import file
 			Vector<uint8_t> array = FileAccess::get_file_as_array(path + ".import");
 			p_func(p_udata, path + ".import", array, idx, total);
@@ -894,20 +1109,36 @@ Error EditorExportPlatform::save_pack(const Ref<EditorExportPreset> &p_preset, c
 	pd.ep = &ep;
 	pd.f = ftmp;
 	pd.so_files = p_so_files;
+	pd.compression = ProjectSettings::get_singleton()->get("editor/compress_pck_files_on_export");
+	pd.pending_bytes = 0;
+	pd.deduplicated = 0;
+	pd.train_dictionaries = pd.compression == 2 && bool(ProjectSettings::get_singleton()->get("editor/zstd_dictionaries_on_export"));
+	pd.dictionary_bytes = 0;
 
 	Error err = export_project_files(p_preset, _save_pack_file, &pd, _add_shared_object);
+	if (err == OK) {
+		_flush_pack_files(&pd);
+		_flush_dictionary_files(&pd);
+		if (pd.deduplicated > 0) {
+			print_verbose("Export: stored " + itos(pd.deduplicated) + " duplicate files in the pack only once.");
+		}
+	}
+
+	for (int i = 0; i < pd.dictionary_ids.size(); i++) {
+		Compression::remove_zstd_dictionary(pd.dictionary_ids[i]);
+	}
 
 	memdelete(ftmp); //close tmp file
 
 	if (err)
 		return err;
 
-	pd.file_ofs.sort(); //do sort, so we can do binary search later
+	pd.file_ofs.sort(); //sorted by path MD5, so the runtime can binary search the mapped directory
 
 	FileAccess *f = FileAccess::open(p_path, FileAccess::WRITE);
 	ERR_FAIL_COND_V(!f, ERR_CANT_CREATE)
 	f->store_32(0x43504447); //GDPK
-	f->store_32(1); //pack version
+	f->store_32(PACK_FORMAT_VERSION); //pack version
 	f->store_32(VERSION_MAJOR);
 	f->store_32(VERSION_MINOR);
 	f->store_32(0); //hmph
@@ -918,35 +1149,37 @@ Error EditorExportPlatform::save_pack(const Ref<EditorExportPreset> &p_preset, c
 
 	f->store_32(pd.file_ofs.size()); //amount of files
 
-	size_t header_size = f->get_position();
-
-	//precalculate header size
-
+	uint32_t paths_size = 0;
 	for (int i = 0; i < pd.file_ofs.size(); i++) {
-		header_size += 4; // size of path string (32 bits is enough)
-		uint32_t string_len = pd.file_ofs[i].path_utf8.length();
-		header_size += string_len + _get_pad(4, string_len); ///size of path string
-		header_size += 8; // offset to file _with_ header size included
-		header_size += 8; // size of file
-		header_size += 16; // md5
+		paths_size += pd.file_ofs[i].path_utf8.length();
 	}
 
+	f->store_32(paths_size);
+
+	//directory entries and path strings have a fixed size, so the header size is known upfront
+	size_t header_size = f->get_position() + pd.file_ofs.size() * PACK_INDEX_ENTRY_SIZE + paths_size;
 	size_t header_padding = _get_pad(PCK_PADDING, header_size);
 
+	uint32_t path_ofs = 0;
 	for (int i = 0; i < pd.file_ofs.size(); i++) {
 
-		uint32_t string_len = pd.file_ofs[i].path_utf8.length();
-		uint32_t pad = _get_pad(4, string_len);
-		;
-		f->store_32(string_len + pad);
-		f->store_buffer((const uint8_t *)pd.file_ofs[i].path_utf8.get_data(), string_len);
-		for (uint32_t j = 0; j < pad; j++) {
-			f->store_8(0);
-		}
+		const SavedData &sd = pd.file_ofs[i];
+		uint32_t string_len = sd.path_utf8.length();
 
-		f->store_64(pd.file_ofs[i].ofs + header_padding + header_size);
-		f->store_64(pd.file_ofs[i].size); // pay attention here, this is where file is
-		f->store_buffer(pd.file_ofs[i].md5.ptr(), 16); //also save md5 for file
+		f->store_buffer(sd.path_md5.ptr(), 16);
+		f->store_64(sd.ofs + header_padding + header_size); // offset to file _with_ header size included
+		f->store_64(sd.size); // pay attention here, this is where file is
+		f->store_32(sd.compressed ? PackedData::PACK_FILE_COMPRESSED : 0);
+		f->store_32(path_ofs);
+		f->store_32(string_len);
+		f->store_32(0); // reserved
+		f->store_buffer(sd.md5.ptr(), 16); //also save md5 for file
+
+		path_ofs += string_len;
+	}
+
+	for (int i = 0; i < pd.file_ofs.size(); i++) {
+		f->store_buffer((const uint8_t *)pd.file_ofs[i].path_utf8.get_data(), pd.file_ofs[i].path_utf8.length());
 	}
 
 	for (uint32_t j = 0; j < header_padding; j++) {
@@ -1339,6 +1572,10 @@ bool EditorExport::poll_export_platforms() {
 
 EditorExport::EditorExport() {
 
+	GLOBAL_DEF("editor/compress_pck_files_on_export", 0);
+	ProjectSettings::get_singleton()->set_custom_property_info("editor/compress_pck_files_on_export", PropertyInfo(Variant::INT, "editor/compress_pck_files_on_export", PROPERTY_HINT_ENUM, "Disabled,FastLZ,Zstd"));
+	GLOBAL_DEF("editor/zstd_dictionaries_on_export", true);
+
 	save_timer = memnew(Timer);
 	add_child(save_timer);
 	save_timer->set_wait_time(0.8);
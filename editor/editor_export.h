@@ -163,20 +163,45 @@ private:
 
 		uint64_t ofs;
 		uint64_t size;
+		bool compressed;
 		Vector<uint8_t> md5;
+		Vector<uint8_t> path_md5;
 		CharString path_utf8;
 
 		bool operator<(const SavedData &p_data) const {
-			return path_utf8 < p_data.path_utf8;
+			return memcmp(path_md5.ptr(), p_data.path_md5.ptr(), 16) < 0;
 		}
 	};
 
+	//files are hashed and compressed in batches on several threads, then written in order
+	struct PendingPackFile {
+
+		Vector<uint8_t> data;
+		Vector<uint8_t> cdata;
+		uint32_t zstd_dictionary;
+		SavedData sd;
+	};
+
 	struct PackData {
 
 		FileAccess *f;
 		Vector<SavedData> file_ofs;
 		EditorProgress *ep;
 		Vector<SharedObject> *so_files;
+		int compression;
+
+		Vector<PendingPackFile> pending;
+		uint64_t pending_bytes;
+		Map<String, int> stored_content; //content key to file_ofs index, so identical files are stored once
+		int deduplicated;
+
+		//small files wait until the end, to be compressed with a dictionary trained on the files of their type
+		bool train_dictionaries;
+		Vector<PendingPackFile> dictionary_files;
+		uint64_t dictionary_bytes;
+		Vector<uint32_t> dictionary_ids;
+
+		void process_pending(uint32_t p_index, void *p_userdata);
 	};
 
 	struct ZipData {
@@ -195,6 +220,8 @@ private:
 
 	void gen_debug_flags(Vector<String> &r_flags, int p_flags);
 	static Error _save_pack_file(void *p_userdata, const String &p_path, const Vector<uint8_t> &p_data, int p_file, int p_total);
+	static void _flush_pack_files(PackData *p_pd);
+	static void _flush_dictionary_files(PackData *p_pd);
 	static Error _save_zip_file(void *p_userdata, const String &p_path, const Vector<uint8_t> &p_data, int p_file, int p_total);
 
 	void _edit_files_with_filter(DirAccess *da, const Vector<String> &p_filters, Set<String> &r_list, bool exclude);
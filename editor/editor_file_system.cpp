@@ -35,15 +35,18 @@
 #include "core/io/resource_saver.h"
 #include "core/os/file_access.h"
 #include "core/os/os.h"
+#include "core/os/thread_work_pool.h"
 #include "core/project_settings.h"
+#include "core/safe_refcount.h"
 #include "core/variant_parser.h"
+#include "core/version.h"
 #include "editor_node.h"
 #include "editor_resource_preview.h"
 #include "editor_settings.h"
 
 EditorFileSystem *EditorFileSystem::singleton = NULL;
 //the name is the version, to keep compatibility with different versions of Godot
-#define CACHE_FILE_NAME "filesystem_cache5"
+#define CACHE_FILE_NAME "filesystem_cache6"
 
 void EditorFileSystemDirectory::sort_files() {
 
@@ -241,7 +244,7 @@ void EditorFileSystem::_scan_filesystem() {
 
 			} else {
 				Vector<String> split = l.split("::");
-				ERR_CONTINUE(split.size() != 7);
+				ERR_CONTINUE(split.size() != 8);
 				String name = split[0];
 				String file;
 
@@ -266,6 +269,11 @@ void EditorFileSystem::_scan_filesystem() {
 					}
 				}
 
+				String dest_paths = split[7].strip_edges();
+				if (dest_paths.length()) {
+					fc.import_dest_paths = dest_paths.split("<>");
+				}
+
 				file_cache[name] = fc;
 			}
 		}
@@ -337,7 +345,26 @@ void EditorFileSystem::_thread_func(void *_userdata) {
 	sd->_scan_filesystem();
 }
 
-bool EditorFileSystem::_test_for_reimport(const String &p_path, bool p_only_imported_files) {
+bool EditorFileSystem::_test_for_reimport_cached(const String &p_path, Vector<String> &r_import_dest_paths, bool p_settings_changed) {
+
+	if (!reimport_on_missing_imported_files)
+		return false;
+
+	if (r_import_dest_paths.size() && !p_settings_changed) {
+		//.import file is unchanged since these were read from it, so only check they are still there
+		for (int i = 0; i < r_import_dest_paths.size(); i++) {
+			if (!FileAccess::exists(r_import_dest_paths[i])) {
+				return true;
+			}
+		}
+		return false;
+	}
+
+	r_import_dest_paths.clear();
+	return _test_for_reimport(p_path, true, &r_import_dest_paths);
+}
+
+bool EditorFileSystem::_test_for_reimport(const String &p_path, bool p_only_imported_files, Vector<String> *r_checked_paths) {
 
 	if (!reimport_on_missing_imported_files && p_only_imported_files)
 		return false;
@@ -480,6 +507,13 @@ bool EditorFileSystem::_test_for_reimport(const String &p_path, bool p_only_impo
 		}
 	}
 
+	if (r_checked_paths) {
+		for (List<String>::Element *E = to_check.front(); E; E = E->next()) {
+			r_checked_paths->push_back(E->get());
+		}
+		r_checked_paths->push_back(base_path + ".md5");
+	}
+
 	return false; //nothing changed
 }
 
@@ -558,7 +592,8 @@ bool EditorFileSystem::_update_scan_actions() {
 				int idx = ia.dir->find_file_index(ia.file);
 				ERR_CONTINUE(idx == -1);
 				String full_path = ia.dir->get_file_path(idx);
-				if (_test_for_reimport(full_path, false)) {
+				ia.dir->files[idx]->import_dest_paths.clear();
+				if (_test_for_reimport(full_path, false, &ia.dir->files[idx]->import_dest_paths)) {
 					//must reimport
 					reimports.push_back(full_path);
 				} else {
@@ -762,10 +797,11 @@ void EditorFileSystem::_scan_new_dir(EditorFileSystemDirectory *p_dir, DirAccess
 				import_mt = FileAccess::get_modified_time(path + ".import");
 			}
 
-			if (fc && fc->modification_time == mt && fc->import_modification_time == import_mt && !_test_for_reimport(path, true)) {
+			if (fc && fc->modification_time == mt && fc->import_modification_time == import_mt && !_test_for_reimport_cached(path, fc->import_dest_paths, false)) {
 
 				fi->type = fc->type;
 				fi->deps = fc->deps;
+				fi->import_dest_paths = fc->import_dest_paths;
 				fi->modified_time = fc->modification_time;
 				fi->import_modified_time = fc->import_modification_time;
 
@@ -977,7 +1013,7 @@ void EditorFileSystem::_scan_fs_changes(EditorFileSystemDirectory *p_dir, const
 				uint64_t import_mt = FileAccess::get_modified_time(path + ".import");
 				if (import_mt != p_dir->files[i]->import_modified_time) {
 					reimport = true;
-				} else if (_test_for_reimport(path, true)) {
+				} else if (_test_for_reimport_cached(path, p_dir->files[i]->import_dest_paths, import_settings_changed)) {
 					reimport = true;
 				}
 			}
@@ -1061,6 +1097,8 @@ void EditorFileSystem::scan_changes() {
 	_update_extensions();
 	sources_changed.clear();
 	scanning_changes = true;
+	//importer settings changed since the last scan, cached import paths may no longer be valid
+	import_settings_changed = ResourceFormatImporter::get_singleton()->get_import_settings_hash() != filesystem_settings_version_for_import;
 	scanning_changes_done = false;
 
 	abort_scan = false;
@@ -1195,6 +1233,13 @@ void EditorFileSystem::_save_filesystem_cache(EditorFileSystemDirectory *p_dir,
 				s += "<>";
 			s += p_dir->files[i]->deps[j];
 		}
+		s += "::";
+		for (int j = 0; j < p_dir->files[i]->import_dest_paths.size(); j++) {
+
+			if (j > 0)
+				s += "<>";
+			s += p_dir->files[i]->import_dest_paths[j];
+		}
 
 		p_file->store_line(s);
 	}
@@ -1534,16 +1579,16 @@ void EditorFileSystem::update_file(const String &p_file) {
 	_queue_update_script_classes();
 }
 
-void EditorFileSystem::_reimport_file(const String &p_file) {
+bool EditorFileSystem::_reimport_prepare(const String &p_file, ReimportTask &r_task) {
 
 	EditorFileSystemDirectory *fs = NULL;
 	int cpos = -1;
 	bool found = _find_file(p_file, &fs, cpos);
-	ERR_FAIL_COND(!found);
+	ERR_FAIL_COND_V(!found, false);
 
 	//try to obtain existing params
 
-	Map<StringName, Variant> params;
+	Map<StringName, Variant> &params = r_task.params;
 	String importer_name;
 
 	if (FileAccess::exists(p_file + ".import")) {
@@ -1581,13 +1626,13 @@ void EditorFileSystem::_reimport_file(const String &p_file) {
 		load_default = true;
 		if (importer.is_null()) {
 			ERR_PRINT("BUG: File queued for import, but can't be imported!");
-			ERR_FAIL();
+			ERR_FAIL_V(false);
 		}
 	}
 
 	//mix with default params, in case a parameter is missing
 
-	List<ResourceImporter::ImportOption> opts;
+	List<ResourceImporter::ImportOption> &opts = r_task.options;
 	importer->get_import_options(&opts);
 	for (List<ResourceImporter::ImportOption>::Element *E = opts.front(); E; E = E->next()) {
 		if (!params.has(E->get().option.name)) { //this one is not present
@@ -1606,21 +1651,177 @@ void EditorFileSystem::_reimport_file(const String &p_file) {
 		}
 	}
 
+	r_task.path = p_file;
+	r_task.importer = importer;
+	r_task.base_path = ResourceFormatImporter::get_singleton()->get_import_base_path(p_file);
+	r_task.err = OK;
+
+	return true;
+}
+
+String EditorFileSystem::_get_import_cache_key(const ReimportTask &p_task) const {
+
+	String key = FileAccess::get_md5(p_task.path);
+	key += "|" + p_task.importer->get_importer_name();
+	key += "|" + p_task.importer->get_import_settings_string();
+	key += "|" VERSION_FULL_CONFIG;
+
+	for (const List<ResourceImporter::ImportOption>::Element *E = p_task.options.front(); E; E = E->next()) {
+
+		String value;
+		VariantWriter::write_to_string(p_task.params[E->get().option.name], value);
+		key += "|" + E->get().option.name + "=" + value;
+	}
+
+	return key.md5_text();
+}
+
+bool EditorFileSystem::_import_cache_fetch(const String &p_key, ReimportTask &p_task) {
+
+	String entry_dir = import_cache_dir.plus_file(p_key);
+
+	Ref<ConfigFile> cf;
+	cf.instance();
+	if (cf->load(entry_dir.plus_file("entry.cfg")) != OK) {
+		return false;
+	}
+
+	String ext = p_task.importer->get_save_extension();
+	PoolStringArray variants = cf->get_value("entry", "variants", PoolStringArray());
+
+	DirAccess *da = DirAccess::create(DirAccess::ACCESS_FILESYSTEM);
+	bool ok = true;
+
+	if (variants.size() == 0) {
+		ok = da->copy(entry_dir.plus_file("_." + ext), ProjectSettings::get_singleton()->globalize_path(p_task.base_path + "." + ext)) == OK;
+	}
+
+	for (int i = 0; i < variants.size() && ok; i++) {
+		ok = da->copy(entry_dir.plus_file(variants[i] + "." + ext), ProjectSettings::get_singleton()->globalize_path(p_task.base_path + "." + variants[i] + "." + ext)) == OK;
+	}
+
+	memdelete(da);
+
+	if (!ok) {
+		return false;
+	}
+
+	p_task.import_variants.clear();
+	for (int i = 0; i < variants.size(); i++) {
+		p_task.import_variants.push_back(variants[i]);
+	}
+	p_task.metadata = cf->get_value("entry", "metadata", Variant());
+	p_task.err = OK;
+
+	return true;
+}
+
+void EditorFileSystem::_import_cache_store(const String &p_key, const ReimportTask &p_task) {
+
+	if (p_task.err != OK || p_task.gen_files.size()) {
+		return; //results spread over other files can't be restored from the cache
+	}
+
+	String entry_dir = import_cache_dir.plus_file(p_key);
+	//entries are written under a temporary name and renamed, so other editors never see them half written
+	String temp_dir = entry_dir + ".tmp" + itos(OS::get_singleton()->get_process_id()) + "_" + itos(Thread::get_caller_id());
+	String ext = p_task.importer->get_save_extension();
+
+	DirAccess *da = DirAccess::create(DirAccess::ACCESS_FILESYSTEM);
+	if (da->dir_exists(entry_dir) || da->make_dir_recursive(temp_dir) != OK) {
+		memdelete(da);
+		return;
+	}
+
+	Vector<String> copied;
+	bool ok = true;
+	PoolStringArray variants;
+
+	if (p_task.import_variants.size() == 0) {
+		copied.push_back(temp_dir.plus_file("_." + ext));
+		ok = da->copy(ProjectSettings::get_singleton()->globalize_path(p_task.base_path + "." + ext), copied[0]) == OK;
+	}
+
+	for (const List<String>::Element *E = p_task.import_variants.front(); E && ok; E = E->next()) {
+		copied.push_back(temp_dir.plus_file(E->get() + "." + ext));
+		ok = da->copy(ProjectSettings::get_singleton()->globalize_path(p_task.base_path + "." + E->get() + "." + ext), copied[copied.size() - 1]) == OK;
+		variants.push_back(E->get());
+	}
+
+	if (ok) {
+		Ref<ConfigFile> cf;
+		cf.instance();
+		cf->set_value("entry", "source_file", p_task.path);
+		cf->set_value("entry", "variants", variants);
+		if (p_task.metadata != Variant()) {
+			cf->set_value("entry", "metadata", p_task.metadata);
+		}
+		copied.push_back(temp_dir.plus_file("entry.cfg"));
+		ok = cf->save(copied[copied.size() - 1]) == OK;
+	}
+
+	if (!ok || da->rename(temp_dir, entry_dir) != OK) {
+		//failed, or another editor stored the same entry first
+		for (int i = 0; i < copied.size(); i++) {
+			da->remove(copied[i]);
+		}
+		da->remove(temp_dir);
+	}
+
+	memdelete(da);
+}
+
+void EditorFileSystem::_reimport_import(ReimportTask &p_task) {
+
+	//importers that only produce their own output files can share results through the import cache
+	bool use_cache = import_cache_dir != String() && p_task.importer->can_import_threaded() && p_task.importer->get_save_extension() != String();
+	String cache_key;
+
+	if (use_cache) {
+		cache_key = _get_import_cache_key(p_task);
+		if (_import_cache_fetch(cache_key, p_task)) {
+			atomic_increment(&import_cache_hits);
+			return;
+		}
+		atomic_increment(&import_cache_misses);
+	}
+
 	//finally, perform import!!
-	String base_path = ResourceFormatImporter::get_singleton()->get_import_base_path(p_file);
+	p_task.err = p_task.importer->import(p_task.path, p_task.base_path, p_task.params, &p_task.import_variants, &p_task.gen_files, &p_task.metadata);
 
-	List<String> import_variants;
-	List<String> gen_files;
-	Variant metadata;
-	Error err = importer->import(p_file, base_path, params, &import_variants, &gen_files, &metadata);
+	if (use_cache) {
+		_import_cache_store(cache_key, p_task);
+	}
+}
+
+void EditorFileSystem::_reimport_import_threaded(uint32_t p_index, ReimportTask *p_tasks) {
+
+	_reimport_import(p_tasks[p_index]);
+}
+
+void EditorFileSystem::_reimport_finish(const ReimportTask &p_task) {
+
+	const String &file = p_task.path;
+	const Ref<ResourceImporter> &importer = p_task.importer;
+	const String &base_path = p_task.base_path;
+	const List<String> &import_variants = p_task.import_variants;
+	const List<String> &gen_files = p_task.gen_files;
+	const List<ResourceImporter::ImportOption> &opts = p_task.options;
+	const Map<StringName, Variant> &params = p_task.params;
+	Error err = p_task.err;
 
 	if (err != OK) {
-		ERR_PRINTS("Error importing: " + p_file);
+		ERR_PRINTS("Error importing: " + file);
 	}
 
+	EditorFileSystemDirectory *fs = NULL;
+	int cpos = -1;
+	bool found = _find_file(file, &fs, cpos);
+	ERR_FAIL_COND(!found);
+
 	//as import is complete, save the .import file
 
-	FileAccess *f = FileAccess::open(p_file + ".import", FileAccess::WRITE);
+	FileAccess *f = FileAccess::open(file + ".import", FileAccess::WRITE);
 	ERR_FAIL_COND(!f);
 
 	//write manually, as order matters ([remap] has to go first for performance).
@@ -1639,7 +1840,7 @@ void EditorFileSystem::_reimport_file(const String &p_file) {
 			//no path
 		} else if (import_variants.size()) {
 			//import with variants
-			for (List<String>::Element *E = import_variants.front(); E; E = E->next()) {
+			for (const List<String>::Element *E = import_variants.front(); E; E = E->next()) {
 
 				String path = base_path.c_escape() + "." + E->get() + "." + importer->get_save_extension();
 
@@ -1657,8 +1858,8 @@ void EditorFileSystem::_reimport_file(const String &p_file) {
 		f->store_line("valid=false");
 	}
 
-	if (metadata != Variant()) {
-		f->store_line("metadata=" + metadata.get_construct_string());
+	if (p_task.metadata != Variant()) {
+		f->store_line("metadata=" + p_task.metadata.get_construct_string());
 	}
 
 	f->store_line("");
@@ -1667,7 +1868,7 @@ void EditorFileSystem::_reimport_file(const String &p_file) {
 
 	if (gen_files.size()) {
 		Array genf;
-		for (List<String>::Element *E = gen_files.front(); E; E = E->next()) {
+		for (const List<String>::Element *E = gen_files.front(); E; E = E->next()) {
 			genf.push_back(E->get());
 			dest_paths.push_back(E->get());
 		}
@@ -1678,7 +1879,7 @@ void EditorFileSystem::_reimport_file(const String &p_file) {
 		f->store_line("");
 	}
 
-	f->store_line("source_file=" + Variant(p_file).get_construct_string());
+	f->store_line("source_file=" + Variant(file).get_construct_string());
 
 	if (dest_paths.size()) {
 		Array dp;
@@ -1693,7 +1894,7 @@ void EditorFileSystem::_reimport_file(const String &p_file) {
 
 	//store options in provided order, to avoid file changing. Order is also important because first match is accepted first.
 
-	for (List<ResourceImporter::ImportOption>::Element *E = opts.front(); E; E = E->next()) {
+	for (const List<ResourceImporter::ImportOption>::Element *E = opts.front(); E; E = E->next()) {
 
 		String base = E->get().option.name;
 		String value;
@@ -1707,7 +1908,7 @@ void EditorFileSystem::_reimport_file(const String &p_file) {
 	// Store the md5's of the various files. These are stored separately so that the .import files can be version controlled.
 	FileAccess *md5s = FileAccess::open(base_path + ".md5", FileAccess::WRITE);
 	ERR_FAIL_COND(!md5s);
-	md5s->store_line("source_md5=\"" + FileAccess::get_md5(p_file) + "\"");
+	md5s->store_line("source_md5=\"" + FileAccess::get_md5(file) + "\"");
 	if (dest_paths.size()) {
 		md5s->store_line("dest_md5=\"" + FileAccess::get_multiple_md5(dest_paths) + "\"\n");
 	}
@@ -1715,27 +1916,28 @@ void EditorFileSystem::_reimport_file(const String &p_file) {
 	memdelete(md5s);
 
 	//update modified times, to avoid reimport
-	fs->files[cpos]->modified_time = FileAccess::get_modified_time(p_file);
-	fs->files[cpos]->import_modified_time = FileAccess::get_modified_time(p_file + ".import");
-	fs->files[cpos]->deps = _get_dependencies(p_file);
+	fs->files[cpos]->modified_time = FileAccess::get_modified_time(file);
+	fs->files[cpos]->import_modified_time = FileAccess::get_modified_time(file + ".import");
+	fs->files[cpos]->import_dest_paths.clear(); //read again on the next scan
+	fs->files[cpos]->deps = _get_dependencies(file);
 	fs->files[cpos]->type = importer->get_resource_type();
-	fs->files[cpos]->import_valid = ResourceLoader::is_import_valid(p_file);
+	fs->files[cpos]->import_valid = ResourceLoader::is_import_valid(file);
 
 	//if file is currently up, maybe the source it was loaded from changed, so import math must be updated for it
 	//to reload properly
-	if (ResourceCache::has(p_file)) {
+	if (ResourceCache::has(file)) {
 
-		Resource *r = ResourceCache::get(p_file);
+		Resource *r = ResourceCache::get(file);
 
 		if (r->get_import_path() != String()) {
 
-			String dst_path = ResourceFormatImporter::get_singleton()->get_internal_resource_path(p_file);
+			String dst_path = ResourceFormatImporter::get_singleton()->get_internal_resource_path(file);
 			r->set_import_path(dst_path);
 			r->set_import_last_modified_time(0);
 		}
 	}
 
-	EditorResourcePreview::get_singleton()->check_for_invalidation(p_file);
+	EditorResourcePreview::get_singleton()->check_for_invalidation(file);
 }
 
 void EditorFileSystem::reimport_files(const Vector<String> &p_files) {
@@ -1767,10 +1969,68 @@ void EditorFileSystem::reimport_files(const Vector<String> &p_files) {
 
 	files.sort();
 
-	for (int i = 0; i < files.size(); i++) {
-		pr.step(files[i].path.get_file(), i);
+	ThreadWorkPool import_pool;
+	if (EditorSettings::get_singleton()->get("filesystem/import/use_multiple_threads")) {
+		import_pool.init();
+	}
+
+	import_cache_dir = EditorSettings::get_singleton()->get("filesystem/import/shared_cache_path");
+	import_cache_hits = 0;
+	import_cache_misses = 0;
+
+	//threaded imports are finished in batches, so progress can be reported between them
+	int batch_size = (import_pool.get_thread_count() + 1) * 4;
+	int step = 0;
+
+	int from = 0;
+	while (from < files.size()) {
+
+		//files with the same import order do not depend on each other, later orders (like scenes) wait for them
+		int to = from + 1;
+		while (to < files.size() && files[to].order == files[from].order) {
+			to++;
+		}
+
+		Vector<ReimportTask> threaded_tasks;
+
+		for (int i = from; i < to; i++) {
+
+			ReimportTask task;
+			if (!_reimport_prepare(files[i].path, task)) {
+				step++;
+				continue;
+			}
+
+			if (import_pool.is_initialized() && task.importer->can_import_threaded()) {
+				threaded_tasks.push_back(task);
+				continue;
+			}
+
+			pr.step(files[i].path.get_file(), step++);
+			_reimport_import(task);
+			_reimport_finish(task);
+		}
+
+		for (int i = 0; i < threaded_tasks.size(); i += batch_size) {
+
+			int count = MIN(batch_size, threaded_tasks.size() - i);
+			pr.step(threaded_tasks[i].path.get_file(), step);
+
+			import_pool.do_work(count, this, &EditorFileSystem::_reimport_import_threaded, threaded_tasks.ptrw() + i);
+
+			for (int j = 0; j < count; j++) {
+				_reimport_finish(threaded_tasks[i + j]);
+			}
+			step += count;
+		}
+
+		from = to;
+	}
+
+	import_pool.finish();
 
-		_reimport_file(files[i].path);
+	if (import_cache_hits || import_cache_misses) {
+		print_line(vformat(TTR("Import cache: %d hit(s), %d miss(es)."), import_cache_hits, import_cache_misses));
 	}
 
 	_save_filesystem_cache();
@@ -1844,6 +2104,8 @@ EditorFileSystem::EditorFileSystem() {
 	scanning = false;
 	importing = false;
 	use_threads = true;
+	import_cache_hits = 0;
+	import_cache_misses = 0;
 	thread_sources = NULL;
 	new_filesystem = NULL;
 
@@ -1863,6 +2125,7 @@ EditorFileSystem::EditorFileSystem() {
 	update_script_classes_queued = false;
 	first_scan = true;
 	revalidate_import_files = false;
+	import_settings_changed = false;
 }
 
 EditorFileSystem::~EditorFileSystem() {
@@ -31,6 +31,7 @@
 #ifndef EDITOR_FILE_SYSTEM_H
 #define EDITOR_FILE_SYSTEM_H
 
+#include "core/io/resource_importer.h"
 #include "core/os/dir_access.h"
 #include "core/os/thread.h"
 #include "core/os/thread_safe.h"
@@ -57,6 +58,7 @@ class EditorFileSystemDirectory : public Object {
 		uint64_t import_modified_time;
 		bool import_valid;
 		Vector<String> deps;
+		Vector<String> import_dest_paths; //what the .import file points to, so scans don't parse it while it is unchanged
 		bool verified; //used for checking changes
 		String script_class_name;
 		String script_class_extends;
@@ -147,6 +149,7 @@ class EditorFileSystem : public Node {
 	float scan_total;
 	String filesystem_settings_version_for_import;
 	bool revalidate_import_files;
+	bool import_settings_changed;
 
 	void _scan_filesystem();
 
@@ -166,6 +169,7 @@ class EditorFileSystem : public Node {
 		uint64_t modification_time;
 		uint64_t import_modification_time;
 		Vector<String> deps;
+		Vector<String> import_dest_paths;
 		bool import_valid;
 		String script_class_name;
 		String script_class_extends;
@@ -210,9 +214,33 @@ class EditorFileSystem : public Node {
 
 	void _update_extensions();
 
-	void _reimport_file(const String &p_file);
+	struct ReimportTask {
+		String path;
+		Ref<ResourceImporter> importer;
+		Map<StringName, Variant> params;
+		List<ResourceImporter::ImportOption> options;
+		String base_path;
+		List<String> import_variants;
+		List<String> gen_files;
+		Variant metadata;
+		Error err;
+	};
+
+	String import_cache_dir;
+	uint32_t import_cache_hits;
+	uint32_t import_cache_misses;
+
+	String _get_import_cache_key(const ReimportTask &p_task) const;
+	bool _import_cache_fetch(const String &p_key, ReimportTask &p_task);
+	void _import_cache_store(const String &p_key, const ReimportTask &p_task);
+
+	bool _reimport_prepare(const String &p_file, ReimportTask &r_task);
+	void _reimport_import(ReimportTask &p_task);
+	void _reimport_import_threaded(uint32_t p_index, ReimportTask *p_tasks);
+	void _reimport_finish(const ReimportTask &p_task);
 
-	bool _test_for_reimport(const String &p_path, bool p_only_imported_files);
+	bool _test_for_reimport(const String &p_path, bool p_only_imported_files, Vector<String> *r_checked_paths = NULL);
+	bool _test_for_reimport_cached(const String &p_path, Vector<String> &r_import_dest_paths, bool p_settings_changed);
 
 	bool reimport_on_missing_imported_files;
 
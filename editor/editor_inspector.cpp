@@ -1180,6 +1180,7 @@ void EditorInspectorSection::_gui_input(const Ref<InputEvent> &p_event) {
 		object->editor_set_section_unfold(section, unfold);
 		if (unfold) {
 			vbox->show();
+			emit_signal("unfolded");
 		} else {
 			vbox->hide();
 		}
@@ -1202,6 +1203,7 @@ void EditorInspectorSection::unfold() {
 	object->editor_set_section_unfold(section, true);
 	vbox->show();
 	update();
+	emit_signal("unfolded");
 #endif
 }
 
@@ -1219,6 +1221,11 @@ void EditorInspectorSection::fold() {
 #endif
 }
 
+bool EditorInspectorSection::is_folded() const {
+
+	return foldable && !vbox->is_visible();
+}
+
 void EditorInspectorSection::_bind_methods() {
 
 	ClassDB::bind_method(D_METHOD("setup", "section", "label", "object", "bg_color", "foldable"), &EditorInspectorSection::setup);
@@ -1226,6 +1233,8 @@ void EditorInspectorSection::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("unfold"), &EditorInspectorSection::unfold);
 	ClassDB::bind_method(D_METHOD("fold"), &EditorInspectorSection::fold);
 	ClassDB::bind_method(D_METHOD("_gui_input"), &EditorInspectorSection::_gui_input);
+
+	ADD_SIGNAL(MethodInfo("unfolded"));
 }
 
 EditorInspectorSection::EditorInspectorSection() {
@@ -1370,6 +1379,106 @@ void EditorInspector::_parse_added_editors(VBoxContainer *current_vbox, Ref<Edit
 	ped->added_editors.clear();
 }
 
+int EditorInspector::_add_property_editors(VBoxContainer *p_vbox, int p_position, const PropertyInfo &p, const String &p_label, const String &p_doc_hint, const StringName &p_selected, int p_focusable) {
+
+	bool checkable = false;
+	bool checked = false;
+	if (p.usage & PROPERTY_USAGE_CHECKABLE) {
+		checkable = true;
+		checked = p.usage & PROPERTY_USAGE_CHECKED;
+	}
+
+	int added = 0;
+
+	for (List<Ref<EditorInspectorPlugin> >::Element *E = valid_plugins.front(); E; E = E->next()) {
+		Ref<EditorInspectorPlugin> ped = E->get();
+		bool exclusive = ped->parse_property(object, p.type, p.name, p.hint, p.hint_string, p.usage);
+
+		List<EditorInspectorPlugin::AddedEditor> editors = ped->added_editors; //make a copy, since plugins may be used again in a sub-inspector
+		ped->added_editors.clear();
+
+		for (List<EditorInspectorPlugin::AddedEditor>::Element *F = editors.front(); F; F = F->next()) {
+
+			EditorProperty *ep = Object::cast_to<EditorProperty>(F->get().property_editor);
+
+			if (ep) {
+				//set all this before the control gets the ENTER_TREE notification
+				ep->object = object;
+
+				if (F->get().properties.size()) {
+
+					if (F->get().properties.size() == 1) {
+						//since it's one, associate:
+						ep->property = F->get().properties[0];
+						ep->property_usage = p.usage;
+						//and set label?
+					}
+
+					if (F->get().label != String()) {
+						ep->set_label(F->get().label);
+					} else {
+						//use existin one
+						ep->set_label(p_label);
+					}
+					for (int i = 0; i < F->get().properties.size(); i++) {
+						String prop = F->get().properties[i];
+
+						if (!editor_property_map.has(prop)) {
+							editor_property_map[prop] = List<EditorProperty *>();
+						}
+						editor_property_map[prop].push_back(ep);
+					}
+				}
+				ep->set_draw_red(draw_red);
+				ep->set_use_folding(use_folding);
+				ep->set_checkable(checkable);
+				ep->set_checked(checked);
+				ep->set_keying(keying);
+
+				ep->set_read_only(read_only);
+			}
+
+			p_vbox->add_child(F->get().property_editor);
+			if (p_position >= 0) {
+				p_vbox->move_child(F->get().property_editor, p_position + added);
+			}
+			added++;
+
+			if (ep) {
+
+				ep->connect("property_changed", this, "_property_changed");
+				if (p.usage & PROPERTY_USAGE_UPDATE_ALL_IF_MODIFIED) {
+					ep->connect("property_changed", this, "_property_changed_update_all", varray(), CONNECT_DEFERRED);
+				}
+				ep->connect("property_keyed", this, "_property_keyed");
+				ep->connect("property_keyed_with_value", this, "_property_keyed_with_value");
+				ep->connect("property_checked", this, "_property_checked");
+				ep->connect("selected", this, "_property_selected");
+				ep->connect("multiple_properties_changed", this, "_multiple_properties_changed");
+				ep->connect("resource_selected", this, "_resource_selected", varray(), CONNECT_DEFERRED);
+				ep->connect("object_id_selected", this, "_object_id_selected", varray(), CONNECT_DEFERRED);
+				if (p_doc_hint != String()) {
+					ep->set_tooltip(property_prefix + p.name + "::" + p_doc_hint);
+				} else {
+					ep->set_tooltip(property_prefix + p.name);
+				}
+				ep->update_property();
+				ep->update_reload_status();
+
+				if (p_selected && ep->property == p_selected) {
+					ep->select(p_focusable);
+				}
+			}
+		}
+
+		if (exclusive) {
+			break;
+		}
+	}
+
+	return added;
+}
+
 void EditorInspector::update_tree() {
 
 	//to update properly if all is refreshed
@@ -1402,15 +1511,13 @@ void EditorInspector::update_tree() {
 	if (!object)
 		return;
 
-	List<Ref<EditorInspectorPlugin> > valid_plugins;
-
 	for (int i = inspector_plugin_count - 1; i >= 0; i--) { //start by last, so lastly added can override newly added
 		if (!inspector_plugins[i]->can_handle(object))
 			continue;
 		valid_plugins.push_back(inspector_plugins[i]);
 	}
 
-	bool draw_red = false;
+	draw_red = false;
 
 	{
 		Node *nod = Object::cast_to<Node>(object);
@@ -1430,6 +1537,7 @@ void EditorInspector::update_tree() {
 	List<PropertyInfo>
 			plist;
 	object->get_property_list(&plist, true);
+	tree_property_list = plist;
 
 	HashMap<String, VBoxContainer *> item_path;
 	Map<VBoxContainer *, EditorInspectorSection *> section_map;
@@ -1595,6 +1703,7 @@ void EditorInspector::update_tree() {
 					Color c = sscolor;
 					c.a /= level;
 					section->setup(acc_path, path_name, object, c, use_folding);
+					section->connect("unfolded", this, "_section_unfolded", varray(section));
 
 					VBoxContainer *vb = section->get_vbox();
 					item_path[acc_path] = vb;
@@ -1613,13 +1722,6 @@ void EditorInspector::update_tree() {
 			}
 		}
 
-		bool checkable = false;
-		bool checked = false;
-		if (p.usage & PROPERTY_USAGE_CHECKABLE) {
-			checkable = true;
-			checked = p.usage & PROPERTY_USAGE_CHECKED;
-		}
-
 		if (p.usage & PROPERTY_USAGE_RESTART_IF_CHANGED) {
 			restart_request_props.insert(p.name);
 		}
@@ -1667,97 +1769,76 @@ void EditorInspector::update_tree() {
 			doc_hint = descr;
 		}
 
-		for (List<Ref<EditorInspectorPlugin> >::Element *E = valid_plugins.front(); E; E = E->next()) {
-			Ref<EditorInspectorPlugin> ped = E->get();
-			bool exclusive = ped->parse_property(object, p.type, p.name, p.hint, p.hint_string, p.usage);
-
-			List<EditorInspectorPlugin::AddedEditor> editors = ped->added_editors; //make a copy, since plugins may be used again in a sub-inspector
-			ped->added_editors.clear();
+		Map<VBoxContainer *, EditorInspectorSection *>::Element *S = section_map.find(current_vbox);
+		if (S && S->get()->is_folded()) {
+			//not visible, create the editors once the section is unfolded
+			DeferredProperty dp;
+			dp.info = p;
+			dp.label = name;
+			dp.doc_hint = doc_hint;
+			dp.position = current_vbox->get_child_count();
+			deferred_properties[S->get()].push_back(dp);
+			continue;
+		}
 
-			for (List<EditorInspectorPlugin::AddedEditor>::Element *F = editors.front(); F; F = F->next()) {
+		_add_property_editors(current_vbox, -1, p, name, doc_hint, current_selected, current_focusable);
+	}
 
-				EditorProperty *ep = Object::cast_to<EditorProperty>(F->get().property_editor);
+	for (List<Ref<EditorInspectorPlugin> >::Element *E = valid_plugins.front(); E; E = E->next()) {
+		Ref<EditorInspectorPlugin> ped = E->get();
+		ped->parse_end();
+		_parse_added_editors(main_vbox, ped);
+	}
 
-				if (ep) {
-					//set all this before the control gets the ENTER_TREE notification
-					ep->object = object;
+	//see if this property exists and should be kept
+}
+void EditorInspector::_section_unfolded(Object *p_section) {
 
-					if (F->get().properties.size()) {
+	EditorInspectorSection *section = Object::cast_to<EditorInspectorSection>(p_section);
+	Map<EditorInspectorSection *, List<DeferredProperty> >::Element *E = deferred_properties.find(section);
+	if (!E)
+		return;
 
-						if (F->get().properties.size() == 1) {
-							//since it's one, associate:
-							ep->property = F->get().properties[0];
-							ep->property_usage = p.usage;
-							//and set label?
-						}
+	List<DeferredProperty> properties = E->get();
+	deferred_properties.erase(E);
 
-						if (F->get().label != String()) {
-							ep->set_label(F->get().label);
-						} else {
-							//use existin one
-							ep->set_label(name);
-						}
-						for (int i = 0; i < F->get().properties.size(); i++) {
-							String prop = F->get().properties[i];
+	//positions were taken before any deferred editor was added, offset them by the ones added since
+	int added = 0;
+	for (List<DeferredProperty>::Element *F = properties.front(); F; F = F->next()) {
+		const DeferredProperty &dp = F->get();
+		added += _add_property_editors(section->get_vbox(), dp.position + added, dp.info, dp.label, dp.doc_hint);
+	}
+}
 
-							if (!editor_property_map.has(prop)) {
-								editor_property_map[prop] = List<EditorProperty *>();
-							}
-							editor_property_map[prop].push_back(ep);
-						}
-					}
-					ep->set_draw_red(draw_red);
-					ep->set_use_folding(use_folding);
-					ep->set_checkable(checkable);
-					ep->set_checked(checked);
-					ep->set_keying(keying);
+bool EditorInspector::_is_property_list_changed() const {
 
-					ep->set_read_only(read_only);
-				}
+	List<PropertyInfo> plist;
+	object->get_property_list(&plist, true);
 
-				current_vbox->add_child(F->get().property_editor);
+	if (plist.size() != tree_property_list.size())
+		return true;
 
-				if (ep) {
+	const List<PropertyInfo>::Element *F = tree_property_list.front();
+	for (const List<PropertyInfo>::Element *E = plist.front(); E; E = E->next(), F = F->next()) {
+		const PropertyInfo &a = E->get();
+		const PropertyInfo &b = F->get();
+		if (a.name != b.name || a.type != b.type || a.hint != b.hint || a.hint_string != b.hint_string || a.usage != b.usage || a.class_name != b.class_name)
+			return true;
+	}
 
-					ep->connect("property_changed", this, "_property_changed");
-					if (p.usage & PROPERTY_USAGE_UPDATE_ALL_IF_MODIFIED) {
-						ep->connect("property_changed", this, "_property_changed_update_all", varray(), CONNECT_DEFERRED);
-					}
-					ep->connect("property_keyed", this, "_property_keyed");
-					ep->connect("property_keyed_with_value", this, "_property_keyed_with_value");
-					ep->connect("property_checked", this, "_property_checked");
-					ep->connect("selected", this, "_property_selected");
-					ep->connect("multiple_properties_changed", this, "_multiple_properties_changed");
-					ep->connect("resource_selected", this, "_resource_selected", varray(), CONNECT_DEFERRED);
-					ep->connect("object_id_selected", this, "_object_id_selected", varray(), CONNECT_DEFERRED);
-					if (doc_hint != String()) {
-						ep->set_tooltip(property_prefix + p.name + "::" + doc_hint);
-					} else {
-						ep->set_tooltip(property_prefix + p.name);
-					}
-					ep->update_property();
-					ep->update_reload_status();
+	return false;
+}
 
-					if (current_selected && ep->property == current_selected) {
-						ep->select(current_focusable);
-					}
-				}
-			}
+void EditorInspector::_update_all_properties() {
 
-			if (exclusive) {
-				break;
-			}
+	for (Map<StringName, List<EditorProperty *> >::Element *F = editor_property_map.front(); F; F = F->next()) {
+		for (List<EditorProperty *>::Element *E = F->get().front(); E; E = E->next()) {
+			E->get()->update_property();
+			E->get()->update_reload_status();
 		}
 	}
-
-	for (List<Ref<EditorInspectorPlugin> >::Element *E = valid_plugins.front(); E; E = E->next()) {
-		Ref<EditorInspectorPlugin> ped = E->get();
-		ped->parse_end();
-		_parse_added_editors(main_vbox, ped);
-	}
-
-	//see if this property exists and should be kept
 }
+
 void EditorInspector::update_property(const String &p_prop) {
 	if (!editor_property_map.has(p_prop))
 		return;
@@ -1778,6 +1859,9 @@ void EditorInspector::_clear() {
 	editor_property_map.clear();
 	sections.clear();
 	pending.clear();
+	deferred_properties.clear();
+	valid_plugins.clear();
+	tree_property_list.clear();
 	restart_request_props.clear();
 }
 
@@ -2161,12 +2245,7 @@ void EditorInspector::_notification(int p_what) {
 		if (refresh_countdown > 0) {
 			refresh_countdown -= get_process_delta_time();
 			if (refresh_countdown <= 0) {
-				for (Map<StringName, List<EditorProperty *> >::Element *F = editor_property_map.front(); F; F = F->next()) {
-					for (List<EditorProperty *>::Element *E = F->get().front(); E; E = E->next()) {
-						E->get()->update_property();
-						E->get()->update_reload_status();
-					}
-				}
+				_update_all_properties();
 			}
 		}
 
@@ -2174,7 +2253,12 @@ void EditorInspector::_notification(int p_what) {
 
 		if (update_tree_pending) {
 
-			update_tree();
+			if (object && !_is_property_list_changed()) {
+				//same properties as the tree was built from, refreshing the editors is enough
+				_update_all_properties();
+			} else {
+				update_tree();
+			}
 			update_tree_pending = false;
 			pending.clear();
 
@@ -2254,6 +2338,7 @@ void EditorInspector::_bind_methods() {
 	ClassDB::bind_method("_resource_selected", &EditorInspector::_resource_selected);
 	ClassDB::bind_method("_object_id_selected", &EditorInspector::_object_id_selected);
 	ClassDB::bind_method("_vscroll_changed", &EditorInspector::_vscroll_changed);
+	ClassDB::bind_method("_section_unfolded", &EditorInspector::_section_unfolded);
 
 	ClassDB::bind_method("refresh", &EditorInspector::refresh);
 
@@ -2294,6 +2379,7 @@ EditorInspector::EditorInspector() {
 	set_process(true);
 	property_focusable = -1;
 	sub_inspector = false;
+	draw_red = false;
 
 	get_v_scrollbar()->connect("value_changed", this, "_vscroll_changed");
 	update_scroll_request = -1;
@@ -240,6 +240,7 @@ public:
 	VBoxContainer *get_vbox();
 	void unfold();
 	void fold();
+	bool is_folded() const;
 
 	Object *get_edited_object();
 
@@ -264,6 +265,19 @@ class EditorInspector : public ScrollContainer {
 	List<EditorInspectorSection *> sections;
 	Set<StringName> pending;
 
+	//properties of folded sections, their editors are created when the section is unfolded
+	struct DeferredProperty {
+		PropertyInfo info;
+		String label;
+		String doc_hint;
+		int position;
+	};
+
+	Map<EditorInspectorSection *, List<DeferredProperty> > deferred_properties;
+	List<Ref<EditorInspectorPlugin> > valid_plugins;
+	List<PropertyInfo> tree_property_list; //list the tree was built from
+	bool draw_red;
+
 	void _clear();
 	Object *object;
 
@@ -320,6 +334,10 @@ class EditorInspector : public ScrollContainer {
 
 	void _filter_changed(const String &p_text);
 	void _parse_added_editors(VBoxContainer *current_vbox, Ref<EditorInspectorPlugin> ped);
+	int _add_property_editors(VBoxContainer *p_vbox, int p_position, const PropertyInfo &p, const String &p_label, const String &p_doc_hint, const StringName &p_selected = StringName(), int p_focusable = -1);
+	void _section_unfolded(Object *p_section);
+	bool _is_property_list_changed() const;
+	void _update_all_properties();
 
 	void _vscroll_changed(double);
 
@@ -0,0 +1,266 @@
+/*************************************************************************/
+/*  editor_network_profiler.cpp                                          */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2019 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2019 Godot Engine contributors (cf. AUTHORS.md)    */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#include "editor_network_profiler.h"
+
+#include "core/os/os.h"
+#include "editor_scale.h"
+
+void EditorNetworkProfiler::_bind_methods() {
+
+	ClassDB::bind_method(D_METHOD("_update_frame"), &EditorNetworkProfiler::_update_frame);
+	ClassDB::bind_method(D_METHOD("_activate_pressed"), &EditorNetworkProfiler::_activate_pressed);
+	ClassDB::bind_method(D_METHOD("_clear_pressed"), &EditorNetworkProfiler::_clear_pressed);
+	ADD_SIGNAL(MethodInfo("enable_profiling", PropertyInfo(Variant::BOOL, "enable")));
+}
+
+void EditorNetworkProfiler::_notification(int p_what) {
+
+	if (p_what == NOTIFICATION_ENTER_TREE || p_what == NOTIFICATION_THEME_CHANGED) {
+		activate->set_icon(get_icon(activate->is_pressed() ? "Stop" : "Play", "EditorIcons"));
+		clear_button->set_icon(get_icon("Clear", "EditorIcons"));
+	}
+}
+
+void EditorNetworkProfiler::_update_frame() {
+
+	if (!dirty)
+		return;
+	dirty = false;
+
+	counters_display->clear();
+
+	TreeItem *root = counters_display->create_item();
+
+	for (Map<String, NodeInfo>::Element *E = nodes_data.front(); E; E = E->next()) {
+
+		const NodeInfo &info = E->get();
+		TreeItem *node = counters_display->create_item(root);
+
+		node->set_text(0, String(info.node));
+		node->set_tooltip(0, String(info.node));
+		node->set_text(1, info.property ? "rset: " + String(info.name) : String(info.name));
+		node->set_text(2, itos(info.incoming_calls));
+		node->set_text(3, String::humanize_size(info.incoming_bytes));
+		node->set_text(4, itos(info.outgoing_calls));
+		node->set_text(5, String::humanize_size(info.outgoing_bytes));
+	}
+}
+
+void EditorNetworkProfiler::_activate_pressed() {
+
+	if (activate->is_pressed()) {
+		activate->set_icon(get_icon("Stop", "EditorIcons"));
+		activate->set_text(TTR("Stop"));
+	} else {
+		activate->set_icon(get_icon("Play", "EditorIcons"));
+		activate->set_text(TTR("Start"));
+	}
+	emit_signal("enable_profiling", activate->is_pressed());
+}
+
+void EditorNetworkProfiler::_clear_pressed() {
+
+	clear();
+}
+
+void EditorNetworkProfiler::add_node_frame_data(const Array &p_frame) {
+
+	for (int i = 0; i < p_frame.size(); i++) {
+
+		Dictionary d = p_frame[i];
+		NodePath path = d["node"];
+		StringName name = d["name"];
+		String key = String(path) + "::" + String(name);
+
+		Map<String, NodeInfo>::Element *E = nodes_data.find(key);
+		if (!E) {
+			NodeInfo info;
+			info.node = path;
+			info.name = name;
+			info.property = d["property"];
+			info.incoming_calls = 0;
+			info.incoming_bytes = 0;
+			info.outgoing_calls = 0;
+			info.outgoing_bytes = 0;
+			E = nodes_data.insert(key, info);
+		}
+
+		NodeInfo &info = E->get();
+		info.incoming_calls += (int)d["incoming_calls"];
+		info.incoming_bytes += (int)d["incoming_bytes"];
+		info.outgoing_calls += (int)d["outgoing_calls"];
+		info.outgoing_bytes += (int)d["outgoing_bytes"];
+	}
+
+	dirty = true;
+	if (frame_delay->is_stopped()) {
+		frame_delay->start();
+	}
+}
+
+void EditorNetworkProfiler::set_bandwidth(uint64_t p_bytes_received, uint64_t p_bytes_sent, const Array &p_peers) {
+
+	uint64_t now = OS::get_singleton()->get_ticks_msec();
+
+	// Counters are totals since the game started, show them as a rate between two updates.
+	if (last_bandwidth_msec && now > last_bandwidth_msec && p_bytes_received >= last_bytes_received && p_bytes_sent >= last_bytes_sent) {
+		uint64_t elapsed = now - last_bandwidth_msec;
+		incoming_bandwidth->set_text(vformat(TTR("Down: %s/s"), String::humanize_size((p_bytes_received - last_bytes_received) * 1000 / elapsed)));
+		outgoing_bandwidth->set_text(vformat(TTR("Up: %s/s"), String::humanize_size((p_bytes_sent - last_bytes_sent) * 1000 / elapsed)));
+	}
+
+	last_bytes_received = p_bytes_received;
+	last_bytes_sent = p_bytes_sent;
+	last_bandwidth_msec = now;
+
+	peers_display->clear();
+	TreeItem *root = peers_display->create_item();
+
+	for (int i = 0; i + 2 < p_peers.size(); i += 3) {
+
+		TreeItem *peer = peers_display->create_item(root);
+		int rtt = p_peers[i + 1];
+		float loss = p_peers[i + 2];
+
+		peer->set_text(0, itos(p_peers[i]));
+		peer->set_text(1, rtt < 0 ? String("-") : itos(rtt) + " ms");
+		peer->set_text(2, loss < 0 ? String("-") : rtos(Math::stepify(loss * 100.0, 0.1)) + " %");
+	}
+}
+
+void EditorNetworkProfiler::set_enabled(bool p_enable) {
+
+	activate->set_disabled(!p_enable);
+}
+
+bool EditorNetworkProfiler::is_profiling() {
+
+	return activate->is_pressed();
+}
+
+void EditorNetworkProfiler::clear() {
+
+	nodes_data.clear();
+	dirty = true;
+	_update_frame();
+
+	peers_display->clear();
+	last_bandwidth_msec = 0;
+	incoming_bandwidth->set_text(TTR("Down: -"));
+	outgoing_bandwidth->set_text(TTR("Up: -"));
+}
+
+EditorNetworkProfiler::EditorNetworkProfiler() {
+
+	HBoxContainer *hb = memnew(HBoxContainer);
+	hb->add_constant_override("separation", 8 * EDSCALE);
+	add_child(hb);
+
+	activate = memnew(Button);
+	activate->set_toggle_mode(true);
+	activate->set_text(TTR("Start"));
+	activate->connect("pressed", this, "_activate_pressed");
+	hb->add_child(activate);
+
+	clear_button = memnew(Button);
+	clear_button->set_text(TTR("Clear"));
+	clear_button->connect("pressed", this, "_clear_pressed");
+	hb->add_child(clear_button);
+
+	hb->add_spacer();
+
+	incoming_bandwidth = memnew(Label);
+	incoming_bandwidth->set_text(TTR("Down: -"));
+	hb->add_child(incoming_bandwidth);
+
+	outgoing_bandwidth = memnew(Label);
+	outgoing_bandwidth->set_text(TTR("Up: -"));
+	hb->add_child(outgoing_bandwidth);
+
+	HSplitContainer *h_split = memnew(HSplitContainer);
+	h_split->set_v_size_flags(SIZE_EXPAND_FILL);
+	add_child(h_split);
+
+	counters_display = memnew(Tree);
+	counters_display->set_custom_minimum_size(Size2(300, 0) * EDSCALE);
+	counters_display->set_h_size_flags(SIZE_EXPAND_FILL);
+	counters_display->set_hide_folding(true);
+	counters_display->set_hide_root(true);
+	counters_display->set_columns(6);
+	counters_display->set_column_titles_visible(true);
+	counters_display->set_column_title(0, TTR("Node"));
+	counters_display->set_column_expand(0, true);
+	counters_display->set_column_min_width(0, 60 * EDSCALE);
+	counters_display->set_column_title(1, TTR("Method/Property"));
+	counters_display->set_column_expand(1, true);
+	counters_display->set_column_min_width(1, 60 * EDSCALE);
+	counters_display->set_column_title(2, TTR("Incoming Calls"));
+	counters_display->set_column_expand(2, false);
+	counters_display->set_column_min_width(2, 100 * EDSCALE);
+	counters_display->set_column_title(3, TTR("Incoming Bytes"));
+	counters_display->set_column_expand(3, false);
+	counters_display->set_column_min_width(3, 100 * EDSCALE);
+	counters_display->set_column_title(4, TTR("Outgoing Calls"));
+	counters_display->set_column_expand(4, false);
+	counters_display->set_column_min_width(4, 100 * EDSCALE);
+	counters_display->set_column_title(5, TTR("Outgoing Bytes"));
+	counters_display->set_column_expand(5, false);
+	counters_display->set_column_min_width(5, 100 * EDSCALE);
+	h_split->add_child(counters_display);
+
+	peers_display = memnew(Tree);
+	peers_display->set_custom_minimum_size(Size2(240, 0) * EDSCALE);
+	peers_display->set_hide_folding(true);
+	peers_display->set_hide_root(true);
+	peers_display->set_columns(3);
+	peers_display->set_column_titles_visible(true);
+	peers_display->set_column_title(0, TTR("Peer"));
+	peers_display->set_column_expand(0, true);
+	peers_display->set_column_title(1, TTR("RTT"));
+	peers_display->set_column_expand(1, false);
+	peers_display->set_column_min_width(1, 70 * EDSCALE);
+	peers_display->set_column_title(2, TTR("Packet Loss"));
+	peers_display->set_column_expand(2, false);
+	peers_display->set_column_min_width(2, 90 * EDSCALE);
+	h_split->add_child(peers_display);
+
+	// Frames arrive every game frame, rebuilding the tree that often would be wasted work.
+	frame_delay = memnew(Timer);
+	frame_delay->set_wait_time(0.5);
+	frame_delay->set_one_shot(true);
+	frame_delay->connect("timeout", this, "_update_frame");
+	add_child(frame_delay);
+
+	dirty = false;
+	last_bytes_received = 0;
+	last_bytes_sent = 0;
+	last_bandwidth_msec = 0;
+}
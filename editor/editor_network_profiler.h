@@ -0,0 +1,90 @@
+/*************************************************************************/
+/*  editor_network_profiler.h                                            */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2019 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2019 Godot Engine contributors (cf. AUTHORS.md)    */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#ifndef EDITOR_NETWORK_PROFILER_H
+#define EDITOR_NETWORK_PROFILER_H
+
+#include "scene/gui/box_container.h"
+#include "scene/gui/button.h"
+#include "scene/gui/label.h"
+#include "scene/gui/split_container.h"
+#include "scene/gui/tree.h"
+#include "scene/main/timer.h"
+
+class EditorNetworkProfiler : public VBoxContainer {
+
+	GDCLASS(EditorNetworkProfiler, VBoxContainer)
+
+	struct NodeInfo {
+
+		NodePath node;
+		StringName name;
+		bool property;
+		int incoming_calls;
+		int incoming_bytes;
+		int outgoing_calls;
+		int outgoing_bytes;
+	};
+
+	Button *activate;
+	Button *clear_button;
+	Label *incoming_bandwidth;
+	Label *outgoing_bandwidth;
+	Tree *counters_display;
+	Tree *peers_display;
+	Timer *frame_delay;
+
+	Map<String, NodeInfo> nodes_data;
+	bool dirty;
+
+	uint64_t last_bytes_received;
+	uint64_t last_bytes_sent;
+	uint64_t last_bandwidth_msec;
+
+	void _update_frame();
+	void _activate_pressed();
+	void _clear_pressed();
+
+protected:
+	void _notification(int p_what);
+	static void _bind_methods();
+
+public:
+	void add_node_frame_data(const Array &p_frame);
+	void set_bandwidth(uint64_t p_bytes_received, uint64_t p_bytes_sent, const Array &p_peers);
+
+	void set_enabled(bool p_enable);
+	bool is_profiling();
+	void clear();
+
+	EditorNetworkProfiler();
+};
+
+#endif // EDITOR_NETWORK_PROFILER_H
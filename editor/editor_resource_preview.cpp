@@ -35,8 +35,10 @@
 #include "core/io/resource_loader.h"
 #include "core/io/resource_saver.h"
 #include "core/message_queue.h"
+#include "core/engine.h"
 #include "core/os/file_access.h"
 #include "core/project_settings.h"
+#include "core/safe_refcount.h"
 #include "editor_node.h"
 #include "editor_scale.h"
 #include "editor_settings.h"
@@ -75,6 +77,10 @@ bool EditorResourcePreviewGenerator::should_generate_small_preview() const {
 	return false;
 }
 
+bool EditorResourcePreviewGenerator::can_generate_threaded() const {
+	return false;
+}
+
 void EditorResourcePreviewGenerator::_bind_methods() {
 
 	ClassDB::add_virtual_method(get_class_static(), MethodInfo(Variant::BOOL, "handles", PropertyInfo(Variant::STRING, "type")));
@@ -146,12 +152,21 @@ void EditorResourcePreview::_generate_preview(Ref<ImageTexture> &r_texture, Ref<
 		if (!preview_generators[i]->handles(type))
 			continue;
 
+		bool threaded = preview_generators[i]->can_generate_threaded();
+		if (!threaded) {
+			generator_mutex->lock();
+		}
+
 		Ref<Texture> generated;
 		if (p_item.resource.is_valid()) {
 			generated = preview_generators[i]->generate(p_item.resource, Vector2(thumbnail_size, thumbnail_size));
 		} else {
 			generated = preview_generators[i]->generate_from_path(p_item.path, Vector2(thumbnail_size, thumbnail_size));
 		}
+
+		if (!threaded) {
+			generator_mutex->unlock();
+		}
 		r_texture = generated;
 
 		if (r_texture.is_valid() && preview_generators[i]->should_generate_small_preview()) {
@@ -196,10 +211,23 @@ void EditorResourcePreview::_thread() {
 
 		if (queue.size()) {
 
-			QueueItem item = queue.front()->get();
-			queue.pop_front();
+			//oldest request of the latest frame, so what was just shown comes before older folders
+			List<QueueItem>::Element *E = queue.front();
+			for (List<QueueItem>::Element *F = E->next(); F; F = F->next()) {
+				if (F->get().frame > E->get().frame) {
+					E = F;
+				}
+			}
 
-			if (cache.has(item.path)) {
+			QueueItem item = E->get();
+			queue.erase(E);
+
+			if (generating.has(item.path)) {
+				//another worker is making this preview, answer from the cache when it is done
+				waiting.push_back(item);
+				preview_mutex->unlock();
+
+			} else if (cache.has(item.path)) {
 				//already has it because someone loaded it, just let it know it's ready
 				String path = item.path;
 				if (item.resource.is_valid()) {
@@ -211,6 +239,7 @@ void EditorResourcePreview::_thread() {
 				preview_mutex->unlock();
 			} else {
 
+				generating.insert(item.path);
 				preview_mutex->unlock();
 
 				Ref<ImageTexture> texture;
@@ -308,6 +337,24 @@ void EditorResourcePreview::_thread() {
 					}
 					_preview_ready(item.path, texture, small_texture, item.id, item.function, item.userdata);
 				}
+
+				preview_mutex->lock();
+				generating.erase(item.path);
+				int requeued = 0;
+				for (List<QueueItem>::Element *F = waiting.front(); F;) {
+					List<QueueItem>::Element *N = F->next();
+					if (F->get().path == item.path) {
+						queue.push_back(F->get());
+						waiting.erase(F);
+						requeued++;
+					}
+					F = N;
+				}
+				preview_mutex->unlock();
+
+				for (int i = 0; i < requeued; i++) {
+					preview_sem->post();
+				}
 			}
 
 		} else {
@@ -315,7 +362,27 @@ void EditorResourcePreview::_thread() {
 		}
 	}
 #endif
-	exited = true;
+	atomic_decrement(&threads_running);
+}
+
+bool EditorResourcePreview::_queue(const QueueItem &p_item) {
+
+	//a receiver asking again for the same path only moves its pending request to the current frame
+	List<QueueItem> *lists[2] = { &queue, &waiting };
+	for (int i = 0; i < 2; i++) {
+		for (List<QueueItem>::Element *E = lists[i]->front(); E; E = E->next()) {
+			QueueItem &pending = E->get();
+			if (pending.id == p_item.id && pending.function == p_item.function && pending.path == p_item.path) {
+				pending.resource = p_item.resource;
+				pending.userdata = p_item.userdata;
+				pending.frame = p_item.frame;
+				return false;
+			}
+		}
+	}
+
+	queue.push_back(p_item);
+	return true;
 }
 
 void EditorResourcePreview::queue_edited_resource_preview(const Ref<Resource> &p_res, Object *p_receiver, const StringName &p_receiver_func, const Variant &p_userdata) {
@@ -343,10 +410,13 @@ void EditorResourcePreview::queue_edited_resource_preview(const Ref<Resource> &p
 	item.resource = p_res;
 	item.path = path_id;
 	item.userdata = p_userdata;
+	item.frame = Engine::get_singleton()->get_idle_frames();
 
-	queue.push_back(item);
+	bool queued = _queue(item);
 	preview_mutex->unlock();
-	preview_sem->post();
+	if (queued) {
+		preview_sem->post();
+	}
 }
 
 void EditorResourcePreview::queue_resource_preview(const String &p_path, Object *p_receiver, const StringName &p_receiver_func, const Variant &p_userdata) {
@@ -365,10 +435,13 @@ void EditorResourcePreview::queue_resource_preview(const String &p_path, Object
 	item.id = p_receiver->get_instance_id();
 	item.path = p_path;
 	item.userdata = p_userdata;
+	item.frame = Engine::get_singleton()->get_idle_frames();
 
-	queue.push_back(item);
+	bool queued = _queue(item);
 	preview_mutex->unlock();
-	preview_sem->post();
+	if (queued) {
+		preview_sem->post();
+	}
 }
 
 void EditorResourcePreview::add_preview_generator(const Ref<EditorResourcePreviewGenerator> &p_generator) {
@@ -421,37 +494,48 @@ void EditorResourcePreview::check_for_invalidation(const String &p_path) {
 }
 
 void EditorResourcePreview::start() {
-	ERR_FAIL_COND(thread);
-	thread = Thread::create(_thread_func, this);
-	exited = false;
+	ERR_FAIL_COND(threads.size());
+
+	//generators that need the main thread serialize on generator_mutex, the rest run in parallel
+	int thread_count = CLAMP(OS::get_singleton()->get_processor_count() - 1, 1, 4);
+	exit = false;
+	threads_running = thread_count;
+	for (int i = 0; i < thread_count; i++) {
+		threads.push_back(Thread::create(_thread_func, this));
+	}
 }
 void EditorResourcePreview::stop() {
-	if (thread) {
+	if (threads.size()) {
 		exit = true;
-		preview_sem->post();
-		while (!exited) {
+		for (int i = 0; i < threads.size(); i++) {
+			preview_sem->post();
+		}
+		while (threads_running > 0) {
 			OS::get_singleton()->delay_usec(10000);
 			VisualServer::get_singleton()->sync(); //sync pending stuff, as thread may be blocked on visual server
 		}
-		Thread::wait_to_finish(thread);
-		memdelete(thread);
-		thread = NULL;
+		for (int i = 0; i < threads.size(); i++) {
+			Thread::wait_to_finish(threads[i]);
+			memdelete(threads[i]);
+		}
+		threads.clear();
 	}
 }
 
 EditorResourcePreview::EditorResourcePreview() {
-	thread = NULL;
 	singleton = this;
 	preview_mutex = Mutex::create();
+	generator_mutex = Mutex::create();
 	preview_sem = Semaphore::create();
 	order = 0;
 	exit = false;
-	exited = false;
+	threads_running = 0;
 }
 
 EditorResourcePreview::~EditorResourcePreview() {
 
 	stop();
 	memdelete(preview_mutex);
+	memdelete(generator_mutex);
 	memdelete(preview_sem);
 }
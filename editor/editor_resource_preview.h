@@ -33,6 +33,7 @@
 
 #include "core/os/semaphore.h"
 #include "core/os/thread.h"
+#include "core/set.h"
 #include "scene/main/node.h"
 #include "scene/resources/texture.h"
 
@@ -49,6 +50,7 @@ public:
 	virtual Ref<Texture> generate_from_path(const String &p_path, const Size2 p_size) const;
 
 	virtual bool should_generate_small_preview() const;
+	virtual bool can_generate_threaded() const;
 
 	EditorResourcePreviewGenerator();
 };
@@ -65,15 +67,19 @@ class EditorResourcePreview : public Node {
 		ObjectID id;
 		StringName function;
 		Variant userdata;
+		uint64_t frame; //requests from the latest frame are served first
 	};
 
 	List<QueueItem> queue;
+	Set<String> generating; //paths a worker is generating right now
+	List<QueueItem> waiting; //requests for a path in generating, queued again once it is done
 
 	Mutex *preview_mutex;
+	Mutex *generator_mutex; //held by generators that can't run on several threads
 	Semaphore *preview_sem;
-	Thread *thread;
+	Vector<Thread *> threads;
 	volatile bool exit;
-	volatile bool exited;
+	uint32_t threads_running;
 
 	struct Item {
 		Ref<Texture> preview;
@@ -87,6 +93,7 @@ class EditorResourcePreview : public Node {
 
 	Map<String, Item> cache;
 
+	bool _queue(const QueueItem &p_item);
 	void _preview_ready(const String &p_str, const Ref<Texture> &p_texture, const Ref<Texture> &p_small_texture, ObjectID id, const StringName &p_func, const Variant &p_ud);
 	void _generate_preview(Ref<ImageTexture> &r_texture, Ref<ImageTexture> &r_small_texture, const QueueItem &p_item, const String &cache_base);
 
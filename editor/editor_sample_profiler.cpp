@@ -0,0 +1,331 @@
+/*************************************************************************/
+/*  editor_sample_profiler.cpp                                           */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2019 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2019 Godot Engine contributors (cf. AUTHORS.md)    */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#include "editor_sample_profiler.h"
+
+#include "editor_scale.h"
+
+void EditorSampleProfiler::_bind_methods() {
+
+	ClassDB::bind_method(D_METHOD("_graph_draw"), &EditorSampleProfiler::_graph_draw);
+	ClassDB::bind_method(D_METHOD("_graph_input"), &EditorSampleProfiler::_graph_input);
+	ClassDB::bind_method(D_METHOD("_activate_pressed"), &EditorSampleProfiler::_activate_pressed);
+	ClassDB::bind_method(D_METHOD("_clear_pressed"), &EditorSampleProfiler::_clear_pressed);
+	ClassDB::bind_method(D_METHOD("_reset_zoom_pressed"), &EditorSampleProfiler::_reset_zoom_pressed);
+	ADD_SIGNAL(MethodInfo("enable_sampling", PropertyInfo(Variant::BOOL, "enable")));
+}
+
+void EditorSampleProfiler::_notification(int p_what) {
+
+	if (p_what == NOTIFICATION_ENTER_TREE || p_what == NOTIFICATION_THEME_CHANGED) {
+		activate->set_icon(get_icon(activate->is_pressed() ? "Stop" : "Play", "EditorIcons"));
+		clear_button->set_icon(get_icon("Clear", "EditorIcons"));
+		reset_zoom->set_icon(get_icon("ZoomReset", "EditorIcons"));
+	}
+}
+
+String EditorSampleProfiler::_get_frame_name(int p_frame) const {
+
+	if (p_frame == 0)
+		return TTR("All Samples");
+
+	// Signatures look like "res://path/file.gd::line::function".
+	Vector<String> parts = String(frames[p_frame].signature).split("::");
+	if (parts.size() < 3)
+		return frames[p_frame].signature;
+
+	return parts[2] + " (" + parts[0].get_file() + ":" + parts[1] + ")";
+}
+
+Color EditorSampleProfiler::_get_frame_color(int p_frame) const {
+
+	if (p_frame == 0)
+		return get_color("dark_color_2", "Editor");
+
+	Color bc = get_color("error_color", "Editor");
+	double rot = ABS(double(frames[p_frame].signature.hash()) / double(0x7FFFFFFF));
+	Color c;
+	c.set_hsv(rot, bc.get_s(), bc.get_v());
+	return c.linear_interpolate(get_color("base_color", "Editor"), 0.07);
+}
+
+float EditorSampleProfiler::_get_row_height() const {
+
+	return get_font("font", "Label")->get_height() + 4 * EDSCALE;
+}
+
+void EditorSampleProfiler::_draw_frame(int p_frame, float p_x, float p_width, int p_depth) {
+
+	if (p_width < 1)
+		return;
+
+	const Frame &frame = frames[p_frame];
+	float row_height = _get_row_height();
+	Rect2 rect(p_x, p_depth * row_height, p_width, row_height - 1);
+
+	Color color = _get_frame_color(p_frame);
+	if (p_frame == hovered_frame) {
+		color = color.lightened(0.3);
+	}
+	graph->draw_rect(rect, color);
+
+	Ref<Font> font = get_font("font", "Label");
+	float pad = 2 * EDSCALE;
+	if (p_width > pad * 2 + font->get_char_size('X').width * 3) {
+		graph->draw_string(font, rect.position + Point2(pad, pad + font->get_ascent()), _get_frame_name(p_frame), get_color("font_color", "Label"), p_width - pad * 2);
+	}
+
+	// Children are laid out left to right by signature so the layout stays stable while sampling.
+	float x = p_x;
+	for (const Map<StringName, int>::Element *E = frame.children.front(); E; E = E->next()) {
+		float width = p_width * frames[E->get()].count / frame.count;
+		_draw_frame(E->get(), x, width, p_depth + 1);
+		x += width;
+	}
+}
+
+int EditorSampleProfiler::_find_frame(int p_frame, float p_x, float p_width, int p_depth, const Point2 &p_pos) const {
+
+	float row_height = _get_row_height();
+	if (p_pos.x < p_x || p_pos.x >= p_x + p_width || p_pos.y < p_depth * row_height)
+		return -1;
+	if (p_pos.y < (p_depth + 1) * row_height)
+		return p_frame;
+
+	const Frame &frame = frames[p_frame];
+	float x = p_x;
+	for (const Map<StringName, int>::Element *E = frame.children.front(); E; E = E->next()) {
+		float width = p_width * frames[E->get()].count / frame.count;
+		int found = _find_frame(E->get(), x, width, p_depth + 1, p_pos);
+		if (found != -1)
+			return found;
+		x += width;
+	}
+	return -1;
+}
+
+void EditorSampleProfiler::_update_graph_size() {
+
+	int depth = max_depth + 1;
+	for (int f = frames[zoom_frame].parent; f != -1; f = frames[f].parent) {
+		depth--;
+	}
+	graph->set_custom_minimum_size(Size2(0, depth * _get_row_height()));
+}
+
+void EditorSampleProfiler::_graph_draw() {
+
+	if (frames[zoom_frame].count == 0) {
+		Ref<Font> font = get_font("font", "Label");
+		String text = TTR("Start sampling to record the script call stacks of the running project.");
+		graph->draw_string(font, Point2(4 * EDSCALE, font->get_ascent() + 4 * EDSCALE), text, get_color("disabled_font_color", "Editor"));
+		return;
+	}
+
+	_draw_frame(zoom_frame, 0, graph->get_size().width, 0);
+}
+
+void EditorSampleProfiler::_graph_input(const Ref<InputEvent> &p_event) {
+
+	Ref<InputEventMouseMotion> mm = p_event;
+	if (mm.is_valid()) {
+
+		int frame = frames[zoom_frame].count ? _find_frame(zoom_frame, 0, graph->get_size().width, 0, mm->get_position()) : -1;
+		if (frame != hovered_frame) {
+			hovered_frame = frame;
+			if (frame != -1) {
+				float percent = 100.0 * frames[frame].count / frames[0].count;
+				graph->set_tooltip(_get_frame_name(frame) + "\n" + vformat(TTR("%d samples (%s%%)"), frames[frame].count, rtos(Math::stepify(percent, 0.1))));
+			} else {
+				graph->set_tooltip("");
+			}
+			graph->update();
+		}
+	}
+
+	Ref<InputEventMouseButton> mb = p_event;
+	if (mb.is_valid() && mb->is_pressed() && mb->get_button_index() == BUTTON_LEFT && hovered_frame != -1) {
+		// Zoom into the clicked frame, it then fills the whole width.
+		zoom_frame = hovered_frame;
+		hovered_frame = -1;
+		reset_zoom->set_disabled(zoom_frame == 0);
+		_update_graph_size();
+		graph->update();
+	}
+}
+
+void EditorSampleProfiler::_activate_pressed() {
+
+	if (activate->is_pressed()) {
+		activate->set_icon(get_icon("Stop", "EditorIcons"));
+		activate->set_text(TTR("Stop"));
+	} else {
+		activate->set_icon(get_icon("Play", "EditorIcons"));
+		activate->set_text(TTR("Start"));
+	}
+	frequency->set_editable(!activate->is_pressed());
+	emit_signal("enable_sampling", activate->is_pressed());
+}
+
+void EditorSampleProfiler::_clear_pressed() {
+
+	clear();
+}
+
+void EditorSampleProfiler::_reset_zoom_pressed() {
+
+	zoom_frame = 0;
+	hovered_frame = -1;
+	reset_zoom->set_disabled(true);
+	_update_graph_size();
+	graph->update();
+}
+
+void EditorSampleProfiler::add_samples(const Array &p_samples) {
+
+	for (int i = 0; i + 1 < p_samples.size(); i += 2) {
+
+		int count = p_samples[i];
+		PoolStringArray stack = p_samples[i + 1];
+
+		int current = 0;
+		frames.write[0].count += count;
+
+		for (int j = 0; j < stack.size(); j++) {
+
+			StringName signature = stack[j];
+			const Map<StringName, int>::Element *E = frames[current].children.find(signature);
+			int child;
+			if (E) {
+				child = E->get();
+			} else {
+				Frame frame;
+				frame.signature = signature;
+				frame.parent = current;
+				frame.count = 0;
+				child = frames.size();
+				frames.push_back(frame);
+				frames.write[current].children[signature] = child;
+			}
+			frames.write[child].count += count;
+			current = child;
+		}
+		max_depth = MAX(max_depth, stack.size());
+	}
+
+	total_label->set_text(vformat(TTR("Samples: %d"), frames[0].count));
+	_update_graph_size();
+	graph->update();
+}
+
+void EditorSampleProfiler::set_enabled(bool p_enable) {
+
+	activate->set_disabled(!p_enable);
+}
+
+bool EditorSampleProfiler::is_profiling() {
+
+	return activate->is_pressed();
+}
+
+int EditorSampleProfiler::get_frequency() const {
+
+	return frequency->get_value();
+}
+
+void EditorSampleProfiler::clear() {
+
+	frames.clear();
+	Frame root;
+	root.parent = -1;
+	root.count = 0;
+	frames.push_back(root);
+
+	max_depth = 0;
+	zoom_frame = 0;
+	hovered_frame = -1;
+	reset_zoom->set_disabled(true);
+	total_label->set_text(vformat(TTR("Samples: %d"), 0));
+	graph->set_tooltip("");
+	_update_graph_size();
+	graph->update();
+}
+
+EditorSampleProfiler::EditorSampleProfiler() {
+
+	HBoxContainer *hb = memnew(HBoxContainer);
+	hb->add_constant_override("separation", 8 * EDSCALE);
+	add_child(hb);
+
+	activate = memnew(Button);
+	activate->set_toggle_mode(true);
+	activate->set_text(TTR("Start"));
+	activate->connect("pressed", this, "_activate_pressed");
+	hb->add_child(activate);
+
+	clear_button = memnew(Button);
+	clear_button->set_text(TTR("Clear"));
+	clear_button->connect("pressed", this, "_clear_pressed");
+	hb->add_child(clear_button);
+
+	reset_zoom = memnew(Button);
+	reset_zoom->set_text(TTR("Reset Zoom"));
+	reset_zoom->connect("pressed", this, "_reset_zoom_pressed");
+	hb->add_child(reset_zoom);
+
+	hb->add_child(memnew(Label(TTR("Frequency (Hz):"))));
+
+	frequency = memnew(SpinBox);
+	frequency->set_min(10);
+	frequency->set_max(10000);
+	frequency->set_step(10);
+	frequency->set_value(1000);
+	hb->add_child(frequency);
+
+	hb->add_spacer();
+
+	total_label = memnew(Label);
+	hb->add_child(total_label);
+
+	scroll = memnew(ScrollContainer);
+	scroll->set_v_size_flags(SIZE_EXPAND_FILL);
+	scroll->set_enable_h_scroll(false);
+	add_child(scroll);
+
+	graph = memnew(Control);
+	graph->set_h_size_flags(SIZE_EXPAND_FILL);
+	graph->set_v_size_flags(SIZE_EXPAND_FILL);
+	graph->set_mouse_filter(MOUSE_FILTER_STOP);
+	graph->connect("draw", this, "_graph_draw");
+	graph->connect("gui_input", this, "_graph_input");
+	scroll->add_child(graph);
+
+	clear();
+}
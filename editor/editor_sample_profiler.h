@@ -0,0 +1,94 @@
+/*************************************************************************/
+/*  editor_sample_profiler.h                                             */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2019 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2019 Godot Engine contributors (cf. AUTHORS.md)    */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#ifndef EDITOR_SAMPLE_PROFILER_H
+#define EDITOR_SAMPLE_PROFILER_H
+
+#include "scene/gui/box_container.h"
+#include "scene/gui/button.h"
+#include "scene/gui/label.h"
+#include "scene/gui/scroll_container.h"
+#include "scene/gui/spin_box.h"
+
+// Shows the call stacks sampled by the script sampling profiler as a flame graph.
+class EditorSampleProfiler : public VBoxContainer {
+
+	GDCLASS(EditorSampleProfiler, VBoxContainer)
+
+	struct Frame {
+
+		StringName signature;
+		int parent;
+		int count;
+		Map<StringName, int> children;
+	};
+
+	Vector<Frame> frames; // The first one is the root, it counts every sample.
+	int max_depth;
+	int zoom_frame;
+	int hovered_frame;
+
+	Button *activate;
+	Button *clear_button;
+	Button *reset_zoom;
+	SpinBox *frequency;
+	Label *total_label;
+	ScrollContainer *scroll;
+	Control *graph;
+
+	String _get_frame_name(int p_frame) const;
+	Color _get_frame_color(int p_frame) const;
+	float _get_row_height() const;
+	void _draw_frame(int p_frame, float p_x, float p_width, int p_depth);
+	int _find_frame(int p_frame, float p_x, float p_width, int p_depth, const Point2 &p_pos) const;
+	void _update_graph_size();
+
+	void _graph_draw();
+	void _graph_input(const Ref<InputEvent> &p_event);
+	void _activate_pressed();
+	void _clear_pressed();
+	void _reset_zoom_pressed();
+
+protected:
+	void _notification(int p_what);
+	static void _bind_methods();
+
+public:
+	void add_samples(const Array &p_samples);
+
+	void set_enabled(bool p_enable);
+	bool is_profiling();
+	int get_frequency() const;
+	void clear();
+
+	EditorSampleProfiler();
+};
+
+#endif // EDITOR_SAMPLE_PROFILER_H
@@ -372,6 +372,11 @@ void EditorSettings::_load_defaults(Ref<ConfigFile> p_extra_config) {
 	_initial_set("filesystem/on_save/compress_binary_resources", true);
 	_initial_set("filesystem/on_save/safe_save_on_backup_then_rename", true);
 
+	// Import
+	_initial_set("filesystem/import/use_multiple_threads", true);
+	_initial_set("filesystem/import/shared_cache_path", "");
+	hints["filesystem/import/shared_cache_path"] = PropertyInfo(Variant::STRING, "filesystem/import/shared_cache_path", PROPERTY_HINT_GLOBAL_DIR);
+
 	// File dialog
 	_initial_set("filesystem/file_dialog/show_hidden_files", false);
 	_initial_set("filesystem/file_dialog/display_mode", 0);
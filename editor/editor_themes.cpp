@@ -31,6 +31,8 @@
 #include "editor_themes.h"
 
 #include "core/io/resource_loader.h"
+#include "core/os/file_access.h"
+#include "core/os/threaded_array_processor.h"
 #include "editor_fonts.h"
 #include "editor_icons.gen.h"
 #include "editor_scale.h"
@@ -81,24 +83,133 @@ static Ref<StyleBoxLine> make_line_stylebox(Color p_color, int p_thickness = 1,
 	return style;
 }
 
-Ref<ImageTexture> editor_generate_icon(int p_index, bool p_convert_color, float p_scale = EDSCALE, bool p_force_filter = false) {
+struct EditorIconJob {
+	int index;
+	bool convert_color;
+	float scale;
+	bool force_filter;
+	Ref<Image> image;
+};
+
+struct EditorIconRasterizer {
+	EditorIconJob *jobs;
+
+	void rasterize(uint32_t p_index, void *p_userdata) {
+
+		EditorIconJob &job = jobs[p_index];
+		job.image.instance();
+		ImageLoaderSVG::create_image_from_string(job.image, editor_icons_sources[job.index], job.scale, true, job.convert_color);
+	}
+};
+
+static void _add_icon_job(Vector<EditorIconJob> &r_jobs, int p_index, bool p_convert_color, float p_scale = EDSCALE, bool p_force_filter = false) {
+
+	EditorIconJob job;
+	job.index = p_index;
+	job.convert_color = p_convert_color;
+	job.scale = p_scale;
+	job.force_filter = p_force_filter;
+	r_jobs.push_back(job);
+}
+
+static Ref<ImageTexture> _make_icon_texture(const EditorIconJob &p_job) {
 
 	Ref<ImageTexture> icon = memnew(ImageTexture);
-	Ref<Image> img = memnew(Image);
 
 	// dumb gizmo check
-	bool is_gizmo = String(editor_icons_names[p_index]).begins_with("Gizmo");
-
-	ImageLoaderSVG::create_image_from_string(img, editor_icons_sources[p_index], p_scale, true, p_convert_color);
+	bool is_gizmo = String(editor_icons_names[p_job.index]).begins_with("Gizmo");
 
-	if ((p_scale - (float)((int)p_scale)) > 0.0 || is_gizmo || p_force_filter)
-		icon->create_from_image(img); // in this case filter really helps
+	if ((p_job.scale - (float)((int)p_job.scale)) > 0.0 || is_gizmo || p_job.force_filter)
+		icon->create_from_image(p_job.image); // in this case filter really helps
 	else
-		icon->create_from_image(img, 0);
+		icon->create_from_image(p_job.image, 0);
 
 	return icon;
 }
 
+// Rasterized icons are cached on disk, keyed by the sources, scales and color conversions they were made with.
+
+#define EDITOR_ICONS_CACHE_VERSION 1
+
+static uint32_t _get_icons_cache_key(const Vector<EditorIconJob> &p_jobs, const Dictionary &p_colors) {
+
+	uint32_t key = hash_djb2_one_32(EDITOR_ICONS_CACHE_VERSION);
+	for (int i = 0; i < p_jobs.size(); i++) {
+		const EditorIconJob &job = p_jobs[i];
+		key = hash_djb2_one_32(hash_djb2(editor_icons_sources[job.index]), key);
+		key = hash_djb2_one_32(job.convert_color, key);
+		key = hash_djb2_one_float(job.scale, key);
+	}
+	return hash_djb2_one_32(p_colors.hash(), key);
+}
+
+static bool _load_icons_cache(const String &p_path, uint32_t p_key, Vector<EditorIconJob> &r_jobs) {
+
+	FileAccess *f = FileAccess::open(p_path, FileAccess::READ);
+	if (!f)
+		return false;
+
+	bool valid = f->get_32() == EDITOR_ICONS_CACHE_VERSION && f->get_32() == p_key && f->get_32() == (uint32_t)r_jobs.size();
+
+	for (int i = 0; valid && i < r_jobs.size(); i++) {
+
+		int w = f->get_32();
+		int h = f->get_32();
+		Image::Format format = Image::Format(f->get_32());
+		uint32_t len = f->get_32();
+
+		if (f->eof_reached() || w <= 0 || h <= 0 || w > Image::MAX_WIDTH || h > Image::MAX_HEIGHT || format >= Image::FORMAT_MAX || len != (uint32_t)Image::get_image_data_size(w, h, format, false)) {
+			valid = false;
+			break;
+		}
+
+		PoolVector<uint8_t> data;
+		data.resize(len);
+		{
+			PoolVector<uint8_t>::Write wr = data.write();
+			valid = f->get_buffer(wr.ptr(), len) == (int)len;
+		}
+
+		if (valid) {
+			r_jobs.write[i].image.instance();
+			r_jobs.write[i].image->create(w, h, false, format, data);
+		}
+	}
+
+	memdelete(f);
+	return valid;
+}
+
+static void _save_icons_cache(const String &p_path, uint32_t p_key, const Vector<EditorIconJob> &p_jobs) {
+
+	for (int i = 0; i < p_jobs.size(); i++) {
+		if (p_jobs[i].image->empty())
+			return; //don't cache a failed rasterization
+	}
+
+	FileAccess *f = FileAccess::open(p_path, FileAccess::WRITE);
+	if (!f)
+		return;
+
+	f->store_32(EDITOR_ICONS_CACHE_VERSION);
+	f->store_32(p_key);
+	f->store_32(p_jobs.size());
+
+	for (int i = 0; i < p_jobs.size(); i++) {
+
+		const Ref<Image> &img = p_jobs[i].image;
+		PoolVector<uint8_t> data = img->get_data();
+		f->store_32(img->get_width());
+		f->store_32(img->get_height());
+		f->store_32(img->get_format());
+		f->store_32(data.size());
+		PoolVector<uint8_t>::Read r = data.read();
+		f->store_buffer(r.ptr(), data.size());
+	}
+
+	memdelete(f);
+}
+
 #ifndef ADD_CONVERT_COLOR
 #define ADD_CONVERT_COLOR(dictionary, old_color, new_color) dictionary[Color::html(old_color)] = Color::html(new_color)
 #endif
@@ -194,13 +305,14 @@ void editor_register_and_generate_icons(Ref<Theme> p_theme, bool p_dark_theme =
 
 	ImageLoaderSVG::set_convert_colors(&dark_icon_color_dictionary);
 
+	Vector<EditorIconJob> jobs;
+
 	// generate icons
 	if (!p_only_thumbs)
 		for (int i = 0; i < editor_icons_count; i++) {
 			List<String>::Element *is_exception = exceptions.find(editor_icons_names[i]);
 			if (is_exception) exceptions.erase(is_exception);
-			Ref<ImageTexture> icon = editor_generate_icon(i, !is_exception);
-			p_theme->set_icon(editor_icons_names[i], "EditorIcons", icon);
+			_add_icon_job(jobs, i, !is_exception);
 		}
 
 	// generate thumb files with the given thumb size
@@ -211,8 +323,7 @@ void editor_register_and_generate_icons(Ref<Theme> p_theme, bool p_dark_theme =
 			int index = editor_bg_thumbs_indices[i];
 			List<String>::Element *is_exception = exceptions.find(editor_icons_names[index]);
 			if (is_exception) exceptions.erase(is_exception);
-			Ref<ImageTexture> icon = editor_generate_icon(index, !p_dark_theme && !is_exception, scale, force_filter);
-			p_theme->set_icon(editor_icons_names[index], "EditorIcons", icon);
+			_add_icon_job(jobs, index, !p_dark_theme && !is_exception, scale, force_filter);
 		}
 	} else {
 		float scale = (float)p_thumb_size / 32.0 * EDSCALE;
@@ -220,11 +331,32 @@ void editor_register_and_generate_icons(Ref<Theme> p_theme, bool p_dark_theme =
 			int index = editor_md_thumbs_indices[i];
 			List<String>::Element *is_exception = exceptions.find(editor_icons_names[index]);
 			if (is_exception) exceptions.erase(is_exception);
-			Ref<ImageTexture> icon = editor_generate_icon(index, !p_dark_theme && !is_exception, scale, force_filter);
-			p_theme->set_icon(editor_icons_names[index], "EditorIcons", icon);
+			_add_icon_job(jobs, index, !p_dark_theme && !is_exception, scale, force_filter);
+		}
+	}
+
+	String cache_path;
+	uint32_t cache_key = 0;
+	if (EditorSettings::get_singleton()) {
+		cache_path = EditorSettings::get_singleton()->get_cache_dir().plus_file(p_only_thumbs ? "editor_thumbs.cache" : "editor_icons.cache");
+		cache_key = _get_icons_cache_key(jobs, dark_icon_color_dictionary);
+	}
+
+	if (cache_path == String() || !_load_icons_cache(cache_path, cache_key, jobs)) {
+
+		EditorIconRasterizer rasterizer;
+		rasterizer.jobs = jobs.ptrw();
+		thread_process_array(jobs.size(), &rasterizer, &EditorIconRasterizer::rasterize, (void *)NULL);
+
+		if (cache_path != String()) {
+			_save_icons_cache(cache_path, cache_key, jobs);
 		}
 	}
 
+	for (int i = 0; i < jobs.size(); i++) {
+		p_theme->set_icon(editor_icons_names[jobs[i].index], "EditorIcons", _make_icon_texture(jobs[i]));
+	}
+
 	ImageLoaderSVG::set_convert_colors(NULL);
 #else
 	print_line("SVG support disabled, editor icons won't be rendered.");
@@ -33,6 +33,7 @@
 #include "core/math/math_defs.h"
 #include "core/os/file_access.h"
 #include "core/os/os.h"
+#include "core/os/threaded_array_processor.h"
 #include "scene/3d/camera.h"
 #include "scene/3d/mesh_instance.h"
 #include "scene/animation/animation_player.h"
@@ -496,12 +497,14 @@ Error EditorSceneImporterGLTF::_decode_buffer_view(GLTFState &state, int p_buffe
 	ERR_FAIL_INDEX_V(bv.buffer, state.buffers.size(), ERR_PARSE_ERROR);
 
 	uint32_t offset = bv.byte_offset + byte_offset;
-	Vector<uint8_t> buffer = state.buffers[bv.buffer]; //copy on write, so no performance hit
+	const Vector<uint8_t> &buffer = state.buffers[bv.buffer];
 	const uint8_t *bufptr = buffer.ptr();
 
-	//use to debug
-	print_verbose("glTF: type " + _get_type_name(type) + " component type: " + _get_component_type_name(component_type) + " stride: " + itos(stride) + " amount " + itos(count));
-	print_verbose("glTF: accessor offset" + itos(byte_offset) + " view offset: " + itos(bv.byte_offset) + " total buffer len: " + itos(buffer.size()) + " view len " + itos(bv.byte_length));
+	//use to debug, only build the strings when they will be printed
+	if (OS::get_singleton()->is_stdout_verbose()) {
+		print_line("glTF: type " + _get_type_name(type) + " component type: " + _get_component_type_name(component_type) + " stride: " + itos(stride) + " amount " + itos(count));
+		print_line("glTF: accessor offset" + itos(byte_offset) + " view offset: " + itos(bv.byte_offset) + " total buffer len: " + itos(buffer.size()) + " view len " + itos(bv.byte_length));
+	}
 
 	int buffer_end = (stride * (count - 1)) + element_size;
 	ERR_FAIL_COND_V(buffer_end > bv.byte_length, ERR_PARSE_ERROR);
@@ -586,6 +589,45 @@ int EditorSceneImporterGLTF::_get_component_type_size(int component_type) {
 	return 0;
 }
 
+const uint8_t *EditorSceneImporterGLTF::_map_float_accessor(GLTFState &state, int p_accessor, bool p_for_vertex, int &r_stride, int &r_components) {
+
+	//plain float accessors can be read straight from the loaded buffer, without
+	//going through the generic (double) decoder. anything else returns NULL and
+	//takes the slow path, which also takes care of reporting errors.
+
+	ERR_FAIL_INDEX_V(p_accessor, state.accessors.size(), NULL);
+
+	const GLTFAccessor &a = state.accessors[p_accessor];
+
+	if (a.component_type != COMPONENT_TYPE_FLOAT || a.sparse_count > 0 || a.buffer_view < 0 || a.buffer_view >= state.buffer_views.size() || a.count <= 0 || a.type > TYPE_VEC4) {
+		return NULL;
+	}
+
+	const GLTFBufferView &bv = state.buffer_views[a.buffer_view];
+	if (bv.buffer < 0 || bv.buffer >= state.buffers.size()) {
+		return NULL;
+	}
+
+	int components = a.type + 1; //scalar and vectors only
+	int element_size = components * 4;
+	int stride = bv.byte_stride ? bv.byte_stride : element_size;
+	if (p_for_vertex && stride % 4) {
+		stride += 4 - (stride % 4);
+	}
+
+	uint32_t offset = bv.byte_offset + a.byte_offset;
+	int buffer_end = (stride * (a.count - 1)) + element_size;
+	const Vector<uint8_t> &buffer = state.buffers[bv.buffer];
+
+	if (buffer_end > bv.byte_length || (int)(offset + buffer_end) > buffer.size() || offset % 4) {
+		return NULL;
+	}
+
+	r_stride = stride;
+	r_components = components;
+	return buffer.ptr() + offset;
+}
+
 Vector<double> EditorSceneImporterGLTF::_decode_accessor(GLTFState &state, int p_accessor, bool p_for_vertex) {
 
 	//spec, for reference:
@@ -701,6 +743,24 @@ PoolVector<int> EditorSceneImporterGLTF::_decode_accessor_as_ints(GLTFState &sta
 
 PoolVector<float> EditorSceneImporterGLTF::_decode_accessor_as_floats(GLTFState &state, int p_accessor, bool p_for_vertex) {
 
+	int stride;
+	int components;
+	const uint8_t *src = _map_float_accessor(state, p_accessor, p_for_vertex, stride, components);
+	if (src) {
+		PoolVector<float> ret;
+		int count = state.accessors[p_accessor].count;
+		ret.resize(count * components);
+		PoolVector<float>::Write w = ret.write();
+		if (stride == components * 4) {
+			copymem(w.ptr(), src, count * stride);
+		} else {
+			for (int i = 0; i < count; i++) {
+				copymem(&w[i * components], src + i * stride, components * 4);
+			}
+		}
+		return ret;
+	}
+
 	Vector<double> attribs = _decode_accessor(state, p_accessor, p_for_vertex);
 	PoolVector<float> ret;
 	if (attribs.size() == 0)
@@ -719,6 +779,21 @@ PoolVector<float> EditorSceneImporterGLTF::_decode_accessor_as_floats(GLTFState
 
 PoolVector<Vector2> EditorSceneImporterGLTF::_decode_accessor_as_vec2(GLTFState &state, int p_accessor, bool p_for_vertex) {
 
+	int stride;
+	int components;
+	const uint8_t *src = _map_float_accessor(state, p_accessor, p_for_vertex, stride, components);
+	if (src && components == 2) {
+		PoolVector<Vector2> ret;
+		int count = state.accessors[p_accessor].count;
+		ret.resize(count);
+		PoolVector<Vector2>::Write w = ret.write();
+		for (int i = 0; i < count; i++) {
+			const float *f = (const float *)(src + i * stride);
+			w[i] = Vector2(f[0], f[1]);
+		}
+		return ret;
+	}
+
 	Vector<double> attribs = _decode_accessor(state, p_accessor, p_for_vertex);
 	PoolVector<Vector2> ret;
 	if (attribs.size() == 0)
@@ -738,6 +813,21 @@ PoolVector<Vector2> EditorSceneImporterGLTF::_decode_accessor_as_vec2(GLTFState
 
 PoolVector<Vector3> EditorSceneImporterGLTF::_decode_accessor_as_vec3(GLTFState &state, int p_accessor, bool p_for_vertex) {
 
+	int stride;
+	int components;
+	const uint8_t *src = _map_float_accessor(state, p_accessor, p_for_vertex, stride, components);
+	if (src && components == 3) {
+		PoolVector<Vector3> ret;
+		int count = state.accessors[p_accessor].count;
+		ret.resize(count);
+		PoolVector<Vector3>::Write w = ret.write();
+		for (int i = 0; i < count; i++) {
+			const float *f = (const float *)(src + i * stride);
+			w[i] = Vector3(f[0], f[1], f[2]);
+		}
+		return ret;
+	}
+
 	Vector<double> attribs = _decode_accessor(state, p_accessor, p_for_vertex);
 	PoolVector<Vector3> ret;
 	if (attribs.size() == 0)
@@ -844,283 +934,327 @@ Vector<Transform> EditorSceneImporterGLTF::_decode_accessor_as_xform(GLTFState &
 	return ret;
 }
 
-Error EditorSceneImporterGLTF::_parse_meshes(GLTFState &state) {
+Error EditorSceneImporterGLTF::_parse_primitive(GLTFState &state, GLTFPrimitive &r_primitive) {
 
-	if (!state.json.has("meshes"))
-		return OK;
+	Dictionary p = r_primitive.primitive;
 
-	Array meshes = state.json["meshes"];
-	for (int i = 0; i < meshes.size(); i++) {
+	Array array;
+	array.resize(Mesh::ARRAY_MAX);
 
-		print_verbose("glTF: Parsing mesh: " + itos(i));
-		Dictionary d = meshes[i];
+	ERR_FAIL_COND_V(!p.has("attributes"), ERR_PARSE_ERROR);
 
-		GLTFMesh mesh;
-		mesh.mesh.instance();
+	Dictionary a = p["attributes"];
 
-		ERR_FAIL_COND_V(!d.has("primitives"), ERR_PARSE_ERROR);
+	Mesh::PrimitiveType primitive = Mesh::PRIMITIVE_TRIANGLES;
+	if (p.has("mode")) {
+		int mode = p["mode"];
+		ERR_FAIL_INDEX_V(mode, 7, ERR_FILE_CORRUPT);
+		static const Mesh::PrimitiveType primitives2[7] = {
+			Mesh::PRIMITIVE_POINTS,
+			Mesh::PRIMITIVE_LINES,
+			Mesh::PRIMITIVE_LINE_LOOP,
+			Mesh::PRIMITIVE_LINE_STRIP,
+			Mesh::PRIMITIVE_TRIANGLES,
+			Mesh::PRIMITIVE_TRIANGLE_STRIP,
+			Mesh::PRIMITIVE_TRIANGLE_FAN,
+		};
 
-		Array primitives = d["primitives"];
-		Dictionary extras = d.has("extras") ? (Dictionary)d["extras"] : Dictionary();
+		primitive = primitives2[mode];
+	}
 
-		for (int j = 0; j < primitives.size(); j++) {
+	ERR_FAIL_COND_V(!a.has("POSITION"), ERR_PARSE_ERROR);
+	if (a.has("POSITION")) {
+		array[Mesh::ARRAY_VERTEX] = _decode_accessor_as_vec3(state, a["POSITION"], true);
+	}
 
-			Dictionary p = primitives[j];
+	if (a.has("NORMAL")) {
+		array[Mesh::ARRAY_NORMAL] = _decode_accessor_as_vec3(state, a["NORMAL"], true);
+	}
+	if (a.has("TANGENT")) {
+		array[Mesh::ARRAY_TANGENT] = _decode_accessor_as_floats(state, a["TANGENT"], true);
+	}
+	if (a.has("TEXCOORD_0")) {
+		array[Mesh::ARRAY_TEX_UV] = _decode_accessor_as_vec2(state, a["TEXCOORD_0"], true);
+	}
+	if (a.has("TEXCOORD_1")) {
+		array[Mesh::ARRAY_TEX_UV2] = _decode_accessor_as_vec2(state, a["TEXCOORD_1"], true);
+	}
+	if (a.has("COLOR_0")) {
+		array[Mesh::ARRAY_COLOR] = _decode_accessor_as_color(state, a["COLOR_0"], true);
+	}
+	if (a.has("JOINTS_0")) {
+		array[Mesh::ARRAY_BONES] = _decode_accessor_as_ints(state, a["JOINTS_0"], true);
+	}
+	if (a.has("WEIGHTS_0")) {
+		PoolVector<float> weights = _decode_accessor_as_floats(state, a["WEIGHTS_0"], true);
+		{ //gltf does not seem to normalize the weights for some reason..
+			int wc = weights.size();
+			PoolVector<float>::Write w = weights.write();
+
+			//PoolVector<int> v = array[Mesh::ARRAY_BONES];
+			//PoolVector<int>::Read r = v.read();
+
+			for (int k = 0; k < wc; k += 4) {
+				float total = 0.0;
+				total += w[k + 0];
+				total += w[k + 1];
+				total += w[k + 2];
+				total += w[k + 3];
+				if (total > 0.0) {
+					w[k + 0] /= total;
+					w[k + 1] /= total;
+					w[k + 2] /= total;
+					w[k + 3] /= total;
+				}
 
-			Array array;
-			array.resize(Mesh::ARRAY_MAX);
+				//print_verbose(itos(j / 4) + ": " + itos(r[j + 0]) + ":" + rtos(w[j + 0]) + ", " + itos(r[j + 1]) + ":" + rtos(w[j + 1]) + ", " + itos(r[j + 2]) + ":" + rtos(w[j + 2]) + ", " + itos(r[j + 3]) + ":" + rtos(w[j + 3]));
+			}
+		}
+		array[Mesh::ARRAY_WEIGHTS] = weights;
+	}
 
-			ERR_FAIL_COND_V(!p.has("attributes"), ERR_PARSE_ERROR);
+	if (p.has("indices")) {
 
-			Dictionary a = p["attributes"];
+		PoolVector<int> indices = _decode_accessor_as_ints(state, p["indices"], false);
 
-			Mesh::PrimitiveType primitive = Mesh::PRIMITIVE_TRIANGLES;
-			if (p.has("mode")) {
-				int mode = p["mode"];
-				ERR_FAIL_INDEX_V(mode, 7, ERR_FILE_CORRUPT);
-				static const Mesh::PrimitiveType primitives2[7] = {
-					Mesh::PRIMITIVE_POINTS,
-					Mesh::PRIMITIVE_LINES,
-					Mesh::PRIMITIVE_LINE_LOOP,
-					Mesh::PRIMITIVE_LINE_STRIP,
-					Mesh::PRIMITIVE_TRIANGLES,
-					Mesh::PRIMITIVE_TRIANGLE_STRIP,
-					Mesh::PRIMITIVE_TRIANGLE_FAN,
-				};
+		if (primitive == Mesh::PRIMITIVE_TRIANGLES) {
+			//swap around indices, convert ccw to cw for front face
 
-				primitive = primitives2[mode];
+			int is = indices.size();
+			PoolVector<int>::Write w = indices.write();
+			for (int k = 0; k < is; k += 3) {
+				SWAP(w[k + 1], w[k + 2]);
 			}
-
-			ERR_FAIL_COND_V(!a.has("POSITION"), ERR_PARSE_ERROR);
-			if (a.has("POSITION")) {
-				array[Mesh::ARRAY_VERTEX] = _decode_accessor_as_vec3(state, a["POSITION"], true);
+		}
+		array[Mesh::ARRAY_INDEX] = indices;
+	} else if (primitive == Mesh::PRIMITIVE_TRIANGLES) {
+		//generate indices because they need to be swapped for CW/CCW
+		PoolVector<Vector3> vertices = array[Mesh::ARRAY_VERTEX];
+		ERR_FAIL_COND_V(vertices.size() == 0, ERR_PARSE_ERROR);
+		PoolVector<int> indices;
+		int vs = vertices.size();
+		indices.resize(vs);
+		{
+			PoolVector<int>::Write w = indices.write();
+			for (int k = 0; k < vs; k += 3) {
+				w[k] = k;
+				w[k + 1] = k + 2;
+				w[k + 2] = k + 1;
 			}
+		}
+		array[Mesh::ARRAY_INDEX] = indices;
+	}
 
-			if (a.has("NORMAL")) {
-				array[Mesh::ARRAY_NORMAL] = _decode_accessor_as_vec3(state, a["NORMAL"], true);
-			}
-			if (a.has("TANGENT")) {
-				array[Mesh::ARRAY_TANGENT] = _decode_accessor_as_floats(state, a["TANGENT"], true);
-			}
-			if (a.has("TEXCOORD_0")) {
-				array[Mesh::ARRAY_TEX_UV] = _decode_accessor_as_vec2(state, a["TEXCOORD_0"], true);
-			}
-			if (a.has("TEXCOORD_1")) {
-				array[Mesh::ARRAY_TEX_UV2] = _decode_accessor_as_vec2(state, a["TEXCOORD_1"], true);
-			}
-			if (a.has("COLOR_0")) {
-				array[Mesh::ARRAY_COLOR] = _decode_accessor_as_color(state, a["COLOR_0"], true);
+	bool generated_tangents = false;
+
+	if (primitive == Mesh::PRIMITIVE_TRIANGLES && !a.has("TANGENT") && a.has("TEXCOORD_0") && a.has("NORMAL")) {
+		//must generate mikktspace tangents.. ergh..
+		Ref<SurfaceTool> st;
+		st.instance();
+		st->create_from_triangle_arrays(array);
+		if (p.has("targets")) {
+			//morph targets should not be reindexed, as array size might differ
+			//removing indices is the best bet here
+			st->deindex();
+		}
+		st->generate_tangents();
+		array = st->commit_to_arrays();
+		generated_tangents = true;
+	}
+
+	//blend shapes
+	if (p.has("targets")) {
+		print_verbose("glTF: Mesh has targets");
+		Array targets = p["targets"];
+
+		for (int k = 0; k < targets.size(); k++) {
+
+			Dictionary t = targets[k];
+
+			Array array_copy;
+			array_copy.resize(Mesh::ARRAY_MAX);
+
+			for (int l = 0; l < Mesh::ARRAY_MAX; l++) {
+				array_copy[l] = array[l];
 			}
-			if (a.has("JOINTS_0")) {
-				array[Mesh::ARRAY_BONES] = _decode_accessor_as_ints(state, a["JOINTS_0"], true);
+
+			array_copy[Mesh::ARRAY_INDEX] = Variant();
+
+			if (t.has("POSITION")) {
+				PoolVector<Vector3> varr = _decode_accessor_as_vec3(state, t["POSITION"], true);
+				PoolVector<Vector3> src_varr = array[Mesh::ARRAY_VERTEX];
+				int size = src_varr.size();
+				ERR_FAIL_COND_V(size == 0, ERR_PARSE_ERROR);
+				{
+
+					int max_idx = varr.size();
+					varr.resize(size);
+
+					PoolVector<Vector3>::Write w_varr = varr.write();
+					PoolVector<Vector3>::Read r_varr = varr.read();
+					PoolVector<Vector3>::Read r_src_varr = src_varr.read();
+					for (int l = 0; l < size; l++) {
+						if (l < max_idx) {
+							w_varr[l] = r_varr[l] + r_src_varr[l];
+						} else {
+							w_varr[l] = r_src_varr[l];
+						}
+					}
+				}
+				array_copy[Mesh::ARRAY_VERTEX] = varr;
 			}
-			if (a.has("WEIGHTS_0")) {
-				PoolVector<float> weights = _decode_accessor_as_floats(state, a["WEIGHTS_0"], true);
-				{ //gltf does not seem to normalize the weights for some reason..
-					int wc = weights.size();
-					PoolVector<float>::Write w = weights.write();
-
-					//PoolVector<int> v = array[Mesh::ARRAY_BONES];
-					//PoolVector<int>::Read r = v.read();
-
-					for (int k = 0; k < wc; k += 4) {
-						float total = 0.0;
-						total += w[k + 0];
-						total += w[k + 1];
-						total += w[k + 2];
-						total += w[k + 3];
-						if (total > 0.0) {
-							w[k + 0] /= total;
-							w[k + 1] /= total;
-							w[k + 2] /= total;
-							w[k + 3] /= total;
+			if (t.has("NORMAL")) {
+				PoolVector<Vector3> narr = _decode_accessor_as_vec3(state, t["NORMAL"], true);
+				PoolVector<Vector3> src_narr = array[Mesh::ARRAY_NORMAL];
+				int size = src_narr.size();
+				ERR_FAIL_COND_V(size == 0, ERR_PARSE_ERROR);
+				{
+					int max_idx = narr.size();
+					narr.resize(size);
+
+					PoolVector<Vector3>::Write w_narr = narr.write();
+					PoolVector<Vector3>::Read r_narr = narr.read();
+					PoolVector<Vector3>::Read r_src_narr = src_narr.read();
+					for (int l = 0; l < size; l++) {
+						if (l < max_idx) {
+							w_narr[l] = r_narr[l] + r_src_narr[l];
+						} else {
+							w_narr[l] = r_src_narr[l];
 						}
-
-						//print_verbose(itos(j / 4) + ": " + itos(r[j + 0]) + ":" + rtos(w[j + 0]) + ", " + itos(r[j + 1]) + ":" + rtos(w[j + 1]) + ", " + itos(r[j + 2]) + ":" + rtos(w[j + 2]) + ", " + itos(r[j + 3]) + ":" + rtos(w[j + 3]));
 					}
 				}
-				array[Mesh::ARRAY_WEIGHTS] = weights;
+				array_copy[Mesh::ARRAY_NORMAL] = narr;
 			}
+			if (t.has("TANGENT")) {
+				PoolVector<Vector3> tangents_v3 = _decode_accessor_as_vec3(state, t["TANGENT"], true);
+				PoolVector<float> tangents_v4;
+				PoolVector<float> src_tangents = array[Mesh::ARRAY_TANGENT];
+				ERR_FAIL_COND_V(src_tangents.size() == 0, ERR_PARSE_ERROR);
 
-			if (p.has("indices")) {
+				{
 
-				PoolVector<int> indices = _decode_accessor_as_ints(state, p["indices"], false);
+					int max_idx = tangents_v3.size();
 
-				if (primitive == Mesh::PRIMITIVE_TRIANGLES) {
-					//swap around indices, convert ccw to cw for front face
+					int size4 = src_tangents.size();
+					tangents_v4.resize(size4);
+					PoolVector<float>::Write w4 = tangents_v4.write();
 
-					int is = indices.size();
-					PoolVector<int>::Write w = indices.write();
-					for (int k = 0; k < is; k += 3) {
-						SWAP(w[k + 1], w[k + 2]);
-					}
-				}
-				array[Mesh::ARRAY_INDEX] = indices;
-			} else if (primitive == Mesh::PRIMITIVE_TRIANGLES) {
-				//generate indices because they need to be swapped for CW/CCW
-				PoolVector<Vector3> vertices = array[Mesh::ARRAY_VERTEX];
-				ERR_FAIL_COND_V(vertices.size() == 0, ERR_PARSE_ERROR);
-				PoolVector<int> indices;
-				int vs = vertices.size();
-				indices.resize(vs);
-				{
-					PoolVector<int>::Write w = indices.write();
-					for (int k = 0; k < vs; k += 3) {
-						w[k] = k;
-						w[k + 1] = k + 2;
-						w[k + 2] = k + 1;
+					PoolVector<Vector3>::Read r3 = tangents_v3.read();
+					PoolVector<float>::Read r4 = src_tangents.read();
+
+					for (int l = 0; l < size4 / 4; l++) {
+
+						if (l < max_idx) {
+							w4[l * 4 + 0] = r3[l].x + r4[l * 4 + 0];
+							w4[l * 4 + 1] = r3[l].y + r4[l * 4 + 1];
+							w4[l * 4 + 2] = r3[l].z + r4[l * 4 + 2];
+						} else {
+							w4[l * 4 + 0] = r4[l * 4 + 0];
+							w4[l * 4 + 1] = r4[l * 4 + 1];
+							w4[l * 4 + 2] = r4[l * 4 + 2];
+						}
+						w4[l * 4 + 3] = r4[l * 4 + 3]; //copy flip value
 					}
 				}
-				array[Mesh::ARRAY_INDEX] = indices;
-			}
 
-			bool generated_tangents = false;
-			Variant erased_indices;
+				array_copy[Mesh::ARRAY_TANGENT] = tangents_v4;
+			}
 
-			if (primitive == Mesh::PRIMITIVE_TRIANGLES && !a.has("TANGENT") && a.has("TEXCOORD_0") && a.has("NORMAL")) {
-				//must generate mikktspace tangents.. ergh..
+			if (generated_tangents) {
 				Ref<SurfaceTool> st;
 				st.instance();
-				st->create_from_triangle_arrays(array);
-				if (p.has("targets")) {
-					//morph targets should not be reindexed, as array size might differ
-					//removing indices is the best bet here
-					st->deindex();
-					erased_indices = a[Mesh::ARRAY_INDEX];
-					a[Mesh::ARRAY_INDEX] = Variant();
-				}
+				st->create_from_triangle_arrays(array_copy);
+				st->deindex();
 				st->generate_tangents();
-				array = st->commit_to_arrays();
-				generated_tangents = true;
+				array_copy = st->commit_to_arrays();
 			}
 
-			Array morphs;
-			//blend shapes
-			if (p.has("targets")) {
-				print_verbose("glTF: Mesh has targets");
-				Array targets = p["targets"];
+			r_primitive.morphs.push_back(array_copy);
+		}
+	}
 
-				//ideally BLEND_SHAPE_MODE_RELATIVE since gltf2 stores in displacement
-				//but it could require a larger refactor?
-				mesh.mesh->set_blend_shape_mode(Mesh::BLEND_SHAPE_MODE_NORMALIZED);
+	r_primitive.type = primitive;
+	r_primitive.arrays = array;
 
-				if (j == 0) {
-					Array target_names = extras.has("targetNames") ? (Array)extras["targetNames"] : Array();
-					for (int k = 0; k < targets.size(); k++) {
-						String name = k < target_names.size() ? (String)target_names[k] : String("morph_") + itos(k);
-						mesh.mesh->add_blend_shape(name);
-					}
-				}
+	return OK;
+}
 
-				for (int k = 0; k < targets.size(); k++) {
+void EditorSceneImporterGLTF::_parse_primitive_thread(uint32_t p_index, GLTFPrimitiveBuild *p_build) {
 
-					Dictionary t = targets[k];
+	GLTFPrimitive &primitive = p_build->primitives[p_index];
+	primitive.err = _parse_primitive(*p_build->state, primitive);
+}
 
-					Array array_copy;
-					array_copy.resize(Mesh::ARRAY_MAX);
+Error EditorSceneImporterGLTF::_parse_meshes(GLTFState &state) {
 
-					for (int l = 0; l < Mesh::ARRAY_MAX; l++) {
-						array_copy[l] = array[l];
-					}
+	if (!state.json.has("meshes"))
+		return OK;
 
-					array_copy[Mesh::ARRAY_INDEX] = Variant();
-
-					if (t.has("POSITION")) {
-						PoolVector<Vector3> varr = _decode_accessor_as_vec3(state, t["POSITION"], true);
-						PoolVector<Vector3> src_varr = array[Mesh::ARRAY_VERTEX];
-						int size = src_varr.size();
-						ERR_FAIL_COND_V(size == 0, ERR_PARSE_ERROR);
-						{
-
-							int max_idx = varr.size();
-							varr.resize(size);
-
-							PoolVector<Vector3>::Write w_varr = varr.write();
-							PoolVector<Vector3>::Read r_varr = varr.read();
-							PoolVector<Vector3>::Read r_src_varr = src_varr.read();
-							for (int l = 0; l < size; l++) {
-								if (l < max_idx) {
-									w_varr[l] = r_varr[l] + r_src_varr[l];
-								} else {
-									w_varr[l] = r_src_varr[l];
-								}
-							}
-						}
-						array_copy[Mesh::ARRAY_VERTEX] = varr;
-					}
-					if (t.has("NORMAL")) {
-						PoolVector<Vector3> narr = _decode_accessor_as_vec3(state, t["NORMAL"], true);
-						PoolVector<Vector3> src_narr = array[Mesh::ARRAY_NORMAL];
-						int size = src_narr.size();
-						ERR_FAIL_COND_V(size == 0, ERR_PARSE_ERROR);
-						{
-							int max_idx = narr.size();
-							narr.resize(size);
-
-							PoolVector<Vector3>::Write w_narr = narr.write();
-							PoolVector<Vector3>::Read r_narr = narr.read();
-							PoolVector<Vector3>::Read r_src_narr = src_narr.read();
-							for (int l = 0; l < size; l++) {
-								if (l < max_idx) {
-									w_narr[l] = r_narr[l] + r_src_narr[l];
-								} else {
-									w_narr[l] = r_src_narr[l];
-								}
-							}
-						}
-						array_copy[Mesh::ARRAY_NORMAL] = narr;
-					}
-					if (t.has("TANGENT")) {
-						PoolVector<Vector3> tangents_v3 = _decode_accessor_as_vec3(state, t["TANGENT"], true);
-						PoolVector<float> tangents_v4;
-						PoolVector<float> src_tangents = array[Mesh::ARRAY_TANGENT];
-						ERR_FAIL_COND_V(src_tangents.size() == 0, ERR_PARSE_ERROR);
-
-						{
-
-							int max_idx = tangents_v3.size();
-
-							int size4 = src_tangents.size();
-							tangents_v4.resize(size4);
-							PoolVector<float>::Write w4 = tangents_v4.write();
-
-							PoolVector<Vector3>::Read r3 = tangents_v3.read();
-							PoolVector<float>::Read r4 = src_tangents.read();
-
-							for (int l = 0; l < size4 / 4; l++) {
-
-								if (l < max_idx) {
-									w4[l * 4 + 0] = r3[l].x + r4[l * 4 + 0];
-									w4[l * 4 + 1] = r3[l].y + r4[l * 4 + 1];
-									w4[l * 4 + 2] = r3[l].z + r4[l * 4 + 2];
-								} else {
-									w4[l * 4 + 0] = r4[l * 4 + 0];
-									w4[l * 4 + 1] = r4[l * 4 + 1];
-									w4[l * 4 + 2] = r4[l * 4 + 2];
-								}
-								w4[l * 4 + 3] = r4[l * 4 + 3]; //copy flip value
-							}
-						}
+	Array meshes = state.json["meshes"];
 
-						array_copy[Mesh::ARRAY_TANGENT] = tangents_v4;
-					}
+	//decoding accessors, generating tangents and building blend shapes only read from the state,
+	//so every primitive of every mesh is processed in parallel. the resources are created afterwards.
+	Vector<GLTFPrimitive> primitives;
+	Vector<int> mesh_first_primitive;
 
-					if (generated_tangents) {
-						Ref<SurfaceTool> st;
-						st.instance();
-						array_copy[Mesh::ARRAY_INDEX] = erased_indices; //needed for tangent generation, erased by deindex
-						st->create_from_triangle_arrays(array_copy);
-						st->deindex();
-						st->generate_tangents();
-						array_copy = st->commit_to_arrays();
-					}
+	for (int i = 0; i < meshes.size(); i++) {
+
+		Dictionary d = meshes[i];
+		ERR_FAIL_COND_V(!d.has("primitives"), ERR_PARSE_ERROR);
+
+		Array mesh_primitives = d["primitives"];
+		mesh_first_primitive.push_back(primitives.size());
+		for (int j = 0; j < mesh_primitives.size(); j++) {
+			GLTFPrimitive primitive;
+			primitive.primitive = mesh_primitives[j];
+			primitives.push_back(primitive);
+		}
+	}
+	mesh_first_primitive.push_back(primitives.size());
+
+	if (primitives.size()) {
+		GLTFPrimitiveBuild build;
+		build.state = &state;
+		build.primitives = primitives.ptrw();
+		thread_process_array(primitives.size(), this, &EditorSceneImporterGLTF::_parse_primitive_thread, &build);
+	}
+
+	for (int i = 0; i < meshes.size(); i++) {
+
+		print_verbose("glTF: Parsing mesh: " + itos(i));
+		Dictionary d = meshes[i];
+
+		GLTFMesh mesh;
+		mesh.mesh.instance();
+
+		Dictionary extras = d.has("extras") ? (Dictionary)d["extras"] : Dictionary();
+
+		for (int j = mesh_first_primitive[i]; j < mesh_first_primitive[i + 1]; j++) {
+
+			const GLTFPrimitive &primitive = primitives[j];
+			if (primitive.err != OK) {
+				return primitive.err;
+			}
+
+			Dictionary p = primitive.primitive;
 
-					morphs.push_back(array_copy);
+			if (p.has("targets")) {
+				//ideally BLEND_SHAPE_MODE_RELATIVE since gltf2 stores in displacement
+				//but it could require a larger refactor?
+				mesh.mesh->set_blend_shape_mode(Mesh::BLEND_SHAPE_MODE_NORMALIZED);
+
+				if (j == mesh_first_primitive[i]) {
+					Array targets = p["targets"];
+					Array target_names = extras.has("targetNames") ? (Array)extras["targetNames"] : Array();
+					for (int k = 0; k < targets.size(); k++) {
+						String name = k < target_names.size() ? (String)target_names[k] : String("morph_") + itos(k);
+						mesh.mesh->add_blend_shape(name);
+					}
 				}
 			}
 
 			//just add it
-			mesh.mesh->add_surface_from_arrays(primitive, array, morphs);
+			mesh.mesh->add_surface_from_arrays(primitive.type, primitive.arrays, primitive.morphs);
 
 			if (p.has("material")) {
 				int material = p["material"];
@@ -1869,13 +2003,18 @@ struct EditorSceneImporterGLTFInterpolate<Quat> {
 template <class T>
 T EditorSceneImporterGLTF::_interpolate_track(const Vector<float> &p_times, const Vector<T> &p_values, float p_time, GLTFAnimation::Interpolation p_interp) {
 
-	//could use binary search, worth it?
-	int idx = -1;
-	for (int i = 0; i < p_times.size(); i++) {
-		if (p_times[i] > p_time)
-			break;
-		idx++;
+	//times are increasing, find the last key at or before p_time
+	int low = 0;
+	int high = p_times.size();
+	while (low < high) {
+		int middle = (low + high) / 2;
+		if (p_times[middle] > p_time) {
+			high = middle;
+		} else {
+			low = middle + 1;
+		}
 	}
+	int idx = low - 1;
 
 	EditorSceneImporterGLTFInterpolate<T> interp;
 
@@ -1940,6 +2079,66 @@ T EditorSceneImporterGLTF::_interpolate_track(const Vector<float> &p_times, cons
 	ERR_FAIL_V(p_values[0]);
 }
 
+void EditorSceneImporterGLTF::_bake_track_thread(uint32_t p_index, GLTFBakeTrack *p_tracks) {
+
+	GLTFBakeTrack &bake = p_tracks[p_index];
+	const GLTFAnimation::Track &track = *bake.track;
+
+	float time = 0.0;
+	bool last = false;
+	while (true) {
+
+		Vector3 pos = bake.base_pos;
+		Quat rot = bake.base_rot;
+		Vector3 scale = bake.base_scale;
+
+		if (track.translation_track.times.size()) {
+
+			pos = _interpolate_track<Vector3>(track.translation_track.times, track.translation_track.values, time, track.translation_track.interpolation);
+		}
+
+		if (track.rotation_track.times.size()) {
+
+			rot = _interpolate_track<Quat>(track.rotation_track.times, track.rotation_track.values, time, track.rotation_track.interpolation);
+		}
+
+		if (track.scale_track.times.size()) {
+
+			scale = _interpolate_track<Vector3>(track.scale_track.times, track.scale_track.values, time, track.scale_track.interpolation);
+		}
+
+		if (bake.is_bone) {
+
+			Transform xform;
+			//xform.basis = Basis(rot);
+			//xform.basis.scale(scale);
+			xform.basis.set_quat_scale(rot, scale);
+			xform.origin = pos;
+
+			xform = bake.rest_inverse * xform;
+
+			rot = xform.basis.get_rotation_quat();
+			rot.normalize();
+			scale = xform.basis.get_scale();
+			pos = xform.origin;
+		}
+
+		bake.times.push_back(time);
+		bake.positions.push_back(pos);
+		bake.rotations.push_back(rot);
+		bake.scales.push_back(scale);
+
+		if (last) {
+			break;
+		}
+		time += bake.increment;
+		if (time >= bake.length) {
+			last = true;
+			time = bake.length;
+		}
+	}
+}
+
 void EditorSceneImporterGLTF::_import_animation(GLTFState &state, AnimationPlayer *ap, int index, int bake_fps, Vector<Skeleton *> skeletons) {
 
 	const GLTFAnimation &anim = state.animations[index];
@@ -1953,8 +2152,35 @@ void EditorSceneImporterGLTF::_import_animation(GLTFState &state, AnimationPlaye
 	animation.instance();
 	animation->set_name(name);
 
+	//first determine animation length, so every track can be baked on its own
 	float length = 0;
 
+	for (Map<int, GLTFAnimation::Track>::Element *E = anim.tracks.front(); E; E = E->next()) {
+
+		const GLTFAnimation::Track &track = E->get();
+		if (state.nodes[E->key()]->godot_nodes.size() == 0) {
+			continue;
+		}
+
+		for (int i = 0; i < track.rotation_track.times.size(); i++) {
+			length = MAX(length, track.rotation_track.times[i]);
+		}
+		for (int i = 0; i < track.translation_track.times.size(); i++) {
+			length = MAX(length, track.translation_track.times[i]);
+		}
+		for (int i = 0; i < track.scale_track.times.size(); i++) {
+			length = MAX(length, track.scale_track.times[i]);
+		}
+
+		for (int i = 0; i < track.weight_tracks.size(); i++) {
+			for (int j = 0; j < track.weight_tracks[i].times.size(); j++) {
+				length = MAX(length, track.weight_tracks[i].times[j]);
+			}
+		}
+	}
+
+	Vector<GLTFBakeTrack> bake_tracks;
+
 	for (Map<int, GLTFAnimation::Track>::Element *E = anim.tracks.front(); E; E = E->next()) {
 
 		const GLTFAnimation::Track &track = E->get();
@@ -1973,99 +2199,39 @@ void EditorSceneImporterGLTF::_import_animation(GLTFState &state, AnimationPlaye
 				node_path = ap->get_parent()->get_path_to(node->godot_nodes[n]);
 			}
 
-			for (int i = 0; i < track.rotation_track.times.size(); i++) {
-				length = MAX(length, track.rotation_track.times[i]);
-			}
-			for (int i = 0; i < track.translation_track.times.size(); i++) {
-				length = MAX(length, track.translation_track.times[i]);
-			}
-			for (int i = 0; i < track.scale_track.times.size(); i++) {
-				length = MAX(length, track.scale_track.times[i]);
-			}
-
-			for (int i = 0; i < track.weight_tracks.size(); i++) {
-				for (int j = 0; j < track.weight_tracks[i].times.size(); j++) {
-					length = MAX(length, track.weight_tracks[i].times[j]);
-				}
-			}
-
 			if (track.rotation_track.values.size() || track.translation_track.values.size() || track.scale_track.values.size()) {
-				//make transform track
+				//make transform track, keys are baked in parallel below
 				int track_idx = animation->get_track_count();
 				animation->add_track(Animation::TYPE_TRANSFORM);
 				animation->track_set_path(track_idx, node_path);
-				//first determine animation length
 
-				float increment = 1.0 / float(bake_fps);
-				float time = 0.0;
-
-				Vector3 base_pos;
-				Quat base_rot;
-				Vector3 base_scale = Vector3(1, 1, 1);
+				GLTFBakeTrack bake;
+				bake.track = &track;
+				bake.track_idx = track_idx;
+				bake.base_scale = Vector3(1, 1, 1);
+				bake.length = length;
+				bake.increment = 1.0 / float(bake_fps);
 
 				if (!track.rotation_track.values.size()) {
-					base_rot = state.nodes[E->key()]->rotation.normalized();
+					bake.base_rot = node->rotation.normalized();
 				}
 
 				if (!track.translation_track.values.size()) {
-					base_pos = state.nodes[E->key()]->translation;
+					bake.base_pos = node->translation;
 				}
 
 				if (!track.scale_track.values.size()) {
-					base_scale = state.nodes[E->key()]->scale;
+					bake.base_scale = node->scale;
 				}
 
-				bool last = false;
-				while (true) {
-
-					Vector3 pos = base_pos;
-					Quat rot = base_rot;
-					Vector3 scale = base_scale;
-
-					if (track.translation_track.times.size()) {
-
-						pos = _interpolate_track<Vector3>(track.translation_track.times, track.translation_track.values, time, track.translation_track.interpolation);
-					}
-
-					if (track.rotation_track.times.size()) {
-
-						rot = _interpolate_track<Quat>(track.rotation_track.times, track.rotation_track.values, time, track.rotation_track.interpolation);
-					}
-
-					if (track.scale_track.times.size()) {
-
-						scale = _interpolate_track<Vector3>(track.scale_track.times, track.scale_track.values, time, track.scale_track.interpolation);
-					}
-
-					if (node->joints.size()) {
-
-						Transform xform;
-						//xform.basis = Basis(rot);
-						//xform.basis.scale(scale);
-						xform.basis.set_quat_scale(rot, scale);
-						xform.origin = pos;
-
-						Skeleton *skeleton = skeletons[node->joints[n].skin];
-						int bone = node->joints[n].godot_bone_index;
-						xform = skeleton->get_bone_rest(bone).affine_inverse() * xform;
-
-						rot = xform.basis.get_rotation_quat();
-						rot.normalize();
-						scale = xform.basis.get_scale();
-						pos = xform.origin;
-					}
-
-					animation->transform_track_insert_key(track_idx, time, pos, rot, scale);
-
-					if (last) {
-						break;
-					}
-					time += increment;
-					if (time >= length) {
-						last = true;
-						time = length;
-					}
+				bake.is_bone = node->joints.size() > 0;
+				if (bake.is_bone) {
+					Skeleton *skeleton = skeletons[node->joints[n].skin];
+					int bone = node->joints[n].godot_bone_index;
+					bake.rest_inverse = skeleton->get_bone_rest(bone).affine_inverse();
 				}
+
+				bake_tracks.push_back(bake);
 			}
 
 			for (int i = 0; i < track.weight_tracks.size(); i++) {
@@ -2107,6 +2273,19 @@ void EditorSceneImporterGLTF::_import_animation(GLTFState &state, AnimationPlaye
 			}
 		}
 	}
+
+	if (bake_tracks.size()) {
+		thread_process_array(bake_tracks.size(), this, &EditorSceneImporterGLTF::_bake_track_thread, bake_tracks.ptrw());
+	}
+
+	for (int i = 0; i < bake_tracks.size(); i++) {
+
+		const GLTFBakeTrack &bake = bake_tracks[i];
+		for (int j = 0; j < bake.times.size(); j++) {
+			animation->transform_track_insert_key(bake.track_idx, bake.times[j], bake.positions[j], bake.rotations[j], bake.scales[j]);
+		}
+	}
+
 	animation->set_length(length);
 
 	ap->add_animation(name, animation);
@@ -202,6 +202,20 @@ class EditorSceneImporterGLTF : public EditorSceneImporter {
 		Vector<float> blend_weights;
 	};
 
+	struct GLTFPrimitive {
+
+		Dictionary primitive;
+		Mesh::PrimitiveType type;
+		Array arrays;
+		Array morphs;
+		Error err;
+
+		GLTFPrimitive() {
+			type = Mesh::PRIMITIVE_TRIANGLES;
+			err = OK;
+		}
+	};
+
 	struct GLTFCamera {
 
 		bool perspective;
@@ -246,6 +260,23 @@ class EditorSceneImporterGLTF : public EditorSceneImporter {
 		Map<int, Track> tracks;
 	};
 
+	struct GLTFBakeTrack {
+		const GLTFAnimation::Track *track;
+		int track_idx;
+		Vector3 base_pos;
+		Quat base_rot;
+		Vector3 base_scale;
+		bool is_bone;
+		Transform rest_inverse;
+		float length;
+		float increment;
+
+		Vector<float> times;
+		Vector<Vector3> positions;
+		Vector<Quat> rotations;
+		Vector<Vector3> scales;
+	};
+
 	struct GLTFState {
 
 		Dictionary json;
@@ -285,6 +316,11 @@ class EditorSceneImporterGLTF : public EditorSceneImporter {
 		}
 	};
 
+	struct GLTFPrimitiveBuild {
+		GLTFState *state;
+		GLTFPrimitive *primitives;
+	};
+
 	String _gen_unique_name(GLTFState &state, const String &p_name);
 
 	Ref<Texture> _get_texture(GLTFState &state, int p_texture);
@@ -298,6 +334,7 @@ class EditorSceneImporterGLTF : public EditorSceneImporter {
 	Error _parse_buffer_views(GLTFState &state);
 	GLTFType _get_type_from_str(const String &p_string);
 	Error _parse_accessors(GLTFState &state);
+	const uint8_t *_map_float_accessor(GLTFState &state, int p_accessor, bool p_for_vertex, int &r_stride, int &r_components);
 	Error _decode_buffer_view(GLTFState &state, int p_buffer_view, double *dst, int skip_every, int skip_bytes, int element_size, int count, GLTFType type, int component_count, int component_type, int component_size, bool normalized, int byte_offset, bool for_vertex);
 	Vector<double> _decode_accessor(GLTFState &state, int p_accessor, bool p_for_vertex);
 	PoolVector<float> _decode_accessor_as_floats(GLTFState &state, int p_accessor, bool p_for_vertex);
@@ -312,10 +349,13 @@ class EditorSceneImporterGLTF : public EditorSceneImporter {
 
 	void _generate_bone(GLTFState &state, int p_node, Vector<Skeleton *> &skeletons, Node *p_parent_node);
 	void _generate_node(GLTFState &state, int p_node, Node *p_parent, Node *p_owner, Vector<Skeleton *> &skeletons);
+	void _bake_track_thread(uint32_t p_index, GLTFBakeTrack *p_tracks);
 	void _import_animation(GLTFState &state, AnimationPlayer *ap, int index, int bake_fps, Vector<Skeleton *> skeletons);
 
 	Spatial *_generate_scene(GLTFState &state, int p_bake_fps);
 
+	Error _parse_primitive(GLTFState &state, GLTFPrimitive &r_primitive);
+	void _parse_primitive_thread(uint32_t p_index, GLTFPrimitiveBuild *p_build);
 	Error _parse_meshes(GLTFState &state);
 	Error _parse_images(GLTFState &state, const String &p_base_path);
 	Error _parse_textures(GLTFState &state);
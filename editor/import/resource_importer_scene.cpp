@@ -31,8 +31,12 @@
 #include "resource_importer_scene.h"
 
 #include "core/io/resource_saver.h"
+#include "core/math/quick_hull.h"
+#include "core/os/file_access.h"
+#include "core/os/threaded_array_processor.h"
 #include "editor/editor_node.h"
 #include "scene/resources/packed_scene.h"
+#include "thirdparty/misc/md5.h"
 
 #include "scene/3d/collision_shape.h"
 #include "scene/3d/mesh_instance.h"
@@ -44,6 +48,7 @@
 #include "scene/animation/animation_player.h"
 #include "scene/resources/animation.h"
 #include "scene/resources/box_shape.h"
+#include "scene/resources/convex_polygon_shape.h"
 #include "scene/resources/plane_shape.h"
 #include "scene/resources/ray_shape.h"
 #include "scene/resources/resource_format_text.h"
@@ -279,12 +284,315 @@ static String _fixstr(const String &p_what, const String &p_str) {
 	return what;
 }
 
-Node *ResourceImporterScene::_fix_node(Node *p_node, Node *p_root, Map<Ref<ArrayMesh>, Ref<Shape> > &collision_map, LightBakeMode p_light_bake_mode) {
+void ResourceImporterScene::_find_convex_collision_meshes(Node *p_node, Node *p_root, Set<Ref<ArrayMesh> > &r_meshes) {
+
+	for (int i = 0; i < p_node->get_child_count(); i++) {
+		_find_convex_collision_meshes(p_node->get_child(i), p_root, r_meshes);
+	}
+
+	MeshInstance *mi = Object::cast_to<MeshInstance>(p_node);
+	if (!mi) {
+		return;
+	}
+
+	Ref<ArrayMesh> mesh = mi->get_mesh();
+	if (mesh.is_null()) {
+		return;
+	}
+
+	// same rules _fix_node() uses to decide a convex shape is wanted
+	String name = p_node->get_name();
+	if (_teststr(name, "convcolonly")) {
+		if (p_node != p_root) {
+			r_meshes.insert(mesh);
+		}
+	} else if (!_teststr(name, "colonly") && _teststr(name, "convcol")) {
+		r_meshes.insert(mesh);
+	} else if (!_teststr(mesh->get_name(), "col") && _teststr(mesh->get_name(), "convcol")) {
+		r_meshes.insert(mesh);
+	}
+}
+
+class _ConvexHullBuilder {
+public:
+	const Vector<Vector3> *points;
+	Vector<Vector3> *hulls;
+
+	void build(uint32_t p_index, void *p_userdata) {
+		QuickHull::build_vertices(points[p_index], hulls[p_index]);
+	}
+};
+
+void ResourceImporterScene::_gen_convex_collision_shapes(Node *p_scene, Map<Ref<ArrayMesh>, Ref<Shape> > &r_shapes) {
+
+	Set<Ref<ArrayMesh> > mesh_set;
+	_find_convex_collision_meshes(p_scene, p_scene, mesh_set);
+	if (mesh_set.empty()) {
+		return;
+	}
+
+	// gather vertices here, surface data must not be requested from the worker threads
+	Vector<Ref<ArrayMesh> > meshes;
+	Vector<Vector<Vector3> > points;
+
+	for (Set<Ref<ArrayMesh> >::Element *E = mesh_set.front(); E; E = E->next()) {
+
+		Vector<Vector3> vertices;
+		for (int i = 0; i < E->get()->get_surface_count(); i++) {
+
+			Array a = E->get()->surface_get_arrays(i);
+			Vector<Vector3> v = a[Mesh::ARRAY_VERTEX];
+			vertices.append_array(v);
+		}
+
+		if (vertices.size() > 3) {
+			meshes.push_back(E->get());
+			points.push_back(vertices);
+		}
+	}
+
+	Vector<Vector<Vector3> > hulls;
+	hulls.resize(meshes.size());
+
+	// hulls are built in batches so progress can be reported between them
+	const int batch_size = 64;
+	EditorProgress progress("gen_convex_collision", TTR("Generating Convex Collision"), meshes.size());
+
+	for (int from = 0; from < meshes.size(); from += batch_size) {
+
+		progress.step(TTR("Generating for Mesh: ") + meshes[from]->get_name() + " (" + itos(from) + "/" + itos(meshes.size()) + ")", from);
+
+		_ConvexHullBuilder builder;
+		builder.points = points.ptr() + from;
+		builder.hulls = hulls.ptrw() + from;
+		thread_process_array(MIN(batch_size, meshes.size() - from), &builder, &_ConvexHullBuilder::build, (void *)NULL);
+	}
+
+	for (int i = 0; i < meshes.size(); i++) {
+
+		if (hulls[i].size() == 0) {
+			continue; // let the regular path report the error
+		}
+
+		Ref<ConvexPolygonShape> shape = memnew(ConvexPolygonShape);
+		shape->set_points(Variant(hulls[i]));
+		r_shapes[meshes[i]] = shape;
+	}
+}
+
+class _LightmapUnwrapper {
+public:
+	ArrayMesh::LightmapUnwrapJob **jobs;
+	Error *errors;
+
+	void unwrap(uint32_t p_index, void *p_userdata) {
+		errors[p_index] = ArrayMesh::lightmap_unwrap_run(*jobs[p_index]);
+	}
+};
+
+#define LIGHTMAP_UNWRAP_CACHE_MAGIC "GDLU"
+#define LIGHTMAP_UNWRAP_CACHE_VERSION 1
+
+static String _lightmap_unwrap_key(const ArrayMesh::LightmapUnwrapJob &p_job) {
+
+	MD5_CTX md5;
+	MD5Init(&md5);
+	MD5Update(&md5, (unsigned char *)&p_job.texel_size, sizeof(float));
+	MD5Update(&md5, (unsigned char *)p_job.vertices.ptr(), p_job.vertices.size() * sizeof(float));
+	MD5Update(&md5, (unsigned char *)p_job.normals.ptr(), p_job.normals.size() * sizeof(float));
+	MD5Update(&md5, (unsigned char *)p_job.indices.ptr(), p_job.indices.size() * sizeof(int));
+	MD5Update(&md5, (unsigned char *)p_job.face_materials.ptr(), p_job.face_materials.size() * sizeof(int));
+	MD5Final(&md5);
+	return String::md5(md5.digest);
+}
+
+// Unwrap results are stored raw, the cache lives next to the imported scene and is never shared between machines.
+static void _load_lightmap_unwrap_cache(const String &p_path, Map<String, ArrayMesh::LightmapUnwrapJob> &r_cache) {
+
+	FileAccessRef f = FileAccess::open(p_path, FileAccess::READ);
+	if (!f) {
+		return;
+	}
+
+	uint8_t magic[4];
+	f->get_buffer(magic, 4);
+	if (magic[0] != LIGHTMAP_UNWRAP_CACHE_MAGIC[0] || magic[1] != LIGHTMAP_UNWRAP_CACHE_MAGIC[1] || magic[2] != LIGHTMAP_UNWRAP_CACHE_MAGIC[2] || magic[3] != LIGHTMAP_UNWRAP_CACHE_MAGIC[3] || f->get_32() != LIGHTMAP_UNWRAP_CACHE_VERSION) {
+		return;
+	}
+
+	uint32_t count = f->get_32();
+	for (uint32_t i = 0; i < count && !f->eof_reached(); i++) {
+
+		String key = f->get_pascal_string();
+		ArrayMesh::LightmapUnwrapJob job;
+		job.size_hint.x = f->get_32();
+		job.size_hint.y = f->get_32();
+
+		uint32_t vertex_count = f->get_32();
+		uint32_t index_count = f->get_32();
+		if (f->eof_reached() || ((uint64_t)vertex_count * 3 + index_count) * 4 > f->get_len() - f->get_position()) {
+			break; // truncated
+		}
+
+		job.gen_vertices.resize(vertex_count);
+		job.gen_uvs.resize(vertex_count * 2);
+		job.gen_indices.resize(index_count);
+		f->get_buffer((uint8_t *)job.gen_vertices.ptrw(), vertex_count * sizeof(int));
+		f->get_buffer((uint8_t *)job.gen_uvs.ptrw(), vertex_count * 2 * sizeof(float));
+		f->get_buffer((uint8_t *)job.gen_indices.ptrw(), index_count * sizeof(int));
+
+		r_cache[key] = job;
+	}
+}
+
+static void _save_lightmap_unwrap_cache(const String &p_path, const Map<String, ArrayMesh::LightmapUnwrapJob> &p_cache) {
+
+	FileAccessRef f = FileAccess::open(p_path, FileAccess::WRITE);
+	ERR_FAIL_COND(!f);
+
+	f->store_buffer((const uint8_t *)LIGHTMAP_UNWRAP_CACHE_MAGIC, 4);
+	f->store_32(LIGHTMAP_UNWRAP_CACHE_VERSION);
+	f->store_32(p_cache.size());
+
+	for (const Map<String, ArrayMesh::LightmapUnwrapJob>::Element *E = p_cache.front(); E; E = E->next()) {
+
+		const ArrayMesh::LightmapUnwrapJob &job = E->get();
+		f->store_pascal_string(E->key());
+		f->store_32(job.size_hint.x);
+		f->store_32(job.size_hint.y);
+		f->store_32(job.gen_vertices.size());
+		f->store_32(job.gen_indices.size());
+		f->store_buffer((const uint8_t *)job.gen_vertices.ptr(), job.gen_vertices.size() * sizeof(int));
+		f->store_buffer((const uint8_t *)job.gen_uvs.ptr(), job.gen_uvs.size() * sizeof(float));
+		f->store_buffer((const uint8_t *)job.gen_indices.ptr(), job.gen_indices.size() * sizeof(int));
+	}
+}
+
+void ResourceImporterScene::_gen_lightmap_uvs(const Map<Ref<ArrayMesh>, Transform> &p_meshes, float p_texel_size, const String &p_cache_path) {
+
+	// gather surface data here, meshes must not be touched from the worker threads
+	Vector<Ref<ArrayMesh> > meshes;
+	Vector<String> names;
+	Vector<ArrayMesh::LightmapUnwrapJob> jobs;
+	Vector<String> keys;
+
+	for (const Map<Ref<ArrayMesh>, Transform>::Element *E = p_meshes.front(); E; E = E->next()) {
+
+		Ref<ArrayMesh> mesh = E->key();
+		String name = mesh->get_name();
+		if (name == "") { //should not happen but..
+			name = "Mesh " + itos(meshes.size());
+		}
+
+		ArrayMesh::LightmapUnwrapJob job;
+		if (mesh->lightmap_unwrap_prepare(E->get(), p_texel_size, job) != OK) {
+			EditorNode::add_io_error("Mesh '" + name + "' failed lightmap generation. Please fix geometry.");
+			continue;
+		}
+
+		meshes.push_back(mesh);
+		names.push_back(name);
+		keys.push_back(_lightmap_unwrap_key(job));
+		jobs.push_back(job);
+	}
+
+	Map<String, ArrayMesh::LightmapUnwrapJob> cache;
+	_load_lightmap_unwrap_cache(p_cache_path, cache);
+
+	Vector<ArrayMesh::LightmapUnwrapJob *> pending;
+	Vector<Error> errors;
+	errors.resize(jobs.size());
+
+	for (int i = 0; i < jobs.size(); i++) {
+
+		const Map<String, ArrayMesh::LightmapUnwrapJob>::Element *C = cache.find(keys[i]);
+		if (C) {
+			ArrayMesh::LightmapUnwrapJob &job = jobs.write[i];
+			job.gen_vertices = C->get().gen_vertices;
+			job.gen_uvs = C->get().gen_uvs;
+			job.gen_indices = C->get().gen_indices;
+			job.size_hint = C->get().size_hint;
+			errors.write[i] = OK;
+		} else {
+			pending.push_back(&jobs.write[i]);
+		}
+	}
+
+	print_verbose("Lightmap unwrap: " + itos(jobs.size() - pending.size()) + " cached, " + itos(pending.size()) + " to unwrap.");
+
+	if (pending.size()) {
+
+		Vector<Error> pending_errors;
+		pending_errors.resize(pending.size());
+
+		// meshes are unwrapped in batches so progress can be reported between them
+		const int batch_size = 64;
+		EditorProgress progress("gen_lightmaps", TTR("Generating Lightmaps"), pending.size());
+
+		for (int from = 0; from < pending.size(); from += batch_size) {
+
+			progress.step(TTR("Generating Lightmaps") + " (" + itos(from) + "/" + itos(pending.size()) + ")", from);
+
+			_LightmapUnwrapper unwrapper;
+			unwrapper.jobs = pending.ptrw() + from;
+			unwrapper.errors = pending_errors.ptrw() + from;
+			thread_process_array(MIN(batch_size, pending.size() - from), &unwrapper, &_LightmapUnwrapper::unwrap, (void *)NULL);
+		}
+
+		int p = 0;
+		for (int i = 0; i < jobs.size(); i++) {
+			if (p < pending.size() && pending[p] == &jobs[i]) {
+				errors.write[i] = pending_errors[p++];
+			}
+		}
+	}
+
+	Map<String, ArrayMesh::LightmapUnwrapJob> used;
+
+	for (int i = 0; i < jobs.size(); i++) {
+
+		if (errors[i] == OK) {
+			Ref<ArrayMesh> mesh = meshes[i];
+			errors.write[i] = mesh->lightmap_unwrap_apply(jobs[i]);
+		}
+
+		if (errors[i] != OK) {
+			EditorNode::add_io_error("Mesh '" + names[i] + "' failed lightmap generation. Please fix geometry.");
+			continue;
+		}
+
+		// only results are kept, inputs are not needed to apply them again
+		ArrayMesh::LightmapUnwrapJob entry;
+		entry.gen_vertices = jobs[i].gen_vertices;
+		entry.gen_uvs = jobs[i].gen_uvs;
+		entry.gen_indices = jobs[i].gen_indices;
+		entry.size_hint = jobs[i].size_hint;
+		used[keys[i]] = entry;
+	}
+
+	_save_lightmap_unwrap_cache(p_cache_path, used);
+}
+
+Node *ResourceImporterScene::_create_convex_collision_node(MeshInstance *p_mesh_instance, const Map<Ref<ArrayMesh>, Ref<Shape> > &p_convex_shapes) {
+
+	const Map<Ref<ArrayMesh>, Ref<Shape> >::Element *E = p_convex_shapes.find(p_mesh_instance->get_mesh());
+	if (!E) {
+		return p_mesh_instance->create_convex_collision_node();
+	}
+
+	StaticBody *static_body = memnew(StaticBody);
+	CollisionShape *cshape = memnew(CollisionShape);
+	cshape->set_shape(E->get());
+	static_body->add_child(cshape);
+	return static_body;
+}
+
+Node *ResourceImporterScene::_fix_node(Node *p_node, Node *p_root, Map<Ref<ArrayMesh>, Ref<Shape> > &collision_map, const Map<Ref<ArrayMesh>, Ref<Shape> > &p_convex_shapes, LightBakeMode p_light_bake_mode) {
 
 	// children first
 	for (int i = 0; i < p_node->get_child_count(); i++) {
 
-		Node *r = _fix_node(p_node->get_child(i), p_root, collision_map, p_light_bake_mode);
+		Node *r = _fix_node(p_node->get_child(i), p_root, collision_map, p_convex_shapes, p_light_bake_mode);
 		if (!r) {
 			i--; //was erased
 		}
@@ -376,7 +684,7 @@ Node *ResourceImporterScene::_fix_node(Node *p_node, Node *p_root, Map<Ref<Array
 					col->set_name(_fixstr(name, "colonly"));
 				}
 			} else {
-				col = mi->create_convex_collision_node();
+				col = _create_convex_collision_node(mi, p_convex_shapes);
 				if (col == NULL) {
 					ERR_PRINTS("Error generating collision for mesh: " + name);
 				} else {
@@ -491,7 +799,7 @@ Node *ResourceImporterScene::_fix_node(Node *p_node, Node *p_root, Map<Ref<Array
 			if (mi->get_parent() && !mi->get_parent()->has_node(new_name)) {
 				mi->set_name(new_name);
 			}
-			col = mi->create_convex_collision_node();
+			col = _create_convex_collision_node(mi, p_convex_shapes);
 			ERR_FAIL_COND_V(!col, NULL);
 
 			col->set_name("convcol");
@@ -594,6 +902,10 @@ Node *ResourceImporterScene::_fix_node(Node *p_node, Node *p_root, Map<Ref<Array
 					if (collision_map.has(mesh)) {
 						shape = collision_map[mesh];
 
+					} else if (p_convex_shapes.has(mesh)) {
+
+						shape = p_convex_shapes.find(mesh)->get();
+						collision_map[mesh] = shape;
 					} else {
 
 						shape = mesh->create_convex_shape();
@@ -865,6 +1177,24 @@ void ResourceImporterScene::_optimize_animations(Node *scene, float p_max_lin_er
 	}
 }
 
+void ResourceImporterScene::_compress_animations(Node *scene) {
+
+	if (!scene->has_node(String("AnimationPlayer")))
+		return;
+	Node *n = scene->get_node(String("AnimationPlayer"));
+	ERR_FAIL_COND(!n);
+	AnimationPlayer *anim = Object::cast_to<AnimationPlayer>(n);
+	ERR_FAIL_COND(!anim);
+
+	List<StringName> anim_names;
+	anim->get_animation_list(&anim_names);
+	for (List<StringName>::Element *E = anim_names.front(); E; E = E->next()) {
+
+		Ref<Animation> a = anim->get_animation(E->get());
+		a->compress();
+	}
+}
+
 static String _make_extname(const String &p_str) {
 
 	String ext_name = p_str.replace(".", "_");
@@ -1090,6 +1420,9 @@ void ResourceImporterScene::get_import_options(List<ImportOption> *r_options, in
 	r_options->push_back(ImportOption(PropertyInfo(Variant::INT, "meshes/storage", PROPERTY_HINT_ENUM, "Built-In,Files"), meshes_out ? 1 : 0));
 	r_options->push_back(ImportOption(PropertyInfo(Variant::INT, "meshes/light_baking", PROPERTY_HINT_ENUM, "Disabled,Enable,Gen Lightmaps", PROPERTY_USAGE_DEFAULT | PROPERTY_USAGE_UPDATE_ALL_IF_MODIFIED), 0));
 	r_options->push_back(ImportOption(PropertyInfo(Variant::REAL, "meshes/lightmap_texel_size", PROPERTY_HINT_RANGE, "0.001,100,0.001"), 0.1));
+	r_options->push_back(ImportOption(PropertyInfo(Variant::BOOL, "meshes/optimize"), true));
+	r_options->push_back(ImportOption(PropertyInfo(Variant::BOOL, "meshes/quantize"), false));
+	r_options->push_back(ImportOption(PropertyInfo(Variant::BOOL, "meshes/generate_lods"), true));
 	r_options->push_back(ImportOption(PropertyInfo(Variant::BOOL, "external_files/store_in_subdir"), false));
 	r_options->push_back(ImportOption(PropertyInfo(Variant::BOOL, "animation/import", PROPERTY_HINT_NONE, "", PROPERTY_USAGE_DEFAULT | PROPERTY_USAGE_UPDATE_ALL_IF_MODIFIED), true));
 	r_options->push_back(ImportOption(PropertyInfo(Variant::REAL, "animation/fps", PROPERTY_HINT_RANGE, "1,120,1"), 15));
@@ -1101,6 +1434,7 @@ void ResourceImporterScene::get_import_options(List<ImportOption> *r_options, in
 	r_options->push_back(ImportOption(PropertyInfo(Variant::REAL, "animation/optimizer/max_angular_error"), 0.01));
 	r_options->push_back(ImportOption(PropertyInfo(Variant::REAL, "animation/optimizer/max_angle"), 22));
 	r_options->push_back(ImportOption(PropertyInfo(Variant::BOOL, "animation/optimizer/remove_unused_tracks"), true));
+	r_options->push_back(ImportOption(PropertyInfo(Variant::BOOL, "animation/compression/enabled"), false));
 	r_options->push_back(ImportOption(PropertyInfo(Variant::INT, "animation/clips/amount", PROPERTY_HINT_RANGE, "0,256,1", PROPERTY_USAGE_DEFAULT | PROPERTY_USAGE_UPDATE_ALL_IF_MODIFIED), 0));
 	for (int i = 0; i < 256; i++) {
 		r_options->push_back(ImportOption(PropertyInfo(Variant::STRING, "animation/clip_" + itos(i + 1) + "/name"), ""));
@@ -1270,8 +1604,10 @@ Error ResourceImporterScene::import(const String &p_source_file, const String &p
 	int light_bake_mode = p_options["meshes/light_baking"];
 
 	Map<Ref<ArrayMesh>, Ref<Shape> > collision_map;
+	Map<Ref<ArrayMesh>, Ref<Shape> > convex_shapes;
 
-	scene = _fix_node(scene, scene, collision_map, LightBakeMode(light_bake_mode));
+	_gen_convex_collision_shapes(scene, convex_shapes);
+	scene = _fix_node(scene, scene, collision_map, convex_shapes, LightBakeMode(light_bake_mode));
 
 	if (use_optimizer) {
 		_optimize_animations(scene, anim_optimizer_linerr, anim_optimizer_angerr, anim_optimizer_maxang);
@@ -1302,6 +1638,10 @@ Error ResourceImporterScene::import(const String &p_source_file, const String &p
 		_filter_tracks(scene, animation_filter);
 	}
 
+	if (bool(p_options["animation/compression/enabled"])) {
+		_compress_animations(scene);
+	}
+
 	bool external_animations = int(p_options["animation/storage"]) == 1;
 	bool keep_custom_tracks = p_options["animation/keep_custom_tracks"];
 	bool external_materials = p_options["materials/storage"];
@@ -1322,7 +1662,11 @@ Error ResourceImporterScene::import(const String &p_source_file, const String &p
 		}
 	}
 
-	if (light_bake_mode == 2 /* || generate LOD */) {
+	bool optimize_meshes = p_options["meshes/optimize"];
+	bool quantize_meshes = p_options["meshes/quantize"];
+	bool generate_lods = p_options["meshes/generate_lods"];
+
+	if (light_bake_mode == 2 || optimize_meshes || quantize_meshes || generate_lods) {
 
 		Map<Ref<ArrayMesh>, Transform> meshes;
 		_find_meshes(scene, meshes);
@@ -1332,22 +1676,55 @@ Error ResourceImporterScene::import(const String &p_source_file, const String &p
 			float texel_size = p_options["meshes/lightmap_texel_size"];
 			texel_size = MAX(0.001, texel_size);
 
-			EditorProgress progress2("gen_lightmaps", TTR("Generating Lightmaps"), meshes.size());
+			_gen_lightmap_uvs(meshes, texel_size, p_save_path + ".unwrap_cache");
+		}
+
+		if (optimize_meshes) {
+
+			// after unwrapping, which rebuilds the surfaces
+			EditorProgress progress_optimize("optimize_meshes", TTR("Optimizing Meshes"), meshes.size());
 			int step = 0;
 			for (Map<Ref<ArrayMesh>, Transform>::Element *E = meshes.front(); E; E = E->next()) {
 
 				Ref<ArrayMesh> mesh = E->key();
 				String name = mesh->get_name();
-				if (name == "") { //should not happen but..
+				if (name == "") {
 					name = "Mesh " + itos(step);
 				}
 
-				progress2.step(TTR("Generating for Mesh: ") + name + " (" + itos(step) + "/" + itos(meshes.size()) + ")", step);
+				progress_optimize.step(TTR("Optimizing Mesh: ") + name + " (" + itos(step) + "/" + itos(meshes.size()) + ")", step);
 
-				Error err2 = mesh->lightmap_unwrap(E->get(), texel_size);
-				if (err2 != OK) {
-					EditorNode::add_io_error("Mesh '" + name + "' failed lightmap generation. Please fix geometry.");
+				mesh->optimize_surfaces();
+				step++;
+			}
+		}
+
+		if (quantize_meshes) {
+
+			// positions relative to the surface bounds, octahedral normals with the tangent packed in and 16-bit UVs
+			uint32_t quantize_flags = Mesh::ARRAY_FLAG_USE_QUANTIZED_VERTICES | Mesh::ARRAY_FLAG_USE_OCTAHEDRAL_NORMALS | Mesh::ARRAY_FLAG_USE_QUANTIZED_UV;
+			for (Map<Ref<ArrayMesh>, Transform>::Element *E = meshes.front(); E; E = E->next()) {
+				Ref<ArrayMesh> mesh = E->key();
+				mesh->compress_surfaces(quantize_flags);
+			}
+		}
+
+		if (generate_lods) {
+
+			// after unwrapping, optimizing and quantizing, which rebuild the surfaces
+			EditorProgress progress3("gen_lods", TTR("Generating LODs"), meshes.size());
+			int step = 0;
+			for (Map<Ref<ArrayMesh>, Transform>::Element *E = meshes.front(); E; E = E->next()) {
+
+				Ref<ArrayMesh> mesh = E->key();
+				String name = mesh->get_name();
+				if (name == "") {
+					name = "Mesh " + itos(step);
 				}
+
+				progress3.step(TTR("Generating for Mesh: ") + name + " (" + itos(step) + "/" + itos(meshes.size()) + ")", step);
+
+				mesh->generate_lods();
 				step++;
 			}
 		}
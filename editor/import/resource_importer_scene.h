@@ -37,6 +37,7 @@
 #include "scene/resources/shape.h"
 
 class Material;
+class MeshInstance;
 
 class EditorSceneImporter : public Reference {
 
@@ -146,12 +147,17 @@ public:
 
 	void _make_external_resources(Node *p_node, const String &p_base_path, bool p_make_animations, bool p_keep_animations, bool p_make_materials, bool p_keep_materials, bool p_make_meshes, Map<Ref<Animation>, Ref<Animation> > &p_animations, Map<Ref<Material>, Ref<Material> > &p_materials, Map<Ref<ArrayMesh>, Ref<ArrayMesh> > &p_meshes);
 
-	Node *_fix_node(Node *p_node, Node *p_root, Map<Ref<ArrayMesh>, Ref<Shape> > &collision_map, LightBakeMode p_light_bake_mode);
+	void _find_convex_collision_meshes(Node *p_node, Node *p_root, Set<Ref<ArrayMesh> > &r_meshes);
+	void _gen_convex_collision_shapes(Node *p_scene, Map<Ref<ArrayMesh>, Ref<Shape> > &r_shapes);
+	void _gen_lightmap_uvs(const Map<Ref<ArrayMesh>, Transform> &p_meshes, float p_texel_size, const String &p_cache_path);
+	Node *_create_convex_collision_node(MeshInstance *p_mesh_instance, const Map<Ref<ArrayMesh>, Ref<Shape> > &p_convex_shapes);
+	Node *_fix_node(Node *p_node, Node *p_root, Map<Ref<ArrayMesh>, Ref<Shape> > &collision_map, const Map<Ref<ArrayMesh>, Ref<Shape> > &p_convex_shapes, LightBakeMode p_light_bake_mode);
 
 	void _create_clips(Node *scene, const Array &p_clips, bool p_bake_all);
 	void _filter_anim_tracks(Ref<Animation> anim, Set<String> &keep);
 	void _filter_tracks(Node *scene, const String &p_text);
 	void _optimize_animations(Node *scene, float p_max_lin_error, float p_max_ang_error, float p_max_angle);
+	void _compress_animations(Node *scene);
 
 	virtual Error import(const String &p_source_file, const String &p_save_path, const Map<StringName, Variant> &p_options, List<String> *r_platform_variants, List<String> *r_gen_files = NULL, Variant *r_metadata = NULL);
 
@@ -161,7 +161,7 @@ bool ResourceImporterTexture::get_option_visibility(const String &p_option, cons
 
 	if (p_option == "compress/lossy_quality") {
 		int compress_mode = int(p_options["compress/mode"]);
-		if (compress_mode != COMPRESS_LOSSY && compress_mode != COMPRESS_VIDEO_RAM) {
+		if (compress_mode != COMPRESS_LOSSY && compress_mode != COMPRESS_VIDEO_RAM && compress_mode != COMPRESS_BASIS_UNIVERSAL) {
 			return false;
 		}
 	} else if (p_option == "compress/hdr_mode") {
@@ -199,7 +199,7 @@ String ResourceImporterTexture::get_preset_name(int p_idx) const {
 
 void ResourceImporterTexture::get_import_options(List<ImportOption> *r_options, int p_preset) const {
 
-	r_options->push_back(ImportOption(PropertyInfo(Variant::INT, "compress/mode", PROPERTY_HINT_ENUM, "Lossless,Lossy,Video RAM,Uncompressed", PROPERTY_USAGE_DEFAULT | PROPERTY_USAGE_UPDATE_ALL_IF_MODIFIED), p_preset == PRESET_3D ? 2 : 0));
+	r_options->push_back(ImportOption(PropertyInfo(Variant::INT, "compress/mode", PROPERTY_HINT_ENUM, "Lossless,Lossy,Video RAM,Uncompressed,Basis Universal", PROPERTY_USAGE_DEFAULT | PROPERTY_USAGE_UPDATE_ALL_IF_MODIFIED), p_preset == PRESET_3D ? 2 : 0));
 	r_options->push_back(ImportOption(PropertyInfo(Variant::REAL, "compress/lossy_quality", PROPERTY_HINT_RANGE, "0,1,0.01"), 0.7));
 	r_options->push_back(ImportOption(PropertyInfo(Variant::INT, "compress/hdr_mode", PROPERTY_HINT_ENUM, "Enabled,Force RGBE"), 0));
 	r_options->push_back(ImportOption(PropertyInfo(Variant::INT, "compress/bptc_ldr", PROPERTY_HINT_ENUM, "Enabled,RGBA Only"), 0));
@@ -351,6 +351,28 @@ void ResourceImporterTexture::_save_stex(const Ref<Image> &p_image, const String
 			PoolVector<uint8_t>::Read r = data.read();
 			f->store_buffer(r.ptr(), dl);
 		} break;
+		case COMPRESS_BASIS_UNIVERSAL: {
+
+			Ref<Image> image = p_image->duplicate();
+			if (image->get_format() > Image::FORMAT_RGBA8) {
+				image->convert(Image::FORMAT_RGBA8);
+			}
+			if (p_mipmaps) {
+				image->generate_mipmaps(p_force_normal);
+			} else {
+				image->clear_mipmaps();
+			}
+
+			format |= StreamTexture::FORMAT_BIT_BASIS_UNIVERSAL;
+			f->store_32(format);
+
+			PoolVector<uint8_t> data = Image::basis_universal_packer(image, p_lossy_quality);
+			int data_len = data.size();
+			f->store_32(data_len);
+
+			PoolVector<uint8_t>::Read r = data.read();
+			f->store_buffer(r.ptr(), data_len);
+		} break;
 		case COMPRESS_UNCOMPRESSED: {
 
 			Ref<Image> image = p_image->duplicate();
@@ -395,9 +417,23 @@ Error ResourceImporterTexture::import(const String &p_source_file, const String
 	bool force_rgbe = p_options["compress/hdr_mode"];
 	int bptc_ldr = p_options["compress/bptc_ldr"];
 
+	if (compress_mode == COMPRESS_BASIS_UNIVERSAL && !Image::basis_universal_packer) {
+		WARN_PRINTS("Basis Universal compression is not available in this build, importing '" + p_source_file + "' as Video RAM instead.");
+		compress_mode = COMPRESS_VIDEO_RAM;
+	}
+
 	Ref<Image> image;
 	image.instance();
+
+	//the SVG loader rasterizes through a single shared rasterizer, so it can't run on several import threads at once
+	bool is_svg = p_source_file.get_extension().to_lower().begins_with("svg");
+	if (is_svg) {
+		mutex->lock();
+	}
 	Error err = ImageLoader::load_image(p_source_file, image, NULL, hdr_as_srgb, scale);
+	if (is_svg) {
+		mutex->unlock();
+	}
 	if (err != OK)
 		return err;
 
@@ -524,7 +560,11 @@ Error ResourceImporterTexture::import(const String &p_source_file, const String
 		}
 
 		if (!ok_on_pc) {
-			EditorNode::add_io_error("Warning, no suitable PC VRAM compression enabled in Project Settings. This texture will not display correctly on PC.");
+			if (Thread::get_caller_id() == Thread::get_main_id()) {
+				EditorNode::add_io_error("Warning, no suitable PC VRAM compression enabled in Project Settings. This texture will not display correctly on PC.");
+			} else {
+				WARN_PRINTS("No suitable PC VRAM compression enabled in Project Settings, '" + p_source_file + "' will not display correctly on PC.");
+			}
 		}
 	} else {
 		//import normally
@@ -75,7 +75,8 @@ public:
 		COMPRESS_LOSSLESS,
 		COMPRESS_LOSSY,
 		COMPRESS_VIDEO_RAM,
-		COMPRESS_UNCOMPRESSED
+		COMPRESS_UNCOMPRESSED,
+		COMPRESS_BASIS_UNIVERSAL
 	};
 
 	virtual int get_preset_count() const;
@@ -86,6 +87,8 @@ public:
 
 	void _save_stex(const Ref<Image> &p_image, const String &p_to_path, int p_compress_mode, float p_lossy_quality, Image::CompressMode p_vram_compression, bool p_mipmaps, int p_texture_flags, bool p_streamable, bool p_detect_3d, bool p_detect_srgb, bool p_force_rgbe, bool p_detect_normal, bool p_force_normal, bool p_force_po2_for_compressed);
 
+	virtual bool can_import_threaded() const { return true; }
+
 	virtual Error import(const String &p_source_file, const String &p_save_path, const Map<StringName, Variant> &p_options, List<String> *r_platform_variants, List<String> *r_gen_files = NULL, Variant *r_metadata = NULL);
 
 	void update_imports();
@@ -73,6 +73,50 @@ void post_process_preview(Ref<Image> p_image) {
 	p_image->unlock();
 }
 
+//the smallest mipmap still covering the preview, so large textures aren't decompressed and scaled at full size
+static Ref<Image> _get_preview_mipmap(const Ref<Image> &p_image, const Size2 &p_size) {
+
+	if (!p_image->has_mipmaps())
+		return p_image;
+
+	int mip = 0;
+	int ofs = 0;
+	int size = p_image->get_data().size();
+	int w = p_image->get_width();
+	int h = p_image->get_height();
+
+	for (int i = 1; i <= p_image->get_mipmap_count(); i++) {
+
+		int mofs, msize, mw, mh;
+		p_image->get_mipmap_offset_size_and_dimensions(i, mofs, msize, mw, mh);
+		if (mw < p_size.x || mh < p_size.y)
+			break;
+
+		mip = i;
+		ofs = mofs;
+		size = msize;
+		w = mw;
+		h = mh;
+	}
+
+	if (mip == 0)
+		return p_image;
+
+	PoolVector<uint8_t> data = p_image->get_data();
+	PoolVector<uint8_t> mip_data;
+	mip_data.resize(size);
+	{
+		PoolVector<uint8_t>::Read r = data.read();
+		PoolVector<uint8_t>::Write wr = mip_data.write();
+		copymem(wr.ptr(), &r[ofs], size);
+	}
+
+	Ref<Image> img;
+	img.instance();
+	img->create(w, h, false, p_image->get_format(), mip_data);
+	return img;
+}
+
 bool EditorTexturePreviewPlugin::handles(const String &p_type) const {
 
 	return ClassDB::is_parent_class(p_type, "Texture");
@@ -82,6 +126,10 @@ bool EditorTexturePreviewPlugin::should_generate_small_preview() const {
 	return true;
 }
 
+bool EditorTexturePreviewPlugin::can_generate_threaded() const {
+	return true;
+}
+
 Ref<Texture> EditorTexturePreviewPlugin::generate(const RES &p_from, const Size2 p_size) const {
 
 	Ref<Image> img;
@@ -103,9 +151,12 @@ Ref<Texture> EditorTexturePreviewPlugin::generate(const RES &p_from, const Size2
 		img = ltex->to_image();
 	} else {
 		Ref<Texture> tex = p_from;
-		img = tex->get_data();
-		if (img.is_valid()) {
-			img = img->duplicate();
+		Ref<Image> data = tex->get_data();
+		if (data.is_valid()) {
+			img = _get_preview_mipmap(data, p_size);
+			if (img == data) {
+				img = img->duplicate();
+			}
 		}
 	}
 
@@ -155,7 +206,11 @@ Ref<Texture> EditorImagePreviewPlugin::generate(const RES &p_from, const Size2 p
 	if (img.is_null() || img->empty())
 		return Ref<Image>();
 
-	img = img->duplicate();
+	Ref<Image> mip = _get_preview_mipmap(img, p_size);
+	if (mip == img) {
+		mip = img->duplicate();
+	}
+	img = mip;
 	img->clear_mipmaps();
 
 	if (img->is_compressed()) {
@@ -189,6 +244,10 @@ EditorImagePreviewPlugin::EditorImagePreviewPlugin() {
 bool EditorImagePreviewPlugin::should_generate_small_preview() const {
 	return true;
 }
+
+bool EditorImagePreviewPlugin::can_generate_threaded() const {
+	return true;
+}
 ////////////////////////////////////////////////////////////////////////////
 /////////////////////////////////////////////////
 bool EditorBitmapPreviewPlugin::handles(const String &p_type) const {
@@ -254,6 +313,10 @@ bool EditorBitmapPreviewPlugin::should_generate_small_preview() const {
 	return true;
 }
 
+bool EditorBitmapPreviewPlugin::can_generate_threaded() const {
+	return true;
+}
+
 EditorBitmapPreviewPlugin::EditorBitmapPreviewPlugin() {
 }
 
@@ -687,6 +750,10 @@ Ref<Texture> EditorAudioStreamPreviewPlugin::generate(const RES &p_from, const S
 	return ptex;
 }
 
+bool EditorAudioStreamPreviewPlugin::can_generate_threaded() const {
+	return true;
+}
+
 EditorAudioStreamPreviewPlugin::EditorAudioStreamPreviewPlugin() {
 }
 
@@ -40,6 +40,7 @@ class EditorTexturePreviewPlugin : public EditorResourcePreviewGenerator {
 public:
 	virtual bool handles(const String &p_type) const;
 	virtual bool should_generate_small_preview() const;
+	virtual bool can_generate_threaded() const;
 	virtual Ref<Texture> generate(const RES &p_from, const Size2 p_size) const;
 
 	EditorTexturePreviewPlugin();
@@ -50,6 +51,7 @@ class EditorImagePreviewPlugin : public EditorResourcePreviewGenerator {
 public:
 	virtual bool handles(const String &p_type) const;
 	virtual bool should_generate_small_preview() const;
+	virtual bool can_generate_threaded() const;
 	virtual Ref<Texture> generate(const RES &p_from, const Size2 p_size) const;
 
 	EditorImagePreviewPlugin();
@@ -60,6 +62,7 @@ class EditorBitmapPreviewPlugin : public EditorResourcePreviewGenerator {
 public:
 	virtual bool handles(const String &p_type) const;
 	virtual bool should_generate_small_preview() const;
+	virtual bool can_generate_threaded() const;
 	virtual Ref<Texture> generate(const RES &p_from, const Size2 p_size) const;
 
 	EditorBitmapPreviewPlugin();
@@ -116,6 +119,7 @@ public:
 class EditorAudioStreamPreviewPlugin : public EditorResourcePreviewGenerator {
 public:
 	virtual bool handles(const String &p_type) const;
+	virtual bool can_generate_threaded() const;
 	virtual Ref<Texture> generate(const RES &p_from, const Size2 p_size) const;
 
 	EditorAudioStreamPreviewPlugin();
@@ -30,11 +30,14 @@
 
 #include "script_editor_debugger.h"
 
+#include "core/io/compression.h"
 #include "core/io/marshalls.h"
 #include "core/project_settings.h"
 #include "core/ustring.h"
 #include "editor_node.h"
+#include "editor_network_profiler.h"
 #include "editor_profiler.h"
+#include "editor_sample_profiler.h"
 #include "editor_settings.h"
 #include "main/performance.h"
 #include "property_editor.h"
@@ -332,16 +335,140 @@ void ScriptEditorDebugger::_scene_tree_property_select_object(ObjectID p_object)
 	ppeer->put_var(msg);
 }
 
-void ScriptEditorDebugger::_scene_tree_request() {
+void ScriptEditorDebugger::_scene_tree_request(bool p_full) {
 
 	ERR_FAIL_COND(connection.is_null());
 	ERR_FAIL_COND(!connection->is_connected_to_host());
 
 	Array msg;
 	msg.push_back("request_scene_tree");
+	msg.push_back(p_full || !remote_tree_synced); // otherwise only the changes are sent
 	ppeer->put_var(msg);
 }
 
+void ScriptEditorDebugger::_scene_tree_clear() {
+
+	inspect_scene_tree->clear();
+	remote_tree_items.clear();
+	remote_tree_synced = false;
+}
+
+TreeItem *ScriptEditorDebugger::_scene_tree_create_item(TreeItem *p_parent, int p_pos, const String &p_name, const String &p_class, ObjectID p_id) {
+
+	TreeItem *it = inspect_scene_tree->create_item(p_parent, p_pos);
+
+	it->set_text(0, p_name);
+	Ref<Texture> icon = EditorNode::get_singleton()->get_class_icon(p_class, "");
+	if (icon.is_valid())
+		it->set_icon(0, icon);
+	it->set_metadata(0, p_id);
+
+	if (p_parent) {
+		if (!unfold_cache.has(p_id)) {
+			it->set_collapsed(true);
+		}
+	} else {
+		if (unfold_cache.has(p_id)) { //reverse for root
+			it->set_collapsed(true);
+		}
+	}
+
+	remote_tree_items.set(p_id, it);
+	return it;
+}
+
+bool ScriptEditorDebugger::_scene_tree_apply_diff(const Array &p_data) {
+
+	// mirrors SceneTree::node_added/node_removed/node_renamed/node_moved
+	enum {
+		TREE_ADD,
+		TREE_REMOVE,
+		TREE_RENAME,
+		TREE_MOVE
+	};
+
+	int i = 0;
+	while (i < p_data.size()) {
+
+		int op = p_data[i];
+		switch (op) {
+
+			case TREE_ADD: {
+
+				ERR_FAIL_COND_V(i + 6 > p_data.size(), false);
+				TreeItem **parent = remote_tree_items.getptr(ObjectID(p_data[i + 1]));
+				if (!parent)
+					return false;
+
+				_scene_tree_create_item(*parent, p_data[i + 2], p_data[i + 3], p_data[i + 4], ObjectID(p_data[i + 5]));
+				i += 6;
+			} break;
+			case TREE_REMOVE: {
+
+				ERR_FAIL_COND_V(i + 2 > p_data.size(), false);
+				TreeItem **item = remote_tree_items.getptr(ObjectID(p_data[i + 1]));
+				if (!item)
+					return false;
+
+				// children are normally removed first, but forget any that are left
+				TreeItem *it = *item;
+				List<TreeItem *> stack;
+				stack.push_back(it);
+				while (stack.size()) {
+					TreeItem *E = stack.back()->get();
+					stack.pop_back();
+					remote_tree_items.erase(ObjectID(E->get_metadata(0)));
+					for (TreeItem *c = E->get_children(); c; c = c->get_next()) {
+						stack.push_back(c);
+					}
+				}
+
+				if (it == inspect_scene_tree->get_root())
+					return false;
+				memdelete(it);
+				i += 2;
+			} break;
+			case TREE_RENAME: {
+
+				ERR_FAIL_COND_V(i + 3 > p_data.size(), false);
+				TreeItem **item = remote_tree_items.getptr(ObjectID(p_data[i + 1]));
+				if (!item)
+					return false;
+
+				(*item)->set_text(0, p_data[i + 2]);
+				i += 3;
+			} break;
+			case TREE_MOVE: {
+
+				ERR_FAIL_COND_V(i + 3 > p_data.size(), false);
+				TreeItem **item = remote_tree_items.getptr(ObjectID(p_data[i + 1]));
+				if (!item || !(*item)->get_parent())
+					return false;
+
+				TreeItem *it = *item;
+				Vector<TreeItem *> order;
+				for (TreeItem *c = it->get_parent()->get_children(); c; c = c->get_next()) {
+					if (c != it)
+						order.push_back(c);
+				}
+				int pos = CLAMP(int(p_data[i + 2]), 0, order.size());
+				order.insert(pos, it);
+
+				// everything from the new position on goes to the bottom, in order
+				for (int j = pos; j < order.size(); j++) {
+					order[j]->move_to_bottom();
+				}
+				i += 3;
+			} break;
+			default: {
+				ERR_FAIL_V(false);
+			}
+		}
+	}
+
+	return true;
+}
+
 void ScriptEditorDebugger::_video_mem_request() {
 
 	ERR_FAIL_COND(connection.is_null());
@@ -360,6 +487,28 @@ Size2 ScriptEditorDebugger::get_minimum_size() const {
 }
 void ScriptEditorDebugger::_parse_message(const String &p_msg, const Array &p_data) {
 
+	if (p_msg.begins_with("compressed:")) {
+
+		// sent by ScriptDebuggerRemote::_put_message() for big messages
+		ERR_FAIL_COND(p_data.size() != 2);
+		int size = p_data[0];
+		PoolVector<uint8_t> compressed = p_data[1];
+		ERR_FAIL_COND(size <= 0 || compressed.size() == 0);
+
+		Vector<uint8_t> encoded;
+		encoded.resize(size);
+		PoolVector<uint8_t>::Read r = compressed.read();
+		int ret = Compression::decompress(encoded.ptrw(), size, r.ptr(), compressed.size(), Compression::MODE_ZSTD);
+		ERR_FAIL_COND(ret != size);
+
+		Variant data;
+		Error err = decode_variant(data, encoded.ptr(), size);
+		ERR_FAIL_COND(err != OK || data.get_type() != Variant::ARRAY);
+
+		_parse_message("message:" + p_msg.substr(11, p_msg.length() - 11), data);
+		return;
+	}
+
 	if (p_msg == "debug_enter") {
 		Array msg;
 		msg.push_back("get_stack_dump");
@@ -380,6 +529,8 @@ void ScriptEditorDebugger::_parse_message(const String &p_msg, const Array &p_da
 			tabs->set_current_tab(0);
 		}
 		profiler->set_enabled(false);
+		network_profiler->set_enabled(false);
+		sample_profiler->set_enabled(false);
 		EditorNode::get_singleton()->get_pause_button()->set_pressed(true);
 		EditorNode::get_singleton()->make_bottom_panel_item_visible(this);
 		_clear_remote_objects();
@@ -399,6 +550,8 @@ void ScriptEditorDebugger::_parse_message(const String &p_msg, const Array &p_da
 		emit_signal("breaked", false, false, Variant());
 		profiler->set_enabled(true);
 		profiler->disable_seeking();
+		network_profiler->set_enabled(true);
+		sample_profiler->set_enabled(true);
 		inspector->edit(NULL);
 		EditorNode::get_singleton()->get_pause_button()->set_pressed(false);
 	} else if (p_msg == "message:click_ctrl") {
@@ -408,7 +561,7 @@ void ScriptEditorDebugger::_parse_message(const String &p_msg, const Array &p_da
 
 	} else if (p_msg == "message:scene_tree") {
 
-		inspect_scene_tree->clear();
+		_scene_tree_clear();
 		Map<int, TreeItem *> lv;
 
 		updating_scene_tree = true;
@@ -424,15 +577,8 @@ void ScriptEditorDebugger::_parse_message(const String &p_msg, const Array &p_da
 				p = lv[level - 1];
 			}
 
-			TreeItem *it = inspect_scene_tree->create_item(p);
-
 			ObjectID id = ObjectID(p_data[i + 3]);
-
-			it->set_text(0, p_data[i + 1]);
-			Ref<Texture> icon = EditorNode::get_singleton()->get_class_icon(p_data[i + 2], "");
-			if (icon.is_valid())
-				it->set_icon(0, icon);
-			it->set_metadata(0, id);
+			TreeItem *it = _scene_tree_create_item(p, -1, p_data[i + 1], p_data[i + 2], id);
 
 			if (id == inspected_object_id) {
 				TreeItem *cti = it->get_parent(); //ensure selected is always uncollapsed
@@ -443,22 +589,27 @@ void ScriptEditorDebugger::_parse_message(const String &p_msg, const Array &p_da
 				it->select(0);
 			}
 
-			if (p) {
-				if (!unfold_cache.has(id)) {
-					it->set_collapsed(true);
-				}
-			} else {
-				if (unfold_cache.has(id)) { //reverse for root
-					it->set_collapsed(true);
-				}
-			}
-
 			lv[level] = it;
 		}
 		updating_scene_tree = false;
+		remote_tree_synced = true;
 
 		le_clear->set_disabled(false);
 		le_set->set_disabled(false);
+	} else if (p_msg == "message:scene_tree_diff") {
+
+		if (!remote_tree_synced)
+			return; // a full tree was already requested
+
+		updating_scene_tree = true;
+		bool applied = _scene_tree_apply_diff(p_data);
+		updating_scene_tree = false;
+
+		if (!applied) {
+			// out of sync, start over
+			remote_tree_synced = false;
+			_scene_tree_request(true);
+		}
 	} else if (p_msg == "message:inspect_object") {
 
 		ScriptEditorDebuggerInspectedObject *debugObj = NULL;
@@ -674,6 +825,18 @@ void ScriptEditorDebugger::_parse_message(const String &p_msg, const Array &p_da
 			EditorNode::get_log()->add_message(t);
 		}
 
+	} else if (p_msg == "network_profile") {
+
+		network_profiler->add_node_frame_data(p_data[0]);
+
+	} else if (p_msg == "stack_samples") {
+
+		sample_profiler->add_samples(p_data[0]);
+
+	} else if (p_msg == "network_bandwidth") {
+
+		network_profiler->set_bandwidth(p_data[0], p_data[1], p_data[2]);
+
 	} else if (p_msg == "performance") {
 		Array arr = p_data[0];
 		Vector<float> p;
@@ -1059,10 +1222,11 @@ void ScriptEditorDebugger::_notification(int p_what) {
 					if (inspected_object_id) {
 						if (ScriptEditorDebuggerInspectedObject *obj = Object::cast_to<ScriptEditorDebuggerInspectedObject>(ObjectDB::get_instance(editor->get_editor_history()->get_current()))) {
 							if (obj->remote_object_id == inspected_object_id) {
-								//take the chance and re-inspect selected object
+								//take the chance and re-inspect selected object, it's only sent back if it changed
 								Array msg;
 								msg.push_back("inspect_object");
 								msg.push_back(inspected_object_id);
+								msg.push_back(true);
 								ppeer->put_var(msg);
 							}
 						}
@@ -1112,8 +1276,10 @@ void ScriptEditorDebugger::_notification(int p_what) {
 
 					_set_reason_text(TTR("Child Process Connected"), MESSAGE_SUCCESS);
 					profiler->clear();
+					network_profiler->clear();
+					sample_profiler->clear();
 
-					inspect_scene_tree->clear();
+					_scene_tree_clear();
 					le_set->set_disabled(true);
 					le_clear->set_disabled(false);
 					error_tree->clear();
@@ -1129,6 +1295,12 @@ void ScriptEditorDebugger::_notification(int p_what) {
 					if (profiler->is_profiling()) {
 						_profiler_activate(true);
 					}
+					if (network_profiler->is_profiling()) {
+						_network_profiler_activate(true);
+					}
+					if (sample_profiler->is_profiling()) {
+						_sample_profiler_activate(true);
+					}
 
 				} else {
 
@@ -1298,8 +1470,10 @@ void ScriptEditorDebugger::stop() {
 	le_clear->set_disabled(false);
 	le_set->set_disabled(true);
 	profiler->set_enabled(true);
+	network_profiler->set_enabled(true);
+	sample_profiler->set_enabled(true);
 
-	inspect_scene_tree->clear();
+	_scene_tree_clear();
 
 	EditorNode::get_singleton()->get_pause_button()->set_pressed(false);
 	EditorNode::get_singleton()->get_pause_button()->set_disabled(true);
@@ -1336,6 +1510,32 @@ void ScriptEditorDebugger::_profiler_activate(bool p_enable) {
 	}
 }
 
+void ScriptEditorDebugger::_network_profiler_activate(bool p_enable) {
+
+	if (!connection.is_valid())
+		return;
+
+	Array msg;
+	msg.push_back(p_enable ? "start_network_profiling" : "stop_network_profiling");
+	ppeer->put_var(msg);
+	print_verbose(p_enable ? "Starting network profiling." : "Ending network profiling.");
+}
+
+void ScriptEditorDebugger::_sample_profiler_activate(bool p_enable) {
+
+	if (!connection.is_valid())
+		return;
+
+	Array msg;
+	if (p_enable) {
+		msg.push_back("start_sampling");
+		msg.push_back(sample_profiler->get_frequency());
+	} else {
+		msg.push_back("stop_sampling");
+	}
+	ppeer->put_var(msg);
+}
+
 void ScriptEditorDebugger::_profiler_seeked() {
 
 	if (!connection.is_valid() || !connection->is_connected_to_host())
@@ -1886,7 +2086,7 @@ void ScriptEditorDebugger::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("_output_clear"), &ScriptEditorDebugger::_output_clear);
 	ClassDB::bind_method(D_METHOD("_performance_draw"), &ScriptEditorDebugger::_performance_draw);
 	ClassDB::bind_method(D_METHOD("_performance_select"), &ScriptEditorDebugger::_performance_select);
-	ClassDB::bind_method(D_METHOD("_scene_tree_request"), &ScriptEditorDebugger::_scene_tree_request);
+	ClassDB::bind_method(D_METHOD("_scene_tree_request", "full"), &ScriptEditorDebugger::_scene_tree_request, DEFVAL(false));
 	ClassDB::bind_method(D_METHOD("_video_mem_request"), &ScriptEditorDebugger::_video_mem_request);
 	ClassDB::bind_method(D_METHOD("_live_edit_set"), &ScriptEditorDebugger::_live_edit_set);
 	ClassDB::bind_method(D_METHOD("_live_edit_clear"), &ScriptEditorDebugger::_live_edit_clear);
@@ -1897,6 +2097,8 @@ void ScriptEditorDebugger::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("_collapse_errors_list"), &ScriptEditorDebugger::_collapse_errors_list);
 	ClassDB::bind_method(D_METHOD("_profiler_activate"), &ScriptEditorDebugger::_profiler_activate);
 	ClassDB::bind_method(D_METHOD("_profiler_seeked"), &ScriptEditorDebugger::_profiler_seeked);
+	ClassDB::bind_method(D_METHOD("_network_profiler_activate"), &ScriptEditorDebugger::_network_profiler_activate);
+	ClassDB::bind_method(D_METHOD("_sample_profiler_activate"), &ScriptEditorDebugger::_sample_profiler_activate);
 	ClassDB::bind_method(D_METHOD("_clear_errors_list"), &ScriptEditorDebugger::_clear_errors_list);
 
 	ClassDB::bind_method(D_METHOD("_error_tree_item_rmb_selected"), &ScriptEditorDebugger::_error_tree_item_rmb_selected);
@@ -2096,6 +2298,7 @@ ScriptEditorDebugger::ScriptEditorDebugger(EditorNode *p_editor) {
 		inspect_edited_object_timeout = EDITOR_DEF("debugger/remote_inspect_refresh_interval", 0.2);
 		inspected_object_id = 0;
 		updating_scene_tree = false;
+		remote_tree_synced = false;
 	}
 
 	{ // File dialog
@@ -2112,6 +2315,20 @@ ScriptEditorDebugger::ScriptEditorDebugger(EditorNode *p_editor) {
 		profiler->connect("break_request", this, "_profiler_seeked");
 	}
 
+	{ //sample profiler
+		sample_profiler = memnew(EditorSampleProfiler);
+		sample_profiler->set_name(TTR("Sampler"));
+		tabs->add_child(sample_profiler);
+		sample_profiler->connect("enable_sampling", this, "_sample_profiler_activate");
+	}
+
+	{ //network profiler
+		network_profiler = memnew(EditorNetworkProfiler);
+		network_profiler->set_name(TTR("Network Profiler"));
+		tabs->add_child(network_profiler);
+		network_profiler->connect("enable_profiling", this, "_network_profiler_activate");
+	}
+
 	{ //monitors
 
 		HSplitContainer *hsp = memnew(HSplitContainer);
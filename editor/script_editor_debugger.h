@@ -50,6 +50,8 @@ class TreeItem;
 class HSplitContainer;
 class ItemList;
 class EditorProfiler;
+class EditorNetworkProfiler;
+class EditorSampleProfiler;
 
 class ScriptEditorDebuggerInspectedObject;
 
@@ -86,6 +88,8 @@ class ScriptEditorDebugger : public Control {
 	ScriptEditorDebuggerVariables *variables;
 	Map<ObjectID, ScriptEditorDebuggerInspectedObject *> remote_objects;
 	Set<ObjectID> unfold_cache;
+	HashMap<ObjectID, TreeItem *> remote_tree_items;
+	bool remote_tree_synced;
 
 	VBoxContainer *errors_tab;
 	Tree *error_tree;
@@ -144,6 +148,8 @@ class ScriptEditorDebugger : public Control {
 	Map<String, int> res_path_cache;
 
 	EditorProfiler *profiler;
+	EditorNetworkProfiler *network_profiler;
+	EditorSampleProfiler *sample_profiler;
 
 	EditorNode *editor;
 
@@ -160,7 +166,10 @@ class ScriptEditorDebugger : public Control {
 	void _scene_tree_selected();
 	void _scene_tree_rmb_selected(const Vector2 &p_position);
 	void _file_selected(const String &p_file);
-	void _scene_tree_request();
+	void _scene_tree_request(bool p_full = false);
+	void _scene_tree_clear();
+	TreeItem *_scene_tree_create_item(TreeItem *p_parent, int p_pos, const String &p_name, const String &p_class, ObjectID p_id);
+	bool _scene_tree_apply_diff(const Array &p_data);
 	void _parse_message(const String &p_msg, const Array &p_data);
 	void _set_reason_text(const String &p_reason, MessageType p_type);
 	void _scene_tree_property_select_object(ObjectID p_object);
@@ -186,6 +195,8 @@ class ScriptEditorDebugger : public Control {
 
 	void _profiler_activate(bool p_enable);
 	void _profiler_seeked();
+	void _network_profiler_activate(bool p_enable);
+	void _sample_profiler_activate(bool p_enable);
 
 	void _paused();
 
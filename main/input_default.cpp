@@ -33,6 +33,7 @@
 #include "core/input_map.h"
 #include "core/os/os.h"
 #include "main/default_controller_mappings.h"
+#include "main/input_recorder.h"
 #include "scene/resources/texture.h"
 #include "servers/visual_server.h"
 
@@ -256,6 +257,9 @@ Vector3 InputDefault::get_gyroscope() const {
 
 void InputDefault::parse_input_event(const Ref<InputEvent> &p_event) {
 
+	if (recorder && !recorder->capture_event(p_event))
+		return;
+
 	_parse_input_event_impl(p_event, false);
 }
 
@@ -506,6 +510,9 @@ void InputDefault::set_main_loop(MainLoop *p_main_loop) {
 
 void InputDefault::set_mouse_position(const Point2 &p_posf) {
 
+	if (recorder && recorder->is_replaying() && !recorder->is_injecting())
+		return; // The replay drives the pointer.
+
 	mouse_speed_track.update(p_posf - mouse_pos);
 	mouse_pos = p_posf;
 }
@@ -667,7 +674,7 @@ void InputDefault::accumulate_input_event(const Ref<InputEvent> &p_event) {
 		parse_input_event(p_event);
 		return;
 	}
-	if (!accumulated_events.empty() && accumulated_events.back()->get()->accumulate(p_event)) {
+	if (!accumulated_events.empty() && accumulated_events[accumulated_events.size() - 1]->accumulate(p_event)) {
 		return; //event was accumulated, exit
 	}
 
@@ -675,10 +682,11 @@ void InputDefault::accumulate_input_event(const Ref<InputEvent> &p_event) {
 }
 void InputDefault::flush_accumulated_events() {
 
-	while (accumulated_events.front()) {
-		parse_input_event(accumulated_events.front()->get());
-		accumulated_events.pop_front();
+	// parsing may accumulate more events, those are parsed too
+	for (int i = 0; i < accumulated_events.size(); i++) {
+		parse_input_event(accumulated_events[i]);
 	}
+	accumulated_events.clear(); // keeps the memory for the next frame
 }
 
 void InputDefault::set_use_accumulated_input(bool p_enable) {
@@ -686,9 +694,63 @@ void InputDefault::set_use_accumulated_input(bool p_enable) {
 	use_accumulated_input = p_enable;
 }
 
+template <class T>
+Ref<T> InputDefault::_get_pooled_event(LocalVector<Ref<T> > &p_pool, int &r_pos) {
+
+	for (int i = 0; i < p_pool.size(); i++) {
+
+		int idx = (r_pos + i) % p_pool.size();
+		if (p_pool[idx]->reference_get_count() == 1) {
+			r_pos = idx + 1;
+			return p_pool[idx];
+		}
+	}
+
+	Ref<T> event;
+	event.instance();
+	if (p_pool.size() < EVENT_POOL_SIZE) {
+		p_pool.push_back(event);
+	}
+	return event;
+}
+
+Ref<InputEventMouseMotion> InputDefault::create_mouse_motion_event() {
+
+	Ref<InputEventMouseMotion> mm = _get_pooled_event(mouse_motion_pool, mouse_motion_pool_pos);
+
+	mm->set_device(0);
+	mm->set_shift(false);
+	mm->set_alt(false);
+	mm->set_control(false);
+	mm->set_metakey(false);
+	mm->set_button_mask(0);
+	mm->set_position(Vector2());
+	mm->set_global_position(Vector2());
+	mm->set_relative(Vector2());
+	mm->set_speed(Vector2());
+
+	return mm;
+}
+
+Ref<InputEventScreenDrag> InputDefault::create_screen_drag_event() {
+
+	Ref<InputEventScreenDrag> sd = _get_pooled_event(screen_drag_pool, screen_drag_pool_pos);
+
+	sd->set_device(0);
+	sd->set_index(0);
+	sd->set_position(Vector2());
+	sd->set_relative(Vector2());
+	sd->set_speed(Vector2());
+
+	return sd;
+}
+
 InputDefault::InputDefault() {
 
 	use_accumulated_input = true;
+	mouse_motion_pool_pos = 0;
+	screen_drag_pool_pos = 0;
+	recorder = NULL;
 	mouse_button_mask = 0;
 	emulate_touch_from_mouse = false;
 	emulate_mouse_from_touch = false;
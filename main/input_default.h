@@ -31,8 +31,11 @@
 #ifndef INPUT_DEFAULT_H
 #define INPUT_DEFAULT_H
 
+#include "core/local_vector.h"
 #include "core/os/input.h"
 
+class InputRecorder;
+
 class InputDefault : public Input {
 
 	GDCLASS(InputDefault, Input);
@@ -183,9 +186,25 @@ private:
 
 	void _parse_input_event_impl(const Ref<InputEvent> &p_event, bool p_is_emulated);
 
-	List<Ref<InputEvent> > accumulated_events;
+	LocalVector<Ref<InputEvent> > accumulated_events;
 	bool use_accumulated_input;
 
+	// Motion events created for the platform code, handed out again once
+	// nothing but the pool references them (scripts that keep one keep it).
+	enum {
+		EVENT_POOL_SIZE = 16
+	};
+
+	LocalVector<Ref<InputEventMouseMotion> > mouse_motion_pool;
+	LocalVector<Ref<InputEventScreenDrag> > screen_drag_pool;
+	int mouse_motion_pool_pos;
+	int screen_drag_pool_pos;
+
+	template <class T>
+	static Ref<T> _get_pooled_event(LocalVector<Ref<T> > &p_pool, int &r_pos);
+
+	InputRecorder *recorder;
+
 public:
 	virtual bool is_key_pressed(int p_scancode) const;
 	virtual bool is_mouse_button_pressed(int p_button) const;
@@ -228,6 +247,7 @@ public:
 	virtual void stop_joy_vibration(int p_device);
 
 	void set_main_loop(MainLoop *p_main_loop);
+	void set_recorder(InputRecorder *p_recorder) { recorder = p_recorder; }
 	void set_mouse_position(const Point2 &p_posf);
 
 	void action_press(const StringName &p_action, float p_strength = 1.f);
@@ -272,6 +292,10 @@ public:
 	virtual void flush_accumulated_events();
 	virtual void set_use_accumulated_input(bool p_enable);
 
+	// Use these instead of instancing the events for every OS motion message.
+	Ref<InputEventMouseMotion> create_mouse_motion_event();
+	Ref<InputEventScreenDrag> create_screen_drag_event();
+
 	InputDefault();
 };
 
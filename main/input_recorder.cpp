@@ -0,0 +1,186 @@
+/*************************************************************************/
+/*  input_recorder.cpp                                                   */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2019 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2019 Godot Engine contributors (cf. AUTHORS.md)    */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#include "input_recorder.h"
+
+#include "core/io/marshalls.h"
+#include "core/math/random_pcg.h"
+#include "core/os/os.h"
+#include "main/input_default.h"
+
+static const char *INPUT_RECORDER_MAGIC = "GDIR";
+
+Error InputRecorder::open(Mode p_mode, const String &p_path, InputDefault *p_input, int p_physics_fps) {
+
+	ERR_FAIL_COND_V(file, ERR_ALREADY_IN_USE);
+
+	Error err;
+	file = FileAccess::open(p_path, p_mode == MODE_RECORD ? FileAccess::WRITE : FileAccess::READ, &err);
+	if (!file) {
+		ERR_EXPLAIN("Can't open input recording: " + p_path);
+		ERR_FAIL_V(err);
+	}
+
+	mode = p_mode;
+	input = p_input;
+
+	if (mode == MODE_RECORD) {
+
+		seed = OS::get_singleton()->get_unix_time() ^ OS::get_singleton()->get_ticks_usec();
+		file->store_buffer((const uint8_t *)INPUT_RECORDER_MAGIC, 4);
+		file->store_32(FORMAT_VERSION);
+		file->store_64(seed);
+		file->store_32(p_physics_fps);
+	} else {
+
+		uint8_t magic[4];
+		file->get_buffer(magic, 4);
+		if (memcmp(magic, INPUT_RECORDER_MAGIC, 4) != 0 || file->get_32() != FORMAT_VERSION) {
+			memdelete(file);
+			file = NULL;
+			ERR_EXPLAIN("Not a valid input recording: " + p_path);
+			ERR_FAIL_V(ERR_FILE_UNRECOGNIZED);
+		}
+
+		seed = file->get_64();
+		int physics_fps = file->get_32();
+		if (physics_fps != p_physics_fps) {
+			WARN_PRINTS("Input recording was made at " + itos(physics_fps) + " physics FPS, the project now uses " + itos(p_physics_fps) + ". The replay will not match.");
+		}
+	}
+
+	// Scripts calling randomize() get the same sequence of seeds in both runs.
+	RandomPCG::set_randomize_seed(seed);
+
+	return OK;
+}
+
+bool InputRecorder::capture_event(const Ref<InputEvent> &p_event) {
+
+	if (mode == MODE_REPLAY)
+		return injecting;
+
+	int len;
+	Error err = encode_variant(p_event, NULL, len, true);
+	ERR_FAIL_COND_V(err != OK, true);
+
+	MutexLock lock(mutex);
+	int ofs = pending_events.size();
+	pending_events.resize(ofs + 4 + len);
+	encode_uint32(len, &pending_events.write[ofs]);
+	encode_variant(p_event, &pending_events.write[ofs + 4], len, true);
+	pending_count++;
+
+	return true;
+}
+
+bool InputRecorder::iteration(MainFrameTime &r_advance) {
+
+	if (!file || finished)
+		return !finished;
+
+	if (mode == MODE_RECORD) {
+
+		MutexLock lock(mutex);
+		file->store_32(frame);
+		file->store_double(r_advance.idle_step);
+		file->store_32(r_advance.physics_steps);
+		file->store_32(pending_count);
+		file->store_buffer(pending_events.ptr(), pending_events.size());
+		pending_events.clear();
+		pending_count = 0;
+		frame++;
+		return true;
+	}
+
+	uint32_t recorded_frame = file->get_32();
+	if (file->eof_reached()) {
+		print_line("Input replay finished after " + itos(frame) + " frames.");
+		finished = true;
+		return false;
+	}
+	if (recorded_frame != frame) {
+		ERR_PRINTS("Input recording is corrupt at frame " + itos(frame) + ", stopping the replay.");
+		finished = true;
+		return false;
+	}
+
+	r_advance.idle_step = file->get_double();
+	r_advance.physics_steps = file->get_32();
+
+	int count = file->get_32();
+	Vector<uint8_t> buffer;
+	injecting = true;
+	for (int i = 0; i < count; i++) {
+
+		int len = file->get_32();
+		buffer.resize(len);
+		if (file->get_buffer(buffer.ptrw(), len) != len) {
+			break;
+		}
+
+		Variant event;
+		if (decode_variant(event, buffer.ptr(), len, NULL, true) != OK) {
+			continue;
+		}
+
+		Ref<InputEventMouse> mouse = event;
+		if (mouse.is_valid()) {
+			input->set_mouse_position(mouse->get_global_position());
+		}
+		input->parse_input_event(event);
+	}
+	injecting = false;
+	frame++;
+
+	return true;
+}
+
+InputRecorder::InputRecorder() {
+
+	mode = MODE_RECORD;
+	file = NULL;
+	input = NULL;
+	mutex = Mutex::create();
+	seed = 0;
+	frame = 0;
+	injecting = false;
+	finished = false;
+	pending_count = 0;
+}
+
+InputRecorder::~InputRecorder() {
+
+	if (file) {
+		file->close();
+		memdelete(file);
+	}
+	memdelete(mutex);
+}
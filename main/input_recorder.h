@@ -0,0 +1,87 @@
+/*************************************************************************/
+/*  input_recorder.h                                                     */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2019 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2019 Godot Engine contributors (cf. AUTHORS.md)    */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#ifndef INPUT_RECORDER_H
+#define INPUT_RECORDER_H
+
+#include "core/os/file_access.h"
+#include "core/os/input_event.h"
+#include "core/os/mutex.h"
+#include "main/main_timer_sync.h"
+
+class InputDefault;
+
+// Captures the input events and frame steps of a run to a file, or plays
+// them back in place of the real input and clock, so a session simulates
+// exactly the same way on any machine.
+class InputRecorder {
+public:
+	enum Mode {
+		MODE_RECORD,
+		MODE_REPLAY,
+	};
+
+private:
+	enum {
+		FORMAT_VERSION = 1
+	};
+
+	Mode mode;
+	FileAccess *file;
+	InputDefault *input;
+	Mutex *mutex;
+
+	uint64_t seed;
+	uint32_t frame;
+	bool injecting;
+	bool finished;
+
+	// Events parsed since the last frame was written, already encoded.
+	Vector<uint8_t> pending_events;
+	int pending_count;
+
+public:
+	Error open(Mode p_mode, const String &p_path, InputDefault *p_input, int p_physics_fps);
+
+	// Returns false if the event must be dropped (real input during a replay).
+	bool capture_event(const Ref<InputEvent> &p_event);
+	bool is_replaying() const { return mode == MODE_REPLAY; }
+	bool is_injecting() const { return injecting; }
+
+	// Called once per main loop iteration with the step measured by MainTimerSync.
+	// While replaying, the recorded step replaces it and the recorded events are
+	// fed to the input. Returns false once a replay ran out of frames.
+	bool iteration(MainFrameTime &r_advance);
+
+	InputRecorder();
+	~InputRecorder();
+};
+
+#endif // INPUT_RECORDER_H
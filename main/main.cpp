@@ -41,7 +41,9 @@
 #include "core/io/stream_peer_tcp.h"
 #include "core/message_queue.h"
 #include "core/os/dir_access.h"
+#include "core/os/frame_arena.h"
 #include "core/os/os.h"
+#include "core/os/trace.h"
 #include "core/project_settings.h"
 #include "core/register_core_types.h"
 #include "core/script_debugger_local.h"
@@ -53,6 +55,7 @@
 #include "drivers/register_driver_types.h"
 #include "main/app_icon.gen.h"
 #include "main/input_default.h"
+#include "main/input_recorder.h"
 #include "main/main_timer_sync.h"
 #include "main/performance.h"
 #include "main/splash.gen.h"
@@ -104,6 +107,28 @@ static Physics2DServer *physics_2d_server = NULL;
 // We error out if setup2() doesn't turn this true
 static bool _start_success = false;
 
+// Startup phase timings, printed with --verbose at the end of setup2()
+struct StartupPhase {
+	const char *name;
+	uint64_t usec;
+};
+
+static const int MAX_STARTUP_PHASES = 16;
+static StartupPhase startup_phases[MAX_STARTUP_PHASES];
+static int startup_phase_count = 0;
+static uint64_t startup_phase_begin = 0;
+
+static void _startup_phase_done(const char *p_name) {
+
+	uint64_t now = OS::get_singleton()->get_ticks_usec();
+	if (startup_phase_count < MAX_STARTUP_PHASES) {
+		startup_phases[startup_phase_count].name = p_name;
+		startup_phases[startup_phase_count].usec = now - startup_phase_begin;
+		startup_phase_count++;
+	}
+	startup_phase_begin = now;
+}
+
 // Drivers
 
 static int video_driver_idx = -1;
@@ -137,6 +162,9 @@ static bool force_lowdpi = false;
 
 static bool use_debug_profiler = false;
 #ifdef DEBUG_ENABLED
+static String trace_file;
+#endif
+#ifdef DEBUG_ENABLED
 static bool debug_collisions = false;
 static bool debug_navigation = false;
 #endif
@@ -144,6 +172,9 @@ static int frame_delay = 0;
 static bool disable_render_loop = false;
 static int fixed_fps = -1;
 static bool print_fps = false;
+static String input_record_file;
+static String input_replay_file;
+static InputRecorder *input_recorder = NULL;
 
 /* Helper methods */
 
@@ -255,7 +286,7 @@ void Main::print_help(const char *p_binary) {
 	OS::get_singleton()->print("  --resolution <W>x<H>             Request window resolution.\n");
 	OS::get_singleton()->print("  --position <X>,<Y>               Request window position.\n");
 	OS::get_singleton()->print("  --low-dpi                        Force low-DPI mode (macOS and Windows only).\n");
-	OS::get_singleton()->print("  --no-window                      Disable window creation (Windows only). Useful together with --script.\n");
+	OS::get_singleton()->print("  --no-window                      Disable window creation (Windows only) and skip all rendering and audio work. Useful together with --script.\n");
 	OS::get_singleton()->print("\n");
 
 	OS::get_singleton()->print("Debug options:\n");
@@ -264,6 +295,7 @@ void Main::print_help(const char *p_binary) {
 	OS::get_singleton()->print("  --profiling                      Enable profiling in the script debugger.\n");
 	OS::get_singleton()->print("  --remote-debug <address>         Remote debug (<host/IP>:<port> address).\n");
 #ifdef DEBUG_ENABLED
+	OS::get_singleton()->print("  --trace <file>                   Write engine trace events to a Chrome trace JSON file (viewable in chrome://tracing or Perfetto).\n");
 	OS::get_singleton()->print("  --debug-collisions               Show collisions shapes when running the scene.\n");
 	OS::get_singleton()->print("  --debug-navigation               Show navigation polygons when running the scene.\n");
 #endif
@@ -273,6 +305,8 @@ void Main::print_help(const char *p_binary) {
 	OS::get_singleton()->print("  --disable-crash-handler          Disable crash handler when supported by the platform code.\n");
 	OS::get_singleton()->print("  --fixed-fps <fps>                Force a fixed number of frames per second. This setting disables real-time synchronization.\n");
 	OS::get_singleton()->print("  --print-fps                      Print the frames per second to the stdout.\n");
+	OS::get_singleton()->print("  --record-input <file>            Record input events, frame steps and random seeds to <file>.\n");
+	OS::get_singleton()->print("  --replay-input <file>            Replay a recording made with --record-input as fast as possible, then quit.\n");
 	OS::get_singleton()->print("\n");
 
 	OS::get_singleton()->print("Standalone tools:\n");
@@ -296,6 +330,7 @@ void Main::print_help(const char *p_binary) {
 		comma = ", ";
 	}
 	OS::get_singleton()->print(").\n");
+	OS::get_singleton()->print("  --benchmark                      Run the benchmark suite. Accepts --benchmark-filter <substring>, --benchmark-iterations <n>, --benchmark-warmup <n> and --benchmark-output <file.json>. With --benchmark-scene <path>, time --benchmark-frames <n> frames of a scene instead.\n");
 #endif
 }
 
@@ -329,6 +364,7 @@ Error Main::setup(const char *execpath, int argc, char *argv[], bool p_second_ph
 	RID_OwnerBase::init_rid();
 
 	OS::get_singleton()->initialize_core();
+	startup_phase_begin = OS::get_singleton()->get_ticks_usec();
 
 	engine = memnew(Engine);
 
@@ -338,6 +374,7 @@ Error Main::setup(const char *execpath, int argc, char *argv[], bool p_second_ph
 
 	register_core_types();
 	register_core_driver_types();
+	_startup_phase_done("Core types");
 
 	MAIN_PRINT("Main: Initialize Globals");
 
@@ -496,6 +533,18 @@ Error Main::setup(const char *execpath, int argc, char *argv[], bool p_second_ph
 		} else if (I->get() == "--profiling") { // enable profiling
 
 			use_debug_profiler = true;
+#ifdef DEBUG_ENABLED
+		} else if (I->get() == "--trace") { // write a trace file
+
+			if (I->next()) {
+
+				trace_file = I->next()->get();
+				N = I->next()->next();
+			} else {
+				OS::get_singleton()->print("Missing trace file argument, aborting.\n");
+				goto error;
+			}
+#endif
 		} else if (I->get() == "--video-driver") { // force video driver
 
 			if (I->next()) {
@@ -715,6 +764,22 @@ Error Main::setup(const char *execpath, int argc, char *argv[], bool p_second_ph
 			}
 		} else if (I->get() == "--print-fps") {
 			print_fps = true;
+		} else if (I->get() == "--record-input") {
+			if (I->next()) {
+				input_record_file = I->next()->get();
+				N = I->next()->next();
+			} else {
+				OS::get_singleton()->print("Missing input recording file argument, aborting.\n");
+				goto error;
+			}
+		} else if (I->get() == "--replay-input") {
+			if (I->next()) {
+				input_replay_file = I->next()->get();
+				N = I->next()->next();
+			} else {
+				OS::get_singleton()->print("Missing input recording file argument, aborting.\n");
+				goto error;
+			}
 		} else if (I->get() == "--disable-crash-handler") {
 			OS::get_singleton()->disable_crash_handler();
 		} else {
@@ -747,7 +812,10 @@ Error Main::setup(const char *execpath, int argc, char *argv[], bool p_second_ph
 		FileAccess::make_default<FileAccessNetwork>(FileAccess::ACCESS_RESOURCES);
 	}
 
+	_startup_phase_done("Command line");
+
 	if (globals->setup(project_path, main_pack, upwards) == OK) {
+		_startup_phase_done("Project settings");
 #ifdef TOOLS_ENABLED
 		found_project = true;
 #endif
@@ -766,6 +834,8 @@ Error Main::setup(const char *execpath, int argc, char *argv[], bool p_second_ph
 
 	GLOBAL_DEF("memory/limits/multithreaded_server/rid_pool_prealloc", 60);
 	ProjectSettings::get_singleton()->set_custom_property_info("memory/limits/multithreaded_server/rid_pool_prealloc", PropertyInfo(Variant::INT, "memory/limits/multithreaded_server/rid_pool_prealloc", PROPERTY_HINT_RANGE, "0,500,1")); // No negative and limit to 500 due to crashes
+	GLOBAL_DEF("network/limits/debugger/compress_messages_over_kb", 16);
+	ProjectSettings::get_singleton()->set_custom_property_info("network/limits/debugger/compress_messages_over_kb", PropertyInfo(Variant::INT, "network/limits/debugger/compress_messages_over_kb", PROPERTY_HINT_RANGE, "0, 1024, 1, or_greater"));
 	GLOBAL_DEF("network/limits/debugger_stdout/max_chars_per_second", 2048);
 	ProjectSettings::get_singleton()->set_custom_property_info("network/limits/debugger_stdout/max_chars_per_second", PropertyInfo(Variant::INT, "network/limits/debugger_stdout/max_chars_per_second", PROPERTY_HINT_RANGE, "0, 4096, 1, or_greater"));
 	GLOBAL_DEF("network/limits/debugger_stdout/max_messages_per_frame", 10);
@@ -822,10 +892,23 @@ Error Main::setup(const char *execpath, int argc, char *argv[], bool p_second_ph
 	GLOBAL_DEF("logging/file_logging/log_path", "user://logs/log.txt");
 	GLOBAL_DEF("logging/file_logging/max_log_files", 10);
 	ProjectSettings::get_singleton()->set_custom_property_info("logging/file_logging/max_log_files", PropertyInfo(Variant::INT, "logging/file_logging/max_log_files", PROPERTY_HINT_RANGE, "0,20,1,or_greater")); //no negative numbers
+	GLOBAL_DEF("logging/file_logging/async", true);
+	GLOBAL_DEF("logging/file_logging/json_lines", false);
+	GLOBAL_DEF("logging/file_logging/collapse_repeated_messages", false);
+	GLOBAL_DEF("logging/file_logging/max_messages_per_second", 0);
+	ProjectSettings::get_singleton()->set_custom_property_info("logging/file_logging/max_messages_per_second", PropertyInfo(Variant::INT, "logging/file_logging/max_messages_per_second", PROPERTY_HINT_RANGE, "0,10000,1,or_greater"));
 	if (FileAccess::get_create_func(FileAccess::ACCESS_USERDATA) && GLOBAL_GET("logging/file_logging/enable_file_logging")) {
 		String base_path = GLOBAL_GET("logging/file_logging/log_path");
 		int max_files = GLOBAL_GET("logging/file_logging/max_log_files");
-		OS::get_singleton()->add_logger(memnew(RotatedFileLogger(base_path, max_files)));
+		Logger *file_logger = memnew(RotatedFileLogger(base_path, max_files));
+		if (GLOBAL_GET("logging/file_logging/async")) {
+			AsyncLogger *async_logger = memnew(AsyncLogger(file_logger));
+			async_logger->set_json_lines(GLOBAL_GET("logging/file_logging/json_lines"));
+			async_logger->set_collapse_repeated(GLOBAL_GET("logging/file_logging/collapse_repeated_messages"));
+			async_logger->set_max_messages_per_second(GLOBAL_GET("logging/file_logging/max_messages_per_second"));
+			file_logger = async_logger;
+		}
+		OS::get_singleton()->add_logger(file_logger);
 	}
 
 #ifdef TOOLS_ENABLED
@@ -1018,6 +1101,20 @@ Error Main::setup(const char *execpath, int argc, char *argv[], bool p_second_ph
 
 	GLOBAL_DEF("debug/settings/stdout/print_fps", false);
 
+	performance->set_frame_history_size(GLOBAL_DEF("debug/settings/performance/frame_history_size", 300));
+	ProjectSettings::get_singleton()->set_custom_property_info("debug/settings/performance/frame_history_size", PropertyInfo(Variant::INT, "debug/settings/performance/frame_history_size", PROPERTY_HINT_RANGE, "16,10000,1,or_greater"));
+	GLOBAL_DEF("debug/settings/performance/hitch_threshold_msec", 0.0);
+	ProjectSettings::get_singleton()->set_custom_property_info("debug/settings/performance/hitch_threshold_msec", PropertyInfo(Variant::REAL, "debug/settings/performance/hitch_threshold_msec", PROPERTY_HINT_RANGE, "0,1000,0.1,or_greater"));
+	GLOBAL_DEF("debug/settings/performance/hitch_trace_frames", 60);
+	ProjectSettings::get_singleton()->set_custom_property_info("debug/settings/performance/hitch_trace_frames", PropertyInfo(Variant::INT, "debug/settings/performance/hitch_trace_frames", PROPERTY_HINT_RANGE, "1,600,1,or_greater"));
+	GLOBAL_DEF("debug/settings/performance/hitch_trace_path", "");
+
+	if (!editor && !project_manager) {
+		performance->set_hitch_threshold(float(GLOBAL_GET("debug/settings/performance/hitch_threshold_msec")) / 1000.0);
+		performance->set_hitch_trace_frames(GLOBAL_GET("debug/settings/performance/hitch_trace_frames"));
+		performance->set_hitch_trace_path(GLOBAL_GET("debug/settings/performance/hitch_trace_path"));
+	}
+
 	if (!OS::get_singleton()->_verbose_stdout) //overridden
 		OS::get_singleton()->_verbose_stdout = GLOBAL_DEF("debug/settings/stdout/verbose_stdout", false);
 
@@ -1033,6 +1130,7 @@ Error Main::setup(const char *execpath, int argc, char *argv[], bool p_second_ph
 	Engine::get_singleton()->set_frame_delay(frame_delay);
 
 	message_queue = memnew(MessageQueue);
+	_startup_phase_done("Settings and input");
 
 	if (p_second_phase)
 		return setup2();
@@ -1091,6 +1189,7 @@ Error Main::setup2(Thread::ID p_main_tid_override) {
 	if (err != OK) {
 		return err;
 	}
+	_startup_phase_done("OS, video and audio drivers");
 
 	if (init_use_custom_pos) {
 		OS::get_singleton()->set_window_position(init_custom_pos);
@@ -1101,6 +1200,12 @@ Error Main::setup2(Thread::ID p_main_tid_override) {
 	audio_server = memnew(AudioServer);
 	audio_server->init();
 
+	// Dedicated servers never present a frame nor play a sound, let scene nodes and loaders skip that work
+	if (!editor && !project_manager && (OS::get_singleton()->is_no_window_mode_enabled() || OS::get_singleton()->get_name() == "Server")) {
+		VisualServer::get_singleton()->set_null_mode(true);
+		audio_server->set_null_mode(true);
+	}
+
 	// also init our arvr_server from here
 	arvr_server = memnew(ARVRServer);
 
@@ -1133,6 +1238,7 @@ Error Main::setup2(Thread::ID p_main_tid_override) {
 	}
 
 	register_server_types();
+	_startup_phase_done("Servers");
 
 	MAIN_PRINT("Main: Load Remaps");
 
@@ -1182,6 +1288,8 @@ Error Main::setup2(Thread::ID p_main_tid_override) {
 #endif
 	}
 
+	_startup_phase_done("Boot splash");
+
 	MAIN_PRINT("Main: DCC");
 	VisualServer::get_singleton()->set_default_clear_color(GLOBAL_DEF("rendering/environment/default_clear_color", Color(0.3, 0.3, 0.3)));
 	MAIN_PRINT("Main: END");
@@ -1199,6 +1307,18 @@ Error Main::setup2(Thread::ID p_main_tid_override) {
 		}
 
 		id->set_emulate_mouse_from_touch(bool(GLOBAL_DEF("input_devices/pointing/emulate_mouse_from_touch", true)));
+
+		if ((input_record_file != String() || input_replay_file != String()) && !(editor || project_manager)) {
+			bool replay = input_replay_file != String();
+			input_recorder = memnew(InputRecorder);
+			Error err = input_recorder->open(replay ? InputRecorder::MODE_REPLAY : InputRecorder::MODE_RECORD, replay ? input_replay_file : input_record_file, id, Engine::get_singleton()->get_iterations_per_second());
+			if (err == OK) {
+				id->set_recorder(input_recorder);
+			} else {
+				memdelete(input_recorder);
+				input_recorder = NULL;
+			}
+		}
 	}
 
 	MAIN_PRINT("Main: Load Remaps");
@@ -1206,6 +1326,7 @@ Error Main::setup2(Thread::ID p_main_tid_override) {
 	MAIN_PRINT("Main: Load Scene Types");
 
 	register_scene_types();
+	_startup_phase_done("Scene types");
 
 	GLOBAL_DEF("display/mouse_cursor/custom_image", String());
 	GLOBAL_DEF("display/mouse_cursor/custom_image_hotspot", Vector2());
@@ -1226,12 +1347,14 @@ Error Main::setup2(Thread::ID p_main_tid_override) {
 
 	ClassDB::set_current_api(ClassDB::API_CORE);
 
+	_startup_phase_done("Editor types");
 #endif
 
 	MAIN_PRINT("Main: Load Modules, Physics, Drivers, Scripts");
 
 	register_platform_apis();
 	register_module_types();
+	_startup_phase_done("Modules");
 
 	initialize_physics();
 	register_server_singletons();
@@ -1240,6 +1363,7 @@ Error Main::setup2(Thread::ID p_main_tid_override) {
 
 	// This loads global classes, so it must happen before custom loaders and savers are registered
 	ScriptServer::init_languages();
+	_startup_phase_done("Physics, drivers and script languages");
 
 	MAIN_PRINT("Main: Load Translations");
 
@@ -1254,6 +1378,7 @@ Error Main::setup2(Thread::ID p_main_tid_override) {
 	ResourceLoader::load_path_remaps();
 
 	audio_server->load_default_bus_layout();
+	_startup_phase_done("Translations, remaps and bus layout");
 
 	if (use_debug_profiler && script_debugger) {
 		script_debugger->profiling_start();
@@ -1263,8 +1388,18 @@ Error Main::setup2(Thread::ID p_main_tid_override) {
 
 	ClassDB::set_current_api(ClassDB::API_NONE); //no more api is registered at this point
 
-	print_verbose("CORE API HASH: " + itos(ClassDB::get_api_hash(ClassDB::API_CORE)));
-	print_verbose("EDITOR API HASH: " + itos(ClassDB::get_api_hash(ClassDB::API_EDITOR)));
+	// Hashing walks and sorts every class and method, don't do it unless it's printed.
+	if (OS::get_singleton()->is_stdout_verbose()) {
+		print_line("CORE API HASH: " + itos(ClassDB::get_api_hash(ClassDB::API_CORE)));
+		print_line("EDITOR API HASH: " + itos(ClassDB::get_api_hash(ClassDB::API_EDITOR)));
+
+		uint64_t total = 0;
+		for (int i = 0; i < startup_phase_count; i++) {
+			print_line(vformat("Startup: %s: %.1f msec", startup_phases[i].name, startup_phases[i].usec / 1000.0));
+			total += startup_phases[i].usec;
+		}
+		print_line(vformat("Startup: total: %.1f msec", total / 1000.0));
+	}
 	MAIN_PRINT("Main: Done");
 
 	return OK;
@@ -1277,6 +1412,16 @@ bool Main::start() {
 
 	ERR_FAIL_COND_V(!_start_success, false);
 
+	// The arena belongs to the thread running the main loop, which on some
+	// platforms is not the one that ran setup().
+	FrameArena::setup();
+
+#ifdef DEBUG_ENABLED
+	if (trace_file != String()) {
+		Trace::start_capture(trace_file);
+	}
+#endif
+
 	bool hasicon = false;
 	String doc_tool;
 	List<String> removal_docs;
@@ -1297,6 +1442,8 @@ bool Main::start() {
 		//parameters that do not have an argument to the right
 		if (args[i] == "--check-only") {
 			check_only = true;
+		} else if (args[i] == "--benchmark") {
+			test = "benchmark";
 #ifdef TOOLS_ENABLED
 		} else if (args[i] == "--no-docbase") {
 			doc_base = false;
@@ -1348,6 +1495,12 @@ bool Main::start() {
 		}
 	}
 
+	if ((editor || project_manager || doc_tool != "") && VisualServer::get_singleton()->is_null_mode()) {
+		// Headless exports and tools still need the real resource data.
+		VisualServer::get_singleton()->set_null_mode(false);
+		audio_server->set_null_mode(false);
+	}
+
 	GLOBAL_DEF("editor/active", editor);
 
 	String main_loop_type;
@@ -1814,6 +1967,8 @@ bool Main::iteration() {
 
 	iterating++;
 
+	TRACE_SCOPE("Main::iteration");
+
 	uint64_t ticks = OS::get_singleton()->get_ticks_usec();
 	Engine::get_singleton()->_frame_ticks = ticks;
 	main_timer_sync.set_cpu_ticks_usec(ticks);
@@ -1821,12 +1976,18 @@ bool Main::iteration() {
 
 	uint64_t ticks_elapsed = ticks - last_ticks;
 
+	// Low processor mode sleeps between frames on purpose, those are not hitches.
+	if (last_ticks && !OS::get_singleton()->is_in_low_processor_usage_mode()) {
+		performance->add_frame_time(ticks_elapsed);
+	}
+
 	int physics_fps = Engine::get_singleton()->get_iterations_per_second();
 	float frame_slice = 1.0 / physics_fps;
 
 	float time_scale = Engine::get_singleton()->get_time_scale();
 
 	MainFrameTime advance = main_timer_sync.advance(frame_slice, physics_fps);
+	bool replay_ended = input_recorder && !input_recorder->iteration(advance);
 	double step = advance.idle_step;
 	double scaled_step = step * time_scale;
 
@@ -1859,17 +2020,24 @@ bool Main::iteration() {
 		Physics2DServer::get_singleton()->sync();
 		Physics2DServer::get_singleton()->flush_queries();
 
-		if (OS::get_singleton()->get_main_loop()->iteration(frame_slice * time_scale)) {
-			exit = true;
-			break;
-		}
+		{
+			MemoryTagScope tag_scope(MEMORY_TAG_SCENE);
+			if (OS::get_singleton()->get_main_loop()->iteration(frame_slice * time_scale)) {
+				exit = true;
+				break;
+			}
 
-		message_queue->flush();
+			message_queue->flush();
+		}
 
-		PhysicsServer::get_singleton()->step(frame_slice * time_scale);
+		{
+			MemoryTagScope tag_scope(MEMORY_TAG_PHYSICS);
+			TRACE_SCOPE("Physics step");
+			PhysicsServer::get_singleton()->step(frame_slice * time_scale);
 
-		Physics2DServer::get_singleton()->end_sync();
-		Physics2DServer::get_singleton()->step(frame_slice * time_scale);
+			Physics2DServer::get_singleton()->end_sync();
+			Physics2DServer::get_singleton()->step(frame_slice * time_scale);
+		}
 
 		message_queue->flush();
 
@@ -1882,10 +2050,13 @@ bool Main::iteration() {
 
 	uint64_t idle_begin = OS::get_singleton()->get_ticks_usec();
 
-	OS::get_singleton()->get_main_loop()->idle(step * time_scale);
-	message_queue->flush();
+	{
+		MemoryTagScope tag_scope(MEMORY_TAG_SCENE);
+		OS::get_singleton()->get_main_loop()->idle(step * time_scale);
+		message_queue->flush();
+	}
 
-	VisualServer::get_singleton()->sync(); //sync if still drawing from previous frames.
+	VisualServer::get_singleton()->sync_frame(); //sync if still drawing from previous frames.
 
 	if (OS::get_singleton()->can_draw() && !disable_render_loop) {
 
@@ -1911,6 +2082,10 @@ bool Main::iteration() {
 
 	AudioServer::get_singleton()->update();
 
+#ifdef DEBUG_ENABLED
+	Trace::flush();
+#endif
+
 	if (script_debugger) {
 		if (script_debugger->is_profiling()) {
 			script_debugger->profiling_set_frame_times(USEC_TO_SEC(frame_time), USEC_TO_SEC(idle_process_ticks), USEC_TO_SEC(physics_process_ticks), frame_slice);
@@ -1943,8 +2118,15 @@ bool Main::iteration() {
 
 	iterating--;
 
-	if (fixed_fps != -1)
-		return exit;
+	// Nested iterations (e.g. editor progress dialogs) run while the outer
+	// frame still holds scratch memory, so only the outermost one rewinds.
+	if (iterating == 0) {
+		FrameArena::reset();
+	}
+
+	// Replays run unthrottled, their steps come from the recording.
+	if (fixed_fps != -1 || (input_recorder && input_recorder->is_replaying()))
+		return exit || replay_ended;
 
 	if (OS::get_singleton()->is_in_low_processor_usage_mode() || !OS::get_singleton()->can_draw())
 		OS::get_singleton()->delay_usec(OS::get_singleton()->get_low_processor_usage_mode_sleep_usec()); //apply some delay to force idle time (results in about 60 FPS max)
@@ -1973,7 +2155,7 @@ bool Main::iteration() {
 	}
 #endif
 
-	return exit || auto_quit;
+	return exit || auto_quit || replay_ended;
 }
 
 void Main::force_redraw() {
@@ -1990,12 +2172,25 @@ void Main::cleanup() {
 
 	ERR_FAIL_COND(!_start_success);
 
+	if (input_recorder) {
+		InputDefault *id = Object::cast_to<InputDefault>(Input::get_singleton());
+		if (id) {
+			id->set_recorder(NULL);
+		}
+		memdelete(input_recorder);
+		input_recorder = NULL;
+	}
+
+	ResourceLoader::clear_thread_load_tasks();
+	ImageLoader::clear_async_loads();
 	ResourceLoader::remove_custom_loaders();
 	ResourceSaver::remove_custom_savers();
 
 	message_queue->flush();
 	memdelete(message_queue);
 
+	Trace::stop_capture();
+
 	if (script_debugger) {
 		if (use_debug_profiler) {
 			script_debugger->profiling_end();
@@ -2064,6 +2259,9 @@ void Main::cleanup() {
 		OS::get_singleton()->set_restart_on_exit(false, List<String>()); //clear list (uses memory)
 	}
 
+	FrameArena::cleanup();
+	Trace::cleanup();
+
 	unregister_core_driver_types();
 	unregister_core_types();
 
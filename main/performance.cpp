@@ -30,8 +30,11 @@
 
 #include "performance.h"
 
+#include "core/engine.h"
 #include "core/message_queue.h"
+#include "core/os/dir_access.h"
 #include "core/os/os.h"
+#include "core/os/trace.h"
 #include "scene/main/scene_tree.h"
 #include "servers/audio_server.h"
 #include "servers/physics_2d_server.h"
@@ -43,6 +46,22 @@ Performance *Performance::singleton = NULL;
 void Performance::_bind_methods() {
 
 	ClassDB::bind_method(D_METHOD("get_monitor", "monitor"), &Performance::get_monitor);
+	ClassDB::bind_method(D_METHOD("get_memory_snapshot"), &Performance::get_memory_snapshot);
+	ClassDB::bind_method(D_METHOD("compare_memory_snapshots", "from", "to"), &Performance::compare_memory_snapshots);
+
+	ClassDB::bind_method(D_METHOD("set_frame_history_size", "frames"), &Performance::set_frame_history_size);
+	ClassDB::bind_method(D_METHOD("get_frame_history_size"), &Performance::get_frame_history_size);
+	ClassDB::bind_method(D_METHOD("set_hitch_threshold", "seconds"), &Performance::set_hitch_threshold);
+	ClassDB::bind_method(D_METHOD("get_hitch_threshold"), &Performance::get_hitch_threshold);
+	ClassDB::bind_method(D_METHOD("set_hitch_trace_path", "path"), &Performance::set_hitch_trace_path);
+	ClassDB::bind_method(D_METHOD("get_hitch_trace_path"), &Performance::get_hitch_trace_path);
+	ClassDB::bind_method(D_METHOD("set_hitch_trace_frames", "frames"), &Performance::set_hitch_trace_frames);
+	ClassDB::bind_method(D_METHOD("get_hitch_trace_frames"), &Performance::get_hitch_trace_frames);
+	ClassDB::bind_method(D_METHOD("get_frame_time_percentile", "percentile"), &Performance::get_frame_time_percentile);
+	ClassDB::bind_method(D_METHOD("get_frame_stats"), &Performance::get_frame_stats);
+	ClassDB::bind_method(D_METHOD("reset_frame_stats"), &Performance::reset_frame_stats);
+
+	ADD_SIGNAL(MethodInfo("hitch_detected", PropertyInfo(Variant::REAL, "frame_time")));
 
 	BIND_ENUM_CONSTANT(TIME_FPS);
 	BIND_ENUM_CONSTANT(TIME_PROCESS);
@@ -72,6 +91,37 @@ void Performance::_bind_methods() {
 	BIND_ENUM_CONSTANT(PHYSICS_3D_COLLISION_PAIRS);
 	BIND_ENUM_CONSTANT(PHYSICS_3D_ISLAND_COUNT);
 	BIND_ENUM_CONSTANT(AUDIO_OUTPUT_LATENCY);
+	BIND_ENUM_CONSTANT(RENDER_2D_BATCHES_IN_FRAME);
+	BIND_ENUM_CONSTANT(NETWORK_SEND_QUEUE_PACKETS);
+	BIND_ENUM_CONSTANT(NETWORK_SEND_QUEUE_BYTES);
+	BIND_ENUM_CONSTANT(MEMORY_SMALL_OBJECTS);
+	BIND_ENUM_CONSTANT(MEMORY_RESOURCES);
+	BIND_ENUM_CONSTANT(MEMORY_SCENE);
+	BIND_ENUM_CONSTANT(MEMORY_PHYSICS);
+	BIND_ENUM_CONSTANT(MEMORY_RENDERING);
+	BIND_ENUM_CONSTANT(MEMORY_AUDIO);
+	BIND_ENUM_CONSTANT(OBJECT_GROUP_CALLS);
+	BIND_ENUM_CONSTANT(RENDER_FRAME_SYNC_TIME);
+	BIND_ENUM_CONSTANT(RENDER_GPU_SHADOWS_TIME);
+	BIND_ENUM_CONSTANT(RENDER_GPU_OPAQUE_TIME);
+	BIND_ENUM_CONSTANT(RENDER_GPU_ALPHA_TIME);
+	BIND_ENUM_CONSTANT(RENDER_GPU_SSAO_TIME);
+	BIND_ENUM_CONSTANT(RENDER_GPU_SSR_TIME);
+	BIND_ENUM_CONSTANT(RENDER_GPU_POST_PROCESS_TIME);
+	BIND_ENUM_CONSTANT(RENDER_GPU_GLOW_TIME);
+	BIND_ENUM_CONSTANT(RENDER_GPU_CANVAS_TIME);
+	BIND_ENUM_CONSTANT(MEMORY_SCRIPT);
+	BIND_ENUM_CONSTANT(MEMORY_ALLOCATIONS);
+	BIND_ENUM_CONSTANT(RENDER_TARGET_MEM_USED);
+	BIND_ENUM_CONSTANT(RENDER_SHADOW_MEM_USED);
+	BIND_ENUM_CONSTANT(RENDER_REFLECTION_MEM_USED);
+	BIND_ENUM_CONSTANT(RENDER_GI_PROBE_MEM_USED);
+	BIND_ENUM_CONSTANT(RENDER_MULTIMESH_MEM_USED);
+	BIND_ENUM_CONSTANT(TIME_FRAME_P50);
+	BIND_ENUM_CONSTANT(TIME_FRAME_P95);
+	BIND_ENUM_CONSTANT(TIME_FRAME_P99);
+	BIND_ENUM_CONSTANT(TIME_FRAME_MAX);
+	BIND_ENUM_CONSTANT(TIME_HITCHES);
 
 	BIND_ENUM_CONSTANT(MONITOR_MAX);
 }
@@ -109,6 +159,37 @@ String Performance::get_monitor_name(Monitor p_monitor) const {
 		"physics_3d/collision_pairs",
 		"physics_3d/islands",
 		"audio/output_latency",
+		"raster/2d_batches",
+		"network/send_queue_packets",
+		"network/send_queue_bytes",
+		"memory/small_objects",
+		"memory/resources",
+		"memory/scene",
+		"memory/physics",
+		"memory/rendering",
+		"memory/audio",
+		"object/group_calls",
+		"raster/frame_sync_time",
+		"gpu/shadows",
+		"gpu/opaque",
+		"gpu/alpha",
+		"gpu/ssao",
+		"gpu/ssr",
+		"gpu/post_process",
+		"gpu/glow",
+		"gpu/canvas",
+		"memory/script",
+		"memory/allocations",
+		"video/render_target_mem",
+		"video/shadow_mem",
+		"video/reflection_mem",
+		"video/gi_probe_mem",
+		"video/multimesh_mem",
+		"time/frame_p50",
+		"time/frame_p95",
+		"time/frame_p99",
+		"time/frame_max",
+		"time/hitches",
 
 	};
 
@@ -153,6 +234,57 @@ float Performance::get_monitor(Monitor p_monitor) const {
 		case PHYSICS_3D_COLLISION_PAIRS: return PhysicsServer::get_singleton()->get_process_info(PhysicsServer::INFO_COLLISION_PAIRS);
 		case PHYSICS_3D_ISLAND_COUNT: return PhysicsServer::get_singleton()->get_process_info(PhysicsServer::INFO_ISLAND_COUNT);
 		case AUDIO_OUTPUT_LATENCY: return AudioServer::get_singleton()->get_output_latency();
+		case RENDER_2D_BATCHES_IN_FRAME: return VS::get_singleton()->get_render_info(VS::INFO_2D_BATCHES_IN_FRAME);
+		case NETWORK_SEND_QUEUE_PACKETS:
+		case NETWORK_SEND_QUEUE_BYTES: {
+
+			SceneTree *sml = Object::cast_to<SceneTree>(OS::get_singleton()->get_main_loop());
+			if (!sml || !sml->get_multiplayer().is_valid())
+				return 0;
+			return sml->get_multiplayer()->get_network_send_queue_size(p_monitor == NETWORK_SEND_QUEUE_BYTES);
+		};
+		case MEMORY_SMALL_OBJECTS: return Memory::get_small_object_memory();
+		case MEMORY_RESOURCES: return Memory::get_tag_usage(MEMORY_TAG_RESOURCES);
+		case MEMORY_SCENE: return Memory::get_tag_usage(MEMORY_TAG_SCENE);
+		case MEMORY_PHYSICS: return Memory::get_tag_usage(MEMORY_TAG_PHYSICS);
+		case MEMORY_RENDERING: return Memory::get_tag_usage(MEMORY_TAG_RENDERING);
+		case MEMORY_AUDIO: return Memory::get_tag_usage(MEMORY_TAG_AUDIO);
+		case OBJECT_GROUP_CALLS: {
+
+			MainLoop *ml = OS::get_singleton()->get_main_loop();
+			SceneTree *sml = Object::cast_to<SceneTree>(ml);
+			if (!sml)
+				return 0;
+			return sml->get_group_call_count();
+		};
+		case RENDER_FRAME_SYNC_TIME: return VS::get_singleton()->get_render_info(VS::INFO_FRAME_SYNC_TIME_USEC) / 1000000.0;
+		case RENDER_GPU_SHADOWS_TIME: return VS::get_singleton()->get_render_info(VS::INFO_GPU_SHADOWS_TIME_USEC) / 1000000.0;
+		case RENDER_GPU_OPAQUE_TIME: return VS::get_singleton()->get_render_info(VS::INFO_GPU_OPAQUE_TIME_USEC) / 1000000.0;
+		case RENDER_GPU_ALPHA_TIME: return VS::get_singleton()->get_render_info(VS::INFO_GPU_ALPHA_TIME_USEC) / 1000000.0;
+		case RENDER_GPU_SSAO_TIME: return VS::get_singleton()->get_render_info(VS::INFO_GPU_SSAO_TIME_USEC) / 1000000.0;
+		case RENDER_GPU_SSR_TIME: return VS::get_singleton()->get_render_info(VS::INFO_GPU_SSR_TIME_USEC) / 1000000.0;
+		case RENDER_GPU_POST_PROCESS_TIME: return VS::get_singleton()->get_render_info(VS::INFO_GPU_POST_PROCESS_TIME_USEC) / 1000000.0;
+		case RENDER_GPU_GLOW_TIME: return VS::get_singleton()->get_render_info(VS::INFO_GPU_GLOW_TIME_USEC) / 1000000.0;
+		case RENDER_GPU_CANVAS_TIME: return VS::get_singleton()->get_render_info(VS::INFO_GPU_CANVAS_TIME_USEC) / 1000000.0;
+		case MEMORY_SCRIPT: return Memory::get_tag_usage(MEMORY_TAG_SCRIPT);
+		case MEMORY_ALLOCATIONS: {
+
+			uint64_t count = 0;
+			for (int i = 0; i < MEMORY_TAG_MAX; i++) {
+				count += Memory::get_tag_allocation_count(MemoryTag(i));
+			}
+			return count;
+		};
+		case RENDER_TARGET_MEM_USED: return VS::get_singleton()->get_render_info(VS::INFO_RENDER_TARGET_MEM_USED);
+		case RENDER_SHADOW_MEM_USED: return VS::get_singleton()->get_render_info(VS::INFO_SHADOW_MEM_USED);
+		case RENDER_REFLECTION_MEM_USED: return VS::get_singleton()->get_render_info(VS::INFO_REFLECTION_MEM_USED);
+		case RENDER_GI_PROBE_MEM_USED: return VS::get_singleton()->get_render_info(VS::INFO_GI_PROBE_MEM_USED);
+		case RENDER_MULTIMESH_MEM_USED: return VS::get_singleton()->get_render_info(VS::INFO_MULTIMESH_MEM_USED);
+		case TIME_FRAME_P50: _update_frame_stats(); return frame_stats.p50;
+		case TIME_FRAME_P95: _update_frame_stats(); return frame_stats.p95;
+		case TIME_FRAME_P99: _update_frame_stats(); return frame_stats.p99;
+		case TIME_FRAME_MAX: _update_frame_stats(); return frame_stats.max;
+		case TIME_HITCHES: return hitch_count;
 
 		default: {}
 	}
@@ -160,6 +292,34 @@ float Performance::get_monitor(Monitor p_monitor) const {
 	return 0;
 }
 
+Dictionary Performance::get_memory_snapshot() const {
+
+	Dictionary snapshot;
+	for (int i = 0; i < MEMORY_TAG_MAX; i++) {
+		Dictionary tag;
+		tag["bytes"] = Memory::get_tag_usage(MemoryTag(i));
+		tag["allocations"] = Memory::get_tag_allocation_count(MemoryTag(i));
+		snapshot[Memory::get_tag_name(MemoryTag(i))] = tag;
+	}
+	return snapshot;
+}
+
+Dictionary Performance::compare_memory_snapshots(const Dictionary &p_from, const Dictionary &p_to) const {
+
+	Dictionary diff;
+	for (int i = 0; i < MEMORY_TAG_MAX; i++) {
+		String name = Memory::get_tag_name(MemoryTag(i));
+		Dictionary from = p_from.has(name) ? Dictionary(p_from[name]) : Dictionary();
+		Dictionary to = p_to.has(name) ? Dictionary(p_to[name]) : Dictionary();
+
+		Dictionary tag;
+		tag["bytes"] = int64_t(to.get("bytes", 0)) - int64_t(from.get("bytes", 0));
+		tag["allocations"] = int64_t(to.get("allocations", 0)) - int64_t(from.get("allocations", 0));
+		diff[name] = tag;
+	}
+	return diff;
+}
+
 Performance::MonitorType Performance::get_monitor_type(Monitor p_monitor) const {
 	ERR_FAIL_INDEX_V(p_monitor, MONITOR_MAX, MONITOR_TYPE_QUANTITY);
 	// ugly
@@ -193,6 +353,37 @@ Performance::MonitorType Performance::get_monitor_type(Monitor p_monitor) const
 		MONITOR_TYPE_QUANTITY,
 		MONITOR_TYPE_QUANTITY,
 		MONITOR_TYPE_TIME,
+		MONITOR_TYPE_QUANTITY,
+		MONITOR_TYPE_QUANTITY,
+		MONITOR_TYPE_MEMORY,
+		MONITOR_TYPE_MEMORY,
+		MONITOR_TYPE_MEMORY,
+		MONITOR_TYPE_MEMORY,
+		MONITOR_TYPE_MEMORY,
+		MONITOR_TYPE_MEMORY,
+		MONITOR_TYPE_MEMORY,
+		MONITOR_TYPE_QUANTITY,
+		MONITOR_TYPE_TIME,
+		MONITOR_TYPE_TIME,
+		MONITOR_TYPE_TIME,
+		MONITOR_TYPE_TIME,
+		MONITOR_TYPE_TIME,
+		MONITOR_TYPE_TIME,
+		MONITOR_TYPE_TIME,
+		MONITOR_TYPE_TIME,
+		MONITOR_TYPE_TIME,
+		MONITOR_TYPE_MEMORY,
+		MONITOR_TYPE_QUANTITY,
+		MONITOR_TYPE_MEMORY,
+		MONITOR_TYPE_MEMORY,
+		MONITOR_TYPE_MEMORY,
+		MONITOR_TYPE_MEMORY,
+		MONITOR_TYPE_MEMORY,
+		MONITOR_TYPE_TIME,
+		MONITOR_TYPE_TIME,
+		MONITOR_TYPE_TIME,
+		MONITOR_TYPE_TIME,
+		MONITOR_TYPE_QUANTITY,
 
 	};
 
@@ -209,9 +400,185 @@ void Performance::set_physics_process_time(float p_pt) {
 	_physics_process_time = p_pt;
 }
 
+void Performance::add_frame_time(uint64_t p_usec) {
+
+	if (frame_times.empty()) {
+		return;
+	}
+
+	uint32_t usec = MIN(p_usec, (uint64_t)0xFFFFFFFF);
+	frame_times.write[frame_time_pos] = usec;
+	frame_time_pos = (frame_time_pos + 1) % frame_times.size();
+	frame_time_count = MIN(frame_time_count + 1, frame_times.size());
+	frame_stats.dirty = true;
+	if (frames_since_hitch_trace < hitch_trace_frames) {
+		frames_since_hitch_trace++;
+	}
+
+	if (hitch_threshold > 0 && USEC_TO_SEC(usec) > hitch_threshold) {
+		hitch_count++;
+		_capture_hitch_trace();
+		emit_signal("hitch_detected", USEC_TO_SEC(usec));
+	}
+}
+
+void Performance::_capture_hitch_trace() {
+
+#ifdef DEBUG_ENABLED
+	// Consecutive hitches would mostly dump the same frames again.
+	if (hitch_trace_path == "" || frames_since_hitch_trace < hitch_trace_frames) {
+		return;
+	}
+	frames_since_hitch_trace = 0;
+
+	DirAccess *da = DirAccess::create_for_path(hitch_trace_path);
+	da->make_dir_recursive(hitch_trace_path);
+	memdelete(da);
+
+	String path = hitch_trace_path.plus_file("hitch_" + itos(Engine::get_singleton()->get_idle_frames()) + ".json");
+	if (Trace::dump_history(path) == OK) {
+		print_verbose("Hitch trace written to " + path);
+	}
+#endif
+}
+
+void Performance::_update_frame_stats() const {
+
+	if (!frame_stats.dirty) {
+		return;
+	}
+	frame_stats.dirty = false;
+
+	if (frame_time_count == 0) {
+		frame_stats.average = 0;
+		frame_stats.p50 = 0;
+		frame_stats.p95 = 0;
+		frame_stats.p99 = 0;
+		frame_stats.max = 0;
+		return;
+	}
+
+	Vector<uint32_t> sorted = frame_times;
+	sorted.resize(frame_time_count);
+	sorted.sort();
+
+	uint64_t total = 0;
+	for (int i = 0; i < frame_time_count; i++) {
+		total += sorted[i];
+	}
+
+	// Nearest rank, so p99 over fewer than 100 frames is the worst frame.
+	const uint32_t *r = sorted.ptr();
+	frame_stats.average = USEC_TO_SEC(total / frame_time_count);
+	frame_stats.p50 = USEC_TO_SEC(r[CLAMP((int)Math::ceil(frame_time_count * 0.50) - 1, 0, frame_time_count - 1)]);
+	frame_stats.p95 = USEC_TO_SEC(r[CLAMP((int)Math::ceil(frame_time_count * 0.95) - 1, 0, frame_time_count - 1)]);
+	frame_stats.p99 = USEC_TO_SEC(r[CLAMP((int)Math::ceil(frame_time_count * 0.99) - 1, 0, frame_time_count - 1)]);
+	frame_stats.max = USEC_TO_SEC(r[frame_time_count - 1]);
+}
+
+void Performance::set_frame_history_size(int p_frames) {
+
+	ERR_FAIL_COND(p_frames < 1);
+
+	frame_times.resize(p_frames);
+	reset_frame_stats();
+}
+
+int Performance::get_frame_history_size() const {
+
+	return frame_times.size();
+}
+
+void Performance::set_hitch_threshold(float p_seconds) {
+
+	hitch_threshold = p_seconds;
+}
+
+float Performance::get_hitch_threshold() const {
+
+	return hitch_threshold;
+}
+
+void Performance::set_hitch_trace_path(const String &p_path) {
+
+	hitch_trace_path = p_path;
+#ifdef DEBUG_ENABLED
+	Trace::set_history_frames(hitch_trace_path == "" ? 0 : hitch_trace_frames);
+#endif
+}
+
+String Performance::get_hitch_trace_path() const {
+
+	return hitch_trace_path;
+}
+
+void Performance::set_hitch_trace_frames(int p_frames) {
+
+	ERR_FAIL_COND(p_frames < 1);
+
+	hitch_trace_frames = p_frames;
+#ifdef DEBUG_ENABLED
+	if (hitch_trace_path != "") {
+		Trace::set_history_frames(hitch_trace_frames);
+	}
+#endif
+}
+
+int Performance::get_hitch_trace_frames() const {
+
+	return hitch_trace_frames;
+}
+
+float Performance::get_frame_time_percentile(float p_percentile) const {
+
+	ERR_FAIL_COND_V(p_percentile < 0 || p_percentile > 100, 0);
+
+	if (frame_time_count == 0) {
+		return 0;
+	}
+
+	Vector<uint32_t> sorted = frame_times;
+	sorted.resize(frame_time_count);
+	sorted.sort();
+
+	int rank = CLAMP((int)Math::ceil(frame_time_count * p_percentile / 100.0) - 1, 0, frame_time_count - 1);
+	return USEC_TO_SEC(sorted[rank]);
+}
+
+Dictionary Performance::get_frame_stats() const {
+
+	_update_frame_stats();
+
+	Dictionary stats;
+	stats["frames"] = frame_time_count;
+	stats["average"] = frame_stats.average;
+	stats["p50"] = frame_stats.p50;
+	stats["p95"] = frame_stats.p95;
+	stats["p99"] = frame_stats.p99;
+	stats["max"] = frame_stats.max;
+	stats["hitches"] = hitch_count;
+	return stats;
+}
+
+void Performance::reset_frame_stats() {
+
+	frame_time_pos = 0;
+	frame_time_count = 0;
+	hitch_count = 0;
+	frame_stats.dirty = true;
+}
+
 Performance::Performance() {
 
 	_process_time = 0;
 	_physics_process_time = 0;
+	frame_time_pos = 0;
+	frame_time_count = 0;
+	hitch_threshold = 0;
+	hitch_count = 0;
+	hitch_trace_frames = 60;
+	frames_since_hitch_trace = hitch_trace_frames;
+	frame_stats.dirty = true;
+	frame_times.resize(300);
 	singleton = this;
 }
@@ -46,6 +46,31 @@ class Performance : public Object {
 	float _process_time;
 	float _physics_process_time;
 
+	// Frame to frame intervals in microseconds, a ring of the last frames.
+	Vector<uint32_t> frame_times;
+	int frame_time_pos;
+	int frame_time_count;
+
+	float hitch_threshold;
+	uint64_t hitch_count;
+	String hitch_trace_path;
+	int hitch_trace_frames;
+	int frames_since_hitch_trace;
+
+	struct FrameStats {
+		bool dirty;
+		float average;
+		float p50;
+		float p95;
+		float p99;
+		float max;
+	};
+
+	mutable FrameStats frame_stats;
+
+	void _update_frame_stats() const;
+	void _capture_hitch_trace();
+
 public:
 	enum Monitor {
 
@@ -78,6 +103,37 @@ public:
 		PHYSICS_3D_ISLAND_COUNT,
 		//physics
 		AUDIO_OUTPUT_LATENCY,
+		RENDER_2D_BATCHES_IN_FRAME,
+		NETWORK_SEND_QUEUE_PACKETS,
+		NETWORK_SEND_QUEUE_BYTES,
+		MEMORY_SMALL_OBJECTS,
+		MEMORY_RESOURCES,
+		MEMORY_SCENE,
+		MEMORY_PHYSICS,
+		MEMORY_RENDERING,
+		MEMORY_AUDIO,
+		OBJECT_GROUP_CALLS,
+		RENDER_FRAME_SYNC_TIME,
+		RENDER_GPU_SHADOWS_TIME,
+		RENDER_GPU_OPAQUE_TIME,
+		RENDER_GPU_ALPHA_TIME,
+		RENDER_GPU_SSAO_TIME,
+		RENDER_GPU_SSR_TIME,
+		RENDER_GPU_POST_PROCESS_TIME,
+		RENDER_GPU_GLOW_TIME,
+		RENDER_GPU_CANVAS_TIME,
+		MEMORY_SCRIPT,
+		MEMORY_ALLOCATIONS,
+		RENDER_TARGET_MEM_USED,
+		RENDER_SHADOW_MEM_USED,
+		RENDER_REFLECTION_MEM_USED,
+		RENDER_GI_PROBE_MEM_USED,
+		RENDER_MULTIMESH_MEM_USED,
+		TIME_FRAME_P50,
+		TIME_FRAME_P95,
+		TIME_FRAME_P99,
+		TIME_FRAME_MAX,
+		TIME_HITCHES,
 		MONITOR_MAX
 	};
 
@@ -88,6 +144,9 @@ public:
 	};
 
 	float get_monitor(Monitor p_monitor) const;
+
+	Dictionary get_memory_snapshot() const;
+	Dictionary compare_memory_snapshots(const Dictionary &p_from, const Dictionary &p_to) const;
 	String get_monitor_name(Monitor p_monitor) const;
 
 	MonitorType get_monitor_type(Monitor p_monitor) const;
@@ -95,6 +154,24 @@ public:
 	void set_process_time(float p_pt);
 	void set_physics_process_time(float p_pt);
 
+	void add_frame_time(uint64_t p_usec);
+
+	void set_frame_history_size(int p_frames);
+	int get_frame_history_size() const;
+
+	void set_hitch_threshold(float p_seconds);
+	float get_hitch_threshold() const;
+
+	void set_hitch_trace_path(const String &p_path);
+	String get_hitch_trace_path() const;
+
+	void set_hitch_trace_frames(int p_frames);
+	int get_hitch_trace_frames() const;
+
+	float get_frame_time_percentile(float p_percentile) const;
+	Dictionary get_frame_stats() const;
+	void reset_frame_stats();
+
 	static Performance *get_singleton() { return singleton; }
 
 	Performance();
@@ -87,11 +87,94 @@ bool test_abcx() {
 	return ok;
 }
 
+static void build_grid(AStar &p_astar, int p_size) {
+	for (int y = 0; y < p_size; y++) {
+		for (int x = 0; x < p_size; x++) {
+			p_astar.add_point(y * p_size + x, Vector3(x, y, 0));
+		}
+	}
+	for (int y = 0; y < p_size; y++) {
+		for (int x = 0; x < p_size; x++) {
+			int id = y * p_size + x;
+			if (x + 1 < p_size)
+				p_astar.connect_points(id, id + 1);
+			if (y + 1 < p_size)
+				p_astar.connect_points(id, id + p_size);
+		}
+	}
+}
+
+bool test_remove_point() {
+	ABCX abcx;
+	abcx.remove_point(ABCX::B);
+	PoolVector<int> path = abcx.get_id_path(ABCX::X, ABCX::C);
+	bool ok = path.size() == 3;
+	int i = 0;
+	ok = ok && path[i++] == ABCX::X;
+	ok = ok && path[i++] == ABCX::A;
+	ok = ok && path[i++] == ABCX::C;
+	ok = ok && !abcx.are_points_connected(ABCX::A, ABCX::B);
+	return ok;
+}
+
+bool test_batch() {
+	const int size = 40;
+	AStar a;
+	build_grid(a, size);
+
+	PoolVector<int> from;
+	PoolVector<int> to;
+	for (int i = 0; i < 64; i++) {
+		from.push_back((i * 7919) % (size * size));
+		to.push_back((i * 104729 + 13) % (size * size));
+	}
+
+	Array paths = a.get_id_paths_batch(from, to);
+	bool ok = paths.size() == from.size();
+	for (int i = 0; ok && i < from.size(); i++) {
+		PoolVector<int> batched = paths[i];
+		PoolVector<int> single = a.get_id_path(from[i], to[i]);
+		ok = batched.size() == single.size() && batched.size() > 0;
+		for (int j = 0; ok && j < single.size(); j++) {
+			ok = batched[j] == single[j];
+		}
+	}
+	return ok;
+}
+
+bool test_benchmark() {
+	const int size = 500;
+	AStar a;
+	build_grid(a, size);
+
+	uint64_t begin = OS::get_singleton()->get_ticks_usec();
+	PoolVector<int> path = a.get_id_path(0, size * size - 1);
+	uint64_t single_usec = OS::get_singleton()->get_ticks_usec() - begin;
+
+	PoolVector<int> from;
+	PoolVector<int> to;
+	for (int i = 0; i < 32; i++) {
+		from.push_back(i * size);
+		to.push_back(size * size - 1 - i);
+	}
+
+	begin = OS::get_singleton()->get_ticks_usec();
+	Array paths = a.get_id_paths_batch(from, to);
+	uint64_t batch_usec = OS::get_singleton()->get_ticks_usec() - begin;
+
+	OS::get_singleton()->print("\t%i points, single query: %.2f ms, batch of %i queries: %.2f ms\n", size * size, single_usec / 1000.0, from.size(), batch_usec / 1000.0);
+
+	return path.size() == size * 2 - 1 && paths.size() == from.size();
+}
+
 typedef bool (*TestFunc)(void);
 
 TestFunc test_funcs[] = {
 	test_abc,
 	test_abcx,
+	test_remove_point,
+	test_batch,
+	test_benchmark,
 	NULL
 };
 
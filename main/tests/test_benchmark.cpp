@@ -0,0 +1,706 @@
+/*************************************************************************/
+/*  test_benchmark.cpp                                                   */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2019 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2019 Godot Engine contributors (cf. AUTHORS.md)    */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#include "test_benchmark.h"
+
+#include "core/flat_map.h"
+#include "core/hash_map.h"
+#include "core/image.h"
+#include "core/io/json.h"
+#include "core/io/resource_loader.h"
+#include "core/io/resource_saver.h"
+#include "core/local_vector.h"
+#include "core/map.h"
+#include "core/math/math_funcs.h"
+#include "core/math/octree.h"
+#include "core/oa_hash_map.h"
+#include "core/os/file_access.h"
+#include "core/os/os.h"
+#include "core/small_vector.h"
+#include "core/sort_array.h"
+#include "core/version.h"
+#include "scene/main/scene_tree.h"
+#include "scene/main/viewport.h"
+#include "scene/resources/curve.h"
+#include "scene/resources/packed_scene.h"
+#include "servers/physics_server.h"
+
+#ifdef GDSCRIPT_ENABLED
+#include "modules/gdscript/gdscript.h"
+#endif
+
+namespace TestBenchmark {
+
+static Registrar *registrars = NULL;
+static volatile uint64_t sink = 0;
+
+Registrar::Registrar(const char *p_name, BenchmarkFunc p_func) {
+
+	name = p_name;
+	func = p_func;
+	next = registrars;
+	registrars = this;
+}
+
+void consume(uint64_t p_value) {
+
+	sink = sink + p_value;
+}
+
+} // namespace TestBenchmark
+
+/* VARIANT */
+
+BENCHMARK(variant_add_int) {
+
+	Variant a = 1;
+	Variant b = 2;
+	for (int i = 0; i < p_repeat; i++) {
+		Variant r;
+		bool valid;
+		Variant::evaluate(Variant::OP_ADD, a, b, r, valid);
+		a = r;
+	}
+	TestBenchmark::consume((int64_t)a);
+}
+
+BENCHMARK(variant_call_method) {
+
+	Variant s = String("benchmark");
+	for (int i = 0; i < p_repeat; i++) {
+		Variant::CallError ce;
+		TestBenchmark::consume((int64_t)s.call("length", NULL, 0, ce));
+	}
+}
+
+BENCHMARK(variant_dictionary_get_set) {
+
+	Dictionary d;
+	for (int i = 0; i < p_repeat; i++) {
+		d[i & 255] = i;
+		TestBenchmark::consume((int64_t)d[(i * 7) & 255]);
+	}
+}
+
+/* CONTAINERS */
+
+BENCHMARK(vector_push_back) {
+
+	Vector<int> v;
+	for (int i = 0; i < p_repeat; i++) {
+		v.push_back(i);
+	}
+	TestBenchmark::consume(v.size());
+}
+
+BENCHMARK(local_vector_push_back) {
+
+	LocalVector<int> v;
+	for (int i = 0; i < p_repeat; i++) {
+		v.push_back(i);
+	}
+	TestBenchmark::consume(v.size());
+}
+
+// per frame list that is cleared and refilled, as done for canvas commands and shadow casters
+BENCHMARK(vector_clear_refill) {
+
+	Vector<int> v;
+	for (int i = 0; i < p_repeat; i++) {
+		v.clear();
+		for (int j = 0; j < 32; j++) {
+			v.push_back(j);
+		}
+		TestBenchmark::consume(v[i & 31]);
+	}
+}
+
+BENCHMARK(local_vector_clear_refill) {
+
+	LocalVector<int> v;
+	for (int i = 0; i < p_repeat; i++) {
+		v.clear();
+		for (int j = 0; j < 32; j++) {
+			v.push_back(j);
+		}
+		TestBenchmark::consume(v[i & 31]);
+	}
+}
+
+// short temporaries, like the planes built for each shadow pass
+BENCHMARK(vector_temporary_planes) {
+
+	for (int i = 0; i < p_repeat; i++) {
+		Vector<Plane> planes;
+		for (int j = 0; j < 6; j++) {
+			planes.push_back(Plane(Vector3(j, i, 1), j));
+		}
+		TestBenchmark::consume(planes[i % 6].d);
+	}
+}
+
+BENCHMARK(small_vector_temporary_planes) {
+
+	for (int i = 0; i < p_repeat; i++) {
+		SmallVector<Plane, 6> planes;
+		for (int j = 0; j < 6; j++) {
+			planes.push_back(Plane(Vector3(j, i, 1), j));
+		}
+		TestBenchmark::consume(planes[i % 6].d);
+	}
+}
+
+BENCHMARK(map_insert_find) {
+
+	Map<int, int> m;
+	for (int i = 0; i < p_repeat; i++) {
+		m.insert((i * 7919) % (p_repeat + 1), i);
+	}
+	for (int i = 0; i < p_repeat; i++) {
+		TestBenchmark::consume(m.has(i));
+	}
+}
+
+BENCHMARK(hash_map_insert_find) {
+
+	HashMap<int, int> m;
+	for (int i = 0; i < p_repeat; i++) {
+		m.set((i * 7919) % (p_repeat + 1), i);
+	}
+	for (int i = 0; i < p_repeat; i++) {
+		TestBenchmark::consume(m.has(i));
+	}
+}
+
+BENCHMARK(oa_hash_map_insert_find) {
+
+	OAHashMap<int, int> m;
+	for (int i = 0; i < p_repeat; i++) {
+		m.set((i * 7919) % (p_repeat + 1), i);
+	}
+	for (int i = 0; i < p_repeat; i++) {
+		int v = 0;
+		TestBenchmark::consume(m.lookup(i, v));
+	}
+}
+
+BENCHMARK(map_small_rebuild) {
+
+	Map<int, int> m;
+	for (int i = 0; i < p_repeat; i++) {
+		for (int j = 0; j < 32; j++) {
+			m[(j * 13 + i) & 63]++;
+		}
+		for (Map<int, int>::Element *E = m.front(); E; E = E->next()) {
+			TestBenchmark::consume(E->get());
+		}
+		m.clear();
+	}
+}
+
+BENCHMARK(flat_map_small_rebuild) {
+
+	FlatMap<int, int> m;
+	for (int i = 0; i < p_repeat; i++) {
+		for (int j = 0; j < 32; j++) {
+			m[(j * 13 + i) & 63]++;
+		}
+		for (int j = 0; j < m.size(); j++) {
+			TestBenchmark::consume(m.getv(j));
+		}
+		m.clear();
+	}
+}
+
+BENCHMARK(sort_array_int) {
+
+	Vector<int> v;
+	v.resize(p_repeat);
+	uint64_t seed = 12345;
+	for (int i = 0; i < p_repeat; i++) {
+		v.write[i] = Math::rand_from_seed(&seed);
+	}
+	v.sort();
+	TestBenchmark::consume(v[0]);
+}
+
+/* STRING */
+
+BENCHMARK(string_concat) {
+
+	for (int i = 0; i < p_repeat; i++) {
+		String s = "res://";
+		s += "folder";
+		s += "/";
+		s += itos(i);
+		s += ".tscn";
+		TestBenchmark::consume(s.length());
+	}
+}
+
+BENCHMARK(string_split_join) {
+
+	String csv = "alpha,beta,gamma,delta,epsilon,zeta,eta,theta";
+	for (int i = 0; i < p_repeat; i++) {
+		Vector<String> parts = csv.split(",");
+		String joined = String("/").join(parts);
+		TestBenchmark::consume(joined.length());
+	}
+}
+
+BENCHMARK(string_hash) {
+
+	String s = "res://assets/characters/player/player_idle_animation.tres";
+	for (int i = 0; i < p_repeat; i++) {
+		TestBenchmark::consume(s.hash());
+	}
+}
+
+BENCHMARK(string_name_lookup) {
+
+	for (int i = 0; i < p_repeat; i++) {
+		StringName sn = "_physics_process";
+		TestBenchmark::consume((uint64_t)sn.data_unique_pointer());
+	}
+}
+
+/* JSON */
+
+static const char *benchmark_json = "{\"name\": \"player\", \"position\": [12.5, -3.25, 0.0], \"health\": 100, \"alive\": true, \"inventory\": [{\"id\": 1, \"count\": 3}, {\"id\": 7, \"count\": 1}, {\"id\": 42, \"count\": 12}], \"tags\": [\"hero\", \"ranged\", \"quest\"]}";
+
+BENCHMARK(json_parse) {
+
+	String text = benchmark_json;
+	for (int i = 0; i < p_repeat; i++) {
+		Variant v;
+		String err;
+		int line;
+		JSON::parse(text, v, err, line);
+		TestBenchmark::consume(v.get_type());
+	}
+}
+
+BENCHMARK(json_print) {
+
+	Variant v;
+	String err;
+	int line;
+	JSON::parse(benchmark_json, v, err, line);
+	for (int i = 0; i < p_repeat; i++) {
+		TestBenchmark::consume(JSON::print(v).length());
+	}
+}
+
+/* IMAGE */
+
+// large enough for resize() and generate_mipmaps() to split the rows across threads
+static Ref<Image> _benchmark_image() {
+
+	static Ref<Image> image;
+	if (image.is_null()) {
+		PoolVector<uint8_t> data;
+		data.resize(1024 * 1024 * 4);
+		{
+			PoolVector<uint8_t>::Write w = data.write();
+			for (int i = 0; i < data.size(); i++) {
+				w[i] = (i * 7 + (i >> 12)) & 0xFF;
+			}
+		}
+		image.instance();
+		image->create(1024, 1024, false, Image::FORMAT_RGBA8, data);
+	}
+	return image;
+}
+
+BENCHMARK(image_resize_bilinear) {
+
+	Ref<Image> source = _benchmark_image();
+	for (int i = 0; i < p_repeat; i++) {
+		Ref<Image> img = source->duplicate();
+		img->resize(1536, 1536, Image::INTERPOLATE_BILINEAR);
+		TestBenchmark::consume(img->get_width());
+	}
+}
+
+BENCHMARK(image_resize_cubic) {
+
+	Ref<Image> source = _benchmark_image();
+	for (int i = 0; i < p_repeat; i++) {
+		Ref<Image> img = source->duplicate();
+		img->resize(768, 768, Image::INTERPOLATE_CUBIC);
+		TestBenchmark::consume(img->get_width());
+	}
+}
+
+BENCHMARK(image_generate_mipmaps) {
+
+	Ref<Image> source = _benchmark_image();
+	for (int i = 0; i < p_repeat; i++) {
+		Ref<Image> img = source->duplicate();
+		img->generate_mipmaps();
+		TestBenchmark::consume(img->get_mipmap_count());
+	}
+}
+
+/* GDSCRIPT */
+
+#ifdef GDSCRIPT_ENABLED
+
+BENCHMARK(gdscript_loop) {
+
+	static Ref<GDScript> script;
+	if (script.is_null()) {
+		script.instance();
+		script->set_source_code("static func run(n):\n\tvar s = 0\n\tfor i in range(n):\n\t\ts += i * 2\n\treturn s\n");
+		script->reload();
+	}
+
+	Variant n = p_repeat;
+	const Variant *args[1] = { &n };
+	Variant::CallError ce;
+	// GDScript::call() is protected, static functions are called through Object
+	Object *obj = script.ptr();
+	TestBenchmark::consume((int64_t)obj->call("run", args, 1, ce));
+}
+
+BENCHMARK(gdscript_call) {
+
+	static Ref<GDScript> script;
+	if (script.is_null()) {
+		script.instance();
+		script->set_source_code("static func add(a, b):\n\treturn a + b\n");
+		script->reload();
+	}
+
+	Variant a = 1;
+	Variant b = 2;
+	const Variant *args[2] = { &a, &b };
+	Object *obj = script.ptr();
+	for (int i = 0; i < p_repeat; i++) {
+		Variant::CallError ce;
+		TestBenchmark::consume((int64_t)obj->call("add", args, 2, ce));
+	}
+}
+
+#endif
+
+/* PHYSICS */
+
+BENCHMARK(physics_3d_step) {
+
+	static RID space;
+	PhysicsServer *ps = PhysicsServer::get_singleton();
+
+	if (!space.is_valid()) {
+		space = ps->space_create();
+		ps->space_set_active(space, true);
+
+		RID floor_shape = ps->shape_create(PhysicsServer::SHAPE_PLANE);
+		ps->shape_set_data(floor_shape, Plane(Vector3(0, 1, 0), 0));
+		RID floor = ps->body_create(PhysicsServer::BODY_MODE_STATIC);
+		ps->body_add_shape(floor, floor_shape);
+		ps->body_set_space(floor, space);
+
+		RID box = ps->shape_create(PhysicsServer::SHAPE_BOX);
+		ps->shape_set_data(box, Vector3(0.5, 0.5, 0.5));
+		for (int i = 0; i < 256; i++) {
+			RID body = ps->body_create(PhysicsServer::BODY_MODE_RIGID);
+			ps->body_add_shape(body, box);
+			ps->body_set_space(body, space);
+			ps->body_set_state(body, PhysicsServer::BODY_STATE_TRANSFORM, Transform(Basis(), Vector3((i % 16) * 1.1, 1 + (i / 16) * 1.1, 0)));
+		}
+	}
+
+	for (int i = 0; i < p_repeat; i++) {
+		ps->flush_queries();
+		ps->step(1.0 / 60.0);
+	}
+}
+
+/* CULLING */
+
+BENCHMARK(octree_cull_aabb) {
+
+	static Octree<int, false> *octree = NULL;
+	static int payload = 0;
+	if (!octree) {
+		octree = memnew((Octree<int, false>));
+		uint64_t seed = 4321;
+		for (int i = 0; i < 8192; i++) {
+			Vector3 pos(Math::rand_from_seed(&seed) % 1000 - 500.0, Math::rand_from_seed(&seed) % 100 - 50.0, Math::rand_from_seed(&seed) % 1000 - 500.0);
+			octree->create(&payload, AABB(pos, Vector3(1, 1, 1) * (1 + Math::rand_from_seed(&seed) % 8)));
+		}
+	}
+
+	int *result[1024];
+	for (int i = 0; i < p_repeat; i++) {
+		Vector3 pos(((i * 37) % 1000) - 500.0, 0, ((i * 91) % 1000) - 500.0);
+		TestBenchmark::consume(octree->cull_aabb(AABB(pos - Vector3(40, 40, 40), Vector3(80, 80, 80)), result, 1024));
+	}
+}
+
+/* RESOURCES */
+
+BENCHMARK(resource_load_text) {
+
+	static String path;
+	if (path == String()) {
+		Ref<Curve2D> curve;
+		curve.instance();
+		for (int i = 0; i < 256; i++) {
+			curve->add_point(Vector2(i, Math::sin(i * 0.1) * 100.0), Vector2(-1, 0), Vector2(1, 0));
+		}
+		path = "user://benchmark_resource.tres";
+		ResourceSaver::save(path, curve);
+	}
+
+	for (int i = 0; i < p_repeat; i++) {
+		RES res = ResourceLoader::load(path, "", true);
+		TestBenchmark::consume(res.is_valid());
+	}
+}
+
+namespace TestBenchmark {
+
+struct Options {
+	String filter;
+	String output;
+	String scene;
+	int iterations;
+	int warmup;
+	int frames;
+};
+
+static uint64_t _sample_usec(BenchmarkFunc p_func, int p_repeat) {
+
+	uint64_t begin = OS::get_singleton()->get_ticks_usec();
+	p_func(p_repeat);
+	return OS::get_singleton()->get_ticks_usec() - begin;
+}
+
+// Summary statistics of a set of samples, each one expressed in
+// nanoseconds per operation.
+static Dictionary _summarize(const String &p_name, Vector<double> p_samples, int p_repeat) {
+
+	p_samples.sort();
+	int count = p_samples.size();
+
+	double mean = 0;
+	for (int i = 0; i < count; i++) {
+		mean += p_samples[i];
+	}
+	mean /= MAX(count, 1);
+
+	double variance = 0;
+	for (int i = 0; i < count; i++) {
+		variance += (p_samples[i] - mean) * (p_samples[i] - mean);
+	}
+	variance /= MAX(count - 1, 1);
+
+	double median = 0;
+	if (count) {
+		median = (count & 1) ? p_samples[count / 2] : (p_samples[count / 2 - 1] + p_samples[count / 2]) * 0.5;
+	}
+
+	Dictionary d;
+	d["name"] = p_name;
+	d["iterations"] = count;
+	d["repeat"] = p_repeat;
+	d["min_ns"] = count ? p_samples[0] : 0.0;
+	d["median_ns"] = median;
+	d["mean_ns"] = mean;
+	d["stddev_ns"] = Math::sqrt(variance);
+	d["max_ns"] = count ? p_samples[count - 1] : 0.0;
+	return d;
+}
+
+static void _print_result(const Dictionary &p_result) {
+
+	OS::get_singleton()->print("%-28s %12.1f ns median  %12.1f ns mean  +- %5.1f%%  (%d x %d)\n",
+			String(p_result["name"]).utf8().get_data(),
+			(double)p_result["median_ns"],
+			(double)p_result["mean_ns"],
+			(double)p_result["mean_ns"] > 0 ? 100.0 * (double)p_result["stddev_ns"] / (double)p_result["mean_ns"] : 0.0,
+			(int)p_result["iterations"],
+			(int)p_result["repeat"]);
+}
+
+static void _write_results(const Options &p_options, const Array &p_results) {
+
+	if (p_options.output == String()) {
+		return;
+	}
+
+	Dictionary report;
+	report["engine"] = VERSION_FULL_BUILD;
+	report["os"] = OS::get_singleton()->get_name();
+	report["processors"] = OS::get_singleton()->get_processor_count();
+	report["timestamp"] = OS::get_singleton()->get_unix_time();
+	report["benchmarks"] = p_results;
+
+	Error err;
+	FileAccess *f = FileAccess::open(p_options.output, FileAccess::WRITE, &err);
+	ERR_FAIL_COND(!f);
+	f->store_string(JSON::print(report, "\t"));
+	f->close();
+	memdelete(f);
+
+	OS::get_singleton()->print("Results written to %s\n", p_options.output.utf8().get_data());
+}
+
+static Array _run_micro(const Options &p_options) {
+
+	// Registration prepends, restore declaration order for stable reports.
+	Vector<Registrar *> list;
+	for (Registrar *r = registrars; r; r = r->next) {
+		list.insert(0, r);
+	}
+
+	Array results;
+	for (int i = 0; i < list.size(); i++) {
+
+		Registrar *r = list[i];
+		if (p_options.filter != String() && String(r->name).find(p_options.filter) == -1) {
+			continue;
+		}
+
+		// Grow the repeat count until one sample lasts at least a millisecond,
+		// so the microsecond clock does not dominate the measurement.
+		int repeat = 1;
+		while (repeat < (1 << 24) && _sample_usec(r->func, repeat) < 1000) {
+			repeat *= 2;
+		}
+
+		for (int j = 0; j < p_options.warmup; j++) {
+			r->func(repeat);
+		}
+
+		Vector<double> samples;
+		for (int j = 0; j < p_options.iterations; j++) {
+			samples.push_back(_sample_usec(r->func, repeat) * 1000.0 / repeat);
+		}
+
+		Dictionary result = _summarize(r->name, samples, repeat);
+		_print_result(result);
+		results.push_back(result);
+	}
+
+	return results;
+}
+
+// Runs a scene for a fixed number of frames and reports the frame times.
+// Meant for reference scenes run headless, e.g. with the server platform.
+class BenchmarkSceneTree : public SceneTree {
+
+	Options options;
+	int frame;
+	uint64_t last_ticks;
+	Vector<double> samples;
+
+public:
+	virtual void init() {
+
+		SceneTree::init();
+
+		Ref<PackedScene> scene = ResourceLoader::load(options.scene);
+		if (scene.is_null()) {
+			ERR_PRINTS("Can't load benchmark scene: " + options.scene);
+			quit();
+			return;
+		}
+		get_root()->add_child(scene->instance());
+	}
+
+	virtual bool idle(float p_time) {
+
+		bool exit = SceneTree::idle(p_time);
+
+		uint64_t ticks = OS::get_singleton()->get_ticks_usec();
+		if (frame > options.warmup) {
+			samples.push_back((ticks - last_ticks) * 1000.0);
+		}
+		last_ticks = ticks;
+		frame++;
+
+		if (samples.size() >= options.frames) {
+			Dictionary result = _summarize("scene:" + options.scene, samples, 1);
+			_print_result(result);
+			Array results;
+			results.push_back(result);
+			_write_results(options, results);
+			return true;
+		}
+
+		return exit;
+	}
+
+	BenchmarkSceneTree(const Options &p_options) {
+		options = p_options;
+		frame = 0;
+		last_ticks = 0;
+	}
+};
+
+MainLoop *test(const List<String> &p_args) {
+
+	Options options;
+	options.iterations = 20;
+	options.warmup = 3;
+	options.frames = 300;
+
+	for (const List<String>::Element *E = p_args.front(); E; E = E->next()) {
+		if (!E->next()) {
+			break;
+		}
+		String value = E->next()->get();
+		if (E->get() == "--benchmark-filter") {
+			options.filter = value;
+		} else if (E->get() == "--benchmark-output") {
+			options.output = value;
+		} else if (E->get() == "--benchmark-scene") {
+			options.scene = value;
+		} else if (E->get() == "--benchmark-iterations") {
+			options.iterations = MAX(1, value.to_int());
+		} else if (E->get() == "--benchmark-frames") {
+			options.frames = MAX(1, value.to_int());
+		} else if (E->get() == "--benchmark-warmup") {
+			options.warmup = MAX(0, value.to_int());
+		}
+	}
+
+	if (options.scene != String()) {
+		return memnew(BenchmarkSceneTree(options));
+	}
+
+	_write_results(options, _run_micro(options));
+	return NULL;
+}
+
+} // namespace TestBenchmark
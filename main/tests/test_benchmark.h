@@ -0,0 +1,63 @@
+/*************************************************************************/
+/*  test_benchmark.h                                                     */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2019 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2019 Godot Engine contributors (cf. AUTHORS.md)    */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#ifndef TEST_BENCHMARK_H
+#define TEST_BENCHMARK_H
+
+#include "core/list.h"
+#include "core/os/main_loop.h"
+#include "core/ustring.h"
+
+namespace TestBenchmark {
+
+typedef void (*BenchmarkFunc)(int p_repeat);
+
+struct Registrar {
+	const char *name;
+	BenchmarkFunc func;
+	Registrar *next;
+
+	Registrar(const char *p_name, BenchmarkFunc p_func);
+};
+
+// Keeps a computed value alive so the optimizer can not drop the work.
+void consume(uint64_t p_value);
+
+MainLoop *test(const List<String> &p_args);
+}
+
+// Defines a benchmark. The body runs the measured operation p_repeat times,
+// the runner picks p_repeat so each sample lasts about a millisecond.
+#define BENCHMARK(m_name)                                                                       \
+	static void _benchmark_##m_name(int p_repeat);                                             \
+	static TestBenchmark::Registrar _benchmark_registrar_##m_name(#m_name, _benchmark_##m_name); \
+	static void _benchmark_##m_name(int p_repeat)
+
+#endif // TEST_BENCHMARK_H
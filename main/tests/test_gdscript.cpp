@@ -560,6 +560,10 @@ static void _disassemble_class(const Ref<GDScript> &p_class, const Vector<String
 
 			switch (code[ip]) {
 
+				case GDScriptFunction::OPCODE_OPERATOR_INT:
+				case GDScriptFunction::OPCODE_OPERATOR_REAL:
+				case GDScriptFunction::OPCODE_OPERATOR_VECTOR2:
+				case GDScriptFunction::OPCODE_OPERATOR_VECTOR3:
 				case GDScriptFunction::OPCODE_OPERATOR: {
 
 					int op = code[ip + 1];
@@ -575,6 +579,7 @@ static void _disassemble_class(const Ref<GDScript> &p_class, const Vector<String
 					incr += 5;
 
 				} break;
+				case GDScriptFunction::OPCODE_SET_ARRAY:
 				case GDScriptFunction::OPCODE_SET: {
 
 					txt += "set ";
@@ -586,6 +591,7 @@ static void _disassemble_class(const Ref<GDScript> &p_class, const Vector<String
 					incr += 4;
 
 				} break;
+				case GDScriptFunction::OPCODE_GET_ARRAY:
 				case GDScriptFunction::OPCODE_GET: {
 
 					txt += " get ";
@@ -598,6 +604,7 @@ static void _disassemble_class(const Ref<GDScript> &p_class, const Vector<String
 					incr += 4;
 
 				} break;
+				case GDScriptFunction::OPCODE_SET_NAMED_VECTOR:
 				case GDScriptFunction::OPCODE_SET_NAMED: {
 
 					txt += " set_named ";
@@ -609,6 +616,7 @@ static void _disassemble_class(const Ref<GDScript> &p_class, const Vector<String
 					incr += 4;
 
 				} break;
+				case GDScriptFunction::OPCODE_GET_NAMED_VECTOR:
 				case GDScriptFunction::OPCODE_GET_NAMED: {
 
 					txt += " get_named ";
@@ -728,18 +736,22 @@ static void _disassemble_class(const Ref<GDScript> &p_class, const Vector<String
 				} break;
 
 				case GDScriptFunction::OPCODE_CALL:
-				case GDScriptFunction::OPCODE_CALL_RETURN: {
+				case GDScriptFunction::OPCODE_CALL_RETURN:
+				case GDScriptFunction::OPCODE_CALL_METHOD_BIND:
+				case GDScriptFunction::OPCODE_CALL_METHOD_BIND_RETURN: {
 
-					bool ret = code[ip] == GDScriptFunction::OPCODE_CALL_RETURN;
+					bool ret = code[ip] == GDScriptFunction::OPCODE_CALL_RETURN || code[ip] == GDScriptFunction::OPCODE_CALL_METHOD_BIND_RETURN;
+					bool bind = code[ip] == GDScriptFunction::OPCODE_CALL_METHOD_BIND || code[ip] == GDScriptFunction::OPCODE_CALL_METHOD_BIND_RETURN;
+					int args = bind ? 5 : 4;
 
 					if (ret)
-						txt += " call-ret ";
+						txt += bind ? " call-bind-ret " : " call-ret ";
 					else
-						txt += " call ";
+						txt += bind ? " call-bind " : " call ";
 
 					int argc = code[ip + 1];
 					if (ret) {
-						txt += DADDR(4 + argc) + "=";
+						txt += DADDR(args + argc) + "=";
 					}
 
 					txt += DADDR(2) + ".";
@@ -749,11 +761,11 @@ static void _disassemble_class(const Ref<GDScript> &p_class, const Vector<String
 					for (int i = 0; i < argc; i++) {
 						if (i > 0)
 							txt += ", ";
-						txt += DADDR(4 + i);
+						txt += DADDR(args + i);
 					}
 					txt += ")";
 
-					incr = 5 + argc;
+					incr = args + 1 + argc;
 
 				} break;
 				case GDScriptFunction::OPCODE_CALL_BUILT_IN: {
@@ -866,6 +878,18 @@ static void _disassemble_class(const Ref<GDScript> &p_class, const Vector<String
 					txt += " for-loop " + DADDR(4) + " in " + DADDR(2) + " counter " + DADDR(1) + " end " + itos(code[ip + 3]);
 					incr += 5;
 
+				} break;
+				case GDScriptFunction::OPCODE_ITERATE_BEGIN_RANGE: {
+
+					txt += " for-init " + DADDR(8) + " in range(" + DADDR(4) + ", " + DADDR(5) + ", " + DADDR(6) + ") counter " + DADDR(1) + " end " + itos(code[ip + 7]);
+					incr += 9;
+
+				} break;
+				case GDScriptFunction::OPCODE_ITERATE_RANGE: {
+
+					txt += " for-loop " + DADDR(5) + " in range counter " + DADDR(1) + " end " + itos(code[ip + 4]);
+					incr += 6;
+
 				} break;
 				case GDScriptFunction::OPCODE_LINE: {
 
@@ -34,6 +34,7 @@
 #ifdef DEBUG_ENABLED
 
 #include "test_astar.h"
+#include "test_benchmark.h"
 #include "test_gdscript.h"
 #include "test_gui.h"
 #include "test_math.h"
@@ -62,6 +63,7 @@ const char **tests_get_names() {
 		"gd_bytecode",
 		"ordered_hash_map",
 		"astar",
+		"benchmark",
 		NULL
 	};
 
@@ -142,6 +144,11 @@ MainLoop *test_main(String p_test, const List<String> &p_args) {
 		return TestAStar::test();
 	}
 
+	if (p_test == "benchmark") {
+
+		return TestBenchmark::test(p_args);
+	}
+
 	print_line("Unknown test: " + p_test);
 	return NULL;
 }
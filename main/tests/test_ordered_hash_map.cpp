@@ -29,8 +29,10 @@
 /*************************************************************************/
 
 #include "core/ordered_hash_map.h"
+#include "core/ordered_oa_hash_map.h"
 #include "core/os/os.h"
 #include "core/pair.h"
+#include "core/variant.h"
 #include "core/vector.h"
 
 namespace TestOrderedHashMap {
@@ -128,6 +130,144 @@ bool test_const_iteration() {
 	return test_const_iteration(map);
 }
 
+bool test_oa_insert_overwrite() {
+	OrderedOAHashMap<int, int> map;
+	map.set(42, 84);
+	map.set(42, 1234);
+
+	return map.size() == 1 && map[42] == 1234;
+}
+
+bool test_oa_erase() {
+	OrderedOAHashMap<int, int> map;
+	map.set(42, 84);
+	map.set(7, 1);
+
+	return map.erase(42) && !map.erase(42) && !map.has(42) && map.has(7) && map.size() == 1;
+}
+
+bool test_oa_iteration() {
+	OrderedOAHashMap<int, int> map;
+
+	// Enough entries to switch from linear search to the index.
+	for (int i = 0; i < 100; i++) {
+		map.set(i * 7, i);
+	}
+	for (int i = 0; i < 100; i += 3) {
+		map.erase(i * 7);
+	}
+	map.set(1000, 1000);
+
+	int expected = 0;
+	for (OrderedOAHashMap<int, int>::Iterator it = map.iter(); it.valid; it = map.next_iter(it)) {
+		if (expected % 3 == 0) {
+			expected++;
+		}
+		if (expected < 100) {
+			if (*it.key != expected * 7 || *it.value != expected) {
+				return false;
+			}
+		} else if (*it.key != 1000) {
+			return false;
+		}
+		expected++;
+	}
+	return expected == 101;
+}
+
+bool test_oa_stable_references() {
+	OrderedOAHashMap<int, int> map;
+	int *first = &map[1];
+	*first = 10;
+
+	for (int i = 2; i < 1000; i++) {
+		map[i] = i;
+	}
+
+	return first == map.getptr(1) && *first == 10;
+}
+
+bool test_oa_copy() {
+	OrderedOAHashMap<int, int> map;
+	for (int i = 0; i < 50; i++) {
+		map.set(i, i * 2);
+	}
+	map.erase(10);
+
+	OrderedOAHashMap<int, int> copy(map);
+	map.set(10, 0);
+
+	if (copy.size() != 49 || copy.has(10)) {
+		return false;
+	}
+	for (int i = 0; i < 50; i++) {
+		if (i != 10 && copy[i] != i * 2) {
+			return false;
+		}
+	}
+	return true;
+}
+
+template <class M>
+static void _bench_fill(M &p_map, int p_count) {
+	for (int i = 0; i < p_count; i++) {
+		p_map[Variant(i)] = Variant(i);
+	}
+}
+
+bool test_performance() {
+	typedef OrderedHashMap<Variant, Variant, VariantHasher, VariantComparator> OldMap;
+	typedef OrderedOAHashMap<Variant, Variant, VariantHasher, VariantComparator> NewMap;
+
+	const int sizes[] = { 4, 8, 64, 100000 };
+
+	for (int s = 0; s < 4; s++) {
+		int size = sizes[s];
+		int maps = 400000 / size;
+		uint64_t t;
+
+		t = OS::get_singleton()->get_ticks_usec();
+		for (int i = 0; i < maps; i++) {
+			OldMap map;
+			_bench_fill(map, size);
+			for (int j = 0; j < size; j++) {
+				map.find(Variant(j));
+			}
+		}
+		uint64_t old_time = OS::get_singleton()->get_ticks_usec() - t;
+
+		t = OS::get_singleton()->get_ticks_usec();
+		for (int i = 0; i < maps; i++) {
+			NewMap map;
+			_bench_fill(map, size);
+			for (int j = 0; j < size; j++) {
+				map.getptr(Variant(j));
+			}
+		}
+		uint64_t new_time = OS::get_singleton()->get_ticks_usec() - t;
+
+		OS::get_singleton()->print("\t%i maps of %i entries, fill and lookup: OrderedHashMap %i usec, OrderedOAHashMap %i usec\n", maps, size, (int)old_time, (int)new_time);
+	}
+
+	OldMap old_map;
+	NewMap new_map;
+	_bench_fill(old_map, 64);
+	_bench_fill(new_map, 64);
+	uint64_t t = OS::get_singleton()->get_ticks_usec();
+	for (int i = 0; i < 10000; i++) {
+		OldMap copy(old_map);
+	}
+	uint64_t old_time = OS::get_singleton()->get_ticks_usec() - t;
+	t = OS::get_singleton()->get_ticks_usec();
+	for (int i = 0; i < 10000; i++) {
+		NewMap copy(new_map);
+	}
+	uint64_t new_time = OS::get_singleton()->get_ticks_usec() - t;
+	OS::get_singleton()->print("\t10000 copies of 64 entries: OrderedHashMap %i usec, OrderedOAHashMap %i usec\n", (int)old_time, (int)new_time);
+
+	return true;
+}
+
 typedef bool (*TestFunc)(void);
 
 TestFunc test_funcs[] = {
@@ -139,6 +279,12 @@ TestFunc test_funcs[] = {
 	test_size,
 	test_iteration,
 	test_const_iteration,
+	test_oa_insert_overwrite,
+	test_oa_erase,
+	test_oa_iteration,
+	test_oa_stable_references,
+	test_oa_copy,
+	test_performance,
 	0
 
 };
@@ -1053,6 +1053,88 @@ bool test_33() {
 	return empty.parse_utf8(NULL, -1) == true;
 }
 
+bool test_34() {
+
+	OS::get_singleton()->print("\n\nTest 34: vectorized paths match expected results, timings\n");
+
+	bool state = true;
+
+	// Lengths around the vector widths exercise both the block and tail loops.
+	for (int len = 0; len < 40; len++) {
+
+		String s;
+		for (int i = 0; i < len; i++) {
+			s += String::chr(i % 7 == 3 ? 0x00C9 : 'A' + (i % 26)); // mix in non-ASCII É
+		}
+
+		String lower = s.to_lower();
+		String upper = lower.to_upper();
+		for (int i = 0; i < len; i++) {
+			state = state && lower[i] == (s[i] == 0x00C9 ? 0x00E9 : s[i] + ('a' - 'A'));
+		}
+		state = state && upper == s;
+
+		String round_trip;
+		round_trip.parse_utf8(s.utf8().get_data());
+		state = state && round_trip == s;
+
+		uint32_t hashv = 5381;
+		for (int i = 0; i < len; i++) {
+			hashv = ((hashv << 5) + hashv) + s[i];
+		}
+		state = state && s.hash() == hashv && String::hash(s.c_str()) == hashv;
+
+		if (len > 0) {
+			state = state && s.find(s.substr(len - 1, 1)) == s.find_char(s[len - 1]);
+			state = state && s.find(s.substr(len / 2, len - len / 2)) <= len / 2;
+		}
+	}
+	OS::get_singleton()->print("\tcase, utf8, hash and find: %s\n", state ? "OK" : "FAIL");
+
+	String text;
+	for (int i = 0; i < 4096; i++) {
+		text += "The quick brown fox jumps over the lazy dog. ";
+	}
+	text += "needle";
+	CharString text_utf8 = text.utf8();
+
+	const int iterations = 20;
+	uint64_t ticks[5] = {};
+	int sink = 0;
+	for (int i = 0; i < iterations; i++) {
+
+		uint64_t t = OS::get_singleton()->get_ticks_usec();
+		sink += text.utf8().length();
+		ticks[0] += OS::get_singleton()->get_ticks_usec() - t;
+
+		t = OS::get_singleton()->get_ticks_usec();
+		String parsed;
+		parsed.parse_utf8(text_utf8.get_data());
+		sink += parsed.length();
+		ticks[1] += OS::get_singleton()->get_ticks_usec() - t;
+
+		t = OS::get_singleton()->get_ticks_usec();
+		sink += text.find("needle");
+		ticks[2] += OS::get_singleton()->get_ticks_usec() - t;
+
+		t = OS::get_singleton()->get_ticks_usec();
+		sink += text.to_upper().length();
+		ticks[3] += OS::get_singleton()->get_ticks_usec() - t;
+
+		t = OS::get_singleton()->get_ticks_usec();
+		sink += text.hash() & 1;
+		ticks[4] += OS::get_singleton()->get_ticks_usec() - t;
+	}
+
+	const char *names[5] = { "utf8()", "parse_utf8()", "find()", "to_upper()", "hash()" };
+	OS::get_singleton()->print("\t%-14s %10s  (%i chars, checksum %i)\n", "operation", "usec/call", text.length(), sink);
+	for (int i = 0; i < 5; i++) {
+		OS::get_singleton()->print("\t%-14s %10.1f\n", names[i], ticks[i] / (double)iterations);
+	}
+
+	return state;
+}
+
 typedef bool (*TestFunc)(void);
 
 TestFunc test_funcs[] = {
@@ -1090,6 +1172,7 @@ TestFunc test_funcs[] = {
 	test_31,
 	test_32,
 	test_33,
+	test_34,
 	0
 
 };
@@ -34,8 +34,11 @@
 #include "cone_twist_joint_bullet.h"
 #include "core/class_db.h"
 #include "core/error_macros.h"
+#include "core/script_language.h"
 #include "core/ustring.h"
+#include "core/project_settings.h"
 #include "generic_6dof_joint_bullet.h"
+#include "godot_task_scheduler.h"
 #include "hinge_joint_bullet.h"
 #include "pin_joint_bullet.h"
 #include "shape_bullet.h"
@@ -81,7 +84,8 @@ void BulletPhysicsServer::_bind_methods() {
 BulletPhysicsServer::BulletPhysicsServer() :
 		PhysicsServer(),
 		active(true),
-		active_spaces_count(0) {}
+		active_spaces_count(0),
+		task_scheduler(NULL) {}
 
 BulletPhysicsServer::~BulletPhysicsServer() {}
 
@@ -221,6 +225,27 @@ PhysicsDirectSpaceState *BulletPhysicsServer::space_get_direct_state(RID p_space
 	return space->get_direct_state();
 }
 
+void BulletPhysicsServer::space_set_history_size(RID p_space, int p_ticks) {
+	if (p_ticks == 0)
+		return; // Nothing is recorded, which is all Bullet can do.
+
+	ERR_EXPLAIN("Space history is only available with the GodotPhysics backend.");
+	ERR_FAIL();
+}
+
+int BulletPhysicsServer::space_get_history_size(RID p_space) const {
+	return 0;
+}
+
+uint64_t BulletPhysicsServer::space_get_history_tick(RID p_space) const {
+	return 0;
+}
+
+PhysicsDirectSpaceState *BulletPhysicsServer::space_get_direct_state_at_tick(RID p_space, uint64_t p_tick) {
+	ERR_EXPLAIN("Space history is only available with the GodotPhysics backend.");
+	ERR_FAIL_V(NULL);
+}
+
 void BulletPhysicsServer::space_set_debug_contacts(RID p_space, int p_max_contacts) {
 	SpaceBullet *space = space_owner.get(p_space);
 	ERR_FAIL_COND(!space);
@@ -242,6 +267,13 @@ int BulletPhysicsServer::space_get_contact_count(RID p_space) const {
 	return space->get_debug_contact_count();
 }
 
+int BulletPhysicsServer::space_get_info(RID p_space, SpaceInfo p_info) {
+	SpaceBullet *space = space_owner.get(p_space);
+	ERR_FAIL_COND_V(!space, 0);
+
+	return space->get_info(p_info);
+}
+
 RID BulletPhysicsServer::area_create() {
 	AreaBullet *area = bulletnew(AreaBullet);
 	area->set_collision_layer(1);
@@ -569,14 +601,14 @@ void BulletPhysicsServer::body_clear_shapes(RID p_body) {
 	body->remove_all_shapes();
 }
 
-void BulletPhysicsServer::body_attach_object_instance_id(RID p_body, uint32_t p_ID) {
+void BulletPhysicsServer::body_attach_object_instance_id(RID p_body, ObjectID p_ID) {
 	CollisionObjectBullet *body = get_collisin_object(p_body);
 	ERR_FAIL_COND(!body);
 
 	body->set_instance_id(p_ID);
 }
 
-uint32_t BulletPhysicsServer::body_get_object_instance_id(RID p_body) const {
+ObjectID BulletPhysicsServer::body_get_object_instance_id(RID p_body) const {
 	CollisionObjectBullet *body = get_collisin_object(p_body);
 	ERR_FAIL_COND_V(!body, 0);
 
@@ -841,6 +873,18 @@ bool BulletPhysicsServer::body_is_omitting_force_integration(RID p_body) const {
 	return body->get_omit_forces_integration();
 }
 
+void BulletPhysicsServer::body_set_record_history(RID p_body, bool p_enable) {
+	if (!p_enable)
+		return;
+
+	ERR_EXPLAIN("Space history is only available with the GodotPhysics backend.");
+	ERR_FAIL();
+}
+
+bool BulletPhysicsServer::body_is_recording_history(RID p_body) const {
+	return false;
+}
+
 void BulletPhysicsServer::body_set_force_integration_callback(RID p_body, Object *p_receiver, const StringName &p_method, const Variant &p_udata) {
 	RigidBodyBullet *body = rigid_body_owner.get(p_body);
 	ERR_FAIL_COND(!body);
@@ -1555,6 +1599,12 @@ void BulletPhysicsServer::free(RID p_rid) {
 
 void BulletPhysicsServer::init() {
 	BulletPhysicsDirectBodyState::initSingleton();
+
+	if (GLOBAL_GET("physics/3d/bullet/multithreaded_world")) {
+		// must be set before any multithreaded world is created
+		task_scheduler = memnew(GodotTaskScheduler(GLOBAL_GET("physics/3d/bullet/thread_count")));
+		btSetTaskScheduler(task_scheduler);
+	}
 }
 
 void BulletPhysicsServer::step(float p_deltaTime) {
@@ -1573,14 +1623,71 @@ void BulletPhysicsServer::sync() {
 }
 
 void BulletPhysicsServer::flush_queries() {
+	if (!active)
+		return;
+
+	if (ScriptDebugger::get_singleton() && ScriptDebugger::get_singleton()->is_profiling()) {
+
+		uint64_t total_time[SpaceBullet::ELAPSED_TIME_MAX];
+		static const char *time_name[SpaceBullet::ELAPSED_TIME_MAX] = {
+			"broadphase",
+			"narrowphase",
+			"solver",
+			"integrate"
+		};
+
+		for (int i = 0; i < SpaceBullet::ELAPSED_TIME_MAX; i++) {
+			total_time[i] = 0;
+		}
+
+		for (int i = 0; i < active_spaces_count; ++i) {
+			for (int j = 0; j < SpaceBullet::ELAPSED_TIME_MAX; j++) {
+				total_time[j] += active_spaces[i]->get_elapsed_time(SpaceBullet::ElapsedTime(j));
+			}
+		}
+
+		Array values;
+		values.resize(SpaceBullet::ELAPSED_TIME_MAX * 2);
+		for (int i = 0; i < SpaceBullet::ELAPSED_TIME_MAX; i++) {
+			values[i * 2 + 0] = time_name[i];
+			values[i * 2 + 1] = USEC_TO_SEC(total_time[i]);
+		}
+
+		ScriptDebugger::get_singleton()->add_profiling_frame_data("physics", values);
+	}
 }
 
 void BulletPhysicsServer::finish() {
 	BulletPhysicsDirectBodyState::destroySingleton();
+
+	if (task_scheduler) {
+		btSetTaskScheduler(NULL);
+		memdelete(task_scheduler);
+		task_scheduler = NULL;
+	}
 }
 
 int BulletPhysicsServer::get_process_info(ProcessInfo p_info) {
-	return 0;
+	SpaceInfo space_info;
+	switch (p_info) {
+		case INFO_ACTIVE_OBJECTS:
+			space_info = SPACE_INFO_ACTIVE_OBJECTS;
+			break;
+		case INFO_COLLISION_PAIRS:
+			space_info = SPACE_INFO_COLLISION_PAIRS;
+			break;
+		case INFO_ISLAND_COUNT:
+			space_info = SPACE_INFO_ISLAND_COUNT;
+			break;
+		default:
+			return 0;
+	}
+
+	int total = 0;
+	for (int i = 0; i < active_spaces_count; ++i) {
+		total += active_spaces[i]->get_info(space_info);
+	}
+	return total;
 }
 
 CollisionObjectBullet *BulletPhysicsServer::get_collisin_object(RID p_object) const {
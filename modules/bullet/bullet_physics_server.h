@@ -40,6 +40,8 @@
 #include "soft_body_bullet.h"
 #include "space_bullet.h"
 
+class GodotTaskScheduler;
+
 /**
 	@author AndreaCatania
 */
@@ -60,6 +62,8 @@ class BulletPhysicsServer : public PhysicsServer {
 	mutable RID_Owner<SoftBodyBullet> soft_body_owner;
 	mutable RID_Owner<JointBullet> joint_owner;
 
+	GodotTaskScheduler *task_scheduler;
+
 protected:
 	static void _bind_methods();
 
@@ -113,10 +117,17 @@ public:
 
 	virtual PhysicsDirectSpaceState *space_get_direct_state(RID p_space);
 
+	virtual void space_set_history_size(RID p_space, int p_ticks);
+	virtual int space_get_history_size(RID p_space) const;
+	virtual uint64_t space_get_history_tick(RID p_space) const;
+	virtual PhysicsDirectSpaceState *space_get_direct_state_at_tick(RID p_space, uint64_t p_tick);
+
 	virtual void space_set_debug_contacts(RID p_space, int p_max_contacts);
 	virtual Vector<Vector3> space_get_contacts(RID p_space) const;
 	virtual int space_get_contact_count(RID p_space) const;
 
+	virtual int space_get_info(RID p_space, SpaceInfo p_info);
+
 	/* AREA API */
 
 	/// Bullet Physics Engine not support "Area", this must be handled by the game developer in another way.
@@ -189,8 +200,8 @@ public:
 	virtual void body_clear_shapes(RID p_body);
 
 	// Used for Rigid and Soft Bodies
-	virtual void body_attach_object_instance_id(RID p_body, uint32_t p_ID);
-	virtual uint32_t body_get_object_instance_id(RID p_body) const;
+	virtual void body_attach_object_instance_id(RID p_body, ObjectID p_ID);
+	virtual ObjectID body_get_object_instance_id(RID p_body) const;
 
 	virtual void body_set_enable_continuous_collision_detection(RID p_body, bool p_enable);
 	virtual bool body_is_continuous_collision_detection_enabled(RID p_body) const;
@@ -246,6 +257,9 @@ public:
 	virtual void body_set_omit_force_integration(RID p_body, bool p_omit);
 	virtual bool body_is_omitting_force_integration(RID p_body) const;
 
+	virtual void body_set_record_history(RID p_body, bool p_enable);
+	virtual bool body_is_recording_history(RID p_body) const;
+
 	virtual void body_set_force_integration_callback(RID p_body, Object *p_receiver, const StringName &p_method, const Variant &p_udata = Variant());
 
 	virtual void body_set_ray_pickable(RID p_body, bool p_enable);
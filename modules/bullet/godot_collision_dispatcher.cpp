@@ -31,6 +31,7 @@
 #include "godot_collision_dispatcher.h"
 
 #include "collision_object_bullet.h"
+#include "core/os/os.h"
 
 /**
 	@author AndreaCatania
@@ -38,6 +39,11 @@
 
 const int GodotCollisionDispatcher::CASTED_TYPE_AREA = static_cast<int>(CollisionObjectBullet::TYPE_AREA);
 
+GodotDispatchTiming::GodotDispatchTiming() :
+		dispatch_begin(0),
+		dispatch_end(0),
+		dispatch_usec(0) {}
+
 GodotCollisionDispatcher::GodotCollisionDispatcher(btCollisionConfiguration *collisionConfiguration) :
 		btCollisionDispatcher(collisionConfiguration) {}
 
@@ -56,3 +62,36 @@ bool GodotCollisionDispatcher::needsResponse(const btCollisionObject *body0, con
 	}
 	return btCollisionDispatcher::needsResponse(body0, body1);
 }
+
+void GodotCollisionDispatcher::dispatchAllCollisionPairs(btOverlappingPairCache *pairCache, const btDispatcherInfo &dispatchInfo, btDispatcher *dispatcher) {
+	dispatch_begin = OS::get_singleton()->get_ticks_usec();
+	btCollisionDispatcher::dispatchAllCollisionPairs(pairCache, dispatchInfo, dispatcher);
+	dispatch_end = OS::get_singleton()->get_ticks_usec();
+	dispatch_usec += dispatch_end - dispatch_begin;
+}
+
+GodotCollisionDispatcherMt::GodotCollisionDispatcherMt(btCollisionConfiguration *collisionConfiguration) :
+		btCollisionDispatcherMt(collisionConfiguration) {}
+
+bool GodotCollisionDispatcherMt::needsCollision(const btCollisionObject *body0, const btCollisionObject *body1) {
+	if (body0->getUserIndex() == GodotCollisionDispatcher::CASTED_TYPE_AREA || body1->getUserIndex() == GodotCollisionDispatcher::CASTED_TYPE_AREA) {
+		// Avoide area narrow phase
+		return false;
+	}
+	return btCollisionDispatcherMt::needsCollision(body0, body1);
+}
+
+bool GodotCollisionDispatcherMt::needsResponse(const btCollisionObject *body0, const btCollisionObject *body1) {
+	if (body0->getUserIndex() == GodotCollisionDispatcher::CASTED_TYPE_AREA || body1->getUserIndex() == GodotCollisionDispatcher::CASTED_TYPE_AREA) {
+		// Avoide area narrow phase
+		return false;
+	}
+	return btCollisionDispatcherMt::needsResponse(body0, body1);
+}
+
+void GodotCollisionDispatcherMt::dispatchAllCollisionPairs(btOverlappingPairCache *pairCache, const btDispatcherInfo &dispatchInfo, btDispatcher *dispatcher) {
+	dispatch_begin = OS::get_singleton()->get_ticks_usec();
+	btCollisionDispatcherMt::dispatchAllCollisionPairs(pairCache, dispatchInfo, dispatcher);
+	dispatch_end = OS::get_singleton()->get_ticks_usec();
+	dispatch_usec += dispatch_end - dispatch_begin;
+}
@@ -33,14 +33,26 @@
 
 #include "core/int_types.h"
 
+#include <BulletCollision/CollisionDispatch/btCollisionDispatcherMt.h>
 #include <btBulletDynamicsCommon.h>
 
 /**
 	@author AndreaCatania
 */
 
+/// Timestamps of the last narrowphase, and its total time since reset by the space
+struct GodotDispatchTiming {
+	uint64_t dispatch_begin;
+	uint64_t dispatch_end;
+	uint64_t dispatch_usec;
+
+	GodotDispatchTiming();
+};
+
 /// This class is required to implement custom collision behaviour in the narrowphase
-class GodotCollisionDispatcher : public btCollisionDispatcher {
+class GodotCollisionDispatcher : public btCollisionDispatcher, public GodotDispatchTiming {
+	friend class GodotCollisionDispatcherMt;
+
 private:
 	static const int CASTED_TYPE_AREA;
 
@@ -48,5 +60,15 @@ public:
 	GodotCollisionDispatcher(btCollisionConfiguration *collisionConfiguration);
 	virtual bool needsCollision(const btCollisionObject *body0, const btCollisionObject *body1);
 	virtual bool needsResponse(const btCollisionObject *body0, const btCollisionObject *body1);
+	virtual void dispatchAllCollisionPairs(btOverlappingPairCache *pairCache, const btDispatcherInfo &dispatchInfo, btDispatcher *dispatcher);
+};
+
+/// Same as GodotCollisionDispatcher, for the multithreaded worlds
+class GodotCollisionDispatcherMt : public btCollisionDispatcherMt, public GodotDispatchTiming {
+public:
+	GodotCollisionDispatcherMt(btCollisionConfiguration *collisionConfiguration);
+	virtual bool needsCollision(const btCollisionObject *body0, const btCollisionObject *body1);
+	virtual bool needsResponse(const btCollisionObject *body0, const btCollisionObject *body1);
+	virtual void dispatchAllCollisionPairs(btOverlappingPairCache *pairCache, const btDispatcherInfo &dispatchInfo, btDispatcher *dispatcher);
 };
 #endif
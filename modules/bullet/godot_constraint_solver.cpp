@@ -0,0 +1,60 @@
+/*************************************************************************/
+/*  godot_constraint_solver.cpp                                          */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2019 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2019 Godot Engine contributors (cf. AUTHORS.md)    */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#include "godot_constraint_solver.h"
+
+#include "core/os/os.h"
+
+GodotSolveTiming::GodotSolveTiming() :
+		solve_usec(0) {}
+
+btScalar GodotConstraintSolver::solveGroup(btCollisionObject **bodies, int numBodies, btPersistentManifold **manifold, int numManifolds, btTypedConstraint **constraints, int numConstraints, const btContactSolverInfo &info, btIDebugDraw *debugDrawer, btDispatcher *dispatcher) {
+
+	uint64_t begin = OS::get_singleton()->get_ticks_usec();
+	btScalar res = btSequentialImpulseConstraintSolver::solveGroup(bodies, numBodies, manifold, numManifolds, constraints, numConstraints, info, debugDrawer, dispatcher);
+	solve_usec += OS::get_singleton()->get_ticks_usec() - begin;
+	return res;
+}
+
+GodotConstraintSolverPoolMt::GodotConstraintSolverPoolMt(int p_solver_count) :
+		btConstraintSolverPoolMt(p_solver_count),
+		solve_begin(0) {}
+
+void GodotConstraintSolverPoolMt::prepareSolve(int numBodies, int numManifolds) {
+
+	solve_begin = OS::get_singleton()->get_ticks_usec();
+	btConstraintSolverPoolMt::prepareSolve(numBodies, numManifolds);
+}
+
+void GodotConstraintSolverPoolMt::allSolved(const btContactSolverInfo &info, btIDebugDraw *debugDrawer) {
+
+	btConstraintSolverPoolMt::allSolved(info, debugDrawer);
+	solve_usec += OS::get_singleton()->get_ticks_usec() - solve_begin;
+}
@@ -0,0 +1,62 @@
+/*************************************************************************/
+/*  godot_constraint_solver.h                                            */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2019 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2019 Godot Engine contributors (cf. AUTHORS.md)    */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#ifndef GODOT_CONSTRAINT_SOLVER_H
+#define GODOT_CONSTRAINT_SOLVER_H
+
+#include "core/int_types.h"
+
+#include <BulletDynamics/Dynamics/btDiscreteDynamicsWorldMt.h>
+#include <btBulletDynamicsCommon.h>
+
+/// Time spent solving since reset by the space, for the profiler
+struct GodotSolveTiming {
+	uint64_t solve_usec;
+
+	GodotSolveTiming();
+};
+
+/// Sequential impulse solver that measures how long solving takes
+class GodotConstraintSolver : public btSequentialImpulseConstraintSolver, public GodotSolveTiming {
+public:
+	virtual btScalar solveGroup(btCollisionObject **bodies, int numBodies, btPersistentManifold **manifold, int numManifolds, btTypedConstraint **constraints, int numConstraints, const btContactSolverInfo &info, btIDebugDraw *debugDrawer, btDispatcher *dispatcher);
+};
+
+/// Solver pool of the multithreaded worlds. Islands are solved in parallel,
+/// so the whole solving stage is measured instead of every island.
+class GodotConstraintSolverPoolMt : public btConstraintSolverPoolMt, public GodotSolveTiming {
+	uint64_t solve_begin;
+
+public:
+	GodotConstraintSolverPoolMt(int p_solver_count);
+	virtual void prepareSolve(int numBodies, int numManifolds);
+	virtual void allSolved(const btContactSolverInfo &info, btIDebugDraw *debugDrawer);
+};
+#endif
@@ -83,6 +83,30 @@ bool GodotClosestRayResultCallback::needsCollision(btBroadphaseProxy *proxy0) co
 	}
 }
 
+GodotRayCandidateCallback::GodotRayCandidateCallback(const btVector3 &rayFromWorld, const btVector3 &rayToWorld, const GodotClosestRayResultCallback *p_filter, Vector<btCollisionObject *> *r_candidates) :
+		m_filter(p_filter),
+		m_candidates(r_candidates) {
+
+	// Same setup as btCollisionWorld's single ray callback
+	btVector3 rayDir = rayToWorld - rayFromWorld;
+	rayDir.normalize();
+	m_rayDirectionInverse[0] = rayDir[0] == btScalar(0.0) ? btScalar(BT_LARGE_FLOAT) : btScalar(1.0) / rayDir[0];
+	m_rayDirectionInverse[1] = rayDir[1] == btScalar(0.0) ? btScalar(BT_LARGE_FLOAT) : btScalar(1.0) / rayDir[1];
+	m_rayDirectionInverse[2] = rayDir[2] == btScalar(0.0) ? btScalar(BT_LARGE_FLOAT) : btScalar(1.0) / rayDir[2];
+	m_signs[0] = m_rayDirectionInverse[0] < 0.0;
+	m_signs[1] = m_rayDirectionInverse[1] < 0.0;
+	m_signs[2] = m_rayDirectionInverse[2] < 0.0;
+	m_lambda_max = rayDir.dot(rayToWorld - rayFromWorld);
+}
+
+bool GodotRayCandidateCallback::process(const btBroadphaseProxy *proxy) {
+	btBroadphaseProxy *p = const_cast<btBroadphaseProxy *>(proxy);
+	if (m_filter->needsCollision(p)) {
+		m_candidates->push_back(static_cast<btCollisionObject *>(p->m_clientObject));
+	}
+	return true;
+}
+
 bool GodotAllConvexResultCallback::needsCollision(btBroadphaseProxy *proxy0) const {
 	if (count >= m_resultMax)
 		return false;
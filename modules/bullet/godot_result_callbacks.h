@@ -82,6 +82,16 @@ public:
 	}
 };
 
+/// Collects the objects whose AABB the ray crosses and that pass p_filter, used by the batched ray casts
+struct GodotRayCandidateCallback : public btBroadphaseRayCallback {
+	const GodotClosestRayResultCallback *m_filter;
+	Vector<btCollisionObject *> *m_candidates;
+
+	GodotRayCandidateCallback(const btVector3 &rayFromWorld, const btVector3 &rayToWorld, const GodotClosestRayResultCallback *p_filter, Vector<btCollisionObject *> *r_candidates);
+
+	virtual bool process(const btBroadphaseProxy *proxy);
+};
+
 // store all colliding object
 struct GodotAllConvexResultCallback : public btCollisionWorld::ConvexResultCallback {
 public:
@@ -0,0 +1,136 @@
+/*************************************************************************/
+/*  godot_task_scheduler.cpp                                             */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2019 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2019 Godot Engine contributors (cf. AUTHORS.md)    */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+
+#include "godot_task_scheduler.h"
+
+#include "core/os/os.h"
+#include "core/vector.h"
+
+void GodotTaskScheduler::_for_job(uint32_t p_index, ForJob *p_job) {
+
+	int begin = p_job->begin + p_index * p_job->grain_size;
+	int end = MIN(begin + p_job->grain_size, p_job->end);
+	p_job->body->forLoop(begin, end);
+}
+
+void GodotTaskScheduler::_sum_job(uint32_t p_index, SumJob *p_job) {
+
+	int begin = p_job->begin + p_index * p_job->grain_size;
+	int end = MIN(begin + p_job->grain_size, p_job->end);
+	p_job->sums[p_index] = p_job->body->sumLoop(begin, end);
+}
+
+int GodotTaskScheduler::getMaxNumThreads() const {
+
+	return BT_MAX_THREAD_COUNT;
+}
+
+int GodotTaskScheduler::getNumThreads() const {
+
+	return thread_count;
+}
+
+void GodotTaskScheduler::setNumThreads(int numThreads) {
+
+	// the pool can't grow once started, only fewer threads than it has can be used
+	thread_count = CLAMP(numThreads, 1, work_pool.get_thread_count() + 1);
+}
+
+void GodotTaskScheduler::parallelFor(int iBegin, int iEnd, int grainSize, const btIParallelForBody &body) {
+
+	int grain_size = MAX(grainSize, 1);
+	int chunks = (iEnd - iBegin + grain_size - 1) / grain_size;
+
+	// the pool is not reentrant, loops started from inside a job run on the calling thread
+	if (running || chunks < 2 || thread_count < 2) {
+		body.forLoop(iBegin, iEnd);
+		return;
+	}
+
+	ForJob job;
+	job.begin = iBegin;
+	job.end = iEnd;
+	job.grain_size = grain_size;
+	job.body = &body;
+
+	running = true;
+	work_pool.do_work(chunks, this, &GodotTaskScheduler::_for_job, &job, thread_count);
+	running = false;
+}
+
+btScalar GodotTaskScheduler::parallelSum(int iBegin, int iEnd, int grainSize, const btIParallelSumBody &body) {
+
+	int grain_size = MAX(grainSize, 1);
+	int chunks = (iEnd - iBegin + grain_size - 1) / grain_size;
+
+	if (running || chunks < 2 || thread_count < 2) {
+		return body.sumLoop(iBegin, iEnd);
+	}
+
+	Vector<btScalar> sums;
+	sums.resize(chunks);
+
+	SumJob job;
+	job.begin = iBegin;
+	job.end = iEnd;
+	job.grain_size = grain_size;
+	job.body = &body;
+	job.sums = sums.ptrw();
+
+	running = true;
+	work_pool.do_work(chunks, this, &GodotTaskScheduler::_sum_job, &job, thread_count);
+	running = false;
+
+	// added in order, so the result doesn't depend on which thread finished first
+	btScalar sum = 0;
+	for (int i = 0; i < chunks; i++) {
+		sum += sums[i];
+	}
+	return sum;
+}
+
+GodotTaskScheduler::GodotTaskScheduler(int p_thread_count) :
+		btITaskScheduler("Godot"),
+		running(false) {
+
+	if (p_thread_count <= 0) {
+		p_thread_count = OS::get_singleton()->get_processor_count();
+	}
+	p_thread_count = CLAMP(p_thread_count, 1, int(BT_MAX_THREAD_COUNT));
+
+	work_pool.init(p_thread_count - 1);
+	thread_count = work_pool.get_thread_count() + 1;
+}
+
+GodotTaskScheduler::~GodotTaskScheduler() {
+
+	work_pool.finish();
+}
@@ -0,0 +1,77 @@
+/*************************************************************************/
+/*  godot_task_scheduler.h                                               */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2019 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2019 Godot Engine contributors (cf. AUTHORS.md)    */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+
+#ifndef GODOT_TASK_SCHEDULER_H
+#define GODOT_TASK_SCHEDULER_H
+
+#include "core/os/thread_work_pool.h"
+
+#include <LinearMath/btThreads.h>
+
+/// Runs the parallel loops of the multithreaded Bullet worlds on a ThreadWorkPool,
+/// so Bullet doesn't spawn threads of its own
+class GodotTaskScheduler : public btITaskScheduler {
+
+	struct ForJob {
+		int begin;
+		int end;
+		int grain_size;
+		const btIParallelForBody *body;
+	};
+
+	struct SumJob {
+		int begin;
+		int end;
+		int grain_size;
+		const btIParallelSumBody *body;
+		btScalar *sums;
+	};
+
+	ThreadWorkPool work_pool;
+	int thread_count;
+	bool running;
+
+	void _for_job(uint32_t p_index, ForJob *p_job);
+	void _sum_job(uint32_t p_index, SumJob *p_job);
+
+public:
+	virtual int getMaxNumThreads() const;
+	virtual int getNumThreads() const;
+	virtual void setNumThreads(int numThreads);
+	virtual void parallelFor(int iBegin, int iEnd, int grainSize, const btIParallelForBody &body);
+	virtual btScalar parallelSum(int iBegin, int iEnd, int grainSize, const btIParallelSumBody &body);
+
+	// p_thread_count includes the calling thread, 0 uses one thread per processor
+	GodotTaskScheduler(int p_thread_count);
+	virtual ~GodotTaskScheduler();
+};
+
+#endif
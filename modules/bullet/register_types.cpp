@@ -51,6 +51,9 @@ void register_bullet_types() {
 
 	GLOBAL_DEF("physics/3d/active_soft_world", true);
 	ProjectSettings::get_singleton()->set_custom_property_info("physics/3d/active_soft_world", PropertyInfo(Variant::BOOL, "physics/3d/active_soft_world"));
+	GLOBAL_DEF("physics/3d/bullet/multithreaded_world", false);
+	GLOBAL_DEF("physics/3d/bullet/thread_count", 0);
+	ProjectSettings::get_singleton()->set_custom_property_info("physics/3d/bullet/thread_count", PropertyInfo(Variant::INT, "physics/3d/bullet/thread_count", PROPERTY_HINT_RANGE, "0,64,1"));
 #endif
 }
 
@@ -263,6 +263,7 @@ RigidBodyBullet::RigidBodyBullet() :
 		gravity_scale(1),
 		linearDamp(0),
 		angularDamp(0),
+		ccd_motion_threshold(0),
 		can_sleep(true),
 		omit_forces_integration(false),
 		can_integrate_forces(false),
@@ -512,6 +513,12 @@ void RigidBodyBullet::set_param(PhysicsServer::BodyParameter p_param, real_t p_v
 			/// The Bullet gravity will be is set by reload_space_override_modificator
 			scratch_space_override_modificator();
 			break;
+		case PhysicsServer::BODY_PARAM_CCD_MOTION_THRESHOLD:
+			ccd_motion_threshold = p_value;
+			if (is_continuous_collision_detection_enabled()) {
+				set_continuous_collision_detection(true);
+			}
+			break;
 		default:
 			WARN_PRINTS("Parameter " + itos(p_param) + " not supported by bullet. Value: " + itos(p_value));
 	}
@@ -533,6 +540,8 @@ real_t RigidBodyBullet::get_param(PhysicsServer::BodyParameter p_param) const {
 			return angularDamp;
 		case PhysicsServer::BODY_PARAM_GRAVITY_SCALE:
 			return gravity_scale;
+		case PhysicsServer::BODY_PARAM_CCD_MOTION_THRESHOLD:
+			return ccd_motion_threshold;
 		default:
 			WARN_PRINTS("Parameter " + itos(p_param) + " not supported by bullet");
 			return 0;
@@ -738,8 +747,8 @@ void RigidBodyBullet::reload_axis_lock() {
 void RigidBodyBullet::set_continuous_collision_detection(bool p_enable) {
 	if (p_enable) {
 		// This threshold enable CCD if the object moves more than
-		// 1 meter in one simulation frame
-		btBody->setCcdMotionThreshold(0.1);
+		// 0.1 meter in one simulation frame, unless the body sets its own
+		btBody->setCcdMotionThreshold(ccd_motion_threshold > 0 ? ccd_motion_threshold : 0.1);
 
 		/// Calculate using the rule writte below the CCD swept sphere radius
 		///     CCD works on an embedded sphere of radius, make sure this radius
@@ -200,6 +200,7 @@ private:
 	real_t gravity_scale;
 	real_t linearDamp;
 	real_t angularDamp;
+	real_t ccd_motion_threshold;
 	bool can_sleep;
 	bool omit_forces_integration;
 	bool can_integrate_forces;
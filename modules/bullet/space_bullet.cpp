@@ -34,10 +34,12 @@
 #include "bullet_types_converter.h"
 #include "bullet_utilities.h"
 #include "constraint_bullet.h"
+#include "core/os/os.h"
 #include "core/project_settings.h"
 #include "core/ustring.h"
 #include "godot_collision_configuration.h"
 #include "godot_collision_dispatcher.h"
+#include "godot_constraint_solver.h"
 #include "rigid_body_bullet.h"
 #include "servers/physics_server.h"
 #include "soft_body_bullet.h"
@@ -48,6 +50,7 @@
 #include <BulletCollision/NarrowPhaseCollision/btGjkPairDetector.h>
 #include <BulletCollision/NarrowPhaseCollision/btPointCollector.h>
 #include <BulletSoftBody/btSoftBodyRigidBodyCollisionConfiguration.h>
+#include <BulletDynamics/Dynamics/btDiscreteDynamicsWorldMt.h>
 #include <BulletSoftBody/btSoftRigidDynamicsWorld.h>
 #include <btBulletDynamicsCommon.h>
 
@@ -117,6 +120,111 @@ bool BulletPhysicsDirectSpaceState::intersect_ray(const Vector3 &p_from, const V
 	}
 }
 
+void BulletPhysicsDirectSpaceState::_ray_batch_job(uint32_t p_index, RayBatch *p_batch) {
+
+	btVector3 btVec_from;
+	btVector3 btVec_to;
+
+	G_TO_B(p_batch->from[p_index], btVec_from);
+	G_TO_B(p_batch->to[p_index], btVec_to);
+
+	btTransform from_trans;
+	btTransform to_trans;
+	from_trans.setIdentity();
+	from_trans.setOrigin(btVec_from);
+	to_trans.setIdentity();
+	to_trans.setOrigin(btVec_to);
+
+	GodotClosestRayResultCallback btResult(btVec_from, btVec_to, p_batch->exclude, p_batch->collide_with_bodies, p_batch->collide_with_areas);
+	btResult.m_collisionFilterGroup = 0;
+	btResult.m_collisionFilterMask = p_batch->collision_mask;
+
+	const bool soft_world = space->is_using_soft_world();
+
+	for (int i = p_batch->ray_offsets[p_index]; i < p_batch->ray_offsets[p_index + 1]; i++) {
+
+		btCollisionObject *btObj = p_batch->candidates[i];
+		if (soft_world) {
+			btSoftRigidDynamicsWorld::rayTestSingle(from_trans, to_trans, btObj, btObj->getCollisionShape(), btObj->getWorldTransform(), btResult);
+		} else {
+			btCollisionWorld::rayTestSingle(from_trans, to_trans, btObj, btObj->getCollisionShape(), btObj->getWorldTransform(), btResult);
+		}
+	}
+
+	p_batch->hits[p_index] = false;
+	if (!btResult.hasHit())
+		return;
+
+	CollisionObjectBullet *gObj = static_cast<CollisionObjectBullet *>(btResult.m_collisionObject->getUserPointer());
+	if (!gObj)
+		return;
+
+	RayResult &r = p_batch->results[p_index];
+	B_TO_G(btResult.m_hitPointWorld, r.position);
+	B_TO_G(btResult.m_hitNormalWorld.normalize(), r.normal);
+	r.shape = btResult.m_shapeId;
+	r.rid = gObj->get_self();
+	r.collider_id = gObj->get_instance_id();
+	r.collider = NULL; // Resolved after the threads finish.
+	p_batch->hits[p_index] = true;
+}
+
+int BulletPhysicsDirectSpaceState::intersect_rays_batch(const Vector3 *p_from, const Vector3 *p_to, int p_count, RayResult *r_results, bool *r_hits, const Set<RID> &p_exclude, uint32_t p_collision_mask, bool p_collide_with_bodies, bool p_collide_with_areas) {
+
+	// The broadphase ray test uses a shared stack, so it runs here. The
+	// per object ray tests are independent and run on the work pool.
+	ray_candidates.resize(0);
+	ray_offsets.resize(p_count + 1);
+
+	for (int i = 0; i < p_count; i++) {
+
+		ray_offsets.write[i] = ray_candidates.size();
+
+		btVector3 btVec_from;
+		btVector3 btVec_to;
+		G_TO_B(p_from[i], btVec_from);
+		G_TO_B(p_to[i], btVec_to);
+
+		GodotClosestRayResultCallback filter(btVec_from, btVec_to, &p_exclude, p_collide_with_bodies, p_collide_with_areas);
+		filter.m_collisionFilterGroup = 0;
+		filter.m_collisionFilterMask = p_collision_mask;
+
+		GodotRayCandidateCallback collector(btVec_from, btVec_to, &filter, &ray_candidates);
+		space->broadphase->rayTest(btVec_from, btVec_to, collector);
+	}
+	ray_offsets.write[p_count] = ray_candidates.size();
+
+	RayBatch batch;
+	batch.from = p_from;
+	batch.to = p_to;
+	batch.results = r_results;
+	batch.hits = r_hits;
+	batch.exclude = &p_exclude;
+	batch.collision_mask = p_collision_mask;
+	batch.collide_with_bodies = p_collide_with_bodies;
+	batch.collide_with_areas = p_collide_with_areas;
+	batch.candidates = ray_candidates.ptr();
+	batch.ray_offsets = ray_offsets.ptr();
+
+	if (!work_pool.is_initialized()) {
+		work_pool.init();
+	}
+
+	work_pool.do_work(p_count, this, &BulletPhysicsDirectSpaceState::_ray_batch_job, &batch);
+
+	int hit_count = 0;
+	for (int i = 0; i < p_count; i++) {
+
+		if (!r_hits[i])
+			continue;
+
+		hit_count++;
+		r_results[i].collider = r_results[i].collider_id != 0 ? ObjectDB::get_instance(r_results[i].collider_id) : NULL;
+	}
+
+	return hit_count;
+}
+
 int BulletPhysicsDirectSpaceState::intersect_shape(const RID &p_shape, const Transform &p_xform, float p_margin, ShapeResult *r_results, int p_result_max, const Set<RID> &p_exclude, uint32_t p_collision_mask, bool p_collide_with_bodies, bool p_collide_with_areas) {
 	if (p_result_max <= 0)
 		return 0;
@@ -336,15 +444,24 @@ SpaceBullet::SpaceBullet() :
 		dispatcher(NULL),
 		solver(NULL),
 		dynamicsWorld(NULL),
+		dispatch_timing(NULL),
+		solve_timing(NULL),
 		soft_body_world_info(NULL),
 		ghostPairCallback(NULL),
 		godotFilterCallback(NULL),
 		gravityDirection(0, -1, 0),
 		gravityMagnitude(10),
 		contactDebugCount(0),
-		delta_time(0.) {
+		delta_time(0.),
+		tick_begin(0),
+		tick_solve_usec(0) {
 
-	create_empty_world(GLOBAL_DEF("physics/3d/active_soft_world", true));
+	for (int i = 0; i < ELAPSED_TIME_MAX; i++) {
+		elapsed_time[i] = 0;
+	}
+
+
+	create_empty_world(GLOBAL_DEF("physics/3d/active_soft_world", true), GLOBAL_DEF("physics/3d/bullet/multithreaded_world", false));
 	direct_access = memnew(BulletPhysicsDirectSpaceState(this));
 }
 
@@ -362,7 +479,82 @@ void SpaceBullet::flush_queries() {
 
 void SpaceBullet::step(real_t p_delta_time) {
 	delta_time = p_delta_time;
+
+	for (int i = 0; i < ELAPSED_TIME_MAX; i++) {
+		elapsed_time[i] = 0;
+	}
+	dispatch_timing->dispatch_usec = 0;
+	solve_timing->solve_usec = 0;
+
 	dynamicsWorld->stepSimulation(p_delta_time, 0, 0);
+
+	elapsed_time[ELAPSED_TIME_NARROWPHASE] = dispatch_timing->dispatch_usec;
+	elapsed_time[ELAPSED_TIME_SOLVER] = solve_timing->solve_usec;
+}
+
+// Bullet has no hooks between its stages, so they are told apart by the
+// pre-tick callback, the narrowphase in GodotCollisionDispatcher, the
+// solver in GodotConstraintSolver and the tick callback. Everything before
+// the narrowphase counts as broadphase (motion prediction, AABB updates and
+// pair finding), everything after it except solving counts as integration.
+void SpaceBullet::profile_tick_begin() {
+	tick_begin = OS::get_singleton()->get_ticks_usec();
+	tick_solve_usec = solve_timing->solve_usec;
+}
+
+void SpaceBullet::profile_tick_end() {
+	if (dispatch_timing->dispatch_begin < tick_begin) {
+		return; // no narrowphase ran this tick
+	}
+
+	uint64_t solve_usec = solve_timing->solve_usec - tick_solve_usec;
+	uint64_t after_dispatch = OS::get_singleton()->get_ticks_usec() - dispatch_timing->dispatch_end;
+
+	elapsed_time[ELAPSED_TIME_BROADPHASE] += dispatch_timing->dispatch_begin - tick_begin;
+	elapsed_time[ELAPSED_TIME_INTEGRATE] += after_dispatch > solve_usec ? after_dispatch - solve_usec : 0;
+}
+
+int SpaceBullet::get_info(PhysicsServer::SpaceInfo p_info) const {
+	switch (p_info) {
+		case PhysicsServer::SPACE_INFO_ACTIVE_OBJECTS:
+		case PhysicsServer::SPACE_INFO_SLEEPING_OBJECTS: {
+			int active = 0;
+			int sleeping = 0;
+			const btCollisionObjectArray &objects = dynamicsWorld->getCollisionObjectArray();
+			for (int i = 0; i < objects.size(); ++i) {
+				if (objects[i]->isStaticOrKinematicObject() || !btRigidBody::upcast(objects[i])) {
+					continue;
+				}
+				if (objects[i]->getActivationState() == ISLAND_SLEEPING) {
+					++sleeping;
+				} else if (objects[i]->isActive()) {
+					++active;
+				}
+			}
+			return p_info == PhysicsServer::SPACE_INFO_ACTIVE_OBJECTS ? active : sleeping;
+		}
+		case PhysicsServer::SPACE_INFO_COLLISION_PAIRS:
+			return dispatcher->getNumManifolds();
+		case PhysicsServer::SPACE_INFO_ISLAND_COUNT: {
+			Set<int> islands;
+			const btCollisionObjectArray &objects = dynamicsWorld->getCollisionObjectArray();
+			for (int i = 0; i < objects.size(); ++i) {
+				if (!objects[i]->isStaticOrKinematicObject() && objects[i]->isActive() && objects[i]->getIslandTag() >= 0) {
+					islands.insert(objects[i]->getIslandTag());
+				}
+			}
+			return islands.size();
+		}
+		case PhysicsServer::SPACE_INFO_BROADPHASE_TIME_USEC:
+			return elapsed_time[ELAPSED_TIME_BROADPHASE];
+		case PhysicsServer::SPACE_INFO_NARROWPHASE_TIME_USEC:
+			return elapsed_time[ELAPSED_TIME_NARROWPHASE];
+		case PhysicsServer::SPACE_INFO_SOLVER_TIME_USEC:
+			return elapsed_time[ELAPSED_TIME_SOLVER];
+		case PhysicsServer::SPACE_INFO_INTEGRATE_TIME_USEC:
+			return elapsed_time[ELAPSED_TIME_INTEGRATE];
+	}
+	return 0;
 }
 
 void SpaceBullet::set_param(PhysicsServer::AreaParameter p_param, const Variant &p_value) {
@@ -535,11 +727,15 @@ void SpaceBullet::remove_all_collision_objects() {
 }
 
 void onBulletPreTickCallback(btDynamicsWorld *p_dynamicsWorld, btScalar timeStep) {
-	static_cast<SpaceBullet *>(p_dynamicsWorld->getWorldUserInfo())->flush_queries();
+	SpaceBullet *sb = static_cast<SpaceBullet *>(p_dynamicsWorld->getWorldUserInfo());
+	sb->flush_queries();
+	sb->profile_tick_begin();
 }
 
 void onBulletTickCallback(btDynamicsWorld *p_dynamicsWorld, btScalar timeStep) {
 
+	static_cast<SpaceBullet *>(p_dynamicsWorld->getWorldUserInfo())->profile_tick_end();
+
 	const btCollisionObjectArray &colObjArray = p_dynamicsWorld->getCollisionObjectArray();
 
 	// Notify all Collision objects the collision checker is started
@@ -570,14 +766,25 @@ btScalar calculateGodotCombinedFriction(const btCollisionObject *body0, const bt
 	return ABS(MIN(body0->getFriction(), body1->getFriction()));
 }
 
-void SpaceBullet::create_empty_world(bool p_create_soft_world) {
+void SpaceBullet::create_empty_world(bool p_create_soft_world, bool p_multithreaded) {
 
 	gjk_epa_pen_solver = bulletnew(btGjkEpaPenetrationDepthSolver);
 	gjk_simplex_solver = bulletnew(btVoronoiSimplexSolver);
 
+	if (p_multithreaded && p_create_soft_world) {
+		// soft bodies are only simulated by the single threaded world
+		WARN_PRINT("Multithreaded Bullet worlds don't support soft bodies, disable physics/3d/active_soft_world to use them. Falling back to a single threaded world.");
+		p_multithreaded = false;
+	}
+	if (!btGetTaskScheduler()) {
+		p_multithreaded = false; // the server didn't set up the scheduler
+	}
+
 	void *world_mem;
 	if (p_create_soft_world) {
 		world_mem = malloc(sizeof(btSoftRigidDynamicsWorld));
+	} else if (p_multithreaded) {
+		world_mem = malloc(sizeof(btDiscreteDynamicsWorldMt));
 	} else {
 		world_mem = malloc(sizeof(btDiscreteDynamicsWorld));
 	}
@@ -588,15 +795,31 @@ void SpaceBullet::create_empty_world(bool p_create_soft_world) {
 		collisionConfiguration = bulletnew(GodotCollisionConfiguration(static_cast<btDiscreteDynamicsWorld *>(world_mem)));
 	}
 
-	dispatcher = bulletnew(GodotCollisionDispatcher(collisionConfiguration));
 	broadphase = bulletnew(btDbvtBroadphase);
-	solver = bulletnew(btSequentialImpulseConstraintSolver);
 
-	if (p_create_soft_world) {
-		dynamicsWorld = new (world_mem) btSoftRigidDynamicsWorld(dispatcher, broadphase, solver, collisionConfiguration);
-		soft_body_world_info = bulletnew(btSoftBodyWorldInfo);
+	if (p_multithreaded) {
+		GodotCollisionDispatcherMt *dispatcher_mt = bulletnew(GodotCollisionDispatcherMt(collisionConfiguration));
+		GodotConstraintSolverPoolMt *solver_pool = bulletnew(GodotConstraintSolverPoolMt(btGetTaskScheduler()->getNumThreads()));
+		dispatcher = dispatcher_mt;
+		dispatch_timing = dispatcher_mt;
+		solver = solver_pool;
+		solve_timing = solver_pool;
+
+		dynamicsWorld = new (world_mem) btDiscreteDynamicsWorldMt(dispatcher, broadphase, solver_pool, NULL, collisionConfiguration);
 	} else {
-		dynamicsWorld = new (world_mem) btDiscreteDynamicsWorld(dispatcher, broadphase, solver, collisionConfiguration);
+		GodotCollisionDispatcher *godot_dispatcher = bulletnew(GodotCollisionDispatcher(collisionConfiguration));
+		GodotConstraintSolver *godot_solver = bulletnew(GodotConstraintSolver);
+		dispatcher = godot_dispatcher;
+		dispatch_timing = godot_dispatcher;
+		solver = godot_solver;
+		solve_timing = godot_solver;
+
+		if (p_create_soft_world) {
+			dynamicsWorld = new (world_mem) btSoftRigidDynamicsWorld(dispatcher, broadphase, solver, collisionConfiguration);
+			soft_body_world_info = bulletnew(btSoftBodyWorldInfo);
+		} else {
+			dynamicsWorld = new (world_mem) btDiscreteDynamicsWorld(dispatcher, broadphase, solver, collisionConfiguration);
+		}
 	}
 
 	ghostPairCallback = bulletnew(btGhostPairCallback);
@@ -31,6 +31,7 @@
 #ifndef SPACE_BULLET_H
 #define SPACE_BULLET_H
 
+#include "core/os/thread_work_pool.h"
 #include "core/variant.h"
 #include "core/vector.h"
 #include "godot_result_callbacks.h"
@@ -64,6 +65,8 @@ class RigidBodyBullet;
 class SpaceBullet;
 class SoftBodyBullet;
 class btGjkEpaPenetrationDepthSolver;
+struct GodotDispatchTiming;
+struct GodotSolveTiming;
 
 extern ContactAddedCallback gContactAddedCallback;
 
@@ -72,11 +75,32 @@ class BulletPhysicsDirectSpaceState : public PhysicsDirectSpaceState {
 private:
 	SpaceBullet *space;
 
+	// Broadphase candidates of every ray in a batch, ray i owns [ray_offsets[i], ray_offsets[i + 1]).
+	struct RayBatch {
+		const Vector3 *from;
+		const Vector3 *to;
+		RayResult *results;
+		bool *hits;
+		const Set<RID> *exclude;
+		uint32_t collision_mask;
+		bool collide_with_bodies;
+		bool collide_with_areas;
+		btCollisionObject *const *candidates;
+		const int *ray_offsets;
+	};
+
+	Vector<btCollisionObject *> ray_candidates;
+	Vector<int> ray_offsets;
+	ThreadWorkPool work_pool;
+
+	void _ray_batch_job(uint32_t p_index, RayBatch *p_batch);
+
 public:
 	BulletPhysicsDirectSpaceState(SpaceBullet *p_space);
 
 	virtual int intersect_point(const Vector3 &p_point, ShapeResult *r_results, int p_result_max, const Set<RID> &p_exclude = Set<RID>(), uint32_t p_collision_mask = 0xFFFFFFFF, bool p_collide_with_bodies = true, bool p_collide_with_areas = false);
 	virtual bool intersect_ray(const Vector3 &p_from, const Vector3 &p_to, RayResult &r_result, const Set<RID> &p_exclude = Set<RID>(), uint32_t p_collision_mask = 0xFFFFFFFF, bool p_collide_with_bodies = true, bool p_collide_with_areas = false, bool p_pick_ray = false);
+	virtual int intersect_rays_batch(const Vector3 *p_from, const Vector3 *p_to, int p_count, RayResult *r_results, bool *r_hits, const Set<RID> &p_exclude = Set<RID>(), uint32_t p_collision_mask = 0xFFFFFFFF, bool p_collide_with_bodies = true, bool p_collide_with_areas = false);
 	virtual int intersect_shape(const RID &p_shape, const Transform &p_xform, float p_margin, ShapeResult *r_results, int p_result_max, const Set<RID> &p_exclude = Set<RID>(), uint32_t p_collision_mask = 0xFFFFFFFF, bool p_collide_with_bodies = true, bool p_collide_with_areas = false);
 	virtual bool cast_motion(const RID &p_shape, const Transform &p_xform, const Vector3 &p_motion, float p_margin, float &r_closest_safe, float &r_closest_unsafe, const Set<RID> &p_exclude = Set<RID>(), uint32_t p_collision_mask = 0xFFFFFFFF, bool p_collide_with_bodies = true, bool p_collide_with_areas = false, ShapeRestInfo *r_info = NULL);
 	/// Returns the list of contacts pairs in this order: Local contact, other body contact
@@ -88,6 +112,7 @@ public:
 class SpaceBullet : public RIDBullet {
 
 	friend class AreaBullet;
+	friend void onBulletPreTickCallback(btDynamicsWorld *world, btScalar timeStep);
 	friend void onBulletTickCallback(btDynamicsWorld *world, btScalar timeStep);
 	friend class BulletPhysicsDirectSpaceState;
 
@@ -96,6 +121,8 @@ class SpaceBullet : public RIDBullet {
 	btCollisionDispatcher *dispatcher;
 	btConstraintSolver *solver;
 	btDiscreteDynamicsWorld *dynamicsWorld;
+	GodotDispatchTiming *dispatch_timing;
+	GodotSolveTiming *solve_timing;
 	btSoftBodyWorldInfo *soft_body_world_info;
 	btGhostPairCallback *ghostPairCallback;
 	GodotFilterCallback *godotFilterCallback;
@@ -113,6 +140,20 @@ class SpaceBullet : public RIDBullet {
 	int contactDebugCount;
 	real_t delta_time;
 
+public:
+	enum ElapsedTime {
+		ELAPSED_TIME_BROADPHASE,
+		ELAPSED_TIME_NARROWPHASE,
+		ELAPSED_TIME_SOLVER,
+		ELAPSED_TIME_INTEGRATE,
+		ELAPSED_TIME_MAX
+	};
+
+private:
+	uint64_t elapsed_time[ELAPSED_TIME_MAX];
+	uint64_t tick_begin;
+	uint64_t tick_solve_usec;
+
 public:
 	SpaceBullet();
 	virtual ~SpaceBullet();
@@ -121,6 +162,9 @@ public:
 	real_t get_delta_time() { return delta_time; }
 	void step(real_t p_delta_time);
 
+	uint64_t get_elapsed_time(ElapsedTime p_time) const { return elapsed_time[p_time]; }
+	int get_info(PhysicsServer::SpaceInfo p_info) const;
+
 	_FORCE_INLINE_ btBroadphaseInterface *get_broadphase() { return broadphase; }
 	_FORCE_INLINE_ btCollisionDispatcher *get_dispatcher() { return dispatcher; }
 	_FORCE_INLINE_ btSoftBodyWorldInfo *get_soft_body_world_info() { return soft_body_world_info; }
@@ -180,11 +224,14 @@ public:
 	int test_ray_separation(RigidBodyBullet *p_body, const Transform &p_transform, bool p_infinite_inertia, Vector3 &r_recover_motion, PhysicsServer::SeparationResult *r_results, int p_result_max, float p_margin);
 
 private:
-	void create_empty_world(bool p_create_soft_world);
+	void create_empty_world(bool p_create_soft_world, bool p_multithreaded);
 	void destroy_world();
 	void check_ghost_overlaps();
 	void check_body_collision();
 
+	void profile_tick_begin();
+	void profile_tick_end();
+
 	struct RecoverResult {
 		bool hasPenetration;
 		btVector3 normal;
@@ -445,7 +445,7 @@ void CSGBrushOperation::BuildPoly::clip(const CSGBrush *p_brush, int p_face, Mes
 	_clip_segment(p_brush, p_face, segment, mesh_merge, p_for_B);
 }
 
-void CSGBrushOperation::_collision_callback(const CSGBrush *A, int p_face_a, Map<int, BuildPoly> &build_polys_a, const CSGBrush *B, int p_face_b, Map<int, BuildPoly> &build_polys_b, MeshMerge &mesh_merge) {
+void CSGBrushOperation::_collision_callback(const CSGBrush *A, int p_face_a, const CSGBrush *B, int p_face_b, CallbackData &p_data, MeshMerge &mesh_merge) {
 
 	//construct a frame of reference for both transforms, in order to do intersection test
 	Vector3 va[3] = {
@@ -575,28 +575,24 @@ void CSGBrushOperation::_collision_callback(const CSGBrush *A, int p_face_a, Map
 
 	//if we are still here, it means they most likely intersect, so create BuildPolys if they don't exist
 
-	BuildPoly *poly_a = NULL;
+	BuildPoly *poly_a = p_data.build_polys_A[p_face_a];
 
-	if (!build_polys_a.has(p_face_a)) {
+	if (!poly_a) {
 
-		BuildPoly bp;
-		bp.create(A, p_face_a, mesh_merge, false);
-		build_polys_a[p_face_a] = bp;
+		poly_a = &p_data.build_polys.push_back(BuildPoly())->get();
+		poly_a->create(A, p_face_a, mesh_merge, false);
+		p_data.build_polys_A.write[p_face_a] = poly_a;
 	}
 
-	poly_a = &build_polys_a[p_face_a];
+	BuildPoly *poly_b = p_data.build_polys_B[p_face_b];
 
-	BuildPoly *poly_b = NULL;
+	if (!poly_b) {
 
-	if (!build_polys_b.has(p_face_b)) {
-
-		BuildPoly bp;
-		bp.create(B, p_face_b, mesh_merge, true);
-		build_polys_b[p_face_b] = bp;
+		poly_b = &p_data.build_polys.push_back(BuildPoly())->get();
+		poly_b->create(B, p_face_b, mesh_merge, true);
+		p_data.build_polys_B.write[p_face_b] = poly_b;
 	}
 
-	poly_b = &build_polys_b[p_face_b];
-
 	//clip each other, this could be improved by using vertex unique IDs (more vertices may be shared instead of using snap)
 	poly_a->clip(B, p_face_b, mesh_merge, false);
 	poly_b->clip(A, p_face_a, mesh_merge, true);
@@ -1325,6 +1321,88 @@ void CSGBrushOperation::MeshMerge::add_face(const Vector3 &p_a, const Vector3 &p
 	faces.push_back(face);
 }
 
+struct _CSGFaceTreeSort {
+
+	const CSGBrush *brush;
+	int axis;
+
+	_FORCE_INLINE_ bool operator()(int p_a, int p_b) const {
+		const AABB &a = brush->faces[p_a].aabb;
+		const AABB &b = brush->faces[p_b].aabb;
+		return a.position[axis] + a.size[axis] * 0.5 < b.position[axis] + b.size[axis] * 0.5;
+	}
+};
+
+int CSGBrushOperation::FaceTree::_build(const CSGBrush &p_brush, int *p_faces, int p_count) {
+
+	int idx = nodes.size();
+	nodes.push_back(Node());
+
+	Node node;
+	node.aabb = p_brush.faces[p_faces[0]].aabb;
+	for (int i = 1; i < p_count; i++) {
+		node.aabb.merge_with(p_brush.faces[p_faces[i]].aabb);
+	}
+
+	if (p_count == 1) {
+		node.face = p_faces[0];
+		node.left = -1;
+		node.right = -1;
+	} else {
+		SortArray<int, _CSGFaceTreeSort> sorter;
+		sorter.compare.brush = &p_brush;
+		sorter.compare.axis = node.aabb.get_longest_axis_index();
+		sorter.sort(p_faces, p_count);
+
+		int half = p_count / 2;
+		node.face = -1;
+		node.left = _build(p_brush, p_faces, half);
+		node.right = _build(p_brush, &p_faces[half], p_count - half);
+	}
+
+	nodes.write[idx] = node;
+	return idx;
+}
+
+void CSGBrushOperation::FaceTree::build(const CSGBrush &p_brush) {
+
+	nodes.clear();
+	if (p_brush.faces.size() == 0)
+		return;
+
+	Vector<int> faces;
+	faces.resize(p_brush.faces.size());
+	for (int i = 0; i < faces.size(); i++) {
+		faces.write[i] = i;
+	}
+
+	_build(p_brush, faces.ptrw(), faces.size());
+}
+
+void CSGBrushOperation::FaceTree::cull(const AABB &p_aabb, Vector<int> &r_faces) const {
+
+	if (nodes.size() == 0)
+		return;
+
+	int stack[64];
+	int stack_size = 0;
+	stack[stack_size++] = 0;
+
+	while (stack_size) {
+
+		const Node &node = nodes[stack[--stack_size]];
+		if (!node.aabb.intersects(p_aabb))
+			continue;
+
+		if (node.face >= 0) {
+			r_faces.push_back(node.face);
+		} else {
+			stack[stack_size++] = node.left;
+			stack[stack_size++] = node.right;
+		}
+	}
+}
+
 void CSGBrushOperation::merge_brushes(Operation p_operation, const CSGBrush &p_A, const CSGBrush &p_B, CSGBrush &result, float p_snap) {
 
 	CallbackData cd;
@@ -1335,32 +1413,51 @@ void CSGBrushOperation::merge_brushes(Operation p_operation, const CSGBrush &p_A
 	MeshMerge mesh_merge;
 	mesh_merge.vertex_snap = p_snap;
 
-	//check intersections between faces. Use AABB to speed up precheck
+	cd.build_polys_A.resize(p_A.faces.size());
+	for (int i = 0; i < p_A.faces.size(); i++) {
+		cd.build_polys_A.write[i] = NULL;
+	}
+	cd.build_polys_B.resize(p_B.faces.size());
+	for (int i = 0; i < p_B.faces.size(); i++) {
+		cd.build_polys_B.write[i] = NULL;
+	}
+
+	//check intersections between faces. A tree over the faces of B finds the candidates,
+	//they are visited in face order so the result is the same as testing every pair.
 	//this generates list of buildpolys and clips them.
-	//this was originally BVH optimized, but its not really worth it.
+	FaceTree tree_b;
+	tree_b.build(p_B);
+
+	Vector<int> candidates;
+
 	for (int i = 0; i < p_A.faces.size(); i++) {
 		cd.face_a = i;
-		for (int j = 0; j < p_B.faces.size(); j++) {
-			if (p_A.faces[i].aabb.intersects(p_B.faces[j].aabb)) {
-				_collision_callback(&p_A, i, cd.build_polys_A, &p_B, j, cd.build_polys_B, mesh_merge);
-			}
+		candidates.clear();
+		tree_b.cull(p_A.faces[i].aabb, candidates);
+		candidates.sort();
+		for (int j = 0; j < candidates.size(); j++) {
+			_collision_callback(&p_A, i, &p_B, candidates[j], cd, mesh_merge);
 		}
 	}
 
 	//merge the already cliped polys back to 3D
-	for (Map<int, BuildPoly>::Element *E = cd.build_polys_A.front(); E; E = E->next()) {
-		_merge_poly(mesh_merge, E->key(), E->get(), false);
+	for (int i = 0; i < p_A.faces.size(); i++) {
+		if (cd.build_polys_A[i]) {
+			_merge_poly(mesh_merge, i, *cd.build_polys_A[i], false);
+		}
 	}
 
-	for (Map<int, BuildPoly>::Element *E = cd.build_polys_B.front(); E; E = E->next()) {
-		_merge_poly(mesh_merge, E->key(), E->get(), true);
+	for (int i = 0; i < p_B.faces.size(); i++) {
+		if (cd.build_polys_B[i]) {
+			_merge_poly(mesh_merge, i, *cd.build_polys_B[i], true);
+		}
 	}
 
 	//merge the non clipped faces back
 
 	for (int i = 0; i < p_A.faces.size(); i++) {
 
-		if (cd.build_polys_A.has(i))
+		if (cd.build_polys_A[i])
 			continue; //made from buildpoly, skipping
 
 		Vector3 points[3];
@@ -1378,7 +1475,7 @@ void CSGBrushOperation::merge_brushes(Operation p_operation, const CSGBrush &p_A
 
 	for (int i = 0; i < p_B.faces.size(); i++) {
 
-		if (cd.build_polys_B.has(i))
+		if (cd.build_polys_B[i])
 			continue; //made from buildpoly, skipping
 
 		Vector3 points[3];
@@ -31,6 +31,7 @@
 #ifndef CSG_H
 #define CSG_H
 
+#include "core/list.h"
 #include "core/map.h"
 #include "core/math/aabb.h"
 #include "core/math/plane.h"
@@ -214,22 +215,40 @@ struct CSGBrushOperation {
 		bool operator<(const EdgeSort &p_edge) const { return angle < p_edge.angle; }
 	};
 
+	// Static AABB tree over the faces of a brush, finds the faces that may touch a given one
+	struct FaceTree {
+
+		struct Node {
+			AABB aabb;
+			int left;
+			int right;
+			int face;
+		};
+
+		Vector<Node> nodes;
+
+		int _build(const CSGBrush &p_brush, int *p_faces, int p_count);
+		void build(const CSGBrush &p_brush);
+		void cull(const AABB &p_aabb, Vector<int> &r_faces) const;
+	};
+
 	struct CallbackData {
 		const CSGBrush *A;
 		const CSGBrush *B;
 		int face_a;
 		CSGBrushOperation *self;
-		Map<int, BuildPoly> build_polys_A;
-		Map<int, BuildPoly> build_polys_B;
+		// one entry per face, NULL for faces that are not clipped
+		Vector<BuildPoly *> build_polys_A;
+		Vector<BuildPoly *> build_polys_B;
+		List<BuildPoly> build_polys; // owns them, keeps their addresses stable
 	};
 
 	void _add_poly_points(const BuildPoly &p_poly, int p_edge, int p_from_point, int p_to_point, const Vector<Vector<int> > &vertex_process, Vector<bool> &edge_process, Vector<PolyPoints> &r_poly);
 	void _add_poly_outline(const BuildPoly &p_poly, int p_from_point, int p_to_point, const Vector<Vector<int> > &vertex_process, Vector<int> &r_outline);
 	void _merge_poly(MeshMerge &mesh, int p_face_idx, const BuildPoly &p_poly, bool p_from_b);
 
-	void _collision_callback(const CSGBrush *A, int p_face_a, Map<int, BuildPoly> &build_polys_a, const CSGBrush *B, int p_face_b, Map<int, BuildPoly> &build_polys_b, MeshMerge &mesh_merge);
+	void _collision_callback(const CSGBrush *A, int p_face_a, const CSGBrush *B, int p_face_b, CallbackData &p_data, MeshMerge &mesh_merge);
 
-	static void _collision_callbacks(void *ud, int p_face_b);
 	void merge_brushes(Operation p_operation, const CSGBrush &p_A, const CSGBrush &p_B, CSGBrush &result, float p_snap = 0.001);
 };
 
@@ -136,6 +136,8 @@ void CSGShape::_make_dirty() {
 	if (!is_inside_tree())
 		return;
 
+	build_version++;
+
 	if (dirty) {
 		return;
 	}
@@ -150,13 +152,54 @@ void CSGShape::_make_dirty() {
 	}
 }
 
+CSGBrush *CSGShape::_merge_brush(CSGBrush *p_brush, CSGBrush *p_child, Operation p_operation, float p_snap) {
+
+	// takes ownership of both brushes
+	if (!p_brush) {
+		return p_child;
+	}
+
+	CSGBrush *merged = memnew(CSGBrush);
+	CSGBrushOperation bop;
+
+	switch (p_operation) {
+		case CSGShape::OPERATION_UNION: bop.merge_brushes(CSGBrushOperation::OPERATION_UNION, *p_brush, *p_child, *merged, p_snap); break;
+		case CSGShape::OPERATION_INTERSECTION: bop.merge_brushes(CSGBrushOperation::OPERATION_INTERSECTION, *p_brush, *p_child, *merged, p_snap); break;
+		case CSGShape::OPERATION_SUBTRACTION: bop.merge_brushes(CSGBrushOperation::OPERATION_SUBSTRACTION, *p_brush, *p_child, *merged, p_snap); break;
+	}
+
+	memdelete(p_brush);
+	memdelete(p_child);
+	return merged;
+}
+
+void CSGShape::_set_brush(CSGBrush *p_brush) {
+
+	if (brush) {
+		memdelete(brush);
+	}
+	brush = p_brush;
+
+	if (brush) {
+		AABB aabb;
+		for (int i = 0; i < brush->faces.size(); i++) {
+			for (int j = 0; j < 3; j++) {
+				if (i == 0 && j == 0)
+					aabb.position = brush->faces[i].vertices[j];
+				else
+					aabb.expand_to(brush->faces[i].vertices[j]);
+			}
+		}
+		node_aabb = aabb;
+	} else {
+		node_aabb = AABB();
+	}
+}
+
 CSGBrush *CSGShape::_get_brush() {
 
 	if (dirty) {
-		if (brush) {
-			memdelete(brush);
-		}
-		brush = NULL;
+		_set_brush(NULL);
 
 		CSGBrush *n = _build_brush();
 
@@ -171,51 +214,158 @@ CSGBrush *CSGShape::_get_brush() {
 			CSGBrush *n2 = child->_get_brush();
 			if (!n2)
 				continue;
-			if (!n) {
-				n = memnew(CSGBrush);
 
-				n->copy_from(*n2, child->get_transform());
+			CSGBrush *nn2 = memnew(CSGBrush);
+			nn2->copy_from(*n2, child->get_transform());
+			n = _merge_brush(n, nn2, child->get_operation(), snap);
+		}
 
-			} else {
+		_set_brush(n);
 
-				CSGBrush *nn = memnew(CSGBrush);
-				CSGBrush *nn2 = memnew(CSGBrush);
-				nn2->copy_from(*n2, child->get_transform());
+		dirty = false;
+	}
 
-				CSGBrushOperation bop;
+	return brush;
+}
 
-				switch (child->get_operation()) {
-					case CSGShape::OPERATION_UNION: bop.merge_brushes(CSGBrushOperation::OPERATION_UNION, *n, *nn2, *nn, snap); break;
-					case CSGShape::OPERATION_INTERSECTION: bop.merge_brushes(CSGBrushOperation::OPERATION_INTERSECTION, *n, *nn2, *nn, snap); break;
-					case CSGShape::OPERATION_SUBTRACTION: bop.merge_brushes(CSGBrushOperation::OPERATION_SUBSTRACTION, *n, *nn2, *nn, snap); break;
-				}
-				memdelete(n);
-				memdelete(nn2);
-				n = nn;
-			}
-		}
+CSGShape::BuildNode *CSGShape::_capture_build() {
 
-		if (n) {
-			AABB aabb;
-			for (int i = 0; i < n->faces.size(); i++) {
-				for (int j = 0; j < 3; j++) {
-					if (i == 0 && j == 0)
-						aabb.position = n->faces[i].vertices[j];
-					else
-						aabb.expand_to(n->faces[i].vertices[j]);
-				}
-			}
-			node_aabb = aabb;
+	BuildNode *node = memnew(BuildNode);
+	node->id = get_instance_id();
+	node->version = build_version;
+	node->snap = snap;
+	node->brush = _build_brush();
+
+	for (int i = 0; i < get_child_count(); i++) {
+
+		CSGShape *child = Object::cast_to<CSGShape>(get_child(i));
+		if (!child)
+			continue;
+		if (!child->is_visible_in_tree())
+			continue;
+
+		BuildNode::Child c;
+		c.node = NULL;
+		c.brush = NULL;
+		c.xform = child->get_transform();
+		c.operation = child->get_operation();
+
+		if (child->dirty) {
+			c.node = child->_capture_build();
 		} else {
-			node_aabb = AABB();
+			if (!child->brush)
+				continue;
+			c.brush = memnew(CSGBrush);
+			c.brush->copy_from(*child->brush, c.xform);
 		}
 
-		brush = n;
+		node->children.push_back(c);
+	}
+
+	// the old brush stays in use until the merged one arrives
+	dirty = false;
 
-		dirty = false;
+	return node;
+}
+
+void CSGShape::_merge_build(BuildNode *p_node) {
+
+	CSGBrush *n = p_node->brush;
+
+	for (int i = 0; i < p_node->children.size(); i++) {
+
+		BuildNode::Child &c = p_node->children.write[i];
+		CSGBrush *child_brush = c.brush;
+		c.brush = NULL;
+
+		if (c.node) {
+			_merge_build(c.node);
+			if (!c.node->brush)
+				continue;
+			// the child keeps its own result, a transformed copy is merged here
+			child_brush = memnew(CSGBrush);
+			child_brush->copy_from(*c.node->brush, c.xform);
+		}
+
+		n = _merge_brush(n, child_brush, c.operation, p_node->snap);
 	}
 
-	return brush;
+	p_node->brush = n;
+}
+
+void CSGShape::_free_build(BuildNode *p_node) {
+
+	for (int i = 0; i < p_node->children.size(); i++) {
+		const BuildNode::Child &c = p_node->children[i];
+		if (c.node) {
+			_free_build(c.node);
+		}
+		if (c.brush) {
+			memdelete(c.brush);
+		}
+	}
+
+	if (p_node->brush) {
+		memdelete(p_node->brush);
+	}
+	memdelete(p_node);
+}
+
+void CSGShape::_apply_build(BuildNode *p_node) {
+
+	for (int i = 0; i < p_node->children.size(); i++) {
+		if (p_node->children[i].node) {
+			_apply_build(p_node->children[i].node);
+		}
+	}
+
+	// shapes that were changed or removed while merging get rebuilt again later
+	CSGShape *shape = Object::cast_to<CSGShape>(ObjectDB::get_instance(p_node->id));
+	if (shape && shape->build_version == p_node->version && !shape->dirty) {
+		shape->_set_brush(p_node->brush);
+		p_node->brush = NULL;
+	}
+}
+
+void CSGShape::_build_thread_function(void *p_ud) {
+
+	CSGShape *shape = (CSGShape *)p_ud;
+	_merge_build(shape->build_root);
+	shape->call_deferred("_build_thread_done");
+}
+
+bool CSGShape::background_rebuild = false;
+
+void CSGShape::set_background_rebuild(bool p_enable) {
+
+#ifndef NO_THREADS
+	background_rebuild = p_enable;
+#endif
+}
+
+void CSGShape::_build_thread_done() {
+
+	ERR_FAIL_COND(!build_thread);
+
+	Thread::wait_to_finish(build_thread);
+	memdelete(build_thread);
+	build_thread = NULL;
+
+	BuildNode *node = build_root;
+	build_root = NULL;
+
+	bool root_changed = build_version != node->version || dirty;
+	_apply_build(node);
+	_free_build(node);
+
+	if (!root_changed) {
+		_update_mesh();
+	}
+
+	if (rebuild_queued || dirty) {
+		rebuild_queued = false;
+		_update_shape();
+	}
 }
 
 int CSGShape::mikktGetNumFaces(const SMikkTSpaceContext *pContext) {
@@ -278,6 +428,23 @@ void CSGShape::_update_shape() {
 	if (parent)
 		return;
 
+	if (build_thread) {
+		// picked up again once the running merge is done
+		rebuild_queued = true;
+		return;
+	}
+
+	if (background_rebuild && dirty && is_inside_tree()) {
+		build_root = _capture_build();
+		build_thread = Thread::create(_build_thread_function, this);
+		return;
+	}
+
+	_update_mesh();
+}
+
+void CSGShape::_update_mesh() {
+
 	set_base(RID());
 	root_mesh.unref(); //byebye root mesh
 
@@ -597,6 +764,7 @@ Array CSGShape::get_meshes() const {
 void CSGShape::_bind_methods() {
 
 	ClassDB::bind_method(D_METHOD("_update_shape"), &CSGShape::_update_shape);
+	ClassDB::bind_method(D_METHOD("_build_thread_done"), &CSGShape::_build_thread_done);
 	ClassDB::bind_method(D_METHOD("is_root_shape"), &CSGShape::is_root_shape);
 
 	ClassDB::bind_method(D_METHOD("set_operation", "operation"), &CSGShape::set_operation);
@@ -644,6 +812,10 @@ CSGShape::CSGShape() {
 	parent = NULL;
 	brush = NULL;
 	dirty = false;
+	build_version = 0;
+	build_thread = NULL;
+	build_root = NULL;
+	rebuild_queued = false;
 	snap = 0.001;
 	use_collision = false;
 	collision_layer = 1;
@@ -653,6 +825,13 @@ CSGShape::CSGShape() {
 }
 
 CSGShape::~CSGShape() {
+	if (build_thread) {
+		Thread::wait_to_finish(build_thread);
+		memdelete(build_thread);
+		build_thread = NULL;
+		_free_build(build_root);
+		build_root = NULL;
+	}
 	if (brush) {
 		memdelete(brush);
 		brush = NULL;
@@ -33,6 +33,7 @@
 
 #define CSGJS_HEADER_ONLY
 
+#include "core/os/thread.h"
 #include "csg.h"
 #include "scene/3d/visual_instance.h"
 #include "scene/resources/concave_polygon_shape.h"
@@ -58,8 +59,35 @@ private:
 	AABB node_aabb;
 
 	bool dirty;
+	uint32_t build_version; // changes every time the shape is made dirty
 	float snap;
 
+	// Background rebuilds. The dirty part of the tree is captured on the main
+	// thread: primitive brushes are built and up to date child brushes copied.
+	// Merging happens on build_thread, and the results are handed back to the
+	// shapes that didn't change in the meantime. Only used by the root shape.
+	struct BuildNode {
+		ObjectID id;
+		uint32_t version;
+		float snap;
+		CSGBrush *brush; // the shape's own brush, the merged result once done
+
+		struct Child {
+			BuildNode *node; // dirty child, merged first
+			CSGBrush *brush; // up to date child, already transformed
+			Transform xform;
+			Operation operation;
+		};
+
+		Vector<Child> children;
+	};
+
+	static bool background_rebuild;
+
+	Thread *build_thread;
+	BuildNode *build_root;
+	bool rebuild_queued;
+
 	bool use_collision;
 	uint32_t collision_layer;
 	uint32_t collision_mask;
@@ -102,7 +130,18 @@ private:
 	static void mikktSetTSpaceDefault(const SMikkTSpaceContext *pContext, const float fvTangent[], const float fvBiTangent[], const float fMagS, const float fMagT,
 			const tbool bIsOrientationPreserving, const int iFace, const int iVert);
 
+	static CSGBrush *_merge_brush(CSGBrush *p_brush, CSGBrush *p_child, Operation p_operation, float p_snap);
+	void _set_brush(CSGBrush *p_brush);
+
+	BuildNode *_capture_build();
+	static void _merge_build(BuildNode *p_node);
+	static void _free_build(BuildNode *p_node);
+	void _apply_build(BuildNode *p_node);
+	static void _build_thread_function(void *p_ud);
+	void _build_thread_done();
+
 	void _update_shape();
+	void _update_mesh();
 
 protected:
 	void _notification(int p_what);
@@ -119,6 +158,8 @@ protected:
 	Array get_meshes() const;
 
 public:
+	static void set_background_rebuild(bool p_enable);
+
 	void set_operation(Operation p_operation);
 	Operation get_operation() const;
 
@@ -30,6 +30,7 @@
 
 #include "register_types.h"
 
+#include "core/project_settings.h"
 #include "csg_gizmos.h"
 #include "csg_shape.h"
 
@@ -47,6 +48,8 @@ void register_csg_types() {
 	ClassDB::register_class<CSGPolygon>();
 	ClassDB::register_class<CSGCombiner>();
 
+	CSGShape::set_background_rebuild(GLOBAL_DEF("rendering/csg/background_rebuild", true));
+
 #ifdef TOOLS_ENABLED
 	EditorPlugins::add_by_type<EditorPluginCSG>();
 #endif
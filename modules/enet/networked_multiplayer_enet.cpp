@@ -50,17 +50,17 @@ void NetworkedMultiplayerENet::set_target_peer(int p_peer) {
 int NetworkedMultiplayerENet::get_packet_peer() const {
 
 	ERR_FAIL_COND_V(!active, 1);
-	ERR_FAIL_COND_V(incoming_packets.size() == 0, 1);
+	ERR_FAIL_COND_V(incoming_count == 0, 1);
 
-	return incoming_packets.front()->get().from;
+	return incoming_packets[incoming_read].from;
 }
 
 int NetworkedMultiplayerENet::get_packet_channel() const {
 
 	ERR_FAIL_COND_V(!active, -1);
-	ERR_FAIL_COND_V(incoming_packets.size() == 0, -1);
+	ERR_FAIL_COND_V(incoming_count == 0, -1);
 
-	return incoming_packets.front()->get().channel;
+	return incoming_packets[incoming_read].channel;
 }
 
 int NetworkedMultiplayerENet::get_last_packet_channel() const {
@@ -106,6 +106,7 @@ Error NetworkedMultiplayerENet::create_server(int p_port, int p_max_clients, int
 	ERR_FAIL_COND_V(!host, ERR_CANT_CREATE);
 
 	_setup_compressor();
+	send_batches.resize(channel_count);
 	active = true;
 	server = true;
 	refuse_connections = false;
@@ -157,6 +158,7 @@ Error NetworkedMultiplayerENet::create_client(const String &p_address, int p_por
 	ERR_FAIL_COND_V(!host, ERR_CANT_CREATE);
 
 	_setup_compressor();
+	send_batches.resize(channel_count);
 
 	IP_Address ip;
 	if (p_address.is_valid_ip_address()) {
@@ -205,6 +207,7 @@ void NetworkedMultiplayerENet::poll() {
 	ERR_FAIL_COND(!active);
 
 	_pop_current_packet();
+	_flush_send_batches();
 
 	ENetEvent event;
 	/* Keep servicing until there are no available events left in queue. */
@@ -341,9 +344,6 @@ void NetworkedMultiplayerENet::poll() {
 					enet_packet_destroy(event.packet);
 				} else if (event.channelID < channel_count) {
 
-					Packet packet;
-					packet.packet = event.packet;
-
 					uint32_t *id = (uint32_t *)event.peer->data;
 
 					ERR_CONTINUE(event.packet->dataLength < 12)
@@ -351,31 +351,28 @@ void NetworkedMultiplayerENet::poll() {
 					uint32_t source = decode_uint32(&event.packet->data[0]);
 					int target = decode_uint32(&event.packet->data[4]);
 					uint32_t flags = decode_uint32(&event.packet->data[8]);
-
-					packet.from = source;
-					packet.channel = event.channelID;
+					int enet_flags = flags & ~PACKET_FLAG_BATCHED;
 
 					if (server) {
 						// Someone is cheating and trying to fake the source!
 						ERR_CONTINUE(source != *id);
 
-						packet.from = *id;
-
 						if (target == 0) {
 							// Re-send to everyone but sender :|
 
-							incoming_packets.push_back(packet);
-							// And make copies for sending
+							// Make copies for sending first, queueing may unpack and release the packet
 							for (Map<int, ENetPeer *>::Element *E = peer_map.front(); E; E = E->next()) {
 
 								if (uint32_t(E->key()) == source) // Do not resend to self
 									continue;
 
-								ENetPacket *packet2 = enet_packet_create(packet.packet->data, packet.packet->dataLength, flags);
+								ENetPacket *packet2 = enet_packet_create(event.packet->data, event.packet->dataLength, enet_flags);
 
 								enet_peer_send(E->get(), event.channelID, packet2);
 							}
 
+							_queue_received(event.packet, *id, event.channelID);
+
 						} else if (target < 0) {
 							// To all but one
 
@@ -385,30 +382,30 @@ void NetworkedMultiplayerENet::poll() {
 								if (uint32_t(E->key()) == source || E->key() == -target) // Do not resend to self, also do not send to excluded
 									continue;
 
-								ENetPacket *packet2 = enet_packet_create(packet.packet->data, packet.packet->dataLength, flags);
+								ENetPacket *packet2 = enet_packet_create(event.packet->data, event.packet->dataLength, enet_flags);
 
 								enet_peer_send(E->get(), event.channelID, packet2);
 							}
 
 							if (-target != 1) {
 								// Server is not excluded
-								incoming_packets.push_back(packet);
+								_queue_received(event.packet, *id, event.channelID);
 							} else {
 								// Server is excluded, erase packet
-								enet_packet_destroy(packet.packet);
+								enet_packet_destroy(event.packet);
 							}
 
 						} else if (target == 1) {
 							// To myself and only myself
-							incoming_packets.push_back(packet);
+							_queue_received(event.packet, *id, event.channelID);
 						} else {
 							// To someone else, specifically
 							ERR_CONTINUE(!peer_map.has(target));
-							enet_peer_send(peer_map[target], event.channelID, packet.packet);
+							enet_peer_send(peer_map[target], event.channelID, event.packet);
 						}
 					} else {
 
-						incoming_packets.push_back(packet);
+						_queue_received(event.packet, source, event.channelID);
 					}
 
 					// Destroy packet later
@@ -454,7 +451,8 @@ void NetworkedMultiplayerENet::close_connection(uint32_t wait_usec) {
 
 	enet_host_destroy(host);
 	active = false;
-	incoming_packets.clear();
+	_clear_incoming();
+	send_batches.clear();
 	unique_id = 1; // Server is 1
 	connection_status = CONNECTION_DISCONNECTED;
 }
@@ -491,20 +489,22 @@ void NetworkedMultiplayerENet::disconnect_peer(int p_peer, bool now) {
 
 int NetworkedMultiplayerENet::get_available_packet_count() const {
 
-	return incoming_packets.size();
+	return incoming_count;
 }
 
 Error NetworkedMultiplayerENet::get_packet(const uint8_t **r_buffer, int &r_buffer_size) {
 
-	ERR_FAIL_COND_V(incoming_packets.size() == 0, ERR_UNAVAILABLE);
+	ERR_FAIL_COND_V(incoming_count == 0, ERR_UNAVAILABLE);
 
 	_pop_current_packet();
 
-	current_packet = incoming_packets.front()->get();
-	incoming_packets.pop_front();
+	current_packet = incoming_packets[incoming_read];
+	incoming_read = (incoming_read + 1) & (incoming_packets.size() - 1);
+	incoming_count--;
 
-	*r_buffer = (const uint8_t *)(&current_packet.packet->data[12]);
-	r_buffer_size = current_packet.packet->dataLength - 12;
+	// Handed out straight from the ENet packet, no copy.
+	*r_buffer = (const uint8_t *)(&current_packet.packet->data[current_packet.offset]);
+	r_buffer_size = current_packet.size;
 
 	return OK;
 }
@@ -538,58 +538,121 @@ Error NetworkedMultiplayerENet::put_packet(const uint8_t *p_buffer, int p_buffer
 	if (transfer_channel > SYSCH_CONFIG)
 		channel = transfer_channel;
 
-	Map<int, ENetPeer *>::Element *E = NULL;
-
 	if (target_peer != 0) {
 
-		E = peer_map.find(ABS(target_peer));
-		if (!E) {
+		if (!peer_map.has(ABS(target_peer))) {
 			ERR_EXPLAIN("Invalid Target Peer: " + itos(target_peer));
 			ERR_FAIL_V(ERR_INVALID_PARAMETER);
 		}
 	}
 
+	if (packet_batching && p_buffer_size <= BATCH_MAX_SIZE - 16) {
+
+		SendBatch &batch = send_batches.write[channel];
+
+		// A channel keeps one open batch, anything going elsewhere closes it to preserve ordering.
+		if (batch.count && (batch.target != target_peer || batch.flags != packet_flags || 12 + batch.used + 4 + p_buffer_size > BATCH_MAX_SIZE)) {
+			_flush_send_batch(channel);
+		}
+
+		if (batch.buffer.size() < BATCH_MAX_SIZE) {
+			batch.buffer.resize(BATCH_MAX_SIZE); // Kept for the lifetime of the connection.
+		}
+
+		batch.target = target_peer;
+		batch.flags = packet_flags;
+		encode_uint32(p_buffer_size, &batch.buffer.write[batch.used]);
+		copymem(&batch.buffer.write[batch.used + 4], p_buffer, p_buffer_size);
+		batch.used += 4 + p_buffer_size;
+		batch.count++;
+
+		return OK;
+	}
+
+	// Too big to batch, whatever is pending must leave first.
+	_flush_send_batches();
+
 	ENetPacket *packet = enet_packet_create(NULL, p_buffer_size + 12, packet_flags);
 	encode_uint32(unique_id, &packet->data[0]); // Source ID
 	encode_uint32(target_peer, &packet->data[4]); // Dest ID
 	encode_uint32(packet_flags, &packet->data[8]); // Dest ID
 	copymem(&packet->data[12], p_buffer, p_buffer_size);
 
+	Error err = _send_packet(target_peer, channel, packet, packet_flags);
+
+	enet_host_flush(host);
+
+	return err;
+}
+
+Error NetworkedMultiplayerENet::_send_packet(int p_target, int p_channel, ENetPacket *p_packet, int p_flags) {
+
 	if (server) {
 
-		if (target_peer == 0) {
-			enet_host_broadcast(host, channel, packet);
-		} else if (target_peer < 0) {
+		if (p_target == 0) {
+			enet_host_broadcast(host, p_channel, p_packet);
+		} else if (p_target < 0) {
 			// Send to all but one
 			// and make copies for sending
 
-			int exclude = -target_peer;
+			int exclude = -p_target;
 
 			for (Map<int, ENetPeer *>::Element *F = peer_map.front(); F; F = F->next()) {
 
 				if (F->key() == exclude) // Exclude packet
 					continue;
 
-				ENetPacket *packet2 = enet_packet_create(packet->data, packet->dataLength, packet_flags);
+				ENetPacket *packet2 = enet_packet_create(p_packet->data, p_packet->dataLength, p_flags);
 
-				enet_peer_send(F->get(), channel, packet2);
+				enet_peer_send(F->get(), p_channel, packet2);
 			}
 
-			enet_packet_destroy(packet); // Original packet no longer needed
+			enet_packet_destroy(p_packet); // Original packet no longer needed
 		} else {
-			enet_peer_send(E->get(), channel, packet);
+			Map<int, ENetPeer *>::Element *E = peer_map.find(p_target);
+			if (!E) {
+				enet_packet_destroy(p_packet);
+				ERR_FAIL_V(ERR_INVALID_PARAMETER);
+			}
+			enet_peer_send(E->get(), p_channel, p_packet);
 		}
 	} else {
 
-		ERR_FAIL_COND_V(!peer_map.has(1), ERR_BUG);
-		enet_peer_send(peer_map[1], channel, packet); // Send to server for broadcast
+		if (!peer_map.has(1)) {
+			enet_packet_destroy(p_packet);
+			ERR_FAIL_V(ERR_BUG);
+		}
+		enet_peer_send(peer_map[1], p_channel, p_packet); // Send to server for broadcast
 	}
 
-	enet_host_flush(host);
-
 	return OK;
 }
 
+void NetworkedMultiplayerENet::_flush_send_batch(int p_channel) {
+
+	SendBatch &batch = send_batches.write[p_channel];
+	if (!batch.count)
+		return;
+
+	ENetPacket *packet = enet_packet_create(NULL, batch.used + 12, batch.flags);
+	encode_uint32(unique_id, &packet->data[0]); // Source ID
+	encode_uint32(batch.target, &packet->data[4]); // Dest ID
+	encode_uint32(batch.flags | PACKET_FLAG_BATCHED, &packet->data[8]); // Flags
+	copymem(&packet->data[12], batch.buffer.ptr(), batch.used);
+
+	batch.used = 0;
+	batch.count = 0;
+
+	_send_packet(batch.target, p_channel, packet, batch.flags);
+}
+
+void NetworkedMultiplayerENet::_flush_send_batches() {
+
+	for (int i = 0; i < send_batches.size(); i++) {
+		_flush_send_batch(i);
+	}
+}
+
 int NetworkedMultiplayerENet::get_max_packet_size() const {
 
 	return 1 << 24; // Anything is good
@@ -598,13 +661,91 @@ int NetworkedMultiplayerENet::get_max_packet_size() const {
 void NetworkedMultiplayerENet::_pop_current_packet() {
 
 	if (current_packet.packet) {
-		enet_packet_destroy(current_packet.packet);
+		if (current_packet.owner) {
+			enet_packet_destroy(current_packet.packet);
+		}
 		current_packet.packet = NULL;
 		current_packet.from = 0;
 		current_packet.channel = -1;
 	}
 }
 
+void NetworkedMultiplayerENet::_push_incoming(const Packet &p_packet) {
+
+	if (incoming_count == incoming_packets.size()) {
+		// Full, grow to the next power of two and unwrap the ring.
+		Vector<Packet> grown;
+		grown.resize(MAX(16, incoming_packets.size() * 2));
+		for (int i = 0; i < incoming_count; i++) {
+			grown.write[i] = incoming_packets[(incoming_read + i) & (incoming_packets.size() - 1)];
+		}
+		incoming_packets = grown;
+		incoming_read = 0;
+	}
+
+	incoming_packets.write[(incoming_read + incoming_count) & (incoming_packets.size() - 1)] = p_packet;
+	incoming_count++;
+}
+
+void NetworkedMultiplayerENet::_queue_received(ENetPacket *p_packet, int p_from, int p_channel) {
+
+	Packet packet;
+	packet.packet = p_packet;
+	packet.from = p_from;
+	packet.channel = p_channel;
+
+	int len = p_packet->dataLength;
+	uint32_t flags = decode_uint32(&p_packet->data[8]);
+
+	if (!(flags & PACKET_FLAG_BATCHED)) {
+		packet.offset = 12;
+		packet.size = len - 12;
+		packet.owner = true;
+		_push_incoming(packet);
+		return;
+	}
+
+	// Validate the whole batch before queueing any of it.
+	int count = 0;
+	int ofs = 12;
+	while (ofs < len) {
+		if (ofs + 4 > len || int(decode_uint32(&p_packet->data[ofs])) > len - ofs - 4) {
+			count = 0;
+			break;
+		}
+		ofs += 4 + decode_uint32(&p_packet->data[ofs]);
+		count++;
+	}
+
+	if (count == 0) {
+		enet_packet_destroy(p_packet);
+		ERR_EXPLAIN("Invalid batched packet received from peer: " + itos(p_from));
+		ERR_FAIL();
+	}
+
+	ofs = 12;
+	for (int i = 0; i < count; i++) {
+		packet.size = decode_uint32(&p_packet->data[ofs]);
+		packet.offset = ofs + 4;
+		packet.owner = i == count - 1;
+		_push_incoming(packet);
+		ofs += 4 + packet.size;
+	}
+}
+
+void NetworkedMultiplayerENet::_clear_incoming() {
+
+	while (incoming_count) {
+		const Packet &packet = incoming_packets[incoming_read];
+		if (packet.owner) {
+			enet_packet_destroy(packet.packet);
+		}
+		incoming_read = (incoming_read + 1) & (incoming_packets.size() - 1);
+		incoming_count--;
+	}
+	incoming_read = 0;
+}
+
 NetworkedMultiplayerPeer::ConnectionStatus NetworkedMultiplayerENet::get_connection_status() const {
 
 	return connection_status;
@@ -659,6 +800,53 @@ NetworkedMultiplayerENet::CompressionMode NetworkedMultiplayerENet::get_compress
 	return compression_mode;
 }
 
+void NetworkedMultiplayerENet::set_compression_dictionary(const PoolVector<uint8_t> &p_dictionary) {
+
+	ERR_FAIL_COND(active);
+
+	compression_dictionary = p_dictionary;
+	compression_dictionary_id = 0;
+	if (p_dictionary.size() == 0)
+		return;
+
+	Vector<uint8_t> dictionary;
+	dictionary.resize(p_dictionary.size());
+	PoolVector<uint8_t>::Read r = p_dictionary.read();
+	copymem(dictionary.ptrw(), r.ptr(), p_dictionary.size());
+
+	// Registered by content, other peers using the same dictionary share it, so it's never removed.
+	compression_dictionary_id = Compression::get_zstd_dictionary_id(dictionary);
+	Compression::add_zstd_dictionary(compression_dictionary_id, dictionary);
+}
+
+PoolVector<uint8_t> NetworkedMultiplayerENet::get_compression_dictionary() const {
+
+	return compression_dictionary;
+}
+
+PoolVector<uint8_t> NetworkedMultiplayerENet::train_compression_dictionary(const Array &p_samples, int p_max_size) const {
+
+	PoolVector<uint8_t> ret;
+	ERR_FAIL_COND_V(p_max_size <= 0, ret);
+
+	Vector<Vector<uint8_t> > samples;
+	for (int i = 0; i < p_samples.size(); i++) {
+
+		PoolVector<uint8_t> sample = p_samples[i];
+		Vector<uint8_t> data;
+		data.resize(sample.size());
+		PoolVector<uint8_t>::Read r = sample.read();
+		copymem(data.ptrw(), r.ptr(), sample.size());
+		samples.push_back(data);
+	}
+
+	Vector<uint8_t> dictionary = Compression::train_zstd_dictionary(samples, p_max_size);
+	ret.resize(dictionary.size());
+	PoolVector<uint8_t>::Write w = ret.write();
+	copymem(w.ptr(), dictionary.ptr(), dictionary.size());
+	return ret;
+}
+
 size_t NetworkedMultiplayerENet::enet_compress(void *context, const ENetBuffer *inBuffers, size_t inBufferCount, size_t inLimit, enet_uint8 *outData, size_t outLimit) {
 
 	NetworkedMultiplayerENet *enet = (NetworkedMultiplayerENet *)(context);
@@ -687,17 +875,20 @@ size_t NetworkedMultiplayerENet::enet_compress(void *context, const ENetBuffer *
 		case COMPRESS_ZLIB: {
 			mode = Compression::MODE_DEFLATE;
 		} break;
-		case COMPRESS_ZSTD: {
+		case COMPRESS_ZSTD:
+		case COMPRESS_ZSTD_DICTIONARY: {
 			mode = Compression::MODE_ZSTD;
 		} break;
 		default: { ERR_FAIL_V(0); }
 	}
 
+	uint32_t dictionary = enet->compression_mode == COMPRESS_ZSTD_DICTIONARY ? enet->compression_dictionary_id : 0;
+
 	int req_size = Compression::get_max_compressed_buffer_size(ofs, mode);
 	if (enet->dst_compressor_mem.size() < req_size) {
 		enet->dst_compressor_mem.resize(req_size);
 	}
-	int ret = Compression::compress(enet->dst_compressor_mem.ptrw(), enet->src_compressor_mem.ptr(), ofs, mode);
+	int ret = Compression::compress(enet->dst_compressor_mem.ptrw(), enet->src_compressor_mem.ptr(), ofs, mode, dictionary);
 
 	if (ret < 0)
 		return 0;
@@ -727,6 +918,10 @@ size_t NetworkedMultiplayerENet::enet_decompress(void *context, const enet_uint8
 
 			ret = Compression::decompress(outData, outLimit, inData, inLimit, Compression::MODE_ZSTD);
 		} break;
+		case COMPRESS_ZSTD_DICTIONARY: {
+
+			ret = Compression::decompress(outData, outLimit, inData, inLimit, Compression::MODE_ZSTD, enet->compression_dictionary_id);
+		} break;
 		default: {}
 	}
 	if (ret < 0) {
@@ -749,7 +944,8 @@ void NetworkedMultiplayerENet::_setup_compressor() {
 		} break;
 		case COMPRESS_FASTLZ:
 		case COMPRESS_ZLIB:
-		case COMPRESS_ZSTD: {
+		case COMPRESS_ZSTD:
+		case COMPRESS_ZSTD_DICTIONARY: {
 
 			enet_host_compress(host, &enet_compressor);
 		} break;
@@ -823,6 +1019,86 @@ bool NetworkedMultiplayerENet::is_always_ordered() const {
 	return always_ordered;
 }
 
+void NetworkedMultiplayerENet::set_packet_batching(bool p_enable) {
+
+	if (packet_batching && !p_enable && active) {
+		_flush_send_batches();
+		enet_host_flush(host);
+	}
+	packet_batching = p_enable;
+}
+
+bool NetworkedMultiplayerENet::is_packet_batching() const {
+	return packet_batching;
+}
+
+static int _enet_outgoing_size(ENetList *p_list, bool p_bytes) {
+
+	int total = 0;
+	for (ENetListIterator I = enet_list_begin(p_list); I != enet_list_end(p_list); I = enet_list_next(I)) {
+		total += p_bytes ? ((ENetOutgoingCommand *)I)->fragmentLength : 1;
+	}
+	return total;
+}
+
+int NetworkedMultiplayerENet::_get_send_queue_size(int p_peer_id, bool p_bytes) const {
+
+	ERR_FAIL_COND_V(!active, 0);
+
+	int total = 0;
+	for (const Map<int, ENetPeer *>::Element *E = peer_map.front(); E; E = E->next()) {
+
+		if (p_peer_id != 0 && E->key() != p_peer_id)
+			continue;
+		if (!E->get())
+			continue; // Clients only know other clients by id, their data goes through the server.
+
+		total += _enet_outgoing_size(&E->get()->outgoingReliableCommands, p_bytes);
+		total += _enet_outgoing_size(&E->get()->outgoingUnreliableCommands, p_bytes);
+
+		for (int i = 0; i < send_batches.size(); i++) {
+			const SendBatch &batch = send_batches[i];
+			if (!batch.count)
+				continue;
+			if (server && batch.target != 0 && batch.target != E->key() && (batch.target > 0 || -batch.target == E->key()))
+				continue;
+			total += p_bytes ? batch.used : batch.count;
+		}
+	}
+
+	return total;
+}
+
+int NetworkedMultiplayerENet::get_send_queue_packet_count(int p_peer_id) const {
+
+	return _get_send_queue_size(p_peer_id, false);
+}
+
+int NetworkedMultiplayerENet::get_send_queue_byte_count(int p_peer_id) const {
+
+	return _get_send_queue_size(p_peer_id, true);
+}
+
+int NetworkedMultiplayerENet::get_peer_rtt(int p_peer_id) const {
+
+	ERR_FAIL_COND_V(!peer_map.has(p_peer_id), -1);
+	ENetPeer *p = peer_map[p_peer_id];
+	if (!p)
+		return -1; // Clients have no direct link to other clients.
+
+	return p->roundTripTime;
+}
+
+float NetworkedMultiplayerENet::get_peer_packet_loss(int p_peer_id) const {
+
+	ERR_FAIL_COND_V(!peer_map.has(p_peer_id), -1);
+	ENetPeer *p = peer_map[p_peer_id];
+	if (!p)
+		return -1;
+
+	return (float)p->packetLoss / ENET_PEER_PACKET_LOSS_SCALE;
+}
+
 void NetworkedMultiplayerENet::_bind_methods() {
 
 	ClassDB::bind_method(D_METHOD("create_server", "port", "max_clients", "in_bandwidth", "out_bandwidth"), &NetworkedMultiplayerENet::create_server, DEFVAL(32), DEFVAL(0), DEFVAL(0));
@@ -831,6 +1107,9 @@ void NetworkedMultiplayerENet::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("disconnect_peer", "id", "now"), &NetworkedMultiplayerENet::disconnect_peer, DEFVAL(false));
 	ClassDB::bind_method(D_METHOD("set_compression_mode", "mode"), &NetworkedMultiplayerENet::set_compression_mode);
 	ClassDB::bind_method(D_METHOD("get_compression_mode"), &NetworkedMultiplayerENet::get_compression_mode);
+	ClassDB::bind_method(D_METHOD("set_compression_dictionary", "dictionary"), &NetworkedMultiplayerENet::set_compression_dictionary);
+	ClassDB::bind_method(D_METHOD("get_compression_dictionary"), &NetworkedMultiplayerENet::get_compression_dictionary);
+	ClassDB::bind_method(D_METHOD("train_compression_dictionary", "samples", "max_size"), &NetworkedMultiplayerENet::train_compression_dictionary, DEFVAL(16384));
 	ClassDB::bind_method(D_METHOD("set_bind_ip", "ip"), &NetworkedMultiplayerENet::set_bind_ip);
 	ClassDB::bind_method(D_METHOD("get_peer_address", "id"), &NetworkedMultiplayerENet::get_peer_address);
 	ClassDB::bind_method(D_METHOD("get_peer_port", "id"), &NetworkedMultiplayerENet::get_peer_port);
@@ -843,17 +1122,22 @@ void NetworkedMultiplayerENet::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("get_channel_count"), &NetworkedMultiplayerENet::get_channel_count);
 	ClassDB::bind_method(D_METHOD("set_always_ordered", "ordered"), &NetworkedMultiplayerENet::set_always_ordered);
 	ClassDB::bind_method(D_METHOD("is_always_ordered"), &NetworkedMultiplayerENet::is_always_ordered);
+	ClassDB::bind_method(D_METHOD("set_packet_batching", "enable"), &NetworkedMultiplayerENet::set_packet_batching);
+	ClassDB::bind_method(D_METHOD("is_packet_batching"), &NetworkedMultiplayerENet::is_packet_batching);
 
-	ADD_PROPERTY(PropertyInfo(Variant::INT, "compression_mode", PROPERTY_HINT_ENUM, "None,Range Coder,FastLZ,ZLib,ZStd"), "set_compression_mode", "get_compression_mode");
+	ADD_PROPERTY(PropertyInfo(Variant::INT, "compression_mode", PROPERTY_HINT_ENUM, "None,Range Coder,FastLZ,ZLib,ZStd,ZStd Dictionary"), "set_compression_mode", "get_compression_mode");
+	ADD_PROPERTY(PropertyInfo(Variant::POOL_BYTE_ARRAY, "compression_dictionary"), "set_compression_dictionary", "get_compression_dictionary");
 	ADD_PROPERTY(PropertyInfo(Variant::INT, "transfer_channel"), "set_transfer_channel", "get_transfer_channel");
 	ADD_PROPERTY(PropertyInfo(Variant::INT, "channel_count"), "set_channel_count", "get_channel_count");
 	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "always_ordered"), "set_always_ordered", "is_always_ordered");
+	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "packet_batching"), "set_packet_batching", "is_packet_batching");
 
 	BIND_ENUM_CONSTANT(COMPRESS_NONE);
 	BIND_ENUM_CONSTANT(COMPRESS_RANGE_CODER);
 	BIND_ENUM_CONSTANT(COMPRESS_FASTLZ);
 	BIND_ENUM_CONSTANT(COMPRESS_ZLIB);
 	BIND_ENUM_CONSTANT(COMPRESS_ZSTD);
+	BIND_ENUM_CONSTANT(COMPRESS_ZSTD_DICTIONARY);
 }
 
 NetworkedMultiplayerENet::NetworkedMultiplayerENet() {
@@ -864,12 +1148,17 @@ NetworkedMultiplayerENet::NetworkedMultiplayerENet() {
 	unique_id = 0;
 	target_peer = 0;
 	current_packet.packet = NULL;
+	current_packet.owner = false;
+	incoming_read = 0;
+	incoming_count = 0;
+	packet_batching = false;
 	transfer_mode = TRANSFER_MODE_RELIABLE;
 	channel_count = SYSCH_MAX;
 	transfer_channel = -1;
 	always_ordered = false;
 	connection_status = CONNECTION_DISCONNECTED;
 	compression_mode = COMPRESS_NONE;
+	compression_dictionary_id = 0;
 	enet_compressor.context = this;
 	enet_compressor.compress = enet_compress;
 	enet_compressor.decompress = enet_decompress;
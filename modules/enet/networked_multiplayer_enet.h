@@ -45,7 +45,8 @@ public:
 		COMPRESS_RANGE_CODER,
 		COMPRESS_FASTLZ,
 		COMPRESS_ZLIB,
-		COMPRESS_ZSTD
+		COMPRESS_ZSTD,
+		COMPRESS_ZSTD_DICTIONARY
 	};
 
 private:
@@ -61,6 +62,11 @@ private:
 		SYSCH_MAX
 	};
 
+	enum {
+		PACKET_FLAG_BATCHED = 1 << 30, // set in the header flags, payload is a run of length-prefixed messages
+		BATCH_MAX_SIZE = 1200 // keep batches below the usual MTU so unreliable ones are never fragmented
+	};
+
 	bool active;
 	bool server;
 
@@ -85,18 +91,53 @@ private:
 	struct Packet {
 
 		ENetPacket *packet;
+		int offset;
+		int size;
 		int from;
 		int channel;
+		bool owner; // Messages of a batch share one ENet packet, the last one destroys it.
 	};
 
 	CompressionMode compression_mode;
+	PoolVector<uint8_t> compression_dictionary;
+	uint32_t compression_dictionary_id;
 
-	List<Packet> incoming_packets;
+	// Ring of received messages, its storage is kept so receiving does not allocate per packet.
+	Vector<Packet> incoming_packets;
+	int incoming_read;
+	int incoming_count;
 
 	Packet current_packet;
 
+	struct SendBatch {
+
+		int target;
+		int flags;
+		Vector<uint8_t> buffer;
+		int used;
+		int count;
+
+		SendBatch() {
+			target = 0;
+			flags = 0;
+			used = 0;
+			count = 0;
+		}
+	};
+
+	bool packet_batching;
+	Vector<SendBatch> send_batches; // One open batch per channel.
+
 	uint32_t _gen_unique_id() const;
 	void _pop_current_packet();
+	void _push_incoming(const Packet &p_packet);
+	void _queue_received(ENetPacket *p_packet, int p_from, int p_channel);
+	void _clear_incoming();
+
+	Error _send_packet(int p_target, int p_channel, ENetPacket *p_packet, int p_flags);
+	void _flush_send_batch(int p_channel);
+	void _flush_send_batches();
+	int _get_send_queue_size(int p_peer_id, bool p_bytes) const;
 
 	Vector<uint8_t> src_compressor_mem;
 	Vector<uint8_t> dst_compressor_mem;
@@ -148,6 +189,9 @@ public:
 
 	void set_compression_mode(CompressionMode p_mode);
 	CompressionMode get_compression_mode() const;
+	void set_compression_dictionary(const PoolVector<uint8_t> &p_dictionary);
+	PoolVector<uint8_t> get_compression_dictionary() const;
+	PoolVector<uint8_t> train_compression_dictionary(const Array &p_samples, int p_max_size = 16384) const;
 
 	int get_packet_channel() const;
 	int get_last_packet_channel() const;
@@ -157,6 +201,13 @@ public:
 	int get_channel_count() const;
 	void set_always_ordered(bool p_ordered);
 	bool is_always_ordered() const;
+	void set_packet_batching(bool p_enable);
+	bool is_packet_batching() const;
+
+	virtual int get_send_queue_packet_count(int p_peer_id = 0) const;
+	virtual int get_send_queue_byte_count(int p_peer_id = 0) const;
+	virtual int get_peer_rtt(int p_peer_id) const;
+	virtual float get_peer_packet_loss(int p_peer_id) const;
 
 	NetworkedMultiplayerENet();
 	~NetworkedMultiplayerENet();
@@ -1,5 +1,6 @@
 def can_build(env, platform):
-    return True
+    # godot_variant has a fixed size that inline transforms would overflow.
+    return not env.get('inline_variant_transforms', False)
 
 def configure(env):
     env.use_ptrcall = True
@@ -34,6 +34,7 @@
 #include "core/engine.h"
 #include "core/error_macros.h"
 #include "core/global_constants.h"
+#include "core/os/frame_arena.h"
 #include "core/os/os.h"
 #include "core/variant.h"
 
@@ -128,6 +129,14 @@ void GDAPI godot_free(void *p_ptr) {
 	memfree(p_ptr);
 }
 
+void GDAPI *godot_frame_arena_alloc(int p_bytes) {
+	return FrameArena::alloc(p_bytes);
+}
+
+void GDAPI godot_frame_arena_free(void *p_ptr) {
+	FrameArena::free(p_ptr);
+}
+
 void GDAPI godot_print_error(const char *p_description, const char *p_function, const char *p_file, int p_line) {
 	_err_print_error(p_function, p_file, p_line, p_description, ERR_HANDLER_ERROR);
 }
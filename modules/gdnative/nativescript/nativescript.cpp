@@ -264,13 +264,7 @@ Error NativeScript::reload(bool p_keep_state) {
 bool NativeScript::has_method(const StringName &p_method) const {
 	NativeScriptDesc *script_data = get_script_desc();
 
-	while (script_data) {
-		if (script_data->methods.has(p_method))
-			return true;
-
-		script_data = script_data->base_data;
-	}
-	return false;
+	return script_data && script_data->method_cache.has(p_method);
 }
 
 MethodInfo NativeScript::get_method_info(const StringName &p_method) const {
@@ -550,6 +544,26 @@ NativeScript::~NativeScript() {
 
 #define GET_SCRIPT_DESC() script->get_script_desc()
 
+void NativeScriptDesc::update_method_cache() {
+	method_cache.clear();
+	notification_methods.clear();
+
+	static StringName notification_name = "_notification";
+
+	for (NativeScriptDesc *desc = this; desc; desc = desc->base_data) {
+		for (Map<StringName, Method>::Element *E = desc->methods.front(); E; E = E->next()) {
+			if (!method_cache.has(E->key())) {
+				method_cache.set(E->key(), &E->get());
+			}
+		}
+
+		Map<StringName, Method>::Element *N = desc->methods.find(notification_name);
+		if (N) {
+			notification_methods.push_back(&N->get());
+		}
+	}
+}
+
 void NativeScriptInstance::_ml_call_reversed(NativeScriptDesc *script_data, const StringName &p_method, const Variant **p_args, int p_argcount) {
 	if (script_data->base_data) {
 		_ml_call_reversed(script_data->base_data, p_method, p_args, p_argcount);
@@ -724,17 +738,17 @@ Variant NativeScriptInstance::call(const StringName &p_method, const Variant **p
 
 	NativeScriptDesc *script_data = GET_SCRIPT_DESC();
 
-	while (script_data) {
-		Map<StringName, NativeScriptDesc::Method>::Element *E = script_data->methods.find(p_method);
-		if (E) {
+	if (script_data) {
+		const NativeScriptDesc::Method *const *M = script_data->method_cache.getptr(p_method);
+		if (M) {
 			godot_variant result;
 
 #ifdef DEBUG_ENABLED
 			current_method_call = p_method;
 #endif
 
-			result = E->get().method.method((godot_object *)owner,
-					E->get().method.method_data,
+			result = (*M)->method.method((godot_object *)owner,
+					(*M)->method.method_data,
 					userdata,
 					p_argcount,
 					(godot_variant **)p_args);
@@ -748,8 +762,6 @@ Variant NativeScriptInstance::call(const StringName &p_method, const Variant **p
 			r_error.error = Variant::CallError::CALL_OK;
 			return res;
 		}
-
-		script_data = script_data->base_data;
 	}
 
 	r_error.error = Variant::CallError::CALL_ERROR_INVALID_METHOD;
@@ -766,9 +778,18 @@ void NativeScriptInstance::notification(int p_notification) {
 	}
 #endif
 
+	NativeScriptDesc *script_data = GET_SCRIPT_DESC();
+	if (!script_data || script_data->notification_methods.empty()) {
+		return;
+	}
+
 	Variant value = p_notification;
 	const Variant *args[1] = { &value };
-	call_multilevel("_notification", args, 1);
+	for (int i = 0; i < script_data->notification_methods.size(); i++) {
+		const NativeScriptDesc::Method *M = script_data->notification_methods[i];
+		godot_variant res = M->method.method((godot_object *)owner, M->method.method_data, userdata, 1, (godot_variant **)args);
+		godot_variant_destroy(&res);
+	}
 }
 
 void NativeScriptInstance::refcount_incremented() {
@@ -1502,11 +1523,24 @@ void NativeScriptLanguage::init_library(const Ref<GDNativeLibrary> &lib) {
 		} else {
 			((void (*)(godot_string *))proc_ptr)((godot_string *)&lib_path);
 		}
+
+		update_method_caches(lib_path);
 	} else {
 		// already initialized. Nice.
 	}
 }
 
+void NativeScriptLanguage::update_method_caches(const String &p_lib_path) {
+	Map<String, Map<StringName, NativeScriptDesc> >::Element *L = library_classes.find(p_lib_path);
+	if (!L) {
+		return;
+	}
+
+	for (Map<StringName, NativeScriptDesc>::Element *C = L->get().front(); C; C = C->next()) {
+		C->get().update_method_cache();
+	}
+}
+
 void NativeScriptLanguage::register_script(NativeScript *script) {
 #ifndef NO_THREADS
 	MutexLock lock(mutex);
@@ -1708,6 +1742,8 @@ void NativeReloadNode::_notification(int p_what) {
 					((void (*)(void *))proc_ptr)((void *)&L->key());
 				}
 
+				NSL->update_method_caches(L->key());
+
 				for (Map<String, Set<NativeScript *> >::Element *U = NSL->library_script_users.front(); U; U = U->next()) {
 					for (Set<NativeScript *>::Element *S = U->get().front(); S; S = S->next()) {
 						NativeScript *script = S->get();
@@ -31,6 +31,7 @@
 #ifndef NATIVE_SCRIPT_H
 #define NATIVE_SCRIPT_H
 
+#include "core/hash_map.h"
 #include "core/io/resource_loader.h"
 #include "core/io/resource_saver.h"
 #include "core/oa_hash_map.h"
@@ -72,6 +73,12 @@ struct NativeScriptDesc {
 
 	Map<StringName, Method> methods;
 	OrderedHashMap<StringName, Property> properties;
+
+	// Methods of this class and its bases (the most derived one wins) and the
+	// _notification of every level, built once the library registered its classes.
+	HashMap<StringName, const Method *> method_cache;
+	Vector<const Method *> notification_methods;
+
 	Map<StringName, Signal> signals_; // QtCreator doesn't like the name signals
 	StringName base;
 	StringName base_native_type;
@@ -85,6 +92,8 @@ struct NativeScriptDesc {
 
 	bool is_tool;
 
+	void update_method_cache();
+
 	inline NativeScriptDesc() :
 			methods(),
 			properties(),
@@ -246,6 +255,7 @@ private:
 #endif
 
 	void init_library(const Ref<GDNativeLibrary> &lib);
+	void update_method_caches(const String &p_lib_path);
 	void register_script(NativeScript *script);
 	void unregister_script(NativeScript *script);
 
@@ -9,6 +9,7 @@ def get_doc_classes():
         "GDScript",
         "GDScriptFunctionState",
         "GDScriptNativeClass",
+        "GDScriptSignalQueue",
     ]
 
 def get_doc_path():
@@ -769,6 +769,23 @@ Error GDScript::load_byte_code(const String &p_path) {
 	ERR_FAIL_COND_V(bytecode.size() == 0, ERR_PARSE_ERROR);
 	path = p_path;
 
+	if (GDScriptBytecode::is_compiled_buffer(bytecode)) {
+
+		if (GDScriptBytecode::load(this, bytecode) == OK) {
+
+			for (Map<StringName, Ref<GDScript> >::Element *E = subclasses.front(); E; E = E->next()) {
+
+				_set_subclass_path(E->get(), path);
+			}
+			return OK;
+		}
+
+		// Made by another engine build or refers to something that is gone, compile the tokens instead.
+		compiled_data.unref();
+		bytecode = GDScriptBytecode::get_token_buffer(bytecode);
+		ERR_FAIL_COND_V(bytecode.size() == 0, ERR_PARSE_ERROR);
+	}
+
 	String basedir = path;
 
 	if (basedir == "")
@@ -961,6 +978,12 @@ bool GDScriptInstance::set(const StringName &p_name, const Variant &p_value) {
 				if (err.error == Variant::CallError::CALL_OK) {
 					return true; //function exists, call was successful
 				}
+			} else if (E->get().data_type.has_element_type()) {
+				Variant typed;
+				if (!E->get().data_type.make_typed_array(p_value, typed)) {
+					return false; // Type mismatch
+				}
+				members.write[E->get().index] = typed;
 			} else {
 				if (!E->get().data_type.is_type(p_value)) {
 					return false; // Type mismatch
@@ -1423,6 +1446,64 @@ Error GDScriptLanguage::execute_file(const String &p_path) {
 void GDScriptLanguage::finish() {
 }
 
+#ifdef GDSCRIPT_PROFILE_OPCODES
+static const char *_opcode_names[GDScriptFunction::OPCODE_END + 1] = {
+	"OPCODE_OPERATOR_INT",
+	"OPCODE_OPERATOR_REAL",
+	"OPCODE_OPERATOR_VECTOR2",
+	"OPCODE_OPERATOR_VECTOR3",
+	"OPCODE_OPERATOR",
+	"OPCODE_EXTENDS_TEST",
+	"OPCODE_IS_BUILTIN",
+	"OPCODE_SET",
+	"OPCODE_GET",
+	"OPCODE_SET_ARRAY",
+	"OPCODE_GET_ARRAY",
+	"OPCODE_SET_NAMED_VECTOR",
+	"OPCODE_SET_NAMED",
+	"OPCODE_GET_NAMED_VECTOR",
+	"OPCODE_GET_NAMED",
+	"OPCODE_SET_MEMBER",
+	"OPCODE_GET_MEMBER",
+	"OPCODE_ASSIGN",
+	"OPCODE_ASSIGN_TRUE",
+	"OPCODE_ASSIGN_FALSE",
+	"OPCODE_ASSIGN_TYPED_BUILTIN",
+	"OPCODE_ASSIGN_TYPED_NATIVE",
+	"OPCODE_ASSIGN_TYPED_SCRIPT",
+	"OPCODE_ASSIGN_TYPED_ARRAY",
+	"OPCODE_CAST_TO_BUILTIN",
+	"OPCODE_CAST_TO_NATIVE",
+	"OPCODE_CAST_TO_SCRIPT",
+	"OPCODE_CONSTRUCT",
+	"OPCODE_CONSTRUCT_ARRAY",
+	"OPCODE_CONSTRUCT_DICTIONARY",
+	"OPCODE_CALL",
+	"OPCODE_CALL_RETURN",
+	"OPCODE_CALL_METHOD_BIND",
+	"OPCODE_CALL_METHOD_BIND_RETURN",
+	"OPCODE_CALL_BUILT_IN",
+	"OPCODE_CALL_SELF",
+	"OPCODE_CALL_SELF_BASE",
+	"OPCODE_YIELD",
+	"OPCODE_YIELD_SIGNAL",
+	"OPCODE_YIELD_RESUME",
+	"OPCODE_JUMP",
+	"OPCODE_JUMP_IF",
+	"OPCODE_JUMP_IF_NOT",
+	"OPCODE_JUMP_TO_DEF_ARGUMENT",
+	"OPCODE_RETURN",
+	"OPCODE_ITERATE_BEGIN",
+	"OPCODE_ITERATE",
+	"OPCODE_ITERATE_BEGIN_RANGE",
+	"OPCODE_ITERATE_RANGE",
+	"OPCODE_ASSERT",
+	"OPCODE_BREAKPOINT",
+	"OPCODE_LINE",
+	"OPCODE_END",
+};
+#endif
+
 void GDScriptLanguage::profiling_start() {
 
 #ifdef DEBUG_ENABLED
@@ -1444,6 +1525,21 @@ void GDScriptLanguage::profiling_start() {
 		elem = elem->next();
 	}
 
+#ifdef GDSCRIPT_PROFILE_OPCODES
+	for (int i = 0; i <= GDScriptFunction::OPCODE_END; i++) {
+		opcode_profile[i].call_count = 0;
+		opcode_profile[i].self_time = 0;
+		opcode_profile[i].total_time = 0;
+		opcode_profile[i].frame_call_count = 0;
+		opcode_profile[i].frame_self_time = 0;
+		opcode_profile[i].frame_total_time = 0;
+		opcode_profile[i].last_frame_call_count = 0;
+		opcode_profile[i].last_frame_self_time = 0;
+		opcode_profile[i].last_frame_total_time = 0;
+	}
+	opcode_nested_time = 0;
+#endif
+
 	profiling = true;
 	if (lock) {
 		lock->unlock();
@@ -1467,6 +1563,140 @@ void GDScriptLanguage::profiling_stop() {
 #endif
 }
 
+void GDScriptLanguage::_take_sample() {
+
+	// Racy on purpose: the main thread keeps running while the stack is copied.
+	// Only pointers are read, a stale entry is filtered out when resolving.
+	int depth = MIN(_debug_call_stack_pos, 128);
+	if (depth <= 0)
+		return; // Not running script code.
+
+	MutexLock lock(sampling_mutex);
+	if (sampled_functions.size() + depth > 1 << 20)
+		return; // Nobody is collecting, don't grow forever.
+
+	int ofs = sampled_functions.size();
+	sampled_functions.resize(ofs + depth);
+	for (int i = 0; i < depth; i++) {
+		sampled_functions.write[ofs + i] = _call_stack[i].function;
+	}
+	sampled_depths.push_back(depth);
+}
+
+void GDScriptLanguage::_sampling_thread_func(void *p_ud) {
+
+	GDScriptLanguage *self = (GDScriptLanguage *)p_ud;
+
+	while (!self->sampling_exit) {
+		OS::get_singleton()->delay_usec(self->sampling_interval_usec);
+		self->_take_sample();
+	}
+}
+
+void GDScriptLanguage::profiling_sampling_start(int p_frequency) {
+
+#ifdef DEBUG_ENABLED
+	ERR_EXPLAIN("The sampling profiler needs the script debugger, run the project from the editor or with --remote-debug.");
+	ERR_FAIL_COND(!_call_stack);
+	ERR_FAIL_COND(p_frequency <= 0);
+
+	profiling_sampling_stop();
+
+	sampling_interval_usec = MAX(1000000 / p_frequency, 100);
+	sampling_exit = false;
+	sampling_mutex = Mutex::create();
+	sampling_thread = Thread::create(_sampling_thread_func, this);
+#endif
+}
+
+void GDScriptLanguage::profiling_sampling_stop() {
+
+	if (!sampling_thread)
+		return;
+
+	sampling_exit = true;
+	Thread::wait_to_finish(sampling_thread);
+	memdelete(sampling_thread);
+	sampling_thread = NULL;
+	memdelete(sampling_mutex);
+	sampling_mutex = NULL;
+	sampled_depths.clear();
+	sampled_functions.clear();
+}
+
+void GDScriptLanguage::profiling_get_stack_samples(List<ProfilingStackSample> *r_samples) {
+
+#ifdef DEBUG_ENABLED
+	if (!sampling_thread)
+		return;
+
+	Vector<int> depths;
+	Vector<GDScriptFunction *> functions;
+	{
+		MutexLock lock(sampling_mutex);
+		SWAP(depths, sampled_depths);
+		SWAP(functions, sampled_functions);
+	}
+
+	if (depths.empty())
+		return;
+
+	// Only functions that still exist can be named.
+	Map<GDScriptFunction *, StringName> signatures;
+	for (int i = 0; i < functions.size(); i++) {
+		signatures[functions[i]] = StringName();
+	}
+
+	if (lock) {
+		lock->lock();
+	}
+	for (SelfList<GDScriptFunction> *elem = function_list.first(); elem; elem = elem->next()) {
+		Map<GDScriptFunction *, StringName>::Element *E = signatures.find(elem->self());
+		if (E) {
+			E->get() = elem->self()->profile.signature;
+		}
+	}
+	if (lock) {
+		lock->unlock();
+	}
+
+	Map<String, ProfilingStackSample> merged;
+	int ofs = 0;
+	for (int i = 0; i < depths.size(); i++) {
+
+		ProfilingStackSample sample;
+		sample.stack.resize(depths[i]);
+		String key;
+		bool valid = true;
+		for (int j = 0; j < depths[i]; j++) {
+			StringName signature = signatures[functions[ofs + j]];
+			if (signature == StringName()) {
+				valid = false;
+				break;
+			}
+			sample.stack.write[j] = signature;
+			key += String(signature) + "\n";
+		}
+		ofs += depths[i];
+
+		if (!valid)
+			continue;
+
+		Map<String, ProfilingStackSample>::Element *E = merged.find(key);
+		if (E) {
+			E->get().count++;
+		} else {
+			sample.count = 1;
+			merged.insert(key, sample);
+		}
+	}
+
+	for (Map<String, ProfilingStackSample>::Element *E = merged.front(); E; E = E->next()) {
+		r_samples->push_back(E->get());
+	}
+#endif
+}
+
 int GDScriptLanguage::profiling_get_accumulated_data(ProfilingInfo *p_info_arr, int p_info_max) {
 
 	int current = 0;
@@ -1487,6 +1717,18 @@ int GDScriptLanguage::profiling_get_accumulated_data(ProfilingInfo *p_info_arr,
 		current++;
 	}
 
+#ifdef GDSCRIPT_PROFILE_OPCODES
+	for (int i = 0; i <= GDScriptFunction::OPCODE_END && current < p_info_max; i++) {
+		if (opcode_profile[i].call_count == 0)
+			continue;
+		p_info_arr[current].call_count = opcode_profile[i].call_count;
+		p_info_arr[current].self_time = opcode_profile[i].self_time;
+		p_info_arr[current].total_time = opcode_profile[i].total_time;
+		p_info_arr[current].signature = opcode_profile[i].signature;
+		current++;
+	}
+#endif
+
 	if (lock) {
 		lock->unlock();
 	}
@@ -1519,6 +1761,18 @@ int GDScriptLanguage::profiling_get_frame_data(ProfilingInfo *p_info_arr, int p_
 		elem = elem->next();
 	}
 
+#ifdef GDSCRIPT_PROFILE_OPCODES
+	for (int i = 0; i <= GDScriptFunction::OPCODE_END && current < p_info_max; i++) {
+		if (opcode_profile[i].last_frame_call_count == 0)
+			continue;
+		p_info_arr[current].call_count = opcode_profile[i].last_frame_call_count;
+		p_info_arr[current].self_time = opcode_profile[i].last_frame_self_time;
+		p_info_arr[current].total_time = opcode_profile[i].last_frame_total_time;
+		p_info_arr[current].signature = opcode_profile[i].signature;
+		current++;
+	}
+#endif
+
 	if (lock) {
 		lock->unlock();
 	}
@@ -1740,6 +1994,18 @@ void GDScriptLanguage::frame() {
 			elem = elem->next();
 		}
 
+#ifdef GDSCRIPT_PROFILE_OPCODES
+		for (int i = 0; i <= GDScriptFunction::OPCODE_END; i++) {
+			GDScriptFunction::Profile &profile = opcode_profile[i];
+			profile.last_frame_call_count = profile.frame_call_count;
+			profile.last_frame_self_time = profile.frame_self_time;
+			profile.last_frame_total_time = profile.frame_total_time;
+			profile.frame_call_count = 0;
+			profile.frame_self_time = 0;
+			profile.frame_total_time = 0;
+		}
+#endif
+
 		if (lock) {
 			lock->unlock();
 		}
@@ -2110,6 +2376,27 @@ GDScriptLanguage::GDScriptLanguage() {
 #endif
 	profiling = false;
 	script_frame_time = 0;
+	sampling_thread = NULL;
+	sampling_mutex = NULL;
+	sampling_exit = false;
+	sampling_interval_usec = 1000;
+
+#ifdef GDSCRIPT_PROFILE_OPCODES
+	for (int i = 0; i <= GDScriptFunction::OPCODE_END; i++) {
+		// shows up in the profiler as a function named after the opcode
+		opcode_profile[i].signature = String("GDScript VM::0::") + _opcode_names[i];
+		opcode_profile[i].call_count = 0;
+		opcode_profile[i].self_time = 0;
+		opcode_profile[i].total_time = 0;
+		opcode_profile[i].frame_call_count = 0;
+		opcode_profile[i].frame_self_time = 0;
+		opcode_profile[i].frame_total_time = 0;
+		opcode_profile[i].last_frame_call_count = 0;
+		opcode_profile[i].last_frame_self_time = 0;
+		opcode_profile[i].last_frame_total_time = 0;
+	}
+	opcode_nested_time = 0;
+#endif
 
 	_debug_call_stack_pos = 0;
 	int dmcs = GLOBAL_DEF("debug/settings/gdscript/max_call_stack", 1024);
@@ -2139,6 +2426,8 @@ GDScriptLanguage::GDScriptLanguage() {
 
 GDScriptLanguage::~GDScriptLanguage() {
 
+	profiling_sampling_stop();
+
 	if (lock) {
 		memdelete(lock);
 		lock = NULL;
@@ -34,6 +34,7 @@
 #include "core/io/resource_loader.h"
 #include "core/io/resource_saver.h"
 #include "core/script_language.h"
+#include "gdscript_bytecode.h"
 #include "gdscript_function.h"
 
 class GDScriptNativeClass : public Reference {
@@ -72,6 +73,7 @@ class GDScript : public Script {
 	friend class GDScriptCompiler;
 	friend class GDScriptFunctions;
 	friend class GDScriptLanguage;
+	friend class GDScriptBytecode;
 
 	Variant _static_ref; //used for static call
 	Ref<GDScriptNativeClass> native;
@@ -105,6 +107,8 @@ class GDScript : public Script {
 
 	GDScriptFunction *initializer; //direct pointer to _init , faster to locate
 
+	Ref<GDScriptBytecodeData> compiled_data; //precompiled file the functions are loaded from
+
 	int subclass_count;
 	Set<Object *> instances;
 	//exported members
@@ -348,9 +352,39 @@ class GDScriptLanguage : public ScriptLanguage {
 	friend class GDScriptFunction;
 
 	SelfList<GDScriptFunction>::List function_list;
+	friend class GDScriptSignalQueue;
+
+	Map<ObjectID, GDScriptSignalQueue *> signal_queues;
 	bool profiling;
 	uint64_t script_frame_time;
 
+	// Sampling profiler. Its thread only copies function pointers out of the
+	// main thread call stack, they are resolved against function_list later.
+	Thread *sampling_thread;
+	Mutex *sampling_mutex;
+	volatile bool sampling_exit;
+	int sampling_interval_usec;
+	Vector<int> sampled_depths;
+	Vector<GDScriptFunction *> sampled_functions; // Outermost first, sampled_depths[i] entries per sample.
+
+	static void _sampling_thread_func(void *p_ud);
+	void _take_sample();
+
+#ifdef GDSCRIPT_PROFILE_OPCODES
+	GDScriptFunction::Profile opcode_profile[GDScriptFunction::OPCODE_END + 1];
+	uint64_t opcode_nested_time; // time spent in nested script calls, kept out of the calling opcode's self time
+
+	_FORCE_INLINE_ void _profile_opcode(int p_opcode, uint64_t p_total_time, uint64_t p_self_time) {
+		GDScriptFunction::Profile &profile = opcode_profile[p_opcode];
+		profile.call_count++;
+		profile.total_time += p_total_time;
+		profile.self_time += p_self_time;
+		profile.frame_call_count++;
+		profile.frame_total_time += p_total_time;
+		profile.frame_self_time += p_self_time;
+	}
+#endif
+
 public:
 	int calls;
 
@@ -491,6 +525,10 @@ public:
 	virtual int profiling_get_accumulated_data(ProfilingInfo *p_info_arr, int p_info_max);
 	virtual int profiling_get_frame_data(ProfilingInfo *p_info_arr, int p_info_max);
 
+	virtual void profiling_sampling_start(int p_frequency);
+	virtual void profiling_sampling_stop();
+	virtual void profiling_get_stack_samples(List<ProfilingStackSample> *r_samples);
+
 	/* LOADER FUNCTIONS */
 
 	virtual void get_recognized_extensions(List<String> *p_extensions) const;
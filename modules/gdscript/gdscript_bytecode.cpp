@@ -0,0 +1,1373 @@
+/*************************************************************************/
+/*  gdscript_bytecode.cpp                                                */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2019 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2019 Godot Engine contributors (cf. AUTHORS.md)    */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#include "gdscript_bytecode.h"
+
+#include "core/io/marshalls.h"
+#include "core/io/resource_loader.h"
+#include "core/os/os.h"
+#include "core/safe_refcount.h"
+#include "core/version.h"
+#include "core/version_hash.gen.h"
+#include "gdscript.h"
+#include "gdscript_functions.h"
+
+// A precompiled script starts with the token stream of the file, so it can
+// always be parsed and compiled again, followed by the compiled classes.
+// Bump the version whenever the layout of the compiled part changes.
+
+#define COMPILED_VERSION 3
+
+enum {
+	OBJECT_RESOURCE,
+	OBJECT_SELF,
+	OBJECT_NATIVE
+};
+
+enum {
+	VALUE_VARIANT,
+	VALUE_OBJECT
+};
+
+enum {
+	BASE_NATIVE,
+	BASE_SCRIPT
+};
+
+// Bytecode refers to opcodes, operators, built-in functions and types by
+// value, so it is only usable by the exact build that produced it.
+static String _get_engine_stamp() {
+
+	return String(VERSION_FULL_BUILD) + "." + VERSION_HASH + "/" + itos(GDScriptFunction::OPCODE_END) + "/" + itos(Variant::VARIANT_MAX) + "/" + itos(Variant::OP_MAX) + "/" + itos(GDScriptFunctions::FUNC_MAX);
+}
+
+struct GDScriptBytecodeReader {
+
+	const uint8_t *data;
+	int size;
+	int pos;
+	bool error;
+	const Vector<StringName> *strings;
+
+	uint32_t get_u32() {
+
+		if (pos + 4 > size) {
+			error = true;
+			return 0;
+		}
+		uint32_t v = decode_uint32(&data[pos]);
+		pos += 4;
+		return v;
+	}
+
+	const uint8_t *get_bytes(int p_len) {
+
+		int padded = (p_len + 3) & ~3;
+		if (p_len < 0 || pos + padded > size) {
+			error = true;
+			return NULL;
+		}
+		const uint8_t *ptr = &data[pos];
+		pos += padded;
+		return ptr;
+	}
+
+	// Element counts can't exceed what is left of the buffer, so a corrupt
+	// count fails here instead of resizing to an arbitrary size.
+	int get_count(int p_min_item_size) {
+
+		uint32_t count = get_u32();
+		if (count > uint32_t(size - pos) / p_min_item_size) {
+			error = true;
+			return 0;
+		}
+		return count;
+	}
+
+	StringName get_string_name() {
+
+		uint32_t idx = get_u32();
+		if (idx >= (uint32_t)strings->size()) {
+			error = true;
+			return StringName();
+		}
+		return (*strings)[idx];
+	}
+
+	void skip(int p_len) {
+
+		if (p_len < 0 || pos + p_len > size) {
+			error = true;
+			return;
+		}
+		pos += p_len;
+	}
+
+	GDScriptBytecodeReader(const Vector<uint8_t> &p_buffer, int p_pos = 0) {
+
+		data = p_buffer.ptr();
+		size = p_buffer.size();
+		pos = p_pos;
+		error = false;
+		strings = NULL;
+	}
+};
+
+bool GDScriptBytecode::is_compiled_buffer(const Vector<uint8_t> &p_buffer) {
+
+	return p_buffer.size() >= 12 && p_buffer[0] == 'G' && p_buffer[1] == 'D' && p_buffer[2] == 'C' && p_buffer[3] == 'C';
+}
+
+Vector<uint8_t> GDScriptBytecode::get_token_buffer(const Vector<uint8_t> &p_buffer) {
+
+	ERR_FAIL_COND_V(!is_compiled_buffer(p_buffer), Vector<uint8_t>());
+
+	GDScriptBytecodeReader r(p_buffer, 8);
+	int len = r.get_u32();
+	const uint8_t *tokens = r.get_bytes(len);
+	ERR_FAIL_COND_V(r.error, Vector<uint8_t>());
+
+	Vector<uint8_t> ret;
+	ret.resize(len);
+	copymem(ret.ptrw(), tokens, len);
+	return ret;
+}
+
+/////////////////////
+
+Variant GDScriptBytecodeData::_get_object(int p_idx) const {
+
+	ERR_FAIL_INDEX_V(p_idx, objects.size(), Variant());
+
+	if (self_objects[p_idx]) {
+		// The file's own classes may go away before a lazy function needs them.
+		GDScript *script = Object::cast_to<GDScript>(ObjectDB::get_instance(self_objects[p_idx]));
+		return script ? Variant(Ref<GDScript>(script)) : Variant();
+	}
+	return objects[p_idx];
+}
+
+bool GDScriptBytecodeData::load_function(GDScriptFunction *p_function) {
+
+	MutexLock mlock(lock);
+
+	if (!p_function->lazy_data) {
+		return true; // Loaded by another thread in the meantime.
+	}
+
+	GDScriptBytecodeReader r(buffer, p_function->lazy_offset);
+	r.strings = &strings;
+
+	Vector<int> code;
+	code.resize(r.get_count(4));
+	for (int i = 0; i < code.size() && !r.error; i++) {
+		code.write[i] = r.get_u32();
+	}
+
+	// Global operands were written as indices into the table of the file.
+	int reloc_count = r.get_count(4);
+	for (int i = 0; i < reloc_count && !r.error; i++) {
+		uint32_t pos = r.get_u32();
+		if (pos >= (uint32_t)code.size() || (code[pos] & GDScriptFunction::ADDR_MASK) >= globals.size()) {
+			r.error = true;
+			break;
+		}
+		code.write[pos] = (GDScriptFunction::ADDR_TYPE_GLOBAL << GDScriptFunction::ADDR_BITS) | globals[code[pos] & GDScriptFunction::ADDR_MASK];
+	}
+
+	Vector<Variant> constants;
+	constants.resize(r.get_count(8));
+	for (int i = 0; i < constants.size() && !r.error; i++) {
+		GDScriptBytecode::_read_value(r, this, constants.write[i]);
+	}
+
+	Vector<StringName> global_names;
+	global_names.resize(r.get_count(4));
+	for (int i = 0; i < global_names.size() && !r.error; i++) {
+		global_names.write[i] = r.get_string_name();
+	}
+
+	Vector<GDScriptFunction::NativeMethod> function_methods;
+	function_methods.resize(r.get_count(4));
+	for (int i = 0; i < function_methods.size() && !r.error; i++) {
+		uint32_t idx = r.get_u32();
+		if (idx >= (uint32_t)methods.size()) {
+			r.error = true;
+			break;
+		}
+		function_methods.write[i] = methods[idx];
+	}
+
+	List<GDScriptFunction::StackDebug> stack_debug;
+	int stack_debug_count = r.get_count(16);
+	for (int i = 0; i < stack_debug_count && !r.error; i++) {
+		GDScriptFunction::StackDebug sd;
+		sd.line = r.get_u32();
+		sd.pos = r.get_u32();
+		sd.added = r.get_u32();
+		sd.identifier = r.get_string_name();
+		stack_debug.push_back(sd);
+	}
+
+	if (r.error || code.size() == 0) {
+		// The function stays unloaded, so every call reports the error.
+		ERR_EXPLAIN("Corrupt precompiled function '" + String(p_function->name) + "' in: " + String(p_function->source));
+		ERR_FAIL_V(false);
+	}
+
+	p_function->constants = constants;
+	p_function->_constants_ptr = constants.size() ? p_function->constants.ptrw() : NULL;
+	p_function->_constant_count = constants.size();
+
+	p_function->global_names = global_names;
+	p_function->_global_names_ptr = global_names.size() ? p_function->global_names.ptr() : NULL;
+	p_function->_global_names_count = global_names.size();
+
+	p_function->methods = function_methods;
+	p_function->_methods_ptr = function_methods.size() ? p_function->methods.ptr() : NULL;
+	p_function->_methods_count = function_methods.size();
+
+	p_function->stack_debug = stack_debug;
+
+	p_function->code = code;
+	p_function->_code_size = code.size();
+	p_function->_code_ptr = p_function->code.ptr();
+
+	// Cleared last with a full barrier, a thread that no longer sees lazy_data sees the whole body.
+	atomic_compare_exchange((volatile uintptr_t *)&p_function->lazy_data, (uintptr_t)this, (uintptr_t)0);
+
+	return true;
+}
+
+GDScriptBytecodeData::GDScriptBytecodeData() {
+
+	lock = Mutex::create();
+}
+
+GDScriptBytecodeData::~GDScriptBytecodeData() {
+
+	memdelete(lock);
+}
+
+/////////////////////
+
+bool GDScriptBytecode::_read_value(GDScriptBytecodeReader &r, const GDScriptBytecodeData *p_data, Variant &r_value) {
+
+	uint32_t tag = r.get_u32();
+
+	if (tag == VALUE_OBJECT) {
+		uint32_t idx = r.get_u32();
+		if (idx >= (uint32_t)p_data->objects.size()) {
+			r.error = true;
+			return false;
+		}
+		r_value = p_data->_get_object(idx);
+		return true;
+	}
+
+	int len = r.get_u32();
+	const uint8_t *ptr = r.get_bytes(len);
+	if (r.error || tag != VALUE_VARIANT || decode_variant(r_value, ptr, len) != OK) {
+		r.error = true;
+		return false;
+	}
+	return true;
+}
+
+void GDScriptBytecode::_read_datatype(GDScriptBytecodeReader &r, const GDScriptBytecodeData *p_data, GDScriptDataType &r_type) {
+
+	r_type.has_type = r.get_u32();
+	switch (r.get_u32()) {
+		case GDScriptDataType::BUILTIN: {
+			r_type.kind = GDScriptDataType::BUILTIN;
+		} break;
+		case GDScriptDataType::NATIVE: {
+			r_type.kind = GDScriptDataType::NATIVE;
+		} break;
+		case GDScriptDataType::SCRIPT: {
+			r_type.kind = GDScriptDataType::SCRIPT;
+		} break;
+		case GDScriptDataType::GDSCRIPT: {
+			r_type.kind = GDScriptDataType::GDSCRIPT;
+		} break;
+		default: {
+			r_type.kind = GDScriptDataType::UNINITIALIZED;
+		}
+	}
+	r_type.builtin_type = Variant::Type(r.get_u32());
+	r_type.native_type = r.get_string_name();
+	r_type.element_type = Variant::Type(r.get_u32());
+	r_type.element_native_type = r.get_string_name();
+	if (r_type.builtin_type >= Variant::VARIANT_MAX || r_type.element_type >= Variant::VARIANT_MAX) {
+		r.error = true;
+		return;
+	}
+	uint32_t script = r.get_u32();
+	if (script != 0xFFFFFFFF) {
+		if (script >= (uint32_t)p_data->objects.size()) {
+			r.error = true;
+			return;
+		}
+		r_type.script_type = p_data->_get_object(script);
+	}
+}
+
+Error GDScriptBytecode::_make_scripts(GDScriptBytecodeReader &r, GDScript *p_script, Map<GDScript *, int> &r_offsets) {
+
+	p_script->name = r.get_string_name();
+	p_script->tool = r.get_u32();
+
+	p_script->subclasses.clear();
+
+	int subclass_count = r.get_count(8);
+	for (int i = 0; i < subclass_count && !r.error; i++) {
+
+		StringName name = r.get_string_name();
+		int size = r.get_u32();
+		int end = r.pos + size;
+
+		Ref<GDScript> subclass;
+		subclass.instance();
+		subclass->_owner = p_script;
+		p_script->subclasses.insert(name, subclass);
+
+		Error err = _make_scripts(r, subclass.ptr(), r_offsets);
+		if (err)
+			return err;
+
+		if (end < r.pos || end > r.size) {
+			r.error = true;
+		}
+		r.pos = end;
+	}
+
+	r_offsets[p_script] = r.pos;
+
+	return r.error ? ERR_FILE_CORRUPT : OK;
+}
+
+Error GDScriptBytecode::_load_class(const GDScriptBytecodeData *p_data, GDScript *p_script, GDScript *p_root, Map<GDScript *, int> &p_offsets, Set<GDScript *> &r_loading) {
+
+	GDScriptBytecodeReader r(p_data->buffer, p_offsets[p_script]);
+	r.strings = &p_data->strings;
+
+	p_offsets.erase(p_script);
+	r_loading.insert(p_script);
+
+	p_script->native = Ref<GDScriptNativeClass>();
+	p_script->base = Ref<GDScript>();
+	p_script->_base = NULL;
+
+	uint32_t base_kind = r.get_u32();
+	if (base_kind == BASE_NATIVE) {
+
+		StringName native = r.get_string_name();
+		const Map<StringName, int> &global_map = GDScriptLanguage::get_singleton()->get_global_map();
+		if (r.error || !global_map.has(native)) {
+			return ERR_FILE_MISSING_DEPENDENCIES;
+		}
+		p_script->native = GDScriptLanguage::get_singleton()->get_global_array()[global_map[native]];
+		if (p_script->native.is_null()) {
+			return ERR_FILE_MISSING_DEPENDENCIES;
+		}
+
+	} else {
+
+		uint32_t idx = r.get_u32();
+		if (r.error || idx >= (uint32_t)p_data->objects.size()) {
+			return ERR_FILE_CORRUPT;
+		}
+		Ref<GDScript> base = p_data->_get_object(idx);
+		if (base.is_null()) {
+			return ERR_FILE_MISSING_DEPENDENCIES;
+		}
+
+		// Inner classes may extend other classes of the same file, which need their members first.
+		if (p_offsets.has(base.ptr())) {
+			Error err = _load_class(p_data, base.ptr(), p_root, p_offsets, r_loading);
+			if (err)
+				return err;
+		} else if (r_loading.has(base.ptr()) || !base->valid) {
+			return ERR_CYCLIC_LINK;
+		}
+
+		p_script->base = base;
+		p_script->_base = base.ptr();
+		p_script->member_indices = base->member_indices;
+	}
+
+	int member_count = r.get_count(4);
+	for (int i = 0; i < member_count && !r.error; i++) {
+
+		StringName name = r.get_string_name();
+
+		GDScript::MemberInfo minfo;
+		minfo.index = r.get_u32();
+		minfo.setter = r.get_string_name();
+		minfo.getter = r.get_string_name();
+		minfo.rpc_mode = MultiplayerAPI::RPCMode(r.get_u32());
+		_read_datatype(r, p_data, minfo.data_type);
+
+		PropertyInfo pinfo;
+		pinfo.name = name;
+		pinfo.type = Variant::Type(r.get_u32());
+		pinfo.class_name = r.get_string_name();
+		pinfo.hint = PropertyHint(r.get_u32());
+		pinfo.hint_string = r.get_string_name();
+		pinfo.usage = r.get_u32();
+
+		p_script->member_info[name] = pinfo;
+		p_script->member_indices[name] = minfo;
+		p_script->members.insert(name);
+	}
+
+	int constant_count = r.get_count(4);
+	for (int i = 0; i < constant_count && !r.error; i++) {
+
+		StringName name = r.get_string_name();
+		Variant value;
+		_read_value(r, p_data, value);
+		p_script->constants.insert(name, value);
+	}
+
+	int signal_count = r.get_count(4);
+	for (int i = 0; i < signal_count && !r.error; i++) {
+
+		StringName name = r.get_string_name();
+		Vector<StringName> args;
+		args.resize(r.get_count(4));
+		for (int j = 0; j < args.size() && !r.error; j++) {
+			args.write[j] = r.get_string_name();
+		}
+		p_script->_signals[name] = args;
+	}
+
+	// Only the function headers are read here, bodies are loaded on first call.
+	String source = p_root->get_path();
+
+	int function_count = r.get_count(4);
+	for (int i = 0; i < function_count && !r.error; i++) {
+
+		GDScriptFunction *gdfunc = memnew(GDScriptFunction);
+
+		gdfunc->name = r.get_string_name();
+		p_script->member_functions[gdfunc->name] = gdfunc;
+
+		gdfunc->_argument_count = r.get_u32();
+		gdfunc->_static = r.get_u32();
+		gdfunc->rpc_mode = MultiplayerAPI::RPCMode(r.get_u32());
+
+		gdfunc->argument_types.resize(r.get_count(4));
+		for (int j = 0; j < gdfunc->argument_types.size() && !r.error; j++) {
+			_read_datatype(r, p_data, gdfunc->argument_types.write[j]);
+		}
+		_read_datatype(r, p_data, gdfunc->return_type);
+
+		gdfunc->default_arguments.resize(r.get_count(4));
+		for (int j = 0; j < gdfunc->default_arguments.size() && !r.error; j++) {
+			gdfunc->default_arguments.write[j] = r.get_u32();
+		}
+		if (gdfunc->default_arguments.size()) {
+			gdfunc->_default_arg_count = gdfunc->default_arguments.size() - 1;
+			gdfunc->_default_arg_ptr = gdfunc->default_arguments.ptr();
+		} else {
+			gdfunc->_default_arg_count = 0;
+			gdfunc->_default_arg_ptr = NULL;
+		}
+
+		gdfunc->_stack_size = r.get_u32();
+		gdfunc->_call_size = r.get_u32();
+		gdfunc->_has_yield = r.get_u32() != 0;
+		gdfunc->_initial_line = r.get_u32();
+		if ((uint32_t)gdfunc->_stack_size > GDScriptFunction::ADDR_MASK || (uint32_t)gdfunc->_call_size > GDScriptFunction::ADDR_MASK || (uint32_t)gdfunc->_argument_count > GDScriptFunction::ADDR_MASK) {
+			r.error = true; // Frames are allocated from these on every call.
+		}
+
+		int arg_name_count = r.get_count(4);
+		for (int j = 0; j < arg_name_count && !r.error; j++) {
+			StringName arg_name = r.get_string_name();
+#ifdef TOOLS_ENABLED
+			gdfunc->arg_names.push_back(arg_name);
+#endif
+		}
+
+		// The body stays in the buffer until the function is first needed.
+		int body_size = r.get_u32();
+		gdfunc->_code_size = r.get_u32();
+		gdfunc->_code_ptr = NULL;
+		gdfunc->_constants_ptr = NULL;
+		gdfunc->_constant_count = 0;
+		gdfunc->_global_names_ptr = NULL;
+		gdfunc->_global_names_count = 0;
+		gdfunc->_methods_ptr = NULL;
+		gdfunc->_methods_count = 0;
+#ifdef TOOLS_ENABLED
+		gdfunc->_named_globals_ptr = NULL;
+		gdfunc->_named_globals_count = 0;
+#endif
+		gdfunc->lazy_data = const_cast<GDScriptBytecodeData *>(p_data);
+		gdfunc->lazy_offset = r.pos;
+		r.skip(body_size);
+
+		gdfunc->_script = p_script;
+		gdfunc->source = source;
+
+#ifdef DEBUG_ENABLED
+		if (ScriptDebugger::get_singleton()) {
+			String signature = source + "::" + itos(gdfunc->_initial_line);
+			if (!p_script->name.empty()) {
+				signature += "::" + String(p_script->name) + "." + String(gdfunc->name);
+			} else {
+				signature += "::" + String(gdfunc->name);
+			}
+			gdfunc->profile.signature = signature;
+		}
+
+		gdfunc->func_cname = (source + " - " + String(gdfunc->name)).utf8();
+		gdfunc->_func_cname = gdfunc->func_cname.get_data();
+#endif
+	}
+
+	if (r.error) {
+		return ERR_FILE_CORRUPT;
+	}
+
+	Map<StringName, GDScriptFunction *>::Element *init = p_script->member_functions.find(GDScriptLanguage::get_singleton()->strings._init);
+	if (!init) {
+		return ERR_FILE_CORRUPT;
+	}
+	p_script->initializer = init->get();
+
+	p_script->compiled_data = Ref<GDScriptBytecodeData>(const_cast<GDScriptBytecodeData *>(p_data));
+	p_script->valid = true;
+
+	r_loading.erase(p_script);
+
+	return OK;
+}
+
+Error GDScriptBytecode::load(GDScript *p_script, const Vector<uint8_t> &p_buffer) {
+
+	ERR_FAIL_COND_V(!is_compiled_buffer(p_buffer), ERR_FILE_UNRECOGNIZED);
+
+	Ref<GDScriptBytecodeData> data;
+	data.instance();
+	data->buffer = p_buffer;
+
+	GDScriptBytecodeReader r(data->buffer, 4);
+	if (r.get_u32() != COMPILED_VERSION) {
+		return ERR_FILE_UNRECOGNIZED;
+	}
+	r.skip(r.get_u32());
+	r.pos = (r.pos + 3) & ~3;
+
+	int stamp_len = r.get_u32();
+	const uint8_t *stamp = r.get_bytes(stamp_len);
+	if (r.error) {
+		return ERR_FILE_CORRUPT;
+	}
+	String stamp_str;
+	stamp_str.parse_utf8((const char *)stamp, stamp_len);
+	if (stamp_str != _get_engine_stamp()) {
+		return ERR_FILE_UNRECOGNIZED;
+	}
+
+	data->strings.resize(r.get_count(4));
+	for (int i = 0; i < data->strings.size() && !r.error; i++) {
+		int len = r.get_u32();
+		const uint8_t *str = r.get_bytes(len);
+		if (str) {
+			String s;
+			s.parse_utf8((const char *)str, len);
+			data->strings.write[i] = s;
+		}
+	}
+	r.strings = &data->strings;
+
+	// Globals are stored by name, their indices depend on what this run registered.
+	const Map<StringName, int> &global_map = GDScriptLanguage::get_singleton()->get_global_map();
+	data->globals.resize(r.get_count(4));
+	for (int i = 0; i < data->globals.size() && !r.error; i++) {
+		StringName name = r.get_string_name();
+		const Map<StringName, int>::Element *E = global_map.find(name);
+		if (!E) {
+			return ERR_FILE_MISSING_DEPENDENCIES;
+		}
+		data->globals.write[i] = E->get();
+	}
+
+	data->methods.resize(r.get_count(8));
+	for (int i = 0; i < data->methods.size() && !r.error; i++) {
+		StringName class_name = r.get_string_name();
+		StringName method_name = r.get_string_name();
+		MethodBind *method = ClassDB::get_method(class_name, method_name);
+		if (!method) {
+			return ERR_FILE_MISSING_DEPENDENCIES;
+		}
+		data->methods.write[i].method = method;
+		data->methods.write[i].class_ptr = ClassDB::get_class_ptr(method->get_instance_class());
+	}
+
+	// Preloaded resources are loaded right away, as the compiler would.
+	Map<int, Vector<StringName> > self_chains;
+	int object_count = r.get_count(4);
+	data->objects.resize(object_count);
+	data->self_objects.resize(object_count);
+
+	for (int i = 0; i < object_count && !r.error; i++) {
+
+		data->self_objects.write[i] = 0;
+
+		uint32_t type = r.get_u32();
+		if (type == OBJECT_NATIVE) {
+			StringName name = r.get_string_name();
+			const Map<StringName, int>::Element *E = global_map.find(name);
+			if (!E || !Object::cast_to<GDScriptNativeClass>(GDScriptLanguage::get_singleton()->get_global_array()[E->get()])) {
+				return ERR_FILE_MISSING_DEPENDENCIES;
+			}
+			data->objects.write[i] = GDScriptLanguage::get_singleton()->get_global_array()[E->get()];
+			continue;
+		}
+
+		String path;
+		if (type == OBJECT_RESOURCE) {
+			path = r.get_string_name();
+		}
+		Vector<StringName> chain;
+		chain.resize(r.get_count(4));
+		for (int j = 0; j < chain.size() && !r.error; j++) {
+			chain.write[j] = r.get_string_name();
+		}
+		if (r.error) {
+			break;
+		}
+
+		if (type == OBJECT_SELF) {
+			self_chains[i] = chain;
+			continue;
+		}
+
+		RES res = ResourceLoader::load(path);
+		if (res.is_null()) {
+			return ERR_FILE_MISSING_DEPENDENCIES;
+		}
+		if (chain.size()) {
+			Ref<GDScript> script = res;
+			for (int j = 0; j < chain.size() && script.is_valid(); j++) {
+				script = script->subclasses.has(chain[j]) ? script->subclasses[chain[j]] : Ref<GDScript>();
+			}
+			if (script.is_null()) {
+				return ERR_FILE_MISSING_DEPENDENCIES;
+			}
+			res = script;
+		}
+		data->objects.write[i] = res;
+	}
+
+	if (r.error) {
+		return ERR_FILE_CORRUPT;
+	}
+
+	// Everything external resolved, now build the classes of the file.
+	Map<GDScript *, int> offsets;
+	Error err = _make_scripts(r, p_script, offsets);
+	if (err)
+		return err;
+
+	for (Map<int, Vector<StringName> >::Element *E = self_chains.front(); E; E = E->next()) {
+
+		GDScript *script = p_script;
+		for (int j = 0; j < E->get().size() && script; j++) {
+			script = script->subclasses.has(E->get()[j]) ? script->subclasses[E->get()[j]].ptr() : NULL;
+		}
+		if (!script) {
+			return ERR_FILE_CORRUPT;
+		}
+		data->self_objects.write[E->key()] = script->get_instance_id();
+	}
+
+	p_script->_owner = NULL;
+
+	Set<GDScript *> loading;
+	while (offsets.size()) {
+		err = _load_class(data.ptr(), offsets.front()->key(), p_script, offsets, loading);
+		if (err)
+			return err;
+	}
+
+	return OK;
+}
+
+/////////////////////
+
+#ifdef TOOLS_ENABLED
+
+struct GDScriptBytecodeWriter {
+
+	Vector<uint8_t> data;
+	Error error;
+
+	const GDScript *root;
+
+	Map<String, int> string_map;
+	Vector<String> strings;
+
+	Map<StringName, int> global_map;
+	Vector<int> globals;
+
+	Map<MethodBind *, int> method_map;
+	Vector<Pair<int, int> > methods;
+
+	Map<String, int> object_map;
+	Vector<Vector<int> > objects;
+
+	Vector<StringName> global_names; // Reverse of the language global map.
+
+	void put_u32(uint32_t p_value) {
+
+		int ofs = data.size();
+		data.resize(ofs + 4);
+		encode_uint32(p_value, &data.write[ofs]);
+	}
+
+	void put_bytes(const uint8_t *p_bytes, int p_len) {
+
+		if (p_len == 0) {
+			return;
+		}
+		int ofs = data.size();
+		data.resize(ofs + ((p_len + 3) & ~3));
+		copymem(&data.write[ofs], p_bytes, p_len);
+		for (int i = ofs + p_len; i < data.size(); i++) {
+			data.write[i] = 0;
+		}
+	}
+
+	int add_string(const String &p_string) {
+
+		Map<String, int>::Element *E = string_map.find(p_string);
+		if (E) {
+			return E->get();
+		}
+		int idx = strings.size();
+		strings.push_back(p_string);
+		string_map[p_string] = idx;
+		return idx;
+	}
+
+	void put_string(const String &p_string) {
+
+		put_u32(add_string(p_string));
+	}
+
+	int add_global(const StringName &p_name) {
+
+		Map<StringName, int>::Element *E = global_map.find(p_name);
+		if (E) {
+			return E->get();
+		}
+		int idx = globals.size();
+		globals.push_back(add_string(p_name));
+		global_map[p_name] = idx;
+		return idx;
+	}
+
+	int add_method(MethodBind *p_method) {
+
+		Map<MethodBind *, int>::Element *E = method_map.find(p_method);
+		if (E) {
+			return E->get();
+		}
+		int idx = methods.size();
+		methods.push_back(Pair<int, int>(add_string(p_method->get_instance_class()), add_string(p_method->get_name())));
+		method_map[p_method] = idx;
+		return idx;
+	}
+
+	GDScriptBytecodeWriter() {
+		error = OK;
+		root = NULL;
+	}
+};
+
+// Returns -1 for objects that can't be referenced from another run.
+int GDScriptBytecode::_write_object(GDScriptBytecodeWriter &w, const Object *p_object) {
+
+	Vector<int> entry;
+
+	const GDScriptNativeClass *native = Object::cast_to<GDScriptNativeClass>(p_object);
+	const GDScript *script = Object::cast_to<GDScript>(p_object);
+	const Resource *resource = Object::cast_to<Resource>(p_object);
+
+	if (native) {
+
+		entry.push_back(OBJECT_NATIVE);
+		entry.push_back(w.add_string(native->get_name()));
+
+	} else if (script || resource) {
+
+		Vector<int> chain;
+		while (script && script->_owner) {
+			const GDScript *owner = script->_owner;
+			const Map<StringName, Ref<GDScript> >::Element *E = owner->subclasses.front();
+			while (E && E->get().ptr() != script) {
+				E = E->next();
+			}
+			if (!E) {
+				return -1;
+			}
+			chain.insert(0, w.add_string(E->key()));
+			script = owner;
+		}
+
+		if (script == w.root) {
+			entry.push_back(OBJECT_SELF);
+		} else {
+			String path = script ? script->get_path() : resource->get_path();
+			if (!path.is_resource_file()) {
+				return -1; // Built-in resources have no path to load them from.
+			}
+			entry.push_back(OBJECT_RESOURCE);
+			entry.push_back(w.add_string(path));
+		}
+		entry.push_back(chain.size());
+		entry.append_array(chain);
+
+	} else {
+		return -1;
+	}
+
+	String key;
+	for (int i = 0; i < entry.size(); i++) {
+		key += itos(entry[i]) + ",";
+	}
+	Map<String, int>::Element *E = w.object_map.find(key);
+	if (E) {
+		return E->get();
+	}
+	int idx = w.objects.size();
+	w.objects.push_back(entry);
+	w.object_map[key] = idx;
+	return idx;
+}
+
+// Values of the compiled code can only contain objects at the top level,
+// where they go through the object table.
+static bool _is_plain_value(const Variant &p_value) {
+
+	switch (p_value.get_type()) {
+		case Variant::OBJECT: {
+			return false;
+		} break;
+		case Variant::ARRAY: {
+			Array array = p_value;
+			for (int i = 0; i < array.size(); i++) {
+				if (!_is_plain_value(array[i])) {
+					return false;
+				}
+			}
+		} break;
+		case Variant::DICTIONARY: {
+			Dictionary dict = p_value;
+			List<Variant> keys;
+			dict.get_key_list(&keys);
+			for (List<Variant>::Element *E = keys.front(); E; E = E->next()) {
+				if (!_is_plain_value(E->get()) || !_is_plain_value(dict[E->get()])) {
+					return false;
+				}
+			}
+		} break;
+		default: {
+		}
+	}
+	return true;
+}
+
+// Finds the operands of an instruction that are addresses, returns the
+// length of the instruction or 0 if the opcode isn't known.
+static int _get_instruction_addresses(const Vector<int> &p_code, int p_ip, Vector<int> &r_addresses) {
+
+#define ADDRESS(m_ofs) r_addresses.push_back(p_ip + (m_ofs))
+#define OPERAND(m_ofs) (p_ip + (m_ofs) < p_code.size() ? p_code[p_ip + (m_ofs)] : -1)
+
+	r_addresses.clear();
+
+	switch (p_code[p_ip]) {
+		case GDScriptFunction::OPCODE_OPERATOR_INT:
+		case GDScriptFunction::OPCODE_OPERATOR_REAL:
+		case GDScriptFunction::OPCODE_OPERATOR_VECTOR2:
+		case GDScriptFunction::OPCODE_OPERATOR_VECTOR3:
+		case GDScriptFunction::OPCODE_OPERATOR: {
+			ADDRESS(2);
+			ADDRESS(3);
+			ADDRESS(4);
+			return 5;
+		}
+		case GDScriptFunction::OPCODE_EXTENDS_TEST:
+		case GDScriptFunction::OPCODE_SET:
+		case GDScriptFunction::OPCODE_GET:
+		case GDScriptFunction::OPCODE_SET_ARRAY:
+		case GDScriptFunction::OPCODE_GET_ARRAY:
+		case GDScriptFunction::OPCODE_ASSIGN_TYPED_NATIVE:
+		case GDScriptFunction::OPCODE_ASSIGN_TYPED_SCRIPT:
+		case GDScriptFunction::OPCODE_CAST_TO_NATIVE:
+		case GDScriptFunction::OPCODE_CAST_TO_SCRIPT: {
+			ADDRESS(1);
+			ADDRESS(2);
+			ADDRESS(3);
+			return 4;
+		}
+		case GDScriptFunction::OPCODE_IS_BUILTIN:
+		case GDScriptFunction::OPCODE_SET_NAMED_VECTOR:
+		case GDScriptFunction::OPCODE_SET_NAMED:
+		case GDScriptFunction::OPCODE_GET_NAMED_VECTOR:
+		case GDScriptFunction::OPCODE_GET_NAMED: {
+			ADDRESS(1);
+			ADDRESS(3);
+			return 4;
+		}
+		case GDScriptFunction::OPCODE_ASSIGN_TYPED_BUILTIN:
+		case GDScriptFunction::OPCODE_CAST_TO_BUILTIN: {
+			ADDRESS(2);
+			ADDRESS(3);
+			return 4;
+		}
+		case GDScriptFunction::OPCODE_ASSIGN_TYPED_ARRAY: {
+			ADDRESS(3);
+			ADDRESS(4);
+			return 5;
+		}
+		case GDScriptFunction::OPCODE_SET_MEMBER:
+		case GDScriptFunction::OPCODE_GET_MEMBER: {
+			ADDRESS(2);
+			return 3;
+		}
+		case GDScriptFunction::OPCODE_ASSIGN:
+		case GDScriptFunction::OPCODE_YIELD_SIGNAL: {
+			ADDRESS(1);
+			ADDRESS(2);
+			return 3;
+		}
+		case GDScriptFunction::OPCODE_ASSIGN_TRUE:
+		case GDScriptFunction::OPCODE_ASSIGN_FALSE:
+		case GDScriptFunction::OPCODE_YIELD_RESUME:
+		case GDScriptFunction::OPCODE_RETURN:
+		case GDScriptFunction::OPCODE_ASSERT: {
+			ADDRESS(1);
+			return 2;
+		}
+		case GDScriptFunction::OPCODE_JUMP_IF:
+		case GDScriptFunction::OPCODE_JUMP_IF_NOT: {
+			ADDRESS(1);
+			return 3;
+		}
+		case GDScriptFunction::OPCODE_CONSTRUCT:
+		case GDScriptFunction::OPCODE_CALL_BUILT_IN:
+		case GDScriptFunction::OPCODE_CALL_SELF_BASE: {
+			int argc = OPERAND(2);
+			if (argc < 0)
+				return 0;
+			for (int i = 0; i <= argc; i++) {
+				ADDRESS(3 + i);
+			}
+			return 4 + argc;
+		}
+		case GDScriptFunction::OPCODE_CONSTRUCT_ARRAY: {
+			int argc = OPERAND(1);
+			if (argc < 0)
+				return 0;
+			for (int i = 0; i <= argc; i++) {
+				ADDRESS(2 + i);
+			}
+			return 3 + argc;
+		}
+		case GDScriptFunction::OPCODE_CONSTRUCT_DICTIONARY: {
+			int argc = OPERAND(1);
+			if (argc < 0)
+				return 0;
+			for (int i = 0; i <= argc * 2; i++) {
+				ADDRESS(2 + i);
+			}
+			return 3 + argc * 2;
+		}
+		case GDScriptFunction::OPCODE_CALL:
+		case GDScriptFunction::OPCODE_CALL_RETURN:
+		case GDScriptFunction::OPCODE_CALL_METHOD_BIND:
+		case GDScriptFunction::OPCODE_CALL_METHOD_BIND_RETURN: {
+			int argc = OPERAND(1);
+			if (argc < 0)
+				return 0;
+			int args = (p_code[p_ip] == GDScriptFunction::OPCODE_CALL || p_code[p_ip] == GDScriptFunction::OPCODE_CALL_RETURN) ? 4 : 5;
+			ADDRESS(2);
+			for (int i = 0; i <= argc; i++) {
+				ADDRESS(args + i);
+			}
+			return args + argc + 1;
+		}
+		case GDScriptFunction::OPCODE_ITERATE_BEGIN:
+		case GDScriptFunction::OPCODE_ITERATE: {
+			ADDRESS(1);
+			ADDRESS(2);
+			ADDRESS(4);
+			return 5;
+		}
+		case GDScriptFunction::OPCODE_ITERATE_BEGIN_RANGE: {
+			for (int i = 1; i <= 6; i++) {
+				ADDRESS(i);
+			}
+			ADDRESS(8);
+			return 9;
+		}
+		case GDScriptFunction::OPCODE_ITERATE_RANGE: {
+			ADDRESS(1);
+			ADDRESS(2);
+			ADDRESS(3);
+			ADDRESS(5);
+			return 6;
+		}
+		case GDScriptFunction::OPCODE_JUMP:
+		case GDScriptFunction::OPCODE_LINE: {
+			return 2;
+		}
+		case GDScriptFunction::OPCODE_YIELD:
+		case GDScriptFunction::OPCODE_JUMP_TO_DEF_ARGUMENT:
+		case GDScriptFunction::OPCODE_BREAKPOINT:
+		case GDScriptFunction::OPCODE_END: {
+			return 1;
+		}
+	}
+
+#undef OPERAND
+#undef ADDRESS
+
+	return 0;
+}
+
+void GDScriptBytecode::_write_value(GDScriptBytecodeWriter &w, const Variant &p_value) {
+
+	if (p_value.get_type() == Variant::OBJECT && p_value.operator Object *()) {
+
+		int idx = _write_object(w, p_value.operator Object *());
+		if (idx < 0) {
+			w.error = ERR_UNAVAILABLE;
+		}
+		w.put_u32(VALUE_OBJECT);
+		w.put_u32(idx);
+		return;
+	}
+
+	Variant value = p_value.get_type() == Variant::OBJECT ? Variant() : p_value;
+	int len;
+	if (!_is_plain_value(value) || encode_variant(value, NULL, len) != OK) {
+		w.error = ERR_UNAVAILABLE;
+		return;
+	}
+
+	Vector<uint8_t> buf;
+	buf.resize(len);
+	encode_variant(value, buf.ptrw(), len);
+
+	w.put_u32(VALUE_VARIANT);
+	w.put_u32(len);
+	w.put_bytes(buf.ptr(), len);
+}
+
+void GDScriptBytecode::_write_datatype(GDScriptBytecodeWriter &w, const GDScriptDataType &p_type) {
+
+	w.put_u32(p_type.has_type);
+	w.put_u32(p_type.kind);
+	w.put_u32(p_type.builtin_type);
+	w.put_string(p_type.native_type);
+	w.put_u32(p_type.element_type);
+	w.put_string(p_type.element_native_type);
+
+	if (p_type.script_type.is_valid()) {
+		int idx = _write_object(w, p_type.script_type.ptr());
+		if (idx < 0) {
+			w.error = ERR_UNAVAILABLE;
+		}
+		w.put_u32(idx);
+	} else {
+		w.put_u32(0xFFFFFFFF);
+	}
+}
+
+void GDScriptBytecode::_write_function(GDScriptBytecodeWriter &w, const GDScriptFunction *p_function) {
+
+	w.put_string(p_function->name);
+	w.put_u32(p_function->_argument_count);
+	w.put_u32(p_function->_static);
+	w.put_u32(p_function->rpc_mode);
+
+	w.put_u32(p_function->argument_types.size());
+	for (int i = 0; i < p_function->argument_types.size(); i++) {
+		_write_datatype(w, p_function->argument_types[i]);
+	}
+	_write_datatype(w, p_function->return_type);
+
+	w.put_u32(p_function->default_arguments.size());
+	for (int i = 0; i < p_function->default_arguments.size(); i++) {
+		w.put_u32(p_function->default_arguments[i]);
+	}
+
+	w.put_u32(p_function->_stack_size);
+	w.put_u32(p_function->_call_size);
+	w.put_u32(p_function->_has_yield);
+	w.put_u32(p_function->_initial_line);
+
+	w.put_u32(p_function->arg_names.size());
+	for (int i = 0; i < p_function->arg_names.size(); i++) {
+		w.put_string(p_function->arg_names[i]);
+	}
+
+	int body_size_ofs = w.data.size();
+	w.put_u32(0);
+	w.put_u32(p_function->code.size());
+	int body_ofs = w.data.size();
+
+	// Globals are referred to by name in the file, named globals (autoloads in
+	// the editor) are regular globals once the project runs.
+	Vector<int> code = p_function->code;
+	Vector<int> relocations;
+	Vector<int> addresses;
+
+	int ip = 0;
+	while (ip < code.size()) {
+
+		int len = _get_instruction_addresses(code, ip, addresses);
+		if (len == 0 || ip + len > code.size()) {
+			w.error = ERR_UNAVAILABLE;
+			return;
+		}
+
+		for (int i = 0; i < addresses.size(); i++) {
+
+			int address = code[addresses[i]];
+			int type = (address & GDScriptFunction::ADDR_TYPE_MASK) >> GDScriptFunction::ADDR_BITS;
+			int idx = address & GDScriptFunction::ADDR_MASK;
+
+			StringName global;
+			if (type == GDScriptFunction::ADDR_TYPE_GLOBAL && idx < w.global_names.size()) {
+				global = w.global_names[idx];
+			} else if (type == GDScriptFunction::ADDR_TYPE_NAMED_GLOBAL && idx < p_function->named_globals.size()) {
+				global = p_function->named_globals[idx];
+			} else if (type == GDScriptFunction::ADDR_TYPE_GLOBAL || type == GDScriptFunction::ADDR_TYPE_NAMED_GLOBAL) {
+				w.error = ERR_UNAVAILABLE;
+				return;
+			} else {
+				continue;
+			}
+
+			code.write[addresses[i]] = (GDScriptFunction::ADDR_TYPE_GLOBAL << GDScriptFunction::ADDR_BITS) | w.add_global(global);
+			relocations.push_back(addresses[i]);
+		}
+
+		ip += len;
+	}
+
+	w.put_u32(code.size());
+	for (int i = 0; i < code.size(); i++) {
+		w.put_u32(code[i]);
+	}
+
+	w.put_u32(relocations.size());
+	for (int i = 0; i < relocations.size(); i++) {
+		w.put_u32(relocations[i]);
+	}
+
+	w.put_u32(p_function->constants.size());
+	for (int i = 0; i < p_function->constants.size(); i++) {
+		_write_value(w, p_function->constants[i]);
+	}
+
+	w.put_u32(p_function->global_names.size());
+	for (int i = 0; i < p_function->global_names.size(); i++) {
+		w.put_string(p_function->global_names[i]);
+	}
+
+	w.put_u32(p_function->methods.size());
+	for (int i = 0; i < p_function->methods.size(); i++) {
+		w.put_u32(w.add_method(p_function->methods[i].method));
+	}
+
+	w.put_u32(p_function->stack_debug.size());
+	for (const List<GDScriptFunction::StackDebug>::Element *E = p_function->stack_debug.front(); E; E = E->next()) {
+		w.put_u32(E->get().line);
+		w.put_u32(E->get().pos);
+		w.put_u32(E->get().added);
+		w.put_string(E->get().identifier);
+	}
+
+	encode_uint32(w.data.size() - body_ofs, &w.data.write[body_size_ofs]);
+}
+
+void GDScriptBytecode::_write_class(GDScriptBytecodeWriter &w, const GDScript *p_script) {
+
+	w.put_string(p_script->name);
+	w.put_u32(p_script->tool);
+
+	w.put_u32(p_script->subclasses.size());
+	for (const Map<StringName, Ref<GDScript> >::Element *E = p_script->subclasses.front(); E; E = E->next()) {
+
+		w.put_string(E->key());
+		int size_ofs = w.data.size();
+		w.put_u32(0);
+		_write_class(w, E->get().ptr());
+		encode_uint32(w.data.size() - size_ofs - 4, &w.data.write[size_ofs]);
+	}
+
+	if (p_script->base.is_valid()) {
+		int idx = _write_object(w, p_script->base.ptr());
+		if (idx < 0) {
+			w.error = ERR_UNAVAILABLE;
+		}
+		w.put_u32(BASE_SCRIPT);
+		w.put_u32(idx);
+	} else if (p_script->native.is_valid()) {
+		w.put_u32(BASE_NATIVE);
+		w.put_string(p_script->native->get_name());
+	} else {
+		w.error = ERR_UNAVAILABLE;
+	}
+
+	// Inherited members are taken from the base when loading.
+	w.put_u32(p_script->members.size());
+	for (const Set<StringName>::Element *E = p_script->members.front(); E; E = E->next()) {
+
+		const GDScript::MemberInfo &minfo = p_script->member_indices[E->get()];
+		const PropertyInfo &pinfo = p_script->member_info[E->get()];
+
+		w.put_string(E->get());
+		w.put_u32(minfo.index);
+		w.put_string(minfo.setter);
+		w.put_string(minfo.getter);
+		w.put_u32(minfo.rpc_mode);
+		_write_datatype(w, minfo.data_type);
+
+		w.put_u32(pinfo.type);
+		w.put_string(pinfo.class_name);
+		w.put_u32(pinfo.hint);
+		w.put_string(pinfo.hint_string);
+		w.put_u32(pinfo.usage);
+	}
+
+	w.put_u32(p_script->constants.size());
+	for (const Map<StringName, Variant>::Element *E = p_script->constants.front(); E; E = E->next()) {
+		w.put_string(E->key());
+		_write_value(w, E->get());
+	}
+
+	w.put_u32(p_script->_signals.size());
+	for (const Map<StringName, Vector<StringName> >::Element *E = p_script->_signals.front(); E; E = E->next()) {
+		w.put_string(E->key());
+		w.put_u32(E->get().size());
+		for (int i = 0; i < E->get().size(); i++) {
+			w.put_string(E->get()[i]);
+		}
+	}
+
+	w.put_u32(p_script->member_functions.size());
+	for (const Map<StringName, GDScriptFunction *>::Element *E = p_script->member_functions.front(); E; E = E->next()) {
+		_write_function(w, E->get());
+	}
+}
+
+Error GDScriptBytecode::save(const Ref<GDScript> &p_script, const Vector<uint8_t> &p_tokens, Vector<uint8_t> &r_buffer) {
+
+	ERR_FAIL_COND_V(p_script.is_null(), ERR_INVALID_PARAMETER);
+
+	if (!p_script->is_valid()) {
+		return ERR_UNAVAILABLE;
+	}
+
+	GDScriptBytecodeWriter w;
+	w.root = p_script.ptr();
+
+	const Map<StringName, int> &global_map = GDScriptLanguage::get_singleton()->get_global_map();
+	w.global_names.resize(GDScriptLanguage::get_singleton()->get_global_array_size());
+	for (const Map<StringName, int>::Element *E = global_map.front(); E; E = E->next()) {
+		if (E->get() < w.global_names.size()) {
+			w.global_names.write[E->get()] = E->key();
+		}
+	}
+
+	_write_class(w, p_script.ptr());
+	if (w.error) {
+		return w.error;
+	}
+
+	Vector<uint8_t> classes = w.data;
+	w.data.clear();
+
+	w.put_bytes((const uint8_t *)"GDCC", 4);
+	w.put_u32(COMPILED_VERSION);
+	w.put_u32(p_tokens.size());
+	w.put_bytes(p_tokens.ptr(), p_tokens.size());
+
+	CharString stamp = _get_engine_stamp().utf8();
+	w.put_u32(stamp.length());
+	w.put_bytes((const uint8_t *)stamp.get_data(), stamp.length());
+
+	// Tables first, the classes refer to them by index.
+	int string_count = w.strings.size();
+	w.put_u32(string_count);
+	for (int i = 0; i < string_count; i++) {
+		CharString cs = w.strings[i].utf8();
+		w.put_u32(cs.length());
+		w.put_bytes((const uint8_t *)cs.get_data(), cs.length());
+	}
+
+	w.put_u32(w.globals.size());
+	for (int i = 0; i < w.globals.size(); i++) {
+		w.put_u32(w.globals[i]);
+	}
+
+	w.put_u32(w.methods.size());
+	for (int i = 0; i < w.methods.size(); i++) {
+		w.put_u32(w.methods[i].first);
+		w.put_u32(w.methods[i].second);
+	}
+
+	w.put_u32(w.objects.size());
+	for (int i = 0; i < w.objects.size(); i++) {
+		for (int j = 0; j < w.objects[i].size(); j++) {
+			w.put_u32(w.objects[i][j]);
+		}
+	}
+
+	ERR_FAIL_COND_V(w.strings.size() != string_count, ERR_BUG);
+
+	w.data.append_array(classes);
+	r_buffer = w.data;
+
+	return OK;
+}
+
+#endif // TOOLS_ENABLED
@@ -0,0 +1,95 @@
+/*************************************************************************/
+/*  gdscript_bytecode.h                                                  */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2019 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2019 Godot Engine contributors (cf. AUTHORS.md)    */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#ifndef GDSCRIPT_BYTECODE_H
+#define GDSCRIPT_BYTECODE_H
+
+#include "core/map.h"
+#include "core/os/mutex.h"
+#include "core/reference.h"
+#include "core/set.h"
+#include "gdscript_function.h"
+
+class GDScript;
+struct GDScriptBytecodeReader;
+struct GDScriptBytecodeWriter;
+
+// Shared, read-only image of a precompiled script file. Every class of the
+// file keeps a reference to it, and function bodies are decoded straight out
+// of the buffer the first time they run.
+class GDScriptBytecodeData : public Reference {
+
+	friend class GDScriptBytecode;
+
+	Vector<uint8_t> buffer;
+	Vector<StringName> strings;
+	Vector<int> globals;
+	Vector<GDScriptFunction::NativeMethod> methods;
+	Vector<Variant> objects;
+	Vector<ObjectID> self_objects; // classes of the file itself, not referenced to avoid cycles
+	Mutex *lock;
+
+	Variant _get_object(int p_idx) const;
+
+public:
+	bool load_function(GDScriptFunction *p_function);
+
+	GDScriptBytecodeData();
+	~GDScriptBytecodeData();
+};
+
+class GDScriptBytecode {
+
+	friend class GDScriptBytecodeData;
+
+	static bool _read_value(GDScriptBytecodeReader &r, const GDScriptBytecodeData *p_data, Variant &r_value);
+	static void _read_datatype(GDScriptBytecodeReader &r, const GDScriptBytecodeData *p_data, GDScriptDataType &r_type);
+	static Error _make_scripts(GDScriptBytecodeReader &r, GDScript *p_script, Map<GDScript *, int> &r_offsets);
+	static Error _load_class(const GDScriptBytecodeData *p_data, GDScript *p_script, GDScript *p_root, Map<GDScript *, int> &p_offsets, Set<GDScript *> &r_loading);
+
+#ifdef TOOLS_ENABLED
+	static int _write_object(GDScriptBytecodeWriter &w, const Object *p_object);
+	static void _write_value(GDScriptBytecodeWriter &w, const Variant &p_value);
+	static void _write_datatype(GDScriptBytecodeWriter &w, const GDScriptDataType &p_type);
+	static void _write_function(GDScriptBytecodeWriter &w, const GDScriptFunction *p_function);
+	static void _write_class(GDScriptBytecodeWriter &w, const GDScript *p_script);
+#endif
+
+public:
+	static bool is_compiled_buffer(const Vector<uint8_t> &p_buffer);
+	static Vector<uint8_t> get_token_buffer(const Vector<uint8_t> &p_buffer);
+
+	static Error load(GDScript *p_script, const Vector<uint8_t> &p_buffer);
+#ifdef TOOLS_ENABLED
+	static Error save(const Ref<GDScript> &p_script, const Vector<uint8_t> &p_tokens, Vector<uint8_t> &r_buffer);
+#endif
+};
+
+#endif // GDSCRIPT_BYTECODE_H
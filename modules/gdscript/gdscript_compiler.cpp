@@ -74,6 +74,80 @@ void GDScriptCompiler::_set_error(const String &p_error, const GDScriptParser::N
 	}
 }
 
+static _FORCE_INLINE_ bool _is_builtin_type(const GDScriptParser::DataType &p_type, Variant::Type p_builtin) {
+
+	return p_type.has_type && !p_type.is_meta_type && p_type.kind == GDScriptParser::DataType::BUILTIN && p_type.builtin_type == p_builtin;
+}
+
+GDScriptFunction::Opcode GDScriptCompiler::_get_operator_opcode(Variant::Operator p_op, const GDScriptParser::DataType &p_a, const GDScriptParser::DataType &p_b) const {
+
+	// Only picks which fast path the interpreter tries first, the typed
+	// opcodes check the actual operand types before taking it.
+	bool a_int = _is_builtin_type(p_a, Variant::INT);
+	bool b_int = _is_builtin_type(p_b, Variant::INT);
+	bool a_real = _is_builtin_type(p_a, Variant::REAL);
+	bool b_real = _is_builtin_type(p_b, Variant::REAL);
+
+	switch (p_op) {
+		case Variant::OP_EQUAL:
+		case Variant::OP_NOT_EQUAL:
+		case Variant::OP_LESS:
+		case Variant::OP_LESS_EQUAL:
+		case Variant::OP_GREATER:
+		case Variant::OP_GREATER_EQUAL:
+		case Variant::OP_ADD:
+		case Variant::OP_SUBTRACT:
+		case Variant::OP_MULTIPLY:
+		case Variant::OP_DIVIDE:
+		case Variant::OP_NEGATE: {
+
+			if (a_int && b_int)
+				return GDScriptFunction::OPCODE_OPERATOR_INT;
+			if ((a_int || a_real) && (b_int || b_real))
+				return GDScriptFunction::OPCODE_OPERATOR_REAL;
+			if (p_op == Variant::OP_LESS || p_op == Variant::OP_LESS_EQUAL || p_op == Variant::OP_GREATER || p_op == Variant::OP_GREATER_EQUAL)
+				break;
+			if (_is_builtin_type(p_a, Variant::VECTOR2) || _is_builtin_type(p_b, Variant::VECTOR2))
+				return GDScriptFunction::OPCODE_OPERATOR_VECTOR2;
+			if (_is_builtin_type(p_a, Variant::VECTOR3) || _is_builtin_type(p_b, Variant::VECTOR3))
+				return GDScriptFunction::OPCODE_OPERATOR_VECTOR3;
+		} break;
+		case Variant::OP_MODULE:
+		case Variant::OP_BIT_AND:
+		case Variant::OP_BIT_OR:
+		case Variant::OP_BIT_XOR: {
+
+			if (a_int && b_int)
+				return GDScriptFunction::OPCODE_OPERATOR_INT;
+		} break;
+		default: {
+		}
+	}
+
+	return GDScriptFunction::OPCODE_OPERATOR;
+}
+
+bool GDScriptCompiler::_is_vector_member(const GDScriptParser::DataType &p_base, const StringName &p_name) const {
+
+	if (p_name == "x" || p_name == "y")
+		return _is_builtin_type(p_base, Variant::VECTOR2) || _is_builtin_type(p_base, Variant::VECTOR3);
+	if (p_name == "z")
+		return _is_builtin_type(p_base, Variant::VECTOR3);
+	return false;
+}
+
+MethodBind *GDScriptCompiler::_get_native_method(const GDScriptParser::DataType &p_base, const StringName &p_name) const {
+
+	// Only instances typed as a native class, scripted bases can define methods of their own.
+	if (!p_base.has_type || p_base.is_meta_type || p_base.kind != GDScriptParser::DataType::NATIVE)
+		return NULL;
+
+	MethodBind *method = ClassDB::get_method(p_base.native_type, p_name);
+	if (!method || method->is_vararg())
+		return NULL;
+	return method;
+}
+
 bool GDScriptCompiler::_create_unary_operator(CodeGen &codegen, const GDScriptParser::OperatorNode *on, Variant::Operator op, int p_stack_level) {
 
 	ERR_FAIL_COND_V(on->arguments.size() != 1, false);
@@ -82,7 +156,8 @@ bool GDScriptCompiler::_create_unary_operator(CodeGen &codegen, const GDScriptPa
 	if (src_address_a < 0)
 		return false;
 
-	codegen.opcodes.push_back(GDScriptFunction::OPCODE_OPERATOR); // perform operator
+	const GDScriptParser::DataType &type_a = on->arguments[0]->get_datatype();
+	codegen.opcodes.push_back(_get_operator_opcode(op, type_a, type_a)); // perform operator
 	codegen.opcodes.push_back(op); //which operator
 	codegen.opcodes.push_back(src_address_a); // argument 1
 	codegen.opcodes.push_back(src_address_a); // argument 2 (repeated)
@@ -104,7 +179,7 @@ bool GDScriptCompiler::_create_binary_operator(CodeGen &codegen, const GDScriptP
 	if (src_address_b < 0)
 		return false;
 
-	codegen.opcodes.push_back(GDScriptFunction::OPCODE_OPERATOR); // perform operator
+	codegen.opcodes.push_back(_get_operator_opcode(op, on->arguments[0]->get_datatype(), on->arguments[1]->get_datatype())); // perform operator
 	codegen.opcodes.push_back(op); //which operator
 	codegen.opcodes.push_back(src_address_a); // argument 1
 	codegen.opcodes.push_back(src_address_b); // argument 2 (unary only takes one parameter)
@@ -123,6 +198,12 @@ GDScriptDataType GDScriptCompiler::_gdtype_from_datatype(const GDScriptParser::D
 		case GDScriptParser::DataType::BUILTIN: {
 			result.kind = GDScriptDataType::BUILTIN;
 			result.builtin_type = p_datatype.builtin_type;
+			result.element_type = p_datatype.element_type;
+			if (p_datatype.element_native_type != StringName()) {
+				// Arrays check elements against the ClassDB name
+				StringName name = p_datatype.element_native_type;
+				result.element_native_type = ClassDB::class_exists(name) ? name : StringName("_" + String(name));
+			}
 		} break;
 		case GDScriptParser::DataType::NATIVE: {
 			result.kind = GDScriptDataType::NATIVE;
@@ -656,11 +737,20 @@ int GDScriptCompiler::_parse_expression(CodeGen &codegen, const GDScriptParser::
 							arguments.push_back(ret);
 						}
 
-						codegen.opcodes.push_back(p_root ? GDScriptFunction::OPCODE_CALL : GDScriptFunction::OPCODE_CALL_RETURN); // perform operator
+						MethodBind *method = _get_native_method(instance->get_datatype(), static_cast<const GDScriptParser::IdentifierNode *>(on->arguments[1])->name);
+
+						if (method) {
+							codegen.opcodes.push_back(p_root ? GDScriptFunction::OPCODE_CALL_METHOD_BIND : GDScriptFunction::OPCODE_CALL_METHOD_BIND_RETURN);
+						} else {
+							codegen.opcodes.push_back(p_root ? GDScriptFunction::OPCODE_CALL : GDScriptFunction::OPCODE_CALL_RETURN); // perform operator
+						}
 						codegen.opcodes.push_back(on->arguments.size() - 2);
 						codegen.alloc_call(on->arguments.size() - 2);
-						for (int i = 0; i < arguments.size(); i++)
+						for (int i = 0; i < arguments.size(); i++) {
 							codegen.opcodes.push_back(arguments[i]);
+							if (i == 1 && method)
+								codegen.opcodes.push_back(codegen.get_method_pos(method));
+						}
 					}
 				} break;
 				case GDScriptParser::OperatorNode::OP_YIELD: {
@@ -682,6 +772,7 @@ int GDScriptCompiler::_parse_expression(CodeGen &codegen, const GDScriptParser::
 					}
 
 					//push call bytecode
+					codegen.has_yield = true;
 					codegen.opcodes.push_back(arguments.size() == 0 ? GDScriptFunction::OPCODE_YIELD : GDScriptFunction::OPCODE_YIELD_SIGNAL); // basic type constructor
 					for (int i = 0; i < arguments.size(); i++)
 						codegen.opcodes.push_back(arguments[i]); //arguments
@@ -747,7 +838,14 @@ int GDScriptCompiler::_parse_expression(CodeGen &codegen, const GDScriptParser::
 						}
 					}
 
-					codegen.opcodes.push_back(named ? GDScriptFunction::OPCODE_GET_NAMED : GDScriptFunction::OPCODE_GET); // perform operator
+					GDScriptFunction::Opcode get_opcode = named ? GDScriptFunction::OPCODE_GET_NAMED : GDScriptFunction::OPCODE_GET;
+					if (named && on->arguments[1]->type == GDScriptParser::Node::TYPE_IDENTIFIER && _is_vector_member(on->arguments[0]->get_datatype(), static_cast<GDScriptParser::IdentifierNode *>(on->arguments[1])->name)) {
+						get_opcode = GDScriptFunction::OPCODE_GET_NAMED_VECTOR;
+					} else if (!named && _is_builtin_type(on->arguments[0]->get_datatype(), Variant::ARRAY)) {
+						get_opcode = GDScriptFunction::OPCODE_GET_ARRAY;
+					}
+
+					codegen.opcodes.push_back(get_opcode); // perform operator
 					codegen.opcodes.push_back(from); // argument 1
 					codegen.opcodes.push_back(index); // argument 2 (unary only takes one parameter)
 
@@ -1049,7 +1147,9 @@ int GDScriptCompiler::_parse_expression(CodeGen &codegen, const GDScriptParser::
 							if (key_idx < 0) //error
 								return key_idx;
 
-							codegen.opcodes.push_back(named ? GDScriptFunction::OPCODE_GET_NAMED : GDScriptFunction::OPCODE_GET);
+							bool array = !named && _is_builtin_type(E->get()->arguments[0]->get_datatype(), Variant::ARRAY);
+
+							codegen.opcodes.push_back(named ? GDScriptFunction::OPCODE_GET_NAMED : (array ? GDScriptFunction::OPCODE_GET_ARRAY : GDScriptFunction::OPCODE_GET));
 							codegen.opcodes.push_back(prev_pos);
 							codegen.opcodes.push_back(key_idx);
 							slevel++;
@@ -1063,7 +1163,7 @@ int GDScriptCompiler::_parse_expression(CodeGen &codegen, const GDScriptParser::
 							setchain.push_back(dst_pos);
 							setchain.push_back(key_idx);
 							setchain.push_back(prev_pos);
-							setchain.push_back(named ? GDScriptFunction::OPCODE_SET_NAMED : GDScriptFunction::OPCODE_SET);
+							setchain.push_back(named ? GDScriptFunction::OPCODE_SET_NAMED : (array ? GDScriptFunction::OPCODE_SET_ARRAY : GDScriptFunction::OPCODE_SET));
 
 							prev_pos = dst_pos;
 						}
@@ -1095,7 +1195,14 @@ int GDScriptCompiler::_parse_expression(CodeGen &codegen, const GDScriptParser::
 						if (set_value < 0) //error
 							return set_value;
 
-						codegen.opcodes.push_back(named ? GDScriptFunction::OPCODE_SET_NAMED : GDScriptFunction::OPCODE_SET);
+						GDScriptFunction::Opcode set_opcode = named ? GDScriptFunction::OPCODE_SET_NAMED : GDScriptFunction::OPCODE_SET;
+						if (named && _is_vector_member(op->arguments[0]->get_datatype(), static_cast<const GDScriptParser::IdentifierNode *>(op->arguments[1])->name)) {
+							set_opcode = GDScriptFunction::OPCODE_SET_NAMED_VECTOR;
+						} else if (!named && _is_builtin_type(op->arguments[0]->get_datatype(), Variant::ARRAY)) {
+							set_opcode = GDScriptFunction::OPCODE_SET_ARRAY;
+						}
+
+						codegen.opcodes.push_back(set_opcode);
 						codegen.opcodes.push_back(prev_pos);
 						codegen.opcodes.push_back(set_index);
 						codegen.opcodes.push_back(set_value);
@@ -1144,7 +1251,17 @@ int GDScriptCompiler::_parse_expression(CodeGen &codegen, const GDScriptParser::
 
 						GDScriptDataType assign_type = _gdtype_from_datatype(on->arguments[0]->get_datatype());
 
-						if (assign_type.has_type && !on->arguments[1]->get_datatype().has_type) {
+						const GDScriptParser::DataType &src_type = on->arguments[1]->get_datatype();
+						bool same_array = src_type.has_type && src_type.kind == GDScriptParser::DataType::BUILTIN && src_type.element_type == assign_type.element_type && src_type.element_native_type == on->arguments[0]->get_datatype().element_native_type;
+
+						if (assign_type.has_element_type() && !same_array) {
+							// Typed array, only values already typed the same way are assigned as is
+							codegen.opcodes.push_back(GDScriptFunction::OPCODE_ASSIGN_TYPED_ARRAY); // perform operator
+							codegen.opcodes.push_back(assign_type.element_type); // element type
+							codegen.opcodes.push_back(codegen.get_name_map_pos(assign_type.element_native_type)); // element class
+							codegen.opcodes.push_back(dst_address_a); // argument 1
+							codegen.opcodes.push_back(src_address_b); // argument 2
+						} else if (assign_type.has_type && !on->arguments[1]->get_datatype().has_type) {
 							// Typed assignment
 							switch (assign_type.kind) {
 								case GDScriptDataType::BUILTIN: {
@@ -1401,39 +1518,105 @@ Error GDScriptCompiler::_parse_block(CodeGen &codegen, const GDScriptParser::Blo
 						int iterator_pos = (slevel++) | (GDScriptFunction::ADDR_TYPE_STACK << GDScriptFunction::ADDR_BITS);
 						int counter_pos = (slevel++) | (GDScriptFunction::ADDR_TYPE_STACK << GDScriptFunction::ADDR_BITS);
 						int container_pos = (slevel++) | (GDScriptFunction::ADDR_TYPE_STACK << GDScriptFunction::ADDR_BITS);
+
+						// for .. in range() counts on the stack instead of building an array
+						const GDScriptParser::OperatorNode *range_call = NULL;
+						if (cf->arguments[1]->type == GDScriptParser::Node::TYPE_OPERATOR) {
+							const GDScriptParser::OperatorNode *on = static_cast<const GDScriptParser::OperatorNode *>(cf->arguments[1]);
+							if (on->op == GDScriptParser::OperatorNode::OP_CALL && on->arguments.size() >= 2 && on->arguments.size() <= 4 && on->arguments[0]->type == GDScriptParser::Node::TYPE_BUILT_IN_FUNCTION && static_cast<const GDScriptParser::BuiltInFunctionNode *>(on->arguments[0])->function == GDScriptFunctions::GEN_RANGE) {
+								range_call = on;
+							}
+						}
+
+						int step_pos = 0;
+						if (range_call) {
+							step_pos = (slevel++) | (GDScriptFunction::ADDR_TYPE_STACK << GDScriptFunction::ADDR_BITS);
+						}
 						codegen.alloc_stack(slevel);
 
 						codegen.push_stack_identifiers();
 						codegen.add_stack_identifier(static_cast<const GDScriptParser::IdentifierNode *>(cf->arguments[0])->name, iter_stack_pos);
 
-						int ret2 = _parse_expression(codegen, cf->arguments[1], slevel, false);
-						if (ret2 < 0)
-							return ERR_COMPILATION_FAILED;
+						int break_pos;
+						int continue_pos;
 
-						//assign container
-						codegen.opcodes.push_back(GDScriptFunction::OPCODE_ASSIGN);
-						codegen.opcodes.push_back(container_pos);
-						codegen.opcodes.push_back(ret2);
+						if (range_call) {
+
+							Vector<int> arguments;
+							int arg_level = slevel;
+							for (int j = 1; j < range_call->arguments.size(); j++) {
+
+								int ret = _parse_expression(codegen, range_call->arguments[j], arg_level);
+								if (ret < 0)
+									return ERR_COMPILATION_FAILED;
+
+								if ((ret >> GDScriptFunction::ADDR_BITS & GDScriptFunction::ADDR_TYPE_STACK) == GDScriptFunction::ADDR_TYPE_STACK) {
+									arg_level++;
+									codegen.alloc_stack(arg_level);
+								}
+
+								arguments.push_back(ret);
+							}
 
-						//begin loop
-						codegen.opcodes.push_back(GDScriptFunction::OPCODE_ITERATE_BEGIN);
-						codegen.opcodes.push_back(counter_pos);
-						codegen.opcodes.push_back(container_pos);
-						codegen.opcodes.push_back(codegen.opcodes.size() + 4);
-						codegen.opcodes.push_back(iterator_pos);
-						codegen.opcodes.push_back(GDScriptFunction::OPCODE_JUMP); //skip code for next
-						codegen.opcodes.push_back(codegen.opcodes.size() + 8);
-						//break loop
-						int break_pos = codegen.opcodes.size();
-						codegen.opcodes.push_back(GDScriptFunction::OPCODE_JUMP); //skip code for next
-						codegen.opcodes.push_back(0); //skip code for next
-						//next loop
-						int continue_pos = codegen.opcodes.size();
-						codegen.opcodes.push_back(GDScriptFunction::OPCODE_ITERATE);
-						codegen.opcodes.push_back(counter_pos);
-						codegen.opcodes.push_back(container_pos);
-						codegen.opcodes.push_back(break_pos);
-						codegen.opcodes.push_back(iterator_pos);
+							int zero_pos = codegen.get_constant_pos(0) | (GDScriptFunction::ADDR_TYPE_LOCAL_CONSTANT << GDScriptFunction::ADDR_BITS);
+							int one_pos = codegen.get_constant_pos(1) | (GDScriptFunction::ADDR_TYPE_LOCAL_CONSTANT << GDScriptFunction::ADDR_BITS);
+
+							//begin loop
+							codegen.opcodes.push_back(GDScriptFunction::OPCODE_ITERATE_BEGIN_RANGE);
+							codegen.opcodes.push_back(counter_pos);
+							codegen.opcodes.push_back(container_pos); // end of the range
+							codegen.opcodes.push_back(step_pos);
+							codegen.opcodes.push_back(arguments.size() > 1 ? arguments[0] : zero_pos);
+							codegen.opcodes.push_back(arguments.size() > 1 ? arguments[1] : arguments[0]);
+							codegen.opcodes.push_back(arguments.size() > 2 ? arguments[2] : one_pos);
+							codegen.opcodes.push_back(codegen.opcodes.size() + 4);
+							codegen.opcodes.push_back(iterator_pos);
+							codegen.opcodes.push_back(GDScriptFunction::OPCODE_JUMP); //skip code for next
+							codegen.opcodes.push_back(codegen.opcodes.size() + 9);
+							//break loop
+							break_pos = codegen.opcodes.size();
+							codegen.opcodes.push_back(GDScriptFunction::OPCODE_JUMP); //skip code for next
+							codegen.opcodes.push_back(0); //skip code for next
+							//next loop
+							continue_pos = codegen.opcodes.size();
+							codegen.opcodes.push_back(GDScriptFunction::OPCODE_ITERATE_RANGE);
+							codegen.opcodes.push_back(counter_pos);
+							codegen.opcodes.push_back(container_pos);
+							codegen.opcodes.push_back(step_pos);
+							codegen.opcodes.push_back(break_pos);
+							codegen.opcodes.push_back(iterator_pos);
+
+						} else {
+
+							int ret2 = _parse_expression(codegen, cf->arguments[1], slevel, false);
+							if (ret2 < 0)
+								return ERR_COMPILATION_FAILED;
+
+							//assign container
+							codegen.opcodes.push_back(GDScriptFunction::OPCODE_ASSIGN);
+							codegen.opcodes.push_back(container_pos);
+							codegen.opcodes.push_back(ret2);
+
+							//begin loop
+							codegen.opcodes.push_back(GDScriptFunction::OPCODE_ITERATE_BEGIN);
+							codegen.opcodes.push_back(counter_pos);
+							codegen.opcodes.push_back(container_pos);
+							codegen.opcodes.push_back(codegen.opcodes.size() + 4);
+							codegen.opcodes.push_back(iterator_pos);
+							codegen.opcodes.push_back(GDScriptFunction::OPCODE_JUMP); //skip code for next
+							codegen.opcodes.push_back(codegen.opcodes.size() + 8);
+							//break loop
+							break_pos = codegen.opcodes.size();
+							codegen.opcodes.push_back(GDScriptFunction::OPCODE_JUMP); //skip code for next
+							codegen.opcodes.push_back(0); //skip code for next
+							//next loop
+							continue_pos = codegen.opcodes.size();
+							codegen.opcodes.push_back(GDScriptFunction::OPCODE_ITERATE);
+							codegen.opcodes.push_back(counter_pos);
+							codegen.opcodes.push_back(container_pos);
+							codegen.opcodes.push_back(break_pos);
+							codegen.opcodes.push_back(iterator_pos);
+						}
 
 						Error err = _parse_block(codegen, cf->body, slevel, break_pos, continue_pos);
 						if (err)
@@ -1573,6 +1756,7 @@ Error GDScriptCompiler::_parse_function(GDScript *p_script, const GDScriptParser
 	codegen.stack_max = 0;
 	codegen.current_line = 0;
 	codegen.call_max = 0;
+	codegen.has_yield = false;
 	codegen.debug_stack = ScriptDebugger::get_singleton() != NULL;
 	Vector<StringName> argnames;
 
@@ -1720,6 +1904,25 @@ Error GDScriptCompiler::_parse_function(GDScript *p_script, const GDScriptParser
 		gdfunc->_global_names_count = 0;
 	}
 
+	//native methods
+	if (codegen.method_map.size()) {
+
+		gdfunc->methods.resize(codegen.method_map.size());
+		for (Map<MethodBind *, int>::Element *E = codegen.method_map.front(); E; E = E->next()) {
+
+			GDScriptFunction::NativeMethod native;
+			native.method = E->key();
+			native.class_ptr = ClassDB::get_class_ptr(E->key()->get_instance_class());
+			gdfunc->methods.write[E->get()] = native;
+		}
+		gdfunc->_methods_ptr = gdfunc->methods.ptr();
+		gdfunc->_methods_count = gdfunc->methods.size();
+
+	} else {
+		gdfunc->_methods_ptr = NULL;
+		gdfunc->_methods_count = 0;
+	}
+
 #ifdef TOOLS_ENABLED
 	// Named globals
 	if (codegen.named_globals.size()) {
@@ -1757,6 +1960,7 @@ Error GDScriptCompiler::_parse_function(GDScript *p_script, const GDScriptParser
 	gdfunc->_argument_count = p_func ? p_func->arguments.size() : 0;
 	gdfunc->_stack_size = codegen.stack_max;
 	gdfunc->_call_size = codegen.call_max;
+	gdfunc->_has_yield = codegen.has_yield;
 	gdfunc->name = func_name;
 #ifdef DEBUG_ENABLED
 	if (ScriptDebugger::get_singleton()) {
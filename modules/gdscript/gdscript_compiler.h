@@ -113,6 +113,16 @@ class GDScriptCompiler {
 			return ret;
 		}
 
+		Map<MethodBind *, int> method_map;
+
+		int get_method_pos(MethodBind *p_method) {
+			if (method_map.has(p_method))
+				return method_map[p_method];
+			int pos = method_map.size();
+			method_map[p_method] = pos;
+			return pos;
+		}
+
 		int get_constant_pos(const Variant &p_constant) {
 			if (constant_map.has(p_constant))
 				return constant_map[p_constant];
@@ -132,6 +142,7 @@ class GDScriptCompiler {
 		int current_line;
 		int stack_max;
 		int call_max;
+		bool has_yield;
 	};
 
 	bool _is_class_member_property(CodeGen &codegen, const StringName &p_name);
@@ -139,6 +150,9 @@ class GDScriptCompiler {
 
 	void _set_error(const String &p_error, const GDScriptParser::Node *p_node);
 
+	GDScriptFunction::Opcode _get_operator_opcode(Variant::Operator p_op, const GDScriptParser::DataType &p_a, const GDScriptParser::DataType &p_b) const;
+	bool _is_vector_member(const GDScriptParser::DataType &p_base, const StringName &p_name) const;
+	MethodBind *_get_native_method(const GDScriptParser::DataType &p_base, const StringName &p_name) const;
 	bool _create_unary_operator(CodeGen &codegen, const GDScriptParser::OperatorNode *on, Variant::Operator op, int p_stack_level);
 	bool _create_binary_operator(CodeGen &codegen, const GDScriptParser::OperatorNode *on, Variant::Operator op, int p_stack_level, bool p_initializer = false);
 
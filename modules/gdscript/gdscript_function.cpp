@@ -30,7 +30,10 @@
 
 #include "gdscript_function.h"
 
+#include "core/core_string_names.h"
+#include "core/method_bind.h"
 #include "core/os/os.h"
+#include "core/variant_internal.h"
 #include "gdscript.h"
 #include "gdscript_functions.h"
 
@@ -183,15 +186,54 @@ static String _get_var_type(const Variant *p_type) {
 }
 #endif
 
+static _FORCE_INLINE_ int _get_vector_axis(const StringName &p_name) {
+
+	const CoreStringNames *names = CoreStringNames::get_singleton();
+	if (p_name == names->x)
+		return 0;
+	if (p_name == names->y)
+		return 1;
+	if (p_name == names->z)
+		return 2;
+	return 3;
+}
+
+#ifdef GDSCRIPT_PROFILE_OPCODES
+// Charges the time since the previous dispatch to the opcode that just ran,
+// minus what nested script calls spent, then starts timing the next one.
+#define OPCODE_PROFILE_NEXT                                                                      \
+	if (profile_opcodes) {                                                                      \
+		uint64_t now = OS::get_singleton()->get_ticks_usec();                                   \
+		uint64_t nested = GDScriptLanguage::get_singleton()->opcode_nested_time;                \
+		if (profile_opcode >= 0) {                                                              \
+			uint64_t total = now - profile_opcode_start;                                        \
+			GDScriptLanguage::get_singleton()->_profile_opcode(profile_opcode, total, total - (nested - profile_opcode_nested)); \
+		}                                                                                       \
+		profile_opcode = _code_ptr[ip];                                                         \
+		profile_opcode_start = now;                                                             \
+		profile_opcode_nested = nested;                                                         \
+	}
+#else
+#define OPCODE_PROFILE_NEXT
+#endif
+
 #if defined(__GNUC__)
 #define OPCODES_TABLE                         \
 	static const void *switch_table_ops[] = { \
+		&&OPCODE_OPERATOR_INT,                \
+		&&OPCODE_OPERATOR_REAL,               \
+		&&OPCODE_OPERATOR_VECTOR2,            \
+		&&OPCODE_OPERATOR_VECTOR3,            \
 		&&OPCODE_OPERATOR,                    \
 		&&OPCODE_EXTENDS_TEST,                \
 		&&OPCODE_IS_BUILTIN,                  \
 		&&OPCODE_SET,                         \
 		&&OPCODE_GET,                         \
+		&&OPCODE_SET_ARRAY,                   \
+		&&OPCODE_GET_ARRAY,                   \
+		&&OPCODE_SET_NAMED_VECTOR,            \
 		&&OPCODE_SET_NAMED,                   \
+		&&OPCODE_GET_NAMED_VECTOR,            \
 		&&OPCODE_GET_NAMED,                   \
 		&&OPCODE_SET_MEMBER,                  \
 		&&OPCODE_GET_MEMBER,                  \
@@ -201,6 +243,7 @@ static String _get_var_type(const Variant *p_type) {
 		&&OPCODE_ASSIGN_TYPED_BUILTIN,        \
 		&&OPCODE_ASSIGN_TYPED_NATIVE,         \
 		&&OPCODE_ASSIGN_TYPED_SCRIPT,         \
+		&&OPCODE_ASSIGN_TYPED_ARRAY,          \
 		&&OPCODE_CAST_TO_BUILTIN,             \
 		&&OPCODE_CAST_TO_NATIVE,              \
 		&&OPCODE_CAST_TO_SCRIPT,              \
@@ -209,6 +252,8 @@ static String _get_var_type(const Variant *p_type) {
 		&&OPCODE_CONSTRUCT_DICTIONARY,        \
 		&&OPCODE_CALL,                        \
 		&&OPCODE_CALL_RETURN,                 \
+		&&OPCODE_CALL_METHOD_BIND,            \
+		&&OPCODE_CALL_METHOD_BIND_RETURN,     \
 		&&OPCODE_CALL_BUILT_IN,               \
 		&&OPCODE_CALL_SELF,                   \
 		&&OPCODE_CALL_SELF_BASE,              \
@@ -222,6 +267,8 @@ static String _get_var_type(const Variant *p_type) {
 		&&OPCODE_RETURN,                      \
 		&&OPCODE_ITERATE_BEGIN,               \
 		&&OPCODE_ITERATE,                     \
+		&&OPCODE_ITERATE_BEGIN_RANGE,         \
+		&&OPCODE_ITERATE_RANGE,               \
 		&&OPCODE_ASSERT,                      \
 		&&OPCODE_BREAKPOINT,                  \
 		&&OPCODE_LINE,                        \
@@ -235,7 +282,11 @@ static String _get_var_type(const Variant *p_type) {
 	OPSEXIT:
 #define OPCODES_OUT \
 	OPSOUT:
-#define DISPATCH_OPCODE goto *switch_table_ops[_code_ptr[ip]]
+#define DISPATCH_OPCODE                             \
+	{                                               \
+		OPCODE_PROFILE_NEXT;                        \
+		goto *switch_table_ops[_code_ptr[ip]];      \
+	}
 #define OPCODE_SWITCH(m_test) DISPATCH_OPCODE;
 #define OPCODE_BREAK goto OPSEXIT
 #define OPCODE_OUT goto OPSOUT
@@ -246,7 +297,9 @@ static String _get_var_type(const Variant *p_type) {
 #define OPCODES_END
 #define OPCODES_OUT
 #define DISPATCH_OPCODE continue
-#define OPCODE_SWITCH(m_test) switch (m_test)
+#define OPCODE_SWITCH(m_test) \
+	OPCODE_PROFILE_NEXT;      \
+	switch (m_test)
 #define OPCODE_BREAK break
 #define OPCODE_OUT break
 #endif
@@ -255,9 +308,22 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 
 	OPCODES_TABLE;
 
-	if (!_code_ptr) {
+#ifdef DEBUG_ENABLED
+	MemoryTagScope tag_scope(MEMORY_TAG_SCRIPT);
+#endif
 
-		return Variant();
+	if (unlikely(lazy_data || !_code_ptr)) {
+
+		if (!_load_lazy_data()) {
+
+			r_err.error = Variant::CallError::CALL_ERROR_INVALID_METHOD;
+			return Variant();
+		}
+
+		if (!_code_ptr) {
+
+			return Variant();
+		}
 	}
 
 	r_err.error = Variant::CallError::CALL_OK;
@@ -275,17 +341,20 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 #endif
 
 	uint32_t alloca_size = 0;
+	uint8_t *heap_frame = NULL;
 	GDScript *script;
 	int ip = 0;
 	int line = _initial_line;
 
 	if (p_state) {
-		//use existing (supplied) state (yielded)
-		stack = (Variant *)p_state->stack.ptr();
-		call_args = (Variant **)&p_state->stack.ptr()[sizeof(Variant) * p_state->stack_size]; //ptr() to avoid bounds check
+		//use existing (supplied) state (yielded), the frame now belongs to this call
+		heap_frame = p_state->stack;
+		p_state->stack = NULL;
+		stack = (Variant *)heap_frame;
+		call_args = (Variant **)&heap_frame[sizeof(Variant) * p_state->stack_size];
 		line = p_state->line;
 		ip = p_state->ip;
-		alloca_size = p_state->stack.size();
+		alloca_size = p_state->alloca_size;
 		script = p_state->script.ptr();
 		p_instance = p_state->instance;
 		defarg = p_state->defarg;
@@ -317,7 +386,13 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 
 		if (alloca_size) {
 
-			uint8_t *aptr = (uint8_t *)alloca(alloca_size);
+			uint8_t *aptr;
+			if (_has_yield) {
+				heap_frame = _alloc_frame(alloca_size);
+				aptr = heap_frame;
+			} else {
+				aptr = (uint8_t *)alloca(alloca_size);
+			}
 
 			if (_stack_size) {
 
@@ -336,10 +411,25 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 							r_err.error = Variant::CallError::CALL_ERROR_INVALID_ARGUMENT;
 							r_err.argument = i;
 							r_err.expected = argument_types[i].kind == GDScriptDataType::BUILTIN ? argument_types[i].builtin_type : Variant::OBJECT;
+							if (heap_frame) {
+								_free_frame(heap_frame);
+							}
 							return Variant();
 						}
 					}
-					if (argument_types[i].kind == GDScriptDataType::BUILTIN) {
+					if (argument_types[i].has_element_type()) {
+						Variant arg;
+						if (!argument_types[i].make_typed_array(*p_args[i], arg)) {
+							r_err.error = Variant::CallError::CALL_ERROR_INVALID_ARGUMENT;
+							r_err.argument = i;
+							r_err.expected = Variant::ARRAY;
+							if (heap_frame) {
+								_free_frame(heap_frame);
+							}
+							return Variant();
+						}
+						memnew_placement(&stack[i], Variant(arg));
+					} else if (argument_types[i].kind == GDScriptDataType::BUILTIN) {
 						Variant arg = Variant::construct(argument_types[i].builtin_type, &p_args[i], 1, r_err);
 						memnew_placement(&stack[i], Variant(arg));
 					} else {
@@ -427,6 +517,14 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 	bool exit_ok = false;
 #endif
 
+#ifdef GDSCRIPT_PROFILE_OPCODES
+	bool profile_opcodes = GDScriptLanguage::get_singleton()->profiling;
+	int profile_opcode = -1;
+	uint64_t profile_opcode_start = 0;
+	uint64_t profile_opcode_nested = 0;
+	uint64_t profile_call_start = profile_opcodes ? OS::get_singleton()->get_ticks_usec() : 0;
+#endif
+
 #ifdef DEBUG_ENABLED
 	OPCODE_WHILE(ip < _code_size) {
 		int last_opcode = _code_ptr[ip];
@@ -436,6 +534,195 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 
 		OPCODE_SWITCH(_code_ptr[ip]) {
 
+			// Typed operators are emitted when the parser knows the operand
+			// types. They still check them, and anything they don't handle falls
+			// through to the next handler, down to the generic OPCODE_OPERATOR.
+
+			OPCODE(OPCODE_OPERATOR_INT) {
+
+				CHECK_SPACE(5);
+
+				GET_VARIANT_PTR(a, 2);
+				GET_VARIANT_PTR(b, 3);
+
+				if (likely(a->get_type() == Variant::INT && b->get_type() == Variant::INT)) {
+
+					GET_VARIANT_PTR(dst, 4);
+					int64_t va = VariantInternal::get_int(a);
+					int64_t vb = VariantInternal::get_int(b);
+					bool handled = true;
+
+					switch ((Variant::Operator)_code_ptr[ip + 1]) {
+						case Variant::OP_ADD: VariantInternal::set_int(dst, va + vb); break;
+						case Variant::OP_SUBTRACT: VariantInternal::set_int(dst, va - vb); break;
+						case Variant::OP_MULTIPLY: VariantInternal::set_int(dst, va * vb); break;
+						case Variant::OP_DIVIDE: {
+							handled = vb != 0; // division by zero is reported by the generic path
+							if (handled)
+								VariantInternal::set_int(dst, va / vb);
+						} break;
+						case Variant::OP_MODULE: {
+							handled = vb != 0;
+							if (handled)
+								VariantInternal::set_int(dst, va % vb);
+						} break;
+						case Variant::OP_NEGATE: VariantInternal::set_int(dst, -va); break;
+						case Variant::OP_BIT_AND: VariantInternal::set_int(dst, va & vb); break;
+						case Variant::OP_BIT_OR: VariantInternal::set_int(dst, va | vb); break;
+						case Variant::OP_BIT_XOR: VariantInternal::set_int(dst, va ^ vb); break;
+						case Variant::OP_EQUAL: VariantInternal::set_bool(dst, va == vb); break;
+						case Variant::OP_NOT_EQUAL: VariantInternal::set_bool(dst, va != vb); break;
+						case Variant::OP_LESS: VariantInternal::set_bool(dst, va < vb); break;
+						case Variant::OP_LESS_EQUAL: VariantInternal::set_bool(dst, va <= vb); break;
+						case Variant::OP_GREATER: VariantInternal::set_bool(dst, va > vb); break;
+						case Variant::OP_GREATER_EQUAL: VariantInternal::set_bool(dst, va >= vb); break;
+						default: handled = false;
+					}
+
+					if (handled) {
+						ip += 5;
+						DISPATCH_OPCODE;
+					}
+				}
+			}
+
+			OPCODE(OPCODE_OPERATOR_REAL) {
+
+				CHECK_SPACE(5);
+
+				GET_VARIANT_PTR(a, 2);
+				GET_VARIANT_PTR(b, 3);
+
+				// int with int keeps integer semantics, leave it to the generic path
+				if (likely(VariantInternal::is_number(a) && VariantInternal::is_number(b) && (a->get_type() == Variant::REAL || b->get_type() == Variant::REAL))) {
+
+					GET_VARIANT_PTR(dst, 4);
+					double va = VariantInternal::get_number(a);
+					double vb = VariantInternal::get_number(b);
+					bool handled = true;
+
+					switch ((Variant::Operator)_code_ptr[ip + 1]) {
+						case Variant::OP_ADD: VariantInternal::set_real(dst, va + vb); break;
+						case Variant::OP_SUBTRACT: VariantInternal::set_real(dst, va - vb); break;
+						case Variant::OP_MULTIPLY: VariantInternal::set_real(dst, va * vb); break;
+						case Variant::OP_DIVIDE: {
+							handled = vb != 0;
+							if (handled)
+								VariantInternal::set_real(dst, va / vb);
+						} break;
+						case Variant::OP_NEGATE: VariantInternal::set_real(dst, -va); break;
+						case Variant::OP_EQUAL: VariantInternal::set_bool(dst, va == vb); break;
+						case Variant::OP_NOT_EQUAL: VariantInternal::set_bool(dst, va != vb); break;
+						case Variant::OP_LESS: VariantInternal::set_bool(dst, va < vb); break;
+						case Variant::OP_LESS_EQUAL: VariantInternal::set_bool(dst, va <= vb); break;
+						case Variant::OP_GREATER: VariantInternal::set_bool(dst, va > vb); break;
+						case Variant::OP_GREATER_EQUAL: VariantInternal::set_bool(dst, va >= vb); break;
+						default: handled = false;
+					}
+
+					if (handled) {
+						ip += 5;
+						DISPATCH_OPCODE;
+					}
+				}
+			}
+
+			OPCODE(OPCODE_OPERATOR_VECTOR2) {
+
+				CHECK_SPACE(5);
+
+				GET_VARIANT_PTR(a, 2);
+				GET_VARIANT_PTR(b, 3);
+				GET_VARIANT_PTR(dst, 4);
+				Variant::Operator op = (Variant::Operator)_code_ptr[ip + 1];
+				bool handled = false;
+
+				if (a->get_type() == Variant::VECTOR2 && b->get_type() == Variant::VECTOR2) {
+
+					const Vector2 &va = VariantInternal::get_vector2(a);
+					const Vector2 &vb = VariantInternal::get_vector2(b);
+					handled = true;
+
+					switch (op) {
+						case Variant::OP_ADD: VariantInternal::set_vector2(dst, va + vb); break;
+						case Variant::OP_SUBTRACT: VariantInternal::set_vector2(dst, va - vb); break;
+						case Variant::OP_MULTIPLY: VariantInternal::set_vector2(dst, va * vb); break;
+						case Variant::OP_DIVIDE: VariantInternal::set_vector2(dst, va / vb); break;
+						case Variant::OP_NEGATE: VariantInternal::set_vector2(dst, -va); break;
+						case Variant::OP_EQUAL: VariantInternal::set_bool(dst, va == vb); break;
+						case Variant::OP_NOT_EQUAL: VariantInternal::set_bool(dst, va != vb); break;
+						default: handled = false;
+					}
+				} else if (a->get_type() == Variant::VECTOR2 && VariantInternal::is_number(b)) {
+
+					real_t vb = VariantInternal::get_number(b);
+					handled = true;
+
+					switch (op) {
+						case Variant::OP_MULTIPLY: VariantInternal::set_vector2(dst, VariantInternal::get_vector2(a) * vb); break;
+						case Variant::OP_DIVIDE: VariantInternal::set_vector2(dst, VariantInternal::get_vector2(a) / vb); break;
+						default: handled = false;
+					}
+				} else if (VariantInternal::is_number(a) && b->get_type() == Variant::VECTOR2 && op == Variant::OP_MULTIPLY) {
+
+					VariantInternal::set_vector2(dst, real_t(VariantInternal::get_number(a)) * VariantInternal::get_vector2(b));
+					handled = true;
+				}
+
+				if (handled) {
+					ip += 5;
+					DISPATCH_OPCODE;
+				}
+			}
+
+			OPCODE(OPCODE_OPERATOR_VECTOR3) {
+
+				CHECK_SPACE(5);
+
+				GET_VARIANT_PTR(a, 2);
+				GET_VARIANT_PTR(b, 3);
+				GET_VARIANT_PTR(dst, 4);
+				Variant::Operator op = (Variant::Operator)_code_ptr[ip + 1];
+				bool handled = false;
+
+				if (a->get_type() == Variant::VECTOR3 && b->get_type() == Variant::VECTOR3) {
+
+					const Vector3 &va = VariantInternal::get_vector3(a);
+					const Vector3 &vb = VariantInternal::get_vector3(b);
+					handled = true;
+
+					switch (op) {
+						case Variant::OP_ADD: VariantInternal::set_vector3(dst, va + vb); break;
+						case Variant::OP_SUBTRACT: VariantInternal::set_vector3(dst, va - vb); break;
+						case Variant::OP_MULTIPLY: VariantInternal::set_vector3(dst, va * vb); break;
+						case Variant::OP_DIVIDE: VariantInternal::set_vector3(dst, va / vb); break;
+						case Variant::OP_NEGATE: VariantInternal::set_vector3(dst, -va); break;
+						case Variant::OP_EQUAL: VariantInternal::set_bool(dst, va == vb); break;
+						case Variant::OP_NOT_EQUAL: VariantInternal::set_bool(dst, va != vb); break;
+						default: handled = false;
+					}
+				} else if (a->get_type() == Variant::VECTOR3 && VariantInternal::is_number(b)) {
+
+					real_t vb = VariantInternal::get_number(b);
+					handled = true;
+
+					switch (op) {
+						case Variant::OP_MULTIPLY: VariantInternal::set_vector3(dst, VariantInternal::get_vector3(a) * vb); break;
+						case Variant::OP_DIVIDE: VariantInternal::set_vector3(dst, VariantInternal::get_vector3(a) / vb); break;
+						default: handled = false;
+					}
+				} else if (VariantInternal::is_number(a) && b->get_type() == Variant::VECTOR3 && op == Variant::OP_MULTIPLY) {
+
+					VariantInternal::set_vector3(dst, real_t(VariantInternal::get_number(a)) * VariantInternal::get_vector3(b));
+					handled = true;
+				}
+
+				if (handled) {
+					ip += 5;
+					DISPATCH_OPCODE;
+				}
+			}
+
 			OPCODE(OPCODE_OPERATOR) {
 
 				CHECK_SPACE(5);
@@ -448,6 +735,13 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 				GET_VARIANT_PTR(b, 3);
 				GET_VARIANT_PTR(dst, 4);
 
+				Variant::ValidatedOperatorEvaluator evaluator = Variant::get_validated_operator_evaluator(op, a->get_type(), b->get_type());
+				if (evaluator) {
+					evaluator(a, b, dst);
+					ip += 5;
+					DISPATCH_OPCODE;
+				}
+
 #ifdef DEBUG_ENABLED
 
 				Variant ret;
@@ -551,6 +845,31 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 			}
 			DISPATCH_OPCODE;
 
+			OPCODE(OPCODE_SET_ARRAY) {
+
+				CHECK_SPACE(3);
+
+				GET_VARIANT_PTR(dst, 1);
+				GET_VARIANT_PTR(index, 2);
+
+				// anything but an int index into an array goes to OPCODE_SET
+				if (likely(dst->get_type() == Variant::ARRAY && index->get_type() == Variant::INT)) {
+
+					GET_VARIANT_PTR(value, 3);
+					Array *array = VariantInternal::get_array_ref(dst);
+					int64_t idx = VariantInternal::get_int(index);
+					if (idx < 0) {
+						idx += array->size();
+					}
+
+					if (idx >= 0 && idx < array->size() && array->can_hold(*value)) {
+						array->set(idx, *value);
+						ip += 4;
+						DISPATCH_OPCODE;
+					}
+				}
+			}
+
 			OPCODE(OPCODE_SET) {
 
 				CHECK_SPACE(3);
@@ -578,6 +897,32 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 			}
 			DISPATCH_OPCODE;
 
+			OPCODE(OPCODE_GET_ARRAY) {
+
+				CHECK_SPACE(3);
+
+				GET_VARIANT_PTR(src, 1);
+				GET_VARIANT_PTR(index, 2);
+
+				if (likely(src->get_type() == Variant::ARRAY && index->get_type() == Variant::INT)) {
+
+					GET_VARIANT_PTR(dst, 3);
+					const Array *array = VariantInternal::get_array(src);
+					int64_t idx = VariantInternal::get_int(index);
+					if (idx < 0) {
+						idx += array->size();
+					}
+
+					if (idx >= 0 && idx < array->size()) {
+						// copy first, dst may be where the array itself is stored
+						Variant value = (*array)[idx];
+						*dst = value;
+						ip += 4;
+						DISPATCH_OPCODE;
+					}
+				}
+			}
+
 			OPCODE(OPCODE_GET) {
 
 				CHECK_SPACE(3);
@@ -611,6 +956,32 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 			}
 			DISPATCH_OPCODE;
 
+			OPCODE(OPCODE_SET_NAMED_VECTOR) {
+
+				CHECK_SPACE(3);
+
+				GET_VARIANT_PTR(dst, 1);
+				GET_VARIANT_PTR(value, 3);
+
+				int indexname = _code_ptr[ip + 2];
+
+				GD_ERR_BREAK(indexname < 0 || indexname >= _global_names_count);
+				int axis = _get_vector_axis(_global_names_ptr[indexname]);
+
+				if (VariantInternal::is_number(value)) {
+					if (dst->get_type() == Variant::VECTOR2 && axis < 2) {
+						VariantInternal::get_vector2_ref(dst)[axis] = VariantInternal::get_number(value);
+						ip += 4;
+						DISPATCH_OPCODE;
+					} else if (dst->get_type() == Variant::VECTOR3 && axis < 3) {
+						VariantInternal::get_vector3_ref(dst)[axis] = VariantInternal::get_number(value);
+						ip += 4;
+						DISPATCH_OPCODE;
+					}
+				}
+				// otherwise falls through to the generic version
+			}
+
 			OPCODE(OPCODE_SET_NAMED) {
 
 				CHECK_SPACE(3);
@@ -637,6 +1008,30 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 			}
 			DISPATCH_OPCODE;
 
+			OPCODE(OPCODE_GET_NAMED_VECTOR) {
+
+				CHECK_SPACE(4);
+
+				GET_VARIANT_PTR(src, 1);
+				GET_VARIANT_PTR(dst, 3);
+
+				int indexname = _code_ptr[ip + 2];
+
+				GD_ERR_BREAK(indexname < 0 || indexname >= _global_names_count);
+				int axis = _get_vector_axis(_global_names_ptr[indexname]);
+
+				if (src->get_type() == Variant::VECTOR2 && axis < 2) {
+					VariantInternal::set_real(dst, VariantInternal::get_vector2(src)[axis]);
+					ip += 4;
+					DISPATCH_OPCODE;
+				} else if (src->get_type() == Variant::VECTOR3 && axis < 3) {
+					VariantInternal::set_real(dst, VariantInternal::get_vector3(src)[axis]);
+					ip += 4;
+					DISPATCH_OPCODE;
+				}
+				// otherwise falls through to the generic version
+			}
+
 			OPCODE(OPCODE_GET_NAMED) {
 
 				CHECK_SPACE(4);
@@ -862,6 +1257,42 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 			}
 			DISPATCH_OPCODE;
 
+			OPCODE(OPCODE_ASSIGN_TYPED_ARRAY) {
+
+				CHECK_SPACE(5);
+				Variant::Type element_type = (Variant::Type)_code_ptr[ip + 1];
+				int class_name_idx = _code_ptr[ip + 2];
+				GET_VARIANT_PTR(dst, 3);
+				GET_VARIANT_PTR(src, 4);
+
+				GD_ERR_BREAK(element_type <= Variant::NIL || element_type >= Variant::VARIANT_MAX);
+				GD_ERR_BREAK(class_name_idx < 0 || class_name_idx >= _global_names_count);
+
+				if (src->get_type() != Variant::ARRAY) {
+#ifdef DEBUG_ENABLED
+					err_text = "Trying to assign value of type '" + Variant::get_type_name(src->get_type()) +
+							   "' to a variable of type 'Array[" + Variant::get_type_name(element_type) + "]'.";
+#endif // DEBUG_ENABLED
+					OPCODE_BREAK;
+				}
+
+				// Shares arrays that already have the element type, converts a
+				// copy of any other
+				Array typed;
+				typed.set_typed(element_type, _global_names_ptr[class_name_idx]);
+				if (!typed.typed_assign(*VariantInternal::get_array(src))) {
+#ifdef DEBUG_ENABLED
+					err_text = "Trying to assign an array holding values of another type to a variable of type 'Array[" +
+							   (_global_names_ptr[class_name_idx] != StringName() ? String(_global_names_ptr[class_name_idx]) : Variant::get_type_name(element_type)) + "]'.";
+#endif // DEBUG_ENABLED
+					OPCODE_BREAK;
+				}
+				*dst = typed;
+
+				ip += 5;
+			}
+			DISPATCH_OPCODE;
+
 			OPCODE(OPCODE_CAST_TO_BUILTIN) {
 
 				CHECK_SPACE(4);
@@ -1034,11 +1465,14 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 			}
 			DISPATCH_OPCODE;
 
+			OPCODE(OPCODE_CALL_METHOD_BIND_RETURN)
+			OPCODE(OPCODE_CALL_METHOD_BIND)
 			OPCODE(OPCODE_CALL_RETURN)
 			OPCODE(OPCODE_CALL) {
 
 				CHECK_SPACE(4);
-				bool call_ret = _code_ptr[ip] == OPCODE_CALL_RETURN;
+				int opcode = _code_ptr[ip];
+				bool call_ret = opcode == OPCODE_CALL_RETURN || opcode == OPCODE_CALL_METHOD_BIND_RETURN;
 
 				int argc = _code_ptr[ip + 1];
 				GET_VARIANT_PTR(base, 2);
@@ -1047,6 +1481,15 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 				GD_ERR_BREAK(nameg < 0 || nameg >= _global_names_count);
 				const StringName *methodname = &_global_names_ptr[nameg];
 
+				const NativeMethod *native = NULL;
+				if (opcode == OPCODE_CALL_METHOD_BIND || opcode == OPCODE_CALL_METHOD_BIND_RETURN) {
+					CHECK_SPACE(5);
+					int methodg = _code_ptr[ip + 4];
+					GD_ERR_BREAK(methodg < 0 || methodg >= _methods_count);
+					native = &_methods_ptr[methodg];
+					ip++;
+				}
+
 				GD_ERR_BREAK(argc < 0);
 				ip += 4;
 				CHECK_SPACE(argc + 1);
@@ -1065,8 +1508,31 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 				}
 
 #endif
+				// The bind can be called directly when the base is an instance of the class
+				// it was resolved from and has no script, which could override the method.
+				// Anything else takes the regular path, which also reports the errors.
+				Object *native_obj = NULL;
+				if (native && base->get_type() == Variant::OBJECT) {
+					native_obj = VariantInternal::get_object(base);
+#ifdef DEBUG_ENABLED
+					if (native_obj && ScriptDebugger::get_singleton() && !base->is_ref() && !ObjectDB::instance_validate(native_obj)) {
+						native_obj = NULL;
+					}
+#endif
+					if (native_obj && (native_obj->get_script_instance() || !native_obj->is_class_ptr(native->class_ptr))) {
+						native_obj = NULL;
+					}
+				}
+
 				Variant::CallError err;
-				if (call_ret) {
+				if (native_obj) {
+
+					Variant result = native->method->call(native_obj, (const Variant **)argptrs, argc, err);
+					if (call_ret && err.error == Variant::CallError::CALL_OK) {
+						GET_VARIANT_PTR(ret, argc);
+						*ret = result;
+					}
+				} else if (call_ret) {
 
 					GET_VARIANT_PTR(ret, argc);
 					base->call_ptr(*methodname, (const Variant **)argptrs, argc, ret, err);
@@ -1250,11 +1716,6 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 				Ref<GDScriptFunctionState> gdfs = memnew(GDScriptFunctionState);
 				gdfs->function = this;
 
-				gdfs->state.stack.resize(alloca_size);
-				//copy variant stack
-				for (int i = 0; i < _stack_size; i++) {
-					memnew_placement(&gdfs->state.stack.write[sizeof(Variant) * i], Variant(stack[i]));
-				}
 				gdfs->state.stack_size = _stack_size;
 				gdfs->state.self = self;
 				gdfs->state.alloca_size = alloca_size;
@@ -1267,6 +1728,10 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 				gdfs->state.instance = p_instance;
 				gdfs->function = this;
 
+				//hand over the frame, it is not freed when this call exits
+				gdfs->state.stack = heap_frame;
+				heap_frame = NULL;
+
 				retvalue = gdfs;
 
 				if (_code_ptr[ip] == OPCODE_YIELD_SIGNAL) {
@@ -1305,13 +1770,13 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 						OPCODE_BREAK;
 					}
 
-					Error err = obj->connect(signal, gdfs.ptr(), "_signal_callback", varray(gdfs), Object::CONNECT_ONESHOT);
+					Error err = GDScriptSignalQueue::wait(obj, signal, gdfs);
 					if (err != OK) {
 						err_text = "Error connecting to signal: " + signal + " during yield().";
 						OPCODE_BREAK;
 					}
 #else
-					obj->connect(signal, gdfs.ptr(), "_signal_callback", varray(gdfs), Object::CONNECT_ONESHOT);
+					GDScriptSignalQueue::wait(obj, signal, gdfs);
 #endif
 				}
 
@@ -1466,6 +1931,76 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 			}
 			DISPATCH_OPCODE;
 
+			OPCODE(OPCODE_ITERATE_BEGIN_RANGE) {
+
+				CHECK_SPACE(9);
+
+				GET_VARIANT_PTR(from, 4);
+				GET_VARIANT_PTR(to, 5);
+				GET_VARIANT_PTR(step, 6);
+
+				if (!VariantInternal::is_number(from) || !VariantInternal::is_number(to) || !VariantInternal::is_number(step)) {
+					const Variant *arg = !VariantInternal::is_number(from) ? from : (!VariantInternal::is_number(to) ? to : step);
+					err_text = "Invalid argument in range(), expected a number but got '" + Variant::get_type_name(arg->get_type()) + "'.";
+					OPCODE_BREAK;
+				}
+
+				// same truncation as range() itself
+				int64_t vfrom = from->operator int64_t();
+				int64_t vto = to->operator int64_t();
+				int64_t vstep = step->operator int64_t();
+
+				if (vstep == 0) {
+					err_text = "Step argument is zero!";
+					OPCODE_BREAK;
+				}
+
+				if (vstep > 0 ? vfrom >= vto : vfrom <= vto) {
+					int jumpto = _code_ptr[ip + 7];
+					GD_ERR_BREAK(jumpto < 0 || jumpto > _code_size);
+					ip = jumpto;
+				} else {
+					GET_VARIANT_PTR(counter, 1);
+					GET_VARIANT_PTR(range_to, 2);
+					GET_VARIANT_PTR(range_step, 3);
+					GET_VARIANT_PTR(iterator, 8);
+
+					VariantInternal::set_int(counter, vfrom);
+					VariantInternal::set_int(range_to, vto);
+					VariantInternal::set_int(range_step, vstep);
+					VariantInternal::set_int(iterator, vfrom);
+					ip += 9; //skip regular iterate which is always next
+				}
+			}
+			DISPATCH_OPCODE;
+
+			OPCODE(OPCODE_ITERATE_RANGE) {
+
+				CHECK_SPACE(6);
+
+				// counter, end and step were set up as ints by OPCODE_ITERATE_BEGIN_RANGE
+				GET_VARIANT_PTR(counter, 1);
+				GET_VARIANT_PTR(range_to, 2);
+				GET_VARIANT_PTR(range_step, 3);
+
+				int64_t vstep = VariantInternal::get_int(range_step);
+				int64_t vto = VariantInternal::get_int(range_to);
+				int64_t value = VariantInternal::get_int(counter) + vstep;
+
+				if (vstep > 0 ? value >= vto : value <= vto) {
+					int jumpto = _code_ptr[ip + 4];
+					GD_ERR_BREAK(jumpto < 0 || jumpto > _code_size);
+					ip = jumpto;
+				} else {
+					GET_VARIANT_PTR(iterator, 5);
+
+					VariantInternal::set_int(counter, value);
+					VariantInternal::set_int(iterator, value);
+					ip += 6; //loop again
+				}
+			}
+			DISPATCH_OPCODE;
+
 			OPCODE(OPCODE_ASSERT) {
 				CHECK_SPACE(2);
 
@@ -1573,6 +2108,16 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 	}
 
 	OPCODES_OUT
+#ifdef GDSCRIPT_PROFILE_OPCODES
+	if (profile_opcodes) {
+		uint64_t now = OS::get_singleton()->get_ticks_usec();
+		if (profile_opcode >= 0) {
+			uint64_t total = now - profile_opcode_start;
+			GDScriptLanguage::get_singleton()->_profile_opcode(profile_opcode, total, total - (GDScriptLanguage::get_singleton()->opcode_nested_time - profile_opcode_nested));
+		}
+		GDScriptLanguage::get_singleton()->opcode_nested_time += now - profile_call_start;
+	}
+#endif
 #ifdef DEBUG_ENABLED
 	if (GDScriptLanguage::get_singleton()->profiling) {
 		uint64_t time_taken = OS::get_singleton()->get_ticks_usec() - function_start_time;
@@ -1587,17 +2132,73 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 		GDScriptLanguage::get_singleton()->exit_function();
 #endif
 
-	if (_stack_size) {
-		//free stack
+	if (stack && (heap_frame || !_has_yield)) {
+		//free stack, unless it was handed over to a function state
 		for (int i = 0; i < _stack_size; i++)
 			stack[i].~Variant();
 	}
 
+	if (heap_frame) {
+		_free_frame(heap_frame);
+	}
+
 	return retvalue;
 }
 
+bool GDScriptFunction::_load_lazy_data() const {
+
+	// Another thread may be loading the body and clear lazy_data at any time, so
+	// go through the data of the script, whose lock rechecks it.
+	GDScriptBytecodeData *data = _script ? _script->compiled_data.ptr() : NULL;
+	return !data || data->load_function(const_cast<GDScriptFunction *>(this));
+}
+
+#define MAX_POOLED_FRAMES 64
+
+uint8_t *GDScriptFunction::_alloc_frame(uint32_t p_size) {
+
+	uint8_t *frame = NULL;
+
+	if (GDScriptLanguage::get_singleton()->lock) {
+		GDScriptLanguage::get_singleton()->lock->lock();
+	}
+	if (frame_pool.size()) {
+		frame = frame_pool[frame_pool.size() - 1];
+		frame_pool.resize(frame_pool.size() - 1);
+	}
+	if (GDScriptLanguage::get_singleton()->lock) {
+		GDScriptLanguage::get_singleton()->lock->unlock();
+	}
+
+	if (!frame) {
+		frame = (uint8_t *)memalloc(p_size);
+	}
+	return frame;
+}
+
+void GDScriptFunction::_free_frame(uint8_t *p_frame) {
+
+	if (GDScriptLanguage::get_singleton()->lock) {
+		GDScriptLanguage::get_singleton()->lock->lock();
+	}
+	bool pooled = frame_pool.size() < MAX_POOLED_FRAMES;
+	if (pooled) {
+		frame_pool.push_back(p_frame);
+	}
+	if (GDScriptLanguage::get_singleton()->lock) {
+		GDScriptLanguage::get_singleton()->lock->unlock();
+	}
+
+	if (!pooled) {
+		memfree(p_frame);
+	}
+}
+
 const int *GDScriptFunction::get_code() const {
 
+	if (lazy_data) {
+		_load_lazy_data();
+	}
 	return _code_ptr;
 }
 int GDScriptFunction::get_code_size() const {
@@ -1607,12 +2208,18 @@ int GDScriptFunction::get_code_size() const {
 
 Variant GDScriptFunction::get_constant(int p_idx) const {
 
+	if (lazy_data) {
+		_load_lazy_data();
+	}
 	ERR_FAIL_INDEX_V(p_idx, constants.size(), "<errconst>");
 	return constants[p_idx];
 }
 
 StringName GDScriptFunction::get_global_name(int p_idx) const {
 
+	if (lazy_data) {
+		_load_lazy_data();
+	}
 	ERR_FAIL_INDEX_V(p_idx, global_names.size(), "<errgname>");
 	return global_names[p_idx];
 }
@@ -1666,6 +2273,10 @@ struct _GDFKCS {
 
 void GDScriptFunction::debug_get_stack_member_state(int p_line, List<Pair<StringName, int> > *r_stackvars) const {
 
+	if (lazy_data) {
+		_load_lazy_data();
+	}
+
 	int oc = 0;
 	Map<StringName, _GDFKC> sdmap;
 	for (const List<StackDebug>::Element *E = stack_debug.front(); E; E = E->next()) {
@@ -1721,8 +2332,11 @@ GDScriptFunction::GDScriptFunction() :
 
 	_stack_size = 0;
 	_call_size = 0;
+	_has_yield = false;
 	rpc_mode = MultiplayerAPI::RPC_MODE_DISABLED;
 	name = "<anonymous>";
+	lazy_data = NULL;
+	lazy_offset = 0;
 #ifdef DEBUG_ENABLED
 	_func_cname = NULL;
 
@@ -1749,6 +2363,11 @@ GDScriptFunction::GDScriptFunction() :
 }
 
 GDScriptFunction::~GDScriptFunction() {
+
+	for (int i = 0; i < frame_pool.size(); i++) {
+		memfree(frame_pool[i]);
+	}
+
 #ifdef DEBUG_ENABLED
 	if (GDScriptLanguage::get_singleton()->lock) {
 		GDScriptLanguage::get_singleton()->lock->lock();
@@ -1901,15 +2520,134 @@ void GDScriptFunctionState::_bind_methods() {
 GDScriptFunctionState::GDScriptFunctionState() {
 
 	function = NULL;
+	state.stack = NULL;
 }
 
 GDScriptFunctionState::~GDScriptFunctionState() {
 
-	if (function != NULL) {
-		//never called, deinitialize stack
+	if (state.stack) {
+		//never resumed, deinitialize stack (the function may be gone, so the frame isn't pooled)
 		for (int i = 0; i < state.stack_size; i++) {
 			Variant *v = (Variant *)&state.stack[sizeof(Variant) * i];
 			v->~Variant();
 		}
+		memfree(state.stack);
+	}
+}
+
+/////////////////////
+
+Error GDScriptSignalQueue::wait(Object *p_object, const StringName &p_signal, const Ref<GDScriptFunctionState> &p_state) {
+
+	GDScriptLanguage *language = GDScriptLanguage::get_singleton();
+
+	if (language->lock) {
+		language->lock->lock();
+	}
+
+	Ref<GDScriptSignalQueue> queue;
+	Map<ObjectID, GDScriptSignalQueue *>::Element *E = language->signal_queues.find(p_object->get_instance_id());
+	if (E) {
+		queue = Ref<GDScriptSignalQueue>(E->get()); // Stays null if the queue is being freed.
+	}
+	if (queue.is_null()) {
+		queue.instance();
+		queue->object_id = p_object->get_instance_id();
+		language->signal_queues[queue->object_id] = queue.ptr();
+	}
+
+	Error err = OK;
+	if (!queue->pending.has(p_signal)) {
+		err = p_object->connect(p_signal, queue.ptr(), "_signal_callback", varray(p_signal, queue));
+		if (err == OK) {
+			queue->pending[p_signal] = Vector<Ref<GDScriptFunctionState> >();
+		}
+	}
+	if (err == OK) {
+		queue->pending[p_signal].push_back(p_state);
+	}
+
+	if (language->lock) {
+		language->lock->unlock();
+	}
+
+	return err;
+}
+
+Variant GDScriptSignalQueue::_signal_callback(const Variant **p_args, int p_argcount, Variant::CallError &r_error) {
+
+	r_error.error = Variant::CallError::CALL_OK;
+
+	if (p_argcount < 2) {
+		r_error.error = Variant::CallError::CALL_ERROR_TOO_FEW_ARGUMENTS;
+		r_error.argument = 2;
+		return Variant();
+	}
+
+	Variant arg;
+	if (p_argcount == 3) {
+		arg = *p_args[0];
+	} else if (p_argcount > 3) {
+		Array extra_args;
+		for (int i = 0; i < p_argcount - 2; i++) {
+			extra_args.push_back(*p_args[i]);
+		}
+		arg = extra_args;
+	}
+
+	StringName signal = *p_args[p_argcount - 2];
+	Ref<GDScriptSignalQueue> self = *p_args[p_argcount - 1]; // Keep alive while resuming.
+
+	// Functions yielding again while resumed wait for the next emission.
+	Vector<Ref<GDScriptFunctionState> > states;
+
+	GDScriptLanguage *language = GDScriptLanguage::get_singleton();
+	if (language->lock) {
+		language->lock->lock();
+	}
+	Map<StringName, Vector<Ref<GDScriptFunctionState> > >::Element *E = pending.find(signal);
+	if (E) {
+		states = E->get();
+		E->get().clear();
+	}
+	if (language->lock) {
+		language->lock->unlock();
+	}
+
+	for (int i = 0; i < states.size(); i++) {
+		// Skip functions that were resumed manually in the meantime.
+		Ref<GDScriptFunctionState> state = states[i];
+		if (state->is_valid()) {
+			state->resume(arg);
+		}
+	}
+
+	return Variant();
+}
+
+void GDScriptSignalQueue::_bind_methods() {
+
+	ClassDB::bind_vararg_method(METHOD_FLAGS_DEFAULT, "_signal_callback", &GDScriptSignalQueue::_signal_callback, MethodInfo("_signal_callback"));
+}
+
+GDScriptSignalQueue::GDScriptSignalQueue() {
+
+	object_id = 0;
+}
+
+GDScriptSignalQueue::~GDScriptSignalQueue() {
+
+	GDScriptLanguage *language = GDScriptLanguage::get_singleton();
+	if (language->lock) {
+		language->lock->lock();
+	}
+
+	Map<ObjectID, GDScriptSignalQueue *>::Element *E = language->signal_queues.find(object_id);
+	if (E && E->get() == this) {
+		language->signal_queues.erase(E);
+	}
+
+	if (language->lock) {
+		language->lock->unlock();
 	}
 }
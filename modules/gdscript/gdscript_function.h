@@ -39,6 +39,17 @@
 #include "core/string_name.h"
 #include "core/variant.h"
 
+class GDScriptBytecodeData;
+
+// Define (e.g. with CCFLAGS=-DGDSCRIPT_PROFILE_OPCODES) to also count executions
+// and time of every opcode while the script profiler runs. It reads the clock
+// on each instruction, so it is meant for instrumented debug builds only.
+//#define GDSCRIPT_PROFILE_OPCODES
+
+#if defined(GDSCRIPT_PROFILE_OPCODES) && !defined(DEBUG_ENABLED)
+#undef GDSCRIPT_PROFILE_OPCODES
+#endif
+
 class GDScriptInstance;
 class GDScript;
 
@@ -55,6 +66,28 @@ struct GDScriptDataType {
 	StringName native_type;
 	Ref<Script> script_type;
 
+	// Typed arrays: the element type, NIL for a plain Array, and the ClassDB
+	// name object elements are restricted to.
+	Variant::Type element_type;
+	StringName element_native_type;
+
+	_FORCE_INLINE_ bool has_element_type() const { return kind == BUILTIN && element_type != Variant::NIL; }
+
+	// Gives a typed array for p_value, sharing it when it already has this
+	// element type and converting a copy otherwise.
+	bool make_typed_array(const Variant &p_value, Variant &r_value) const {
+		if (p_value.get_type() != Variant::ARRAY) {
+			return false;
+		}
+		Array typed;
+		typed.set_typed(element_type, element_native_type);
+		if (!typed.typed_assign(p_value)) {
+			return false;
+		}
+		r_value = typed;
+		return true;
+	}
+
 	bool is_type(const Variant &p_variant, bool p_allow_implicit_conversion = false) const {
 		if (!has_type) return true; // Can't type check
 
@@ -64,6 +97,10 @@ struct GDScriptDataType {
 			case BUILTIN: {
 				Variant::Type var_type = p_variant.get_type();
 				bool valid = builtin_type == var_type;
+				if (valid && element_type != Variant::NIL && !p_allow_implicit_conversion) {
+					Array array = p_variant;
+					valid = array.get_typed_builtin() == uint32_t(element_type) && array.get_typed_class_name() == element_native_type;
+				}
 				if (!valid && p_allow_implicit_conversion) {
 					valid = Variant::can_convert_strict(var_type, builtin_type);
 				}
@@ -120,6 +157,14 @@ struct GDScriptDataType {
 					break;
 				case BUILTIN: {
 					info.type = builtin_type;
+					if (element_type != Variant::NIL) {
+						info.hint = PROPERTY_HINT_TYPE_STRING;
+						if (element_native_type != StringName() && ClassDB::is_parent_class(element_native_type, "Resource")) {
+							info.hint_string = itos(element_type) + "/" + itos(PROPERTY_HINT_RESOURCE_TYPE) + ":" + element_native_type;
+						} else {
+							info.hint_string = itos(element_type) + ":";
+						}
+					}
 				} break;
 				case NATIVE: {
 					info.type = Variant::OBJECT;
@@ -141,18 +186,27 @@ struct GDScriptDataType {
 	GDScriptDataType() :
 			has_type(false),
 			kind(UNINITIALIZED),
-			builtin_type(Variant::NIL) {}
+			builtin_type(Variant::NIL),
+			element_type(Variant::NIL) {}
 };
 
 class GDScriptFunction {
 public:
 	enum Opcode {
+		OPCODE_OPERATOR_INT, // typed variants fall back to OPCODE_OPERATOR on other operand types
+		OPCODE_OPERATOR_REAL,
+		OPCODE_OPERATOR_VECTOR2,
+		OPCODE_OPERATOR_VECTOR3,
 		OPCODE_OPERATOR,
 		OPCODE_EXTENDS_TEST,
 		OPCODE_IS_BUILTIN,
 		OPCODE_SET,
 		OPCODE_GET,
+		OPCODE_SET_ARRAY, // same as OPCODE_SET, with a fast path for int indices into arrays
+		OPCODE_GET_ARRAY,
+		OPCODE_SET_NAMED_VECTOR,
 		OPCODE_SET_NAMED,
+		OPCODE_GET_NAMED_VECTOR,
 		OPCODE_GET_NAMED,
 		OPCODE_SET_MEMBER,
 		OPCODE_GET_MEMBER,
@@ -162,6 +216,7 @@ public:
 		OPCODE_ASSIGN_TYPED_BUILTIN,
 		OPCODE_ASSIGN_TYPED_NATIVE,
 		OPCODE_ASSIGN_TYPED_SCRIPT,
+		OPCODE_ASSIGN_TYPED_ARRAY,
 		OPCODE_CAST_TO_BUILTIN,
 		OPCODE_CAST_TO_NATIVE,
 		OPCODE_CAST_TO_SCRIPT,
@@ -170,6 +225,8 @@ public:
 		OPCODE_CONSTRUCT_DICTIONARY,
 		OPCODE_CALL,
 		OPCODE_CALL_RETURN,
+		OPCODE_CALL_METHOD_BIND, // same as OPCODE_CALL, with a MethodBind resolved from the static type of the base
+		OPCODE_CALL_METHOD_BIND_RETURN,
 		OPCODE_CALL_BUILT_IN,
 		OPCODE_CALL_SELF,
 		OPCODE_CALL_SELF_BASE,
@@ -183,6 +240,8 @@ public:
 		OPCODE_RETURN,
 		OPCODE_ITERATE_BEGIN,
 		OPCODE_ITERATE,
+		OPCODE_ITERATE_BEGIN_RANGE,
+		OPCODE_ITERATE_RANGE,
 		OPCODE_ASSERT,
 		OPCODE_BREAKPOINT,
 		OPCODE_LINE,
@@ -213,8 +272,16 @@ public:
 		StringName identifier;
 	};
 
+	struct NativeMethod {
+
+		MethodBind *method;
+		void *class_ptr; // class the method is bound in, checked with Object::is_class_ptr()
+	};
+
 private:
 	friend class GDScriptCompiler;
+	friend class GDScriptBytecode;
+	friend class GDScriptBytecodeData;
 
 	StringName source;
 
@@ -223,6 +290,8 @@ private:
 	int _constant_count;
 	const StringName *_global_names_ptr;
 	int _global_names_count;
+	const NativeMethod *_methods_ptr;
+	int _methods_count;
 #ifdef TOOLS_ENABLED
 	const StringName *_named_globals_ptr;
 	int _named_globals_count;
@@ -236,6 +305,7 @@ private:
 	int _call_size;
 	int _initial_line;
 	bool _static;
+	bool _has_yield;
 	MultiplayerAPI::RPCMode rpc_mode;
 
 	GDScript *_script;
@@ -243,6 +313,7 @@ private:
 	StringName name;
 	Vector<Variant> constants;
 	Vector<StringName> global_names;
+	Vector<NativeMethod> methods;
 #ifdef TOOLS_ENABLED
 	Vector<StringName> named_globals;
 #endif
@@ -257,6 +328,19 @@ private:
 
 	List<StackDebug> stack_debug;
 
+	// Set while the body of a precompiled function hasn't been loaded yet.
+	GDScriptBytecodeData *lazy_data;
+	int lazy_offset;
+
+	bool _load_lazy_data() const;
+
+	// Functions that yield keep their stack frame on the heap, a yield hands
+	// the frame over to the function state and resuming runs in place.
+	Vector<uint8_t *> frame_pool;
+
+	uint8_t *_alloc_frame(uint32_t p_size);
+	void _free_frame(uint8_t *p_frame);
+
 	_FORCE_INLINE_ Variant *_get_variant(int p_address, GDScriptInstance *p_instance, GDScript *p_script, Variant &self, Variant *p_stack, String &r_error) const;
 	_FORCE_INLINE_ String _get_call_error(const Variant::CallError &p_err, const String &p_where, const Variant **argptrs) const;
 
@@ -287,7 +371,7 @@ public:
 
 		ObjectID instance_id;
 		GDScriptInstance *instance;
-		Vector<uint8_t> stack;
+		uint8_t *stack;
 		int stack_size;
 		Variant self;
 		uint32_t alloca_size;
@@ -357,4 +441,26 @@ public:
 	~GDScriptFunctionState();
 };
 
+// Yields waiting for a signal of the same object share one connection, instead
+// of connecting and disconnecting once per yield. Connection binds keep the
+// queue alive until the object is freed.
+class GDScriptSignalQueue : public Reference {
+
+	GDCLASS(GDScriptSignalQueue, Reference);
+
+	ObjectID object_id;
+	Map<StringName, Vector<Ref<GDScriptFunctionState> > > pending;
+
+	Variant _signal_callback(const Variant **p_args, int p_argcount, Variant::CallError &r_error);
+
+protected:
+	static void _bind_methods();
+
+public:
+	static Error wait(Object *p_object, const StringName &p_signal, const Ref<GDScriptFunctionState> &p_state);
+
+	GDScriptSignalQueue();
+	~GDScriptSignalQueue();
+};
+
 #endif // GDSCRIPT_FUNCTION_H
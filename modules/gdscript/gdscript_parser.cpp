@@ -3076,59 +3076,7 @@ void GDScriptParser::_parse_block(BlockNode *p_block, bool p_static) {
 
 					OperatorNode *op = static_cast<OperatorNode *>(container);
 					if (op->op == OperatorNode::OP_CALL && op->arguments[0]->type == Node::TYPE_BUILT_IN_FUNCTION && static_cast<BuiltInFunctionNode *>(op->arguments[0])->function == GDScriptFunctions::GEN_RANGE) {
-						//iterating a range, so see if range() can be optimized without allocating memory, by replacing it by vectors (which can work as iterable too!)
-
-						Vector<Node *> args;
-						Vector<double> constants;
-
-						bool constant = false;
-
-						for (int i = 1; i < op->arguments.size(); i++) {
-							args.push_back(op->arguments[i]);
-							if (constant && op->arguments[i]->type == Node::TYPE_CONSTANT) {
-								ConstantNode *c = static_cast<ConstantNode *>(op->arguments[i]);
-								if (c->value.get_type() == Variant::REAL || c->value.get_type() == Variant::INT) {
-									constants.push_back(c->value);
-									constant = true;
-								}
-							} else {
-								constant = false;
-							}
-						}
-
-						if (args.size() > 0 && args.size() < 4) {
-
-							if (constant) {
-
-								ConstantNode *cn = alloc_node<ConstantNode>();
-								switch (args.size()) {
-									case 1: cn->value = (int)constants[0]; break;
-									case 2: cn->value = Vector2(constants[0], constants[1]); break;
-									case 3: cn->value = Vector3(constants[0], constants[1], constants[2]); break;
-								}
-								cn->datatype = _type_from_variant(cn->value);
-								container = cn;
-							} else {
-								OperatorNode *on = alloc_node<OperatorNode>();
-								on->op = OperatorNode::OP_CALL;
-
-								TypeNode *tn = alloc_node<TypeNode>();
-								on->arguments.push_back(tn);
-
-								switch (args.size()) {
-									case 1: tn->vtype = Variant::INT; break;
-									case 2: tn->vtype = Variant::VECTOR2; break;
-									case 3: tn->vtype = Variant::VECTOR3; break;
-								}
-
-								for (int i = 0; i < args.size(); i++) {
-									on->arguments.push_back(args[i]);
-								}
-
-								container = on;
-							}
-						}
-
+						//iterating a range, the compiler counts it in place without allocating an array
 						iter_type.has_type = true;
 						iter_type.kind = DataType::BUILTIN;
 						iter_type.builtin_type = Variant::INT;
@@ -5275,6 +5223,12 @@ String GDScriptParser::DataType::to_string() const {
 	switch (kind) {
 		case BUILTIN: {
 			if (builtin_type == Variant::NIL) return "null";
+			if (element_type != Variant::NIL) {
+				if (element_native_type != StringName()) {
+					return "Array[" + element_native_type.operator String() + "]";
+				}
+				return "Array[" + Variant::get_type_name(element_type) + "]";
+			}
 			return Variant::get_type_name(builtin_type);
 		} break;
 		case NATIVE: {
@@ -5390,6 +5344,34 @@ bool GDScriptParser::_parse_type(DataType &r_type, bool p_can_be_void) {
 		tokenizer->advance();
 	}
 
+	if (r_type.kind == DataType::BUILTIN && r_type.builtin_type == Variant::ARRAY && tokenizer->get_token() == GDScriptTokenizer::TK_BRACKET_OPEN) {
+		// Typed array, only built-in types and native classes can be elements
+		tokenizer->advance();
+		switch (tokenizer->get_token()) {
+			case GDScriptTokenizer::TK_BUILT_IN_TYPE: {
+				r_type.element_type = tokenizer->get_token_type();
+			} break;
+			case GDScriptTokenizer::TK_IDENTIFIER: {
+				r_type.element_native_type = tokenizer->get_token_identifier();
+				if (!ClassDB::class_exists(r_type.element_native_type) && !ClassDB::class_exists("_" + r_type.element_native_type.operator String())) {
+					_set_error("Typed arrays only support built-in types and native classes as element type.");
+					return false;
+				}
+				r_type.element_type = Variant::OBJECT;
+			} break;
+			default: {
+				_set_error("Expected element type for typed array.");
+				return false;
+			}
+		}
+		tokenizer->advance();
+		if (tokenizer->get_token() != GDScriptTokenizer::TK_BRACKET_CLOSE) {
+			_set_error("Expected ']' after the element type of typed array.");
+			return false;
+		}
+		tokenizer->advance();
+	}
+
 	if (can_index) {
 		while (!finished) {
 			switch (tokenizer->get_token()) {
@@ -5650,6 +5632,8 @@ GDScriptParser::DataType GDScriptParser::_type_from_gdtype(const GDScriptDataTyp
 	result.builtin_type = p_gdtype.builtin_type;
 	result.native_type = p_gdtype.native_type;
 	result.script_type = p_gdtype.script_type;
+	result.element_type = p_gdtype.element_type;
+	result.element_native_type = p_gdtype.element_native_type;
 
 	switch (p_gdtype.kind) {
 		case GDScriptDataType::UNINITIALIZED: {
@@ -5830,6 +5814,10 @@ bool GDScriptParser::_is_type_compatible(const DataType &p_container, const Data
 	ERR_FAIL_COND_V(p_expression.kind == DataType::UNRESOLVED, false);
 
 	if (p_container.kind == DataType::BUILTIN && p_expression.kind == DataType::BUILTIN) {
+		if (p_container.element_type != Variant::NIL && p_expression.element_type != Variant::NIL) {
+			// Arrays typed differently can't be converted into each other
+			return p_container.element_type == p_expression.element_type && p_container.element_native_type == p_expression.element_native_type;
+		}
 		bool valid = p_container.builtin_type == p_expression.builtin_type;
 		if (p_allow_implicit_conversion) {
 			valid = valid || Variant::can_convert_strict(p_expression.builtin_type, p_container.builtin_type);
@@ -6446,6 +6434,17 @@ GDScriptParser::DataType GDScriptParser::_reduce_node_type(Node *p_node) {
 							case Variant::AABB:
 							case Variant::BASIS: {
 								result.builtin_type = Variant::VECTOR3;
+							} break;
+								// Return the element type of typed arrays
+							case Variant::ARRAY: {
+								if (base_type.element_type == Variant::NIL) {
+									result.has_type = false;
+								} else if (base_type.element_type == Variant::OBJECT) {
+									result.kind = DataType::NATIVE;
+									result.native_type = base_type.element_native_type != StringName() ? base_type.element_native_type : StringName("Object");
+								} else {
+									result.builtin_type = base_type.element_type;
+								}
 							} break;
 								// Depends on the index
 							case Variant::TRANSFORM:
@@ -7473,6 +7472,11 @@ void GDScriptParser::_check_class_level_types(ClassNode *p_class) {
 #endif
 		}
 
+		if (v.initial_assignment && v.data_type.element_type != Variant::NIL) {
+			// Typed arrays are converted when initialized, so the assignment must know the member type
+			v.initial_assignment->arguments[0]->set_datatype(v.data_type);
+		}
+
 		// Check export hint
 		if (v.data_type.has_type && v._export.type != Variant::NIL) {
 			DataType export_type = _type_from_property(v._export);
@@ -7687,7 +7691,12 @@ void GDScriptParser::_check_function_types(FunctionNode *p_function) {
 void GDScriptParser::_check_class_blocks_types(ClassNode *p_class) {
 
 	// Function blocks
+	// Completion only needs local types inside the function being edited,
+	// the other bodies can't affect what it sees.
 	for (int i = 0; i < p_class->static_functions.size(); i++) {
+		if (for_completion && p_class->static_functions[i] != completion_function) {
+			continue;
+		}
 		current_function = p_class->static_functions[i];
 		current_block = current_function->body;
 		_mark_line_as_safe(current_function->line);
@@ -7698,6 +7707,9 @@ void GDScriptParser::_check_class_blocks_types(ClassNode *p_class) {
 	}
 
 	for (int i = 0; i < p_class->functions.size(); i++) {
+		if (for_completion && p_class->functions[i] != completion_function) {
+			continue;
+		}
 		current_function = p_class->functions[i];
 		current_block = current_function->body;
 		_mark_line_as_safe(current_function->line);
@@ -7709,12 +7721,12 @@ void GDScriptParser::_check_class_blocks_types(ClassNode *p_class) {
 
 #ifdef DEBUG_ENABLED
 	// Warnings
-	for (int i = 0; i < p_class->variables.size(); i++) {
+	for (int i = 0; i < p_class->variables.size() && !for_completion; i++) {
 		if (p_class->variables[i].usages == 0) {
 			_add_warning(GDScriptWarning::UNUSED_CLASS_VARIABLE, p_class->variables[i].line, p_class->variables[i].identifier);
 		}
 	}
-	for (int i = 0; i < p_class->_signals.size(); i++) {
+	for (int i = 0; i < p_class->_signals.size() && !for_completion; i++) {
 		if (p_class->_signals[i].emissions == 0) {
 			_add_warning(GDScriptWarning::UNUSED_SIGNAL, p_class->_signals[i].line, p_class->_signals[i].name);
 		}
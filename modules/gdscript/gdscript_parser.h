@@ -65,6 +65,11 @@ public:
 		Ref<Script> script_type;
 		ClassNode *class_type;
 
+		// Typed arrays: the element type, NIL for a plain Array. Object
+		// elements may be restricted to a native class.
+		Variant::Type element_type;
+		StringName element_native_type;
+
 		String to_string() const;
 
 		bool operator==(const DataType &other) const {
@@ -76,7 +81,7 @@ public:
 			}
 			switch (kind) {
 				case BUILTIN: {
-					return builtin_type == other.builtin_type;
+					return builtin_type == other.builtin_type && element_type == other.element_type && element_native_type == other.element_native_type;
 				} break;
 				case NATIVE: {
 					return native_type == other.native_type;
@@ -102,7 +107,8 @@ public:
 				infer_type(false),
 				may_yield(false),
 				builtin_type(Variant::NIL),
-				class_type(NULL) {}
+				class_type(NULL),
+				element_type(Variant::NIL) {}
 	};
 
 	struct Node {
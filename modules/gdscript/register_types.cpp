@@ -77,6 +77,17 @@ public:
 
 		if (!file.empty()) {
 
+			// Store the compiled classes along with the tokens, so the game doesn't
+			// have to parse and compile the script again. Only possible when the
+			// script loaded in the editor is the one on disk.
+			Ref<GDScript> script = ResourceLoader::load(p_path);
+			if (script.is_valid() && script->get_source_code() == txt) {
+				Vector<uint8_t> compiled;
+				if (GDScriptBytecode::save(script, file, compiled) == OK) {
+					file = compiled;
+				}
+			}
+
 			if (script_mode == EditorExportPreset::MODE_SCRIPT_ENCRYPTED) {
 
 				String tmp_path = EditorSettings::get_singleton()->get_cache_dir().plus_file("script.gde");
@@ -138,6 +149,7 @@ void register_gdscript_types() {
 
 	ClassDB::register_class<GDScript>();
 	ClassDB::register_virtual_class<GDScriptFunctionState>();
+	ClassDB::register_virtual_class<GDScriptSignalQueue>();
 
 	script_language_gd = memnew(GDScriptLanguage);
 	ScriptServer::register_language(script_language_gd);
@@ -306,9 +306,11 @@ void GridMap::set_cell_item(int p_x, int p_y, int p_z, int p_item, int p_rot) {
 		if (cell_map.has(key)) {
 			OctantKey octantkey = ok;
 
-			ERR_FAIL_COND(!octant_map.has(octantkey));
-			Octant &g = *octant_map[octantkey];
+			Octant **G = octant_map.getptr(octantkey);
+			ERR_FAIL_COND(!G);
+			Octant &g = **G;
 			g.cells.erase(key);
+			g.dirty_cells.insert(key);
 			g.dirty = true;
 			cell_map.erase(key);
 			_queue_octants_dirty();
@@ -318,10 +320,13 @@ void GridMap::set_cell_item(int p_x, int p_y, int p_z, int p_item, int p_rot) {
 
 	OctantKey octantkey = ok;
 
-	if (!octant_map.has(octantkey)) {
+	Octant **G = octant_map.getptr(octantkey);
+	if (!G) {
 		//create octant because it does not exist
 		Octant *g = memnew(Octant);
 		g->dirty = true;
+		g->rebuild = true;
+		g->pending_ready = false;
 		g->static_body = PhysicsServer::get_singleton()->body_create(PhysicsServer::BODY_MODE_STATIC);
 		PhysicsServer::get_singleton()->body_attach_object_instance_id(g->static_body, get_instance_id());
 		PhysicsServer::get_singleton()->body_set_collision_layer(g->static_body, collision_layer);
@@ -336,6 +341,7 @@ void GridMap::set_cell_item(int p_x, int p_y, int p_z, int p_item, int p_rot) {
 		}
 
 		octant_map[octantkey] = g;
+		G = octant_map.getptr(octantkey);
 
 		if (is_inside_world()) {
 			_octant_enter_world(octantkey);
@@ -343,8 +349,9 @@ void GridMap::set_cell_item(int p_x, int p_y, int p_z, int p_item, int p_rot) {
 		}
 	}
 
-	Octant &g = *octant_map[octantkey];
+	Octant &g = **G;
 	g.cells.insert(key);
+	g.dirty_cells.insert(key);
 	g.dirty = true;
 	_queue_octants_dirty();
 
@@ -406,8 +413,9 @@ Vector3 GridMap::map_to_world(int p_x, int p_y, int p_z) const {
 
 void GridMap::_octant_transform(const OctantKey &p_key) {
 
-	ERR_FAIL_COND(!octant_map.has(p_key));
-	Octant &g = *octant_map[p_key];
+	Octant **G = octant_map.getptr(p_key);
+	ERR_FAIL_COND(!G);
+	Octant &g = **G;
 	PhysicsServer::get_singleton()->body_set_state(g.static_body, PhysicsServer::BODY_STATE_TRANSFORM, get_global_transform());
 
 	if (g.collision_debug_instance.is_valid()) {
@@ -419,152 +427,223 @@ void GridMap::_octant_transform(const OctantKey &p_key) {
 	}
 }
 
-bool GridMap::_octant_update(const OctantKey &p_key) {
-	ERR_FAIL_COND_V(!octant_map.has(p_key), false);
-	Octant &g = *octant_map[p_key];
-	if (!g.dirty)
-		return false;
+Transform GridMap::_cell_get_transform(const IndexKey &p_key, const Cell &p_cell) const {
 
-	//erase body shapes
-	PhysicsServer::get_singleton()->body_clear_shapes(g.static_body);
+	Vector3 cellpos = Vector3(p_key.x, p_key.y, p_key.z);
 
-	//erase body shapes debug
-	if (g.collision_debug.is_valid()) {
+	Transform xform;
+	xform.basis.set_orthogonal_index(p_cell.rot);
+	xform.set_origin(cellpos * cell_size + _get_offset());
+	xform.basis.scale(Vector3(cell_scale, cell_scale, cell_scale));
+	return xform;
+}
 
-		VS::get_singleton()->mesh_clear(g.collision_debug);
-	}
+bool GridMap::_octant_needs_rebuild(const Octant &p_octant) const {
 
-	//erase navigation
-	if (navigation) {
-		for (Map<IndexKey, Octant::NavMesh>::Element *E = g.navmesh_ids.front(); E; E = E->next()) {
-			navigation->navmesh_remove(E->get().id);
-		}
-		g.navmesh_ids.clear();
+	//patching is cheaper only while a small part of the octant changed
+	return p_octant.dirty && p_octant.cells.size() && (p_octant.rebuild || p_octant.dirty_cells.size() * 2 > p_octant.cells.size());
+}
+
+void GridMap::_fill_multimesh_buffer(const Vector<Octant::MultimeshInstance::Item> &p_items, int p_capacity, PoolVector<float> &r_buffer) {
+
+	r_buffer.resize(p_capacity * 12);
+	PoolVector<float>::Write w = r_buffer.write();
+
+	for (int i = 0; i < p_capacity; i++) {
+		//unused slots repeat a used transform, so they don't grow the multimesh AABB
+		const Transform &xform = p_items[i < p_items.size() ? i : 0].transform;
+		float *dataptr = &w[i * 12];
+
+		dataptr[0] = xform.basis.elements[0][0];
+		dataptr[1] = xform.basis.elements[0][1];
+		dataptr[2] = xform.basis.elements[0][2];
+		dataptr[3] = xform.origin.x;
+		dataptr[4] = xform.basis.elements[1][0];
+		dataptr[5] = xform.basis.elements[1][1];
+		dataptr[6] = xform.basis.elements[1][2];
+		dataptr[7] = xform.origin.y;
+		dataptr[8] = xform.basis.elements[2][0];
+		dataptr[9] = xform.basis.elements[2][1];
+		dataptr[10] = xform.basis.elements[2][2];
+		dataptr[11] = xform.origin.z;
 	}
+}
 
-	//erase multimeshes
+void GridMap::_octant_prepare_rebuild_job(uint32_t p_index, Octant **p_octants) {
 
-	for (int i = 0; i < g.multimesh_instances.size(); i++) {
+	//only reads the cell map and mesh library, everything touching the servers is left to the main thread
+	Octant &g = *p_octants[p_index];
+	g.pending_multimeshes.clear();
 
-		VS::get_singleton()->free(g.multimesh_instances[i].instance);
-		VS::get_singleton()->free(g.multimesh_instances[i].multimesh);
+	if (baked_meshes.size() == 0 && mesh_library.is_valid()) {
+
+		Map<int, int> pending_index;
+
+		for (Set<IndexKey>::Element *E = g.cells.front(); E; E = E->next()) {
+
+			const Map<IndexKey, Cell>::Element *C = cell_map.find(E->get());
+			ERR_CONTINUE(!C);
+			const Cell &c = C->get();
+
+			if (!mesh_library->has_item(c.item) || !mesh_library->get_item_mesh(c.item).is_valid())
+				continue;
+
+			Map<int, int>::Element *P = pending_index.find(c.item);
+			if (!P) {
+				Octant::PendingMultimesh pm;
+				pm.item = c.item;
+				g.pending_multimeshes.push_back(pm);
+				P = pending_index.insert(c.item, g.pending_multimeshes.size() - 1);
+			}
+
+			Octant::PendingMultimesh &pm = g.pending_multimeshes.write[P->get()];
+
+			Octant::MultimeshInstance::Item it;
+			it.index = pm.items.size();
+			it.transform = _cell_get_transform(E->get(), c);
+			it.key = E->get();
+			pm.items.push_back(it);
+		}
+
+		for (int i = 0; i < g.pending_multimeshes.size(); i++) {
+			Octant::PendingMultimesh &pm = g.pending_multimeshes.write[i];
+			_fill_multimesh_buffer(pm.items, pm.items.size(), pm.buffer);
+		}
 	}
-	g.multimesh_instances.clear();
 
-	if (g.cells.size() == 0) {
-		//octant no longer needed
-		_octant_clean_up(p_key);
-		return true;
+	g.pending_ready = true;
+}
+
+int GridMap::_octant_get_multimesh(Octant &g, int p_item) {
+
+	Map<int, int>::Element *E = g.item_multimesh.find(p_item);
+	if (E) {
+		return E->get();
 	}
 
-	PoolVector<Vector3> col_debug;
+	Octant::MultimeshInstance mmi;
+	mmi.capacity = 0;
+	mmi.multimesh = VS::get_singleton()->multimesh_create();
+	VS::get_singleton()->multimesh_set_mesh(mmi.multimesh, mesh_library->get_item_mesh(p_item)->get_rid());
 
-	/*
-	 * foreach item in this octant,
-	 * set item's multimesh's instance count to number of cells which have this item
-	 * and set said multimesh bounding box to one containing all cells which have this item
-	 */
+	mmi.instance = VS::get_singleton()->instance_create();
+	VS::get_singleton()->instance_set_base(mmi.instance, mmi.multimesh);
 
-	Map<int, List<Pair<Transform, IndexKey> > > multimesh_items;
+	if (is_inside_tree()) {
+		VS::get_singleton()->instance_set_scenario(mmi.instance, get_world()->get_scenario());
+		VS::get_singleton()->instance_set_transform(mmi.instance, get_global_transform());
+	}
 
-	for (Set<IndexKey>::Element *E = g.cells.front(); E; E = E->next()) {
+	g.multimesh_instances.push_back(mmi);
+	g.item_multimesh[p_item] = g.multimesh_instances.size() - 1;
+	return g.multimesh_instances.size() - 1;
+}
 
-		ERR_CONTINUE(!cell_map.has(E->get()));
-		const Cell &c = cell_map[E->get()];
+void GridMap::_octant_update_multimesh(Octant::MultimeshInstance &p_mmi, const PoolVector<float> &p_buffer) {
 
-		if (!mesh_library.is_valid() || !mesh_library->has_item(c.item))
-			continue;
+	VS::get_singleton()->multimesh_allocate(p_mmi.multimesh, p_mmi.capacity, VS::MULTIMESH_TRANSFORM_3D, VS::MULTIMESH_COLOR_NONE);
+	VS::get_singleton()->multimesh_set_as_bulk_array(p_mmi.multimesh, p_buffer);
+	VS::get_singleton()->multimesh_set_visible_instances(p_mmi.multimesh, p_mmi.items.size());
+}
 
-		Vector3 cellpos = Vector3(E->get().x, E->get().y, E->get().z);
-		Vector3 ofs = _get_offset();
+void GridMap::_octant_add_cell(Octant &g, const IndexKey &p_key, const Cell &p_cell, const Transform &p_xform) {
 
-		Transform xform;
+	Vector<MeshLibrary::ShapeData> shapes = mesh_library->get_item_shapes(p_cell.item);
+	// add the item's shape at given xform to octant's static_body
+	for (int i = 0; i < shapes.size(); i++) {
+		// add the item's shape
+		if (!shapes[i].shape.is_valid())
+			continue;
+		PhysicsServer::get_singleton()->body_add_shape(g.static_body, shapes[i].shape->get_rid(), p_xform * shapes[i].local_transform);
+		g.shape_owners.push_back(p_key);
+	}
 
-		if (clip && ((clip_above && cellpos[clip_axis] > clip_floor) || (!clip_above && cellpos[clip_axis] < clip_floor))) {
+	// add the item's navmesh at given xform to GridMap's Navigation ancestor
+	Ref<NavigationMesh> navmesh = mesh_library->get_item_navmesh(p_cell.item);
+	if (navmesh.is_valid()) {
+		Octant::NavMesh nm;
+		nm.xform = p_xform * mesh_library->get_item_navmesh_transform(p_cell.item);
 
+		if (navigation) {
+			nm.id = navigation->navmesh_add(navmesh, p_xform, this);
 		} else {
+			nm.id = -1;
 		}
+		g.navmesh_ids[p_key] = nm;
+	}
+}
 
-		xform.basis.set_orthogonal_index(c.rot);
-		xform.set_origin(cellpos * cell_size + ofs);
-		xform.basis.scale(Vector3(cell_scale, cell_scale, cell_scale));
-		if (baked_meshes.size() == 0) {
-			if (mesh_library->get_item_mesh(c.item).is_valid()) {
-				if (!multimesh_items.has(c.item)) {
-					multimesh_items[c.item] = List<Pair<Transform, IndexKey> >();
-				}
+void GridMap::_octant_remove_cell(Octant &g, const IndexKey &p_key) {
 
-				Pair<Transform, IndexKey> p;
-				p.first = xform;
-				p.second = E->get();
-				multimesh_items[c.item].push_back(p);
-			}
+	//body shapes, from the back so the remaining indices stay valid
+	for (int i = g.shape_owners.size() - 1; i >= 0; i--) {
+		if (g.shape_owners[i].key == p_key.key) {
+			PhysicsServer::get_singleton()->body_remove_shape(g.static_body, i);
+			g.shape_owners.remove(i);
 		}
+	}
 
-		Vector<MeshLibrary::ShapeData> shapes = mesh_library->get_item_shapes(c.item);
-		// add the item's shape at given xform to octant's static_body
-		for (int i = 0; i < shapes.size(); i++) {
-			// add the item's shape
-			if (!shapes[i].shape.is_valid())
-				continue;
-			PhysicsServer::get_singleton()->body_add_shape(g.static_body, shapes[i].shape->get_rid(), xform * shapes[i].local_transform);
-			if (g.collision_debug.is_valid()) {
-				shapes.write[i].shape->add_vertices_to_array(col_debug, xform * shapes[i].local_transform);
-			}
+	Map<IndexKey, Octant::NavMesh>::Element *N = g.navmesh_ids.find(p_key);
+	if (N) {
+		if (navigation && N->get().id >= 0) {
+			navigation->navmesh_remove(N->get().id);
 		}
+		g.navmesh_ids.erase(N);
+	}
 
-		// add the item's navmesh at given xform to GridMap's Navigation ancestor
-		Ref<NavigationMesh> navmesh = mesh_library->get_item_navmesh(c.item);
-		if (navmesh.is_valid()) {
-			Octant::NavMesh nm;
-			nm.xform = xform * mesh_library->get_item_navmesh_transform(c.item);
+	for (int i = 0; i < g.multimesh_instances.size(); i++) {
 
-			if (navigation) {
-				nm.id = navigation->navmesh_add(navmesh, xform, this);
-			} else {
-				nm.id = -1;
-			}
-			g.navmesh_ids[E->get()] = nm;
+		Octant::MultimeshInstance &mmi = g.multimesh_instances.write[i];
+		Map<IndexKey, int>::Element *S = mmi.slots.find(p_key);
+		if (!S) {
+			continue;
 		}
-	}
 
-	//update multimeshes, only if not baked
-	if (baked_meshes.size() == 0) {
+		//move the last instance into the freed slot and shrink the visible range
+		int slot = S->get();
+		int last = mmi.items.size() - 1;
+		mmi.slots.erase(S);
 
-		for (Map<int, List<Pair<Transform, IndexKey> > >::Element *E = multimesh_items.front(); E; E = E->next()) {
-			Octant::MultimeshInstance mmi;
+		if (slot != last) {
+			mmi.items.write[slot] = mmi.items[last];
+			mmi.items.write[slot].index = slot;
+			mmi.slots[mmi.items[slot].key] = slot;
+			VS::get_singleton()->multimesh_instance_set_transform(mmi.multimesh, slot, mmi.items[slot].transform);
+		}
 
-			RID mm = VS::get_singleton()->multimesh_create();
-			VS::get_singleton()->multimesh_allocate(mm, E->get().size(), VS::MULTIMESH_TRANSFORM_3D, VS::MULTIMESH_COLOR_NONE);
-			VS::get_singleton()->multimesh_set_mesh(mm, mesh_library->get_item_mesh(E->key())->get_rid());
+		mmi.items.resize(last);
+		if (last > 0) {
+			VS::get_singleton()->multimesh_instance_set_transform(mmi.multimesh, last, mmi.items[0].transform);
+		}
+		VS::get_singleton()->multimesh_set_visible_instances(mmi.multimesh, last);
+		break;
+	}
+}
 
-			int idx = 0;
-			for (List<Pair<Transform, IndexKey> >::Element *F = E->get().front(); F; F = F->next()) {
-				VS::get_singleton()->multimesh_instance_set_transform(mm, idx, F->get().first);
-#ifdef TOOLS_ENABLED
+void GridMap::_octant_update_collision_debug(Octant &g) {
 
-				Octant::MultimeshInstance::Item it;
-				it.index = idx;
-				it.transform = F->get().first;
-				it.key = F->get().second;
-				mmi.items.push_back(it);
-#endif
+	if (!g.collision_debug.is_valid())
+		return;
 
-				idx++;
-			}
+	VS::get_singleton()->mesh_clear(g.collision_debug);
 
-			RID instance = VS::get_singleton()->instance_create();
-			VS::get_singleton()->instance_set_base(instance, mm);
+	if (!mesh_library.is_valid())
+		return;
 
-			if (is_inside_tree()) {
-				VS::get_singleton()->instance_set_scenario(instance, get_world()->get_scenario());
-				VS::get_singleton()->instance_set_transform(instance, get_global_transform());
-			}
+	PoolVector<Vector3> col_debug;
 
-			mmi.multimesh = mm;
-			mmi.instance = instance;
+	for (Set<IndexKey>::Element *E = g.cells.front(); E; E = E->next()) {
+
+		const Map<IndexKey, Cell>::Element *C = cell_map.find(E->get());
+		if (!C || !mesh_library->has_item(C->get().item))
+			continue;
 
-			g.multimesh_instances.push_back(mmi);
+		Transform xform = _cell_get_transform(E->get(), C->get());
+		Vector<MeshLibrary::ShapeData> shapes = mesh_library->get_item_shapes(C->get().item);
+		for (int i = 0; i < shapes.size(); i++) {
+			if (!shapes[i].shape.is_valid())
+				continue;
+			shapes.write[i].shape->add_vertices_to_array(col_debug, xform * shapes[i].local_transform);
 		}
 	}
 
@@ -580,23 +659,144 @@ bool GridMap::_octant_update(const OctantKey &p_key) {
 			VS::get_singleton()->mesh_surface_set_material(g.collision_debug, 0, st->get_debug_collision_material()->get_rid());
 		}
 	}
+}
+
+void GridMap::_octant_rebuild(Octant &g) {
+
+	//erase body shapes
+	PhysicsServer::get_singleton()->body_clear_shapes(g.static_body);
+	g.shape_owners.clear();
+
+	//erase navigation
+	if (navigation) {
+		for (Map<IndexKey, Octant::NavMesh>::Element *E = g.navmesh_ids.front(); E; E = E->next()) {
+			navigation->navmesh_remove(E->get().id);
+		}
+	}
+	g.navmesh_ids.clear();
+
+	//erase multimeshes
+	for (int i = 0; i < g.multimesh_instances.size(); i++) {
+
+		VS::get_singleton()->free(g.multimesh_instances[i].instance);
+		VS::get_singleton()->free(g.multimesh_instances[i].multimesh);
+	}
+	g.multimesh_instances.clear();
+	g.item_multimesh.clear();
+
+	if (!g.pending_ready) {
+		Octant *octant = &g;
+		_octant_prepare_rebuild_job(0, &octant);
+	}
+
+	for (Set<IndexKey>::Element *E = g.cells.front(); E; E = E->next()) {
+
+		const Map<IndexKey, Cell>::Element *C = cell_map.find(E->get());
+		ERR_CONTINUE(!C);
+
+		if (!mesh_library.is_valid() || !mesh_library->has_item(C->get().item))
+			continue;
+
+		_octant_add_cell(g, E->get(), C->get(), _cell_get_transform(E->get(), C->get()));
+	}
+
+	//swap in the multimesh data prepared for this octant
+	for (int i = 0; i < g.pending_multimeshes.size(); i++) {
+
+		const Octant::PendingMultimesh &pm = g.pending_multimeshes[i];
+		Octant::MultimeshInstance &mmi = g.multimesh_instances.write[_octant_get_multimesh(g, pm.item)];
+
+		mmi.items = pm.items;
+		for (int j = 0; j < mmi.items.size(); j++) {
+			mmi.slots[mmi.items[j].key] = j;
+		}
+		mmi.capacity = mmi.items.size();
+		_octant_update_multimesh(mmi, pm.buffer);
+	}
+
+	g.pending_multimeshes.clear();
+	g.pending_ready = false;
+}
+
+bool GridMap::_octant_update(const OctantKey &p_key) {
+	Octant **G = octant_map.getptr(p_key);
+	ERR_FAIL_COND_V(!G, false);
+	Octant &g = **G;
+	if (!g.dirty)
+		return false;
+
+	if (g.cells.size() == 0) {
+		//octant no longer needed
+		_octant_clean_up(p_key);
+		return true;
+	}
+
+	if (_octant_needs_rebuild(g)) {
+
+		_octant_rebuild(g);
+
+	} else {
+
+		//patch only the cells that changed since the last update
+		for (Set<IndexKey>::Element *E = g.dirty_cells.front(); E; E = E->next()) {
+
+			_octant_remove_cell(g, E->get());
+
+			const Map<IndexKey, Cell>::Element *C = cell_map.find(E->get());
+			if (!C || !g.cells.has(E->get()) || !mesh_library.is_valid() || !mesh_library->has_item(C->get().item))
+				continue;
+
+			const Cell &c = C->get();
+			Transform xform = _cell_get_transform(E->get(), c);
+			_octant_add_cell(g, E->get(), c, xform);
+
+			if (baked_meshes.size() == 0 && mesh_library->get_item_mesh(c.item).is_valid()) {
+
+				Octant::MultimeshInstance &mmi = g.multimesh_instances.write[_octant_get_multimesh(g, c.item)];
+
+				Octant::MultimeshInstance::Item it;
+				it.index = mmi.items.size();
+				it.transform = xform;
+				it.key = E->get();
+				mmi.slots[it.key] = it.index;
+				mmi.items.push_back(it);
+
+				if (mmi.items.size() > mmi.capacity) {
+					//out of slots, reallocate with room to grow
+					mmi.capacity = next_power_of_2(mmi.items.size());
+					PoolVector<float> buffer;
+					_fill_multimesh_buffer(mmi.items, mmi.capacity, buffer);
+					_octant_update_multimesh(mmi, buffer);
+				} else {
+					VS::get_singleton()->multimesh_instance_set_transform(mmi.multimesh, it.index, xform);
+					VS::get_singleton()->multimesh_set_visible_instances(mmi.multimesh, mmi.items.size());
+				}
+			}
+		}
+	}
 
+	_octant_update_collision_debug(g);
+
+	g.dirty_cells.clear();
 	g.dirty = false;
+	g.rebuild = false;
 
 	return false;
 }
 
 void GridMap::_reset_physic_bodies_collision_filters() {
-	for (Map<OctantKey, Octant *>::Element *E = octant_map.front(); E; E = E->next()) {
-		PhysicsServer::get_singleton()->body_set_collision_layer(E->get()->static_body, collision_layer);
-		PhysicsServer::get_singleton()->body_set_collision_mask(E->get()->static_body, collision_mask);
+	for (const OctantKey *K = octant_map.next(NULL); K; K = octant_map.next(K)) {
+		Octant *g = octant_map[*K];
+		PhysicsServer::get_singleton()->body_set_collision_layer(g->static_body, collision_layer);
+		PhysicsServer::get_singleton()->body_set_collision_mask(g->static_body, collision_mask);
 	}
 }
 
 void GridMap::_octant_enter_world(const OctantKey &p_key) {
 
-	ERR_FAIL_COND(!octant_map.has(p_key));
-	Octant &g = *octant_map[p_key];
+	Octant **G = octant_map.getptr(p_key);
+	ERR_FAIL_COND(!G);
+	Octant &g = **G;
 	PhysicsServer::get_singleton()->body_set_state(g.static_body, PhysicsServer::BODY_STATE_TRANSFORM, get_global_transform());
 	PhysicsServer::get_singleton()->body_set_space(g.static_body, get_world()->get_space());
 
@@ -625,8 +825,9 @@ void GridMap::_octant_enter_world(const OctantKey &p_key) {
 
 void GridMap::_octant_exit_world(const OctantKey &p_key) {
 
-	ERR_FAIL_COND(!octant_map.has(p_key));
-	Octant &g = *octant_map[p_key];
+	Octant **G = octant_map.getptr(p_key);
+	ERR_FAIL_COND(!G);
+	Octant &g = **G;
 	PhysicsServer::get_singleton()->body_set_state(g.static_body, PhysicsServer::BODY_STATE_TRANSFORM, get_global_transform());
 	PhysicsServer::get_singleton()->body_set_space(g.static_body, RID());
 
@@ -652,8 +853,9 @@ void GridMap::_octant_exit_world(const OctantKey &p_key) {
 
 void GridMap::_octant_clean_up(const OctantKey &p_key) {
 
-	ERR_FAIL_COND(!octant_map.has(p_key));
-	Octant &g = *octant_map[p_key];
+	Octant **G = octant_map.getptr(p_key);
+	ERR_FAIL_COND(!G);
+	Octant &g = **G;
 
 	if (g.collision_debug.is_valid())
 		VS::get_singleton()->free(g.collision_debug);
@@ -698,8 +900,8 @@ void GridMap::_notification(int p_what) {
 
 			last_transform = get_global_transform();
 
-			for (Map<OctantKey, Octant *>::Element *E = octant_map.front(); E; E = E->next()) {
-				_octant_enter_world(E->key());
+			for (const OctantKey *K = octant_map.next(NULL); K; K = octant_map.next(K)) {
+				_octant_enter_world(*K);
 			}
 
 			for (int i = 0; i < baked_meshes.size(); i++) {
@@ -714,8 +916,8 @@ void GridMap::_notification(int p_what) {
 			if (new_xform == last_transform)
 				break;
 			//update run
-			for (Map<OctantKey, Octant *>::Element *E = octant_map.front(); E; E = E->next()) {
-				_octant_transform(E->key());
+			for (const OctantKey *K = octant_map.next(NULL); K; K = octant_map.next(K)) {
+				_octant_transform(*K);
 			}
 
 			last_transform = new_xform;
@@ -727,8 +929,8 @@ void GridMap::_notification(int p_what) {
 		} break;
 		case NOTIFICATION_EXIT_WORLD: {
 
-			for (Map<OctantKey, Octant *>::Element *E = octant_map.front(); E; E = E->next()) {
-				_octant_exit_world(E->key());
+			for (const OctantKey *K = octant_map.next(NULL); K; K = octant_map.next(K)) {
+				_octant_exit_world(*K);
 			}
 
 			navigation = NULL;
@@ -753,8 +955,8 @@ void GridMap::_update_visibility() {
 
 	_change_notify("visible");
 
-	for (Map<OctantKey, Octant *>::Element *e = octant_map.front(); e; e = e->next()) {
-		Octant *octant = e->value();
+	for (const OctantKey *K = octant_map.next(NULL); K; K = octant_map.next(K)) {
+		Octant *octant = octant_map[*K];
 		for (int i = 0; i < octant->multimesh_instances.size(); i++) {
 			const Octant::MultimeshInstance &mi = octant->multimesh_instances[i];
 			VS::get_singleton()->instance_set_visible(mi.instance, is_visible());
@@ -785,12 +987,12 @@ void GridMap::_recreate_octant_data() {
 
 void GridMap::_clear_internal() {
 
-	for (Map<OctantKey, Octant *>::Element *E = octant_map.front(); E; E = E->next()) {
+	for (const OctantKey *K = octant_map.next(NULL); K; K = octant_map.next(K)) {
 		if (is_inside_world())
-			_octant_exit_world(E->key());
+			_octant_exit_world(*K);
 
-		_octant_clean_up(E->key());
-		memdelete(E->get());
+		_octant_clean_up(*K);
+		memdelete(octant_map[*K]);
 	}
 
 	octant_map.clear();
@@ -813,23 +1015,57 @@ void GridMap::_update_octants_callback() {
 	if (!awaiting_update)
 		return;
 
+	//octants that must be rebuilt from scratch have their multimesh data prepared in parallel first
+	Vector<Octant *> to_rebuild;
+	for (const OctantKey *K = octant_map.next(NULL); K; K = octant_map.next(K)) {
+
+		Octant *g = octant_map[*K];
+		if (_octant_needs_rebuild(*g)) {
+			to_rebuild.push_back(g);
+		}
+	}
+
+	if (to_rebuild.size()) {
+		if (octant_pool) {
+			octant_pool->do_work(to_rebuild.size(), this, &GridMap::_octant_prepare_rebuild_job, to_rebuild.ptrw());
+		} else {
+			for (int i = 0; i < to_rebuild.size(); i++) {
+				_octant_prepare_rebuild_job(i, to_rebuild.ptrw());
+			}
+		}
+	}
+
 	List<OctantKey> to_delete;
-	for (Map<OctantKey, Octant *>::Element *E = octant_map.front(); E; E = E->next()) {
+	for (const OctantKey *K = octant_map.next(NULL); K; K = octant_map.next(K)) {
 
-		if (_octant_update(E->key())) {
-			to_delete.push_back(E->key());
+		if (_octant_update(*K)) {
+			to_delete.push_back(*K);
 		}
 	}
 
-	while (to_delete.front()) {
-		octant_map.erase(to_delete.front()->get());
-		to_delete.pop_back();
+	for (List<OctantKey>::Element *E = to_delete.front(); E; E = E->next()) {
+		octant_map.erase(E->get());
 	}
 
 	_update_visibility();
 	awaiting_update = false;
 }
 
+ThreadWorkPool *GridMap::octant_pool = NULL;
+
+void GridMap::set_threaded_octant_rebuild(bool p_enable) {
+
+#ifndef NO_THREADS
+	if (p_enable && !octant_pool) {
+		octant_pool = memnew(ThreadWorkPool);
+		octant_pool->init();
+	} else if (!p_enable && octant_pool) {
+		memdelete(octant_pool);
+		octant_pool = NULL;
+	}
+#endif
+}
+
 void GridMap::_bind_methods() {
 
 	ClassDB::bind_method(D_METHOD("set_collision_layer", "layer"), &GridMap::set_collision_layer);
@@ -923,9 +1159,9 @@ void GridMap::set_clip(bool p_enabled, bool p_clip_above, int p_floor, Vector3::
 	clip_above = p_clip_above;
 
 	//make it all update
-	for (Map<OctantKey, Octant *>::Element *E = octant_map.front(); E; E = E->next()) {
+	for (const OctantKey *K = octant_map.next(NULL); K; K = octant_map.next(K)) {
 
-		Octant *g = E->get();
+		Octant *g = octant_map[*K];
 		g->dirty = true;
 	}
 	awaiting_update = true;
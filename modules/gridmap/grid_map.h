@@ -31,6 +31,8 @@
 #ifndef GRID_MAP_H
 #define GRID_MAP_H
 
+#include "core/hash_map.h"
+#include "core/os/thread_work_pool.h"
 #include "scene/3d/navigation.h"
 #include "scene/3d/spatial.h"
 #include "scene/resources/mesh_library.h"
@@ -98,23 +100,39 @@ class GridMap : public Spatial {
 		struct MultimeshInstance {
 			RID instance;
 			RID multimesh;
+			int capacity;
 			struct Item {
 				int index;
 				Transform transform;
 				IndexKey key;
 			};
 
-			Vector<Item> items; //tools only, for changing visibility
+			Vector<Item> items; //one per used instance slot, in slot order
+			Map<IndexKey, int> slots;
+		};
+
+		struct PendingMultimesh {
+			int item;
+			Vector<MultimeshInstance::Item> items;
+			PoolVector<float> buffer;
 		};
 
 		Vector<MultimeshInstance> multimesh_instances;
+		Map<int, int> item_multimesh; //mesh library item to index in multimesh_instances
 		Set<IndexKey> cells;
+		Set<IndexKey> dirty_cells; //changed since the last update, patched in place unless rebuilding
+		Vector<IndexKey> shape_owners; //cell owning each shape of static_body, in shape order
 		RID collision_debug;
 		RID collision_debug_instance;
 
 		bool dirty;
+		bool rebuild;
 		RID static_body;
 		Map<IndexKey, NavMesh> navmesh_ids;
+
+		//back buffer for full rebuilds, filled off the main thread and swapped in by _octant_update()
+		Vector<PendingMultimesh> pending_multimeshes;
+		bool pending_ready;
 	};
 
 	union OctantKey {
@@ -133,10 +151,19 @@ class GridMap : public Spatial {
 			return key < p_key.key;
 		}
 
+		_FORCE_INLINE_ bool operator==(const OctantKey &p_key) const {
+
+			return key == p_key.key;
+		}
+
 		//OctantKey(const IndexKey& p_k, int p_item) { indexkey=p_k.key; item=p_item; }
 		OctantKey() { key = 0; }
 	};
 
+	struct OctantKeyHasher {
+		static _FORCE_INLINE_ uint32_t hash(const OctantKey &p_key) { return hash_one_uint64(p_key.key); }
+	};
+
 	uint32_t collision_layer;
 	uint32_t collision_mask;
 
@@ -159,7 +186,7 @@ class GridMap : public Spatial {
 
 	Ref<MeshLibrary> mesh_library;
 
-	Map<OctantKey, Octant *> octant_map;
+	HashMap<OctantKey, Octant *, OctantKeyHasher> octant_map;
 	Map<IndexKey, Cell> cell_map;
 
 	void _recreate_octant_data();
@@ -177,6 +204,19 @@ class GridMap : public Spatial {
 		return Vector3(p_key.x, p_key.y, p_key.z) * cell_size * octant_size;
 	}
 
+	static ThreadWorkPool *octant_pool;
+
+	Transform _cell_get_transform(const IndexKey &p_key, const Cell &p_cell) const;
+	bool _octant_needs_rebuild(const Octant &p_octant) const;
+	void _octant_prepare_rebuild_job(uint32_t p_index, Octant **p_octants);
+	void _octant_rebuild(Octant &g);
+	void _octant_add_cell(Octant &g, const IndexKey &p_key, const Cell &p_cell, const Transform &p_xform);
+	void _octant_remove_cell(Octant &g, const IndexKey &p_key);
+	int _octant_get_multimesh(Octant &g, int p_item);
+	static void _fill_multimesh_buffer(const Vector<Octant::MultimeshInstance::Item> &p_items, int p_capacity, PoolVector<float> &r_buffer);
+	void _octant_update_multimesh(Octant::MultimeshInstance &p_mmi, const PoolVector<float> &p_buffer);
+	void _octant_update_collision_debug(Octant &g);
+
 	void _reset_physic_bodies_collision_filters();
 	void _octant_enter_world(const OctantKey &p_key);
 	void _octant_exit_world(const OctantKey &p_key);
@@ -272,6 +312,8 @@ public:
 	Array get_bake_meshes();
 	RID get_bake_mesh_instance(int p_idx);
 
+	static void set_threaded_octant_rebuild(bool p_enable);
+
 	GridMap();
 	~GridMap();
 };
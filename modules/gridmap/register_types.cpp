@@ -31,6 +31,8 @@
 #include "register_types.h"
 #ifndef _3D_DISABLED
 #include "core/class_db.h"
+#include "core/engine.h"
+#include "core/project_settings.h"
 #include "grid_map.h"
 #include "grid_map_editor_plugin.h"
 #endif
@@ -39,6 +41,7 @@ void register_gridmap_types() {
 
 #ifndef _3D_DISABLED
 	ClassDB::register_class<GridMap>();
+	GridMap::set_threaded_octant_rebuild(GLOBAL_DEF("rendering/gridmap/threaded_octant_rebuild", true) && !Engine::get_singleton()->is_editor_hint());
 #ifdef TOOLS_ENABLED
 	EditorPlugins::add_by_type<GridMapEditorPlugin>();
 #endif
@@ -46,4 +49,8 @@ void register_gridmap_types() {
 }
 
 void unregister_gridmap_types() {
+
+#ifndef _3D_DISABLED
+	GridMap::set_threaded_octant_rebuild(false);
+#endif
 }
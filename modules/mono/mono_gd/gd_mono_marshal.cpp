@@ -797,8 +797,8 @@ MonoArray *PoolIntArray_to_mono_array(const PoolIntArray &p_array) {
 
 	MonoArray *ret = mono_array_new(mono_domain_get(), CACHED_CLASS_RAW(int32_t), p_array.size());
 
-	for (int i = 0; i < p_array.size(); i++) {
-		mono_array_set(ret, int32_t, i, r[i]);
+	if (p_array.size()) {
+		copymem(mono_array_addr_with_size(ret, sizeof(int32_t), 0), r.ptr(), p_array.size() * sizeof(int32_t));
 	}
 
 	return ret;
@@ -810,10 +810,10 @@ PoolIntArray mono_array_to_PoolIntArray(MonoArray *p_array) {
 		return ret;
 	int length = mono_array_length(p_array);
 	ret.resize(length);
-	PoolIntArray::Write w = ret.write();
 
-	for (int i = 0; i < length; i++) {
-		w[i] = mono_array_get(p_array, int32_t, i);
+	if (length) {
+		PoolIntArray::Write w = ret.write();
+		copymem(w.ptr(), mono_array_addr_with_size(p_array, sizeof(int32_t), 0), length * sizeof(int32_t));
 	}
 
 	return ret;
@@ -824,8 +824,8 @@ MonoArray *PoolByteArray_to_mono_array(const PoolByteArray &p_array) {
 
 	MonoArray *ret = mono_array_new(mono_domain_get(), CACHED_CLASS_RAW(uint8_t), p_array.size());
 
-	for (int i = 0; i < p_array.size(); i++) {
-		mono_array_set(ret, uint8_t, i, r[i]);
+	if (p_array.size()) {
+		copymem(mono_array_addr_with_size(ret, sizeof(uint8_t), 0), r.ptr(), p_array.size() * sizeof(uint8_t));
 	}
 
 	return ret;
@@ -837,10 +837,10 @@ PoolByteArray mono_array_to_PoolByteArray(MonoArray *p_array) {
 		return ret;
 	int length = mono_array_length(p_array);
 	ret.resize(length);
-	PoolByteArray::Write w = ret.write();
 
-	for (int i = 0; i < length; i++) {
-		w[i] = mono_array_get(p_array, uint8_t, i);
+	if (length) {
+		PoolByteArray::Write w = ret.write();
+		copymem(w.ptr(), mono_array_addr_with_size(p_array, sizeof(uint8_t), 0), length * sizeof(uint8_t));
 	}
 
 	return ret;
@@ -851,8 +851,8 @@ MonoArray *PoolRealArray_to_mono_array(const PoolRealArray &p_array) {
 
 	MonoArray *ret = mono_array_new(mono_domain_get(), REAL_T_MONOCLASS, p_array.size());
 
-	for (int i = 0; i < p_array.size(); i++) {
-		mono_array_set(ret, real_t, i, r[i]);
+	if (p_array.size()) {
+		copymem(mono_array_addr_with_size(ret, sizeof(real_t), 0), r.ptr(), p_array.size() * sizeof(real_t));
 	}
 
 	return ret;
@@ -864,10 +864,10 @@ PoolRealArray mono_array_to_PoolRealArray(MonoArray *p_array) {
 		return ret;
 	int length = mono_array_length(p_array);
 	ret.resize(length);
-	PoolRealArray::Write w = ret.write();
 
-	for (int i = 0; i < length; i++) {
-		w[i] = mono_array_get(p_array, real_t, i);
+	if (length) {
+		PoolRealArray::Write w = ret.write();
+		copymem(w.ptr(), mono_array_addr_with_size(p_array, sizeof(real_t), 0), length * sizeof(real_t));
 	}
 
 	return ret;
@@ -907,6 +907,13 @@ MonoArray *PoolColorArray_to_mono_array(const PoolColorArray &p_array) {
 
 	MonoArray *ret = mono_array_new(mono_domain_get(), CACHED_CLASS_RAW(Color), p_array.size());
 
+	if (InteropLayout::MATCHES_Color) {
+		if (p_array.size()) {
+			copymem(mono_array_addr_with_size(ret, sizeof(M_Color), 0), r.ptr(), p_array.size() * sizeof(M_Color));
+		}
+		return ret;
+	}
+
 	for (int i = 0; i < p_array.size(); i++) {
 		M_Color *raw = (M_Color *)mono_array_addr_with_size(ret, sizeof(M_Color), i);
 		*raw = MARSHALLED_OUT(Color, r[i]);
@@ -923,6 +930,13 @@ PoolColorArray mono_array_to_PoolColorArray(MonoArray *p_array) {
 	ret.resize(length);
 	PoolColorArray::Write w = ret.write();
 
+	if (InteropLayout::MATCHES_Color) {
+		if (length) {
+			copymem(w.ptr(), mono_array_addr_with_size(p_array, sizeof(M_Color), 0), length * sizeof(M_Color));
+		}
+		return ret;
+	}
+
 	for (int i = 0; i < length; i++) {
 		w[i] = MARSHALLED_IN(Color, (M_Color *)mono_array_addr_with_size(p_array, sizeof(M_Color), i));
 	}
@@ -935,6 +949,13 @@ MonoArray *PoolVector2Array_to_mono_array(const PoolVector2Array &p_array) {
 
 	MonoArray *ret = mono_array_new(mono_domain_get(), CACHED_CLASS_RAW(Vector2), p_array.size());
 
+	if (InteropLayout::MATCHES_Vector2) {
+		if (p_array.size()) {
+			copymem(mono_array_addr_with_size(ret, sizeof(M_Vector2), 0), r.ptr(), p_array.size() * sizeof(M_Vector2));
+		}
+		return ret;
+	}
+
 	for (int i = 0; i < p_array.size(); i++) {
 		M_Vector2 *raw = (M_Vector2 *)mono_array_addr_with_size(ret, sizeof(M_Vector2), i);
 		*raw = MARSHALLED_OUT(Vector2, r[i]);
@@ -951,6 +972,13 @@ PoolVector2Array mono_array_to_PoolVector2Array(MonoArray *p_array) {
 	ret.resize(length);
 	PoolVector2Array::Write w = ret.write();
 
+	if (InteropLayout::MATCHES_Vector2) {
+		if (length) {
+			copymem(w.ptr(), mono_array_addr_with_size(p_array, sizeof(M_Vector2), 0), length * sizeof(M_Vector2));
+		}
+		return ret;
+	}
+
 	for (int i = 0; i < length; i++) {
 		w[i] = MARSHALLED_IN(Vector2, (M_Vector2 *)mono_array_addr_with_size(p_array, sizeof(M_Vector2), i));
 	}
@@ -963,6 +991,13 @@ MonoArray *PoolVector3Array_to_mono_array(const PoolVector3Array &p_array) {
 
 	MonoArray *ret = mono_array_new(mono_domain_get(), CACHED_CLASS_RAW(Vector3), p_array.size());
 
+	if (InteropLayout::MATCHES_Vector3) {
+		if (p_array.size()) {
+			copymem(mono_array_addr_with_size(ret, sizeof(M_Vector3), 0), r.ptr(), p_array.size() * sizeof(M_Vector3));
+		}
+		return ret;
+	}
+
 	for (int i = 0; i < p_array.size(); i++) {
 		M_Vector3 *raw = (M_Vector3 *)mono_array_addr_with_size(ret, sizeof(M_Vector3), i);
 		*raw = MARSHALLED_OUT(Vector3, r[i]);
@@ -979,6 +1014,13 @@ PoolVector3Array mono_array_to_PoolVector3Array(MonoArray *p_array) {
 	ret.resize(length);
 	PoolVector3Array::Write w = ret.write();
 
+	if (InteropLayout::MATCHES_Vector3) {
+		if (length) {
+			copymem(w.ptr(), mono_array_addr_with_size(p_array, sizeof(M_Vector3), 0), length * sizeof(M_Vector3));
+		}
+		return ret;
+	}
+
 	for (int i = 0; i < length; i++) {
 		w[i] = MARSHALLED_IN(Vector3, (M_Vector3 *)mono_array_addr_with_size(p_array, sizeof(M_Vector3), i));
 	}
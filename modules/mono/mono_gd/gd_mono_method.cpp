@@ -100,41 +100,63 @@ void *GDMonoMethod::get_thunk() {
 }
 
 MonoObject *GDMonoMethod::invoke(MonoObject *p_object, const Variant **p_params, MonoException **r_exc) {
-	if (get_return_type().type_encoding != MONO_TYPE_VOID || get_parameters_count() > 0) {
-		MonoArray *params = mono_array_new(mono_domain_get(), CACHED_CLASS_RAW(MonoObject), get_parameters_count());
-
-		for (int i = 0; i < params_count; i++) {
-			MonoObject *boxed_param = GDMonoMarshal::variant_to_mono_object(p_params[i], param_types[i]);
-			mono_array_set(params, MonoObject *, i, boxed_param);
-		}
+	MonoException *exc = NULL;
+	MonoObject *ret;
 
-		MonoException *exc = NULL;
-		MonoObject *ret = GDMonoUtils::runtime_invoke_array(mono_method, p_object, params, &exc);
+	if (params_count > 0) {
+		// Arguments are passed by address instead of through a managed object array.
+		// Primitives are written to a native buffer so they don't need to be boxed.
+		void **params = (void **)alloca(sizeof(void *) * params_count);
+		int64_t *values = (int64_t *)alloca(sizeof(int64_t) * params_count);
 
-		if (exc) {
-			ret = NULL;
-			if (r_exc) {
-				*r_exc = exc;
-			} else {
-				GDMonoUtils::set_pending_exception(exc);
+		for (int i = 0; i < params_count; i++) {
+			void *value = &values[i];
+
+			switch (param_types[i].type_encoding) {
+				case MONO_TYPE_BOOLEAN: {
+					*(MonoBoolean *)value = p_params[i]->operator bool();
+				} break;
+				case MONO_TYPE_I4: {
+					*(int32_t *)value = p_params[i]->operator signed int();
+				} break;
+				case MONO_TYPE_I8: {
+					*(int64_t *)value = p_params[i]->operator int64_t();
+				} break;
+				case MONO_TYPE_R4: {
+					*(float *)value = p_params[i]->operator float();
+				} break;
+				case MONO_TYPE_R8: {
+					*(double *)value = p_params[i]->operator double();
+				} break;
+				default: {
+					MonoObject *boxed_param = GDMonoMarshal::variant_to_mono_object(p_params[i], param_types[i]);
+					// Value types are passed as a pointer to their data, reference types as the object itself
+					if (boxed_param && mono_class_is_valuetype(param_types[i].type_class->get_mono_ptr())) {
+						value = mono_object_unbox(boxed_param);
+					} else {
+						value = boxed_param;
+					}
+				} break;
 			}
+
+			params[i] = value;
 		}
 
-		return ret;
+		ret = GDMonoUtils::runtime_invoke(mono_method, p_object, params, &exc);
 	} else {
-		MonoException *exc = NULL;
-		GDMonoUtils::runtime_invoke(mono_method, p_object, NULL, &exc);
-
-		if (exc) {
-			if (r_exc) {
-				*r_exc = exc;
-			} else {
-				GDMonoUtils::set_pending_exception(exc);
-			}
-		}
+		ret = GDMonoUtils::runtime_invoke(mono_method, p_object, NULL, &exc);
+	}
 
-		return NULL;
+	if (exc) {
+		ret = NULL;
+		if (r_exc) {
+			*r_exc = exc;
+		} else {
+			GDMonoUtils::set_pending_exception(exc);
+		}
 	}
+
+	return ret;
 }
 
 MonoObject *GDMonoMethod::invoke(MonoObject *p_object, MonoException **r_exc) {
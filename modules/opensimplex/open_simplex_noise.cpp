@@ -31,6 +31,7 @@
 #include "open_simplex_noise.h"
 
 #include "core/core_string_names.h"
+#include "core/os/thread_work_pool.h"
 
 OpenSimplexNoise::OpenSimplexNoise() {
 
@@ -93,60 +94,81 @@ void OpenSimplexNoise::set_lacunarity(float p_lacunarity) {
 	emit_changed();
 }
 
+void OpenSimplexNoise::_image_row(uint32_t p_row, ImageJob *p_job) {
+
+	uint8_t *wd8 = p_job->data + p_row * p_job->size * 4;
+
+	for (int j = 0; j < p_job->size; j++) {
+		float v = get_noise_2d(p_row, j);
+		v = v * 0.5 + 0.5; // Normalize [0..1]
+		uint8_t value = uint8_t(CLAMP(v * 255.0, 0, 255));
+		wd8[j * 4 + 0] = value;
+		wd8[j * 4 + 1] = value;
+		wd8[j * 4 + 2] = value;
+		wd8[j * 4 + 3] = 255;
+	}
+}
+
 Ref<Image> OpenSimplexNoise::get_image(int p_width, int p_height) {
 
 	PoolVector<uint8_t> data;
 	data.resize(p_width * p_height * 4);
 
-	PoolVector<uint8_t>::Write wd8 = data.write();
-
-	for (int i = 0; i < p_height; i++) {
-		for (int j = 0; j < p_width; j++) {
-			float v = get_noise_2d(i, j);
-			v = v * 0.5 + 0.5; // Normalize [0..1]
-			uint8_t value = uint8_t(CLAMP(v * 255.0, 0, 255));
-			wd8[(i * p_width + j) * 4 + 0] = value;
-			wd8[(i * p_width + j) * 4 + 1] = value;
-			wd8[(i * p_width + j) * 4 + 2] = value;
-			wd8[(i * p_width + j) * 4 + 3] = 255;
-		}
+	{
+		PoolVector<uint8_t>::Write wd8 = data.write();
+
+		ImageJob job;
+		job.data = wd8.ptr();
+		job.size = p_width;
+		ThreadWorkPool::get_singleton()->do_work(p_height, this, &OpenSimplexNoise::_image_row, &job);
 	}
 
 	Ref<Image> image = memnew(Image(p_width, p_height, false, Image::FORMAT_RGBA8, data));
 	return image;
 }
 
-Ref<Image> OpenSimplexNoise::get_seamless_image(int p_size) {
+void OpenSimplexNoise::_seamless_image_row(uint32_t p_row, ImageJob *p_job) {
 
-	PoolVector<uint8_t> data;
-	data.resize(p_size * p_size * 4);
+	int size = p_job->size;
+	uint8_t *wd8 = p_job->data + p_row * size * 4;
 
-	PoolVector<uint8_t>::Write wd8 = data.write();
+	float ii = (float)p_row / (float)size;
+	ii *= 2.0 * Math_PI;
 
-	for (int i = 0; i < p_size; i++) {
-		for (int j = 0; j < p_size; j++) {
+	float radius = size / (2.0 * Math_PI);
+	float z = radius * Math::sin(ii);
+	float w = radius * Math::cos(ii);
 
-			float ii = (float)i / (float)p_size;
-			float jj = (float)j / (float)p_size;
+	for (int j = 0; j < size; j++) {
 
-			ii *= 2.0 * Math_PI;
-			jj *= 2.0 * Math_PI;
+		float jj = (float)j / (float)size;
+		jj *= 2.0 * Math_PI;
 
-			float radius = p_size / (2.0 * Math_PI);
+		float x = radius * Math::sin(jj);
+		float y = radius * Math::cos(jj);
+		float v = get_noise_4d(x, y, z, w);
 
-			float x = radius * Math::sin(jj);
-			float y = radius * Math::cos(jj);
-			float z = radius * Math::sin(ii);
-			float w = radius * Math::cos(ii);
-			float v = get_noise_4d(x, y, z, w);
+		v = v * 0.5 + 0.5; // Normalize [0..1]
+		uint8_t value = uint8_t(CLAMP(v * 255.0, 0, 255));
+		wd8[j * 4 + 0] = value;
+		wd8[j * 4 + 1] = value;
+		wd8[j * 4 + 2] = value;
+		wd8[j * 4 + 3] = 255;
+	}
+}
 
-			v = v * 0.5 + 0.5; // Normalize [0..1]
-			uint8_t value = uint8_t(CLAMP(v * 255.0, 0, 255));
-			wd8[(i * p_size + j) * 4 + 0] = value;
-			wd8[(i * p_size + j) * 4 + 1] = value;
-			wd8[(i * p_size + j) * 4 + 2] = value;
-			wd8[(i * p_size + j) * 4 + 3] = 255;
-		}
+Ref<Image> OpenSimplexNoise::get_seamless_image(int p_size) {
+
+	PoolVector<uint8_t> data;
+	data.resize(p_size * p_size * 4);
+
+	{
+		PoolVector<uint8_t>::Write wd8 = data.write();
+
+		ImageJob job;
+		job.data = wd8.ptr();
+		job.size = p_size;
+		ThreadWorkPool::get_singleton()->do_work(p_size, this, &OpenSimplexNoise::_seamless_image_row, &job);
 	}
 
 	Ref<Image> image = memnew(Image(p_size, p_size, false, Image::FORMAT_RGBA8, data));
@@ -180,6 +202,9 @@ void OpenSimplexNoise::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("get_noise_2dv", "pos"), &OpenSimplexNoise::get_noise_2dv);
 	ClassDB::bind_method(D_METHOD("get_noise_3dv", "pos"), &OpenSimplexNoise::get_noise_3dv);
 
+	ClassDB::bind_method(D_METHOD("get_noise_2d_batch", "points"), &OpenSimplexNoise::get_noise_2d_batch);
+	ClassDB::bind_method(D_METHOD("get_noise_3d_batch", "points"), &OpenSimplexNoise::get_noise_3d_batch);
+
 	ADD_PROPERTY(PropertyInfo(Variant::INT, "seed"), "set_seed", "get_seed");
 	ADD_PROPERTY(PropertyInfo(Variant::INT, "octaves", PROPERTY_HINT_RANGE, "1,6,1"), "set_octaves", "get_octaves");
 	ADD_PROPERTY(PropertyInfo(Variant::REAL, "period", PROPERTY_HINT_RANGE, "0.1,256.0,0.1"), "set_period", "get_period");
@@ -255,3 +280,120 @@ float OpenSimplexNoise::get_noise_4d(float x, float y, float z, float w) {
 
 	return sum / max;
 }
+
+// The batch versions give the same results as get_noise_2d/3d, but run each octave over a
+// whole chunk of points, so only one octave's permutation tables are in use at a time,
+// and split the chunks over the worker threads.
+
+void OpenSimplexNoise::_noise_2d_chunk(uint32_t p_chunk, BatchJob *p_job) {
+
+	int from = p_chunk * BATCH_CHUNK_SIZE;
+	int count = MIN(int(BATCH_CHUNK_SIZE), p_job->count - from);
+	const Vector2 *points = p_job->points_2d + from;
+	float *results = p_job->results + from;
+
+	float x[BATCH_CHUNK_SIZE];
+	float y[BATCH_CHUNK_SIZE];
+
+	for (int i = 0; i < count; i++) {
+		x[i] = points[i].x / period;
+		y[i] = points[i].y / period;
+		results[i] = _get_octave_noise_2d(0, x[i], y[i]);
+	}
+
+	float amp = 1.0;
+	float max = 1.0;
+
+	for (int o = 1; o < octaves; o++) {
+		amp *= persistence;
+		max += amp;
+		for (int i = 0; i < count; i++) {
+			x[i] *= lacunarity;
+			y[i] *= lacunarity;
+			results[i] += _get_octave_noise_2d(o, x[i], y[i]) * amp;
+		}
+	}
+
+	for (int i = 0; i < count; i++) {
+		results[i] /= max;
+	}
+}
+
+void OpenSimplexNoise::_noise_3d_chunk(uint32_t p_chunk, BatchJob *p_job) {
+
+	int from = p_chunk * BATCH_CHUNK_SIZE;
+	int count = MIN(int(BATCH_CHUNK_SIZE), p_job->count - from);
+	const Vector3 *points = p_job->points_3d + from;
+	float *results = p_job->results + from;
+
+	float x[BATCH_CHUNK_SIZE];
+	float y[BATCH_CHUNK_SIZE];
+	float z[BATCH_CHUNK_SIZE];
+
+	for (int i = 0; i < count; i++) {
+		x[i] = points[i].x / period;
+		y[i] = points[i].y / period;
+		z[i] = points[i].z / period;
+		results[i] = _get_octave_noise_3d(0, x[i], y[i], z[i]);
+	}
+
+	float amp = 1.0;
+	float max = 1.0;
+
+	for (int o = 1; o < octaves; o++) {
+		amp *= persistence;
+		max += amp;
+		for (int i = 0; i < count; i++) {
+			x[i] *= lacunarity;
+			y[i] *= lacunarity;
+			z[i] *= lacunarity;
+			results[i] += _get_octave_noise_3d(o, x[i], y[i], z[i]) * amp;
+		}
+	}
+
+	for (int i = 0; i < count; i++) {
+		results[i] /= max;
+	}
+}
+
+PoolVector<float> OpenSimplexNoise::get_noise_2d_batch(const PoolVector<Vector2> &p_points) {
+
+	PoolVector<float> results;
+	results.resize(p_points.size());
+	if (p_points.size() == 0)
+		return results;
+
+	PoolVector<Vector2>::Read r = p_points.read();
+	PoolVector<float>::Write w = results.write();
+
+	BatchJob job;
+	job.points_2d = r.ptr();
+	job.points_3d = NULL;
+	job.results = w.ptr();
+	job.count = p_points.size();
+	ThreadWorkPool::get_singleton()->do_work((job.count + BATCH_CHUNK_SIZE - 1) / BATCH_CHUNK_SIZE, this, &OpenSimplexNoise::_noise_2d_chunk, &job);
+
+	w = PoolVector<float>::Write();
+	return results;
+}
+
+PoolVector<float> OpenSimplexNoise::get_noise_3d_batch(const PoolVector<Vector3> &p_points) {
+
+	PoolVector<float> results;
+	results.resize(p_points.size());
+	if (p_points.size() == 0)
+		return results;
+
+	PoolVector<Vector3>::Read r = p_points.read();
+	PoolVector<float>::Write w = results.write();
+
+	BatchJob job;
+	job.points_2d = NULL;
+	job.points_3d = r.ptr();
+	job.results = w.ptr();
+	job.count = p_points.size();
+	ThreadWorkPool::get_singleton()->do_work((job.count + BATCH_CHUNK_SIZE - 1) / BATCH_CHUNK_SIZE, this, &OpenSimplexNoise::_noise_3d_chunk, &job);
+
+	w = PoolVector<float>::Write();
+	return results;
+}
@@ -49,6 +49,27 @@ class OpenSimplexNoise : public Resource {
 	float period; // Distance above which we start to see similarities. The higher, the longer "hills" will be on a terrain.
 	float lacunarity; // Controls period change across octaves. 2 is usually a good value to address all detail levels.
 
+	enum {
+		BATCH_CHUNK_SIZE = 1024 // points per job, evaluated an octave at a time
+	};
+
+	struct ImageJob {
+		uint8_t *data;
+		int size;
+	};
+
+	struct BatchJob {
+		const Vector2 *points_2d;
+		const Vector3 *points_3d;
+		float *results;
+		int count;
+	};
+
+	void _image_row(uint32_t p_row, ImageJob *p_job);
+	void _seamless_image_row(uint32_t p_row, ImageJob *p_job);
+	void _noise_2d_chunk(uint32_t p_chunk, BatchJob *p_job);
+	void _noise_3d_chunk(uint32_t p_chunk, BatchJob *p_job);
+
 public:
 	OpenSimplexNoise();
 	~OpenSimplexNoise();
@@ -77,6 +98,9 @@ public:
 	float get_noise_3d(float x, float y, float z);
 	float get_noise_4d(float x, float y, float z, float w);
 
+	PoolVector<float> get_noise_2d_batch(const PoolVector<Vector2> &p_points);
+	PoolVector<float> get_noise_3d_batch(const PoolVector<Vector3> &p_points);
+
 	_FORCE_INLINE_ float _get_octave_noise_2d(int octave, float x, float y) { return open_simplex_noise2(&(contexts[octave]), x, y); }
 	_FORCE_INLINE_ float _get_octave_noise_3d(int octave, float x, float y, float z) { return open_simplex_noise3(&(contexts[octave]), x, y, z); }
 	_FORCE_INLINE_ float _get_octave_noise_4d(int octave, float x, float y, float z, float w) { return open_simplex_noise4(&(contexts[octave]), x, y, z, w); }
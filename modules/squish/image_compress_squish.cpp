@@ -30,8 +30,62 @@
 
 #include "image_compress_squish.h"
 
+#include "core/os/threaded_array_processor.h"
+
 #include <squish.h>
 
+// Rows of 4x4 blocks are independent, so large images are (de)compressed in horizontal bands in parallel.
+struct SquishBandJob {
+
+	const uint8_t *src;
+	uint8_t *dst;
+	int width;
+	int height;
+	int flags;
+	int band_height;
+	int block_row_size;
+	bool decompress;
+
+	void process_band(uint32_t p_band, void *p_userdata) {
+
+		int from = p_band * band_height;
+		int rows = MIN(band_height, height - from);
+
+		if (decompress) {
+			squish::DecompressImage(dst + from * width * 4, width, rows, src + (from / 4) * block_row_size, flags);
+		} else {
+			squish::CompressImage(src + from * width * 4, width, rows, dst + (from / 4) * block_row_size, flags);
+		}
+	}
+};
+
+static void _squish_process(const uint8_t *p_src, uint8_t *p_dst, int p_width, int p_height, int p_flags, bool p_decompress) {
+
+	int bands = OS::get_singleton()->get_processor_count() * 4;
+	int block_rows = (p_height + 3) / 4;
+
+	if (bands <= 1 || block_rows < 2 || p_width * p_height < 256 * 256) {
+		if (p_decompress) {
+			squish::DecompressImage(p_dst, p_width, p_height, p_src, p_flags);
+		} else {
+			squish::CompressImage(p_src, p_width, p_height, p_dst, p_flags);
+		}
+		return;
+	}
+
+	SquishBandJob job;
+	job.src = p_src;
+	job.dst = p_dst;
+	job.width = p_width;
+	job.height = p_height;
+	job.flags = p_flags;
+	job.band_height = ((block_rows + bands - 1) / bands) * 4;
+	job.block_row_size = ((p_width + 3) / 4) * ((p_flags & (squish::kDxt1 | squish::kBc4)) ? 8 : 16);
+	job.decompress = p_decompress;
+
+	thread_process_array((p_height + job.band_height - 1) / job.band_height, &job, &SquishBandJob::process_band, (void *)NULL);
+}
+
 void image_decompress_squish(Image *p_image) {
 	int w = p_image->get_width();
 	int h = p_image->get_height();
@@ -66,7 +120,7 @@ void image_decompress_squish(Image *p_image) {
 		int src_ofs = 0, mipmap_size = 0, mipmap_w = 0, mipmap_h = 0;
 		p_image->get_mipmap_offset_size_and_dimensions(i, src_ofs, mipmap_size, mipmap_w, mipmap_h);
 		int dst_ofs = Image::get_image_mipmap_offset(p_image->get_width(), p_image->get_height(), target_format, i);
-		squish::DecompressImage(&wb[dst_ofs], w, h, &rb[src_ofs], squish_flags);
+		_squish_process(&rb[src_ofs], &wb[dst_ofs], w, h, squish_flags, true);
 		w >>= 1;
 		h >>= 1;
 	}
@@ -191,7 +245,7 @@ void image_compress_squish(Image *p_image, float p_lossy_quality, Image::Compres
 			int bh = h % 4 != 0 ? h + (4 - h % 4) : h;
 
 			int src_ofs = p_image->get_mipmap_offset(i);
-			squish::CompressImage(&rb[src_ofs], w, h, &wb[dst_ofs], squish_comp);
+			_squish_process(&rb[src_ofs], &wb[dst_ofs], w, h, squish_comp, false);
 			dst_ofs += (MAX(4, bw) * MAX(4, bh)) >> shift;
 			w = MAX(w / 2, 1);
 			h = MAX(h / 2, 1);
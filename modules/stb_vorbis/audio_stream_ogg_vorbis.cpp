@@ -32,10 +32,309 @@
 
 #include "core/os/file_access.h"
 
+SelfList<AudioStreamPlaybackOGGVorbis>::List AudioStreamPlaybackOGGVorbis::stream_list;
+Thread *AudioStreamPlaybackOGGVorbis::stream_thread = NULL;
+Semaphore *AudioStreamPlaybackOGGVorbis::stream_semaphore = NULL;
+Mutex *AudioStreamPlaybackOGGVorbis::stream_mutex = NULL;
+bool AudioStreamPlaybackOGGVorbis::stream_thread_exit = false;
+
+void AudioStreamPlaybackOGGVorbis::_stream_thread_func(void *p_userdata) {
+
+	while (true) {
+
+		stream_semaphore->wait();
+		if (stream_thread_exit)
+			break;
+
+		stream_mutex->lock();
+		for (SelfList<AudioStreamPlaybackOGGVorbis> *E = stream_list.first(); E; E = E->next()) {
+			if (E->self()->active) {
+				E->self()->_stream_fill();
+			}
+		}
+		stream_mutex->unlock();
+	}
+}
+
+void AudioStreamPlaybackOGGVorbis::_stream_thread_start() {
+
+	if (stream_mutex)
+		return;
+
+	stream_mutex = Mutex::create();
+#ifndef NO_THREADS
+	stream_semaphore = Semaphore::create();
+	if (stream_semaphore) {
+		stream_thread_exit = false;
+		stream_thread = Thread::create(_stream_thread_func, NULL);
+	}
+#endif
+	//without a thread, playbacks decode on the audio thread as they are mixed
+}
+
+void AudioStreamPlaybackOGGVorbis::finish_streaming() {
+
+	if (stream_thread) {
+		stream_thread_exit = true;
+		stream_semaphore->post();
+		Thread::wait_to_finish(stream_thread);
+		memdelete(stream_thread);
+		stream_thread = NULL;
+	}
+	if (stream_semaphore) {
+		memdelete(stream_semaphore);
+		stream_semaphore = NULL;
+	}
+	if (stream_mutex) {
+		memdelete(stream_mutex);
+		stream_mutex = NULL;
+	}
+}
+
+Error AudioStreamPlaybackOGGVorbis::_stream_open() {
+
+	if (ogg_stream) {
+		stb_vorbis_close(ogg_stream);
+		ogg_stream = NULL;
+	}
+
+	stream_file->seek(0);
+	read_pos = 0;
+	read_len = 0;
+	pending_frames = 0;
+	pending_pos = 0;
+
+	while (true) {
+
+		if (read_len == read_buffer.size()) {
+			read_buffer.resize(read_buffer.size() + STREAM_READ_CHUNK);
+		}
+		int got = stream_file->get_buffer(read_buffer.ptrw() + read_len, read_buffer.size() - read_len);
+		ERR_FAIL_COND_V(got <= 0, ERR_FILE_CORRUPT);
+		read_len += got;
+
+		int used = 0;
+		int error = 0;
+		ogg_stream = stb_vorbis_open_pushdata(read_buffer.ptr(), read_len, &used, &error, &ogg_alloc);
+		if (ogg_stream) {
+			read_pos = used;
+			return OK;
+		}
+
+		ERR_FAIL_COND_V(error != VORBIS_need_more_data, ERR_FILE_CORRUPT);
+	}
+}
+
+bool AudioStreamPlaybackOGGVorbis::_stream_decode_frame(float ***r_output, int *r_samples) {
+
+	while (true) {
+
+		int channels;
+		int used = stb_vorbis_decode_frame_pushdata(ogg_stream, read_buffer.ptr() + read_pos, read_len - read_pos, &channels, r_output, r_samples);
+		read_pos += used;
+
+		if (*r_samples > 0)
+			return true;
+
+		if (used == 0) {
+			//needs more data, keep what's left and read the next chunk
+			if (read_pos > 0) {
+				uint8_t *w = read_buffer.ptrw();
+				memmove(w, w + read_pos, read_len - read_pos);
+				read_len -= read_pos;
+				read_pos = 0;
+			}
+			if (read_len == read_buffer.size()) {
+				read_buffer.resize(read_buffer.size() + STREAM_READ_CHUNK); //packet larger than the buffer
+			}
+
+			int got = stream_file->get_buffer(read_buffer.ptrw() + read_len, read_buffer.size() - read_len);
+			if (got <= 0)
+				return false; //end of file
+			read_len += got;
+		}
+	}
+}
+
+void AudioStreamPlaybackOGGVorbis::_stream_seek(uint32_t p_frame) {
+
+	pending_frames = 0;
+	pending_pos = 0;
+	stream_ended = false;
+
+	PoolIntArray::Read table = vorbis_stream->seek_table.read();
+	int entries = ogg_stream ? vorbis_stream->seek_table.size() / 2 : 0; //reopen if the decoder was lost
+
+	//last page that ends before the requested frame
+	int entry = -1;
+	int lo = 0, hi = entries - 1;
+	while (lo <= hi) {
+		int mid = (lo + hi) / 2;
+		if (uint32_t(table[mid * 2]) <= p_frame) {
+			entry = mid;
+			lo = mid + 1;
+		} else {
+			hi = mid - 1;
+		}
+	}
+
+	while (true) {
+
+		if (entry < 0) {
+			if (_stream_open() != OK) {
+				stream_ended = true;
+				return;
+			}
+		} else {
+			stream_file->seek(table[entry * 2 + 1]);
+			read_pos = 0;
+			read_len = 0;
+			stb_vorbis_flush_pushdata(ogg_stream);
+		}
+
+		bool overshot = false;
+
+		while (true) {
+
+			float **output;
+			int samples;
+			if (!_stream_decode_frame(&output, &samples)) {
+				stream_ended = true; //past the end
+				return;
+			}
+
+			int loc = stb_vorbis_get_sample_offset(ogg_stream);
+			if (loc < 0)
+				continue; //position not known until the end of the current page
+
+			int start = MAX(loc - samples, 0);
+			if (uint32_t(start) > p_frame) {
+				overshot = true;
+				break;
+			}
+
+			if (uint32_t(loc) > p_frame) {
+				pending_output = output;
+				pending_frames = samples;
+				pending_pos = p_frame - start;
+				return;
+			}
+		}
+
+		if (!overshot || entry < 0)
+			return;
+
+		entry--; //started too late, try from the page before
+	}
+}
+
+void AudioStreamPlaybackOGGVorbis::_stream_fill() {
+
+	uint32_t serial = seek_serial;
+	if (serial != served_serial) {
+		//the audio thread doesn't read while a seek is pending, so the ring can be reset
+		ring_write = ring_read;
+		_stream_seek(seek_frame);
+		served_serial = serial;
+	}
+
+	AudioFrame *ring_w = ring.ptrw();
+	int channels = vorbis_stream->channels;
+
+	while (!stream_ended && ogg_stream) {
+
+		if (pending_pos >= pending_frames) {
+
+			float **output;
+			int samples;
+			if (!_stream_decode_frame(&output, &samples)) {
+
+				if (vorbis_stream->loop) {
+					_stream_seek(uint32_t(vorbis_stream->loop_offset * vorbis_stream->sample_rate));
+					continue;
+				}
+
+				stream_ended = true;
+				break;
+			}
+
+			pending_output = output;
+			pending_frames = samples;
+			pending_pos = 0;
+		}
+
+		uint32_t space = STREAM_RING_SIZE - (ring_write - ring_read);
+		if (space == 0)
+			break;
+
+		int todo = MIN(int(space), pending_frames - pending_pos);
+		const float *l = pending_output[0] + pending_pos;
+		const float *r = pending_output[channels > 1 ? 1 : 0] + pending_pos;
+		uint32_t pos = ring_write;
+
+		for (int i = 0; i < todo; i++) {
+
+			ring_w[(pos + i) & STREAM_RING_MASK] = AudioFrame(l[i], r[i]);
+		}
+
+		pending_pos += todo;
+		ring_write = pos + todo; //publish only once the frames are written
+	}
+}
+
+void AudioStreamPlaybackOGGVorbis::_mix_streamed(AudioFrame *p_buffer, int p_frames) {
+
+	if (!stream_thread) {
+		_stream_fill();
+	}
+
+	int mixed = 0;
+
+	if (served_serial == seek_serial) {
+
+		bool ended = stream_ended; //read before the ring, the last frames are published first
+		uint32_t available = ring_write - ring_read;
+		const AudioFrame *ring_r = ring.ptr();
+		uint32_t pos = ring_read;
+
+		mixed = MIN(int(available), p_frames);
+		for (int i = 0; i < mixed; i++) {
+			p_buffer[i] = ring_r[(pos + i) & STREAM_RING_MASK];
+		}
+		ring_read = pos + mixed;
+
+		frames_mixed += mixed;
+		uint32_t total_frames = uint32_t(vorbis_stream->length * vorbis_stream->sample_rate);
+		if (vorbis_stream->loop && total_frames > 0 && frames_mixed >= total_frames) {
+			uint32_t loop_frames = uint32_t(vorbis_stream->loop_offset * vorbis_stream->sample_rate);
+			frames_mixed = loop_frames + (frames_mixed - total_frames);
+			loops++;
+		}
+
+		if (ended && mixed == int(available)) {
+			active = false;
+		}
+	}
+
+	//not decoded in time (or still seeking), play silence rather than block the mix
+	for (int i = mixed; i < p_frames; i++) {
+		p_buffer[i] = AudioFrame(0, 0);
+	}
+
+	if (stream_thread) {
+		stream_semaphore->post();
+	}
+}
+
 void AudioStreamPlaybackOGGVorbis::_mix_internal(AudioFrame *p_buffer, int p_frames) {
 
 	ERR_FAIL_COND(!active);
 
+	if (stream_file) {
+		_mix_streamed(p_buffer, p_frames);
+		return;
+	}
+
 	int todo = p_frames;
 
 	int start_buffer = 0;
@@ -115,12 +414,57 @@ void AudioStreamPlaybackOGGVorbis::seek(float p_time) {
 	}
 	frames_mixed = uint32_t(vorbis_stream->sample_rate * p_time);
 
+	if (stream_file) {
+		seek_frame = frames_mixed;
+		seek_serial++; //published after the frame
+		if (stream_thread) {
+			stream_semaphore->post();
+		}
+		return;
+	}
+
 	stb_vorbis_seek(ogg_stream, frames_mixed);
 }
 
+AudioStreamPlaybackOGGVorbis::AudioStreamPlaybackOGGVorbis() :
+		stream_item(this) {
+
+	ogg_stream = NULL;
+	ogg_alloc.alloc_buffer = NULL;
+	ogg_alloc.alloc_buffer_length_in_bytes = 0;
+	frames_mixed = 0;
+	active = false;
+	loops = 0;
+	stream_file = NULL;
+	read_pos = 0;
+	read_len = 0;
+	pending_output = NULL;
+	pending_frames = 0;
+	pending_pos = 0;
+	ring_read = 0;
+	ring_write = 0;
+	stream_ended = false;
+	seek_frame = 0;
+	seek_serial = 0;
+	served_serial = 0;
+}
+
 AudioStreamPlaybackOGGVorbis::~AudioStreamPlaybackOGGVorbis() {
+
+	if (stream_item.in_list()) {
+		stream_mutex->lock(); //not while the stream thread is filling it
+		stream_list.remove(&stream_item);
+		stream_mutex->unlock();
+	}
+
+	if (stream_file) {
+		memdelete(stream_file);
+	}
+
 	if (ogg_alloc.alloc_buffer) {
-		stb_vorbis_close(ogg_stream);
+		if (ogg_stream) {
+			stb_vorbis_close(ogg_stream);
+		}
 		AudioServer::get_singleton()->audio_data_free(ogg_alloc.alloc_buffer);
 	}
 }
@@ -129,6 +473,31 @@ Ref<AudioStreamPlayback> AudioStreamOGGVorbis::instance_playback() {
 
 	Ref<AudioStreamPlaybackOGGVorbis> ovs;
 
+	if (stream_file != String()) {
+
+		FileAccess *f = FileAccess::open(stream_file, FileAccess::READ);
+		ERR_FAIL_COND_V(!f, ovs);
+
+		ovs.instance();
+		ovs->vorbis_stream = Ref<AudioStreamOGGVorbis>(this);
+		ovs->ogg_alloc.alloc_buffer = (char *)AudioServer::get_singleton()->audio_data_alloc(decode_mem_size);
+		ovs->ogg_alloc.alloc_buffer_length_in_bytes = decode_mem_size;
+		ovs->stream_file = f;
+		ovs->ring.resize(AudioStreamPlaybackOGGVorbis::STREAM_RING_SIZE);
+
+		if (ovs->_stream_open() != OK) {
+			ERR_PRINTS("Can't open Ogg Vorbis stream: " + stream_file);
+			return Ref<AudioStreamPlaybackOGGVorbis>(); //the destructor releases the file and decoder memory
+		}
+
+		AudioStreamPlaybackOGGVorbis::_stream_thread_start();
+		AudioStreamPlaybackOGGVorbis::stream_mutex->lock();
+		AudioStreamPlaybackOGGVorbis::stream_list.add(&ovs->stream_item);
+		AudioStreamPlaybackOGGVorbis::stream_mutex->unlock();
+
+		return ovs;
+	}
+
 	ERR_FAIL_COND_V(data == NULL, ovs);
 
 	ovs.instance();
@@ -166,6 +535,10 @@ void AudioStreamOGGVorbis::clear_data() {
 void AudioStreamOGGVorbis::set_data(const PoolVector<uint8_t> &p_data) {
 
 	int src_data_len = p_data.size();
+	if (src_data_len == 0) {
+		clear_data(); //streaming resources are saved without data
+		return;
+	}
 #define MAX_TEST_MEM (1 << 20)
 
 	uint32_t alloc_try = 1024;
@@ -211,6 +584,7 @@ void AudioStreamOGGVorbis::set_data(const PoolVector<uint8_t> &p_data) {
 
 			data = AudioServer::get_singleton()->audio_data_alloc(src_data_len, src_datar.ptr());
 			data_len = src_data_len;
+			stream_file = String();
 
 			break;
 		}
@@ -232,6 +606,144 @@ PoolVector<uint8_t> AudioStreamOGGVorbis::get_data() const {
 	return vdata;
 }
 
+void AudioStreamOGGVorbis::set_stream_file(const String &p_file) {
+
+	if (p_file == String()) {
+		stream_file = String();
+		return;
+	}
+
+	FileAccess *f = FileAccess::open(p_file, FileAccess::READ);
+	ERR_FAIL_COND(!f);
+
+	//only the headers are needed to know the format and how much memory a decoder takes
+	Vector<uint8_t> header;
+	Vector<char> alloc_mem;
+	int header_len = 0;
+	uint32_t alloc_try = 1024;
+	stb_vorbis *ogg_stream = NULL;
+
+	while (alloc_try < MAX_TEST_MEM) {
+
+		alloc_mem.resize(alloc_try);
+
+		stb_vorbis_alloc ogg_alloc;
+		ogg_alloc.alloc_buffer = alloc_mem.ptrw();
+		ogg_alloc.alloc_buffer_length_in_bytes = alloc_try;
+
+		int used = 0;
+		int error = 0;
+		ogg_stream = header_len ? stb_vorbis_open_pushdata(header.ptr(), header_len, &used, &error, &ogg_alloc) : NULL;
+
+		if (ogg_stream) {
+			break;
+		} else if (header_len == 0 || error == VORBIS_need_more_data) {
+			header.resize(header_len + 4096);
+			int got = f->get_buffer(header.ptrw() + header_len, 4096);
+			if (got <= 0)
+				break;
+			header_len += got;
+		} else if (error == VORBIS_outofmem) {
+			alloc_try *= 2;
+		} else {
+			break;
+		}
+	}
+
+	memdelete(f);
+	ERR_FAIL_COND(ogg_stream == NULL);
+
+	stb_vorbis_info info = stb_vorbis_get_info(ogg_stream);
+	channels = info.channels;
+	sample_rate = info.sample_rate;
+	decode_mem_size = alloc_try;
+	stb_vorbis_close(ogg_stream);
+
+	clear_data(); //pages are read from the file as they play
+	stream_file = p_file;
+	_update_stream_length();
+}
+
+String AudioStreamOGGVorbis::get_stream_file() const {
+
+	return stream_file;
+}
+
+bool AudioStreamOGGVorbis::is_streaming() const {
+
+	return stream_file != String();
+}
+
+void AudioStreamOGGVorbis::set_seek_table(const PoolIntArray &p_seek_table) {
+
+	seek_table = p_seek_table;
+	_update_stream_length();
+}
+
+PoolIntArray AudioStreamOGGVorbis::get_seek_table() const {
+
+	return seek_table;
+}
+
+void AudioStreamOGGVorbis::_update_stream_length() {
+
+	//the last granule position is the total amount of frames
+	if (stream_file != String() && seek_table.size() >= 2 && sample_rate > 0) {
+		length = seek_table[seek_table.size() - 2] / sample_rate;
+	}
+}
+
+PoolIntArray AudioStreamOGGVorbis::build_seek_table(const PoolVector<uint8_t> &p_data) {
+
+	Vector<int> table;
+
+	PoolVector<uint8_t>::Read r = p_data.read();
+	int len = p_data.size();
+	int pos = 0;
+
+	while (pos + 27 <= len) {
+
+		const uint8_t *page = &r[pos];
+		if (page[0] != 'O' || page[1] != 'g' || page[2] != 'g' || page[3] != 'S') {
+			pos++; //resync to the next page
+			continue;
+		}
+
+		int segments = page[26];
+		if (pos + 27 + segments > len)
+			break;
+
+		int page_len = 27 + segments;
+		for (int i = 0; i < segments; i++) {
+			page_len += page[27 + i];
+		}
+
+		uint64_t granule = 0;
+		for (int i = 7; i >= 0; i--) {
+			granule = (granule << 8) | page[6 + i];
+		}
+
+		//header pages are at granule 0, and pages where no packet ends don't have one
+		if (granule != 0 && granule != (uint64_t)-1) {
+			table.push_back(int(MIN(granule, (uint64_t)0x7FFFFFFF)));
+			table.push_back(pos);
+		}
+
+		pos += page_len;
+	}
+
+	PoolIntArray seek_table;
+	seek_table.resize(table.size());
+	{
+		PoolIntArray::Write w = seek_table.write();
+		for (int i = 0; i < table.size(); i++) {
+			w[i] = table[i];
+		}
+	}
+
+	return seek_table;
+}
+
 void AudioStreamOGGVorbis::set_loop(bool p_enable) {
 	loop = p_enable;
 }
@@ -265,9 +777,18 @@ void AudioStreamOGGVorbis::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("set_loop_offset", "seconds"), &AudioStreamOGGVorbis::set_loop_offset);
 	ClassDB::bind_method(D_METHOD("get_loop_offset"), &AudioStreamOGGVorbis::get_loop_offset);
 
+	ClassDB::bind_method(D_METHOD("set_seek_table", "seek_table"), &AudioStreamOGGVorbis::set_seek_table);
+	ClassDB::bind_method(D_METHOD("get_seek_table"), &AudioStreamOGGVorbis::get_seek_table);
+
+	ClassDB::bind_method(D_METHOD("set_stream_file", "file"), &AudioStreamOGGVorbis::set_stream_file);
+	ClassDB::bind_method(D_METHOD("get_stream_file"), &AudioStreamOGGVorbis::get_stream_file);
+	ClassDB::bind_method(D_METHOD("is_streaming"), &AudioStreamOGGVorbis::is_streaming);
+
 	ADD_PROPERTY(PropertyInfo(Variant::POOL_BYTE_ARRAY, "data", PROPERTY_HINT_NONE, "", PROPERTY_USAGE_NOEDITOR), "set_data", "get_data");
 	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "loop", PROPERTY_HINT_NONE, "", PROPERTY_USAGE_NOEDITOR), "set_loop", "has_loop");
 	ADD_PROPERTY(PropertyInfo(Variant::REAL, "loop_offset", PROPERTY_HINT_NONE, "", PROPERTY_USAGE_NOEDITOR), "set_loop_offset", "get_loop_offset");
+	ADD_PROPERTY(PropertyInfo(Variant::POOL_INT_ARRAY, "seek_table", PROPERTY_HINT_NONE, "", PROPERTY_USAGE_NOEDITOR), "set_seek_table", "get_seek_table");
+	ADD_PROPERTY(PropertyInfo(Variant::STRING, "stream_file", PROPERTY_HINT_FILE, "", PROPERTY_USAGE_NOEDITOR), "set_stream_file", "get_stream_file");
 }
 
 AudioStreamOGGVorbis::AudioStreamOGGVorbis() {
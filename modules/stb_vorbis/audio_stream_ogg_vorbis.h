@@ -32,6 +32,11 @@
 #define AUDIO_STREAM_STB_VORBIS_H
 
 #include "core/io/resource_loader.h"
+#include "core/os/file_access.h"
+#include "core/os/mutex.h"
+#include "core/os/semaphore.h"
+#include "core/os/thread.h"
+#include "core/self_list.h"
 #include "servers/audio/audio_stream.h"
 
 #include "thirdparty/misc/stb_vorbis.h"
@@ -52,6 +57,53 @@ class AudioStreamPlaybackOGGVorbis : public AudioStreamPlaybackResampled {
 
 	Ref<AudioStreamOGGVorbis> vorbis_stream;
 
+	/* streaming mode: pages are read from stream_file and decoded ahead on the stream thread */
+
+	enum {
+		STREAM_RING_BITS = 15,
+		STREAM_RING_SIZE = 1 << STREAM_RING_BITS,
+		STREAM_RING_MASK = STREAM_RING_SIZE - 1,
+		STREAM_READ_CHUNK = 4096
+	};
+
+	FileAccess *stream_file;
+	Vector<uint8_t> read_buffer;
+	int read_pos;
+	int read_len;
+
+	//frame decoded by stb_vorbis that didn't fit in the ring yet
+	float **pending_output;
+	int pending_frames;
+	int pending_pos;
+
+	//single producer (stream thread), single consumer (audio thread)
+	Vector<AudioFrame> ring;
+	volatile uint32_t ring_read;
+	volatile uint32_t ring_write;
+	volatile bool stream_ended;
+
+	//seeks are requested by the audio thread and served by the stream thread
+	volatile uint32_t seek_frame;
+	volatile uint32_t seek_serial;
+	volatile uint32_t served_serial;
+
+	SelfList<AudioStreamPlaybackOGGVorbis> stream_item;
+
+	static SelfList<AudioStreamPlaybackOGGVorbis>::List stream_list;
+	static Thread *stream_thread;
+	static Semaphore *stream_semaphore;
+	static Mutex *stream_mutex;
+	static bool stream_thread_exit;
+
+	static void _stream_thread_func(void *p_userdata);
+	static void _stream_thread_start();
+
+	Error _stream_open();
+	bool _stream_decode_frame(float ***r_output, int *r_samples);
+	void _stream_seek(uint32_t p_frame);
+	void _stream_fill();
+	void _mix_streamed(AudioFrame *p_buffer, int p_frames);
+
 protected:
 	virtual void _mix_internal(AudioFrame *p_buffer, int p_frames);
 	virtual float get_stream_sampling_rate();
@@ -66,7 +118,9 @@ public:
 	virtual float get_playback_position() const;
 	virtual void seek(float p_time);
 
-	AudioStreamPlaybackOGGVorbis() {}
+	static void finish_streaming();
+
+	AudioStreamPlaybackOGGVorbis();
 	~AudioStreamPlaybackOGGVorbis();
 };
 
@@ -89,12 +143,16 @@ class AudioStreamOGGVorbis : public AudioStream {
 	float loop_offset;
 	void clear_data();
 
+	String stream_file;
+	PoolIntArray seek_table; //granule position and byte offset of every page that ends a packet
+	void _update_stream_length();
+
 protected:
 	static void _bind_methods();
 
 public:
 	void set_loop(bool p_enable);
-	bool has_loop() const;
+	virtual bool has_loop() const;
 
 	void set_loop_offset(float p_seconds);
 	float get_loop_offset() const;
@@ -105,6 +163,15 @@ public:
 	void set_data(const PoolVector<uint8_t> &p_data);
 	PoolVector<uint8_t> get_data() const;
 
+	void set_stream_file(const String &p_file);
+	String get_stream_file() const;
+	bool is_streaming() const;
+
+	void set_seek_table(const PoolIntArray &p_seek_table);
+	PoolIntArray get_seek_table() const;
+
+	static PoolIntArray build_seek_table(const PoolVector<uint8_t> &p_data);
+
 	virtual float get_length() const; //if supported, otherwise return 0
 
 	AudioStreamOGGVorbis();
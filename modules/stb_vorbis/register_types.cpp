@@ -43,4 +43,6 @@ void register_stb_vorbis_types() {
 }
 
 void unregister_stb_vorbis_types() {
+
+	AudioStreamPlaybackOGGVorbis::finish_streaming();
 }
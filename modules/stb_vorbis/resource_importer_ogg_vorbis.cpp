@@ -74,12 +74,14 @@ void ResourceImporterOGGVorbis::get_import_options(List<ImportOption> *r_options
 
 	r_options->push_back(ImportOption(PropertyInfo(Variant::BOOL, "loop"), true));
 	r_options->push_back(ImportOption(PropertyInfo(Variant::REAL, "loop_offset"), 0));
+	r_options->push_back(ImportOption(PropertyInfo(Variant::BOOL, "streaming"), false));
 }
 
 Error ResourceImporterOGGVorbis::import(const String &p_source_file, const String &p_save_path, const Map<StringName, Variant> &p_options, List<String> *r_platform_variants, List<String> *r_gen_files, Variant *r_metadata) {
 
 	bool loop = p_options["loop"];
 	float loop_offset = p_options["loop_offset"];
+	bool streaming = p_options.has("streaming") && bool(p_options["streaming"]);
 
 	FileAccess *f = FileAccess::open(p_source_file, FileAccess::READ);
 	if (!f) {
@@ -104,6 +106,23 @@ Error ResourceImporterOGGVorbis::import(const String &p_source_file, const Strin
 	ogg_stream->set_loop(loop);
 	ogg_stream->set_loop_offset(loop_offset);
 
+	if (streaming) {
+		//keep the compressed data in its own file next to the resource, so it can be read page by page
+		String stream_path = p_save_path + ".ogg";
+		FileAccess *sf = FileAccess::open(stream_path, FileAccess::WRITE);
+		ERR_FAIL_COND_V(!sf, ERR_CANT_CREATE);
+		sf->store_buffer(data.read().ptr(), len);
+		memdelete(sf);
+
+		ogg_stream->set_seek_table(AudioStreamOGGVorbis::build_seek_table(data));
+		ogg_stream->set_stream_file(stream_path);
+		ERR_FAIL_COND_V(!ogg_stream->is_streaming(), ERR_FILE_CORRUPT);
+
+		if (r_gen_files) {
+			r_gen_files->push_back(stream_path);
+		}
+	}
+
 	return ResourceSaver::save(p_save_path + ".oggstr", ogg_stream);
 }
 
@@ -45,8 +45,6 @@ SVGRasterizer::~SVGRasterizer() {
 	nsvgDeleteRasterizer(rasterizer);
 }
 
-SVGRasterizer ImageLoaderSVG::rasterizer;
-
 inline void change_nsvg_paint_color(NSVGpaint *p_paint, const uint32_t p_old, const uint32_t p_new) {
 
 	if (p_paint->type == NSVG_PAINT_COLOR) {
@@ -109,18 +107,26 @@ Error ImageLoaderSVG::_create_image(Ref<Image> p_image, const PoolVector<uint8_t
 	float upscale = upsample ? 2.0 : 1.0;
 
 	int w = (int)(svg_image->width * p_scale * upscale);
-	ERR_EXPLAIN(vformat("Can't create image from SVG with scale %s, the resulting image size exceeds max width.", rtos(p_scale)));
-	ERR_FAIL_COND_V(w > Image::MAX_WIDTH, ERR_PARAMETER_RANGE_ERROR);
+	if (w > Image::MAX_WIDTH) {
+		nsvgDelete(svg_image);
+		ERR_EXPLAIN(vformat("Can't create image from SVG with scale %s, the resulting image size exceeds max width.", rtos(p_scale)));
+		ERR_FAIL_V(ERR_PARAMETER_RANGE_ERROR);
+	}
 
 	int h = (int)(svg_image->height * p_scale * upscale);
-	ERR_EXPLAIN(vformat("Can't create image from SVG with scale %s, the resulting image size exceeds max height.", rtos(p_scale)));
-	ERR_FAIL_COND_V(h > Image::MAX_HEIGHT, ERR_PARAMETER_RANGE_ERROR);
+	if (h > Image::MAX_HEIGHT) {
+		nsvgDelete(svg_image);
+		ERR_EXPLAIN(vformat("Can't create image from SVG with scale %s, the resulting image size exceeds max height.", rtos(p_scale)));
+		ERR_FAIL_V(ERR_PARAMETER_RANGE_ERROR);
+	}
 
 	PoolVector<uint8_t> dst_image;
 	dst_image.resize(w * h * 4);
 
 	PoolVector<uint8_t>::Write dw = dst_image.write();
 
+	//a rasterizer per call, so images can be created from several threads at once
+	SVGRasterizer rasterizer;
 	rasterizer.rasterize(svg_image, 0, 0, p_scale * upscale, (unsigned char *)dw.ptr(), w, h, w * 4);
 
 	dw = PoolVector<uint8_t>::Write();
@@ -54,14 +54,14 @@ public:
 
 class ImageLoaderSVG : public ImageFormatLoader {
 	static struct ReplaceColors {
-		List<uint32_t> old_colors;
-		List<uint32_t> new_colors;
+		Vector<uint32_t> old_colors;
+		Vector<uint32_t> new_colors;
 	} replace_colors;
-	static SVGRasterizer rasterizer;
 	static void _convert_colors(NSVGimage *p_svg_image);
 	static Error _create_image(Ref<Image> p_image, const PoolVector<uint8_t> *p_data, float p_scale, bool upsample, bool convert_colors = false);
 
 public:
+	// Rasterizing is thread safe. The colors set here are shared, so they must not change while images are being created with convert_colors.
 	static void set_convert_colors(Dictionary *p_replace_color = NULL);
 	static Error create_image_from_string(Ref<Image> p_image, const char *p_svg_str, float p_scale, bool upsample, bool convert_colors = false);
 
@@ -2215,6 +2215,79 @@ void VisualScriptInstance::create(const Ref<VisualScript> &p_script, Object *p_o
 			}
 		}
 
+		//fifth pass: fold pure nodes that only read default values, repeat until
+		//nothing changes so constant expressions collapse completely
+
+		Set<int> folded;
+		bool changed = true;
+		while (changed) {
+			changed = false;
+
+			for (const Map<int, VisualScript::Function::NodeData>::Element *F = E->get().nodes.front(); F; F = F->next()) {
+
+				if (folded.has(F->key()) || !instances.has(F->key()))
+					continue;
+
+				Ref<VisualScriptNode> node = F->get().node;
+				VisualScriptNodeInstance *instance = instances[F->key()];
+
+				if (!node->is_pure() || node->has_input_sequence_port() || instance->sequence_output_count || instance->working_mem_idx >= 0)
+					continue;
+
+				bool constant_inputs = true;
+				for (int i = 0; i < instance->input_port_count; i++) {
+					if (!(instance->input_ports[i] & VisualScriptNodeInstance::INPUT_DEFAULT_VALUE_BIT)) {
+						constant_inputs = false;
+						break;
+					}
+				}
+
+				if (!constant_inputs)
+					continue;
+
+				Vector<const Variant *> inputs;
+				inputs.resize(instance->input_port_count);
+				for (int i = 0; i < instance->input_port_count; i++) {
+					inputs.write[i] = &default_values[instance->input_ports[i] & VisualScriptNodeInstance::INPUT_MASK];
+				}
+
+				Vector<Variant> results;
+				results.resize(instance->output_port_count);
+				Vector<Variant *> outputs;
+				outputs.resize(instance->output_port_count);
+				for (int i = 0; i < instance->output_port_count; i++) {
+					outputs.write[i] = &results.write[i];
+				}
+
+				Variant::CallError ce;
+				String error_str;
+				instance->step(inputs.ptrw(), outputs.ptrw(), VisualScriptNodeInstance::START_MODE_BEGIN_SEQUENCE, NULL, ce, error_str);
+
+				folded.insert(F->key());
+
+				if (ce.error != Variant::CallError::CALL_OK)
+					continue; //leave it to report the error when called
+
+				//readers of the outputs now read default values, and no longer depend on this node
+				for (const Set<VisualScript::DataConnection>::Element *G = E->get().data_connections.front(); G; G = G->next()) {
+
+					const VisualScript::DataConnection &dc = G->get();
+					if (dc.from_node != F->key() || !instances.has(dc.to_node) || dc.from_port >= instance->output_port_count)
+						continue;
+
+					VisualScriptNodeInstance *to = instances[dc.to_node];
+					if (dc.to_port >= to->input_port_count)
+						continue;
+
+					to->input_ports[dc.to_port] = default_values.size() | VisualScriptNodeInstance::INPUT_DEFAULT_VALUE_BIT;
+					default_values.push_back(results[dc.from_port]);
+					to->dependencies.erase(instance);
+				}
+
+				changed = true;
+			}
+		}
+
 		functions[E->key()] = function;
 	}
 }
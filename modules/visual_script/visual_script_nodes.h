@@ -116,6 +116,7 @@ protected:
 public:
 	virtual int get_output_sequence_port_count() const;
 	virtual bool has_input_sequence_port() const;
+	virtual bool is_pure() const { return true; }
 
 	virtual String get_output_sequence_port_text(int p_port) const;
 
@@ -151,6 +152,7 @@ protected:
 public:
 	virtual int get_output_sequence_port_count() const;
 	virtual bool has_input_sequence_port() const;
+	virtual bool is_pure() const { return true; }
 
 	virtual String get_output_sequence_port_text(int p_port) const;
 
@@ -252,6 +254,7 @@ protected:
 public:
 	virtual int get_output_sequence_port_count() const;
 	virtual bool has_input_sequence_port() const;
+	virtual bool is_pure() const { return true; }
 
 	virtual String get_output_sequence_port_text(int p_port) const;
 
@@ -287,6 +290,7 @@ protected:
 public:
 	virtual int get_output_sequence_port_count() const;
 	virtual bool has_input_sequence_port() const;
+	virtual bool is_pure() const { return true; }
 
 	virtual String get_output_sequence_port_text(int p_port) const;
 
@@ -366,6 +370,7 @@ class VisualScriptGlobalConstant : public VisualScriptNode {
 public:
 	virtual int get_output_sequence_port_count() const;
 	virtual bool has_input_sequence_port() const;
+	virtual bool is_pure() const { return true; }
 
 	virtual String get_output_sequence_port_text(int p_port) const;
 
@@ -400,6 +405,7 @@ protected:
 public:
 	virtual int get_output_sequence_port_count() const;
 	virtual bool has_input_sequence_port() const;
+	virtual bool is_pure() const { return true; }
 
 	virtual String get_output_sequence_port_text(int p_port) const;
 
@@ -437,6 +443,7 @@ protected:
 public:
 	virtual int get_output_sequence_port_count() const;
 	virtual bool has_input_sequence_port() const;
+	virtual bool is_pure() const { return true; }
 
 	virtual String get_output_sequence_port_text(int p_port) const;
 
@@ -488,6 +495,7 @@ protected:
 public:
 	virtual int get_output_sequence_port_count() const;
 	virtual bool has_input_sequence_port() const;
+	virtual bool is_pure() const { return true; }
 
 	virtual String get_output_sequence_port_text(int p_port) const;
 
@@ -967,6 +975,7 @@ protected:
 public:
 	virtual int get_output_sequence_port_count() const;
 	virtual bool has_input_sequence_port() const;
+	virtual bool is_pure() const { return true; }
 
 	virtual String get_output_sequence_port_text(int p_port) const;
 
@@ -44,10 +44,12 @@
 
 void LWSPeer::set_wsi(struct lws *p_wsi, unsigned int p_in_buf_size, unsigned int p_in_pkt_size, unsigned int p_out_buf_size, unsigned int p_out_pkt_size) {
 	ERR_FAIL_COND(wsi != NULL);
+	ERR_FAIL_COND(LWS_PRE > FRAME_HEADROOM);
 
 	_in_buffer.resize(p_in_pkt_size, p_in_buf_size);
-	_out_buffer.resize(p_out_pkt_size, p_out_buf_size);
-	_packet_buffer.resize((1 << MAX(p_in_buf_size, p_out_buf_size)) + LWS_PRE);
+	_out_frames.resize(1 << p_out_pkt_size);
+	_out_max_bytes = 1 << p_out_buf_size;
+	_packet_buffer.resize(1 << MAX(p_in_buf_size, p_out_buf_size));
 	wsi = p_wsi;
 };
 
@@ -95,36 +97,82 @@ Error LWSPeer::write_wsi() {
 
 	ERR_FAIL_COND_V(!is_connected_to_host(), FAILED);
 
-	PoolVector<uint8_t> tmp;
-	int count = _out_buffer.packets_left();
-
-	if (count == 0)
-		return OK;
+	// Write as much as the socket takes, instead of one frame per writable callback.
+	while (_out_count) {
+
+		OutFrame &frame = _out_frames.write[_out_read];
+		int size = frame.data.size() - FRAME_HEADROOM;
+		{
+			// lws only puts the frame header into the headroom, and frames leave one at a time,
+			// so writing into a buffer shared with other peers is safe.
+			PoolVector<uint8_t>::Read r = frame.data.read();
+			enum lws_write_protocol mode = frame.is_string ? LWS_WRITE_TEXT : LWS_WRITE_BINARY;
+			lws_write(wsi, const_cast<uint8_t *>(&r[FRAME_HEADROOM]), size, mode);
+		}
+		frame.data = PoolVector<uint8_t>();
 
-	int read = 0;
-	uint8_t is_string = 0;
-	PoolVector<uint8_t>::Write rw = _packet_buffer.write();
-	_out_buffer.read_packet(&(rw[LWS_PRE]), _packet_buffer.size() - LWS_PRE, &is_string, read);
+		_out_read = (_out_read + 1) & (_out_frames.size() - 1);
+		_out_count--;
+		_out_bytes -= size;
 
-	enum lws_write_protocol mode = is_string ? LWS_WRITE_TEXT : LWS_WRITE_BINARY;
-	lws_write(wsi, &(rw[LWS_PRE]), read, mode);
+		if (lws_send_pipe_choked(wsi))
+			break;
+	}
 
-	if (count > 1)
+	if (_out_count > 0)
 		lws_callback_on_writable(wsi); // we want to write more!
 
 	return OK;
 }
 
-Error LWSPeer::put_packet(const uint8_t *p_buffer, int p_buffer_size) {
+Error LWSPeer::_queue_frame(const PoolVector<uint8_t> &p_frame, bool p_is_string) {
 
-	ERR_FAIL_COND_V(!is_connected_to_host(), FAILED);
+	int size = p_frame.size() - FRAME_HEADROOM;
+
+#ifdef TOOLS_ENABLED
+	// Verbose buffer warnings
+	if (_out_bytes + size > _out_max_bytes) {
+		ERR_PRINT("Buffer payload full! Dropping data.");
+		ERR_FAIL_V(ERR_OUT_OF_MEMORY);
+	}
+	if (_out_count == _out_frames.size()) {
+		ERR_PRINT("Too many packets in queue! Dropping data.");
+		ERR_FAIL_V(ERR_OUT_OF_MEMORY);
+	}
+#else
+	ERR_FAIL_COND_V(_out_bytes + size > _out_max_bytes, ERR_OUT_OF_MEMORY);
+	ERR_FAIL_COND_V(_out_count == _out_frames.size(), ERR_OUT_OF_MEMORY);
+#endif
+
+	OutFrame &frame = _out_frames.write[(_out_read + _out_count) & (_out_frames.size() - 1)];
+	frame.data = p_frame;
+	frame.is_string = p_is_string;
+	_out_count++;
+	_out_bytes += size;
 
-	uint8_t is_string = write_mode == WRITE_MODE_TEXT;
-	_out_buffer.write_packet(p_buffer, p_buffer_size, &is_string);
 	lws_callback_on_writable(wsi); // notify that we want to write
 	return OK;
+}
+
+Error LWSPeer::put_packet(const uint8_t *p_buffer, int p_buffer_size) {
+
+	ERR_FAIL_COND_V(!is_connected_to_host(), FAILED);
+
+	PoolVector<uint8_t> frame;
+	frame.resize(FRAME_HEADROOM + p_buffer_size);
+	copymem(&frame.write()[FRAME_HEADROOM], p_buffer, p_buffer_size);
+
+	return _queue_frame(frame, write_mode == WRITE_MODE_TEXT);
 };
 
+Error LWSPeer::put_frame(const PoolVector<uint8_t> &p_frame) {
+
+	ERR_FAIL_COND_V(!is_connected_to_host(), FAILED);
+	ERR_FAIL_COND_V(p_frame.size() < FRAME_HEADROOM, ERR_INVALID_PARAMETER);
+
+	return _queue_frame(p_frame, write_mode == WRITE_MODE_TEXT);
+}
+
 Error LWSPeer::get_packet(const uint8_t **r_buffer, int &r_buffer_size) {
 
 	r_buffer_size = 0;
@@ -208,7 +256,10 @@ void LWSPeer::close(int p_code, String p_reason) {
 	}
 	wsi = NULL;
 	_in_buffer.clear();
-	_out_buffer.clear();
+	_out_frames.clear();
+	_out_read = 0;
+	_out_count = 0;
+	_out_bytes = 0;
 	_in_size = 0;
 	_is_string = 0;
 	_packet_buffer.resize(0);
@@ -259,6 +310,7 @@ uint16_t LWSPeer::get_connected_port() const {
 LWSPeer::LWSPeer() {
 	wsi = NULL;
 	write_mode = WRITE_MODE_BINARY;
+	_out_max_bytes = 0;
 	close();
 };
 
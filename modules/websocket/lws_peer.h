@@ -50,10 +50,23 @@ private:
 	uint8_t _is_string;
 	// Our packet info is just a boolean (is_string), using uint8_t for it.
 	PacketBuffer<uint8_t> _in_buffer;
-	PacketBuffer<uint8_t> _out_buffer;
+
+	struct OutFrame {
+		PoolVector<uint8_t> data; // FRAME_HEADROOM bytes for lws, then the payload.
+		bool is_string;
+	};
+
+	// Frames waiting for a writable callback, written by lws straight from their buffers.
+	Vector<OutFrame> _out_frames;
+	int _out_read;
+	int _out_count;
+	int _out_bytes;
+	int _out_max_bytes;
 
 	PoolVector<uint8_t> _packet_buffer;
 
+	Error _queue_frame(const PoolVector<uint8_t> &p_frame, bool p_is_string);
+
 	struct lws *wsi;
 	WriteMode write_mode;
 
@@ -70,6 +83,7 @@ public:
 	virtual int get_available_packet_count() const;
 	virtual Error get_packet(const uint8_t **r_buffer, int &r_buffer_size);
 	virtual Error put_packet(const uint8_t *p_buffer, int p_buffer_size);
+	virtual Error put_frame(const PoolVector<uint8_t> &p_frame);
 	virtual int get_max_packet_size() const { return _packet_buffer.size(); };
 
 	virtual void close(int p_code = 1000, String p_reason = "");
@@ -30,6 +30,8 @@
 
 #include "websocket_multiplayer_peer.h"
 
+#include "core/io/compression.h"
+#include "core/io/marshalls.h"
 #include "core/os/os.h"
 
 WebSocketMultiplayerPeer::WebSocketMultiplayerPeer() {
@@ -38,6 +40,7 @@ WebSocketMultiplayerPeer::WebSocketMultiplayerPeer() {
 	_peer_id = 0;
 	_target_peer = 0;
 	_refusing = false;
+	_compression_threshold = 0;
 
 	_current_packet.source = 0;
 	_current_packet.destination = 0;
@@ -88,6 +91,10 @@ void WebSocketMultiplayerPeer::_clear() {
 void WebSocketMultiplayerPeer::_bind_methods() {
 
 	ClassDB::bind_method(D_METHOD("get_peer", "peer_id"), &WebSocketMultiplayerPeer::get_peer);
+	ClassDB::bind_method(D_METHOD("set_compression_threshold", "bytes"), &WebSocketMultiplayerPeer::set_compression_threshold);
+	ClassDB::bind_method(D_METHOD("get_compression_threshold"), &WebSocketMultiplayerPeer::get_compression_threshold);
+
+	ADD_PROPERTY(PropertyInfo(Variant::INT, "compression_threshold"), "set_compression_threshold", "get_compression_threshold");
 
 	ADD_SIGNAL(MethodInfo("peer_packet", PropertyInfo(Variant::INT, "peer_source")));
 }
@@ -132,9 +139,9 @@ Error WebSocketMultiplayerPeer::put_packet(const uint8_t *p_buffer, int p_buffer
 	PoolVector<uint8_t> buffer = _make_pkt(SYS_NONE, get_unique_id(), _target_peer, p_buffer, p_buffer_size);
 
 	if (is_server()) {
-		return _server_relay(1, _target_peer, &(buffer.read()[0]), buffer.size());
+		return _server_relay(1, _target_peer, buffer);
 	} else {
-		return get_peer(1)->put_packet(&(buffer.read()[0]), buffer.size());
+		return get_peer(1)->put_frame(buffer);
 	}
 }
 
@@ -181,25 +188,62 @@ bool WebSocketMultiplayerPeer::is_refusing_new_connections() const {
 	return _refusing;
 }
 
+void WebSocketMultiplayerPeer::set_compression_threshold(int p_bytes) {
+
+	ERR_FAIL_COND(p_bytes < 0);
+	_compression_threshold = p_bytes;
+}
+
+int WebSocketMultiplayerPeer::get_compression_threshold() const {
+
+	return _compression_threshold;
+}
+
 void WebSocketMultiplayerPeer::_send_sys(Ref<WebSocketPeer> p_peer, uint8_t p_type, int32_t p_peer_id) {
 
 	ERR_FAIL_COND(!p_peer.is_valid());
 	ERR_FAIL_COND(!p_peer->is_connected_to_host());
 
 	PoolVector<uint8_t> message = _make_pkt(p_type, 1, 0, (uint8_t *)&p_peer_id, 4);
-	p_peer->put_packet(&(message.read()[0]), message.size());
+	p_peer->put_frame(message);
 }
 
 PoolVector<uint8_t> WebSocketMultiplayerPeer::_make_pkt(uint32_t p_type, int32_t p_from, int32_t p_to, const uint8_t *p_data, uint32_t p_data_size) {
 
+	// Built as a frame (see WebSocketPeer::put_frame), so all peers can share it without copies.
+	const int ofs = WebSocketPeer::FRAME_HEADROOM;
 	PoolVector<uint8_t> out;
-	out.resize(PROTO_SIZE + p_data_size);
+
+	if (p_type == SYS_NONE && _compression_threshold > 0 && p_data_size >= (uint32_t)_compression_threshold) {
+
+		out.resize(ofs + PROTO_SIZE + 4 + Compression::get_max_compressed_buffer_size(p_data_size, Compression::MODE_DEFLATE));
+		int size = -1;
+		{
+			PoolVector<uint8_t>::Write w = out.write();
+			size = Compression::compress(&w[ofs + PROTO_SIZE + 4], p_data, p_data_size, Compression::MODE_DEFLATE);
+			if (size >= 0 && (uint32_t)size + 4 < p_data_size) {
+				uint8_t type = p_type | PROTO_COMPRESSED;
+				copymem(&w[ofs], &type, 1);
+				copymem(&w[ofs + 1], &p_from, 4);
+				copymem(&w[ofs + 5], &p_to, 4);
+				encode_uint32(p_data_size, &w[ofs + PROTO_SIZE]);
+			} else {
+				size = -1; // Not worth it, send as is.
+			}
+		}
+		if (size >= 0) {
+			out.resize(ofs + PROTO_SIZE + 4 + size);
+			return out;
+		}
+	}
+
+	out.resize(ofs + PROTO_SIZE + p_data_size);
 
 	PoolVector<uint8_t>::Write w = out.write();
-	copymem(&w[0], &p_type, 1);
-	copymem(&w[1], &p_from, 4);
-	copymem(&w[5], &p_to, 4);
-	copymem(&w[PROTO_SIZE], p_data, p_data_size);
+	copymem(&w[ofs], &p_type, 1);
+	copymem(&w[ofs + 1], &p_from, 4);
+	copymem(&w[ofs + 5], &p_to, 4);
+	copymem(&w[ofs + PROTO_SIZE], p_data, p_data_size);
 
 	return out;
 }
@@ -232,18 +276,35 @@ void WebSocketMultiplayerPeer::_send_del(int32_t p_peer_id) {
 	}
 }
 
-void WebSocketMultiplayerPeer::_store_pkt(int32_t p_source, int32_t p_dest, const uint8_t *p_data, uint32_t p_data_size) {
+void WebSocketMultiplayerPeer::_store_pkt(int32_t p_source, int32_t p_dest, const uint8_t *p_data, uint32_t p_data_size, bool p_compressed, int p_max_size) {
 	Packet packet;
-	packet.data = (uint8_t *)memalloc(p_data_size);
-	packet.size = p_data_size;
 	packet.source = p_source;
 	packet.destination = p_dest;
-	copymem(packet.data, &p_data[PROTO_SIZE], p_data_size);
+
+	if (p_compressed) {
+		ERR_FAIL_COND(p_data_size < 4);
+		uint32_t size = decode_uint32(p_data);
+		ERR_FAIL_COND(size > (uint32_t)p_max_size);
+
+		packet.data = (uint8_t *)memalloc(size);
+		packet.size = size;
+		int ret = Compression::decompress(packet.data, size, &p_data[4], p_data_size - 4, Compression::MODE_DEFLATE);
+		if (ret != (int)size) {
+			memfree(packet.data);
+			ERR_EXPLAIN("Invalid compressed packet received from peer: " + itos(p_source));
+			ERR_FAIL();
+		}
+	} else {
+		packet.data = (uint8_t *)memalloc(p_data_size);
+		packet.size = p_data_size;
+		copymem(packet.data, p_data, p_data_size);
+	}
+
 	_incoming_packets.push_back(packet);
 	emit_signal("peer_packet", p_source);
 }
 
-Error WebSocketMultiplayerPeer::_server_relay(int32_t p_from, int32_t p_to, const uint8_t *p_buffer, uint32_t p_buffer_size) {
+Error WebSocketMultiplayerPeer::_server_relay(int32_t p_from, int32_t p_to, const PoolVector<uint8_t> &p_frame) {
 	if (p_to == 1) {
 
 		return OK; // Will not send to self
@@ -252,7 +313,7 @@ Error WebSocketMultiplayerPeer::_server_relay(int32_t p_from, int32_t p_to, cons
 
 		for (Map<int, Ref<WebSocketPeer> >::Element *E = _peer_map.front(); E; E = E->next()) {
 			if (E->key() != p_from)
-				E->get()->put_packet(p_buffer, p_buffer_size);
+				E->get()->put_frame(p_frame);
 		}
 		return OK; // Sent to all but sender
 
@@ -260,7 +321,7 @@ Error WebSocketMultiplayerPeer::_server_relay(int32_t p_from, int32_t p_to, cons
 
 		for (Map<int, Ref<WebSocketPeer> >::Element *E = _peer_map.front(); E; E = E->next()) {
 			if (E->key() != p_from && E->key() != -p_to)
-				E->get()->put_packet(p_buffer, p_buffer_size);
+				E->get()->put_frame(p_frame);
 		}
 		return OK; // Sent to all but sender and excluded
 
@@ -268,7 +329,7 @@ Error WebSocketMultiplayerPeer::_server_relay(int32_t p_from, int32_t p_to, cons
 
 		ERR_FAIL_COND_V(p_to == p_from, FAILED);
 
-		return get_peer(p_to)->put_packet(p_buffer, p_buffer_size); // Sending to specific peer
+		return get_peer(p_to)->put_frame(p_frame); // Sending to specific peer
 	}
 }
 
@@ -294,40 +355,46 @@ void WebSocketMultiplayerPeer::_process_multiplayer(Ref<WebSocketPeer> p_peer, u
 	copymem(&from, &in_buffer[1], 4);
 	copymem(&to, &in_buffer[5], 4);
 
+	bool compressed = type & PROTO_COMPRESSED;
+	type &= ~PROTO_COMPRESSED;
+	const uint8_t *data = &in_buffer[PROTO_SIZE];
+	int max_size = p_peer->get_max_packet_size();
+
 	if (is_server()) { // Server can resend
 
 		ERR_FAIL_COND(type != SYS_NONE); // Only server sends sys messages
 		ERR_FAIL_COND(from != p_peer_id); // Someone is cheating
 
-		_server_relay(from, to, in_buffer, size); // Relay if needed
+		if (to != 1) {
+			// Relay as received, one shared frame for all recipients.
+			ERR_FAIL_COND(to > 1 && !_peer_map.has(to));
+			PoolVector<uint8_t> frame;
+			frame.resize(WebSocketPeer::FRAME_HEADROOM + size);
+			copymem(&frame.write()[WebSocketPeer::FRAME_HEADROOM], in_buffer, size);
+			_server_relay(from, to, frame);
+		}
 
 		if (to == 1) { // This is for the server
 
-			_store_pkt(from, to, in_buffer, data_size);
+			_store_pkt(from, to, data, data_size, compressed, max_size);
 
 		} else if (to == 0) {
 
 			// Broadcast, for us too
-			_store_pkt(from, to, in_buffer, data_size);
+			_store_pkt(from, to, data, data_size, compressed, max_size);
 
 		} else if (to < 0) {
 
 			// All but one, for us if not excluded
 			if (_peer_id != -(int32_t)p_peer_id)
-				_store_pkt(from, to, in_buffer, data_size);
-
-		} else {
-
-			// Send to specific peer
-			ERR_FAIL_COND(!_peer_map.has(to));
-			get_peer(to)->put_packet(in_buffer, size);
+				_store_pkt(from, to, data, data_size, compressed, max_size);
 		}
 
 	} else {
 
 		if (type == SYS_NONE) { // Payload message
 
-			_store_pkt(from, to, in_buffer, data_size);
+			_store_pkt(from, to, data, data_size, compressed, max_size);
 			return;
 		}
 
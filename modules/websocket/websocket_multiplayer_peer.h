@@ -42,8 +42,8 @@ class WebSocketMultiplayerPeer : public NetworkedMultiplayerPeer {
 
 private:
 	PoolVector<uint8_t> _make_pkt(uint32_t p_type, int32_t p_from, int32_t p_to, const uint8_t *p_data, uint32_t p_data_size);
-	void _store_pkt(int32_t p_source, int32_t p_dest, const uint8_t *p_data, uint32_t p_data_size);
-	Error _server_relay(int32_t p_from, int32_t p_to, const uint8_t *p_buffer, uint32_t p_buffer_size);
+	void _store_pkt(int32_t p_source, int32_t p_dest, const uint8_t *p_data, uint32_t p_data_size, bool p_compressed, int p_max_size);
+	Error _server_relay(int32_t p_from, int32_t p_to, const PoolVector<uint8_t> &p_frame);
 
 protected:
 	enum {
@@ -52,6 +52,7 @@ protected:
 		SYS_DEL = 2,
 		SYS_ID = 3,
 
+		PROTO_COMPRESSED = 0x80, // Type flag, payload is the uncompressed size followed by deflate data.
 		PROTO_SIZE = 9
 	};
 
@@ -70,6 +71,7 @@ protected:
 	int _target_peer;
 	int _peer_id;
 	int _refusing;
+	int _compression_threshold;
 
 	static void _bind_methods();
 
@@ -88,6 +90,9 @@ public:
 	virtual bool is_server() const = 0;
 	void set_refuse_new_connections(bool p_enable);
 	bool is_refusing_new_connections() const;
+
+	void set_compression_threshold(int p_bytes);
+	int get_compression_threshold() const;
 	virtual ConnectionStatus get_connection_status() const = 0;
 
 	/* PacketPeer */
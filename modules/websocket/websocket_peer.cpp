@@ -38,6 +38,14 @@ WebSocketPeer::WebSocketPeer() {
 WebSocketPeer::~WebSocketPeer() {
 }
 
+Error WebSocketPeer::put_frame(const PoolVector<uint8_t> &p_frame) {
+
+	ERR_FAIL_COND_V(p_frame.size() < FRAME_HEADROOM, ERR_INVALID_PARAMETER);
+
+	PoolVector<uint8_t>::Read r = p_frame.read();
+	return put_packet(&r[FRAME_HEADROOM], p_frame.size() - FRAME_HEADROOM);
+}
+
 void WebSocketPeer::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("get_write_mode"), &WebSocketPeer::get_write_mode);
 	ClassDB::bind_method(D_METHOD("set_write_mode", "mode"), &WebSocketPeer::set_write_mode);
@@ -46,6 +46,10 @@ public:
 		WRITE_MODE_BINARY,
 	};
 
+	enum {
+		FRAME_HEADROOM = 16 // Room left in front of a frame's payload for the transport header, see put_frame().
+	};
+
 protected:
 	static void _bind_methods();
 
@@ -65,6 +69,10 @@ public:
 	virtual uint16_t get_connected_port() const = 0;
 	virtual bool was_string_packet() const = 0;
 
+	// Sends the payload found after FRAME_HEADROOM bytes of p_frame. Implementations may keep a
+	// reference instead of copying, so one encoded frame can be queued on many peers.
+	virtual Error put_frame(const PoolVector<uint8_t> &p_frame);
+
 	WebSocketPeer();
 	~WebSocketPeer();
 };
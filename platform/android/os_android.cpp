@@ -305,6 +305,7 @@ bool OS_Android::main_loop_iterate() {
 
 	if (!main_loop)
 		return false;
+	input->flush_accumulated_events();
 	return Main::iteration();
 }
 
@@ -350,7 +351,7 @@ void OS_Android::process_joy_event(OS_Android::JoypadEvent p_event) {
 
 void OS_Android::process_event(Ref<InputEvent> p_event) {
 
-	input->parse_input_event(p_event);
+	input->accumulate_input_event(p_event);
 }
 
 void OS_Android::process_touch(int p_what, int p_pointer, const Vector<TouchPos> &p_points) {
@@ -367,7 +368,7 @@ void OS_Android::process_touch(int p_what, int p_pointer, const Vector<TouchPos>
 					ev->set_index(touch[i].id);
 					ev->set_pressed(false);
 					ev->set_position(touch[i].pos);
-					input->parse_input_event(ev);
+					input->accumulate_input_event(ev);
 				}
 			}
 
@@ -385,7 +386,7 @@ void OS_Android::process_touch(int p_what, int p_pointer, const Vector<TouchPos>
 				ev->set_index(touch[i].id);
 				ev->set_pressed(true);
 				ev->set_position(touch[i].pos);
-				input->parse_input_event(ev);
+				input->accumulate_input_event(ev);
 			}
 
 		} break;
@@ -409,12 +410,11 @@ void OS_Android::process_touch(int p_what, int p_pointer, const Vector<TouchPos>
 				if (touch[i].pos == p_points[idx].pos)
 					continue; //no move unncesearily
 
-				Ref<InputEventScreenDrag> ev;
-				ev.instance();
+				Ref<InputEventScreenDrag> ev = input->create_screen_drag_event();
 				ev->set_index(touch[i].id);
 				ev->set_position(p_points[idx].pos);
 				ev->set_relative(p_points[idx].pos - touch[i].pos);
-				input->parse_input_event(ev);
+				input->accumulate_input_event(ev);
 				touch.write[i].pos = p_points[idx].pos;
 			}
 
@@ -430,7 +430,7 @@ void OS_Android::process_touch(int p_what, int p_pointer, const Vector<TouchPos>
 					ev->set_index(touch[i].id);
 					ev->set_pressed(false);
 					ev->set_position(touch[i].pos);
-					input->parse_input_event(ev);
+					input->accumulate_input_event(ev);
 				}
 				touch.clear();
 			}
@@ -448,7 +448,7 @@ void OS_Android::process_touch(int p_what, int p_pointer, const Vector<TouchPos>
 					ev->set_index(tp.id);
 					ev->set_pressed(true);
 					ev->set_position(tp.pos);
-					input->parse_input_event(ev);
+					input->accumulate_input_event(ev);
 
 					break;
 				}
@@ -464,7 +464,7 @@ void OS_Android::process_touch(int p_what, int p_pointer, const Vector<TouchPos>
 					ev->set_index(touch[i].id);
 					ev->set_pressed(false);
 					ev->set_position(touch[i].pos);
-					input->parse_input_event(ev);
+					input->accumulate_input_event(ev);
 					touch.remove(i);
 
 					break;
@@ -86,6 +86,7 @@ void HaikuDirectWindow::DirectConnected(direct_buffer_info *info) {
 void HaikuDirectWindow::MessageReceived(BMessage *message) {
 	switch (message->what) {
 		case REDRAW_MSG:
+			input->flush_accumulated_events();
 			if (Main::iteration()) {
 				view->EnableDirectMode(false);
 				Quit();
@@ -190,7 +191,7 @@ void HaikuDirectWindow::HandleMouseButton(BMessage *message) {
 		}
 	}
 
-	input->parse_input_event(mouse_event);
+	input->accumulate_input_event(mouse_event);
 }
 
 void HaikuDirectWindow::HandleMouseMoved(BMessage *message) {
@@ -210,8 +211,7 @@ void HaikuDirectWindow::HandleMouseMoved(BMessage *message) {
 
 	Point2i rel = pos - last_mouse_position;
 
-	Ref<InputEventMouseMotion> motion_event;
-	motion_event.instance();
+	Ref<InputEventMouseMotion> motion_event = input->create_mouse_motion_event();
 	GetKeyModifierState(motion_event, modifiers);
 
 	motion_event->set_button_mask(GetMouseButtonState(buttons));
@@ -225,7 +225,7 @@ void HaikuDirectWindow::HandleMouseMoved(BMessage *message) {
 
 	last_mouse_position = pos;
 
-	input->parse_input_event(motion_event);
+	input->accumulate_input_event(motion_event);
 }
 
 void HaikuDirectWindow::HandleMouseWheelChanged(BMessage *message) {
@@ -246,10 +246,11 @@ void HaikuDirectWindow::HandleMouseWheelChanged(BMessage *message) {
 			last_mouse_position.y });
 
 	mouse_event->set_pressed(true);
-	input->parse_input_event(mouse_event);
+	input->accumulate_input_event(mouse_event);
 
+	mouse_event = mouse_event->duplicate();
 	mouse_event->set_pressed(false);
-	input->parse_input_event(mouse_event);
+	input->accumulate_input_event(mouse_event);
 }
 
 void HaikuDirectWindow::HandleKeyboardEvent(BMessage *message) {
@@ -288,7 +289,7 @@ void HaikuDirectWindow::HandleKeyboardEvent(BMessage *message) {
 		event->set_shift(true);
 	}
 
-	input->parse_input_event(event);
+	input->accumulate_input_event(event);
 }
 
 void HaikuDirectWindow::HandleKeyboardModifierEvent(BMessage *message) {
@@ -314,7 +315,7 @@ void HaikuDirectWindow::HandleKeyboardModifierEvent(BMessage *message) {
 	event->set_control(key & B_CONTROL_KEY);
 	event->set_command(key & B_COMMAND_KEY);
 
-	input->parse_input_event(event);
+	input->accumulate_input_event(event);
 }
 
 void HaikuDirectWindow::HandleWindowResized(BMessage *message) {
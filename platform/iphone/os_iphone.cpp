@@ -211,8 +211,9 @@ bool OSIPhone::iterate() {
 	if (main_loop) {
 		for (int i = 0; i < event_count; i++) {
 
-			input->parse_input_event(event_queue[i]);
+			input->accumulate_input_event(event_queue[i]);
 		};
+		input->flush_accumulated_events();
 	};
 	event_count = 0;
 
@@ -249,8 +250,7 @@ void OSIPhone::touch_drag(int p_idx, int p_prev_x, int p_prev_y, int p_x, int p_
 
 	if (!GLOBAL_DEF("debug/disable_touch", false)) {
 
-		Ref<InputEventScreenDrag> ev;
-		ev.instance();
+		Ref<InputEventScreenDrag> ev = input->create_screen_drag_event();
 		ev->set_index(p_idx);
 		ev->set_position(Vector2(p_x, p_y));
 		ev->set_relative(Vector2(p_x - p_prev_x, p_y - p_prev_y));
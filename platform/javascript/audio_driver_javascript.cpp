@@ -54,7 +54,9 @@ void AudioDriverJavaScript::mix_to_js() {
 	int channel_count = get_total_channels_by_speaker_mode(get_speaker_mode());
 	int sample_count = memarr_len(internal_buffer) / channel_count;
 	int32_t *stream_buffer = reinterpret_cast<int32_t *>(internal_buffer);
+	lock();
 	audio_server_process(sample_count, stream_buffer);
+	unlock();
 	for (int i = 0; i < sample_count * channel_count; i++) {
 		internal_buffer[i] = float(stream_buffer[i] >> 16) / 32768.f;
 	}
@@ -68,6 +70,9 @@ void AudioDriverJavaScript::process_capture(float sample) {
 
 Error AudioDriverJavaScript::init() {
 
+	if (!mutex)
+		mutex = Mutex::create();
+
 	/* clang-format off */
 	EM_ASM({
 		_audioDriver_audioContext = new (window.AudioContext || window.webkitAudioContext);
@@ -173,11 +178,18 @@ AudioDriver::SpeakerMode AudioDriverJavaScript::get_speaker_mode() const {
 	/* clang-format on */
 }
 
-// No locking, as threads are not supported.
+// Mixing happens on the main thread, but with threads enabled the audio
+// server can be used from other threads too.
 void AudioDriverJavaScript::lock() {
+
+	if (mutex)
+		mutex->lock();
 }
 
 void AudioDriverJavaScript::unlock() {
+
+	if (mutex)
+		mutex->unlock();
 }
 
 void AudioDriverJavaScript::finish() {
@@ -194,6 +206,11 @@ void AudioDriverJavaScript::finish() {
 		memdelete_arr(internal_buffer);
 		internal_buffer = NULL;
 	}
+
+	if (mutex) {
+		memdelete(mutex);
+		mutex = NULL;
+	}
 }
 
 Error AudioDriverJavaScript::capture_start() {
@@ -253,6 +270,7 @@ Error AudioDriverJavaScript::capture_stop() {
 AudioDriverJavaScript::AudioDriverJavaScript() {
 
 	internal_buffer = NULL;
+	mutex = NULL;
 
 	singleton = this;
 }
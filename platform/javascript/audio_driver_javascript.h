@@ -31,6 +31,7 @@
 #ifndef AUDIO_DRIVER_JAVASCRIPT_H
 #define AUDIO_DRIVER_JAVASCRIPT_H
 
+#include "core/os/mutex.h"
 #include "servers/audio_server.h"
 
 class AudioDriverJavaScript : public AudioDriver {
@@ -39,6 +40,8 @@ class AudioDriverJavaScript : public AudioDriver {
 
 	int buffer_length;
 
+	Mutex *mutex;
+
 public:
 	void mix_to_js();
 	void process_capture(float sample);
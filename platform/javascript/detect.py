@@ -19,6 +19,9 @@ def get_opts():
     return [
         # eval() can be a security concern, so it can be disabled.
         BoolVariable('javascript_eval', 'Enable JavaScript eval interface', True),
+        # Needs SharedArrayBuffer, which browsers only provide to cross-origin
+        # isolated pages.
+        BoolVariable('threads_enabled', 'Enable WebAssembly threads support', False),
     ]
 
 
@@ -107,9 +110,18 @@ def configure(env):
     env.Append(CPPPATH=['#platform/javascript'])
     env.Append(CPPDEFINES=['JAVASCRIPT_ENABLED', 'UNIX_ENABLED'])
 
-    # No multi-threading (SharedArrayBuffer) available yet,
-    # once feasible also consider memory buffer size issues.
-    env.Append(CPPDEFINES=['NO_THREADS'])
+    if env['threads_enabled']:
+        # Threads run in Web Workers sharing the module's memory. Every object
+        # must be built with the flag for atomics to be available.
+        env.Append(CCFLAGS=['-s', 'USE_PTHREADS=1'])
+        env.Append(LINKFLAGS=['-s', 'USE_PTHREADS=1'])
+        # Workers are started ahead of time, creating one on demand needs the
+        # main thread to return to the browser event loop first.
+        env.Append(LINKFLAGS=['-s', 'PTHREAD_POOL_SIZE=8'])
+        # Shared memory can't grow past a maximum fixed at startup.
+        env.Append(LINKFLAGS=['-s', 'WASM_MEM_MAX=2048MB'])
+    else:
+        env.Append(CPPDEFINES=['NO_THREADS'])
 
     # These flags help keep the file size down.
     env.Append(CCFLAGS=['-fno-exceptions', '-fno-rtti'])
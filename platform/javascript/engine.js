@@ -49,6 +49,7 @@
 		var unloadAfterInit = true;
 
 		var preloadedFiles = [];
+		var persistentCache = false;
 
 		var resizeCanvasOnStart = true;
 		var progressFunc = null;
@@ -112,10 +113,11 @@
 				});
 				return Promise.resolve();
 			} else if (typeof pathOrBuffer === 'string') {
-				return loadPromise(pathOrBuffer, preloadProgressTracker).then(function(xhr) {
+				var load = persistentCache ? loadCachedPromise : loadPromise;
+				return load(pathOrBuffer, preloadProgressTracker).then(function(response) {
 					preloadedFiles.push({
 						path: destPath || pathOrBuffer,
-						buffer: xhr.response
+						buffer: persistentCache ? response : response.response
 					});
 				});
 			} else {
@@ -216,6 +218,12 @@
 			resizeCanvasOnStart = enabled;
 		};
 
+		// Keep preloaded files in IndexedDB, so later visits only download
+		// them again when the server reports a change.
+		this.setPersistentCache = function(enabled) {
+			persistentCache = enabled;
+		};
+
 		function animateProgress() {
 
 			var loaded = 0;
@@ -350,20 +358,128 @@
 		});
 	}
 
-	function loadXHR(resolve, reject, file, tracker) {
+	function loadXHR(resolve, reject, file, tracker, cached) {
 
 		var xhr = new XMLHttpRequest;
 		xhr.open('GET', file);
 		if (!file.endsWith('.js')) {
 			xhr.responseType = 'arraybuffer';
 		}
+		if (cached) {
+			// A 304 answer means the cached copy is still good.
+			if (cached.etag)
+				xhr.setRequestHeader('If-None-Match', cached.etag);
+			else if (cached.lastModified)
+				xhr.setRequestHeader('If-Modified-Since', cached.lastModified);
+		}
 		['loadstart', 'progress', 'load', 'error', 'abort'].forEach(function(ev) {
-			xhr.addEventListener(ev, onXHREvent.bind(xhr, resolve, reject, file, tracker));
+			xhr.addEventListener(ev, onXHREvent.bind(xhr, resolve, reject, file, tracker, cached));
 		});
 		xhr.send();
 	}
 
-	function onXHREvent(resolve, reject, file, tracker, ev) {
+	var CACHE_DB_NAME = 'godot-preload-cache';
+	var CACHE_STORE_NAME = 'files';
+	var cacheDBPromise = null;
+
+	// Any failure (private browsing, quota, old browsers) just disables the
+	// cache, the file is then downloaded as usual.
+	function openCacheDB() {
+
+		if (!cacheDBPromise) {
+			cacheDBPromise = new Promise(function(resolve) {
+				if (typeof indexedDB === 'undefined') {
+					resolve(null);
+					return;
+				}
+				try {
+					var req = indexedDB.open(CACHE_DB_NAME, 1);
+					req.onupgradeneeded = function() {
+						req.result.createObjectStore(CACHE_STORE_NAME);
+					};
+					req.onsuccess = function() {
+						resolve(req.result);
+					};
+					req.onerror = function() {
+						resolve(null);
+					};
+				} catch (e) {
+					resolve(null);
+				}
+			});
+		}
+		return cacheDBPromise;
+	}
+
+	function getCacheKey(file) {
+
+		try {
+			return new URL(file, document.baseURI).href;
+		} catch (e) {
+			return file;
+		}
+	}
+
+	function cacheGet(file) {
+
+		return openCacheDB().then(function(db) {
+			return new Promise(function(resolve) {
+				if (!db) {
+					resolve(null);
+					return;
+				}
+				try {
+					var req = db.transaction(CACHE_STORE_NAME, 'readonly').objectStore(CACHE_STORE_NAME).get(getCacheKey(file));
+					req.onsuccess = function() {
+						resolve(req.result || null);
+					};
+					req.onerror = function() {
+						resolve(null);
+					};
+				} catch (e) {
+					resolve(null);
+				}
+			});
+		});
+	}
+
+	function cachePut(file, entry) {
+
+		openCacheDB().then(function(db) {
+			if (!db)
+				return;
+			try {
+				db.transaction(CACHE_STORE_NAME, 'readwrite').objectStore(CACHE_STORE_NAME).put(entry, getCacheKey(file));
+			} catch (e) {
+				// Not cached, downloaded again next time.
+			}
+		});
+	}
+
+	function loadCachedPromise(file, tracker) {
+
+		return cacheGet(file).then(function(cached) {
+			return new Promise(function(resolve, reject) {
+				loadXHR(resolve, reject, file, tracker, cached);
+			}).then(function(xhr) {
+				if (xhr.status === 304 && cached) {
+					return cached.buffer;
+				}
+				var etag = xhr.getResponseHeader('ETag');
+				var lastModified = xhr.getResponseHeader('Last-Modified');
+				if (etag || lastModified) {
+					cachePut(file, {
+						etag: etag,
+						lastModified: lastModified,
+						buffer: xhr.response
+					});
+				}
+				return xhr.response;
+			});
+		});
+	}
+
+	function onXHREvent(resolve, reject, file, tracker, cached, ev) {
 
 		if (this.status >= 400) {
 
@@ -372,7 +488,7 @@
 				this.abort();
 				return;
 			} else {
-				setTimeout(loadXHR.bind(null, resolve, reject, file, tracker), 1000);
+				setTimeout(loadXHR.bind(null, resolve, reject, file, tracker, cached), 1000);
 			}
 		}
 
@@ -403,7 +519,7 @@
 					tracker[file].final = true;
 					reject(new Error("Failed loading file '" + file + "'"));
 				} else {
-					setTimeout(loadXHR.bind(null, resolve, reject, file, tracker), 1000);
+					setTimeout(loadXHR.bind(null, resolve, reject, file, tracker, cached), 1000);
 				}
 				break;
 
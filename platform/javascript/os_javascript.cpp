@@ -244,6 +244,7 @@ EM_BOOL OS_JavaScript::keydown_callback(int p_event_type, const EmscriptenKeyboa
 		// Do not suppress keypress event.
 		return false;
 	}
+	os->input->flush_accumulated_events();
 	os->input->parse_input_event(ev);
 	// Resume audio context after input in case autoplay was denied.
 	os->audio_driver_javascript.resume();
@@ -254,6 +255,7 @@ EM_BOOL OS_JavaScript::keypress_callback(int p_event_type, const EmscriptenKeybo
 
 	OS_JavaScript *os = get_singleton();
 	os->deferred_key_event->set_unicode(p_event->charCode);
+	os->input->flush_accumulated_events();
 	os->input->parse_input_event(os->deferred_key_event);
 	return true;
 }
@@ -262,6 +264,7 @@ EM_BOOL OS_JavaScript::keyup_callback(int p_event_type, const EmscriptenKeyboard
 
 	Ref<InputEventKey> ev = setup_key_event(p_event);
 	ev->set_pressed(false);
+	get_singleton()->input->flush_accumulated_events();
 	get_singleton()->input->parse_input_event(ev);
 	return ev->get_scancode() != KEY_UNKNOWN && ev->get_scancode() != 0;
 }
@@ -336,6 +339,7 @@ EM_BOOL OS_JavaScript::mouse_button_callback(int p_event_type, const EmscriptenM
 	}
 	ev->set_button_mask(mask);
 
+	os->input->flush_accumulated_events();
 	os->input->parse_input_event(ev);
 	// Resume audio context after input in case autoplay was denied.
 	os->audio_driver_javascript.resume();
@@ -355,8 +359,7 @@ EM_BOOL OS_JavaScript::mousemove_callback(int p_event_type, const EmscriptenMous
 	if (!cursor_inside_canvas && !input_mask)
 		return false;
 
-	Ref<InputEventMouseMotion> ev;
-	ev.instance();
+	Ref<InputEventMouseMotion> ev = os->input->create_mouse_motion_event();
 	dom2godot_mod(p_event, ev);
 	ev->set_button_mask(input_mask);
 
@@ -367,7 +370,8 @@ EM_BOOL OS_JavaScript::mousemove_callback(int p_event_type, const EmscriptenMous
 	os->input->set_mouse_position(ev->get_position());
 	ev->set_speed(os->input->get_last_mouse_speed());
 
-	os->input->parse_input_event(ev);
+	// Parsed once per frame, other events flush it first to keep the order.
+	os->input->accumulate_input_event(ev);
 	// Don't suppress mouseover/-leave events.
 	return false;
 }
@@ -632,6 +636,7 @@ EM_BOOL OS_JavaScript::wheel_callback(int p_event_type, const EmscriptenWheelEve
 
 	ev->set_pressed(true);
 	ev->set_button_mask(input->get_mouse_button_mask() | button_flag);
+	input->flush_accumulated_events();
 	input->parse_input_event(ev);
 
 	ev->set_pressed(false);
@@ -670,6 +675,7 @@ EM_BOOL OS_JavaScript::touch_press_callback(int p_event_type, const EmscriptenTo
 		os->touches[i] = ev->get_position();
 		ev->set_pressed(p_event_type == EMSCRIPTEN_EVENT_TOUCHSTART);
 
+		os->input->flush_accumulated_events();
 		os->input->parse_input_event(ev);
 	}
 	// Resume audio context after input in case autoplay was denied.
@@ -680,8 +686,6 @@ EM_BOOL OS_JavaScript::touch_press_callback(int p_event_type, const EmscriptenTo
 EM_BOOL OS_JavaScript::touchmove_callback(int p_event_type, const EmscriptenTouchEvent *p_event, void *p_user_data) {
 
 	OS_JavaScript *os = get_singleton();
-	Ref<InputEventScreenDrag> ev;
-	ev.instance();
 	int lowest_id_index = -1;
 	for (int i = 0; i < p_event->numTouches; ++i) {
 
@@ -690,13 +694,14 @@ EM_BOOL OS_JavaScript::touchmove_callback(int p_event_type, const EmscriptenTouc
 			lowest_id_index = i;
 		if (!touch.isChanged)
 			continue;
+		Ref<InputEventScreenDrag> ev = os->input->create_screen_drag_event();
 		ev->set_index(touch.identifier);
 		ev->set_position(Point2(touch.canvasX, touch.canvasY));
 		Point2 &prev = os->touches[i];
 		ev->set_relative(ev->get_position() - prev);
 		prev = ev->get_position();
 
-		os->input->parse_input_event(ev);
+		os->input->accumulate_input_event(ev);
 	}
 	return true;
 }
@@ -1020,6 +1025,7 @@ bool OS_JavaScript::main_loop_iterate() {
 		windowed_size.height = canvas[1];
 	}
 
+	input->flush_accumulated_events();
 	return Main::iteration();
 }
 
@@ -637,8 +637,7 @@ static void _mouseDownEvent(NSEvent *event, int index, int mask, bool pressed) {
 
 - (void)mouseMoved:(NSEvent *)event {
 
-	Ref<InputEventMouseMotion> mm;
-	mm.instance();
+	Ref<InputEventMouseMotion> mm = OS_OSX::singleton->input->create_mouse_motion_event();
 
 	mm->set_button_mask(button_mask);
 	const CGFloat backingScaleFactor = [[event window] backingScaleFactor];
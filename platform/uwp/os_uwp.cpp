@@ -368,7 +368,7 @@ String OS_UWP::get_clipboard() const {
 
 void OS_UWP::input_event(const Ref<InputEvent> &p_event) {
 
-	input->parse_input_event(p_event);
+	input->accumulate_input_event(p_event);
 };
 
 void OS_UWP::delete_main_loop() {
@@ -869,6 +869,7 @@ void OS_UWP::run() {
 		CoreWindow::GetForCurrentThread()->Dispatcher->ProcessEvents(CoreProcessEventsOption::ProcessAllIfPresent);
 		if (managed_object->alert_close_handle) continue;
 		process_events(); // get rid of pending events
+		input->flush_accumulated_events();
 		if (Main::iteration())
 			break;
 	};
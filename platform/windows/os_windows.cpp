@@ -287,8 +287,7 @@ void OS_Windows::_drag_event(float p_x, float p_y, int idx) {
 
 	curr->get() = Vector2(p_x, p_y);
 
-	Ref<InputEventScreenDrag> event;
-	event.instance();
+	Ref<InputEventScreenDrag> event = input->create_screen_drag_event();
 	event->set_index(idx);
 	event->set_position(Vector2(p_x, p_y));
 
@@ -407,8 +406,7 @@ LRESULT OS_Windows::WndProc(HWND hWnd, UINT uMsg, WPARAM wParam, LPARAM lParam)
 			RAWINPUT *raw = (RAWINPUT *)lpb;
 
 			if (raw->header.dwType == RIM_TYPEMOUSE) {
-				Ref<InputEventMouseMotion> mm;
-				mm.instance();
+				Ref<InputEventMouseMotion> mm = input->create_mouse_motion_event();
 
 				mm->set_control(control_mem);
 				mm->set_shift(shift_mem);
@@ -501,8 +499,7 @@ LRESULT OS_Windows::WndProc(HWND hWnd, UINT uMsg, WPARAM wParam, LPARAM lParam)
 			if (!window_has_focus && mouse_mode == MOUSE_MODE_CAPTURED)
 				break;
 
-			Ref<InputEventMouseMotion> mm;
-			mm.instance();
+			Ref<InputEventMouseMotion> mm = input->create_mouse_motion_event();
 
 			mm->set_control((wParam & MK_CONTROL) != 0);
 			mm->set_shift((wParam & MK_SHIFT) != 0);
@@ -1529,6 +1526,7 @@ void OS_Windows::finalize() {
 
 void OS_Windows::finalize_core() {
 
+	FileAccessWindows::finish_async_reads();
 	timeEndPeriod(1);
 
 	memdelete(process_map);
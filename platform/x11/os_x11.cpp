@@ -2009,8 +2009,7 @@ void OS_X11::process_xevents() {
 
 						if (curr_pos_elem->value() != pos) {
 
-							Ref<InputEventScreenDrag> sd;
-							sd.instance();
+							Ref<InputEventScreenDrag> sd = input->create_screen_drag_event();
 							sd->set_index(index);
 							sd->set_position(pos);
 							sd->set_relative(pos - curr_pos_elem->value());
@@ -2251,8 +2250,7 @@ void OS_X11::process_xevents() {
 					pos = Point2i(current_videomode.width / 2, current_videomode.height / 2);
 				}
 
-				Ref<InputEventMouseMotion> mm;
-				mm.instance();
+				Ref<InputEventMouseMotion> mm = input->create_mouse_motion_event();
 
 				// Make the absolute position integral so it doesn't look _too_ weird :)
 				Point2i posi(pos);
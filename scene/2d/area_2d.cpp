@@ -29,6 +29,7 @@
 /*************************************************************************/
 
 #include "area_2d.h"
+#include "core/engine.h"
 #include "scene/scene_string_names.h"
 #include "servers/audio_server.h"
 #include "servers/physics_2d_server.h"
@@ -125,10 +126,12 @@ void Area2D::_body_enter_tree(ObjectID p_id) {
 	ERR_FAIL_COND(E->get().in_tree);
 
 	E->get().in_tree = true;
-	emit_signal(SceneStringNames::get_singleton()->body_entered, node);
-	for (int i = 0; i < E->get().shapes.size(); i++) {
+	_overlap_changed(body_changes, p_id, true, SceneStringNames::get_singleton()->body_entered, node);
+	if (overlap_signals) {
+		for (int i = 0; i < E->get().shapes.size(); i++) {
 
-		emit_signal(SceneStringNames::get_singleton()->body_shape_entered, p_id, node, E->get().shapes[i].body_shape, E->get().shapes[i].area_shape);
+			emit_signal(SceneStringNames::get_singleton()->body_shape_entered, p_id, node, E->get().shapes[i].body_shape, E->get().shapes[i].area_shape);
+		}
 	}
 }
 
@@ -141,10 +144,12 @@ void Area2D::_body_exit_tree(ObjectID p_id) {
 	ERR_FAIL_COND(!E);
 	ERR_FAIL_COND(!E->get().in_tree);
 	E->get().in_tree = false;
-	emit_signal(SceneStringNames::get_singleton()->body_exited, node);
-	for (int i = 0; i < E->get().shapes.size(); i++) {
+	_overlap_changed(body_changes, p_id, false, SceneStringNames::get_singleton()->body_exited, node);
+	if (overlap_signals) {
+		for (int i = 0; i < E->get().shapes.size(); i++) {
 
-		emit_signal(SceneStringNames::get_singleton()->body_shape_exited, p_id, node, E->get().shapes[i].body_shape, E->get().shapes[i].area_shape);
+			emit_signal(SceneStringNames::get_singleton()->body_shape_exited, p_id, node, E->get().shapes[i].body_shape, E->get().shapes[i].area_shape);
+		}
 	}
 }
 
@@ -174,7 +179,7 @@ void Area2D::_body_inout(int p_status, const RID &p_body, int p_instance, int p_
 				node->connect(SceneStringNames::get_singleton()->tree_entered, this, SceneStringNames::get_singleton()->_body_enter_tree, make_binds(objid));
 				node->connect(SceneStringNames::get_singleton()->tree_exiting, this, SceneStringNames::get_singleton()->_body_exit_tree, make_binds(objid));
 				if (E->get().in_tree) {
-					emit_signal(SceneStringNames::get_singleton()->body_entered, node);
+					_overlap_changed(body_changes, objid, true, SceneStringNames::get_singleton()->body_entered, node);
 				}
 			}
 		}
@@ -182,7 +187,7 @@ void Area2D::_body_inout(int p_status, const RID &p_body, int p_instance, int p_
 		if (node)
 			E->get().shapes.insert(ShapePair(p_body_shape, p_area_shape));
 
-		if (!node || E->get().in_tree) {
+		if (overlap_signals && (!node || E->get().in_tree)) {
 			emit_signal(SceneStringNames::get_singleton()->body_shape_entered, objid, node, p_body_shape, p_area_shape);
 		}
 
@@ -201,12 +206,12 @@ void Area2D::_body_inout(int p_status, const RID &p_body, int p_instance, int p_
 				node->disconnect(SceneStringNames::get_singleton()->tree_entered, this, SceneStringNames::get_singleton()->_body_enter_tree);
 				node->disconnect(SceneStringNames::get_singleton()->tree_exiting, this, SceneStringNames::get_singleton()->_body_exit_tree);
 				if (E->get().in_tree)
-					emit_signal(SceneStringNames::get_singleton()->body_exited, obj);
+					_overlap_changed(body_changes, objid, false, SceneStringNames::get_singleton()->body_exited, obj);
 			}
 
 			eraseit = true;
 		}
-		if (!node || E->get().in_tree) {
+		if (overlap_signals && (!node || E->get().in_tree)) {
 			emit_signal(SceneStringNames::get_singleton()->body_shape_exited, objid, obj, p_body_shape, p_area_shape);
 		}
 
@@ -228,10 +233,12 @@ void Area2D::_area_enter_tree(ObjectID p_id) {
 	ERR_FAIL_COND(E->get().in_tree);
 
 	E->get().in_tree = true;
-	emit_signal(SceneStringNames::get_singleton()->area_entered, node);
-	for (int i = 0; i < E->get().shapes.size(); i++) {
+	_overlap_changed(area_changes, p_id, true, SceneStringNames::get_singleton()->area_entered, node);
+	if (overlap_signals) {
+		for (int i = 0; i < E->get().shapes.size(); i++) {
 
-		emit_signal(SceneStringNames::get_singleton()->area_shape_entered, p_id, node, E->get().shapes[i].area_shape, E->get().shapes[i].self_shape);
+			emit_signal(SceneStringNames::get_singleton()->area_shape_entered, p_id, node, E->get().shapes[i].area_shape, E->get().shapes[i].self_shape);
+		}
 	}
 }
 
@@ -244,10 +251,12 @@ void Area2D::_area_exit_tree(ObjectID p_id) {
 	ERR_FAIL_COND(!E);
 	ERR_FAIL_COND(!E->get().in_tree);
 	E->get().in_tree = false;
-	emit_signal(SceneStringNames::get_singleton()->area_exited, node);
-	for (int i = 0; i < E->get().shapes.size(); i++) {
+	_overlap_changed(area_changes, p_id, false, SceneStringNames::get_singleton()->area_exited, node);
+	if (overlap_signals) {
+		for (int i = 0; i < E->get().shapes.size(); i++) {
 
-		emit_signal(SceneStringNames::get_singleton()->area_shape_exited, p_id, node, E->get().shapes[i].area_shape, E->get().shapes[i].self_shape);
+			emit_signal(SceneStringNames::get_singleton()->area_shape_exited, p_id, node, E->get().shapes[i].area_shape, E->get().shapes[i].self_shape);
+		}
 	}
 }
 
@@ -275,7 +284,7 @@ void Area2D::_area_inout(int p_status, const RID &p_area, int p_instance, int p_
 				node->connect(SceneStringNames::get_singleton()->tree_entered, this, SceneStringNames::get_singleton()->_area_enter_tree, make_binds(objid));
 				node->connect(SceneStringNames::get_singleton()->tree_exiting, this, SceneStringNames::get_singleton()->_area_exit_tree, make_binds(objid));
 				if (E->get().in_tree) {
-					emit_signal(SceneStringNames::get_singleton()->area_entered, node);
+					_overlap_changed(area_changes, objid, true, SceneStringNames::get_singleton()->area_entered, node);
 				}
 			}
 		}
@@ -283,7 +292,7 @@ void Area2D::_area_inout(int p_status, const RID &p_area, int p_instance, int p_
 		if (node)
 			E->get().shapes.insert(AreaShapePair(p_area_shape, p_self_shape));
 
-		if (!node || E->get().in_tree) {
+		if (overlap_signals && (!node || E->get().in_tree)) {
 			emit_signal(SceneStringNames::get_singleton()->area_shape_entered, objid, node, p_area_shape, p_self_shape);
 		}
 
@@ -302,12 +311,12 @@ void Area2D::_area_inout(int p_status, const RID &p_area, int p_instance, int p_
 				node->disconnect(SceneStringNames::get_singleton()->tree_entered, this, SceneStringNames::get_singleton()->_area_enter_tree);
 				node->disconnect(SceneStringNames::get_singleton()->tree_exiting, this, SceneStringNames::get_singleton()->_area_exit_tree);
 				if (E->get().in_tree)
-					emit_signal(SceneStringNames::get_singleton()->area_exited, obj);
+					_overlap_changed(area_changes, objid, false, SceneStringNames::get_singleton()->area_exited, obj);
 			}
 
 			eraseit = true;
 		}
-		if (!node || E->get().in_tree) {
+		if (overlap_signals && (!node || E->get().in_tree)) {
 			emit_signal(SceneStringNames::get_singleton()->area_shape_exited, objid, obj, p_area_shape, p_self_shape);
 		}
 
@@ -345,12 +354,14 @@ void Area2D::_clear_monitoring() {
 			if (!E->get().in_tree)
 				continue;
 
-			for (int i = 0; i < E->get().shapes.size(); i++) {
+			if (overlap_signals) {
+				for (int i = 0; i < E->get().shapes.size(); i++) {
 
-				emit_signal(SceneStringNames::get_singleton()->body_shape_exited, E->key(), node, E->get().shapes[i].body_shape, E->get().shapes[i].area_shape);
+					emit_signal(SceneStringNames::get_singleton()->body_shape_exited, E->key(), node, E->get().shapes[i].body_shape, E->get().shapes[i].area_shape);
+				}
 			}
 
-			emit_signal(SceneStringNames::get_singleton()->body_exited, obj);
+			_overlap_changed(body_changes, E->key(), false, SceneStringNames::get_singleton()->body_exited, obj);
 		}
 	}
 
@@ -375,12 +386,14 @@ void Area2D::_clear_monitoring() {
 			if (!E->get().in_tree)
 				continue;
 
-			for (int i = 0; i < E->get().shapes.size(); i++) {
+			if (overlap_signals) {
+				for (int i = 0; i < E->get().shapes.size(); i++) {
 
-				emit_signal(SceneStringNames::get_singleton()->area_shape_exited, E->key(), node, E->get().shapes[i].area_shape, E->get().shapes[i].self_shape);
+					emit_signal(SceneStringNames::get_singleton()->area_shape_exited, E->key(), node, E->get().shapes[i].area_shape, E->get().shapes[i].self_shape);
+				}
 			}
 
-			emit_signal(SceneStringNames::get_singleton()->area_exited, obj);
+			_overlap_changed(area_changes, E->key(), false, SceneStringNames::get_singleton()->area_exited, obj);
 		}
 	}
 }
@@ -498,6 +511,70 @@ bool Area2D::overlaps_body(Node *p_body) const {
 	return E->get().in_tree;
 }
 
+void Area2D::_overlap_changed(OverlapChanges &r_changes, ObjectID p_id, bool p_entered, const StringName &p_signal, Object *p_obj) {
+
+	uint64_t frame = Engine::get_singleton()->get_physics_frames();
+	if (r_changes.frame != frame) {
+		r_changes.frame = frame;
+		r_changes.entered.clear();
+		r_changes.exited.clear();
+	}
+
+	if (p_entered) {
+		r_changes.entered.push_back(p_id);
+	} else {
+		r_changes.exited.push_back(p_id);
+	}
+
+	if (overlap_signals) {
+		emit_signal(p_signal, p_obj);
+	}
+}
+
+Array Area2D::_get_overlap_changes(const OverlapChanges &p_changes, bool p_entered) const {
+
+	Array ret;
+	if (p_changes.frame != Engine::get_singleton()->get_physics_frames())
+		return ret;
+
+	const Vector<ObjectID> &ids = p_entered ? p_changes.entered : p_changes.exited;
+	ret.resize(ids.size());
+	for (int i = 0; i < ids.size(); i++) {
+		ret[i] = ids[i];
+	}
+	return ret;
+}
+
+void Area2D::set_overlap_signals_enabled(bool p_enabled) {
+
+	overlap_signals = p_enabled;
+}
+
+bool Area2D::is_overlap_signals_enabled() const {
+
+	return overlap_signals;
+}
+
+Array Area2D::get_entered_body_ids() const {
+
+	return _get_overlap_changes(body_changes, true);
+}
+
+Array Area2D::get_exited_body_ids() const {
+
+	return _get_overlap_changes(body_changes, false);
+}
+
+Array Area2D::get_entered_area_ids() const {
+
+	return _get_overlap_changes(area_changes, true);
+}
+
+Array Area2D::get_exited_area_ids() const {
+
+	return _get_overlap_changes(area_changes, false);
+}
+
 void Area2D::set_collision_mask(uint32_t p_mask) {
 
 	collision_mask = p_mask;
@@ -645,6 +722,14 @@ void Area2D::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("get_overlapping_areas"), &Area2D::get_overlapping_areas);
 
 	ClassDB::bind_method(D_METHOD("overlaps_body", "body"), &Area2D::overlaps_body);
+
+	ClassDB::bind_method(D_METHOD("set_overlap_signals_enabled", "enabled"), &Area2D::set_overlap_signals_enabled);
+	ClassDB::bind_method(D_METHOD("is_overlap_signals_enabled"), &Area2D::is_overlap_signals_enabled);
+
+	ClassDB::bind_method(D_METHOD("get_entered_body_ids"), &Area2D::get_entered_body_ids);
+	ClassDB::bind_method(D_METHOD("get_exited_body_ids"), &Area2D::get_exited_body_ids);
+	ClassDB::bind_method(D_METHOD("get_entered_area_ids"), &Area2D::get_entered_area_ids);
+	ClassDB::bind_method(D_METHOD("get_exited_area_ids"), &Area2D::get_exited_area_ids);
 	ClassDB::bind_method(D_METHOD("overlaps_area", "area"), &Area2D::overlaps_area);
 
 	ClassDB::bind_method(D_METHOD("set_audio_bus_name", "name"), &Area2D::set_audio_bus_name);
@@ -676,6 +761,7 @@ void Area2D::_bind_methods() {
 	ADD_PROPERTY(PropertyInfo(Variant::INT, "priority", PROPERTY_HINT_RANGE, "0,128,1"), "set_priority", "get_priority");
 	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "monitoring"), "set_monitoring", "is_monitoring");
 	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "monitorable"), "set_monitorable", "is_monitorable");
+	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "overlap_signals_enabled"), "set_overlap_signals_enabled", "is_overlap_signals_enabled");
 	ADD_GROUP("Collision", "collision_");
 	ADD_PROPERTY(PropertyInfo(Variant::INT, "collision_layer", PROPERTY_HINT_LAYERS_2D_PHYSICS), "set_collision_layer", "get_collision_layer");
 	ADD_PROPERTY(PropertyInfo(Variant::INT, "collision_mask", PROPERTY_HINT_LAYERS_2D_PHYSICS), "set_collision_mask", "get_collision_mask");
@@ -702,6 +788,7 @@ Area2D::Area2D() :
 	linear_damp = 0.1;
 	angular_damp = 1;
 	locked = false;
+	overlap_signals = true;
 	priority = 0;
 	monitoring = false;
 	monitorable = false;
@@ -61,6 +61,23 @@ private:
 	bool monitoring;
 	bool monitorable;
 	bool locked;
+	bool overlap_signals;
+
+	// Overlaps that started or ended during the current physics frame, for polling.
+	struct OverlapChanges {
+
+		uint64_t frame;
+		Vector<ObjectID> entered;
+		Vector<ObjectID> exited;
+
+		OverlapChanges() { frame = 0; }
+	};
+
+	OverlapChanges body_changes;
+	OverlapChanges area_changes;
+
+	void _overlap_changed(OverlapChanges &r_changes, ObjectID p_id, bool p_entered, const StringName &p_signal, Object *p_obj);
+	Array _get_overlap_changes(const OverlapChanges &p_changes, bool p_entered) const;
 
 	void _body_inout(int p_status, const RID &p_body, int p_instance, int p_body_shape, int p_area_shape);
 
@@ -184,6 +201,14 @@ public:
 	bool overlaps_area(Node *p_area) const;
 	bool overlaps_body(Node *p_body) const;
 
+	void set_overlap_signals_enabled(bool p_enabled);
+	bool is_overlap_signals_enabled() const;
+
+	Array get_entered_body_ids() const;
+	Array get_exited_body_ids() const;
+	Array get_entered_area_ids() const;
+	Array get_exited_area_ids() const;
+
 	void set_audio_bus_override(bool p_override);
 	bool is_overriding_audio_bus() const;
 
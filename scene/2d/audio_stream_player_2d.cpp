@@ -33,6 +33,7 @@
 #include "core/engine.h"
 #include "scene/2d/area_2d.h"
 #include "scene/main/viewport.h"
+#include "servers/audio/audio_mix_kernels.h"
 
 void AudioStreamPlayer2D::_mix_audio() {
 
@@ -97,11 +98,7 @@ void AudioStreamPlayer2D::_mix_audio() {
 
 			AudioFrame *target = AudioServer::get_singleton()->thread_get_channel_mix_buffer(current.bus_index, 0);
 
-			for (int j = 0; j < buffer_size; j++) {
-
-				target[j] += buffer[j] * vol;
-				vol += vol_inc;
-			}
+			AudioMixKernels::mix_ramp(buffer, target, buffer_size, vol, vol_inc);
 
 		} else {
 			AudioFrame *targets[4];
@@ -119,13 +116,8 @@ void AudioStreamPlayer2D::_mix_audio() {
 			if (!valid)
 				continue;
 
-			for (int j = 0; j < buffer_size; j++) {
-
-				AudioFrame frame = buffer[j] * vol;
-				for (int k = 0; k < cc; k++) {
-					targets[k][j] += frame;
-				}
-				vol += vol_inc;
+			for (int k = 0; k < cc; k++) {
+				AudioMixKernels::mix_ramp(buffer, targets[k], buffer_size, vol, vol_inc);
 			}
 		}
 
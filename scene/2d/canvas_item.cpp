@@ -479,13 +479,27 @@ Transform2D CanvasItem::get_global_transform() const {
 #endif
 	if (global_invalid) {
 
-		const CanvasItem *pi = get_parent_item();
-		if (pi)
-			global_transform = pi->get_global_transform() * get_transform();
-		else
-			global_transform = get_transform();
+		// Resolve the invalid ancestors top-down instead of recursing once per level.
+		const CanvasItem *chain[GLOBAL_XFORM_CHAIN_MAX];
+		const CanvasItem *pi = this;
+		int depth = 0;
+
+		while (pi && pi->global_invalid && depth < GLOBAL_XFORM_CHAIN_MAX) {
+			chain[depth++] = pi;
+			pi = pi->get_parent_item();
+		}
+
+		for (int i = depth - 1; i >= 0; i--) {
 
-		global_invalid = false;
+			const CanvasItem *ci = chain[i];
+			if (pi)
+				ci->global_transform = pi->get_global_transform() * ci->get_transform();
+			else
+				ci->global_transform = ci->get_transform();
+
+			ci->global_invalid = false;
+			pi = ci;
+		}
 	}
 
 	return global_transform;
@@ -575,7 +589,7 @@ void CanvasItem::_notification(int p_what) {
 			}
 			_enter_canvas();
 			if (!block_transform_notify && !xform_change.in_list()) {
-				get_tree()->xform_change_list.add(&xform_change);
+				get_tree()->_add_xform_change(&xform_change);
 			}
 		} break;
 		case NOTIFICATION_MOVED_IN_PARENT: {
@@ -633,6 +647,8 @@ void CanvasItem::update() {
 		return;
 	if (pending_update)
 		return;
+	if (VisualServer::get_singleton()->is_null_mode())
+		return; // nothing will ever be drawn, don't queue the draw callback
 
 	pending_update = true;
 
@@ -943,22 +959,38 @@ void CanvasItem::_notify_transform(CanvasItem *p_node) {
 		return; //nothing to do
 	}
 
-	p_node->global_invalid = true;
+	// The subtree is walked depth first without recursion, climbing back through the parent links.
+	CanvasItem *n = p_node;
+	while (true) {
+
+		n->global_invalid = true;
 
-	if (p_node->notify_transform && !p_node->xform_change.in_list()) {
-		if (!p_node->block_transform_notify) {
-			if (p_node->is_inside_tree())
-				get_tree()->xform_change_list.add(&p_node->xform_change);
+		if (n->notify_transform && !n->xform_change.in_list()) {
+			if (!n->block_transform_notify) {
+				if (n->is_inside_tree())
+					get_tree()->_add_xform_change(&n->xform_change);
+			}
+		}
+
+		CanvasItem *next = _next_transform_notified(n->children_items.front());
+		while (!next && n != p_node) {
+			next = _next_transform_notified(n->C->next());
+			if (!next)
+				n = static_cast<CanvasItem *>(n->get_parent()); // owns the children_items list n->C belongs to
 		}
+
+		if (!next)
+			return;
+		n = next;
 	}
+}
 
-	for (List<CanvasItem *>::Element *E = p_node->children_items.front(); E; E = E->next()) {
+CanvasItem *CanvasItem::_next_transform_notified(List<CanvasItem *>::Element *E) {
 
-		CanvasItem *ci = E->get();
-		if (ci->toplevel)
-			continue;
-		_notify_transform(ci);
+	while (E && (E->get()->toplevel || E->get()->global_invalid)) {
+		E = E->next();
 	}
+	return E ? E->get() : NULL;
 }
 
 Rect2 CanvasItem::get_viewport_rect() const {
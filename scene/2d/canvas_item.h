@@ -205,6 +205,10 @@ private:
 
 	Ref<Material> material;
 
+	enum {
+		GLOBAL_XFORM_CHAIN_MAX = 32
+	};
+
 	mutable Transform2D global_transform;
 	mutable bool global_invalid;
 
@@ -218,6 +222,7 @@ private:
 	void _exit_canvas();
 
 	void _notify_transform(CanvasItem *p_node);
+	static CanvasItem *_next_transform_notified(List<CanvasItem *>::Element *E);
 
 	void _set_on_top(bool p_on_top) { set_draw_behind_parent(!p_on_top); }
 	bool _is_on_top() const { return !is_draw_behind_parent_enabled(); }
@@ -497,6 +497,21 @@ void CPUParticles2D::_validate_property(PropertyInfo &property) const {
 	*/
 }
 
+ThreadWorkPool *CPUParticles2D::process_pool = NULL;
+
+void CPUParticles2D::set_threaded_processing(bool p_enable) {
+
+#ifndef NO_THREADS
+	if (p_enable && !process_pool) {
+		process_pool = memnew(ThreadWorkPool);
+		process_pool->init();
+	} else if (!p_enable && process_pool) {
+		memdelete(process_pool);
+		process_pool = NULL;
+	}
+#endif
+}
+
 static uint32_t idhash(uint32_t x) {
 
 	x = ((x >> uint32_t(16)) ^ x) * uint32_t(0x45d9f3b);
@@ -548,6 +563,7 @@ void CPUParticles2D::_particles_process(float p_delta) {
 	for (int i = 0; i < pcount; i++) {
 
 		Particle &p = parray[i];
+		p.process = false;
 
 		if (!emitting && !p.active)
 			continue;
@@ -675,9 +691,54 @@ void CPUParticles2D::_particles_process(float p_delta) {
 				p.transform = emission_xform * p.transform;
 			}
 
+			p.restarted = true;
+
 		} else if (!p.active) {
 			continue;
 		} else {
+			p.restarted = false;
+		}
+
+		p.process_delta = local_delta;
+		p.process = true;
+	}
+
+	// Gradient sorts its points lazily, do it here before workers read it.
+	if (color_ramp.is_valid()) {
+		color_ramp->get_color_at_offset(0);
+	}
+
+	ParticleProcessJob job;
+	job.particles = parray;
+	job.count = pcount;
+	job.emission_origin = emission_xform[2];
+
+	if (process_pool && pcount >= PARTICLE_THREADED_MIN) {
+		process_pool->do_work((pcount + PARTICLE_CHUNK_SIZE - 1) / PARTICLE_CHUNK_SIZE, this, &CPUParticles2D::_process_particle_chunk, &job);
+	} else {
+		_process_particles(parray, 0, pcount, job.emission_origin);
+	}
+}
+
+void CPUParticles2D::_process_particle_chunk(uint32_t p_chunk, ParticleProcessJob *p_job) {
+
+	int from = p_chunk * PARTICLE_CHUNK_SIZE;
+	int to = MIN(from + PARTICLE_CHUNK_SIZE, p_job->count);
+	_process_particles(p_job->particles, from, to, p_job->emission_origin);
+}
+
+void CPUParticles2D::_process_particles(Particle *p_particles, int p_from, int p_to, const Vector2 &p_emission_origin) {
+
+	for (int i = p_from; i < p_to; i++) {
+
+		Particle &p = p_particles[i];
+
+		if (!p.process)
+			continue;
+
+		float local_delta = p.process_delta;
+
+		if (!p.restarted) {
 
 			uint32_t alt_seed = p.seed;
 
@@ -743,7 +804,7 @@ void CPUParticles2D::_particles_process(float p_delta) {
 			//apply linear acceleration
 			force += p.velocity.length() > 0.0 ? p.velocity.normalized() * (parameters[PARAM_LINEAR_ACCEL] + tex_linear_accel) * Math::lerp(1.0f, rand_from_seed(alt_seed), randomness[PARAM_LINEAR_ACCEL]) : Vector2();
 			//apply radial acceleration
-			Vector2 org = emission_xform[2];
+			Vector2 org = p_emission_origin;
 			Vector2 diff = pos - org;
 			force += diff.length() > 0.0 ? diff.normalized() * (parameters[PARAM_RADIAL_ACCEL] + tex_radial_accel) * Math::lerp(1.0f, rand_from_seed(alt_seed), randomness[PARAM_RADIAL_ACCEL]) : Vector2();
 			//apply tangential acceleration;
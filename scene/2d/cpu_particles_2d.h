@@ -31,6 +31,7 @@
 #ifndef CPU_PARTICLES_2D_H
 #define CPU_PARTICLES_2D_H
 
+#include "core/os/thread_work_pool.h"
 #include "core/rid.h"
 #include "scene/2d/node_2d.h"
 #include "scene/resources/texture.h"
@@ -97,6 +98,11 @@ private:
 		Color base_color;
 
 		uint32_t seed;
+
+		// Set by the emission pass for the particles to update this frame.
+		bool process;
+		bool restarted;
+		float process_delta;
 	};
 
 	float time;
@@ -171,7 +177,22 @@ private:
 
 	Vector2 gravity;
 
+	enum {
+		PARTICLE_CHUNK_SIZE = 256,
+		PARTICLE_THREADED_MIN = 1024
+	};
+
+	struct ParticleProcessJob {
+		Particle *particles;
+		int count;
+		Vector2 emission_origin;
+	};
+
+	static ThreadWorkPool *process_pool;
+
 	void _particles_process(float p_delta);
+	void _process_particle_chunk(uint32_t p_chunk, ParticleProcessJob *p_job);
+	void _process_particles(Particle *p_particles, int p_from, int p_to, const Vector2 &p_emission_origin);
 	void _update_particle_data_buffer();
 
 	Mutex *update_mutex;
@@ -188,6 +209,8 @@ protected:
 	virtual void _validate_property(PropertyInfo &property) const;
 
 public:
+	static void set_threaded_processing(bool p_enable);
+
 	void set_emitting(bool p_emitting);
 	void set_amount(int p_amount);
 	void set_lifetime(float p_lifetime);
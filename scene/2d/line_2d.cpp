@@ -47,6 +47,13 @@ Line2D::Line2D() :
 	_default_color = Color(0.4, 0.5, 1);
 	_sharp_limit = 2.f;
 	_round_precision = 8;
+
+	_builder = memnew(LineBuilder);
+	_dirty_from = 0;
+}
+
+Line2D::~Line2D() {
+	memdelete(_builder);
 }
 
 Rect2 Line2D::_edit_get_rect() const {
@@ -80,14 +87,29 @@ bool Line2D::_edit_is_selected_on_click(const Point2 &p_point, double p_toleranc
 }
 
 void Line2D::set_points(const PoolVector<Vector2> &p_points) {
+
+	// Scripts often assign the whole array when only the tail moved
+	int first_changed = MIN(_points.size(), p_points.size());
+	{
+		PoolVector<Vector2>::Read old_read = _points.read();
+		PoolVector<Vector2>::Read new_read = p_points.read();
+		for (int i = 0; i < first_changed; i++) {
+			if (old_read[i] != new_read[i]) {
+				first_changed = i;
+				break;
+			}
+		}
+	}
+
 	_points = p_points;
-	update();
+	_points_changed(first_changed);
 }
 
 void Line2D::set_width(float width) {
 	if (width < 0.0)
 		width = 0.0;
 	_width = width;
+	_dirty_from = 0;
 	update();
 }
 
@@ -101,7 +123,7 @@ PoolVector<Vector2> Line2D::get_points() const {
 
 void Line2D::set_point_position(int i, Vector2 pos) {
 	_points.set(i, pos);
-	update();
+	_points_changed(i);
 }
 
 Vector2 Line2D::get_point_position(int i) const {
@@ -114,16 +136,17 @@ int Line2D::get_point_count() const {
 
 void Line2D::add_point(Vector2 pos) {
 	_points.append(pos);
-	update();
+	_points_changed(_points.size() - 1);
 }
 
 void Line2D::remove_point(int i) {
 	_points.remove(i);
-	update();
+	_points_changed(i);
 }
 
 void Line2D::set_default_color(Color color) {
 	_default_color = color;
+	_dirty_from = 0;
 	update();
 }
 
@@ -145,6 +168,7 @@ void Line2D::set_gradient(const Ref<Gradient> &gradient) {
 		(**_gradient).connect(CoreStringNames::get_singleton()->changed, this, "_gradient_changed");
 	}
 
+	_dirty_from = 0;
 	update();
 }
 
@@ -154,6 +178,7 @@ Ref<Gradient> Line2D::get_gradient() const {
 
 void Line2D::set_texture(const Ref<Texture> &texture) {
 	_texture = texture;
+	_dirty_from = 0;
 	update();
 }
 
@@ -163,6 +188,7 @@ Ref<Texture> Line2D::get_texture() const {
 
 void Line2D::set_texture_mode(const LineTextureMode mode) {
 	_texture_mode = mode;
+	_dirty_from = 0;
 	update();
 }
 
@@ -172,6 +198,7 @@ Line2D::LineTextureMode Line2D::get_texture_mode() const {
 
 void Line2D::set_joint_mode(LineJointMode mode) {
 	_joint_mode = mode;
+	_dirty_from = 0;
 	update();
 }
 
@@ -181,6 +208,7 @@ Line2D::LineJointMode Line2D::get_joint_mode() const {
 
 void Line2D::set_begin_cap_mode(LineCapMode mode) {
 	_begin_cap_mode = mode;
+	_dirty_from = 0;
 	update();
 }
 
@@ -190,6 +218,7 @@ Line2D::LineCapMode Line2D::get_begin_cap_mode() const {
 
 void Line2D::set_end_cap_mode(LineCapMode mode) {
 	_end_cap_mode = mode;
+	_dirty_from = 0;
 	update();
 }
 
@@ -209,6 +238,7 @@ void Line2D::set_sharp_limit(float limit) {
 	if (limit < 0.f)
 		limit = 0.f;
 	_sharp_limit = limit;
+	_dirty_from = 0;
 	update();
 }
 
@@ -220,6 +250,7 @@ void Line2D::set_round_precision(int precision) {
 	if (precision < 1)
 		precision = 1;
 	_round_precision = precision;
+	_dirty_from = 0;
 	update();
 }
 
@@ -231,21 +262,18 @@ void Line2D::_draw() {
 	if (_points.size() <= 1 || _width == 0.f)
 		return;
 
-	// TODO Is this really needed?
 	// Copy points for faster access
-	Vector<Vector2> points;
-	points.resize(_points.size());
-	int len = points.size();
+	LineBuilder &lb = *_builder;
+	int len = _points.size();
+	lb.points.resize(len);
 	{
 		PoolVector<Vector2>::Read points_read = _points.read();
+		Vector2 *points_write = lb.points.ptrw();
 		for (int i = 0; i < len; ++i) {
-			points.write[i] = points_read[i];
+			points_write[i] = points_read[i];
 		}
 	}
 
-	// TODO Maybe have it as member rather than copying parameters and allocating memory?
-	LineBuilder lb;
-	lb.points = points;
 	lb.default_color = _default_color;
 	lb.gradient = *_gradient;
 	lb.texture_mode = _texture_mode;
@@ -260,10 +288,15 @@ void Line2D::_draw() {
 	if (_texture.is_valid()) {
 		texture_rid = (**_texture).get_rid();
 
-		lb.tile_aspect = _texture->get_size().aspect();
+		float tile_aspect = _texture->get_size().aspect();
+		if (tile_aspect != lb.tile_aspect) {
+			lb.tile_aspect = tile_aspect;
+			_dirty_from = 0;
+		}
 	}
 
-	lb.build();
+	lb.build_from(_dirty_from);
+	_dirty_from = 0x7FFFFFFF;
 
 	VS::get_singleton()->canvas_item_add_triangle_array(
 			get_canvas_item(),
@@ -296,6 +329,12 @@ void Line2D::_draw() {
 }
 
 void Line2D::_gradient_changed() {
+	_dirty_from = 0;
+	update();
+}
+
+void Line2D::_points_changed(int p_from) {
+	_dirty_from = MIN(_dirty_from, p_from);
 	update();
 }
 
@@ -33,6 +33,8 @@
 
 #include "node_2d.h"
 
+class LineBuilder;
+
 class Line2D : public Node2D {
 
 	GDCLASS(Line2D, Node2D)
@@ -57,6 +59,7 @@ public:
 	};
 
 	Line2D();
+	~Line2D();
 
 	virtual Rect2 _edit_get_rect() const;
 	virtual bool _edit_use_rect() const;
@@ -111,6 +114,7 @@ protected:
 
 private:
 	void _gradient_changed();
+	void _points_changed(int p_from);
 
 private:
 	PoolVector<Vector2> _points;
@@ -124,6 +128,10 @@ private:
 	LineTextureMode _texture_mode;
 	float _sharp_limit;
 	int _round_precision;
+
+	// Geometry is kept between draws, only the part after _dirty_from is rebuilt when possible
+	LineBuilder *_builder;
+	int _dirty_from;
 };
 
 #endif // LINE2D_H
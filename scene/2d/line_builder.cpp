@@ -106,6 +106,7 @@ LineBuilder::LineBuilder() {
 	_interpolate_color = false;
 	_last_index[0] = 0;
 	_last_index[1] = 0;
+	_checkpoint.point = 0;
 }
 
 void LineBuilder::clear_output() {
@@ -117,6 +118,32 @@ void LineBuilder::clear_output() {
 
 void LineBuilder::build() {
 
+	clear_output();
+	_build(1);
+}
+
+void LineBuilder::build_from(int p_first_changed_point) {
+
+	// Joints before the checkpoint only depend on points up to it, the rest is rebuilt
+	if (_checkpoint.point < 2 || p_first_changed_point <= _checkpoint.point || _checkpoint.point > points.size() - 2) {
+		build();
+		return;
+	}
+
+	vertices.resize(_checkpoint.vertex_count);
+	colors.resize(_checkpoint.color_count);
+	uvs.resize(_checkpoint.uv_count);
+	indices.resize(_checkpoint.index_count);
+	_last_index[UP] = _checkpoint.last_index[UP];
+	_last_index[DOWN] = _checkpoint.last_index[DOWN];
+
+	_build(_checkpoint.point);
+}
+
+void LineBuilder::_build(int p_first_point) {
+
+	_checkpoint.point = 0;
+
 	// Need at least 2 points to draw a line
 	if (points.size() < 2) {
 		clear_output();
@@ -132,12 +159,12 @@ void LineBuilder::build() {
 
 	// Initial values
 
-	Vector2 pos0 = points[0];
-	Vector2 pos1 = points[1];
-	Vector2 f0 = (pos1 - pos0).normalized();
-	Vector2 u0 = rotate90(f0);
-	Vector2 pos_up0 = pos0 + u0 * hw;
-	Vector2 pos_down0 = pos0 - u0 * hw;
+	Vector2 pos0;
+	Vector2 pos1;
+	Vector2 f0;
+	Vector2 u0;
+	Vector2 pos_up0;
+	Vector2 pos_down0;
 
 	Color color0;
 	Color color1;
@@ -149,36 +176,56 @@ void LineBuilder::build() {
 	bool distance_required = _interpolate_color ||
 							 texture_mode == Line2D::LINE_TEXTURE_TILE ||
 							 texture_mode == Line2D::LINE_TEXTURE_STRETCH;
-	if (distance_required)
-		total_distance = calculate_total_distance(points);
-	if (_interpolate_color)
-		color0 = gradient->get_color(0);
-	else
-		colors.push_back(default_color);
 
 	float uvx0 = 0.f;
 	float uvx1 = 0.f;
 
-	// Begin cap
-	if (begin_cap_mode == Line2D::LINE_CAP_BOX) {
-		// Push back first vertices a little bit
-		pos_up0 -= f0 * hw;
-		pos_down0 -= f0 * hw;
-		// The line's outer length will be a little higher due to begin and end caps
-		total_distance += width;
-		current_distance0 += hw;
-		current_distance1 = current_distance0;
-	} else if (begin_cap_mode == Line2D::LINE_CAP_ROUND) {
-		if (texture_mode == Line2D::LINE_TEXTURE_TILE) {
-			uvx0 = 0.5f / tile_aspect;
+	// Nothing that depends on the whole line can be resumed
+	const bool resumable = !_interpolate_color && texture_mode != Line2D::LINE_TEXTURE_STRETCH;
+	const int checkpoint_point = len - 2;
+
+	if (p_first_point > 1) {
+		pos0 = _checkpoint.pos0;
+		f0 = _checkpoint.f0;
+		u0 = _checkpoint.u0;
+		current_distance1 = _checkpoint.current_distance;
+	} else {
+
+		pos0 = points[0];
+		pos1 = points[1];
+		f0 = (pos1 - pos0).normalized();
+		u0 = rotate90(f0);
+		pos_up0 = pos0 + u0 * hw;
+		pos_down0 = pos0 - u0 * hw;
+
+		if (distance_required)
+			total_distance = calculate_total_distance(points);
+		if (_interpolate_color)
+			color0 = gradient->get_color(0);
+		else
+			colors.push_back(default_color);
+
+		// Begin cap
+		if (begin_cap_mode == Line2D::LINE_CAP_BOX) {
+			// Push back first vertices a little bit
+			pos_up0 -= f0 * hw;
+			pos_down0 -= f0 * hw;
+			// The line's outer length will be a little higher due to begin and end caps
+			total_distance += width;
+			current_distance0 += hw;
+			current_distance1 = current_distance0;
+		} else if (begin_cap_mode == Line2D::LINE_CAP_ROUND) {
+			if (texture_mode == Line2D::LINE_TEXTURE_TILE) {
+				uvx0 = 0.5f / tile_aspect;
+			}
+			new_arc(pos0, pos_up0 - pos0, -Math_PI, color0, Rect2(0.f, 0.f, fmin(uvx0 * 2, 1.f), 1.f));
+			total_distance += width;
+			current_distance0 += hw;
+			current_distance1 = current_distance0;
 		}
-		new_arc(pos0, pos_up0 - pos0, -Math_PI, color0, Rect2(0.f, 0.f, fmin(uvx0 * 2, 1.f), 1.f));
-		total_distance += width;
-		current_distance0 += hw;
-		current_distance1 = current_distance0;
-	}
 
-	strip_begin(pos_up0, pos_down0, color0, uvx0);
+		strip_begin(pos_up0, pos_down0, color0, uvx0);
+	}
 
 	/*
 	 *  pos_up0 ------------- pos_up1 --------------------
@@ -194,7 +241,11 @@ void LineBuilder::build() {
 	// (not the same implementation but visuals help a lot)
 
 	// For each additional segment
-	for (int i = 1; i < len - 1; ++i) {
+	for (int i = p_first_point; i < len - 1; ++i) {
+
+		if (resumable && i == checkpoint_point) {
+			_save_checkpoint(i, pos0, f0, u0, current_distance1);
+		}
 
 		pos1 = points[i];
 		Vector2 pos2 = points[i + 1];
@@ -398,6 +449,20 @@ void LineBuilder::build() {
 	}
 }
 
+void LineBuilder::_save_checkpoint(int p_point, const Vector2 &p_pos0, const Vector2 &p_f0, const Vector2 &p_u0, float p_current_distance) {
+	_checkpoint.point = p_point;
+	_checkpoint.pos0 = p_pos0;
+	_checkpoint.f0 = p_f0;
+	_checkpoint.u0 = p_u0;
+	_checkpoint.current_distance = p_current_distance;
+	_checkpoint.last_index[UP] = _last_index[UP];
+	_checkpoint.last_index[DOWN] = _last_index[DOWN];
+	_checkpoint.vertex_count = vertices.size();
+	_checkpoint.color_count = colors.size();
+	_checkpoint.uv_count = uvs.size();
+	_checkpoint.index_count = indices.size();
+}
+
 void LineBuilder::strip_begin(Vector2 up, Vector2 down, Color color, float uvx) {
 	int vi = vertices.size();
 
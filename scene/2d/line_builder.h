@@ -63,6 +63,10 @@ public:
 	LineBuilder();
 
 	void build();
+	// Rebuilds after the points from p_first_changed_point on were modified, appended or removed,
+	// keeping the geometry of the joints before them. Falls back to build() when that's not possible.
+	// Other inputs must not have changed since the previous build.
+	void build_from(int p_first_changed_point);
 	void clear_output();
 
 private:
@@ -80,9 +84,28 @@ private:
 
 	void new_arc(Vector2 center, Vector2 vbegin, float angle_delta, Color color, Rect2 uv_rect);
 
+	void _build(int p_first_point);
+	void _save_checkpoint(int p_point, const Vector2 &p_pos0, const Vector2 &p_f0, const Vector2 &p_u0, float p_current_distance);
+
 private:
 	bool _interpolate_color;
 	int _last_index[2]; // Index of last up and down vertices of the strip
+
+	// Strip state at the start of the joint before the last one, to resume from
+	struct Checkpoint {
+		int point; // 0 if there is nothing to resume from
+		Vector2 pos0;
+		Vector2 f0;
+		Vector2 u0;
+		float current_distance;
+		int last_index[2];
+		int vertex_count;
+		int color_count;
+		int uv_count;
+		int index_count;
+	};
+
+	Checkpoint _checkpoint;
 };
 
 #endif // LINE_BUILDER_H
@@ -30,6 +30,8 @@
 
 #include "navigation_2d.h"
 
+#include "core/os/frame_arena.h"
+
 #define USE_ENTRY_POINT
 
 void Navigation2D::_navpoly_link(int p_id) {
@@ -104,7 +106,7 @@ void Navigation2D::_navpoly_link(int p_id) {
 			int next = (j + 1) % plen;
 			EdgeKey ek(p.edges[j].point, p.edges[next].point);
 
-			Map<EdgeKey, Connection>::Element *C = connections.find(ek);
+			Connection *C = connections.getptr(ek);
 			if (!C) {
 
 				Connection c;
@@ -115,20 +117,20 @@ void Navigation2D::_navpoly_link(int p_id) {
 				connections[ek] = c;
 			} else {
 
-				if (C->get().B != NULL) {
+				if (C->B != NULL) {
 					ConnectionPending pending;
 					pending.polygon = &p;
 					pending.edge = j;
-					p.edges.write[j].P = C->get().pending.push_back(pending);
+					p.edges.write[j].P = C->pending.push_back(pending);
 					continue;
 				}
 
-				C->get().B = &p;
-				C->get().B_edge = j;
-				C->get().A->edges.write[C->get().A_edge].C = &p;
-				C->get().A->edges.write[C->get().A_edge].C_edge = j;
-				p.edges.write[j].C = C->get().A;
-				p.edges.write[j].C_edge = C->get().A_edge;
+				C->B = &p;
+				C->B_edge = j;
+				C->A->edges.write[C->A_edge].C = &p;
+				C->A->edges.write[C->A_edge].C_edge = j;
+				p.edges.write[j].C = C->A;
+				p.edges.write[j].C_edge = C->A_edge;
 				//connection successful.
 			}
 		}
@@ -154,45 +156,45 @@ void Navigation2D::_navpoly_unlink(int p_id) {
 			int next = (i + 1) % ec;
 
 			EdgeKey ek(edges[i].point, edges[next].point);
-			Map<EdgeKey, Connection>::Element *C = connections.find(ek);
+			Connection *C = connections.getptr(ek);
 			ERR_CONTINUE(!C);
 
 			if (edges[i].P) {
-				C->get().pending.erase(edges[i].P);
+				C->pending.erase(edges[i].P);
 				edges[i].P = NULL;
 
-			} else if (C->get().B) {
+			} else if (C->B) {
 				//disconnect
 
-				C->get().B->edges.write[C->get().B_edge].C = NULL;
-				C->get().B->edges.write[C->get().B_edge].C_edge = -1;
-				C->get().A->edges.write[C->get().A_edge].C = NULL;
-				C->get().A->edges.write[C->get().A_edge].C_edge = -1;
+				C->B->edges.write[C->B_edge].C = NULL;
+				C->B->edges.write[C->B_edge].C_edge = -1;
+				C->A->edges.write[C->A_edge].C = NULL;
+				C->A->edges.write[C->A_edge].C_edge = -1;
 
-				if (C->get().A == &E->get()) {
+				if (C->A == &E->get()) {
 
-					C->get().A = C->get().B;
-					C->get().A_edge = C->get().B_edge;
+					C->A = C->B;
+					C->A_edge = C->B_edge;
 				}
-				C->get().B = NULL;
-				C->get().B_edge = -1;
+				C->B = NULL;
+				C->B_edge = -1;
 
-				if (C->get().pending.size()) {
+				if (C->pending.size()) {
 					//reconnect if something is pending
-					ConnectionPending cp = C->get().pending.front()->get();
-					C->get().pending.pop_front();
-
-					C->get().B = cp.polygon;
-					C->get().B_edge = cp.edge;
-					C->get().A->edges.write[C->get().A_edge].C = cp.polygon;
-					C->get().A->edges.write[C->get().A_edge].C_edge = cp.edge;
-					cp.polygon->edges.write[cp.edge].C = C->get().A;
-					cp.polygon->edges.write[cp.edge].C_edge = C->get().A_edge;
+					ConnectionPending cp = C->pending.front()->get();
+					C->pending.pop_front();
+
+					C->B = cp.polygon;
+					C->B_edge = cp.edge;
+					C->A->edges.write[C->A_edge].C = cp.polygon;
+					C->A->edges.write[C->A_edge].C_edge = cp.edge;
+					cp.polygon->edges.write[cp.edge].C = C->A;
+					cp.polygon->edges.write[cp.edge].C_edge = C->A_edge;
 					cp.polygon->edges.write[cp.edge].P = NULL;
 				}
 
 			} else {
-				connections.erase(C);
+				connections.erase(ek);
 				//erase
 			}
 		}
@@ -214,6 +216,7 @@ int Navigation2D::navpoly_add(const Ref<NavigationPolygon> &p_mesh, const Transf
 	navpoly_map[id] = nm;
 
 	_navpoly_link(id);
+	_update_polygon_ids();
 
 	return id;
 }
@@ -227,16 +230,37 @@ void Navigation2D::navpoly_set_transform(int p_id, const Transform2D &p_xform) {
 	_navpoly_unlink(p_id);
 	nm.xform = p_xform;
 	_navpoly_link(p_id);
+	_update_polygon_ids();
 }
 void Navigation2D::navpoly_remove(int p_id) {
 
 	ERR_FAIL_COND(!navpoly_map.has(p_id));
 	_navpoly_unlink(p_id);
 	navpoly_map.erase(p_id);
+	_update_polygon_ids();
+}
+
+void Navigation2D::_update_polygon_ids() {
+
+	polygon_count = 0;
+
+	for (Map<int, NavMesh>::Element *E = navpoly_map.front(); E; E = E->next()) {
+
+		if (!E->get().linked)
+			continue;
+
+		for (List<Polygon>::Element *F = E->get().polygons.front(); F; F = F->next()) {
+			F->get().id = polygon_count++;
+		}
+	}
 }
 
 Vector<Vector2> Navigation2D::get_simple_path(const Vector2 &p_start, const Vector2 &p_end, bool p_optimize) {
 
+	Vector<PolygonSearch> search_data;
+	search_data.resize(polygon_count);
+	PolygonSearch *search = search_data.ptrw();
+
 	Polygon *begin_poly = NULL;
 	Polygon *end_poly = NULL;
 	Vector2 begin_point;
@@ -282,7 +306,7 @@ Vector<Vector2> Navigation2D::get_simple_path(const Vector2 &p_start, const Vect
 				}
 			}
 
-			p.prev_edge = -1;
+			search[p.id].prev_edge = -1;
 		}
 	}
 
@@ -343,26 +367,26 @@ Vector<Vector2> Navigation2D::get_simple_path(const Vector2 &p_start, const Vect
 
 	bool found_route = false;
 
-	List<Polygon *> open_list;
+	List<Polygon *, FrameArena> open_list;
 
-	begin_poly->entry = p_start;
+	search[begin_poly->id].entry = p_start;
 
 	for (int i = 0; i < begin_poly->edges.size(); i++) {
 
 		if (begin_poly->edges[i].C) {
 
-			begin_poly->edges[i].C->prev_edge = begin_poly->edges[i].C_edge;
+			search[begin_poly->edges[i].C->id].prev_edge = begin_poly->edges[i].C_edge;
 #ifdef USE_ENTRY_POINT
 			Vector2 edge[2] = {
 				_get_vertex(begin_poly->edges[i].point),
 				_get_vertex(begin_poly->edges[(i + 1) % begin_poly->edges.size()].point)
 			};
 
-			Vector2 entry = Geometry::get_closest_point_to_segment_2d(begin_poly->entry, edge);
-			begin_poly->edges[i].C->distance = begin_poly->entry.distance_to(entry);
-			begin_poly->edges[i].C->entry = entry;
+			Vector2 entry = Geometry::get_closest_point_to_segment_2d(search[begin_poly->id].entry, edge);
+			search[begin_poly->edges[i].C->id].distance = search[begin_poly->id].entry.distance_to(entry);
+			search[begin_poly->edges[i].C->id].entry = entry;
 #else
-			begin_poly->edges[i].C->distance = begin_poly->center.distance_to(begin_poly->edges[i].C->center);
+			search[begin_poly->edges[i].C->id].distance = begin_poly->center.distance_to(begin_poly->edges[i].C->center);
 #endif
 			open_list.push_back(begin_poly->edges[i].C);
 
@@ -379,15 +403,15 @@ Vector<Vector2> Navigation2D::get_simple_path(const Vector2 &p_start, const Vect
 		}
 		//check open list
 
-		List<Polygon *>::Element *least_cost_poly = NULL;
+		List<Polygon *, FrameArena>::Element *least_cost_poly = NULL;
 		float least_cost = 1e30;
 
 		//this could be faster (cache previous results)
-		for (List<Polygon *>::Element *E = open_list.front(); E; E = E->next()) {
+		for (List<Polygon *, FrameArena>::Element *E = open_list.front(); E; E = E->next()) {
 
 			Polygon *p = E->get();
 
-			float cost = p->distance;
+			float cost = search[p->id].distance;
 
 #ifdef USE_ENTRY_POINT
 			int es = p->edges.size();
@@ -395,7 +419,7 @@ Vector<Vector2> Navigation2D::get_simple_path(const Vector2 &p_start, const Vect
 			float shortest_distance = 1e30;
 
 			for (int i = 0; i < es; i++) {
-				Polygon::Edge &e = p->edges.write[i];
+				const Polygon::Edge &e = p->edges[i];
 
 				if (!e.C)
 					continue;
@@ -405,8 +429,8 @@ Vector<Vector2> Navigation2D::get_simple_path(const Vector2 &p_start, const Vect
 					_get_vertex(p->edges[(i + 1) % es].point)
 				};
 
-				Vector2 edge_point = Geometry::get_closest_point_to_segment_2d(p->entry, edge);
-				float dist = p->entry.distance_to(edge_point);
+				Vector2 edge_point = Geometry::get_closest_point_to_segment_2d(search[p->id].entry, edge);
+				float dist = search[p->id].entry.distance_to(edge_point);
 				if (dist < shortest_distance)
 					shortest_distance = dist;
 			}
@@ -427,7 +451,7 @@ Vector<Vector2> Navigation2D::get_simple_path(const Vector2 &p_start, const Vect
 
 		for (int i = 0; i < es; i++) {
 
-			Polygon::Edge &e = p->edges.write[i];
+			const Polygon::Edge &e = p->edges[i];
 
 			if (!e.C)
 				continue;
@@ -438,33 +462,33 @@ Vector<Vector2> Navigation2D::get_simple_path(const Vector2 &p_start, const Vect
 				_get_vertex(p->edges[(i + 1) % es].point)
 			};
 
-			Vector2 edge_entry = Geometry::get_closest_point_to_segment_2d(p->entry, edge);
-			float distance = p->entry.distance_to(edge_entry) + p->distance;
+			Vector2 edge_entry = Geometry::get_closest_point_to_segment_2d(search[p->id].entry, edge);
+			float distance = search[p->id].entry.distance_to(edge_entry) + search[p->id].distance;
 
 #else
 
-			float distance = p->center.distance_to(e.C->center) + p->distance;
+			float distance = p->center.distance_to(e.C->center) + search[p->id].distance;
 
 #endif
 
-			if (e.C->prev_edge != -1) {
+			if (search[e.C->id].prev_edge != -1) {
 				//oh this was visited already, can we win the cost?
 
-				if (e.C->distance > distance) {
+				if (search[e.C->id].distance > distance) {
 
-					e.C->prev_edge = e.C_edge;
-					e.C->distance = distance;
+					search[e.C->id].prev_edge = e.C_edge;
+					search[e.C->id].distance = distance;
 #ifdef USE_ENTRY_POINT
-					e.C->entry = edge_entry;
+					search[e.C->id].entry = edge_entry;
 #endif
 				}
 			} else {
 				//add to open neighbours
 
-				e.C->prev_edge = e.C_edge;
-				e.C->distance = distance;
+				search[e.C->id].prev_edge = e.C_edge;
+				search[e.C->id].distance = distance;
 #ifdef USE_ENTRY_POINT
-				e.C->entry = edge_entry;
+				search[e.C->id].entry = edge_entry;
 #endif
 
 				open_list.push_back(e.C);
@@ -509,8 +533,8 @@ Vector<Vector2> Navigation2D::get_simple_path(const Vector2 &p_start, const Vect
 					left = begin_point;
 					right = begin_point;
 				} else {
-					int prev = p->prev_edge;
-					int prev_n = (p->prev_edge + 1) % p->edges.size();
+					int prev = search[p->id].prev_edge;
+					int prev_n = (search[p->id].prev_edge + 1) % p->edges.size();
 					left = _get_vertex(p->edges[prev].point);
 					right = _get_vertex(p->edges[prev_n].point);
 
@@ -576,7 +600,7 @@ Vector<Vector2> Navigation2D::get_simple_path(const Vector2 &p_start, const Vect
 				}
 
 				if (p != begin_poly)
-					p = p->edges[p->prev_edge].C;
+					p = p->edges[search[p->id].prev_edge].C;
 				else
 					p = NULL;
 			}
@@ -586,8 +610,8 @@ Vector<Vector2> Navigation2D::get_simple_path(const Vector2 &p_start, const Vect
 			Polygon *p = end_poly;
 
 			while (true) {
-				int prev = p->prev_edge;
-				int prev_n = (p->prev_edge + 1) % p->edges.size();
+				int prev = search[p->id].prev_edge;
+				int prev_n = (search[p->id].prev_edge + 1) % p->edges.size();
 				Vector2 point = (_get_vertex(p->edges[prev].point) + _get_vertex(p->edges[prev_n].point)) * 0.5;
 				path.push_back(point);
 				p = p->edges[prev].C;
@@ -616,6 +640,49 @@ Vector<Vector2> Navigation2D::get_simple_path(const Vector2 &p_start, const Vect
 	return Vector<Vector2>();
 }
 
+void Navigation2D::_solve_path_query(uint32_t p_index, PathQueryBatch *p_batch) {
+
+	p_batch->paths[p_index] = get_simple_path(p_batch->starts[p_index], p_batch->ends[p_index], p_batch->optimize);
+}
+
+Array Navigation2D::get_simple_paths(const PoolVector2Array &p_starts, const PoolVector2Array &p_ends, bool p_optimize) {
+
+	ERR_FAIL_COND_V(p_starts.size() != p_ends.size(), Array());
+
+	int count = p_starts.size();
+
+	Vector<Vector<Vector2> > paths;
+	paths.resize(count);
+
+	PoolVector2Array::Read starts = p_starts.read();
+	PoolVector2Array::Read ends = p_ends.read();
+
+	PathQueryBatch batch;
+	batch.starts = starts.ptr();
+	batch.ends = ends.ptr();
+	batch.paths = paths.ptrw();
+	batch.optimize = p_optimize;
+
+	if (count > 1) {
+		if (!path_query_pool.is_initialized()) {
+			path_query_pool.init();
+		}
+		path_query_pool.do_work(count, this, &Navigation2D::_solve_path_query, &batch);
+	} else {
+		for (int i = 0; i < count; i++) {
+			_solve_path_query(i, &batch);
+		}
+	}
+
+	Array ret;
+	ret.resize(count);
+	for (int i = 0; i < count; i++) {
+		ret[i] = paths[i];
+	}
+
+	return ret;
+}
+
 Vector2 Navigation2D::get_closest_point(const Vector2 &p_point) {
 
 	Vector2 closest_point = Vector2();
@@ -727,6 +794,7 @@ void Navigation2D::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("navpoly_remove", "id"), &Navigation2D::navpoly_remove);
 
 	ClassDB::bind_method(D_METHOD("get_simple_path", "start", "end", "optimize"), &Navigation2D::get_simple_path, DEFVAL(true));
+	ClassDB::bind_method(D_METHOD("get_simple_paths", "starts", "ends", "optimize"), &Navigation2D::get_simple_paths, DEFVAL(true));
 	ClassDB::bind_method(D_METHOD("get_closest_point", "to_point"), &Navigation2D::get_closest_point);
 	ClassDB::bind_method(D_METHOD("get_closest_point_owner", "to_point"), &Navigation2D::get_closest_point_owner);
 }
@@ -736,4 +804,5 @@ Navigation2D::Navigation2D() {
 	ERR_FAIL_COND(sizeof(Point) != 8);
 	cell_size = 1; // one pixel
 	last_id = 1;
+	polygon_count = 0;
 }
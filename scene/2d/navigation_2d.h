@@ -31,6 +31,8 @@
 #ifndef NAVIGATION_2D_H
 #define NAVIGATION_2D_H
 
+#include "core/hash_map.h"
+#include "core/os/thread_work_pool.h"
 #include "scene/2d/navigation_polygon.h"
 #include "scene/2d/node_2d.h"
 
@@ -58,6 +60,10 @@ class Navigation2D : public Node2D {
 			return (a.key == p_key.a.key) ? (b.key < p_key.b.key) : (a.key < p_key.a.key);
 		};
 
+		bool operator==(const EdgeKey &p_key) const {
+			return a.key == p_key.a.key && b.key == p_key.b.key;
+		}
+
 		EdgeKey(const Point &p_a = Point(), const Point &p_b = Point()) :
 				a(p_a),
 				b(p_b) {
@@ -67,6 +73,10 @@ class Navigation2D : public Node2D {
 		}
 	};
 
+	struct EdgeKeyHasher {
+		static _FORCE_INLINE_ uint32_t hash(const EdgeKey &p_key) { return hash_djb2_one_32(hash_one_uint64(p_key.b.key), hash_one_uint64(p_key.a.key)); }
+	};
+
 	struct NavMesh;
 	struct Polygon;
 
@@ -93,16 +103,21 @@ class Navigation2D : public Node2D {
 		Vector<Edge> edges;
 
 		Vector2 center;
-		Vector2 entry;
-
-		float distance;
-		int prev_edge;
+		int id; //index into the search data of path queries
 
 		bool clockwise;
 
 		NavMesh *owner;
 	};
 
+	// per query state, kept apart from the polygons so path queries can run concurrently
+	struct PolygonSearch {
+
+		Vector2 entry;
+		float distance;
+		int prev_edge;
+	};
+
 	struct Connection {
 
 		Polygon *A;
@@ -120,7 +135,7 @@ class Navigation2D : public Node2D {
 		}
 	};
 
-	Map<EdgeKey, Connection> connections;
+	HashMap<EdgeKey, Connection, EdgeKeyHasher> connections;
 
 	struct NavMesh {
 
@@ -150,6 +165,20 @@ class Navigation2D : public Node2D {
 
 	void _navpoly_link(int p_id);
 	void _navpoly_unlink(int p_id);
+	void _update_polygon_ids();
+
+	struct PathQueryBatch {
+
+		const Vector2 *starts;
+		const Vector2 *ends;
+		Vector<Vector2> *paths;
+		bool optimize;
+	};
+
+	ThreadWorkPool path_query_pool;
+	void _solve_path_query(uint32_t p_index, PathQueryBatch *p_batch);
+
+	int polygon_count;
 
 	float cell_size;
 	Map<int, NavMesh> navpoly_map;
@@ -165,6 +194,7 @@ public:
 	void navpoly_remove(int p_id);
 
 	Vector<Vector2> get_simple_path(const Vector2 &p_start, const Vector2 &p_end, bool p_optimize = true);
+	Array get_simple_paths(const PoolVector2Array &p_starts, const PoolVector2Array &p_ends, bool p_optimize = true);
 	Vector2 get_closest_point(const Vector2 &p_point);
 	Object *get_closest_point_owner(const Vector2 &p_point);
 
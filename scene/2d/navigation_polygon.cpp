@@ -32,10 +32,9 @@
 
 #include "core/core_string_names.h"
 #include "core/engine.h"
+#include "core/math/geometry.h"
 #include "navigation_2d.h"
 
-#include "thirdparty/misc/triangulator.h"
-
 Rect2 NavigationPolygon::_edit_get_rect() const {
 
 	if (rect_cache_dirty) {
@@ -189,7 +188,8 @@ void NavigationPolygon::clear_outlines() {
 }
 void NavigationPolygon::make_polygons_from_outlines() {
 
-	List<TriangulatorPoly> in_poly, out_poly;
+	Vector<Vector<Vector2> > outers;
+	Vector<Vector<Vector2> > holes;
 
 	Vector2 outside_point(-1e10, -1e10);
 
@@ -239,44 +239,67 @@ void NavigationPolygon::make_polygons_from_outlines() {
 
 		bool outer = (interscount % 2) == 0;
 
-		TriangulatorPoly tp;
-		tp.Init(olsize);
+		Vector<Vector2> outline;
+		outline.resize(olsize);
 		for (int j = 0; j < olsize; j++) {
-			tp[j] = r[j];
+			outline.write[j] = r[j];
 		}
 
 		if (outer)
-			tp.SetOrientation(TRIANGULATOR_CCW);
-		else {
-			tp.SetOrientation(TRIANGULATOR_CW);
-			tp.SetHole(true);
+			outers.push_back(outline);
+		else
+			holes.push_back(outline);
+	}
+
+	// Each hole is cut out of the smallest outer outline around it.
+	Vector<real_t> outer_areas;
+	outer_areas.resize(outers.size());
+	for (int i = 0; i < outers.size(); i++) {
+		outer_areas.write[i] = ABS(Triangulate::get_area(outers[i]));
+	}
+
+	Vector<Vector<Vector<Vector2> > > outer_holes;
+	outer_holes.resize(outers.size());
+	for (int i = 0; i < holes.size(); i++) {
+
+		int best = -1;
+		for (int j = 0; j < outers.size(); j++) {
+			if ((best < 0 || outer_areas[j] < outer_areas[best]) && Geometry::is_point_in_polygon(holes[i][0], outers[j])) {
+				best = j;
+			}
 		}
 
-		in_poly.push_back(tp);
+		if (best >= 0)
+			outer_holes.write[best].push_back(holes[i]);
 	}
 
-	TriangulatorPartition tpart;
-	if (tpart.ConvexPartition_HM(&in_poly, &out_poly) == 0) { //failed!
-		ERR_PRINTS("NavigationPolygon: Convex partition failed!");
-		return;
+	Vector<Vector<Vector2> > parts;
+	for (int i = 0; i < outers.size(); i++) {
+
+		Vector<Vector<Vector2> > outer_parts = Geometry::decompose_polygon_in_convex(outers[i], outer_holes[i]);
+		if (outer_parts.empty()) { //failed!
+			ERR_PRINTS("NavigationPolygon: Convex partition failed!");
+			return;
+		}
+		parts.append_array(outer_parts);
 	}
 
 	polygons.clear();
 	vertices.resize(0);
 
 	Map<Vector2, int> points;
-	for (List<TriangulatorPoly>::Element *I = out_poly.front(); I; I = I->next()) {
+	for (int i = 0; i < parts.size(); i++) {
 
-		TriangulatorPoly &tp = I->get();
+		const Vector<Vector2> &part = parts[i];
 
 		struct Polygon p;
 
-		for (int i = 0; i < tp.GetNumPoints(); i++) {
+		for (int j = 0; j < part.size(); j++) {
 
-			Map<Vector2, int>::Element *E = points.find(tp[i]);
+			Map<Vector2, int>::Element *E = points.find(part[j]);
 			if (!E) {
-				E = points.insert(tp[i], vertices.size());
-				vertices.push_back(tp[i]);
+				E = points.insert(part[j], vertices.size());
+				vertices.push_back(part[j]);
 			}
 			p.indices.push_back(E->get());
 		}
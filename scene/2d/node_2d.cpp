@@ -133,7 +133,9 @@ void Node2D::_update_transform() {
 	_mat.set_rotation_and_scale(angle, _scale);
 	_mat.elements[2] = pos;
 
-	VisualServer::get_singleton()->canvas_item_set_transform(get_canvas_item(), _mat);
+	if (!VisualServer::get_singleton()->is_null_mode()) {
+		VisualServer::get_singleton()->canvas_item_set_transform(get_canvas_item(), _mat);
+	}
 
 	if (!is_inside_tree())
 		return;
@@ -311,7 +313,9 @@ void Node2D::set_transform(const Transform2D &p_transform) {
 	_mat = p_transform;
 	_xform_dirty = true;
 
-	VisualServer::get_singleton()->canvas_item_set_transform(get_canvas_item(), _mat);
+	if (!VisualServer::get_singleton()->is_null_mode()) {
+		VisualServer::get_singleton()->canvas_item_set_transform(get_canvas_item(), _mat);
+	}
 
 	if (!is_inside_tree())
 		return;
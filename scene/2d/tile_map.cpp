@@ -71,9 +71,9 @@ void TileMap::_notification(int p_what) {
 		case NOTIFICATION_EXIT_TREE: {
 
 			_update_quadrant_space(RID());
-			for (Map<PosKey, Quadrant>::Element *E = quadrant_map.front(); E; E = E->next()) {
+			for (const PosKey *K = quadrant_map.next(NULL); K; K = quadrant_map.next(K)) {
 
-				Quadrant &q = E->get();
+				Quadrant &q = quadrant_map[*K];
 				if (navigation) {
 					for (Map<PosKey, Quadrant::NavPoly>::Element *F = q.navpoly_ids.front(); F; F = F->next()) {
 
@@ -102,9 +102,9 @@ void TileMap::_notification(int p_what) {
 
 void TileMap::_update_quadrant_space(const RID &p_space) {
 
-	for (Map<PosKey, Quadrant>::Element *E = quadrant_map.front(); E; E = E->next()) {
+	for (const PosKey *K = quadrant_map.next(NULL); K; K = quadrant_map.next(K)) {
 
-		Quadrant &q = E->get();
+		Quadrant &q = quadrant_map[*K];
 		Physics2DServer::get_singleton()->body_set_space(q.body, p_space);
 	}
 }
@@ -120,9 +120,9 @@ void TileMap::_update_quadrant_transform() {
 	if (navigation)
 		nav_rel = get_relative_transform_to_parent(navigation);
 
-	for (Map<PosKey, Quadrant>::Element *E = quadrant_map.front(); E; E = E->next()) {
+	for (const PosKey *K = quadrant_map.next(NULL); K; K = quadrant_map.next(K)) {
 
-		Quadrant &q = E->get();
+		Quadrant &q = quadrant_map[*K];
 		Transform2D xform;
 		xform.set_origin(q.pos);
 		xform = global_transform * xform;
@@ -245,380 +245,566 @@ void TileMap::_fix_cell_transform(Transform2D &xform, const Cell &p_cell, const
 	xform.elements[2].y += offset.y;
 }
 
-void TileMap::update_dirty_quadrants() {
+void TileMap::_prepare_quadrant_update(uint32_t p_index, QuadrantJob *p_job) {
 
-	if (!pending_update)
-		return;
-	if (!is_inside_tree() || !tile_set.is_valid()) {
-		pending_update = false;
-		return;
-	}
+	Quadrant &q = *p_job->quadrants[p_index];
+	QuadrantUpdate &u = q.update;
 
-	VisualServer *vs = VisualServer::get_singleton();
-	Physics2DServer *ps = Physics2DServer::get_singleton();
-	Vector2 tofs = get_cell_draw_offset();
-	Transform2D nav_rel;
-	if (navigation)
-		nav_rel = get_relative_transform_to_parent(navigation);
+	u.groups.clear();
+	u.draws.clear();
+	u.debug_shapes.clear();
+	u.cells.clear();
+	u.rebuild = q.rebuild;
 
-	Vector2 qofs;
+	for (int i = 0; i < q.cells.size(); i++) {
 
-	SceneTree *st = SceneTree::get_singleton();
-	Color debug_collision_color;
-	Color debug_navigation_color;
+		const Map<PosKey, Cell>::Element *E = tile_map.find(q.cells[i]);
+		const Cell &c = E->get();
+		//moment of truth
+		if (!tile_set->has_tile(c.id))
+			continue;
+		Ref<Texture> tex = tile_set->tile_get_texture(c.id);
+		Vector2 tile_ofs = tile_set->tile_get_texture_offset(c.id);
 
-	bool debug_shapes = st && st->is_debugging_collisions_hint();
-	if (debug_shapes) {
-		debug_collision_color = st->get_debug_collisions_color();
-	}
+		Vector2 wofs = _map_to_world(E->key().x, E->key().y);
+		Vector2 offset = wofs - q.pos + p_job->tofs;
 
-	bool debug_navigation = st && st->is_debugging_navigation_hint();
-	if (debug_navigation) {
-		debug_navigation_color = st->get_debug_navigation_color();
-	}
+		if (!tex.is_valid())
+			continue;
 
-	while (dirty_quadrant_list.first()) {
+		QuadrantUpdate::Group group;
+		group.material = tile_set->tile_get_material(c.id);
+		group.z_index = tile_set->tile_get_z_index(c.id);
 
-		Quadrant &q = *dirty_quadrant_list.first()->self();
+		if (tile_set->tile_get_tile_mode(c.id) == TileSet::AUTO_TILE ||
+				tile_set->tile_get_tile_mode(c.id) == TileSet::ATLAS_TILE) {
+			group.z_index += tile_set->autotile_get_z_index(c.id, Vector2(c.autotile_coord_x, c.autotile_coord_y));
+		}
 
-		for (List<RID>::Element *E = q.canvas_items.front(); E; E = E->next()) {
+		if (u.groups.empty() || !(u.groups[u.groups.size() - 1] == group)) {
+			u.groups.push_back(group);
+		}
 
-			vs->free(E->get());
+		int group_index = u.groups.size() - 1;
+
+		Rect2 r = tile_set->tile_get_region(c.id);
+		if (tile_set->tile_get_tile_mode(c.id) == TileSet::AUTO_TILE || tile_set->tile_get_tile_mode(c.id) == TileSet::ATLAS_TILE) {
+			int spacing = tile_set->autotile_get_spacing(c.id);
+			r.size = tile_set->autotile_get_size(c.id);
+			r.position += (r.size + Vector2(spacing, spacing)) * Vector2(c.autotile_coord_x, c.autotile_coord_y);
 		}
 
-		q.canvas_items.clear();
+		Size2 s;
+		if (r == Rect2())
+			s = tex->get_size();
+		else
+			s = r.size;
+
+		Rect2 rect;
+		rect.position = offset.floor();
+		rect.size = s;
+		rect.size.x += fp_adjust;
+		rect.size.y += fp_adjust;
+
+		if (rect.size.y > rect.size.x) {
+			if ((c.flip_h && (c.flip_v || c.transpose)) || (c.flip_v && !c.transpose))
+				tile_ofs.y += rect.size.y - rect.size.x;
+		} else if (rect.size.y < rect.size.x) {
+			if ((c.flip_v && (c.flip_h || c.transpose)) || (c.flip_h && !c.transpose))
+				tile_ofs.x += rect.size.x - rect.size.y;
+		}
 
-		ps->body_clear_shapes(q.body);
-		int shape_idx = 0;
+		/*	rect.size.x+=fp_adjust;
+		rect.size.y+=fp_adjust;*/
 
-		if (navigation) {
-			for (Map<PosKey, Quadrant::NavPoly>::Element *E = q.navpoly_ids.front(); E; E = E->next()) {
+		if (c.transpose)
+			SWAP(tile_ofs.x, tile_ofs.y);
 
-				navigation->navpoly_remove(E->get().id);
-			}
-			q.navpoly_ids.clear();
+		if (c.flip_h) {
+			rect.size.x = -rect.size.x;
+			tile_ofs.x = -tile_ofs.x;
 		}
-
-		for (Map<PosKey, Quadrant::Occluder>::Element *E = q.occluder_instances.front(); E; E = E->next()) {
-			VS::get_singleton()->free(E->get().id);
+		if (c.flip_v) {
+			rect.size.y = -rect.size.y;
+			tile_ofs.y = -tile_ofs.y;
 		}
-		q.occluder_instances.clear();
-		Ref<ShaderMaterial> prev_material;
-		int prev_z_index = 0;
-		RID prev_canvas_item;
-		RID prev_debug_canvas_item;
-
-		for (int i = 0; i < q.cells.size(); i++) {
 
-			Map<PosKey, Cell>::Element *E = tile_map.find(q.cells[i]);
-			Cell &c = E->get();
-			//moment of truth
-			if (!tile_set->has_tile(c.id))
-				continue;
-			Ref<Texture> tex = tile_set->tile_get_texture(c.id);
-			Vector2 tile_ofs = tile_set->tile_get_texture_offset(c.id);
+		Vector2 center_ofs;
 
-			Vector2 wofs = _map_to_world(E->key().x, E->key().y);
-			Vector2 offset = wofs - q.pos + tofs;
+		if (tile_origin == TILE_ORIGIN_TOP_LEFT) {
+			rect.position += tile_ofs;
 
-			if (!tex.is_valid())
-				continue;
+		} else if (tile_origin == TILE_ORIGIN_BOTTOM_LEFT) {
 
-			Ref<ShaderMaterial> mat = tile_set->tile_get_material(c.id);
-			int z_index = tile_set->tile_get_z_index(c.id);
+			rect.position += tile_ofs;
 
-			if (tile_set->tile_get_tile_mode(c.id) == TileSet::AUTO_TILE ||
-					tile_set->tile_get_tile_mode(c.id) == TileSet::ATLAS_TILE) {
-				z_index += tile_set->autotile_get_z_index(c.id, Vector2(c.autotile_coord_x, c.autotile_coord_y));
+			if (c.transpose) {
+				if (c.flip_h)
+					rect.position.x -= cell_size.x;
+				else
+					rect.position.x += cell_size.x;
+			} else {
+				if (c.flip_v)
+					rect.position.y -= cell_size.y;
+				else
+					rect.position.y += cell_size.y;
 			}
 
-			RID canvas_item;
-			RID debug_canvas_item;
+		} else if (tile_origin == TILE_ORIGIN_CENTER) {
 
-			if (prev_canvas_item == RID() || prev_material != mat || prev_z_index != z_index) {
+			rect.position += tile_ofs;
 
-				canvas_item = vs->canvas_item_create();
-				if (mat.is_valid())
-					vs->canvas_item_set_material(canvas_item, mat->get_rid());
-				vs->canvas_item_set_parent(canvas_item, get_canvas_item());
-				_update_item_material_state(canvas_item);
-				Transform2D xform;
-				xform.set_origin(q.pos);
-				vs->canvas_item_set_transform(canvas_item, xform);
-				vs->canvas_item_set_light_mask(canvas_item, get_light_mask());
-				vs->canvas_item_set_z_index(canvas_item, z_index);
+			if (c.flip_h)
+				rect.position.x -= cell_size.x / 2;
+			else
+				rect.position.x += cell_size.x / 2;
 
-				q.canvas_items.push_back(canvas_item);
+			if (c.flip_v)
+				rect.position.y -= cell_size.y / 2;
+			else
+				rect.position.y += cell_size.y / 2;
+		}
 
-				if (debug_shapes) {
+		QuadrantUpdate::Draw draw;
+		draw.group = group_index;
+		draw.texture = tex;
+		draw.normal_map = tile_set->tile_get_normal_map(c.id);
+		draw.rect = rect;
+		draw.region = r;
+		Color modulate = tile_set->tile_get_modulate(c.id);
+		draw.modulate = Color(modulate.r * p_job->self_modulate.r, modulate.g * p_job->self_modulate.g,
+				modulate.b * p_job->self_modulate.b, modulate.a * p_job->self_modulate.a);
+		draw.transpose = c.transpose;
+		u.draws.push_back(draw);
+
+		//canvas commands are always regenerated, the rest only for the cells that changed
+		bool cell_changed = u.rebuild || q.dirty_cells.has(E->key());
+		if (!cell_changed && !p_job->debug_shapes)
+			continue;
 
-					debug_canvas_item = vs->canvas_item_create();
-					vs->canvas_item_set_parent(debug_canvas_item, canvas_item);
-					vs->canvas_item_set_z_as_relative_to_parent(debug_canvas_item, false);
-					vs->canvas_item_set_z_index(debug_canvas_item, VS::CANVAS_ITEM_Z_MAX - 1);
-					q.canvas_items.push_back(debug_canvas_item);
-					prev_debug_canvas_item = debug_canvas_item;
-				}
+		QuadrantUpdate::CellData cell;
+		cell.key = E->key();
 
-				prev_canvas_item = canvas_item;
-				prev_material = mat;
-				prev_z_index = z_index;
+		Vector<TileSet::ShapeData> shapes = tile_set->tile_get_shapes(c.id);
 
-			} else {
-				canvas_item = prev_canvas_item;
-				if (debug_shapes) {
-					debug_canvas_item = prev_debug_canvas_item;
+		for (int j = 0; j < shapes.size(); j++) {
+			Ref<Shape2D> shape = shapes[j].shape;
+			if (shape.is_valid()) {
+				if (tile_set->tile_get_tile_mode(c.id) == TileSet::SINGLE_TILE || (shapes[j].autotile_coord.x == c.autotile_coord_x && shapes[j].autotile_coord.y == c.autotile_coord_y)) {
+					Transform2D xform;
+					xform.set_origin(offset.floor());
+
+					Vector2 shape_ofs = shapes[j].shape_transform.get_origin();
+
+					_fix_cell_transform(xform, c, shape_ofs + center_ofs, s);
+
+					xform *= shapes[j].shape_transform.untranslated();
+
+					if (p_job->debug_shapes) {
+						QuadrantUpdate::DebugShape debug_shape;
+						debug_shape.group = group_index;
+						debug_shape.shape = shape;
+						debug_shape.xform = xform;
+						u.debug_shapes.push_back(debug_shape);
+					}
+
+					if (!cell_changed)
+						continue;
+
+					QuadrantUpdate::Shape cell_shape;
+					cell_shape.xform = xform;
+					cell_shape.one_way_collision = shapes[j].one_way_collision;
+					cell_shape.one_way_collision_margin = shapes[j].one_way_collision_margin;
+
+					if (shape->has_meta("decomposed")) {
+						Array _shapes = shape->get_meta("decomposed");
+						for (int k = 0; k < _shapes.size(); k++) {
+							Ref<ConvexPolygonShape2D> convex = _shapes[k];
+							if (convex.is_valid()) {
+								cell_shape.shape = convex->get_rid();
+								cell.shapes.push_back(cell_shape);
+#ifdef DEBUG_ENABLED
+							} else {
+								print_error("The TileSet asigned to the TileMap " + get_name() + " has an invalid convex shape.");
+#endif
+							}
+						}
+					} else {
+						cell_shape.shape = shape->get_rid();
+						cell.shapes.push_back(cell_shape);
+					}
 				}
 			}
+		}
 
-			Rect2 r = tile_set->tile_get_region(c.id);
+		if (!cell_changed)
+			continue;
+
+		if (p_job->navigation) {
+			Vector2 npoly_ofs;
 			if (tile_set->tile_get_tile_mode(c.id) == TileSet::AUTO_TILE || tile_set->tile_get_tile_mode(c.id) == TileSet::ATLAS_TILE) {
-				int spacing = tile_set->autotile_get_spacing(c.id);
-				r.size = tile_set->autotile_get_size(c.id);
-				r.position += (r.size + Vector2(spacing, spacing)) * Vector2(c.autotile_coord_x, c.autotile_coord_y);
+				cell.navpoly = tile_set->autotile_get_navigation_polygon(c.id, Vector2(c.autotile_coord_x, c.autotile_coord_y));
+				npoly_ofs = Vector2();
+			} else {
+				cell.navpoly = tile_set->tile_get_navigation_polygon(c.id);
+				npoly_ofs = tile_set->tile_get_navigation_polygon_offset(c.id);
 			}
 
-			Size2 s;
-			if (r == Rect2())
-				s = tex->get_size();
-			else
-				s = r.size;
-
-			Rect2 rect;
-			rect.position = offset.floor();
-			rect.size = s;
-			rect.size.x += fp_adjust;
-			rect.size.y += fp_adjust;
-
-			if (rect.size.y > rect.size.x) {
-				if ((c.flip_h && (c.flip_v || c.transpose)) || (c.flip_v && !c.transpose))
-					tile_ofs.y += rect.size.y - rect.size.x;
-			} else if (rect.size.y < rect.size.x) {
-				if ((c.flip_v && (c.flip_h || c.transpose)) || (c.flip_h && !c.transpose))
-					tile_ofs.x += rect.size.x - rect.size.y;
+			if (cell.navpoly.is_valid()) {
+				cell.navpoly_xform.set_origin(offset.floor() + q.pos);
+				_fix_cell_transform(cell.navpoly_xform, c, npoly_ofs + center_ofs, s);
 			}
+		}
 
-			/*	rect.size.x+=fp_adjust;
-			rect.size.y+=fp_adjust;*/
+		if (tile_set->tile_get_tile_mode(c.id) == TileSet::AUTO_TILE || tile_set->tile_get_tile_mode(c.id) == TileSet::ATLAS_TILE) {
+			cell.occluder = tile_set->autotile_get_light_occluder(c.id, Vector2(c.autotile_coord_x, c.autotile_coord_y));
+		} else {
+			cell.occluder = tile_set->tile_get_light_occluder(c.id);
+		}
+		if (cell.occluder.is_valid()) {
+			Vector2 occluder_ofs = tile_set->tile_get_occluder_offset(c.id);
+			cell.occluder_xform.set_origin(offset.floor() + q.pos);
+			_fix_cell_transform(cell.occluder_xform, c, occluder_ofs + center_ofs, s);
+		}
 
-			if (c.transpose)
-				SWAP(tile_ofs.x, tile_ofs.y);
+		u.cells.push_back(cell);
+	}
+}
 
-			if (c.flip_h) {
-				rect.size.x = -rect.size.x;
-				tile_ofs.x = -tile_ofs.x;
-			}
-			if (c.flip_v) {
-				rect.size.y = -rect.size.y;
-				tile_ofs.y = -tile_ofs.y;
-			}
+void TileMap::_quadrant_remove_cell(Quadrant &q, const PosKey &p_pk) {
 
-			Vector2 center_ofs;
+	//shapes are removed from the back, so the remaining indices stay valid
+	for (int i = q.shape_owners.size() - 1; i >= 0; i--) {
+		if (q.shape_owners[i] == p_pk) {
+			Physics2DServer::get_singleton()->body_remove_shape(q.body, i);
+			q.shape_owners.remove(i);
+		}
+	}
 
-			if (tile_origin == TILE_ORIGIN_TOP_LEFT) {
-				rect.position += tile_ofs;
+	Map<PosKey, Quadrant::NavPoly>::Element *N = q.navpoly_ids.find(p_pk);
+	if (N) {
+		if (navigation) {
+			navigation->navpoly_remove(N->get().id);
+		}
+		q.navpoly_ids.erase(N);
+	}
 
-			} else if (tile_origin == TILE_ORIGIN_BOTTOM_LEFT) {
+	Map<PosKey, Quadrant::Occluder>::Element *O = q.occluder_instances.find(p_pk);
+	if (O) {
+		VS::get_singleton()->free(O->get().id);
+		q.occluder_instances.erase(O);
+	}
+}
 
-				rect.position += tile_ofs;
+void TileMap::_commit_quadrant_update(Quadrant &q, const Transform2D &p_nav_rel, bool p_debug_shapes, const Color &p_debug_collision_color, bool p_debug_navigation, const Color &p_debug_navigation_color) {
 
-				if (c.transpose) {
-					if (c.flip_h)
-						rect.position.x -= cell_size.x;
-					else
-						rect.position.x += cell_size.x;
-				} else {
-					if (c.flip_v)
-						rect.position.y -= cell_size.y;
-					else
-						rect.position.y += cell_size.y;
-				}
+	VisualServer *vs = VisualServer::get_singleton();
+	Physics2DServer *ps = Physics2DServer::get_singleton();
+	QuadrantUpdate &u = q.update;
 
-			} else if (tile_origin == TILE_ORIGIN_CENTER) {
+	for (List<RID>::Element *E = q.debug_navigation_items.front(); E; E = E->next()) {
+		vs->free(E->get());
+	}
+	q.debug_navigation_items.clear();
+
+	//canvas items are kept (and only cleared) while the material and z index layout stays the same,
+	//which also keeps their draw order valid
+	int items_per_group = p_debug_shapes ? 2 : 1;
+	bool reuse_items = q.canvas_groups.size() == u.groups.size() && q.canvas_items.size() == u.groups.size() * items_per_group;
+	for (int i = 0; reuse_items && i < u.groups.size(); i++) {
+		reuse_items = q.canvas_groups[i] == u.groups[i];
+	}
 
-				rect.position += tile_ofs;
+	Vector<RID> group_items;
+	Vector<RID> group_debug_items;
+	group_items.resize(u.groups.size());
+	group_debug_items.resize(u.groups.size());
 
-				if (c.flip_h)
-					rect.position.x -= cell_size.x / 2;
-				else
-					rect.position.x += cell_size.x / 2;
+	if (reuse_items) {
 
-				if (c.flip_v)
-					rect.position.y -= cell_size.y / 2;
-				else
-					rect.position.y += cell_size.y / 2;
+		int idx = 0;
+		for (List<RID>::Element *E = q.canvas_items.front(); E; E = E->next()) {
+			vs->canvas_item_clear(E->get());
+			if (p_debug_shapes && (idx & 1)) {
+				group_debug_items.write[idx / 2] = E->get();
+			} else {
+				group_items.write[idx / items_per_group] = E->get();
 			}
+			idx++;
+		}
 
-			Ref<Texture> normal_map = tile_set->tile_get_normal_map(c.id);
-			Color modulate = tile_set->tile_get_modulate(c.id);
-			Color self_modulate = get_self_modulate();
-			modulate = Color(modulate.r * self_modulate.r, modulate.g * self_modulate.g,
-					modulate.b * self_modulate.b, modulate.a * self_modulate.a);
-			if (r == Rect2()) {
-				tex->draw_rect(canvas_item, rect, false, modulate, c.transpose, normal_map);
-			} else {
-				tex->draw_rect_region(canvas_item, rect, r, modulate, c.transpose, normal_map, clip_uv);
+	} else {
+
+		for (List<RID>::Element *E = q.canvas_items.front(); E; E = E->next()) {
+			vs->free(E->get());
+		}
+		q.canvas_items.clear();
+
+		for (int i = 0; i < u.groups.size(); i++) {
+
+			RID canvas_item = vs->canvas_item_create();
+			if (u.groups[i].material.is_valid())
+				vs->canvas_item_set_material(canvas_item, u.groups[i].material->get_rid());
+			vs->canvas_item_set_parent(canvas_item, get_canvas_item());
+			_update_item_material_state(canvas_item);
+			Transform2D xform;
+			xform.set_origin(q.pos);
+			vs->canvas_item_set_transform(canvas_item, xform);
+			vs->canvas_item_set_light_mask(canvas_item, get_light_mask());
+			vs->canvas_item_set_z_index(canvas_item, u.groups[i].z_index);
+
+			q.canvas_items.push_back(canvas_item);
+			group_items.write[i] = canvas_item;
+
+			if (p_debug_shapes) {
+
+				RID debug_canvas_item = vs->canvas_item_create();
+				vs->canvas_item_set_parent(debug_canvas_item, canvas_item);
+				vs->canvas_item_set_z_as_relative_to_parent(debug_canvas_item, false);
+				vs->canvas_item_set_z_index(debug_canvas_item, VS::CANVAS_ITEM_Z_MAX - 1);
+				q.canvas_items.push_back(debug_canvas_item);
+				group_debug_items.write[i] = debug_canvas_item;
 			}
+		}
 
-			Vector<TileSet::ShapeData> shapes = tile_set->tile_get_shapes(c.id);
+		q.canvas_groups = u.groups;
+		quadrant_order_dirty = true;
+	}
 
-			for (int j = 0; j < shapes.size(); j++) {
-				Ref<Shape2D> shape = shapes[j].shape;
-				if (shape.is_valid()) {
-					if (tile_set->tile_get_tile_mode(c.id) == TileSet::SINGLE_TILE || (shapes[j].autotile_coord.x == c.autotile_coord_x && shapes[j].autotile_coord.y == c.autotile_coord_y)) {
-						Transform2D xform;
-						xform.set_origin(offset.floor());
+	for (int i = 0; i < u.draws.size(); i++) {
 
-						Vector2 shape_ofs = shapes[j].shape_transform.get_origin();
+		const QuadrantUpdate::Draw &d = u.draws[i];
+		if (d.region == Rect2()) {
+			d.texture->draw_rect(group_items[d.group], d.rect, false, d.modulate, d.transpose, d.normal_map);
+		} else {
+			d.texture->draw_rect_region(group_items[d.group], d.rect, d.region, d.modulate, d.transpose, d.normal_map, clip_uv);
+		}
+	}
 
-						_fix_cell_transform(xform, c, shape_ofs + center_ofs, s);
+	for (int i = 0; i < u.debug_shapes.size(); i++) {
 
-						xform *= shapes[j].shape_transform.untranslated();
+		QuadrantUpdate::DebugShape &ds = u.debug_shapes.write[i];
+		vs->canvas_item_add_set_transform(group_debug_items[ds.group], ds.xform);
+		ds.shape->draw(group_debug_items[ds.group], p_debug_collision_color);
+	}
 
-						if (debug_canvas_item.is_valid()) {
-							vs->canvas_item_add_set_transform(debug_canvas_item, xform);
-							shape->draw(debug_canvas_item, debug_collision_color);
-						}
+	if (p_debug_shapes) {
+		for (int i = 0; i < group_debug_items.size(); i++) {
+			vs->canvas_item_add_set_transform(group_debug_items[i], Transform2D());
+		}
+	}
 
-						if (shape->has_meta("decomposed")) {
-							Array _shapes = shape->get_meta("decomposed");
-							for (int k = 0; k < _shapes.size(); k++) {
-								Ref<ConvexPolygonShape2D> convex = _shapes[k];
-								if (convex.is_valid()) {
-									ps->body_add_shape(q.body, convex->get_rid(), xform);
-									ps->body_set_shape_metadata(q.body, shape_idx, Vector2(E->key().x, E->key().y));
-									ps->body_set_shape_as_one_way_collision(q.body, shape_idx, shapes[j].one_way_collision, shapes[j].one_way_collision_margin);
-									shape_idx++;
-#ifdef DEBUG_ENABLED
-								} else {
-									print_error("The TileSet asigned to the TileMap " + get_name() + " has an invalid convex shape.");
-#endif
-								}
-							}
-						} else {
-							ps->body_add_shape(q.body, shape->get_rid(), xform);
-							ps->body_set_shape_metadata(q.body, shape_idx, Vector2(E->key().x, E->key().y));
-							ps->body_set_shape_as_one_way_collision(q.body, shape_idx, shapes[j].one_way_collision, shapes[j].one_way_collision_margin);
-							shape_idx++;
-						}
-					}
-				}
+	//collision, navigation and occluders are patched per cell unless the whole quadrant is rebuilt
+	if (u.rebuild) {
+
+		ps->body_clear_shapes(q.body);
+		q.shape_owners.clear();
+
+		if (navigation) {
+			for (Map<PosKey, Quadrant::NavPoly>::Element *E = q.navpoly_ids.front(); E; E = E->next()) {
+
+				navigation->navpoly_remove(E->get().id);
 			}
+		}
+		q.navpoly_ids.clear();
+
+		for (Map<PosKey, Quadrant::Occluder>::Element *E = q.occluder_instances.front(); E; E = E->next()) {
+			vs->free(E->get().id);
+		}
+		q.occluder_instances.clear();
+
+	} else {
+
+		for (int i = 0; i < q.dirty_cells.size(); i++) {
+			_quadrant_remove_cell(q, q.dirty_cells[i]);
+		}
+	}
+
+	for (int i = 0; i < u.cells.size(); i++) {
+
+		const QuadrantUpdate::CellData &cell = u.cells[i];
+
+		for (int j = 0; j < cell.shapes.size(); j++) {
+
+			int shape_idx = q.shape_owners.size();
+			ps->body_add_shape(q.body, cell.shapes[j].shape, cell.shapes[j].xform);
+			ps->body_set_shape_metadata(q.body, shape_idx, Vector2(cell.key.x, cell.key.y));
+			ps->body_set_shape_as_one_way_collision(q.body, shape_idx, cell.shapes[j].one_way_collision, cell.shapes[j].one_way_collision_margin);
+			q.shape_owners.push_back(cell.key);
+		}
+
+		if (navigation && cell.navpoly.is_valid()) {
+
+			Quadrant::NavPoly np;
+			np.id = navigation->navpoly_add(cell.navpoly, p_nav_rel * cell.navpoly_xform);
+			np.xform = cell.navpoly_xform;
+			q.navpoly_ids[cell.key] = np;
+		}
+
+		if (cell.occluder.is_valid()) {
+
+			RID orid = vs->canvas_light_occluder_create();
+			vs->canvas_light_occluder_set_transform(orid, get_global_transform() * cell.occluder_xform);
+			vs->canvas_light_occluder_set_polygon(orid, cell.occluder->get_rid());
+			vs->canvas_light_occluder_attach_to_canvas(orid, get_canvas());
+			vs->canvas_light_occluder_set_light_mask(orid, occluder_light_mask);
+			Quadrant::Occluder oc;
+			oc.xform = cell.occluder_xform;
+			oc.id = orid;
+			q.occluder_instances[cell.key] = oc;
+		}
+	}
 
-			if (debug_canvas_item.is_valid()) {
-				vs->canvas_item_add_set_transform(debug_canvas_item, Transform2D());
+	if (navigation && p_debug_navigation && group_items.size()) {
+
+		for (Map<PosKey, Quadrant::NavPoly>::Element *E = q.navpoly_ids.front(); E; E = E->next()) {
+
+			const Map<PosKey, Cell>::Element *C = tile_map.find(E->key());
+			if (!C)
+				continue;
+
+			const Cell &c = C->get();
+			Ref<NavigationPolygon> navpoly;
+			if (tile_set->tile_get_tile_mode(c.id) == TileSet::AUTO_TILE || tile_set->tile_get_tile_mode(c.id) == TileSet::ATLAS_TILE) {
+				navpoly = tile_set->autotile_get_navigation_polygon(c.id, Vector2(c.autotile_coord_x, c.autotile_coord_y));
+			} else {
+				navpoly = tile_set->tile_get_navigation_polygon(c.id);
 			}
 
-			if (navigation) {
-				Ref<NavigationPolygon> navpoly;
-				Vector2 npoly_ofs;
-				if (tile_set->tile_get_tile_mode(c.id) == TileSet::AUTO_TILE || tile_set->tile_get_tile_mode(c.id) == TileSet::ATLAS_TILE) {
-					navpoly = tile_set->autotile_get_navigation_polygon(c.id, Vector2(c.autotile_coord_x, c.autotile_coord_y));
-					npoly_ofs = Vector2();
-				} else {
-					navpoly = tile_set->tile_get_navigation_polygon(c.id);
-					npoly_ofs = tile_set->tile_get_navigation_polygon_offset(c.id);
+			if (navpoly.is_null())
+				continue;
+
+			PoolVector<Vector2> navigation_polygon_vertices = navpoly->get_vertices();
+			int vsize = navigation_polygon_vertices.size();
+
+			if (vsize <= 2)
+				continue;
+
+			RID debug_navigation_item = vs->canvas_item_create();
+			vs->canvas_item_set_parent(debug_navigation_item, group_items[0]);
+			vs->canvas_item_set_z_as_relative_to_parent(debug_navigation_item, false);
+			vs->canvas_item_set_z_index(debug_navigation_item, VS::CANVAS_ITEM_Z_MAX - 2); // Display one below collision debug
+			q.debug_navigation_items.push_back(debug_navigation_item);
+
+			Vector<Color> colors;
+			Vector<Vector2> vertices;
+			vertices.resize(vsize);
+			colors.resize(vsize);
+			{
+				PoolVector<Vector2>::Read vr = navigation_polygon_vertices.read();
+				for (int j = 0; j < vsize; j++) {
+					vertices.write[j] = vr[j];
+					colors.write[j] = p_debug_navigation_color;
 				}
+			}
 
-				if (navpoly.is_valid()) {
-					Transform2D xform;
-					xform.set_origin(offset.floor() + q.pos);
-					_fix_cell_transform(xform, c, npoly_ofs + center_ofs, s);
-
-					int pid = navigation->navpoly_add(navpoly, nav_rel * xform);
-
-					Quadrant::NavPoly np;
-					np.id = pid;
-					np.xform = xform;
-					q.navpoly_ids[E->key()] = np;
-
-					if (debug_navigation) {
-						RID debug_navigation_item = vs->canvas_item_create();
-						vs->canvas_item_set_parent(debug_navigation_item, canvas_item);
-						vs->canvas_item_set_z_as_relative_to_parent(debug_navigation_item, false);
-						vs->canvas_item_set_z_index(debug_navigation_item, VS::CANVAS_ITEM_Z_MAX - 2); // Display one below collision debug
-
-						if (debug_navigation_item.is_valid()) {
-							PoolVector<Vector2> navigation_polygon_vertices = navpoly->get_vertices();
-							int vsize = navigation_polygon_vertices.size();
-
-							if (vsize > 2) {
-								Vector<Color> colors;
-								Vector<Vector2> vertices;
-								vertices.resize(vsize);
-								colors.resize(vsize);
-								{
-									PoolVector<Vector2>::Read vr = navigation_polygon_vertices.read();
-									for (int j = 0; j < vsize; j++) {
-										vertices.write[j] = vr[j];
-										colors.write[j] = debug_navigation_color;
-									}
-								}
-
-								Vector<int> indices;
-
-								for (int j = 0; j < navpoly->get_polygon_count(); j++) {
-									Vector<int> polygon = navpoly->get_polygon(j);
-
-									for (int k = 2; k < polygon.size(); k++) {
-
-										int kofs[3] = { 0, k - 1, k };
-										for (int l = 0; l < 3; l++) {
-
-											int idx = polygon[kofs[l]];
-											ERR_FAIL_INDEX(idx, vsize);
-											indices.push_back(idx);
-										}
-									}
-								}
-								Transform2D navxform;
-								navxform.set_origin(offset.floor());
-								_fix_cell_transform(navxform, c, npoly_ofs + center_ofs, s);
-
-								vs->canvas_item_set_transform(debug_navigation_item, navxform);
-								vs->canvas_item_add_triangle_array(debug_navigation_item, indices, vertices, colors);
-							}
-						}
+			Vector<int> indices;
+
+			for (int j = 0; j < navpoly->get_polygon_count(); j++) {
+				Vector<int> polygon = navpoly->get_polygon(j);
+
+				for (int k = 2; k < polygon.size(); k++) {
+
+					int kofs[3] = { 0, k - 1, k };
+					for (int l = 0; l < 3; l++) {
+
+						int idx = polygon[kofs[l]];
+						ERR_FAIL_INDEX(idx, vsize);
+						indices.push_back(idx);
 					}
 				}
 			}
 
-			Ref<OccluderPolygon2D> occluder;
-			if (tile_set->tile_get_tile_mode(c.id) == TileSet::AUTO_TILE || tile_set->tile_get_tile_mode(c.id) == TileSet::ATLAS_TILE) {
-				occluder = tile_set->autotile_get_light_occluder(c.id, Vector2(c.autotile_coord_x, c.autotile_coord_y));
-			} else {
-				occluder = tile_set->tile_get_light_occluder(c.id);
-			}
-			if (occluder.is_valid()) {
-				Vector2 occluder_ofs = tile_set->tile_get_occluder_offset(c.id);
-				Transform2D xform;
-				xform.set_origin(offset.floor() + q.pos);
-				_fix_cell_transform(xform, c, occluder_ofs + center_ofs, s);
-
-				RID orid = VS::get_singleton()->canvas_light_occluder_create();
-				VS::get_singleton()->canvas_light_occluder_set_transform(orid, get_global_transform() * xform);
-				VS::get_singleton()->canvas_light_occluder_set_polygon(orid, occluder->get_rid());
-				VS::get_singleton()->canvas_light_occluder_attach_to_canvas(orid, get_canvas());
-				VS::get_singleton()->canvas_light_occluder_set_light_mask(orid, occluder_light_mask);
-				Quadrant::Occluder oc;
-				oc.xform = xform;
-				oc.id = orid;
-				q.occluder_instances[E->key()] = oc;
-			}
+			//the navigation polygon transform is in tilemap space, the debug item is relative to the quadrant
+			Transform2D navxform = E->get().xform;
+			navxform.elements[2] -= q.pos;
+
+			vs->canvas_item_set_transform(debug_navigation_item, navxform);
+			vs->canvas_item_add_triangle_array(debug_navigation_item, indices, vertices, colors);
+		}
+	}
+
+	u.groups.clear();
+	u.draws.clear();
+	u.debug_shapes.clear();
+	u.cells.clear();
+
+	q.dirty_cells = VSet<PosKey>();
+	q.rebuild = false;
+}
+
+void TileMap::update_dirty_quadrants() {
+
+	if (!pending_update)
+		return;
+	if (!is_inside_tree() || !tile_set.is_valid()) {
+		pending_update = false;
+		return;
+	}
+
+	Transform2D nav_rel;
+	if (navigation)
+		nav_rel = get_relative_transform_to_parent(navigation);
+
+	SceneTree *st = SceneTree::get_singleton();
+	Color debug_collision_color;
+	Color debug_navigation_color;
+
+	bool debug_shapes = st && st->is_debugging_collisions_hint();
+	if (debug_shapes) {
+		debug_collision_color = st->get_debug_collisions_color();
+	}
+
+	bool debug_navigation = st && st->is_debugging_navigation_hint();
+	if (debug_navigation) {
+		debug_navigation_color = st->get_debug_navigation_color();
+	}
+
+	Vector<Quadrant *> dirty_quadrants;
+	for (SelfList<Quadrant> *E = dirty_quadrant_list.first(); E; E = E->next()) {
+		dirty_quadrants.push_back(E->self());
+	}
+
+	//gather the draw commands and shapes of every dirty quadrant first, this only reads the map and tileset
+	QuadrantJob job;
+	job.quadrants = dirty_quadrants.ptrw();
+	job.tofs = get_cell_draw_offset();
+	job.self_modulate = get_self_modulate();
+	job.debug_shapes = debug_shapes;
+	job.navigation = navigation != NULL;
+
+	if (quadrant_pool) {
+		quadrant_pool->do_work(dirty_quadrants.size(), this, &TileMap::_prepare_quadrant_update, &job);
+	} else {
+		for (int i = 0; i < dirty_quadrants.size(); i++) {
+			_prepare_quadrant_update(i, &job);
 		}
+	}
+
+	while (dirty_quadrant_list.first()) {
 
+		Quadrant &q = *dirty_quadrant_list.first()->self();
+		_commit_quadrant_update(q, nav_rel, debug_shapes, debug_collision_color, debug_navigation, debug_navigation_color);
 		dirty_quadrant_list.remove(dirty_quadrant_list.first());
-		quadrant_order_dirty = true;
 	}
 
 	pending_update = false;
 
 	if (quadrant_order_dirty) {
 
+		//the hashed store is unordered, draw order still follows the quadrant positions
+		Vector<PosKey> keys;
+		keys.resize(quadrant_map.size());
+		int key_count = 0;
+		for (const PosKey *K = quadrant_map.next(NULL); K; K = quadrant_map.next(K)) {
+			keys.write[key_count++] = *K;
+		}
+		keys.sort();
+
 		int index = -(int64_t)0x80000000; //always must be drawn below children
-		for (Map<PosKey, Quadrant>::Element *E = quadrant_map.front(); E; E = E->next()) {
+		for (int i = 0; i < keys.size(); i++) {
 
-			Quadrant &q = E->get();
+			Quadrant &q = quadrant_map[keys[i]];
 			for (List<RID>::Element *F = q.canvas_items.front(); F; F = F->next()) {
 
 				VS::get_singleton()->canvas_item_set_draw_index(F->get(), index++);
@@ -639,14 +825,14 @@ void TileMap::_recompute_rect_cache() {
 		return;
 
 	Rect2 r_total;
-	for (Map<PosKey, Quadrant>::Element *E = quadrant_map.front(); E; E = E->next()) {
+	for (const PosKey *K = quadrant_map.next(NULL); K; K = quadrant_map.next(K)) {
 
 		Rect2 r;
-		r.position = _map_to_world(E->key().x * _get_quadrant_size(), E->key().y * _get_quadrant_size());
-		r.expand_to(_map_to_world(E->key().x * _get_quadrant_size() + _get_quadrant_size(), E->key().y * _get_quadrant_size()));
-		r.expand_to(_map_to_world(E->key().x * _get_quadrant_size() + _get_quadrant_size(), E->key().y * _get_quadrant_size() + _get_quadrant_size()));
-		r.expand_to(_map_to_world(E->key().x * _get_quadrant_size(), E->key().y * _get_quadrant_size() + _get_quadrant_size()));
-		if (E == quadrant_map.front())
+		r.position = _map_to_world(K->x * _get_quadrant_size(), K->y * _get_quadrant_size());
+		r.expand_to(_map_to_world(K->x * _get_quadrant_size() + _get_quadrant_size(), K->y * _get_quadrant_size()));
+		r.expand_to(_map_to_world(K->x * _get_quadrant_size() + _get_quadrant_size(), K->y * _get_quadrant_size() + _get_quadrant_size()));
+		r.expand_to(_map_to_world(K->x * _get_quadrant_size(), K->y * _get_quadrant_size() + _get_quadrant_size()));
+		if (K == quadrant_map.next(NULL))
 			r_total = r;
 		else
 			r_total = r_total.merge(r);
@@ -660,11 +846,12 @@ void TileMap::_recompute_rect_cache() {
 #endif
 }
 
-Map<TileMap::PosKey, TileMap::Quadrant>::Element *TileMap::_create_quadrant(const PosKey &p_qk) {
+TileMap::Quadrant *TileMap::_create_quadrant(const PosKey &p_qk) {
 
 	Transform2D xform;
 	//xform.set_origin(Point2(p_qk.x,p_qk.y)*cell_size*quadrant_size);
 	Quadrant q;
+	q.key = p_qk;
 	q.pos = _map_to_world(p_qk.x * _get_quadrant_size(), p_qk.y * _get_quadrant_size());
 	q.pos += get_cell_draw_offset();
 	if (tile_origin == TILE_ORIGIN_CENTER)
@@ -693,13 +880,19 @@ Map<TileMap::PosKey, TileMap::Quadrant>::Element *TileMap::_create_quadrant(cons
 
 	rect_cache_dirty = true;
 	quadrant_order_dirty = true;
-	return quadrant_map.insert(p_qk, q);
+	quadrant_map.set(p_qk, q);
+	return quadrant_map.getptr(p_qk);
 }
 
-void TileMap::_erase_quadrant(Map<PosKey, Quadrant>::Element *Q) {
+void TileMap::_erase_quadrant(Quadrant *Q) {
 
-	Quadrant &q = Q->get();
+	Quadrant &q = *Q;
 	Physics2DServer::get_singleton()->free(q.body);
+	for (List<RID>::Element *E = q.debug_navigation_items.front(); E; E = E->next()) {
+
+		VisualServer::get_singleton()->free(E->get());
+	}
+	q.debug_navigation_items.clear();
 	for (List<RID>::Element *E = q.canvas_items.front(); E; E = E->next()) {
 
 		VisualServer::get_singleton()->free(E->get());
@@ -721,13 +914,14 @@ void TileMap::_erase_quadrant(Map<PosKey, Quadrant>::Element *Q) {
 	}
 	q.occluder_instances.clear();
 
-	quadrant_map.erase(Q);
+	PosKey qk = q.key;
+	quadrant_map.erase(qk);
 	rect_cache_dirty = true;
 }
 
-void TileMap::_make_quadrant_dirty(Map<PosKey, Quadrant>::Element *Q, bool update) {
+void TileMap::_make_quadrant_dirty(Quadrant *Q, bool update) {
 
-	Quadrant &q = Q->get();
+	Quadrant &q = *Q;
 	if (!q.dirty_list.in_list())
 		dirty_quadrant_list.add(&q.dirty_list);
 
@@ -742,11 +936,38 @@ void TileMap::_make_quadrant_dirty(Map<PosKey, Quadrant>::Element *Q, bool updat
 	}
 }
 
+void TileMap::_make_cell_dirty(const PosKey &p_pk, Quadrant *Q) {
+
+	if (!Q->rebuild) {
+		Q->dirty_cells.insert(p_pk);
+		if (Q->dirty_cells.size() * 2 > Q->cells.size()) {
+			//most of the quadrant changed, rebuilding it is cheaper than patching every cell
+			Q->dirty_cells = VSet<PosKey>();
+			Q->rebuild = true;
+		}
+	}
+	_make_quadrant_dirty(Q);
+}
+
 void TileMap::set_cellv(const Vector2 &p_pos, int p_tile, bool p_flip_x, bool p_flip_y, bool p_transpose) {
 
 	set_cell(p_pos.x, p_pos.y, p_tile, p_flip_x, p_flip_y, p_transpose);
 }
 
+void TileMap::set_cells(const PoolVector<Vector2> &p_positions, const PoolVector<int> &p_tiles) {
+
+	ERR_FAIL_COND(p_tiles.size() != 1 && p_tiles.size() != p_positions.size());
+
+	int count = p_positions.size();
+	bool fill = p_tiles.size() == 1;
+	PoolVector<Vector2>::Read pr = p_positions.read();
+	PoolVector<int>::Read tr = p_tiles.read();
+
+	for (int i = 0; i < count; i++) {
+		set_cell(pr[i].x, pr[i].y, fill ? tr[0] : tr[i]);
+	}
+}
+
 void TileMap::_set_celld(const Vector2 &p_pos, const Dictionary &p_data) {
 
 	set_cell(p_pos.x, p_pos.y, p_data["id"], p_data["flip_h"], p_data["flip_y"], p_data["transpose"], p_data["auto_coord"]);
@@ -764,27 +985,27 @@ void TileMap::set_cell(int p_x, int p_y, int p_tile, bool p_flip_x, bool p_flip_
 	if (p_tile == INVALID_CELL) {
 		//erase existing
 		tile_map.erase(pk);
-		Map<PosKey, Quadrant>::Element *Q = quadrant_map.find(qk);
+		Quadrant *Q = quadrant_map.getptr(qk);
 		ERR_FAIL_COND(!Q);
-		Quadrant &q = Q->get();
+		Quadrant &q = *Q;
 		q.cells.erase(pk);
 		if (q.cells.size() == 0)
 			_erase_quadrant(Q);
 		else
-			_make_quadrant_dirty(Q);
+			_make_cell_dirty(pk, Q);
 
 		used_size_cache_dirty = true;
 		return;
 	}
 
-	Map<PosKey, Quadrant>::Element *Q = quadrant_map.find(qk);
+	Quadrant *Q = quadrant_map.getptr(qk);
 
 	if (!E) {
 		E = tile_map.insert(pk, Cell());
 		if (!Q) {
 			Q = _create_quadrant(qk);
 		}
-		Quadrant &q = Q->get();
+		Quadrant &q = *Q;
 		q.cells.insert(pk);
 	} else {
 		ERR_FAIL_COND(!Q); // quadrant should exist...
@@ -802,7 +1023,7 @@ void TileMap::set_cell(int p_x, int p_y, int p_tile, bool p_flip_x, bool p_flip_
 	c.autotile_coord_x = (uint16_t)p_autotile_coord.x;
 	c.autotile_coord_y = (uint16_t)p_autotile_coord.y;
 
-	_make_quadrant_dirty(Q);
+	_make_cell_dirty(pk, Q);
 	used_size_cache_dirty = true;
 }
 
@@ -920,8 +1141,8 @@ void TileMap::update_cell_bitmask(int p_x, int p_y) {
 			E->get().autotile_coord_y = (int)coord.y;
 
 			PosKey qk(p_x / _get_quadrant_size(), p_y / _get_quadrant_size());
-			Map<PosKey, Quadrant>::Element *Q = quadrant_map.find(qk);
-			_make_quadrant_dirty(Q);
+			Quadrant *Q = quadrant_map.getptr(qk);
+			_make_cell_dirty(p, Q);
 
 		} else if (tile_set->tile_get_tile_mode(id) == TileSet::SINGLE_TILE) {
 			E->get().autotile_coord_x = 0;
@@ -1008,12 +1229,12 @@ void TileMap::set_cell_autotile_coord(int p_x, int p_y, const Vector2 &p_coord)
 	tile_map[pk] = c;
 
 	PosKey qk(p_x / _get_quadrant_size(), p_y / _get_quadrant_size());
-	Map<PosKey, Quadrant>::Element *Q = quadrant_map.find(qk);
+	Quadrant *Q = quadrant_map.getptr(qk);
 
 	if (!Q)
 		return;
 
-	_make_quadrant_dirty(Q);
+	_make_cell_dirty(pk, Q);
 }
 
 Vector2 TileMap::get_cell_autotile_coord(int p_x, int p_y) const {
@@ -1036,13 +1257,13 @@ void TileMap::_recreate_quadrants() {
 
 		PosKey qk(E->key().x / _get_quadrant_size(), E->key().y / _get_quadrant_size());
 
-		Map<PosKey, Quadrant>::Element *Q = quadrant_map.find(qk);
+		Quadrant *Q = quadrant_map.getptr(qk);
 		if (!Q) {
 			Q = _create_quadrant(qk);
-			dirty_quadrant_list.add(&Q->get().dirty_list);
+			dirty_quadrant_list.add(&Q->dirty_list);
 		}
 
-		Q->get().cells.insert(E->key());
+		Q->cells.insert(E->key());
 		_make_quadrant_dirty(Q, false);
 	}
 	update_dirty_quadrants();
@@ -1051,7 +1272,7 @@ void TileMap::_recreate_quadrants() {
 void TileMap::_clear_quadrants() {
 
 	while (quadrant_map.size()) {
-		_erase_quadrant(quadrant_map.front());
+		_erase_quadrant(quadrant_map.getptr(*quadrant_map.next(NULL)));
 	}
 }
 
@@ -1069,9 +1290,9 @@ void TileMap::set_use_parent_material(bool p_use_parent_material) {
 
 void TileMap::_update_all_items_material_state() {
 
-	for (Map<PosKey, Quadrant>::Element *E = quadrant_map.front(); E; E = E->next()) {
+	for (const PosKey *K = quadrant_map.next(NULL); K; K = quadrant_map.next(K)) {
 
-		Quadrant &q = E->get();
+		Quadrant &q = quadrant_map[*K];
 		for (List<RID>::Element *F = q.canvas_items.front(); F; F = F->next()) {
 
 			_update_item_material_state(F->get());
@@ -1181,9 +1402,9 @@ Rect2 TileMap::_edit_get_rect() const {
 void TileMap::set_collision_layer(uint32_t p_layer) {
 
 	collision_layer = p_layer;
-	for (Map<PosKey, Quadrant>::Element *E = quadrant_map.front(); E; E = E->next()) {
+	for (const PosKey *K = quadrant_map.next(NULL); K; K = quadrant_map.next(K)) {
 
-		Quadrant &q = E->get();
+		Quadrant &q = quadrant_map[*K];
 		Physics2DServer::get_singleton()->body_set_collision_layer(q.body, collision_layer);
 	}
 }
@@ -1191,9 +1412,9 @@ void TileMap::set_collision_layer(uint32_t p_layer) {
 void TileMap::set_collision_mask(uint32_t p_mask) {
 
 	collision_mask = p_mask;
-	for (Map<PosKey, Quadrant>::Element *E = quadrant_map.front(); E; E = E->next()) {
+	for (const PosKey *K = quadrant_map.next(NULL); K; K = quadrant_map.next(K)) {
 
-		Quadrant &q = E->get();
+		Quadrant &q = quadrant_map[*K];
 		Physics2DServer::get_singleton()->body_set_collision_mask(q.body, collision_mask);
 	}
 }
@@ -1233,9 +1454,9 @@ void TileMap::set_collision_use_kinematic(bool p_use_kinematic) {
 void TileMap::set_collision_friction(float p_friction) {
 
 	friction = p_friction;
-	for (Map<PosKey, Quadrant>::Element *E = quadrant_map.front(); E; E = E->next()) {
+	for (const PosKey *K = quadrant_map.next(NULL); K; K = quadrant_map.next(K)) {
 
-		Quadrant &q = E->get();
+		Quadrant &q = quadrant_map[*K];
 		Physics2DServer::get_singleton()->body_set_param(q.body, Physics2DServer::BODY_PARAM_FRICTION, p_friction);
 	}
 }
@@ -1248,9 +1469,9 @@ float TileMap::get_collision_friction() const {
 void TileMap::set_collision_bounce(float p_bounce) {
 
 	bounce = p_bounce;
-	for (Map<PosKey, Quadrant>::Element *E = quadrant_map.front(); E; E = E->next()) {
+	for (const PosKey *K = quadrant_map.next(NULL); K; K = quadrant_map.next(K)) {
 
-		Quadrant &q = E->get();
+		Quadrant &q = quadrant_map[*K];
 		Physics2DServer::get_singleton()->body_set_param(q.body, Physics2DServer::BODY_PARAM_BOUNCE, p_bounce);
 	}
 }
@@ -1545,9 +1766,9 @@ Rect2 TileMap::get_used_rect() { // Not const because of cache
 void TileMap::set_occluder_light_mask(int p_mask) {
 
 	occluder_light_mask = p_mask;
-	for (Map<PosKey, Quadrant>::Element *E = quadrant_map.front(); E; E = E->next()) {
+	for (const PosKey *K = quadrant_map.next(NULL); K; K = quadrant_map.next(K)) {
 
-		for (Map<PosKey, Quadrant::Occluder>::Element *F = E->get().occluder_instances.front(); F; F = F->next()) {
+		for (Map<PosKey, Quadrant::Occluder>::Element *F = quadrant_map[*K].occluder_instances.front(); F; F = F->next()) {
 			VisualServer::get_singleton()->canvas_light_occluder_set_light_mask(F->get().id, occluder_light_mask);
 		}
 	}
@@ -1561,9 +1782,9 @@ int TileMap::get_occluder_light_mask() const {
 void TileMap::set_light_mask(int p_light_mask) {
 
 	CanvasItem::set_light_mask(p_light_mask);
-	for (Map<PosKey, Quadrant>::Element *E = quadrant_map.front(); E; E = E->next()) {
+	for (const PosKey *K = quadrant_map.next(NULL); K; K = quadrant_map.next(K)) {
 
-		for (List<RID>::Element *F = E->get().canvas_items.front(); F; F = F->next()) {
+		for (List<RID>::Element *F = quadrant_map[*K].canvas_items.front(); F; F = F->next()) {
 			VisualServer::get_singleton()->canvas_item_set_light_mask(F->get(), get_light_mask());
 		}
 	}
@@ -1584,6 +1805,21 @@ bool TileMap::get_clip_uv() const {
 	return clip_uv;
 }
 
+ThreadWorkPool *TileMap::quadrant_pool = NULL;
+
+void TileMap::set_threaded_quadrant_updates(bool p_enable) {
+
+#ifndef NO_THREADS
+	if (p_enable && !quadrant_pool) {
+		quadrant_pool = memnew(ThreadWorkPool);
+		quadrant_pool->init();
+	} else if (!p_enable && quadrant_pool) {
+		memdelete(quadrant_pool);
+		quadrant_pool = NULL;
+	}
+#endif
+}
+
 void TileMap::_bind_methods() {
 
 	ClassDB::bind_method(D_METHOD("set_tileset", "tileset"), &TileMap::set_tileset);
@@ -1642,6 +1878,7 @@ void TileMap::_bind_methods() {
 
 	ClassDB::bind_method(D_METHOD("set_cell", "x", "y", "tile", "flip_x", "flip_y", "transpose", "autotile_coord"), &TileMap::set_cell, DEFVAL(false), DEFVAL(false), DEFVAL(false), DEFVAL(Vector2()));
 	ClassDB::bind_method(D_METHOD("set_cellv", "position", "tile", "flip_x", "flip_y", "transpose"), &TileMap::set_cellv, DEFVAL(false), DEFVAL(false), DEFVAL(false));
+	ClassDB::bind_method(D_METHOD("set_cells", "positions", "tiles"), &TileMap::set_cells);
 	ClassDB::bind_method(D_METHOD("_set_celld", "position", "data"), &TileMap::_set_celld);
 	ClassDB::bind_method(D_METHOD("get_cell", "x", "y"), &TileMap::get_cell);
 	ClassDB::bind_method(D_METHOD("get_cellv", "position"), &TileMap::get_cellv);
@@ -31,6 +31,8 @@
 #ifndef TILE_MAP_H
 #define TILE_MAP_H
 
+#include "core/hash_map.h"
+#include "core/os/thread_work_pool.h"
 #include "core/self_list.h"
 #include "core/vset.h"
 #include "scene/2d/navigation_2d.h"
@@ -113,14 +115,74 @@ private:
 		Cell() { _u64t = 0; }
 	};
 
+	struct PosKeyHasher {
+		static _FORCE_INLINE_ uint32_t hash(const PosKey &p_key) { return hash_one_uint64(p_key.key); }
+	};
+
 	Map<PosKey, Cell> tile_map;
 	List<PosKey> dirty_bitmask;
 
+	/**
+	 * Everything a quadrant update needs from the TileSet, gathered without touching the servers
+	 * so it can be built on worker threads and committed afterwards.
+	 */
+	struct QuadrantUpdate {
+
+		struct Group {
+			Ref<ShaderMaterial> material;
+			int z_index;
+
+			bool operator==(const Group &p_group) const { return material == p_group.material && z_index == p_group.z_index; }
+		};
+
+		struct Draw {
+			int group;
+			Ref<Texture> texture;
+			Ref<Texture> normal_map;
+			Rect2 rect;
+			Rect2 region;
+			Color modulate;
+			bool transpose;
+		};
+
+		struct DebugShape {
+			int group;
+			Ref<Shape2D> shape;
+			Transform2D xform;
+		};
+
+		struct Shape {
+			RID shape;
+			Transform2D xform;
+			bool one_way_collision;
+			float one_way_collision_margin;
+		};
+
+		struct CellData {
+			PosKey key;
+			Vector<Shape> shapes;
+			Ref<NavigationPolygon> navpoly;
+			Transform2D navpoly_xform;
+			Ref<OccluderPolygon2D> occluder;
+			Transform2D occluder_xform;
+		};
+
+		Vector<Group> groups;
+		Vector<Draw> draws;
+		Vector<DebugShape> debug_shapes;
+		Vector<CellData> cells; //only the cells whose collision, navigation or occluders must be added
+		bool rebuild;
+	};
+
 	struct Quadrant {
 
+		PosKey key;
 		Vector2 pos;
 		List<RID> canvas_items;
+		List<RID> debug_navigation_items;
+		Vector<QuadrantUpdate::Group> canvas_groups; //material and z index of each canvas item, so they can be reused
 		RID body;
+		Vector<PosKey> shape_owners; //cell owning each shape of body, in shape order
 
 		SelfList<Quadrant> dirty_list;
 
@@ -138,29 +200,47 @@ private:
 		Map<PosKey, Occluder> occluder_instances;
 
 		VSet<PosKey> cells;
+		VSet<PosKey> dirty_cells; //changed since the last update, their collision is patched in place unless rebuilding
+		bool rebuild;
+
+		QuadrantUpdate update;
 
 		void operator=(const Quadrant &q) {
+			key = q.key;
 			pos = q.pos;
 			canvas_items = q.canvas_items;
+			debug_navigation_items = q.debug_navigation_items;
+			canvas_groups = q.canvas_groups;
 			body = q.body;
+			shape_owners = q.shape_owners;
 			cells = q.cells;
+			dirty_cells = q.dirty_cells;
+			rebuild = q.rebuild;
 			navpoly_ids = q.navpoly_ids;
 			occluder_instances = q.occluder_instances;
 		}
 		Quadrant(const Quadrant &q) :
 				dirty_list(this) {
+			key = q.key;
 			pos = q.pos;
 			canvas_items = q.canvas_items;
+			debug_navigation_items = q.debug_navigation_items;
+			canvas_groups = q.canvas_groups;
 			body = q.body;
+			shape_owners = q.shape_owners;
 			cells = q.cells;
+			dirty_cells = q.dirty_cells;
+			rebuild = q.rebuild;
 			occluder_instances = q.occluder_instances;
 			navpoly_ids = q.navpoly_ids;
 		}
 		Quadrant() :
-				dirty_list(this) {}
+				dirty_list(this) {
+			rebuild = true;
+		}
 	};
 
-	Map<PosKey, Quadrant> quadrant_map;
+	HashMap<PosKey, Quadrant, PosKeyHasher> quadrant_map;
 
 	SelfList<Quadrant>::List dirty_quadrant_list;
 
@@ -186,9 +266,24 @@ private:
 
 	void _fix_cell_transform(Transform2D &xform, const Cell &p_cell, const Vector2 &p_offset, const Size2 &p_sc);
 
-	Map<PosKey, Quadrant>::Element *_create_quadrant(const PosKey &p_qk);
-	void _erase_quadrant(Map<PosKey, Quadrant>::Element *Q);
-	void _make_quadrant_dirty(Map<PosKey, Quadrant>::Element *Q, bool update = true);
+	Quadrant *_create_quadrant(const PosKey &p_qk);
+	void _erase_quadrant(Quadrant *Q);
+	void _make_quadrant_dirty(Quadrant *Q, bool update = true);
+	void _make_cell_dirty(const PosKey &p_pk, Quadrant *Q);
+
+	struct QuadrantJob {
+		Quadrant **quadrants;
+		Vector2 tofs;
+		Color self_modulate;
+		bool debug_shapes;
+		bool navigation;
+	};
+
+	static ThreadWorkPool *quadrant_pool;
+
+	void _prepare_quadrant_update(uint32_t p_index, QuadrantJob *p_job);
+	void _commit_quadrant_update(Quadrant &q, const Transform2D &p_nav_rel, bool p_debug_shapes, const Color &p_debug_collision_color, bool p_debug_navigation, const Color &p_debug_navigation_color);
+	void _quadrant_remove_cell(Quadrant &q, const PosKey &p_pk);
 	void _recreate_quadrants();
 	void _clear_quadrants();
 	void _update_quadrant_space(const RID &p_space);
@@ -244,6 +339,7 @@ public:
 
 	void _set_celld(const Vector2 &p_pos, const Dictionary &p_data);
 	void set_cellv(const Vector2 &p_pos, int p_tile, bool p_flip_x = false, bool p_flip_y = false, bool p_transpose = false);
+	void set_cells(const PoolVector<Vector2> &p_positions, const PoolVector<int> &p_tiles);
 	int get_cellv(const Vector2 &p_pos) const;
 
 	void make_bitmask_area_dirty(const Vector2 &p_pos);
@@ -315,6 +411,8 @@ public:
 	void fix_invalid_tiles();
 	void clear();
 
+	static void set_threaded_quadrant_updates(bool p_enable);
+
 	TileMap();
 	~TileMap();
 };
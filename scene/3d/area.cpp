@@ -29,6 +29,7 @@
 /*************************************************************************/
 
 #include "area.h"
+#include "core/engine.h"
 #include "scene/scene_string_names.h"
 #include "servers/audio_server.h"
 #include "servers/physics_server.h"
@@ -124,10 +125,12 @@ void Area::_body_enter_tree(ObjectID p_id) {
 	ERR_FAIL_COND(E->get().in_tree);
 
 	E->get().in_tree = true;
-	emit_signal(SceneStringNames::get_singleton()->body_entered, node);
-	for (int i = 0; i < E->get().shapes.size(); i++) {
+	_overlap_changed(body_changes, p_id, true, SceneStringNames::get_singleton()->body_entered, node);
+	if (overlap_signals) {
+		for (int i = 0; i < E->get().shapes.size(); i++) {
 
-		emit_signal(SceneStringNames::get_singleton()->body_shape_entered, p_id, node, E->get().shapes[i].body_shape, E->get().shapes[i].area_shape);
+			emit_signal(SceneStringNames::get_singleton()->body_shape_entered, p_id, node, E->get().shapes[i].body_shape, E->get().shapes[i].area_shape);
+		}
 	}
 }
 
@@ -140,10 +143,12 @@ void Area::_body_exit_tree(ObjectID p_id) {
 	ERR_FAIL_COND(!E);
 	ERR_FAIL_COND(!E->get().in_tree);
 	E->get().in_tree = false;
-	emit_signal(SceneStringNames::get_singleton()->body_exited, node);
-	for (int i = 0; i < E->get().shapes.size(); i++) {
+	_overlap_changed(body_changes, p_id, false, SceneStringNames::get_singleton()->body_exited, node);
+	if (overlap_signals) {
+		for (int i = 0; i < E->get().shapes.size(); i++) {
 
-		emit_signal(SceneStringNames::get_singleton()->body_shape_exited, p_id, node, E->get().shapes[i].body_shape, E->get().shapes[i].area_shape);
+			emit_signal(SceneStringNames::get_singleton()->body_shape_exited, p_id, node, E->get().shapes[i].body_shape, E->get().shapes[i].area_shape);
+		}
 	}
 }
 
@@ -173,7 +178,7 @@ void Area::_body_inout(int p_status, const RID &p_body, int p_instance, int p_bo
 				node->connect(SceneStringNames::get_singleton()->tree_entered, this, SceneStringNames::get_singleton()->_body_enter_tree, make_binds(objid));
 				node->connect(SceneStringNames::get_singleton()->tree_exiting, this, SceneStringNames::get_singleton()->_body_exit_tree, make_binds(objid));
 				if (E->get().in_tree) {
-					emit_signal(SceneStringNames::get_singleton()->body_entered, node);
+					_overlap_changed(body_changes, objid, true, SceneStringNames::get_singleton()->body_entered, node);
 				}
 			}
 		}
@@ -181,7 +186,7 @@ void Area::_body_inout(int p_status, const RID &p_body, int p_instance, int p_bo
 		if (node)
 			E->get().shapes.insert(ShapePair(p_body_shape, p_area_shape));
 
-		if (E->get().in_tree) {
+		if (overlap_signals && E->get().in_tree) {
 			emit_signal(SceneStringNames::get_singleton()->body_shape_entered, objid, node, p_body_shape, p_area_shape);
 		}
 
@@ -200,12 +205,12 @@ void Area::_body_inout(int p_status, const RID &p_body, int p_instance, int p_bo
 				node->disconnect(SceneStringNames::get_singleton()->tree_entered, this, SceneStringNames::get_singleton()->_body_enter_tree);
 				node->disconnect(SceneStringNames::get_singleton()->tree_exiting, this, SceneStringNames::get_singleton()->_body_exit_tree);
 				if (E->get().in_tree)
-					emit_signal(SceneStringNames::get_singleton()->body_exited, obj);
+					_overlap_changed(body_changes, objid, false, SceneStringNames::get_singleton()->body_exited, obj);
 			}
 
 			eraseit = true;
 		}
-		if (node && E->get().in_tree) {
+		if (overlap_signals && node && E->get().in_tree) {
 			emit_signal(SceneStringNames::get_singleton()->body_shape_exited, objid, obj, p_body_shape, p_area_shape);
 		}
 
@@ -240,12 +245,14 @@ void Area::_clear_monitoring() {
 			if (!E->get().in_tree)
 				continue;
 
-			for (int i = 0; i < E->get().shapes.size(); i++) {
+			if (overlap_signals) {
+				for (int i = 0; i < E->get().shapes.size(); i++) {
 
-				emit_signal(SceneStringNames::get_singleton()->body_shape_exited, E->key(), node, E->get().shapes[i].body_shape, E->get().shapes[i].area_shape);
+					emit_signal(SceneStringNames::get_singleton()->body_shape_exited, E->key(), node, E->get().shapes[i].body_shape, E->get().shapes[i].area_shape);
+				}
 			}
 
-			emit_signal(SceneStringNames::get_singleton()->body_exited, node);
+			_overlap_changed(body_changes, E->key(), false, SceneStringNames::get_singleton()->body_exited, node);
 
 			node->disconnect(SceneStringNames::get_singleton()->tree_entered, this, SceneStringNames::get_singleton()->_body_enter_tree);
 			node->disconnect(SceneStringNames::get_singleton()->tree_exiting, this, SceneStringNames::get_singleton()->_body_exit_tree);
@@ -270,12 +277,14 @@ void Area::_clear_monitoring() {
 			if (!E->get().in_tree)
 				continue;
 
-			for (int i = 0; i < E->get().shapes.size(); i++) {
+			if (overlap_signals) {
+				for (int i = 0; i < E->get().shapes.size(); i++) {
 
-				emit_signal(SceneStringNames::get_singleton()->area_shape_exited, E->key(), node, E->get().shapes[i].area_shape, E->get().shapes[i].self_shape);
+					emit_signal(SceneStringNames::get_singleton()->area_shape_exited, E->key(), node, E->get().shapes[i].area_shape, E->get().shapes[i].self_shape);
+				}
 			}
 
-			emit_signal(SceneStringNames::get_singleton()->area_exited, obj);
+			_overlap_changed(area_changes, E->key(), false, SceneStringNames::get_singleton()->area_exited, obj);
 
 			node->disconnect(SceneStringNames::get_singleton()->tree_entered, this, SceneStringNames::get_singleton()->_area_enter_tree);
 			node->disconnect(SceneStringNames::get_singleton()->tree_exiting, this, SceneStringNames::get_singleton()->_area_exit_tree);
@@ -323,10 +332,12 @@ void Area::_area_enter_tree(ObjectID p_id) {
 	ERR_FAIL_COND(E->get().in_tree);
 
 	E->get().in_tree = true;
-	emit_signal(SceneStringNames::get_singleton()->area_entered, node);
-	for (int i = 0; i < E->get().shapes.size(); i++) {
+	_overlap_changed(area_changes, p_id, true, SceneStringNames::get_singleton()->area_entered, node);
+	if (overlap_signals) {
+		for (int i = 0; i < E->get().shapes.size(); i++) {
 
-		emit_signal(SceneStringNames::get_singleton()->area_shape_entered, p_id, node, E->get().shapes[i].area_shape, E->get().shapes[i].self_shape);
+			emit_signal(SceneStringNames::get_singleton()->area_shape_entered, p_id, node, E->get().shapes[i].area_shape, E->get().shapes[i].self_shape);
+		}
 	}
 }
 
@@ -339,10 +350,12 @@ void Area::_area_exit_tree(ObjectID p_id) {
 	ERR_FAIL_COND(!E);
 	ERR_FAIL_COND(!E->get().in_tree);
 	E->get().in_tree = false;
-	emit_signal(SceneStringNames::get_singleton()->area_exited, node);
-	for (int i = 0; i < E->get().shapes.size(); i++) {
+	_overlap_changed(area_changes, p_id, false, SceneStringNames::get_singleton()->area_exited, node);
+	if (overlap_signals) {
+		for (int i = 0; i < E->get().shapes.size(); i++) {
 
-		emit_signal(SceneStringNames::get_singleton()->area_shape_exited, p_id, node, E->get().shapes[i].area_shape, E->get().shapes[i].self_shape);
+			emit_signal(SceneStringNames::get_singleton()->area_shape_exited, p_id, node, E->get().shapes[i].area_shape, E->get().shapes[i].self_shape);
+		}
 	}
 }
 
@@ -370,7 +383,7 @@ void Area::_area_inout(int p_status, const RID &p_area, int p_instance, int p_ar
 				node->connect(SceneStringNames::get_singleton()->tree_entered, this, SceneStringNames::get_singleton()->_area_enter_tree, make_binds(objid));
 				node->connect(SceneStringNames::get_singleton()->tree_exiting, this, SceneStringNames::get_singleton()->_area_exit_tree, make_binds(objid));
 				if (E->get().in_tree) {
-					emit_signal(SceneStringNames::get_singleton()->area_entered, node);
+					_overlap_changed(area_changes, objid, true, SceneStringNames::get_singleton()->area_entered, node);
 				}
 			}
 		}
@@ -378,7 +391,7 @@ void Area::_area_inout(int p_status, const RID &p_area, int p_instance, int p_ar
 		if (node)
 			E->get().shapes.insert(AreaShapePair(p_area_shape, p_self_shape));
 
-		if (!node || E->get().in_tree) {
+		if (overlap_signals && (!node || E->get().in_tree)) {
 			emit_signal(SceneStringNames::get_singleton()->area_shape_entered, objid, node, p_area_shape, p_self_shape);
 		}
 
@@ -397,13 +410,13 @@ void Area::_area_inout(int p_status, const RID &p_area, int p_instance, int p_ar
 				node->disconnect(SceneStringNames::get_singleton()->tree_entered, this, SceneStringNames::get_singleton()->_area_enter_tree);
 				node->disconnect(SceneStringNames::get_singleton()->tree_exiting, this, SceneStringNames::get_singleton()->_area_exit_tree);
 				if (E->get().in_tree) {
-					emit_signal(SceneStringNames::get_singleton()->area_exited, obj);
+					_overlap_changed(area_changes, objid, false, SceneStringNames::get_singleton()->area_exited, obj);
 				}
 			}
 
 			eraseit = true;
 		}
-		if (!node || E->get().in_tree) {
+		if (overlap_signals && (!node || E->get().in_tree)) {
 			emit_signal(SceneStringNames::get_singleton()->area_shape_exited, objid, obj, p_area_shape, p_self_shape);
 		}
 
@@ -492,6 +505,71 @@ bool Area::overlaps_body(Node *p_body) const {
 		return false;
 	return E->get().in_tree;
 }
+
+void Area::_overlap_changed(OverlapChanges &r_changes, ObjectID p_id, bool p_entered, const StringName &p_signal, Object *p_obj) {
+
+	uint64_t frame = Engine::get_singleton()->get_physics_frames();
+	if (r_changes.frame != frame) {
+		r_changes.frame = frame;
+		r_changes.entered.clear();
+		r_changes.exited.clear();
+	}
+
+	if (p_entered) {
+		r_changes.entered.push_back(p_id);
+	} else {
+		r_changes.exited.push_back(p_id);
+	}
+
+	if (overlap_signals) {
+		emit_signal(p_signal, p_obj);
+	}
+}
+
+Array Area::_get_overlap_changes(const OverlapChanges &p_changes, bool p_entered) const {
+
+	Array ret;
+	if (p_changes.frame != Engine::get_singleton()->get_physics_frames())
+		return ret;
+
+	const Vector<ObjectID> &ids = p_entered ? p_changes.entered : p_changes.exited;
+	ret.resize(ids.size());
+	for (int i = 0; i < ids.size(); i++) {
+		ret[i] = ids[i];
+	}
+	return ret;
+}
+
+void Area::set_overlap_signals_enabled(bool p_enabled) {
+
+	overlap_signals = p_enabled;
+}
+
+bool Area::is_overlap_signals_enabled() const {
+
+	return overlap_signals;
+}
+
+Array Area::get_entered_body_ids() const {
+
+	return _get_overlap_changes(body_changes, true);
+}
+
+Array Area::get_exited_body_ids() const {
+
+	return _get_overlap_changes(body_changes, false);
+}
+
+Array Area::get_entered_area_ids() const {
+
+	return _get_overlap_changes(area_changes, true);
+}
+
+Array Area::get_exited_area_ids() const {
+
+	return _get_overlap_changes(area_changes, false);
+}
+
 void Area::set_collision_mask(uint32_t p_mask) {
 
 	collision_mask = p_mask;
@@ -678,6 +756,14 @@ void Area::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("get_overlapping_areas"), &Area::get_overlapping_areas);
 
 	ClassDB::bind_method(D_METHOD("overlaps_body", "body"), &Area::overlaps_body);
+
+	ClassDB::bind_method(D_METHOD("set_overlap_signals_enabled", "enabled"), &Area::set_overlap_signals_enabled);
+	ClassDB::bind_method(D_METHOD("is_overlap_signals_enabled"), &Area::is_overlap_signals_enabled);
+
+	ClassDB::bind_method(D_METHOD("get_entered_body_ids"), &Area::get_entered_body_ids);
+	ClassDB::bind_method(D_METHOD("get_exited_body_ids"), &Area::get_exited_body_ids);
+	ClassDB::bind_method(D_METHOD("get_entered_area_ids"), &Area::get_entered_area_ids);
+	ClassDB::bind_method(D_METHOD("get_exited_area_ids"), &Area::get_exited_area_ids);
 	ClassDB::bind_method(D_METHOD("overlaps_area", "area"), &Area::overlaps_area);
 
 	ClassDB::bind_method(D_METHOD("_body_inout"), &Area::_body_inout);
@@ -721,6 +807,7 @@ void Area::_bind_methods() {
 	ADD_PROPERTY(PropertyInfo(Variant::INT, "priority", PROPERTY_HINT_RANGE, "0,128,1"), "set_priority", "get_priority");
 	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "monitoring"), "set_monitoring", "is_monitoring");
 	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "monitorable"), "set_monitorable", "is_monitorable");
+	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "overlap_signals_enabled"), "set_overlap_signals_enabled", "is_overlap_signals_enabled");
 	ADD_GROUP("Collision", "collision_");
 	ADD_PROPERTY(PropertyInfo(Variant::INT, "collision_layer", PROPERTY_HINT_LAYERS_3D_PHYSICS), "set_collision_layer", "get_collision_layer");
 	ADD_PROPERTY(PropertyInfo(Variant::INT, "collision_mask", PROPERTY_HINT_LAYERS_3D_PHYSICS), "set_collision_mask", "get_collision_mask");
@@ -746,6 +833,7 @@ Area::Area() :
 	space_override = SPACE_OVERRIDE_DISABLED;
 	set_gravity(9.8);
 	locked = false;
+	overlap_signals = true;
 	set_gravity_vector(Vector3(0, -1, 0));
 	gravity_is_point = false;
 	gravity_distance_scale = 0;
@@ -34,6 +34,12 @@
 #include "scene/3d/camera.h"
 #include "scene/3d/listener.h"
 #include "scene/main/viewport.h"
+#include "servers/audio/audio_mix_kernels.h"
+
+SelfList<AudioStreamPlayer3D>::List AudioStreamPlayer3D::voice_list;
+uint64_t AudioStreamPlayer3D::voice_frame = 0;
+int AudioStreamPlayer3D::max_real_voices = 0;
+float AudioStreamPlayer3D::virtual_voice_threshold = 0;
 
 void AudioStreamPlayer3D::_mix_audio() {
 
@@ -45,10 +51,51 @@ void AudioStreamPlayer3D::_mix_audio() {
 	bool started = false;
 	if (setseek >= 0.0) {
 		stream_playback->start(setseek);
+		virtual_position = setseek;
 		setseek = -1.0; //reset seek
 		started = true;
 	}
 
+	if (voice_virtual || (playback_virtual && stream_stop)) {
+
+		if (!playback_virtual) {
+			virtual_position = stream_playback->get_playback_position();
+			playback_virtual = true;
+		}
+
+		//only advance the position, doppler is ignored while nobody can hear it
+		virtual_position += pitch_scale * mix_buffer.size() / AudioServer::get_singleton()->get_mix_rate();
+
+		float length = stream->get_length();
+		if (virtual_position >= length) {
+			if (stream->has_loop()) {
+				virtual_position = Math::fmod(virtual_position, length);
+			} else {
+				active = false; //would have finished playing by now
+			}
+		}
+
+		if (stream_stop) {
+			active = false;
+			set_physics_process_internal(false);
+			setplay = -1;
+		}
+
+		prev_output_count = 0;
+		output_ready = false;
+		stream_fade_in = false;
+		stream_fade_out = false;
+		return;
+	}
+
+	if (playback_virtual) {
+		//audible again, continue from where the virtual voice got to and ramp in
+		stream_playback->start(virtual_position);
+		playback_virtual = false;
+		stream_fade_in = true;
+		started = true;
+	}
+
 	//get data
 	AudioFrame *buffer = mix_buffer.ptrw();
 	int buffer_size = mix_buffer.size();
@@ -170,20 +217,10 @@ void AudioStreamPlayer3D::_mix_audio() {
 
 				if (current.reverb_bus_index == prev_outputs[i].reverb_bus_index) {
 					AudioFrame rvol_inc = (current.reverb_vol[k] - prev_outputs[i].reverb_vol[k]) / float(buffer_size);
-					AudioFrame rvol = prev_outputs[i].reverb_vol[k];
-
-					for (int j = 0; j < buffer_size; j++) {
-
-						rtarget[j] += buffer[j] * rvol;
-						rvol += rvol_inc;
-					}
+					AudioMixKernels::mix_ramp(buffer, rtarget, buffer_size, prev_outputs[i].reverb_vol[k], rvol_inc);
 				} else {
 
-					AudioFrame rvol = current.reverb_vol[k];
-					for (int j = 0; j < buffer_size; j++) {
-
-						rtarget[j] += buffer[j] * rvol;
-					}
+					AudioMixKernels::mix_ramp(buffer, rtarget, buffer_size, current.reverb_vol[k], AudioFrame(0, 0));
 				}
 			}
 		}
@@ -246,6 +283,7 @@ void AudioStreamPlayer3D::_notification(int p_what) {
 	if (p_what == NOTIFICATION_ENTER_TREE) {
 
 		velocity_tracker->reset(get_global_transform().origin);
+		voice_list.add(&voice_item);
 		AudioServer::get_singleton()->add_callback(_mix_audios, this);
 		if (autoplay && !Engine::get_singleton()->is_editor_hint()) {
 			play();
@@ -255,6 +293,7 @@ void AudioStreamPlayer3D::_notification(int p_what) {
 	if (p_what == NOTIFICATION_EXIT_TREE) {
 
 		AudioServer::get_singleton()->remove_callback(_mix_audios, this);
+		voice_list.remove(&voice_item);
 	}
 
 	if (p_what == NOTIFICATION_PAUSED) {
@@ -571,10 +610,22 @@ void AudioStreamPlayer3D::_notification(int p_what) {
 					break;
 			}
 
+			float loudest = 0;
+			int vol_index_max = AudioServer::get_singleton()->get_speaker_mode() + 1;
+			for (int i = 0; i < new_output_count; i++) {
+				for (int k = 0; k < vol_index_max; k++) {
+					loudest = MAX(loudest, MAX(outputs[i].vol[k].l, outputs[i].vol[k].r));
+					loudest = MAX(loudest, MAX(outputs[i].reverb_vol[k].l, outputs[i].reverb_vol[k].r));
+				}
+			}
+			audibility = loudest;
+
 			output_count = new_output_count;
 			output_ready = true;
 		}
 
+		_update_voices();
+
 		//start playing if requested
 		if (setplay >= 0.0) {
 			setseek = setplay;
@@ -887,6 +938,68 @@ bool AudioStreamPlayer3D::get_stream_paused() const {
 	return stream_paused;
 }
 
+void AudioStreamPlayer3D::set_priority(int p_priority) {
+
+	priority = p_priority;
+}
+
+int AudioStreamPlayer3D::get_priority() const {
+
+	return priority;
+}
+
+bool AudioStreamPlayer3D::is_voice_virtual() const {
+
+	return voice_virtual;
+}
+
+void AudioStreamPlayer3D::_update_voices() {
+
+	uint64_t frame = Engine::get_singleton()->get_physics_frames();
+	if (frame == voice_frame)
+		return; //already done by another player this frame
+	voice_frame = frame;
+
+	Vector<AudioStreamPlayer3D *> voices;
+
+	for (SelfList<AudioStreamPlayer3D> *E = voice_list.first(); E; E = E->next()) {
+
+		AudioStreamPlayer3D *player = E->self();
+
+		if (!player->active || !player->stream.is_valid() || player->stream->get_length() <= 0) {
+			//without a known length, the position can't be restored
+			player->voice_virtual = false;
+			continue;
+		}
+
+		if (player->out_of_range_mode == OUT_OF_RANGE_PAUSE && player->output_count == 0) {
+			player->voice_virtual = false; //already paused
+			continue;
+		}
+
+		if (player->audibility < virtual_voice_threshold) {
+			player->voice_virtual = true;
+			continue;
+		}
+
+		voices.push_back(player);
+	}
+
+	if (max_real_voices > 0 && voices.size() > max_real_voices) {
+		voices.sort_custom<VoiceSort>();
+	}
+
+	for (int i = 0; i < voices.size(); i++) {
+		voices[i]->voice_virtual = max_real_voices > 0 && i >= max_real_voices;
+	}
+}
+
+void AudioStreamPlayer3D::set_voice_budget(int p_max_real_voices, float p_virtual_threshold_db) {
+
+	max_real_voices = p_max_real_voices;
+	virtual_voice_threshold = Math::db2linear(p_virtual_threshold_db);
+}
+
 void AudioStreamPlayer3D::_bind_methods() {
 
 	ClassDB::bind_method(D_METHOD("set_stream", "stream"), &AudioStreamPlayer3D::set_stream);
@@ -953,6 +1066,11 @@ void AudioStreamPlayer3D::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("set_stream_paused", "pause"), &AudioStreamPlayer3D::set_stream_paused);
 	ClassDB::bind_method(D_METHOD("get_stream_paused"), &AudioStreamPlayer3D::get_stream_paused);
 
+	ClassDB::bind_method(D_METHOD("set_priority", "priority"), &AudioStreamPlayer3D::set_priority);
+	ClassDB::bind_method(D_METHOD("get_priority"), &AudioStreamPlayer3D::get_priority);
+
+	ClassDB::bind_method(D_METHOD("is_voice_virtual"), &AudioStreamPlayer3D::is_voice_virtual);
+
 	ClassDB::bind_method(D_METHOD("_bus_layout_changed"), &AudioStreamPlayer3D::_bus_layout_changed);
 
 	ADD_PROPERTY(PropertyInfo(Variant::OBJECT, "stream", PROPERTY_HINT_RESOURCE_TYPE, "AudioStream"), "set_stream", "get_stream");
@@ -968,6 +1086,7 @@ void AudioStreamPlayer3D::_bind_methods() {
 	ADD_PROPERTY(PropertyInfo(Variant::INT, "out_of_range_mode", PROPERTY_HINT_ENUM, "Mix,Pause"), "set_out_of_range_mode", "get_out_of_range_mode");
 	ADD_PROPERTY(PropertyInfo(Variant::STRING, "bus", PROPERTY_HINT_ENUM, ""), "set_bus", "get_bus");
 	ADD_PROPERTY(PropertyInfo(Variant::INT, "area_mask", PROPERTY_HINT_LAYERS_2D_PHYSICS), "set_area_mask", "get_area_mask");
+	ADD_PROPERTY(PropertyInfo(Variant::INT, "priority"), "set_priority", "get_priority");
 	ADD_GROUP("Emission Angle", "emission_angle");
 	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "emission_angle_enabled"), "set_emission_angle_enabled", "is_emission_angle_enabled");
 	ADD_PROPERTY(PropertyInfo(Variant::REAL, "emission_angle_degrees", PROPERTY_HINT_RANGE, "0.1,90,0.1"), "set_emission_angle", "get_emission_angle");
@@ -992,7 +1111,8 @@ void AudioStreamPlayer3D::_bind_methods() {
 	ADD_SIGNAL(MethodInfo("finished"));
 }
 
-AudioStreamPlayer3D::AudioStreamPlayer3D() {
+AudioStreamPlayer3D::AudioStreamPlayer3D() :
+		voice_item(this) {
 
 	unit_db = 0;
 	unit_size = 1;
@@ -1019,6 +1139,11 @@ AudioStreamPlayer3D::AudioStreamPlayer3D() {
 	stream_fade_in = false;
 	stream_fade_out = false;
 	stream_stop = false;
+	priority = 0;
+	audibility = 0;
+	voice_virtual = false;
+	playback_virtual = false;
+	virtual_position = 0;
 
 	velocity_tracker.instance();
 	AudioServer::get_singleton()->connect("bus_layout_changed", this, "_bus_layout_changed");
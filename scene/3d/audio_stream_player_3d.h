@@ -31,6 +31,7 @@
 #ifndef AUDIO_STREAM_PLAYER_3D_H
 #define AUDIO_STREAM_PLAYER_3D_H
 
+#include "core/self_list.h"
 #include "scene/3d/spatial.h"
 #include "scene/3d/spatial_velocity_tracker.h"
 #include "servers/audio/audio_filter_sw.h"
@@ -114,6 +115,30 @@ private:
 	bool stream_stop;
 	StringName bus;
 
+	//voice budget, a virtual voice keeps its playback position moving but is neither decoded nor mixed
+	int priority;
+	float audibility; //loudest volume sent to any listener, updated on physics process
+	volatile bool voice_virtual;
+	bool playback_virtual; //audio thread side of voice_virtual
+	float virtual_position;
+	SelfList<AudioStreamPlayer3D> voice_item;
+
+	static SelfList<AudioStreamPlayer3D>::List voice_list;
+	static uint64_t voice_frame;
+	static int max_real_voices;
+	static float virtual_voice_threshold;
+
+	struct VoiceSort {
+		_FORCE_INLINE_ bool operator()(const AudioStreamPlayer3D *p_a, const AudioStreamPlayer3D *p_b) const {
+			if (p_a->priority != p_b->priority) {
+				return p_a->priority > p_b->priority;
+			}
+			return p_a->audibility > p_b->audibility;
+		}
+	};
+
+	static void _update_voices();
+
 	void _mix_audio();
 	static void _mix_audios(void *self) { reinterpret_cast<AudioStreamPlayer3D *>(self)->_mix_audio(); }
 
@@ -206,6 +231,13 @@ public:
 	void set_stream_paused(bool p_pause);
 	bool get_stream_paused() const;
 
+	void set_priority(int p_priority);
+	int get_priority() const;
+
+	bool is_voice_virtual() const;
+
+	static void set_voice_budget(int p_max_real_voices, float p_virtual_threshold_db);
+
 	AudioStreamPlayer3D();
 	~AudioStreamPlayer3D();
 };
@@ -30,6 +30,8 @@
 
 #include "navigation.h"
 
+#include "core/os/frame_arena.h"
+
 #define USE_ENTRY_POINT
 
 void Navigation::_navmesh_link(int p_id) {
@@ -105,7 +107,7 @@ void Navigation::_navmesh_link(int p_id) {
 			int next = (j + 1) % plen;
 			EdgeKey ek(p.edges[j].point, p.edges[next].point);
 
-			Map<EdgeKey, Connection>::Element *C = connections.find(ek);
+			Connection *C = connections.getptr(ek);
 			if (!C) {
 
 				Connection c;
@@ -116,20 +118,20 @@ void Navigation::_navmesh_link(int p_id) {
 				connections[ek] = c;
 			} else {
 
-				if (C->get().B != NULL) {
+				if (C->B != NULL) {
 					ConnectionPending pending;
 					pending.polygon = &p;
 					pending.edge = j;
-					p.edges.write[j].P = C->get().pending.push_back(pending);
+					p.edges.write[j].P = C->pending.push_back(pending);
 					continue;
 				}
 
-				C->get().B = &p;
-				C->get().B_edge = j;
-				C->get().A->edges.write[C->get().A_edge].C = &p;
-				C->get().A->edges.write[C->get().A_edge].C_edge = j;
-				p.edges.write[j].C = C->get().A;
-				p.edges.write[j].C_edge = C->get().A_edge;
+				C->B = &p;
+				C->B_edge = j;
+				C->A->edges.write[C->A_edge].C = &p;
+				C->A->edges.write[C->A_edge].C_edge = j;
+				p.edges.write[j].C = C->A;
+				p.edges.write[j].C_edge = C->A_edge;
 				//connection successful.
 			}
 		}
@@ -155,45 +157,45 @@ void Navigation::_navmesh_unlink(int p_id) {
 			int next = (i + 1) % ec;
 
 			EdgeKey ek(edges[i].point, edges[next].point);
-			Map<EdgeKey, Connection>::Element *C = connections.find(ek);
+			Connection *C = connections.getptr(ek);
 
 			ERR_CONTINUE(!C);
 
 			if (edges[i].P) {
-				C->get().pending.erase(edges[i].P);
+				C->pending.erase(edges[i].P);
 				edges[i].P = NULL;
-			} else if (C->get().B) {
+			} else if (C->B) {
 				//disconnect
 
-				C->get().B->edges.write[C->get().B_edge].C = NULL;
-				C->get().B->edges.write[C->get().B_edge].C_edge = -1;
-				C->get().A->edges.write[C->get().A_edge].C = NULL;
-				C->get().A->edges.write[C->get().A_edge].C_edge = -1;
+				C->B->edges.write[C->B_edge].C = NULL;
+				C->B->edges.write[C->B_edge].C_edge = -1;
+				C->A->edges.write[C->A_edge].C = NULL;
+				C->A->edges.write[C->A_edge].C_edge = -1;
 
-				if (C->get().A == &E->get()) {
+				if (C->A == &E->get()) {
 
-					C->get().A = C->get().B;
-					C->get().A_edge = C->get().B_edge;
+					C->A = C->B;
+					C->A_edge = C->B_edge;
 				}
-				C->get().B = NULL;
-				C->get().B_edge = -1;
+				C->B = NULL;
+				C->B_edge = -1;
 
-				if (C->get().pending.size()) {
+				if (C->pending.size()) {
 					//reconnect if something is pending
-					ConnectionPending cp = C->get().pending.front()->get();
-					C->get().pending.pop_front();
-
-					C->get().B = cp.polygon;
-					C->get().B_edge = cp.edge;
-					C->get().A->edges.write[C->get().A_edge].C = cp.polygon;
-					C->get().A->edges.write[C->get().A_edge].C_edge = cp.edge;
-					cp.polygon->edges.write[cp.edge].C = C->get().A;
-					cp.polygon->edges.write[cp.edge].C_edge = C->get().A_edge;
+					ConnectionPending cp = C->pending.front()->get();
+					C->pending.pop_front();
+
+					C->B = cp.polygon;
+					C->B_edge = cp.edge;
+					C->A->edges.write[C->A_edge].C = cp.polygon;
+					C->A->edges.write[C->A_edge].C_edge = cp.edge;
+					cp.polygon->edges.write[cp.edge].C = C->A;
+					cp.polygon->edges.write[cp.edge].C_edge = C->A_edge;
 					cp.polygon->edges.write[cp.edge].P = NULL;
 				}
 
 			} else {
-				connections.erase(C);
+				connections.erase(ek);
 				//erase
 			}
 		}
@@ -215,6 +217,7 @@ int Navigation::navmesh_add(const Ref<NavigationMesh> &p_mesh, const Transform &
 	navmesh_map[id] = nm;
 
 	_navmesh_link(id);
+	_update_polygon_ids();
 
 	return id;
 }
@@ -228,15 +231,32 @@ void Navigation::navmesh_set_transform(int p_id, const Transform &p_xform) {
 	_navmesh_unlink(p_id);
 	nm.xform = p_xform;
 	_navmesh_link(p_id);
+	_update_polygon_ids();
 }
 void Navigation::navmesh_remove(int p_id) {
 
 	ERR_FAIL_COND(!navmesh_map.has(p_id));
 	_navmesh_unlink(p_id);
 	navmesh_map.erase(p_id);
+	_update_polygon_ids();
+}
+
+void Navigation::_update_polygon_ids() {
+
+	polygon_count = 0;
+
+	for (Map<int, NavMesh>::Element *E = navmesh_map.front(); E; E = E->next()) {
+
+		if (!E->get().linked)
+			continue;
+
+		for (List<Polygon>::Element *F = E->get().polygons.front(); F; F = F->next()) {
+			F->get().id = polygon_count++;
+		}
+	}
 }
 
-void Navigation::_clip_path(Vector<Vector3> &path, Polygon *from_poly, const Vector3 &p_to_point, Polygon *p_to_poly) {
+void Navigation::_clip_path(Vector<Vector3> &path, Polygon *from_poly, const Vector3 &p_to_point, Polygon *p_to_poly, const PolygonSearch *p_search) {
 
 	Vector3 from = path[path.size() - 1];
 
@@ -251,7 +271,7 @@ void Navigation::_clip_path(Vector<Vector3> &path, Polygon *from_poly, const Vec
 
 	while (from_poly != p_to_poly) {
 
-		int pe = from_poly->prev_edge;
+		int pe = p_search[from_poly->id].prev_edge;
 		Vector3 a = _get_vertex(from_poly->edges[pe].point);
 		Vector3 b = _get_vertex(from_poly->edges[(pe + 1) % from_poly->edges.size()].point);
 
@@ -272,6 +292,10 @@ void Navigation::_clip_path(Vector<Vector3> &path, Polygon *from_poly, const Vec
 
 Vector<Vector3> Navigation::get_simple_path(const Vector3 &p_start, const Vector3 &p_end, bool p_optimize) {
 
+	Vector<PolygonSearch> search_data;
+	search_data.resize(polygon_count);
+	PolygonSearch *search = search_data.ptrw();
+
 	Polygon *begin_poly = NULL;
 	Polygon *end_poly = NULL;
 	Vector3 begin_point;
@@ -306,7 +330,7 @@ Vector<Vector3> Navigation::get_simple_path(const Vector3 &p_start, const Vector
 				}
 			}
 
-			p.prev_edge = -1;
+			search[p.id].prev_edge = -1;
 		}
 	}
 
@@ -326,24 +350,24 @@ Vector<Vector3> Navigation::get_simple_path(const Vector3 &p_start, const Vector
 
 	bool found_route = false;
 
-	List<Polygon *> open_list;
+	List<Polygon *, FrameArena> open_list;
 
 	for (int i = 0; i < begin_poly->edges.size(); i++) {
 
 		if (begin_poly->edges[i].C) {
 
-			begin_poly->edges[i].C->prev_edge = begin_poly->edges[i].C_edge;
+			search[begin_poly->edges[i].C->id].prev_edge = begin_poly->edges[i].C_edge;
 #ifdef USE_ENTRY_POINT
 			Vector3 edge[2] = {
 				_get_vertex(begin_poly->edges[i].point),
 				_get_vertex(begin_poly->edges[(i + 1) % begin_poly->edges.size()].point)
 			};
 
-			Vector3 entry = Geometry::get_closest_point_to_segment(begin_poly->entry, edge);
-			begin_poly->edges[i].C->distance = begin_poly->entry.distance_to(entry);
-			begin_poly->edges[i].C->entry = entry;
+			Vector3 entry = Geometry::get_closest_point_to_segment(search[begin_poly->id].entry, edge);
+			search[begin_poly->edges[i].C->id].distance = search[begin_poly->id].entry.distance_to(entry);
+			search[begin_poly->edges[i].C->id].entry = entry;
 #else
-			begin_poly->edges[i].C->distance = begin_poly->center.distance_to(begin_poly->edges[i].C->center);
+			search[begin_poly->edges[i].C->id].distance = begin_poly->center.distance_to(begin_poly->edges[i].C->center);
 #endif
 			open_list.push_back(begin_poly->edges[i].C);
 
@@ -360,22 +384,22 @@ Vector<Vector3> Navigation::get_simple_path(const Vector3 &p_start, const Vector
 		}
 		//check open list
 
-		List<Polygon *>::Element *least_cost_poly = NULL;
+		List<Polygon *, FrameArena>::Element *least_cost_poly = NULL;
 		float least_cost = 1e30;
 
 		//this could be faster (cache previous results)
-		for (List<Polygon *>::Element *E = open_list.front(); E; E = E->next()) {
+		for (List<Polygon *, FrameArena>::Element *E = open_list.front(); E; E = E->next()) {
 
 			Polygon *p = E->get();
 
-			float cost = p->distance;
+			float cost = search[p->id].distance;
 #ifdef USE_ENTRY_POINT
 			int es = p->edges.size();
 
 			float shortest_distance = 1e30;
 
 			for (int i = 0; i < es; i++) {
-				Polygon::Edge &e = p->edges.write[i];
+				const Polygon::Edge &e = p->edges[i];
 
 				if (!e.C)
 					continue;
@@ -385,8 +409,8 @@ Vector<Vector3> Navigation::get_simple_path(const Vector3 &p_start, const Vector
 					_get_vertex(p->edges[(i + 1) % es].point)
 				};
 
-				Vector3 edge_point = Geometry::get_closest_point_to_segment(p->entry, edge);
-				float dist = p->entry.distance_to(edge_point);
+				Vector3 edge_point = Geometry::get_closest_point_to_segment(search[p->id].entry, edge);
+				float dist = search[p->id].entry.distance_to(edge_point);
 				if (dist < shortest_distance)
 					shortest_distance = dist;
 			}
@@ -406,26 +430,26 @@ Vector<Vector3> Navigation::get_simple_path(const Vector3 &p_start, const Vector
 
 		for (int i = 0; i < p->edges.size(); i++) {
 
-			Polygon::Edge &e = p->edges.write[i];
+			const Polygon::Edge &e = p->edges[i];
 
 			if (!e.C)
 				continue;
 
-			float distance = p->center.distance_to(e.C->center) + p->distance;
+			float distance = p->center.distance_to(e.C->center) + search[p->id].distance;
 
-			if (e.C->prev_edge != -1) {
+			if (search[e.C->id].prev_edge != -1) {
 				//oh this was visited already, can we win the cost?
 
-				if (e.C->distance > distance) {
+				if (search[e.C->id].distance > distance) {
 
-					e.C->prev_edge = e.C_edge;
-					e.C->distance = distance;
+					search[e.C->id].prev_edge = e.C_edge;
+					search[e.C->id].distance = distance;
 				}
 			} else {
 				//add to open neighbours
 
-				e.C->prev_edge = e.C_edge;
-				e.C->distance = distance;
+				search[e.C->id].prev_edge = e.C_edge;
+				search[e.C->id].distance = distance;
 				open_list.push_back(e.C);
 
 				if (e.C == end_poly) {
@@ -469,8 +493,8 @@ Vector<Vector3> Navigation::get_simple_path(const Vector3 &p_start, const Vector
 					left = begin_point;
 					right = begin_point;
 				} else {
-					int prev = p->prev_edge;
-					int prev_n = (p->prev_edge + 1) % p->edges.size();
+					int prev = search[p->id].prev_edge;
+					int prev_n = (search[p->id].prev_edge + 1) % p->edges.size();
 					left = _get_vertex(p->edges[prev].point);
 					right = _get_vertex(p->edges[prev_n].point);
 
@@ -489,7 +513,7 @@ Vector<Vector3> Navigation::get_simple_path(const Vector3 &p_start, const Vector
 						portal_left = left;
 					} else {
 
-						_clip_path(path, apex_poly, portal_right, right_poly);
+						_clip_path(path, apex_poly, portal_right, right_poly, search);
 
 						apex_point = portal_right;
 						p = right_poly;
@@ -509,7 +533,7 @@ Vector<Vector3> Navigation::get_simple_path(const Vector3 &p_start, const Vector
 						portal_right = right;
 					} else {
 
-						_clip_path(path, apex_poly, portal_left, left_poly);
+						_clip_path(path, apex_poly, portal_left, left_poly, search);
 
 						apex_point = portal_left;
 						p = left_poly;
@@ -522,7 +546,7 @@ Vector<Vector3> Navigation::get_simple_path(const Vector3 &p_start, const Vector
 				}
 
 				if (p != begin_poly)
-					p = p->edges[p->prev_edge].C;
+					p = p->edges[search[p->id].prev_edge].C;
 				else
 					p = NULL;
 			}
@@ -538,8 +562,8 @@ Vector<Vector3> Navigation::get_simple_path(const Vector3 &p_start, const Vector
 
 			path.push_back(end_point);
 			while (true) {
-				int prev = p->prev_edge;
-				int prev_n = (p->prev_edge + 1) % p->edges.size();
+				int prev = search[p->id].prev_edge;
+				int prev_n = (search[p->id].prev_edge + 1) % p->edges.size();
 				Vector3 point = (_get_vertex(p->edges[prev].point) + _get_vertex(p->edges[prev_n].point)) * 0.5;
 				path.push_back(point);
 				p = p->edges[prev].C;
@@ -558,6 +582,49 @@ Vector<Vector3> Navigation::get_simple_path(const Vector3 &p_start, const Vector
 	return Vector<Vector3>();
 }
 
+void Navigation::_solve_path_query(uint32_t p_index, PathQueryBatch *p_batch) {
+
+	p_batch->paths[p_index] = get_simple_path(p_batch->starts[p_index], p_batch->ends[p_index], p_batch->optimize);
+}
+
+Array Navigation::get_simple_paths(const PoolVector3Array &p_starts, const PoolVector3Array &p_ends, bool p_optimize) {
+
+	ERR_FAIL_COND_V(p_starts.size() != p_ends.size(), Array());
+
+	int count = p_starts.size();
+
+	Vector<Vector<Vector3> > paths;
+	paths.resize(count);
+
+	PoolVector3Array::Read starts = p_starts.read();
+	PoolVector3Array::Read ends = p_ends.read();
+
+	PathQueryBatch batch;
+	batch.starts = starts.ptr();
+	batch.ends = ends.ptr();
+	batch.paths = paths.ptrw();
+	batch.optimize = p_optimize;
+
+	if (count > 1) {
+		if (!path_query_pool.is_initialized()) {
+			path_query_pool.init();
+		}
+		path_query_pool.do_work(count, this, &Navigation::_solve_path_query, &batch);
+	} else {
+		for (int i = 0; i < count; i++) {
+			_solve_path_query(i, &batch);
+		}
+	}
+
+	Array ret;
+	ret.resize(count);
+	for (int i = 0; i < count; i++) {
+		ret[i] = paths[i];
+	}
+
+	return ret;
+}
+
 Vector3 Navigation::get_closest_point_to_segment(const Vector3 &p_from, const Vector3 &p_to, const bool &p_use_collision) {
 
 	bool use_collision = p_use_collision;
@@ -716,6 +783,7 @@ void Navigation::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("navmesh_remove", "id"), &Navigation::navmesh_remove);
 
 	ClassDB::bind_method(D_METHOD("get_simple_path", "start", "end", "optimize"), &Navigation::get_simple_path, DEFVAL(true));
+	ClassDB::bind_method(D_METHOD("get_simple_paths", "starts", "ends", "optimize"), &Navigation::get_simple_paths, DEFVAL(true));
 	ClassDB::bind_method(D_METHOD("get_closest_point_to_segment", "start", "end", "use_collision"), &Navigation::get_closest_point_to_segment, DEFVAL(false));
 	ClassDB::bind_method(D_METHOD("get_closest_point", "to_point"), &Navigation::get_closest_point);
 	ClassDB::bind_method(D_METHOD("get_closest_point_normal", "to_point"), &Navigation::get_closest_point_normal);
@@ -732,5 +800,6 @@ Navigation::Navigation() {
 	ERR_FAIL_COND(sizeof(Point) != 8);
 	cell_size = 0.01; //one centimeter
 	last_id = 1;
+	polygon_count = 0;
 	up = Vector3(0, 1, 0);
 }
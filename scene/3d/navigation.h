@@ -31,6 +31,8 @@
 #ifndef NAVIGATION_H
 #define NAVIGATION_H
 
+#include "core/hash_map.h"
+#include "core/os/thread_work_pool.h"
 #include "scene/3d/navigation_mesh.h"
 #include "scene/3d/spatial.h"
 
@@ -59,6 +61,10 @@ class Navigation : public Spatial {
 			return (a.key == p_key.a.key) ? (b.key < p_key.b.key) : (a.key < p_key.a.key);
 		};
 
+		bool operator==(const EdgeKey &p_key) const {
+			return a.key == p_key.a.key && b.key == p_key.b.key;
+		}
+
 		EdgeKey(const Point &p_a = Point(), const Point &p_b = Point()) :
 				a(p_a),
 				b(p_b) {
@@ -68,6 +74,10 @@ class Navigation : public Spatial {
 		}
 	};
 
+	struct EdgeKeyHasher {
+		static _FORCE_INLINE_ uint32_t hash(const EdgeKey &p_key) { return hash_djb2_one_32(hash_one_uint64(p_key.b.key), hash_one_uint64(p_key.a.key)); }
+	};
+
 	struct NavMesh;
 	struct Polygon;
 
@@ -94,15 +104,20 @@ class Navigation : public Spatial {
 		Vector<Edge> edges;
 
 		Vector3 center;
-		Vector3 entry;
-
-		float distance;
-		int prev_edge;
+		int id; //index into the search data of path queries
 		bool clockwise;
 
 		NavMesh *owner;
 	};
 
+	// per query state, kept apart from the polygons so path queries can run concurrently
+	struct PolygonSearch {
+
+		Vector3 entry;
+		float distance;
+		int prev_edge;
+	};
+
 	struct Connection {
 
 		Polygon *A;
@@ -120,7 +135,7 @@ class Navigation : public Spatial {
 		}
 	};
 
-	Map<EdgeKey, Connection> connections;
+	HashMap<EdgeKey, Connection, EdgeKeyHasher> connections;
 
 	struct NavMesh {
 
@@ -152,13 +167,27 @@ class Navigation : public Spatial {
 
 	void _navmesh_link(int p_id);
 	void _navmesh_unlink(int p_id);
+	void _update_polygon_ids();
+
+	struct PathQueryBatch {
+
+		const Vector3 *starts;
+		const Vector3 *ends;
+		Vector<Vector3> *paths;
+		bool optimize;
+	};
+
+	ThreadWorkPool path_query_pool;
+	void _solve_path_query(uint32_t p_index, PathQueryBatch *p_batch);
+
+	int polygon_count;
 
 	float cell_size;
 	Map<int, NavMesh> navmesh_map;
 	int last_id;
 
 	Vector3 up;
-	void _clip_path(Vector<Vector3> &path, Polygon *from_poly, const Vector3 &p_to_point, Polygon *p_to_poly);
+	void _clip_path(Vector<Vector3> &path, Polygon *from_poly, const Vector3 &p_to_point, Polygon *p_to_poly, const PolygonSearch *p_search);
 
 protected:
 	static void _bind_methods();
@@ -173,6 +202,7 @@ public:
 	void navmesh_remove(int p_id);
 
 	Vector<Vector3> get_simple_path(const Vector3 &p_start, const Vector3 &p_end, bool p_optimize = true);
+	Array get_simple_paths(const PoolVector3Array &p_starts, const PoolVector3Array &p_ends, bool p_optimize = true);
 	Vector3 get_closest_point_to_segment(const Vector3 &p_from, const Vector3 &p_to, const bool &p_use_collision = false);
 	Vector3 get_closest_point(const Vector3 &p_point);
 	Vector3 get_closest_point_normal(const Vector3 &p_point);
@@ -30,10 +30,13 @@
 
 #include "skeleton.h"
 
+#include "core/math/math_batch.h"
 #include "core/message_queue.h"
+#include "core/os/threaded_array_processor.h"
 
 #include "core/project_settings.h"
 #include "scene/3d/physics_body.h"
+#include "scene/resources/animation.h"
 #include "scene/resources/surface_tool.h"
 
 bool Skeleton::_set(const StringName &p_path, const Variant &p_value) {
@@ -109,7 +112,7 @@ bool Skeleton::_get(const StringName &p_path, Variant &r_ret) const {
 	else if (what == "bound_children") {
 		Array children;
 
-		for (const List<uint32_t>::Element *E = bones[which].nodes_bound.front(); E; E = E->next()) {
+		for (const List<ObjectID>::Element *E = bones[which].nodes_bound.front(); E; E = E->next()) {
 
 			Object *obj = ObjectDB::get_instance(E->get());
 			ERR_CONTINUE(!obj);
@@ -196,130 +199,226 @@ void Skeleton::_notification(int p_what) {
 
 	switch (p_what) {
 
-		case NOTIFICATION_ENTER_WORLD: {
-
-			VS::get_singleton()->skeleton_set_world_transform(skeleton, use_bones_in_world_transform, get_global_transform());
+		case NOTIFICATION_ENTER_WORLD:
+		case NOTIFICATION_TRANSFORM_CHANGED: {
 
+			if (!VS::get_singleton()->is_null_mode()) {
+				VS::get_singleton()->skeleton_set_world_transform(skeleton, use_bones_in_world_transform, get_global_transform());
+			}
 		} break;
 		case NOTIFICATION_EXIT_WORLD: {
 
 		} break;
-		case NOTIFICATION_TRANSFORM_CHANGED: {
+		case NOTIFICATION_UPDATE_SKELETON: {
 
-			VS::get_singleton()->skeleton_set_world_transform(skeleton, use_bones_in_world_transform, get_global_transform());
+			// The first notification of a frame evaluates every dirty skeleton at once,
+			// the ones queued after it find nothing left to do.
+			if (dirty_list.in_list()) {
+				_update_dirty_skeletons();
+			}
 		} break;
-		case NOTIFICATION_UPDATE_SKELETON: {
+	}
+}
+
+void Skeleton::_update_pose() {
+
+	Bone *bonesptr = bones.ptrw();
+	int len = bones.size();
+
+	_update_process_order();
+
+	const int *order = process_order.ptr();
+
+	// pose changed, rebuild cache of inverses
+	if (rest_global_inverse_dirty) {
 
-			VisualServer *vs = VisualServer::get_singleton();
-			Bone *bonesptr = bones.ptrw();
-			int len = bones.size();
+		// calculate global rests and invert them
+		for (int i = 0; i < len; i++) {
+			Bone &b = bonesptr[order[i]];
+			if (b.parent >= 0)
+				b.rest_global_inverse = bonesptr[b.parent].rest_global_inverse * b.rest;
+			else
+				b.rest_global_inverse = b.rest;
+		}
+		for (int i = 0; i < len; i++) {
+			Bone &b = bonesptr[order[i]];
+			b.rest_global_inverse.affine_invert();
+		}
 
-			vs->skeleton_allocate(skeleton, len); // if same size, nothing really happens
+		rest_global_inverse_dirty = false;
+	}
 
-			_update_process_order();
+	pose_global_batch.resize(len);
+	rest_global_inverse_batch.resize(len);
+	transform_final_batch.resize(len);
+	Transform *pose_globals = pose_global_batch.ptrw();
+	Transform *rest_global_inverses = rest_global_inverse_batch.ptrw();
+	Transform *finals = transform_final_batch.ptrw();
 
-			const int *order = process_order.ptr();
+	for (int i = 0; i < len; i++) {
+
+		Bone &b = bonesptr[order[i]];
 
-			// pose changed, rebuild cache of inverses
-			if (rest_global_inverse_dirty) {
+		if (b.disable_rest) {
+			if (b.enabled) {
 
-				// calculate global rests and invert them
-				for (int i = 0; i < len; i++) {
-					Bone &b = bonesptr[order[i]];
-					if (b.parent >= 0)
-						b.rest_global_inverse = bonesptr[b.parent].rest_global_inverse * b.rest;
-					else
-						b.rest_global_inverse = b.rest;
+				Transform pose = b.pose;
+				if (b.custom_pose_enable) {
+
+					pose = b.custom_pose * pose;
 				}
-				for (int i = 0; i < len; i++) {
-					Bone &b = bonesptr[order[i]];
-					b.rest_global_inverse.affine_invert();
+
+				if (b.parent >= 0) {
+
+					b.pose_global = bonesptr[b.parent].pose_global * pose;
+				} else {
+
+					b.pose_global = pose;
 				}
+			} else {
+
+				if (b.parent >= 0) {
 
-				rest_global_inverse_dirty = false;
+					b.pose_global = bonesptr[b.parent].pose_global;
+				} else {
+
+					b.pose_global = Transform();
+				}
 			}
 
-			for (int i = 0; i < len; i++) {
+		} else {
+			if (b.enabled) {
+
+				Transform pose = b.pose;
+				if (b.custom_pose_enable) {
 
-				Bone &b = bonesptr[order[i]];
+					pose = b.custom_pose * pose;
+				}
 
-				if (b.disable_rest) {
-					if (b.enabled) {
+				if (b.parent >= 0) {
 
-						Transform pose = b.pose;
-						if (b.custom_pose_enable) {
+					b.pose_global = bonesptr[b.parent].pose_global * (b.rest * pose);
+				} else {
 
-							pose = b.custom_pose * pose;
-						}
+					b.pose_global = b.rest * pose;
+				}
+			} else {
 
-						if (b.parent >= 0) {
+				if (b.parent >= 0) {
 
-							b.pose_global = bonesptr[b.parent].pose_global * pose;
-						} else {
+					b.pose_global = bonesptr[b.parent].pose_global * b.rest;
+				} else {
 
-							b.pose_global = pose;
-						}
-					} else {
+					b.pose_global = b.rest;
+				}
+			}
+		}
 
-						if (b.parent >= 0) {
+		pose_globals[order[i]] = b.pose_global;
+		rest_global_inverses[order[i]] = b.rest_global_inverse;
+	}
 
-							b.pose_global = bonesptr[b.parent].pose_global;
-						} else {
+	// The chain above is sequential, the final skinning transforms are independent.
+	MathBatch::multiply_transforms(pose_globals, rest_global_inverses, finals, len);
 
-							b.pose_global = Transform();
-						}
-					}
+	bone_transforms.resize(len * 12);
+	PoolVector<float>::Write w = bone_transforms.write();
+	float *dst = w.ptr();
 
-				} else {
-					if (b.enabled) {
+	for (int i = 0; i < len; i++) {
 
-						Transform pose = b.pose;
-						if (b.custom_pose_enable) {
+		const Transform &t = finals[i];
+		bonesptr[i].transform_final = t;
 
-							pose = b.custom_pose * pose;
-						}
+		// three rows per bone, as expected by skeleton_set_bone_transforms()
+		for (int j = 0; j < 3; j++) {
+			dst[i * 12 + j * 4 + 0] = t.basis[j][0];
+			dst[i * 12 + j * 4 + 1] = t.basis[j][1];
+			dst[i * 12 + j * 4 + 2] = t.basis[j][2];
+			dst[i * 12 + j * 4 + 3] = t.origin[j];
+		}
+	}
+}
 
-						if (b.parent >= 0) {
+void Skeleton::_update_pose_thread(uint32_t p_index, Skeleton **p_skeletons) {
 
-							b.pose_global = bonesptr[b.parent].pose_global * (b.rest * pose);
-						} else {
+	p_skeletons[p_index]->_update_pose();
+}
 
-							b.pose_global = b.rest * pose;
-						}
-					} else {
+void Skeleton::_commit_pose() {
 
-						if (b.parent >= 0) {
+	VisualServer *vs = VisualServer::get_singleton();
 
-							b.pose_global = bonesptr[b.parent].pose_global * b.rest;
-						} else {
+	// Global poses still drive bone attachments, only the upload to the server is skipped.
+	if (!vs->is_null_mode()) {
+		vs->skeleton_allocate(skeleton, bones.size()); // if same size, nothing really happens
+		vs->skeleton_set_bone_transforms(skeleton, bone_transforms);
+	}
 
-							b.pose_global = b.rest;
-						}
-					}
-				}
+	const Bone *bonesptr = bones.ptr();
+	int len = bones.size();
 
-				b.transform_final = b.pose_global * b.rest_global_inverse;
-				vs->skeleton_bone_set_transform(skeleton, order[i], b.transform_final);
+	for (int i = 0; i < len; i++) {
 
-				for (List<uint32_t>::Element *E = b.nodes_bound.front(); E; E = E->next()) {
+		const Bone &b = bonesptr[i];
 
-					Object *obj = ObjectDB::get_instance(E->get());
-					ERR_CONTINUE(!obj);
-					Spatial *sp = Object::cast_to<Spatial>(obj);
-					ERR_CONTINUE(!sp);
-					sp->set_transform(b.pose_global);
-				}
-			}
+		for (const List<ObjectID>::Element *E = b.nodes_bound.front(); E; E = E->next()) {
 
-			dirty = false;
-		} break;
+			Object *obj = ObjectDB::get_instance(E->get());
+			ERR_CONTINUE(!obj);
+			Spatial *sp = Object::cast_to<Spatial>(obj);
+			ERR_CONTINUE(!sp);
+			sp->set_transform(b.pose_global);
+		}
+	}
+}
+
+void Skeleton::_update_skeleton() {
+
+	if (dirty_list.in_list()) {
+		dirty_skeletons.remove(&dirty_list);
+	}
+
+	_update_pose();
+	dirty = false;
+	_commit_pose();
+}
+
+void Skeleton::_update_dirty_skeletons() {
+
+	Vector<Skeleton *> skeletons;
+	while (dirty_skeletons.first()) {
+		SelfList<Skeleton> *E = dirty_skeletons.first();
+		skeletons.push_back(E->self());
+		dirty_skeletons.remove(E);
+	}
+
+	if (skeletons.size() == 0) {
+		return;
+	}
+
+	// Poses only touch their own skeleton, so they are evaluated on the worker threads.
+	// Uploading and moving bone attachments stays on this thread.
+	if (skeletons.size() == 1) {
+		skeletons[0]->_update_pose();
+	} else {
+		thread_process_array(skeletons.size(), skeletons[0], &Skeleton::_update_pose_thread, skeletons.ptrw());
+	}
+
+	// Clear the flags first, so a skeleton dirtied by an attachment below gets queued again.
+	for (int i = 0; i < skeletons.size(); i++) {
+		skeletons[i]->dirty = false;
+	}
+
+	for (int i = 0; i < skeletons.size(); i++) {
+		skeletons[i]->_commit_pose();
 	}
 }
 
 Transform Skeleton::get_bone_transform(int p_bone) const {
 	ERR_FAIL_INDEX_V(p_bone, bones.size(), Transform());
 	if (dirty)
-		const_cast<Skeleton *>(this)->notification(NOTIFICATION_UPDATE_SKELETON);
+		const_cast<Skeleton *>(this)->_update_skeleton();
 	return bones[p_bone].pose_global * bones[p_bone].rest_global_inverse;
 }
 
@@ -339,7 +438,7 @@ Transform Skeleton::get_bone_global_pose(int p_bone) const {
 
 	ERR_FAIL_INDEX_V(p_bone, bones.size(), Transform());
 	if (dirty)
-		const_cast<Skeleton *>(this)->notification(NOTIFICATION_UPDATE_SKELETON);
+		const_cast<Skeleton *>(this)->_update_skeleton();
 	return bones[p_bone].pose_global;
 }
 
@@ -496,9 +595,9 @@ void Skeleton::bind_child_node_to_bone(int p_bone, Node *p_node) {
 	ERR_FAIL_NULL(p_node);
 	ERR_FAIL_INDEX(p_bone, bones.size());
 
-	uint32_t id = p_node->get_instance_id();
+	ObjectID id = p_node->get_instance_id();
 
-	for (const List<uint32_t>::Element *E = bones[p_bone].nodes_bound.front(); E; E = E->next()) {
+	for (const List<ObjectID>::Element *E = bones[p_bone].nodes_bound.front(); E; E = E->next()) {
 
 		if (E->get() == id)
 			return; // already here
@@ -511,14 +610,14 @@ void Skeleton::unbind_child_node_from_bone(int p_bone, Node *p_node) {
 	ERR_FAIL_NULL(p_node);
 	ERR_FAIL_INDEX(p_bone, bones.size());
 
-	uint32_t id = p_node->get_instance_id();
+	ObjectID id = p_node->get_instance_id();
 	bones.write[p_bone].nodes_bound.erase(id);
 }
 void Skeleton::get_bound_child_nodes_to_bone(int p_bone, List<Node *> *p_bound) const {
 
 	ERR_FAIL_INDEX(p_bone, bones.size());
 
-	for (const List<uint32_t>::Element *E = bones[p_bone].nodes_bound.front(); E; E = E->next()) {
+	for (const List<ObjectID>::Element *E = bones[p_bone].nodes_bound.front(); E; E = E->next()) {
 
 		Object *obj = ObjectDB::get_instance(E->get());
 		ERR_CONTINUE(!obj);
@@ -545,6 +644,21 @@ void Skeleton::set_bone_pose(int p_bone, const Transform &p_pose) {
 	bones.write[p_bone].pose = p_pose;
 	_make_dirty();
 }
+
+void Skeleton::set_bone_poses(const int *p_bones, const Transform *p_poses, int p_count) {
+
+	ERR_FAIL_COND(!is_inside_tree());
+
+	int bone_count = bones.size();
+	Bone *bonesptr = bones.ptrw();
+	for (int i = 0; i < p_count; i++) {
+
+		ERR_CONTINUE(p_bones[i] < 0 || p_bones[i] >= bone_count);
+		bonesptr[p_bones[i]].pose = p_poses[i];
+	}
+	_make_dirty();
+}
+
 Transform Skeleton::get_bone_pose(int p_bone) const {
 
 	ERR_FAIL_INDEX_V(p_bone, bones.size(), Transform());
@@ -574,6 +688,7 @@ void Skeleton::_make_dirty() {
 		return;
 
 	MessageQueue::get_singleton()->push_notification(this, NOTIFICATION_UPDATE_SKELETON);
+	dirty_skeletons.add_last(&dirty_list);
 	dirty = true;
 }
 
@@ -595,6 +710,125 @@ void Skeleton::localize_rests() {
 	}
 }
 
+Ref<Image> Skeleton::bake_animation_texture(const Array &p_animations, float p_fps) {
+
+	ERR_FAIL_COND_V(p_fps <= 0, Ref<Image>());
+	ERR_FAIL_COND_V(p_animations.empty(), Ref<Image>());
+
+	int len = bones.size();
+	ERR_FAIL_COND_V(len == 0, Ref<Image>());
+
+	_update_process_order();
+	const int *order = process_order.ptr();
+
+	Vector<Transform> rest_global_inverse;
+	rest_global_inverse.resize(len);
+	for (int i = 0; i < len; i++) {
+		const Bone &b = bones[order[i]];
+		rest_global_inverse.write[order[i]] = b.parent >= 0 ? rest_global_inverse[b.parent] * b.rest : b.rest;
+	}
+	for (int i = 0; i < len; i++) {
+		rest_global_inverse.write[i].affine_invert();
+	}
+
+	// every clip gets the same amount of rows, so a clip starts at clip_index * rows_per_clip
+	int rows_per_clip = 0;
+	Vector<Vector<int> > track_bones;
+	track_bones.resize(p_animations.size());
+
+	for (int i = 0; i < p_animations.size(); i++) {
+
+		Ref<Animation> anim = p_animations[i];
+		ERR_FAIL_COND_V(anim.is_null(), Ref<Image>());
+
+		rows_per_clip = MAX(rows_per_clip, int(Math::ceil(anim->get_length() * p_fps)) + 1);
+
+		Vector<int> &tb = track_bones.write[i];
+		tb.resize(anim->get_track_count());
+		for (int j = 0; j < anim->get_track_count(); j++) {
+			int bone = -1;
+			if (anim->track_get_type(j) == Animation::TYPE_TRANSFORM) {
+				bone = find_bone(anim->track_get_path(j).get_concatenated_subnames());
+			}
+			tb.write[j] = bone;
+		}
+	}
+
+	int width = len * 3;
+	int height = rows_per_clip * p_animations.size();
+
+	PoolVector<uint8_t> data;
+	data.resize(width * height * 4 * sizeof(float));
+	PoolVector<uint8_t>::Write w = data.write();
+	float *dst = (float *)w.ptr();
+
+	Vector<Transform> pose;
+	Vector<Transform> pose_global;
+	Vector<Transform> skin;
+	pose.resize(len);
+	pose_global.resize(len);
+	skin.resize(len);
+
+	for (int i = 0; i < p_animations.size(); i++) {
+
+		Ref<Animation> anim = p_animations[i];
+		const Vector<int> &tb = track_bones[i];
+
+		for (int f = 0; f < rows_per_clip; f++) {
+
+			float time = MIN(f / p_fps, anim->get_length());
+
+			for (int j = 0; j < len; j++) {
+				pose.write[j] = bones[j].pose;
+			}
+
+			for (int j = 0; j < tb.size(); j++) {
+				if (tb[j] < 0 || bones[tb[j]].ignore_animation) {
+					continue;
+				}
+
+				Vector3 loc;
+				Quat rot;
+				Vector3 scale;
+				if (anim->transform_track_interpolate(j, time, &loc, &rot, &scale) != OK) {
+					continue;
+				}
+
+				Transform &t = pose.write[tb[j]];
+				t.basis.set_quat_scale(rot, scale);
+				t.origin = loc;
+			}
+
+			for (int j = 0; j < len; j++) {
+				const Bone &b = bones[order[j]];
+				Transform local = b.disable_rest ? pose[order[j]] : b.rest * pose[order[j]];
+				pose_global.write[order[j]] = b.parent >= 0 ? pose_global[b.parent] * local : local;
+			}
+
+			MathBatch::multiply_transforms(pose_global.ptr(), rest_global_inverse.ptr(), skin.ptrw(), len);
+
+			// three texels per bone, holding the rows of the skinning matrix
+			float *row = &dst[((i * rows_per_clip + f) * width) * 4];
+			for (int j = 0; j < len; j++) {
+				const Transform &t = skin[j];
+				for (int k = 0; k < 3; k++) {
+					row[j * 12 + k * 4 + 0] = t.basis[k][0];
+					row[j * 12 + k * 4 + 1] = t.basis[k][1];
+					row[j * 12 + k * 4 + 2] = t.basis[k][2];
+					row[j * 12 + k * 4 + 3] = t.origin[k];
+				}
+			}
+		}
+	}
+
+	w = PoolVector<uint8_t>::Write();
+
+	Ref<Image> image;
+	image.instance();
+	image->create(width, height, false, Image::FORMAT_RGBAF, data);
+	return image;
+}
+
 #ifndef _3D_DISABLED
 
 void Skeleton::bind_physical_bone_to_bone(int p_bone, PhysicalBone *p_physical_bone) {
@@ -792,6 +1026,8 @@ void Skeleton::_bind_methods() {
 
 	ClassDB::bind_method(D_METHOD("get_bone_transform", "bone_idx"), &Skeleton::get_bone_transform);
 
+	ClassDB::bind_method(D_METHOD("bake_animation_texture", "animations", "fps"), &Skeleton::bake_animation_texture, DEFVAL(30.0));
+
 	ClassDB::bind_method(D_METHOD("set_use_bones_in_world_transform", "enable"), &Skeleton::set_use_bones_in_world_transform);
 	ClassDB::bind_method(D_METHOD("is_using_bones_in_world_transform"), &Skeleton::is_using_bones_in_world_transform);
 
@@ -810,7 +1046,10 @@ void Skeleton::_bind_methods() {
 	BIND_CONSTANT(NOTIFICATION_UPDATE_SKELETON);
 }
 
-Skeleton::Skeleton() {
+SelfList<Skeleton>::List Skeleton::dirty_skeletons;
+
+Skeleton::Skeleton() :
+		dirty_list(this) {
 
 	rest_global_inverse_dirty = true;
 	dirty = false;
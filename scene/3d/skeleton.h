@@ -32,6 +32,7 @@
 #define SKELETON_H
 
 #include "core/rid.h"
+#include "core/self_list.h"
 #include "scene/3d/spatial.h"
 
 /**
@@ -75,7 +76,7 @@ class Skeleton : public Spatial {
 		PhysicalBone *cache_parent_physical_bone;
 #endif // _3D_DISABLED
 
-		List<uint32_t> nodes_bound;
+		List<ObjectID> nodes_bound;
 
 		Bone() {
 			parent = -1;
@@ -98,6 +99,15 @@ class Skeleton : public Spatial {
 
 	RID skeleton;
 
+	// Scratch arrays for the batched pose evaluation, indexed by bone.
+	Vector<Transform> pose_global_batch;
+	Vector<Transform> rest_global_inverse_batch;
+	Vector<Transform> transform_final_batch;
+	PoolVector<float> bone_transforms;
+
+	SelfList<Skeleton> dirty_list;
+	static SelfList<Skeleton>::List dirty_skeletons;
+
 	void _make_dirty();
 	bool dirty;
 	bool use_bones_in_world_transform;
@@ -117,6 +127,11 @@ class Skeleton : public Spatial {
 	}
 
 	void _update_process_order();
+	void _update_pose();
+	void _update_pose_thread(uint32_t p_index, Skeleton **p_skeletons);
+	void _commit_pose();
+	void _update_skeleton();
+	static void _update_dirty_skeletons();
 
 protected:
 	bool _get(const StringName &p_path, Variant &r_ret) const;
@@ -173,6 +188,7 @@ public:
 
 	void set_bone_pose(int p_bone, const Transform &p_pose);
 	Transform get_bone_pose(int p_bone) const;
+	void set_bone_poses(const int *p_bones, const Transform *p_poses, int p_count); // for animation players, not bound
 
 	void set_bone_custom_pose(int p_bone, const Transform &p_custom_pose);
 	Transform get_bone_custom_pose(int p_bone) const;
@@ -180,6 +196,8 @@ public:
 	void localize_rests(); // used for loaders and tools
 	int get_process_order(int p_idx);
 
+	Ref<Image> bake_animation_texture(const Array &p_animations, float p_fps = 30.0);
+
 	void set_use_bones_in_world_transform(bool p_enable);
 	bool is_using_bones_in_world_transform() const;
 
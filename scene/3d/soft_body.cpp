@@ -473,7 +473,7 @@ void SoftBody::become_mesh_owner() {
 		Array surface_blend_arrays = mesh->surface_get_blend_shape_arrays(0);
 		uint32_t surface_format = mesh->surface_get_format(0);
 
-		surface_format &= ~(Mesh::ARRAY_COMPRESS_VERTEX | Mesh::ARRAY_COMPRESS_NORMAL);
+		surface_format &= ~(Mesh::ARRAY_COMPRESS_VERTEX | Mesh::ARRAY_COMPRESS_NORMAL | Mesh::ARRAY_FLAG_USE_QUANTIZED_VERTICES | Mesh::ARRAY_FLAG_USE_OCTAHEDRAL_NORMALS);
 		surface_format |= Mesh::ARRAY_FLAG_USE_DYNAMIC_UPDATE;
 
 		Ref<ArrayMesh> soft_mesh;
@@ -81,7 +81,7 @@ void Spatial::_notify_dirty() {
 	if (data.notify_transform && !data.ignore_notification && !xform_change.in_list()) {
 
 #endif
-		get_tree()->xform_change_list.add(&xform_change);
+		get_tree()->_add_xform_change(&xform_change);
 	}
 }
 
@@ -90,35 +90,69 @@ void Spatial::_update_local_transform() const {
 
 	data.dirty &= ~DIRTY_LOCAL;
 }
+void Spatial::_mark_global_dirty(SceneTree *p_tree) {
+
+#ifdef TOOLS_ENABLED
+	if ((data.gizmo.is_valid() || data.notify_transform) && !data.ignore_notification && !xform_change.in_list()) {
+#else
+	if (data.notify_transform && !data.ignore_notification && !xform_change.in_list()) {
+#endif
+		p_tree->_add_xform_change(&xform_change);
+	}
+	data.dirty |= DIRTY_GLOBAL;
+	data.xform_pass = p_tree->xform_change_pass;
+}
+
+Spatial *Spatial::_next_propagated(List<Spatial *>::Element *E) {
+
+	while (E && E->get()->data.toplevel_active) {
+		E = E->next(); //don't propagate to a toplevel
+	}
+	return E ? E->get() : NULL;
+}
+
 void Spatial::_propagate_transform_changed(Spatial *p_origin) {
 
 	if (!is_inside_tree()) {
 		return;
 	}
 
-	/*
-	if (data.dirty&DIRTY_GLOBAL)
-		return; //already dirty
-	*/
+	/* The subtree is walked depth first without recursion, climbing back through the parent links.
+	 * A node that is still dirty from a propagation since the last transform notification
+	 * flush already has its whole subtree dirty and queued, so only the node itself is revisited.
+	 * Nodes are marked after their children, so the queued notification order stays the same.
+	 */
 
-	data.children_lock++;
+	SceneTree *tree = get_tree();
+	Spatial *n = this;
 
-	for (List<Spatial *>::Element *E = data.children.front(); E; E = E->next()) {
+	while (true) {
 
-		if (E->get()->data.toplevel_active)
-			continue; //don't propagate to a toplevel
-		E->get()->_propagate_transform_changed(p_origin);
-	}
-#ifdef TOOLS_ENABLED
-	if ((data.gizmo.is_valid() || data.notify_transform) && !data.ignore_notification && !xform_change.in_list()) {
-#else
-	if (data.notify_transform && !data.ignore_notification && !xform_change.in_list()) {
-#endif
-		get_tree()->xform_change_list.add(&xform_change);
-	}
-	data.dirty |= DIRTY_GLOBAL;
+		Spatial *child = NULL;
+		if (!(n->data.dirty & DIRTY_GLOBAL) || n->data.xform_pass != tree->xform_change_pass) {
+			child = _next_propagated(n->data.children.front());
+		}
+
+		if (child) {
+			n = child;
+			continue;
+		}
+
+		while (true) {
 
-	data.children_lock--;
+			n->_mark_global_dirty(tree);
+			if (n == this) {
+				return;
+			}
+
+			Spatial *sibling = _next_propagated(n->data.C->next());
+			if (sibling) {
+				n = sibling;
+				break;
+			}
+			n = n->data.parent;
+		}
+	}
 }
 
 void Spatial::_notification(int p_what) {
@@ -261,30 +295,50 @@ Transform Spatial::get_transform() const {
 
 	return data.local_transform;
 }
-Transform Spatial::get_global_transform() const {
+void Spatial::_update_global_transform() const {
 
-	ERR_FAIL_COND_V(!is_inside_tree(), Transform());
+	if (data.dirty & DIRTY_LOCAL) {
 
-	if (data.dirty & DIRTY_GLOBAL) {
+		_update_local_transform();
+	}
 
-		if (data.dirty & DIRTY_LOCAL) {
+	if (data.parent && !data.toplevel_active) {
 
-			_update_local_transform();
-		}
+		data.global_transform = data.parent->get_global_transform() * data.local_transform;
+	} else {
 
-		if (data.parent && !data.toplevel_active) {
+		data.global_transform = data.local_transform;
+	}
 
-			data.global_transform = data.parent->get_global_transform() * data.local_transform;
-		} else {
+	if (data.disable_scale) {
+		data.global_transform.basis.orthonormalize();
+	}
 
-			data.global_transform = data.local_transform;
-		}
+	data.dirty &= ~DIRTY_GLOBAL;
+}
+
+Transform Spatial::get_global_transform() const {
+
+	ERR_FAIL_COND_V(!is_inside_tree(), Transform());
 
-		if (data.disable_scale) {
-			data.global_transform.basis.orthonormalize();
+	if (data.dirty & DIRTY_GLOBAL) {
+
+		// Resolve the dirty ancestors top-down instead of recursing once per level.
+		const Spatial *chain[GLOBAL_XFORM_CHAIN_MAX];
+		int depth = 0;
+
+		const Spatial *s = this;
+		while (true) {
+			chain[depth++] = s;
+			if (depth == GLOBAL_XFORM_CHAIN_MAX || !s->data.parent || s->data.toplevel_active || !(s->data.parent->data.dirty & DIRTY_GLOBAL)) {
+				break;
+			}
+			s = s->data.parent;
 		}
 
-		data.dirty &= ~DIRTY_GLOBAL;
+		for (int i = depth - 1; i >= 0; i--) {
+			chain[i]->_update_global_transform();
+		}
 	}
 
 	return data.global_transform;
@@ -710,6 +764,9 @@ Vector3 Spatial::to_global(Vector3 p_local) const {
 
 void Spatial::set_notify_transform(bool p_enable) {
 	data.notify_transform = p_enable;
+	if (p_enable && is_inside_tree()) {
+		get_tree()->xform_change_pass++; //ancestors may skip this node's subtree otherwise
+	}
 }
 
 bool Spatial::is_transform_notification_enabled() const {
@@ -730,6 +787,7 @@ void Spatial::force_update_transform() {
 		return; //nothing to update
 	}
 	get_tree()->xform_change_list.remove(&xform_change);
+	get_tree()->xform_change_pass++;
 
 	notification(NOTIFICATION_TRANSFORM_CHANGED);
 }
@@ -821,7 +879,7 @@ Spatial::Spatial() :
 		xform_change(this) {
 
 	data.dirty = DIRTY_NONE;
-	data.children_lock = 0;
+	data.xform_pass = 0;
 
 	data.ignore_notification = false;
 	data.toplevel = false;
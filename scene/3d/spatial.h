@@ -65,6 +65,10 @@ class Spatial : public Node {
 		DIRTY_GLOBAL = 4
 	};
 
+	enum {
+		GLOBAL_XFORM_CHAIN_MAX = 32
+	};
+
 	mutable SelfList<Node> xform_change;
 
 	struct Data {
@@ -82,7 +86,7 @@ class Spatial : public Node {
 		bool toplevel;
 		bool inside_world;
 
-		int children_lock;
+		uint32_t xform_pass; // SceneTree::xform_change_pass of the last propagation through this node
 		Spatial *parent;
 		List<Spatial *> children;
 		List<Spatial *>::Element *C;
@@ -105,6 +109,9 @@ class Spatial : public Node {
 	void _update_gizmo();
 	void _notify_dirty();
 	void _propagate_transform_changed(Spatial *p_origin);
+	static _FORCE_INLINE_ Spatial *_next_propagated(List<Spatial *>::Element *E);
+	void _mark_global_dirty(SceneTree *p_tree);
+	void _update_global_transform() const;
 
 	void _propagate_visibility_changed();
 
@@ -45,6 +45,8 @@ void VisualInstance::_update_visibility() {
 		return;
 
 	_change_notify("visible");
+	if (VS::get_singleton()->is_null_mode())
+		return;
 	VS::get_singleton()->instance_set_visible(get_instance(), is_visible_in_tree());
 }
 
@@ -54,6 +56,11 @@ void VisualInstance::_notification(int p_what) {
 
 		case NOTIFICATION_ENTER_WORLD: {
 
+			if (VS::get_singleton()->is_null_mode()) {
+				// Never placed in a scenario, so the server has nothing to cull or pair.
+				break;
+			}
+
 			// CHECK SKELETON => moving skeleton attaching logic to MeshInstance
 			/*
 			Skeleton *skeleton=Object::cast_to<Skeleton>(get_parent());
@@ -67,11 +74,22 @@ void VisualInstance::_notification(int p_what) {
 		} break;
 		case NOTIFICATION_TRANSFORM_CHANGED: {
 
-			Transform gt = get_global_transform();
-			VisualServer::get_singleton()->instance_set_transform(instance, gt);
+			// Sent to the server together with all other moved instances when the tree flushes transforms.
+			if (!xform_batch.in_list()) {
+				get_tree()->visual_xform_list.add_last(&xform_batch);
+			}
 		} break;
 		case NOTIFICATION_EXIT_WORLD: {
 
+			if (VS::get_singleton()->is_null_mode()) {
+				break;
+			}
+
+			if (xform_batch.in_list()) {
+				get_tree()->visual_xform_list.remove(&xform_batch);
+				VisualServer::get_singleton()->instance_set_transform(instance, get_global_transform());
+			}
+
 			VisualServer::get_singleton()->instance_set_scenario(instance, RID());
 			VisualServer::get_singleton()->instance_attach_skeleton(instance, RID());
 			//VS::get_singleton()->instance_geometry_set_baked_light_sampler(instance, RID() );
@@ -138,12 +156,14 @@ void VisualInstance::set_base(const RID &p_base) {
 	VisualServer::get_singleton()->instance_set_base(instance, p_base);
 }
 
-VisualInstance::VisualInstance() {
+VisualInstance::VisualInstance() :
+		xform_batch(this) {
 
 	instance = VisualServer::get_singleton()->instance_create();
 	VisualServer::get_singleton()->instance_attach_object_instance_id(instance, get_instance_id());
 	layers = 1;
-	set_notify_transform(true);
+	// Nobody renders in null mode, so moving nodes need not report their transforms here.
+	set_notify_transform(!VS::get_singleton()->is_null_mode());
 }
 
 VisualInstance::~VisualInstance() {
@@ -296,6 +316,7 @@ void GeometryInstance::_bind_methods() {
 	ADD_PROPERTY(PropertyInfo(Variant::INT, "cast_shadow", PROPERTY_HINT_ENUM, "Off,On,Double-Sided,Shadows Only"), "set_cast_shadows_setting", "get_cast_shadows_setting");
 	ADD_PROPERTY(PropertyInfo(Variant::REAL, "extra_cull_margin", PROPERTY_HINT_RANGE, "0,16384,0.01"), "set_extra_cull_margin", "get_extra_cull_margin");
 	ADD_PROPERTYI(PropertyInfo(Variant::BOOL, "use_in_baked_light"), "set_flag", "get_flag", FLAG_USE_BAKED_LIGHT);
+	ADD_PROPERTYI(PropertyInfo(Variant::BOOL, "use_as_occluder"), "set_flag", "get_flag", FLAG_OCCLUDER);
 
 	ADD_GROUP("LOD", "lod_");
 	ADD_PROPERTY(PropertyInfo(Variant::INT, "lod_min_distance", PROPERTY_HINT_RANGE, "0,32768,0.01"), "set_lod_min_distance", "get_lod_min_distance");
@@ -311,6 +332,7 @@ void GeometryInstance::_bind_methods() {
 	BIND_ENUM_CONSTANT(SHADOW_CASTING_SETTING_SHADOWS_ONLY);
 
 	BIND_ENUM_CONSTANT(FLAG_USE_BAKED_LIGHT);
+	BIND_ENUM_CONSTANT(FLAG_OCCLUDER);
 	BIND_ENUM_CONSTANT(FLAG_MAX);
 }
 
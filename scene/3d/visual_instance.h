@@ -46,6 +46,8 @@ class VisualInstance : public Spatial {
 	RID instance;
 	uint32_t layers;
 
+	SelfList<VisualInstance> xform_batch;
+
 	RID _get_visual_instance_rid() const;
 
 protected:
@@ -87,6 +89,7 @@ class GeometryInstance : public VisualInstance {
 public:
 	enum Flags {
 		FLAG_USE_BAKED_LIGHT = VS::INSTANCE_FLAG_USE_BAKED_LIGHT,
+		FLAG_OCCLUDER = VS::INSTANCE_FLAG_OCCLUDER,
 		FLAG_MAX = VS::INSTANCE_FLAG_MAX,
 	};
 
@@ -30,7 +30,6 @@
 
 #include "voxel_light_baker.h"
 #include "core/os/os.h"
-#include "core/os/threaded_array_processor.h"
 
 #include <stdlib.h>
 
@@ -732,12 +731,17 @@ void VoxelLightBaker::_check_init_light() {
 
 		direct_lights_baked = false;
 		leaf_voxel_count = 0;
-		_fixup_plot(0, 0); //pre fixup, so normal, albedo, emission, etc. work for lighting.
+		_fixup_octree(); //pre fixup, so normal, albedo, emission, etc. work for lighting.
 		bake_light.resize(bake_cells.size());
 		print_line("bake light size: " + itos(bake_light.size()));
 		//zeromem(bake_light.ptrw(), bake_light.size() * sizeof(Light));
 		first_leaf = -1;
 		_init_light_plot(0, 0, 0, 0, 0, CHILD_EMPTY);
+
+		leaf_cells.clear();
+		for (int idx = first_leaf; idx >= 0; idx = bake_light[idx].next_leaf) {
+			leaf_cells.push_back(idx);
+		}
 	}
 }
 
@@ -817,476 +821,464 @@ uint32_t VoxelLightBaker::_find_cell_at_pos(const Cell *cells, int x, int y, int
 
 	return cell;
 }
-void VoxelLightBaker::plot_light_directional(const Vector3 &p_direction, const Color &p_color, float p_energy, float p_indirect_energy, bool p_direct) {
-
-	_check_init_light();
-
-	float max_len = Vector3(axis_cell_size[0], axis_cell_size[1], axis_cell_size[2]).length() * 1.1;
-
-	if (p_direct)
-		direct_lights_baked = true;
+void VoxelLightBaker::_add_light_to_leaf(int p_idx, const Vector3 &p_light_axis, const Vector3 &p_energy, bool p_direct) {
 
-	Vector3 light_axis = p_direction;
-	Plane clip[3];
-	int clip_planes = 0;
+	const Cell *cell = &bake_cells.ptr()[p_idx];
+	Light *light = &bake_light.ptrw()[p_idx];
 
-	Light *light_data = bake_light.ptrw();
-	const Cell *cells = bake_cells.ptr();
-
-	for (int i = 0; i < 3; i++) {
-
-		if (ABS(light_axis[i]) < CMP_EPSILON)
-			continue;
-		clip[clip_planes].normal[i] = 1.0;
+	Vector3 normal(cell->normal[0], cell->normal[1], cell->normal[2]);
+	if (normal == Vector3()) {
+		for (int i = 0; i < 6; i++) {
+			light->accum[i][0] += p_energy.x * cell->albedo[0];
+			light->accum[i][1] += p_energy.y * cell->albedo[1];
+			light->accum[i][2] += p_energy.z * cell->albedo[2];
+		}
 
-		if (light_axis[i] < 0) {
+	} else {
 
-			clip[clip_planes].d = axis_cell_size[i] + 1;
-		} else {
-			clip[clip_planes].d -= 1.0;
+		for (int i = 0; i < 6; i++) {
+			float s = MAX(0.0, aniso_normal[i].dot(-normal));
+			light->accum[i][0] += p_energy.x * cell->albedo[0] * s;
+			light->accum[i][1] += p_energy.y * cell->albedo[1] * s;
+			light->accum[i][2] += p_energy.z * cell->albedo[2] * s;
 		}
-
-		clip_planes++;
 	}
 
-	float distance_adv = _get_normal_advance(light_axis);
-
-	int success_count = 0;
-
-	Vector3 light_energy = Vector3(p_color.r, p_color.g, p_color.b) * p_energy * p_indirect_energy;
-
-	int idx = first_leaf;
-	while (idx >= 0) {
-
-		Light *light = &light_data[idx];
-
-		Vector3 to(light->x + 0.5, light->y + 0.5, light->z + 0.5);
-		to += -light_axis.sign() * 0.47; //make it more likely to receive a ray
-
-		Vector3 from = to - max_len * light_axis;
-
-		for (int j = 0; j < clip_planes; j++) {
-
-			clip[j].intersects_segment(from, to, &from);
+	if (p_direct) {
+		for (int i = 0; i < 6; i++) {
+			float s = MAX(0.0, aniso_normal[i].dot(-p_light_axis)); //light depending on normal for direct
+			light->direct_accum[i][0] += p_energy.x * s;
+			light->direct_accum[i][1] += p_energy.y * s;
+			light->direct_accum[i][2] += p_energy.z * s;
 		}
+	}
+}
 
-		float distance = (to - from).length();
-		distance += distance_adv - Math::fmod(distance, distance_adv); //make it reach the center of the box always
-		from = to - light_axis * distance;
+void VoxelLightBaker::_plot_light_directional_job(uint32_t p_leaf, LightPlot *p_light) {
 
-		uint32_t result = 0xFFFFFFFF;
+	int idx = leaf_cells[p_leaf];
+	const Light *light = &bake_light[idx];
+	const Cell *cells = bake_cells.ptr();
+	const Vector3 &light_axis = p_light->axis;
+	float distance_adv = p_light->distance_adv;
 
-		while (distance > -distance_adv) { //use this to avoid precision errors
+	Vector3 to(light->x + 0.5, light->y + 0.5, light->z + 0.5);
+	to += -light_axis.sign() * 0.47; //make it more likely to receive a ray
 
-			result = _find_cell_at_pos(cells, int(floor(from.x)), int(floor(from.y)), int(floor(from.z)));
-			if (result != 0xFFFFFFFF) {
-				break;
-			}
+	Vector3 from = to - p_light->max_len * light_axis;
 
-			from += light_axis * distance_adv;
-			distance -= distance_adv;
-		}
+	for (int j = 0; j < p_light->clip_planes; j++) {
 
-		if (result == (uint32_t)idx) {
-			//cell hit itself! hooray!
+		p_light->clip[j].intersects_segment(from, to, &from);
+	}
 
-			Vector3 normal(cells[idx].normal[0], cells[idx].normal[1], cells[idx].normal[2]);
-			if (normal == Vector3()) {
-				for (int i = 0; i < 6; i++) {
-					light->accum[i][0] += light_energy.x * cells[idx].albedo[0];
-					light->accum[i][1] += light_energy.y * cells[idx].albedo[1];
-					light->accum[i][2] += light_energy.z * cells[idx].albedo[2];
-				}
+	float distance = (to - from).length();
+	distance += distance_adv - Math::fmod(distance, distance_adv); //make it reach the center of the box always
+	from = to - light_axis * distance;
 
-			} else {
+	uint32_t result = 0xFFFFFFFF;
 
-				for (int i = 0; i < 6; i++) {
-					float s = MAX(0.0, aniso_normal[i].dot(-normal));
-					light->accum[i][0] += light_energy.x * cells[idx].albedo[0] * s;
-					light->accum[i][1] += light_energy.y * cells[idx].albedo[1] * s;
-					light->accum[i][2] += light_energy.z * cells[idx].albedo[2] * s;
-				}
-			}
+	while (distance > -distance_adv) { //use this to avoid precision errors
 
-			if (p_direct) {
-				for (int i = 0; i < 6; i++) {
-					float s = MAX(0.0, aniso_normal[i].dot(-light_axis)); //light depending on normal for direct
-					light->direct_accum[i][0] += light_energy.x * s;
-					light->direct_accum[i][1] += light_energy.y * s;
-					light->direct_accum[i][2] += light_energy.z * s;
-				}
-			}
-			success_count++;
+		result = _find_cell_at_pos(cells, int(floor(from.x)), int(floor(from.y)), int(floor(from.z)));
+		if (result != 0xFFFFFFFF) {
+			break;
 		}
 
-		idx = light_data[idx].next_leaf;
+		from += light_axis * distance_adv;
+		distance -= distance_adv;
+	}
+
+	if (result == (uint32_t)idx) {
+		//cell hit itself! hooray!
+		_add_light_to_leaf(idx, light_axis, p_light->energy, p_light->direct);
 	}
 }
 
-void VoxelLightBaker::plot_light_omni(const Vector3 &p_pos, const Color &p_color, float p_energy, float p_indirect_energy, float p_radius, float p_attenutation, bool p_direct) {
+void VoxelLightBaker::plot_light_directional(const Vector3 &p_direction, const Color &p_color, float p_energy, float p_indirect_energy, bool p_direct) {
 
 	_check_init_light();
 
 	if (p_direct)
 		direct_lights_baked = true;
 
-	Plane clip[3];
-	int clip_planes = 0;
+	LightPlot light;
+	light.axis = p_direction;
+	light.max_len = Vector3(axis_cell_size[0], axis_cell_size[1], axis_cell_size[2]).length() * 1.1;
+	light.clip_planes = 0;
 
-	// uint64_t us = OS::get_singleton()->get_ticks_usec();
+	for (int i = 0; i < 3; i++) {
 
-	Vector3 light_pos = to_cell_space.xform(p_pos) + Vector3(0.5, 0.5, 0.5);
-	//Vector3 spot_axis = -light_cache.transform.basis.get_axis(2).normalized();
+		if (ABS(light.axis[i]) < CMP_EPSILON)
+			continue;
+		light.clip[light.clip_planes].normal[i] = 1.0;
 
-	float local_radius = to_cell_space.basis.xform(Vector3(0, 0, 1)).length() * p_radius;
+		if (light.axis[i] < 0) {
 
-	Light *light_data = bake_light.ptrw();
-	const Cell *cells = bake_cells.ptr();
-	Vector3 light_energy = Vector3(p_color.r, p_color.g, p_color.b) * p_energy * p_indirect_energy;
+			light.clip[light.clip_planes].d = axis_cell_size[i] + 1;
+		} else {
+			light.clip[light.clip_planes].d -= 1.0;
+		}
 
-	int idx = first_leaf;
-	while (idx >= 0) {
+		light.clip_planes++;
+	}
 
-		Light *light = &light_data[idx];
+	light.distance_adv = _get_normal_advance(light.axis);
+	light.energy = Vector3(p_color.r, p_color.g, p_color.b) * p_energy * p_indirect_energy;
+	light.direct = p_direct;
 
-		Vector3 to(light->x + 0.5, light->y + 0.5, light->z + 0.5);
-		to += (light_pos - to).sign() * 0.47; //make it more likely to receive a ray
+	//every leaf only writes to its own light, so they can be traced in parallel
+	bake_pool.do_work(leaf_cells.size(), this, &VoxelLightBaker::_plot_light_directional_job, &light);
+}
+
+static _FORCE_INLINE_ int _compute_local_clip_planes(const Vector3 &p_light_axis, int p_cell_subdiv, Plane *r_clip) {
 
-		Vector3 light_axis = (to - light_pos).normalized();
-		float distance_adv = _get_normal_advance(light_axis);
+	int clip_planes = 0;
 
-		Vector3 normal(cells[idx].normal[0], cells[idx].normal[1], cells[idx].normal[2]);
+	for (int c = 0; c < 3; c++) {
 
-		if (normal != Vector3() && normal.dot(-light_axis) < 0.001) {
-			idx = light_data[idx].next_leaf;
+		if (ABS(p_light_axis[c]) < CMP_EPSILON)
 			continue;
-		}
+		r_clip[clip_planes].normal[c] = 1.0;
 
-		float att = 1.0;
-		{
-			float d = light_pos.distance_to(to);
-			if (d + distance_adv > local_radius) {
-				idx = light_data[idx].next_leaf;
-				continue; // too far away
-			}
+		if (p_light_axis[c] < 0) {
 
-			float dt = CLAMP((d + distance_adv) / local_radius, 0, 1);
-			att *= powf(1.0 - dt, p_attenutation);
+			r_clip[clip_planes].d = (1 << (p_cell_subdiv - 1)) + 1;
+		} else {
+			r_clip[clip_planes].d -= 1.0;
 		}
 
-		clip_planes = 0;
+		clip_planes++;
+	}
 
-		for (int c = 0; c < 3; c++) {
+	return clip_planes;
+}
 
-			if (ABS(light_axis[c]) < CMP_EPSILON)
-				continue;
-			clip[clip_planes].normal[c] = 1.0;
+void VoxelLightBaker::_plot_light_omni_job(uint32_t p_leaf, LightPlot *p_light) {
 
-			if (light_axis[c] < 0) {
+	int idx = leaf_cells[p_leaf];
+	const Light *light = &bake_light[idx];
+	const Cell *cells = bake_cells.ptr();
+	const Vector3 &light_pos = p_light->pos;
 
-				clip[clip_planes].d = (1 << (cell_subdiv - 1)) + 1;
-			} else {
-				clip[clip_planes].d -= 1.0;
-			}
+	Vector3 to(light->x + 0.5, light->y + 0.5, light->z + 0.5);
+	to += (light_pos - to).sign() * 0.47; //make it more likely to receive a ray
 
-			clip_planes++;
-		}
+	Vector3 light_axis = (to - light_pos).normalized();
+	float distance_adv = _get_normal_advance(light_axis);
 
-		Vector3 from = light_pos;
+	Vector3 normal(cells[idx].normal[0], cells[idx].normal[1], cells[idx].normal[2]);
 
-		for (int j = 0; j < clip_planes; j++) {
+	if (normal != Vector3() && normal.dot(-light_axis) < 0.001) {
+		return;
+	}
 
-			clip[j].intersects_segment(from, to, &from);
+	float att = 1.0;
+	{
+		float d = light_pos.distance_to(to);
+		if (d + distance_adv > p_light->radius) {
+			return; // too far away
 		}
 
-		float distance = (to - from).length();
+		float dt = CLAMP((d + distance_adv) / p_light->radius, 0, 1);
+		att *= powf(1.0 - dt, p_light->attenuation);
+	}
 
-		distance -= Math::fmod(distance, distance_adv); //make it reach the center of the box always, but this tame make it closer
-		from = to - light_axis * distance;
-		to += (light_pos - to).sign() * 0.47; //make it more likely to receive a ray
+	Plane clip[3];
+	int clip_planes = _compute_local_clip_planes(light_axis, cell_subdiv, clip);
 
-		uint32_t result = 0xFFFFFFFF;
+	Vector3 from = light_pos;
 
-		while (distance > -distance_adv) { //use this to avoid precision errors
+	for (int j = 0; j < clip_planes; j++) {
 
-			result = _find_cell_at_pos(cells, int(floor(from.x)), int(floor(from.y)), int(floor(from.z)));
-			if (result != 0xFFFFFFFF) {
-				break;
-			}
+		clip[j].intersects_segment(from, to, &from);
+	}
 
-			from += light_axis * distance_adv;
-			distance -= distance_adv;
-		}
+	float distance = (to - from).length();
 
-		if (result == (uint32_t)idx) {
-			//cell hit itself! hooray!
+	distance -= Math::fmod(distance, distance_adv); //make it reach the center of the box always, but this tame make it closer
+	from = to - light_axis * distance;
 
-			if (normal == Vector3()) {
-				for (int i = 0; i < 6; i++) {
-					light->accum[i][0] += light_energy.x * cells[idx].albedo[0] * att;
-					light->accum[i][1] += light_energy.y * cells[idx].albedo[1] * att;
-					light->accum[i][2] += light_energy.z * cells[idx].albedo[2] * att;
-				}
+	uint32_t result = 0xFFFFFFFF;
 
-			} else {
+	while (distance > -distance_adv) { //use this to avoid precision errors
 
-				for (int i = 0; i < 6; i++) {
-					float s = MAX(0.0, aniso_normal[i].dot(-normal));
-					light->accum[i][0] += light_energy.x * cells[idx].albedo[0] * s * att;
-					light->accum[i][1] += light_energy.y * cells[idx].albedo[1] * s * att;
-					light->accum[i][2] += light_energy.z * cells[idx].albedo[2] * s * att;
-				}
-			}
-
-			if (p_direct) {
-				for (int i = 0; i < 6; i++) {
-					float s = MAX(0.0, aniso_normal[i].dot(-light_axis)); //light depending on normal for direct
-					light->direct_accum[i][0] += light_energy.x * s * att;
-					light->direct_accum[i][1] += light_energy.y * s * att;
-					light->direct_accum[i][2] += light_energy.z * s * att;
-				}
-			}
+		result = _find_cell_at_pos(cells, int(floor(from.x)), int(floor(from.y)), int(floor(from.z)));
+		if (result != 0xFFFFFFFF) {
+			break;
 		}
 
-		idx = light_data[idx].next_leaf;
+		from += light_axis * distance_adv;
+		distance -= distance_adv;
+	}
+
+	if (result == (uint32_t)idx) {
+		//cell hit itself! hooray!
+		_add_light_to_leaf(idx, light_axis, p_light->energy * att, p_light->direct);
 	}
 }
 
-void VoxelLightBaker::plot_light_spot(const Vector3 &p_pos, const Vector3 &p_axis, const Color &p_color, float p_energy, float p_indirect_energy, float p_radius, float p_attenutation, float p_spot_angle, float p_spot_attenuation, bool p_direct) {
+void VoxelLightBaker::plot_light_omni(const Vector3 &p_pos, const Color &p_color, float p_energy, float p_indirect_energy, float p_radius, float p_attenutation, bool p_direct) {
 
 	_check_init_light();
 
 	if (p_direct)
 		direct_lights_baked = true;
 
-	Plane clip[3];
-	int clip_planes = 0;
+	LightPlot light;
+	light.pos = to_cell_space.xform(p_pos) + Vector3(0.5, 0.5, 0.5);
+	light.radius = to_cell_space.basis.xform(Vector3(0, 0, 1)).length() * p_radius;
+	light.attenuation = p_attenutation;
+	light.energy = Vector3(p_color.r, p_color.g, p_color.b) * p_energy * p_indirect_energy;
+	light.direct = p_direct;
 
-	// uint64_t us = OS::get_singleton()->get_ticks_usec();
-
-	Vector3 light_pos = to_cell_space.xform(p_pos) + Vector3(0.5, 0.5, 0.5);
-	Vector3 spot_axis = to_cell_space.basis.xform(p_axis).normalized();
+	bake_pool.do_work(leaf_cells.size(), this, &VoxelLightBaker::_plot_light_omni_job, &light);
+}
 
-	float local_radius = to_cell_space.basis.xform(Vector3(0, 0, 1)).length() * p_radius;
+void VoxelLightBaker::_plot_light_spot_job(uint32_t p_leaf, LightPlot *p_light) {
 
-	Light *light_data = bake_light.ptrw();
+	int idx = leaf_cells[p_leaf];
+	const Light *light = &bake_light[idx];
 	const Cell *cells = bake_cells.ptr();
-	Vector3 light_energy = Vector3(p_color.r, p_color.g, p_color.b) * p_energy * p_indirect_energy;
+	const Vector3 &light_pos = p_light->pos;
 
-	int idx = first_leaf;
-	while (idx >= 0) {
+	Vector3 to(light->x + 0.5, light->y + 0.5, light->z + 0.5);
 
-		Light *light = &light_data[idx];
-
-		Vector3 to(light->x + 0.5, light->y + 0.5, light->z + 0.5);
-
-		Vector3 light_axis = (to - light_pos).normalized();
-		float distance_adv = _get_normal_advance(light_axis);
+	Vector3 light_axis = (to - light_pos).normalized();
+	float distance_adv = _get_normal_advance(light_axis);
 
-		Vector3 normal(cells[idx].normal[0], cells[idx].normal[1], cells[idx].normal[2]);
+	Vector3 normal(cells[idx].normal[0], cells[idx].normal[1], cells[idx].normal[2]);
 
-		if (normal != Vector3() && normal.dot(-light_axis) < 0.001) {
-			idx = light_data[idx].next_leaf;
-			continue;
-		}
-
-		float angle = Math::rad2deg(Math::acos(light_axis.dot(-spot_axis)));
-		if (angle > p_spot_angle) {
-			idx = light_data[idx].next_leaf;
-			continue; // too far away
-		}
+	if (normal != Vector3() && normal.dot(-light_axis) < 0.001) {
+		return;
+	}
 
-		float att = Math::pow(1.0f - angle / p_spot_angle, p_spot_attenuation);
+	float angle = Math::rad2deg(Math::acos(light_axis.dot(-p_light->axis)));
+	if (angle > p_light->spot_angle) {
+		return; // too far away
+	}
 
-		{
-			float d = light_pos.distance_to(to);
-			if (d + distance_adv > local_radius) {
-				idx = light_data[idx].next_leaf;
-				continue; // too far away
-			}
+	float att = Math::pow(1.0f - angle / p_light->spot_angle, p_light->spot_attenuation);
 
-			float dt = CLAMP((d + distance_adv) / local_radius, 0, 1);
-			att *= powf(1.0 - dt, p_attenutation);
+	{
+		float d = light_pos.distance_to(to);
+		if (d + distance_adv > p_light->radius) {
+			return; // too far away
 		}
 
-		clip_planes = 0;
-
-		for (int c = 0; c < 3; c++) {
-
-			if (ABS(light_axis[c]) < CMP_EPSILON)
-				continue;
-			clip[clip_planes].normal[c] = 1.0;
-
-			if (light_axis[c] < 0) {
-
-				clip[clip_planes].d = (1 << (cell_subdiv - 1)) + 1;
-			} else {
-				clip[clip_planes].d -= 1.0;
-			}
+		float dt = CLAMP((d + distance_adv) / p_light->radius, 0, 1);
+		att *= powf(1.0 - dt, p_light->attenuation);
+	}
 
-			clip_planes++;
-		}
+	Plane clip[3];
+	int clip_planes = _compute_local_clip_planes(light_axis, cell_subdiv, clip);
 
-		Vector3 from = light_pos;
+	Vector3 from = light_pos;
 
-		for (int j = 0; j < clip_planes; j++) {
+	for (int j = 0; j < clip_planes; j++) {
 
-			clip[j].intersects_segment(from, to, &from);
-		}
+		clip[j].intersects_segment(from, to, &from);
+	}
 
-		float distance = (to - from).length();
+	float distance = (to - from).length();
 
-		distance -= Math::fmod(distance, distance_adv); //make it reach the center of the box always, but this tame make it closer
-		from = to - light_axis * distance;
+	distance -= Math::fmod(distance, distance_adv); //make it reach the center of the box always, but this tame make it closer
+	from = to - light_axis * distance;
 
-		uint32_t result = 0xFFFFFFFF;
+	uint32_t result = 0xFFFFFFFF;
 
-		while (distance > -distance_adv) { //use this to avoid precision errors
+	while (distance > -distance_adv) { //use this to avoid precision errors
 
-			result = _find_cell_at_pos(cells, int(floor(from.x)), int(floor(from.y)), int(floor(from.z)));
-			if (result != 0xFFFFFFFF) {
-				break;
-			}
-
-			from += light_axis * distance_adv;
-			distance -= distance_adv;
+		result = _find_cell_at_pos(cells, int(floor(from.x)), int(floor(from.y)), int(floor(from.z)));
+		if (result != 0xFFFFFFFF) {
+			break;
 		}
 
-		if (result == (uint32_t)idx) {
-			//cell hit itself! hooray!
+		from += light_axis * distance_adv;
+		distance -= distance_adv;
+	}
 
-			if (normal == Vector3()) {
-				for (int i = 0; i < 6; i++) {
-					light->accum[i][0] += light_energy.x * cells[idx].albedo[0] * att;
-					light->accum[i][1] += light_energy.y * cells[idx].albedo[1] * att;
-					light->accum[i][2] += light_energy.z * cells[idx].albedo[2] * att;
-				}
+	if (result == (uint32_t)idx) {
+		//cell hit itself! hooray!
+		_add_light_to_leaf(idx, light_axis, p_light->energy * att, p_light->direct);
+	}
+}
 
-			} else {
+void VoxelLightBaker::plot_light_spot(const Vector3 &p_pos, const Vector3 &p_axis, const Color &p_color, float p_energy, float p_indirect_energy, float p_radius, float p_attenutation, float p_spot_angle, float p_spot_attenuation, bool p_direct) {
 
-				for (int i = 0; i < 6; i++) {
-					float s = MAX(0.0, aniso_normal[i].dot(-normal));
-					light->accum[i][0] += light_energy.x * cells[idx].albedo[0] * s * att;
-					light->accum[i][1] += light_energy.y * cells[idx].albedo[1] * s * att;
-					light->accum[i][2] += light_energy.z * cells[idx].albedo[2] * s * att;
-				}
-			}
+	_check_init_light();
 
-			if (p_direct) {
-				for (int i = 0; i < 6; i++) {
-					float s = MAX(0.0, aniso_normal[i].dot(-light_axis)); //light depending on normal for direct
-					light->direct_accum[i][0] += light_energy.x * s * att;
-					light->direct_accum[i][1] += light_energy.y * s * att;
-					light->direct_accum[i][2] += light_energy.z * s * att;
-				}
-			}
-		}
+	if (p_direct)
+		direct_lights_baked = true;
 
-		idx = light_data[idx].next_leaf;
-	}
+	LightPlot light;
+	light.pos = to_cell_space.xform(p_pos) + Vector3(0.5, 0.5, 0.5);
+	light.axis = to_cell_space.basis.xform(p_axis).normalized();
+	light.radius = to_cell_space.basis.xform(Vector3(0, 0, 1)).length() * p_radius;
+	light.attenuation = p_attenutation;
+	light.spot_angle = p_spot_angle;
+	light.spot_attenuation = p_spot_attenuation;
+	light.energy = Vector3(p_color.r, p_color.g, p_color.b) * p_energy * p_indirect_energy;
+	light.direct = p_direct;
+
+	bake_pool.do_work(leaf_cells.size(), this, &VoxelLightBaker::_plot_light_spot_job, &light);
 }
 
-void VoxelLightBaker::_fixup_plot(int p_idx, int p_level) {
+int VoxelLightBaker::_fixup_plot(int p_idx, int p_level, int p_fixed_level) {
+
+	Cell *cells = bake_cells.ptrw();
+	Light *lights = bake_light.size() ? bake_light.ptrw() : NULL;
+	Cell *cell = &cells[p_idx];
 
 	if (p_level == cell_subdiv - 1) {
 
-		leaf_voxel_count++;
-		float alpha = bake_cells[p_idx].alpha;
+		float alpha = cell->alpha;
 
-		bake_cells.write[p_idx].albedo[0] /= alpha;
-		bake_cells.write[p_idx].albedo[1] /= alpha;
-		bake_cells.write[p_idx].albedo[2] /= alpha;
+		cell->albedo[0] /= alpha;
+		cell->albedo[1] /= alpha;
+		cell->albedo[2] /= alpha;
 
 		//transfer emission to light
-		bake_cells.write[p_idx].emission[0] /= alpha;
-		bake_cells.write[p_idx].emission[1] /= alpha;
-		bake_cells.write[p_idx].emission[2] /= alpha;
+		cell->emission[0] /= alpha;
+		cell->emission[1] /= alpha;
+		cell->emission[2] /= alpha;
 
-		bake_cells.write[p_idx].normal[0] /= alpha;
-		bake_cells.write[p_idx].normal[1] /= alpha;
-		bake_cells.write[p_idx].normal[2] /= alpha;
+		cell->normal[0] /= alpha;
+		cell->normal[1] /= alpha;
+		cell->normal[2] /= alpha;
 
-		Vector3 n(bake_cells[p_idx].normal[0], bake_cells[p_idx].normal[1], bake_cells[p_idx].normal[2]);
+		Vector3 n(cell->normal[0], cell->normal[1], cell->normal[2]);
 		if (n.length() < 0.01) {
 			//too much fight over normal, zero it
-			bake_cells.write[p_idx].normal[0] = 0;
-			bake_cells.write[p_idx].normal[1] = 0;
-			bake_cells.write[p_idx].normal[2] = 0;
+			cell->normal[0] = 0;
+			cell->normal[1] = 0;
+			cell->normal[2] = 0;
 		} else {
 			n.normalize();
-			bake_cells.write[p_idx].normal[0] = n.x;
-			bake_cells.write[p_idx].normal[1] = n.y;
-			bake_cells.write[p_idx].normal[2] = n.z;
+			cell->normal[0] = n.x;
+			cell->normal[1] = n.y;
+			cell->normal[2] = n.z;
 		}
 
-		bake_cells.write[p_idx].alpha = 1.0;
+		cell->alpha = 1.0;
 
-		/*if (bake_light.size()) {
-			for(int i=0;i<6;i++) {
+		return 1;
+	}
 
-			}
-		}*/
+	//go down
 
-	} else {
+	int leaf_count = 0;
 
-		//go down
+	cell->emission[0] = 0;
+	cell->emission[1] = 0;
+	cell->emission[2] = 0;
+	cell->normal[0] = 0;
+	cell->normal[1] = 0;
+	cell->normal[2] = 0;
+	cell->albedo[0] = 0;
+	cell->albedo[1] = 0;
+	cell->albedo[2] = 0;
+	if (lights) {
+		for (int j = 0; j < 6; j++) {
+			lights[p_idx].accum[j][0] = 0;
+			lights[p_idx].accum[j][1] = 0;
+			lights[p_idx].accum[j][2] = 0;
+		}
+	}
+
+	float alpha_average = 0;
+	int children_found = 0;
+
+	for (int i = 0; i < 8; i++) {
+
+		uint32_t child = cell->children[i];
+
+		if (child == CHILD_EMPTY)
+			continue;
+
+		if (p_level + 1 != p_fixed_level) {
+			leaf_count += _fixup_plot(child, p_level + 1, p_fixed_level);
+		}
+		alpha_average += cells[child].alpha;
 
-		bake_cells.write[p_idx].emission[0] = 0;
-		bake_cells.write[p_idx].emission[1] = 0;
-		bake_cells.write[p_idx].emission[2] = 0;
-		bake_cells.write[p_idx].normal[0] = 0;
-		bake_cells.write[p_idx].normal[1] = 0;
-		bake_cells.write[p_idx].normal[2] = 0;
-		bake_cells.write[p_idx].albedo[0] = 0;
-		bake_cells.write[p_idx].albedo[1] = 0;
-		bake_cells.write[p_idx].albedo[2] = 0;
-		if (bake_light.size()) {
+		if (lights) {
 			for (int j = 0; j < 6; j++) {
-				bake_light.write[p_idx].accum[j][0] = 0;
-				bake_light.write[p_idx].accum[j][1] = 0;
-				bake_light.write[p_idx].accum[j][2] = 0;
+				lights[p_idx].accum[j][0] += lights[child].accum[j][0];
+				lights[p_idx].accum[j][1] += lights[child].accum[j][1];
+				lights[p_idx].accum[j][2] += lights[child].accum[j][2];
 			}
+			cell->emission[0] += cells[child].emission[0];
+			cell->emission[1] += cells[child].emission[1];
+			cell->emission[2] += cells[child].emission[2];
 		}
 
-		float alpha_average = 0;
-		int children_found = 0;
+		children_found++;
+	}
 
-		for (int i = 0; i < 8; i++) {
+	cell->alpha = alpha_average / 8.0;
+	if (lights && children_found) {
+		float divisor = Math::lerp(8, children_found, propagation);
+		for (int j = 0; j < 6; j++) {
+			lights[p_idx].accum[j][0] /= divisor;
+			lights[p_idx].accum[j][1] /= divisor;
+			lights[p_idx].accum[j][2] /= divisor;
+		}
+		cell->emission[0] /= divisor;
+		cell->emission[1] /= divisor;
+		cell->emission[2] /= divisor;
+	}
 
-			uint32_t child = bake_cells[p_idx].children[i];
+	return leaf_count;
+}
 
-			if (child == CHILD_EMPTY)
-				continue;
+void VoxelLightBaker::_fixup_plot_job(uint32_t p_index, FixupPlot *p_fixup) {
 
-			_fixup_plot(child, p_level + 1);
-			alpha_average += bake_cells[child].alpha;
+	p_fixup->leaf_counts[p_index] = _fixup_plot(p_fixup->cells[p_index], p_fixup->level);
+}
 
-			if (bake_light.size() > 0) {
-				for (int j = 0; j < 6; j++) {
-					bake_light.write[p_idx].accum[j][0] += bake_light[child].accum[j][0];
-					bake_light.write[p_idx].accum[j][1] += bake_light[child].accum[j][1];
-					bake_light.write[p_idx].accum[j][2] += bake_light[child].accum[j][2];
-				}
-				bake_cells.write[p_idx].emission[0] += bake_cells[child].emission[0];
-				bake_cells.write[p_idx].emission[1] += bake_cells[child].emission[1];
-				bake_cells.write[p_idx].emission[2] += bake_cells[child].emission[2];
-			}
+void VoxelLightBaker::_gather_cells_at_level(int p_idx, int p_level, int p_target_level, Vector<uint32_t> &r_cells) {
 
-			children_found++;
-		}
+	if (p_level == p_target_level) {
+		r_cells.push_back(p_idx);
+		return;
+	}
 
-		bake_cells.write[p_idx].alpha = alpha_average / 8.0;
-		if (bake_light.size() && children_found) {
-			float divisor = Math::lerp(8, children_found, propagation);
-			for (int j = 0; j < 6; j++) {
-				bake_light.write[p_idx].accum[j][0] /= divisor;
-				bake_light.write[p_idx].accum[j][1] /= divisor;
-				bake_light.write[p_idx].accum[j][2] /= divisor;
-			}
-			bake_cells.write[p_idx].emission[0] /= divisor;
-			bake_cells.write[p_idx].emission[1] /= divisor;
-			bake_cells.write[p_idx].emission[2] /= divisor;
-		}
+	for (int i = 0; i < 8; i++) {
+
+		uint32_t child = bake_cells[p_idx].children[i];
+
+		if (child == CHILD_EMPTY)
+			continue;
+
+		_gather_cells_at_level(child, p_level + 1, p_target_level, r_cells);
+	}
+}
+
+void VoxelLightBaker::_fixup_octree() {
+
+	//subtrees below the split level share no cells, so they are fixed up in parallel,
+	//then the few cells above it are aggregated from their already fixed children
+	int split_level = MIN(2, cell_subdiv - 1);
+
+	Vector<uint32_t> subtrees;
+	_gather_cells_at_level(0, 0, split_level, subtrees);
+
+	Vector<int> leaf_counts;
+	leaf_counts.resize(subtrees.size());
+
+	FixupPlot fixup;
+	fixup.cells = subtrees.ptr();
+	fixup.level = split_level;
+	fixup.leaf_counts = leaf_counts.ptrw();
+
+	bake_pool.do_work(subtrees.size(), this, &VoxelLightBaker::_fixup_plot_job, &fixup);
+
+	for (int i = 0; i < leaf_counts.size(); i++) {
+		leaf_voxel_count += leaf_counts[i];
+	}
+
+	if (split_level > 0) {
+		_fixup_plot(0, 0, split_level);
 	}
 }
 
@@ -1794,6 +1786,134 @@ void VoxelLightBaker::_lightmap_bake_point(uint32_t p_x, LightMap *p_line) {
 	}
 }
 
+//gauss kernel, 7 step sigma 2
+static const float lightmap_gauss_kernel[4] = { 0.214607f, 0.189879f, 0.131514f, 0.071303f };
+
+void VoxelLightBaker::_lightmap_blur_horizontal_job(uint32_t p_line, LightMapPass *p_pass) {
+
+	LightMap *lightmap_ptr = p_pass->pixels;
+	int width = p_pass->width;
+	int i = p_line;
+
+	for (int j = 0; j < width; j++) {
+		if (lightmap_ptr[i * width + j].normal == Vector3()) {
+			continue; //empty
+		}
+		float gauss_sum = lightmap_gauss_kernel[0];
+		Vector3 accum = lightmap_ptr[i * width + j].light * lightmap_gauss_kernel[0];
+		for (int k = 1; k < 4; k++) {
+			int new_x = j + k;
+			if (new_x >= width || lightmap_ptr[i * width + new_x].normal == Vector3())
+				break;
+			gauss_sum += lightmap_gauss_kernel[k];
+			accum += lightmap_ptr[i * width + new_x].light * lightmap_gauss_kernel[k];
+		}
+		for (int k = 1; k < 4; k++) {
+			int new_x = j - k;
+			if (new_x < 0 || lightmap_ptr[i * width + new_x].normal == Vector3())
+				break;
+			gauss_sum += lightmap_gauss_kernel[k];
+			accum += lightmap_ptr[i * width + new_x].light * lightmap_gauss_kernel[k];
+		}
+
+		lightmap_ptr[i * width + j].pos = accum /= gauss_sum;
+	}
+}
+
+void VoxelLightBaker::_lightmap_blur_vertical_job(uint32_t p_line, LightMapPass *p_pass) {
+
+	LightMap *lightmap_ptr = p_pass->pixels;
+	int width = p_pass->width;
+	int height = p_pass->height;
+	int i = p_line;
+
+	for (int j = 0; j < width; j++) {
+		if (lightmap_ptr[i * width + j].normal == Vector3())
+			continue; //empty, don't write over it anyway
+		float gauss_sum = lightmap_gauss_kernel[0];
+		Vector3 accum = lightmap_ptr[i * width + j].pos * lightmap_gauss_kernel[0];
+		for (int k = 1; k < 4; k++) {
+			int new_y = i + k;
+			if (new_y >= height || lightmap_ptr[new_y * width + j].normal == Vector3())
+				break;
+			gauss_sum += lightmap_gauss_kernel[k];
+			accum += lightmap_ptr[new_y * width + j].pos * lightmap_gauss_kernel[k];
+		}
+		for (int k = 1; k < 4; k++) {
+			int new_y = i - k;
+			if (new_y < 0 || lightmap_ptr[new_y * width + j].normal == Vector3())
+				break;
+			gauss_sum += lightmap_gauss_kernel[k];
+			accum += lightmap_ptr[new_y * width + j].pos * lightmap_gauss_kernel[k];
+		}
+
+		lightmap_ptr[i * width + j].light = accum /= gauss_sum;
+	}
+}
+
+void VoxelLightBaker::_lightmap_add_direct_job(uint32_t p_line, LightMapPass *p_pass) {
+
+	const Cell *cells = bake_cells.ptr();
+	const Light *light = bake_light.ptr();
+	int width = p_pass->width;
+	int size = 1 << (cell_subdiv - 1);
+
+	for (int j = 0; j < width; j++) {
+
+		LightMap *pixel = &p_pass->pixels[p_line * width + j];
+		if (pixel->pos == Vector3())
+			continue; //unused, skipe
+
+		int x = int(pixel->pos.x) - 1;
+		int y = int(pixel->pos.y) - 1;
+		int z = int(pixel->pos.z) - 1;
+		Color accum;
+
+		int found = 0;
+
+		for (int k = 0; k < 8; k++) {
+
+			int ofs_x = x;
+			int ofs_y = y;
+			int ofs_z = z;
+
+			if (k & 1)
+				ofs_x++;
+			if (k & 2)
+				ofs_y++;
+			if (k & 4)
+				ofs_z++;
+
+			if (x < 0 || x >= size)
+				continue;
+			if (y < 0 || y >= size)
+				continue;
+			if (z < 0 || z >= size)
+				continue;
+
+			uint32_t cell = _find_cell_at_pos(cells, ofs_x, ofs_y, ofs_z);
+
+			if (cell == CHILD_EMPTY)
+				continue;
+			for (int l = 0; l < 6; l++) {
+				float s = pixel->normal.dot(aniso_normal[l]);
+				if (s < 0)
+					s = 0;
+				accum.r += light[cell].direct_accum[l][0] * s;
+				accum.g += light[cell].direct_accum[l][1] * s;
+				accum.b += light[cell].direct_accum[l][2] * s;
+			}
+			found++;
+		}
+		if (found) {
+			accum /= found;
+			pixel->light.x += accum.r;
+			pixel->light.y += accum.g;
+			pixel->light.z += accum.b;
+		}
+	}
+}
+
 Error VoxelLightBaker::make_lightmap(const Transform &p_xform, Ref<Mesh> &p_mesh, LightMapData &r_lightmap, bool (*p_bake_time_func)(void *, float, float), void *p_bake_time_ud) {
 
 	//transfer light information to a lightmap
@@ -1853,152 +1973,39 @@ Error VoxelLightBaker::make_lightmap(const Transform &p_xform, Ref<Mesh> &p_mesh
 	{
 		LightMap *lightmap_ptr = lightmap.ptrw();
 		uint64_t begin_time = OS::get_singleton()->get_ticks_usec();
-		volatile int lines = 0;
 
-		// make sure our OS-level rng is seeded
+		//trace a band of lines per job, so the pool stays busy while progress is still reported often
+		int lines_per_step = MAX(1, MIN(height, (bake_pool.get_thread_count() + 1) * 2));
 
-		for (int i = 0; i < height; i++) {
+		for (int i = 0; i < height; i += lines_per_step) {
 
-			thread_process_array(width, this, &VoxelLightBaker::_lightmap_bake_point, &lightmap_ptr[i * width]);
+			int step_lines = MIN(lines_per_step, height - i);
+			bake_pool.do_work(width * step_lines, this, &VoxelLightBaker::_lightmap_bake_point, &lightmap_ptr[i * width]);
 
-			lines = MAX(lines, i); //for multithread
+			int lines = i + step_lines;
 			if (p_bake_time_func) {
 				uint64_t elapsed = OS::get_singleton()->get_ticks_usec() - begin_time;
 				float elapsed_sec = double(elapsed) / 1000000.0;
-				float remaining = lines < 1 ? 0 : (elapsed_sec / lines) * (height - lines - 1);
+				float remaining = (elapsed_sec / lines) * (height - lines);
 				if (p_bake_time_func(p_bake_time_ud, remaining, lines / float(height))) {
 					return ERR_SKIP;
 				}
 			}
 		}
 
-		if (bake_mode == BAKE_MODE_RAY_TRACE) {
-			//blur
-			//gauss kernel, 7 step sigma 2
-			static const float gauss_kernel[4] = { 0.214607f, 0.189879f, 0.131514f, 0.071303f };
-			//horizontal pass
-			for (int i = 0; i < height; i++) {
-				for (int j = 0; j < width; j++) {
-					if (lightmap_ptr[i * width + j].normal == Vector3()) {
-						continue; //empty
-					}
-					float gauss_sum = gauss_kernel[0];
-					Vector3 accum = lightmap_ptr[i * width + j].light * gauss_kernel[0];
-					for (int k = 1; k < 4; k++) {
-						int new_x = j + k;
-						if (new_x >= width || lightmap_ptr[i * width + new_x].normal == Vector3())
-							break;
-						gauss_sum += gauss_kernel[k];
-						accum += lightmap_ptr[i * width + new_x].light * gauss_kernel[k];
-					}
-					for (int k = 1; k < 4; k++) {
-						int new_x = j - k;
-						if (new_x < 0 || lightmap_ptr[i * width + new_x].normal == Vector3())
-							break;
-						gauss_sum += gauss_kernel[k];
-						accum += lightmap_ptr[i * width + new_x].light * gauss_kernel[k];
-					}
-
-					lightmap_ptr[i * width + j].pos = accum /= gauss_sum;
-				}
-			}
-			//vertical pass
-			for (int i = 0; i < height; i++) {
-				for (int j = 0; j < width; j++) {
-					if (lightmap_ptr[i * width + j].normal == Vector3())
-						continue; //empty, don't write over it anyway
-					float gauss_sum = gauss_kernel[0];
-					Vector3 accum = lightmap_ptr[i * width + j].pos * gauss_kernel[0];
-					for (int k = 1; k < 4; k++) {
-						int new_y = i + k;
-						if (new_y >= height || lightmap_ptr[new_y * width + j].normal == Vector3())
-							break;
-						gauss_sum += gauss_kernel[k];
-						accum += lightmap_ptr[new_y * width + j].pos * gauss_kernel[k];
-					}
-					for (int k = 1; k < 4; k++) {
-						int new_y = i - k;
-						if (new_y < 0 || lightmap_ptr[new_y * width + j].normal == Vector3())
-							break;
-						gauss_sum += gauss_kernel[k];
-						accum += lightmap_ptr[new_y * width + j].pos * gauss_kernel[k];
-					}
+		LightMapPass pass;
+		pass.pixels = lightmap_ptr;
+		pass.width = width;
+		pass.height = height;
 
-					lightmap_ptr[i * width + j].light = accum /= gauss_sum;
-				}
-			}
+		if (bake_mode == BAKE_MODE_RAY_TRACE) {
+			//blur, the horizontal pass writes to pos and the vertical one reads it back, so each pass is split by lines
+			bake_pool.do_work(height, this, &VoxelLightBaker::_lightmap_blur_horizontal_job, &pass);
+			bake_pool.do_work(height, this, &VoxelLightBaker::_lightmap_blur_vertical_job, &pass);
 		}
 
 		//add directional light (do this after blur)
-		{
-			const Cell *cells = bake_cells.ptr();
-			const Light *light = bake_light.ptr();
-#ifdef _OPENMP
-#pragma omp parallel
-#endif
-			for (int i = 0; i < height; i++) {
-#ifdef _OPENMP
-#pragma omp parallel for schedule(dynamic, 1)
-#endif
-				for (int j = 0; j < width; j++) {
-
-					//if (i == 125 && j == 280) {
-
-					LightMap *pixel = &lightmap_ptr[i * width + j];
-					if (pixel->pos == Vector3())
-						continue; //unused, skipe
-
-					int x = int(pixel->pos.x) - 1;
-					int y = int(pixel->pos.y) - 1;
-					int z = int(pixel->pos.z) - 1;
-					Color accum;
-					int size = 1 << (cell_subdiv - 1);
-
-					int found = 0;
-
-					for (int k = 0; k < 8; k++) {
-
-						int ofs_x = x;
-						int ofs_y = y;
-						int ofs_z = z;
-
-						if (k & 1)
-							ofs_x++;
-						if (k & 2)
-							ofs_y++;
-						if (k & 4)
-							ofs_z++;
-
-						if (x < 0 || x >= size)
-							continue;
-						if (y < 0 || y >= size)
-							continue;
-						if (z < 0 || z >= size)
-							continue;
-
-						uint32_t cell = _find_cell_at_pos(cells, ofs_x, ofs_y, ofs_z);
-
-						if (cell == CHILD_EMPTY)
-							continue;
-						for (int l = 0; l < 6; l++) {
-							float s = pixel->normal.dot(aniso_normal[l]);
-							if (s < 0)
-								s = 0;
-							accum.r += light[cell].direct_accum[l][0] * s;
-							accum.g += light[cell].direct_accum[l][1] * s;
-							accum.b += light[cell].direct_accum[l][2] * s;
-						}
-						found++;
-					}
-					if (found) {
-						accum /= found;
-						pixel->light.x += accum.r;
-						pixel->light.y += accum.g;
-						pixel->light.z += accum.b;
-					}
-				}
-			}
-		}
+		bake_pool.do_work(height, this, &VoxelLightBaker::_lightmap_add_direct_job, &pass);
 
 		{
 			//fill gaps with neighbour vertices to avoid filter fades to black on edges
@@ -2101,6 +2108,10 @@ void VoxelLightBaker::begin_bake(int p_subdiv, const AABB &p_bounds) {
 	bake_cells.resize(1);
 	material_cache.clear();
 
+	if (!bake_pool.is_initialized()) {
+		bake_pool.init();
+	}
+
 	//find out the actual real bounds, power of 2, which gets the highest subdivision
 	po2_bounds = p_bounds;
 	int longest_axis = po2_bounds.get_longest_axis_index();
@@ -2137,7 +2148,7 @@ void VoxelLightBaker::begin_bake(int p_subdiv, const AABB &p_bounds) {
 }
 
 void VoxelLightBaker::end_bake() {
-	_fixup_plot(0, 0);
+	_fixup_octree();
 }
 
 //create the data for visual server
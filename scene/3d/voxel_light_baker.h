@@ -31,6 +31,7 @@
 #ifndef VOXEL_LIGHT_BAKER_H
 #define VOXEL_LIGHT_BAKER_H
 
+#include "core/os/thread_work_pool.h"
 #include "scene/3d/mesh_instance.h"
 #include "scene/resources/multimesh.h"
 
@@ -105,6 +106,7 @@ private:
 	};
 
 	int first_leaf;
+	Vector<uint32_t> leaf_cells; //flat copy of the leaf list, so lights can be plotted in parallel
 
 	Vector<Light> bake_light;
 
@@ -135,18 +137,49 @@ private:
 
 	int max_original_cells;
 
+	ThreadWorkPool bake_pool;
+
+	struct LightPlot {
+		Vector3 pos;
+		Vector3 axis;
+		Vector3 energy;
+		float radius;
+		float attenuation;
+		float spot_angle;
+		float spot_attenuation;
+		float max_len;
+		float distance_adv;
+		Plane clip[3];
+		int clip_planes;
+		bool direct;
+	};
+
+	struct FixupPlot {
+		const uint32_t *cells;
+		int level;
+		int *leaf_counts;
+	};
+
 	void _init_light_plot(int p_idx, int p_level, int p_x, int p_y, int p_z, uint32_t p_parent);
 
 	Vector<Color> _get_bake_texture(Ref<Image> p_image, const Color &p_color_mul, const Color &p_color_add);
 	MaterialCache _get_material_cache(Ref<Material> p_material);
 
 	void _plot_face(int p_idx, int p_level, int p_x, int p_y, int p_z, const Vector3 *p_vtx, const Vector3 *p_normal, const Vector2 *p_uv, const MaterialCache &p_material, const AABB &p_aabb);
-	void _fixup_plot(int p_idx, int p_level);
+	int _fixup_plot(int p_idx, int p_level, int p_fixed_level = -1);
+	void _fixup_plot_job(uint32_t p_index, FixupPlot *p_fixup);
+	void _gather_cells_at_level(int p_idx, int p_level, int p_target_level, Vector<uint32_t> &r_cells);
+	void _fixup_octree();
 	void _debug_mesh(int p_idx, int p_level, const AABB &p_aabb, Ref<MultiMesh> &p_multimesh, int &idx, DebugMode p_mode);
 	void _check_init_light();
 
 	uint32_t _find_cell_at_pos(const Cell *cells, int x, int y, int z);
 
+	_FORCE_INLINE_ void _add_light_to_leaf(int p_idx, const Vector3 &p_light_axis, const Vector3 &p_energy, bool p_direct);
+	void _plot_light_directional_job(uint32_t p_leaf, LightPlot *p_light);
+	void _plot_light_omni_job(uint32_t p_leaf, LightPlot *p_light);
+	void _plot_light_spot_job(uint32_t p_leaf, LightPlot *p_light);
+
 	struct LightMap {
 		Vector3 light;
 		Vector3 pos;
@@ -162,6 +195,16 @@ private:
 
 	void _lightmap_bake_point(uint32_t p_x, LightMap *p_line);
 
+	struct LightMapPass {
+		LightMap *pixels;
+		int width;
+		int height;
+	};
+
+	void _lightmap_blur_horizontal_job(uint32_t p_line, LightMapPass *p_pass);
+	void _lightmap_blur_vertical_job(uint32_t p_line, LightMapPass *p_pass);
+	void _lightmap_add_direct_job(uint32_t p_line, LightMapPass *p_pass);
+
 public:
 	void begin_bake(int p_subdiv, const AABB &p_bounds);
 	void plot_mesh(const Transform &p_xform, Ref<Mesh> &p_mesh, const Vector<Ref<Material> > &p_materials, const Ref<Material> &p_override_material);
@@ -0,0 +1,632 @@
+/*************************************************************************/
+/*  world_streamer.cpp                                                   */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2019 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2019 Godot Engine contributors (cf. AUTHORS.md)    */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#include "world_streamer.h"
+
+#include "core/engine.h"
+#include "core/os/os.h"
+#include "scene/3d/camera.h"
+#include "scene/main/instance_placeholder.h"
+#include "scene/main/viewport.h"
+#include "scene/resources/packed_scene.h"
+
+WorldStreamer::CellKey WorldStreamer::_get_cell_key(const Vector3 &p_pos) const {
+
+	CellKey key;
+	key.x = CLAMP(Math::floor(p_pos.x / cell_size), -32768, 32767);
+	key.y = CLAMP(Math::floor(p_pos.y / cell_size), -32768, 32767);
+	key.z = CLAMP(Math::floor(p_pos.z / cell_size), -32768, 32767);
+	return key;
+}
+
+Vector3 WorldStreamer::_get_cell_position(const CellKey &p_key) const {
+
+	return (Vector3(p_key.x, p_key.y, p_key.z) + Vector3(0.5, 0.5, 0.5)) * cell_size;
+}
+
+float WorldStreamer::_get_cell_distance(const CellKey &p_key, const Vector<Vector3> &p_focus) const {
+
+	// Distance from the nearest focus point to the cell bounds, so a focus inside a cell is at distance zero.
+	Vector3 from = Vector3(p_key.x, p_key.y, p_key.z) * cell_size;
+	Vector3 to = from + Vector3(cell_size, cell_size, cell_size);
+
+	float min_dist = 1e20;
+	for (int i = 0; i < p_focus.size(); i++) {
+		Vector3 p = p_focus[i];
+		Vector3 closest(CLAMP(p.x, from.x, to.x), CLAMP(p.y, from.y, to.y), CLAMP(p.z, from.z, to.z));
+		min_dist = MIN(min_dist, closest.distance_squared_to(p));
+	}
+
+	return Math::sqrt(min_dist);
+}
+
+void WorldStreamer::_collect_placeholders() {
+
+	if (collected)
+		return;
+
+	for (int i = get_child_count() - 1; i >= 0; i--) {
+
+		InstancePlaceholder *ip = Object::cast_to<InstancePlaceholder>(get_child(i));
+		if (!ip)
+			continue;
+
+		// The placeholder keeps the original node properties, the transform tells which cell it belongs to.
+		Variant xform = ip->get("transform");
+		Vector3 origin = xform.get_type() == Variant::TRANSFORM ? xform.operator Transform().origin : Vector3();
+
+		remove_child(ip);
+		cells[_get_cell_key(origin)].placeholders.push_back(ip);
+	}
+
+	collected = true;
+}
+
+void WorldStreamer::_release_placeholders() {
+
+	for (Map<CellKey, Cell>::Element *E = cells.front(); E; E = E->next()) {
+
+		Cell &c = E->get();
+		// Instances already added are children and were freed along with this node.
+		for (int i = c.added; i < c.instances.size(); i++) {
+			memdelete(c.instances[i]);
+		}
+		for (int i = 0; i < c.placeholders.size(); i++) {
+			memdelete(c.placeholders[i]);
+		}
+	}
+
+	cells.clear();
+	collected = false;
+}
+
+void WorldStreamer::_queue_cell(const CellKey &p_key, Cell &r_cell) {
+
+	LoadRequest req;
+	req.key = p_key;
+	req.placeholders = r_cell.placeholders;
+
+	r_cell.state = CELL_QUEUED;
+	r_cell.cancel = false;
+	queued_count++;
+
+	load_mutex->lock();
+	load_queue.push_back(req);
+	load_mutex->unlock();
+
+	if (thread)
+		load_sem->post();
+}
+
+bool WorldStreamer::_process_load_request() {
+
+	load_mutex->lock();
+	if (load_queue.empty()) {
+		load_mutex->unlock();
+		return false;
+	}
+	LoadRequest req = load_queue.front()->get();
+	load_queue.pop_front();
+	load_mutex->unlock();
+
+	// Loading and instancing happen out of the tree, only adding the nodes is left to the main thread.
+	LoadResult res;
+	res.key = req.key;
+	for (int i = 0; i < req.placeholders.size(); i++) {
+		Node *n = req.placeholders[i]->create_detached_instance();
+		if (n)
+			res.instances.push_back(n);
+	}
+
+	load_mutex->lock();
+	load_results.push_back(res);
+	load_mutex->unlock();
+
+	return true;
+}
+
+void WorldStreamer::_flush_load_results() {
+
+	load_mutex->lock();
+	List<LoadResult> results = load_results;
+	load_results.clear();
+	load_mutex->unlock();
+
+	for (List<LoadResult>::Element *E = results.front(); E; E = E->next()) {
+
+		Map<CellKey, Cell>::Element *C = cells.find(E->get().key);
+		ERR_CONTINUE(!C);
+
+		Cell &c = C->get();
+		queued_count--;
+
+		if (c.cancel) {
+			for (int i = 0; i < E->get().instances.size(); i++) {
+				memdelete(E->get().instances[i]);
+			}
+			c.cancel = false;
+			c.state = CELL_UNLOADED;
+			continue;
+		}
+
+		c.instances = E->get().instances;
+		c.instance_ids.resize(c.instances.size());
+		for (int i = 0; i < c.instances.size(); i++) {
+			c.instance_ids.write[i] = c.instances[i]->get_instance_id();
+		}
+		c.added = 0;
+		c.state = CELL_READY;
+		loaded_count++;
+	}
+}
+
+bool WorldStreamer::_add_cell_instances(const CellKey &p_key, Cell &r_cell, uint64_t p_deadline) {
+
+	while (r_cell.added < r_cell.instances.size()) {
+
+		add_child(r_cell.instances[r_cell.added]);
+		r_cell.added++;
+
+		if (OS::get_singleton()->get_ticks_usec() >= p_deadline)
+			break;
+	}
+
+	if (r_cell.added < r_cell.instances.size())
+		return false;
+
+	r_cell.state = CELL_LOADED;
+	emit_signal("cell_loaded", _get_cell_position(p_key));
+	return true;
+}
+
+void WorldStreamer::_unload_cell(const CellKey &p_key, Cell &r_cell) {
+
+	bool was_loaded = r_cell.state == CELL_LOADED;
+
+	for (int i = 0; i < r_cell.instances.size(); i++) {
+		if (i >= r_cell.added) {
+			memdelete(r_cell.instances[i]);
+			continue;
+		}
+		// Scripts may have freed or reparented the instance since it was added.
+		Node *n = Object::cast_to<Node>(ObjectDB::get_instance(r_cell.instance_ids[i]));
+		if (n && n->get_parent() == this) {
+			remove_child(n);
+			n->queue_delete();
+		}
+	}
+
+	r_cell.instances.clear();
+	r_cell.instance_ids.clear();
+	r_cell.added = 0;
+	r_cell.state = CELL_UNLOADED;
+	loaded_count--;
+
+	if (was_loaded)
+		emit_signal("cell_unloaded", _get_cell_position(p_key));
+}
+
+void WorldStreamer::_gather_focus(Vector<Vector3> &r_focus) const {
+
+	Transform to_local = get_global_transform().affine_inverse();
+
+	for (int i = 0; i < focus_nodes.size(); i++) {
+		Spatial *s = Object::cast_to<Spatial>(ObjectDB::get_instance(focus_nodes[i]));
+		if (s && s->is_inside_tree())
+			r_focus.push_back(to_local.xform(s->get_global_transform().origin));
+	}
+
+	if (r_focus.empty() && get_viewport()) {
+		Camera *camera = get_viewport()->get_camera();
+		if (camera)
+			r_focus.push_back(to_local.xform(camera->get_global_transform().origin));
+	}
+}
+
+void WorldStreamer::_update_streaming() {
+
+	_flush_load_results();
+
+	Vector<Vector3> focus;
+	_gather_focus(focus);
+	if (focus.empty())
+		return;
+
+	float unload_dist = MAX(unload_radius, load_radius);
+
+	Vector<SortCell> to_load;
+	Vector<SortCell> evictable;
+	Vector<SortCell> ready;
+
+	for (Map<CellKey, Cell>::Element *E = cells.front(); E; E = E->next()) {
+
+		Cell &c = E->get();
+		c.distance = _get_cell_distance(E->key(), focus);
+
+		SortCell sc;
+		sc.key = E->key();
+		sc.distance = c.distance;
+
+		switch (c.state) {
+			case CELL_UNLOADED: {
+				if (c.distance <= load_radius)
+					to_load.push_back(sc);
+			} break;
+			case CELL_QUEUED: {
+				// The loader thread can't be interrupted, drop the result when it comes back instead.
+				if (c.distance > unload_dist)
+					c.cancel = true;
+				else if (c.distance <= load_radius)
+					c.cancel = false;
+			} break;
+			case CELL_READY:
+			case CELL_LOADED: {
+				if (c.distance > unload_dist) {
+					_unload_cell(E->key(), c);
+					continue;
+				}
+				if (c.distance > load_radius)
+					evictable.push_back(sc);
+				if (c.state == CELL_READY)
+					ready.push_back(sc);
+			} break;
+		}
+	}
+
+	to_load.sort();
+	evictable.sort();
+
+	// Cells kept only by the hysteresis band are given up first, farthest first, when over the cell budget.
+	int evict = evictable.size() - 1;
+	for (int i = 0; i < to_load.size() && queued_count < max_queued_loads; i++) {
+
+		if (max_loaded_cells > 0) {
+			while (loaded_count + queued_count >= max_loaded_cells && evict >= 0) {
+				Map<CellKey, Cell>::Element *C = cells.find(evictable[evict].key);
+				if (C->get().state == CELL_READY) {
+					for (int j = 0; j < ready.size(); j++) {
+						if (ready[j].key.key == C->key().key) {
+							ready.remove(j);
+							break;
+						}
+					}
+				}
+				_unload_cell(C->key(), C->get());
+				evict--;
+			}
+			if (loaded_count + queued_count >= max_loaded_cells)
+				break;
+		}
+
+		_queue_cell(to_load[i].key, cells[to_load[i].key]);
+	}
+
+	if (!thread)
+		_process_load_request();
+
+	if (ready.empty())
+		return;
+
+	// Nearest cells are added first, at least one instance goes in every frame so streaming never stalls.
+	ready.sort();
+	uint64_t deadline = OS::get_singleton()->get_ticks_usec() + instance_budget_usec;
+	for (int i = 0; i < ready.size(); i++) {
+		if (!_add_cell_instances(ready[i].key, cells[ready[i].key], deadline))
+			break;
+		if (OS::get_singleton()->get_ticks_usec() >= deadline)
+			break;
+	}
+}
+
+void WorldStreamer::_thread_func(void *p_ud) {
+
+	WorldStreamer *ws = (WorldStreamer *)p_ud;
+	ws->_thread_process();
+}
+
+void WorldStreamer::_thread_process() {
+
+	while (true) {
+
+		load_sem->wait();
+		if (exit_thread)
+			break;
+
+		_process_load_request();
+	}
+}
+
+void WorldStreamer::_start_thread() {
+
+	ERR_FAIL_COND(thread);
+	exit_thread = false;
+#ifndef NO_THREADS
+	thread = Thread::create(_thread_func, this);
+#endif
+}
+
+void WorldStreamer::_stop_thread() {
+
+	if (thread) {
+		exit_thread = true;
+		load_sem->post();
+		Thread::wait_to_finish(thread);
+		memdelete(thread);
+		thread = NULL;
+	}
+
+	// Whatever the thread finished is kept, requests it didn't get to go back to unloaded.
+	_flush_load_results();
+
+	load_mutex->lock();
+	for (List<LoadRequest>::Element *E = load_queue.front(); E; E = E->next()) {
+		Map<CellKey, Cell>::Element *C = cells.find(E->get().key);
+		if (C) {
+			C->get().state = CELL_UNLOADED;
+			C->get().cancel = false;
+			queued_count--;
+		}
+	}
+	load_queue.clear();
+	load_mutex->unlock();
+}
+
+void WorldStreamer::_notification(int p_what) {
+
+	switch (p_what) {
+
+		case NOTIFICATION_ENTER_TREE: {
+
+			if (Engine::get_singleton()->is_editor_hint())
+				return;
+
+			_start_thread();
+			set_process_internal(true);
+		} break;
+		case NOTIFICATION_READY: {
+
+			if (Engine::get_singleton()->is_editor_hint())
+				return;
+
+			_collect_placeholders();
+		} break;
+		case NOTIFICATION_INTERNAL_PROCESS: {
+
+			if (collected)
+				_update_streaming();
+		} break;
+		case NOTIFICATION_EXIT_TREE: {
+
+			if (Engine::get_singleton()->is_editor_hint())
+				return;
+
+			set_process_internal(false);
+			_stop_thread();
+		} break;
+	}
+}
+
+void WorldStreamer::set_cell_size(float p_size) {
+
+	ERR_FAIL_COND(p_size <= 0);
+	ERR_EXPLAIN("Cell size can't be changed once placeholders have been assigned to cells.");
+	ERR_FAIL_COND(collected);
+	cell_size = p_size;
+}
+
+float WorldStreamer::get_cell_size() const {
+
+	return cell_size;
+}
+
+void WorldStreamer::set_load_radius(float p_radius) {
+
+	load_radius = MAX(p_radius, 0);
+	update_configuration_warning();
+}
+
+float WorldStreamer::get_load_radius() const {
+
+	return load_radius;
+}
+
+void WorldStreamer::set_unload_radius(float p_radius) {
+
+	unload_radius = MAX(p_radius, 0);
+	update_configuration_warning();
+}
+
+float WorldStreamer::get_unload_radius() const {
+
+	return unload_radius;
+}
+
+void WorldStreamer::set_max_queued_loads(int p_count) {
+
+	max_queued_loads = MAX(p_count, 1);
+}
+
+int WorldStreamer::get_max_queued_loads() const {
+
+	return max_queued_loads;
+}
+
+void WorldStreamer::set_instance_budget_usec(int p_usec) {
+
+	instance_budget_usec = MAX(p_usec, 0);
+}
+
+int WorldStreamer::get_instance_budget_usec() const {
+
+	return instance_budget_usec;
+}
+
+void WorldStreamer::set_max_loaded_cells(int p_count) {
+
+	max_loaded_cells = MAX(p_count, 0);
+}
+
+int WorldStreamer::get_max_loaded_cells() const {
+
+	return max_loaded_cells;
+}
+
+void WorldStreamer::add_focus_node(Node *p_node) {
+
+	ERR_FAIL_NULL(p_node);
+	ERR_EXPLAIN("Focus nodes must inherit Spatial.");
+	ERR_FAIL_COND(!Object::cast_to<Spatial>(p_node));
+	ERR_FAIL_COND(focus_nodes.find(p_node->get_instance_id()) != -1);
+	focus_nodes.push_back(p_node->get_instance_id());
+}
+
+void WorldStreamer::remove_focus_node(Node *p_node) {
+
+	ERR_FAIL_NULL(p_node);
+	focus_nodes.erase(p_node->get_instance_id());
+}
+
+int WorldStreamer::get_cell_count() const {
+
+	return cells.size();
+}
+
+int WorldStreamer::get_loaded_cell_count() const {
+
+	int count = 0;
+	for (const Map<CellKey, Cell>::Element *E = cells.front(); E; E = E->next()) {
+		if (E->get().state == CELL_LOADED)
+			count++;
+	}
+	return count;
+}
+
+bool WorldStreamer::is_cell_loaded(const Vector3 &p_position) const {
+
+	const Map<CellKey, Cell>::Element *E = cells.find(_get_cell_key(p_position));
+	return E && E->get().state == CELL_LOADED;
+}
+
+String WorldStreamer::get_configuration_warning() const {
+
+	String warning = Spatial::get_configuration_warning();
+
+	if (unload_radius < load_radius) {
+		if (warning != String())
+			warning += "\n\n";
+		warning += TTR("Unload radius is smaller than load radius, cells at the edge will be reloaded repeatedly. Set it to at least the load radius.");
+	}
+
+	if (!is_inside_tree() || !Engine::get_singleton()->is_editor_hint())
+		return warning;
+
+	bool has_placeholder = false;
+	for (int i = 0; i < get_child_count(); i++) {
+		if (get_child(i)->get_scene_instance_load_placeholder()) {
+			has_placeholder = true;
+			break;
+		}
+	}
+
+	if (!has_placeholder) {
+		if (warning != String())
+			warning += "\n\n";
+		warning += TTR("WorldStreamer only streams child scenes instanced with \"Load As Placeholder\" enabled.");
+	}
+
+	return warning;
+}
+
+void WorldStreamer::_bind_methods() {
+
+	ClassDB::bind_method(D_METHOD("set_cell_size", "size"), &WorldStreamer::set_cell_size);
+	ClassDB::bind_method(D_METHOD("get_cell_size"), &WorldStreamer::get_cell_size);
+
+	ClassDB::bind_method(D_METHOD("set_load_radius", "radius"), &WorldStreamer::set_load_radius);
+	ClassDB::bind_method(D_METHOD("get_load_radius"), &WorldStreamer::get_load_radius);
+
+	ClassDB::bind_method(D_METHOD("set_unload_radius", "radius"), &WorldStreamer::set_unload_radius);
+	ClassDB::bind_method(D_METHOD("get_unload_radius"), &WorldStreamer::get_unload_radius);
+
+	ClassDB::bind_method(D_METHOD("set_max_queued_loads", "count"), &WorldStreamer::set_max_queued_loads);
+	ClassDB::bind_method(D_METHOD("get_max_queued_loads"), &WorldStreamer::get_max_queued_loads);
+
+	ClassDB::bind_method(D_METHOD("set_instance_budget_usec", "usec"), &WorldStreamer::set_instance_budget_usec);
+	ClassDB::bind_method(D_METHOD("get_instance_budget_usec"), &WorldStreamer::get_instance_budget_usec);
+
+	ClassDB::bind_method(D_METHOD("set_max_loaded_cells", "count"), &WorldStreamer::set_max_loaded_cells);
+	ClassDB::bind_method(D_METHOD("get_max_loaded_cells"), &WorldStreamer::get_max_loaded_cells);
+
+	ClassDB::bind_method(D_METHOD("add_focus_node", "node"), &WorldStreamer::add_focus_node);
+	ClassDB::bind_method(D_METHOD("remove_focus_node", "node"), &WorldStreamer::remove_focus_node);
+
+	ClassDB::bind_method(D_METHOD("get_cell_count"), &WorldStreamer::get_cell_count);
+	ClassDB::bind_method(D_METHOD("get_loaded_cell_count"), &WorldStreamer::get_loaded_cell_count);
+	ClassDB::bind_method(D_METHOD("is_cell_loaded", "position"), &WorldStreamer::is_cell_loaded);
+
+	ADD_PROPERTY(PropertyInfo(Variant::REAL, "cell_size", PROPERTY_HINT_RANGE, "1,1024,0.1,or_greater"), "set_cell_size", "get_cell_size");
+	ADD_PROPERTY(PropertyInfo(Variant::REAL, "load_radius", PROPERTY_HINT_RANGE, "0,4096,0.1,or_greater"), "set_load_radius", "get_load_radius");
+	ADD_PROPERTY(PropertyInfo(Variant::REAL, "unload_radius", PROPERTY_HINT_RANGE, "0,4096,0.1,or_greater"), "set_unload_radius", "get_unload_radius");
+	ADD_GROUP("Budget", "");
+	ADD_PROPERTY(PropertyInfo(Variant::INT, "max_queued_loads", PROPERTY_HINT_RANGE, "1,64,1"), "set_max_queued_loads", "get_max_queued_loads");
+	ADD_PROPERTY(PropertyInfo(Variant::INT, "instance_budget_usec", PROPERTY_HINT_RANGE, "0,33000,1"), "set_instance_budget_usec", "get_instance_budget_usec");
+	ADD_PROPERTY(PropertyInfo(Variant::INT, "max_loaded_cells", PROPERTY_HINT_RANGE, "0,4096,1"), "set_max_loaded_cells", "get_max_loaded_cells");
+
+	ADD_SIGNAL(MethodInfo("cell_loaded", PropertyInfo(Variant::VECTOR3, "position")));
+	ADD_SIGNAL(MethodInfo("cell_unloaded", PropertyInfo(Variant::VECTOR3, "position")));
+}
+
+WorldStreamer::WorldStreamer() {
+
+	cell_size = 64;
+	load_radius = 128;
+	unload_radius = 160;
+	max_queued_loads = 2;
+	instance_budget_usec = 2000;
+	max_loaded_cells = 0;
+
+	queued_count = 0;
+	loaded_count = 0;
+	collected = false;
+
+	thread = NULL;
+	load_mutex = Mutex::create();
+	load_sem = Semaphore::create();
+	exit_thread = false;
+}
+
+WorldStreamer::~WorldStreamer() {
+
+	_stop_thread();
+	_release_placeholders();
+
+	memdelete(load_mutex);
+	memdelete(load_sem);
+}
@@ -0,0 +1,178 @@
+/*************************************************************************/
+/*  world_streamer.h                                                     */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2019 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2019 Godot Engine contributors (cf. AUTHORS.md)    */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#ifndef WORLD_STREAMER_H
+#define WORLD_STREAMER_H
+
+#include "core/os/mutex.h"
+#include "core/os/semaphore.h"
+#include "core/os/thread.h"
+#include "scene/3d/spatial.h"
+
+class InstancePlaceholder;
+
+class WorldStreamer : public Spatial {
+
+	GDCLASS(WorldStreamer, Spatial);
+
+	union CellKey {
+
+		struct {
+			int16_t x;
+			int16_t y;
+			int16_t z;
+		};
+		uint64_t key;
+
+		_FORCE_INLINE_ bool operator<(const CellKey &p_key) const {
+			return key < p_key.key;
+		}
+
+		CellKey() { key = 0; }
+	};
+
+	enum CellState {
+		CELL_UNLOADED,
+		CELL_QUEUED, // waiting for or being processed by the loader thread
+		CELL_READY, // instanced by the loader thread, waiting to be added to the tree
+		CELL_LOADED,
+	};
+
+	struct Cell {
+
+		Vector<InstancePlaceholder *> placeholders;
+		Vector<Node *> instances;
+		Vector<ObjectID> instance_ids;
+		int added; // instances already added to the tree while CELL_READY
+		CellState state;
+		bool cancel; // went out of range while queued, drop the result
+		float distance;
+
+		Cell() {
+			added = 0;
+			state = CELL_UNLOADED;
+			cancel = false;
+			distance = 0;
+		}
+	};
+
+	struct LoadRequest {
+		CellKey key;
+		Vector<InstancePlaceholder *> placeholders;
+	};
+
+	struct LoadResult {
+		CellKey key;
+		Vector<Node *> instances;
+	};
+
+	struct SortCell {
+		CellKey key;
+		float distance;
+		bool operator<(const SortCell &p_cell) const { return distance < p_cell.distance; }
+	};
+
+	float cell_size;
+	float load_radius;
+	float unload_radius;
+	int max_queued_loads;
+	int instance_budget_usec;
+	int max_loaded_cells;
+
+	Vector<ObjectID> focus_nodes;
+
+	Map<CellKey, Cell> cells;
+	int queued_count;
+	int loaded_count;
+	bool collected;
+
+	Thread *thread;
+	Mutex *load_mutex;
+	Semaphore *load_sem;
+	bool exit_thread;
+	List<LoadRequest> load_queue;
+	List<LoadResult> load_results;
+
+	CellKey _get_cell_key(const Vector3 &p_pos) const;
+	Vector3 _get_cell_position(const CellKey &p_key) const;
+	float _get_cell_distance(const CellKey &p_key, const Vector<Vector3> &p_focus) const;
+
+	void _collect_placeholders();
+	void _release_placeholders();
+	void _queue_cell(const CellKey &p_key, Cell &r_cell);
+	bool _process_load_request();
+	void _flush_load_results();
+	bool _add_cell_instances(const CellKey &p_key, Cell &r_cell, uint64_t p_deadline);
+	void _unload_cell(const CellKey &p_key, Cell &r_cell);
+	void _gather_focus(Vector<Vector3> &r_focus) const;
+	void _update_streaming();
+
+	void _start_thread();
+	void _stop_thread();
+	static void _thread_func(void *p_ud);
+	void _thread_process();
+
+protected:
+	void _notification(int p_what);
+	static void _bind_methods();
+
+public:
+	void set_cell_size(float p_size);
+	float get_cell_size() const;
+
+	void set_load_radius(float p_radius);
+	float get_load_radius() const;
+
+	void set_unload_radius(float p_radius);
+	float get_unload_radius() const;
+
+	void set_max_queued_loads(int p_count);
+	int get_max_queued_loads() const;
+
+	void set_instance_budget_usec(int p_usec);
+	int get_instance_budget_usec() const;
+
+	void set_max_loaded_cells(int p_count);
+	int get_max_loaded_cells() const;
+
+	void add_focus_node(Node *p_node);
+	void remove_focus_node(Node *p_node);
+
+	int get_cell_count() const;
+	int get_loaded_cell_count() const;
+	bool is_cell_loaded(const Vector3 &p_position) const;
+
+	virtual String get_configuration_warning() const;
+
+	WorldStreamer();
+	~WorldStreamer();
+};
+
+#endif // WORLD_STREAMER_H
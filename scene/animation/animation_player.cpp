@@ -217,6 +217,48 @@ void AnimationPlayer::_notification(int p_what) {
 	}
 }
 
+HashMap<AnimationPlayer::CacheTemplateKey, Vector<AnimationPlayer::TrackTemplate>, AnimationPlayer::CacheTemplateKeyHasher> AnimationPlayer::cache_templates;
+
+Node *AnimationPlayer::_resolve_route(Node *p_root, const NodePath &p_path, const Vector<int> &p_route) {
+
+	if (p_route.size() == 0 || p_route.size() != p_path.get_name_count())
+		return NULL;
+
+	// sibling names are unique, so matching every name finds the same node as get_node()
+	Node *node = p_root;
+	for (int i = 0; i < p_route.size(); i++) {
+
+		if (p_route[i] >= node->get_child_count())
+			return NULL;
+		node = node->get_child(p_route[i]);
+		if (node->get_name() != p_path.get_name(i))
+			return NULL;
+	}
+
+	return node;
+}
+
+bool AnimationPlayer::_set_property(Object *p_object, const Vector<StringName> &p_subpath, MethodBind *p_setter, int p_setter_index, const Variant &p_value) {
+
+	// objects with a script instance may handle the property themselves
+	if (p_setter && !p_object->get_script_instance()) {
+		Variant::CallError ce;
+		if (p_setter_index >= 0) {
+			Variant index = p_setter_index;
+			const Variant *args[2] = { &index, &p_value };
+			p_setter->call(p_object, args, 2, ce);
+		} else {
+			const Variant *args[1] = { &p_value };
+			p_setter->call(p_object, args, 1, ce);
+		}
+		return ce.error == Variant::CallError::CALL_OK;
+	}
+
+	bool valid = false;
+	p_object->set_indexed(p_subpath, p_value, &valid);
+	return valid;
+}
+
 void AnimationPlayer::_ensure_node_caches(AnimationData *p_anim) {
 
 	// Already cached?
@@ -230,24 +272,79 @@ void AnimationPlayer::_ensure_node_caches(AnimationData *p_anim) {
 	Animation *a = p_anim->animation.operator->();
 
 	p_anim->node_cache.resize(a->get_track_count());
+	p_anim->property_cache.resize(a->get_track_count());
+	p_anim->bezier_cache.resize(a->get_track_count());
+	p_anim->track_cursors.resize(a->get_track_count());
+
+	TrackTemplate *templates = NULL;
+	if (parent->get_filename() != String()) {
+
+		CacheTemplateKey key;
+		key.animation = a->get_instance_id();
+		key.scene = parent->get_filename();
+
+		Vector<TrackTemplate> *E = cache_templates.getptr(key);
+		if (!E) {
+			if (cache_templates.size() >= CACHE_TEMPLATES_MAX) {
+				cache_templates.clear(); // animations that were freed leave their entries behind
+			}
+			cache_templates.set(key, Vector<TrackTemplate>());
+			E = cache_templates.getptr(key);
+		}
+		if (E->size() != a->get_track_count()) {
+			E->clear();
+			E->resize(a->get_track_count());
+		}
+		templates = E->ptrw();
+	}
 
 	for (int i = 0; i < a->get_track_count(); i++) {
 
 		p_anim->node_cache.write[i] = NULL;
+		p_anim->property_cache.write[i] = NULL;
+		p_anim->bezier_cache.write[i] = NULL;
+		p_anim->track_cursors.write[i] = -1;
+
+		NodePath path = a->track_get_path(i);
 		RES resource;
 		Vector<StringName> leftover_path;
-		Node *child = parent->get_node_and_resource(a->track_get_path(i), resource, leftover_path);
+		Node *child = templates ? _resolve_route(parent, path, templates[i].route) : NULL;
+		if (child) {
+			if (path.get_subname_count()) {
+				child->get_node_and_resource(NodePath(Vector<StringName>(), path.get_subnames(), false), resource, leftover_path);
+			}
+		} else {
+			child = parent->get_node_and_resource(path, resource, leftover_path);
+			if (child && templates) {
+
+				Vector<int> route;
+				for (Node *n = child; n && n != parent; n = n->get_parent()) {
+					route.push_back(n->get_index());
+				}
+				route.invert();
+				templates[i].route = _resolve_route(parent, path, route) == child ? route : Vector<int>();
+			}
+		}
 		if (!child) {
-			ERR_EXPLAIN("On Animation: '" + p_anim->name + "', couldn't resolve track:  '" + String(a->track_get_path(i)) + "'");
+			ERR_EXPLAIN("On Animation: '" + p_anim->name + "', couldn't resolve track:  '" + String(path) + "'");
 		}
 		ERR_CONTINUE(!child); // couldn't find the child node
-		uint32_t id = resource.is_valid() ? resource->get_instance_id() : child->get_instance_id();
+		ObjectID id = resource.is_valid() ? resource->get_instance_id() : child->get_instance_id();
 		int bone_idx = -1;
 
-		if (a->track_get_path(i).get_subname_count() == 1 && Object::cast_to<Skeleton>(child)) {
+		Skeleton *sk = Object::cast_to<Skeleton>(child);
+		if (path.get_subname_count() == 1 && sk) {
 
-			Skeleton *sk = Object::cast_to<Skeleton>(child);
-			bone_idx = sk->find_bone(a->track_get_path(i).get_subname(0));
+			String bone_name = path.get_subname(0);
+			int hint = templates ? templates[i].bone_idx : -1;
+			if (hint >= 0 && hint < sk->get_bone_count() && sk->get_bone_name(hint) == bone_name) {
+				bone_idx = hint;
+			} else {
+				bone_idx = sk->find_bone(bone_name);
+				if (templates) {
+					templates[i].bone_idx = bone_idx;
+				}
+			}
 			if (bone_idx == -1 || sk->is_bone_ignore_animation(bone_idx)) {
 
 				continue;
@@ -266,46 +363,41 @@ void AnimationPlayer::_ensure_node_caches(AnimationData *p_anim) {
 		if (!node_cache_map.has(key))
 			node_cache_map[key] = TrackNodeCache();
 
-		p_anim->node_cache.write[i] = &node_cache_map[key];
-		p_anim->node_cache[i]->path = a->track_get_path(i);
-		p_anim->node_cache[i]->node = child;
-		p_anim->node_cache[i]->resource = resource;
-		p_anim->node_cache[i]->node_2d = Object::cast_to<Node2D>(child);
+		TrackNodeCache *nc = &node_cache_map[key];
+		p_anim->node_cache.write[i] = nc;
+		nc->path = path;
+		nc->node = child;
+		nc->resource = resource;
+		nc->node_2d = Object::cast_to<Node2D>(child);
 		if (a->track_get_type(i) == Animation::TYPE_TRANSFORM) {
 			// special cases and caches for transform tracks
 
 			// cache spatial
-			p_anim->node_cache[i]->spatial = Object::cast_to<Spatial>(child);
+			nc->spatial = Object::cast_to<Spatial>(child);
 			// cache skeleton
-			p_anim->node_cache[i]->skeleton = Object::cast_to<Skeleton>(child);
-			if (p_anim->node_cache[i]->skeleton) {
-				if (a->track_get_path(i).get_subname_count() == 1) {
-					StringName bone_name = a->track_get_path(i).get_subname(0);
-
-					p_anim->node_cache[i]->bone_idx = p_anim->node_cache[i]->skeleton->find_bone(bone_name);
-					if (p_anim->node_cache[i]->bone_idx < 0) {
-						// broken track (nonexistent bone)
-						p_anim->node_cache[i]->skeleton = NULL;
-						p_anim->node_cache[i]->spatial = NULL;
-						ERR_CONTINUE(p_anim->node_cache[i]->bone_idx < 0);
-					}
+			nc->skeleton = sk;
+			if (nc->skeleton) {
+				if (path.get_subname_count() == 1) {
+					// resolved above, tracks of missing bones were skipped
+					nc->bone_idx = bone_idx;
 				} else {
 					// no property, just use spatialnode
-					p_anim->node_cache[i]->skeleton = NULL;
+					nc->skeleton = NULL;
 				}
 			}
 		}
 
 		if (a->track_get_type(i) == Animation::TYPE_VALUE) {
 
-			if (!p_anim->node_cache[i]->property_anim.has(a->track_get_path(i).get_concatenated_subnames())) {
+			StringName subnames = path.get_concatenated_subnames();
+			if (!nc->property_anim.has(subnames)) {
 
 				TrackNodeCache::PropertyAnim pa;
 				pa.subpath = leftover_path;
 				pa.object = resource.is_valid() ? (Object *)resource.ptr() : (Object *)child;
 				pa.special = SP_NONE;
-				pa.owner = p_anim->node_cache[i];
-				if (false && p_anim->node_cache[i]->node_2d) {
+				pa.owner = nc;
+				if (false && nc->node_2d) {
 
 					if (leftover_path.size() == 1 && leftover_path[0] == SceneStringNames::get_singleton()->transform_pos)
 						pa.special = SP_NODE2D_POS;
@@ -314,21 +406,30 @@ void AnimationPlayer::_ensure_node_caches(AnimationData *p_anim) {
 					else if (leftover_path.size() == 1 && leftover_path[0] == SceneStringNames::get_singleton()->transform_scale)
 						pa.special = SP_NODE2D_SCALE;
 				}
-				p_anim->node_cache[i]->property_anim[a->track_get_path(i).get_concatenated_subnames()] = pa;
+				if (leftover_path.size() == 1) {
+					pa.setter = ClassDB::get_property_setter_bind(pa.object->get_class_name(), leftover_path[0], &pa.setter_index);
+				}
+				nc->property_anim[subnames] = pa;
 			}
+			p_anim->property_cache.write[i] = &nc->property_anim[subnames];
 		}
 
 		if (a->track_get_type(i) == Animation::TYPE_BEZIER && leftover_path.size()) {
 
-			if (!p_anim->node_cache[i]->bezier_anim.has(a->track_get_path(i).get_concatenated_subnames())) {
+			StringName subnames = path.get_concatenated_subnames();
+			if (!nc->bezier_anim.has(subnames)) {
 
 				TrackNodeCache::BezierAnim ba;
 				ba.bezier_property = leftover_path;
 				ba.object = resource.is_valid() ? (Object *)resource.ptr() : (Object *)child;
-				ba.owner = p_anim->node_cache[i];
+				ba.owner = nc;
+				if (leftover_path.size() == 1) {
+					ba.setter = ClassDB::get_property_setter_bind(ba.object->get_class_name(), leftover_path[0], &ba.setter_index);
+				}
 
-				p_anim->node_cache[i]->bezier_anim[a->track_get_path(i).get_concatenated_subnames()] = ba;
+				nc->bezier_anim[subnames] = ba;
 			}
+			p_anim->bezier_cache.write[i] = &nc->bezier_anim[subnames];
 		}
 	}
 }
@@ -350,6 +451,7 @@ void AnimationPlayer::_animation_process_animation(AnimationData *p_anim, float
 		}
 
 		TrackNodeCache *nc = p_anim->node_cache[i];
+		int *cursor = &p_anim->track_cursors.write[i];
 
 		if (!nc)
 			continue; // no node cache for this track, skip it
@@ -371,7 +473,7 @@ void AnimationPlayer::_animation_process_animation(AnimationData *p_anim, float
 				Quat rot;
 				Vector3 scale;
 
-				Error err = a->transform_track_interpolate(i, p_time, &loc, &rot, &scale);
+				Error err = a->transform_track_interpolate(i, p_time, &loc, &rot, &scale, cursor);
 				//ERR_CONTINUE(err!=OK); //used for testing, should be removed
 
 				if (err != OK)
@@ -400,10 +502,8 @@ void AnimationPlayer::_animation_process_animation(AnimationData *p_anim, float
 
 				//StringName property=a->track_get_path(i).get_property();
 
-				Map<StringName, TrackNodeCache::PropertyAnim>::Element *E = nc->property_anim.find(a->track_get_path(i).get_concatenated_subnames());
-				ERR_CONTINUE(!E); //should it continue, or create a new one?
-
-				TrackNodeCache::PropertyAnim *pa = &E->get();
+				TrackNodeCache::PropertyAnim *pa = p_anim->property_cache[i];
+				ERR_CONTINUE(!pa); //should it continue, or create a new one?
 
 				Animation::UpdateMode update_mode = a->value_track_get_update_mode(i);
 
@@ -451,7 +551,7 @@ void AnimationPlayer::_animation_process_animation(AnimationData *p_anim, float
 
 				if (update_mode == Animation::UPDATE_CONTINUOUS || update_mode == Animation::UPDATE_CAPTURE || (p_delta == 0 && update_mode == Animation::UPDATE_DISCRETE)) { //delta == 0 means seek
 
-					Variant value = a->value_track_interpolate(i, p_time);
+					Variant value = a->value_track_interpolate(i, p_time, cursor);
 
 					if (value == Variant())
 						continue;
@@ -481,8 +581,7 @@ void AnimationPlayer::_animation_process_animation(AnimationData *p_anim, float
 						switch (pa->special) {
 
 							case SP_NONE: {
-								bool valid;
-								pa->object->set_indexed(pa->subpath, value, &valid); //you are not speshul
+								bool valid = _set_property(pa->object, pa->subpath, pa->setter, pa->setter_index, value); //you are not speshul
 #ifdef DEBUG_ENABLED
 								if (!valid) {
 									ERR_PRINTS("Failed setting track value '" + String(pa->owner->path) + "'. Check if property exists or the type of key is valid. Animation '" + a->get_name() + "' at node '" + get_path() + "'.");
@@ -567,10 +666,8 @@ void AnimationPlayer::_animation_process_animation(AnimationData *p_anim, float
 				if (!nc->node)
 					continue;
 
-				Map<StringName, TrackNodeCache::BezierAnim>::Element *E = nc->bezier_anim.find(a->track_get_path(i).get_concatenated_subnames());
-				ERR_CONTINUE(!E); //should it continue, or create a new one?
-
-				TrackNodeCache::BezierAnim *ba = &E->get();
+				TrackNodeCache::BezierAnim *ba = p_anim->bezier_cache[i];
+				ERR_CONTINUE(!ba); //should it continue, or create a new one?
 
 				float bezier = a->bezier_track_interpolate(i, p_time);
 				if (ba->accum_pass != accum_pass) {
@@ -832,6 +929,8 @@ void AnimationPlayer::_animation_process2(float p_delta, bool p_started) {
 void AnimationPlayer::_animation_update_transforms() {
 	{
 		Transform t;
+		// bone poses are handed to their skeleton together, its tracks are usually next to each other
+		Skeleton *skeleton = NULL;
 		for (int i = 0; i < cache_update_size; i++) {
 
 			TrackNodeCache *nc = cache_update[i];
@@ -842,13 +941,26 @@ void AnimationPlayer::_animation_update_transforms() {
 			t.basis.set_quat_scale(nc->rot_accum, nc->scale_accum);
 			if (nc->skeleton && nc->bone_idx >= 0) {
 
-				nc->skeleton->set_bone_pose(nc->bone_idx, t);
+				if (nc->skeleton != skeleton) {
+					if (skeleton) {
+						skeleton->set_bone_poses(skeleton_update_bones.ptr(), skeleton_update_poses.ptr(), skeleton_update_bones.size());
+					}
+					skeleton = nc->skeleton;
+					skeleton_update_bones.clear();
+					skeleton_update_poses.clear();
+				}
+				skeleton_update_bones.push_back(nc->bone_idx);
+				skeleton_update_poses.push_back(t);
 
 			} else if (nc->spatial) {
 
 				nc->spatial->set_transform(t);
 			}
 		}
+
+		if (skeleton) {
+			skeleton->set_bone_poses(skeleton_update_bones.ptr(), skeleton_update_poses.ptr(), skeleton_update_bones.size());
+		}
 	}
 
 	cache_update_size = 0;
@@ -862,8 +974,7 @@ void AnimationPlayer::_animation_update_transforms() {
 		switch (pa->special) {
 
 			case SP_NONE: {
-				bool valid;
-				pa->object->set_indexed(pa->subpath, pa->value_accum, &valid); //you are not speshul
+				bool valid = _set_property(pa->object, pa->subpath, pa->setter, pa->setter_index, pa->value_accum); //you are not speshul
 #ifdef DEBUG_ENABLED
 				if (!valid) {
 					ERR_PRINTS("Failed setting key at time " + rtos(playback.current.pos) + " in Animation '" + get_current_animation() + "' at Node '" + get_path() + "', Track '" + String(pa->owner->path) + "'. Check if property exists or the type of key is right for the property");
@@ -907,7 +1018,7 @@ void AnimationPlayer::_animation_update_transforms() {
 		TrackNodeCache::BezierAnim *ba = cache_update_bezier[i];
 
 		ERR_CONTINUE(ba->accum_pass != accum_pass);
-		ba->object->set_indexed(ba->bezier_property, ba->bezier_accum);
+		_set_property(ba->object, ba->bezier_property, ba->setter, ba->setter_index, ba->bezier_accum);
 	}
 
 	cache_update_bezier_size = 0;
@@ -1397,6 +1508,8 @@ void AnimationPlayer::clear_caches() {
 	for (Map<StringName, AnimationData>::Element *E = animation_set.front(); E; E = E->next()) {
 
 		E->get().node_cache.clear();
+		E->get().property_cache.clear();
+		E->get().bezier_cache.clear();
 	}
 
 	cache_update_size = 0;
@@ -31,6 +31,8 @@
 #ifndef ANIMATION_PLAYER_H
 #define ANIMATION_PLAYER_H
 
+#include "core/hash_map.h"
+#include "core/local_vector.h"
 #include "scene/2d/node_2d.h"
 #include "scene/3d/skeleton.h"
 #include "scene/3d/spatial.h"
@@ -85,7 +87,7 @@ private:
 	struct TrackNodeCache {
 
 		NodePath path;
-		uint32_t id;
+		ObjectID id;
 		RES resource;
 		Node *node;
 		Spatial *spatial;
@@ -114,12 +116,16 @@ private:
 			Variant value_accum;
 			uint64_t accum_pass;
 			Variant capture;
+			MethodBind *setter; // resolved for plain single-name properties
+			int setter_index;
 
 			PropertyAnim() :
 					owner(NULL),
 					special(SP_NONE),
 					object(NULL),
-					accum_pass(0) {}
+					accum_pass(0),
+					setter(NULL),
+					setter_index(-1) {}
 		};
 
 		Map<StringName, PropertyAnim> property_anim;
@@ -131,12 +137,16 @@ private:
 			float bezier_accum;
 			Object *object;
 			uint64_t accum_pass;
+			MethodBind *setter; // resolved for plain single-name properties
+			int setter_index;
 
 			BezierAnim() :
 					owner(NULL),
 					bezier_accum(0.0),
 					object(NULL),
-					accum_pass(0) {}
+					accum_pass(0),
+					setter(NULL),
+					setter_index(-1) {}
 		};
 
 		Map<StringName, BezierAnim> bezier_anim;
@@ -157,7 +167,7 @@ private:
 
 	struct TrackNodeCacheKey {
 
-		uint32_t id;
+		ObjectID id;
 		int bone_idx;
 
 		inline bool operator<(const TrackNodeCacheKey &p_right) const {
@@ -181,6 +191,41 @@ private:
 	int cache_update_bezier_size;
 	Set<TrackNodeCache *> playing_caches;
 
+	// scratch for applying the poses of one skeleton at once
+	LocalVector<int> skeleton_update_bones;
+	LocalVector<Transform> skeleton_update_poses;
+
+	// Instances of a scene resolve the tracks of its animations to the same
+	// child indices and bones. What the first instance found is kept and only
+	// verified by the next ones, instead of looking up names again.
+	struct TrackTemplate {
+		Vector<int> route; // child indices from the root node to the track node, empty if unknown
+		int bone_idx;
+
+		TrackTemplate() :
+				bone_idx(-1) {}
+	};
+
+	struct CacheTemplateKey {
+		ObjectID animation;
+		StringName scene;
+
+		bool operator==(const CacheTemplateKey &p_key) const { return animation == p_key.animation && scene == p_key.scene; }
+	};
+
+	struct CacheTemplateKeyHasher {
+		static _FORCE_INLINE_ uint32_t hash(const CacheTemplateKey &p_key) { return (uint32_t)hash_djb2_one_64(p_key.animation, p_key.scene.hash()); }
+	};
+
+	enum {
+		CACHE_TEMPLATES_MAX = 1024
+	};
+
+	static HashMap<CacheTemplateKey, Vector<TrackTemplate>, CacheTemplateKeyHasher> cache_templates;
+
+	static Node *_resolve_route(Node *p_root, const NodePath &p_path, const Vector<int> &p_route);
+	static bool _set_property(Object *p_object, const Vector<StringName> &p_subpath, MethodBind *p_setter, int p_setter_index, const Variant &p_value);
+
 	uint64_t accum_pass;
 	float speed_scale;
 	float default_blend_time;
@@ -189,6 +234,9 @@ private:
 		String name;
 		StringName next;
 		Vector<TrackNodeCache *> node_cache;
+		Vector<TrackNodeCache::PropertyAnim *> property_cache; // per value track, saves the lookup by subpath
+		Vector<TrackNodeCache::BezierAnim *> bezier_cache; // per bezier track
+		Vector<int> track_cursors; // last key sampled per track, speeds up sequential playback
 		Ref<Animation> animation;
 	};
 
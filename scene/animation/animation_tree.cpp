@@ -743,7 +743,7 @@ void AnimationTree::_clear_caches() {
 	cache_valid = false;
 }
 
-void AnimationTree::_process_graph(float p_delta) {
+bool AnimationTree::_prepare_process(float p_delta) {
 
 	_update_properties(); //if properties need updating, update them
 
@@ -755,14 +755,14 @@ void AnimationTree::_process_graph(float p_delta) {
 		ERR_PRINT("AnimationTree: root AnimationNode is not set, disabling playback.");
 		set_active(false);
 		cache_valid = false;
-		return;
+		return false;
 	}
 
 	if (!has_node(animation_player)) {
 		ERR_PRINT("AnimationTree: no valid AnimationPlayer path set, disabling playback");
 		set_active(false);
 		cache_valid = false;
-		return;
+		return false;
 	}
 
 	AnimationPlayer *player = Object::cast_to<AnimationPlayer>(get_node(animation_player));
@@ -793,12 +793,12 @@ void AnimationTree::_process_graph(float p_delta) {
 		ERR_PRINT("AnimationTree: path points to a node not an AnimationPlayer, disabling playback");
 		set_active(false);
 		cache_valid = false;
-		return;
+		return false;
 	}
 
 	if (!cache_valid) {
 		if (!_update_caches(player)) {
-			return;
+			return false;
 		}
 	}
 
@@ -837,99 +837,104 @@ void AnimationTree::_process_graph(float p_delta) {
 	}
 
 	if (!state.valid) {
-		return; //state is not valid. do nothing.
+		return false; //state is not valid. do nothing.
 	}
-	//apply value/transform/bezier blends to track caches and execute method/audio/animation tracks
-
-	{
 
-		bool can_call = is_inside_tree() && !Engine::get_singleton()->is_editor_hint();
+	return true;
+}
 
-		for (List<AnimationNode::AnimationState>::Element *E = state.animation_states.front(); E; E = E->next()) {
+void AnimationTree::_defer_track(const AnimationNode::AnimationState *p_state, int p_track, TrackCache *p_cache, float p_blend) {
 
-			const AnimationNode::AnimationState &as = E->get();
+	DeferredTrack dt;
+	dt.state = p_state;
+	dt.track = p_track;
+	dt.cache = p_cache;
+	dt.blend = p_blend;
+	deferred_tracks.push_back(dt);
+}
 
-			Ref<Animation> a = as.animation;
-			float time = as.time;
-			float delta = as.delta;
-			bool seeked = as.seeked;
+void AnimationTree::_process_graph(float p_delta) {
 
-			for (int i = 0; i < a->get_track_count(); i++) {
+	if (!_prepare_process(p_delta)) {
+		return;
+	}
 
-				NodePath path = a->track_get_path(i);
+	_blend_tracks();
+	_apply_tracks();
+}
 
-				ERR_CONTINUE(!track_cache.has(path));
+void AnimationTree::_blend_tracks() {
 
-				TrackCache *track = track_cache[path];
-				if (track->type != a->track_get_type(i)) {
-					continue; //may happen should not
-				}
+	deferred_tracks.clear();
 
-				track->root_motion = root_motion_track == path;
+	for (List<AnimationNode::AnimationState>::Element *E = state.animation_states.front(); E; E = E->next()) {
 
-				ERR_CONTINUE(!state.track_map.has(path));
-				int blend_idx = state.track_map[path];
+		const AnimationNode::AnimationState &as = E->get();
 
-				ERR_CONTINUE(blend_idx < 0 || blend_idx >= state.track_count);
+		Ref<Animation> a = as.animation;
+		float time = as.time;
+		float delta = as.delta;
 
-				float blend = (*as.track_blends)[blend_idx];
+		for (int i = 0; i < a->get_track_count(); i++) {
 
-				if (blend < CMP_EPSILON)
-					continue; //nothing to blend
+			NodePath path = a->track_get_path(i);
 
-				switch (track->type) {
+			ERR_CONTINUE(!track_cache.has(path));
 
-					case Animation::TYPE_TRANSFORM: {
+			TrackCache *track = track_cache[path];
+			if (track->type != a->track_get_type(i)) {
+				continue; //may happen should not
+			}
 
-						TrackCacheTransform *t = static_cast<TrackCacheTransform *>(track);
+			track->root_motion = root_motion_track == path;
 
-						if (track->root_motion) {
+			ERR_CONTINUE(!state.track_map.has(path));
+			int blend_idx = state.track_map[path];
 
-							if (t->process_pass != process_pass) {
+			ERR_CONTINUE(blend_idx < 0 || blend_idx >= state.track_count);
 
-								t->process_pass = process_pass;
-								t->loc = Vector3();
-								t->rot = Quat();
-								t->rot_blend_accum = 0;
-								t->scale = Vector3();
-							}
+			float blend = (*as.track_blends)[blend_idx];
 
-							float prev_time = time - delta;
-							if (prev_time < 0) {
-								if (!a->has_loop()) {
-									prev_time = 0;
-								} else {
-									prev_time = a->get_length() + prev_time;
-								}
-							}
+			if (blend < CMP_EPSILON)
+				continue; //nothing to blend
 
-							Vector3 loc[2];
-							Quat rot[2];
-							Vector3 scale[2];
+			switch (track->type) {
+				case Animation::TYPE_TRANSFORM: {
 
-							if (prev_time > time) {
+					TrackCacheTransform *t = static_cast<TrackCacheTransform *>(track);
 
-								Error err = a->transform_track_interpolate(i, prev_time, &loc[0], &rot[0], &scale[0]);
-								if (err != OK) {
-									continue;
-								}
+					if (track->root_motion) {
 
-								a->transform_track_interpolate(i, a->get_length(), &loc[1], &rot[1], &scale[1]);
+						if (t->process_pass != process_pass) {
 
-								t->loc += (loc[1] - loc[0]) * blend;
-								t->scale += (scale[1] - scale[0]) * blend;
-								Quat q = Quat().slerp(rot[0].normalized().inverse() * rot[1].normalized(), blend).normalized();
-								t->rot = (t->rot * q).normalized();
+							t->process_pass = process_pass;
+							t->loc = Vector3();
+							t->rot = Quat();
+							t->rot_blend_accum = 0;
+							t->scale = Vector3();
+						}
 
+						float prev_time = time - delta;
+						if (prev_time < 0) {
+							if (!a->has_loop()) {
 								prev_time = 0;
+							} else {
+								prev_time = a->get_length() + prev_time;
 							}
+						}
+
+						Vector3 loc[2];
+						Quat rot[2];
+						Vector3 scale[2];
+
+						if (prev_time > time) {
 
 							Error err = a->transform_track_interpolate(i, prev_time, &loc[0], &rot[0], &scale[0]);
 							if (err != OK) {
 								continue;
 							}
 
-							a->transform_track_interpolate(i, time, &loc[1], &rot[1], &scale[1]);
+							a->transform_track_interpolate(i, a->get_length(), &loc[1], &rot[1], &scale[1]);
 
 							t->loc += (loc[1] - loc[0]) * blend;
 							t->scale += (scale[1] - scale[0]) * blend;
@@ -937,289 +942,338 @@ void AnimationTree::_process_graph(float p_delta) {
 							t->rot = (t->rot * q).normalized();
 
 							prev_time = 0;
+						}
+
+						Error err = a->transform_track_interpolate(i, prev_time, &loc[0], &rot[0], &scale[0]);
+						if (err != OK) {
+							continue;
+						}
+
+						a->transform_track_interpolate(i, time, &loc[1], &rot[1], &scale[1]);
+
+						t->loc += (loc[1] - loc[0]) * blend;
+						t->scale += (scale[1] - scale[0]) * blend;
+						Quat q = Quat().slerp(rot[0].normalized().inverse() * rot[1].normalized(), blend).normalized();
+						t->rot = (t->rot * q).normalized();
+
+						prev_time = 0;
+
+					} else {
+						Vector3 loc;
+						Quat rot;
+						Vector3 scale;
+
+						Error err = a->transform_track_interpolate(i, time, &loc, &rot, &scale);
+						//ERR_CONTINUE(err!=OK); //used for testing, should be removed
+
+						if (t->process_pass != process_pass) {
+
+							t->process_pass = process_pass;
+							t->loc = loc;
+							t->rot = rot;
+							t->rot_blend_accum = 0;
+							t->scale = Vector3();
+						}
+
+						scale -= Vector3(1.0, 1.0, 1.0); //helps make it work properly with Add nodes
 
+						if (err != OK)
+							continue;
+
+						t->loc = t->loc.linear_interpolate(loc, blend);
+						if (t->rot_blend_accum == 0) {
+							t->rot = rot;
+							t->rot_blend_accum = blend;
 						} else {
-							Vector3 loc;
-							Quat rot;
-							Vector3 scale;
+							float rot_total = t->rot_blend_accum + blend;
+							t->rot = rot.slerp(t->rot, t->rot_blend_accum / rot_total).normalized();
+							t->rot_blend_accum = rot_total;
+						}
+						t->scale = t->scale.linear_interpolate(scale, blend);
+					}
 
-							Error err = a->transform_track_interpolate(i, time, &loc, &rot, &scale);
-							//ERR_CONTINUE(err!=OK); //used for testing, should be removed
+				} break;
+				case Animation::TYPE_VALUE: {
 
-							if (t->process_pass != process_pass) {
+					TrackCacheValue *t = static_cast<TrackCacheValue *>(track);
 
-								t->process_pass = process_pass;
-								t->loc = loc;
-								t->rot = rot;
-								t->rot_blend_accum = 0;
-								t->scale = Vector3();
-							}
+					Animation::UpdateMode update_mode = a->value_track_get_update_mode(i);
 
-							scale -= Vector3(1.0, 1.0, 1.0); //helps make it work properly with Add nodes
+					if (update_mode == Animation::UPDATE_CONTINUOUS || update_mode == Animation::UPDATE_CAPTURE) { //delta == 0 means seek
 
-							if (err != OK)
-								continue;
+						Variant value = a->value_track_interpolate(i, time);
 
-							t->loc = t->loc.linear_interpolate(loc, blend);
-							if (t->rot_blend_accum == 0) {
-								t->rot = rot;
-								t->rot_blend_accum = blend;
-							} else {
-								float rot_total = t->rot_blend_accum + blend;
-								t->rot = rot.slerp(t->rot, t->rot_blend_accum / rot_total).normalized();
-								t->rot_blend_accum = rot_total;
-							}
-							t->scale = t->scale.linear_interpolate(scale, blend);
+						if (value == Variant())
+							continue;
+
+						if (t->process_pass != process_pass) {
+							t->value = value;
+							t->process_pass = process_pass;
 						}
 
-					} break;
-					case Animation::TYPE_VALUE: {
+						Variant::interpolate(t->value, value, blend, t->value);
 
-						TrackCacheValue *t = static_cast<TrackCacheValue *>(track);
+						//discrete keys set properties, leave them for the main thread
+						_defer_track(&as, i, track, blend);
+					}
 
-						Animation::UpdateMode update_mode = a->value_track_get_update_mode(i);
+				} break;
+				case Animation::TYPE_BEZIER: {
 
-						if (update_mode == Animation::UPDATE_CONTINUOUS || update_mode == Animation::UPDATE_CAPTURE) { //delta == 0 means seek
+					TrackCacheBezier *t = static_cast<TrackCacheBezier *>(track);
 
-							Variant value = a->value_track_interpolate(i, time);
+					float bezier = a->bezier_track_interpolate(i, time);
 
-							if (value == Variant())
-								continue;
+					if (t->process_pass != process_pass) {
+						t->value = bezier;
+						t->process_pass = process_pass;
+					}
 
-							if (t->process_pass != process_pass) {
-								t->value = value;
-								t->process_pass = process_pass;
-							}
+					t->value = Math::lerp(t->value, bezier, blend);
 
-							Variant::interpolate(t->value, value, blend, t->value);
+				} break;
+				default: {
+					//method, audio and animation tracks have side effects, leave them for the main thread
+					_defer_track(&as, i, track, blend);
+				} break;
+			}
+		}
+	}
+}
 
-						} else if (delta != 0) {
+void AnimationTree::_apply_tracks() {
 
-							List<int> indices;
-							a->value_track_get_key_indices(i, time, delta, &indices);
+	bool can_call = is_inside_tree() && !Engine::get_singleton()->is_editor_hint();
 
-							for (List<int>::Element *F = indices.front(); F; F = F->next()) {
+	for (int d = 0; d < deferred_tracks.size(); d++) {
 
-								Variant value = a->track_get_key_value(i, F->get());
-								t->object->set_indexed(t->subpath, value);
-							}
-						}
+		const DeferredTrack &dt = deferred_tracks[d];
+		const AnimationNode::AnimationState &as = *dt.state;
 
-					} break;
-					case Animation::TYPE_METHOD: {
+		Ref<Animation> a = as.animation;
+		float time = as.time;
+		float delta = as.delta;
+		bool seeked = as.seeked;
+		int i = dt.track;
+		TrackCache *track = dt.cache;
+		float blend = dt.blend;
 
-						if (delta == 0) {
-							continue;
-						}
-						TrackCacheMethod *t = static_cast<TrackCacheMethod *>(track);
+		switch (track->type) {
 
-						List<int> indices;
+			case Animation::TYPE_VALUE: {
 
-						a->method_track_get_key_indices(i, time, delta, &indices);
+				TrackCacheValue *t = static_cast<TrackCacheValue *>(track);
 
-						for (List<int>::Element *F = indices.front(); F; F = F->next()) {
+				List<int> indices;
+				a->value_track_get_key_indices(i, time, delta, &indices);
 
-							StringName method = a->method_track_get_name(i, F->get());
-							Vector<Variant> params = a->method_track_get_params(i, F->get());
+				for (List<int>::Element *F = indices.front(); F; F = F->next()) {
 
-							int s = params.size();
+					Variant value = a->track_get_key_value(i, F->get());
+					t->object->set_indexed(t->subpath, value);
+				}
 
-							ERR_CONTINUE(s > VARIANT_ARG_MAX);
-							if (can_call) {
-								t->object->call_deferred(
-										method,
-										s >= 1 ? params[0] : Variant(),
-										s >= 2 ? params[1] : Variant(),
-										s >= 3 ? params[2] : Variant(),
-										s >= 4 ? params[3] : Variant(),
-										s >= 5 ? params[4] : Variant());
-							}
-						}
+			} break;
+		case Animation::TYPE_METHOD: {
 
-					} break;
-					case Animation::TYPE_BEZIER: {
+			if (delta == 0) {
+				continue;
+			}
+			TrackCacheMethod *t = static_cast<TrackCacheMethod *>(track);
 
-						TrackCacheBezier *t = static_cast<TrackCacheBezier *>(track);
+			List<int> indices;
 
-						float bezier = a->bezier_track_interpolate(i, time);
+			a->method_track_get_key_indices(i, time, delta, &indices);
 
-						if (t->process_pass != process_pass) {
-							t->value = bezier;
-							t->process_pass = process_pass;
-						}
+			for (List<int>::Element *F = indices.front(); F; F = F->next()) {
 
-						t->value = Math::lerp(t->value, bezier, blend);
+				StringName method = a->method_track_get_name(i, F->get());
+				Vector<Variant> params = a->method_track_get_params(i, F->get());
 
-					} break;
-					case Animation::TYPE_AUDIO: {
+				int s = params.size();
 
-						TrackCacheAudio *t = static_cast<TrackCacheAudio *>(track);
+				ERR_CONTINUE(s > VARIANT_ARG_MAX);
+				if (can_call) {
+					t->object->call_deferred(
+							method,
+							s >= 1 ? params[0] : Variant(),
+							s >= 2 ? params[1] : Variant(),
+							s >= 3 ? params[2] : Variant(),
+							s >= 4 ? params[3] : Variant(),
+							s >= 5 ? params[4] : Variant());
+				}
+			}
 
-						if (seeked) {
-							//find whathever should be playing
-							int idx = a->track_find_key(i, time);
-							if (idx < 0)
-								continue;
+		} break;
+		case Animation::TYPE_AUDIO: {
 
-							Ref<AudioStream> stream = a->audio_track_get_key_stream(i, idx);
-							if (!stream.is_valid()) {
-								t->object->call("stop");
-								t->playing = false;
-								playing_caches.erase(t);
-							} else {
-								float start_ofs = a->audio_track_get_key_start_offset(i, idx);
-								start_ofs += time - a->track_get_key_time(i, idx);
-								float end_ofs = a->audio_track_get_key_end_offset(i, idx);
-								float len = stream->get_length();
-
-								if (start_ofs > len - end_ofs) {
-									t->object->call("stop");
-									t->playing = false;
-									playing_caches.erase(t);
-									continue;
-								}
-
-								t->object->call("set_stream", stream);
-								t->object->call("play", start_ofs);
-
-								t->playing = true;
-								playing_caches.insert(t);
-								if (len && end_ofs > 0) { //force a end at a time
-									t->len = len - start_ofs - end_ofs;
-								} else {
-									t->len = 0;
-								}
-
-								t->start = time;
-							}
+			TrackCacheAudio *t = static_cast<TrackCacheAudio *>(track);
+
+			if (seeked) {
+				//find whathever should be playing
+				int idx = a->track_find_key(i, time);
+				if (idx < 0)
+					continue;
 
+				Ref<AudioStream> stream = a->audio_track_get_key_stream(i, idx);
+				if (!stream.is_valid()) {
+					t->object->call("stop");
+					t->playing = false;
+					playing_caches.erase(t);
+				} else {
+					float start_ofs = a->audio_track_get_key_start_offset(i, idx);
+					start_ofs += time - a->track_get_key_time(i, idx);
+					float end_ofs = a->audio_track_get_key_end_offset(i, idx);
+					float len = stream->get_length();
+
+					if (start_ofs > len - end_ofs) {
+						t->object->call("stop");
+						t->playing = false;
+						playing_caches.erase(t);
+						continue;
+					}
+
+					t->object->call("set_stream", stream);
+					t->object->call("play", start_ofs);
+
+					t->playing = true;
+					playing_caches.insert(t);
+					if (len && end_ofs > 0) { //force a end at a time
+						t->len = len - start_ofs - end_ofs;
+					} else {
+						t->len = 0;
+					}
+
+					t->start = time;
+				}
+
+			} else {
+				//find stuff to play
+				List<int> to_play;
+				a->track_get_key_indices_in_range(i, time, delta, &to_play);
+				if (to_play.size()) {
+					int idx = to_play.back()->get();
+
+					Ref<AudioStream> stream = a->audio_track_get_key_stream(i, idx);
+					if (!stream.is_valid()) {
+						t->object->call("stop");
+						t->playing = false;
+						playing_caches.erase(t);
+					} else {
+						float start_ofs = a->audio_track_get_key_start_offset(i, idx);
+						float end_ofs = a->audio_track_get_key_end_offset(i, idx);
+						float len = stream->get_length();
+
+						t->object->call("set_stream", stream);
+						t->object->call("play", start_ofs);
+
+						t->playing = true;
+						playing_caches.insert(t);
+						if (len && end_ofs > 0) { //force a end at a time
+							t->len = len - start_ofs - end_ofs;
 						} else {
-							//find stuff to play
-							List<int> to_play;
-							a->track_get_key_indices_in_range(i, time, delta, &to_play);
-							if (to_play.size()) {
-								int idx = to_play.back()->get();
-
-								Ref<AudioStream> stream = a->audio_track_get_key_stream(i, idx);
-								if (!stream.is_valid()) {
-									t->object->call("stop");
-									t->playing = false;
-									playing_caches.erase(t);
-								} else {
-									float start_ofs = a->audio_track_get_key_start_offset(i, idx);
-									float end_ofs = a->audio_track_get_key_end_offset(i, idx);
-									float len = stream->get_length();
-
-									t->object->call("set_stream", stream);
-									t->object->call("play", start_ofs);
-
-									t->playing = true;
-									playing_caches.insert(t);
-									if (len && end_ofs > 0) { //force a end at a time
-										t->len = len - start_ofs - end_ofs;
-									} else {
-										t->len = 0;
-									}
-
-									t->start = time;
-								}
-							} else if (t->playing) {
-
-								bool loop = a->has_loop();
-
-								bool stop = false;
-
-								if (!loop && time < t->start) {
-									stop = true;
-								} else if (t->len > 0) {
-									float len = t->start > time ? (a->get_length() - t->start) + time : time - t->start;
-
-									if (len > t->len) {
-										stop = true;
-									}
-								}
-
-								if (stop) {
-									//time to stop
-									t->object->call("stop");
-									t->playing = false;
-									playing_caches.erase(t);
-								}
-							}
+							t->len = 0;
 						}
 
-						float db = Math::linear2db(MAX(blend, 0.00001));
-						if (t->object->has_method("set_unit_db")) {
-							t->object->call("set_unit_db", db);
-						} else {
-							t->object->call("set_volume_db", db);
+						t->start = time;
+					}
+				} else if (t->playing) {
+
+					bool loop = a->has_loop();
+
+					bool stop = false;
+
+					if (!loop && time < t->start) {
+						stop = true;
+					} else if (t->len > 0) {
+						float len = t->start > time ? (a->get_length() - t->start) + time : time - t->start;
+
+						if (len > t->len) {
+							stop = true;
 						}
-					} break;
-					case Animation::TYPE_ANIMATION: {
+					}
 
-						TrackCacheAnimation *t = static_cast<TrackCacheAnimation *>(track);
+					if (stop) {
+						//time to stop
+						t->object->call("stop");
+						t->playing = false;
+						playing_caches.erase(t);
+					}
+				}
+			}
 
-						AnimationPlayer *player2 = Object::cast_to<AnimationPlayer>(t->object);
+			float db = Math::linear2db(MAX(blend, 0.00001));
+			if (t->object->has_method("set_unit_db")) {
+				t->object->call("set_unit_db", db);
+			} else {
+				t->object->call("set_volume_db", db);
+			}
+		} break;
+		case Animation::TYPE_ANIMATION: {
 
-						if (!player2)
-							continue;
+			TrackCacheAnimation *t = static_cast<TrackCacheAnimation *>(track);
 
-						if (delta == 0 || seeked) {
-							//seek
-							int idx = a->track_find_key(i, time);
-							if (idx < 0)
-								continue;
+			AnimationPlayer *player2 = Object::cast_to<AnimationPlayer>(t->object);
 
-							float pos = a->track_get_key_time(i, idx);
+			if (!player2)
+				continue;
 
-							StringName anim_name = a->animation_track_get_key_animation(i, idx);
-							if (String(anim_name) == "[stop]" || !player2->has_animation(anim_name))
-								continue;
+			if (delta == 0 || seeked) {
+				//seek
+				int idx = a->track_find_key(i, time);
+				if (idx < 0)
+					continue;
 
-							Ref<Animation> anim = player2->get_animation(anim_name);
+				float pos = a->track_get_key_time(i, idx);
 
-							float at_anim_pos;
+				StringName anim_name = a->animation_track_get_key_animation(i, idx);
+				if (String(anim_name) == "[stop]" || !player2->has_animation(anim_name))
+					continue;
 
-							if (anim->has_loop()) {
-								at_anim_pos = Math::fposmod(time - pos, anim->get_length()); //seek to loop
-							} else {
-								at_anim_pos = MAX(anim->get_length(), time - pos); //seek to end
-							}
+				Ref<Animation> anim = player2->get_animation(anim_name);
 
-							if (player2->is_playing() || seeked) {
-								player2->play(anim_name);
-								player2->seek(at_anim_pos);
-								t->playing = true;
-								playing_caches.insert(t);
-							} else {
-								player2->set_assigned_animation(anim_name);
-								player2->seek(at_anim_pos, true);
-							}
-						} else {
-							//find stuff to play
-							List<int> to_play;
-							a->track_get_key_indices_in_range(i, time, delta, &to_play);
-							if (to_play.size()) {
-								int idx = to_play.back()->get();
-
-								StringName anim_name = a->animation_track_get_key_animation(i, idx);
-								if (String(anim_name) == "[stop]" || !player2->has_animation(anim_name)) {
-
-									if (playing_caches.has(t)) {
-										playing_caches.erase(t);
-										player2->stop();
-										t->playing = false;
-									}
-								} else {
-									player2->play(anim_name);
-									t->playing = true;
-									playing_caches.insert(t);
-								}
-							}
-						}
+				float at_anim_pos;
 
-					} break;
+				if (anim->has_loop()) {
+					at_anim_pos = Math::fposmod(time - pos, anim->get_length()); //seek to loop
+				} else {
+					at_anim_pos = MAX(anim->get_length(), time - pos); //seek to end
+				}
+
+				if (player2->is_playing() || seeked) {
+					player2->play(anim_name);
+					player2->seek(at_anim_pos);
+					t->playing = true;
+					playing_caches.insert(t);
+				} else {
+					player2->set_assigned_animation(anim_name);
+					player2->seek(at_anim_pos, true);
 				}
+			} else {
+				//find stuff to play
+				List<int> to_play;
+				a->track_get_key_indices_in_range(i, time, delta, &to_play);
+				if (to_play.size()) {
+					int idx = to_play.back()->get();
+
+					StringName anim_name = a->animation_track_get_key_animation(i, idx);
+					if (String(anim_name) == "[stop]" || !player2->has_animation(anim_name)) {
+
+						if (playing_caches.has(t)) {
+							playing_caches.erase(t);
+							player2->stop();
+							t->playing = false;
+						}
+					} else {
+						player2->play(anim_name);
+						t->playing = true;
+						playing_caches.insert(t);
+					}
+				}
+			}
+
+		} break;
+			default: {
 			}
 		}
 	}
@@ -1287,17 +1341,81 @@ void AnimationTree::advance(float p_time) {
 	_process_graph(p_time);
 }
 
+void AnimationTree::_blend_tracks_job(uint32_t p_index, AnimationTree **p_trees) {
+
+	p_trees[p_index]->_blend_tracks();
+}
+
+void AnimationTree::_process_batch(uint64_t p_frame, float p_delta) {
+
+	if (blend_frame == p_frame) {
+		return; //already processed this frame, along with the tree that led the batch
+	}
+
+	// Gather every tree due this frame first, as preparing them may run scripts that add or remove trees.
+	Vector<ObjectID> pending;
+	for (SelfList<AnimationTree> *E = blend_list.first(); E; E = E->next()) {
+		AnimationTree *tree = E->self();
+		if (tree->active && tree->process_mode == process_mode && tree->blend_frame != p_frame) {
+			tree->blend_frame = p_frame;
+			pending.push_back(tree->get_instance_id());
+		}
+	}
+
+	// Graph evaluation stays on the main thread, as node resources keep per-call state and may be shared between trees.
+	Vector<AnimationTree *> batch;
+	Vector<ObjectID> batch_ids;
+	for (int i = 0; i < pending.size(); i++) {
+		AnimationTree *tree = Object::cast_to<AnimationTree>(ObjectDB::get_instance(pending[i]));
+		if (tree && tree->is_inside_tree() && tree->_prepare_process(p_delta)) {
+			batch.push_back(tree);
+			batch_ids.push_back(pending[i]);
+		}
+	}
+
+	if (batch.size() == 0) {
+		return;
+	}
+
+	if (batch.size() == 1) {
+		batch[0]->_blend_tracks();
+	} else {
+		blend_pool->do_work(batch.size(), this, &AnimationTree::_blend_tracks_job, batch.ptrw());
+	}
+
+	for (int i = 0; i < batch.size(); i++) {
+		// Applying may run setters and scripts, which could free trees further down the batch.
+		AnimationTree *tree = Object::cast_to<AnimationTree>(ObjectDB::get_instance(batch_ids[i]));
+		if (tree) {
+			tree->_apply_tracks();
+		}
+	}
+}
+
 void AnimationTree::_notification(int p_what) {
 
 	if (active && p_what == NOTIFICATION_INTERNAL_PHYSICS_PROCESS && process_mode == ANIMATION_PROCESS_PHYSICS) {
-		_process_graph(get_physics_process_delta_time());
+		if (blend_pool) {
+			_process_batch(Engine::get_singleton()->get_physics_frames(), get_physics_process_delta_time());
+		} else {
+			_process_graph(get_physics_process_delta_time());
+		}
 	}
 
 	if (active && p_what == NOTIFICATION_INTERNAL_PROCESS && process_mode == ANIMATION_PROCESS_IDLE) {
-		_process_graph(get_process_delta_time());
+		if (blend_pool) {
+			_process_batch(Engine::get_singleton()->get_idle_frames(), get_process_delta_time());
+		} else {
+			_process_graph(get_process_delta_time());
+		}
+	}
+
+	if (p_what == NOTIFICATION_ENTER_TREE) {
+		blend_list.add(&blend_item);
 	}
 
 	if (p_what == NOTIFICATION_EXIT_TREE) {
+		blend_list.remove(&blend_item);
 		_clear_caches();
 		if (last_animation_player) {
 
@@ -1569,7 +1687,24 @@ void AnimationTree::_bind_methods() {
 	BIND_ENUM_CONSTANT(ANIMATION_PROCESS_MANUAL);
 }
 
-AnimationTree::AnimationTree() {
+ThreadWorkPool *AnimationTree::blend_pool = NULL;
+SelfList<AnimationTree>::List AnimationTree::blend_list;
+
+void AnimationTree::set_threaded_blending(bool p_enable) {
+
+#ifndef NO_THREADS
+	if (p_enable && !blend_pool) {
+		blend_pool = memnew(ThreadWorkPool);
+		blend_pool->init();
+	} else if (!p_enable && blend_pool) {
+		memdelete(blend_pool);
+		blend_pool = NULL;
+	}
+#endif
+}
+
+AnimationTree::AnimationTree() :
+		blend_item(this) {
 
 	process_mode = ANIMATION_PROCESS_IDLE;
 	active = false;
@@ -1578,6 +1713,7 @@ AnimationTree::AnimationTree() {
 	started = true;
 	properties_dirty = true;
 	last_animation_player = 0;
+	blend_frame = (uint64_t)-1; //not processed yet
 }
 
 AnimationTree::~AnimationTree() {
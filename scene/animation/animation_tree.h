@@ -32,6 +32,8 @@
 #define ANIMATION_GRAPH_PLAYER_H
 
 #include "animation_player.h"
+#include "core/os/thread_work_pool.h"
+#include "core/self_list.h"
 #include "scene/3d/skeleton.h"
 #include "scene/3d/spatial.h"
 #include "scene/resources/animation.h"
@@ -270,6 +272,30 @@ private:
 	bool _update_caches(AnimationPlayer *player);
 	void _process_graph(float p_delta);
 
+	// Tracks with side effects (method calls, audio, discrete values, sub-animations),
+	// collected while blending and executed afterwards on the main thread.
+	struct DeferredTrack {
+		const AnimationNode::AnimationState *state;
+		int track;
+		TrackCache *cache;
+		float blend;
+	};
+
+	Vector<DeferredTrack> deferred_tracks;
+
+	bool _prepare_process(float p_delta);
+	void _defer_track(const AnimationNode::AnimationState *p_state, int p_track, TrackCache *p_cache, float p_blend);
+	void _blend_tracks();
+	void _apply_tracks();
+
+	static ThreadWorkPool *blend_pool;
+	static SelfList<AnimationTree>::List blend_list;
+	SelfList<AnimationTree> blend_item;
+	uint64_t blend_frame;
+
+	void _process_batch(uint64_t p_frame, float p_delta);
+	void _blend_tracks_job(uint32_t p_index, AnimationTree **p_trees);
+
 	uint64_t setup_pass;
 	uint64_t process_pass;
 
@@ -335,6 +361,9 @@ public:
 	void rename_parameter(const String &p_base, const String &p_new_base);
 
 	uint64_t get_last_process_pass() const;
+
+	static void set_threaded_blending(bool p_enable);
+
 	AnimationTree();
 	~AnimationTree();
 };
@@ -34,6 +34,9 @@
 
 #include "skeleton_ik.h"
 
+#include "core/engine.h"
+#include "core/os/threaded_array_processor.h"
+
 #ifndef _3D_DISABLED
 
 FabrikInverseKinematic::ChainItem *FabrikInverseKinematic::ChainItem::find_child(const BoneId p_bone_id) {
@@ -133,24 +136,71 @@ bool FabrikInverseKinematic::build_chain(Task *p_task, bool p_force_simple_chain
 			break;
 		}
 	}
+
+	chain.length = 0;
+	if (chain.tips.size()) {
+		for (const ChainItem *ci = chain.tips[0].chain_item; ci; ci = ci->parent_item) {
+			chain.length += ci->length;
+		}
+	}
+
 	return true;
 }
 
-void FabrikInverseKinematic::update_chain(const Skeleton *p_sk, ChainItem *p_chain_item) {
+void FabrikInverseKinematic::update_chain(const Skeleton *p_sk, ChainItem *p_chain_item, bool p_keep_positions) {
 
 	if (!p_chain_item)
 		return;
 
 	p_chain_item->initial_transform = p_sk->get_bone_global_pose(p_chain_item->bone);
-	p_chain_item->current_pos = p_chain_item->initial_transform.origin;
+	if (!p_keep_positions) {
+		p_chain_item->current_pos = p_chain_item->initial_transform.origin;
+	}
 
 	for (int i = p_chain_item->childs.size() - 1; 0 <= i; --i) {
-		update_chain(p_sk, &p_chain_item->childs.write[i]);
+		update_chain(p_sk, &p_chain_item->childs.write[i], p_keep_positions);
 	}
 }
 
+bool FabrikInverseKinematic::solve_unreachable(Task *p_task) {
+
+	Chain &chain(p_task->chain);
+
+	const Vector3 origin(chain.chain_root.initial_transform.origin);
+	const Vector3 to_goal(chain.tips[0].end_effector->goal_transform.origin - origin);
+	const real_t distance(to_goal.length());
+
+	if (chain.length <= CMP_EPSILON || distance < chain.length) {
+		return false;
+	}
+
+	// Iterating would only converge to a straight chain pointing at the goal, so build it directly
+	const Vector3 direction(to_goal / distance);
+	Vector3 pos(origin);
+
+	ChainItem *ci(&chain.chain_root);
+	while (ci) {
+		ci->current_pos = pos;
+
+		if (!ci->childs.empty()) {
+			ChainItem &child(ci->childs.write[0]);
+			ci->current_ori = direction;
+			pos += direction * child.length;
+			ci = &child;
+		} else {
+			ci = NULL;
+		}
+	}
+
+	return true;
+}
+
 void FabrikInverseKinematic::solve_simple(Task *p_task, bool p_solve_magnet) {
 
+	if (!p_solve_magnet && solve_unreachable(p_task)) {
+		return;
+	}
+
 	real_t distance_to_goal(1e4);
 	real_t previous_distance_to_goal(0);
 	int can_solve(p_task->max_iterations);
@@ -280,22 +330,43 @@ void FabrikInverseKinematic::make_goal(Task *p_task, const Transform &p_inverse_
 	}
 }
 
-void FabrikInverseKinematic::solve(Task *p_task, real_t blending_delta, bool override_tip_basis, bool p_use_magnet, const Vector3 &p_magnet_position) {
+bool FabrikInverseKinematic::prepare_solve(Task *p_task) {
+
+	if (p_task->blending_delta <= 0.01f) {
+		return false; // Skip solving
+	}
+
+	make_goal(p_task, p_task->skeleton->get_global_transform().affine_inverse().scaled(p_task->skeleton->get_global_transform().get_basis().get_scale()), p_task->blending_delta);
 
-	if (blending_delta <= 0.01f) {
-		return; // Skip solving
+	// Warm starting keeps the previous solution as initial guess, which usually converges in a couple of iterations
+	update_chain(p_task->skeleton, &p_task->chain.chain_root, p_task->warm_start && p_task->solved);
+
+	if (p_task->use_magnet && p_task->chain.middle_chain_item) {
+		p_task->chain.magnet_position = p_task->chain.middle_chain_item->initial_transform.origin.linear_interpolate(p_task->magnet_position, p_task->blending_delta);
 	}
 
-	make_goal(p_task, p_task->skeleton->get_global_transform().affine_inverse().scaled(p_task->skeleton->get_global_transform().get_basis().get_scale()), blending_delta);
+	return true;
+}
 
-	update_chain(p_task->skeleton, &p_task->chain.chain_root);
+void FabrikInverseKinematic::solve_positions(Task *p_task) {
 
-	if (p_use_magnet && p_task->chain.middle_chain_item) {
-		p_task->chain.magnet_position = p_task->chain.middle_chain_item->initial_transform.origin.linear_interpolate(p_magnet_position, blending_delta);
+	if (p_task->use_magnet && p_task->chain.middle_chain_item) {
 		solve_simple(p_task, true);
 	}
 	solve_simple(p_task, false);
 
+	p_task->solved = true;
+}
+
+void FabrikInverseKinematic::apply_solution(Task *p_task) {
+
+	Skeleton *sk(p_task->skeleton);
+
+	// Local poses are computed from the new global pose of the parent in the chain,
+	// instead of reading it back from the skeleton after each bone is set.
+	Transform parent_pose;
+	BoneId parent_bone(-1);
+
 	// Assign new bone position.
 	ChainItem *ci(&p_task->chain.chain_root);
 	while (ci) {
@@ -314,13 +385,24 @@ void FabrikInverseKinematic::solve(Task *p_task, real_t blending_delta, bool ove
 			}
 		} else {
 			// Set target orientation to tip
-			if (override_tip_basis)
+			if (p_task->override_tip_basis)
 				new_bone_pose.basis = p_task->chain.tips[0].end_effector->goal_transform.basis;
 			else
 				new_bone_pose.basis = new_bone_pose.basis * p_task->chain.tips[0].end_effector->goal_transform.basis;
 		}
 
-		p_task->skeleton->set_bone_global_pose(ci->bone, new_bone_pose);
+		const BoneId parent(sk->get_bone_parent(ci->bone));
+		Transform local_pose(new_bone_pose);
+		if (parent >= 0) {
+			if (parent != parent_bone) {
+				parent_pose = sk->get_bone_global_pose(parent);
+			}
+			local_pose = parent_pose.affine_inverse() * new_bone_pose;
+		}
+		sk->set_bone_pose(ci->bone, sk->get_bone_rest(ci->bone).affine_inverse() * local_pose);
+
+		parent_pose = new_bone_pose;
+		parent_bone = ci->bone;
 
 		if (!ci->childs.empty())
 			ci = &ci->childs.write[0];
@@ -329,6 +411,81 @@ void FabrikInverseKinematic::solve(Task *p_task, real_t blending_delta, bool ove
 	}
 }
 
+void FabrikInverseKinematic::solve(Task *p_task, real_t blending_delta, bool override_tip_basis, bool p_use_magnet, const Vector3 &p_magnet_position) {
+
+	p_task->blending_delta = blending_delta;
+	p_task->override_tip_basis = override_tip_basis;
+	p_task->use_magnet = p_use_magnet;
+	p_task->magnet_position = p_magnet_position;
+
+	if (!prepare_solve(p_task)) {
+		return;
+	}
+
+	solve_positions(p_task);
+	apply_solution(p_task);
+}
+
+void FabrikInverseKinematic::_solve_positions_thread(uint32_t p_index, Task **p_tasks) {
+
+	solve_positions(p_tasks[p_index]);
+}
+
+void FabrikInverseKinematic::solve_tasks(Task **p_tasks, int p_count) {
+
+	// Chains on the same skeleton may share bones, each one has to see the result of the previous.
+	// So every pass takes at most one task per skeleton.
+	Vector<Task *> pending;
+	for (int i = 0; i < p_count; i++) {
+		pending.push_back(p_tasks[i]);
+	}
+
+	FabrikInverseKinematic solver;
+	Vector<Task *> pass;
+	Vector<Task *> next;
+
+	while (pending.size()) {
+
+		pass.clear();
+		next.clear();
+
+		for (int i = 0; i < pending.size(); i++) {
+
+			bool busy = false;
+			for (int j = 0; j < pass.size(); j++) {
+				if (pass[j]->skeleton == pending[i]->skeleton) {
+					busy = true;
+					break;
+				}
+			}
+
+			if (busy) {
+				next.push_back(pending[i]);
+			} else {
+				pass.push_back(pending[i]);
+			}
+		}
+
+		for (int i = pass.size() - 1; 0 <= i; --i) {
+			if (!prepare_solve(pass[i])) {
+				pass.remove(i);
+			}
+		}
+
+		if (pass.size() > 1) {
+			thread_process_array(pass.size(), &solver, &FabrikInverseKinematic::_solve_positions_thread, pass.ptrw());
+		} else if (pass.size() == 1) {
+			solve_positions(pass[0]);
+		}
+
+		for (int i = 0; i < pass.size(); i++) {
+			apply_solution(pass[i]);
+		}
+
+		pending = next;
+	}
+}
+
 void SkeletonIK::_validate_property(PropertyInfo &property) const {
 
 	if (property.name == "root_bone" || property.name == "tip_bone") {
@@ -387,6 +544,9 @@ void SkeletonIK::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("set_max_iterations", "iterations"), &SkeletonIK::set_max_iterations);
 	ClassDB::bind_method(D_METHOD("get_max_iterations"), &SkeletonIK::get_max_iterations);
 
+	ClassDB::bind_method(D_METHOD("set_warm_start", "enable"), &SkeletonIK::set_warm_start);
+	ClassDB::bind_method(D_METHOD("is_warm_start_enabled"), &SkeletonIK::is_warm_start_enabled);
+
 	ClassDB::bind_method(D_METHOD("start", "one_time"), &SkeletonIK::start, DEFVAL(false));
 	ClassDB::bind_method(D_METHOD("stop"), &SkeletonIK::stop);
 
@@ -400,6 +560,7 @@ void SkeletonIK::_bind_methods() {
 	ADD_PROPERTY(PropertyInfo(Variant::NODE_PATH, "target_node"), "set_target_node", "get_target_node");
 	ADD_PROPERTY(PropertyInfo(Variant::REAL, "min_distance"), "set_min_distance", "get_min_distance");
 	ADD_PROPERTY(PropertyInfo(Variant::INT, "max_iterations"), "set_max_iterations", "get_max_iterations");
+	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "warm_start"), "set_warm_start", "is_warm_start_enabled");
 }
 
 void SkeletonIK::_notification(int p_what) {
@@ -407,16 +568,19 @@ void SkeletonIK::_notification(int p_what) {
 		case NOTIFICATION_ENTER_TREE: {
 			skeleton = Object::cast_to<Skeleton>(get_parent());
 			reload_chain();
+			running_iks.add_last(&running_list);
 		} break;
 		case NOTIFICATION_INTERNAL_PROCESS: {
 
-			if (target_node_override)
-				reload_goal();
-
-			_solve_chain();
+			// The first SkeletonIK processed in a frame solves all the running ones together,
+			// the others find their chain already solved.
+			if (solved_frame != Engine::get_singleton()->get_idle_frames()) {
+				_solve_running_chains();
+			}
 
 		} break;
 		case NOTIFICATION_EXIT_TREE: {
+			running_iks.remove(&running_list);
 			reload_chain();
 		} break;
 	}
@@ -429,9 +593,12 @@ SkeletonIK::SkeletonIK() :
 		use_magnet(false),
 		min_distance(0.01),
 		max_iterations(10),
+		warm_start(false),
 		skeleton(NULL),
 		target_node_override(NULL),
-		task(NULL) {
+		task(NULL),
+		running_list(this),
+		solved_frame(~uint64_t(0)) {
 
 	set_process_priority(1);
 }
@@ -518,6 +685,14 @@ void SkeletonIK::set_max_iterations(int p_iterations) {
 	max_iterations = p_iterations;
 }
 
+void SkeletonIK::set_warm_start(bool p_enable) {
+	warm_start = p_enable;
+}
+
+bool SkeletonIK::is_warm_start_enabled() const {
+	return warm_start;
+}
+
 bool SkeletonIK::is_running() {
 	return is_processing_internal();
 }
@@ -568,10 +743,49 @@ void SkeletonIK::reload_goal() {
 	FabrikInverseKinematic::set_goal(task, _get_target_transform());
 }
 
+void SkeletonIK::_update_task_settings() {
+	task->min_distance = min_distance;
+	task->max_iterations = max_iterations;
+	task->blending_delta = interpolation;
+	task->override_tip_basis = override_tip_basis;
+	task->use_magnet = use_magnet;
+	task->magnet_position = magnet_position;
+	task->warm_start = warm_start;
+}
+
 void SkeletonIK::_solve_chain() {
 	if (!task)
 		return;
+	_update_task_settings();
 	FabrikInverseKinematic::solve(task, interpolation, override_tip_basis, use_magnet, magnet_position);
 }
 
+void SkeletonIK::_solve_running_chains() {
+
+	const uint64_t frame = Engine::get_singleton()->get_idle_frames();
+	Vector<FabrikInverseKinematic::Task *> tasks;
+
+	for (SelfList<SkeletonIK> *E = running_iks.first(); E; E = E->next()) {
+
+		SkeletonIK *ik = E->self();
+		if (ik->solved_frame == frame || !ik->is_processing_internal() || !ik->can_process())
+			continue;
+
+		ik->solved_frame = frame;
+
+		if (ik->target_node_override)
+			ik->reload_goal();
+
+		if (!ik->task)
+			continue;
+
+		ik->_update_task_settings();
+		tasks.push_back(ik->task);
+	}
+
+	FabrikInverseKinematic::solve_tasks(tasks.ptrw(), tasks.size());
+}
+
+SelfList<SkeletonIK>::List SkeletonIK::running_iks;
+
 #endif // _3D_DISABLED
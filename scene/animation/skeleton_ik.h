@@ -38,6 +38,7 @@
  */
 
 #include "core/math/transform.h"
+#include "core/self_list.h"
 #include "scene/3d/skeleton.h"
 
 class FabrikInverseKinematic {
@@ -95,6 +96,12 @@ class FabrikInverseKinematic {
 		ChainItem *middle_chain_item;
 		Vector<ChainTip> tips;
 		Vector3 magnet_position;
+		/// Sum of the bone lengths from the root to the first tip
+		real_t length;
+
+		Chain() :
+				middle_chain_item(NULL),
+				length(0) {}
 	};
 
 public:
@@ -114,20 +121,37 @@ public:
 
 		Transform goal_global_transform;
 
+		// Solve settings
+		real_t blending_delta;
+		bool override_tip_basis;
+		bool use_magnet;
+		Vector3 magnet_position;
+		bool warm_start;
+
+		/// True once the chain positions hold a previous solution
+		bool solved;
+
 		Task() :
 				skeleton(NULL),
 				min_distance(0.01),
 				max_iterations(10),
-				root_bone(-1) {}
+				root_bone(-1),
+				blending_delta(1),
+				override_tip_basis(true),
+				use_magnet(false),
+				warm_start(false),
+				solved(false) {}
 	};
 
 private:
 	/// Init a chain that starts from the root to tip
 	static bool build_chain(Task *p_task, bool p_force_simple_chain = true);
 
-	static void update_chain(const Skeleton *p_sk, ChainItem *p_chain_item);
+	static void update_chain(const Skeleton *p_sk, ChainItem *p_chain_item, bool p_keep_positions);
 
 	static void solve_simple(Task *p_task, bool p_solve_magnet);
+	/// Places the chain in a straight line toward the goal, returns false if the goal is reachable
+	static bool solve_unreachable(Task *p_task);
 	/// Special solvers that solve only chains with one end effector
 	static void solve_simple_backwards(Chain &r_chain, bool p_solve_magnet);
 	static void solve_simple_forwards(Chain &r_chain, bool p_solve_magnet);
@@ -139,6 +163,17 @@ public:
 	static void set_goal(Task *p_task, const Transform &p_goal);
 	static void make_goal(Task *p_task, const Transform &p_inverse_transf, real_t blending_delta);
 	static void solve(Task *p_task, real_t blending_delta, bool override_tip_basis, bool p_use_magnet, const Vector3 &p_magnet_position);
+	/// Solves several tasks using their own settings, chains of different skeletons are solved in parallel
+	static void solve_tasks(Task **p_tasks, int p_count);
+
+private:
+	/// Reads the skeleton, returns false if there is nothing to solve
+	static bool prepare_solve(Task *p_task);
+	/// Only touches the task, so it can run on any thread
+	static void solve_positions(Task *p_task);
+	static void apply_solution(Task *p_task);
+
+	void _solve_positions_thread(uint32_t p_index, Task **p_tasks);
 };
 
 class SkeletonIK : public Node {
@@ -155,11 +190,16 @@ class SkeletonIK : public Node {
 
 	real_t min_distance;
 	int max_iterations;
+	bool warm_start;
 
 	Skeleton *skeleton;
 	Spatial *target_node_override;
 	FabrikInverseKinematic::Task *task;
 
+	SelfList<SkeletonIK> running_list;
+	uint64_t solved_frame;
+	static SelfList<SkeletonIK>::List running_iks;
+
 protected:
 	virtual void
 	_validate_property(PropertyInfo &property) const;
@@ -201,6 +241,9 @@ public:
 	void set_max_iterations(int p_iterations);
 	int get_max_iterations() const { return max_iterations; }
 
+	void set_warm_start(bool p_enable);
+	bool is_warm_start_enabled() const;
+
 	Skeleton *get_parent_skeleton() const { return skeleton; }
 
 	bool is_running();
@@ -212,7 +255,9 @@ private:
 	Transform _get_target_transform();
 	void reload_chain();
 	void reload_goal();
+	void _update_task_settings();
 	void _solve_chain();
+	static void _solve_running_chains();
 };
 
 #endif // _3D_DISABLED
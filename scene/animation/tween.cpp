@@ -31,6 +31,7 @@
 #include "tween.h"
 
 #include "core/method_bind_ext.gen.inc"
+#include "scene/main/scene_tree.h"
 
 void Tween::_add_pending_command(StringName p_key, const Variant &p_arg1, const Variant &p_arg2, const Variant &p_arg3, const Variant &p_arg4, const Variant &p_arg5, const Variant &p_arg6, const Variant &p_arg7, const Variant &p_arg8, const Variant &p_arg9, const Variant &p_arg10) {
 
@@ -151,30 +152,7 @@ void Tween::_notification(int p_what) {
 
 		case NOTIFICATION_ENTER_TREE: {
 
-			if (!is_active()) {
-				//make sure that a previous process state was not saved
-				//only process if "processing" is set
-				set_physics_process_internal(false);
-				set_process_internal(false);
-			}
-		} break;
-		case NOTIFICATION_READY: {
-
-		} break;
-		case NOTIFICATION_INTERNAL_PROCESS: {
-			if (tween_process_mode == TWEEN_PROCESS_PHYSICS)
-				break;
-
-			if (is_active())
-				_tween_process(get_process_delta_time());
-		} break;
-		case NOTIFICATION_INTERNAL_PHYSICS_PROCESS: {
-
-			if (tween_process_mode == TWEEN_PROCESS_IDLE)
-				break;
-
-			if (is_active())
-				_tween_process(get_physics_process_delta_time());
+			_schedule();
 		} break;
 		case NOTIFICATION_EXIT_TREE: {
 
@@ -491,6 +469,19 @@ bool Tween::_apply_tween_value(InterpolateData &p_data, Variant &value) {
 		case INTER_PROPERTY:
 		case FOLLOW_PROPERTY:
 		case TARGETING_PROPERTY: {
+			if (p_data.setter && !object->get_script_instance()) {
+				Variant::CallError ce;
+				if (p_data.setter_index >= 0) {
+					Variant index = p_data.setter_index;
+					const Variant *args[2] = { &index, &value };
+					p_data.setter->call(object, args, 2, ce);
+				} else {
+					const Variant *args[1] = { &value };
+					p_data.setter->call(object, args, 1, ce);
+				}
+				return ce.error == Variant::CallError::CALL_OK;
+			}
+
 			bool valid = false;
 			object->set_indexed(p_data.key, value, &valid);
 			return valid;
@@ -565,7 +556,7 @@ void Tween::_tween_process(float p_delta) {
 		else if (prev_delaying) {
 
 			_apply_tween_value(data, data.initial_val);
-			emit_signal("tween_started", object, NodePath(Vector<StringName>(), data.key, false));
+			emit_signal(SNAME("tween_started"), object, data.key_path);
 		}
 
 		if (data.elapsed > (data.delay + data.duration)) {
@@ -613,13 +604,13 @@ void Tween::_tween_process(float p_delta) {
 		} else {
 			Variant result = _run_equation(data);
 			_apply_tween_value(data, result);
-			emit_signal("tween_step", object, NodePath(Vector<StringName>(), data.key, false), data.elapsed, result);
+			emit_signal(SNAME("tween_step"), object, data.key_path, data.elapsed, result);
 		}
 
 		if (data.finish) {
 			_apply_tween_value(data, data.final_val);
 			data.elapsed = 0;
-			emit_signal("tween_completed", object, NodePath(Vector<StringName>(), data.key, false));
+			emit_signal(SNAME("tween_completed"), object, data.key_path);
 			// not repeat mode, remove completed action
 			if (!repeat)
 				call_deferred("_remove_by_uid", data.uid);
@@ -634,7 +625,12 @@ void Tween::_tween_process(float p_delta) {
 
 void Tween::set_tween_process_mode(TweenProcessMode p_mode) {
 
+	if (tween_process_mode == p_mode)
+		return;
+
+	_unschedule();
 	tween_process_mode = p_mode;
+	_schedule();
 }
 
 Tween::TweenProcessMode Tween::get_tween_process_mode() const {
@@ -644,19 +640,33 @@ Tween::TweenProcessMode Tween::get_tween_process_mode() const {
 
 bool Tween::is_active() const {
 
-	return is_processing_internal() || is_physics_processing_internal();
+	return active;
 }
 
 void Tween::set_active(bool p_active) {
 
-	if (is_active() == p_active)
+	if (active == p_active)
 		return;
 
-	switch (tween_process_mode) {
+	active = p_active;
+	if (active)
+		_schedule();
+	else
+		_unschedule();
+}
 
-		case TWEEN_PROCESS_IDLE: set_process_internal(p_active); break;
-		case TWEEN_PROCESS_PHYSICS: set_physics_process_internal(p_active); break;
-	}
+void Tween::_schedule() {
+
+	if (scheduled_index >= 0 || !active || !is_inside_tree())
+		return;
+	get_tree()->_schedule_tween(this);
+}
+
+void Tween::_unschedule() {
+
+	if (scheduled_index < 0)
+		return;
+	get_tree()->_unschedule_tween(this);
 }
 
 bool Tween::is_repeat() const {
@@ -827,6 +837,16 @@ void Tween::_remove_by_uid(int uid) {
 void Tween::_push_interpolate_data(InterpolateData &p_data) {
 	pending_update++;
 	p_data.uid = ++uid;
+	p_data.key_path = NodePath(Vector<StringName>(), p_data.key, false);
+	p_data.setter = NULL;
+	p_data.setter_index = -1;
+	if (p_data.key.size() == 1 && (p_data.type == INTER_PROPERTY || p_data.type == FOLLOW_PROPERTY || p_data.type == TARGETING_PROPERTY)) {
+		// Skips the per-step property lookup of Object::set(); objects that
+		// have a script instance when the value is applied still go through set_indexed().
+		Object *object = ObjectDB::get_instance(p_data.id);
+		if (object)
+			p_data.setter = ClassDB::get_property_setter_bind(object->get_class_name(), p_data.key[0], &p_data.setter_index);
+	}
 	interpolates.push_back(p_data);
 	pending_update--;
 }
@@ -1425,6 +1445,8 @@ Tween::Tween() {
 	speed_scale = 1;
 	pending_update = 0;
 	uid = 0;
+	active = false;
+	scheduled_index = -1;
 }
 
 Tween::~Tween() {
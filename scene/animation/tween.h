@@ -101,6 +101,9 @@ private:
 		int args;
 		Variant arg[5];
 		int uid;
+		NodePath key_path; // reported by the tween signals
+		MethodBind *setter; // resolved at push time for plain single-name properties
+		int setter_index;
 	};
 
 	String autoplay;
@@ -109,6 +112,10 @@ private:
 	float speed_scale;
 	mutable int pending_update;
 	int uid;
+	bool active;
+	int scheduled_index; // slot in the SceneTree tween schedule, -1 when not ticking
+
+	friend class SceneTree;
 
 	List<InterpolateData> interpolates;
 
@@ -136,6 +143,9 @@ private:
 	void _remove_by_uid(int uid);
 	void _push_interpolate_data(InterpolateData &p_data);
 
+	void _schedule();
+	void _unschedule();
+
 protected:
 	bool _set(const StringName &p_name, const Variant &p_value);
 	bool _get(const StringName &p_name, Variant &r_ret) const;
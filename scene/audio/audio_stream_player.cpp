@@ -31,6 +31,7 @@
 #include "audio_stream_player.h"
 
 #include "core/engine.h"
+#include "servers/audio/audio_mix_kernels.h"
 
 void AudioStreamPlayer::_mix_internal(bool p_fadeout) {
 
@@ -47,16 +48,11 @@ void AudioStreamPlayer::_mix_internal(bool p_fadeout) {
 
 	stream_playback->mix(buffer, pitch_scale, buffer_size);
 
-	//multiply volume interpolating to avoid clicks if this changes
+	//volume is interpolated to avoid clicks if this changes, applied while mixing into the targets
 	float target_volume = p_fadeout ? -80.0 : volume_db;
 	float vol = Math::db2linear(mix_volume_db);
 	float vol_inc = (Math::db2linear(target_volume) - vol) / float(buffer_size);
 
-	for (int i = 0; i < buffer_size; i++) {
-		buffer[i] *= vol;
-		vol += vol_inc;
-	}
-
 	//set volume for next mix
 	mix_volume_db = target_volume;
 
@@ -83,9 +79,7 @@ void AudioStreamPlayer::_mix_internal(bool p_fadeout) {
 	for (int c = 0; c < 4; c++) {
 		if (!targets[c])
 			break;
-		for (int i = 0; i < buffer_size; i++) {
-			targets[c][i] += buffer[i];
-		}
+		AudioMixKernels::mix_ramp(buffer, targets[c], buffer_size, AudioFrame(vol, vol), AudioFrame(vol_inc, vol_inc));
 	}
 }
 
@@ -51,6 +51,14 @@ void BaseButton::_unpress_group() {
 	}
 }
 
+void BaseButton::_update_if_draw_changed() {
+
+	if (drawn.valid && drawn.draw_mode == get_draw_mode() && drawn.pressed == status.pressed && drawn.hovering == status.hovering && drawn.focused == has_focus())
+		return;
+
+	update();
+}
+
 void BaseButton::_gui_input(Ref<InputEvent> p_event) {
 
 	if (status.disabled) // no interaction with disabled button
@@ -111,7 +119,7 @@ void BaseButton::_gui_input(Ref<InputEvent> p_event) {
 */
 				status.press_attempt = false;
 			}
-			update();
+			_update_if_draw_changed();
 			return;
 		}
 
@@ -157,7 +165,7 @@ void BaseButton::_gui_input(Ref<InputEvent> p_event) {
 			status.press_attempt = false;
 		}
 
-		update();
+		_update_if_draw_changed();
 	}
 
 	Ref<InputEventMouseMotion> mm = p_event;
@@ -167,7 +175,7 @@ void BaseButton::_gui_input(Ref<InputEvent> p_event) {
 			bool last_press_inside = status.pressing_inside;
 			status.pressing_inside = has_point(mm->get_position());
 			if (last_press_inside != status.pressing_inside)
-				update();
+				_update_if_draw_changed();
 		}
 	}
 
@@ -234,7 +242,7 @@ void BaseButton::_gui_input(Ref<InputEvent> p_event) {
 			}
 
 			accept_event();
-			update();
+			_update_if_draw_changed();
 		}
 	}
 }
@@ -244,26 +252,26 @@ void BaseButton::_notification(int p_what) {
 	if (p_what == NOTIFICATION_MOUSE_ENTER) {
 
 		status.hovering = true;
-		update();
+		_update_if_draw_changed();
 	}
 
 	if (p_what == NOTIFICATION_MOUSE_EXIT) {
 		status.hovering = false;
-		update();
+		_update_if_draw_changed();
 	}
 	if (p_what == NOTIFICATION_DRAG_BEGIN || p_what == NOTIFICATION_SCROLL_BEGIN) {
 
 		if (status.press_attempt) {
 			status.press_attempt = false;
 			status.pressing_button = 0;
-			update();
+			_update_if_draw_changed();
 		}
 	}
 
 	if (p_what == NOTIFICATION_FOCUS_ENTER) {
 
 		status.hovering = true;
-		update();
+		_update_if_draw_changed();
 	}
 
 	if (p_what == NOTIFICATION_FOCUS_EXIT) {
@@ -272,21 +280,34 @@ void BaseButton::_notification(int p_what) {
 			status.press_attempt = false;
 			status.pressing_button = 0;
 			status.hovering = false;
-			update();
+			_update_if_draw_changed();
 		} else if (status.hovering) {
 			status.hovering = false;
-			update();
+			_update_if_draw_changed();
 		}
 	}
 
+	if (p_what == NOTIFICATION_DRAW) {
+
+		drawn.valid = true;
+		drawn.draw_mode = get_draw_mode();
+		drawn.pressed = status.pressed;
+		drawn.hovering = status.hovering;
+		drawn.focused = has_focus();
+	}
+
 	if (p_what == NOTIFICATION_ENTER_TREE) {
 	}
 
 	if (p_what == NOTIFICATION_EXIT_TREE) {
+
+		drawn.valid = false;
 	}
 
 	if (p_what == NOTIFICATION_VISIBILITY_CHANGED && !is_visible_in_tree()) {
 
+		drawn.valid = false;
+
 		if (!toggle_mode) {
 			status.pressed = false;
 		}
@@ -575,6 +596,7 @@ BaseButton::BaseButton() {
 	status.pressing_inside = false;
 	status.disabled = false;
 	status.pressing_button = 0;
+	drawn.valid = false;
 	set_focus_mode(FOCUS_ALL);
 	enabled_focus_mode = FOCUS_ALL;
 	action_mode = ACTION_MODE_BUTTON_RELEASE;
@@ -68,9 +68,22 @@ private:
 
 	} status;
 
+	// State the button was last drawn with, so input that doesn't change how
+	// it looks doesn't rebuild its canvas commands.
+	struct DrawnState {
+
+		bool valid;
+		int draw_mode;
+		bool pressed;
+		bool hovering;
+		bool focused;
+
+	} drawn;
+
 	Ref<ButtonGroup> button_group;
 
 	void _unpress_group();
+	void _update_if_draw_changed();
 
 protected:
 	virtual void pressed();
@@ -29,7 +29,7 @@
 /*************************************************************************/
 
 #include "container.h"
-#include "core/message_queue.h"
+#include "scene/main/viewport.h"
 #include "scene/scene_string_names.h"
 
 void Container::_child_minsize_changed() {
@@ -88,6 +88,12 @@ void Container::_sort_children() {
 	if (!is_inside_tree())
 		return;
 
+	if (!is_visible_in_tree()) {
+		// Laid out again once it becomes visible, see NOTIFICATION_VISIBILITY_CHANGED.
+		pending_sort = false;
+		return;
+	}
+
 	notification(NOTIFICATION_SORT_CHILDREN);
 	emit_signal(SceneStringNames::get_singleton()->sort_children);
 	pending_sort = false;
@@ -140,7 +146,11 @@ void Container::queue_sort() {
 	if (pending_sort)
 		return;
 
-	MessageQueue::get_singleton()->push_call(this, "_sort_children");
+	// Hidden containers are sorted when they become visible again.
+	if (!is_visible_in_tree())
+		return;
+
+	get_viewport()->_gui_queue_sort(this);
 	pending_sort = true;
 }
 
@@ -152,6 +162,13 @@ void Container::_notification(int p_what) {
 			pending_sort = false;
 			queue_sort();
 		} break;
+		case NOTIFICATION_EXIT_TREE: {
+
+			if (sort_item.in_list()) {
+				get_viewport()->_gui_unqueue_sort(this);
+			}
+			pending_sort = false;
+		} break;
 		case NOTIFICATION_RESIZED: {
 
 			queue_sort();
@@ -194,7 +211,8 @@ void Container::_bind_methods() {
 	ADD_SIGNAL(MethodInfo("sort_children"));
 }
 
-Container::Container() {
+Container::Container() :
+		sort_item(this) {
 
 	pending_sort = false;
 }
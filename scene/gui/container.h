@@ -31,6 +31,7 @@
 #ifndef CONTAINER_H
 #define CONTAINER_H
 
+#include "core/self_list.h"
 #include "scene/gui/control.h"
 
 class Container : public Control {
@@ -38,9 +39,12 @@ class Container : public Control {
 	GDCLASS(Container, Control);
 
 	bool pending_sort;
+	SelfList<Container> sort_item;
 	void _sort_children();
 	void _child_minsize_changed();
 
+	friend class Viewport;
+
 protected:
 	void queue_sort();
 	virtual void add_child_notify(Node *p_child);
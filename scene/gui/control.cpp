@@ -423,28 +423,40 @@ void Control::_resize(const Size2 &p_size) {
 
 void Control::add_child_notify(Node *p_child) {
 
+	// Other canvas items under a control make its root fall back to the tree walk when picking.
+	_pick_rect_changed();
+
 	Control *child_c = Object::cast_to<Control>(p_child);
 	if (!child_c)
 		return;
 
 	if (child_c->data.theme.is_null() && data.theme_owner) {
 		_propagate_theme_changed(child_c, data.theme_owner); //need to propagate here, since many controls may require setting up stuff
+	} else if (child_c->data.theme.is_valid() && data.theme_owner) {
+		_propagate_theme_changed(child_c, child_c, false); //items missing in its theme now come from ours, drop cached lookups
 	}
 }
 
 void Control::remove_child_notify(Node *p_child) {
 
+	_pick_rect_changed();
+
 	Control *child_c = Object::cast_to<Control>(p_child);
 	if (!child_c)
 		return;
 
 	if (child_c->data.theme_owner && child_c->data.theme.is_null()) {
 		_propagate_theme_changed(child_c, NULL);
+	} else if (child_c->data.theme.is_valid() && data.theme_owner) {
+		_propagate_theme_changed(child_c, child_c, false);
 	}
 }
 
 void Control::_update_canvas_item_transform() {
 
+	if (VisualServer::get_singleton()->is_null_mode())
+		return;
+
 	Transform2D xform = _get_internal_transform();
 	xform[2] += get_position();
 
@@ -476,6 +488,7 @@ void Control::_notification(int p_notification) {
 		case NOTIFICATION_ENTER_CANVAS: {
 
 			data.parent = Object::cast_to<Control>(get_parent());
+			get_viewport()->_gui_invalidate_pick();
 
 			if (is_set_as_toplevel()) {
 				data.SI = get_viewport()->_gui_add_subwindow_control(this);
@@ -550,6 +563,8 @@ void Control::_notification(int p_notification) {
 		} break;
 		case NOTIFICATION_EXIT_CANVAS: {
 
+			get_viewport()->_gui_invalidate_pick();
+
 			if (data.parent_canvas_item) {
 
 				data.parent_canvas_item->disconnect("item_rect_changed", this, "_size_changed");
@@ -590,6 +605,7 @@ void Control::_notification(int p_notification) {
 			if (data.parent)
 				data.parent->update();
 			update();
+			_pick_rect_changed();
 
 			if (data.SI) {
 				get_viewport()->_gui_set_subwindow_order_dirty();
@@ -632,6 +648,8 @@ void Control::_notification(int p_notification) {
 		} break;
 		case NOTIFICATION_THEME_CHANGED: {
 
+			_clear_theme_cache();
+			_pick_rect_changed();
 			update();
 		} break;
 		case NOTIFICATION_MODAL_CLOSE: {
@@ -640,6 +658,8 @@ void Control::_notification(int p_notification) {
 		} break;
 		case NOTIFICATION_VISIBILITY_CHANGED: {
 
+			_pick_rect_changed();
+
 			if (!is_visible_in_tree()) {
 
 				if (get_viewport() != NULL)
@@ -690,6 +710,23 @@ bool Control::has_point(const Point2 &p_point) const {
 	return Rect2(Point2(), get_size()).has_point(p_point);
 }
 
+bool Control::_get_pick_rect(Rect2 &r_rect) const {
+
+	if (get_script_instance() && get_script_instance()->has_method(SceneStringNames::get_singleton()->has_point)) {
+		return false;
+	}
+
+	r_rect = Rect2(Point2(), get_size());
+	return true;
+}
+
+void Control::_pick_rect_changed() {
+
+	if (is_inside_tree()) {
+		get_viewport()->_gui_invalidate_pick();
+	}
+}
+
 void Control::set_drag_forwarding(Control *p_target) {
 
 	if (p_target)
@@ -803,7 +840,7 @@ Size2 Control::get_minimum_size() const {
 	return Size2();
 }
 
-Ref<Texture> Control::get_icon(const StringName &p_name, const StringName &p_type) const {
+Ref<Texture> Control::_resolve_icon(const StringName &p_name, const StringName &p_type) const {
 
 	if (p_type == StringName() || p_type == "") {
 
@@ -840,7 +877,7 @@ Ref<Texture> Control::get_icon(const StringName &p_name, const StringName &p_typ
 	return Theme::get_default()->get_icon(p_name, type);
 }
 
-Ref<Shader> Control::get_shader(const StringName &p_name, const StringName &p_type) const {
+Ref<Shader> Control::_resolve_shader(const StringName &p_name, const StringName &p_type) const {
 	if (p_type == StringName() || p_type == "") {
 
 		const Ref<Shader> *sdr = data.shader_override.getptr(p_name);
@@ -876,7 +913,7 @@ Ref<Shader> Control::get_shader(const StringName &p_name, const StringName &p_ty
 	return Theme::get_default()->get_shader(p_name, type);
 }
 
-Ref<StyleBox> Control::get_stylebox(const StringName &p_name, const StringName &p_type) const {
+Ref<StyleBox> Control::_resolve_stylebox(const StringName &p_name, const StringName &p_type) const {
 
 	if (p_type == StringName() || p_type == "") {
 		const Ref<StyleBox> *style = data.style_override.getptr(p_name);
@@ -919,7 +956,7 @@ Ref<StyleBox> Control::get_stylebox(const StringName &p_name, const StringName &
 	}
 	return Theme::get_default()->get_stylebox(p_name, type);
 }
-Ref<Font> Control::get_font(const StringName &p_name, const StringName &p_type) const {
+Ref<Font> Control::_resolve_font(const StringName &p_name, const StringName &p_type) const {
 
 	if (p_type == StringName() || p_type == "") {
 		const Ref<Font> *font = data.font_override.getptr(p_name);
@@ -956,7 +993,7 @@ Ref<Font> Control::get_font(const StringName &p_name, const StringName &p_type)
 
 	return Theme::get_default()->get_font(p_name, type);
 }
-Color Control::get_color(const StringName &p_name, const StringName &p_type) const {
+Color Control::_resolve_color(const StringName &p_name, const StringName &p_type) const {
 
 	if (p_type == StringName() || p_type == "") {
 		const Color *color = data.color_override.getptr(p_name);
@@ -991,7 +1028,7 @@ Color Control::get_color(const StringName &p_name, const StringName &p_type) con
 	return Theme::get_default()->get_color(p_name, type);
 }
 
-int Control::get_constant(const StringName &p_name, const StringName &p_type) const {
+int Control::_resolve_constant(const StringName &p_name, const StringName &p_type) const {
 
 	if (p_type == StringName() || p_type == "") {
 		const int *constant = data.constant_override.getptr(p_name);
@@ -1026,6 +1063,117 @@ int Control::get_constant(const StringName &p_name, const StringName &p_type) co
 	return Theme::get_default()->get_constant(p_name, type);
 }
 
+Control::ThemeCache *Control::_get_theme_cache() const {
+
+	if (!data.theme_cache) {
+		data.theme_cache = memnew(ThemeCache);
+		data.theme_cache->version = Theme::get_version();
+	} else if (data.theme_cache->version != Theme::get_version()) {
+		//some theme changed, maybe one this control doesn't use, but there is no telling
+		data.theme_cache->icons.clear();
+		data.theme_cache->shaders.clear();
+		data.theme_cache->styleboxes.clear();
+		data.theme_cache->fonts.clear();
+		data.theme_cache->colors.clear();
+		data.theme_cache->constants.clear();
+		data.theme_cache->version = Theme::get_version();
+	}
+
+	return data.theme_cache;
+}
+
+void Control::_clear_theme_cache() {
+
+	if (data.theme_cache) {
+		memdelete(data.theme_cache);
+		data.theme_cache = NULL;
+	}
+}
+
+Ref<Texture> Control::get_icon(const StringName &p_name, const StringName &p_type) const {
+
+	ThemeCache *cache = _get_theme_cache();
+	ThemeItemKey key(p_name, p_type);
+
+	const Ref<Texture> *cached = cache->icons.getptr(key);
+	if (cached)
+		return *cached;
+
+	Ref<Texture> icon = _resolve_icon(p_name, p_type);
+	cache->icons.set(key, icon);
+	return icon;
+}
+
+Ref<Shader> Control::get_shader(const StringName &p_name, const StringName &p_type) const {
+
+	ThemeCache *cache = _get_theme_cache();
+	ThemeItemKey key(p_name, p_type);
+
+	const Ref<Shader> *cached = cache->shaders.getptr(key);
+	if (cached)
+		return *cached;
+
+	Ref<Shader> shader = _resolve_shader(p_name, p_type);
+	cache->shaders.set(key, shader);
+	return shader;
+}
+
+Ref<StyleBox> Control::get_stylebox(const StringName &p_name, const StringName &p_type) const {
+
+	ThemeCache *cache = _get_theme_cache();
+	ThemeItemKey key(p_name, p_type);
+
+	const Ref<StyleBox> *cached = cache->styleboxes.getptr(key);
+	if (cached)
+		return *cached;
+
+	Ref<StyleBox> stylebox = _resolve_stylebox(p_name, p_type);
+	cache->styleboxes.set(key, stylebox);
+	return stylebox;
+}
+
+Ref<Font> Control::get_font(const StringName &p_name, const StringName &p_type) const {
+
+	ThemeCache *cache = _get_theme_cache();
+	ThemeItemKey key(p_name, p_type);
+
+	const Ref<Font> *cached = cache->fonts.getptr(key);
+	if (cached)
+		return *cached;
+
+	Ref<Font> font = _resolve_font(p_name, p_type);
+	cache->fonts.set(key, font);
+	return font;
+}
+
+Color Control::get_color(const StringName &p_name, const StringName &p_type) const {
+
+	ThemeCache *cache = _get_theme_cache();
+	ThemeItemKey key(p_name, p_type);
+
+	const Color *cached = cache->colors.getptr(key);
+	if (cached)
+		return *cached;
+
+	Color color = _resolve_color(p_name, p_type);
+	cache->colors.set(key, color);
+	return color;
+}
+
+int Control::get_constant(const StringName &p_name, const StringName &p_type) const {
+
+	ThemeCache *cache = _get_theme_cache();
+	ThemeItemKey key(p_name, p_type);
+
+	const int *cached = cache->constants.getptr(key);
+	if (cached)
+		return *cached;
+
+	int constant = _resolve_constant(p_name, p_type);
+	cache->constants.set(key, constant);
+	return constant;
+}
+
 bool Control::has_icon_override(const StringName &p_name) const {
 
 	const Ref<Texture> *tex = data.icon_override.getptr(p_name);
@@ -1352,6 +1500,7 @@ void Control::_size_changed() {
 			item_rect_changed(size_changed);
 			_change_notify_margins();
 			_notify_transform();
+			get_viewport()->_gui_invalidate_pick();
 		}
 
 		if (pos_changed && !size_changed) {
@@ -2498,6 +2647,7 @@ void Control::set_mouse_filter(MouseFilter p_filter) {
 
 	ERR_FAIL_INDEX(p_filter, 3);
 	data.mouse_filter = p_filter;
+	_pick_rect_changed();
 }
 
 Control::MouseFilter Control::get_mouse_filter() const {
@@ -2545,6 +2695,7 @@ void Control::set_rotation(float p_radians) {
 	data.rotation = p_radians;
 	update();
 	_notify_transform();
+	_pick_rect_changed();
 	_change_notify("rect_rotation");
 }
 
@@ -2572,6 +2723,7 @@ void Control::set_pivot_offset(const Vector2 &p_pivot) {
 	data.pivot_offset = p_pivot;
 	update();
 	_notify_transform();
+	_pick_rect_changed();
 	_change_notify("rect_pivot_offset");
 }
 
@@ -2585,6 +2737,7 @@ void Control::set_scale(const Vector2 &p_scale) {
 	data.scale = p_scale;
 	update();
 	_notify_transform();
+	_pick_rect_changed();
 }
 Vector2 Control::get_scale() const {
 
@@ -2658,6 +2811,7 @@ void Control::get_argument_options(const StringName &p_function, int p_idx, List
 void Control::set_clip_contents(bool p_clip) {
 
 	data.clip_contents = p_clip;
+	_pick_rect_changed();
 	update();
 }
 
@@ -2996,7 +3150,10 @@ Control::Control() {
 	}
 	data.focus_mode = FOCUS_NONE;
 	data.modal_prev_focus_owner = 0;
+	data.theme_cache = NULL;
 }
 
 Control::~Control() {
+
+	_clear_theme_cache();
 }
@@ -144,6 +144,36 @@ private:
 		}
 	};
 
+	struct ThemeItemKey {
+
+		StringName name;
+		StringName type;
+
+		bool operator==(const ThemeItemKey &p_key) const { return name == p_key.name && type == p_key.type; }
+
+		ThemeItemKey(const StringName &p_name, const StringName &p_type) :
+				name(p_name),
+				type(p_type) {}
+		ThemeItemKey() {}
+	};
+
+	struct ThemeItemKeyHasher {
+		static _FORCE_INLINE_ uint32_t hash(const ThemeItemKey &p_key) { return hash_djb2_one_32(p_key.name.hash(), p_key.type.hash()); }
+	};
+
+	// Theme items as resolved by get_icon(), get_stylebox() and the like. Resolving walks the theme
+	// owners and the class hierarchy, with several lookups per step, and drawing does it a lot.
+	struct ThemeCache {
+
+		uint64_t version; // Theme::get_version() when filled
+		HashMap<ThemeItemKey, Ref<Texture>, ThemeItemKeyHasher> icons;
+		HashMap<ThemeItemKey, Ref<Shader>, ThemeItemKeyHasher> shaders;
+		HashMap<ThemeItemKey, Ref<StyleBox>, ThemeItemKeyHasher> styleboxes;
+		HashMap<ThemeItemKey, Ref<Font>, ThemeItemKeyHasher> fonts;
+		HashMap<ThemeItemKey, Color, ThemeItemKeyHasher> colors;
+		HashMap<ThemeItemKey, int, ThemeItemKeyHasher> constants;
+	};
+
 	struct Data {
 
 		Point2 pos_cache;
@@ -208,6 +238,8 @@ private:
 		HashMap<StringName, Color> color_override;
 		HashMap<StringName, int> constant_override;
 
+		mutable ThemeCache *theme_cache; // created on first lookup, dropped on NOTIFICATION_THEME_CHANGED
+
 	} data;
 
 	// used internally
@@ -221,6 +253,16 @@ private:
 	void _propagate_theme_changed(CanvasItem *p_at, Control *p_owner, bool p_assign = true);
 	void _theme_changed();
 
+	ThemeCache *_get_theme_cache() const;
+	void _clear_theme_cache();
+
+	Ref<Texture> _resolve_icon(const StringName &p_name, const StringName &p_type) const;
+	Ref<Shader> _resolve_shader(const StringName &p_name, const StringName &p_type) const;
+	Ref<StyleBox> _resolve_stylebox(const StringName &p_name, const StringName &p_type) const;
+	Ref<Font> _resolve_font(const StringName &p_name, const StringName &p_type) const;
+	Color _resolve_color(const StringName &p_name, const StringName &p_type) const;
+	int _resolve_constant(const StringName &p_name, const StringName &p_type) const;
+
 	void _change_notify_margins();
 	void _update_minimum_size();
 
@@ -259,6 +301,10 @@ protected:
 
 	static void _bind_methods();
 
+	// Local rect containing every point has_point() accepts, or false if there's no such rect.
+	virtual bool _get_pick_rect(Rect2 &r_rect) const;
+	void _pick_rect_changed();
+
 	//bind helpers
 
 public:
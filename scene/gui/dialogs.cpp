@@ -87,6 +87,13 @@ void WindowDialog::_fix_size() {
 
 bool WindowDialog::has_point(const Point2 &p_point) const {
 
+	Rect2 r;
+	_get_pick_rect(r);
+	return r.has_point(p_point);
+}
+
+bool WindowDialog::_get_pick_rect(Rect2 &r_rect) const {
+
 	Rect2 r(Point2(), get_size());
 
 	// Enlarge upwards for title bar.
@@ -103,7 +110,8 @@ bool WindowDialog::has_point(const Point2 &p_point) const {
 		r.size.height += scaleborder_size * 2;
 	}
 
-	return r.has_point(p_point);
+	r_rect = r;
+	return true;
 }
 
 void WindowDialog::_gui_input(const Ref<InputEvent> &p_event) {
@@ -282,6 +290,7 @@ String WindowDialog::get_title() const {
 
 void WindowDialog::set_resizable(bool p_resizable) {
 	resizable = p_resizable;
+	_pick_rect_changed();
 }
 bool WindowDialog::get_resizable() const {
 	return resizable;
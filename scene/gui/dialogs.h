@@ -70,6 +70,7 @@ protected:
 	virtual void _fix_size();
 	virtual void _close_pressed() {}
 	virtual bool has_point(const Point2 &p_point) const;
+	virtual bool _get_pick_rect(Rect2 &r_rect) const;
 	void _notification(int p_what);
 	static void _bind_methods();
 
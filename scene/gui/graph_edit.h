@@ -48,6 +48,7 @@ class GraphEditFilter : public Control {
 	friend class GraphEdit;
 	GraphEdit *ge;
 	virtual bool has_point(const Point2 &p_point) const;
+	virtual bool _get_pick_rect(Rect2 &r_rect) const { return false; }
 
 public:
 	GraphEditFilter(GraphEdit *p_edit);
@@ -259,6 +259,25 @@ Variant ItemList::get_item_metadata(int p_idx) const {
 }
 void ItemList::select(int p_idx, bool p_single) {
 
+	if (is_virtual()) {
+
+		ERR_FAIL_INDEX(p_idx, virtual_item_count);
+
+		const Item &item = _get_virtual_item(p_idx);
+		if (!item.selectable || item.disabled) {
+			return;
+		}
+
+		if (p_single || select_mode == SELECT_SINGLE) {
+			virtual_selected.clear();
+			current = p_idx;
+			ensure_selected_visible = false;
+		}
+		virtual_selected.insert(p_idx);
+		update();
+		return;
+	}
+
 	ERR_FAIL_INDEX(p_idx, items.size());
 
 	if (p_single || select_mode == SELECT_SINGLE) {
@@ -283,6 +302,18 @@ void ItemList::select(int p_idx, bool p_single) {
 }
 void ItemList::unselect(int p_idx) {
 
+	if (is_virtual()) {
+
+		ERR_FAIL_INDEX(p_idx, virtual_item_count);
+
+		virtual_selected.erase(p_idx);
+		if (select_mode != SELECT_MULTI) {
+			current = -1;
+		}
+		update();
+		return;
+	}
+
 	ERR_FAIL_INDEX(p_idx, items.size());
 
 	if (select_mode != SELECT_MULTI) {
@@ -296,6 +327,13 @@ void ItemList::unselect(int p_idx) {
 
 void ItemList::unselect_all() {
 
+	if (is_virtual()) {
+		virtual_selected.clear();
+		current = -1;
+		update();
+		return;
+	}
+
 	if (items.size() < 1)
 		return;
 
@@ -309,13 +347,18 @@ void ItemList::unselect_all() {
 
 bool ItemList::is_selected(int p_idx) const {
 
+	if (is_virtual()) {
+		ERR_FAIL_INDEX_V(p_idx, virtual_item_count, false);
+		return virtual_selected.has(p_idx);
+	}
+
 	ERR_FAIL_INDEX_V(p_idx, items.size(), false);
 
 	return items[p_idx].selected;
 }
 
 void ItemList::set_current(int p_current) {
-	ERR_FAIL_INDEX(p_current, items.size());
+	ERR_FAIL_INDEX(p_current, get_item_count());
 
 	if (select_mode == SELECT_SINGLE)
 		select(p_current, true);
@@ -349,7 +392,7 @@ void ItemList::move_item(int p_from_idx, int p_to_idx) {
 
 int ItemList::get_item_count() const {
 
-	return items.size();
+	return is_virtual() ? virtual_item_count : items.size();
 }
 void ItemList::remove_item(int p_idx) {
 
@@ -444,6 +487,7 @@ void ItemList::set_fixed_icon_size(const Size2 &p_size) {
 
 	fixed_icon_size = p_size;
 	update();
+	shape_changed = true;
 }
 
 Size2 ItemList::get_fixed_icon_size() const {
@@ -476,6 +520,9 @@ void ItemList::_gui_input(const Ref<InputEvent> &p_event) {
 		return;
 	}
 
+	if (is_virtual() && _gui_input_virtual(p_event))
+		return;
+
 	Ref<InputEventMouseButton> mb = p_event;
 
 	if (defer_select_single >= 0 && mb.is_valid() && mb->get_button_index() == BUTTON_LEFT && !mb->is_pressed()) {
@@ -845,6 +892,11 @@ void ItemList::_notification(int p_what) {
 			VisualServer::get_singleton()->canvas_item_add_clip_ignore(get_canvas_item(), false);
 		}
 
+		if (is_virtual()) {
+			_draw_virtual();
+			return;
+		}
+
 		if (shape_changed) {
 
 			float max_column_width = 0;
@@ -1236,6 +1288,20 @@ int ItemList::get_item_at_position(const Point2 &p_pos, bool p_exact) const {
 	pos -= bg->get_offset();
 	pos.y += scroll_bar->get_value();
 
+	if (is_virtual()) {
+
+		if (virtual_item_count == 0)
+			return -1;
+
+		int row_height = _get_virtual_row_height();
+		int pitch = row_height + get_constant("vseparation");
+		int idx = Math::floor(pos.y / pitch);
+		if (p_exact && (idx < 0 || idx >= virtual_item_count || pos.y - idx * pitch >= row_height))
+			return -1;
+
+		return CLAMP(idx, 0, virtual_item_count - 1);
+	}
+
 	int closest = -1;
 	int closest_dist = 0x7FFFFFFF;
 
@@ -1263,7 +1329,7 @@ int ItemList::get_item_at_position(const Point2 &p_pos, bool p_exact) const {
 
 bool ItemList::is_pos_at_end_of_items(const Point2 &p_pos) const {
 
-	if (items.empty())
+	if (get_item_count() == 0)
 		return true;
 
 	Vector2 pos = p_pos;
@@ -1271,6 +1337,11 @@ bool ItemList::is_pos_at_end_of_items(const Point2 &p_pos) const {
 	pos -= bg->get_offset();
 	pos.y += scroll_bar->get_value();
 
+	if (is_virtual()) {
+		int pitch = _get_virtual_row_height() + get_constant("vseparation");
+		return pos.y > virtual_item_count * pitch;
+	}
+
 	Rect2 endrect = items[items.size() - 1].rect_cache;
 	return (pos.y > endrect.position.y + endrect.size.y);
 }
@@ -1279,6 +1350,14 @@ String ItemList::get_tooltip(const Point2 &p_pos) const {
 
 	int closest = get_item_at_position(p_pos, true);
 
+	if (closest != -1 && is_virtual()) {
+		const Item &item = _get_virtual_item(closest);
+		if (!item.tooltip_enabled) {
+			return "";
+		}
+		return item.tooltip != "" ? item.tooltip : item.text;
+	}
+
 	if (closest != -1) {
 		if (!items[closest].tooltip_enabled) {
 			return "";
@@ -1351,6 +1430,13 @@ real_t ItemList::get_icon_scale() const {
 
 Vector<int> ItemList::get_selected_items() {
 	Vector<int> selected;
+	if (is_virtual()) {
+		for (Set<int>::Element *E = virtual_selected.front(); E; E = E->next()) {
+			selected.push_back(E->get());
+		}
+		return selected;
+	}
+
 	for (int i = 0; i < items.size(); i++) {
 		if (items[i].selected) {
 			selected.push_back(i);
@@ -1363,6 +1449,9 @@ Vector<int> ItemList::get_selected_items() {
 }
 
 bool ItemList::is_anything_selected() {
+	if (is_virtual())
+		return !virtual_selected.empty();
+
 	for (int i = 0; i < items.size(); i++) {
 		if (items[i].selected)
 			return true;
@@ -1426,6 +1515,351 @@ bool ItemList::has_auto_height() const {
 	return auto_height;
 }
 
+void ItemList::set_virtual_source(Object *p_source, const StringName &p_method) {
+
+	virtual_source = p_source ? p_source->get_instance_id() : 0;
+	virtual_method = p_source ? p_method : StringName();
+	virtual_cache.clear();
+	virtual_selected.clear();
+	current = -1;
+	defer_select_single = -1;
+	shape_changed = true;
+	update();
+}
+
+void ItemList::set_virtual_item_count(int p_count) {
+
+	ERR_FAIL_COND(p_count < 0);
+	virtual_item_count = p_count;
+
+	while (virtual_selected.size() && virtual_selected.back()->get() >= p_count) {
+		virtual_selected.erase(virtual_selected.back());
+	}
+	if (current >= p_count) {
+		current = -1;
+	}
+
+	refresh_virtual_items();
+}
+
+int ItemList::get_virtual_item_count() const {
+
+	return virtual_item_count;
+}
+
+void ItemList::refresh_virtual_items() {
+
+	virtual_cache.clear();
+	shape_changed = true;
+	update();
+}
+
+const ItemList::Item &ItemList::_get_virtual_item(int p_idx) const {
+
+	Map<int, Item>::Element *E = virtual_cache.find(p_idx);
+	if (E)
+		return E->get();
+
+	// Only the drawn rows are kept between frames, this bounds lookups done
+	// from input or tooltips in between.
+	if (virtual_cache.size() > 1024)
+		virtual_cache.clear();
+
+	Item item;
+	item.icon_transposed = false;
+	item.icon_modulate = Color(1, 1, 1, 1);
+	item.selectable = true;
+	item.selected = false;
+	item.disabled = false;
+	item.tooltip_enabled = true;
+	item.custom_bg = Color(0, 0, 0, 0);
+
+	Object *source = ObjectDB::get_instance(virtual_source);
+	if (source) {
+
+		Variant ret = source->call(virtual_method, p_idx);
+		if (ret.get_type() == Variant::DICTIONARY) {
+
+			Dictionary d = ret;
+			item.text = d.has("text") ? String(d["text"]) : String();
+			item.icon = d.has("icon") ? Ref<Texture>(d["icon"]) : Ref<Texture>();
+			if (d.has("icon_modulate"))
+				item.icon_modulate = d["icon_modulate"];
+			if (d.has("custom_fg_color"))
+				item.custom_fg = d["custom_fg_color"];
+			if (d.has("custom_bg_color"))
+				item.custom_bg = d["custom_bg_color"];
+			if (d.has("selectable"))
+				item.selectable = d["selectable"];
+			if (d.has("disabled"))
+				item.disabled = d["disabled"];
+			if (d.has("tooltip"))
+				item.tooltip = d["tooltip"];
+			if (d.has("metadata"))
+				item.metadata = d["metadata"];
+		} else {
+			item.text = ret;
+		}
+	}
+
+	return virtual_cache.insert(p_idx, item)->get();
+}
+
+int ItemList::_get_virtual_row_height() const {
+
+	int height = get_font("font")->get_height();
+	if (fixed_icon_size.y > 0) {
+		height = MAX(height, int(fixed_icon_size.y * icon_scale));
+	}
+
+	return height + get_constant("vseparation");
+}
+
+void ItemList::_virtual_move_current(int p_idx) {
+
+	p_idx = CLAMP(p_idx, 0, virtual_item_count - 1);
+	if (p_idx == current)
+		return;
+
+	set_current(p_idx);
+	ensure_current_is_visible();
+	if (select_mode == SELECT_SINGLE) {
+		emit_signal("item_selected", current);
+	}
+}
+
+bool ItemList::_gui_input_virtual(const Ref<InputEvent> &p_event) {
+
+	Ref<InputEventMouseButton> mb = p_event;
+
+	if (mb.is_valid() && (mb->get_button_index() == BUTTON_LEFT || (allow_rmb_select && mb->get_button_index() == BUTTON_RIGHT)) && mb->is_pressed()) {
+
+		int i = get_item_at_position(mb->get_position(), true);
+
+		if (i == -1) {
+			if (mb->get_button_index() == BUTTON_RIGHT) {
+				emit_signal("rmb_clicked", mb->get_position());
+			} else {
+				emit_signal("nothing_selected");
+			}
+			return true;
+		}
+
+		bool selected = virtual_selected.has(i);
+
+		if (select_mode == SELECT_MULTI && selected && mb->get_command()) {
+			unselect(i);
+			emit_signal("multi_selected", i, false);
+
+		} else if (select_mode == SELECT_MULTI && mb->get_shift() && current >= 0 && current < virtual_item_count && current != i) {
+
+			int from = MIN(current, i);
+			int to = MAX(current, i);
+			for (int j = from; j <= to; j++) {
+				if (!virtual_selected.has(j)) {
+					select(j, false);
+					if (virtual_selected.has(j))
+						emit_signal("multi_selected", j, true);
+				}
+			}
+			if (mb->get_button_index() == BUTTON_RIGHT) {
+				emit_signal("item_rmb_selected", i, get_local_mouse_position());
+			}
+
+		} else if (selected && mb->get_button_index() == BUTTON_RIGHT) {
+			emit_signal("item_rmb_selected", i, get_local_mouse_position());
+
+		} else {
+
+			select(i, select_mode == SELECT_SINGLE || !mb->get_command());
+
+			if (!selected || allow_reselect) {
+				if (select_mode == SELECT_SINGLE) {
+					emit_signal("item_selected", i);
+				} else {
+					emit_signal("multi_selected", i, true);
+				}
+			}
+
+			if (mb->get_button_index() == BUTTON_RIGHT) {
+				emit_signal("item_rmb_selected", i, get_local_mouse_position());
+			} else if (mb->is_doubleclick()) {
+				emit_signal("item_activated", i);
+			}
+		}
+
+		return true;
+	}
+
+	if (!p_event->is_pressed() || virtual_item_count == 0)
+		return false;
+
+	int page_rows = MAX(1, int(scroll_bar->get_page() / (_get_virtual_row_height() + get_constant("vseparation"))));
+
+	if (p_event->is_action("ui_up")) {
+		_virtual_move_current(current - 1);
+	} else if (p_event->is_action("ui_down")) {
+		_virtual_move_current(current + 1);
+	} else if (p_event->is_action("ui_page_up")) {
+		_virtual_move_current(current - page_rows);
+	} else if (p_event->is_action("ui_page_down")) {
+		_virtual_move_current(current + page_rows);
+	} else if (p_event->is_action("ui_select") && select_mode == SELECT_MULTI) {
+
+		if (current >= 0 && current < virtual_item_count) {
+			if (virtual_selected.has(current)) {
+				unselect(current);
+				emit_signal("multi_selected", current, false);
+			} else {
+				select(current, false);
+				if (virtual_selected.has(current))
+					emit_signal("multi_selected", current, true);
+			}
+		}
+	} else if (p_event->is_action("ui_accept")) {
+
+		if (current >= 0 && current < virtual_item_count) {
+			emit_signal("item_activated", current);
+		}
+	} else {
+		return false;
+	}
+
+	accept_event();
+	return true;
+}
+
+void ItemList::_draw_virtual() {
+
+	Ref<StyleBox> bg = get_stylebox("bg");
+	Size2 size = get_size();
+
+	int hseparation = get_constant("hseparation");
+	int vseparation = get_constant("vseparation");
+	int icon_margin = get_constant("icon_margin");
+
+	Ref<StyleBox> sbsel = has_focus() ? get_stylebox("selected_focus") : get_stylebox("selected");
+	Ref<StyleBox> cursor = has_focus() ? get_stylebox("cursor") : get_stylebox("cursor_unfocused");
+
+	Ref<Font> font = get_font("font");
+	Color font_color = get_color("font_color");
+	Color font_color_selected = get_color("font_color_selected");
+
+	int row_height = _get_virtual_row_height();
+	int pitch = row_height + vseparation;
+
+	if (shape_changed) {
+
+		float page = size.height - bg->get_minimum_size().height;
+		float max = MAX(page, float(virtual_item_count) * pitch);
+		if (auto_height)
+			auto_height_value = float(virtual_item_count) * pitch + bg->get_minimum_size().height;
+		scroll_bar->set_max(max);
+		scroll_bar->set_page(page);
+		if (max <= page) {
+			scroll_bar->set_value(0);
+			scroll_bar->hide();
+		} else {
+			scroll_bar->show();
+
+			if (do_autoscroll_to_bottom)
+				scroll_bar->set_value(max);
+		}
+
+		minimum_size_changed();
+		shape_changed = false;
+	}
+
+	if (ensure_selected_visible && current >= 0 && current < virtual_item_count) {
+
+		int from = scroll_bar->get_value();
+		int to = from + scroll_bar->get_page();
+		int y = current * pitch;
+
+		if (y < from) {
+			scroll_bar->set_value(y);
+		} else if (y + row_height > to) {
+			scroll_bar->set_value(y + row_height - (to - from));
+		}
+	}
+
+	ensure_selected_visible = false;
+
+	int width = size.width - bg->get_minimum_size().width;
+	if (scroll_bar->is_visible()) {
+		width -= scroll_bar->get_minimum_size().x;
+	}
+
+	Vector2 base_ofs = bg->get_offset();
+	int scroll = scroll_bar->get_value();
+	base_ofs.y -= scroll;
+
+	if (virtual_item_count == 0) {
+		virtual_cache.clear();
+		return;
+	}
+
+	int first = CLAMP(scroll / pitch, 0, virtual_item_count - 1);
+	int last = CLAMP((scroll + int(size.height)) / pitch, first, virtual_item_count - 1);
+
+	// Drop rows that scrolled out, so the cache stays O(visible).
+	while (virtual_cache.front() && virtual_cache.front()->key() < first) {
+		virtual_cache.erase(virtual_cache.front());
+	}
+	while (virtual_cache.back() && virtual_cache.back()->key() > last) {
+		virtual_cache.erase(virtual_cache.back());
+	}
+
+	for (int i = first; i <= last; i++) {
+
+		const Item &item = _get_virtual_item(i);
+		Rect2 rcache = Rect2(base_ofs + Vector2(0, i * pitch), Size2(width, row_height));
+
+		Rect2 r = rcache;
+		r.position.y -= vseparation / 2;
+		r.size.y += vseparation;
+		r.position.x -= hseparation / 2;
+		r.size.x += hseparation;
+
+		bool selected = virtual_selected.has(i);
+		if (selected) {
+			draw_style_box(sbsel, r);
+		}
+		if (item.custom_bg.a > 0.001) {
+			draw_rect(r, item.custom_bg);
+		}
+
+		Vector2 text_ofs;
+		if (item.icon.is_valid()) {
+
+			Size2 icon_size = fixed_icon_size.x > 0 && fixed_icon_size.y > 0 ? fixed_icon_size * icon_scale : Size2(row_height - vseparation, row_height - vseparation);
+			Rect2 draw_rect = _adjust_to_max_size(item.get_icon_size() * icon_scale, icon_size);
+			draw_rect.position += rcache.position + Vector2(0, Math::floor((row_height - icon_size.height) / 2));
+
+			Color modulate = item.icon_modulate;
+			if (item.disabled)
+				modulate.a *= 0.5;
+
+			draw_texture_rect(item.icon, draw_rect, false, modulate);
+			text_ofs.x = icon_size.width + icon_margin;
+		}
+
+		if (item.text != "") {
+
+			Color modulate = selected ? font_color_selected : (item.custom_fg != Color() ? item.custom_fg : font_color);
+			if (item.disabled)
+				modulate.a *= 0.5;
+
+			text_ofs.y = Math::floor((row_height - font->get_height()) / 2) + font->get_ascent();
+			draw_string(font, (rcache.position + text_ofs).floor(), item.text, modulate, MAX(0, width - int(text_ofs.x)));
+		}
+
+		if (select_mode == SELECT_MULTI && i == current) {
+			draw_style_box(cursor, r);
+		}
+	}
+}
+
 void ItemList::_bind_methods() {
 
 	ClassDB::bind_method(D_METHOD("add_item", "text", "icon", "selectable"), &ItemList::add_item, DEFVAL(Variant()), DEFVAL(true));
@@ -1521,6 +1955,12 @@ void ItemList::_bind_methods() {
 
 	ClassDB::bind_method(D_METHOD("ensure_current_is_visible"), &ItemList::ensure_current_is_visible);
 
+	ClassDB::bind_method(D_METHOD("set_virtual_source", "source", "method"), &ItemList::set_virtual_source);
+	ClassDB::bind_method(D_METHOD("is_virtual"), &ItemList::is_virtual);
+	ClassDB::bind_method(D_METHOD("set_virtual_item_count", "count"), &ItemList::set_virtual_item_count);
+	ClassDB::bind_method(D_METHOD("get_virtual_item_count"), &ItemList::get_virtual_item_count);
+	ClassDB::bind_method(D_METHOD("refresh_virtual_items"), &ItemList::refresh_virtual_items);
+
 	ClassDB::bind_method(D_METHOD("get_v_scroll"), &ItemList::get_v_scroll);
 
 	ClassDB::bind_method(D_METHOD("_scroll_changed"), &ItemList::_scroll_changed);
@@ -1591,6 +2031,9 @@ ItemList::ItemList() {
 	allow_reselect = false;
 	do_autoscroll_to_bottom = false;
 
+	virtual_source = 0;
+	virtual_item_count = 0;
+
 	icon_scale = 1.0f;
 	set_clip_contents(true);
 }
@@ -114,6 +114,19 @@ private:
 
 	bool do_autoscroll_to_bottom;
 
+	// Virtual mode: rows are requested from virtual_source only when visible.
+	ObjectID virtual_source;
+	StringName virtual_method;
+	int virtual_item_count;
+	mutable Map<int, Item> virtual_cache;
+	Set<int> virtual_selected;
+
+	const Item &_get_virtual_item(int p_idx) const;
+	int _get_virtual_row_height() const;
+	void _virtual_move_current(int p_idx);
+	bool _gui_input_virtual(const Ref<InputEvent> &p_event);
+	void _draw_virtual();
+
 	Array _get_items() const;
 	void _set_items(const Array &p_items);
 
@@ -230,6 +243,13 @@ public:
 
 	void set_autoscroll_to_bottom(const bool p_enable);
 
+	void set_virtual_source(Object *p_source, const StringName &p_method);
+	bool is_virtual() const { return virtual_method != StringName(); }
+
+	void set_virtual_item_count(int p_count);
+	int get_virtual_item_count() const;
+	void refresh_virtual_items();
+
 	VScrollBar *get_v_scroll() { return scroll_bar; }
 
 	ItemList();
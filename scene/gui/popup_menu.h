@@ -114,6 +114,7 @@ class PopupMenu : public Popup {
 
 protected:
 	virtual bool has_point(const Point2 &p_point) const;
+	virtual bool _get_pick_rect(Rect2 &r_rect) const { return false; } // parent and autohide areas are in other spaces
 
 	friend class MenuButton;
 	void _notification(int p_what);
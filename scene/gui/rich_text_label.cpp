@@ -786,7 +786,16 @@ void RichTextLabel::_notification(int p_what) {
 
 		case NOTIFICATION_RESIZED: {
 
-			main->first_invalid_line = 0; //invalidate ALL
+			if (_get_text_rect().get_size().width - scroll_w != line_cache_width) {
+				main->first_invalid_line = 0; //invalidate ALL
+			} else if (main->first_invalid_line == main->lines.size()) {
+				// Only the height changed, lines keep their layout.
+				updating_scroll = true;
+				vscroll->set_page(get_size().height);
+				if (scroll_follow && scroll_following)
+					vscroll->set_value(vscroll->get_max() - get_size().height);
+				updating_scroll = false;
+			}
 			update();
 
 		} break;
@@ -828,20 +837,11 @@ void RichTextLabel::_notification(int p_what) {
 
 			int ofs = vscroll->get_value();
 
-			//todo, change to binary search
-
-			int from_line = 0;
-			int total_chars = 0;
-			while (from_line < main->lines.size()) {
-
-				if (main->lines[from_line].height_accum_cache + _get_text_rect().get_position().y >= ofs)
-					break;
-				total_chars += main->lines[from_line].char_count;
-				from_line++;
-			}
-
+			int from_line = _find_first_visible_line(main, ofs - text_rect.get_position().y);
 			if (from_line >= main->lines.size())
 				break; //nothing to draw
+
+			int total_chars = main->lines[from_line].char_accum_cache;
 			int y = (main->lines[from_line].height_accum_cache - main->lines[from_line].height_cache) - ofs;
 			Ref<Font> base_font = get_font("normal_font");
 			Color base_color = get_color("default_color");
@@ -872,16 +872,7 @@ void RichTextLabel::_find_click(ItemFrame *p_frame, const Point2i &p_click, Item
 	bool use_outline = get_constant("shadow_as_outline");
 	Point2 shadow_ofs(get_constant("shadow_offset_x"), get_constant("shadow_offset_y"));
 
-	//todo, change to binary search
-	int from_line = 0;
-
-	while (from_line < p_frame->lines.size()) {
-
-		if (p_frame->lines[from_line].height_accum_cache >= ofs)
-			break;
-		from_line++;
-	}
-
+	int from_line = _find_first_visible_line(p_frame, ofs);
 	if (from_line >= p_frame->lines.size())
 		return;
 
@@ -1307,11 +1298,16 @@ void RichTextLabel::_validate_line_caches(ItemFrame *p_frame) {
 		_process_line(p_frame, text_rect.get_position(), y, text_rect.get_size().width - scroll_w, i, PROCESS_CACHE, base_font, Color(), font_color_shadow, use_outline, shadow_ofs);
 		p_frame->lines.write[i].height_cache = y;
 		p_frame->lines.write[i].height_accum_cache = y;
+		p_frame->lines.write[i].char_accum_cache = 0;
 
-		if (i > 0)
+		if (i > 0) {
 			p_frame->lines.write[i].height_accum_cache += p_frame->lines[i - 1].height_accum_cache;
+			p_frame->lines.write[i].char_accum_cache = p_frame->lines[i - 1].char_accum_cache + p_frame->lines[i - 1].char_count;
+		}
 	}
 
+	line_cache_width = text_rect.get_size().width - scroll_w;
+
 	int total_height = 0;
 	if (p_frame->lines.size())
 		total_height = p_frame->lines[p_frame->lines.size() - 1].height_accum_cache + get_stylebox("normal")->get_minimum_size().height;
@@ -1327,6 +1323,24 @@ void RichTextLabel::_validate_line_caches(ItemFrame *p_frame) {
 	updating_scroll = false;
 }
 
+int RichTextLabel::_find_first_visible_line(ItemFrame *p_frame, int p_ofs) const {
+
+	// height_accum_cache grows with the line index, so the first line ending
+	// at or below the offset can be found with a binary search.
+	int lo = 0;
+	int hi = p_frame->lines.size();
+	while (lo < hi) {
+		int mid = (lo + hi) / 2;
+		if (p_frame->lines[mid].height_accum_cache >= p_ofs) {
+			hi = mid;
+		} else {
+			lo = mid + 1;
+		}
+	}
+
+	return lo;
+}
+
 void RichTextLabel::_invalidate_current_line(ItemFrame *p_frame) {
 
 	if (p_frame->lines.size() - 1 <= p_frame->first_invalid_line) {
@@ -2334,6 +2348,7 @@ RichTextLabel::RichTextLabel() {
 	updating_scroll = false;
 	scroll_active = true;
 	scroll_w = 0;
+	line_cache_width = -1;
 	scroll_updated = false;
 
 	vscroll = memnew(VScrollBar);
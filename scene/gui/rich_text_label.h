@@ -87,12 +87,14 @@ private:
 		int height_cache;
 		int height_accum_cache;
 		int char_count;
+		int char_accum_cache; // characters in the lines before this one
 		int minimum_width;
 		int maximum_width;
 
 		Line() {
 			from = NULL;
 			char_count = 0;
+			char_accum_cache = 0;
 		}
 	};
 
@@ -225,6 +227,7 @@ private:
 	bool scroll_following;
 	bool scroll_active;
 	int scroll_w;
+	int line_cache_width; // text width the main frame lines were laid out for
 	bool scroll_updated;
 	bool updating_scroll;
 	int current_idx;
@@ -241,6 +244,7 @@ private:
 
 	void _invalidate_current_line(ItemFrame *p_frame);
 	void _validate_line_caches(ItemFrame *p_frame);
+	int _find_first_visible_line(ItemFrame *p_frame, int p_ofs) const;
 
 	void _add_item(Item *p_item, bool p_enter = false, bool p_ensure_newline = false);
 	void _remove_item(Item *p_item, const int p_line, const int p_subitem_line);
@@ -836,9 +836,9 @@ void TextEdit::_notification(int p_what) {
 
 				const String &fullstr = text[line];
 
-				Map<int, HighlighterInfo> color_map;
+				const Map<int, HighlighterInfo> *color_map = NULL;
 				if (syntax_coloring) {
-					color_map = _get_line_syntax_highlighting(line);
+					color_map = &_get_line_syntax_highlighting_cached(line);
 				}
 				// ensure we at least use the font color
 				Color current_color = cache.font_color;
@@ -977,8 +977,8 @@ void TextEdit::_notification(int p_what) {
 					for (int j = 0; j < str.length(); j++) {
 
 						if (syntax_coloring) {
-							if (color_map.has(last_wrap_column + j)) {
-								current_color = color_map[last_wrap_column + j].color;
+							if (color_map->has(last_wrap_column + j)) {
+								current_color = (*color_map)[last_wrap_column + j].color;
 								if (readonly) {
 									current_color.a *= readonly_alpha;
 								}
@@ -3599,6 +3599,11 @@ void TextEdit::_line_edited_from(int p_line) {
 	for (int i = p_line; i < cache_size; i++) {
 		color_region_cache.erase(i);
 	}
+
+	// Color regions carry over between lines, so later lines may change too.
+	while (syntax_highlighting_cache.back() && syntax_highlighting_cache.back()->key() >= p_line) {
+		syntax_highlighting_cache.erase(syntax_highlighting_cache.back());
+	}
 }
 
 int TextEdit::get_char_count() {
@@ -4285,6 +4290,7 @@ void TextEdit::_clear() {
 
 	clear_undo_history();
 	text.clear();
+	_clear_syntax_highlighting_cache();
 	cursor.column = 0;
 	cursor.line = 0;
 	cursor.x_ofs = 0;
@@ -4350,6 +4356,8 @@ void TextEdit::_toggle_draw_caret() {
 
 void TextEdit::_update_caches() {
 
+	_clear_syntax_highlighting_cache();
+
 	cache.style_normal = get_stylebox("normal");
 	cache.style_focus = get_stylebox("focus");
 	cache.style_readonly = get_stylebox("read_only");
@@ -4407,6 +4415,7 @@ void TextEdit::_set_syntax_highlighting(SyntaxHighlighter *p_syntax_highlighter)
 		syntax_highlighter->set_text_editor(this);
 		syntax_highlighter->_update_cache();
 	}
+	_clear_syntax_highlighting_cache();
 	update();
 }
 
@@ -4473,12 +4482,14 @@ void TextEdit::clear_colors() {
 	keywords.clear();
 	color_regions.clear();
 	color_region_cache.clear();
+	_clear_syntax_highlighting_cache();
 	text.clear_width_cache();
 }
 
 void TextEdit::add_keyword_color(const String &p_keyword, const Color &p_color) {
 
 	keywords[p_keyword] = p_color;
+	_clear_syntax_highlighting_cache();
 	update();
 }
 
@@ -4493,12 +4504,14 @@ Color TextEdit::get_keyword_color(String p_keyword) const {
 void TextEdit::add_color_region(const String &p_begin_key, const String &p_end_key, const Color &p_color, bool p_line_only) {
 
 	color_regions.push_back(ColorRegion(p_begin_key, p_end_key, p_color, p_line_only));
+	_clear_syntax_highlighting_cache();
 	text.clear_width_cache();
 	update();
 }
 
 void TextEdit::add_member_keyword(const String &p_keyword, const Color &p_color) {
 	member_keywords[p_keyword] = p_color;
+	_clear_syntax_highlighting_cache();
 	update();
 }
 
@@ -4512,12 +4525,14 @@ Color TextEdit::get_member_color(String p_member) const {
 
 void TextEdit::clear_member_keywords() {
 	member_keywords.clear();
+	_clear_syntax_highlighting_cache();
 	update();
 }
 
 void TextEdit::set_syntax_coloring(bool p_enabled) {
 
 	syntax_coloring = p_enabled;
+	_clear_syntax_highlighting_cache();
 	update();
 }
 
@@ -6390,6 +6405,23 @@ TextEdit::~TextEdit() {
 
 ///////////////////////////////////////////////////////////////////////////////
 
+const Map<int, TextEdit::HighlighterInfo> &TextEdit::_get_line_syntax_highlighting_cached(int p_line) {
+
+	Map<int, Map<int, HighlighterInfo> >::Element *E = syntax_highlighting_cache.find(p_line);
+	if (E)
+		return E->get();
+
+	if (syntax_highlighting_cache.size() > 1024)
+		syntax_highlighting_cache.clear();
+
+	return syntax_highlighting_cache.insert(p_line, _get_line_syntax_highlighting(p_line))->get();
+}
+
+void TextEdit::_clear_syntax_highlighting_cache() {
+
+	syntax_highlighting_cache.clear();
+}
+
 Map<int, TextEdit::HighlighterInfo> TextEdit::_get_line_syntax_highlighting(int p_line) {
 	if (syntax_highlighter != NULL) {
 		return syntax_highlighter->_get_line_syntax_highlighting(p_line);
@@ -233,6 +233,11 @@ private:
 
 	Map<int, HighlighterInfo> _get_line_syntax_highlighting(int p_line);
 
+	// Highlighting of recently drawn lines, dropped from the first edited line on.
+	Map<int, Map<int, HighlighterInfo> > syntax_highlighting_cache;
+	const Map<int, HighlighterInfo> &_get_line_syntax_highlighting_cached(int p_line);
+	void _clear_syntax_highlighting_cache();
+
 	Vector<ColorRegion> color_regions;
 
 	Set<String> completion_prefixes;
@@ -30,14 +30,120 @@
 
 #include "http_request.h"
 
+#include "core/project_settings.h"
+
+// Servers usually drop idle keep-alive connections after a few seconds.
+#define POOL_IDLE_TIMEOUT_MSEC 15000
+
+Mutex *HTTPRequest::pool_mutex = NULL;
+List<HTTPRequest::PooledClient> *HTTPRequest::idle_clients = NULL;
+Vector<HTTPRequest::Worker *> HTTPRequest::workers;
+int HTTPRequest::next_worker = 0;
+volatile bool HTTPRequest::workers_quit = false;
+
 void HTTPRequest::_redirect_request(const String &p_new_url) {
 }
 
 Error HTTPRequest::_request() {
 
+	reused_connection = false;
+
+	if (use_connection_pool) {
+		Ref<HTTPClient> pooled = _take_pooled_client(_get_pool_key());
+		if (pooled.is_valid()) {
+			client = pooled;
+			reused_connection = true;
+		}
+	}
+
+	client->set_blocking_mode(false);
+	client->set_read_chunk_size(download_chunk_size);
+
+	if (reused_connection)
+		return OK;
+
 	return client->connect_to_host(url, port, use_ssl, validate_ssl);
 }
 
+bool HTTPRequest::_retry_connection() {
+
+	// The server may have closed a pooled connection while it was idle, so try once more on a new one.
+	// Requests which may not be repeated safely are only retried if they could not be sent.
+	if (!reused_connection || got_response)
+		return false;
+
+	if (request_sent && method != HTTPClient::METHOD_GET && method != HTTPClient::METHOD_HEAD && method != HTTPClient::METHOD_OPTIONS)
+		return false;
+
+	reused_connection = false;
+	request_sent = false;
+	client->close();
+
+	return client->connect_to_host(url, port, use_ssl, validate_ssl) == OK;
+}
+
+String HTTPRequest::_get_pool_key() const {
+
+	String key = url + ":" + itos(port);
+	if (use_ssl)
+		key += validate_ssl ? ":ssl" : ":ssl_unvalidated";
+	return key;
+}
+
+Ref<HTTPClient> HTTPRequest::_take_pooled_client(const String &p_key) {
+
+	Ref<HTTPClient> found;
+	uint64_t now = OS::get_singleton()->get_ticks_msec();
+
+	pool_mutex->lock();
+
+	List<PooledClient>::Element *E = idle_clients->front();
+	while (E) {
+		List<PooledClient>::Element *N = E->next();
+		if (now - E->get().idle_since > POOL_IDLE_TIMEOUT_MSEC) {
+			idle_clients->erase(E);
+		} else if (found.is_null() && E->get().key == p_key) {
+			found = E->get().client;
+			idle_clients->erase(E);
+		}
+		E = N;
+	}
+
+	pool_mutex->unlock();
+
+	if (found.is_valid()) {
+		found->poll();
+		if (found->get_status() != HTTPClient::STATUS_CONNECTED)
+			return Ref<HTTPClient>();
+	}
+
+	return found;
+}
+
+void HTTPRequest::_release_client() {
+
+	if (!use_connection_pool || client->get_status() != HTTPClient::STATUS_CONNECTED)
+		return;
+
+	int max_idle = GLOBAL_GET("network/limits/http_request/max_idle_connections");
+	if (max_idle <= 0)
+		return;
+
+	PooledClient pc;
+	pc.key = _get_pool_key();
+	pc.client = client;
+	pc.idle_since = OS::get_singleton()->get_ticks_msec();
+
+	pool_mutex->lock();
+	idle_clients->push_back(pc);
+	while (idle_clients->size() > max_idle) {
+		idle_clients->pop_front(); // Oldest first.
+	}
+	pool_mutex->unlock();
+
+	client.instance();
+}
+
 Error HTTPRequest::_parse_url(const String &p_url) {
 
 	url = p_url;
@@ -110,45 +216,67 @@ Error HTTPRequest::request(const String &p_url, const Vector<String> &p_custom_h
 
 	requesting = true;
 
+	err = _request();
+	if (err != OK) {
+		call_deferred("_request_done", RESULT_CANT_CONNECT, 0, PoolStringArray(), PoolByteArray());
+		return ERR_CANT_CONNECT;
+	}
+
 	if (use_threads) {
 
-		thread_done = false;
-		thread_request_quit = false;
-		client->set_blocking_mode(true);
-		thread = Thread::create(_thread_func, this);
-	} else {
-		client->set_blocking_mode(false);
-		err = _request();
-		if (err != OK) {
-			call_deferred("_request_done", RESULT_CANT_CONNECT, 0, PoolStringArray(), PoolByteArray());
-			return ERR_CANT_CONNECT;
+		pool_mutex->lock();
+		if (workers.empty()) {
+			int count = MAX(1, (int)GLOBAL_GET("network/limits/http_request/worker_threads"));
+			workers_quit = false;
+			for (int i = 0; i < count; i++) {
+				Worker *w = memnew(Worker);
+				w->mutex = Mutex::create();
+				w->semaphore = Semaphore::create();
+				w->thread = Thread::create(_worker_func, w);
+				workers.push_back(w);
+			}
 		}
-
+		worker = next_worker;
+		next_worker = (next_worker + 1) % workers.size();
+		pool_mutex->unlock();
+
+		Worker *w = workers[worker];
+		w->mutex->lock();
+		w->requests.push_back(this);
+		w->mutex->unlock();
+		w->semaphore->post();
+	} else {
 		set_process_internal(true);
 	}
 
 	return OK;
 }
 
-void HTTPRequest::_thread_func(void *p_userdata) {
+void HTTPRequest::_worker_func(void *p_userdata) {
 
-	HTTPRequest *hr = (HTTPRequest *)p_userdata;
+	Worker *w = (Worker *)p_userdata;
 
-	Error err = hr->_request();
+	while (!workers_quit) {
 
-	if (err != OK) {
-		hr->call_deferred("_request_done", RESULT_CANT_CONNECT, 0, PoolStringArray(), PoolByteArray());
-	} else {
-		while (!hr->thread_request_quit) {
+		w->mutex->lock();
 
-			bool exit = hr->_update_connection();
-			if (exit)
-				break;
-			OS::get_singleton()->delay_usec(1);
+		if (w->requests.empty()) {
+			w->mutex->unlock();
+			w->semaphore->wait();
+			continue;
 		}
-	}
 
-	hr->thread_done = true;
+		for (int i = 0; i < w->requests.size(); i++) {
+			if (w->requests[i]->_update_connection()) {
+				w->requests.remove(i);
+				i--;
+			}
+		}
+
+		w->mutex->unlock();
+
+		OS::get_singleton()->delay_usec(1000);
+	}
 }
 
 void HTTPRequest::cancel_request() {
@@ -156,13 +284,15 @@ void HTTPRequest::cancel_request() {
 	if (!requesting)
 		return;
 
-	if (!use_threads) {
-		set_process_internal(false);
-	} else {
-		thread_request_quit = true;
-		Thread::wait_to_finish(thread);
-		memdelete(thread);
-		thread = NULL;
+	set_process_internal(false);
+
+	if (worker >= 0) {
+		// Once the worker lock is held, the request is not being polled.
+		Worker *w = workers[worker];
+		w->mutex->lock();
+		w->requests.erase(this);
+		w->mutex->unlock();
+		worker = -1;
 	}
 
 	if (file) {
@@ -246,6 +376,8 @@ bool HTTPRequest::_update_connection() {
 
 	switch (client->get_status()) {
 		case HTTPClient::STATUS_DISCONNECTED: {
+			if (_retry_connection())
+				return false;
 			call_deferred("_request_done", RESULT_CANT_CONNECT, 0, PoolStringArray(), PoolByteArray());
 			return true; // End it, since it's doing something
 		} break;
@@ -300,6 +432,8 @@ bool HTTPRequest::_update_connection() {
 
 				Error err = client->request(method, request_string, headers, request_data);
 				if (err != OK) {
+					if (_retry_connection())
+						return false;
 					call_deferred("_request_done", RESULT_CONNECTION_ERROR, 0, PoolStringArray(), PoolByteArray());
 					return true;
 				}
@@ -384,6 +518,8 @@ bool HTTPRequest::_update_connection() {
 
 		} break; // Request resulted in body: break which must be read
 		case HTTPClient::STATUS_CONNECTION_ERROR: {
+			if (_retry_connection())
+				return false;
 			call_deferred("_request_done", RESULT_CONNECTION_ERROR, 0, PoolStringArray(), PoolByteArray());
 			return true;
 		} break;
@@ -398,6 +534,8 @@ bool HTTPRequest::_update_connection() {
 
 void HTTPRequest::_request_done(int p_status, int p_code, const PoolStringArray &headers, const PoolByteArray &p_data) {
 
+	if (p_status == RESULT_SUCCESS)
+		_release_client();
 	cancel_request();
 	emit_signal("request_completed", p_status, p_code, headers, p_data);
 }
@@ -471,6 +609,30 @@ int HTTPRequest::get_max_redirects() const {
 	return max_redirects;
 }
 
+void HTTPRequest::set_use_connection_pool(bool p_enable) {
+
+	use_connection_pool = p_enable;
+}
+
+bool HTTPRequest::is_using_connection_pool() const {
+
+	return use_connection_pool;
+}
+
+void HTTPRequest::set_download_chunk_size(int p_chunk_size) {
+
+	ERR_FAIL_COND(status != HTTPClient::STATUS_DISCONNECTED);
+	ERR_FAIL_COND(p_chunk_size < 256);
+
+	download_chunk_size = p_chunk_size;
+	client->set_read_chunk_size(p_chunk_size);
+}
+
+int HTTPRequest::get_download_chunk_size() const {
+
+	return download_chunk_size;
+}
+
 int HTTPRequest::get_downloaded_bytes() const {
 
 	return downloaded;
@@ -495,6 +657,12 @@ void HTTPRequest::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("set_max_redirects", "amount"), &HTTPRequest::set_max_redirects);
 	ClassDB::bind_method(D_METHOD("get_max_redirects"), &HTTPRequest::get_max_redirects);
 
+	ClassDB::bind_method(D_METHOD("set_use_connection_pool", "enable"), &HTTPRequest::set_use_connection_pool);
+	ClassDB::bind_method(D_METHOD("is_using_connection_pool"), &HTTPRequest::is_using_connection_pool);
+
+	ClassDB::bind_method(D_METHOD("set_download_chunk_size", "bytes"), &HTTPRequest::set_download_chunk_size);
+	ClassDB::bind_method(D_METHOD("get_download_chunk_size"), &HTTPRequest::get_download_chunk_size);
+
 	ClassDB::bind_method(D_METHOD("set_download_file", "path"), &HTTPRequest::set_download_file);
 	ClassDB::bind_method(D_METHOD("get_download_file"), &HTTPRequest::get_download_file);
 
@@ -505,7 +673,9 @@ void HTTPRequest::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("_request_done"), &HTTPRequest::_request_done);
 
 	ADD_PROPERTY(PropertyInfo(Variant::STRING, "download_file", PROPERTY_HINT_FILE), "set_download_file", "get_download_file");
+	ADD_PROPERTY(PropertyInfo(Variant::INT, "download_chunk_size", PROPERTY_HINT_RANGE, "256,16777216"), "set_download_chunk_size", "get_download_chunk_size");
 	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "use_threads"), "set_use_threads", "is_using_threads");
+	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "use_connection_pool"), "set_use_connection_pool", "is_using_connection_pool");
 	ADD_PROPERTY(PropertyInfo(Variant::INT, "body_size_limit", PROPERTY_HINT_RANGE, "-1,2000000000"), "set_body_size_limit", "get_body_size_limit");
 	ADD_PROPERTY(PropertyInfo(Variant::INT, "max_redirects", PROPERTY_HINT_RANGE, "-1,64"), "set_max_redirects", "get_max_redirects");
 
@@ -526,9 +696,41 @@ void HTTPRequest::_bind_methods() {
 	BIND_ENUM_CONSTANT(RESULT_REDIRECT_LIMIT_REACHED);
 }
 
+void HTTPRequest::initialize_pool() {
+
+	GLOBAL_DEF("network/limits/http_request/worker_threads", 4);
+	ProjectSettings::get_singleton()->set_custom_property_info("network/limits/http_request/worker_threads", PropertyInfo(Variant::INT, "network/limits/http_request/worker_threads", PROPERTY_HINT_RANGE, "1,64,1"));
+	GLOBAL_DEF("network/limits/http_request/max_idle_connections", 32);
+
+	pool_mutex = Mutex::create();
+	idle_clients = memnew(List<PooledClient>);
+}
+
+void HTTPRequest::finish_pool() {
+
+	workers_quit = true;
+	for (int i = 0; i < workers.size(); i++) {
+		workers[i]->semaphore->post();
+	}
+	for (int i = 0; i < workers.size(); i++) {
+		Worker *w = workers[i];
+		Thread::wait_to_finish(w->thread);
+		memdelete(w->thread);
+		memdelete(w->semaphore);
+		memdelete(w->mutex);
+		memdelete(w);
+	}
+	workers.clear();
+
+	memdelete(idle_clients);
+	idle_clients = NULL;
+	memdelete(pool_mutex);
+	pool_mutex = NULL;
+}
+
 HTTPRequest::HTTPRequest() {
 
-	thread = NULL;
+	worker = -1;
 
 	port = 80;
 	redirections = 0;
@@ -542,9 +744,11 @@ HTTPRequest::HTTPRequest() {
 	requesting = false;
 	client.instance();
 	use_threads = false;
-	thread_done = false;
+	use_connection_pool = false;
+	reused_connection = false;
 	downloaded = 0;
 	body_size_limit = -1;
+	download_chunk_size = 4096;
 	file = NULL;
 	status = HTTPClient::STATUS_DISCONNECTED;
 }
@@ -33,6 +33,8 @@
 
 #include "core/io/http_client.h"
 #include "core/os/file_access.h"
+#include "core/os/mutex.h"
+#include "core/os/semaphore.h"
 #include "core/os/thread.h"
 #include "node.h"
 
@@ -73,6 +75,8 @@ private:
 	Ref<HTTPClient> client;
 	PoolByteArray body;
 	volatile bool use_threads;
+	bool use_connection_pool;
+	bool reused_connection;
 
 	bool got_response;
 	int response_code;
@@ -85,6 +89,7 @@ private:
 	int body_len;
 	volatile int downloaded;
 	int body_size_limit;
+	int download_chunk_size;
 
 	int redirections;
 
@@ -100,14 +105,38 @@ private:
 
 	Error _parse_url(const String &p_url);
 	Error _request();
+	bool _retry_connection();
 
-	volatile bool thread_done;
-	volatile bool thread_request_quit;
+	String _get_pool_key() const;
+	void _release_client();
 
-	Thread *thread;
+	int worker;
 
 	void _request_done(int p_status, int p_code, const PoolStringArray &headers, const PoolByteArray &p_data);
-	static void _thread_func(void *p_userdata);
+
+	// Idle keep-alive connections, shared by all requests.
+	struct PooledClient {
+		String key;
+		Ref<HTTPClient> client;
+		uint64_t idle_since;
+	};
+
+	// Requests using threads are spread over a few workers, each polling many non-blocking clients.
+	struct Worker {
+		Thread *thread;
+		Mutex *mutex;
+		Semaphore *semaphore;
+		Vector<HTTPRequest *> requests;
+	};
+
+	static Mutex *pool_mutex;
+	static List<PooledClient> *idle_clients;
+	static Vector<Worker *> workers;
+	static int next_worker;
+	static volatile bool workers_quit;
+
+	static Ref<HTTPClient> _take_pooled_client(const String &p_key);
+	static void _worker_func(void *p_userdata);
 
 protected:
 	void _notification(int p_what);
@@ -130,9 +159,18 @@ public:
 	void set_max_redirects(int p_max);
 	int get_max_redirects() const;
 
+	void set_use_connection_pool(bool p_enable);
+	bool is_using_connection_pool() const;
+
+	void set_download_chunk_size(int p_chunk_size);
+	int get_download_chunk_size() const;
+
 	int get_downloaded_bytes() const;
 	int get_body_size() const;
 
+	static void initialize_pool();
+	static void finish_pool();
+
 	HTTPRequest();
 	~HTTPRequest();
 };
@@ -75,13 +75,7 @@ String InstancePlaceholder::get_instance_path() const {
 	return path;
 }
 
-Node *InstancePlaceholder::create_instance(bool p_replace, const Ref<PackedScene> &p_custom_scene) {
-
-	ERR_FAIL_COND_V(!is_inside_tree(), NULL);
-
-	Node *base = get_parent();
-	if (!base)
-		return NULL;
+Node *InstancePlaceholder::create_detached_instance(const Ref<PackedScene> &p_custom_scene) const {
 
 	Ref<PackedScene> ps;
 	if (p_custom_scene.is_valid())
@@ -92,13 +86,29 @@ Node *InstancePlaceholder::create_instance(bool p_replace, const Ref<PackedScene
 	if (!ps.is_valid())
 		return NULL;
 	Node *scene = ps->instance();
+	ERR_FAIL_COND_V(!scene, NULL);
 	scene->set_name(get_name());
-	int pos = get_position_in_parent();
 
-	for (List<PropSet>::Element *E = stored_values.front(); E; E = E->next()) {
+	for (const List<PropSet>::Element *E = stored_values.front(); E; E = E->next()) {
 		scene->set(E->get().name, E->get().value);
 	}
 
+	return scene;
+}
+
+Node *InstancePlaceholder::create_instance(bool p_replace, const Ref<PackedScene> &p_custom_scene) {
+
+	ERR_FAIL_COND_V(!is_inside_tree(), NULL);
+
+	Node *base = get_parent();
+	if (!base)
+		return NULL;
+
+	Node *scene = create_detached_instance(p_custom_scene);
+	if (!scene)
+		return NULL;
+	int pos = get_position_in_parent();
+
 	if (p_replace) {
 		queue_delete();
 		base->remove_child(this);
@@ -135,6 +145,7 @@ Dictionary InstancePlaceholder::get_stored_values(bool p_with_order) {
 void InstancePlaceholder::_bind_methods() {
 
 	ClassDB::bind_method(D_METHOD("get_stored_values", "with_order"), &InstancePlaceholder::get_stored_values, DEFVAL(false));
+	ClassDB::bind_method(D_METHOD("create_detached_instance", "custom_scene"), &InstancePlaceholder::create_detached_instance, DEFVAL(Variant()));
 	ClassDB::bind_method(D_METHOD("create_instance", "replace", "custom_scene"), &InstancePlaceholder::create_instance, DEFVAL(false), DEFVAL(Variant()));
 	ClassDB::bind_method(D_METHOD("replace_by_instance", "custom_scene"), &InstancePlaceholder::replace_by_instance, DEFVAL(Variant()));
 	ClassDB::bind_method(D_METHOD("get_instance_path"), &InstancePlaceholder::get_instance_path);
@@ -338,7 +338,7 @@ void Node::move_child(Node *p_child, int p_pos) {
 	data.children.insert(p_pos, p_child);
 
 	if (data.tree) {
-		data.tree->tree_changed();
+		data.tree->node_moved(p_child, p_pos);
 	}
 
 	data.blocked++;
@@ -844,6 +844,17 @@ void Node::set_process_priority(int p_priority) {
 		data.tree->make_group_changed("physics_process_internal");
 }
 
+void Node::set_process_thread_group(int p_group) {
+
+	ERR_FAIL_COND(p_group < 0);
+	data.process_thread_group = p_group;
+}
+
+int Node::get_process_thread_group() const {
+
+	return data.process_thread_group;
+}
+
 void Node::set_process_input(bool p_enable) {
 
 	if (p_enable == data.input)
@@ -940,7 +951,7 @@ void Node::set_name(const String &p_name) {
 	if (is_inside_tree()) {
 
 		emit_signal("renamed");
-		get_tree()->tree_changed();
+		get_tree()->node_renamed(this);
 	}
 }
 
@@ -1682,16 +1693,14 @@ void Node::add_to_group(const StringName &p_identifier, bool p_persistent) {
 		return;
 
 	GroupData gd;
+	gd.persistent = p_persistent;
+
+	// Inserted first, so the tree can record the node's slot in the group.
+	Map<StringName, GroupData>::Element *E = data.grouped.insert(p_identifier, gd);
 
 	if (data.tree) {
-		gd.group = data.tree->add_to_group(p_identifier, this);
-	} else {
-		gd.group = NULL;
+		E->get().group = data.tree->add_to_group(p_identifier, this);
 	}
-
-	gd.persistent = p_persistent;
-
-	data.grouped[p_identifier] = gd;
 }
 
 void Node::remove_from_group(const StringName &p_identifier) {
@@ -2743,6 +2752,8 @@ void Node::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("get_process_delta_time"), &Node::get_process_delta_time);
 	ClassDB::bind_method(D_METHOD("set_process", "enable"), &Node::set_process);
 	ClassDB::bind_method(D_METHOD("set_process_priority", "priority"), &Node::set_process_priority);
+	ClassDB::bind_method(D_METHOD("set_process_thread_group", "group"), &Node::set_process_thread_group);
+	ClassDB::bind_method(D_METHOD("get_process_thread_group"), &Node::get_process_thread_group);
 	ClassDB::bind_method(D_METHOD("is_processing"), &Node::is_processing);
 	ClassDB::bind_method(D_METHOD("set_process_input", "enable"), &Node::set_process_input);
 	ClassDB::bind_method(D_METHOD("is_processing_input"), &Node::is_processing_input);
@@ -2867,6 +2878,9 @@ void Node::_bind_methods() {
 	//ADD_PROPERTY( PropertyInfo( Variant::BOOL, "process/unhandled_input" ), "set_process_unhandled_input","is_processing_unhandled_input" ) ;
 	ADD_GROUP("Pause", "pause_");
 	ADD_PROPERTY(PropertyInfo(Variant::INT, "pause_mode", PROPERTY_HINT_ENUM, "Inherit,Stop,Process"), "set_pause_mode", "get_pause_mode");
+	ADD_GROUP("Process", "process_");
+	ADD_PROPERTY(PropertyInfo(Variant::INT, "process_thread_group", PROPERTY_HINT_RANGE, "0,64,1,or_greater"), "set_process_thread_group", "get_process_thread_group");
+	ADD_GROUP("", "");
 	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "editor/display_folded", PROPERTY_HINT_NONE, "", PROPERTY_USAGE_NOEDITOR | PROPERTY_USAGE_INTERNAL), "set_display_folded", "is_displayed_folded");
 	ADD_PROPERTY(PropertyInfo(Variant::STRING, "name", PROPERTY_HINT_NONE, "", 0), "set_name", "get_name");
 	ADD_PROPERTY(PropertyInfo(Variant::STRING, "filename", PROPERTY_HINT_NONE, "", 0), "set_filename", "get_filename");
@@ -2908,6 +2922,7 @@ Node::Node() {
 	data.physics_process = false;
 	data.idle_process = false;
 	data.process_priority = 0;
+	data.process_thread_group = 0;
 	data.physics_process_internal = false;
 	data.idle_process_internal = false;
 	data.inside_tree = false;
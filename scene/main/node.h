@@ -80,7 +80,12 @@ private:
 
 		bool persistent;
 		SceneTree::Group *group;
-		GroupData() { persistent = false; }
+		int index; // position in group->nodes, maintained by SceneTree
+		GroupData() {
+			persistent = false;
+			group = NULL;
+			index = -1;
+		}
 	};
 
 	struct Data {
@@ -124,6 +129,7 @@ private:
 		bool physics_process;
 		bool idle_process;
 		int process_priority;
+		int process_thread_group;
 
 		bool physics_process_internal;
 		bool idle_process_internal;
@@ -344,6 +350,9 @@ public:
 
 	void set_process_priority(int p_priority);
 
+	void set_process_thread_group(int p_group);
+	int get_process_thread_group() const;
+
 	void set_process_input(bool p_enable);
 	bool is_processing_input() const;
 
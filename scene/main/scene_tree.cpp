@@ -30,16 +30,21 @@
 
 #include "scene_tree.h"
 
+#include "core/hash_map.h"
 #include "core/io/marshalls.h"
 #include "core/io/resource_loader.h"
 #include "core/message_queue.h"
 #include "core/os/keyboard.h"
 #include "core/os/os.h"
+#include "core/os/thread_work_pool.h"
+#include "core/os/trace.h"
 #include "core/print_string.h"
 #include "core/project_settings.h"
 #include "editor/editor_node.h"
 #include "main/input_default.h"
 #include "node.h"
+#include "scene/3d/visual_instance.h"
+#include "scene/animation/tween.h"
 #include "scene/resources/dynamic_font.h"
 #include "scene/resources/material.h"
 #include "scene/resources/mesh.h"
@@ -47,6 +52,7 @@
 #include "scene/scene_string_names.h"
 #include "servers/physics_2d_server.h"
 #include "servers/physics_server.h"
+#include "timer.h"
 #include "viewport.h"
 
 #include <stdio.h>
@@ -87,11 +93,25 @@ SceneTreeTimer::SceneTreeTimer() {
 void SceneTree::tree_changed() {
 
 	tree_version++;
+	if (tree_changed_batch > 0) {
+		tree_changed_pending = true;
+		return;
+	}
 	emit_signal(tree_changed_name);
 }
 
 void SceneTree::node_added(Node *p_node) {
 
+#ifdef DEBUG_ENABLED
+	if (p_node->get_parent() && _debugger_tree_track(6)) {
+		debugger_tree_changes.push_back(DEBUGGER_TREE_ADD);
+		debugger_tree_changes.push_back(p_node->get_parent()->get_instance_id());
+		debugger_tree_changes.push_back(p_node->get_index());
+		debugger_tree_changes.push_back(p_node->get_name());
+		debugger_tree_changes.push_back(p_node->get_class());
+		debugger_tree_changes.push_back(p_node->get_instance_id());
+	}
+#endif
 	emit_signal(node_added_name, p_node);
 }
 
@@ -100,22 +120,58 @@ void SceneTree::node_removed(Node *p_node) {
 	if (current_scene == p_node) {
 		current_scene = NULL;
 	}
+#ifdef DEBUG_ENABLED
+	if (_debugger_tree_track(2)) {
+		debugger_tree_changes.push_back(DEBUGGER_TREE_REMOVE);
+		debugger_tree_changes.push_back(p_node->get_instance_id());
+	}
+#endif
 	emit_signal(node_removed_name, p_node);
 	if (call_lock > 0)
 		call_skip.insert(p_node);
 }
 
+void SceneTree::node_renamed(Node *p_node) {
+
+#ifdef DEBUG_ENABLED
+	if (_debugger_tree_track(3)) {
+		debugger_tree_changes.push_back(DEBUGGER_TREE_RENAME);
+		debugger_tree_changes.push_back(p_node->get_instance_id());
+		debugger_tree_changes.push_back(p_node->get_name());
+	}
+#endif
+	tree_changed();
+}
+
+void SceneTree::node_moved(Node *p_node, int p_pos) {
+
+#ifdef DEBUG_ENABLED
+	if (_debugger_tree_track(3)) {
+		debugger_tree_changes.push_back(DEBUGGER_TREE_MOVE);
+		debugger_tree_changes.push_back(p_node->get_instance_id());
+		debugger_tree_changes.push_back(p_pos);
+	}
+#endif
+	tree_changed();
+}
+
 SceneTree::Group *SceneTree::add_to_group(const StringName &p_group, Node *p_node) {
 
 	Map<StringName, Group>::Element *E = group_map.find(p_group);
 	if (!E) {
 		E = group_map.insert(p_group, Group());
+		E->get().name = p_group;
 	}
 
-	if (E->get().nodes.find(p_node) != -1) {
+	Map<StringName, Node::GroupData>::Element *G = p_node->data.grouped.find(p_group);
+	ERR_FAIL_COND_V(!G, &E->get());
+
+	int index = G->get().index;
+	if (index >= 0 && index < E->get().nodes.size() && E->get().nodes[index] == p_node) {
 		ERR_EXPLAIN("Already in group: " + p_group);
 		ERR_FAIL_V(&E->get());
 	}
+	G->get().index = E->get().nodes.size();
 	E->get().nodes.push_back(p_node);
 	//E->get().last_tree_version=0;
 	E->get().changed = true;
@@ -126,9 +182,29 @@ void SceneTree::remove_from_group(const StringName &p_group, Node *p_node) {
 
 	Map<StringName, Group>::Element *E = group_map.find(p_group);
 	ERR_FAIL_COND(!E);
+	Group &g = E->get();
 
-	E->get().nodes.erase(p_node);
-	if (E->get().nodes.empty())
+	Map<StringName, Node::GroupData>::Element *G = p_node->data.grouped.find(p_group);
+	int index = G ? G->get().index : -1;
+	if (index < 0 || index >= g.nodes.size() || g.nodes[index] != p_node) {
+		index = g.nodes.find(p_node);
+		ERR_FAIL_COND(index == -1);
+	}
+	if (G) {
+		G->get().index = -1;
+	}
+
+	// Leave a hole rather than shifting or swapping the tail, so the group
+	// keeps its order and does not need sorting again. Holes are compacted
+	// in one pass by the next _update_group_order().
+	if (index == g.nodes.size() - 1) {
+		g.nodes.resize(index);
+	} else {
+		g.nodes.write[index] = NULL;
+		g.removed++;
+	}
+
+	if (g.nodes.size() == g.removed)
 		group_map.erase(E);
 }
 
@@ -146,9 +222,203 @@ void SceneTree::flush_transform_notifications() {
 		Node *node = n->self();
 		SelfList<Node> *nx = n->next();
 		xform_change_list.remove(n);
+		xform_change_pass++;
 		n = nx;
 		node->notification(NOTIFICATION_TRANSFORM_CHANGED);
 	}
+
+	_flush_visual_instance_transforms();
+}
+
+void SceneTree::_schedule_timer(Timer *p_timer) {
+
+	TimerSchedule &s = timer_schedule[p_timer->timer_process_mode];
+	p_timer->scheduled_index = s.timers.size();
+	s.timers.push_back(p_timer);
+	s.time_left.push_back(p_timer->time_left);
+}
+
+void SceneTree::_unschedule_timer(Timer *p_timer) {
+
+	TimerSchedule &s = timer_schedule[p_timer->timer_process_mode];
+	int idx = p_timer->scheduled_index;
+	ERR_FAIL_INDEX(idx, s.timers.size());
+
+	p_timer->time_left = s.time_left[idx];
+	p_timer->scheduled_index = -1;
+	s.timers.write[idx] = NULL;
+	s.removed++;
+}
+
+double SceneTree::_get_scheduled_time_left(const Timer *p_timer) const {
+
+	const TimerSchedule &s = timer_schedule[p_timer->timer_process_mode];
+	ERR_FAIL_INDEX_V(p_timer->scheduled_index, s.time_left.size(), p_timer->time_left);
+	return s.time_left[p_timer->scheduled_index];
+}
+
+void SceneTree::_schedule_tween(Tween *p_tween) {
+
+	TweenSchedule &s = tween_schedule[p_tween->tween_process_mode];
+	p_tween->scheduled_index = s.tweens.size();
+	s.tweens.push_back(p_tween);
+}
+
+void SceneTree::_unschedule_tween(Tween *p_tween) {
+
+	TweenSchedule &s = tween_schedule[p_tween->tween_process_mode];
+	int idx = p_tween->scheduled_index;
+	ERR_FAIL_INDEX(idx, s.tweens.size());
+
+	p_tween->scheduled_index = -1;
+	s.tweens.write[idx] = NULL;
+	s.removed++;
+}
+
+void SceneTree::_process_timers(int p_mode, float p_time) {
+
+	TimerSchedule &s = timer_schedule[p_mode];
+
+	if (s.removed) {
+		Timer **timers = s.timers.ptrw();
+		double *time_left = s.time_left.ptrw();
+		int count = s.timers.size();
+		int to = 0;
+		for (int i = 0; i < count; i++) {
+			if (!timers[i])
+				continue;
+			if (to != i) {
+				timers[to] = timers[i];
+				time_left[to] = time_left[i];
+				timers[to]->scheduled_index = to;
+			}
+			to++;
+		}
+		s.timers.resize(to);
+		s.time_left.resize(to);
+		s.removed = 0;
+	}
+
+	// Timers scheduled from a timeout callback are only ticked from the next frame on.
+	int count = s.timers.size();
+	if (count == 0)
+		return;
+
+	bool expired = false;
+	{
+		Timer *const *timers = s.timers.ptr();
+		double *time_left = s.time_left.ptrw();
+		for (int i = 0; i < count; i++) {
+			if (pause && !timers[i]->can_process())
+				continue;
+			time_left[i] -= p_time;
+			expired = expired || time_left[i] < 0;
+		}
+	}
+
+	if (!expired)
+		return;
+
+	// Callbacks may start, stop or free timers, so the arrays are indexed again on every step.
+	for (int i = 0; i < count; i++) {
+
+		Timer *timer = s.timers[i];
+		if (!timer || s.time_left[i] >= 0)
+			continue;
+		if (pause && !timer->can_process())
+			continue;
+
+		if (!timer->one_shot)
+			s.time_left.write[i] += timer->wait_time;
+		else
+			timer->stop();
+
+		timer->emit_signal(SNAME("timeout"));
+	}
+}
+
+void SceneTree::_process_tweens(int p_mode, float p_time) {
+
+	TweenSchedule &s = tween_schedule[p_mode];
+
+	if (s.removed) {
+		Tween **tweens = s.tweens.ptrw();
+		int count = s.tweens.size();
+		int to = 0;
+		for (int i = 0; i < count; i++) {
+			if (!tweens[i])
+				continue;
+			if (to != i) {
+				tweens[to] = tweens[i];
+				tweens[to]->scheduled_index = to;
+			}
+			to++;
+		}
+		s.tweens.resize(to);
+		s.removed = 0;
+	}
+
+	int count = s.tweens.size();
+	for (int i = 0; i < count; i++) {
+
+		Tween *tween = s.tweens[i];
+		if (!tween)
+			continue;
+		if (pause && !tween->can_process())
+			continue;
+
+		tween->_tween_process(p_time);
+	}
+}
+
+void SceneTree::_flush_visual_instance_transforms() {
+
+	int count = 0;
+	for (SelfList<VisualInstance> *E = visual_xform_list.first(); E; E = E->next()) {
+		count++;
+	}
+
+	if (count == 0)
+		return;
+
+	Vector<RID> instances;
+	instances.resize(count);
+	PoolVector<float> transforms;
+	transforms.resize(count * 12);
+
+	{
+		PoolVector<float>::Write w = transforms.write();
+		int idx = 0;
+
+		SelfList<VisualInstance> *E = visual_xform_list.first();
+		while (E) {
+
+			VisualInstance *vi = E->self();
+			SelfList<VisualInstance> *nx = E->next();
+			visual_xform_list.remove(E);
+			E = nx;
+
+			const Transform gt = vi->get_global_transform();
+			float *dst = &w[idx * 12];
+			dst[0] = gt.basis.elements[0][0];
+			dst[1] = gt.basis.elements[0][1];
+			dst[2] = gt.basis.elements[0][2];
+			dst[3] = gt.origin.x;
+			dst[4] = gt.basis.elements[1][0];
+			dst[5] = gt.basis.elements[1][1];
+			dst[6] = gt.basis.elements[1][2];
+			dst[7] = gt.origin.y;
+			dst[8] = gt.basis.elements[2][0];
+			dst[9] = gt.basis.elements[2][1];
+			dst[10] = gt.basis.elements[2][2];
+			dst[11] = gt.origin.z;
+
+			instances.write[idx] = vi->get_instance();
+			idx++;
+		}
+	}
+
+	VS::get_singleton()->instances_set_transforms(instances, transforms);
 }
 
 void SceneTree::_flush_ugc() {
@@ -173,7 +443,7 @@ void SceneTree::_flush_ugc() {
 
 void SceneTree::_update_group_order(Group &g, bool p_use_priority) {
 
-	if (!g.changed)
+	if (!g.changed && !g.removed)
 		return;
 	if (g.nodes.empty())
 		return;
@@ -181,6 +451,27 @@ void SceneTree::_update_group_order(Group &g, bool p_use_priority) {
 	Node **nodes = g.nodes.ptrw();
 	int node_count = g.nodes.size();
 
+	if (g.removed) {
+		int to = 0;
+		for (int i = 0; i < node_count; i++) {
+			if (!nodes[i])
+				continue;
+			if (to != i) {
+				nodes[to] = nodes[i];
+				if (!g.changed)
+					nodes[to]->data.grouped[g.name].index = to;
+			}
+			to++;
+		}
+		g.nodes.resize(to);
+		g.removed = 0;
+		nodes = g.nodes.ptrw();
+		node_count = to;
+	}
+
+	if (!g.changed)
+		return;
+
 	if (p_use_priority) {
 		SortArray<Node *, Node::ComparatorWithPriority> node_sort;
 		node_sort.sort(nodes, node_count);
@@ -188,9 +479,23 @@ void SceneTree::_update_group_order(Group &g, bool p_use_priority) {
 		SortArray<Node *, Node::Comparator> node_sort;
 		node_sort.sort(nodes, node_count);
 	}
+
+	for (int i = 0; i < node_count; i++) {
+		nodes[i]->data.grouped[g.name].index = i;
+	}
 	g.changed = false;
 }
 
+void SceneTree::_call_group_job(uint32_t p_index, GroupCallData *p_data) {
+
+	Node *node = p_data->nodes[p_index];
+	if (call_skip.has(node))
+		return;
+
+	Variant::CallError ce;
+	node->call(p_data->function, p_data->args, p_data->argc, ce);
+}
+
 void SceneTree::call_group_flags(uint32_t p_call_flags, const StringName &p_group, const StringName &p_function, VARIANT_ARG_DECLARE) {
 
 	Map<StringName, Group>::Element *E = group_map.find(p_group);
@@ -226,10 +531,44 @@ void SceneTree::call_group_flags(uint32_t p_call_flags, const StringName &p_grou
 
 	_update_group_order(g);
 
+	// Holding a reference keeps this snapshot valid if the group changes
+	// during the calls; only reading it avoids a copy-on-write allocation.
 	Vector<Node *> nodes_copy = g.nodes;
-	Node **nodes = nodes_copy.ptrw();
+	Node *const *nodes = nodes_copy.ptr();
 	int node_count = nodes_copy.size();
 
+	group_calls += node_count;
+
+	if (p_call_flags & GROUP_CALL_PARALLEL) {
+
+		VARIANT_ARGPTRS;
+
+		GroupCallData data;
+		data.nodes = nodes;
+		data.function = p_function;
+		data.args = argptr;
+		data.argc = 0;
+		while (data.argc < VARIANT_ARG_MAX && argptr[data.argc]->get_type() != Variant::NIL)
+			data.argc++;
+
+		call_lock++;
+#ifndef NO_THREADS
+		if (!group_pool) {
+			group_pool = memnew(ThreadWorkPool);
+			group_pool->init();
+		}
+		group_pool->do_work(node_count, this, &SceneTree::_call_group_job, &data);
+#else
+		for (int i = 0; i < node_count; i++) {
+			_call_group_job(i, &data);
+		}
+#endif
+		call_lock--;
+		if (call_lock == 0)
+			call_skip.clear();
+		return;
+	}
+
 	call_lock++;
 
 	if (p_call_flags & GROUP_CALL_REVERSE) {
@@ -248,6 +587,42 @@ void SceneTree::call_group_flags(uint32_t p_call_flags, const StringName &p_grou
 				MessageQueue::get_singleton()->push_call(nodes[i], p_function, VARIANT_ARG_PASS);
 		}
 
+	} else if ((p_call_flags & (GROUP_CALL_REALTIME | GROUP_CALL_MULTILEVEL)) == GROUP_CALL_REALTIME) {
+
+		// Groups are usually made of a few node types, so resolve the method
+		// once per run of nodes sharing a class instead of by name per node.
+		VARIANT_ARGPTRS;
+
+		int argc = 0;
+		while (argc < VARIANT_ARG_MAX && argptr[argc]->get_type() != Variant::NIL)
+			argc++;
+
+		StringName last_class;
+		MethodBind *method = NULL;
+
+		for (int i = 0; i < node_count; i++) {
+
+			Node *node = nodes[i];
+			if (call_lock && call_skip.has(node))
+				continue;
+
+			if (!node->get_script_instance()) {
+				const StringName &class_name = node->get_class_name();
+				if (class_name != last_class) {
+					last_class = class_name;
+					method = ClassDB::get_method(class_name, p_function);
+				}
+				if (method) {
+					Variant::CallError ce;
+					method->call(node, argptr, argc, ce);
+					continue;
+				}
+			}
+
+			Variant::CallError ce;
+			node->call(p_function, argptr, argc, ce);
+		}
+
 	} else {
 
 		for (int i = 0; i < node_count; i++) {
@@ -255,12 +630,9 @@ void SceneTree::call_group_flags(uint32_t p_call_flags, const StringName &p_grou
 			if (call_lock && call_skip.has(nodes[i]))
 				continue;
 
-			if (p_call_flags & GROUP_CALL_REALTIME) {
-				if (p_call_flags & GROUP_CALL_MULTILEVEL)
-					nodes[i]->call_multilevel(p_function, VARIANT_ARG_PASS);
-				else
-					nodes[i]->call(p_function, VARIANT_ARG_PASS);
-			} else
+			if (p_call_flags & GROUP_CALL_REALTIME)
+				nodes[i]->call_multilevel(p_function, VARIANT_ARG_PASS);
+			else
 				MessageQueue::get_singleton()->push_call(nodes[i], p_function, VARIANT_ARG_PASS);
 		}
 	}
@@ -282,9 +654,11 @@ void SceneTree::notify_group_flags(uint32_t p_call_flags, const StringName &p_gr
 	_update_group_order(g);
 
 	Vector<Node *> nodes_copy = g.nodes;
-	Node **nodes = nodes_copy.ptrw();
+	Node *const *nodes = nodes_copy.ptr();
 	int node_count = nodes_copy.size();
 
+	group_calls += node_count;
+
 	call_lock++;
 
 	if (p_call_flags & GROUP_CALL_REVERSE) {
@@ -331,9 +705,11 @@ void SceneTree::set_group_flags(uint32_t p_call_flags, const StringName &p_group
 	_update_group_order(g);
 
 	Vector<Node *> nodes_copy = g.nodes;
-	Node **nodes = nodes_copy.ptrw();
+	Node *const *nodes = nodes_copy.ptr();
 	int node_count = nodes_copy.size();
 
+	group_calls += node_count;
+
 	call_lock++;
 
 	if (p_call_flags & GROUP_CALL_REVERSE) {
@@ -459,6 +835,8 @@ void SceneTree::init() {
 
 bool SceneTree::iteration(float p_time) {
 
+	TRACE_SCOPE("SceneTree::iteration");
+
 	root_lock++;
 
 	current_frame++;
@@ -468,8 +846,10 @@ bool SceneTree::iteration(float p_time) {
 	MainLoop::iteration(p_time);
 	physics_process_time = p_time;
 
-	emit_signal("physics_frame");
+	emit_signal(SNAME("physics_frame"));
 
+	_process_timers(Timer::TIMER_PROCESS_PHYSICS, p_time);
+	_process_tweens(Tween::TWEEN_PROCESS_PHYSICS, p_time);
 	_notify_group_pause("physics_process_internal", Node::NOTIFICATION_INTERNAL_PHYSICS_PROCESS);
 	_notify_group_pause("physics_process", Node::NOTIFICATION_PHYSICS_PROCESS);
 	_flush_ugc();
@@ -494,6 +874,8 @@ void SceneTree::_update_font_oversampling(float p_ratio) {
 
 bool SceneTree::idle(float p_time) {
 
+	TRACE_SCOPE("SceneTree::idle");
+
 	//print_line("ram: "+itos(OS::get_singleton()->get_static_memory_usage())+" sram: "+itos(OS::get_singleton()->get_dynamic_memory_usage()));
 	//print_line("node count: "+itos(get_node_count()));
 	//print_line("TEXTURE RAM: "+itos(VS::get_singleton()->get_render_info(VS::INFO_TEXTURE_MEM_USED)));
@@ -503,17 +885,21 @@ bool SceneTree::idle(float p_time) {
 	MainLoop::idle(p_time);
 
 	idle_process_time = p_time;
+	group_calls_frame = group_calls;
+	group_calls = 0;
 
 	if (multiplayer_poll) {
 		multiplayer->poll();
 	}
 
-	emit_signal("idle_frame");
+	emit_signal(SNAME("idle_frame"));
 
 	MessageQueue::get_singleton()->flush(); //small little hack
 
 	flush_transform_notifications();
 
+	_process_timers(Timer::TIMER_PROCESS_IDLE, p_time);
+	_process_tweens(Tween::TWEEN_PROCESS_IDLE, p_time);
 	_notify_group_pause("idle_process_internal", Node::NOTIFICATION_INTERNAL_PROCESS);
 	_notify_group_pause("idle_process", Node::NOTIFICATION_PROCESS);
 
@@ -554,7 +940,7 @@ bool SceneTree::idle(float p_time) {
 		E->get()->set_time_left(time_left);
 
 		if (time_left < 0) {
-			E->get()->emit_signal("timeout");
+			E->get()->emit_signal(SNAME("timeout"));
 			timers.erase(E);
 		}
 		if (E == L) {
@@ -598,7 +984,7 @@ bool SceneTree::idle(float p_time) {
 
 void SceneTree::finish() {
 
-	_flush_delete_queue();
+	_flush_delete_queue(true);
 
 	_flush_ugc();
 
@@ -955,11 +1341,20 @@ void SceneTree::_notify_group_pause(const StringName &p_group, int p_notificatio
 	int node_count = nodes_copy.size();
 	Node **nodes = nodes_copy.ptrw();
 
+	// Only user processing can be moved off the main thread, internal processing stays on it.
+	bool threaded = p_notification == Node::NOTIFICATION_PROCESS || p_notification == Node::NOTIFICATION_PHYSICS_PROCESS;
+	bool has_thread_groups = false;
+
 	call_lock++;
 
 	for (int i = 0; i < node_count; i++) {
 
 		Node *n = nodes[i];
+		if (threaded && n->data.process_thread_group) {
+			has_thread_groups = true;
+			continue;
+		}
+
 		if (call_lock && call_skip.has(n))
 			continue;
 
@@ -972,11 +1367,95 @@ void SceneTree::_notify_group_pause(const StringName &p_group, int p_notificatio
 		//ERR_FAIL_COND(node_count != g.nodes.size());
 	}
 
+	if (has_thread_groups) {
+
+		// Sorted after the main thread nodes ran, so nodes they freed or paused are left out.
+		for (int i = 0; i < process_thread_groups.size(); i++) {
+			process_thread_groups.write[i].count = 0;
+		}
+
+		int last = -1;
+		for (int i = 0; i < node_count; i++) {
+
+			Node *n = nodes[i];
+			int id = n->data.process_thread_group;
+			if (!id)
+				continue;
+
+			if (call_lock && call_skip.has(n))
+				continue;
+			if (!n->can_process())
+				continue;
+			if (!n->can_process_notification(p_notification))
+				continue;
+
+			if (last == -1 || process_thread_groups[last].id != id) {
+				last = -1;
+				for (int j = 0; j < process_thread_groups.size(); j++) {
+					if (process_thread_groups[j].id == id) {
+						last = j;
+						break;
+					}
+				}
+				if (last == -1) {
+					ProcessThreadGroup ptg;
+					ptg.id = id;
+					ptg.count = 0;
+					process_thread_groups.push_back(ptg);
+					last = process_thread_groups.size() - 1;
+				}
+			}
+
+			ProcessThreadGroup &ptg = process_thread_groups.write[last];
+			if (ptg.count == ptg.nodes.size()) {
+				ptg.nodes.resize(MAX(ptg.count * 2, 16));
+			}
+			ptg.nodes.write[ptg.count++] = n;
+		}
+
+		// Groups left empty would only cost the workers a wakeup.
+		int to = 0;
+		for (int i = 0; i < process_thread_groups.size(); i++) {
+			if (process_thread_groups[i].count) {
+				if (to != i) {
+					SWAP(process_thread_groups.write[to], process_thread_groups.write[i]);
+				}
+				to++;
+			}
+		}
+
+		if (to) {
+			process_threads_active = true;
+#ifndef NO_THREADS
+			if (!group_pool) {
+				group_pool = memnew(ThreadWorkPool);
+				group_pool->init();
+			}
+			group_pool->do_work(to, this, &SceneTree::_process_thread_group_job, p_notification);
+#else
+			for (int i = 0; i < to; i++) {
+				_process_thread_group_job(i, p_notification);
+			}
+#endif
+			process_threads_active = false;
+		}
+	}
+
 	call_lock--;
 	if (call_lock == 0)
 		call_skip.clear();
 }
 
+void SceneTree::_process_thread_group_job(uint32_t p_index, int p_notification) {
+
+	// Read only access, a write accessor would race on the copy-on-write check.
+	const ProcessThreadGroup &ptg = process_thread_groups[p_index];
+	Node *const *nodes = ptg.nodes.ptr();
+	for (int i = 0; i < ptg.count; i++) {
+		nodes[i]->notification(p_notification);
+	}
+}
+
 /*
 void SceneMainLoop::_update_listener_2d() {
 
@@ -1097,26 +1576,142 @@ static void _fill_array(Node *p_node, Array &array, int p_level) {
 	}
 }
 
-void SceneTree::_debugger_request_tree(void *self) {
+void SceneTree::_debugger_request_tree(void *self, bool p_full) {
 
 	SceneTree *sml = (SceneTree *)self;
 
+#ifdef DEBUG_ENABLED
+	if (!p_full && sml->debugger_tree_sent && !sml->debugger_tree_full) {
+		// the debugger already has the tree, only send what changed since then
+		if (sml->debugger_tree_changes.size()) {
+			ScriptDebugger::get_singleton()->send_message("scene_tree_diff", sml->debugger_tree_changes);
+			sml->debugger_tree_changes = Array(); // the message keeps a reference to the sent one
+		}
+		return;
+	}
+
+	sml->debugger_tree_sent = true;
+	sml->debugger_tree_full = false;
+	sml->debugger_tree_changes = Array();
+#endif
+
 	Array arr;
 	_fill_array(sml->root, arr, 0);
 	ScriptDebugger::get_singleton()->send_message("scene_tree", arr);
 }
 
-void SceneTree::_flush_delete_queue() {
+#ifdef DEBUG_ENABLED
+bool SceneTree::_debugger_tree_track(int p_entries) {
+
+	if (!debugger_tree_sent || debugger_tree_full)
+		return false;
+
+	if (debugger_tree_changes.size() + p_entries > DEBUGGER_TREE_MAX_CHANGES) {
+		// cheaper to send the whole tree again than to keep tracking
+		debugger_tree_full = true;
+		debugger_tree_changes = Array();
+		return false;
+	}
+
+	return true;
+}
+#endif
+
+void SceneTree::_flush_delete_queue(bool p_all) {
 
 	_THREAD_SAFE_METHOD_
 
-	while (delete_queue.size()) {
+	if (delete_queue.empty() && delete_pending.empty())
+		return;
+
+	// every node leaving the tree would emit tree_changed, emit it once for the whole batch
+	tree_changed_batch++;
+
+	Vector<DeleteEntry> entries;
+	HashMap<ObjectID, int> parent_order;
+
+	while (delete_queue.size()) { // deleting may queue more objects
+
+		entries.resize(0);
+		parent_order.clear();
+
+		for (List<ObjectID>::Element *E = delete_queue.front(); E; E = E->next()) {
+
+			Object *obj = ObjectDB::get_instance(E->get());
+			if (!obj)
+				continue;
+
+			DeleteEntry entry;
+			entry.id = E->get();
+			entry.order = entries.size();
+			entry.pos = 0;
+
+			Node *node = Object::cast_to<Node>(obj);
+			if (node && node->get_parent()) {
+				ObjectID parent = node->get_parent()->get_instance_id();
+				int *order = parent_order.getptr(parent);
+				if (order) {
+					entry.order = *order;
+				} else {
+					parent_order.set(parent, entry.order);
+				}
+				entry.pos = node->get_position_in_parent();
+			}
+
+			entries.push_back(entry);
+		}
+		delete_queue.clear();
+
+		entries.sort_custom<DeleteEntrySort>();
 
-		Object *obj = ObjectDB::get_instance(delete_queue.front()->get());
-		if (obj) {
-			memdelete(obj);
+		for (int i = 0; i < entries.size(); i++) {
+
+			// may have been freed along with an ancestor
+			Object *obj = ObjectDB::get_instance(entries[i].id);
+			if (!obj)
+				continue;
+
+			Node *node = Object::cast_to<Node>(obj);
+			if (node && !p_all && delete_budget_usec > 0) {
+				// leave the tree right away, the destruction itself is spread over the following frames
+				if (node->get_parent()) {
+					node->get_parent()->remove_child(node);
+				}
+				delete_pending.push_back(entries[i].id);
+			} else {
+				memdelete(obj);
+			}
 		}
-		delete_queue.pop_front();
+	}
+
+	uint64_t until = OS::get_singleton()->get_ticks_usec() + delete_budget_usec;
+
+	while (delete_pending.size()) {
+
+		Object *obj = ObjectDB::get_instance(delete_pending.front()->get());
+		delete_pending.pop_front();
+		if (!obj)
+			continue;
+
+		Node *node = Object::cast_to<Node>(obj);
+		if (node) {
+			// free large subtrees a node at a time, detaching from the back is cheap outside the tree
+			while (node->get_child_count()) {
+				Node *child = node->get_child(node->get_child_count() - 1);
+				node->remove_child(child);
+				delete_pending.push_front(child->get_instance_id());
+			}
+		}
+		memdelete(obj);
+
+		if (!p_all && OS::get_singleton()->get_ticks_usec() >= until)
+			break;
+	}
+
+	tree_changed_batch--;
+	if (tree_changed_pending) {
+		tree_changed_pending = false;
+		emit_signal(tree_changed_name);
 	}
 }
 
@@ -1750,6 +2345,10 @@ void SceneTree::set_multiplayer(Ref<MultiplayerAPI> p_multiplayer) {
 	multiplayer->connect("connected_to_server", this, "_connected_to_server");
 	multiplayer->connect("connection_failed", this, "_connection_failed");
 	multiplayer->connect("server_disconnected", this, "_server_disconnected");
+
+	if (ScriptDebugger::get_singleton()) {
+		ScriptDebugger::get_singleton()->set_multiplayer(multiplayer);
+	}
 }
 
 void SceneTree::set_network_peer(const Ref<NetworkedMultiplayerPeer> &p_network_peer) {
@@ -1913,6 +2512,7 @@ void SceneTree::_bind_methods() {
 	BIND_ENUM_CONSTANT(GROUP_CALL_REVERSE);
 	BIND_ENUM_CONSTANT(GROUP_CALL_REALTIME);
 	BIND_ENUM_CONSTANT(GROUP_CALL_UNIQUE);
+	BIND_ENUM_CONSTANT(GROUP_CALL_PARALLEL);
 
 	BIND_ENUM_CONSTANT(STRETCH_MODE_DISABLED);
 	BIND_ENUM_CONSTANT(STRETCH_MODE_2D);
@@ -1963,9 +2563,16 @@ SceneTree::SceneTree() {
 	quit_on_go_back = true;
 	initialized = false;
 	use_font_oversampling = false;
+	xform_change_pass = 0;
+	group_calls = 0;
+	group_calls_frame = 0;
+	group_pool = NULL;
+	process_threads_active = false;
 #ifdef DEBUG_ENABLED
 	debug_collisions_hint = false;
 	debug_navigation_hint = false;
+	debugger_tree_sent = false;
+	debugger_tree_full = false;
 #endif
 	debug_collisions_color = GLOBAL_DEF("debug/shapes/collision/shape_color", Color(0.0, 0.6, 0.7, 0.5));
 	debug_collision_contact_color = GLOBAL_DEF("debug/shapes/collision/contact_color", Color(1.0, 0.2, 0.1, 0.8));
@@ -1974,6 +2581,11 @@ SceneTree::SceneTree() {
 	collision_debug_contacts = GLOBAL_DEF("debug/shapes/collision/max_contacts_displayed", 10000);
 	ProjectSettings::get_singleton()->set_custom_property_info("debug/shapes/collision/max_contacts_displayed", PropertyInfo(Variant::INT, "debug/shapes/collision/max_contacts_displayed", PROPERTY_HINT_RANGE, "0,20000,1")); // No negative
 
+	delete_budget_usec = GLOBAL_DEF("memory/limits/delete_queue/frame_budget_usec", 0);
+	ProjectSettings::get_singleton()->set_custom_property_info("memory/limits/delete_queue/frame_budget_usec", PropertyInfo(Variant::INT, "memory/limits/delete_queue/frame_budget_usec", PROPERTY_HINT_RANGE, "0,100000,1,or_greater"));
+	tree_changed_batch = 0;
+	tree_changed_pending = false;
+
 	tree_version = 1;
 	physics_process_time = 1;
 	idle_process_time = 1;
@@ -1999,7 +2611,11 @@ SceneTree::SceneTree() {
 
 	// Initialize network state
 	multiplayer_poll = true;
-	set_multiplayer(Ref<MultiplayerAPI>(memnew(MultiplayerAPI)));
+	Ref<MultiplayerAPI> multiplayer_api = memnew(MultiplayerAPI);
+#ifndef NO_THREADS
+	multiplayer_api->set_threaded_polling(GLOBAL_DEF("network/multiplayer/threaded_polling", false));
+#endif
+	set_multiplayer(multiplayer_api);
 
 	//root->set_world_2d( Ref<World2D>( memnew( World2D )));
 	root->set_as_audio_listener(true);
@@ -2101,4 +2717,11 @@ SceneTree::SceneTree() {
 }
 
 SceneTree::~SceneTree() {
+
+	if (ScriptDebugger::get_singleton()) {
+		ScriptDebugger::get_singleton()->set_multiplayer(Ref<MultiplayerAPI>());
+	}
+	if (group_pool) {
+		memdelete(group_pool);
+	}
 }
@@ -46,8 +46,12 @@
 class PackedScene;
 class Node;
 class Viewport;
+class VisualInstance;
 class Material;
+class ThreadWorkPool;
 class Mesh;
+class Timer;
+class Tween;
 
 class SceneTreeTimer : public Reference {
 	GDCLASS(SceneTreeTimer, Reference);
@@ -97,9 +101,14 @@ private:
 	struct Group {
 
 		Vector<Node *> nodes;
+		StringName name;
 		//uint64_t last_tree_version;
+		int removed; // NULL slots left by remove_from_group(), compacted by _update_group_order()
 		bool changed;
-		Group() { changed = false; };
+		Group() {
+			removed = 0;
+			changed = false;
+		};
 	};
 
 	Viewport *root;
@@ -131,6 +140,9 @@ private:
 	int64_t current_frame;
 	int64_t current_event;
 	int node_count;
+	uint64_t group_calls;
+	uint64_t group_calls_frame;
+	ThreadWorkPool *group_pool;
 
 #ifdef TOOLS_ENABLED
 	Node *edited_scene_root;
@@ -157,11 +169,50 @@ private:
 
 	List<ObjectID> delete_queue;
 
+	struct DeleteEntry {
+		ObjectID id;
+		int order; // queue order of the first entry sharing this parent
+		int pos;
+	};
+
+	struct DeleteEntrySort {
+		// siblings go from the last one backwards, so removing one does not move and notify the others
+		_FORCE_INLINE_ bool operator()(const DeleteEntry &p_a, const DeleteEntry &p_b) const {
+			return p_a.order == p_b.order ? p_a.pos > p_b.pos : p_a.order < p_b.order;
+		}
+	};
+
+	List<ObjectID> delete_pending; // detached nodes destroyed within delete_budget_usec per frame
+	uint64_t delete_budget_usec;
+
+	int tree_changed_batch;
+	bool tree_changed_pending;
+
 	Map<UGCall, Vector<Variant> > unique_group_calls;
 	bool ugc_locked;
 	void _flush_ugc();
 
 	_FORCE_INLINE_ void _update_group_order(Group &g, bool p_use_priority = false);
+
+	struct GroupCallData {
+		Node *const *nodes;
+		StringName function;
+		const Variant **args;
+		int argc;
+	};
+
+	void _call_group_job(uint32_t p_index, GroupCallData *p_data);
+
+	struct ProcessThreadGroup {
+		int id;
+		Vector<Node *> nodes; // only grows, so buckets are not reallocated every frame
+		int count;
+	};
+
+	Vector<ProcessThreadGroup> process_thread_groups;
+	bool process_threads_active;
+
+	void _process_thread_group_job(uint32_t p_index, int p_notification);
 	void _update_listener();
 
 	Array _get_nodes_in_group(const StringName &p_group);
@@ -201,6 +252,8 @@ private:
 	void tree_changed();
 	void node_added(Node *p_node);
 	void node_removed(Node *p_node);
+	void node_renamed(Node *p_node);
+	void node_moved(Node *p_node, int p_pos);
 
 	Group *add_to_group(const StringName &p_group, Node *p_node);
 	void remove_from_group(const StringName &p_group, Node *p_node);
@@ -211,17 +264,79 @@ private:
 	Variant _call_group_flags(const Variant **p_args, int p_argcount, Variant::CallError &r_error);
 	Variant _call_group(const Variant **p_args, int p_argcount, Variant::CallError &r_error);
 
-	static void _debugger_request_tree(void *self);
-	void _flush_delete_queue();
+	static void _debugger_request_tree(void *self, bool p_full);
+	void _flush_delete_queue(bool p_all = false);
 	//optimization
 	friend class CanvasItem;
 	friend class Spatial;
 	friend class Viewport;
+	friend class VisualInstance;
 
 	SelfList<Node>::List xform_change_list;
+	// Nodes processed on a thread group can queue transform changes concurrently.
+	_FORCE_INLINE_ void _add_xform_change(SelfList<Node> *p_elem) {
+		if (process_threads_active) {
+			_THREAD_SAFE_METHOD_
+			xform_change_list.add(p_elem);
+		} else {
+			xform_change_list.add(p_elem);
+		}
+	}
+	uint32_t xform_change_pass; // bumped whenever nodes leave xform_change_list, see Spatial::_propagate_transform_changed()
+	SelfList<VisualInstance>::List visual_xform_list; // visual instances whose transform goes to the server in the next batch
+
+	void _flush_visual_instance_transforms();
+
+	// Running timers and tweens are ticked from flat arrays, one per process
+	// mode, instead of going through the internal process groups.
+	friend class Timer;
+	friend class Tween;
+
+	struct TimerSchedule {
+		Vector<Timer *> timers;
+		Vector<double> time_left; // authoritative while the timer is scheduled
+		int removed; // NULL slots, compacted before the next tick
+		TimerSchedule() {
+			removed = 0;
+		}
+	};
+
+	struct TweenSchedule {
+		Vector<Tween *> tweens;
+		int removed;
+		TweenSchedule() {
+			removed = 0;
+		}
+	};
+
+	TimerSchedule timer_schedule[2]; // indexed by Timer::TimerProcessMode
+	TweenSchedule tween_schedule[2]; // indexed by Tween::TweenProcessMode
+
+	void _schedule_timer(Timer *p_timer);
+	void _unschedule_timer(Timer *p_timer);
+	double _get_scheduled_time_left(const Timer *p_timer) const;
+	void _schedule_tween(Tween *p_tween);
+	void _unschedule_tween(Tween *p_tween);
+	void _process_timers(int p_mode, float p_time);
+	void _process_tweens(int p_mode, float p_time);
 
 #ifdef DEBUG_ENABLED
 
+	enum {
+		DEBUGGER_TREE_ADD, // parent id, position, name, class, id
+		DEBUGGER_TREE_REMOVE, // id
+		DEBUGGER_TREE_RENAME, // id, name
+		DEBUGGER_TREE_MOVE, // id, position
+		DEBUGGER_TREE_MAX_CHANGES = 16384 // array entries, past this the whole tree is sent again
+	};
+
+	// changes to the tree since it was last sent to the remote debugger
+	bool debugger_tree_sent;
+	bool debugger_tree_full;
+	Array debugger_tree_changes;
+
+	bool _debugger_tree_track(int p_entries);
+
 	Map<int, NodePath> live_edit_node_path_cache;
 	Map<int, String> live_edit_resource_cache;
 
@@ -296,6 +411,7 @@ public:
 		GROUP_CALL_REALTIME = 2,
 		GROUP_CALL_UNIQUE = 4,
 		GROUP_CALL_MULTILEVEL = 8,
+		GROUP_CALL_PARALLEL = 16,
 	};
 
 	_FORCE_INLINE_ Viewport *get_root() const { return root; }
@@ -378,6 +494,7 @@ public:
 	int64_t get_event_count() const;
 
 	int get_node_count() const;
+	uint64_t get_group_call_count() const { return group_calls_frame; }
 
 	void queue_delete(Object *p_object);
 
@@ -31,6 +31,7 @@
 #include "timer.h"
 
 #include "core/engine.h"
+#include "scene/main/scene_tree.h"
 
 void Timer::_notification(int p_what) {
 
@@ -47,34 +48,13 @@ void Timer::_notification(int p_what) {
 				autostart = false;
 			}
 		} break;
-		case NOTIFICATION_INTERNAL_PROCESS: {
-			if (timer_process_mode == TIMER_PROCESS_PHYSICS || !is_processing_internal())
-				return;
-			time_left -= get_process_delta_time();
-
-			if (time_left < 0) {
-				if (!one_shot)
-					time_left += wait_time;
-				else
-					stop();
-
-				emit_signal("timeout");
-			}
+		case NOTIFICATION_ENTER_TREE: {
 
+			_schedule();
 		} break;
-		case NOTIFICATION_INTERNAL_PHYSICS_PROCESS: {
-			if (timer_process_mode == TIMER_PROCESS_IDLE || !is_physics_processing_internal())
-				return;
-			time_left -= get_physics_process_delta_time();
-
-			if (time_left < 0) {
-				if (!one_shot)
-					time_left += wait_time;
-				else
-					stop();
-				emit_signal("timeout");
-			}
+		case NOTIFICATION_EXIT_TREE: {
 
+			_unschedule();
 		} break;
 	}
 }
@@ -108,16 +88,19 @@ bool Timer::has_autostart() const {
 }
 
 void Timer::start(float p_time) {
+	_unschedule();
 	if (p_time > 0) {
 		set_wait_time(p_time);
 	}
 	time_left = wait_time;
-	_set_process(true);
+	processing = true;
+	_schedule();
 }
 
 void Timer::stop() {
+	_unschedule();
 	time_left = -1;
-	_set_process(false);
+	processing = false;
 	autostart = false;
 }
 
@@ -125,8 +108,9 @@ void Timer::set_paused(bool p_paused) {
 	if (paused == p_paused)
 		return;
 
+	_unschedule();
 	paused = p_paused;
-	_set_process(processing);
+	_schedule();
 }
 
 bool Timer::is_paused() const {
@@ -139,7 +123,8 @@ bool Timer::is_stopped() const {
 
 float Timer::get_time_left() const {
 
-	return time_left > 0 ? time_left : 0;
+	double left = scheduled_index >= 0 ? get_tree()->_get_scheduled_time_left(this) : time_left;
+	return left > 0 ? left : 0;
 }
 
 void Timer::set_timer_process_mode(TimerProcessMode p_mode) {
@@ -147,21 +132,9 @@ void Timer::set_timer_process_mode(TimerProcessMode p_mode) {
 	if (timer_process_mode == p_mode)
 		return;
 
-	switch (timer_process_mode) {
-		case TIMER_PROCESS_PHYSICS:
-			if (is_physics_processing_internal()) {
-				set_physics_process_internal(false);
-				set_process_internal(true);
-			}
-			break;
-		case TIMER_PROCESS_IDLE:
-			if (is_processing_internal()) {
-				set_process_internal(false);
-				set_physics_process_internal(true);
-			}
-			break;
-	}
+	_unschedule();
 	timer_process_mode = p_mode;
+	_schedule();
 }
 
 Timer::TimerProcessMode Timer::get_timer_process_mode() const {
@@ -169,12 +142,18 @@ Timer::TimerProcessMode Timer::get_timer_process_mode() const {
 	return timer_process_mode;
 }
 
-void Timer::_set_process(bool p_process, bool p_force) {
-	switch (timer_process_mode) {
-		case TIMER_PROCESS_PHYSICS: set_physics_process_internal(p_process && !paused); break;
-		case TIMER_PROCESS_IDLE: set_process_internal(p_process && !paused); break;
-	}
-	processing = p_process;
+void Timer::_schedule() {
+
+	if (scheduled_index >= 0 || !processing || paused || !is_inside_tree())
+		return;
+	get_tree()->_schedule_timer(this);
+}
+
+void Timer::_unschedule() {
+
+	if (scheduled_index < 0)
+		return;
+	get_tree()->_unschedule_timer(this);
 }
 
 void Timer::_bind_methods() {
@@ -222,4 +201,5 @@ Timer::Timer() {
 	time_left = -1;
 	processing = false;
 	paused = false;
+	scheduled_index = -1;
 }
@@ -44,6 +44,9 @@ class Timer : public Node {
 	bool paused;
 
 	double time_left;
+	int scheduled_index; // slot in the SceneTree timer schedule, -1 when not ticking
+
+	friend class SceneTree;
 
 protected:
 	void _notification(int p_what);
@@ -80,7 +83,8 @@ public:
 
 private:
 	TimerProcessMode timer_process_mode;
-	void _set_process(bool p_process, bool p_force = false);
+	void _schedule();
+	void _unschedule();
 };
 
 VARIANT_ENUM_CAST(Timer::TimerProcessMode);
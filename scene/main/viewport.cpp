@@ -30,6 +30,8 @@
 
 #include "viewport.h"
 
+#include "core/message_queue.h"
+#include "core/os/frame_arena.h"
 #include "core/os/input.h"
 #include "core/os/os.h"
 #include "core/project_settings.h"
@@ -198,6 +200,8 @@ Viewport::GUI::GUI() {
 	tooltip_label = NULL;
 	subwindow_visibility_dirty = false;
 	subwindow_order_dirty = false;
+	pick_dirty = true;
+	sort_flush_queued = false;
 }
 
 /////////////////////////////////////
@@ -548,7 +552,7 @@ void Viewport::_notification(int p_what) {
 						}
 
 						if (is_mouse) {
-							List<Map<ObjectID, uint64_t>::Element *> to_erase;
+							List<Map<ObjectID, uint64_t>::Element *, FrameArena> to_erase;
 
 							for (Map<ObjectID, uint64_t>::Element *E = physics_2d_mouseover.front(); E; E = E->next()) {
 								if (E->get() != frame) {
@@ -1283,6 +1287,10 @@ Ref<InputEvent> Viewport::_make_input_local(const Ref<InputEvent> &ev) {
 	Vector2 vp_ofs = _get_window_offset();
 	Transform2D ai = get_final_transform().affine_inverse() * _get_input_pre_xform();
 
+	if (vp_ofs == Vector2() && ai == Transform2D()) {
+		return ev; // already local, don't copy it
+	}
+
 	return ev->xformed_by(ai, -vp_ofs);
 }
 
@@ -1384,6 +1392,69 @@ void Viewport::_gui_sort_modal_stack() {
 	gui.modal_stack.sort_custom<Control::CComparator>();
 }
 
+void Viewport::_gui_queue_sort(Container *p_container) {
+
+	gui.sort_queue.add_last(&p_container->sort_item);
+
+	if (!gui.sort_flush_queued) {
+		MessageQueue::get_singleton()->push_call(this, "_gui_flush_sorts");
+		gui.sort_flush_queued = true;
+	}
+}
+
+void Viewport::_gui_unqueue_sort(Container *p_container) {
+
+	gui.sort_queue.remove(&p_container->sort_item);
+}
+
+struct _ContainerSortPending {
+
+	ObjectID id;
+	int depth;
+
+	bool operator<(const _ContainerSortPending &p_other) const { return depth < p_other.depth; }
+};
+
+void Viewport::_gui_flush_sorts() {
+
+	// Lay out parents before their children: when a container resizes a child
+	// container that is also pending, the child is then sorted only once, at its
+	// final size. Sorts queued while flushing are handled in the next pass.
+	Vector<_ContainerSortPending> pending;
+
+	while (gui.sort_queue.first()) {
+
+		pending.clear();
+
+		while (SelfList<Container> *E = gui.sort_queue.first()) {
+
+			Container *c = E->self();
+			gui.sort_queue.remove(E);
+
+			_ContainerSortPending p;
+			p.id = c->get_instance_id();
+			p.depth = 0;
+			for (Node *n = c->get_parent(); n; n = n->get_parent()) {
+				p.depth++;
+			}
+			pending.push_back(p);
+		}
+
+		pending.sort();
+
+		for (int i = 0; i < pending.size(); i++) {
+
+			// Sorting a container may free others, so look them up again.
+			Container *c = Object::cast_to<Container>(ObjectDB::get_instance(pending[i].id));
+			if (c && c->pending_sort) {
+				c->_sort_children();
+			}
+		}
+	}
+
+	gui.sort_flush_queued = false;
+}
+
 void Viewport::_gui_sort_roots() {
 
 	if (!gui.roots_order_dirty)
@@ -1402,6 +1473,7 @@ void Viewport::_gui_cancel_tooltip() {
 		gui.tooltip_popup->queue_delete();
 		gui.tooltip_popup = NULL;
 		gui.tooltip_label = NULL;
+		gui.pick_dirty = true;
 	}
 }
 
@@ -1587,10 +1659,19 @@ void Viewport::_gui_call_notification(Control *p_control, int p_what) {
 Control *Viewport::_gui_find_control(const Point2 &p_global) {
 
 	_gui_prepare_subwindows();
+	_gui_sort_roots();
 
-	for (List<Control *>::Element *E = gui.subwindows.back(); E; E = E->prev()) {
+	if (gui.pick_dirty) {
+		_gui_build_pick_index();
+	}
+
+	const GUIPickEntry *entries = gui.pick_entries.ptr();
+	const int *cells = gui.pick_cells.ptr();
+
+	for (int i = 0; i < gui.pick_roots.size(); i++) {
 
-		Control *sw = E->get();
+		const GUIPickRoot &pr = gui.pick_roots[i];
+		Control *sw = pr.control;
 		if (!sw->is_visible_in_tree())
 			continue;
 
@@ -1601,32 +1682,279 @@ Control *Viewport::_gui_find_control(const Point2 &p_global) {
 		else
 			xform = sw->get_canvas_transform();
 
-		Control *ret = _gui_find_control_at_pos(sw, p_global, xform, gui.focus_inv_xform);
-		if (ret)
-			return ret;
+		if (pr.fallback) {
+			Control *ret = _gui_find_control_at_pos(sw, p_global, xform, gui.focus_inv_xform);
+			if (ret)
+				return ret;
+			continue;
+		}
+
+		if (xform.basis_determinant() == 0.0f)
+			continue;
+
+		Transform2D inv_xform = xform.affine_inverse();
+		Point2 pos = inv_xform.xform(p_global);
+
+		const int *list;
+		int count;
+		if (pr.grid_w && pr.bounds.has_point(pos)) {
+			int x = MIN(int((pos.x - pr.bounds.position.x) / pr.cell_size.x), pr.grid_w - 1);
+			int y = MIN(int((pos.y - pr.bounds.position.y) / pr.cell_size.y), pr.grid_h - 1);
+			int cell = pr.cells + y * pr.grid_w + x;
+			list = &cells[cells[cell]];
+			count = cells[cell + 1] - cells[cell];
+		} else {
+			list = &cells[pr.unbounded];
+			count = pr.unbounded_count;
+		}
+
+		// Lists are in the order the tree walk would find the controls in.
+		for (int j = 0; j < count; j++) {
+
+			const GUIPickEntry &e = entries[list[j]];
+			Control *c = e.control;
+
+			if (!c->has_point(e.inv_xform.xform(pos)))
+				continue;
+
+			bool clipped = false;
+			for (int k = e.clip; k != -1; k = entries[k].clip) {
+				if (!entries[k].control->has_point(entries[k].inv_xform.xform(pos))) {
+					clipped = true;
+					break;
+				}
+			}
+			if (clipped)
+				continue;
+
+			if (gui.drag_preview && (c == gui.drag_preview || gui.drag_preview->is_a_parent_of(c)))
+				continue;
+
+			gui.focus_inv_xform = e.inv_xform * inv_xform;
+			return c;
+		}
 	}
 
-	_gui_sort_roots();
+	return NULL;
+}
+
+void Viewport::_gui_build_pick_index() {
+
+	gui.pick_roots.clear();
+	gui.pick_entries.clear();
+	gui.pick_cells.clear();
+
+	for (List<Control *>::Element *E = gui.subwindows.back(); E; E = E->prev()) {
+		_gui_build_pick_root(E->get());
+	}
 
 	for (List<Control *>::Element *E = gui.roots.back(); E; E = E->prev()) {
+		_gui_build_pick_root(E->get());
+	}
 
-		Control *sw = E->get();
-		if (!sw->is_visible_in_tree())
+	gui.pick_dirty = false;
+}
+
+void Viewport::_gui_build_pick_root(Control *p_root) {
+
+	GUIPickRoot pr;
+	pr.control = p_root;
+	pr.fallback = false;
+	pr.grid_w = 0;
+	pr.grid_h = 0;
+
+	int first_entry = gui.pick_entries.size();
+	Vector<int> order;
+	Vector<Rect2> rects;
+
+	if (!_gui_build_pick_node(p_root, Transform2D(), -1, Rect2(), false, order, rects)) {
+		gui.pick_entries.resize(first_entry);
+		pr.fallback = true;
+		gui.pick_roots.push_back(pr);
+		return;
+	}
+
+	int count = order.size();
+	const Rect2 *r = rects.ptr();
+
+	bool has_bounds = false;
+	for (int i = 0; i < count; i++) {
+		if (r[i].size.x < 0)
 			continue;
+		if (has_bounds) {
+			pr.bounds = pr.bounds.merge(r[i]);
+		} else {
+			pr.bounds = r[i];
+			has_bounds = true;
+		}
+	}
 
-		Transform2D xform;
-		CanvasItem *pci = sw->get_parent_item();
-		if (pci)
-			xform = pci->get_global_transform_with_canvas();
-		else
-			xform = sw->get_canvas_transform();
+	if (has_bounds) {
+		pr.grid_w = CLAMP(int(Math::sqrt((float)count)), 1, 64);
+		pr.grid_h = pr.grid_w;
+		pr.cell_size = Vector2(MAX(pr.bounds.size.x, CMP_EPSILON) / pr.grid_w, MAX(pr.bounds.size.y, CMP_EPSILON) / pr.grid_h);
+	}
 
-		Control *ret = _gui_find_control_at_pos(sw, p_global, xform, gui.focus_inv_xform);
-		if (ret)
-			return ret;
+	// Cell offsets first, filled by counting sort, then the entries of every cell.
+	int cell_count = pr.grid_w * pr.grid_h;
+	pr.cells = gui.pick_cells.size();
+	gui.pick_cells.resize(pr.cells + cell_count + 1);
+	int *offsets = gui.pick_cells.ptrw() + pr.cells;
+	for (int i = 0; i <= cell_count; i++) {
+		offsets[i] = 0;
 	}
 
-	return NULL;
+	Vector<Rect2i> ranges;
+	ranges.resize(count);
+	Rect2i *range = ranges.ptrw();
+	int unbounded_count = 0;
+
+	for (int i = 0; i < count; i++) {
+
+		if (r[i].size.x < 0) {
+			range[i] = Rect2i(0, 0, pr.grid_w, pr.grid_h);
+			unbounded_count++;
+		} else {
+			Point2 from = (r[i].position - pr.bounds.position) / pr.cell_size;
+			Point2 to = (r[i].position + r[i].size - pr.bounds.position) / pr.cell_size;
+			int x0 = CLAMP(int(from.x), 0, pr.grid_w - 1);
+			int y0 = CLAMP(int(from.y), 0, pr.grid_h - 1);
+			int x1 = CLAMP(int(to.x), 0, pr.grid_w - 1);
+			int y1 = CLAMP(int(to.y), 0, pr.grid_h - 1);
+			range[i] = Rect2i(x0, y0, x1 - x0 + 1, y1 - y0 + 1);
+		}
+
+		for (int y = range[i].position.y; y < range[i].position.y + range[i].size.y; y++) {
+			for (int x = range[i].position.x; x < range[i].position.x + range[i].size.x; x++) {
+				offsets[y * pr.grid_w + x + 1]++;
+			}
+		}
+	}
+
+	int base = pr.cells + cell_count + 1;
+	int total = 0;
+	for (int i = 0; i < cell_count; i++) {
+		total += offsets[i + 1];
+		offsets[i + 1] = total;
+	}
+
+	pr.unbounded = base + total;
+	pr.unbounded_count = unbounded_count;
+	gui.pick_cells.resize(base + total + unbounded_count);
+
+	int *cells = gui.pick_cells.ptrw();
+	offsets = cells + pr.cells;
+	Vector<int> fill;
+	fill.resize(cell_count);
+	int *fill_pos = fill.ptrw();
+	for (int i = 0; i < cell_count; i++) {
+		offsets[i] += base;
+		fill_pos[i] = offsets[i];
+	}
+	offsets[cell_count] += base;
+
+	int unbounded_pos = pr.unbounded;
+	for (int i = 0; i < count; i++) {
+
+		for (int y = range[i].position.y; y < range[i].position.y + range[i].size.y; y++) {
+			for (int x = range[i].position.x; x < range[i].position.x + range[i].size.x; x++) {
+				cells[fill_pos[y * pr.grid_w + x]++] = order[i];
+			}
+		}
+
+		if (r[i].size.x < 0) {
+			cells[unbounded_pos++] = order[i];
+		}
+	}
+
+	gui.pick_roots.push_back(pr);
+}
+
+bool Viewport::_gui_build_pick_node(CanvasItem *p_node, const Transform2D &p_xform, int p_clip, const Rect2 &p_clip_rect, bool p_clipped, Vector<int> &r_order, Vector<Rect2> &r_rects) {
+
+	// Mirrors _gui_find_control_at_pos(), which is still used for roots this can't index.
+
+	if (!p_node->is_visible())
+		return true;
+
+	Control *c = Object::cast_to<Control>(p_node);
+	if (!c)
+		return false;
+
+	if (c->get_script_instance() && c->get_script_instance()->has_method(SceneStringNames::get_singleton()->_clips_input))
+		return false;
+
+	Transform2D matrix = p_xform * c->get_transform();
+	if (matrix.basis_determinant() == 0.0f)
+		return true;
+
+	Rect2 pick_rect;
+	bool bounded = c->_get_pick_rect(pick_rect);
+	if (bounded) {
+		// Grown a little, so rounding can't drop points on the edge of the control.
+		pick_rect = matrix.xform(pick_rect).grow(1);
+	}
+
+	int entry = -1;
+	int clip = p_clip;
+	Rect2 clip_rect = p_clip_rect;
+	bool clipped = p_clipped;
+
+	if (c->clips_input()) {
+
+		GUIPickEntry e;
+		e.control = c;
+		e.inv_xform = matrix.affine_inverse();
+		e.clip = p_clip;
+		entry = gui.pick_entries.size();
+		gui.pick_entries.push_back(e);
+
+		clip = entry;
+		if (bounded) {
+			clip_rect = clipped ? clip_rect.clip(pick_rect) : pick_rect;
+			clipped = true;
+		}
+	}
+
+	if (p_node != gui.tooltip_popup) {
+
+		for (int i = p_node->get_child_count() - 1; i >= 0; i--) {
+
+			CanvasItem *ci = Object::cast_to<CanvasItem>(p_node->get_child(i));
+			if (!ci || ci->is_set_as_toplevel())
+				continue;
+
+			if (!_gui_build_pick_node(ci, matrix, clip, clip_rect, clipped, r_order, r_rects))
+				return false;
+		}
+	}
+
+	if (c->data.mouse_filter == Control::MOUSE_FILTER_IGNORE)
+		return true;
+
+	Rect2 rect;
+	if (bounded) {
+		rect = p_clipped ? pick_rect.clip(p_clip_rect) : pick_rect;
+		if (p_clipped && !pick_rect.intersects(p_clip_rect))
+			return true;
+	} else if (p_clipped) {
+		rect = p_clip_rect;
+	} else {
+		rect = Rect2(0, 0, -1, -1); // can be picked anywhere
+	}
+
+	if (entry == -1) {
+		GUIPickEntry e;
+		e.control = c;
+		e.inv_xform = matrix.affine_inverse();
+		e.clip = p_clip;
+		entry = gui.pick_entries.size();
+		gui.pick_entries.push_back(e);
+	}
+
+	r_order.push_back(entry);
+	r_rects.push_back(rect);
+	return true;
 }
 
 Control *Viewport::_gui_find_control_at_pos(CanvasItem *p_node, const Point2 &p_global, const Transform2D &p_xform, Transform2D &r_inv_xform) {
@@ -2341,6 +2669,7 @@ void Viewport::_gui_input_event(Ref<InputEvent> p_event) {
 List<Control *>::Element *Viewport::_gui_add_root_control(Control *p_control) {
 
 	gui.roots_order_dirty = true;
+	gui.pick_dirty = true;
 	return gui.roots.push_back(p_control);
 }
 
@@ -2352,16 +2681,19 @@ List<Control *>::Element *Viewport::_gui_add_subwindow_control(Control *p_contro
 		gui.subwindow_order_dirty = true;
 		gui.subwindows.push_back(p_control);
 	}
+	gui.pick_dirty = true;
 
 	return gui.all_known_subwindows.push_back(p_control);
 }
 
 void Viewport::_gui_set_subwindow_order_dirty() {
 	gui.subwindow_order_dirty = true;
+	gui.pick_dirty = true;
 }
 
 void Viewport::_gui_set_root_order_dirty() {
 	gui.roots_order_dirty = true;
+	gui.pick_dirty = true;
 }
 
 void Viewport::_gui_remove_modal_control(List<Control *>::Element *MI) {
@@ -2435,6 +2767,7 @@ void Viewport::_gui_set_drag_preview(Control *p_base, Control *p_control) {
 void Viewport::_gui_remove_root_control(List<Control *>::Element *RI) {
 
 	gui.roots.erase(RI);
+	gui.pick_dirty = true;
 }
 
 void Viewport::_gui_remove_subwindow_control(List<Control *>::Element *SI) {
@@ -2450,6 +2783,7 @@ void Viewport::_gui_remove_subwindow_control(List<Control *>::Element *SI) {
 		gui.subwindows.erase(E);
 
 	gui.all_known_subwindows.erase(SI);
+	gui.pick_dirty = true;
 }
 
 void Viewport::_gui_unfocus_control(Control *p_control) {
@@ -2879,6 +3213,72 @@ bool Viewport::get_hdr() const {
 	return hdr;
 }
 
+void Viewport::set_render_scale(float p_scale) {
+
+	render_scale = CLAMP(p_scale, 0.1, 1.0);
+	VS::get_singleton()->viewport_set_render_scale(viewport, render_scale);
+}
+
+float Viewport::get_render_scale() const {
+
+	return render_scale;
+}
+
+void Viewport::set_render_scale_sharpness(float p_sharpness) {
+
+	render_scale_sharpness = CLAMP(p_sharpness, 0.0, 1.0);
+	VS::get_singleton()->viewport_set_render_scale_sharpness(viewport, render_scale_sharpness);
+}
+
+float Viewport::get_render_scale_sharpness() const {
+
+	return render_scale_sharpness;
+}
+
+void Viewport::_update_dynamic_render_scale() {
+
+	VS::get_singleton()->viewport_set_dynamic_render_scale(viewport, render_scale_dynamic, render_scale_target_frame_time, render_scale_min);
+}
+
+void Viewport::set_render_scale_dynamic(bool p_enable) {
+
+	render_scale_dynamic = p_enable;
+	_update_dynamic_render_scale();
+}
+
+bool Viewport::is_render_scale_dynamic() const {
+
+	return render_scale_dynamic;
+}
+
+void Viewport::set_render_scale_target_frame_time(float p_msec) {
+
+	ERR_FAIL_COND(p_msec <= 0.0);
+	render_scale_target_frame_time = p_msec;
+	_update_dynamic_render_scale();
+}
+
+float Viewport::get_render_scale_target_frame_time() const {
+
+	return render_scale_target_frame_time;
+}
+
+void Viewport::set_render_scale_min(float p_scale) {
+
+	render_scale_min = CLAMP(p_scale, 0.1, 1.0);
+	_update_dynamic_render_scale();
+}
+
+float Viewport::get_render_scale_min() const {
+
+	return render_scale_min;
+}
+
+float Viewport::get_current_render_scale() const {
+
+	return VS::get_singleton()->viewport_get_current_render_scale(viewport);
+}
+
 void Viewport::set_usage(Usage p_usage) {
 
 	usage = p_usage;
@@ -3002,6 +3402,23 @@ void Viewport::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("set_hdr", "enable"), &Viewport::set_hdr);
 	ClassDB::bind_method(D_METHOD("get_hdr"), &Viewport::get_hdr);
 
+	ClassDB::bind_method(D_METHOD("set_render_scale", "scale"), &Viewport::set_render_scale);
+	ClassDB::bind_method(D_METHOD("get_render_scale"), &Viewport::get_render_scale);
+
+	ClassDB::bind_method(D_METHOD("set_render_scale_sharpness", "sharpness"), &Viewport::set_render_scale_sharpness);
+	ClassDB::bind_method(D_METHOD("get_render_scale_sharpness"), &Viewport::get_render_scale_sharpness);
+
+	ClassDB::bind_method(D_METHOD("set_render_scale_dynamic", "enable"), &Viewport::set_render_scale_dynamic);
+	ClassDB::bind_method(D_METHOD("is_render_scale_dynamic"), &Viewport::is_render_scale_dynamic);
+
+	ClassDB::bind_method(D_METHOD("set_render_scale_target_frame_time", "msec"), &Viewport::set_render_scale_target_frame_time);
+	ClassDB::bind_method(D_METHOD("get_render_scale_target_frame_time"), &Viewport::get_render_scale_target_frame_time);
+
+	ClassDB::bind_method(D_METHOD("set_render_scale_min", "scale"), &Viewport::set_render_scale_min);
+	ClassDB::bind_method(D_METHOD("get_render_scale_min"), &Viewport::get_render_scale_min);
+
+	ClassDB::bind_method(D_METHOD("get_current_render_scale"), &Viewport::get_current_render_scale);
+
 	ClassDB::bind_method(D_METHOD("set_usage", "usage"), &Viewport::set_usage);
 	ClassDB::bind_method(D_METHOD("get_usage"), &Viewport::get_usage);
 
@@ -3071,6 +3488,7 @@ void Viewport::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("is_handling_input_locally"), &Viewport::is_handling_input_locally);
 
 	ClassDB::bind_method(D_METHOD("_subwindow_visibility_changed"), &Viewport::_subwindow_visibility_changed);
+	ClassDB::bind_method(D_METHOD("_gui_flush_sorts"), &Viewport::_gui_flush_sorts);
 
 	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "arvr"), "set_use_arvr", "use_arvr");
 
@@ -3087,6 +3505,11 @@ void Viewport::_bind_methods() {
 	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "keep_3d_linear"), "set_keep_3d_linear", "get_keep_3d_linear");
 	ADD_PROPERTY(PropertyInfo(Variant::INT, "usage", PROPERTY_HINT_ENUM, "2D,2D No-Sampling,3D,3D No-Effects"), "set_usage", "get_usage");
 	ADD_PROPERTY(PropertyInfo(Variant::INT, "debug_draw", PROPERTY_HINT_ENUM, "Disabled,Unshaded,Overdraw,Wireframe"), "set_debug_draw", "get_debug_draw");
+	ADD_PROPERTY(PropertyInfo(Variant::REAL, "render_scale", PROPERTY_HINT_RANGE, "0.1,1,0.01"), "set_render_scale", "get_render_scale");
+	ADD_PROPERTY(PropertyInfo(Variant::REAL, "render_scale_sharpness", PROPERTY_HINT_RANGE, "0,1,0.01"), "set_render_scale_sharpness", "get_render_scale_sharpness");
+	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "render_scale_dynamic"), "set_render_scale_dynamic", "is_render_scale_dynamic");
+	ADD_PROPERTY(PropertyInfo(Variant::REAL, "render_scale_target_frame_time", PROPERTY_HINT_RANGE, "1,100,0.1"), "set_render_scale_target_frame_time", "get_render_scale_target_frame_time");
+	ADD_PROPERTY(PropertyInfo(Variant::REAL, "render_scale_min", PROPERTY_HINT_RANGE, "0.1,1,0.01"), "set_render_scale_min", "get_render_scale_min");
 	ADD_GROUP("Render Target", "render_target_");
 	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "render_target_v_flip"), "set_vflip", "get_vflip");
 	ADD_PROPERTY(PropertyInfo(Variant::INT, "render_target_clear_mode", PROPERTY_HINT_ENUM, "Always,Never,Next Frame"), "set_clear_mode", "get_clear_mode");
@@ -3158,6 +3581,7 @@ void Viewport::_subwindow_visibility_changed() {
 	// unfortunately, we don't know the sender, i.e. which subwindow changed;
 	// so we have to check them all.
 	gui.subwindow_visibility_dirty = true;
+	gui.pick_dirty = true;
 }
 
 Viewport::Viewport() {
@@ -3237,6 +3661,12 @@ Viewport::Viewport() {
 	msaa = MSAA_DISABLED;
 	hdr = true;
 
+	render_scale = 1.0;
+	render_scale_sharpness = 0.5;
+	render_scale_dynamic = false;
+	render_scale_target_frame_time = 16.0;
+	render_scale_min = 0.5;
+
 	usage = USAGE_3D;
 	debug_draw = DEBUG_DRAW_DISABLED;
 	clear_mode = CLEAR_MODE_ALWAYS;
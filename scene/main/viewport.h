@@ -32,6 +32,7 @@
 #define VIEWPORT_H
 
 #include "core/math/transform_2d.h"
+#include "core/self_list.h"
 #include "scene/main/node.h"
 #include "scene/resources/texture.h"
 #include "scene/resources/world_2d.h"
@@ -44,6 +45,7 @@ class Camera;
 class Camera2D;
 class Listener;
 class Control;
+class Container;
 class CanvasItem;
 class CanvasLayer;
 class Panel;
@@ -263,9 +265,35 @@ private:
 	MSAA msaa;
 	bool hdr;
 
+	float render_scale;
+	float render_scale_sharpness;
+	bool render_scale_dynamic;
+	float render_scale_target_frame_time;
+	float render_scale_min;
+	void _update_dynamic_render_scale();
+
 	Ref<ViewportTexture> default_texture;
 	Set<ViewportTexture *> viewport_textures;
 
+	// Screen space index of the controls that can take the mouse, so
+	// _gui_find_control() only tests the few controls under the pointer.
+	struct GUIPickEntry {
+		Control *control;
+		Transform2D inv_xform; // from the space of the root's parent item to the control
+		int clip; // entry of the nearest ancestor clipping input, or -1
+	};
+
+	struct GUIPickRoot {
+		Control *control;
+		bool fallback; // has other canvas items inside, so it is walked on every query
+		Rect2 bounds;
+		int grid_w, grid_h;
+		Vector2 cell_size;
+		int cells; // cell offsets into GUI::pick_cells, grid_w * grid_h + 1 of them
+		int unbounded; // offset of the entries that can't be bounded by a rect
+		int unbounded_count;
+	};
+
 	struct GUI {
 		// info used when this is a window
 
@@ -297,6 +325,12 @@ private:
 		List<Control *> roots;
 		int canvas_sort_index; //for sorting items with canvas as root
 		bool dragging;
+		bool pick_dirty;
+		Vector<GUIPickRoot> pick_roots;
+		Vector<GUIPickEntry> pick_entries;
+		Vector<int> pick_cells;
+		SelfList<Container>::List sort_queue; // containers waiting for _sort_children
+		bool sort_flush_queued;
 
 		GUI();
 	} gui;
@@ -312,6 +346,14 @@ private:
 	void _gui_sort_modal_stack();
 	Control *_gui_find_control(const Point2 &p_global);
 	Control *_gui_find_control_at_pos(CanvasItem *p_node, const Point2 &p_global, const Transform2D &p_xform, Transform2D &r_inv_xform);
+	void _gui_build_pick_index();
+	void _gui_build_pick_root(Control *p_root);
+	bool _gui_build_pick_node(CanvasItem *p_node, const Transform2D &p_xform, int p_clip, const Rect2 &p_clip_rect, bool p_clipped, Vector<int> &r_order, Vector<Rect2> &r_rects);
+	_FORCE_INLINE_ void _gui_invalidate_pick() { gui.pick_dirty = true; }
+
+	void _gui_queue_sort(Container *p_container);
+	void _gui_unqueue_sort(Container *p_container);
+	void _gui_flush_sorts();
 
 	void _gui_input_event(Ref<InputEvent> p_event);
 
@@ -325,6 +367,7 @@ private:
 	Ref<InputEvent> _make_input_local(const Ref<InputEvent> &ev);
 
 	friend class Control;
+	friend class Container;
 
 	List<Control *>::Element *_gui_add_root_control(Control *p_control);
 	List<Control *>::Element *_gui_add_subwindow_control(Control *p_control);
@@ -460,6 +503,23 @@ public:
 	void set_hdr(bool p_hdr);
 	bool get_hdr() const;
 
+	void set_render_scale(float p_scale);
+	float get_render_scale() const;
+
+	void set_render_scale_sharpness(float p_sharpness);
+	float get_render_scale_sharpness() const;
+
+	void set_render_scale_dynamic(bool p_enable);
+	bool is_render_scale_dynamic() const;
+
+	void set_render_scale_target_frame_time(float p_msec);
+	float get_render_scale_target_frame_time() const;
+
+	void set_render_scale_min(float p_scale);
+	float get_render_scale_min() const;
+
+	float get_current_render_scale() const;
+
 	Vector2 get_camera_coords(const Vector2 &p_viewport_coords) const;
 	Vector2 get_camera_rect_size() const;
 
@@ -206,6 +206,7 @@
 #include "scene/3d/sprite_3d.h"
 #include "scene/3d/vehicle_body.h"
 #include "scene/3d/visibility_notifier.h"
+#include "scene/3d/world_streamer.h"
 #include "scene/animation/skeleton_ik.h"
 #include "scene/resources/environment.h"
 #endif
@@ -265,6 +266,7 @@ void register_scene_types() {
 	ClassDB::register_class<Viewport>();
 	ClassDB::register_class<ViewportTexture>();
 	ClassDB::register_class<HTTPRequest>();
+	HTTPRequest::initialize_pool();
 	ClassDB::register_class<Timer>();
 	ClassDB::register_class<CanvasLayer>();
 	ClassDB::register_class<CanvasModulate>();
@@ -404,6 +406,7 @@ void register_scene_types() {
 	ClassDB::set_class_enabled("RootMotionView", false); //disabled by default, enabled by editor
 
 	ClassDB::register_class<AnimationTree>();
+	AnimationTree::set_threaded_blending(GLOBAL_DEF("animation/animation_tree/threaded_blending", true) && !Engine::get_singleton()->is_editor_hint());
 	ClassDB::register_class<AnimationNode>();
 	ClassDB::register_class<AnimationRootNode>();
 	ClassDB::register_class<AnimationNodeBlendTree>();
@@ -456,6 +459,7 @@ void register_scene_types() {
 	ClassDB::register_class<VisibilityEnabler>();
 	ClassDB::register_class<WorldEnvironment>();
 	ClassDB::register_class<RemoteTransform>();
+	ClassDB::register_class<WorldStreamer>();
 
 	ClassDB::register_virtual_class<Joint>();
 	ClassDB::register_class<PinJoint>();
@@ -652,6 +656,8 @@ void register_scene_types() {
 	ClassDB::register_class<AudioStreamPlayer2D>();
 #ifndef _3D_DISABLED
 	ClassDB::register_class<AudioStreamPlayer3D>();
+	AudioStreamPlayer3D::set_voice_budget(GLOBAL_DEF("audio/3d/max_real_voices", 0), GLOBAL_DEF("audio/3d/virtual_voice_threshold_db", -80.0));
+	ProjectSettings::get_singleton()->set_custom_property_info("audio/3d/max_real_voices", PropertyInfo(Variant::INT, "audio/3d/max_real_voices", PROPERTY_HINT_RANGE, "0,1024,1,or_greater"));
 #endif
 	ClassDB::register_virtual_class<VideoStream>();
 	ClassDB::register_class<AudioStreamSample>();
@@ -679,6 +685,12 @@ void register_scene_types() {
 
 	ClassDB::register_virtual_class<SceneState>();
 	ClassDB::register_class<PackedScene>();
+	SceneState::set_threaded_instancing(GLOBAL_DEF("application/run/threaded_scene_instancing", false) && !Engine::get_singleton()->is_editor_hint());
+	TileMap::set_threaded_quadrant_updates(GLOBAL_DEF("rendering/2d/tilemap/threaded_quadrant_updates", true) && !Engine::get_singleton()->is_editor_hint());
+	CPUParticles2D::set_threaded_processing(GLOBAL_DEF("rendering/2d/cpu_particles/threaded_processing", true));
+	TriangleMesh::set_threaded_build(GLOBAL_DEF("rendering/quality/triangle_mesh/threaded_build", true));
+	StreamTexture::set_stream_size_limit(Engine::get_singleton()->is_editor_hint() ? 0 : int(GLOBAL_DEF("rendering/quality/texture_streaming/size_limit", 0)));
+	ProjectSettings::get_singleton()->set_custom_property_info("rendering/quality/texture_streaming/size_limit", PropertyInfo(Variant::INT, "rendering/quality/texture_streaming/size_limit", PROPERTY_HINT_RANGE, "0,16384,1"));
 
 	ClassDB::register_class<SceneTree>();
 	ClassDB::register_virtual_class<SceneTreeTimer>(); //sorry, you can't create it
@@ -744,6 +756,7 @@ void unregister_scene_types() {
 	resource_loader_stream_texture.unref();
 
 	DynamicFont::finish_dynamic_fonts();
+	HTTPRequest::finish_pool();
 
 	ResourceSaver::remove_resource_format_saver(resource_saver_text);
 	resource_saver_text.unref();
@@ -763,5 +776,11 @@ void unregister_scene_types() {
 	SpatialMaterial::finish_shaders();
 	ParticlesMaterial::finish_shaders();
 	CanvasItemMaterial::finish_shaders();
+	SceneState::set_threaded_instancing(false);
+	AnimationTree::set_threaded_blending(false);
+	TileMap::set_threaded_quadrant_updates(false);
+	CPUParticles2D::set_threaded_processing(false);
+	TriangleMesh::set_threaded_build(false);
+	StreamTexture::set_stream_size_limit(0);
 	SceneStringNames::free();
 }
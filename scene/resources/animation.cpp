@@ -32,6 +32,7 @@
 #include "scene/scene_string_names.h"
 
 #include "core/math/geometry.h"
+#include "core/os/threaded_array_processor.h"
 
 #define ANIM_MIN_LENGTH 0.001
 
@@ -86,7 +87,16 @@ bool Animation::_set(const StringName &p_name, const Variant &p_value) {
 			track_set_imported(track, p_value);
 		else if (what == "enabled")
 			track_set_enabled(track, p_value);
-		else if (what == "keys" || what == "key_values") {
+		else if (what == "compressed") {
+
+			ERR_FAIL_COND_V(track_get_type(track) != TYPE_TRANSFORM, false);
+			TransformTrack *tt = static_cast<TransformTrack *>(tracks[track]);
+			if (p_value) {
+				_transform_track_compress(tt);
+			} else {
+				_transform_track_decompress(tt);
+			}
+		} else if (what == "keys" || what == "key_values") {
 
 			if (track_get_type(track) == TYPE_TRANSFORM) {
 
@@ -97,6 +107,7 @@ bool Animation::_set(const StringName &p_name, const Variant &p_value) {
 
 				PoolVector<float>::Read r = values.read();
 
+				_transform_track_decompress(tt);
 				tt->transforms.resize(vcount / 12);
 
 				for (int i = 0; i < (vcount / 12); i++) {
@@ -369,6 +380,8 @@ bool Animation::_get(const StringName &p_name, Variant &r_ret) const {
 			r_ret = track_is_imported(track);
 		else if (what == "enabled")
 			r_ret = track_is_enabled(track);
+		else if (what == "compressed")
+			r_ret = track_is_compressed(track);
 		else if (what == "keys") {
 
 			if (track_get_type(track) == TYPE_TRANSFORM) {
@@ -623,6 +636,10 @@ void Animation::_get_property_list(List<PropertyInfo> *p_list) const {
 		p_list->push_back(PropertyInfo(Variant::BOOL, "tracks/" + itos(i) + "/imported", PROPERTY_HINT_NONE, "", PROPERTY_USAGE_NOEDITOR | PROPERTY_USAGE_INTERNAL));
 		p_list->push_back(PropertyInfo(Variant::BOOL, "tracks/" + itos(i) + "/enabled", PROPERTY_HINT_NONE, "", PROPERTY_USAGE_NOEDITOR | PROPERTY_USAGE_INTERNAL));
 		p_list->push_back(PropertyInfo(Variant::ARRAY, "tracks/" + itos(i) + "/keys", PROPERTY_HINT_NONE, "", PROPERTY_USAGE_NOEDITOR | PROPERTY_USAGE_INTERNAL));
+		if (track_is_compressed(i)) {
+			// must come after the keys, so they are compressed again when loading
+			p_list->push_back(PropertyInfo(Variant::BOOL, "tracks/" + itos(i) + "/compressed", PROPERTY_HINT_NONE, "", PROPERTY_USAGE_NOEDITOR | PROPERTY_USAGE_INTERNAL));
+		}
 	}
 }
 
@@ -849,14 +866,22 @@ Error Animation::transform_track_get_key(int p_track, int p_key, Vector3 *r_loc,
 
 	TransformTrack *tt = static_cast<TransformTrack *>(t);
 	ERR_FAIL_COND_V(t->type != TYPE_TRANSFORM, ERR_INVALID_PARAMETER);
-	ERR_FAIL_INDEX_V(p_key, tt->transforms.size(), ERR_INVALID_PARAMETER);
+
+	TransformKey tk;
+	if (tt->compressed) {
+		ERR_FAIL_INDEX_V(p_key, tt->compressed_times.size(), ERR_INVALID_PARAMETER);
+		tk = _transform_track_get_compressed_key(tt, p_key);
+	} else {
+		ERR_FAIL_INDEX_V(p_key, tt->transforms.size(), ERR_INVALID_PARAMETER);
+		tk = tt->transforms[p_key].value;
+	}
 
 	if (r_loc)
-		*r_loc = tt->transforms[p_key].value.loc;
+		*r_loc = tk.loc;
 	if (r_rot)
-		*r_rot = tt->transforms[p_key].value.rot;
+		*r_rot = tk.rot;
 	if (r_scale)
-		*r_scale = tt->transforms[p_key].value.scale;
+		*r_scale = tk.scale;
 
 	return OK;
 }
@@ -868,6 +893,7 @@ int Animation::transform_track_insert_key(int p_track, float p_time, const Vecto
 	ERR_FAIL_COND_V(t->type != TYPE_TRANSFORM, -1);
 
 	TransformTrack *tt = static_cast<TransformTrack *>(t);
+	_transform_track_decompress(tt);
 
 	TKey<TransformKey> tkey;
 	tkey.time = p_time;
@@ -896,6 +922,7 @@ void Animation::track_remove_key(int p_track, int p_idx) {
 		case TYPE_TRANSFORM: {
 
 			TransformTrack *tt = static_cast<TransformTrack *>(t);
+			_transform_track_decompress(tt);
 			ERR_FAIL_INDEX(p_idx, tt->transforms.size());
 			tt->transforms.remove(p_idx);
 
@@ -949,6 +976,14 @@ int Animation::track_find_key(int p_track, float p_time, bool p_exact) const {
 		case TYPE_TRANSFORM: {
 
 			TransformTrack *tt = static_cast<TransformTrack *>(t);
+			if (tt->compressed) {
+				int k = _find(tt->compressed_times, p_time);
+				if (k < 0 || k >= tt->compressed_times.size())
+					return -1;
+				if (tt->compressed_times[k] != p_time && p_exact)
+					return -1;
+				return k;
+			}
 			int k = _find(tt->transforms, p_time);
 			if (k < 0 || k >= tt->transforms.size())
 				return -1;
@@ -1134,7 +1169,7 @@ int Animation::track_get_key_count(int p_track) const {
 		case TYPE_TRANSFORM: {
 
 			TransformTrack *tt = static_cast<TransformTrack *>(t);
-			return tt->transforms.size();
+			return tt->compressed ? tt->compressed_times.size() : tt->transforms.size();
 		} break;
 		case TYPE_VALUE: {
 
@@ -1177,6 +1212,19 @@ Variant Animation::track_get_key_value(int p_track, int p_key_idx) const {
 		case TYPE_TRANSFORM: {
 
 			TransformTrack *tt = static_cast<TransformTrack *>(t);
+
+			if (tt->compressed) {
+				ERR_FAIL_INDEX_V(p_key_idx, tt->compressed_times.size(), Variant());
+				TransformKey tk = _transform_track_get_compressed_key(tt, p_key_idx);
+
+				Dictionary d;
+				d["location"] = tk.loc;
+				d["rotation"] = tk.rot;
+				d["scale"] = tk.scale;
+
+				return d;
+			}
+
 			ERR_FAIL_INDEX_V(p_key_idx, tt->transforms.size(), Variant());
 
 			Dictionary d;
@@ -1253,6 +1301,10 @@ float Animation::track_get_key_time(int p_track, int p_key_idx) const {
 		case TYPE_TRANSFORM: {
 
 			TransformTrack *tt = static_cast<TransformTrack *>(t);
+			if (tt->compressed) {
+				ERR_FAIL_INDEX_V(p_key_idx, tt->compressed_times.size(), -1);
+				return tt->compressed_times[p_key_idx];
+			}
 			ERR_FAIL_INDEX_V(p_key_idx, tt->transforms.size(), -1);
 			return tt->transforms[p_key_idx].time;
 		} break;
@@ -1306,6 +1358,10 @@ float Animation::track_get_key_transition(int p_track, int p_key_idx) const {
 		case TYPE_TRANSFORM: {
 
 			TransformTrack *tt = static_cast<TransformTrack *>(t);
+			if (tt->compressed) {
+				ERR_FAIL_INDEX_V(p_key_idx, tt->compressed_times.size(), -1);
+				return 1.0; //only tracks without easing are compressed
+			}
 			ERR_FAIL_INDEX_V(p_key_idx, tt->transforms.size(), -1);
 			return tt->transforms[p_key_idx].transition;
 		} break;
@@ -1350,6 +1406,7 @@ void Animation::track_set_key_value(int p_track, int p_key_idx, const Variant &p
 		case TYPE_TRANSFORM: {
 
 			TransformTrack *tt = static_cast<TransformTrack *>(t);
+			_transform_track_decompress(tt);
 			ERR_FAIL_INDEX(p_key_idx, tt->transforms.size());
 			Dictionary d = p_value;
 			if (d.has("location"))
@@ -1428,6 +1485,7 @@ void Animation::track_set_key_transition(int p_track, int p_key_idx, float p_tra
 		case TYPE_TRANSFORM: {
 
 			TransformTrack *tt = static_cast<TransformTrack *>(t);
+			_transform_track_decompress(tt);
 			ERR_FAIL_INDEX(p_key_idx, tt->transforms.size());
 			tt->transforms.write[p_key_idx].transition = p_transition;
 		} break;
@@ -1456,12 +1514,23 @@ void Animation::track_set_key_transition(int p_track, int p_key_idx, float p_tra
 }
 
 template <class K>
-int Animation::_find(const Vector<K> &p_keys, float p_time) const {
+int Animation::_find(const Vector<K> &p_keys, float p_time, int p_hint) const {
 
 	int len = p_keys.size();
 	if (len == 0)
 		return -2;
 
+	const K *keys = &p_keys[0];
+
+	if (p_hint >= 0 && p_hint < len) {
+		// sequential playback almost always lands on the hinted key or the one after it
+		for (int i = p_hint; i < len && i <= p_hint + 1; i++) {
+			if (p_time >= _key_time(keys[i]) - CMP_EPSILON && (i + 1 == len || p_time < _key_time(keys[i + 1]) - CMP_EPSILON)) {
+				return i;
+			}
+		}
+	}
+
 	int low = 0;
 	int high = len - 1;
 	int middle = 0;
@@ -1471,21 +1540,19 @@ int Animation::_find(const Vector<K> &p_keys, float p_time) const {
 		ERR_PRINT("low > high, this may be a bug");
 #endif
 
-	const K *keys = &p_keys[0];
-
 	while (low <= high) {
 
 		middle = (low + high) / 2;
 
-		if (Math::abs(p_time - keys[middle].time) < CMP_EPSILON) { //match
+		if (Math::abs(p_time - _key_time(keys[middle])) < CMP_EPSILON) { //match
 			return middle;
-		} else if (p_time < keys[middle].time)
+		} else if (p_time < _key_time(keys[middle]))
 			high = middle - 1; //search low end of array
 		else
 			low = middle + 1; //search high end of array
 	}
 
-	if (keys[middle].time > p_time)
+	if (_key_time(keys[middle]) > p_time)
 		middle--;
 
 	return middle;
@@ -1643,27 +1710,32 @@ float Animation::_cubic_interpolate(const float &p_pre_a, const float &p_a, cons
 	return _interpolate(p_a, p_b, p_c);
 }
 
-template <class T>
-T Animation::_interpolate(const Vector<TKey<T> > &p_keys, float p_time, InterpolationType p_interp, bool p_loop_wrap, bool *p_ok) const {
+template <class K>
+bool Animation::_find_interpolation_keys(const Vector<K> &p_keys, float p_time, bool p_loop_wrap, int *r_cursor, int &r_idx, int &r_next, float &r_c, int &r_len) const {
 
-	int len = _find(p_keys, length) + 1; // try to find last key (there may be more past the end)
+	int len = p_keys.size();
+	if (len == 0 || _key_time(p_keys[len - 1]) > length) {
+		len = _find(p_keys, length) + 1; // try to find last key (there may be more past the end)
+	}
 
 	if (len <= 0) {
 		// (-1 or -2 returned originally) (plus one above)
 		// meaning no keys, or only key time is larger than length
-		if (p_ok)
-			*p_ok = false;
-		return T();
+		return false;
 	} else if (len == 1) { // one key found (0+1), return it
 
-		if (p_ok)
-			*p_ok = true;
-		return p_keys[0].value;
+		r_idx = r_next = 0;
+		r_c = 0;
+		r_len = 1;
+		return true;
 	}
 
-	int idx = _find(p_keys, p_time);
+	int idx = _find(p_keys, p_time, r_cursor ? *r_cursor : -1);
 
-	ERR_FAIL_COND_V(idx == -2, T());
+	ERR_FAIL_COND_V(idx == -2, false);
+
+	if (r_cursor)
+		*r_cursor = idx;
 
 	bool result = true;
 	int next = 0;
@@ -1677,8 +1749,8 @@ T Animation::_interpolate(const Vector<TKey<T> > &p_keys, float p_time, Interpol
 			if ((idx + 1) < len) {
 
 				next = idx + 1;
-				float delta = p_keys[next].time - p_keys[idx].time;
-				float from = p_time - p_keys[idx].time;
+				float delta = _key_time(p_keys[next]) - _key_time(p_keys[idx]);
+				float from = p_time - _key_time(p_keys[idx]);
 
 				if (Math::absf(delta) > CMP_EPSILON)
 					c = from / delta;
@@ -1688,8 +1760,8 @@ T Animation::_interpolate(const Vector<TKey<T> > &p_keys, float p_time, Interpol
 			} else {
 
 				next = 0;
-				float delta = (length - p_keys[idx].time) + p_keys[next].time;
-				float from = p_time - p_keys[idx].time;
+				float delta = (length - _key_time(p_keys[idx])) + _key_time(p_keys[next]);
+				float from = p_time - _key_time(p_keys[idx]);
 
 				if (Math::absf(delta) > CMP_EPSILON)
 					c = from / delta;
@@ -1701,10 +1773,10 @@ T Animation::_interpolate(const Vector<TKey<T> > &p_keys, float p_time, Interpol
 			// on loop, behind first key
 			idx = len - 1;
 			next = 0;
-			float endtime = (length - p_keys[idx].time);
+			float endtime = (length - _key_time(p_keys[idx]));
 			if (endtime < 0) // may be keys past the end
 				endtime = 0;
-			float delta = endtime + p_keys[next].time;
+			float delta = endtime + _key_time(p_keys[next]);
 			float from = endtime + p_time;
 
 			if (Math::absf(delta) > CMP_EPSILON)
@@ -1720,8 +1792,8 @@ T Animation::_interpolate(const Vector<TKey<T> > &p_keys, float p_time, Interpol
 			if ((idx + 1) < len) {
 
 				next = idx + 1;
-				float delta = p_keys[next].time - p_keys[idx].time;
-				float from = p_time - p_keys[idx].time;
+				float delta = _key_time(p_keys[next]) - _key_time(p_keys[idx]);
+				float from = p_time - _key_time(p_keys[idx]);
 
 				if (Math::absf(delta) > CMP_EPSILON)
 					c = from / delta;
@@ -1743,6 +1815,22 @@ T Animation::_interpolate(const Vector<TKey<T> > &p_keys, float p_time, Interpol
 		}
 	}
 
+	r_idx = idx;
+	r_next = next;
+	r_c = c;
+	r_len = len;
+	return result;
+}
+
+template <class T>
+T Animation::_interpolate(const Vector<TKey<T> > &p_keys, float p_time, InterpolationType p_interp, bool p_loop_wrap, bool *p_ok, int *r_cursor) const {
+
+	int idx = 0;
+	int next = 0;
+	float c = 0;
+	int len = 0;
+	bool result = _find_interpolation_keys(p_keys, p_time, p_loop_wrap, r_cursor, idx, next, c, len);
+
 	if (p_ok)
 		*p_ok = result;
 	if (!result)
@@ -1787,7 +1875,7 @@ T Animation::_interpolate(const Vector<TKey<T> > &p_keys, float p_time, Interpol
 	// do a barrel roll
 }
 
-Error Animation::transform_track_interpolate(int p_track, float p_time, Vector3 *r_loc, Quat *r_rot, Vector3 *r_scale) const {
+Error Animation::transform_track_interpolate(int p_track, float p_time, Vector3 *r_loc, Quat *r_rot, Vector3 *r_scale, int *r_cursor) const {
 
 	ERR_FAIL_INDEX_V(p_track, tracks.size(), ERR_INVALID_PARAMETER);
 	Track *t = tracks[p_track];
@@ -1797,7 +1885,12 @@ Error Animation::transform_track_interpolate(int p_track, float p_time, Vector3
 
 	bool ok = false;
 
-	TransformKey tk = _interpolate(tt->transforms, p_time, tt->interpolation, tt->loop_wrap, &ok);
+	TransformKey tk;
+	if (tt->compressed) {
+		tk = _transform_track_interpolate_compressed(tt, p_time, &ok, r_cursor);
+	} else {
+		tk = _interpolate(tt->transforms, p_time, tt->interpolation, tt->loop_wrap, &ok, r_cursor);
+	}
 
 	if (!ok)
 		return ERR_UNAVAILABLE;
@@ -1814,7 +1907,7 @@ Error Animation::transform_track_interpolate(int p_track, float p_time, Vector3
 	return OK;
 }
 
-Variant Animation::value_track_interpolate(int p_track, float p_time) const {
+Variant Animation::value_track_interpolate(int p_track, float p_time, int *r_cursor) const {
 
 	ERR_FAIL_INDEX_V(p_track, tracks.size(), 0);
 	Track *t = tracks[p_track];
@@ -1823,7 +1916,7 @@ Variant Animation::value_track_interpolate(int p_track, float p_time) const {
 
 	bool ok = false;
 
-	Variant res = _interpolate(vt->values, p_time, (vt->update_mode == UPDATE_CONTINUOUS || vt->update_mode == UPDATE_CAPTURE) ? vt->interpolation : INTERPOLATION_NEAREST, vt->loop_wrap, &ok);
+	Variant res = _interpolate(vt->values, p_time, (vt->update_mode == UPDATE_CONTINUOUS || vt->update_mode == UPDATE_CAPTURE) ? vt->interpolation : INTERPOLATION_NEAREST, vt->loop_wrap, &ok, r_cursor);
 
 	if (ok) {
 
@@ -1941,7 +2034,7 @@ void Animation::_track_get_key_indices_in_range(const Vector<T> &p_array, float
 	// can't really send the events == time, will be sent in the next frame.
 	// if event>=len then it will probably never be requested by the anim player.
 
-	if (to >= 0 && p_array[to].time >= to_time)
+	if (to >= 0 && _key_time(p_array[to]) >= to_time)
 		to--;
 
 	if (to < 0)
@@ -1950,7 +2043,7 @@ void Animation::_track_get_key_indices_in_range(const Vector<T> &p_array, float
 	int from = _find(p_array, from_time);
 
 	// position in the right first event.+
-	if (from < 0 || p_array[from].time < from_time)
+	if (from < 0 || _key_time(p_array[from]) < from_time)
 		from++;
 
 	int max = p_array.size();
@@ -1989,8 +2082,13 @@ void Animation::track_get_key_indices_in_range(int p_track, float p_time, float
 				case TYPE_TRANSFORM: {
 
 					const TransformTrack *tt = static_cast<const TransformTrack *>(t);
-					_track_get_key_indices_in_range(tt->transforms, from_time, length, p_indices);
-					_track_get_key_indices_in_range(tt->transforms, 0, to_time, p_indices);
+					if (tt->compressed) {
+						_track_get_key_indices_in_range(tt->compressed_times, from_time, length, p_indices);
+						_track_get_key_indices_in_range(tt->compressed_times, 0, to_time, p_indices);
+					} else {
+						_track_get_key_indices_in_range(tt->transforms, from_time, length, p_indices);
+						_track_get_key_indices_in_range(tt->transforms, 0, to_time, p_indices);
+					}
 
 				} break;
 				case TYPE_VALUE: {
@@ -2049,7 +2147,11 @@ void Animation::track_get_key_indices_in_range(int p_track, float p_time, float
 		case TYPE_TRANSFORM: {
 
 			const TransformTrack *tt = static_cast<const TransformTrack *>(t);
-			_track_get_key_indices_in_range(tt->transforms, from_time, to_time, p_indices);
+			if (tt->compressed) {
+				_track_get_key_indices_in_range(tt->compressed_times, from_time, to_time, p_indices);
+			} else {
+				_track_get_key_indices_in_range(tt->transforms, from_time, to_time, p_indices);
+			}
 
 		} break;
 		case TYPE_VALUE: {
@@ -2663,6 +2765,7 @@ void Animation::_bind_methods() {
 
 	ClassDB::bind_method(D_METHOD("track_set_enabled", "idx", "enabled"), &Animation::track_set_enabled);
 	ClassDB::bind_method(D_METHOD("track_is_enabled", "idx"), &Animation::track_is_enabled);
+	ClassDB::bind_method(D_METHOD("track_is_compressed", "idx"), &Animation::track_is_compressed);
 
 	ClassDB::bind_method(D_METHOD("transform_track_insert_key", "idx", "time", "location", "rotation", "scale"), &Animation::transform_track_insert_key);
 	ClassDB::bind_method(D_METHOD("track_insert_key", "idx", "time", "key", "transition"), &Animation::track_insert_key, DEFVAL(1));
@@ -2728,6 +2831,7 @@ void Animation::_bind_methods() {
 
 	ClassDB::bind_method(D_METHOD("clear"), &Animation::clear);
 	ClassDB::bind_method(D_METHOD("copy_track", "track", "to_animation"), &Animation::copy_track);
+	ClassDB::bind_method(D_METHOD("compress"), &Animation::compress);
 
 	ADD_PROPERTY(PropertyInfo(Variant::REAL, "length", PROPERTY_HINT_RANGE, "0.001,99999,0.001"), "set_length", "get_length");
 	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "loop"), "set_loop", "has_loop");
@@ -2939,16 +3043,26 @@ void Animation::_transform_track_optimize(int p_idx, float p_allowed_linear_err,
 	ERR_FAIL_INDEX(p_idx, tracks.size());
 	ERR_FAIL_COND(tracks[p_idx]->type != TYPE_TRANSFORM);
 	TransformTrack *tt = static_cast<TransformTrack *>(tracks[p_idx]);
+	_transform_track_decompress(tt);
 	bool prev_erased = false;
 	TKey<TransformKey> first_erased;
 
 	Vector3 norm;
 
-	for (int i = 1; i < tt->transforms.size() - 1; i++) {
+	int key_count = tt->transforms.size();
+	if (key_count < 3) {
+		return;
+	}
+
+	//kept keys are compacted in place, instead of erasing them one by one
+	TKey<TransformKey> *keys = tt->transforms.ptrw();
+	int kept = 1;
 
-		TKey<TransformKey> &t0 = tt->transforms.write[i - 1];
-		TKey<TransformKey> &t1 = tt->transforms.write[i];
-		TKey<TransformKey> &t2 = tt->transforms.write[i + 1];
+	for (int i = 1; i < key_count - 1; i++) {
+
+		const TKey<TransformKey> &t0 = keys[kept - 1];
+		const TKey<TransformKey> &t1 = keys[i];
+		const TKey<TransformKey> &t2 = keys[i + 1];
 
 		bool erase = _transform_track_optimize_key(t0, t1, t2, p_allowed_linear_err, p_allowed_angular_err, p_max_optimizable_angle, norm);
 		if (erase && !prev_erased) {
@@ -2967,23 +3081,193 @@ void Animation::_transform_track_optimize(int p_idx, float p_allowed_linear_err,
 				prev_erased = true;
 			}
 
-			tt->transforms.remove(i);
-			i--;
-
 		} else {
 			prev_erased = false;
 			norm = Vector3();
+			keys[kept++] = keys[i];
 		}
 	}
+
+	keys[kept++] = keys[key_count - 1];
+	tt->transforms.resize(kept);
+}
+
+void Animation::_transform_track_optimize_thread(uint32_t p_index, const OptimizeData *p_data) {
+
+	_transform_track_optimize(p_data->tracks[p_index], p_data->allowed_linear_err, p_data->allowed_angular_err, p_data->max_optimizable_angle);
 }
 
 void Animation::optimize(float p_allowed_linear_err, float p_allowed_angular_err, float p_max_optimizable_angle) {
 
+	Vector<int> transform_tracks;
+	for (int i = 0; i < tracks.size(); i++) {
+
+		if (tracks[i]->type == TYPE_TRANSFORM)
+			transform_tracks.push_back(i);
+	}
+
+	if (transform_tracks.size() == 0) {
+		return;
+	}
+
+	//tracks don't share any data, so they can be optimized in parallel
+	OptimizeData data;
+	data.tracks = transform_tracks.ptr();
+	data.allowed_linear_err = p_allowed_linear_err;
+	data.allowed_angular_err = p_allowed_angular_err;
+	data.max_optimizable_angle = p_max_optimizable_angle;
+
+	thread_process_array(transform_tracks.size(), this, &Animation::_transform_track_optimize_thread, (const OptimizeData *)&data);
+}
+
+static _FORCE_INLINE_ uint16_t _quantize_range(float p_value, float p_min, float p_size) {
+
+	if (p_size < CMP_EPSILON)
+		return 0;
+	return (uint16_t)CLAMP(Math::fast_ftoi((p_value - p_min) / p_size * 65535.0), 0, 65535);
+}
+
+static _FORCE_INLINE_ float _dequantize_range(uint16_t p_value, float p_min, float p_size) {
+
+	return p_min + p_value * (p_size / 65535.0);
+}
+
+Animation::TransformKey Animation::_transform_track_get_compressed_key(const TransformTrack *p_track, int p_key) const {
+
+	const CompressedTransformKey &ck = p_track->compressed_keys[p_key];
+	const AABB &lr = p_track->loc_range;
+	const AABB &sr = p_track->scale_range;
+
+	TransformKey tk;
+	tk.loc = Vector3(_dequantize_range(ck.loc[0], lr.position.x, lr.size.x), _dequantize_range(ck.loc[1], lr.position.y, lr.size.y), _dequantize_range(ck.loc[2], lr.position.z, lr.size.z));
+	tk.rot = Quat(ck.rot[0], ck.rot[1], ck.rot[2], ck.rot[3]).normalized();
+	tk.scale = Vector3(_dequantize_range(ck.scale[0], sr.position.x, sr.size.x), _dequantize_range(ck.scale[1], sr.position.y, sr.size.y), _dequantize_range(ck.scale[2], sr.position.z, sr.size.z));
+	return tk;
+}
+
+Animation::TransformKey Animation::_transform_track_interpolate_compressed(const TransformTrack *p_track, float p_time, bool *p_ok, int *r_cursor) const {
+
+	int idx = 0;
+	int next = 0;
+	float c = 0;
+	int len = 0;
+	*p_ok = _find_interpolation_keys(p_track->compressed_times, p_time, p_track->loop_wrap, r_cursor, idx, next, c, len);
+
+	if (!*p_ok)
+		return TransformKey();
+
+	TransformKey a = _transform_track_get_compressed_key(p_track, idx);
+
+	if (idx == next || p_track->interpolation == INTERPOLATION_NEAREST)
+		return a;
+
+	TransformKey b = _transform_track_get_compressed_key(p_track, next);
+
+	if (p_track->interpolation == INTERPOLATION_CUBIC) {
+		int pre = MAX(idx - 1, 0);
+		int post = next + 1;
+		if (post >= len)
+			post = next;
+
+		return _cubic_interpolate(_transform_track_get_compressed_key(p_track, pre), a, b, _transform_track_get_compressed_key(p_track, post), c);
+	}
+
+	return _interpolate(a, b, c);
+}
+
+bool Animation::_transform_track_compress(TransformTrack *p_track) {
+
+	if (p_track->compressed)
+		return true;
+
+	int key_count = p_track->transforms.size();
+	if (key_count == 0)
+		return false;
+
+	const TKey<TransformKey> *keys = p_track->transforms.ptr();
+
+	for (int i = 0; i < key_count; i++) {
+		if (keys[i].transition != 1.0)
+			return false; //easing is not kept by compressed keys
+	}
+
+	AABB loc_range(keys[0].value.loc, Vector3());
+	AABB scale_range(keys[0].value.scale, Vector3());
+	for (int i = 1; i < key_count; i++) {
+		loc_range.expand_to(keys[i].value.loc);
+		scale_range.expand_to(keys[i].value.scale);
+	}
+
+	p_track->compressed_times.resize(key_count);
+	p_track->compressed_keys.resize(key_count);
+	float *times = p_track->compressed_times.ptrw();
+	CompressedTransformKey *ckeys = p_track->compressed_keys.ptrw();
+
+	for (int i = 0; i < key_count; i++) {
+
+		const TransformKey &tk = keys[i].value;
+		CompressedTransformKey &ck = ckeys[i];
+
+		times[i] = keys[i].time;
+
+		for (int j = 0; j < 3; j++) {
+			ck.loc[j] = _quantize_range(tk.loc[j], loc_range.position[j], loc_range.size[j]);
+			ck.scale[j] = _quantize_range(tk.scale[j], scale_range.position[j], scale_range.size[j]);
+		}
+
+		Quat rot = tk.rot.normalized();
+		ck.rot[0] = (int16_t)CLAMP(Math::fast_ftoi(rot.x * 32767.0), -32767, 32767);
+		ck.rot[1] = (int16_t)CLAMP(Math::fast_ftoi(rot.y * 32767.0), -32767, 32767);
+		ck.rot[2] = (int16_t)CLAMP(Math::fast_ftoi(rot.z * 32767.0), -32767, 32767);
+		ck.rot[3] = (int16_t)CLAMP(Math::fast_ftoi(rot.w * 32767.0), -32767, 32767);
+	}
+
+	p_track->loc_range = loc_range;
+	p_track->scale_range = scale_range;
+	p_track->transforms.clear();
+	p_track->compressed = true;
+
+	return true;
+}
+
+void Animation::_transform_track_decompress(TransformTrack *p_track) {
+
+	if (!p_track->compressed)
+		return;
+
+	int key_count = p_track->compressed_times.size();
+	p_track->transforms.resize(key_count);
+
+	for (int i = 0; i < key_count; i++) {
+
+		TKey<TransformKey> &tk = p_track->transforms.write[i];
+		tk.time = p_track->compressed_times[i];
+		tk.transition = 1.0;
+		tk.value = _transform_track_get_compressed_key(p_track, i);
+	}
+
+	p_track->compressed_times.clear();
+	p_track->compressed_keys.clear();
+	p_track->compressed = false;
+}
+
+void Animation::compress() {
+
 	for (int i = 0; i < tracks.size(); i++) {
 
 		if (tracks[i]->type == TYPE_TRANSFORM)
-			_transform_track_optimize(i, p_allowed_linear_err, p_allowed_angular_err, p_max_optimizable_angle);
+			_transform_track_compress(static_cast<TransformTrack *>(tracks[i]));
 	}
+	emit_changed();
+}
+
+bool Animation::track_is_compressed(int p_track) const {
+
+	ERR_FAIL_INDEX_V(p_track, tracks.size(), false);
+	if (tracks[p_track]->type != TYPE_TRANSFORM)
+		return false;
+
+	return static_cast<const TransformTrack *>(tracks[p_track])->compressed;
 }
 
 Animation::Animation() {
@@ -106,11 +106,29 @@ private:
 
 	/* TRANSFORM TRACK */
 
+	// location and scale are quantized within the track ranges, rotation is stored as a normalized quaternion
+	struct CompressedTransformKey {
+
+		uint16_t loc[3];
+		int16_t rot[4];
+		uint16_t scale[3];
+	};
+
 	struct TransformTrack : public Track {
 
 		Vector<TKey<TransformKey> > transforms;
 
-		TransformTrack() { type = TYPE_TRANSFORM; }
+		// compressed tracks keep their keys here instead, with times split apart for faster lookups
+		bool compressed;
+		Vector<float> compressed_times;
+		Vector<CompressedTransformKey> compressed_keys;
+		AABB loc_range;
+		AABB scale_range;
+
+		TransformTrack() {
+			type = TYPE_TRANSFORM;
+			compressed = false;
+		}
 	};
 
 	/* PROPERTY VALUE TRACK */
@@ -202,8 +220,16 @@ private:
 	template <class T, class V>
 	int _insert(float p_time, T &p_keys, const V &p_value);
 
+	template <class T>
+	static _FORCE_INLINE_ float _key_time(const TKey<T> &p_key) { return p_key.time; }
+	static _FORCE_INLINE_ float _key_time(const Key &p_key) { return p_key.time; }
+	static _FORCE_INLINE_ float _key_time(float p_time) { return p_time; }
+
 	template <class K>
-	inline int _find(const Vector<K> &p_keys, float p_time) const;
+	inline int _find(const Vector<K> &p_keys, float p_time, int p_hint = -1) const;
+
+	template <class K>
+	_FORCE_INLINE_ bool _find_interpolation_keys(const Vector<K> &p_keys, float p_time, bool p_loop_wrap, int *r_cursor, int &r_idx, int &r_next, float &r_c, int &r_len) const;
 
 	_FORCE_INLINE_ Animation::TransformKey _interpolate(const Animation::TransformKey &p_a, const Animation::TransformKey &p_b, float p_c) const;
 
@@ -219,7 +245,12 @@ private:
 	_FORCE_INLINE_ float _cubic_interpolate(const float &p_pre_a, const float &p_a, const float &p_b, const float &p_post_b, float p_c) const;
 
 	template <class T>
-	_FORCE_INLINE_ T _interpolate(const Vector<TKey<T> > &p_keys, float p_time, InterpolationType p_interp, bool p_loop_wrap, bool *p_ok) const;
+	_FORCE_INLINE_ T _interpolate(const Vector<TKey<T> > &p_keys, float p_time, InterpolationType p_interp, bool p_loop_wrap, bool *p_ok, int *r_cursor = NULL) const;
+
+	TransformKey _transform_track_get_compressed_key(const TransformTrack *p_track, int p_key) const;
+	TransformKey _transform_track_interpolate_compressed(const TransformTrack *p_track, float p_time, bool *p_ok, int *r_cursor) const;
+	bool _transform_track_compress(TransformTrack *p_track);
+	void _transform_track_decompress(TransformTrack *p_track);
 
 	template <class T>
 	_FORCE_INLINE_ void _track_get_key_indices_in_range(const Vector<T> &p_array, float from_time, float to_time, List<int> *p_indices) const;
@@ -273,6 +304,15 @@ private:
 	bool _transform_track_optimize_key(const TKey<TransformKey> &t0, const TKey<TransformKey> &t1, const TKey<TransformKey> &t2, float p_alowed_linear_err, float p_alowed_angular_err, float p_max_optimizable_angle, const Vector3 &p_norm);
 	void _transform_track_optimize(int p_idx, float p_allowed_linear_err = 0.05, float p_allowed_angular_err = 0.01, float p_max_optimizable_angle = Math_PI * 0.125);
 
+	struct OptimizeData {
+		const int *tracks;
+		float allowed_linear_err;
+		float allowed_angular_err;
+		float max_optimizable_angle;
+	};
+
+	void _transform_track_optimize_thread(uint32_t p_index, const OptimizeData *p_data);
+
 protected:
 	bool _set(const StringName &p_name, const Variant &p_value);
 	bool _get(const StringName &p_name, Variant &r_ret) const;
@@ -343,9 +383,9 @@ public:
 	void track_set_interpolation_loop_wrap(int p_track, bool p_enable);
 	bool track_get_interpolation_loop_wrap(int p_track) const;
 
-	Error transform_track_interpolate(int p_track, float p_time, Vector3 *r_loc, Quat *r_rot, Vector3 *r_scale) const;
+	Error transform_track_interpolate(int p_track, float p_time, Vector3 *r_loc, Quat *r_rot, Vector3 *r_scale, int *r_cursor = NULL) const;
 
-	Variant value_track_interpolate(int p_track, float p_time) const;
+	Variant value_track_interpolate(int p_track, float p_time, int *r_cursor = NULL) const;
 	void value_track_get_key_indices(int p_track, float p_time, float p_delta, List<int> *p_indices) const;
 	void value_track_set_update_mode(int p_track, UpdateMode p_mode);
 	UpdateMode value_track_get_update_mode(int p_track) const;
@@ -371,6 +411,9 @@ public:
 
 	void optimize(float p_allowed_linear_err = 0.05, float p_allowed_angular_err = 0.01, float p_max_optimizable_angle = Math_PI * 0.125);
 
+	void compress();
+	bool track_is_compressed(int p_track) const;
+
 	Animation();
 	~Animation();
 };
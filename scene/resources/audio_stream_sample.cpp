@@ -31,6 +31,7 @@
 #include "audio_stream_sample.h"
 #include "core/io/marshalls.h"
 #include "core/os/file_access.h"
+#include "servers/audio/audio_mix_kernels.h"
 
 void AudioStreamPlaybackSample::start(float p_from_pos) {
 
@@ -363,17 +364,11 @@ void AudioStreamPlaybackSample::mix(AudioFrame *p_buffer, float p_rate_scale, in
 		switch (base->format) {
 			case AudioStreamSample::FORMAT_8_BITS: {
 
-				if (is_stereo)
-					do_resample<int8_t, true, false>((int8_t *)data, dst_buff, offset, increment, target, ima_adpcm);
-				else
-					do_resample<int8_t, false, false>((int8_t *)data, dst_buff, offset, increment, target, ima_adpcm);
+				AudioMixKernels::resample_pcm8((const int8_t *)data, is_stereo, offset, increment, dst_buff, target);
 			} break;
 			case AudioStreamSample::FORMAT_16_BITS: {
-				if (is_stereo)
-					do_resample<int16_t, true, false>((int16_t *)data, dst_buff, offset, increment, target, ima_adpcm);
-				else
-					do_resample<int16_t, false, false>((int16_t *)data, dst_buff, offset, increment, target, ima_adpcm);
 
+				AudioMixKernels::resample_pcm16((const int16_t *)data, is_stereo, offset, increment, dst_buff, target);
 			} break;
 			case AudioStreamSample::FORMAT_IMA_ADPCM: {
 				if (is_stereo)
@@ -475,6 +470,11 @@ float AudioStreamSample::get_length() const {
 	return float(len) / mix_rate;
 }
 
+bool AudioStreamSample::has_loop() const {
+
+	return loop_mode != LOOP_DISABLED;
+}
+
 void AudioStreamSample::set_data(const PoolVector<uint8_t> &p_data) {
 
 	AudioServer::get_singleton()->lock();
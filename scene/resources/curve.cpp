@@ -44,6 +44,37 @@ static _FORCE_INLINE_ T _bezier_interp(real_t t, T start, T control_1, T control
 	return start * omt3 + control_1 * omt2 * t * 3.0 + control_2 * omt * t2 * 3.0 + end * t3;
 }
 
+// Baked points are bake_interval apart (except for the end point), so the
+// segment containing an offset is found with a division.
+template <class T>
+static _FORCE_INLINE_ T _interpolate_baked_points(const T *p_points, int p_count, float p_interval, float p_max_ofs, float p_offset, bool p_cubic) {
+
+	if (p_offset < 0)
+		return p_points[0];
+	if (p_offset >= p_max_ofs)
+		return p_points[p_count - 1];
+
+	int idx = Math::floor((double)p_offset / (double)p_interval);
+	float frac = Math::fmod(p_offset, p_interval);
+
+	if (idx >= p_count - 1) {
+		return p_points[p_count - 1];
+	} else if (idx == p_count - 2) {
+		frac /= Math::fmod(p_max_ofs, p_interval);
+	} else {
+		frac /= p_interval;
+	}
+
+	if (p_cubic) {
+
+		T pre = idx > 0 ? p_points[idx - 1] : p_points[idx];
+		T post = (idx < (p_count - 2)) ? p_points[idx + 2] : p_points[idx + 1];
+		return p_points[idx].cubic_interpolate(p_points[idx + 1], pre, post, frac);
+	} else {
+		return p_points[idx].linear_interpolate(p_points[idx + 1], frac);
+	}
+}
+
 const char *Curve::SIGNAL_RANGE_CHANGED = "range_changed";
 
 Curve::Curve() {
@@ -541,12 +572,11 @@ void Curve2D::add_point(const Vector2 &p_pos, const Vector2 &p_in, const Vector2
 	n.pos = p_pos;
 	n.in = p_in;
 	n.out = p_out;
-	if (p_atpos >= 0 && p_atpos < points.size())
-		points.insert(p_atpos, n);
-	else
-		points.push_back(n);
+	if (p_atpos < 0 || p_atpos >= points.size())
+		p_atpos = points.size();
+	points.insert(p_atpos, n);
 
-	baked_cache_dirty = true;
+	_make_baked_dirty(p_atpos - 1);
 	emit_signal(CoreStringNames::get_singleton()->changed);
 }
 
@@ -555,7 +585,7 @@ void Curve2D::set_point_position(int p_index, const Vector2 &p_pos) {
 	ERR_FAIL_INDEX(p_index, points.size());
 
 	points.write[p_index].pos = p_pos;
-	baked_cache_dirty = true;
+	_make_baked_dirty(p_index - 1);
 	emit_signal(CoreStringNames::get_singleton()->changed);
 }
 Vector2 Curve2D::get_point_position(int p_index) const {
@@ -569,7 +599,7 @@ void Curve2D::set_point_in(int p_index, const Vector2 &p_in) {
 	ERR_FAIL_INDEX(p_index, points.size());
 
 	points.write[p_index].in = p_in;
-	baked_cache_dirty = true;
+	_make_baked_dirty(p_index - 1);
 	emit_signal(CoreStringNames::get_singleton()->changed);
 }
 Vector2 Curve2D::get_point_in(int p_index) const {
@@ -583,7 +613,7 @@ void Curve2D::set_point_out(int p_index, const Vector2 &p_out) {
 	ERR_FAIL_INDEX(p_index, points.size());
 
 	points.write[p_index].out = p_out;
-	baked_cache_dirty = true;
+	_make_baked_dirty(p_index);
 	emit_signal(CoreStringNames::get_singleton()->changed);
 }
 
@@ -597,14 +627,14 @@ void Curve2D::remove_point(int p_index) {
 
 	ERR_FAIL_INDEX(p_index, points.size());
 	points.remove(p_index);
-	baked_cache_dirty = true;
+	_make_baked_dirty(p_index - 1);
 	emit_signal(CoreStringNames::get_singleton()->changed);
 }
 
 void Curve2D::clear_points() {
 	if (!points.empty()) {
 		points.clear();
-		baked_cache_dirty = true;
+		_make_baked_dirty(0);
 		emit_signal(CoreStringNames::get_singleton()->changed);
 	}
 }
@@ -659,6 +689,12 @@ void Curve2D::_bake_segment2d(Map<float, Vector2> &r_bake, float p_begin, float
 	}
 }
 
+void Curve2D::_make_baked_dirty(int p_from_segment) {
+
+	baked_valid_segments = MIN(baked_valid_segments, MAX(p_from_segment, 0));
+	baked_cache_dirty = true;
+}
+
 void Curve2D::_bake() const {
 
 	if (!baked_cache_dirty)
@@ -667,24 +703,43 @@ void Curve2D::_bake() const {
 	baked_max_ofs = 0;
 	baked_cache_dirty = false;
 
-	if (points.size() == 0) {
-		baked_point_cache.resize(0);
-		return;
-	}
+	if (points.size() < 2) {
 
-	if (points.size() == 1) {
+		baked_valid_segments = 0;
+		baked_segment_start.clear();
 
-		baked_point_cache.resize(1);
-		baked_point_cache.set(0, points[0].pos);
+		if (points.size() == 0) {
+			baked_point_cache.resize(0);
+		} else {
+			baked_point_cache.resize(1);
+			baked_point_cache.set(0, points[0].pos);
+		}
 		return;
 	}
 
+	// Points baked for the segments before the first edited one are still
+	// valid, baking resumes from the last of them.
+	int segments = points.size() - 1;
+	int from = MIN(baked_valid_segments, segments);
+	if (baked_segment_start.size() <= from)
+		from = 0;
+
+	int kept = 0;
 	Vector2 pos = points[0].pos;
-	List<Vector2> pointlist;
+	Vector<Vector2> pointlist;
 
-	pointlist.push_back(pos); //start always from origin
+	if (from > 0) {
+		kept = baked_segment_start[from];
+		pos = baked_point_cache.get(kept - 1);
+	} else {
+		pointlist.push_back(pos); //start always from origin
+	}
 
-	for (int i = 0; i < points.size() - 1; i++) {
+	baked_segment_start.resize(segments + 1);
+
+	for (int i = from; i < segments; i++) {
+
+		baked_segment_start.write[i] = kept + pointlist.size();
 
 		float step = 0.1; // at least 10 substeps ought to be enough?
 		float p = 0;
@@ -729,20 +784,21 @@ void Curve2D::_bake() const {
 		}
 	}
 
+	baked_segment_start.write[segments] = kept + pointlist.size();
+	baked_valid_segments = segments;
+
 	Vector2 lastpos = points[points.size() - 1].pos;
 
 	float rem = pos.distance_to(lastpos);
-	baked_max_ofs = (pointlist.size() - 1) * bake_interval + rem;
+	baked_max_ofs = (kept + pointlist.size() - 1) * bake_interval + rem;
 	pointlist.push_back(lastpos);
 
-	baked_point_cache.resize(pointlist.size());
+	baked_point_cache.resize(kept + pointlist.size());
 	PoolVector2Array::Write w = baked_point_cache.write();
-	int idx = 0;
 
-	for (List<Vector2>::Element *E = pointlist.front(); E; E = E->next()) {
+	for (int i = 0; i < pointlist.size(); i++) {
 
-		w[idx] = E->get();
-		idx++;
+		w[kept + i] = pointlist[i];
 	}
 }
 
@@ -768,33 +824,38 @@ Vector2 Curve2D::interpolate_baked(float p_offset, bool p_cubic) const {
 	if (pc == 1)
 		return baked_point_cache.get(0);
 
-	int bpc = baked_point_cache.size();
 	PoolVector2Array::Read r = baked_point_cache.read();
+	return _interpolate_baked_points(r.ptr(), pc, bake_interval, baked_max_ofs, p_offset, p_cubic);
+}
 
-	if (p_offset < 0)
-		return r[0];
-	if (p_offset >= baked_max_ofs)
-		return r[bpc - 1];
+PoolVector2Array Curve2D::interpolate_baked_array(const PoolRealArray &p_offsets, bool p_cubic) const {
 
-	int idx = Math::floor((double)p_offset / (double)bake_interval);
-	float frac = Math::fmod(p_offset, (float)bake_interval);
+	if (baked_cache_dirty)
+		_bake();
 
-	if (idx >= bpc - 1) {
-		return r[bpc - 1];
-	} else if (idx == bpc - 2) {
-		frac /= Math::fmod(baked_max_ofs, bake_interval);
-	} else {
-		frac /= bake_interval;
+	PoolVector2Array ret;
+
+	//validate//
+	int pc = baked_point_cache.size();
+	if (pc == 0) {
+		ERR_EXPLAIN("No points in Curve2D.");
+		ERR_FAIL_V(ret);
 	}
 
-	if (p_cubic) {
+	int count = p_offsets.size();
+	ret.resize(count);
 
-		Vector2 pre = idx > 0 ? r[idx - 1] : r[idx];
-		Vector2 post = (idx < (bpc - 2)) ? r[idx + 2] : r[idx + 1];
-		return r[idx].cubic_interpolate(r[idx + 1], pre, post, frac);
-	} else {
-		return r[idx].linear_interpolate(r[idx + 1], frac);
+	{
+		PoolVector2Array::Write w = ret.write();
+		PoolRealArray::Read ro = p_offsets.read();
+		PoolVector2Array::Read r = baked_point_cache.read();
+
+		for (int i = 0; i < count; i++) {
+			w[i] = pc == 1 ? r[0] : _interpolate_baked_points(r.ptr(), pc, bake_interval, baked_max_ofs, ro[i], p_cubic);
+		}
 	}
+
+	return ret;
 }
 
 PoolVector2Array Curve2D::get_baked_points() const {
@@ -808,7 +869,7 @@ PoolVector2Array Curve2D::get_baked_points() const {
 void Curve2D::set_bake_interval(float p_tolerance) {
 
 	bake_interval = p_tolerance;
-	baked_cache_dirty = true;
+	_make_baked_dirty(0);
 	emit_signal(CoreStringNames::get_singleton()->changed);
 }
 
@@ -936,7 +997,7 @@ void Curve2D::_set_data(const Dictionary &p_data) {
 		points.write[i].pos = r[i * 3 + 2];
 	}
 
-	baked_cache_dirty = true;
+	_make_baked_dirty(0);
 }
 
 PoolVector2Array Curve2D::tessellate(int p_max_stages, float p_tolerance) const {
@@ -1000,6 +1061,7 @@ void Curve2D::_bind_methods() {
 
 	ClassDB::bind_method(D_METHOD("get_baked_length"), &Curve2D::get_baked_length);
 	ClassDB::bind_method(D_METHOD("interpolate_baked", "offset", "cubic"), &Curve2D::interpolate_baked, DEFVAL(false));
+	ClassDB::bind_method(D_METHOD("interpolate_baked_array", "offsets", "cubic"), &Curve2D::interpolate_baked_array, DEFVAL(false));
 	ClassDB::bind_method(D_METHOD("get_baked_points"), &Curve2D::get_baked_points);
 	ClassDB::bind_method(D_METHOD("get_closest_point", "to_point"), &Curve2D::get_closest_point);
 	ClassDB::bind_method(D_METHOD("get_closest_offset", "to_point"), &Curve2D::get_closest_offset);
@@ -1015,6 +1077,7 @@ void Curve2D::_bind_methods() {
 Curve2D::Curve2D() {
 	baked_cache_dirty = false;
 	baked_max_ofs = 0;
+	baked_valid_segments = 0;
 	/*	add_point(Vector2(-1,0,0));
 	add_point(Vector2(0,2,0));
 	add_point(Vector2(0,3,5));*/
@@ -1038,12 +1101,11 @@ void Curve3D::add_point(const Vector3 &p_pos, const Vector3 &p_in, const Vector3
 	n.pos = p_pos;
 	n.in = p_in;
 	n.out = p_out;
-	if (p_atpos >= 0 && p_atpos < points.size())
-		points.insert(p_atpos, n);
-	else
-		points.push_back(n);
+	if (p_atpos < 0 || p_atpos >= points.size())
+		p_atpos = points.size();
+	points.insert(p_atpos, n);
 
-	baked_cache_dirty = true;
+	_make_baked_dirty(p_atpos - 1);
 	emit_signal(CoreStringNames::get_singleton()->changed);
 }
 void Curve3D::set_point_position(int p_index, const Vector3 &p_pos) {
@@ -1051,7 +1113,7 @@ void Curve3D::set_point_position(int p_index, const Vector3 &p_pos) {
 	ERR_FAIL_INDEX(p_index, points.size());
 
 	points.write[p_index].pos = p_pos;
-	baked_cache_dirty = true;
+	_make_baked_dirty(p_index - 1);
 	emit_signal(CoreStringNames::get_singleton()->changed);
 }
 Vector3 Curve3D::get_point_position(int p_index) const {
@@ -1065,7 +1127,7 @@ void Curve3D::set_point_tilt(int p_index, float p_tilt) {
 	ERR_FAIL_INDEX(p_index, points.size());
 
 	points.write[p_index].tilt = p_tilt;
-	baked_cache_dirty = true;
+	_make_baked_dirty(p_index - 1);
 	emit_signal(CoreStringNames::get_singleton()->changed);
 }
 float Curve3D::get_point_tilt(int p_index) const {
@@ -1079,7 +1141,7 @@ void Curve3D::set_point_in(int p_index, const Vector3 &p_in) {
 	ERR_FAIL_INDEX(p_index, points.size());
 
 	points.write[p_index].in = p_in;
-	baked_cache_dirty = true;
+	_make_baked_dirty(p_index - 1);
 	emit_signal(CoreStringNames::get_singleton()->changed);
 }
 Vector3 Curve3D::get_point_in(int p_index) const {
@@ -1093,7 +1155,7 @@ void Curve3D::set_point_out(int p_index, const Vector3 &p_out) {
 	ERR_FAIL_INDEX(p_index, points.size());
 
 	points.write[p_index].out = p_out;
-	baked_cache_dirty = true;
+	_make_baked_dirty(p_index);
 	emit_signal(CoreStringNames::get_singleton()->changed);
 }
 
@@ -1107,7 +1169,7 @@ void Curve3D::remove_point(int p_index) {
 
 	ERR_FAIL_INDEX(p_index, points.size());
 	points.remove(p_index);
-	baked_cache_dirty = true;
+	_make_baked_dirty(p_index - 1);
 	emit_signal(CoreStringNames::get_singleton()->changed);
 }
 
@@ -1115,7 +1177,7 @@ void Curve3D::clear_points() {
 
 	if (!points.empty()) {
 		points.clear();
-		baked_cache_dirty = true;
+		_make_baked_dirty(0);
 		emit_signal(CoreStringNames::get_singleton()->changed);
 	}
 }
@@ -1169,6 +1231,12 @@ void Curve3D::_bake_segment3d(Map<float, Vector3> &r_bake, float p_begin, float
 	}
 }
 
+void Curve3D::_make_baked_dirty(int p_from_segment) {
+
+	baked_valid_segments = MIN(baked_valid_segments, MAX(p_from_segment, 0));
+	baked_cache_dirty = true;
+}
+
 void Curve3D::_bake() const {
 
 	if (!baked_cache_dirty)
@@ -1177,14 +1245,18 @@ void Curve3D::_bake() const {
 	baked_max_ofs = 0;
 	baked_cache_dirty = false;
 
-	if (points.size() == 0) {
-		baked_point_cache.resize(0);
-		baked_tilt_cache.resize(0);
-		baked_up_vector_cache.resize(0);
-		return;
-	}
+	if (points.size() < 2) {
 
-	if (points.size() == 1) {
+		baked_valid_segments = 0;
+		baked_segment_start.clear();
+
+		if (points.size() == 0) {
+			baked_point_cache.resize(0);
+			baked_tilt_cache.resize(0);
+			baked_up_vector_cache.resize(0);
+			baked_tilted_up_vector_cache.resize(0);
+			return;
+		}
 
 		baked_point_cache.resize(1);
 		baked_point_cache.set(0, points[0].pos);
@@ -1195,17 +1267,38 @@ void Curve3D::_bake() const {
 
 			baked_up_vector_cache.resize(1);
 			baked_up_vector_cache.set(0, Vector3(0, 1, 0));
-		} else
+			baked_tilted_up_vector_cache = baked_up_vector_cache;
+		} else {
 			baked_up_vector_cache.resize(0);
+			baked_tilted_up_vector_cache.resize(0);
+		}
 
 		return;
 	}
 
+	// Points baked for the segments before the first edited one are still
+	// valid, baking resumes from the last of them.
+	int segments = points.size() - 1;
+	int from = MIN(baked_valid_segments, segments);
+	if (baked_segment_start.size() <= from)
+		from = 0;
+
+	int kept = 0;
 	Vector3 pos = points[0].pos;
-	List<Plane> pointlist;
-	pointlist.push_back(Plane(pos, points[0].tilt));
+	Vector<Plane> pointlist;
 
-	for (int i = 0; i < points.size() - 1; i++) {
+	if (from > 0) {
+		kept = baked_segment_start[from];
+		pos = baked_point_cache.get(kept - 1);
+	} else {
+		pointlist.push_back(Plane(pos, points[0].tilt));
+	}
+
+	baked_segment_start.resize(segments + 1);
+
+	for (int i = from; i < segments; i++) {
+
+		baked_segment_start.write[i] = kept + pointlist.size();
 
 		float step = 0.1; // at least 10 substeps ought to be enough?
 		float p = 0;
@@ -1253,21 +1346,36 @@ void Curve3D::_bake() const {
 		}
 	}
 
+	baked_segment_start.write[segments] = kept + pointlist.size();
+	baked_valid_segments = segments;
+
 	Vector3 lastpos = points[points.size() - 1].pos;
 	float lastilt = points[points.size() - 1].tilt;
 
 	float rem = pos.distance_to(lastpos);
-	baked_max_ofs = (pointlist.size() - 1) * bake_interval + rem;
+	baked_max_ofs = (kept + pointlist.size() - 1) * bake_interval + rem;
 	pointlist.push_back(Plane(lastpos, lastilt));
 
-	baked_point_cache.resize(pointlist.size());
+	int count = kept + pointlist.size();
+
+	baked_point_cache.resize(count);
 	PoolVector3Array::Write w = baked_point_cache.write();
-	int idx = 0;
 
-	baked_tilt_cache.resize(pointlist.size());
+	baked_tilt_cache.resize(count);
 	PoolRealArray::Write wt = baked_tilt_cache.write();
 
-	baked_up_vector_cache.resize(up_vector_enabled ? pointlist.size() : 0);
+	for (int i = 0; i < pointlist.size(); i++) {
+
+		w[kept + i] = pointlist[i].normal;
+		wt[kept + i] = pointlist[i].d;
+	}
+
+	baked_up_vector_cache.resize(up_vector_enabled ? count : 0);
+	baked_tilted_up_vector_cache.resize(up_vector_enabled ? count : 0);
+
+	if (!up_vector_enabled)
+		return;
+
 	PoolVector3Array::Write up_write = baked_up_vector_cache.write();
 
 	Vector3 sideways;
@@ -1278,15 +1386,7 @@ void Curve3D::_bake() const {
 	Vector3 prev_up = Vector3(0, 1, 0);
 	Vector3 prev_forward = Vector3(0, 0, 1);
 
-	for (List<Plane>::Element *E = pointlist.front(); E; E = E->next()) {
-
-		w[idx] = E->get().normal;
-		wt[idx] = E->get().d;
-
-		if (!up_vector_enabled) {
-			idx++;
-			continue;
-		}
+	for (int idx = 0; idx < count; idx++) {
 
 		forward = idx > 0 ? (w[idx] - w[idx - 1]).normalized() : prev_forward;
 
@@ -1311,8 +1411,21 @@ void Curve3D::_bake() const {
 		prev_sideways = sideways;
 		prev_up = up;
 		prev_forward = forward;
+	}
+
+	// Up vectors with the tilt already applied, so sampling them does not
+	// have to build two rotations per call.
+	PoolVector3Array::Write tilted_write = baked_tilted_up_vector_cache.write();
+
+	for (int idx = 0; idx < count; idx++) {
 
-		idx++;
+		forward = idx < count - 1 ? w[idx + 1] - w[idx] : w[idx] - w[idx - 1];
+
+		if (forward.length_squared() < CMP_EPSILON2) {
+			tilted_write[idx] = up_write[idx];
+		} else {
+			tilted_write[idx] = up_write[idx].rotated(forward.normalized(), wt[idx]);
+		}
 	}
 }
 
@@ -1338,33 +1451,38 @@ Vector3 Curve3D::interpolate_baked(float p_offset, bool p_cubic) const {
 	if (pc == 1)
 		return baked_point_cache.get(0);
 
-	int bpc = baked_point_cache.size();
 	PoolVector3Array::Read r = baked_point_cache.read();
+	return _interpolate_baked_points(r.ptr(), pc, bake_interval, baked_max_ofs, p_offset, p_cubic);
+}
 
-	if (p_offset < 0)
-		return r[0];
-	if (p_offset >= baked_max_ofs)
-		return r[bpc - 1];
+PoolVector3Array Curve3D::interpolate_baked_array(const PoolRealArray &p_offsets, bool p_cubic) const {
 
-	int idx = Math::floor((double)p_offset / (double)bake_interval);
-	float frac = Math::fmod(p_offset, bake_interval);
+	if (baked_cache_dirty)
+		_bake();
 
-	if (idx >= bpc - 1) {
-		return r[bpc - 1];
-	} else if (idx == bpc - 2) {
-		frac /= Math::fmod(baked_max_ofs, bake_interval);
-	} else {
-		frac /= bake_interval;
+	PoolVector3Array ret;
+
+	//validate//
+	int pc = baked_point_cache.size();
+	if (pc == 0) {
+		ERR_EXPLAIN("No points in Curve3D.");
+		ERR_FAIL_V(ret);
 	}
 
-	if (p_cubic) {
+	int count = p_offsets.size();
+	ret.resize(count);
 
-		Vector3 pre = idx > 0 ? r[idx - 1] : r[idx];
-		Vector3 post = (idx < (bpc - 2)) ? r[idx + 2] : r[idx + 1];
-		return r[idx].cubic_interpolate(r[idx + 1], pre, post, frac);
-	} else {
-		return r[idx].linear_interpolate(r[idx + 1], frac);
+	{
+		PoolVector3Array::Write w = ret.write();
+		PoolRealArray::Read ro = p_offsets.read();
+		PoolVector3Array::Read r = baked_point_cache.read();
+
+		for (int i = 0; i < count; i++) {
+			w[i] = pc == 1 ? r[0] : _interpolate_baked_points(r.ptr(), pc, bake_interval, baked_max_ofs, ro[i], p_cubic);
+		}
 	}
+
+	return ret;
 }
 
 float Curve3D::interpolate_baked_tilt(float p_offset) const {
@@ -1420,9 +1538,9 @@ Vector3 Curve3D::interpolate_baked_up_vector(float p_offset, bool p_apply_tilt)
 	if (count == 1)
 		return baked_up_vector_cache.get(0);
 
-	PoolVector3Array::Read r = baked_up_vector_cache.read();
+	const PoolVector3Array &up_vectors = p_apply_tilt ? baked_tilted_up_vector_cache : baked_up_vector_cache;
+	PoolVector3Array::Read r = up_vectors.read();
 	PoolVector3Array::Read rp = baked_point_cache.read();
-	PoolRealArray::Read rt = baked_tilt_cache.read();
 
 	float offset = CLAMP(p_offset, 0.0f, baked_max_ofs);
 
@@ -1430,17 +1548,12 @@ Vector3 Curve3D::interpolate_baked_up_vector(float p_offset, bool p_apply_tilt)
 	float frac = Math::fmod(offset, bake_interval) / bake_interval;
 
 	if (idx == count - 1)
-		return p_apply_tilt ? r[idx].rotated((rp[idx] - rp[idx - 1]).normalized(), rt[idx]) : r[idx];
+		return r[idx];
 
 	Vector3 forward = (rp[idx + 1] - rp[idx]).normalized();
 	Vector3 up = r[idx];
 	Vector3 up1 = r[idx + 1];
 
-	if (p_apply_tilt) {
-		up.rotate(forward, rt[idx]);
-		up1.rotate(idx + 2 >= count ? forward : (rp[idx + 2] - rp[idx + 1]).normalized(), rt[idx + 1]);
-	}
-
 	Vector3 axis = up.cross(up1);
 
 	if (axis.length_squared() < CMP_EPSILON2)
@@ -1559,7 +1672,7 @@ float Curve3D::get_closest_offset(const Vector3 &p_to_point) const {
 void Curve3D::set_bake_interval(float p_tolerance) {
 
 	bake_interval = p_tolerance;
-	baked_cache_dirty = true;
+	_make_baked_dirty(0);
 	emit_signal(CoreStringNames::get_singleton()->changed);
 }
 
@@ -1571,7 +1684,7 @@ float Curve3D::get_bake_interval() const {
 void Curve3D::set_up_vector_enabled(bool p_enable) {
 
 	up_vector_enabled = p_enable;
-	baked_cache_dirty = true;
+	_make_baked_dirty(points.size());
 	emit_signal(CoreStringNames::get_singleton()->changed);
 }
 
@@ -1628,7 +1741,7 @@ void Curve3D::_set_data(const Dictionary &p_data) {
 		points.write[i].tilt = rt[i];
 	}
 
-	baked_cache_dirty = true;
+	_make_baked_dirty(0);
 }
 
 PoolVector3Array Curve3D::tessellate(int p_max_stages, float p_tolerance) const {
@@ -1696,6 +1809,7 @@ void Curve3D::_bind_methods() {
 
 	ClassDB::bind_method(D_METHOD("get_baked_length"), &Curve3D::get_baked_length);
 	ClassDB::bind_method(D_METHOD("interpolate_baked", "offset", "cubic"), &Curve3D::interpolate_baked, DEFVAL(false));
+	ClassDB::bind_method(D_METHOD("interpolate_baked_array", "offsets", "cubic"), &Curve3D::interpolate_baked_array, DEFVAL(false));
 	ClassDB::bind_method(D_METHOD("interpolate_baked_up_vector", "offset", "apply_tilt"), &Curve3D::interpolate_baked_up_vector, DEFVAL(false));
 	ClassDB::bind_method(D_METHOD("get_baked_points"), &Curve3D::get_baked_points);
 	ClassDB::bind_method(D_METHOD("get_baked_tilts"), &Curve3D::get_baked_tilts);
@@ -1717,6 +1831,7 @@ void Curve3D::_bind_methods() {
 Curve3D::Curve3D() {
 	baked_cache_dirty = false;
 	baked_max_ofs = 0;
+	baked_valid_segments = 0;
 	/*	add_point(Vector3(-1,0,0));
 	add_point(Vector3(0,2,0));
 	add_point(Vector3(0,3,5));*/
@@ -168,8 +168,11 @@ class Curve2D : public Resource {
 	mutable bool baked_cache_dirty;
 	mutable PoolVector2Array baked_point_cache;
 	mutable float baked_max_ofs;
+	mutable int baked_valid_segments; // leading segments whose baked points survived the last edit
+	mutable Vector<int> baked_segment_start; // baked point count before each segment, plus the total before the end point
 
 	void _bake() const;
+	void _make_baked_dirty(int p_from_segment);
 
 	float bake_interval;
 
@@ -200,6 +203,7 @@ public:
 
 	float get_baked_length() const;
 	Vector2 interpolate_baked(float p_offset, bool p_cubic = false) const;
+	PoolVector2Array interpolate_baked_array(const PoolRealArray &p_offsets, bool p_cubic = false) const;
 	PoolVector2Array get_baked_points() const; //useful for going through
 	Vector2 get_closest_point(const Vector2 &p_to_point) const;
 	float get_closest_offset(const Vector2 &p_to_point) const;
@@ -235,9 +239,13 @@ class Curve3D : public Resource {
 	mutable PoolVector3Array baked_point_cache;
 	mutable PoolRealArray baked_tilt_cache;
 	mutable PoolVector3Array baked_up_vector_cache;
+	mutable PoolVector3Array baked_tilted_up_vector_cache;
 	mutable float baked_max_ofs;
+	mutable int baked_valid_segments; // leading segments whose baked points survived the last edit
+	mutable Vector<int> baked_segment_start; // baked point count before each segment, plus the total before the end point
 
 	void _bake() const;
+	void _make_baked_dirty(int p_from_segment);
 
 	float bake_interval;
 	bool up_vector_enabled;
@@ -273,6 +281,7 @@ public:
 
 	float get_baked_length() const;
 	Vector3 interpolate_baked(float p_offset, bool p_cubic = false) const;
+	PoolVector3Array interpolate_baked_array(const PoolRealArray &p_offsets, bool p_cubic = false) const;
 	float interpolate_baked_tilt(float p_offset) const;
 	Vector3 interpolate_baked_up_vector(float p_offset, bool p_apply_tilt = false) const;
 	PoolVector3Array get_baked_points() const; //useful for going through
@@ -281,13 +281,22 @@ const Pair<const DynamicFontAtSize::Character *, DynamicFontAtSize *> DynamicFon
 	return Pair<const Character *, DynamicFontAtSize *>(chr, const_cast<DynamicFontAtSize *>(this));
 }
 
+Pair<const DynamicFontAtSize::Character *, DynamicFontAtSize *> DynamicFontAtSize::_get_char_with_font(CharType p_char, const Vector<Ref<DynamicFontAtSize> > &p_fallbacks) const {
+
+	if (p_char < 256 && latin_chars[p_char]) {
+		return Pair<const Character *, DynamicFontAtSize *>(latin_chars[p_char], const_cast<DynamicFontAtSize *>(this));
+	}
+
+	const_cast<DynamicFontAtSize *>(this)->_update_char(p_char);
+	return _find_char_with_font(p_char, p_fallbacks);
+}
+
 Size2 DynamicFontAtSize::get_char_size(CharType p_char, CharType p_next, const Vector<Ref<DynamicFontAtSize> > &p_fallbacks) const {
 
 	if (!valid)
 		return Size2(1, 1);
-	const_cast<DynamicFontAtSize *>(this)->_update_char(p_char);
 
-	Pair<const Character *, DynamicFontAtSize *> char_pair_with_font = _find_char_with_font(p_char, p_fallbacks);
+	Pair<const Character *, DynamicFontAtSize *> char_pair_with_font = _get_char_with_font(p_char, p_fallbacks);
 	const Character *ch = char_pair_with_font.first;
 	ERR_FAIL_COND_V(!ch, Size2());
 
@@ -315,9 +324,7 @@ float DynamicFontAtSize::draw_char(RID p_canvas_item, const Point2 &p_pos, CharT
 	if (!valid)
 		return 0;
 
-	const_cast<DynamicFontAtSize *>(this)->_update_char(p_char);
-
-	Pair<const Character *, DynamicFontAtSize *> char_pair_with_font = _find_char_with_font(p_char, p_fallbacks);
+	Pair<const Character *, DynamicFontAtSize *> char_pair_with_font = _get_char_with_font(p_char, p_fallbacks);
 	const Character *ch = char_pair_with_font.first;
 	DynamicFontAtSize *font = char_pair_with_font.second;
 
@@ -626,6 +633,9 @@ void DynamicFontAtSize::_update_char(CharType p_char) {
 	}
 
 	char_map[p_char] = character;
+	if (p_char < 256 && character.found) {
+		latin_chars[p_char] = char_map.getptr(p_char);
+	}
 }
 
 void DynamicFontAtSize::update_oversampling() {
@@ -635,6 +645,7 @@ void DynamicFontAtSize::update_oversampling() {
 	FT_Done_FreeType(library);
 	textures.clear();
 	char_map.clear();
+	memset(latin_chars, 0, sizeof(latin_chars));
 	oversampling = font_oversampling;
 	valid = false;
 	_load();
@@ -650,6 +661,7 @@ DynamicFontAtSize::DynamicFontAtSize() {
 	texture_flags = 0;
 	oversampling = font_oversampling;
 	scale_color_font = 1;
+	memset(latin_chars, 0, sizeof(latin_chars));
 }
 
 DynamicFontAtSize::~DynamicFontAtSize() {
@@ -663,9 +675,16 @@ DynamicFontAtSize::~DynamicFontAtSize() {
 
 /////////////////////////
 
+void DynamicFont::_clear_string_size_cache() {
+
+	_THREAD_SAFE_METHOD_
+	string_size_cache.clear();
+}
+
 void DynamicFont::_reload_cache() {
 
 	ERR_FAIL_COND(cache_id.size < 1);
+	_clear_string_size_cache();
 	if (!data.is_valid()) {
 		data_at_size.unref();
 		outline_data_at_size.unref();
@@ -824,6 +843,7 @@ void DynamicFont::set_spacing(int p_type, int p_value) {
 		spacing_space = p_value;
 	}
 
+	_clear_string_size_cache();
 	emit_changed();
 	_change_notify();
 }
@@ -866,6 +886,30 @@ Size2 DynamicFont::get_char_size(CharType p_char, CharType p_next) const {
 	return ret;
 }
 
+Size2 DynamicFont::get_string_size(const String &p_string) const {
+
+	if (!data_at_size.is_valid() || p_string.empty())
+		return Font::get_string_size(p_string);
+
+	_THREAD_SAFE_LOCK_
+	const float *cached = string_size_cache.getptr(p_string);
+	float width = cached ? *cached : 0;
+	_THREAD_SAFE_UNLOCK_
+
+	if (cached)
+		return Size2(width, get_height());
+
+	Size2 size = Font::get_string_size(p_string);
+
+	_THREAD_SAFE_LOCK_
+	if (string_size_cache.size() >= STRING_SIZE_CACHE_MAX)
+		string_size_cache.clear();
+	string_size_cache[p_string] = size.width;
+	_THREAD_SAFE_UNLOCK_
+
+	return size;
+}
+
 bool DynamicFont::is_distance_field_hint() const {
 
 	return false;
@@ -895,6 +939,7 @@ void DynamicFont::set_fallback(int p_idx, const Ref<DynamicFontData> &p_data) {
 	ERR_FAIL_INDEX(p_idx, fallbacks.size());
 	fallbacks.write[p_idx] = p_data;
 	fallback_data_at_size.write[p_idx] = fallbacks.write[p_idx]->_get_dynamic_font_at_size(cache_id);
+	_clear_string_size_cache();
 }
 
 void DynamicFont::add_fallback(const Ref<DynamicFontData> &p_data) {
@@ -905,6 +950,7 @@ void DynamicFont::add_fallback(const Ref<DynamicFontData> &p_data) {
 	if (outline_cache_id.outline_size > 0)
 		fallback_outline_data_at_size.push_back(fallbacks.write[fallbacks.size() - 1]->_get_dynamic_font_at_size(outline_cache_id));
 
+	_clear_string_size_cache();
 	_change_notify();
 	emit_changed();
 	_change_notify();
@@ -924,6 +970,7 @@ void DynamicFont::remove_fallback(int p_idx) {
 	ERR_FAIL_INDEX(p_idx, fallbacks.size());
 	fallbacks.remove(p_idx);
 	fallback_data_at_size.remove(p_idx);
+	_clear_string_size_cache();
 	emit_changed();
 	_change_notify();
 }
@@ -1095,6 +1142,7 @@ void DynamicFont::update_oversampling() {
 				}
 			}
 
+			E->self()->_clear_string_size_cache();
 			changed.push_back(Ref<DynamicFont>(E->self()));
 		}
 
@@ -172,8 +172,11 @@ class DynamicFontAtSize : public Reference {
 	static void _ft_stream_close(FT_Stream stream);
 
 	HashMap<CharType, Character> char_map;
+	// Latin-1 glyphs present in this face, resolved without hashing or fallbacks.
+	const Character *latin_chars[256];
 
 	_FORCE_INLINE_ void _update_char(CharType p_char);
+	_FORCE_INLINE_ Pair<const Character *, DynamicFontAtSize *> _get_char_with_font(CharType p_char, const Vector<Ref<DynamicFontAtSize> > &p_fallbacks) const;
 
 	friend class DynamicFontData;
 	Ref<DynamicFontData> font;
@@ -207,6 +210,8 @@ class DynamicFont : public Font {
 
 	GDCLASS(DynamicFont, Font);
 
+	_THREAD_SAFE_CLASS_
+
 public:
 	enum SpacingType {
 		SPACING_TOP,
@@ -235,6 +240,14 @@ private:
 
 	Color outline_color;
 
+	enum {
+		STRING_SIZE_CACHE_MAX = 4096
+	};
+
+	// Widths of measured strings, cleared whenever glyph advances may change.
+	mutable HashMap<String, float> string_size_cache;
+	void _clear_string_size_cache();
+
 protected:
 	void _reload_cache();
 
@@ -278,6 +291,7 @@ public:
 	virtual float get_descent() const;
 
 	virtual Size2 get_char_size(CharType p_char, CharType p_next = 0) const;
+	virtual Size2 get_string_size(const String &p_string) const;
 
 	virtual bool is_distance_field_hint() const;
 
@@ -52,7 +52,7 @@ public:
 	virtual float get_descent() const = 0;
 
 	virtual Size2 get_char_size(CharType p_char, CharType p_next = 0) const = 0;
-	Size2 get_string_size(const String &p_string) const;
+	virtual Size2 get_string_size(const String &p_string) const;
 
 	virtual bool is_distance_field_hint() const = 0;
 
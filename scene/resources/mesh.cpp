@@ -30,6 +30,9 @@
 
 #include "mesh.h"
 
+#include "core/math/mesh_optimizer.h"
+#include "core/math/mesh_simplifier.h"
+#include "core/math/quick_hull.h"
 #include "core/pair.h"
 #include "scene/resources/concave_polygon_shape.h"
 #include "scene/resources/convex_polygon_shape.h"
@@ -156,7 +159,8 @@ void Mesh::generate_debug_mesh_indices(Vector<Vector3> &r_points) {
 
 bool Mesh::surface_is_softbody_friendly(int p_idx) const {
 	const uint32_t surface_format = surface_get_format(p_idx);
-	return (surface_format & Mesh::ARRAY_FLAG_USE_DYNAMIC_UPDATE && (!(surface_format & Mesh::ARRAY_COMPRESS_VERTEX)) && (!(surface_format & Mesh::ARRAY_COMPRESS_NORMAL)));
+	const uint32_t packed = Mesh::ARRAY_COMPRESS_VERTEX | Mesh::ARRAY_COMPRESS_NORMAL | Mesh::ARRAY_FLAG_USE_QUANTIZED_VERTICES | Mesh::ARRAY_FLAG_USE_OCTAHEDRAL_NORMALS;
+	return (surface_format & Mesh::ARRAY_FLAG_USE_DYNAMIC_UPDATE) && !(surface_format & packed);
 }
 
 PoolVector<Face3> Mesh::get_faces() const {
@@ -237,7 +241,14 @@ Ref<Shape> Mesh::create_convex_shape() const {
 	}
 
 	Ref<ConvexPolygonShape> shape = memnew(ConvexPolygonShape);
-	shape->set_points(vertices);
+
+	// store only the hull vertices, so the physics server and the debug mesh don't redo the work on every point
+	Vector<Vector3> hull;
+	if (vertices.size() > 3 && QuickHull::build_vertices(Variant(vertices), hull) == OK) {
+		shape->set_points(Variant(hull));
+	} else {
+		shape->set_points(vertices);
+	}
 	return shape;
 }
 
@@ -523,6 +534,9 @@ void Mesh::_bind_methods() {
 
 	BIND_ENUM_CONSTANT(ARRAY_FLAG_USE_2D_VERTICES);
 	BIND_ENUM_CONSTANT(ARRAY_FLAG_USE_16_BIT_BONES);
+	BIND_ENUM_CONSTANT(ARRAY_FLAG_USE_QUANTIZED_VERTICES);
+	BIND_ENUM_CONSTANT(ARRAY_FLAG_USE_OCTAHEDRAL_NORMALS);
+	BIND_ENUM_CONSTANT(ARRAY_FLAG_USE_QUANTIZED_UV);
 
 	BIND_ENUM_CONSTANT(ARRAY_COMPRESS_DEFAULT);
 
@@ -639,7 +653,12 @@ bool ArrayMesh::_set(const StringName &p_name, const Variant &p_value) {
 				}
 			}
 
-			add_surface(format, PrimitiveType(primitive), array_data, vertex_count, array_index_data, index_count, aabb, blend_shapes, bone_aabb);
+			Rect2 uv_range(0, 0, 1, 1);
+			if (d.has("uv_range")) {
+				uv_range = d["uv_range"];
+			}
+
+			add_surface(format, PrimitiveType(primitive), array_data, vertex_count, array_index_data, index_count, aabb, blend_shapes, bone_aabb, uv_range);
 		} else {
 			ERR_FAIL_V(false);
 		}
@@ -651,6 +670,18 @@ bool ArrayMesh::_set(const StringName &p_name, const Variant &p_value) {
 		if (d.has("name")) {
 			surface_set_name(idx, d["name"]);
 		}
+		if (d.has("lods")) {
+			// pairs of relative error and index data
+			Array lods = d["lods"];
+			ERR_FAIL_COND_V(lods.size() & 1, false);
+			for (int i = 0; i < lods.size(); i += 2) {
+				Surface::LOD lod;
+				lod.error = lods[i];
+				lod.index_data = lods[i + 1];
+				surfaces.write[idx].lods.push_back(lod);
+			}
+			_surface_update_lods(idx);
+		}
 
 		return true;
 	}
@@ -703,6 +734,9 @@ bool ArrayMesh::_get(const StringName &p_name, Variant &r_ret) const {
 	d["primitive"] = VS::get_singleton()->mesh_surface_get_primitive_type(mesh, idx);
 	d["format"] = VS::get_singleton()->mesh_surface_get_format(mesh, idx);
 	d["aabb"] = VS::get_singleton()->mesh_surface_get_aabb(mesh, idx);
+	if (VS::get_singleton()->mesh_surface_get_format(mesh, idx) & ARRAY_FLAG_USE_QUANTIZED_UV) {
+		d["uv_range"] = VS::get_singleton()->mesh_surface_get_uv_range(mesh, idx);
+	}
 
 	Vector<AABB> skel_aabb = VS::get_singleton()->mesh_surface_get_skeleton_aabb(mesh, idx);
 	Array arr;
@@ -728,6 +762,15 @@ bool ArrayMesh::_get(const StringName &p_name, Variant &r_ret) const {
 	if (n != "")
 		d["name"] = n;
 
+	if (surfaces[idx].lods.size()) {
+		Array lods;
+		for (int i = 0; i < surfaces[idx].lods.size(); i++) {
+			lods.push_back(surfaces[idx].lods[i].error);
+			lods.push_back(surfaces[idx].lods[i].index_data);
+		}
+		d["lods"] = lods;
+	}
+
 	r_ret = d;
 
 	return true;
@@ -769,7 +812,7 @@ void ArrayMesh::_recompute_aabb() {
 	}
 }
 
-void ArrayMesh::add_surface(uint32_t p_format, PrimitiveType p_primitive, const PoolVector<uint8_t> &p_array, int p_vertex_count, const PoolVector<uint8_t> &p_index_array, int p_index_count, const AABB &p_aabb, const Vector<PoolVector<uint8_t> > &p_blend_shapes, const Vector<AABB> &p_bone_aabbs) {
+void ArrayMesh::add_surface(uint32_t p_format, PrimitiveType p_primitive, const PoolVector<uint8_t> &p_array, int p_vertex_count, const PoolVector<uint8_t> &p_index_array, int p_index_count, const AABB &p_aabb, const Vector<PoolVector<uint8_t> > &p_blend_shapes, const Vector<AABB> &p_bone_aabbs, const Rect2 &p_uv_range) {
 
 	Surface s;
 	s.aabb = p_aabb;
@@ -777,7 +820,7 @@ void ArrayMesh::add_surface(uint32_t p_format, PrimitiveType p_primitive, const
 	surfaces.push_back(s);
 	_recompute_aabb();
 
-	VisualServer::get_singleton()->mesh_add_surface(mesh, p_format, (VS::PrimitiveType)p_primitive, p_array, p_vertex_count, p_index_array, p_index_count, p_aabb, p_blend_shapes, p_bone_aabbs);
+	VisualServer::get_singleton()->mesh_add_surface(mesh, p_format, (VS::PrimitiveType)p_primitive, p_array, p_vertex_count, p_index_array, p_index_count, p_aabb, p_blend_shapes, p_bone_aabbs, p_uv_range);
 }
 
 void ArrayMesh::add_surface_from_arrays(PrimitiveType p_primitive, const Array &p_arrays, const Array &p_blend_shapes, uint32_t p_flags) {
@@ -1060,37 +1103,34 @@ struct ArrayMeshLightmapSurface {
 	uint32_t format;
 };
 
-Error ArrayMesh::lightmap_unwrap(const Transform &p_base_transform, float p_texel_size) {
+Error ArrayMesh::lightmap_unwrap_prepare(const Transform &p_base_transform, float p_texel_size, LightmapUnwrapJob &r_job) const {
 
-	ERR_FAIL_COND_V(!array_mesh_lightmap_unwrap_callback, ERR_UNCONFIGURED);
 	ERR_EXPLAIN("Can't unwrap mesh with blend shapes");
 	ERR_FAIL_COND_V(blend_shapes.size() != 0, ERR_UNAVAILABLE);
 
-	Vector<float> vertices;
-	Vector<float> normals;
-	Vector<int> indices;
-	Vector<int> face_materials;
-	Vector<float> uv;
-	Vector<Pair<int, int> > uv_index;
+	r_job.texel_size = p_texel_size;
+	Vector<float> &vertices = r_job.vertices;
+	Vector<float> &normals = r_job.normals;
+	Vector<int> &indices = r_job.indices;
+	Vector<int> &face_materials = r_job.face_materials;
+
+	vertices.clear();
+	normals.clear();
+	indices.clear();
+	face_materials.clear();
 
-	Vector<ArrayMeshLightmapSurface> surfaces;
 	for (int i = 0; i < get_surface_count(); i++) {
-		ArrayMeshLightmapSurface s;
-		s.primitive = surface_get_primitive_type(i);
 
-		if (s.primitive != Mesh::PRIMITIVE_TRIANGLES) {
+		if (surface_get_primitive_type(i) != Mesh::PRIMITIVE_TRIANGLES) {
 			ERR_EXPLAIN("Only triangles are supported for lightmap unwrap");
 			ERR_FAIL_V(ERR_UNAVAILABLE);
 		}
-		s.format = surface_get_format(i);
-		if (!(s.format & ARRAY_FORMAT_NORMAL)) {
+		if (!(surface_get_format(i) & ARRAY_FORMAT_NORMAL)) {
 			ERR_EXPLAIN("Normals are required for lightmap unwrap");
 			ERR_FAIL_V(ERR_UNAVAILABLE);
 		}
 
 		Array arrays = surface_get_arrays(i);
-		s.material = surface_get_material(i);
-		s.vertices = SurfaceTool::create_vertex_array_from_triangle_arrays(arrays);
 
 		PoolVector<Vector3> rvertices = arrays[Mesh::ARRAY_VERTEX];
 		int vc = rvertices.size();
@@ -1103,7 +1143,6 @@ Error ArrayMesh::lightmap_unwrap(const Transform &p_base_transform, float p_texe
 
 		vertices.resize((vertex_ofs + vc) * 3);
 		normals.resize((vertex_ofs + vc) * 3);
-		uv_index.resize(vertex_ofs + vc);
 
 		for (int j = 0; j < vc; j++) {
 
@@ -1116,7 +1155,6 @@ Error ArrayMesh::lightmap_unwrap(const Transform &p_base_transform, float p_texe
 			normals.write[(j + vertex_ofs) * 3 + 0] = n.x;
 			normals.write[(j + vertex_ofs) * 3 + 1] = n.y;
 			normals.write[(j + vertex_ofs) * 3 + 2] = n.z;
-			uv_index.write[j + vertex_ofs] = Pair<int, int>(i, j);
 		}
 
 		PoolVector<int> rindices = arrays[Mesh::ARRAY_INDEX];
@@ -1146,11 +1184,14 @@ Error ArrayMesh::lightmap_unwrap(const Transform &p_base_transform, float p_texe
 				face_materials.push_back(i);
 			}
 		}
-
-		surfaces.push_back(s);
 	}
 
-	//unwrap
+	return OK;
+}
+
+Error ArrayMesh::lightmap_unwrap_run(LightmapUnwrapJob &r_job) {
+
+	ERR_FAIL_COND_V(!array_mesh_lightmap_unwrap_callback, ERR_UNCONFIGURED);
 
 	float *gen_uvs;
 	int *gen_vertices;
@@ -1160,12 +1201,67 @@ Error ArrayMesh::lightmap_unwrap(const Transform &p_base_transform, float p_texe
 	int size_x;
 	int size_y;
 
-	bool ok = array_mesh_lightmap_unwrap_callback(p_texel_size, vertices.ptr(), normals.ptr(), vertices.size() / 3, indices.ptr(), face_materials.ptr(), indices.size(), &gen_uvs, &gen_vertices, &gen_vertex_count, &gen_indices, &gen_index_count, &size_x, &size_y);
+	bool ok = array_mesh_lightmap_unwrap_callback(r_job.texel_size, r_job.vertices.ptr(), r_job.normals.ptr(), r_job.vertices.size() / 3, r_job.indices.ptr(), r_job.face_materials.ptr(), r_job.indices.size(), &gen_uvs, &gen_vertices, &gen_vertex_count, &gen_indices, &gen_index_count, &size_x, &size_y);
 
 	if (!ok) {
 		return ERR_CANT_CREATE;
 	}
 
+	r_job.gen_vertices.resize(gen_vertex_count);
+	r_job.gen_uvs.resize(gen_vertex_count * 2);
+	r_job.gen_indices.resize(gen_index_count);
+	copymem(r_job.gen_vertices.ptrw(), gen_vertices, sizeof(int) * gen_vertex_count);
+	copymem(r_job.gen_uvs.ptrw(), gen_uvs, sizeof(float) * gen_vertex_count * 2);
+	copymem(r_job.gen_indices.ptrw(), gen_indices, sizeof(int) * gen_index_count);
+	r_job.size_hint = Size2(size_x, size_y);
+
+	//free stuff
+	::free(gen_vertices);
+	::free(gen_indices);
+	::free(gen_uvs);
+
+	return OK;
+}
+
+Error ArrayMesh::lightmap_unwrap_apply(const LightmapUnwrapJob &p_job) {
+
+	Vector<Pair<int, int> > uv_index;
+
+	Vector<ArrayMeshLightmapSurface> surfaces;
+	for (int i = 0; i < get_surface_count(); i++) {
+		ArrayMeshLightmapSurface s;
+		s.primitive = surface_get_primitive_type(i);
+		s.format = surface_get_format(i);
+
+		Array arrays = surface_get_arrays(i);
+		s.material = surface_get_material(i);
+		s.vertices = SurfaceTool::create_vertex_array_from_triangle_arrays(arrays);
+
+		PoolVector<Vector3> rvertices = arrays[Mesh::ARRAY_VERTEX];
+		int vc = rvertices.size();
+		int vertex_ofs = uv_index.size();
+		uv_index.resize(vertex_ofs + vc);
+		for (int j = 0; j < vc; j++) {
+			uv_index.write[j + vertex_ofs] = Pair<int, int>(i, j);
+		}
+
+		surfaces.push_back(s);
+	}
+
+	ERR_EXPLAIN("Lightmap unwrap results don't match the mesh");
+	ERR_FAIL_COND_V(uv_index.size() != p_job.vertices.size() / 3 || p_job.gen_uvs.size() != p_job.gen_vertices.size() * 2, ERR_INVALID_DATA);
+
+	const int *gen_vertices = p_job.gen_vertices.ptr();
+	const int *gen_indices = p_job.gen_indices.ptr();
+	const float *gen_uvs = p_job.gen_uvs.ptr();
+	int gen_index_count = p_job.gen_indices.size();
+
+	// validated before the surfaces are removed, results may come from a cache
+	for (int i = 0; i < gen_index_count; i++) {
+		ERR_FAIL_INDEX_V(gen_indices[i], p_job.gen_vertices.size(), ERR_INVALID_DATA);
+		ERR_FAIL_INDEX_V(gen_vertices[gen_indices[i]], uv_index.size(), ERR_INVALID_DATA);
+	}
+
 	//remove surfaces
 	while (get_surface_count()) {
 		surface_remove(0);
@@ -1186,10 +1282,6 @@ Error ArrayMesh::lightmap_unwrap(const Transform &p_base_transform, float p_texe
 	//go through all indices
 	for (int i = 0; i < gen_index_count; i += 3) {
 
-		ERR_FAIL_INDEX_V(gen_vertices[gen_indices[i + 0]], uv_index.size(), ERR_BUG);
-		ERR_FAIL_INDEX_V(gen_vertices[gen_indices[i + 1]], uv_index.size(), ERR_BUG);
-		ERR_FAIL_INDEX_V(gen_vertices[gen_indices[i + 2]], uv_index.size(), ERR_BUG);
-
 		ERR_FAIL_COND_V(uv_index[gen_vertices[gen_indices[i + 0]]].first != uv_index[gen_vertices[gen_indices[i + 1]]].first || uv_index[gen_vertices[gen_indices[i + 0]]].first != uv_index[gen_vertices[gen_indices[i + 2]]].first, ERR_BUG);
 
 		int surface = uv_index[gen_vertices[gen_indices[i + 0]]].first;
@@ -1227,11 +1319,6 @@ Error ArrayMesh::lightmap_unwrap(const Transform &p_base_transform, float p_texe
 		}
 	}
 
-	//free stuff
-	::free(gen_vertices);
-	::free(gen_indices);
-	::free(gen_uvs);
-
 	//generate surfaces
 
 	for (int i = 0; i < surfaces_tools.size(); i++) {
@@ -1239,11 +1326,283 @@ Error ArrayMesh::lightmap_unwrap(const Transform &p_base_transform, float p_texe
 		surfaces_tools.write[i]->commit(Ref<ArrayMesh>((ArrayMesh *)this), surfaces[i].format);
 	}
 
-	set_lightmap_size_hint(Size2(size_x, size_y));
+	set_lightmap_size_hint(p_job.size_hint);
 
 	return OK;
 }
 
+Error ArrayMesh::lightmap_unwrap(const Transform &p_base_transform, float p_texel_size) {
+
+	ERR_FAIL_COND_V(!array_mesh_lightmap_unwrap_callback, ERR_UNCONFIGURED);
+
+	LightmapUnwrapJob job;
+	Error err = lightmap_unwrap_prepare(p_base_transform, p_texel_size, job);
+	if (err != OK) {
+		return err;
+	}
+
+	err = lightmap_unwrap_run(job);
+	if (err != OK) {
+		return err;
+	}
+
+	return lightmap_unwrap_apply(job);
+}
+
+void ArrayMesh::_surface_update_lods(int p_idx) {
+
+	const Vector<Surface::LOD> &lods = surfaces[p_idx].lods;
+
+	Vector<PoolVector<uint8_t> > lod_indices;
+	Vector<float> lod_errors;
+	for (int i = 0; i < lods.size(); i++) {
+		lod_indices.push_back(lods[i].index_data);
+		lod_errors.push_back(lods[i].error);
+	}
+
+	VS::get_singleton()->mesh_surface_set_lods(mesh, p_idx, lod_indices, lod_errors);
+}
+
+void ArrayMesh::generate_lods(int p_max_lods, float p_max_error) {
+
+	ERR_FAIL_COND(p_max_lods < 1);
+
+	for (int i = 0; i < surfaces.size(); i++) {
+
+		if (surfaces[i].is_2d || surface_get_primitive_type(i) != PRIMITIVE_TRIANGLES || !(surface_get_format(i) & ARRAY_FORMAT_INDEX))
+			continue;
+
+		Array arrays = surface_get_arrays(i);
+		PoolVector<Vector3> vertices = arrays[ARRAY_VERTEX];
+		PoolVector<int> indices = arrays[ARRAY_INDEX];
+
+		Vector<MeshSimplifier::LOD> lods = MeshSimplifier::build_lods(vertices, indices, p_max_lods, 0.5, p_max_error);
+
+		surfaces.write[i].lods.clear();
+
+		// same encoding as the base index array
+		bool wide = vertices.size() >= (1 << 16);
+		for (int j = 0; j < lods.size(); j++) {
+
+			// the collapses leave holes in the triangle order, so reorder each level on its own
+			Vector<int> src = lods[j].indices;
+			MeshOptimizer::optimize_vertex_cache(src, vertices.size());
+
+			Surface::LOD lod;
+			lod.error = lods[j].error;
+			lod.index_data.resize(src.size() * (wide ? 4 : 2));
+			{
+				PoolVector<uint8_t>::Write w = lod.index_data.write();
+				for (int k = 0; k < src.size(); k++) {
+					if (wide) {
+						uint32_t v = src[k];
+						copymem(&w[k * 4], &v, 4);
+					} else {
+						uint16_t v = src[k];
+						copymem(&w[k * 2], &v, 2);
+					}
+				}
+			}
+
+			surfaces.write[i].lods.push_back(lod);
+		}
+
+		_surface_update_lods(i);
+	}
+}
+
+void ArrayMesh::clear_lods() {
+
+	for (int i = 0; i < surfaces.size(); i++) {
+		if (surfaces[i].lods.empty())
+			continue;
+		surfaces.write[i].lods.clear();
+		_surface_update_lods(i);
+	}
+}
+
+int ArrayMesh::surface_get_lod_count(int p_idx) const {
+
+	ERR_FAIL_INDEX_V(p_idx, surfaces.size(), 0);
+	return surfaces[p_idx].lods.size();
+}
+
+template <class T>
+static PoolVector<T> _remap_vertex_array(const PoolVector<T> &p_array, const Vector<int> &p_remap) {
+
+	int vertex_count = p_remap.size();
+	if (p_array.size() == 0 || p_array.size() % vertex_count != 0)
+		return p_array;
+
+	// bones, weights and tangents have several elements per vertex
+	int stride = p_array.size() / vertex_count;
+
+	PoolVector<T> ret;
+	ret.resize(p_array.size());
+	{
+		typename PoolVector<T>::Read r = p_array.read();
+		typename PoolVector<T>::Write w = ret.write();
+		for (int i = 0; i < vertex_count; i++) {
+			for (int j = 0; j < stride; j++) {
+				w[p_remap[i] * stride + j] = r[i * stride + j];
+			}
+		}
+	}
+
+	return ret;
+}
+
+static void _remap_vertex_arrays(Array &r_arrays, const Vector<int> &p_remap) {
+
+	for (int i = 0; i < r_arrays.size(); i++) {
+
+		if (i == Mesh::ARRAY_INDEX)
+			continue;
+
+		switch (r_arrays[i].get_type()) {
+			case Variant::POOL_VECTOR3_ARRAY: {
+				r_arrays[i] = _remap_vertex_array(PoolVector<Vector3>(r_arrays[i]), p_remap);
+			} break;
+			case Variant::POOL_VECTOR2_ARRAY: {
+				r_arrays[i] = _remap_vertex_array(PoolVector<Vector2>(r_arrays[i]), p_remap);
+			} break;
+			case Variant::POOL_COLOR_ARRAY: {
+				r_arrays[i] = _remap_vertex_array(PoolVector<Color>(r_arrays[i]), p_remap);
+			} break;
+			case Variant::POOL_REAL_ARRAY: {
+				r_arrays[i] = _remap_vertex_array(PoolVector<real_t>(r_arrays[i]), p_remap);
+			} break;
+			case Variant::POOL_INT_ARRAY: {
+				r_arrays[i] = _remap_vertex_array(PoolVector<int>(r_arrays[i]), p_remap);
+			} break;
+			default: {
+			}
+		}
+	}
+}
+
+struct ArrayMeshRebuildSurface {
+
+	Mesh::PrimitiveType primitive;
+	uint32_t format;
+	Array arrays;
+	Array blend_shapes;
+	Ref<Material> material;
+	String name;
+};
+
+static ArrayMeshRebuildSurface _get_rebuild_surface(const ArrayMesh *p_mesh, int p_idx) {
+
+	ArrayMeshRebuildSurface s;
+	s.primitive = p_mesh->surface_get_primitive_type(p_idx);
+	s.format = p_mesh->surface_get_format(p_idx);
+	s.arrays = p_mesh->surface_get_arrays(p_idx);
+	s.blend_shapes = p_mesh->surface_get_blend_shape_arrays(p_idx);
+	s.material = p_mesh->surface_get_material(p_idx);
+	s.name = p_mesh->surface_get_name(p_idx);
+	return s;
+}
+
+static void _rebuild_surfaces(ArrayMesh *p_mesh, const Vector<ArrayMeshRebuildSurface> &p_surfaces) {
+
+	// Surfaces can only be appended, so all of them are rebuilt to keep their order.
+	while (p_mesh->get_surface_count()) {
+		p_mesh->surface_remove(0);
+	}
+
+	for (int i = 0; i < p_surfaces.size(); i++) {
+
+		const ArrayMeshRebuildSurface &s = p_surfaces[i];
+		p_mesh->add_surface_from_arrays(s.primitive, s.arrays, s.blend_shapes, s.format);
+		int idx = p_mesh->get_surface_count() - 1;
+		p_mesh->surface_set_material(idx, s.material);
+		p_mesh->surface_set_name(idx, s.name);
+	}
+}
+
+void ArrayMesh::optimize_surfaces() {
+
+	Vector<ArrayMeshRebuildSurface> surfs;
+	bool optimized = false;
+
+	for (int i = 0; i < surfaces.size(); i++) {
+
+		ArrayMeshRebuildSurface s = _get_rebuild_surface(this, i);
+
+		if (!surfaces[i].is_2d && s.primitive == PRIMITIVE_TRIANGLES && (s.format & ARRAY_FORMAT_INDEX)) {
+
+			PoolVector<Vector3> vertices = s.arrays[ARRAY_VERTEX];
+			PoolVector<int> index_array = s.arrays[ARRAY_INDEX];
+			int vertex_count = vertices.size();
+
+			Vector<int> indices;
+			indices.resize(index_array.size());
+			{
+				PoolVector<int>::Read r = index_array.read();
+				for (int j = 0; j < indices.size(); j++) {
+					indices.write[j] = r[j];
+				}
+			}
+
+			MeshOptimizer::optimize_vertex_cache(indices, vertex_count);
+			MeshOptimizer::optimize_overdraw(indices, vertices);
+			Vector<int> remap = MeshOptimizer::optimize_vertex_fetch(indices, vertex_count);
+
+			if (remap.size() == vertex_count) {
+
+				{
+					PoolVector<int>::Write w = index_array.write();
+					for (int j = 0; j < indices.size(); j++) {
+						w[j] = indices[j];
+					}
+				}
+
+				_remap_vertex_arrays(s.arrays, remap);
+				s.arrays[ARRAY_INDEX] = index_array;
+
+				for (int j = 0; j < s.blend_shapes.size(); j++) {
+					Array blend_shape = s.blend_shapes[j];
+					_remap_vertex_arrays(blend_shape, remap);
+					s.blend_shapes[j] = blend_shape;
+				}
+
+				optimized = true;
+			}
+		}
+
+		surfs.push_back(s);
+	}
+
+	if (!optimized)
+		return;
+
+	_rebuild_surfaces(this, surfs);
+}
+
+void ArrayMesh::compress_surfaces(uint32_t p_flags) {
+
+	// Only the compression bits and flags can be requested, the arrays present stay the same.
+	p_flags &= ~((1 << ARRAY_MAX) - 1);
+
+	Vector<ArrayMeshRebuildSurface> surfs;
+	bool changed = false;
+
+	for (int i = 0; i < surfaces.size(); i++) {
+
+		ArrayMeshRebuildSurface s = _get_rebuild_surface(this, i);
+		if ((s.format | p_flags) != s.format) {
+			s.format |= p_flags;
+			changed = true;
+		}
+		surfs.push_back(s);
+	}
+
+	if (!changed)
+		return;
+
+	_rebuild_surfaces(this, surfs);
+}
+
 void ArrayMesh::_bind_methods() {
 
 	ClassDB::bind_method(D_METHOD("add_blend_shape", "name"), &ArrayMesh::add_blend_shape);
@@ -1271,6 +1630,11 @@ void ArrayMesh::_bind_methods() {
 	ClassDB::set_method_flags(get_class_static(), _scs_create("regen_normalmaps"), METHOD_FLAGS_DEFAULT | METHOD_FLAG_EDITOR);
 	ClassDB::bind_method(D_METHOD("lightmap_unwrap", "transform", "texel_size"), &ArrayMesh::lightmap_unwrap);
 	ClassDB::set_method_flags(get_class_static(), _scs_create("lightmap_unwrap"), METHOD_FLAGS_DEFAULT | METHOD_FLAG_EDITOR);
+	ClassDB::bind_method(D_METHOD("generate_lods", "max_lods", "max_error"), &ArrayMesh::generate_lods, DEFVAL(4), DEFVAL(0.05));
+	ClassDB::bind_method(D_METHOD("clear_lods"), &ArrayMesh::clear_lods);
+	ClassDB::bind_method(D_METHOD("optimize_surfaces"), &ArrayMesh::optimize_surfaces);
+	ClassDB::bind_method(D_METHOD("compress_surfaces", "flags"), &ArrayMesh::compress_surfaces);
+	ClassDB::bind_method(D_METHOD("surface_get_lod_count", "surf_idx"), &ArrayMesh::surface_get_lod_count);
 	ClassDB::bind_method(D_METHOD("get_faces"), &ArrayMesh::get_faces);
 	ClassDB::bind_method(D_METHOD("generate_triangle_mesh"), &ArrayMesh::generate_triangle_mesh);
 
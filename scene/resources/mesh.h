@@ -98,6 +98,9 @@ public:
 		ARRAY_FLAG_USE_2D_VERTICES = ARRAY_COMPRESS_INDEX << 1,
 		ARRAY_FLAG_USE_16_BIT_BONES = ARRAY_COMPRESS_INDEX << 2,
 		ARRAY_FLAG_USE_DYNAMIC_UPDATE = ARRAY_COMPRESS_INDEX << 3,
+		ARRAY_FLAG_USE_QUANTIZED_VERTICES = ARRAY_COMPRESS_INDEX << 4,
+		ARRAY_FLAG_USE_OCTAHEDRAL_NORMALS = ARRAY_COMPRESS_INDEX << 5,
+		ARRAY_FLAG_USE_QUANTIZED_UV = ARRAY_COMPRESS_INDEX << 6,
 
 		ARRAY_COMPRESS_DEFAULT = ARRAY_COMPRESS_NORMAL | ARRAY_COMPRESS_TANGENT | ARRAY_COMPRESS_COLOR | ARRAY_COMPRESS_TEX_UV | ARRAY_COMPRESS_TEX_UV2 | ARRAY_COMPRESS_WEIGHTS
 
@@ -157,10 +160,16 @@ class ArrayMesh : public Mesh {
 
 private:
 	struct Surface {
+		struct LOD {
+			float error;
+			PoolVector<uint8_t> index_data;
+		};
+
 		String name;
 		AABB aabb;
 		Ref<Material> material;
 		bool is_2d;
+		Vector<LOD> lods;
 	};
 	Vector<Surface> surfaces;
 	RID mesh;
@@ -170,6 +179,7 @@ private:
 	AABB custom_aabb;
 
 	void _recompute_aabb();
+	void _surface_update_lods(int p_idx);
 
 protected:
 	virtual bool _is_generated() const { return false; }
@@ -182,7 +192,7 @@ protected:
 
 public:
 	void add_surface_from_arrays(PrimitiveType p_primitive, const Array &p_arrays, const Array &p_blend_shapes = Array(), uint32_t p_flags = ARRAY_COMPRESS_DEFAULT);
-	void add_surface(uint32_t p_format, PrimitiveType p_primitive, const PoolVector<uint8_t> &p_array, int p_vertex_count, const PoolVector<uint8_t> &p_index_array, int p_index_count, const AABB &p_aabb, const Vector<PoolVector<uint8_t> > &p_blend_shapes = Vector<PoolVector<uint8_t> >(), const Vector<AABB> &p_bone_aabbs = Vector<AABB>());
+	void add_surface(uint32_t p_format, PrimitiveType p_primitive, const PoolVector<uint8_t> &p_array, int p_vertex_count, const PoolVector<uint8_t> &p_index_array, int p_index_count, const AABB &p_aabb, const Vector<PoolVector<uint8_t> > &p_blend_shapes = Vector<PoolVector<uint8_t> >(), const Vector<AABB> &p_bone_aabbs = Vector<AABB>(), const Rect2 &p_uv_range = Rect2(0, 0, 1, 1));
 
 	Array surface_get_arrays(int p_surface) const;
 	Array surface_get_blend_shape_arrays(int p_surface) const;
@@ -225,8 +235,37 @@ public:
 
 	void regen_normalmaps();
 
+	// lightmap_unwrap() split in steps, so several meshes can be unwrapped at
+	// once and the results reused. Only lightmap_unwrap_run() may be called
+	// from other threads, the mesh must not change between the other two.
+	struct LightmapUnwrapJob {
+
+		float texel_size;
+		Vector<float> vertices;
+		Vector<float> normals;
+		Vector<int> indices;
+		Vector<int> face_materials;
+
+		// Results, per generated vertex and per generated index.
+		Vector<int> gen_vertices;
+		Vector<float> gen_uvs;
+		Vector<int> gen_indices;
+		Size2 size_hint;
+	};
+
+	Error lightmap_unwrap_prepare(const Transform &p_base_transform, float p_texel_size, LightmapUnwrapJob &r_job) const;
+	static Error lightmap_unwrap_run(LightmapUnwrapJob &r_job);
+	Error lightmap_unwrap_apply(const LightmapUnwrapJob &p_job);
+
 	Error lightmap_unwrap(const Transform &p_base_transform = Transform(), float p_texel_size = 0.05);
 
+	void generate_lods(int p_max_lods = 4, float p_max_error = 0.05);
+	void clear_lods();
+	int surface_get_lod_count(int p_idx) const;
+
+	void optimize_surfaces();
+	void compress_surfaces(uint32_t p_flags);
+
 	virtual void reload_from_file();
 
 	ArrayMesh();
@@ -200,6 +200,16 @@ Color MultiMesh::get_instance_custom_data(int p_instance) const {
 	return VisualServer::get_singleton()->multimesh_instance_get_custom_data(multimesh, p_instance);
 }
 
+void MultiMesh::set_as_bulk_array(const PoolVector<float> &p_array) {
+
+	VisualServer::get_singleton()->multimesh_set_as_bulk_array(multimesh, p_array);
+}
+
+void MultiMesh::set_as_bulk_array_range(int p_from_instance, const PoolVector<float> &p_array) {
+
+	VisualServer::get_singleton()->multimesh_set_as_bulk_array_range(multimesh, p_from_instance, p_array);
+}
+
 AABB MultiMesh::get_aabb() const {
 
 	return VisualServer::get_singleton()->multimesh_get_aabb(multimesh);
@@ -263,6 +273,8 @@ void MultiMesh::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("get_instance_color", "instance"), &MultiMesh::get_instance_color);
 	ClassDB::bind_method(D_METHOD("set_instance_custom_data", "instance", "custom_data"), &MultiMesh::set_instance_custom_data);
 	ClassDB::bind_method(D_METHOD("get_instance_custom_data", "instance"), &MultiMesh::get_instance_custom_data);
+	ClassDB::bind_method(D_METHOD("set_as_bulk_array", "array"), &MultiMesh::set_as_bulk_array);
+	ClassDB::bind_method(D_METHOD("set_as_bulk_array_range", "from_instance", "array"), &MultiMesh::set_as_bulk_array_range);
 	ClassDB::bind_method(D_METHOD("get_aabb"), &MultiMesh::get_aabb);
 
 	ClassDB::bind_method(D_METHOD("_set_transform_array"), &MultiMesh::_set_transform_array);
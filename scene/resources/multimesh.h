@@ -104,6 +104,9 @@ public:
 	void set_instance_custom_data(int p_instance, const Color &p_custom_data);
 	Color get_instance_custom_data(int p_instance) const;
 
+	void set_as_bulk_array(const PoolVector<float> &p_array);
+	void set_as_bulk_array_range(int p_from_instance, const PoolVector<float> &p_array);
+
 	virtual AABB get_aabb() const;
 
 	virtual RID get_rid() const;
@@ -84,12 +84,47 @@ Node *SceneState::instance(GenEditState p_edit_state) const {
 
 	Map<Ref<Resource>, Ref<Resource> > resources_local_to_scene;
 
+	bool use_setter_cache = p_edit_state == GEN_EDIT_STATE_DISABLED;
+	if (use_setter_cache) {
+		_update_setter_cache();
+	}
+	int setter_ofs = 0;
+
+	//sub-scene instances are detached subtrees that don't depend on each other, so build them on the worker pool first
+	Node **sub_scenes = NULL;
+	if (instance_pool && p_edit_state == GEN_EDIT_STATE_DISABLED && !instancing_sub_scenes && Thread::get_caller_id() == Thread::get_main_id()) {
+
+		int *sub_scene_nodes = (int *)alloca(sizeof(int) * nc);
+		int sub_scene_count = 0;
+		for (int i = 1; i < nc; i++) {
+			if (nd[i].instance >= 0 && !(nd[i].instance & FLAG_INSTANCE_IS_PLACEHOLDER)) {
+				sub_scene_nodes[sub_scene_count++] = i;
+			}
+		}
+
+		if (sub_scene_count > 1) {
+			sub_scenes = (Node **)alloca(sizeof(Node *) * nc);
+			zeromem(sub_scenes, sizeof(Node *) * nc);
+
+			SubSceneWork work;
+			work.nodes = sub_scene_nodes;
+			work.instances = sub_scenes;
+
+			instancing_sub_scenes = true; //the calling thread takes part, don't nest
+			instance_pool->do_work(sub_scene_count, this, &SceneState::_instance_sub_scene, &work);
+			instancing_sub_scenes = false;
+		}
+	}
+
 	for (int i = 0; i < nc; i++) {
 
 		const NodeData &n = nd[i];
 
 		Node *parent = NULL;
 
+		const PropertySetter *node_setters = use_setter_cache ? setter_cache.ptr() + setter_ofs : NULL;
+		setter_ofs += n.properties.size();
+
 		if (i > 0) {
 
 			ERR_EXPLAIN(vformat("Invalid scene: node %s does not specify its parent node.", snames[n.name]))
@@ -133,6 +168,8 @@ Node *SceneState::instance(GenEditState p_edit_state) const {
 					node = ip;
 				}
 				node->set_scene_instance_load_placeholder(true);
+			} else if (sub_scenes && sub_scenes[i]) {
+				node = sub_scenes[i];
 			} else {
 				Ref<PackedScene> sdata = props[n.instance & FLAG_MASK];
 				ERR_FAIL_COND_V(!sdata.is_valid(), NULL);
@@ -176,6 +213,10 @@ Node *SceneState::instance(GenEditState p_edit_state) const {
 
 			node = Object::cast_to<Node>(obj);
 
+			if (node_setters && node->get_class_name() != snames[n.type]) {
+				node_setters = NULL; //replaced by a fallback type
+			}
+
 		} else {
 			//print_line("Class is disabled for: " + itos(n.type));
 			//print_line("name: " + String(snames[n.type]));
@@ -251,7 +292,24 @@ Node *SceneState::instance(GenEditState p_edit_state) const {
 						} else if (p_edit_state == GEN_EDIT_STATE_INSTANCE) {
 							value = value.duplicate(true); // Duplicate arrays and dictionaries for the editor
 						}
-						node->set(snames[nprops[j].name], value, &valid);
+
+						if (node_setters && node_setters[j].setter && !node->get_script_instance()) {
+							const PropertySetter &ps = node_setters[j];
+							Variant::CallError ce;
+							if (ps.index >= 0) {
+								Variant index = ps.index;
+								const Variant *args[2] = { &index, &value };
+								ps.setter->call(node, args, 2, ce);
+							} else {
+								const Variant *args[1] = { &value };
+								ps.setter->call(node, args, 1, ce);
+							}
+#ifdef TOOLS_ENABLED
+							node->set_edited(true);
+#endif
+						} else {
+							node->set(snames[nprops[j].name], value, &valid);
+						}
 					}
 				}
 			}
@@ -353,6 +411,56 @@ Node *SceneState::instance(GenEditState p_edit_state) const {
 	return ret_nodes[0];
 }
 
+void SceneState::_update_setter_cache() const {
+
+	GLOBAL_LOCK_FUNCTION
+
+	if (setter_cache_valid)
+		return;
+
+	int count = 0;
+	for (int i = 0; i < nodes.size(); i++) {
+		count += nodes[i].properties.size();
+	}
+
+	setter_cache.resize(count);
+	PropertySetter *w = setter_cache.ptrw();
+
+	for (int i = 0; i < nodes.size(); i++) {
+
+		const NodeData &n = nodes[i];
+		//only nodes created here have a known type, anything inherited or instanced is left to Object::set()
+		bool created = n.instance < 0 && n.type != TYPE_INSTANCED && n.type >= 0 && n.type < names.size() && !(i == 0 && base_scene_idx >= 0);
+
+		for (int j = 0; j < n.properties.size(); j++) {
+
+			PropertySetter &ps = *w++;
+			ps.setter = NULL;
+			ps.index = -1;
+
+			if (!created || n.properties[j].name < 0 || n.properties[j].name >= names.size())
+				continue;
+
+			const StringName &pname = names[n.properties[j].name];
+			if (pname == CoreStringNames::get_singleton()->_script)
+				continue;
+
+			ps.setter = ClassDB::get_property_setter_bind(names[n.type], pname, &ps.index);
+		}
+	}
+
+	setter_cache_valid = true;
+}
+
+void SceneState::_instance_sub_scene(uint32_t p_index, SubSceneWork *p_work) const {
+
+	int idx = p_work->nodes[p_index];
+	Ref<PackedScene> sdata = variants[nodes[idx].instance & FLAG_MASK];
+	if (sdata.is_valid()) {
+		p_work->instances[idx] = sdata->instance(PackedScene::GEN_EDIT_STATE_DISABLED);
+	}
+}
+
 static int _nm_get_string(const String &p_string, Map<StringName, int> &name_map) {
 
 	if (name_map.has(p_string))
@@ -930,6 +1038,8 @@ void SceneState::clear() {
 	node_paths.clear();
 	editable_instances.clear();
 	base_scene_idx = -1;
+	setter_cache.clear();
+	setter_cache_valid = false;
 }
 
 Ref<SceneState> SceneState::_get_base_scene_state() const {
@@ -1042,6 +1152,22 @@ void SceneState::set_disable_placeholders(bool p_disable) {
 	disable_placeholders = p_disable;
 }
 
+ThreadWorkPool *SceneState::instance_pool = NULL;
+bool SceneState::instancing_sub_scenes = false;
+
+void SceneState::set_threaded_instancing(bool p_enable) {
+
+#ifndef NO_THREADS
+	if (p_enable && !instance_pool) {
+		instance_pool = memnew(ThreadWorkPool);
+		instance_pool->init();
+	} else if (!p_enable && instance_pool) {
+		memdelete(instance_pool);
+		instance_pool = NULL;
+	}
+#endif
+}
+
 bool SceneState::is_connection(int p_node, const StringName &p_signal, int p_to_node, const StringName &p_to_method) const {
 
 	ERR_FAIL_COND_V(p_node < 0, false);
@@ -1124,6 +1250,7 @@ void SceneState::set_bundled_scene(const Dictionary &p_dictionary) {
 
 	nodes.resize(p_dictionary["node_count"]);
 	int nc = nodes.size();
+	setter_cache_valid = false;
 	if (nc) {
 		PoolVector<int> snodes = p_dictionary["nodes"];
 		PoolVector<int>::Read r = snodes.read();
@@ -1566,6 +1693,7 @@ int SceneState::add_node(int p_parent, int p_owner, int p_type, int p_name, int
 	nd.index = p_index;
 
 	nodes.push_back(nd);
+	setter_cache_valid = false;
 
 	return nodes.size() - 1;
 }
@@ -1579,6 +1707,7 @@ void SceneState::add_node_property(int p_node, int p_name, int p_value) {
 	prop.name = p_name;
 	prop.value = p_value;
 	nodes.write[p_node].properties.push_back(prop);
+	setter_cache_valid = false;
 }
 void SceneState::add_node_group(int p_node, int p_group) {
 
@@ -1658,6 +1787,7 @@ SceneState::SceneState() {
 
 	base_scene_idx = -1;
 	last_modified_time = 0;
+	setter_cache_valid = false;
 }
 
 ////////////////
@@ -31,6 +31,7 @@
 #ifndef PACKED_SCENE_H
 #define PACKED_SCENE_H
 
+#include "core/os/thread_work_pool.h"
 #include "core/resource.h"
 #include "scene/main/node.h"
 
@@ -92,6 +93,27 @@ class SceneState : public Reference {
 
 	Vector<ConnectionData> connections;
 
+	//setters resolved for the properties of nodes created by this scene, in node order
+	struct PropertySetter {
+		MethodBind *setter; //NULL goes through Object::set()
+		int index;
+	};
+
+	mutable Vector<PropertySetter> setter_cache;
+	mutable bool setter_cache_valid;
+
+	void _update_setter_cache() const;
+
+	struct SubSceneWork {
+		const int *nodes;
+		Node **instances;
+	};
+
+	void _instance_sub_scene(uint32_t p_index, SubSceneWork *p_work) const;
+
+	static ThreadWorkPool *instance_pool;
+	static bool instancing_sub_scenes;
+
 	Error _parse_node(Node *p_owner, Node *p_node, int p_parent_idx, Map<StringName, int> &name_map, HashMap<Variant, int, VariantHasher, VariantComparator> &variant_map, Map<Node *, int> &node_map, Map<Node *, int> &nodepath_map);
 	Error _parse_connections(Node *p_owner, Node *p_node, Map<StringName, int> &name_map, HashMap<Variant, int, VariantHasher, VariantComparator> &variant_map, Map<Node *, int> &node_map, Map<Node *, int> &nodepath_map);
 
@@ -125,6 +147,7 @@ public:
 	};
 
 	static void set_disable_placeholders(bool p_disable);
+	static void set_threaded_instancing(bool p_enable);
 
 	int find_node_by_path(const NodePath &p_node) const;
 	Variant get_property_value(int p_node, const StringName &p_property, bool &found) const;
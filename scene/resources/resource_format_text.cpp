@@ -718,6 +718,8 @@ void ResourceInteractiveLoaderText::get_dependencies(FileAccess *p_f, List<Strin
 
 Error ResourceInteractiveLoaderText::rename_dependencies(FileAccess *p_f, const String &p_path, const Map<String, String> &p_map) {
 
+	// Tag ends are taken from the file position, so the parser must not read ahead.
+	stream.readahead_enabled = false;
 	open(p_f, true);
 	ERR_FAIL_COND_V(error != OK, error);
 	ignore_resource_parsing = true;
@@ -922,7 +924,7 @@ Error ResourceInteractiveLoaderText::save_as_binary(FileAccess *p_f, const Strin
 	wf->store_32(0); //64 bits file, false for now
 	wf->store_32(VERSION_MAJOR);
 	wf->store_32(VERSION_MINOR);
-	static const int save_format_version = 3; //use format version 3 for saving
+	static const int save_format_version = 4; //use format version 4 for saving, must match ResourceFormatSaverBinaryInstance::write_variant()
 	wf->store_32(save_format_version);
 
 	bs_save_unicode_string(wf.f, is_scene ? "PackedScene" : resource_type);
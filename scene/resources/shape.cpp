@@ -30,6 +30,7 @@
 
 #include "shape.h"
 
+#include "core/math/math_batch.h"
 #include "core/os/os.h"
 #include "scene/main/scene_tree.h"
 #include "scene/resources/mesh.h"
@@ -44,9 +45,7 @@ void Shape::add_vertices_to_array(PoolVector<Vector3> &array, const Transform &p
 		int base = array.size();
 		array.resize(base + toadd.size());
 		PoolVector<Vector3>::Write w = array.write();
-		for (int i = 0; i < toadd.size(); i++) {
-			w[i + base] = p_xform.xform(toadd[i]);
-		}
+		MathBatch::xform_points(p_xform, toadd.ptr(), w.ptr() + base, toadd.size());
 	}
 }
 
@@ -360,6 +360,7 @@ StyleBoxTexture::~StyleBoxTexture() {
 void StyleBoxFlat::set_bg_color(const Color &p_color) {
 
 	bg_color = p_color;
+	_clear_geometry_cache();
 	emit_changed();
 }
 
@@ -373,6 +374,7 @@ void StyleBoxFlat::set_border_color_all(const Color &p_color) {
 
 		border_color.write()[i] = p_color;
 	}
+	_clear_geometry_cache();
 	emit_changed();
 }
 Color StyleBoxFlat::get_border_color_all() const {
@@ -382,6 +384,7 @@ Color StyleBoxFlat::get_border_color_all() const {
 void StyleBoxFlat::set_border_color(Margin p_border, const Color &p_color) {
 
 	border_color.write()[p_border] = p_color;
+	_clear_geometry_cache();
 	emit_changed();
 }
 Color StyleBoxFlat::get_border_color(Margin p_border) const {
@@ -394,6 +397,7 @@ void StyleBoxFlat::set_border_width_all(int p_size) {
 	border_width[1] = p_size;
 	border_width[2] = p_size;
 	border_width[3] = p_size;
+	_clear_geometry_cache();
 	emit_changed();
 }
 int StyleBoxFlat::get_border_width_min() const {
@@ -403,6 +407,7 @@ int StyleBoxFlat::get_border_width_min() const {
 
 void StyleBoxFlat::set_border_width(Margin p_margin, int p_width) {
 	border_width[p_margin] = p_width;
+	_clear_geometry_cache();
 	emit_changed();
 }
 
@@ -413,6 +418,7 @@ int StyleBoxFlat::get_border_width(Margin p_margin) const {
 void StyleBoxFlat::set_border_blend(bool p_blend) {
 
 	blend_border = p_blend;
+	_clear_geometry_cache();
 	emit_changed();
 }
 bool StyleBoxFlat::get_border_blend() const {
@@ -426,6 +432,7 @@ void StyleBoxFlat::set_corner_radius_all(int radius) {
 		corner_radius[i] = radius;
 	}
 
+	_clear_geometry_cache();
 	emit_changed();
 }
 void StyleBoxFlat::set_corner_radius_individual(const int radius_top_left, const int radius_top_right, const int radius_botton_right, const int radius_bottom_left) {
@@ -434,6 +441,7 @@ void StyleBoxFlat::set_corner_radius_individual(const int radius_top_left, const
 	corner_radius[2] = radius_botton_right;
 	corner_radius[3] = radius_bottom_left;
 
+	_clear_geometry_cache();
 	emit_changed();
 }
 int StyleBoxFlat::get_corner_radius_min() const {
@@ -449,6 +457,7 @@ int StyleBoxFlat::get_corner_radius_min() const {
 void StyleBoxFlat::set_corner_radius(const Corner p_corner, const int radius) {
 
 	corner_radius[p_corner] = radius;
+	_clear_geometry_cache();
 	emit_changed();
 }
 int StyleBoxFlat::get_corner_radius(const Corner p_corner) const {
@@ -458,6 +467,7 @@ int StyleBoxFlat::get_corner_radius(const Corner p_corner) const {
 void StyleBoxFlat::set_expand_margin_size(Margin p_expand_margin, float p_size) {
 
 	expand_margin[p_expand_margin] = p_size;
+	_clear_geometry_cache();
 	emit_changed();
 }
 
@@ -466,6 +476,7 @@ void StyleBoxFlat::set_expand_margin_size_individual(float p_left, float p_top,
 	expand_margin[MARGIN_TOP] = p_top;
 	expand_margin[MARGIN_RIGHT] = p_right;
 	expand_margin[MARGIN_BOTTOM] = p_bottom;
+	_clear_geometry_cache();
 	emit_changed();
 }
 
@@ -474,6 +485,7 @@ void StyleBoxFlat::set_expand_margin_size_all(float p_expand_margin_size) {
 
 		expand_margin[i] = p_expand_margin_size;
 	}
+	_clear_geometry_cache();
 	emit_changed();
 }
 
@@ -484,6 +496,7 @@ float StyleBoxFlat::get_expand_margin_size(Margin p_expand_margin) const {
 void StyleBoxFlat::set_draw_center(bool p_enabled) {
 
 	draw_center = p_enabled;
+	_clear_geometry_cache();
 	emit_changed();
 }
 bool StyleBoxFlat::is_draw_center_enabled() const {
@@ -494,6 +507,7 @@ bool StyleBoxFlat::is_draw_center_enabled() const {
 void StyleBoxFlat::set_shadow_color(const Color &p_color) {
 
 	shadow_color = p_color;
+	_clear_geometry_cache();
 	emit_changed();
 }
 Color StyleBoxFlat::get_shadow_color() const {
@@ -504,6 +518,7 @@ Color StyleBoxFlat::get_shadow_color() const {
 void StyleBoxFlat::set_shadow_size(const int &p_size) {
 
 	shadow_size = p_size;
+	_clear_geometry_cache();
 	emit_changed();
 }
 int StyleBoxFlat::get_shadow_size() const {
@@ -513,6 +528,7 @@ int StyleBoxFlat::get_shadow_size() const {
 
 void StyleBoxFlat::set_anti_aliased(const bool &p_anti_aliased) {
 	anti_aliased = p_anti_aliased;
+	_clear_geometry_cache();
 	emit_changed();
 }
 bool StyleBoxFlat::is_anti_aliased() const {
@@ -521,6 +537,7 @@ bool StyleBoxFlat::is_anti_aliased() const {
 
 void StyleBoxFlat::set_aa_size(const int &p_aa_size) {
 	aa_size = CLAMP(p_aa_size, 1, 5);
+	_clear_geometry_cache();
 	emit_changed();
 }
 int StyleBoxFlat::get_aa_size() const {
@@ -529,6 +546,7 @@ int StyleBoxFlat::get_aa_size() const {
 
 void StyleBoxFlat::set_corner_detail(const int &p_corner_detail) {
 	corner_detail = CLAMP(p_corner_detail, 1, 128);
+	_clear_geometry_cache();
 	emit_changed();
 }
 int StyleBoxFlat::get_corner_detail() const {
@@ -654,14 +672,15 @@ inline void adapt_values(int p_index_a, int p_index_b, int *adapted_values, cons
 	adapted_values[p_index_a] = MIN(p_max_a, adapted_values[p_index_a]);
 	adapted_values[p_index_b] = MIN(p_max_b, adapted_values[p_index_b]);
 }
-void StyleBoxFlat::draw(RID p_canvas_item, const Rect2 &p_rect) const {
+void StyleBoxFlat::_build_geometry(const Size2 &p_size, Geometry &r_geometry) const {
 
 	//PREPARATIONS
+	Rect2 rect = Rect2(Point2(), p_size);
 
 	bool rounded_corners = (corner_radius[0] > 0) || (corner_radius[1] > 0) || (corner_radius[2] > 0) || (corner_radius[3] > 0);
 	bool aa_on = rounded_corners && anti_aliased;
 
-	Rect2 style_rect = p_rect.grow_individual(expand_margin[MARGIN_LEFT], expand_margin[MARGIN_TOP], expand_margin[MARGIN_RIGHT], expand_margin[MARGIN_BOTTOM]);
+	Rect2 style_rect = rect.grow_individual(expand_margin[MARGIN_LEFT], expand_margin[MARGIN_TOP], expand_margin[MARGIN_RIGHT], expand_margin[MARGIN_BOTTOM]);
 	if (aa_on) {
 		style_rect = style_rect.grow(-((aa_size + 1) / 2));
 	}
@@ -682,12 +701,13 @@ void StyleBoxFlat::draw(RID p_canvas_item, const Rect2 &p_rect) const {
 
 	Rect2 infill_rect = style_rect.grow_individual(-adapted_border[MARGIN_LEFT], -adapted_border[MARGIN_TOP], -adapted_border[MARGIN_RIGHT], -adapted_border[MARGIN_BOTTOM]);
 
-	Vector<Point2> verts;
-	Vector<int> indices;
-	Vector<Color> colors;
+	Vector<Point2> &verts = r_geometry.verts;
+	Vector<int> &indices = r_geometry.indices;
+	Vector<Color> &colors = r_geometry.colors;
 
-	//DRAWING
-	VisualServer *vs = VisualServer::get_singleton();
+	verts.clear();
+	indices.clear();
+	colors.clear();
 
 	//DRAW SHADOW
 	if (shadow_size > 0) {
@@ -759,7 +779,51 @@ void StyleBoxFlat::draw(RID p_canvas_item, const Rect2 &p_rect) const {
 		}
 	}
 
-	vs->canvas_item_add_triangle_array(p_canvas_item, indices, verts, colors);
+	r_geometry.size = p_size;
+	r_geometry.valid = true;
+}
+
+void StyleBoxFlat::_clear_geometry_cache() {
+
+	for (int i = 0; i < GEOMETRY_CACHE_SIZE; i++) {
+		geometry_cache[i] = Geometry();
+	}
+	geometry_cache_next = 0;
+}
+
+void StyleBoxFlat::draw(RID p_canvas_item, const Rect2 &p_rect) const {
+
+	const Geometry *geometry = NULL;
+	for (int i = 0; i < GEOMETRY_CACHE_SIZE; i++) {
+		if (geometry_cache[i].valid && geometry_cache[i].size == p_rect.size) {
+			geometry = &geometry_cache[i];
+			break;
+		}
+	}
+
+	if (!geometry) {
+		Geometry &slot = geometry_cache[geometry_cache_next];
+		geometry_cache_next = (geometry_cache_next + 1) % GEOMETRY_CACHE_SIZE;
+		_build_geometry(p_rect.size, slot);
+		geometry = &slot;
+	}
+
+	VisualServer *vs = VisualServer::get_singleton();
+
+	if (p_rect.position == Point2()) {
+		// Controls mostly draw at their own origin; the arrays are shared with the command.
+		vs->canvas_item_add_triangle_array(p_canvas_item, geometry->indices, geometry->verts, geometry->colors);
+		return;
+	}
+
+	Vector<Point2> verts = geometry->verts;
+	int vert_count = verts.size();
+	Point2 *w = verts.ptrw();
+	for (int i = 0; i < vert_count; i++) {
+		w[i] += p_rect.position;
+	}
+
+	vs->canvas_item_add_triangle_array(p_canvas_item, geometry->indices, verts, geometry->colors);
 }
 
 float StyleBoxFlat::get_style_margin(Margin p_margin) const {
@@ -881,6 +945,8 @@ StyleBoxFlat::StyleBoxFlat() {
 	corner_radius[1] = 0;
 	corner_radius[2] = 0;
 	corner_radius[3] = 0;
+
+	geometry_cache_next = 0;
 }
 StyleBoxFlat::~StyleBoxFlat() {
 }
@@ -163,6 +163,27 @@ class StyleBoxFlat : public StyleBox {
 	int shadow_size;
 	int aa_size;
 
+	// Geometry depends only on the style and the size of the drawn rect, so
+	// the last few sizes are kept around, built at the origin.
+	enum {
+		GEOMETRY_CACHE_SIZE = 4
+	};
+
+	struct Geometry {
+		Size2 size;
+		Vector<Point2> verts;
+		Vector<int> indices;
+		Vector<Color> colors;
+		bool valid;
+		Geometry() { valid = false; }
+	};
+
+	mutable Geometry geometry_cache[GEOMETRY_CACHE_SIZE];
+	mutable int geometry_cache_next;
+
+	void _build_geometry(const Size2 &p_size, Geometry &r_geometry) const;
+	void _clear_geometry_cache();
+
 protected:
 	virtual float get_style_margin(Margin p_margin) const;
 	static void _bind_methods();
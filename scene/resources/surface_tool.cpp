@@ -63,6 +63,9 @@ bool SurfaceTool::Vertex::operator==(const Vertex &p_vertex) const {
 			return false;
 	}
 
+	if (weights.size() != p_vertex.weights.size())
+		return false;
+
 	for (int i = 0; i < weights.size(); i++) {
 		if (weights[i] != p_vertex.weights[i])
 			return false;
@@ -73,15 +76,15 @@ bool SurfaceTool::Vertex::operator==(const Vertex &p_vertex) const {
 
 uint32_t SurfaceTool::VertexHasher::hash(const Vertex &p_vtx) {
 
-	uint32_t h = hash_djb2_buffer((const uint8_t *)&p_vtx.vertex, sizeof(real_t) * 3);
-	h = hash_djb2_buffer((const uint8_t *)&p_vtx.normal, sizeof(real_t) * 3, h);
-	h = hash_djb2_buffer((const uint8_t *)&p_vtx.binormal, sizeof(real_t) * 3, h);
-	h = hash_djb2_buffer((const uint8_t *)&p_vtx.tangent, sizeof(real_t) * 3, h);
-	h = hash_djb2_buffer((const uint8_t *)&p_vtx.uv, sizeof(real_t) * 2, h);
-	h = hash_djb2_buffer((const uint8_t *)&p_vtx.uv2, sizeof(real_t) * 2, h);
-	h = hash_djb2_buffer((const uint8_t *)&p_vtx.color, sizeof(real_t) * 4, h);
-	h = hash_djb2_buffer((const uint8_t *)p_vtx.bones.ptr(), p_vtx.bones.size() * sizeof(int), h);
-	h = hash_djb2_buffer((const uint8_t *)p_vtx.weights.ptr(), p_vtx.weights.size() * sizeof(float), h);
+	// Only the fields that usually tell vertices apart, operator== settles the rest.
+	uint32_t h = hash_djb2_one_float(p_vtx.vertex.x);
+	h = hash_djb2_one_float(p_vtx.vertex.y, h);
+	h = hash_djb2_one_float(p_vtx.vertex.z, h);
+	h = hash_djb2_one_float(p_vtx.normal.x, h);
+	h = hash_djb2_one_float(p_vtx.normal.y, h);
+	h = hash_djb2_one_float(p_vtx.normal.z, h);
+	h = hash_djb2_one_float(p_vtx.uv.x, h);
+	h = hash_djb2_one_float(p_vtx.uv.y, h);
 	return h;
 }
 
@@ -434,19 +437,40 @@ void SurfaceTool::index() {
 	if (index_array.size())
 		return; //already indexed
 
-	HashMap<Vertex, int, VertexHasher> indices;
+	// Open addressing table of vertex indices, so nothing is allocated or copied per lookup.
+	int table_size = next_power_of_2(MAX(vertex_array.size(), 1) * 2);
+	uint32_t mask = table_size - 1;
+	Vector<int> table;
+	table.resize(table_size);
+	int *slots = table.ptrw();
+	for (int i = 0; i < table_size; i++) {
+		slots[i] = -1;
+	}
+
+	Vector<const Vertex *> unique;
 	List<Vertex> new_vertices;
 
 	for (List<Vertex>::Element *E = vertex_array.front(); E; E = E->next()) {
 
-		int *idxptr = indices.getptr(E->get());
+		const Vertex &v = E->get();
+		uint32_t slot = VertexHasher::hash(v) & mask;
 		int idx;
-		if (!idxptr) {
-			idx = indices.size();
-			new_vertices.push_back(E->get());
-			indices[E->get()] = idx;
-		} else {
-			idx = *idxptr;
+
+		while (true) {
+
+			int entry = slots[slot];
+			if (entry < 0) {
+				idx = unique.size();
+				slots[slot] = idx;
+				unique.push_back(&v);
+				new_vertices.push_back(v);
+				break;
+			}
+			if (*unique[entry] == v) {
+				idx = entry;
+				break;
+			}
+			slot = (slot + 1) & mask;
 		}
 
 		index_array.push_back(idx);
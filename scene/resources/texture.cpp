@@ -474,6 +474,13 @@ StreamTexture::TextureFormatRequestCallback StreamTexture::request_3d_callback =
 StreamTexture::TextureFormatRequestCallback StreamTexture::request_srgb_callback = NULL;
 StreamTexture::TextureFormatRequestCallback StreamTexture::request_normal_callback = NULL;
 
+int StreamTexture::stream_size_limit = 0;
+
+void StreamTexture::set_stream_size_limit(int p_limit) {
+
+	stream_size_limit = MAX(p_limit, 0);
+}
+
 uint32_t StreamTexture::get_flags() const {
 
 	return flags;
@@ -543,7 +550,50 @@ Error StreamTexture::_load_data(const String &p_path, int &tw, int &th, int &tw_
 		p_size_limit = 0;
 	}
 
-	if (df & FORMAT_BIT_LOSSLESS || df & FORMAT_BIT_LOSSY) {
+	if (df & FORMAT_BIT_BASIS_UNIVERSAL) {
+		//a single supercompressed payload, transcoded here to whatever the renderer supports
+
+		uint32_t size = f->get_32();
+
+		PoolVector<uint8_t> pv;
+		pv.resize(size);
+		{
+			PoolVector<uint8_t>::Write w = pv.write();
+			f->get_buffer(w.ptr(), size);
+		}
+
+		memdelete(f);
+
+		if (!Image::basis_universal_unpacker) {
+			ERR_EXPLAIN("Basis Universal textures are not supported by this build, can't load: " + p_path);
+			ERR_FAIL_V(ERR_UNAVAILABLE);
+		}
+
+		Ref<Image> img = Image::basis_universal_unpacker(pv);
+		ERR_FAIL_COND_V(img.is_null() || img->empty(), ERR_FILE_CORRUPT);
+
+		int sw = img->get_width();
+		int sh = img->get_height();
+		int mip = 0;
+
+		while (mip < img->get_mipmap_count() && p_size_limit > 0 && (sw > p_size_limit || sh > p_size_limit)) {
+
+			sw = MAX(sw >> 1, 1);
+			sh = MAX(sh >> 1, 1);
+			mip++;
+		}
+
+		if (mip == 0) {
+			image = img;
+			return OK;
+		}
+
+		PoolVector<uint8_t> img_data = img->get_data();
+		int ofs = img->get_mipmap_offset(mip);
+		image->create(sw, sh, true, img->get_format(), img_data.subarray(ofs, img_data.size() - 1));
+		return OK;
+
+	} else if (df & FORMAT_BIT_LOSSLESS || df & FORMAT_BIT_LOSSY) {
 		//look for a PNG or WEBP file inside
 
 		int sw = tw;
@@ -708,12 +758,57 @@ Error StreamTexture::_load_data(const String &p_path, int &tw, int &th, int &tw_
 	return ERR_BUG; //unreachable
 }
 
+Error StreamTexture::_load_header(const String &p_path) {
+
+	alpha_cache.unref();
+
+	FileAccess *f = FileAccess::open(p_path, FileAccess::READ);
+	ERR_FAIL_COND_V(!f, ERR_CANT_OPEN);
+
+	uint8_t header[4];
+	f->get_buffer(header, 4);
+	if (header[0] != 'G' || header[1] != 'D' || header[2] != 'S' || header[3] != 'T') {
+		memdelete(f);
+		ERR_FAIL_COND_V(header[0] != 'G' || header[1] != 'D' || header[2] != 'S' || header[3] != 'T', ERR_FILE_CORRUPT);
+	}
+
+	int lw = f->get_16();
+	int lwc = f->get_16();
+	int lh = f->get_16();
+	int lhc = f->get_16();
+	int lflags = f->get_32();
+	uint32_t df = f->get_32();
+	memdelete(f);
+
+	// PNG and WEBP payloads only reveal their format once decoded.
+	Image::Format lformat = (df & FORMAT_BIT_LOSSLESS || df & FORMAT_BIT_LOSSY) ? Image::FORMAT_RGBA8 : Image::Format(df & FORMAT_MASK_IMAGE_FORMAT);
+
+	VS::get_singleton()->texture_allocate(texture, lw, lh, 0, lformat, VS::TEXTURE_TYPE_2D, lflags);
+	if (lwc || lhc) {
+		VS::get_singleton()->texture_set_size_override(texture, lwc, lhc, 0);
+	}
+
+	w = lwc ? lwc : lw;
+	h = lhc ? lhc : lh;
+	flags = lflags;
+	path_to_file = p_path;
+	format = lformat;
+
+	_change_notify();
+	return OK;
+}
+
 Error StreamTexture::load(const String &p_path) {
 
+	if (VS::get_singleton()->is_null_mode()) {
+		// Headless servers only need the texture size, skip decoding the pixels.
+		return _load_header(p_path);
+	}
+
 	int lw, lh, lwc, lhc, lflags;
 	Ref<Image> image;
 	image.instance();
-	Error err = _load_data(p_path, lw, lh, lwc, lhc, lflags, image);
+	Error err = _load_data(p_path, lw, lh, lwc, lhc, lflags, image, stream_size_limit);
 	if (err)
 		return err;
 
@@ -725,7 +820,9 @@ Error StreamTexture::load(const String &p_path) {
 	VS::get_singleton()->texture_set_data(texture, image);
 	if (lwc || lhc) {
 		VS::get_singleton()->texture_set_size_override(texture, lwc, lhc, 0);
-	} else {
+	} else if (image->get_width() != lw || image->get_height() != lh) {
+		// Top mipmaps were skipped by the stream size limit, keep reporting the imported size.
+		VS::get_singleton()->texture_set_size_override(texture, lw, lh, 0);
 	}
 
 	w = lwc ? lwc : lw;
@@ -184,10 +184,12 @@ public:
 		FORMAT_BIT_DETECT_3D = 1 << 24,
 		FORMAT_BIT_DETECT_SRGB = 1 << 25,
 		FORMAT_BIT_DETECT_NORMAL = 1 << 26,
+		FORMAT_BIT_BASIS_UNIVERSAL = 1 << 27,
 	};
 
 private:
 	Error _load_data(const String &p_path, int &tw, int &th, int &tw_custom, int &th_custom, int &flags, Ref<Image> &image, int p_size_limit = 0);
+	Error _load_header(const String &p_path);
 	String path_to_file;
 	RID texture;
 	Image::Format format;
@@ -201,6 +203,8 @@ private:
 	static void _requested_srgb(void *p_ud);
 	static void _requested_normal(void *p_ud);
 
+	static int stream_size_limit;
+
 protected:
 	static void _bind_methods();
 	void _validate_property(PropertyInfo &property) const;
@@ -212,6 +216,8 @@ public:
 	static TextureFormatRequestCallback request_srgb_callback;
 	static TextureFormatRequestCallback request_normal_callback;
 
+	static void set_stream_size_limit(int p_limit);
+
 	uint32_t get_flags() const;
 	Image::Format get_format() const;
 	Error load(const String &p_path);
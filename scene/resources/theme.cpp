@@ -33,6 +33,7 @@
 #include "core/print_string.h"
 
 Ref<Theme> Theme::default_theme;
+uint64_t Theme::version = 0;
 
 void Theme::_emit_theme_changed() {
 
@@ -196,6 +197,8 @@ void Theme::set_default_theme_font(const Ref<Font> &p_default_font) {
 	if (default_theme_font == p_default_font)
 		return;
 
+	version++;
+
 	if (default_theme_font.is_valid()) {
 		default_theme_font->disconnect("changed", this, "_emit_theme_changed");
 	}
@@ -217,6 +220,7 @@ Ref<Font> Theme::get_default_theme_font() const {
 
 void Theme::set_default(const Ref<Theme> &p_default) {
 
+	version++;
 	default_theme = p_default;
 }
 
@@ -226,19 +230,23 @@ Ref<Font> Theme::default_font;
 
 void Theme::set_default_icon(const Ref<Texture> &p_icon) {
 
+	version++;
 	default_icon = p_icon;
 }
 void Theme::set_default_style(const Ref<StyleBox> &p_style) {
 
+	version++;
 	default_style = p_style;
 }
 void Theme::set_default_font(const Ref<Font> &p_font) {
 
+	version++;
 	default_font = p_font;
 }
 
 void Theme::set_icon(const StringName &p_name, const StringName &p_type, const Ref<Texture> &p_icon) {
 
+	version++;
 	//ERR_FAIL_COND(p_icon.is_null());
 
 	bool new_value = !icon_map.has(p_type) || !icon_map[p_type].has(p_name);
@@ -260,9 +268,10 @@ void Theme::set_icon(const StringName &p_name, const StringName &p_type, const R
 }
 Ref<Texture> Theme::get_icon(const StringName &p_name, const StringName &p_type) const {
 
-	if (icon_map.has(p_type) && icon_map[p_type].has(p_name) && icon_map[p_type][p_name].is_valid()) {
+	const Ref<Texture> *icon = _find_item(icon_map, p_name, p_type);
+	if (icon && icon->is_valid()) {
 
-		return icon_map[p_type][p_name];
+		return *icon;
 	} else {
 		return default_icon;
 	}
@@ -270,11 +279,13 @@ Ref<Texture> Theme::get_icon(const StringName &p_name, const StringName &p_type)
 
 bool Theme::has_icon(const StringName &p_name, const StringName &p_type) const {
 
-	return (icon_map.has(p_type) && icon_map[p_type].has(p_name) && icon_map[p_type][p_name].is_valid());
+	const Ref<Texture> *icon = _find_item(icon_map, p_name, p_type);
+	return icon && icon->is_valid();
 }
 
 void Theme::clear_icon(const StringName &p_name, const StringName &p_type) {
 
+	version++;
 	ERR_FAIL_COND(!icon_map.has(p_type));
 	ERR_FAIL_COND(!icon_map[p_type].has(p_name));
 
@@ -302,6 +313,7 @@ void Theme::get_icon_list(StringName p_type, List<StringName> *p_list) const {
 }
 
 void Theme::set_shader(const StringName &p_name, const StringName &p_type, const Ref<Shader> &p_shader) {
+	version++;
 	bool new_value = !shader_map.has(p_type) || !shader_map[p_type].has(p_name);
 
 	shader_map[p_type][p_name] = p_shader;
@@ -313,18 +325,21 @@ void Theme::set_shader(const StringName &p_name, const StringName &p_type, const
 }
 
 Ref<Shader> Theme::get_shader(const StringName &p_name, const StringName &p_type) const {
-	if (shader_map.has(p_type) && shader_map[p_type].has(p_name) && shader_map[p_type][p_name].is_valid()) {
-		return shader_map[p_type][p_name];
+	const Ref<Shader> *shader = _find_item(shader_map, p_name, p_type);
+	if (shader && shader->is_valid()) {
+		return *shader;
 	} else {
 		return NULL;
 	}
 }
 
 bool Theme::has_shader(const StringName &p_name, const StringName &p_type) const {
-	return (shader_map.has(p_type) && shader_map[p_type].has(p_name) && shader_map[p_type][p_name].is_valid());
+	const Ref<Shader> *shader = _find_item(shader_map, p_name, p_type);
+	return shader && shader->is_valid();
 }
 
 void Theme::clear_shader(const StringName &p_name, const StringName &p_type) {
+	version++;
 	ERR_FAIL_COND(!shader_map.has(p_type));
 	ERR_FAIL_COND(!shader_map[p_type].has(p_name));
 
@@ -347,6 +362,7 @@ void Theme::get_shader_list(const StringName &p_type, List<StringName> *p_list)
 
 void Theme::set_stylebox(const StringName &p_name, const StringName &p_type, const Ref<StyleBox> &p_style) {
 
+	version++;
 	//ERR_FAIL_COND(p_style.is_null());
 
 	bool new_value = !style_map.has(p_type) || !style_map[p_type].has(p_name);
@@ -368,9 +384,10 @@ void Theme::set_stylebox(const StringName &p_name, const StringName &p_type, con
 
 Ref<StyleBox> Theme::get_stylebox(const StringName &p_name, const StringName &p_type) const {
 
-	if (style_map.has(p_type) && style_map[p_type].has(p_name) && style_map[p_type][p_name].is_valid()) {
+	const Ref<StyleBox> *style = _find_item(style_map, p_name, p_type);
+	if (style && style->is_valid()) {
 
-		return style_map[p_type][p_name];
+		return *style;
 	} else {
 		return default_style;
 	}
@@ -378,11 +395,13 @@ Ref<StyleBox> Theme::get_stylebox(const StringName &p_name, const StringName &p_
 
 bool Theme::has_stylebox(const StringName &p_name, const StringName &p_type) const {
 
-	return (style_map.has(p_type) && style_map[p_type].has(p_name) && style_map[p_type][p_name].is_valid());
+	const Ref<StyleBox> *style = _find_item(style_map, p_name, p_type);
+	return style && style->is_valid();
 }
 
 void Theme::clear_stylebox(const StringName &p_name, const StringName &p_type) {
 
+	version++;
 	ERR_FAIL_COND(!style_map.has(p_type));
 	ERR_FAIL_COND(!style_map[p_type].has(p_name));
 
@@ -418,6 +437,7 @@ void Theme::get_stylebox_types(List<StringName> *p_list) const {
 
 void Theme::set_font(const StringName &p_name, const StringName &p_type, const Ref<Font> &p_font) {
 
+	version++;
 	//ERR_FAIL_COND(p_font.is_null());
 
 	bool new_value = !font_map.has(p_type) || !font_map[p_type].has(p_name);
@@ -439,8 +459,9 @@ void Theme::set_font(const StringName &p_name, const StringName &p_type, const R
 }
 Ref<Font> Theme::get_font(const StringName &p_name, const StringName &p_type) const {
 
-	if (font_map.has(p_type) && font_map[p_type].has(p_name) && font_map[p_type][p_name].is_valid())
-		return font_map[p_type][p_name];
+	const Ref<Font> *font = _find_item(font_map, p_name, p_type);
+	if (font && font->is_valid())
+		return *font;
 	else if (default_theme_font.is_valid())
 		return default_theme_font;
 	else
@@ -449,11 +470,13 @@ Ref<Font> Theme::get_font(const StringName &p_name, const StringName &p_type) co
 
 bool Theme::has_font(const StringName &p_name, const StringName &p_type) const {
 
-	return (font_map.has(p_type) && font_map[p_type].has(p_name) && font_map[p_type][p_name].is_valid());
+	const Ref<Font> *font = _find_item(font_map, p_name, p_type);
+	return font && font->is_valid();
 }
 
 void Theme::clear_font(const StringName &p_name, const StringName &p_type) {
 
+	version++;
 	ERR_FAIL_COND(!font_map.has(p_type));
 	ERR_FAIL_COND(!font_map[p_type].has(p_name));
 
@@ -481,6 +504,7 @@ void Theme::get_font_list(StringName p_type, List<StringName> *p_list) const {
 
 void Theme::set_color(const StringName &p_name, const StringName &p_type, const Color &p_color) {
 
+	version++;
 	bool new_value = !color_map.has(p_type) || !color_map[p_type].has(p_name);
 
 	color_map[p_type][p_name] = p_color;
@@ -493,19 +517,21 @@ void Theme::set_color(const StringName &p_name, const StringName &p_type, const
 
 Color Theme::get_color(const StringName &p_name, const StringName &p_type) const {
 
-	if (color_map.has(p_type) && color_map[p_type].has(p_name))
-		return color_map[p_type][p_name];
+	const Color *color = _find_item(color_map, p_name, p_type);
+	if (color)
+		return *color;
 	else
 		return Color();
 }
 
 bool Theme::has_color(const StringName &p_name, const StringName &p_type) const {
 
-	return (color_map.has(p_type) && color_map[p_type].has(p_name));
+	return _find_item(color_map, p_name, p_type) != NULL;
 }
 
 void Theme::clear_color(const StringName &p_name, const StringName &p_type) {
 
+	version++;
 	ERR_FAIL_COND(!color_map.has(p_type));
 	ERR_FAIL_COND(!color_map[p_type].has(p_name));
 
@@ -529,6 +555,7 @@ void Theme::get_color_list(StringName p_type, List<StringName> *p_list) const {
 
 void Theme::set_constant(const StringName &p_name, const StringName &p_type, int p_constant) {
 
+	version++;
 	bool new_value = !constant_map.has(p_type) || !constant_map[p_type].has(p_name);
 	constant_map[p_type][p_name] = p_constant;
 
@@ -540,8 +567,9 @@ void Theme::set_constant(const StringName &p_name, const StringName &p_type, int
 
 int Theme::get_constant(const StringName &p_name, const StringName &p_type) const {
 
-	if (constant_map.has(p_type) && constant_map[p_type].has(p_name))
-		return constant_map[p_type][p_name];
+	const int *constant = _find_item(constant_map, p_name, p_type);
+	if (constant)
+		return *constant;
 	else {
 		return 0;
 	}
@@ -549,11 +577,12 @@ int Theme::get_constant(const StringName &p_name, const StringName &p_type) cons
 
 bool Theme::has_constant(const StringName &p_name, const StringName &p_type) const {
 
-	return (constant_map.has(p_type) && constant_map[p_type].has(p_name));
+	return _find_item(constant_map, p_name, p_type) != NULL;
 }
 
 void Theme::clear_constant(const StringName &p_name, const StringName &p_type) {
 
+	version++;
 	ERR_FAIL_COND(!constant_map.has(p_type));
 	ERR_FAIL_COND(!constant_map[p_type].has(p_name));
 
@@ -577,6 +606,7 @@ void Theme::get_constant_list(StringName p_type, List<StringName> *p_list) const
 
 void Theme::clear() {
 
+	version++;
 	//these need disconnecting
 	{
 		const StringName *K = NULL;
@@ -627,6 +657,7 @@ void Theme::copy_default_theme() {
 
 void Theme::copy_theme(const Ref<Theme> &p_other) {
 
+	version++;
 	//these need reconnecting, so add normally
 	{
 		const StringName *K = NULL;
@@ -47,8 +47,16 @@ class Theme : public Resource {
 	RES_BASE_EXTENSION("theme");
 
 	static Ref<Theme> default_theme;
+	static uint64_t version;
 	void _emit_theme_changed();
 
+	template <class T>
+	static _FORCE_INLINE_ const T *_find_item(const HashMap<StringName, HashMap<StringName, T> > &p_map, const StringName &p_name, const StringName &p_type) {
+
+		const HashMap<StringName, T> *items = p_map.getptr(p_type);
+		return items ? items->getptr(p_name) : NULL;
+	}
+
 	HashMap<StringName, HashMap<StringName, Ref<Texture> > > icon_map;
 	HashMap<StringName, HashMap<StringName, Ref<StyleBox> > > style_map;
 	HashMap<StringName, HashMap<StringName, Ref<Font> > > font_map;
@@ -137,6 +145,9 @@ public:
 	static Ref<Theme> get_default();
 	static void set_default(const Ref<Theme> &p_default);
 
+	// Increases whenever an item of any theme, or a default, is set or cleared, so lookups can be cached.
+	static uint64_t get_version() { return version; }
+
 	static void set_default_icon(const Ref<Texture> &p_icon);
 	static void set_default_style(const Ref<StyleBox> &p_style);
 	static void set_default_font(const Ref<Font> &p_font);
@@ -30,6 +30,75 @@
 
 #include "video_stream.h"
 
+#include "core/os/os.h"
+#include "core/os/threaded_array_processor.h"
+#include "thirdparty/misc/yuv2rgb.h"
+
+struct YUVBandJob {
+
+	uint8_t *dst;
+	const uint8_t *y;
+	const uint8_t *u;
+	const uint8_t *v;
+	int width;
+	int height;
+	int y_stride;
+	int uv_stride;
+	int chroma_shift_h;
+	int band_height;
+	bool half_width;
+
+	void process_band(uint32_t p_band, void *p_userdata) {
+
+		int from = p_band * band_height;
+		int rows = MIN(band_height, height - from);
+		int uv_ofs = (from >> chroma_shift_h) * uv_stride;
+
+		uint8_t *d = dst + from * width * 4;
+		const uint8_t *py = y + from * y_stride;
+
+		if (chroma_shift_h) {
+			yuv420_2_rgb8888(d, py, u + uv_ofs, v + uv_ofs, width, rows, y_stride, uv_stride, width << 2, 0);
+		} else if (half_width) {
+			// The 4:2:2 and 4:4:4 converters stop one row short of the height they are given.
+			yuv422_2_rgb8888(d, py, u + uv_ofs, v + uv_ofs, width, rows + 1, y_stride, uv_stride, width << 2, 0);
+		} else {
+			yuv444_2_rgb8888(d, py, u + uv_ofs, v + uv_ofs, width, rows + 1, y_stride, uv_stride, width << 2, 0);
+		}
+	}
+};
+
+bool VideoStreamPlayback::_convert_yuv_to_rgba(uint8_t *p_dst, const uint8_t *p_y, const uint8_t *p_u, const uint8_t *p_v, int p_width, int p_height, int p_y_stride, int p_uv_stride, int p_chroma_shift_w, int p_chroma_shift_h) {
+
+	if (p_chroma_shift_h > 1 || p_chroma_shift_w > 1 || (p_chroma_shift_h && !p_chroma_shift_w)) {
+		return false; // 4:1:1 and other layouts are not supported.
+	}
+
+	YUVBandJob job;
+	job.dst = p_dst;
+	job.y = p_y;
+	job.u = p_u;
+	job.v = p_v;
+	job.width = p_width;
+	job.height = p_height;
+	job.y_stride = p_y_stride;
+	job.uv_stride = p_uv_stride;
+	job.chroma_shift_h = p_chroma_shift_h;
+	job.half_width = p_chroma_shift_w == 1;
+
+	int bands = OS::get_singleton()->get_processor_count() * 2;
+	if (bands <= 1 || p_width * p_height < 256 * 256) {
+		job.band_height = p_height;
+		job.process_band(0, NULL);
+		return true;
+	}
+
+	// Bands start on an even row so 4:2:0 chroma rows are never shared.
+	job.band_height = (((p_height + bands - 1) / bands) + 1) & ~1;
+	thread_process_array((p_height + job.band_height - 1) / job.band_height, &job, &YUVBandJob::process_band, (void *)NULL);
+	return true;
+}
+
 void VideoStreamPlayback::_bind_methods(){
 
 };
@@ -40,6 +40,10 @@ class VideoStreamPlayback : public Resource {
 protected:
 	static void _bind_methods();
 
+	// Converts a planar YUV frame to RGBA8, splitting the rows between the
+	// worker threads. p_chroma_shift_w/h select 4:2:0, 4:2:2 or 4:4:4.
+	static bool _convert_yuv_to_rgba(uint8_t *p_dst, const uint8_t *p_y, const uint8_t *p_u, const uint8_t *p_v, int p_width, int p_height, int p_y_stride, int p_uv_stride, int p_chroma_shift_w, int p_chroma_shift_h);
+
 public:
 	typedef int (*AudioMixCallback)(void *p_udata, const float *p_data, int p_frames);
 
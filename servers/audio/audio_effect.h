@@ -40,6 +40,8 @@ class AudioEffectInstance : public Reference {
 public:
 	virtual void process(const AudioFrame *p_src_frames, AudioFrame *p_dst_frames, int p_frame_count) = 0;
 	virtual bool process_silence() const { return false; }
+	// Effects that read other buses' mix buffers are never run in parallel with other buses.
+	virtual bool reads_other_buses() const { return false; }
 };
 
 class AudioEffect : public Resource {
@@ -281,10 +281,25 @@ void AudioFilterSW::Processor::process(float *p_samples, int p_amount, int p_str
 			p_samples += p_stride;
 		}
 	} else {
+		//same as process_one, but with coefficients and history in locals so the loop doesn't go through memory
+		float b0 = coeffs.b0, b1 = coeffs.b1, b2 = coeffs.b2, a1 = coeffs.a1, a2 = coeffs.a2;
+		float h_a1 = ha1, h_a2 = ha2, h_b1 = hb1, h_b2 = hb2;
+
 		for (int i = 0; i < p_amount; i++) {
 
-			process_one(*p_samples);
+			float pre = *p_samples;
+			float out = pre * b0 + h_b1 * b1 + h_b2 * b2 + h_a1 * a1 + h_a2 * a2;
+			*p_samples = out;
+			h_a2 = h_a1;
+			h_b2 = h_b1;
+			h_b1 = pre;
+			h_a1 = out;
 			p_samples += p_stride;
 		}
+
+		ha1 = h_a1;
+		ha2 = h_a2;
+		hb1 = h_b1;
+		hb2 = h_b2;
 	}
 }
@@ -0,0 +1,326 @@
+/*************************************************************************/
+/*  audio_mix_kernels.cpp                                                */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2019 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2019 Godot Engine contributors (cf. AUTHORS.md)    */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+
+#include "audio_mix_kernels.h"
+
+#include "core/error_macros.h"
+#include "core/ustring.h"
+
+#include <string.h>
+
+// SSE2 is part of the x86_64 baseline and NEON of AArch64, so no runtime
+// detection is needed.
+#if defined(__SSE2__)
+#define AUDIO_MIX_SSE2
+#include <emmintrin.h>
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+#define AUDIO_MIX_NEON
+#include <arm_neon.h>
+#endif
+
+#if defined(AUDIO_MIX_SSE2)
+
+typedef __m128 _Vec4f;
+
+static _FORCE_INLINE_ _Vec4f _vload(const float *p_ptr) { return _mm_loadu_ps(p_ptr); }
+static _FORCE_INLINE_ void _vstore(float *p_ptr, _Vec4f p_v) { _mm_storeu_ps(p_ptr, p_v); }
+static _FORCE_INLINE_ _Vec4f _vset1(float p_f) { return _mm_set1_ps(p_f); }
+static _FORCE_INLINE_ _Vec4f _vsetr(float p_a, float p_b, float p_c, float p_d) { return _mm_setr_ps(p_a, p_b, p_c, p_d); }
+static _FORCE_INLINE_ _Vec4f _vsetr_int(int32_t p_a, int32_t p_b, int32_t p_c, int32_t p_d) { return _mm_cvtepi32_ps(_mm_setr_epi32(p_a, p_b, p_c, p_d)); }
+static _FORCE_INLINE_ _Vec4f _vadd(_Vec4f p_a, _Vec4f p_b) { return _mm_add_ps(p_a, p_b); }
+static _FORCE_INLINE_ _Vec4f _vsub(_Vec4f p_a, _Vec4f p_b) { return _mm_sub_ps(p_a, p_b); }
+static _FORCE_INLINE_ _Vec4f _vmul(_Vec4f p_a, _Vec4f p_b) { return _mm_mul_ps(p_a, p_b); }
+// (a, a, b, b) and (c, c, d, d) from (a, b, c, d), turns mono samples into frames.
+static _FORCE_INLINE_ _Vec4f _vdup_lo(_Vec4f p_v) { return _mm_unpacklo_ps(p_v, p_v); }
+static _FORCE_INLINE_ _Vec4f _vdup_hi(_Vec4f p_v) { return _mm_unpackhi_ps(p_v, p_v); }
+
+// Eight consecutive samples as float.
+static _FORCE_INLINE_ void _vload8(const int16_t *p_src, _Vec4f &r_lo, _Vec4f &r_hi) {
+	__m128i v = _mm_loadu_si128((const __m128i *)p_src);
+	r_lo = _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpacklo_epi16(v, v), 16));
+	r_hi = _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpackhi_epi16(v, v), 16));
+}
+
+static _FORCE_INLINE_ void _vload8(const int8_t *p_src, _Vec4f &r_lo, _Vec4f &r_hi) {
+	__m128i v = _mm_loadl_epi64((const __m128i *)p_src);
+	v = _mm_srai_epi16(_mm_unpacklo_epi8(v, v), 8);
+	r_lo = _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpacklo_epi16(v, v), 16));
+	r_hi = _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpackhi_epi16(v, v), 16));
+}
+
+#elif defined(AUDIO_MIX_NEON)
+
+typedef float32x4_t _Vec4f;
+
+static _FORCE_INLINE_ _Vec4f _vload(const float *p_ptr) { return vld1q_f32(p_ptr); }
+static _FORCE_INLINE_ void _vstore(float *p_ptr, _Vec4f p_v) { vst1q_f32(p_ptr, p_v); }
+static _FORCE_INLINE_ _Vec4f _vset1(float p_f) { return vdupq_n_f32(p_f); }
+static _FORCE_INLINE_ _Vec4f _vsetr(float p_a, float p_b, float p_c, float p_d) {
+	float lanes[4] = { p_a, p_b, p_c, p_d };
+	return vld1q_f32(lanes);
+}
+static _FORCE_INLINE_ _Vec4f _vsetr_int(int32_t p_a, int32_t p_b, int32_t p_c, int32_t p_d) {
+	int32_t lanes[4] = { p_a, p_b, p_c, p_d };
+	return vcvtq_f32_s32(vld1q_s32(lanes));
+}
+// Separate multiply and add, vmlaq/vfmaq would round differently from the scalar code.
+static _FORCE_INLINE_ _Vec4f _vadd(_Vec4f p_a, _Vec4f p_b) { return vaddq_f32(p_a, p_b); }
+static _FORCE_INLINE_ _Vec4f _vsub(_Vec4f p_a, _Vec4f p_b) { return vsubq_f32(p_a, p_b); }
+static _FORCE_INLINE_ _Vec4f _vmul(_Vec4f p_a, _Vec4f p_b) { return vmulq_f32(p_a, p_b); }
+static _FORCE_INLINE_ _Vec4f _vdup_lo(_Vec4f p_v) { return vzipq_f32(p_v, p_v).val[0]; }
+static _FORCE_INLINE_ _Vec4f _vdup_hi(_Vec4f p_v) { return vzipq_f32(p_v, p_v).val[1]; }
+
+static _FORCE_INLINE_ void _vload8(const int16_t *p_src, _Vec4f &r_lo, _Vec4f &r_hi) {
+	int16x8_t v = vld1q_s16(p_src);
+	r_lo = vcvtq_f32_s32(vmovl_s16(vget_low_s16(v)));
+	r_hi = vcvtq_f32_s32(vmovl_s16(vget_high_s16(v)));
+}
+
+static _FORCE_INLINE_ void _vload8(const int8_t *p_src, _Vec4f &r_lo, _Vec4f &r_hi) {
+	int16x8_t v = vmovl_s8(vld1_s8(p_src));
+	r_lo = vcvtq_f32_s32(vmovl_s16(vget_low_s16(v)));
+	r_hi = vcvtq_f32_s32(vmovl_s16(vget_high_s16(v)));
+}
+
+#endif
+
+#if defined(AUDIO_MIX_SSE2) || defined(AUDIO_MIX_NEON)
+#define AUDIO_MIX_VECTORIZED
+#endif
+
+template <class T, bool S>
+static void _resample_pcm(const T *p_src, int64_t &r_offset, int32_t p_increment, AudioFrame *r_dst, int p_count) {
+
+	// 8 bit samples are shifted up to the 16 bit range, as the mixer always did.
+	const float scale = (sizeof(T) == 1 ? 256.0f : 1.0f) / 32767.0f;
+	const int stride = S ? 2 : 1;
+	int64_t offset = r_offset;
+	int i = 0;
+
+	if (p_increment == AudioMixKernels::FRAC_LEN && (offset & AudioMixKernels::FRAC_MASK) == 0) {
+		// Source and mix rate match, frames are converted without interpolating.
+		const T *src = p_src + (offset >> AudioMixKernels::FRAC_BITS) * stride;
+#ifdef AUDIO_MIX_VECTORIZED
+		const _Vec4f vscale = _vset1(scale);
+		const int step = 8 / stride;
+		for (; i + step <= p_count; i += step) {
+			_Vec4f lo, hi;
+			_vload8(src + i * stride, lo, hi);
+			lo = _vmul(lo, vscale);
+			hi = _vmul(hi, vscale);
+			float *dst = &r_dst[i].l;
+			if (S) {
+				_vstore(dst, lo);
+				_vstore(dst + 4, hi);
+			} else {
+				_vstore(dst, _vdup_lo(lo));
+				_vstore(dst + 4, _vdup_hi(lo));
+				_vstore(dst + 8, _vdup_lo(hi));
+				_vstore(dst + 12, _vdup_hi(hi));
+			}
+		}
+#endif
+		for (; i < p_count; i++) {
+			const T *s = src + i * stride;
+			float l = s[0] * scale;
+			r_dst[i] = AudioFrame(l, S ? s[1] * scale : l);
+		}
+
+		r_offset = offset + (int64_t(p_count) << AudioMixKernels::FRAC_BITS);
+		return;
+	}
+
+	const float frac_scale = 1.0f / AudioMixKernels::FRAC_LEN;
+
+#ifdef AUDIO_MIX_VECTORIZED
+	const _Vec4f vscale = _vset1(scale);
+	const _Vec4f vfrac_scale = _vset1(frac_scale);
+	for (; i + 2 <= p_count; i += 2) {
+		const T *s0 = p_src + (offset >> AudioMixKernels::FRAC_BITS) * stride;
+		int32_t f0 = int32_t(offset & AudioMixKernels::FRAC_MASK);
+		offset += p_increment;
+		const T *s1 = p_src + (offset >> AudioMixKernels::FRAC_BITS) * stride;
+		int32_t f1 = int32_t(offset & AudioMixKernels::FRAC_MASK);
+		offset += p_increment;
+
+		_Vec4f a, b;
+		if (S) {
+			a = _vsetr_int(s0[0], s0[1], s1[0], s1[1]);
+			b = _vsetr_int(s0[2], s0[3], s1[2], s1[3]);
+		} else {
+			a = _vsetr_int(s0[0], s0[0], s1[0], s1[0]);
+			b = _vsetr_int(s0[1], s0[1], s1[1], s1[1]);
+		}
+		_Vec4f frac = _vmul(_vsetr_int(f0, f0, f1, f1), vfrac_scale);
+		_vstore(&r_dst[i].l, _vmul(_vadd(a, _vmul(_vsub(b, a), frac)), vscale));
+	}
+#endif
+	for (; i < p_count; i++) {
+		const T *s = p_src + (offset >> AudioMixKernels::FRAC_BITS) * stride;
+		float frac = float(offset & AudioMixKernels::FRAC_MASK) * frac_scale;
+		float l = (s[0] + float(s[stride] - s[0]) * frac) * scale;
+		float r = S ? (s[1] + float(s[3] - s[1]) * frac) * scale : l;
+		r_dst[i] = AudioFrame(l, r);
+		offset += p_increment;
+	}
+
+	r_offset = offset;
+}
+
+template <int C>
+static void _resample_ring(const float *p_ring, uint32_t p_ring_bits, uint32_t &r_offset, int32_t p_increment, AudioFrame *r_dst, int p_count) {
+
+	const uint32_t offset_mask = (1 << (p_ring_bits + AudioMixKernels::FRAC_BITS)) - 1;
+	const uint32_t frame_mask = (1 << p_ring_bits) - 1;
+	uint32_t offset = r_offset;
+	int i = 0;
+
+	if (p_increment == AudioMixKernels::FRAC_LEN && (offset & AudioMixKernels::FRAC_MASK) == 0) {
+		// Matching rates, frames are copied up to the end of the ring and then from its start.
+		uint32_t pos = offset >> AudioMixKernels::FRAC_BITS;
+		while (i < p_count) {
+			uint32_t from = (pos + 1) & frame_mask;
+			int run = MIN(p_count - i, int(frame_mask + 1 - from));
+			if (C == 2) {
+				memcpy(&r_dst[i].l, p_ring + from * 2, run * 2 * sizeof(float));
+			} else {
+				for (int j = 0; j < run; j++) {
+					const float *f = p_ring + (from + j) * C;
+					r_dst[i + j] = AudioFrame(f[0], C == 1 ? f[0] : f[1]);
+				}
+			}
+			i += run;
+			pos = (from + run - 1) & frame_mask;
+		}
+
+		r_offset = pos << AudioMixKernels::FRAC_BITS;
+		return;
+	}
+
+	const float frac_scale = 1.0f / AudioMixKernels::FRAC_LEN;
+
+#ifdef AUDIO_MIX_VECTORIZED
+	const _Vec4f vfrac_scale = _vset1(frac_scale);
+	for (; i + 2 <= p_count; i += 2) {
+		offset = (offset + p_increment) & offset_mask;
+		uint32_t pos0 = offset >> AudioMixKernels::FRAC_BITS;
+		int32_t f0 = int32_t(offset & AudioMixKernels::FRAC_MASK);
+		offset = (offset + p_increment) & offset_mask;
+		uint32_t pos1 = offset >> AudioMixKernels::FRAC_BITS;
+		int32_t f1 = int32_t(offset & AudioMixKernels::FRAC_MASK);
+
+		const float *a0 = p_ring + pos0 * C;
+		const float *b0 = p_ring + ((pos0 + 1) & frame_mask) * C;
+		const float *a1 = p_ring + pos1 * C;
+		const float *b1 = p_ring + ((pos1 + 1) & frame_mask) * C;
+
+		_Vec4f a = _vsetr(a0[0], a0[C == 1 ? 0 : 1], a1[0], a1[C == 1 ? 0 : 1]);
+		_Vec4f b = _vsetr(b0[0], b0[C == 1 ? 0 : 1], b1[0], b1[C == 1 ? 0 : 1]);
+		_Vec4f frac = _vmul(_vsetr_int(f0, f0, f1, f1), vfrac_scale);
+		_vstore(&r_dst[i].l, _vadd(a, _vmul(_vsub(b, a), frac)));
+	}
+#endif
+	for (; i < p_count; i++) {
+		offset = (offset + p_increment) & offset_mask;
+		uint32_t pos = offset >> AudioMixKernels::FRAC_BITS;
+		float frac = float(offset & AudioMixKernels::FRAC_MASK) * frac_scale;
+		const float *a = p_ring + pos * C;
+		const float *b = p_ring + ((pos + 1) & frame_mask) * C;
+
+		float l = a[0] + (b[0] - a[0]) * frac;
+		float r = C == 1 ? l : a[1] + (b[1] - a[1]) * frac;
+		r_dst[i] = AudioFrame(l, r);
+	}
+
+	r_offset = offset;
+}
+
+void AudioMixKernels::resample_pcm8(const int8_t *p_src, bool p_stereo, int64_t &r_offset, int32_t p_increment, AudioFrame *r_dst, int p_count) {
+
+	if (p_stereo) {
+		_resample_pcm<int8_t, true>(p_src, r_offset, p_increment, r_dst, p_count);
+	} else {
+		_resample_pcm<int8_t, false>(p_src, r_offset, p_increment, r_dst, p_count);
+	}
+}
+
+void AudioMixKernels::resample_pcm16(const int16_t *p_src, bool p_stereo, int64_t &r_offset, int32_t p_increment, AudioFrame *r_dst, int p_count) {
+
+	if (p_stereo) {
+		_resample_pcm<int16_t, true>(p_src, r_offset, p_increment, r_dst, p_count);
+	} else {
+		_resample_pcm<int16_t, false>(p_src, r_offset, p_increment, r_dst, p_count);
+	}
+}
+
+void AudioMixKernels::resample_ring(const float *p_ring, int p_channels, uint32_t p_ring_bits, uint32_t &r_offset, int32_t p_increment, AudioFrame *r_dst, int p_count) {
+
+	switch (p_channels) {
+		case 1: _resample_ring<1>(p_ring, p_ring_bits, r_offset, p_increment, r_dst, p_count); break;
+		case 2: _resample_ring<2>(p_ring, p_ring_bits, r_offset, p_increment, r_dst, p_count); break;
+		case 4: _resample_ring<4>(p_ring, p_ring_bits, r_offset, p_increment, r_dst, p_count); break;
+		case 6: _resample_ring<6>(p_ring, p_ring_bits, r_offset, p_increment, r_dst, p_count); break;
+		default: {
+			ERR_EXPLAIN("Unsupported channel count: " + itos(p_channels));
+			ERR_FAIL();
+		}
+	}
+}
+
+void AudioMixKernels::mix_ramp(const AudioFrame *p_src, AudioFrame *r_dst, int p_count, const AudioFrame &p_volume, const AudioFrame &p_volume_inc) {
+
+	AudioFrame vol = p_volume;
+	int i = 0;
+
+#ifdef AUDIO_MIX_VECTORIZED
+	_Vec4f v = _vsetr(vol.l, vol.r, vol.l + p_volume_inc.l, vol.r + p_volume_inc.r);
+	const _Vec4f inc = _vsetr(p_volume_inc.l * 2.0f, p_volume_inc.r * 2.0f, p_volume_inc.l * 2.0f, p_volume_inc.r * 2.0f);
+	for (; i + 2 <= p_count; i += 2) {
+		float *dst = &r_dst[i].l;
+		_vstore(dst, _vadd(_vload(dst), _vmul(_vload(&p_src[i].l), v)));
+		v = _vadd(v, inc);
+	}
+	vol = p_volume + p_volume_inc * float(i);
+#endif
+	for (; i < p_count; i++) {
+		r_dst[i] += p_src[i] * vol;
+		vol += p_volume_inc;
+	}
+}
+
+bool AudioMixKernels::is_vectorized() {
+
+#ifdef AUDIO_MIX_VECTORIZED
+	return true;
+#else
+	return false;
+#endif
+}
@@ -0,0 +1,70 @@
+/*************************************************************************/
+/*  audio_mix_kernels.h                                                  */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2019 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2019 Godot Engine contributors (cf. AUTHORS.md)    */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+
+#ifndef AUDIO_MIX_KERNELS_H
+#define AUDIO_MIX_KERNELS_H
+
+#include "core/math/audio_frame.h"
+#include "core/typedefs.h"
+
+// Block versions of the per-frame loops of the sample players and the ring
+// buffer resampler. When the target has SSE2 or NEON, two frames are handled
+// per step, and blocks of source samples are converted at once when the source
+// and mix rates match.
+class AudioMixKernels {
+	AudioMixKernels();
+
+public:
+	// Fixed point used for source offsets, same as the mixers using these.
+	enum {
+		FRAC_BITS = 13,
+		FRAC_LEN = (1 << FRAC_BITS),
+		FRAC_MASK = FRAC_LEN - 1
+	};
+
+	// Linearly interpolated read of mono or interleaved stereo PCM, starting at
+	// r_offset and advancing it by p_increment per frame. Reads one frame past
+	// the last position, 8 bit samples are scaled to the 16 bit range.
+	static void resample_pcm8(const int8_t *p_src, bool p_stereo, int64_t &r_offset, int32_t p_increment, AudioFrame *r_dst, int p_count);
+	static void resample_pcm16(const int16_t *p_src, bool p_stereo, int64_t &r_offset, int32_t p_increment, AudioFrame *r_dst, int p_count);
+
+	// Same for a ring of 1 << p_ring_bits float frames with p_channels
+	// interleaved channels, of which the first two are used. r_offset is
+	// advanced before each read and wraps around the ring.
+	static void resample_ring(const float *p_ring, int p_channels, uint32_t p_ring_bits, uint32_t &r_offset, int32_t p_increment, AudioFrame *r_dst, int p_count);
+
+	// r_dst[i] += p_src[i] * (p_volume + p_volume_inc * i).
+	static void mix_ramp(const AudioFrame *p_src, AudioFrame *r_dst, int p_count, const AudioFrame &p_volume, const AudioFrame &p_volume_inc);
+
+	static bool is_vectorized();
+};
+
+#endif // AUDIO_MIX_KERNELS_H
@@ -31,6 +31,7 @@
 #include "audio_rb_resampler.h"
 #include "core/math/math_funcs.h"
 #include "core/os/os.h"
+#include "servers/audio/audio_mix_kernels.h"
 #include "servers/audio_server.h"
 
 int AudioRBResampler::get_channel_count() const {
@@ -47,62 +48,11 @@ int AudioRBResampler::get_channel_count() const {
 template <int C>
 uint32_t AudioRBResampler::_resample(AudioFrame *p_dest, int p_todo, int32_t p_increment) {
 
-	uint32_t read = offset & MIX_FRAC_MASK;
+	uint32_t read = (offset & MIX_FRAC_MASK) + uint32_t(p_todo) * p_increment;
 
-	for (int i = 0; i < p_todo; i++) {
-
-		offset = (offset + p_increment) & (((1 << (rb_bits + MIX_FRAC_BITS)) - 1));
-		read += p_increment;
-		uint32_t pos = offset >> MIX_FRAC_BITS;
-		float frac = float(offset & MIX_FRAC_MASK) / float(MIX_FRAC_LEN);
-		ERR_FAIL_COND_V(pos >= rb_len, 0);
-		uint32_t pos_next = (pos + 1) & rb_mask;
-
-		// since this is a template with a known compile time value (C), conditionals go away when compiling.
-		if (C == 1) {
-
-			float v0 = rb[pos];
-			float v0n = rb[pos_next];
-			v0 += (v0n - v0) * frac;
-			p_dest[i] = AudioFrame(v0, v0);
-		}
-
-		if (C == 2) {
-
-			float v0 = rb[(pos << 1) + 0];
-			float v1 = rb[(pos << 1) + 1];
-			float v0n = rb[(pos_next << 1) + 0];
-			float v1n = rb[(pos_next << 1) + 1];
-
-			v0 += (v0n - v0) * frac;
-			v1 += (v1n - v1) * frac;
-			p_dest[i] = AudioFrame(v0, v1);
-		}
-
-		// This will probably never be used, but added anyway
-		if (C == 4) {
-
-			float v0 = rb[(pos << 2) + 0];
-			float v1 = rb[(pos << 2) + 1];
-			float v0n = rb[(pos_next << 2) + 0];
-			float v1n = rb[(pos_next << 2) + 1];
-			v0 += (v0n - v0) * frac;
-			v1 += (v1n - v1) * frac;
-			p_dest[i] = AudioFrame(v0, v1);
-		}
-
-		if (C == 6) {
-
-			float v0 = rb[(pos * 6) + 0];
-			float v1 = rb[(pos * 6) + 1];
-			float v0n = rb[(pos_next * 6) + 0];
-			float v1n = rb[(pos_next * 6) + 1];
-
-			v0 += (v0n - v0) * frac;
-			v1 += (v1n - v1) * frac;
-			p_dest[i] = AudioFrame(v0, v1);
-		}
-	}
+	uint32_t new_offset = offset;
+	AudioMixKernels::resample_ring(rb, C, rb_bits, new_offset, p_increment, p_dest, p_todo);
+	offset = new_offset;
 
 	return read >> MIX_FRAC_BITS; //rb_read_pos = offset >> MIX_FRAC_BITS;
 }
@@ -92,6 +92,7 @@ public:
 	virtual String get_stream_name() const = 0;
 
 	virtual float get_length() const = 0; //if supported, otherwise return 0
+	virtual bool has_loop() const { return false; } //if supported, otherwise return false
 };
 
 // Microphone
@@ -174,6 +175,7 @@ public:
 	virtual String get_stream_name() const;
 
 	virtual float get_length() const; //if supported, otherwise return 0
+	virtual bool has_loop() const;
 
 	AudioStreamRandomPitch();
 };
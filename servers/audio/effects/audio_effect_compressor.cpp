@@ -45,7 +45,8 @@ void AudioEffectCompressorInstance::process(const AudioFrame *p_src_frames, Audi
 
 	float makeup = Math::db2linear(base->gain);
 
-	float mix = base->mix;
+	float wet = makeup * base->mix;
+	float dry = 1.0 - base->mix;
 	float gr_meter_decay = exp(1 / (1 * sample_rate));
 
 	const AudioFrame *src = p_src_frames;
@@ -108,10 +109,15 @@ void AudioEffectCompressorInstance::process(const AudioFrame *p_src_frames, Audi
 				gr_meter = 1;
 		}
 
-		p_dst_frames[i] = p_src_frames[i] * grv * makeup * mix + p_src_frames[i] * (1.0 - mix);
+		p_dst_frames[i] = p_src_frames[i] * (grv * wet + dry);
 	}
 }
 
+bool AudioEffectCompressorInstance::reads_other_buses() const {
+
+	return base->sidechain != StringName();
+}
+
 Ref<AudioEffectInstance> AudioEffectCompressor::instance() {
 	Ref<AudioEffectCompressorInstance> ins;
 	ins.instance();
@@ -43,22 +43,14 @@ void AudioEffectEQInstance::process(const AudioFrame *p_src_frames, AudioFrame *
 
 	for (int i = 0; i < p_frame_count; i++) {
 
-		AudioFrame src = p_src_frames[i];
-		AudioFrame dst = AudioFrame(0, 0);
-
-		for (int j = 0; j < band_count; j++) {
-
-			float l = src.l;
-			float r = src.r;
-
-			proc_l[j].process_one(l);
-			proc_r[j].process_one(r);
+		p_dst_frames[i] = AudioFrame(0, 0);
+	}
 
-			dst.l += l * bgain[j];
-			dst.r += r * bgain[j];
-		}
+	//band by band over the whole block, so each band's state is loaded once instead of once per frame
+	for (int j = 0; j < band_count; j++) {
 
-		p_dst_frames[i] = dst;
+		proc_l[j].process_block_add(&p_src_frames[0].l, &p_dst_frames[0].l, p_frame_count, 2, bgain[j]);
+		proc_r[j].process_block_add(&p_src_frames[0].r, &p_dst_frames[0].r, p_frame_count, 2, bgain[j]);
 	}
 }
 
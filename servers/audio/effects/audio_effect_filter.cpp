@@ -35,29 +35,13 @@ template <int S>
 void AudioEffectFilterInstance::_process_filter(const AudioFrame *p_src_frames, AudioFrame *p_dst_frames, int p_frame_count) {
 
 	for (int i = 0; i < p_frame_count; i++) {
-		float f = p_src_frames[i].l;
-		filter_process[0][0].process_one(f);
-		if (S > 1)
-			filter_process[0][1].process_one(f);
-		if (S > 2)
-			filter_process[0][2].process_one(f);
-		if (S > 3)
-			filter_process[0][3].process_one(f);
-
-		p_dst_frames[i].l = f;
+		p_dst_frames[i] = p_src_frames[i];
 	}
 
-	for (int i = 0; i < p_frame_count; i++) {
-		float f = p_src_frames[i].r;
-		filter_process[1][0].process_one(f);
-		if (S > 1)
-			filter_process[1][1].process_one(f);
-		if (S > 2)
-			filter_process[1][2].process_one(f);
-		if (S > 3)
-			filter_process[1][3].process_one(f);
-
-		p_dst_frames[i].r = f;
+	//run each stage over the whole block in place, channels are interleaved in the frames
+	for (int i = 0; i < S; i++) {
+		filter_process[0][i].process(&p_dst_frames[0].l, p_frame_count, 2);
+		filter_process[1][i].process(&p_dst_frames[0].r, p_frame_count, 2);
 	}
 }
 
@@ -63,6 +63,7 @@ public:
 
 	public:
 		inline void process_one(float &p_data);
+		inline void process_block_add(const float *p_src, float *p_dst, int p_count, int p_stride, float p_gain);
 
 		BandProcess();
 	};
@@ -109,4 +110,35 @@ inline void EQ::BandProcess::process_one(float &p_data) {
 	history.b2 = history.b1;
 }
 
+//filters a whole block and adds it to p_dst scaled by p_gain, history and coefficients stay in registers
+inline void EQ::BandProcess::process_block_add(const float *p_src, float *p_dst, int p_count, int p_stride, float p_gain) {
+
+	if (p_count <= 0)
+		return;
+
+	float k1 = c1, k2 = c2, k3 = c3;
+	float a1 = history.a1, a2 = history.a2, a3 = history.a3;
+	float b1 = history.b1, b2 = history.b2, b3 = history.b3;
+
+	for (int i = 0; i < p_count; i++) {
+
+		a1 = p_src[i * p_stride];
+		b1 = k1 * (a1 - a3) + k3 * b2 - k2 * b3;
+
+		p_dst[i * p_stride] += b1 * p_gain;
+
+		a3 = a2;
+		a2 = a1;
+		b3 = b2;
+		b2 = b1;
+	}
+
+	history.a1 = a1;
+	history.a2 = a2;
+	history.a3 = a3;
+	history.b1 = b1;
+	history.b2 = b2;
+	history.b3 = b3;
+}
+
 #endif
@@ -105,18 +105,30 @@ void Reverb::process(float *p_src, float *p_dst, int p_frames) {
 		Comb &c = comb[i];
 
 		int size_limit = c.size - lrintf((float)c.extra_spread_frames * (1.0 - params.extra_spread));
+
+		//keep the comb state in locals, writes through the buffers would otherwise force reloads every frame
+		float *buffer = c.buffer;
+		float feedback = c.feedback;
+		float damp = c.damp;
+		float undamp = 1.0 - c.damp;
+		float damp_h = c.damp_h;
+		int pos = c.pos;
+
 		for (int j = 0; j < p_frames; j++) {
 
-			if (c.pos >= size_limit) //reset this now just in case
-				c.pos = 0;
+			if (pos >= size_limit) //reset this now just in case
+				pos = 0;
 
-			float out = undenormalise(c.buffer[c.pos] * c.feedback);
-			out = out * (1.0 - c.damp) + c.damp_h * c.damp; //lowpass
-			c.damp_h = out;
-			c.buffer[c.pos] = input_buffer[j] + out;
+			float out = undenormalise(buffer[pos] * feedback);
+			out = out * undamp + damp_h * damp; //lowpass
+			damp_h = out;
+			buffer[pos] = input_buffer[j] + out;
 			p_dst[j] += out;
-			c.pos++;
+			pos++;
 		}
+
+		c.damp_h = damp_h;
+		c.pos = pos;
 	}
 
 	static const float allpass_feedback = 0.7;
@@ -159,23 +171,31 @@ void Reverb::process(float *p_src, float *p_dst, int p_frames) {
 		AllPass &a = allpass[i];
 		int size_limit = a.size - lrintf((float)a.extra_spread_frames * (1.0 - params.extra_spread));
 
+		float *buffer = a.buffer;
+		int pos = a.pos;
+
 		for (int j = 0; j < p_frames; j++) {
 
-			if (a.pos >= size_limit)
-				a.pos = 0;
+			if (pos >= size_limit)
+				pos = 0;
 
-			float aux = a.buffer[a.pos];
-			a.buffer[a.pos] = undenormalise(allpass_feedback * aux + p_dst[j]);
-			p_dst[j] = aux - allpass_feedback * a.buffer[a.pos];
-			a.pos++;
+			float aux = buffer[pos];
+			float stored = undenormalise(allpass_feedback * aux + p_dst[j]);
+			buffer[pos] = stored;
+			p_dst[j] = aux - allpass_feedback * stored;
+			pos++;
 		}
+
+		a.pos = pos;
 	}
 
 	static const float wet_scale = 0.6;
+	float wet = params.wet * wet_scale;
+	float dry = params.dry;
 
 	for (int i = 0; i < p_frames; i++) {
 
-		p_dst[i] = p_dst[i] * params.wet * wet_scale + p_src[i] * params.dry;
+		p_dst[i] = p_dst[i] * wet + p_src[i] * dry;
 	}
 }
 
@@ -30,8 +30,10 @@
 
 #include "audio_server.h"
 #include "core/io/resource_loader.h"
+#include "core/os/copymem.h"
 #include "core/os/file_access.h"
 #include "core/os/os.h"
+#include "core/os/trace.h"
 #include "core/project_settings.h"
 #include "scene/resources/audio_stream_sample.h"
 #include "servers/audio/audio_driver_dummy.h"
@@ -222,6 +224,14 @@ AudioDriver *AudioDriverManager::get_driver(int p_driver) {
 
 void AudioServer::_driver_process(int p_frames, int32_t *p_buffer) {
 
+	MemoryTagScope tag_scope(MEMORY_TAG_AUDIO);
+
+	if (null_mode) {
+		// Nothing is listening, hand back silence without mixing any bus.
+		zeromem(p_buffer, sizeof(int32_t) * p_frames * get_channel_count() * 2);
+		return;
+	}
+
 	int todo = p_frames;
 
 #ifdef DEBUG_ENABLED
@@ -295,6 +305,8 @@ void AudioServer::_driver_process(int p_frames, int32_t *p_buffer) {
 
 void AudioServer::_mix_step() {
 
+	TRACE_SCOPE("AudioServer::mix_step");
+
 	bool solo_mode = false;
 
 	for (int i = 0; i < buses.size(); i++) {
@@ -340,133 +352,223 @@ void AudioServer::_mix_step() {
 		E->get().callback(E->get().userdata);
 	}
 
-	for (int i = buses.size() - 1; i >= 0; i--) {
-		//go bus by bus
+	//resolve sends now that every index_cache is up to date
+	int max_mix_level = 0;
+	for (int i = 0; i < buses.size(); i++) {
 		Bus *bus = buses[i];
 
-		for (int k = 0; k < bus->channels.size(); k++) {
+		if (i == 0) {
+			bus->send_index_cache = -1;
+			bus->mix_level = 0;
+			continue;
+		}
 
-			if (bus->channels[k].active && !bus->channels[k].used) {
-				//buffer was not used, but it's still active, so it must be cleaned
-				AudioFrame *buf = bus->channels.write[k].buffer.ptrw();
+		//everything has a send save for master bus
+		bus->send_index_cache = 0;
+		if (bus_map.has(bus->send)) {
+			int send_index = bus_map[bus->send]->index_cache;
+			if (send_index < bus->index_cache) { //otherwise invalid, send to master
+				bus->send_index_cache = send_index;
+			}
+		}
 
-				for (uint32_t j = 0; j < buffer_size; j++) {
+		bus->mix_level = buses[bus->send_index_cache]->mix_level + 1;
+		max_mix_level = MAX(max_mix_level, bus->mix_level);
+	}
 
-					buf[j] = AudioFrame(0, 0);
-				}
-			}
+	mix_solo_mode = solo_mode;
+
+	if (!threaded_bus_mixing) {
+
+		for (int i = buses.size() - 1; i >= 0; i--) {
+			//go bus by bus
+			_mix_bus(buses[i], false);
+			_send_bus(buses[i]);
 		}
 
-		//process effects
-		if (!bus->bypass) {
-			for (int j = 0; j < bus->effects.size(); j++) {
+	} else {
 
-				if (!bus->effects[j].enabled)
-					continue;
+		//buses of a level only send to lower levels, so each level can be mixed in parallel once the deeper ones are done
+		for (int level = max_mix_level; level >= 0; level--) {
 
-#ifdef DEBUG_ENABLED
-				uint64_t ticks = OS::get_singleton()->get_ticks_usec();
-#endif
+			//sized once for all buses, clearing would free the memory on every level
+			mix_level_buses.resize(buses.size());
+			mix_serial_buses.resize(buses.size());
+			int parallel_count = 0;
+			int serial_count = 0;
 
-				for (int k = 0; k < bus->channels.size(); k++) {
+			for (int i = buses.size() - 1; i >= 0; i--) {
+				Bus *bus = buses[i];
+				if (bus->mix_level != level)
+					continue;
 
-					if (!(bus->channels[k].active || bus->channels[k].effect_instances[j]->process_silence()))
-						continue;
-					bus->channels.write[k].effect_instances.write[j]->process(bus->channels[k].buffer.ptr(), temp_buffer.write[k].ptrw(), buffer_size);
+				bool serial = false;
+				if (!bus->bypass) {
+					for (int j = 0; j < bus->effects.size() && !serial; j++) {
+						if (!bus->effects[j].enabled)
+							continue;
+						for (int k = 0; k < bus->channels.size(); k++) {
+							if (bus->channels[k].effect_instances[j]->reads_other_buses()) {
+								serial = true;
+								break;
+							}
+						}
+					}
 				}
 
-				//swap buffers, so internal buffer always has the right data
-				for (int k = 0; k < bus->channels.size(); k++) {
-
-					if (!(buses[i]->channels[k].active || bus->channels[k].effect_instances[j]->process_silence()))
-						continue;
-					SWAP(bus->channels.write[k].buffer, temp_buffer.write[k]);
+				if (serial) {
+					mix_serial_buses.write[serial_count++] = bus;
+				} else {
+					mix_level_buses.write[parallel_count++] = bus;
 				}
+			}
 
-#ifdef DEBUG_ENABLED
-				bus->effects.write[j].prof_time += OS::get_singleton()->get_ticks_usec() - ticks;
-#endif
+			if (parallel_count == 1) {
+				_mix_bus(mix_level_buses[0], false);
+			} else if (parallel_count > 1) {
+				bus_mix_pool.do_work(parallel_count, this, &AudioServer::_mix_bus_job, mix_level_buses.ptrw());
+			}
+
+			for (int i = 0; i < serial_count; i++) {
+				_mix_bus(mix_serial_buses[i], false);
+			}
+
+			//sends write into lower levels only, but several buses may share a target
+			for (int i = 0; i < parallel_count; i++) {
+				_send_bus(mix_level_buses[i]);
+			}
+			for (int i = 0; i < serial_count; i++) {
+				_send_bus(mix_serial_buses[i]);
 			}
 		}
+	}
+
+	mix_frames += buffer_size;
+	to_mix = buffer_size;
+}
 
-		//process send
+void AudioServer::_mix_bus(Bus *p_bus, bool p_own_temp_buffers) {
 
-		Bus *send = NULL;
+	for (int k = 0; k < p_bus->channels.size(); k++) {
 
-		if (i > 0) {
-			//everything has a send save for master bus
-			if (!bus_map.has(bus->send)) {
-				send = buses[0];
-			} else {
-				send = bus_map[bus->send];
-				if (send->index_cache >= bus->index_cache) { //invalid, send to master
-					send = buses[0];
-				}
+		if (p_bus->channels[k].active && !p_bus->channels[k].used) {
+			//buffer was not used, but it's still active, so it must be cleaned
+			AudioFrame *buf = p_bus->channels.write[k].buffer.ptrw();
+
+			for (uint32_t j = 0; j < buffer_size; j++) {
+
+				buf[j] = AudioFrame(0, 0);
 			}
 		}
+	}
 
-		for (int k = 0; k < bus->channels.size(); k++) {
+	//process effects
+	if (!p_bus->bypass) {
+		for (int j = 0; j < p_bus->effects.size(); j++) {
 
-			if (!bus->channels[k].active)
+			if (!p_bus->effects[j].enabled)
 				continue;
 
-			AudioFrame *buf = bus->channels.write[k].buffer.ptrw();
+#ifdef DEBUG_ENABLED
+			uint64_t ticks = OS::get_singleton()->get_ticks_usec();
+#endif
+
+			for (int k = 0; k < p_bus->channels.size(); k++) {
 
-			AudioFrame peak = AudioFrame(0, 0);
+				if (!(p_bus->channels[k].active || p_bus->channels[k].effect_instances[j]->process_silence()))
+					continue;
+				//the shared temp buffers can't be used when several buses are mixed at once, so each channel brings its own
+				Vector<AudioFrame> &temp = p_own_temp_buffers ? p_bus->channels.write[k].temp_buffer : temp_buffer.write[k];
+				p_bus->channels.write[k].effect_instances.write[j]->process(p_bus->channels[k].buffer.ptr(), temp.ptrw(), buffer_size);
+			}
 
-			float volume = Math::db2linear(bus->volume_db);
+			//swap buffers, so internal buffer always has the right data
+			for (int k = 0; k < p_bus->channels.size(); k++) {
 
-			if (solo_mode) {
-				if (!bus->soloed) {
-					volume = 0.0;
-				}
-			} else {
-				if (bus->mute) {
-					volume = 0.0;
-				}
+				if (!(p_bus->channels[k].active || p_bus->channels[k].effect_instances[j]->process_silence()))
+					continue;
+				Vector<AudioFrame> &temp = p_own_temp_buffers ? p_bus->channels.write[k].temp_buffer : temp_buffer.write[k];
+				SWAP(p_bus->channels.write[k].buffer, temp);
 			}
 
-			//apply volume and compute peak
-			for (uint32_t j = 0; j < buffer_size; j++) {
+#ifdef DEBUG_ENABLED
+			p_bus->effects.write[j].prof_time += OS::get_singleton()->get_ticks_usec() - ticks;
+#endif
+		}
+	}
 
-				buf[j] *= volume;
+	for (int k = 0; k < p_bus->channels.size(); k++) {
 
-				float l = ABS(buf[j].l);
-				if (l > peak.l) {
-					peak.l = l;
-				}
-				float r = ABS(buf[j].r);
-				if (r > peak.r) {
-					peak.r = r;
-				}
+		if (!p_bus->channels[k].active)
+			continue;
+
+		AudioFrame *buf = p_bus->channels.write[k].buffer.ptrw();
+
+		AudioFrame peak = AudioFrame(0, 0);
+
+		float volume = Math::db2linear(p_bus->volume_db);
+
+		if (mix_solo_mode) {
+			if (!p_bus->soloed) {
+				volume = 0.0;
+			}
+		} else {
+			if (p_bus->mute) {
+				volume = 0.0;
 			}
+		}
 
-			bus->channels.write[k].peak_volume = AudioFrame(Math::linear2db(peak.l + 0.0000000001), Math::linear2db(peak.r + 0.0000000001));
+		//apply volume and compute peak
+		for (uint32_t j = 0; j < buffer_size; j++) {
 
-			if (!bus->channels[k].used) {
-				//see if any audio is contained, because channel was not used
+			buf[j] *= volume;
 
-				if (MAX(peak.r, peak.l) > Math::db2linear(channel_disable_threshold_db)) {
-					bus->channels.write[k].last_mix_with_audio = mix_frames;
-				} else if (mix_frames - bus->channels[k].last_mix_with_audio > channel_disable_frames) {
-					bus->channels.write[k].active = false;
-					continue; //went inactive, don't mix.
-				}
+			float l = ABS(buf[j].l);
+			if (l > peak.l) {
+				peak.l = l;
+			}
+			float r = ABS(buf[j].r);
+			if (r > peak.r) {
+				peak.r = r;
 			}
+		}
 
-			if (send) {
-				//if not master bus, send
-				AudioFrame *target_buf = thread_get_channel_mix_buffer(send->index_cache, k);
+		p_bus->channels.write[k].peak_volume = AudioFrame(Math::linear2db(peak.l + 0.0000000001), Math::linear2db(peak.r + 0.0000000001));
 
-				for (uint32_t j = 0; j < buffer_size; j++) {
-					target_buf[j] += buf[j];
-				}
+		if (!p_bus->channels[k].used) {
+			//see if any audio is contained, because channel was not used
+
+			if (MAX(peak.r, peak.l) > Math::db2linear(channel_disable_threshold_db)) {
+				p_bus->channels.write[k].last_mix_with_audio = mix_frames;
+			} else if (mix_frames - p_bus->channels[k].last_mix_with_audio > channel_disable_frames) {
+				p_bus->channels.write[k].active = false; //went inactive, don't mix.
 			}
 		}
 	}
+}
 
-	mix_frames += buffer_size;
-	to_mix = buffer_size;
+void AudioServer::_mix_bus_job(uint32_t p_index, Bus **p_buses) {
+
+	_mix_bus(p_buses[p_index], true);
+}
+
+void AudioServer::_send_bus(Bus *p_bus) {
+
+	if (p_bus->send_index_cache < 0)
+		return; //master bus
+
+	for (int k = 0; k < p_bus->channels.size(); k++) {
+
+		if (!p_bus->channels[k].active)
+			continue;
+
+		const AudioFrame *buf = p_bus->channels[k].buffer.ptr();
+		AudioFrame *target_buf = thread_get_channel_mix_buffer(p_bus->send_index_cache, k);
+
+		for (uint32_t j = 0; j < buffer_size; j++) {
+			target_buf[j] += buf[j];
+		}
+	}
 }
 
 bool AudioServer::thread_has_channel_mix_buffer(int p_bus, int p_buffer) const {
@@ -556,6 +658,7 @@ void AudioServer::set_bus_count(int p_count) {
 		buses.write[i]->channels.resize(channel_count);
 		for (int j = 0; j < channel_count; j++) {
 			buses.write[i]->channels.write[j].buffer.resize(buffer_size);
+			buses.write[i]->channels.write[j].temp_buffer.resize(threaded_bus_mixing ? buffer_size : 0);
 		}
 		buses[i]->name = attempt;
 		buses[i]->solo = false;
@@ -628,6 +731,7 @@ void AudioServer::add_bus(int p_at_pos) {
 	bus->channels.resize(channel_count);
 	for (int j = 0; j < channel_count; j++) {
 		bus->channels.write[j].buffer.resize(buffer_size);
+		bus->channels.write[j].temp_buffer.resize(threaded_bus_mixing ? buffer_size : 0);
 	}
 	bus->name = attempt;
 	bus->solo = false;
@@ -949,6 +1053,7 @@ void AudioServer::init_channels_and_buffers() {
 		buses[i]->channels.resize(channel_count);
 		for (int j = 0; j < channel_count; j++) {
 			buses.write[i]->channels.write[j].buffer.resize(buffer_size);
+			buses.write[i]->channels.write[j].temp_buffer.resize(threaded_bus_mixing ? buffer_size : 0);
 		}
 	}
 }
@@ -960,6 +1065,13 @@ void AudioServer::init() {
 	ProjectSettings::get_singleton()->set_custom_property_info("audio/channel_disable_time", PropertyInfo(Variant::REAL, "audio/channel_disable_time", PROPERTY_HINT_RANGE, "0,5,0.01,or_greater"));
 	buffer_size = 1024; //hardcoded for now
 
+#ifndef NO_THREADS
+	threaded_bus_mixing = GLOBAL_DEF_RST("audio/threaded_bus_mixing", false);
+	if (threaded_bus_mixing) {
+		bus_mix_pool.init();
+	}
+#endif
+
 	init_channels_and_buffers();
 
 	mix_count = 0;
@@ -1045,6 +1157,9 @@ void AudioServer::update() {
 
 void AudioServer::load_default_bus_layout() {
 
+	if (null_mode)
+		return;
+
 	if (ResourceLoader::exists("res://default_bus_layout.tres")) {
 		Ref<AudioBusLayout> default_layout = ResourceLoader::load("res://default_bus_layout.tres");
 		if (default_layout.is_valid()) {
@@ -1053,6 +1168,13 @@ void AudioServer::load_default_bus_layout() {
 	}
 }
 
+void AudioServer::set_null_mode(bool p_enable) {
+
+	lock();
+	null_mode = p_enable;
+	unlock();
+}
+
 void AudioServer::finish() {
 
 	for (int i = 0; i < AudioDriverManager::get_driver_count(); i++) {
@@ -1064,6 +1186,11 @@ void AudioServer::finish() {
 	}
 
 	buses.clear();
+
+	if (bus_mix_pool.is_initialized()) {
+		bus_mix_pool.finish();
+	}
+	threaded_bus_mixing = false;
 }
 
 /* MISC config */
@@ -1228,6 +1355,7 @@ void AudioServer::set_bus_layout(const Ref<AudioBusLayout> &p_bus_layout) {
 		buses[i]->channels.resize(channel_count);
 		for (int j = 0; j < channel_count; j++) {
 			buses.write[i]->channels.write[j].buffer.resize(buffer_size);
+			buses.write[i]->channels.write[j].temp_buffer.resize(threaded_bus_mixing ? buffer_size : 0);
 		}
 		_update_bus_effects(i);
 	}
@@ -1371,6 +1499,9 @@ AudioServer::AudioServer() {
 	to_mix = 0;
 	output_latency = 0;
 	output_latency_ticks = 0;
+	threaded_bus_mixing = false;
+	mix_solo_mode = false;
+	null_mode = false;
 #ifdef DEBUG_ENABLED
 	prof_time = 0;
 #endif
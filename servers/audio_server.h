@@ -34,6 +34,7 @@
 #include "core/math/audio_frame.h"
 #include "core/object.h"
 #include "core/os/os.h"
+#include "core/os/thread_work_pool.h"
 #include "core/variant.h"
 #include "servers/audio/audio_effect.h"
 
@@ -191,6 +192,7 @@ private:
 			bool active;
 			AudioFrame peak_volume;
 			Vector<AudioFrame> buffer;
+			Vector<AudioFrame> temp_buffer; //only allocated when buses are mixed in parallel
 			Vector<Ref<AudioEffectInstance> > effect_instances;
 			uint64_t last_mix_with_audio;
 			Channel() {
@@ -215,6 +217,8 @@ private:
 		float volume_db;
 		StringName send;
 		int index_cache;
+		int send_index_cache;
+		int mix_level; //distance to master through sends, buses of the same level never send to each other
 	};
 
 	Vector<Vector<AudioFrame> > temp_buffer; //temp_buffer for each level
@@ -223,6 +227,17 @@ private:
 
 	void _update_bus_effects(int p_bus);
 
+	ThreadWorkPool bus_mix_pool;
+	bool threaded_bus_mixing;
+	bool mix_solo_mode;
+	bool null_mode;
+	Vector<Bus *> mix_level_buses;
+	Vector<Bus *> mix_serial_buses;
+
+	void _mix_bus(Bus *p_bus, bool p_own_temp_buffers);
+	void _mix_bus_job(uint32_t p_index, Bus **p_buses);
+	void _send_bus(Bus *p_bus);
+
 	static AudioServer *singleton;
 
 	// TODO create an audiodata pool to optimize memory
@@ -377,6 +392,10 @@ public:
 	void capture_set_device(const String &p_name);
 
 	float get_output_latency() { return output_latency; }
+
+	void set_null_mode(bool p_enable);
+	bool is_null_mode() const { return null_mode; }
+
 	AudioServer();
 	virtual ~AudioServer();
 };
@@ -46,6 +46,7 @@ class AreaPairSW : public ConstraintSW {
 public:
 	bool setup(real_t p_step);
 	void solve(real_t p_step);
+	bool is_setup_thread_safe() const { return false; } // updates area queries
 
 	AreaPairSW(BodySW *p_body, int p_body_shape, AreaSW *p_area, int p_area_shape);
 	~AreaPairSW();
@@ -62,6 +63,7 @@ class Area2PairSW : public ConstraintSW {
 public:
 	bool setup(real_t p_step);
 	void solve(real_t p_step);
+	bool is_setup_thread_safe() const { return false; } // updates area queries
 
 	Area2PairSW(AreaSW *p_area_a, int p_shape_a, AreaSW *p_area_b, int p_shape_b);
 	~Area2PairSW();
@@ -186,20 +186,27 @@ void AreaSW::call_queries() {
 			return;
 		}
 
-		for (Map<BodyKey, BodyState>::Element *E = monitored_bodies.front(); E; E = E->next()) {
+		monitor_query_work.swap(monitored_bodies);
 
-			if (E->get().state == 0)
+		for (int i = 0; i < monitor_query_work.size(); i++) {
+
+			const BodyKey &key = monitor_query_work.getk(i);
+			const BodyState &state = monitor_query_work.getv(i);
+
+			if (state.state == 0)
 				continue; //nothing happened
 
-			res[0] = E->get().state > 0 ? PhysicsServer::AREA_BODY_ADDED : PhysicsServer::AREA_BODY_REMOVED;
-			res[1] = E->key().rid;
-			res[2] = E->key().instance_id;
-			res[3] = E->key().body_shape;
-			res[4] = E->key().area_shape;
+			res[0] = state.state > 0 ? PhysicsServer::AREA_BODY_ADDED : PhysicsServer::AREA_BODY_REMOVED;
+			res[1] = key.rid;
+			res[2] = key.instance_id;
+			res[3] = key.body_shape;
+			res[4] = key.area_shape;
 
 			Variant::CallError ce;
 			obj->call(monitor_callback_method, (const Variant **)resptr, 5, ce);
 		}
+
+		monitor_query_work.clear();
 	}
 
 	monitored_bodies.clear();
@@ -218,20 +225,27 @@ void AreaSW::call_queries() {
 			return;
 		}
 
-		for (Map<BodyKey, BodyState>::Element *E = monitored_areas.front(); E; E = E->next()) {
+		monitor_query_work.swap(monitored_areas);
 
-			if (E->get().state == 0)
+		for (int i = 0; i < monitor_query_work.size(); i++) {
+
+			const BodyKey &key = monitor_query_work.getk(i);
+			const BodyState &state = monitor_query_work.getv(i);
+
+			if (state.state == 0)
 				continue; //nothing happened
 
-			res[0] = E->get().state > 0 ? PhysicsServer::AREA_BODY_ADDED : PhysicsServer::AREA_BODY_REMOVED;
-			res[1] = E->key().rid;
-			res[2] = E->key().instance_id;
-			res[3] = E->key().body_shape;
-			res[4] = E->key().area_shape;
+			res[0] = state.state > 0 ? PhysicsServer::AREA_BODY_ADDED : PhysicsServer::AREA_BODY_REMOVED;
+			res[1] = key.rid;
+			res[2] = key.instance_id;
+			res[3] = key.body_shape;
+			res[4] = key.area_shape;
 
 			Variant::CallError ce;
 			obj->call(area_monitor_callback_method, (const Variant **)resptr, 5, ce);
 		}
+
+		monitor_query_work.clear();
 	}
 
 	monitored_areas.clear();
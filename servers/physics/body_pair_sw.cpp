@@ -78,6 +78,7 @@ void BodyPairSW::contact_added_callback(const Vector3 &p_point_A, const Vector3
 	contact.local_A = local_A;
 	contact.local_B = local_B;
 	contact.normal = (p_point_A - p_point_B).normalized();
+	contact.local_normal = A->get_inv_transform().basis.xform(contact.normal);
 	contact.mass_normal = 0; // will be computed in setup()
 
 	// attempt to determine if the contact will be reused
@@ -169,44 +170,190 @@ void BodyPairSW::validate_contacts() {
 	}
 }
 
+// Motion of a body over a step for continuous collision detection, a linear
+// motion plus a rotation around its center of mass.
+struct _CCDMotionSW {
+
+	Transform xform;
+	Vector3 center;
+	Vector3 linear;
+	Vector3 angular_axis;
+	real_t angular_speed;
+	real_t radius; // no point of the shape is further away from the center
+
+	Transform get_xform(real_t p_time) const {
+
+		Transform xf = xform;
+		if (angular_speed > CMP_EPSILON) {
+			Basis rot(angular_axis, angular_speed * p_time);
+			xf.basis = rot * xf.basis;
+			xf.origin = center + rot.xform(xf.origin - center);
+		}
+		xf.origin += linear * p_time;
+		return xf;
+	}
+};
+
+// Conservative advancement: the distance to B divided by the fastest any point
+// of A can approach it is a time A can move without touching B, so A is moved
+// by that much until it is within the tolerance.
+static bool _ccd_time_of_impact(const ShapeSW *p_shape_A, const _CCDMotionSW &p_motion, const ShapeSW *p_shape_B, const Transform &p_xform_B, real_t p_max_time, real_t p_tolerance, real_t &r_time) {
+
+	real_t time = 0;
+
+	for (int i = 0; i < 16; i++) {
+
+		Vector3 point_A, point_B;
+		if (!CollisionSolverSW::solve_distance(p_shape_A, p_motion.get_xform(time), p_shape_B, p_xform_B, point_A, point_B, AABB())) {
+			if (i == 0)
+				return false; // already overlapping, the regular test handles it
+			break;
+		}
+
+		Vector3 normal = point_B - point_A;
+		real_t distance = normal.length();
+		if (distance < p_tolerance) {
+			if (i == 0)
+				return false; // already touching
+			break;
+		}
+		normal /= distance;
+
+		real_t speed = p_motion.linear.dot(normal) + p_motion.angular_speed * p_motion.radius;
+		if (speed <= CMP_EPSILON)
+			return false; // moving away
+
+		time += (distance - p_tolerance * 0.5) / speed;
+		if (time > p_max_time)
+			return false;
+	}
+
+	r_time = time;
+	return true;
+}
+
+struct _CCDConcaveInfoSW {
+
+	const ShapeSW *shape_A;
+	const _CCDMotionSW *motion;
+	const Transform *xform_B;
+	real_t tolerance;
+	real_t time;
+	bool hit;
+};
+
+static void _ccd_concave_callback(void *p_userdata, ShapeSW *p_convex) {
+
+	_CCDConcaveInfoSW &info = *(_CCDConcaveInfoSW *)p_userdata;
+
+	real_t time;
+	if (_ccd_time_of_impact(info.shape_A, *info.motion, p_convex, *info.xform_B, info.time, info.tolerance, time)) {
+		info.time = time;
+		info.hit = true;
+	}
+}
+
 bool BodyPairSW::_test_ccd(real_t p_step, BodySW *p_A, int p_shape_A, const Transform &p_xform_A, BodySW *p_B, int p_shape_B, const Transform &p_xform_B) {
 
-	Vector3 motion = p_A->get_linear_velocity() * p_step;
-	real_t mlen = motion.length();
-	if (mlen < CMP_EPSILON)
+	const ShapeSW *shape_A = p_A->get_shape(p_shape_A);
+	const ShapeSW *shape_B = p_B->get_shape(p_shape_B);
+
+	if (shape_A->is_concave() || shape_A->get_type() == PhysicsServer::SHAPE_PLANE)
 		return false;
 
-	Vector3 mnormal = motion / mlen;
+	// transforms are relative to the origin of the pair's A
+	_CCDMotionSW motion;
+	motion.xform = p_xform_A;
+	motion.center = p_A->get_transform().origin - A->get_transform().origin + p_A->get_center_of_mass();
+	motion.linear = p_A->get_linear_velocity() - p_B->get_linear_velocity();
+	motion.angular_speed = p_A->get_angular_velocity().length();
+	motion.angular_axis = motion.angular_speed > CMP_EPSILON ? p_A->get_angular_velocity() / motion.angular_speed : Vector3();
+
+	AABB aabb = p_xform_A.xform(shape_A->get_aabb());
+	motion.radius = 0;
+	for (int i = 0; i < 8; i++) {
+		Vector3 corner;
+		aabb.get_edge(i, corner, corner);
+		motion.radius = MAX(motion.radius, corner.distance_to(motion.center));
+	}
+
+	real_t mlen = motion.linear.length() * p_step;
+	real_t max_motion = mlen + motion.angular_speed * p_step * motion.radius;
+	if (max_motion < CMP_EPSILON)
+		return false;
 
-	real_t min, max;
-	p_A->get_shape(p_shape_A)->project_range(mnormal, p_xform_A, min, max);
-	bool fast_object = mlen > (max - min) * 0.3; //going too fast in that direction
+	real_t threshold = p_A->get_ccd_motion_threshold();
+	if (threshold <= 0) {
+		//did it move enough to even attempt it? let's say it should move more than 1/3 the size of the object along its motion
+		if (mlen > CMP_EPSILON) {
+			real_t min, max;
+			shape_A->project_range(motion.linear.normalized(), p_xform_A, min, max);
+			threshold = (max - min) * 0.3;
+		} else {
+			threshold = motion.radius * 0.6;
+		}
+	}
 
-	if (!fast_object) { //did it move enough in this direction to even attempt raycast? let's say it should move more than 1/3 the size of the object in that axis
+	if (max_motion <= threshold)
 		return false;
+
+	real_t tolerance = MAX(space->get_contact_max_allowed_penetration(), CMP_EPSILON);
+	real_t time = p_step;
+	bool hit = false;
+
+	if (shape_B->is_concave()) {
+
+		// every point of A stays within its radius of the path of the center
+		AABB swept(motion.center - Vector3(motion.radius, motion.radius, motion.radius), Vector3(motion.radius, motion.radius, motion.radius) * 2.0);
+		AABB end = swept;
+		end.position += motion.linear * p_step;
+		swept.merge_with(end);
+
+		_CCDConcaveInfoSW info;
+		info.shape_A = shape_A;
+		info.motion = &motion;
+		info.xform_B = &p_xform_B;
+		info.tolerance = tolerance;
+		info.time = time;
+		info.hit = false;
+
+		static_cast<const ConcaveShapeSW *>(shape_B)->cull(p_xform_B.affine_inverse().xform(swept), _ccd_concave_callback, &info);
+		hit = info.hit;
+		time = info.time;
+	} else {
+		hit = _ccd_time_of_impact(shape_A, motion, shape_B, p_xform_B, p_step, tolerance, time);
 	}
 
-	//cast a segment from support in motion normal, in the same direction of motion by motion length
-	//support is the worst case collision point, so real collision happened before
-	Vector3 s = p_A->get_shape(p_shape_A)->get_support(p_xform_A.basis.xform(mnormal).normalized());
-	Vector3 from = p_xform_A.xform(s);
-	Vector3 to = from + motion;
+	if (!hit)
+		return false;
 
-	Transform from_inv = p_xform_B.affine_inverse();
+	//slow it down so it stops right before the impact, next step will hit softly or soft enough
+	real_t scale = time / p_step;
+	p_A->set_linear_velocity(p_B->get_linear_velocity() + motion.linear * scale);
+	p_A->set_angular_velocity(p_A->get_angular_velocity() * scale);
 
-	Vector3 local_from = from_inv.xform(from - mnormal * mlen * 0.1); //start from a little inside the bounding box
-	Vector3 local_to = from_inv.xform(to);
+	return true;
+}
+
+bool BodyPairSW::_can_reuse_contacts(const ShapeSW *p_shape_A, const ShapeSW *p_shape_B, const Transform &p_relative_xform) const {
 
-	Vector3 rpos, rnorm;
-	if (!p_B->get_shape(p_shape_B)->intersect_segment(local_from, local_to, rpos, rnorm)) {
+	real_t threshold = space->get_contact_cache_threshold();
+	if (threshold <= 0 || !collided || contact_count == 0 || cached_steps >= MAX_CACHED_STEPS)
 		return false;
-	}
 
-	//shorten the linear velocity so it does not hit, but gets close enough, next frame will hit softly or soft enough
-	Vector3 hitpos = p_xform_B.xform(rpos);
+	if (p_shape_A != cached_shape_A || p_shape_B != cached_shape_B)
+		return false;
 
-	real_t newlen = hitpos.distance_to(from) - (max - min) * 0.01;
-	p_A->set_linear_velocity((mnormal * newlen) / p_step);
+	if (p_relative_xform.origin.distance_squared_to(cached_xform.origin) > threshold * threshold)
+		return false;
+
+	// For small rotations the change of each basis element is about the angle rotated.
+	for (int i = 0; i < 3; i++) {
+		for (int j = 0; j < 3; j++) {
+			if (Math::abs(p_relative_xform.basis[i][j] - cached_xform.basis[i][j]) > threshold)
+				return false;
+		}
+	}
 
 	return true;
 }
@@ -247,12 +394,32 @@ bool BodyPairSW::setup(real_t p_step) {
 	ShapeSW *shape_A_ptr = A->get_shape(shape_A);
 	ShapeSW *shape_B_ptr = B->get_shape(shape_B);
 
-	bool collided = CollisionSolverSW::solve_static(shape_A_ptr, xform_A, shape_B_ptr, xform_B, _contact_added_callback, this, &sep_axis);
+	// Bodies resting on each other barely move relative to each other, their
+	// contacts (stored relative to each body) stay valid without a new test.
+	Transform relative_xform = xform_A.affine_inverse() * xform_B;
+	bool collided;
+
+	if (_can_reuse_contacts(shape_A_ptr, shape_B_ptr, relative_xform)) {
+
+		collided = true;
+		cached_steps++;
+
+		for (int i = 0; i < contact_count; i++) {
+			contacts[i].normal = xform_Au.basis.xform(contacts[i].local_normal).normalized();
+		}
+	} else {
+
+		collided = CollisionSolverSW::solve_static(shape_A_ptr, xform_A, shape_B_ptr, xform_B, _contact_added_callback, this, &sep_axis);
+		cached_xform = relative_xform;
+		cached_shape_A = shape_A_ptr;
+		cached_shape_B = shape_B_ptr;
+		cached_steps = 0;
+	}
 	this->collided = collided;
 
 	if (!collided) {
 
-		//test ccd (currently just a raycast)
+		//test ccd
 
 		if (A->is_continuous_collision_detection_enabled() && A->get_mode() > PhysicsServer::BODY_MODE_KINEMATIC && B->get_mode() <= PhysicsServer::BODY_MODE_KINEMATIC) {
 			_test_ccd(p_step, A, shape_A, xform_A, B, shape_B, xform_B);
@@ -353,6 +520,17 @@ bool BodyPairSW::setup(real_t p_step) {
 	return true;
 }
 
+bool BodyPairSW::is_setup_thread_safe() const {
+
+	//static and kinematic bodies can be part of several islands, contacts can't be reported to them concurrently
+	if (A->get_mode() <= PhysicsServer::BODY_MODE_KINEMATIC && A->can_report_contacts())
+		return false;
+	if (B->get_mode() <= PhysicsServer::BODY_MODE_KINEMATIC && B->can_report_contacts())
+		return false;
+
+	return true;
+}
+
 void BodyPairSW::solve(real_t p_step) {
 
 	if (!collided)
@@ -486,6 +664,9 @@ BodyPairSW::BodyPairSW(BodySW *p_A, int p_shape_A, BodySW *p_B, int p_shape_B) :
 	B->add_constraint(this, 1);
 	contact_count = 0;
 	collided = false;
+	cached_shape_A = NULL;
+	cached_shape_B = NULL;
+	cached_steps = 0;
 }
 
 BodyPairSW::~BodyPairSW() {
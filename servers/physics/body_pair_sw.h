@@ -37,7 +37,9 @@
 class BodyPairSW : public ConstraintSW {
 	enum {
 
-		MAX_CONTACTS = 4
+		MAX_CONTACTS = 4,
+		// Cached contacts are refreshed at least this often, so changes to the shapes themselves are picked up.
+		MAX_CACHED_STEPS = 8
 	};
 
 	union {
@@ -56,6 +58,7 @@ class BodyPairSW : public ConstraintSW {
 
 		Vector3 position;
 		Vector3 normal;
+		Vector3 local_normal; // normal in A's orientation, used when the collision test is skipped
 		Vector3 local_A, local_B;
 		real_t acc_normal_impulse; // accumulated normal impulse (Pn)
 		Vector3 acc_tangent_impulse; // accumulated tangent impulse (Pt)
@@ -77,6 +80,14 @@ class BodyPairSW : public ConstraintSW {
 	int contact_count;
 	bool collided;
 
+	// Relative transform of the shapes at the last collision test, see SpaceSW::get_contact_cache_threshold().
+	Transform cached_xform;
+	const ShapeSW *cached_shape_A;
+	const ShapeSW *cached_shape_B;
+	int cached_steps;
+
+	bool _can_reuse_contacts(const ShapeSW *p_shape_A, const ShapeSW *p_shape_B, const Transform &p_relative_xform) const;
+
 	static void _contact_added_callback(const Vector3 &p_point_A, const Vector3 &p_point_B, void *p_userdata);
 
 	void contact_added_callback(const Vector3 &p_point_A, const Vector3 &p_point_B);
@@ -89,6 +100,7 @@ class BodyPairSW : public ConstraintSW {
 public:
 	bool setup(real_t p_step);
 	void solve(real_t p_step);
+	bool is_setup_thread_safe() const;
 
 	BodyPairSW(BodySW *p_A, int p_shape_A, BodySW *p_B, int p_shape_B);
 	~BodyPairSW();
@@ -196,6 +196,10 @@ void BodySW::set_param(PhysicsServer::BodyParameter p_param, real_t p_value) {
 
 			angular_damp = p_value;
 		} break;
+		case PhysicsServer::BODY_PARAM_CCD_MOTION_THRESHOLD: {
+
+			ccd_motion_threshold = p_value;
+		} break;
 		default: {}
 	}
 }
@@ -225,6 +229,10 @@ real_t BodySW::get_param(PhysicsServer::BodyParameter p_param) const {
 
 			return angular_damp;
 		} break;
+		case PhysicsServer::BODY_PARAM_CCD_MOTION_THRESHOLD: {
+
+			return ccd_motion_threshold;
+		} break;
 
 		default: {}
 	}
@@ -268,6 +276,8 @@ void BodySW::set_mode(PhysicsServer::BodyMode p_mode) {
 	}
 
 	_update_inertia();
+	if (get_space())
+		get_space()->invalidate_islands(); //static and kinematic bodies split islands
 	/*
 	if (get_space())
 		_update_queries();
@@ -379,16 +389,34 @@ Variant BodySW::get_state(PhysicsServer::BodyState p_state) const {
 	return Variant();
 }
 
+void BodySW::add_constraint(ConstraintSW *p_constraint, int p_pos) {
+
+	constraint_map[p_constraint] = p_pos;
+	if (get_space())
+		get_space()->invalidate_islands();
+}
+
+void BodySW::remove_constraint(ConstraintSW *p_constraint) {
+
+	constraint_map.erase(p_constraint);
+	if (get_space())
+		get_space()->invalidate_islands();
+}
+
 void BodySW::set_space(SpaceSW *p_space) {
 
 	if (get_space()) {
 
+		get_space()->invalidate_islands();
+
 		if (inertia_update_list.in_list())
 			get_space()->body_remove_from_inertia_update_list(&inertia_update_list);
 		if (active_list.in_list())
 			get_space()->body_remove_from_active_list(&active_list);
 		if (direct_state_query_list.in_list())
 			get_space()->body_remove_from_state_query_list(&direct_state_query_list);
+		if (history_list.in_list())
+			get_space()->body_remove_from_history_list(&history_list);
 	}
 
 	_set_space(p_space);
@@ -396,8 +424,11 @@ void BodySW::set_space(SpaceSW *p_space) {
 	if (get_space()) {
 
 		_update_inertia();
+		get_space()->invalidate_islands();
 		if (active)
 			get_space()->body_add_to_active_list(&active_list);
+		if (record_history)
+			get_space()->body_add_to_history_list(&history_list);
 		/*
 		_update_queries();
 		if (is_active()) {
@@ -625,7 +656,9 @@ void BodySW::integrate_velocities(real_t p_step) {
 
 	transform.origin += total_linear_velocity * p_step;
 
-	_set_transform(transform);
+	// a body resting in place keeps its broadphase entries, moving them would re-test all pairs
+	bool moved = ang_vel != 0.0 || total_linear_velocity != Vector3();
+	_set_transform(transform, moved || continuous_cd);
 	_set_inv_transform(get_transform().inverse());
 
 	_update_transform_dependant();
@@ -753,6 +786,28 @@ void BodySW::set_force_integration_callback(ObjectID p_id, const StringName &p_m
 	}
 }
 
+void BodySW::set_record_history(bool p_enable) {
+
+	if (record_history == p_enable)
+		return;
+
+	record_history = p_enable;
+
+	if (!get_space())
+		return;
+
+	if (record_history)
+		get_space()->body_add_to_history_list(&history_list);
+	else
+		get_space()->body_remove_from_history_list(&history_list);
+}
+
+void BodySW::reset_history(int p_size, uint64_t p_start_tick) {
+
+	history.resize(p_size);
+	history_start = p_start_tick;
+}
+
 void BodySW::set_kinematic_margin(real_t p_margin) {
 	kinematic_safe_margin = p_margin;
 }
@@ -762,7 +817,8 @@ BodySW::BodySW() :
 		locked_axis(0),
 		active_list(this),
 		inertia_update_list(this),
-		direct_state_query_list(this) {
+		direct_state_query_list(this),
+		history_list(this) {
 
 	mode = PhysicsServer::BODY_MODE_RIGID;
 	active = true;
@@ -774,6 +830,8 @@ BodySW::BodySW() :
 	bounce = 0;
 	friction = 1;
 	omit_force_integration = false;
+	history_start = 0;
+	record_history = false;
 	//applied_torque=0;
 	island_step = 0;
 	island_next = NULL;
@@ -791,6 +849,7 @@ BodySW::BodySW() :
 
 	still_time = 0;
 	continuous_cd = false;
+	ccd_motion_threshold = 0;
 	can_sleep = false;
 	fi_callback = NULL;
 }
@@ -33,6 +33,7 @@
 
 #include "area_sw.h"
 #include "collision_object_sw.h"
+#include "core/local_vector.h"
 #include "core/vset.h"
 
 class ConstraintSW;
@@ -82,6 +83,12 @@ class BodySW : public CollisionObjectSW {
 	SelfList<BodySW> active_list;
 	SelfList<BodySW> inertia_update_list;
 	SelfList<BodySW> direct_state_query_list;
+	SelfList<BodySW> history_list;
+
+	// Transforms of the last ticks for queries in the past, indexed by tick modulo size.
+	Vector<Transform> history;
+	uint64_t history_start;
+	bool record_history;
 
 	VSet<RID> exceptions;
 	bool omit_force_integration;
@@ -90,6 +97,7 @@ class BodySW : public CollisionObjectSW {
 	bool first_integration;
 
 	bool continuous_cd;
+	real_t ccd_motion_threshold;
 	bool can_sleep;
 	bool first_time_kinematic;
 	void _update_inertia();
@@ -126,7 +134,7 @@ class BodySW : public CollisionObjectSW {
 		Vector3 collider_velocity_at_pos;
 	};
 
-	Vector<Contact> contacts; //no contacts by default
+	LocalVector<Contact> contacts; //no contacts by default
 	int contact_count;
 
 	struct ForceIntegrationCallback {
@@ -196,12 +204,27 @@ public:
 	_FORCE_INLINE_ BodySW *get_island_list_next() const { return island_list_next; }
 	_FORCE_INLINE_ void set_island_list_next(BodySW *p_next) { island_list_next = p_next; }
 
-	_FORCE_INLINE_ void add_constraint(ConstraintSW *p_constraint, int p_pos) { constraint_map[p_constraint] = p_pos; }
-	_FORCE_INLINE_ void remove_constraint(ConstraintSW *p_constraint) { constraint_map.erase(p_constraint); }
+	void add_constraint(ConstraintSW *p_constraint, int p_pos);
+	void remove_constraint(ConstraintSW *p_constraint);
 	const Map<ConstraintSW *, int> &get_constraint_map() const { return constraint_map; }
 	_FORCE_INLINE_ void clear_constraint_map() { constraint_map.clear(); }
 
 	_FORCE_INLINE_ void set_omit_force_integration(bool p_omit_force_integration) { omit_force_integration = p_omit_force_integration; }
+
+	void set_record_history(bool p_enable);
+	_FORCE_INLINE_ bool is_recording_history() const { return record_history; }
+
+	void reset_history(int p_size, uint64_t p_start_tick);
+	_FORCE_INLINE_ void store_history(uint64_t p_tick) {
+		if (history.size())
+			history.write[p_tick % history.size()] = get_transform();
+	}
+	_FORCE_INLINE_ bool get_history_transform(uint64_t p_tick, uint64_t p_current_tick, Transform &r_transform) const {
+		if (history.empty() || p_tick < history_start || p_tick > p_current_tick || p_current_tick - p_tick >= (uint64_t)history.size())
+			return false;
+		r_transform = history[p_tick % history.size()];
+		return true;
+	}
 	_FORCE_INLINE_ bool get_omit_force_integration() const { return omit_force_integration; }
 
 	_FORCE_INLINE_ Basis get_principal_inertia_axes() const { return principal_inertia_axes; }
@@ -290,6 +313,7 @@ public:
 
 	_FORCE_INLINE_ void set_continuous_collision_detection(bool p_enable) { continuous_cd = p_enable; }
 	_FORCE_INLINE_ bool is_continuous_collision_detection_enabled() const { return continuous_cd; }
+	_FORCE_INLINE_ real_t get_ccd_motion_threshold() const { return ccd_motion_threshold; }
 
 	void set_space(SpaceSW *p_space);
 
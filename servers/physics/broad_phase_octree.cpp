@@ -30,6 +30,7 @@
 
 #include "broad_phase_octree.h"
 #include "collision_object_sw.h"
+#include "core/project_settings.h"
 
 BroadPhaseSW::ID BroadPhaseOctree::create(CollisionObjectSW *p_object, int p_subindex) {
 
@@ -121,6 +122,8 @@ BroadPhaseSW *BroadPhaseOctree::_create() {
 }
 
 BroadPhaseOctree::BroadPhaseOctree() {
+	octree.set_use_bvh(GLOBAL_DEF("physics/3d/godot_physics/use_bvh", false));
+	octree.set_bvh_fat_margin(GLOBAL_DEF("physics/3d/godot_physics/bvh_collision_margin", 0.1));
 	octree.set_pair_callback(_pair_callback, this);
 	octree.set_unpair_callback(_unpair_callback, this);
 	pair_callback = NULL;
@@ -32,11 +32,11 @@
 #define BROAD_PHASE_OCTREE_H
 
 #include "broad_phase_sw.h"
-#include "core/math/octree.h"
+#include "core/math/spatial_index.h"
 
 class BroadPhaseOctree : public BroadPhaseSW {
 
-	Octree<CollisionObjectSW, true> octree;
+	SpatialIndex<CollisionObjectSW, true> octree;
 
 	static void *_pair_callback(void *, OctreeElementID, CollisionObjectSW *, int, OctreeElementID, CollisionObjectSW *, int);
 	static void _unpair_callback(void *, OctreeElementID, CollisionObjectSW *, int, OctreeElementID, CollisionObjectSW *, int, void *);
@@ -79,6 +79,9 @@ public:
 	virtual bool setup(real_t p_step) = 0;
 	virtual void solve(real_t p_step) = 0;
 
+	// false if setup writes to objects shared with other islands, so it can't run on a worker thread
+	virtual bool is_setup_thread_safe() const { return true; }
+
 	virtual ~ConstraintSW() {}
 };
 
@@ -209,6 +209,48 @@ PhysicsDirectSpaceState *PhysicsServerSW::space_get_direct_state(RID p_space) {
 	return space->get_direct_state();
 }
 
+void PhysicsServerSW::space_set_history_size(RID p_space, int p_ticks) {
+
+	SpaceSW *space = space_owner.get(p_space);
+	ERR_FAIL_COND(!space);
+
+	space->set_history_size(p_ticks);
+}
+
+int PhysicsServerSW::space_get_history_size(RID p_space) const {
+
+	const SpaceSW *space = space_owner.get(p_space);
+	ERR_FAIL_COND_V(!space, 0);
+
+	return space->get_history_size();
+}
+
+uint64_t PhysicsServerSW::space_get_history_tick(RID p_space) const {
+
+	const SpaceSW *space = space_owner.get(p_space);
+	ERR_FAIL_COND_V(!space, 0);
+
+	return space->get_history_tick();
+}
+
+PhysicsDirectSpaceState *PhysicsServerSW::space_get_direct_state_at_tick(RID p_space, uint64_t p_tick) {
+
+	SpaceSW *space = space_owner.get(p_space);
+	ERR_FAIL_COND_V(!space, NULL);
+	if (!doing_sync || space->is_locked()) {
+
+		ERR_EXPLAIN("Space state is inaccessible right now, wait for iteration or physics process notification.");
+		ERR_FAIL_V(NULL);
+	}
+	if (!space->has_history_tick(p_tick)) {
+
+		ERR_EXPLAIN("Tick " + itos(p_tick) + " is not in the space history, which holds the last " + itos(space->get_history_size()) + " ticks.");
+		ERR_FAIL_V(NULL);
+	}
+
+	return space->get_direct_state_at_tick(p_tick);
+}
+
 void PhysicsServerSW::space_set_debug_contacts(RID p_space, int p_max_contacts) {
 
 	SpaceSW *space = space_owner.get(p_space);
@@ -230,6 +272,54 @@ int PhysicsServerSW::space_get_contact_count(RID p_space) const {
 	return space->get_debug_contact_count();
 }
 
+int PhysicsServerSW::space_get_info(RID p_space, SpaceInfo p_info) {
+
+	SpaceSW *space = space_owner.get(p_space);
+	ERR_FAIL_COND_V(!space, 0);
+
+	switch (p_info) {
+
+		case SPACE_INFO_ACTIVE_OBJECTS: {
+			return space->get_active_objects();
+		} break;
+		case SPACE_INFO_SLEEPING_OBJECTS: {
+
+			int count = 0;
+			for (const Set<CollisionObjectSW *>::Element *E = space->get_objects().front(); E; E = E->next()) {
+
+				if (E->get()->get_type() != CollisionObjectSW::TYPE_BODY)
+					continue;
+
+				const BodySW *body = static_cast<const BodySW *>(E->get());
+				if ((body->get_mode() == BODY_MODE_RIGID || body->get_mode() == BODY_MODE_CHARACTER) && !body->is_active())
+					count++;
+			}
+			return count;
+		} break;
+		case SPACE_INFO_COLLISION_PAIRS: {
+			return space->get_collision_pairs();
+		} break;
+		case SPACE_INFO_ISLAND_COUNT: {
+			return space->get_island_count();
+		} break;
+		case SPACE_INFO_BROADPHASE_TIME_USEC: {
+			return space->get_elapsed_time(SpaceSW::ELAPSED_TIME_BROADPHASE);
+		} break;
+		case SPACE_INFO_NARROWPHASE_TIME_USEC: {
+			// contacts are generated when the constraints are set up
+			return space->get_elapsed_time(SpaceSW::ELAPSED_TIME_SETUP_CONSTRAINTS);
+		} break;
+		case SPACE_INFO_SOLVER_TIME_USEC: {
+			return space->get_elapsed_time(SpaceSW::ELAPSED_TIME_GENERATE_ISLANDS) + space->get_elapsed_time(SpaceSW::ELAPSED_TIME_SOLVE_CONSTRAINTS);
+		} break;
+		case SPACE_INFO_INTEGRATE_TIME_USEC: {
+			return space->get_elapsed_time(SpaceSW::ELAPSED_TIME_INTEGRATE_FORCES) + space->get_elapsed_time(SpaceSW::ELAPSED_TIME_INTEGRATE_VELOCITIES);
+		} break;
+	}
+
+	return 0;
+}
+
 RID PhysicsServerSW::area_create() {
 
 	AreaSW *area = memnew(AreaSW);
@@ -673,7 +763,7 @@ uint32_t PhysicsServerSW::body_get_collision_mask(RID p_body) const {
 	return body->get_collision_mask();
 }
 
-void PhysicsServerSW::body_attach_object_instance_id(RID p_body, uint32_t p_ID) {
+void PhysicsServerSW::body_attach_object_instance_id(RID p_body, ObjectID p_ID) {
 
 	BodySW *body = body_owner.get(p_body);
 	ERR_FAIL_COND(!body);
@@ -681,7 +771,7 @@ void PhysicsServerSW::body_attach_object_instance_id(RID p_body, uint32_t p_ID)
 	body->set_instance_id(p_ID);
 };
 
-uint32_t PhysicsServerSW::body_get_object_instance_id(RID p_body) const {
+ObjectID PhysicsServerSW::body_get_object_instance_id(RID p_body) const {
 
 	BodySW *body = body_owner.get(p_body);
 	ERR_FAIL_COND_V(!body, 0);
@@ -924,6 +1014,21 @@ bool PhysicsServerSW::body_is_omitting_force_integration(RID p_body) const {
 	return body->get_omit_force_integration();
 };
 
+void PhysicsServerSW::body_set_record_history(RID p_body, bool p_enable) {
+
+	BodySW *body = body_owner.get(p_body);
+	ERR_FAIL_COND(!body);
+
+	body->set_record_history(p_enable);
+};
+
+bool PhysicsServerSW::body_is_recording_history(RID p_body) const {
+
+	BodySW *body = body_owner.get(p_body);
+	ERR_FAIL_COND_V(!body, false);
+	return body->is_recording_history();
+};
+
 void PhysicsServerSW::body_set_max_contacts_reported(RID p_body, int p_contacts) {
 
 	BodySW *body = body_owner.get(p_body);
@@ -998,6 +1103,362 @@ PhysicsDirectBodyState *PhysicsServerSW::body_get_direct_state(RID p_body) {
 	return direct_state;
 }
 
+/* SOFT BODY API */
+
+RID PhysicsServerSW::soft_body_create(bool p_init_sleeping) {
+
+	SoftBodySW *soft_body = memnew(SoftBodySW);
+	RID rid = soft_body_owner.make_rid(soft_body);
+	soft_body->set_self(rid);
+	return rid;
+}
+
+void PhysicsServerSW::soft_body_update_visual_server(RID p_body, SoftBodyVisualServerHandler *p_visual_server_handler) {
+
+	SoftBodySW *soft_body = soft_body_owner.get(p_body);
+	ERR_FAIL_COND(!soft_body);
+
+	soft_body->update_visual_server(p_visual_server_handler);
+}
+
+void PhysicsServerSW::soft_body_set_space(RID p_body, RID p_space) {
+
+	SoftBodySW *soft_body = soft_body_owner.get(p_body);
+	ERR_FAIL_COND(!soft_body);
+
+	SpaceSW *space = NULL;
+	if (p_space.is_valid()) {
+		space = space_owner.get(p_space);
+		ERR_FAIL_COND(!space);
+	}
+
+	soft_body->set_space(space);
+}
+
+RID PhysicsServerSW::soft_body_get_space(RID p_body) const {
+
+	SoftBodySW *soft_body = soft_body_owner.get(p_body);
+	ERR_FAIL_COND_V(!soft_body, RID());
+
+	SpaceSW *space = soft_body->get_space();
+	if (!space)
+		return RID();
+	return space->get_self();
+}
+
+void PhysicsServerSW::soft_body_set_collision_layer(RID p_body, uint32_t p_layer) {
+
+	SoftBodySW *soft_body = soft_body_owner.get(p_body);
+	ERR_FAIL_COND(!soft_body);
+
+	soft_body->set_collision_layer(p_layer);
+}
+
+uint32_t PhysicsServerSW::soft_body_get_collision_layer(RID p_body) const {
+
+	SoftBodySW *soft_body = soft_body_owner.get(p_body);
+	ERR_FAIL_COND_V(!soft_body, 0);
+
+	return soft_body->get_collision_layer();
+}
+
+void PhysicsServerSW::soft_body_set_collision_mask(RID p_body, uint32_t p_mask) {
+
+	SoftBodySW *soft_body = soft_body_owner.get(p_body);
+	ERR_FAIL_COND(!soft_body);
+
+	soft_body->set_collision_mask(p_mask);
+}
+
+uint32_t PhysicsServerSW::soft_body_get_collision_mask(RID p_body) const {
+
+	SoftBodySW *soft_body = soft_body_owner.get(p_body);
+	ERR_FAIL_COND_V(!soft_body, 0);
+
+	return soft_body->get_collision_mask();
+}
+
+void PhysicsServerSW::soft_body_add_collision_exception(RID p_body, RID p_body_b) {
+
+	SoftBodySW *soft_body = soft_body_owner.get(p_body);
+	ERR_FAIL_COND(!soft_body);
+
+	soft_body->add_exception(p_body_b);
+}
+
+void PhysicsServerSW::soft_body_remove_collision_exception(RID p_body, RID p_body_b) {
+
+	SoftBodySW *soft_body = soft_body_owner.get(p_body);
+	ERR_FAIL_COND(!soft_body);
+
+	soft_body->remove_exception(p_body_b);
+}
+
+void PhysicsServerSW::soft_body_get_collision_exceptions(RID p_body, List<RID> *p_exceptions) {
+
+	SoftBodySW *soft_body = soft_body_owner.get(p_body);
+	ERR_FAIL_COND(!soft_body);
+
+	for (int i = 0; i < soft_body->get_exceptions().size(); i++) {
+		p_exceptions->push_back(soft_body->get_exceptions()[i]);
+	}
+}
+
+void PhysicsServerSW::soft_body_set_state(RID p_body, BodyState p_state, const Variant &p_variant) {
+
+	SoftBodySW *soft_body = soft_body_owner.get(p_body);
+	ERR_FAIL_COND(!soft_body);
+
+	if (p_state == BODY_STATE_TRANSFORM) {
+		soft_body->set_transform(p_variant);
+	}
+}
+
+Variant PhysicsServerSW::soft_body_get_state(RID p_body, BodyState p_state) const {
+
+	SoftBodySW *soft_body = soft_body_owner.get(p_body);
+	ERR_FAIL_COND_V(!soft_body, Variant());
+
+	if (p_state == BODY_STATE_TRANSFORM) {
+		return soft_body->get_transform();
+	}
+	return Variant();
+}
+
+void PhysicsServerSW::soft_body_set_transform(RID p_body, const Transform &p_transform) {
+
+	SoftBodySW *soft_body = soft_body_owner.get(p_body);
+	ERR_FAIL_COND(!soft_body);
+
+	soft_body->set_transform(p_transform);
+}
+
+Vector3 PhysicsServerSW::soft_body_get_vertex_position(RID p_body, int vertex_index) const {
+
+	SoftBodySW *soft_body = soft_body_owner.get(p_body);
+	ERR_FAIL_COND_V(!soft_body, Vector3());
+	ERR_FAIL_INDEX_V(vertex_index, soft_body->get_point_count(), Vector3());
+
+	return soft_body->get_point_position(vertex_index);
+}
+
+void PhysicsServerSW::soft_body_set_ray_pickable(RID p_body, bool p_enable) {
+
+	SoftBodySW *soft_body = soft_body_owner.get(p_body);
+	ERR_FAIL_COND(!soft_body);
+
+	soft_body->set_ray_pickable(p_enable);
+}
+
+bool PhysicsServerSW::soft_body_is_ray_pickable(RID p_body) const {
+
+	SoftBodySW *soft_body = soft_body_owner.get(p_body);
+	ERR_FAIL_COND_V(!soft_body, false);
+
+	return soft_body->is_ray_pickable();
+}
+
+void PhysicsServerSW::soft_body_set_simulation_precision(RID p_body, int p_simulation_precision) {
+
+	SoftBodySW *soft_body = soft_body_owner.get(p_body);
+	ERR_FAIL_COND(!soft_body);
+
+	soft_body->set_simulation_precision(p_simulation_precision);
+}
+
+int PhysicsServerSW::soft_body_get_simulation_precision(RID p_body) {
+
+	SoftBodySW *soft_body = soft_body_owner.get(p_body);
+	ERR_FAIL_COND_V(!soft_body, 0);
+
+	return soft_body->get_simulation_precision();
+}
+
+void PhysicsServerSW::soft_body_set_total_mass(RID p_body, real_t p_total_mass) {
+
+	SoftBodySW *soft_body = soft_body_owner.get(p_body);
+	ERR_FAIL_COND(!soft_body);
+
+	soft_body->set_total_mass(p_total_mass);
+}
+
+real_t PhysicsServerSW::soft_body_get_total_mass(RID p_body) {
+
+	SoftBodySW *soft_body = soft_body_owner.get(p_body);
+	ERR_FAIL_COND_V(!soft_body, 0);
+
+	return soft_body->get_total_mass();
+}
+
+void PhysicsServerSW::soft_body_set_linear_stiffness(RID p_body, real_t p_stiffness) {
+
+	SoftBodySW *soft_body = soft_body_owner.get(p_body);
+	ERR_FAIL_COND(!soft_body);
+
+	soft_body->set_linear_stiffness(p_stiffness);
+}
+
+real_t PhysicsServerSW::soft_body_get_linear_stiffness(RID p_body) {
+
+	SoftBodySW *soft_body = soft_body_owner.get(p_body);
+	ERR_FAIL_COND_V(!soft_body, 0);
+
+	return soft_body->get_linear_stiffness();
+}
+
+void PhysicsServerSW::soft_body_set_areaAngular_stiffness(RID p_body, real_t p_stiffness) {
+
+	SoftBodySW *soft_body = soft_body_owner.get(p_body);
+	ERR_FAIL_COND(!soft_body);
+
+	soft_body->set_areaAngular_stiffness(p_stiffness);
+}
+
+real_t PhysicsServerSW::soft_body_get_areaAngular_stiffness(RID p_body) {
+
+	SoftBodySW *soft_body = soft_body_owner.get(p_body);
+	ERR_FAIL_COND_V(!soft_body, 0);
+
+	return soft_body->get_areaAngular_stiffness();
+}
+
+void PhysicsServerSW::soft_body_set_volume_stiffness(RID p_body, real_t p_stiffness) {
+
+	SoftBodySW *soft_body = soft_body_owner.get(p_body);
+	ERR_FAIL_COND(!soft_body);
+
+	soft_body->set_volume_stiffness(p_stiffness);
+}
+
+real_t PhysicsServerSW::soft_body_get_volume_stiffness(RID p_body) {
+
+	SoftBodySW *soft_body = soft_body_owner.get(p_body);
+	ERR_FAIL_COND_V(!soft_body, 0);
+
+	return soft_body->get_volume_stiffness();
+}
+
+void PhysicsServerSW::soft_body_set_pressure_coefficient(RID p_body, real_t p_pressure_coefficient) {
+
+	SoftBodySW *soft_body = soft_body_owner.get(p_body);
+	ERR_FAIL_COND(!soft_body);
+
+	soft_body->set_pressure_coefficient(p_pressure_coefficient);
+}
+
+real_t PhysicsServerSW::soft_body_get_pressure_coefficient(RID p_body) {
+
+	SoftBodySW *soft_body = soft_body_owner.get(p_body);
+	ERR_FAIL_COND_V(!soft_body, 0);
+
+	return soft_body->get_pressure_coefficient();
+}
+
+void PhysicsServerSW::soft_body_set_pose_matching_coefficient(RID p_body, real_t p_pose_matching_coefficient) {
+
+	SoftBodySW *soft_body = soft_body_owner.get(p_body);
+	ERR_FAIL_COND(!soft_body);
+
+	soft_body->set_pose_matching_coefficient(p_pose_matching_coefficient);
+}
+
+real_t PhysicsServerSW::soft_body_get_pose_matching_coefficient(RID p_body) {
+
+	SoftBodySW *soft_body = soft_body_owner.get(p_body);
+	ERR_FAIL_COND_V(!soft_body, 0);
+
+	return soft_body->get_pose_matching_coefficient();
+}
+
+void PhysicsServerSW::soft_body_set_damping_coefficient(RID p_body, real_t p_damping_coefficient) {
+
+	SoftBodySW *soft_body = soft_body_owner.get(p_body);
+	ERR_FAIL_COND(!soft_body);
+
+	soft_body->set_damping_coefficient(p_damping_coefficient);
+}
+
+real_t PhysicsServerSW::soft_body_get_damping_coefficient(RID p_body) {
+
+	SoftBodySW *soft_body = soft_body_owner.get(p_body);
+	ERR_FAIL_COND_V(!soft_body, 0);
+
+	return soft_body->get_damping_coefficient();
+}
+
+void PhysicsServerSW::soft_body_set_drag_coefficient(RID p_body, real_t p_drag_coefficient) {
+
+	SoftBodySW *soft_body = soft_body_owner.get(p_body);
+	ERR_FAIL_COND(!soft_body);
+
+	soft_body->set_drag_coefficient(p_drag_coefficient);
+}
+
+real_t PhysicsServerSW::soft_body_get_drag_coefficient(RID p_body) {
+
+	SoftBodySW *soft_body = soft_body_owner.get(p_body);
+	ERR_FAIL_COND_V(!soft_body, 0);
+
+	return soft_body->get_drag_coefficient();
+}
+
+void PhysicsServerSW::soft_body_set_mesh(RID p_body, const REF &p_mesh) {
+
+	SoftBodySW *soft_body = soft_body_owner.get(p_body);
+	ERR_FAIL_COND(!soft_body);
+
+	soft_body->set_mesh(p_mesh);
+}
+
+void PhysicsServerSW::soft_body_move_point(RID p_body, int p_point_index, const Vector3 &p_global_position) {
+
+	SoftBodySW *soft_body = soft_body_owner.get(p_body);
+	ERR_FAIL_COND(!soft_body);
+
+	soft_body->move_point(p_point_index, p_global_position);
+}
+
+Vector3 PhysicsServerSW::soft_body_get_point_global_position(RID p_body, int p_point_index) {
+
+	SoftBodySW *soft_body = soft_body_owner.get(p_body);
+	ERR_FAIL_COND_V(!soft_body, Vector3());
+	ERR_FAIL_INDEX_V(p_point_index, soft_body->get_point_count(), Vector3());
+
+	return soft_body->get_point_position(p_point_index);
+}
+
+Vector3 PhysicsServerSW::soft_body_get_point_offset(RID p_body, int p_point_index) const {
+
+	SoftBodySW *soft_body = soft_body_owner.get(p_body);
+	ERR_FAIL_COND_V(!soft_body, Vector3());
+
+	return soft_body->get_point_offset(p_point_index);
+}
+
+void PhysicsServerSW::soft_body_remove_all_pinned_points(RID p_body) {
+
+	SoftBodySW *soft_body = soft_body_owner.get(p_body);
+	ERR_FAIL_COND(!soft_body);
+
+	soft_body->remove_all_pinned_points();
+}
+
+void PhysicsServerSW::soft_body_pin_point(RID p_body, int p_point_index, bool p_pin) {
+
+	SoftBodySW *soft_body = soft_body_owner.get(p_body);
+	ERR_FAIL_COND(!soft_body);
+
+	soft_body->pin_point(p_point_index, p_pin);
+}
+
+bool PhysicsServerSW::soft_body_is_point_pinned(RID p_body, int p_point_index) {
+
+	SoftBodySW *soft_body = soft_body_owner.get(p_body);
+	ERR_FAIL_COND_V(!soft_body, false);
+
+	return soft_body->is_point_pinned(p_point_index);
+}
+
 /* JOINT API */
 
 RID PhysicsServerSW::joint_create_pin(RID p_body_A, const Vector3 &p_local_A, RID p_body_B, const Vector3 &p_local_B) {
@@ -1382,10 +1843,21 @@ void PhysicsServerSW::free(RID p_rid) {
 
 		area_owner.free(p_rid);
 		memdelete(area);
+	} else if (soft_body_owner.owns(p_rid)) {
+
+		SoftBodySW *soft_body = soft_body_owner.get(p_rid);
+		soft_body->set_space(NULL);
+
+		soft_body_owner.free(p_rid);
+		memdelete(soft_body);
 	} else if (space_owner.owns(p_rid)) {
 
 		SpaceSW *space = space_owner.get(p_rid);
 
+		while (space->get_soft_body_list().first()) {
+			space->get_soft_body_list().first()->self()->set_space(NULL);
+		}
+
 		while (space->get_objects().size()) {
 			CollisionObjectSW *co = (CollisionObjectSW *)space->get_objects().front()->get();
 			co->set_space(NULL);
@@ -1449,6 +1921,7 @@ void PhysicsServerSW::step(real_t p_step) {
 	for (Set<const SpaceSW *>::Element *E = active_spaces.front(); E; E = E->next()) {
 
 		stepper->step((SpaceSW *)E->get(), p_step, iterations);
+		((SpaceSW *)E->get())->record_history();
 		island_count += E->get()->get_island_count();
 		active_objects += E->get()->get_active_objects();
 		collision_pairs += E->get()->get_collision_pairs();
@@ -1489,7 +1962,8 @@ void PhysicsServerSW::flush_queries() {
 			"generate_islands",
 			"setup_constraints",
 			"solve_constraints",
-			"integrate_velocities"
+			"integrate_velocities",
+			"broadphase"
 		};
 
 		for (int i = 0; i < SpaceSW::ELAPSED_TIME_MAX; i++) {
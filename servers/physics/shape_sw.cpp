@@ -1121,13 +1121,15 @@ PoolVector<Vector3> ConcavePolygonShapeSW::get_faces() const {
 	PoolVector<Vector3> rfaces;
 	rfaces.resize(faces.size() * 3);
 
-	for (int i = 0; i < faces.size(); i++) {
+	PoolVector<Vector3>::Write w = rfaces.write();
+	const Face *fr = faces.ptr();
+	const Vector3 *vr = vertices.ptr();
 
-		Face f = faces.get(i);
+	for (int i = 0; i < faces.size(); i++) {
 
 		for (int j = 0; j < 3; j++) {
 
-			rfaces.set(i * 3 + j, vertices.get(f.indices[j]));
+			w[i * 3 + j] = vr[fr[i].indices[j]];
 		}
 	}
 
@@ -1142,8 +1144,7 @@ void ConcavePolygonShapeSW::project_range(const Vector3 &p_normal, const Transfo
 		r_max = 0;
 		return;
 	}
-	PoolVector<Vector3>::Read r = vertices.read();
-	const Vector3 *vptr = r.ptr();
+	const Vector3 *vptr = vertices.ptr();
 
 	for (int i = 0; i < count; i++) {
 
@@ -1162,8 +1163,7 @@ Vector3 ConcavePolygonShapeSW::get_support(const Vector3 &p_normal) const {
 	if (count == 0)
 		return Vector3();
 
-	PoolVector<Vector3>::Read r = vertices.read();
-	const Vector3 *vptr = r.ptr();
+	const Vector3 *vptr = vertices.ptr();
 
 	Vector3 n = p_normal;
 
@@ -1183,28 +1183,48 @@ Vector3 ConcavePolygonShapeSW::get_support(const Vector3 &p_normal) const {
 	return vptr[vert_support_idx];
 }
 
+AABB ConcavePolygonShapeSW::_get_node_aabb(const BVH &p_node) const {
+
+	const Vector3 &base = get_aabb().position;
+	Vector3 min(p_node.min[0], p_node.min[1], p_node.min[2]);
+	Vector3 max(p_node.max[0], p_node.max[1], p_node.max[2]);
+	min = base + min * dequantize_scale;
+	max = base + max * dequantize_scale;
+	return AABB(min, max - min);
+}
+
+void ConcavePolygonShapeSW::_quantize_aabb(const AABB &p_aabb, uint16_t *r_min, uint16_t *r_max) const {
+
+	const AABB &shape_aabb = get_aabb();
+
+	for (int i = 0; i < 3; i++) {
+
+		real_t min = Math::floor((p_aabb.position[i] - shape_aabb.position[i]) * quantize_scale[i]);
+		real_t max = Math::ceil((p_aabb.position[i] + p_aabb.size[i] - shape_aabb.position[i]) * quantize_scale[i]);
+		// one extra step on each side absorbs rounding, bounds must never shrink
+		r_min[i] = (uint16_t)CLAMP(min - 1, 0, 65535);
+		r_max[i] = (uint16_t)CLAMP(max + 1, 0, 65535);
+	}
+}
+
 void ConcavePolygonShapeSW::_cull_segment(int p_idx, _SegmentCullParams *p_params) const {
 
 	const BVH *bvh = &p_params->bvh[p_idx];
 
-	/*
-	if (p_params->dir.dot(bvh->aabb.get_support(-p_params->dir))>p_params->min_d)
-		return; //test against whole AABB, which isn't very costly
-	*/
-
-	//printf("addr: %p\n",bvh);
-	if (!bvh->aabb.intersects_segment(p_params->from, p_params->to)) {
+	if (!_get_node_aabb(*bvh).intersects_segment(p_params->from, p_params->to)) {
 
 		return;
 	}
 
-	if (bvh->face_index >= 0) {
+	if (bvh->is_leaf()) {
+
+		const Face &f = p_params->faces[bvh->get_face_index()];
 
 		Vector3 res;
 		Vector3 vertices[3] = {
-			p_params->vertices[p_params->faces[bvh->face_index].indices[0]],
-			p_params->vertices[p_params->faces[bvh->face_index].indices[1]],
-			p_params->vertices[p_params->faces[bvh->face_index].indices[2]]
+			p_params->vertices[f.indices[0]],
+			p_params->vertices[f.indices[1]],
+			p_params->vertices[f.indices[2]]
 		};
 
 		if (Geometry::segment_intersects_triangle(
@@ -1221,17 +1241,17 @@ void ConcavePolygonShapeSW::_cull_segment(int p_idx, _SegmentCullParams *p_param
 
 				p_params->min_d = d;
 				p_params->result = res;
-				p_params->normal = Plane(vertices[0], vertices[1], vertices[2]).normal;
+				p_params->normal = f.normal;
 				p_params->collisions++;
+				// anything further away can't win anymore, shorten the segment so the remaining nodes get culled
+				p_params->to = res;
 			}
 		}
 
 	} else {
 
-		if (bvh->left >= 0)
-			_cull_segment(bvh->left, p_params);
-		if (bvh->right >= 0)
-			_cull_segment(bvh->right, p_params);
+		_cull_segment(p_idx + 1, p_params);
+		_cull_segment(bvh->data, p_params);
 	}
 }
 
@@ -1240,20 +1260,15 @@ bool ConcavePolygonShapeSW::intersect_segment(const Vector3 &p_begin, const Vect
 	if (faces.size() == 0)
 		return false;
 
-	// unlock data
-	PoolVector<Face>::Read fr = faces.read();
-	PoolVector<Vector3>::Read vr = vertices.read();
-	PoolVector<BVH>::Read br = bvh.read();
-
 	_SegmentCullParams params;
 	params.from = p_begin;
 	params.to = p_end;
 	params.collisions = 0;
 	params.dir = (p_end - p_begin).normalized();
 
-	params.faces = fr.ptr();
-	params.vertices = vr.ptr();
-	params.bvh = br.ptr();
+	params.faces = faces.ptr();
+	params.vertices = vertices.ptr();
+	params.bvh = bvh.ptr();
 
 	params.min_d = 1e20;
 	// cull
@@ -1284,12 +1299,15 @@ void ConcavePolygonShapeSW::_cull(int p_idx, _CullParams *p_params) const {
 
 	const BVH *bvh = &p_params->bvh[p_idx];
 
-	if (!p_params->aabb.intersects(bvh->aabb))
-		return;
+	for (int i = 0; i < 3; i++) {
+
+		if (bvh->min[i] > p_params->max[i] || bvh->max[i] < p_params->min[i])
+			return;
+	}
 
-	if (bvh->face_index >= 0) {
+	if (bvh->is_leaf()) {
 
-		const Face *f = &p_params->faces[bvh->face_index];
+		const Face *f = &p_params->faces[bvh->get_face_index()];
 		FaceShapeSW *face = p_params->face;
 		face->normal = f->normal;
 		face->vertex[0] = p_params->vertices[f->indices[0]];
@@ -1299,15 +1317,8 @@ void ConcavePolygonShapeSW::_cull(int p_idx, _CullParams *p_params) const {
 
 	} else {
 
-		if (bvh->left >= 0) {
-
-			_cull(bvh->left, p_params);
-		}
-
-		if (bvh->right >= 0) {
-
-			_cull(bvh->right, p_params);
-		}
+		_cull(p_idx + 1, p_params);
+		_cull(bvh->data, p_params);
 	}
 }
 
@@ -1317,21 +1328,17 @@ void ConcavePolygonShapeSW::cull(const AABB &p_local_aabb, Callback p_callback,
 	if (faces.size() == 0)
 		return;
 
-	AABB local_aabb = p_local_aabb;
-
-	// unlock data
-	PoolVector<Face>::Read fr = faces.read();
-	PoolVector<Vector3>::Read vr = vertices.read();
-	PoolVector<BVH>::Read br = bvh.read();
+	if (!p_local_aabb.intersects(get_aabb()))
+		return;
 
 	FaceShapeSW face; // use this to send in the callback
 
 	_CullParams params;
-	params.aabb = local_aabb;
+	_quantize_aabb(p_local_aabb, params.min, params.max);
 	params.face = &face;
-	params.faces = fr.ptr();
-	params.vertices = vr.ptr();
-	params.bvh = br.ptr();
+	params.faces = faces.ptr();
+	params.vertices = vertices.ptr();
+	params.bvh = bvh.ptr();
 	params.callback = p_callback;
 	params.userdata = p_userdata;
 
@@ -1381,101 +1388,190 @@ struct _VolumeSW_BVH_CompareZ {
 	}
 };
 
-struct _VolumeSW_BVH {
+struct _VolumeSW_Vertex {
 
-	AABB aabb;
-	_VolumeSW_BVH *left;
-	_VolumeSW_BVH *right;
+	Vector3 position;
+	int index;
 
-	int face_index;
+	_FORCE_INLINE_ bool operator<(const _VolumeSW_Vertex &p_vertex) const {
+
+		return position < p_vertex.position;
+	}
 };
 
-_VolumeSW_BVH *_volume_sw_build_bvh(_VolumeSW_BVH_Element *p_elements, int p_size, int &count) {
+struct _VolumeSW_BVH_Builder {
 
-	_VolumeSW_BVH *bvh = memnew(_VolumeSW_BVH);
+	enum {
+		BIN_COUNT = 12
+	};
 
-	if (p_size == 1) {
-		//leaf
-		bvh->aabb = p_elements[0].aabb;
-		bvh->left = NULL;
-		bvh->right = NULL;
-		bvh->face_index = p_elements->face_index;
-		count++;
-		return bvh;
-	} else {
+	struct Bin {
+		AABB aabb;
+		int count;
+	};
 
-		bvh->face_index = -1;
-	}
+	_VolumeSW_BVH_Element *elements;
+	Vector<ConcavePolygonShapeSW::BVH> *nodes;
+	const ConcavePolygonShapeSW *shape;
 
-	AABB aabb;
-	for (int i = 0; i < p_size; i++) {
+	static _FORCE_INLINE_ real_t _get_area(const AABB &p_aabb) {
 
-		if (i == 0)
-			aabb = p_elements[i].aabb;
-		else
-			aabb.merge_with(p_elements[i].aabb);
+		const Vector3 &s = p_aabb.size;
+		return s.x * s.y + s.y * s.z + s.z * s.x;
 	}
-	bvh->aabb = aabb;
-	switch (aabb.get_longest_axis_index()) {
 
-		case 0: {
+	// Binned surface area heuristic, returns the element count of the left side
+	// after partitioning, or 0 when no split beats the median.
+	int _partition(int p_from, int p_size, const AABB &p_aabb) {
 
-			SortArray<_VolumeSW_BVH_Element, _VolumeSW_BVH_CompareX> sort_x;
-			sort_x.sort(p_elements, p_size);
+		AABB centers(elements[p_from].center, Vector3());
+		for (int i = 1; i < p_size; i++) {
+			centers.expand_to(elements[p_from + i].center);
+		}
 
-		} break;
-		case 1: {
+		int best_axis = -1;
+		int best_bin = 0;
+		real_t best_cost = _get_area(p_aabb) * p_size; // cost of keeping a big leaf, scaled like the splits
 
-			SortArray<_VolumeSW_BVH_Element, _VolumeSW_BVH_CompareY> sort_y;
-			sort_y.sort(p_elements, p_size);
-		} break;
-		case 2: {
+		for (int axis = 0; axis < 3; axis++) {
 
-			SortArray<_VolumeSW_BVH_Element, _VolumeSW_BVH_CompareZ> sort_z;
-			sort_z.sort(p_elements, p_size);
-		} break;
-	}
+			real_t extent = centers.size[axis];
+			if (extent <= CMP_EPSILON)
+				continue;
 
-	int split = p_size / 2;
-	bvh->left = _volume_sw_build_bvh(p_elements, split, count);
-	bvh->right = _volume_sw_build_bvh(&p_elements[split], p_size - split, count);
+			Bin bins[BIN_COUNT];
+			for (int i = 0; i < BIN_COUNT; i++) {
+				bins[i].count = 0;
+			}
 
-	//printf("branch at %p - %i: %i\n",bvh,count,bvh->face_index);
-	count++;
-	return bvh;
-}
+			real_t scale = BIN_COUNT / extent;
+			for (int i = 0; i < p_size; i++) {
 
-void ConcavePolygonShapeSW::_fill_bvh(_VolumeSW_BVH *p_bvh_tree, BVH *p_bvh_array, int &p_idx) {
+				const _VolumeSW_BVH_Element &e = elements[p_from + i];
+				int b = MIN(int((e.center[axis] - centers.position[axis]) * scale), BIN_COUNT - 1);
+				if (bins[b].count == 0)
+					bins[b].aabb = e.aabb;
+				else
+					bins[b].aabb.merge_with(e.aabb);
+				bins[b].count++;
+			}
 
-	int idx = p_idx;
+			// sweep from the right to get the cost of every right side
+			real_t right_area[BIN_COUNT];
+			int right_count[BIN_COUNT];
+			AABB accum;
+			int count = 0;
+			for (int i = BIN_COUNT - 1; i > 0; i--) {
+
+				if (bins[i].count) {
+					if (count == 0)
+						accum = bins[i].aabb;
+					else
+						accum.merge_with(bins[i].aabb);
+					count += bins[i].count;
+				}
+				right_area[i] = count ? _get_area(accum) : 0;
+				right_count[i] = count;
+			}
 
-	p_bvh_array[idx].aabb = p_bvh_tree->aabb;
-	p_bvh_array[idx].face_index = p_bvh_tree->face_index;
-	//printf("%p - %i: %i(%p)  -- %p:%p\n",%p_bvh_array[idx],p_idx,p_bvh_array[i]->face_index,&p_bvh_tree->face_index,p_bvh_tree->left,p_bvh_tree->right);
+			count = 0;
+			for (int i = 0; i < BIN_COUNT - 1; i++) {
 
-	if (p_bvh_tree->left) {
-		p_bvh_array[idx].left = ++p_idx;
-		_fill_bvh(p_bvh_tree->left, p_bvh_array, p_idx);
+				if (bins[i].count) {
+					if (count == 0)
+						accum = bins[i].aabb;
+					else
+						accum.merge_with(bins[i].aabb);
+					count += bins[i].count;
+				}
 
-	} else {
+				if (count == 0 || right_count[i + 1] == 0)
+					continue;
 
-		p_bvh_array[p_idx].left = -1;
-	}
+				real_t cost = _get_area(accum) * count + right_area[i + 1] * right_count[i + 1];
+				if (cost < best_cost) {
+					best_cost = cost;
+					best_axis = axis;
+					best_bin = i;
+				}
+			}
+		}
 
-	if (p_bvh_tree->right) {
-		p_bvh_array[idx].right = ++p_idx;
-		_fill_bvh(p_bvh_tree->right, p_bvh_array, p_idx);
+		if (best_axis == -1)
+			return 0;
 
-	} else {
+		real_t scale = BIN_COUNT / centers.size[best_axis];
+		int left = p_from;
+		int right = p_from + p_size - 1;
+		while (left <= right) {
+
+			int b = MIN(int((elements[left].center[best_axis] - centers.position[best_axis]) * scale), BIN_COUNT - 1);
+			if (b <= best_bin) {
+				left++;
+			} else {
+				SWAP(elements[left], elements[right]);
+				right--;
+			}
+		}
 
-		p_bvh_array[p_idx].right = -1;
+		return left - p_from;
 	}
 
-	memdelete(p_bvh_tree);
-}
+	int build(int p_from, int p_size) {
+
+		int idx = nodes->size();
+		nodes->push_back(ConcavePolygonShapeSW::BVH());
+
+		AABB aabb = elements[p_from].aabb;
+		for (int i = 1; i < p_size; i++) {
+			aabb.merge_with(elements[p_from + i].aabb);
+		}
+
+		ConcavePolygonShapeSW::BVH node;
+		shape->_quantize_aabb(aabb, node.min, node.max);
+
+		if (p_size == 1) {
+			//leaf
+			node.data = ~elements[p_from].face_index;
+			nodes->set(idx, node);
+			return idx;
+		}
+
+		int split = _partition(p_from, p_size, aabb);
+
+		if (split == 0 || split == p_size) {
+			// all centers fall in the same spot, fall back to a median split
+			int axis = aabb.get_longest_axis_index();
+			switch (axis) {
+				case 0: {
+					SortArray<_VolumeSW_BVH_Element, _VolumeSW_BVH_CompareX> sort_x;
+					sort_x.sort(&elements[p_from], p_size);
+				} break;
+				case 1: {
+					SortArray<_VolumeSW_BVH_Element, _VolumeSW_BVH_CompareY> sort_y;
+					sort_y.sort(&elements[p_from], p_size);
+				} break;
+				case 2: {
+					SortArray<_VolumeSW_BVH_Element, _VolumeSW_BVH_CompareZ> sort_z;
+					sort_z.sort(&elements[p_from], p_size);
+				} break;
+			}
+			split = p_size / 2;
+		}
+
+		build(p_from, split); // left child always follows its parent
+		node.data = build(p_from + split, p_size - split);
+		nodes->set(idx, node);
+		return idx;
+	}
+};
 
 void ConcavePolygonShapeSW::_setup(PoolVector<Vector3> p_faces) {
 
+	faces.clear();
+	vertices.clear();
+	bvh.clear();
+
 	int src_face_count = p_faces.size();
 	if (src_face_count == 0) {
 		configure(AABB());
@@ -1487,20 +1583,33 @@ void ConcavePolygonShapeSW::_setup(PoolVector<Vector3> p_faces) {
 	PoolVector<Vector3>::Read r = p_faces.read();
 	const Vector3 *facesr = r.ptr();
 
-	PoolVector<_VolumeSW_BVH_Element> bvh_array;
-	bvh_array.resize(src_face_count);
+	// merge vertices shared between faces, keeps the data smaller and get_support() cheaper
+	Vector<_VolumeSW_Vertex> sorted;
+	sorted.resize(src_face_count * 3);
+	_VolumeSW_Vertex *sortedw = sorted.ptrw();
+	for (int i = 0; i < src_face_count * 3; i++) {
+		sortedw[i].position = facesr[i];
+		sortedw[i].index = i;
+	}
+	sorted.sort();
 
-	PoolVector<_VolumeSW_BVH_Element>::Write bvhw = bvh_array.write();
-	_VolumeSW_BVH_Element *bvh_arrayw = bvhw.ptr();
+	Vector<int> remap;
+	remap.resize(src_face_count * 3);
+	int *remapw = remap.ptrw();
 
-	faces.resize(src_face_count);
-	PoolVector<Face>::Write w = faces.write();
-	Face *facesw = w.ptr();
+	for (int i = 0; i < sorted.size(); i++) {
 
-	vertices.resize(src_face_count * 3);
+		if (i == 0 || sortedw[i - 1].position != sortedw[i].position)
+			vertices.push_back(sortedw[i].position);
+		remapw[sortedw[i].index] = vertices.size() - 1;
+	}
 
-	PoolVector<Vector3>::Write vw = vertices.write();
-	Vector3 *verticesw = vw.ptr();
+	Vector<_VolumeSW_BVH_Element> bvh_array;
+	bvh_array.resize(src_face_count);
+	_VolumeSW_BVH_Element *bvh_arrayw = bvh_array.ptrw();
+
+	faces.resize(src_face_count);
+	Face *facesw = faces.ptrw();
 
 	AABB _aabb;
 
@@ -1511,34 +1620,35 @@ void ConcavePolygonShapeSW::_setup(PoolVector<Vector3> p_faces) {
 		bvh_arrayw[i].aabb = face.get_aabb();
 		bvh_arrayw[i].center = bvh_arrayw[i].aabb.position + bvh_arrayw[i].aabb.size * 0.5;
 		bvh_arrayw[i].face_index = i;
-		facesw[i].indices[0] = i * 3 + 0;
-		facesw[i].indices[1] = i * 3 + 1;
-		facesw[i].indices[2] = i * 3 + 2;
+		facesw[i].indices[0] = remapw[i * 3 + 0];
+		facesw[i].indices[1] = remapw[i * 3 + 1];
+		facesw[i].indices[2] = remapw[i * 3 + 2];
 		facesw[i].normal = face.get_plane().normal;
-		verticesw[i * 3 + 0] = face.vertex[0];
-		verticesw[i * 3 + 1] = face.vertex[1];
-		verticesw[i * 3 + 2] = face.vertex[2];
 		if (i == 0)
 			_aabb = bvh_arrayw[i].aabb;
 		else
 			_aabb.merge_with(bvh_arrayw[i].aabb);
 	}
 
-	w = PoolVector<Face>::Write();
-	vw = PoolVector<Vector3>::Write();
-
-	int count = 0;
-	_VolumeSW_BVH *bvh_tree = _volume_sw_build_bvh(bvh_arrayw, src_face_count, count);
-
-	bvh.resize(count + 1);
+	configure(_aabb); // this type of shape has no margin
 
-	PoolVector<BVH>::Write bvhw2 = bvh.write();
-	BVH *bvh_arrayw2 = bvhw2.ptr();
+	for (int i = 0; i < 3; i++) {
 
-	int idx = 0;
-	_fill_bvh(bvh_tree, bvh_arrayw2, idx);
+		if (_aabb.size[i] > CMP_EPSILON) {
+			quantize_scale[i] = 65535.0 / _aabb.size[i];
+			dequantize_scale[i] = _aabb.size[i] / 65535.0;
+		} else {
+			quantize_scale[i] = 0;
+			dequantize_scale[i] = 0;
+		}
+	}
 
-	configure(_aabb); // this type of shape has no margin
+	_VolumeSW_BVH_Builder builder;
+	builder.elements = bvh_arrayw;
+	builder.nodes = &bvh;
+	builder.shape = this;
+	bvh.resize(0);
+	builder.build(0, src_face_count);
 }
 
 void ConcavePolygonShapeSW::set_data(const Variant &p_data) {
@@ -1558,7 +1668,13 @@ ConcavePolygonShapeSW::ConcavePolygonShapeSW() {
 
 PoolVector<real_t> HeightMapShapeSW::get_heights() const {
 
-	return heights;
+	PoolVector<real_t> ret;
+	ret.resize(heights.size());
+	PoolVector<real_t>::Write w = ret.write();
+	for (int i = 0; i < heights.size(); i++) {
+		w[i] = heights[i];
+	}
+	return ret;
 }
 int HeightMapShapeSW::get_width() const {
 
@@ -1585,8 +1701,126 @@ Vector3 HeightMapShapeSW::get_support(const Vector3 &p_normal) const {
 	return get_aabb().get_support(p_normal);
 }
 
+void HeightMapShapeSW::_get_cell_triangles(int p_x, int p_z, Vector3 *r_points) const {
+
+	// p00, p10, p01 and p10, p11, p01, both facing up
+	r_points[0] = _get_point(p_x, p_z);
+	r_points[1] = _get_point(p_x + 1, p_z);
+	r_points[2] = _get_point(p_x, p_z + 1);
+	r_points[3] = r_points[1];
+	r_points[4] = _get_point(p_x + 1, p_z + 1);
+	r_points[5] = r_points[2];
+}
+
+bool HeightMapShapeSW::_intersect_cell(int p_x, int p_z, const Vector3 &p_begin, const Vector3 &p_end, real_t &r_dist, Vector3 &r_point, Vector3 &r_normal) const {
+
+	Vector3 points[6];
+	_get_cell_triangles(p_x, p_z, points);
+
+	Vector3 dir = p_end - p_begin;
+	bool found = false;
+
+	for (int i = 0; i < 6; i += 3) {
+
+		Vector3 res;
+		if (!Geometry::segment_intersects_triangle(p_begin, p_end, points[i + 0], points[i + 1], points[i + 2], &res))
+			continue;
+
+		real_t d = dir.dot(res - p_begin);
+		if (d < r_dist) {
+			r_dist = d;
+			r_point = res;
+			r_normal = Plane(points[i + 0], points[i + 1], points[i + 2]).normal;
+			found = true;
+		}
+	}
+
+	return found;
+}
+
 bool HeightMapShapeSW::intersect_segment(const Vector3 &p_begin, const Vector3 &p_end, Vector3 &r_point, Vector3 &r_normal) const {
 
+	if (width < 2 || depth < 2)
+		return false;
+
+	// clip the segment against the shape bounds first
+	const AABB &aabb = get_aabb();
+	Vector3 dir = p_end - p_begin;
+	real_t t_min = 0;
+	real_t t_max = 1;
+
+	for (int i = 0; i < 3; i++) {
+
+		real_t from = aabb.position[i] - CMP_EPSILON;
+		real_t to = aabb.position[i] + aabb.size[i] + CMP_EPSILON;
+
+		if (Math::abs(dir[i]) < CMP_EPSILON) {
+			if (p_begin[i] < from || p_begin[i] > to)
+				return false;
+			continue;
+		}
+
+		real_t t0 = (from - p_begin[i]) / dir[i];
+		real_t t1 = (to - p_begin[i]) / dir[i];
+		if (t0 > t1)
+			SWAP(t0, t1);
+		t_min = MAX(t_min, t0);
+		t_max = MIN(t_max, t1);
+		if (t_min > t_max)
+			return false;
+	}
+
+	// walk the cells under the segment in order, the first cell with a hit has the closest one
+	Vector3 start = p_begin + dir * t_min;
+	int x = CLAMP(int(Math::floor((start.x - local_origin.x) / cell_size)), 0, width - 2);
+	int z = CLAMP(int(Math::floor((start.z - local_origin.z) / cell_size)), 0, depth - 2);
+
+	int step_x = dir.x > 0 ? 1 : -1;
+	int step_z = dir.z > 0 ? 1 : -1;
+	real_t t_delta_x = Math::abs(dir.x) > CMP_EPSILON ? cell_size / Math::abs(dir.x) : 1e20;
+	real_t t_delta_z = Math::abs(dir.z) > CMP_EPSILON ? cell_size / Math::abs(dir.z) : 1e20;
+	real_t t_next_x = Math::abs(dir.x) > CMP_EPSILON ? (local_origin.x + (x + (step_x > 0 ? 1 : 0)) * cell_size - p_begin.x) / dir.x : 1e20;
+	real_t t_next_z = Math::abs(dir.z) > CMP_EPSILON ? (local_origin.z + (z + (step_z > 0 ? 1 : 0)) * cell_size - p_begin.z) / dir.z : 1e20;
+
+	real_t t_enter = t_min;
+	real_t dist = 1e20;
+
+	while (true) {
+
+		real_t t_exit = MIN(MIN(t_next_x, t_next_z), t_max);
+
+		// skip cells the segment passes entirely above or below
+		real_t y0 = p_begin.y + dir.y * t_enter;
+		real_t y1 = p_begin.y + dir.y * t_exit;
+		real_t h00 = heights[z * width + x];
+		real_t h10 = heights[z * width + x + 1];
+		real_t h01 = heights[(z + 1) * width + x];
+		real_t h11 = heights[(z + 1) * width + x + 1];
+		real_t cell_min = MIN(MIN(h00, h10), MIN(h01, h11)) + local_origin.y - CMP_EPSILON;
+		real_t cell_max = MAX(MAX(h00, h10), MAX(h01, h11)) + local_origin.y + CMP_EPSILON;
+
+		if (MAX(y0, y1) >= cell_min && MIN(y0, y1) <= cell_max) {
+			if (_intersect_cell(x, z, p_begin, p_end, dist, r_point, r_normal))
+				return true;
+		}
+
+		if (t_exit >= t_max)
+			break;
+
+		if (t_next_x < t_next_z) {
+			x += step_x;
+			t_next_x += t_delta_x;
+		} else {
+			z += step_z;
+			t_next_z += t_delta_z;
+		}
+
+		if (x < 0 || x > width - 2 || z < 0 || z > depth - 2)
+			break;
+
+		t_enter = t_exit;
+	}
+
 	return false;
 }
 
@@ -1600,6 +1834,58 @@ Vector3 HeightMapShapeSW::get_closest_point_to(const Vector3 &p_point) const {
 }
 
 void HeightMapShapeSW::cull(const AABB &p_local_aabb, Callback p_callback, void *p_userdata) const {
+
+	if (width < 2 || depth < 2)
+		return;
+
+	if (!p_local_aabb.intersects(get_aabb()))
+		return;
+
+	Vector3 from = p_local_aabb.position - local_origin;
+	Vector3 to = from + p_local_aabb.size;
+
+	int from_x = CLAMP(int(Math::floor(from.x / cell_size)), 0, width - 2);
+	int to_x = CLAMP(int(Math::floor(to.x / cell_size)), 0, width - 2);
+	int from_z = CLAMP(int(Math::floor(from.z / cell_size)), 0, depth - 2);
+	int to_z = CLAMP(int(Math::floor(to.z / cell_size)), 0, depth - 2);
+
+	FaceShapeSW face; // use this to send in the callback
+	Vector3 points[6];
+
+	for (int cz = from_z / CHUNK_SIZE; cz <= to_z / CHUNK_SIZE; cz++) {
+
+		for (int cx = from_x / CHUNK_SIZE; cx <= to_x / CHUNK_SIZE; cx++) {
+
+			const HeightRange &range = chunks[cz * chunks_x + cx];
+			if (range.max < from.y || range.min > to.y)
+				continue;
+
+			int chunk_to_z = MIN(cz * CHUNK_SIZE + CHUNK_SIZE - 1, to_z);
+			int chunk_to_x = MIN(cx * CHUNK_SIZE + CHUNK_SIZE - 1, to_x);
+
+			for (int z = MAX(cz * CHUNK_SIZE, from_z); z <= chunk_to_z; z++) {
+
+				for (int x = MAX(cx * CHUNK_SIZE, from_x); x <= chunk_to_x; x++) {
+
+					_get_cell_triangles(x, z, points);
+
+					for (int i = 0; i < 6; i += 3) {
+
+						real_t min = MIN(MIN(points[i].y, points[i + 1].y), points[i + 2].y);
+						real_t max = MAX(MAX(points[i].y, points[i + 1].y), points[i + 2].y);
+						if (max < p_local_aabb.position.y || min > p_local_aabb.position.y + p_local_aabb.size.y)
+							continue;
+
+						face.vertex[0] = points[i + 0];
+						face.vertex[1] = points[i + 1];
+						face.vertex[2] = points[i + 2];
+						face.normal = Plane(points[i + 0], points[i + 1], points[i + 2]).normal;
+						p_callback(p_userdata, &face);
+					}
+				}
+			}
+		}
+	}
 }
 
 Vector3 HeightMapShapeSW::get_moment_of_inertia(real_t p_mass) const {
@@ -1613,31 +1899,57 @@ Vector3 HeightMapShapeSW::get_moment_of_inertia(real_t p_mass) const {
 			(p_mass / 3.0) * (extents.y * extents.y + extents.y * extents.y));
 }
 
-void HeightMapShapeSW::_setup(PoolVector<real_t> p_heights, int p_width, int p_depth, real_t p_cell_size) {
+void HeightMapShapeSW::_setup(const Vector<real_t> &p_heights, int p_width, int p_depth, real_t p_cell_size) {
 
 	heights = p_heights;
 	width = p_width;
 	depth = p_depth;
 	cell_size = p_cell_size;
+	local_origin = Vector3((width - 1) * cell_size * -0.5, 0, (depth - 1) * cell_size * -0.5);
 
-	PoolVector<real_t>::Read r = heights.read();
-
-	AABB aabb;
-
-	for (int i = 0; i < depth; i++) {
+	const real_t *r = heights.ptr();
 
-		for (int j = 0; j < width; j++) {
+	real_t min_height = r[0];
+	real_t max_height = r[0];
+	for (int i = 1; i < heights.size(); i++) {
+		min_height = MIN(min_height, r[i]);
+		max_height = MAX(max_height, r[i]);
+	}
 
-			real_t h = r[i * width + j];
+	// height ranges of blocks of cells, lets cull() skip whole blocks at once
+	chunks_x = MAX(width - 1, 1);
+	chunks_x = (chunks_x + CHUNK_SIZE - 1) / CHUNK_SIZE;
+	chunks_z = MAX(depth - 1, 1);
+	chunks_z = (chunks_z + CHUNK_SIZE - 1) / CHUNK_SIZE;
+	chunks.resize(chunks_x * chunks_z);
+	HeightRange *chunksw = chunks.ptrw();
+
+	for (int cz = 0; cz < chunks_z; cz++) {
+
+		for (int cx = 0; cx < chunks_x; cx++) {
+
+			HeightRange range;
+			range.min = 1e20;
+			range.max = -1e20;
+
+			int to_z = MIN(cz * CHUNK_SIZE + CHUNK_SIZE, depth - 1);
+			int to_x = MIN(cx * CHUNK_SIZE + CHUNK_SIZE, width - 1);
+			for (int z = cz * CHUNK_SIZE; z <= to_z; z++) {
+				for (int x = cx * CHUNK_SIZE; x <= to_x; x++) {
+					real_t h = r[z * width + x];
+					range.min = MIN(range.min, h);
+					range.max = MAX(range.max, h);
+				}
+			}
 
-			Vector3 pos(j * cell_size, h, i * cell_size);
-			if (i == 0 || j == 0)
-				aabb.position = pos;
-			else
-				aabb.expand_to(pos);
+			chunksw[cz * chunks_x + cx] = range;
 		}
 	}
 
+	AABB aabb;
+	aabb.position = local_origin + Vector3(0, min_height, 0);
+	aabb.size = Vector3((width - 1) * cell_size, max_height - min_height, (depth - 1) * cell_size);
+
 	configure(aabb);
 }
 
@@ -1647,24 +1959,37 @@ void HeightMapShapeSW::set_data(const Variant &p_data) {
 	Dictionary d = p_data;
 	ERR_FAIL_COND(!d.has("width"));
 	ERR_FAIL_COND(!d.has("depth"));
-	ERR_FAIL_COND(!d.has("cell_size"));
 	ERR_FAIL_COND(!d.has("heights"));
 
 	int width = d["width"];
 	int depth = d["depth"];
-	real_t cell_size = d["cell_size"];
+	real_t cell_size = d.has("cell_size") ? real_t(d["cell_size"]) : real_t(1.0);
 	PoolVector<real_t> heights = d["heights"];
 
 	ERR_FAIL_COND(width <= 0);
 	ERR_FAIL_COND(depth <= 0);
 	ERR_FAIL_COND(cell_size <= CMP_EPSILON);
 	ERR_FAIL_COND(heights.size() != (width * depth));
-	_setup(heights, width, depth, cell_size);
+
+	Vector<real_t> local_heights;
+	local_heights.resize(heights.size());
+	real_t *w = local_heights.ptrw();
+	PoolVector<real_t>::Read r = heights.read();
+	for (int i = 0; i < heights.size(); i++) {
+		w[i] = r[i];
+	}
+
+	_setup(local_heights, width, depth, cell_size);
 }
 
 Variant HeightMapShapeSW::get_data() const {
 
-	ERR_FAIL_V(Variant());
+	Dictionary d;
+	d["width"] = width;
+	d["depth"] = depth;
+	d["cell_size"] = cell_size;
+	d["heights"] = get_heights();
+	return d;
 }
 
 HeightMapShapeSW::HeightMapShapeSW() {
@@ -1672,4 +1997,6 @@ HeightMapShapeSW::HeightMapShapeSW() {
 	width = 0;
 	depth = 0;
 	cell_size = 0;
+	chunks_x = 0;
+	chunks_z = 0;
 }
@@ -285,7 +285,6 @@ public:
 	ConvexPolygonShapeSW();
 };
 
-struct _VolumeSW_BVH;
 struct FaceShapeSW;
 
 struct ConcavePolygonShapeSW : public ConcaveShapeSW {
@@ -297,23 +296,31 @@ struct ConcavePolygonShapeSW : public ConcaveShapeSW {
 		int indices[3];
 	};
 
-	PoolVector<Face> faces;
-	PoolVector<Vector3> vertices;
-
+	// 16 byte node, bounds are quantized to 16 bits per axis inside the shape's AABB
+	// and rounded outwards. The left child of an internal node is the next node,
+	// data holds the index of the right child; for leaves data is ~face_index.
 	struct BVH {
 
-		AABB aabb;
-		int left;
-		int right;
+		uint16_t min[3];
+		uint16_t max[3];
+		int32_t data;
 
-		int face_index;
+		_FORCE_INLINE_ bool is_leaf() const { return data < 0; }
+		_FORCE_INLINE_ int get_face_index() const { return ~data; }
 	};
 
-	PoolVector<BVH> bvh;
+	// Built once in _setup(), never resized afterwards, so reading needs no lock.
+	Vector<Face> faces;
+	Vector<Vector3> vertices;
+	Vector<BVH> bvh;
+
+	Vector3 quantize_scale; // shape space to quantized space
+	Vector3 dequantize_scale;
 
 	struct _CullParams {
 
-		AABB aabb;
+		uint16_t min[3];
+		uint16_t max[3];
 		Callback callback;
 		void *userdata;
 		const Face *faces;
@@ -337,11 +344,12 @@ struct ConcavePolygonShapeSW : public ConcaveShapeSW {
 		int collisions;
 	};
 
+	_FORCE_INLINE_ AABB _get_node_aabb(const BVH &p_node) const;
+	void _quantize_aabb(const AABB &p_aabb, uint16_t *r_min, uint16_t *r_max) const;
+
 	void _cull_segment(int p_idx, _SegmentCullParams *p_params) const;
 	void _cull(int p_idx, _CullParams *p_params) const;
 
-	void _fill_bvh(_VolumeSW_BVH *p_bvh_tree, BVH *p_bvh_array, int &p_idx);
-
 	void _setup(PoolVector<Vector3> p_faces);
 
 public:
@@ -366,17 +374,37 @@ public:
 	ConcavePolygonShapeSW();
 };
 
+// Grid of width x depth heights, spaced cell_size apart and centered on the
+// origin in X and Z like the Bullet heightfield. Triangles are generated on
+// demand, two per cell.
 struct HeightMapShapeSW : public ConcaveShapeSW {
 
-	PoolVector<real_t> heights;
+	enum {
+		CHUNK_SIZE = 16 // cells per side of the blocks with precomputed height ranges
+	};
+
+	struct HeightRange {
+		real_t min;
+		real_t max;
+	};
+
+	Vector<real_t> heights;
 	int width;
 	int depth;
 	real_t cell_size;
+	Vector3 local_origin; // position of height 0, 0
 
-	//void _cull_segment(int p_idx,_SegmentCullParams *p_params) const;
-	//void _cull(int p_idx,_CullParams *p_params) const;
+	Vector<HeightRange> chunks;
+	int chunks_x;
+	int chunks_z;
+
+	_FORCE_INLINE_ Vector3 _get_point(int p_x, int p_z) const {
+		return local_origin + Vector3(p_x * cell_size, heights[p_z * width + p_x], p_z * cell_size);
+	}
+	_FORCE_INLINE_ void _get_cell_triangles(int p_x, int p_z, Vector3 *r_points) const;
+	bool _intersect_cell(int p_x, int p_z, const Vector3 &p_begin, const Vector3 &p_end, real_t &r_dist, Vector3 &r_point, Vector3 &r_normal) const;
 
-	void _setup(PoolVector<real_t> p_heights, int p_width, int p_depth, real_t p_cell_size);
+	void _setup(const Vector<real_t> &p_heights, int p_width, int p_depth, real_t p_cell_size);
 
 public:
 	PoolVector<real_t> get_heights() const;
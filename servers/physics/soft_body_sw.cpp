@@ -0,0 +1,695 @@
+/*************************************************************************/
+/*  soft_body_sw.cpp                                                     */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2019 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2019 Godot Engine contributors (cf. AUTHORS.md)    */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#include "soft_body_sw.h"
+
+#include "core/map.h"
+#include "core/os/thread_work_pool.h"
+#include "scene/3d/soft_body.h"
+#include "scene/resources/mesh.h"
+#include "space_sw.h"
+
+// distance kept between particles and the surfaces they collide with
+static const real_t SOFT_BODY_MARGIN = 0.01;
+// fraction of the tangential velocity removed on contact
+static const real_t SOFT_BODY_FRICTION = 0.5;
+
+void SoftBodySW::set_space(SpaceSW *p_space) {
+
+	if (space == p_space)
+		return;
+
+	if (space) {
+		space->soft_body_remove_from_list(&soft_body_list);
+	}
+
+	space = p_space;
+	colliders.clear();
+
+	if (space) {
+		space->soft_body_add_to_list(&soft_body_list);
+	}
+}
+
+void SoftBodySW::set_mesh(const REF &p_mesh) {
+
+	soft_mesh = p_mesh;
+
+	pos_x.clear();
+	pos_y.clear();
+	pos_z.clear();
+	prev_x.clear();
+	prev_y.clear();
+	prev_z.clear();
+	inv_mass.clear();
+	normals.clear();
+	rest_positions.clear();
+	visual_indices.clear();
+	faces.clear();
+	links.clear();
+	colliders.clear();
+	for (int i = 0; i <= MAX_COLORS; i++) {
+		color_offsets[i] = 0;
+	}
+	aabb = AABB();
+
+	if (soft_mesh.is_null())
+		return;
+
+	ERR_FAIL_COND(soft_mesh->get_surface_count() == 0);
+	ERR_FAIL_COND(!(soft_mesh->surface_get_format(0) & VS::ARRAY_FORMAT_INDEX));
+
+	Array arrays = soft_mesh->surface_get_arrays(0);
+	PoolVector<Vector3> vertices = arrays[VS::ARRAY_VERTEX];
+	PoolVector<int> indices = arrays[VS::ARRAY_INDEX];
+
+	// Vertices split for normals or UVs share a single particle. Points are
+	// numbered in order of first appearance, so pinned point indices picked
+	// in the editor stay valid.
+	Vector<int> vertex_to_point;
+	vertex_to_point.resize(vertices.size());
+	{
+		Map<Vector3, int> unique_points;
+		PoolVector<Vector3>::Read r = vertices.read();
+
+		for (int i = 0; i < vertices.size(); i++) {
+
+			Map<Vector3, int>::Element *E = unique_points.find(r[i]);
+			if (!E) {
+				E = unique_points.insert(r[i], rest_positions.size());
+				rest_positions.push_back(r[i]);
+				visual_indices.push_back(Vector<int>());
+			}
+			vertex_to_point.write[i] = E->get();
+			visual_indices.write[E->get()].push_back(i);
+		}
+	}
+
+	{
+		PoolVector<int>::Read r = indices.read();
+		int triangle_count = indices.size() / 3;
+
+		for (int i = 0; i < triangle_count; i++) {
+
+			int a = vertex_to_point[r[i * 3 + 0]];
+			int b = vertex_to_point[r[i * 3 + 1]];
+			int c = vertex_to_point[r[i * 3 + 2]];
+			if (a == b || b == c || c == a)
+				continue; //degenerate
+
+			faces.push_back(a);
+			faces.push_back(b);
+			faces.push_back(c);
+		}
+	}
+
+	int point_count = rest_positions.size();
+	pos_x.resize(point_count);
+	pos_y.resize(point_count);
+	pos_z.resize(point_count);
+	prev_x.resize(point_count);
+	prev_y.resize(point_count);
+	prev_z.resize(point_count);
+	inv_mass.resize(point_count);
+	normals.resize(point_count);
+
+	_build_links();
+	_update_masses();
+	_reset_positions();
+}
+
+struct _SoftBodyEdgeSW {
+
+	int a;
+	int b;
+	int opposite;
+
+	_FORCE_INLINE_ bool operator<(const _SoftBodyEdgeSW &p_edge) const {
+		return a == p_edge.a ? b < p_edge.b : a < p_edge.a;
+	}
+};
+
+void SoftBodySW::_build_links() {
+
+	Vector<_SoftBodyEdgeSW> edges;
+	edges.resize(faces.size());
+
+	for (int i = 0; i < faces.size(); i += 3) {
+		for (int j = 0; j < 3; j++) {
+
+			int a = faces[i + j];
+			int b = faces[i + (j + 1) % 3];
+
+			_SoftBodyEdgeSW &edge = edges.write[i + j];
+			edge.a = MIN(a, b);
+			edge.b = MAX(a, b);
+			edge.opposite = faces[i + (j + 2) % 3];
+		}
+	}
+
+	edges.sort();
+
+	// one stretch link per edge, plus a bending link between the opposite
+	// points of every other triangle sharing it
+	int first = 0;
+	for (int i = 0; i < edges.size(); i++) {
+
+		Link link;
+		link.rest_length = 0;
+		link.color = 0;
+
+		if (i > 0 && edges[i].a == edges[first].a && edges[i].b == edges[first].b) {
+			link.a = edges[first].opposite;
+			link.b = edges[i].opposite;
+			link.bending = true;
+			if (link.a == link.b)
+				continue;
+		} else {
+			first = i;
+			link.a = edges[i].a;
+			link.b = edges[i].b;
+			link.bending = false;
+		}
+
+		links.push_back(link);
+	}
+
+	// greedy coloring, each point remembers the colors already touching it
+	Vector<uint64_t> point_colors;
+	point_colors.resize(rest_positions.size());
+	for (int i = 0; i < point_colors.size(); i++) {
+		point_colors.write[i] = 0;
+	}
+
+	Link *lw = links.ptrw();
+	for (int i = 0; i < links.size(); i++) {
+
+		uint64_t used = point_colors[lw[i].a] | point_colors[lw[i].b];
+		int color = 0;
+		while (color < SERIAL_COLOR && (used & (uint64_t(1) << color))) {
+			color++;
+		}
+
+		lw[i].color = color;
+		if (color < SERIAL_COLOR) {
+			point_colors.write[lw[i].a] |= uint64_t(1) << color;
+			point_colors.write[lw[i].b] |= uint64_t(1) << color;
+		}
+	}
+
+	links.sort();
+
+	for (int i = 0; i <= MAX_COLORS; i++) {
+		color_offsets[i] = 0;
+	}
+	for (int i = 0; i < links.size(); i++) {
+		color_offsets[links[i].color + 1]++;
+	}
+	for (int i = 0; i < MAX_COLORS; i++) {
+		color_offsets[i + 1] += color_offsets[i];
+	}
+}
+
+void SoftBodySW::_update_masses() {
+
+	int point_count = inv_mass.size();
+	if (!point_count)
+		return;
+
+	real_t point_inv_mass = total_mass > 0 ? point_count / total_mass : 1.0;
+
+	real_t *w = inv_mass.ptrw();
+	for (int i = 0; i < point_count; i++) {
+		w[i] = point_inv_mass;
+	}
+
+	for (int i = 0; i < pinned_points.size(); i++) {
+		if (pinned_points[i] < point_count) {
+			w[pinned_points[i]] = 0;
+		}
+	}
+}
+
+void SoftBodySW::_reset_positions() {
+
+	int point_count = rest_positions.size();
+
+	for (int i = 0; i < point_count; i++) {
+
+		Vector3 p = transform.xform(rest_positions[i]);
+		pos_x.write[i] = prev_x.write[i] = p.x;
+		pos_y.write[i] = prev_y.write[i] = p.y;
+		pos_z.write[i] = prev_z.write[i] = p.z;
+	}
+
+	// rest lengths are measured in world space, so a scaled transform scales the body
+	Link *lw = links.ptrw();
+	for (int i = 0; i < links.size(); i++) {
+		lw[i].rest_length = get_point_position(lw[i].a).distance_to(get_point_position(lw[i].b));
+	}
+
+	_update_normals();
+	_update_aabb();
+}
+
+void SoftBodySW::_update_normals() {
+
+	int point_count = normals.size();
+	Vector3 *nw = normals.ptrw();
+
+	for (int i = 0; i < point_count; i++) {
+		nw[i] = Vector3();
+	}
+
+	for (int i = 0; i < faces.size(); i += 3) {
+
+		Vector3 p0 = get_point_position(faces[i + 0]);
+		Vector3 p1 = get_point_position(faces[i + 1]);
+		Vector3 p2 = get_point_position(faces[i + 2]);
+
+		// same winding as Face3, area weighted
+		Vector3 n = (p0 - p2).cross(p0 - p1);
+		nw[faces[i + 0]] += n;
+		nw[faces[i + 1]] += n;
+		nw[faces[i + 2]] += n;
+	}
+
+	for (int i = 0; i < point_count; i++) {
+		nw[i].normalize();
+	}
+}
+
+void SoftBodySW::_update_aabb() {
+
+	int point_count = inv_mass.size();
+	if (!point_count) {
+		aabb = AABB();
+		return;
+	}
+
+	const real_t *x = pos_x.ptr();
+	const real_t *y = pos_y.ptr();
+	const real_t *z = pos_z.ptr();
+
+	Vector3 min(x[0], y[0], z[0]);
+	Vector3 max = min;
+
+	for (int i = 1; i < point_count; i++) {
+		min.x = MIN(min.x, x[i]);
+		min.y = MIN(min.y, y[i]);
+		min.z = MIN(min.z, z[i]);
+		max.x = MAX(max.x, x[i]);
+		max.y = MAX(max.y, y[i]);
+		max.z = MAX(max.z, z[i]);
+	}
+
+	aabb = AABB(min, max - min);
+}
+
+void SoftBodySW::update_visual_server(SoftBodyVisualServerHandler *p_visual_server_handler) {
+
+	int point_count = inv_mass.size();
+
+	for (int i = 0; i < point_count; i++) {
+
+		// the handler copies three floats, whatever real_t is
+		float vertex[3] = { float(pos_x[i]), float(pos_y[i]), float(pos_z[i]) };
+		float normal[3] = { float(normals[i].x), float(normals[i].y), float(normals[i].z) };
+
+		const Vector<int> &vs_indices = visual_indices[i];
+		for (int j = 0; j < vs_indices.size(); j++) {
+			p_visual_server_handler->set_vertex(vs_indices[j], vertex);
+			p_visual_server_handler->set_normal(vs_indices[j], normal);
+		}
+	}
+
+	p_visual_server_handler->set_aabb(aabb);
+}
+
+void SoftBodySW::set_transform(const Transform &p_transform) {
+
+	transform = p_transform;
+	_reset_positions();
+}
+
+void SoftBodySW::set_simulation_precision(int p_precision) {
+
+	simulation_precision = MAX(p_precision, 1);
+}
+
+void SoftBodySW::set_total_mass(real_t p_total_mass) {
+
+	total_mass = p_total_mass;
+	_update_masses();
+}
+
+void SoftBodySW::move_point(int p_index, const Vector3 &p_global_position) {
+
+	ERR_FAIL_INDEX(p_index, get_point_count());
+
+	pos_x.write[p_index] = prev_x.write[p_index] = p_global_position.x;
+	pos_y.write[p_index] = prev_y.write[p_index] = p_global_position.y;
+	pos_z.write[p_index] = prev_z.write[p_index] = p_global_position.z;
+}
+
+Vector3 SoftBodySW::get_point_offset(int p_index) const {
+
+	ERR_FAIL_INDEX_V(p_index, rest_positions.size(), Vector3());
+	return rest_positions[p_index];
+}
+
+void SoftBodySW::pin_point(int p_index, bool p_pin) {
+
+	ERR_FAIL_COND(p_index < 0);
+
+	int pos = pinned_points.find(p_index);
+	if (p_pin) {
+		if (pos == -1) {
+			pinned_points.push_back(p_index);
+		}
+	} else if (pos != -1) {
+		pinned_points.remove(pos);
+	}
+
+	if (p_index < inv_mass.size()) {
+		inv_mass.write[p_index] = p_pin ? 0 : (total_mass > 0 ? inv_mass.size() / total_mass : 1.0);
+	}
+}
+
+bool SoftBodySW::is_point_pinned(int p_index) const {
+
+	return pinned_points.find(p_index) != -1;
+}
+
+void SoftBodySW::remove_all_pinned_points() {
+
+	pinned_points.clear();
+	_update_masses();
+}
+
+void SoftBodySW::integrate(real_t p_step) {
+
+	colliders.clear();
+
+	int point_count = inv_mass.size();
+	if (!space || !point_count)
+		return;
+
+	AreaSW *default_area = space->get_default_area();
+	Vector3 gravity = default_area->get_gravity_vector() * default_area->get_gravity() * p_step * p_step;
+	real_t keep = 1.0 - damping_coefficient;
+
+	real_t *x = pos_x.ptrw();
+	real_t *y = pos_y.ptrw();
+	real_t *z = pos_z.ptrw();
+	real_t *px = prev_x.ptrw();
+	real_t *py = prev_y.ptrw();
+	real_t *pz = prev_z.ptrw();
+	const real_t *im = inv_mass.ptr();
+
+	Vector3 min(x[0], y[0], z[0]);
+	Vector3 max = min;
+
+	for (int i = 0; i < point_count; i++) {
+
+		min.x = MIN(min.x, x[i]);
+		min.y = MIN(min.y, y[i]);
+		min.z = MIN(min.z, z[i]);
+		max.x = MAX(max.x, x[i]);
+		max.y = MAX(max.y, y[i]);
+		max.z = MAX(max.z, z[i]);
+
+		if (im[i] == 0) {
+			px[i] = x[i];
+			py[i] = y[i];
+			pz[i] = z[i];
+			continue;
+		}
+
+		real_t vx = (x[i] - px[i]) * keep + gravity.x;
+		real_t vy = (y[i] - py[i]) * keep + gravity.y;
+		real_t vz = (z[i] - pz[i]) * keep + gravity.z;
+		px[i] = x[i];
+		py[i] = y[i];
+		pz[i] = z[i];
+		x[i] += vx;
+		y[i] += vy;
+		z[i] += vz;
+
+		min.x = MIN(min.x, x[i]);
+		min.y = MIN(min.y, y[i]);
+		min.z = MIN(min.z, z[i]);
+		max.x = MAX(max.x, x[i]);
+		max.y = MAX(max.y, y[i]);
+		max.z = MAX(max.z, z[i]);
+	}
+
+	AABB swept(min, max - min);
+	swept.grow_by(SOFT_BODY_MARGIN);
+
+	// the broadphase is not thread safe, so colliders are gathered here and
+	// only read while solving
+	CollisionObjectSW *results[MAX_COLLIDERS];
+	int subindices[MAX_COLLIDERS];
+	int amount = space->get_broadphase()->cull_aabb(swept, results, MAX_COLLIDERS, subindices);
+
+	for (int i = 0; i < amount; i++) {
+
+		CollisionObjectSW *co = results[i];
+		int shape_idx = subindices[i];
+
+		if (co->get_type() == CollisionObjectSW::TYPE_AREA)
+			continue;
+		if (!(co->get_collision_layer() & collision_mask))
+			continue;
+		if (exceptions.has(co->get_self()))
+			continue;
+		if (co->is_shape_set_as_disabled(shape_idx))
+			continue;
+
+		Collider collider;
+		collider.shape = co->get_shape(shape_idx);
+		collider.xform = co->get_transform() * co->get_shape_transform(shape_idx);
+		collider.inv_xform = collider.xform.affine_inverse();
+		collider.local_aabb = collider.shape->get_aabb().grow(SOFT_BODY_MARGIN);
+		colliders.push_back(collider);
+	}
+}
+
+void SoftBodySW::_solve_link_range(const Link *p_links, int p_from, int p_to, real_t p_linear_k, real_t p_bending_k) {
+
+	real_t *x = pos_x.ptrw();
+	real_t *y = pos_y.ptrw();
+	real_t *z = pos_z.ptrw();
+	const real_t *im = inv_mass.ptr();
+
+	for (int i = p_from; i < p_to; i++) {
+
+		const Link &link = p_links[i];
+		int a = link.a;
+		int b = link.b;
+
+		real_t w = im[a] + im[b];
+		if (w == 0)
+			continue;
+
+		real_t dx = x[b] - x[a];
+		real_t dy = y[b] - y[a];
+		real_t dz = z[b] - z[a];
+		real_t d = Math::sqrt(dx * dx + dy * dy + dz * dz);
+		if (d < CMP_EPSILON)
+			continue;
+
+		real_t k = link.bending ? p_bending_k : p_linear_k;
+		real_t s = k * (d - link.rest_length) / (d * w);
+
+		x[a] += dx * s * im[a];
+		y[a] += dy * s * im[a];
+		z[a] += dz * s * im[a];
+		x[b] -= dx * s * im[b];
+		y[b] -= dy * s * im[b];
+		z[b] -= dz * s * im[b];
+	}
+}
+
+void SoftBodySW::_solve_links_job(uint32_t p_chunk, SolveData *p_data) {
+
+	int from = p_data->from + p_chunk * LINK_CHUNK_SIZE;
+	int to = MIN(from + LINK_CHUNK_SIZE, p_data->from + p_data->count);
+	_solve_link_range(p_data->links, from, to, p_data->linear_k, p_data->bending_k);
+}
+
+void SoftBodySW::_collide_point_range(int p_from, int p_to) {
+
+	real_t *x = pos_x.ptrw();
+	real_t *y = pos_y.ptrw();
+	real_t *z = pos_z.ptrw();
+	real_t *px = prev_x.ptrw();
+	real_t *py = prev_y.ptrw();
+	real_t *pz = prev_z.ptrw();
+	const real_t *im = inv_mass.ptr();
+	const Collider *cs = colliders.ptr();
+	int collider_count = colliders.size();
+
+	for (int i = p_from; i < p_to; i++) {
+
+		if (im[i] == 0)
+			continue;
+
+		Vector3 pos(x[i], y[i], z[i]);
+		Vector3 prev(px[i], py[i], pz[i]);
+		bool moved = false;
+
+		for (int j = 0; j < collider_count; j++) {
+
+			const Collider &c = cs[j];
+			Vector3 local_to = c.inv_xform.xform(pos);
+			Vector3 local_from = c.inv_xform.xform(prev);
+
+			if (!c.local_aabb.has_point(local_to) && !c.local_aabb.intersects_segment(local_from, local_to))
+				continue;
+
+			Vector3 point, normal;
+			if (c.shape->intersect_segment(local_from, local_to, point, normal)) {
+				// crossed the surface during this step
+				if (normal.dot(local_from - local_to) < 0) {
+					normal = -normal;
+				}
+			} else if (c.shape->intersect_point(local_to)) {
+				// started inside, leave through the closest side along the center direction
+				Vector3 dir = local_to - c.local_aabb.position - c.local_aabb.size * 0.5;
+				if (dir.length_squared() < CMP_EPSILON2) {
+					dir = Vector3(0, 1, 0);
+				}
+				Vector3 outside = local_to + dir.normalized() * c.local_aabb.size.length();
+				if (!c.shape->intersect_segment(outside, local_to, point, normal))
+					continue;
+			} else {
+				continue;
+			}
+
+			pos = c.xform.xform(point + normal * SOFT_BODY_MARGIN);
+
+			// the normal velocity is removed and the tangential part damped
+			Vector3 n = c.xform.basis.xform(normal).normalized();
+			Vector3 v = pos - prev;
+			prev = pos - (v - n * n.dot(v)) * (1.0 - SOFT_BODY_FRICTION);
+			moved = true;
+		}
+
+		if (moved) {
+			x[i] = pos.x;
+			y[i] = pos.y;
+			z[i] = pos.z;
+			px[i] = prev.x;
+			py[i] = prev.y;
+			pz[i] = prev.z;
+		}
+	}
+}
+
+void SoftBodySW::_collide_points_job(uint32_t p_chunk, void *p_unused) {
+
+	int from = p_chunk * POINT_CHUNK_SIZE;
+	_collide_point_range(from, MIN(from + POINT_CHUNK_SIZE, inv_mass.size()));
+}
+
+void SoftBodySW::solve(ThreadWorkPool *p_work_pool, int p_max_threads) {
+
+	int point_count = inv_mass.size();
+	if (!space || !point_count)
+		return;
+
+	bool threaded = p_work_pool && p_max_threads != 1;
+	int iterations = simulation_precision;
+
+	// stiffness is applied once per iteration, spread it so the result does
+	// not depend on the precision
+	SolveData data;
+	data.links = links.ptr();
+	data.linear_k = 1.0 - Math::pow(real_t(1.0 - linear_stiffness), real_t(1.0 / iterations));
+	data.bending_k = 1.0 - Math::pow(real_t(1.0 - areaAngular_stiffness), real_t(1.0 / iterations));
+
+	for (int i = 0; i < iterations; i++) {
+
+		for (int c = 0; c < MAX_COLORS; c++) {
+
+			data.from = color_offsets[c];
+			data.count = color_offsets[c + 1] - data.from;
+
+			if (!data.count)
+				continue;
+
+			if (!threaded || c == SERIAL_COLOR || data.count <= LINK_CHUNK_SIZE) {
+				_solve_link_range(data.links, data.from, data.from + data.count, data.linear_k, data.bending_k);
+			} else {
+				p_work_pool->do_work((data.count + LINK_CHUNK_SIZE - 1) / LINK_CHUNK_SIZE, this, &SoftBodySW::_solve_links_job, &data, p_max_threads);
+			}
+		}
+
+		if (colliders.empty())
+			continue;
+
+		if (!threaded || point_count <= POINT_CHUNK_SIZE) {
+			_collide_point_range(0, point_count);
+		} else {
+			p_work_pool->do_work((point_count + POINT_CHUNK_SIZE - 1) / POINT_CHUNK_SIZE, this, &SoftBodySW::_collide_points_job, (void *)NULL, p_max_threads);
+		}
+	}
+
+	_update_normals();
+	_update_aabb();
+}
+
+SoftBodySW::SoftBodySW() :
+		soft_body_list(this) {
+
+	space = NULL;
+	collision_layer = 1;
+	collision_mask = 1;
+	ray_pickable = true;
+
+	simulation_precision = 5;
+	total_mass = 1;
+	linear_stiffness = 0.5;
+	areaAngular_stiffness = 0.5;
+	volume_stiffness = 0.5;
+	pressure_coefficient = 0;
+	pose_matching_coefficient = 0;
+	damping_coefficient = 0.01;
+	drag_coefficient = 0;
+
+	for (int i = 0; i <= MAX_COLORS; i++) {
+		color_offsets[i] = 0;
+	}
+}
+
+SoftBodySW::~SoftBodySW() {
+}
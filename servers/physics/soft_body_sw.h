@@ -0,0 +1,213 @@
+/*************************************************************************/
+/*  soft_body_sw.h                                                       */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2019 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2019 Godot Engine contributors (cf. AUTHORS.md)    */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#ifndef SOFT_BODY_SW_H
+#define SOFT_BODY_SW_H
+
+#include "core/self_list.h"
+#include "core/vset.h"
+#include "servers/physics_server.h"
+#include "shape_sw.h"
+
+class Mesh;
+class SpaceSW;
+class ThreadWorkPool;
+class SoftBodyVisualServerHandler;
+
+/*
+	Position based soft body. Particles are kept as separate coordinate
+	arrays and every triangle edge (plus a bending link across each shared
+	edge) is a distance constraint. Links are greedily colored so that no two
+	links of the same color share a particle, which lets each color be solved
+	in parallel without locks.
+*/
+
+class SoftBodySW : public RID_Data {
+
+	enum {
+		MAX_COLORS = 64,
+		SERIAL_COLOR = MAX_COLORS - 1, // links that could not be colored are solved on one thread
+		LINK_CHUNK_SIZE = 256,
+		POINT_CHUNK_SIZE = 256,
+		MAX_COLLIDERS = 256
+	};
+
+	struct Link {
+		int a;
+		int b;
+		real_t rest_length;
+		bool bending;
+		uint8_t color;
+
+		_FORCE_INLINE_ bool operator<(const Link &p_link) const { return color < p_link.color; }
+	};
+
+	struct Collider {
+		const ShapeSW *shape;
+		Transform xform;
+		Transform inv_xform;
+		AABB local_aabb;
+	};
+
+	struct SolveData {
+		const Link *links;
+		int from;
+		int count;
+		real_t linear_k;
+		real_t bending_k;
+	};
+
+	RID self;
+	SpaceSW *space;
+	SelfList<SoftBodySW> soft_body_list;
+
+	uint32_t collision_layer;
+	uint32_t collision_mask;
+	VSet<RID> exceptions;
+	bool ray_pickable;
+
+	Ref<Mesh> soft_mesh;
+	Transform transform;
+
+	int simulation_precision;
+	real_t total_mass;
+	real_t linear_stiffness;
+	real_t areaAngular_stiffness;
+	real_t volume_stiffness;
+	real_t pressure_coefficient;
+	real_t pose_matching_coefficient;
+	real_t damping_coefficient;
+	real_t drag_coefficient;
+
+	Vector<real_t> pos_x;
+	Vector<real_t> pos_y;
+	Vector<real_t> pos_z;
+	Vector<real_t> prev_x;
+	Vector<real_t> prev_y;
+	Vector<real_t> prev_z;
+	Vector<real_t> inv_mass;
+	Vector<Vector3> normals;
+	Vector<Vector3> rest_positions;
+	Vector<Vector<int> > visual_indices; // physics point -> visual vertices sharing its position
+	Vector<int> faces;
+	Vector<int> pinned_points;
+
+	Vector<Link> links;
+	int color_offsets[MAX_COLORS + 1];
+
+	Vector<Collider> colliders;
+	AABB aabb;
+
+	void _build_links();
+	void _update_masses();
+	void _reset_positions();
+	void _update_normals();
+	void _update_aabb();
+
+	void _solve_link_range(const Link *p_links, int p_from, int p_to, real_t p_linear_k, real_t p_bending_k);
+	void _solve_links_job(uint32_t p_chunk, SolveData *p_data);
+	void _collide_point_range(int p_from, int p_to);
+	void _collide_points_job(uint32_t p_chunk, void *p_unused);
+
+public:
+	_FORCE_INLINE_ void set_self(const RID &p_self) { self = p_self; }
+	_FORCE_INLINE_ RID get_self() const { return self; }
+
+	void set_space(SpaceSW *p_space);
+	_FORCE_INLINE_ SpaceSW *get_space() const { return space; }
+
+	_FORCE_INLINE_ void set_collision_layer(uint32_t p_layer) { collision_layer = p_layer; }
+	_FORCE_INLINE_ uint32_t get_collision_layer() const { return collision_layer; }
+
+	_FORCE_INLINE_ void set_collision_mask(uint32_t p_mask) { collision_mask = p_mask; }
+	_FORCE_INLINE_ uint32_t get_collision_mask() const { return collision_mask; }
+
+	_FORCE_INLINE_ void add_exception(const RID &p_exception) { exceptions.insert(p_exception); }
+	_FORCE_INLINE_ void remove_exception(const RID &p_exception) { exceptions.erase(p_exception); }
+	_FORCE_INLINE_ bool has_exception(const RID &p_exception) const { return exceptions.has(p_exception); }
+	_FORCE_INLINE_ const VSet<RID> &get_exceptions() const { return exceptions; }
+
+	_FORCE_INLINE_ void set_ray_pickable(bool p_enable) { ray_pickable = p_enable; }
+	_FORCE_INLINE_ bool is_ray_pickable() const { return ray_pickable; }
+
+	void set_mesh(const REF &p_mesh);
+	void update_visual_server(SoftBodyVisualServerHandler *p_visual_server_handler);
+
+	void set_transform(const Transform &p_transform);
+	_FORCE_INLINE_ const Transform &get_transform() const { return transform; }
+
+	void set_simulation_precision(int p_precision);
+	_FORCE_INLINE_ int get_simulation_precision() const { return simulation_precision; }
+
+	void set_total_mass(real_t p_total_mass);
+	_FORCE_INLINE_ real_t get_total_mass() const { return total_mass; }
+
+	_FORCE_INLINE_ void set_linear_stiffness(real_t p_stiffness) { linear_stiffness = CLAMP(p_stiffness, 0, 1); }
+	_FORCE_INLINE_ real_t get_linear_stiffness() const { return linear_stiffness; }
+
+	_FORCE_INLINE_ void set_areaAngular_stiffness(real_t p_stiffness) { areaAngular_stiffness = CLAMP(p_stiffness, 0, 1); }
+	_FORCE_INLINE_ real_t get_areaAngular_stiffness() const { return areaAngular_stiffness; }
+
+	_FORCE_INLINE_ void set_volume_stiffness(real_t p_stiffness) { volume_stiffness = p_stiffness; }
+	_FORCE_INLINE_ real_t get_volume_stiffness() const { return volume_stiffness; }
+
+	_FORCE_INLINE_ void set_pressure_coefficient(real_t p_coefficient) { pressure_coefficient = p_coefficient; }
+	_FORCE_INLINE_ real_t get_pressure_coefficient() const { return pressure_coefficient; }
+
+	_FORCE_INLINE_ void set_pose_matching_coefficient(real_t p_coefficient) { pose_matching_coefficient = p_coefficient; }
+	_FORCE_INLINE_ real_t get_pose_matching_coefficient() const { return pose_matching_coefficient; }
+
+	_FORCE_INLINE_ void set_damping_coefficient(real_t p_coefficient) { damping_coefficient = CLAMP(p_coefficient, 0, 1); }
+	_FORCE_INLINE_ real_t get_damping_coefficient() const { return damping_coefficient; }
+
+	_FORCE_INLINE_ void set_drag_coefficient(real_t p_coefficient) { drag_coefficient = p_coefficient; }
+	_FORCE_INLINE_ real_t get_drag_coefficient() const { return drag_coefficient; }
+
+	_FORCE_INLINE_ int get_point_count() const { return inv_mass.size(); }
+	_FORCE_INLINE_ Vector3 get_point_position(int p_index) const { return Vector3(pos_x[p_index], pos_y[p_index], pos_z[p_index]); }
+	void move_point(int p_index, const Vector3 &p_global_position);
+	Vector3 get_point_offset(int p_index) const;
+
+	void pin_point(int p_index, bool p_pin);
+	bool is_point_pinned(int p_index) const;
+	void remove_all_pinned_points();
+
+	_FORCE_INLINE_ const AABB &get_aabb() const { return aabb; }
+
+	// predicts positions and gathers colliders, must run on the stepping thread
+	void integrate(real_t p_step);
+	// pass a pool to solve each link color on several threads
+	void solve(ThreadWorkPool *p_work_pool = NULL, int p_max_threads = 1);
+
+	SoftBodySW();
+	~SoftBodySW();
+};
+
+#endif // SOFT_BODY_SW_H
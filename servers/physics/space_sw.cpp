@@ -49,6 +49,32 @@ _FORCE_INLINE_ static bool _can_collide_with(CollisionObjectSW *p_object, uint32
 	return true;
 }
 
+_FORCE_INLINE_ static bool _is_recording_history(const CollisionObjectSW *p_object) {
+
+	return p_object->get_type() == CollisionObjectSW::TYPE_BODY && static_cast<const BodySW *>(p_object)->is_recording_history();
+}
+
+// Segment test against one shape of an object, the point is returned in global space.
+_FORCE_INLINE_ static bool _intersect_segment_shape(const CollisionObjectSW *p_object, int p_shape, const Vector3 &p_begin, const Vector3 &p_end, Vector3 &r_point, Vector3 &r_normal) {
+
+	Transform inv_xform = p_object->get_shape_inv_transform(p_shape) * p_object->get_inv_transform();
+
+	Vector3 local_from = inv_xform.xform(p_begin);
+	Vector3 local_to = inv_xform.xform(p_end);
+
+	const ShapeSW *shape = p_object->get_shape(p_shape);
+
+	Vector3 shape_point, shape_normal;
+
+	if (!shape->intersect_segment(local_from, local_to, shape_point, shape_normal))
+		return false;
+
+	Transform xform = p_object->get_transform() * p_object->get_shape_transform(p_shape);
+	r_point = xform.xform(shape_point);
+	r_normal = inv_xform.basis.xform_inv(shape_normal).normalized();
+	return true;
+}
+
 int PhysicsDirectSpaceStateSW::intersect_point(const Vector3 &p_point, ShapeResult *r_results, int p_result_max, const Set<RID> &p_exclude, uint32_t p_collision_mask, bool p_collide_with_bodies, bool p_collide_with_areas) {
 
 	ERR_FAIL_COND_V(space->locked, false);
@@ -73,6 +99,9 @@ int PhysicsDirectSpaceStateSW::intersect_point(const Vector3 &p_point, ShapeResu
 		const CollisionObjectSW *col_obj = space->intersection_query_results[i];
 		int shape_idx = space->intersection_query_subindex_results[i];
 
+		if (rewound && _is_recording_history(col_obj))
+			continue; // Tested below, where it was at that tick.
+
 		Transform inv_xform = col_obj->get_transform() * col_obj->get_shape_transform(shape_idx);
 		inv_xform.affine_invert();
 
@@ -90,6 +119,44 @@ int PhysicsDirectSpaceStateSW::intersect_point(const Vector3 &p_point, ShapeResu
 		cc++;
 	}
 
+	if (!rewound)
+		return cc;
+
+	for (const SelfList<BodySW> *E = space->get_history_list().first(); E && cc < p_result_max; E = E->next()) {
+
+		BodySW *body = E->self();
+		Transform body_xform;
+
+		if (!body->get_history_transform(rewind_tick, space->get_history_tick(), body_xform))
+			continue;
+		if (!_can_collide_with(body, p_collision_mask, p_collide_with_bodies, p_collide_with_areas))
+			continue;
+		if (p_exclude.has(body->get_self()))
+			continue;
+
+		for (int j = 0; j < body->get_shape_count() && cc < p_result_max; j++) {
+
+			if (body->is_shape_set_as_disabled(j))
+				continue;
+
+			Transform inv_xform = body_xform * body->get_shape_transform(j);
+			inv_xform.affine_invert();
+
+			if (!body->get_shape(j)->intersect_point(inv_xform.xform(p_point)))
+				continue;
+
+			r_results[cc].collider_id = body->get_instance_id();
+			if (r_results[cc].collider_id != 0)
+				r_results[cc].collider = ObjectDB::get_instance(r_results[cc].collider_id);
+			else
+				r_results[cc].collider = NULL;
+			r_results[cc].rid = body->get_self();
+			r_results[cc].shape = j;
+
+			cc++;
+		}
+	}
+
 	return cc;
 }
 
@@ -126,20 +193,13 @@ bool PhysicsDirectSpaceStateSW::intersect_ray(const Vector3 &p_from, const Vecto
 
 		const CollisionObjectSW *col_obj = space->intersection_query_results[i];
 
-		int shape_idx = space->intersection_query_subindex_results[i];
-		Transform inv_xform = col_obj->get_shape_inv_transform(shape_idx) * col_obj->get_inv_transform();
-
-		Vector3 local_from = inv_xform.xform(begin);
-		Vector3 local_to = inv_xform.xform(end);
-
-		const ShapeSW *shape = col_obj->get_shape(shape_idx);
+		if (rewound && _is_recording_history(col_obj))
+			continue; // Tested below, where it was at that tick.
 
+		int shape_idx = space->intersection_query_subindex_results[i];
 		Vector3 shape_point, shape_normal;
 
-		if (shape->intersect_segment(local_from, local_to, shape_point, shape_normal)) {
-
-			Transform xform = col_obj->get_transform() * col_obj->get_shape_transform(shape_idx);
-			shape_point = xform.xform(shape_point);
+		if (_intersect_segment_shape(col_obj, shape_idx, begin, end, shape_point, shape_normal)) {
 
 			real_t ld = normal.dot(shape_point);
 
@@ -147,7 +207,7 @@ bool PhysicsDirectSpaceStateSW::intersect_ray(const Vector3 &p_from, const Vecto
 
 				min_d = ld;
 				res_point = shape_point;
-				res_normal = inv_xform.basis.xform_inv(shape_normal).normalized();
+				res_normal = shape_normal;
 				res_shape = shape_idx;
 				res_obj = col_obj;
 				collided = true;
@@ -155,6 +215,52 @@ bool PhysicsDirectSpaceStateSW::intersect_ray(const Vector3 &p_from, const Vecto
 		}
 	}
 
+	for (const SelfList<BodySW> *E = rewound ? space->get_history_list().first() : NULL; E; E = E->next()) {
+
+		BodySW *body = E->self();
+		Transform body_xform;
+
+		if (!body->get_history_transform(rewind_tick, space->get_history_tick(), body_xform))
+			continue;
+		if (!_can_collide_with(body, p_collision_mask, p_collide_with_bodies, p_collide_with_areas))
+			continue;
+		if (p_pick_ray && !body->is_ray_pickable())
+			continue;
+		if (p_exclude.has(body->get_self()))
+			continue;
+
+		for (int j = 0; j < body->get_shape_count(); j++) {
+
+			if (body->is_shape_set_as_disabled(j))
+				continue;
+
+			const ShapeSW *shape = body->get_shape(j);
+			Transform xform = body_xform * body->get_shape_transform(j);
+
+			if (!xform.xform(shape->get_aabb()).intersects_segment(begin, end))
+				continue;
+
+			Transform inv_xform = xform.affine_inverse();
+			Vector3 shape_point, shape_normal;
+
+			if (shape->intersect_segment(inv_xform.xform(begin), inv_xform.xform(end), shape_point, shape_normal)) {
+
+				shape_point = xform.xform(shape_point);
+				real_t ld = normal.dot(shape_point);
+
+				if (ld < min_d) {
+
+					min_d = ld;
+					res_point = shape_point;
+					res_normal = inv_xform.basis.xform_inv(shape_normal).normalized();
+					res_shape = j;
+					res_obj = body;
+					collided = true;
+				}
+			}
+		}
+	}
+
 	if (!collided)
 		return false;
 
@@ -171,6 +277,119 @@ bool PhysicsDirectSpaceStateSW::intersect_ray(const Vector3 &p_from, const Vecto
 	return true;
 }
 
+void PhysicsDirectSpaceStateSW::_ray_batch_job(uint32_t p_index, RayBatch *p_batch) {
+
+	const Vector3 &begin = p_batch->from[p_index];
+	const Vector3 &end = p_batch->to[p_index];
+	Vector3 normal = (end - begin).normalized();
+
+	bool collided = false;
+	Vector3 res_point, res_normal;
+	int res_shape = -1;
+	const CollisionObjectSW *res_obj = NULL;
+	real_t min_d = 1e10;
+
+	for (int i = p_batch->ray_offsets[p_index]; i < p_batch->ray_offsets[p_index + 1]; i++) {
+
+		const RayCandidate &c = p_batch->candidates[i];
+		Vector3 shape_point, shape_normal;
+
+		if (_intersect_segment_shape(c.object, c.shape, begin, end, shape_point, shape_normal)) {
+
+			real_t ld = normal.dot(shape_point);
+
+			if (ld < min_d) {
+
+				min_d = ld;
+				res_point = shape_point;
+				res_normal = shape_normal;
+				res_shape = c.shape;
+				res_obj = c.object;
+				collided = true;
+			}
+		}
+	}
+
+	p_batch->hits[p_index] = collided;
+	if (!collided)
+		return;
+
+	RayResult &r = p_batch->results[p_index];
+	r.collider_id = res_obj->get_instance_id();
+	r.collider = NULL; // Resolved after the threads finish.
+	r.normal = res_normal;
+	r.position = res_point;
+	r.rid = res_obj->get_self();
+	r.shape = res_shape;
+}
+
+int PhysicsDirectSpaceStateSW::intersect_rays_batch(const Vector3 *p_from, const Vector3 *p_to, int p_count, RayResult *r_results, bool *r_hits, const Set<RID> &p_exclude, uint32_t p_collision_mask, bool p_collide_with_bodies, bool p_collide_with_areas) {
+
+	ERR_FAIL_COND_V(space->locked, 0);
+
+	if (rewound) {
+		// History bodies are tested outside the broadphase, one ray at a time.
+		return PhysicsDirectSpaceState::intersect_rays_batch(p_from, p_to, p_count, r_results, r_hits, p_exclude, p_collision_mask, p_collide_with_bodies, p_collide_with_areas);
+	}
+
+	// The broadphase reuses the space's result buffers, so culling stays on this
+	// thread. The filtered candidates are then tested against their shapes in parallel.
+	ray_candidates.resize(0);
+	ray_offsets.resize(p_count + 1);
+
+	for (int i = 0; i < p_count; i++) {
+
+		ray_offsets.write[i] = ray_candidates.size();
+
+		int amount = space->broadphase->cull_segment(p_from[i], p_to[i], space->intersection_query_results, SpaceSW::INTERSECTION_QUERY_MAX, space->intersection_query_subindex_results);
+
+		for (int j = 0; j < amount; j++) {
+
+			CollisionObjectSW *col_obj = space->intersection_query_results[j];
+
+			if (!_can_collide_with(col_obj, p_collision_mask, p_collide_with_bodies, p_collide_with_areas))
+				continue;
+
+			if (p_exclude.has(col_obj->get_self()))
+				continue;
+
+			RayCandidate c;
+			c.object = col_obj;
+			c.shape = space->intersection_query_subindex_results[j];
+			ray_candidates.push_back(c);
+		}
+	}
+	ray_offsets.write[p_count] = ray_candidates.size();
+
+	RayBatch batch;
+	batch.from = p_from;
+	batch.to = p_to;
+	batch.results = r_results;
+	batch.hits = r_hits;
+	batch.candidates = ray_candidates.ptr();
+	batch.ray_offsets = ray_offsets.ptr();
+
+	int thread_count = space->get_solver_thread_count() > 0 ? space->get_solver_thread_count() : -1;
+
+	if (thread_count != 1 && !work_pool.is_initialized()) {
+		work_pool.init();
+	}
+
+	work_pool.do_work(p_count, this, &PhysicsDirectSpaceStateSW::_ray_batch_job, &batch, thread_count);
+
+	int hit_count = 0;
+	for (int i = 0; i < p_count; i++) {
+
+		if (!r_hits[i])
+			continue;
+
+		hit_count++;
+		r_results[i].collider = r_results[i].collider_id != 0 ? ObjectDB::get_instance(r_results[i].collider_id) : NULL;
+	}
+
+	return hit_count;
+}
+
 int PhysicsDirectSpaceStateSW::intersect_shape(const RID &p_shape, const Transform &p_xform, real_t p_margin, ShapeResult *r_results, int p_result_max, const Set<RID> &p_exclude, uint32_t p_collision_mask, bool p_collide_with_bodies, bool p_collide_with_areas) {
 
 	if (p_result_max <= 0)
@@ -203,6 +422,9 @@ int PhysicsDirectSpaceStateSW::intersect_shape(const RID &p_shape, const Transfo
 		const CollisionObjectSW *col_obj = space->intersection_query_results[i];
 		int shape_idx = space->intersection_query_subindex_results[i];
 
+		if (rewound && _is_recording_history(col_obj))
+			continue; // Tested below, where it was at that tick.
+
 		if (!CollisionSolverSW::solve_static(shape, p_xform, col_obj->get_shape(shape_idx), col_obj->get_transform() * col_obj->get_shape_transform(shape_idx), NULL, NULL, NULL, p_margin, 0))
 			continue;
 
@@ -219,11 +441,59 @@ int PhysicsDirectSpaceStateSW::intersect_shape(const RID &p_shape, const Transfo
 		cc++;
 	}
 
+	if (!rewound)
+		return cc;
+
+	aabb = aabb.grow(p_margin);
+
+	for (const SelfList<BodySW> *E = space->get_history_list().first(); E && cc < p_result_max; E = E->next()) {
+
+		BodySW *body = E->self();
+		Transform body_xform;
+
+		if (!body->get_history_transform(rewind_tick, space->get_history_tick(), body_xform))
+			continue;
+		if (!_can_collide_with(body, p_collision_mask, p_collide_with_bodies, p_collide_with_areas))
+			continue;
+		if (p_exclude.has(body->get_self()))
+			continue;
+
+		for (int j = 0; j < body->get_shape_count() && cc < p_result_max; j++) {
+
+			if (body->is_shape_set_as_disabled(j))
+				continue;
+
+			Transform xform = body_xform * body->get_shape_transform(j);
+			if (!aabb.intersects(xform.xform(body->get_shape(j)->get_aabb())))
+				continue;
+
+			if (!CollisionSolverSW::solve_static(shape, p_xform, body->get_shape(j), xform, NULL, NULL, NULL, p_margin, 0))
+				continue;
+
+			if (r_results) {
+				r_results[cc].collider_id = body->get_instance_id();
+				if (r_results[cc].collider_id != 0)
+					r_results[cc].collider = ObjectDB::get_instance(r_results[cc].collider_id);
+				else
+					r_results[cc].collider = NULL;
+				r_results[cc].rid = body->get_self();
+				r_results[cc].shape = j;
+			}
+
+			cc++;
+		}
+	}
+
 	return cc;
 }
 
 bool PhysicsDirectSpaceStateSW::cast_motion(const RID &p_shape, const Transform &p_xform, const Vector3 &p_motion, real_t p_margin, real_t &p_closest_safe, real_t &p_closest_unsafe, const Set<RID> &p_exclude, uint32_t p_collision_mask, bool p_collide_with_bodies, bool p_collide_with_areas, ShapeRestInfo *r_info) {
 
+	if (rewound) {
+		ERR_EXPLAIN("Only point, ray and shape intersection queries are supported at a past tick.");
+		ERR_FAIL_V(false);
+	}
+
 	ShapeSW *shape = static_cast<PhysicsServerSW *>(PhysicsServer::get_singleton())->shape_owner.get(p_shape);
 	ERR_FAIL_COND_V(!shape, false);
 
@@ -330,6 +600,11 @@ bool PhysicsDirectSpaceStateSW::cast_motion(const RID &p_shape, const Transform
 
 bool PhysicsDirectSpaceStateSW::collide_shape(RID p_shape, const Transform &p_shape_xform, real_t p_margin, Vector3 *r_results, int p_result_max, int &r_result_count, const Set<RID> &p_exclude, uint32_t p_collision_mask, bool p_collide_with_bodies, bool p_collide_with_areas) {
 
+	if (rewound) {
+		ERR_EXPLAIN("Only point, ray and shape intersection queries are supported at a past tick.");
+		ERR_FAIL_V(false);
+	}
+
 	if (p_result_max <= 0)
 		return 0;
 
@@ -409,6 +684,11 @@ static void _rest_cbk_result(const Vector3 &p_point_A, const Vector3 &p_point_B,
 }
 bool PhysicsDirectSpaceStateSW::rest_info(RID p_shape, const Transform &p_shape_xform, real_t p_margin, ShapeRestInfo *r_info, const Set<RID> &p_exclude, uint32_t p_collision_mask, bool p_collide_with_bodies, bool p_collide_with_areas) {
 
+	if (rewound) {
+		ERR_EXPLAIN("Only point, ray and shape intersection queries are supported at a past tick.");
+		ERR_FAIL_V(false);
+	}
+
 	ShapeSW *shape = static_cast<PhysicsServerSW *>(PhysicsServer::get_singleton())->shape_owner.get(p_shape);
 	ERR_FAIL_COND_V(!shape, 0);
 
@@ -506,6 +786,8 @@ Vector3 PhysicsDirectSpaceStateSW::get_closest_point_to_object_volume(RID p_obje
 PhysicsDirectSpaceStateSW::PhysicsDirectSpaceStateSW() {
 
 	space = NULL;
+	rewound = false;
+	rewind_tick = 0;
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -1052,10 +1334,12 @@ const SelfList<BodySW>::List &SpaceSW::get_active_body_list() const {
 void SpaceSW::body_add_to_active_list(SelfList<BodySW> *p_body) {
 
 	active_list.add(p_body);
+	islands_valid = false;
 }
 void SpaceSW::body_remove_from_active_list(SelfList<BodySW> *p_body) {
 
 	active_list.remove(p_body);
+	islands_valid = false;
 }
 
 void SpaceSW::body_add_to_inertia_update_list(SelfList<BodySW> *p_body) {
@@ -1099,6 +1383,17 @@ void SpaceSW::body_remove_from_state_query_list(SelfList<BodySW> *p_body) {
 	state_query_list.remove(p_body);
 }
 
+void SpaceSW::body_add_to_history_list(SelfList<BodySW> *p_body) {
+
+	p_body->self()->reset_history(history_size, history_tick + 1);
+	history_list.add(p_body);
+}
+void SpaceSW::body_remove_from_history_list(SelfList<BodySW> *p_body) {
+
+	history_list.remove(p_body);
+	p_body->self()->reset_history(0, 0);
+}
+
 void SpaceSW::area_add_to_monitor_query_list(SelfList<AreaSW> *p_area) {
 
 	monitor_query_list.add(p_area);
@@ -1123,6 +1418,35 @@ const SelfList<AreaSW>::List &SpaceSW::get_moved_area_list() const {
 	return area_moved_list;
 }
 
+void SpaceSW::set_cached_islands(BodySW *p_island_list, ConstraintSW *p_constraint_island_list) {
+
+	cached_island_list = p_island_list;
+	cached_island_constraints.clear();
+	cached_island_sizes.clear();
+
+	for (ConstraintSW *ci = p_constraint_island_list; ci; ci = ci->get_island_list_next()) {
+
+		int size = 0;
+		for (ConstraintSW *c = ci; c; c = c->get_island_next()) {
+			cached_island_constraints.push_back(c);
+			size++;
+		}
+		cached_island_sizes.push_back(size);
+	}
+
+	islands_valid = true;
+}
+
+void SpaceSW::soft_body_add_to_list(SelfList<SoftBodySW> *p_soft_body) {
+
+	soft_body_list.add(p_soft_body);
+}
+
+void SpaceSW::soft_body_remove_from_list(SelfList<SoftBodySW> *p_soft_body) {
+
+	soft_body_list.remove(p_soft_body);
+}
+
 void SpaceSW::call_queries() {
 
 	while (state_query_list.first()) {
@@ -1167,6 +1491,8 @@ void SpaceSW::set_param(PhysicsServer::SpaceParameter p_param, real_t p_value) {
 		case PhysicsServer::SPACE_PARAM_BODY_ANGULAR_VELOCITY_DAMP_RATIO: body_angular_velocity_damp_ratio = p_value; break;
 		case PhysicsServer::SPACE_PARAM_CONSTRAINT_DEFAULT_BIAS: constraint_bias = p_value; break;
 		case PhysicsServer::SPACE_PARAM_TEST_MOTION_MIN_CONTACT_DEPTH: test_motion_min_contact_depth = p_value; break;
+		case PhysicsServer::SPACE_PARAM_SOLVER_THREAD_COUNT: solver_thread_count = MAX(int(p_value), 0); break;
+		case PhysicsServer::SPACE_PARAM_CONTACT_CACHE_THRESHOLD: contact_cache_threshold = MAX(p_value, 0); break;
 	}
 }
 
@@ -1183,6 +1509,8 @@ real_t SpaceSW::get_param(PhysicsServer::SpaceParameter p_param) const {
 		case PhysicsServer::SPACE_PARAM_BODY_ANGULAR_VELOCITY_DAMP_RATIO: return body_angular_velocity_damp_ratio;
 		case PhysicsServer::SPACE_PARAM_CONSTRAINT_DEFAULT_BIAS: return constraint_bias;
 		case PhysicsServer::SPACE_PARAM_TEST_MOTION_MIN_CONTACT_DEPTH: return test_motion_min_contact_depth;
+		case PhysicsServer::SPACE_PARAM_SOLVER_THREAD_COUNT: return solver_thread_count;
+		case PhysicsServer::SPACE_PARAM_CONTACT_CACHE_THRESHOLD: return contact_cache_threshold;
 	}
 	return 0;
 }
@@ -1207,6 +1535,40 @@ PhysicsDirectSpaceStateSW *SpaceSW::get_direct_state() {
 	return direct_access;
 }
 
+void SpaceSW::set_history_size(int p_ticks) {
+
+	ERR_FAIL_COND(p_ticks < 0);
+	history_size = p_ticks;
+
+	// Past transforms are lost, recording starts again with the next tick.
+	for (SelfList<BodySW> *E = history_list.first(); E; E = E->next()) {
+		E->self()->reset_history(history_size, history_tick + 1);
+	}
+}
+
+bool SpaceSW::has_history_tick(uint64_t p_tick) const {
+
+	return history_size > 0 && p_tick <= history_tick && history_tick - p_tick < (uint64_t)history_size;
+}
+
+void SpaceSW::record_history() {
+
+	history_tick++;
+
+	if (history_size == 0)
+		return;
+
+	for (SelfList<BodySW> *E = history_list.first(); E; E = E->next()) {
+		E->self()->store_history(history_tick);
+	}
+}
+
+PhysicsDirectSpaceStateSW *SpaceSW::get_direct_state_at_tick(uint64_t p_tick) {
+
+	history_access->rewind_tick = p_tick;
+	return history_access;
+}
+
 SpaceSW::SpaceSW() {
 
 	collision_pairs = 0;
@@ -1214,6 +1576,9 @@ SpaceSW::SpaceSW() {
 	island_count = 0;
 	contact_debug_count = 0;
 
+	islands_valid = false;
+	cached_island_list = NULL;
+
 	locked = false;
 	contact_recycle_radius = 0.01;
 	contact_max_separation = 0.05;
@@ -1226,6 +1591,10 @@ SpaceSW::SpaceSW() {
 	body_time_to_sleep = GLOBAL_DEF("physics/3d/time_before_sleep", 0.5);
 	ProjectSettings::get_singleton()->set_custom_property_info("physics/3d/time_before_sleep", PropertyInfo(Variant::REAL, "physics/3d/time_before_sleep", PROPERTY_HINT_RANGE, "0,5,0.01,or_greater"));
 	body_angular_velocity_damp_ratio = 10;
+	solver_thread_count = MAX(int(GLOBAL_DEF("physics/3d/godot_physics/solver_thread_count", 1)), 0);
+	ProjectSettings::get_singleton()->set_custom_property_info("physics/3d/godot_physics/solver_thread_count", PropertyInfo(Variant::INT, "physics/3d/godot_physics/solver_thread_count", PROPERTY_HINT_RANGE, "0,64,1"));
+	contact_cache_threshold = MAX(real_t(GLOBAL_DEF("physics/3d/godot_physics/contact_cache_threshold", 0.001)), 0);
+	ProjectSettings::get_singleton()->set_custom_property_info("physics/3d/godot_physics/contact_cache_threshold", PropertyInfo(Variant::REAL, "physics/3d/godot_physics/contact_cache_threshold", PROPERTY_HINT_RANGE, "0,0.1,0.0001"));
 
 	broadphase = BroadPhaseSW::create_func();
 	broadphase->set_pair_callback(_broadphase_pair, this);
@@ -1235,6 +1604,12 @@ SpaceSW::SpaceSW() {
 	direct_access = memnew(PhysicsDirectSpaceStateSW);
 	direct_access->space = this;
 
+	history_access = memnew(PhysicsDirectSpaceStateSW);
+	history_access->space = this;
+	history_access->rewound = true;
+	history_size = 0;
+	history_tick = 0;
+
 	for (int i = 0; i < ELAPSED_TIME_MAX; i++)
 		elapsed_time[i] = 0;
 }
@@ -1243,4 +1618,5 @@ SpaceSW::~SpaceSW() {
 
 	memdelete(broadphase);
 	memdelete(direct_access);
+	memdelete(history_access);
 }
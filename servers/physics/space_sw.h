@@ -38,18 +38,46 @@
 #include "broad_phase_sw.h"
 #include "collision_object_sw.h"
 #include "core/hash_map.h"
+#include "core/os/thread_work_pool.h"
 #include "core/project_settings.h"
 #include "core/typedefs.h"
+#include "soft_body_sw.h"
 
 class PhysicsDirectSpaceStateSW : public PhysicsDirectSpaceState {
 
 	GDCLASS(PhysicsDirectSpaceStateSW, PhysicsDirectSpaceState);
 
+	// Broadphase candidates of every ray in a batch, ray i owns [ray_offsets[i], ray_offsets[i + 1]).
+	struct RayCandidate {
+		const CollisionObjectSW *object;
+		int shape;
+	};
+
+	struct RayBatch {
+		const Vector3 *from;
+		const Vector3 *to;
+		RayResult *results;
+		bool *hits;
+		const RayCandidate *candidates;
+		const int *ray_offsets;
+	};
+
+	Vector<RayCandidate> ray_candidates;
+	Vector<int> ray_offsets;
+	ThreadWorkPool work_pool;
+
+	void _ray_batch_job(uint32_t p_index, RayBatch *p_batch);
+
 public:
 	SpaceSW *space;
 
+	// Queries against the transforms recorded at a past tick, see SpaceSW::set_history_size().
+	bool rewound;
+	uint64_t rewind_tick;
+
 	virtual int intersect_point(const Vector3 &p_point, ShapeResult *r_results, int p_result_max, const Set<RID> &p_exclude = Set<RID>(), uint32_t p_collision_mask = 0xFFFFFFFF, bool p_collide_with_bodies = true, bool p_collide_with_areas = false);
 	virtual bool intersect_ray(const Vector3 &p_from, const Vector3 &p_to, RayResult &r_result, const Set<RID> &p_exclude = Set<RID>(), uint32_t p_collision_mask = 0xFFFFFFFF, bool p_collide_with_bodies = true, bool p_collide_with_areas = false, bool p_pick_ray = false);
+	virtual int intersect_rays_batch(const Vector3 *p_from, const Vector3 *p_to, int p_count, RayResult *r_results, bool *r_hits, const Set<RID> &p_exclude = Set<RID>(), uint32_t p_collision_mask = 0xFFFFFFFF, bool p_collide_with_bodies = true, bool p_collide_with_areas = false);
 	virtual int intersect_shape(const RID &p_shape, const Transform &p_xform, real_t p_margin, ShapeResult *r_results, int p_result_max, const Set<RID> &p_exclude = Set<RID>(), uint32_t p_collision_mask = 0xFFFFFFFF, bool p_collide_with_bodies = true, bool p_collide_with_areas = false);
 	virtual bool cast_motion(const RID &p_shape, const Transform &p_xform, const Vector3 &p_motion, real_t p_margin, real_t &p_closest_safe, real_t &p_closest_unsafe, const Set<RID> &p_exclude = Set<RID>(), uint32_t p_collision_mask = 0xFFFFFFFF, bool p_collide_with_bodies = true, bool p_collide_with_areas = false, ShapeRestInfo *r_info = NULL);
 	virtual bool collide_shape(RID p_shape, const Transform &p_shape_xform, real_t p_margin, Vector3 *r_results, int p_result_max, int &r_result_count, const Set<RID> &p_exclude = Set<RID>(), uint32_t p_collision_mask = 0xFFFFFFFF, bool p_collide_with_bodies = true, bool p_collide_with_areas = false);
@@ -68,6 +96,7 @@ public:
 		ELAPSED_TIME_SETUP_CONSTRAINTS,
 		ELAPSED_TIME_SOLVE_CONSTRAINTS,
 		ELAPSED_TIME_INTEGRATE_VELOCITIES,
+		ELAPSED_TIME_BROADPHASE,
 		ELAPSED_TIME_MAX
 
 	};
@@ -84,6 +113,19 @@ private:
 	SelfList<BodySW>::List state_query_list;
 	SelfList<AreaSW>::List monitor_query_list;
 	SelfList<AreaSW>::List area_moved_list;
+	SelfList<BodySW>::List history_list;
+	SelfList<SoftBodySW>::List soft_body_list;
+
+	// islands found by the last traversal of the constraint graph, they stay
+	// valid until a constraint, an active body or a body mode changes
+	bool islands_valid;
+	BodySW *cached_island_list;
+	Vector<ConstraintSW *> cached_island_constraints; // all islands, back to back
+	Vector<int> cached_island_sizes;
+
+	PhysicsDirectSpaceStateSW *history_access;
+	int history_size;
+	uint64_t history_tick;
 
 	static void *_broadphase_pair(CollisionObjectSW *A, int p_subindex_A, CollisionObjectSW *B, int p_subindex_B, void *p_self);
 	static void _broadphase_unpair(CollisionObjectSW *A, int p_subindex_A, CollisionObjectSW *B, int p_subindex_B, void *p_data, void *p_self);
@@ -97,6 +139,8 @@ private:
 	real_t contact_max_allowed_penetration;
 	real_t constraint_bias;
 	real_t test_motion_min_contact_depth;
+	int solver_thread_count;
+	real_t contact_cache_threshold;
 
 	enum {
 
@@ -142,12 +186,27 @@ public:
 	void body_add_to_state_query_list(SelfList<BodySW> *p_body);
 	void body_remove_from_state_query_list(SelfList<BodySW> *p_body);
 
+	void body_add_to_history_list(SelfList<BodySW> *p_body);
+	void body_remove_from_history_list(SelfList<BodySW> *p_body);
+	_FORCE_INLINE_ const SelfList<BodySW>::List &get_history_list() const { return history_list; }
+
 	void area_add_to_monitor_query_list(SelfList<AreaSW> *p_area);
 	void area_remove_from_monitor_query_list(SelfList<AreaSW> *p_area);
 	void area_add_to_moved_list(SelfList<AreaSW> *p_area);
 	void area_remove_from_moved_list(SelfList<AreaSW> *p_area);
 	const SelfList<AreaSW>::List &get_moved_area_list() const;
 
+	_FORCE_INLINE_ void invalidate_islands() { islands_valid = false; }
+	_FORCE_INLINE_ bool are_islands_valid() const { return islands_valid; }
+	void set_cached_islands(BodySW *p_island_list, ConstraintSW *p_constraint_island_list);
+	_FORCE_INLINE_ BodySW *get_cached_island_list() const { return cached_island_list; }
+	_FORCE_INLINE_ const Vector<ConstraintSW *> &get_cached_island_constraints() const { return cached_island_constraints; }
+	_FORCE_INLINE_ const Vector<int> &get_cached_island_sizes() const { return cached_island_sizes; }
+
+	void soft_body_add_to_list(SelfList<SoftBodySW> *p_soft_body);
+	void soft_body_remove_from_list(SelfList<SoftBodySW> *p_soft_body);
+	_FORCE_INLINE_ const SelfList<SoftBodySW>::List &get_soft_body_list() const { return soft_body_list; }
+
 	BroadPhaseSW *get_broadphase();
 
 	void add_object(CollisionObjectSW *p_object);
@@ -162,6 +221,8 @@ public:
 	_FORCE_INLINE_ real_t get_body_angular_velocity_sleep_threshold() const { return body_angular_velocity_sleep_threshold; }
 	_FORCE_INLINE_ real_t get_body_time_to_sleep() const { return body_time_to_sleep; }
 	_FORCE_INLINE_ real_t get_body_angular_velocity_damp_ratio() const { return body_angular_velocity_damp_ratio; }
+	_FORCE_INLINE_ int get_solver_thread_count() const { return solver_thread_count; }
+	_FORCE_INLINE_ real_t get_contact_cache_threshold() const { return contact_cache_threshold; }
 
 	void update();
 	void setup();
@@ -184,6 +245,13 @@ public:
 
 	PhysicsDirectSpaceStateSW *get_direct_state();
 
+	void set_history_size(int p_ticks);
+	int get_history_size() const { return history_size; }
+	uint64_t get_history_tick() const { return history_tick; }
+	bool has_history_tick(uint64_t p_tick) const;
+	void record_history();
+	PhysicsDirectSpaceStateSW *get_direct_state_at_tick(uint64_t p_tick);
+
 	void set_debug_contacts(int p_amount) { contact_debug.resize(p_amount); }
 	_FORCE_INLINE_ bool is_debugging_contacts() const { return !contact_debug.empty(); }
 	_FORCE_INLINE_ void add_debug_contact(const Vector3 &p_contact) {
@@ -59,6 +59,18 @@ void StepSW::_populate_island(BodySW *p_body, BodySW **p_island, ConstraintSW **
 	}
 }
 
+bool StepSW::_is_island_setup_thread_safe(ConstraintSW *p_island) const {
+
+	ConstraintSW *ci = p_island;
+	while (ci) {
+		if (!ci->is_setup_thread_safe())
+			return false;
+		ci = ci->get_island_next();
+	}
+
+	return true;
+}
+
 void StepSW::_setup_island(ConstraintSW *p_island, real_t p_delta) {
 
 	ConstraintSW *ci = p_island;
@@ -107,6 +119,16 @@ void StepSW::_solve_island(ConstraintSW *p_island, int p_iterations, real_t p_de
 	}
 }
 
+void StepSW::_setup_island_job(uint32_t p_index, IslandStepData *p_data) {
+
+	_setup_island(threaded_setup_islands[p_index], p_data->delta);
+}
+
+void StepSW::_solve_island_job(uint32_t p_index, IslandStepData *p_data) {
+
+	_solve_island(constraint_islands[p_index], p_data->iterations, p_data->delta);
+}
+
 void StepSW::_check_suspend(BodySW *p_island, real_t p_delta) {
 
 	bool can_sleep = true;
@@ -144,6 +166,11 @@ void StepSW::_check_suspend(BodySW *p_island, real_t p_delta) {
 	}
 }
 
+void StepSW::_solve_soft_body_job(uint32_t p_index, void *p_unused) {
+
+	soft_bodies[p_index]->solve();
+}
+
 void StepSW::step(SpaceSW *p_space, real_t p_delta, int p_iterations) {
 
 	p_space->lock(); // can't access space during this
@@ -179,29 +206,67 @@ void StepSW::step(SpaceSW *p_space, real_t p_delta, int p_iterations) {
 
 	BodySW *island_list = NULL;
 	ConstraintSW *constraint_island_list = NULL;
-	b = body_list->first();
 
 	int island_count = 0;
 
-	while (b) {
-		BodySW *body = b->self();
+	if (p_space->are_islands_valid()) {
+
+		// nothing joined or split the islands since they were built, relink
+		// the constraint chains (solving reorders them) instead of walking
+		// the constraint graph again
+		island_list = p_space->get_cached_island_list();
 
-		if (body->get_island_step() != _step) {
+		ConstraintSW *const *constraints = p_space->get_cached_island_constraints().ptr();
+		const int *sizes = p_space->get_cached_island_sizes().ptr();
+		island_count = p_space->get_cached_island_sizes().size();
 
-			BodySW *island = NULL;
-			ConstraintSW *constraint_island = NULL;
-			_populate_island(body, &island, &constraint_island);
+		ConstraintSW *last_island = NULL;
+		int idx = 0;
+		for (int i = 0; i < island_count; i++) {
 
-			island->set_island_list_next(island_list);
-			island_list = island;
+			ConstraintSW *island = constraints[idx];
+			for (int j = 0; j < sizes[i]; j++) {
+				ConstraintSW *c = constraints[idx + j];
+				c->set_island_step(_step);
+				c->set_island_next(j + 1 < sizes[i] ? constraints[idx + j + 1] : NULL);
+			}
+			idx += sizes[i];
 
-			if (constraint_island) {
-				constraint_island->set_island_list_next(constraint_island_list);
-				constraint_island_list = constraint_island;
-				island_count++;
+			island->set_island_list_next(NULL);
+			if (last_island) {
+				last_island->set_island_list_next(island);
+			} else {
+				constraint_island_list = island;
 			}
+			last_island = island;
 		}
-		b = b->next();
+
+	} else {
+
+		b = body_list->first();
+
+		while (b) {
+			BodySW *body = b->self();
+
+			if (body->get_island_step() != _step) {
+
+				BodySW *island = NULL;
+				ConstraintSW *constraint_island = NULL;
+				_populate_island(body, &island, &constraint_island);
+
+				island->set_island_list_next(island_list);
+				island_list = island;
+
+				if (constraint_island) {
+					constraint_island->set_island_list_next(constraint_island_list);
+					constraint_island_list = constraint_island;
+					island_count++;
+				}
+			}
+			b = b->next();
+		}
+
+		p_space->set_cached_islands(island_list, constraint_island_list);
 	}
 
 	p_space->set_island_count(island_count);
@@ -230,7 +295,50 @@ void StepSW::step(SpaceSW *p_space, real_t p_delta, int p_iterations) {
 
 	/* SETUP CONSTRAINT ISLANDS */
 
-	{
+	//islands don't share dynamic bodies, so they can be set up and solved in parallel
+	int thread_count = p_space->get_solver_thread_count() > 0 ? p_space->get_solver_thread_count() : -1;
+	bool threaded = thread_count != 1 && !p_space->is_debugging_contacts(); //debug contacts are written to the space
+
+	if (threaded) {
+
+		if (!work_pool.is_initialized()) {
+			work_pool.init();
+		}
+
+		int count = 0;
+		for (ConstraintSW *ci = constraint_island_list; ci; ci = ci->get_island_list_next()) {
+			count++;
+		}
+
+		threaded = count > 1 && work_pool.get_thread_count() > 0;
+
+		if (threaded) {
+			constraint_islands.resize(count);
+			threaded_setup_islands.resize(count);
+			ConstraintSW **islands = constraint_islands.ptrw();
+			ConstraintSW **setup_islands = threaded_setup_islands.ptrw();
+
+			int setup_count = 0;
+			int idx = 0;
+			for (ConstraintSW *ci = constraint_island_list; ci; ci = ci->get_island_list_next()) {
+
+				islands[idx++] = ci;
+
+				if (_is_island_setup_thread_safe(ci)) {
+					setup_islands[setup_count++] = ci;
+				} else {
+					_setup_island(ci, p_delta);
+				}
+			}
+
+			IslandStepData data;
+			data.delta = p_delta;
+			data.iterations = p_iterations;
+			work_pool.do_work(setup_count, this, &StepSW::_setup_island_job, &data, thread_count);
+		}
+	}
+
+	if (!threaded) {
 		ConstraintSW *ci = constraint_island_list;
 		while (ci) {
 
@@ -247,7 +355,12 @@ void StepSW::step(SpaceSW *p_space, real_t p_delta, int p_iterations) {
 
 	/* SOLVE CONSTRAINT ISLANDS */
 
-	{
+	if (threaded) {
+		IslandStepData data;
+		data.delta = p_delta;
+		data.iterations = p_iterations;
+		work_pool.do_work(constraint_islands.size(), this, &StepSW::_solve_island_job, &data, thread_count);
+	} else {
 		ConstraintSW *ci = constraint_island_list;
 		while (ci) {
 			//iterating each island separatedly improves cache efficiency
@@ -282,13 +395,46 @@ void StepSW::step(SpaceSW *p_space, real_t p_delta, int p_iterations) {
 		}
 	}
 
+	/* SOFT BODIES */
+
+	const SelfList<SoftBodySW> *sb = p_space->get_soft_body_list().first();
+	if (sb) {
+
+		soft_bodies.clear();
+		while (sb) {
+			sb->self()->integrate(p_delta);
+			soft_bodies.push_back(sb->self());
+			sb = sb->next();
+		}
+
+		if (thread_count != 1 && !work_pool.is_initialized()) {
+			work_pool.init();
+		}
+
+		// several bodies are solved one per thread, a lone body splits its own link colors
+		if (soft_bodies.size() > 1) {
+			work_pool.do_work(soft_bodies.size(), this, &StepSW::_solve_soft_body_job, (void *)NULL, thread_count);
+		} else {
+			soft_bodies[0]->solve(&work_pool, thread_count);
+		}
+	}
+
 	{ //profile
 		profile_endtime = OS::get_singleton()->get_ticks_usec();
 		p_space->set_elapsed_time(SpaceSW::ELAPSED_TIME_INTEGRATE_VELOCITIES, profile_endtime - profile_begtime);
 		profile_begtime = profile_endtime;
 	}
 
+	/* BROADPHASE */
+
 	p_space->update();
+
+	{ //profile
+		profile_endtime = OS::get_singleton()->get_ticks_usec();
+		p_space->set_elapsed_time(SpaceSW::ELAPSED_TIME_BROADPHASE, profile_endtime - profile_begtime);
+		profile_begtime = profile_endtime;
+	}
+
 	p_space->unlock();
 	_step++;
 }
@@ -297,3 +443,8 @@ StepSW::StepSW() {
 
 	_step = 1;
 }
+
+StepSW::~StepSW() {
+
+	work_pool.finish();
+}
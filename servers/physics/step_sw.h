@@ -33,18 +33,35 @@
 
 #include "space_sw.h"
 
+#include "core/os/thread_work_pool.h"
+
 class StepSW {
 
 	uint64_t _step;
 
+	struct IslandStepData {
+		real_t delta;
+		int iterations;
+	};
+
+	ThreadWorkPool work_pool;
+	Vector<ConstraintSW *> constraint_islands;
+	Vector<ConstraintSW *> threaded_setup_islands;
+	Vector<SoftBodySW *> soft_bodies;
+
 	void _populate_island(BodySW *p_body, BodySW **p_island, ConstraintSW **p_constraint_island);
+	bool _is_island_setup_thread_safe(ConstraintSW *p_island) const;
 	void _setup_island(ConstraintSW *p_island, real_t p_delta);
 	void _solve_island(ConstraintSW *p_island, int p_iterations, real_t p_delta);
+	void _setup_island_job(uint32_t p_index, IslandStepData *p_data);
+	void _solve_island_job(uint32_t p_index, IslandStepData *p_data);
 	void _check_suspend(BodySW *p_island, real_t p_delta);
+	void _solve_soft_body_job(uint32_t p_index, void *p_unused);
 
 public:
 	void step(SpaceSW *p_space, real_t p_delta, int p_iterations);
 	StepSW();
+	~StepSW();
 };
 
 #endif // STEP__SW_H
@@ -46,6 +46,7 @@ class AreaPair2DSW : public Constraint2DSW {
 public:
 	bool setup(real_t p_step);
 	void solve(real_t p_step);
+	bool is_setup_thread_safe() const { return false; } // updates area queries
 
 	AreaPair2DSW(Body2DSW *p_body, int p_body_shape, Area2DSW *p_area, int p_area_shape);
 	~AreaPair2DSW();
@@ -62,6 +63,7 @@ class Area2Pair2DSW : public Constraint2DSW {
 public:
 	bool setup(real_t p_step);
 	void solve(real_t p_step);
+	bool is_setup_thread_safe() const { return false; } // updates area queries
 
 	Area2Pair2DSW(Area2DSW *p_area_a, int p_shape_a, Area2DSW *p_area_b, int p_shape_b);
 	~Area2Pair2DSW();
@@ -174,6 +174,10 @@ void Body2DSW::set_param(Physics2DServer::BodyParameter p_param, real_t p_value)
 
 			angular_damp = p_value;
 		} break;
+		case Physics2DServer::BODY_PARAM_CCD_MOTION_THRESHOLD: {
+
+			ccd_motion_threshold = p_value;
+		} break;
 		default: {}
 	}
 }
@@ -206,6 +210,10 @@ real_t Body2DSW::get_param(Physics2DServer::BodyParameter p_param) const {
 
 			return angular_damp;
 		} break;
+		case Physics2DServer::BODY_PARAM_CCD_MOTION_THRESHOLD: {
+
+			return ccd_motion_threshold;
+		} break;
 		default: {}
 	}
 
@@ -687,6 +695,7 @@ Body2DSW::Body2DSW() :
 
 	still_time = 0;
 	continuous_cd_mode = Physics2DServer::CCD_MODE_DISABLED;
+	ccd_motion_threshold = 0;
 	can_sleep = false;
 	fi_callback = NULL;
 }
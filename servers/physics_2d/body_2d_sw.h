@@ -33,6 +33,7 @@
 
 #include "area_2d_sw.h"
 #include "collision_object_2d_sw.h"
+#include "core/local_vector.h"
 #include "core/vset.h"
 
 class Constraint2DSW;
@@ -74,6 +75,7 @@ class Body2DSW : public CollisionObject2DSW {
 
 	VSet<RID> exceptions;
 	Physics2DServer::CCDMode continuous_cd_mode;
+	real_t ccd_motion_threshold;
 	bool omit_force_integration;
 	bool active;
 	bool can_sleep;
@@ -113,7 +115,7 @@ class Body2DSW : public CollisionObject2DSW {
 		Vector2 collider_velocity_at_pos;
 	};
 
-	Vector<Contact> contacts; //no contacts by default
+	LocalVector<Contact> contacts; //no contacts by default
 	int contact_count;
 
 	struct ForceIntegrationCallback {
@@ -259,6 +261,7 @@ public:
 
 	_FORCE_INLINE_ void set_continuous_collision_detection_mode(Physics2DServer::CCDMode p_mode) { continuous_cd_mode = p_mode; }
 	_FORCE_INLINE_ Physics2DServer::CCDMode get_continuous_collision_detection_mode() const { return continuous_cd_mode; }
+	_FORCE_INLINE_ real_t get_ccd_motion_threshold() const { return ccd_motion_threshold; }
 
 	void set_space(Space2DSW *p_space);
 
@@ -168,53 +168,129 @@ void BodyPair2DSW::_validate_contacts() {
 	}
 }
 
-bool BodyPair2DSW::_test_ccd(real_t p_step, Body2DSW *p_A, int p_shape_A, const Transform2D &p_xform_A, Body2DSW *p_B, int p_shape_B, const Transform2D &p_xform_B, bool p_swap_result) {
+// Motion of a body over a step for continuous collision detection, a linear
+// motion plus a rotation around the body origin.
+struct _CCDMotion2DSW {
+
+	Transform2D xform;
+	Vector2 center;
+	Vector2 linear;
+	real_t angular;
+	real_t radius; // no point of the shape is further away from the center
+
+	Transform2D get_xform(real_t p_time) const {
+
+		Transform2D xf = xform;
+		if (angular != 0) {
+			Transform2D rot(angular * p_time, Vector2());
+			xf.elements[0] = rot.basis_xform(xf.elements[0]);
+			xf.elements[1] = rot.basis_xform(xf.elements[1]);
+			xf.elements[2] = center + rot.basis_xform(xf.elements[2] - center);
+		}
+		xf.elements[2] += linear * p_time;
+		return xf;
+	}
+};
 
-	Vector2 motion = p_A->get_linear_velocity() * p_step;
-	real_t mlen = motion.length();
-	if (mlen < CMP_EPSILON)
-		return false;
+struct _CCDContacts2DSW {
 
-	Vector2 mnormal = motion / mlen;
+	Vector2 points_A[2];
+	Vector2 points_B[2];
+	int count;
+};
 
-	real_t min, max;
-	p_A->get_shape(p_shape_A)->project_rangev(mnormal, p_xform_A, min, max);
-	bool fast_object = mlen > (max - min) * 0.3; //going too fast in that direction
+static void _ccd_contact_callback(const Vector2 &p_point_A, const Vector2 &p_point_B, void *p_userdata) {
 
-	if (!fast_object) { //did it move enough in this direction to even attempt raycast? let's say it should move more than 1/3 the size of the object in that axis
-		return false;
+	_CCDContacts2DSW &contacts = *(_CCDContacts2DSW *)p_userdata;
+	if (contacts.count < 2) {
+		contacts.points_A[contacts.count] = p_point_A;
+		contacts.points_B[contacts.count] = p_point_B;
+		contacts.count++;
 	}
+}
 
-	//cast a segment from support in motion normal, in the same direction of motion by motion length
-	//support is the worst case collision point, so real collision happened before
-	int a;
-	Vector2 s[2];
-	p_A->get_shape(p_shape_A)->get_supports(p_xform_A.basis_xform(mnormal).normalized(), s, a);
-	Vector2 from = p_xform_A.xform(s[0]);
-	Vector2 to = from + motion;
+// Whether A can touch B between the two times: the shape is extruded by the
+// linear motion and grown by the most any point can move from the rotation.
+static bool _ccd_sweep(const Shape2DSW *p_shape_A, const _CCDMotion2DSW &p_motion, real_t p_from, real_t p_to, const Shape2DSW *p_shape_B, const Transform2D &p_xform_B, CollisionSolver2DSW::CallbackResult p_callback, void *p_userdata) {
 
-	Transform2D from_inv = p_xform_B.affine_inverse();
+	real_t margin = Math::abs(p_motion.angular) * (p_to - p_from) * p_motion.radius;
+	return CollisionSolver2DSW::solve(p_shape_A, p_motion.get_xform(p_from), p_motion.linear * (p_to - p_from), p_shape_B, p_xform_B, Vector2(), p_callback, p_userdata, NULL, margin);
+}
 
-	Vector2 local_from = from_inv.xform(from - mnormal * mlen * 0.1); //start from a little inside the bounding box
-	Vector2 local_to = from_inv.xform(to);
+bool BodyPair2DSW::_test_ccd(real_t p_step, Body2DSW *p_A, int p_shape_A, const Transform2D &p_xform_A, Body2DSW *p_B, int p_shape_B, const Transform2D &p_xform_B, bool p_swap_result) {
 
-	Vector2 rpos, rnorm;
-	if (!p_B->get_shape(p_shape_B)->intersect_segment(local_from, local_to, rpos, rnorm))
+	const Shape2DSW *shape_A = p_A->get_shape(p_shape_A);
+	const Shape2DSW *shape_B = p_B->get_shape(p_shape_B);
+
+	// transforms are relative to the origin of the pair's A
+	_CCDMotion2DSW motion;
+	motion.xform = p_xform_A;
+	motion.center = p_A->get_transform().get_origin() - A->get_transform().get_origin();
+	motion.linear = p_A->get_linear_velocity() - p_B->get_linear_velocity();
+	motion.angular = p_A->get_angular_velocity();
+
+	Rect2 aabb = p_xform_A.xform(shape_A->get_aabb());
+	motion.radius = 0;
+	for (int i = 0; i < 4; i++) {
+		Vector2 corner = aabb.position + Vector2((i & 1) ? aabb.size.x : 0, (i & 2) ? aabb.size.y : 0);
+		motion.radius = MAX(motion.radius, corner.distance_to(motion.center));
+	}
+
+	real_t mlen = motion.linear.length() * p_step;
+	real_t max_motion = mlen + Math::abs(motion.angular) * p_step * motion.radius;
+	if (max_motion < CMP_EPSILON)
 		return false;
 
-	//ray hit something
+	real_t threshold = p_A->get_ccd_motion_threshold();
+	if (threshold <= 0) {
+		//did it move enough to even attempt it? let's say it should move more than 1/3 the size of the object along its motion
+		if (mlen > CMP_EPSILON) {
+			real_t min, max;
+			shape_A->project_rangev(motion.linear.normalized(), p_xform_A, min, max);
+			threshold = (max - min) * 0.3;
+		} else {
+			threshold = motion.radius * 0.6;
+		}
+	}
 
-	Vector2 hitpos = p_xform_B.xform(rpos);
+	if (max_motion <= threshold)
+		return false;
 
-	Vector2 contact_A = to;
-	Vector2 contact_B = hitpos;
+	if (!_ccd_sweep(shape_A, motion, 0, p_step, shape_B, p_xform_B, NULL, NULL))
+		return false;
 
-	//create a contact
+	// bisect the time of impact, the start of the interval is always free
+	real_t from = 0;
+	real_t to = p_step;
+	for (int i = 0; i < 10; i++) {
 
-	if (p_swap_result)
-		_contact_added_callback(contact_B, contact_A);
-	else
-		_contact_added_callback(contact_A, contact_B);
+		real_t mid = (from + to) * 0.5;
+		if (_ccd_sweep(shape_A, motion, from, mid, shape_B, p_xform_B, NULL, NULL)) {
+			to = mid;
+		} else {
+			from = mid;
+		}
+	}
+
+	_CCDContacts2DSW contacts;
+	contacts.count = 0;
+	_ccd_sweep(shape_A, motion, from, to, shape_B, p_xform_B, _ccd_contact_callback, &contacts);
+	if (contacts.count == 0)
+		return false;
+
+	//create contacts where A would end up if it kept moving, so the solver stops it at the impact
+	Vector2 remaining = motion.linear * (p_step - from);
+
+	for (int i = 0; i < contacts.count; i++) {
+
+		Vector2 contact_A = contacts.points_A[i] + remaining;
+		Vector2 contact_B = contacts.points_B[i];
+
+		if (p_swap_result)
+			_contact_added_callback(contact_B, contact_A);
+		else
+			_contact_added_callback(contact_A, contact_B);
+	}
 
 	return true;
 }
@@ -271,7 +347,7 @@ bool BodyPair2DSW::setup(real_t p_step) {
 	collided = CollisionSolver2DSW::solve(shape_A_ptr, xform_A, motion_A, shape_B_ptr, xform_B, motion_B, _add_contact, this, &sep_axis);
 	if (!collided) {
 
-		//test ccd (currently just a raycast)
+		//test ccd
 
 		if (A->get_continuous_collision_detection_mode() == Physics2DServer::CCD_MODE_CAST_RAY && A->get_mode() > Physics2DServer::BODY_MODE_KINEMATIC) {
 			if (_test_ccd(p_step, A, shape_A, xform_A, B, shape_B, xform_B))
@@ -455,6 +531,17 @@ bool BodyPair2DSW::setup(real_t p_step) {
 	return do_process;
 }
 
+bool BodyPair2DSW::is_setup_thread_safe() const {
+
+	//static and kinematic bodies can be part of several islands, contacts can't be reported to them concurrently
+	if (A->get_mode() <= Physics2DServer::BODY_MODE_KINEMATIC && A->can_report_contacts())
+		return false;
+	if (B->get_mode() <= Physics2DServer::BODY_MODE_KINEMATIC && B->can_report_contacts())
+		return false;
+
+	return true;
+}
+
 void BodyPair2DSW::solve(real_t p_step) {
 
 	if (!collided)
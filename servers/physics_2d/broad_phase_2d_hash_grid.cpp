@@ -35,64 +35,67 @@
 
 void BroadPhase2DHashGrid::_pair_attempt(Element *p_elem, Element *p_with) {
 
-	Map<Element *, PairData *>::Element *E = p_elem->paired.find(p_with);
+	int idx = p_elem->paired.find(p_with);
 
 	ERR_FAIL_COND(p_elem->_static && p_with->_static);
 
-	if (!E) {
+	if (idx == -1) {
 
 		PairData *pd = memnew(PairData);
-		p_elem->paired[p_with] = pd;
-		p_with->paired[p_elem] = pd;
+		p_elem->paired.insert(p_with, pd);
+		p_with->paired.insert(p_elem, pd);
 	} else {
-		E->get()->rc++;
+		p_elem->paired.getv(idx)->rc++;
 	}
 }
 
 void BroadPhase2DHashGrid::_unpair_attempt(Element *p_elem, Element *p_with) {
 
-	Map<Element *, PairData *>::Element *E = p_elem->paired.find(p_with);
+	int idx = p_elem->paired.find(p_with);
 
-	ERR_FAIL_COND(!E); //this should really be paired..
+	ERR_FAIL_COND(idx == -1); //this should really be paired..
 
-	E->get()->rc--;
+	PairData *pd = p_elem->paired.getv(idx);
+	pd->rc--;
 
-	if (E->get()->rc == 0) {
+	if (pd->rc == 0) {
 
-		if (E->get()->colliding) {
+		if (pd->colliding) {
 			//uncollide
 			if (unpair_callback) {
-				unpair_callback(p_elem->owner, p_elem->subindex, p_with->owner, p_with->subindex, E->get()->ud, unpair_userdata);
+				unpair_callback(p_elem->owner, p_elem->subindex, p_with->owner, p_with->subindex, pd->ud, unpair_userdata);
 			}
 		}
 
-		memdelete(E->get());
-		p_elem->paired.erase(E);
+		memdelete(pd);
+		p_elem->paired.remove_at(idx);
 		p_with->paired.erase(p_elem);
 	}
 }
 
 void BroadPhase2DHashGrid::_check_motion(Element *p_elem) {
 
-	for (Map<Element *, PairData *>::Element *E = p_elem->paired.front(); E; E = E->next()) {
+	for (int i = 0; i < p_elem->paired.size(); i++) {
 
-		bool pairing = p_elem->aabb.intersects(E->key()->aabb);
+		Element *other = p_elem->paired.getk(i);
+		PairData *pd = p_elem->paired.getv(i);
+		bool pairing = p_elem->aabb.intersects(other->aabb);
 
-		if (pairing != E->get()->colliding) {
+		if (pairing != pd->colliding) {
 
 			if (pairing) {
 
 				if (pair_callback) {
-					E->get()->ud = pair_callback(p_elem->owner, p_elem->subindex, E->key()->owner, E->key()->subindex, pair_userdata);
+					pd->ud = pair_callback(p_elem->owner, p_elem->subindex, other->owner, other->subindex, pair_userdata);
 				}
 			} else {
 
 				if (unpair_callback) {
-					unpair_callback(p_elem->owner, p_elem->subindex, E->key()->owner, E->key()->subindex, E->get()->ud, unpair_userdata);
+					unpair_callback(p_elem->owner, p_elem->subindex, other->owner, other->subindex, pd->ud, unpair_userdata);
 				}
 			}
 
-			E->get()->colliding = pairing;
+			pd->colliding = pairing;
 		}
 	}
 }
@@ -204,11 +207,9 @@ void BroadPhase2DHashGrid::_exit_grid(Element *p_elem, const Rect2 &p_rect, bool
 	if (sz.width * sz.height > large_object_min_surface) {
 
 		//unpair all elements, instead of checking all, just check what is already paired, so we at least save from checking static vs static
-		Map<Element *, PairData *>::Element *E = p_elem->paired.front();
-		while (E) {
-			Map<Element *, PairData *>::Element *next = E->next();
-			_unpair_attempt(p_elem, E->key());
-			E = next;
+		//backwards, unpairing may remove the current entry
+		for (int i = p_elem->paired.size() - 1; i >= 0; i--) {
+			_unpair_attempt(p_elem, p_elem->paired.getk(i));
 		}
 
 		if (large_elements[p_elem].dec() == 0) {
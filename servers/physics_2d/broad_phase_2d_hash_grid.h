@@ -32,6 +32,7 @@
 #define BROAD_PHASE_2D_HASH_GRID_H
 
 #include "broad_phase_2d_sw.h"
+#include "core/flat_map.h"
 #include "core/map.h"
 
 class BroadPhase2DHashGrid : public BroadPhase2DSW {
@@ -56,7 +57,7 @@ class BroadPhase2DHashGrid : public BroadPhase2DSW {
 		Rect2 aabb;
 		int subindex;
 		uint64_t pass;
-		Map<Element *, PairData *> paired;
+		FlatMap<Element *, PairData *> paired;
 	};
 
 	struct RC {
@@ -84,34 +85,6 @@ class BroadPhase2DHashGrid : public BroadPhase2DSW {
 
 	uint64_t pass;
 
-	struct PairKey {
-
-		union {
-			struct {
-				ID a;
-				ID b;
-			};
-			uint64_t key;
-		};
-
-		_FORCE_INLINE_ bool operator<(const PairKey &p_key) const {
-			return key < p_key.key;
-		}
-
-		PairKey() { key = 0; }
-		PairKey(ID p_a, ID p_b) {
-			if (p_a > p_b) {
-				a = p_b;
-				b = p_a;
-			} else {
-				a = p_a;
-				b = p_b;
-			}
-		}
-	};
-
-	Map<PairKey, PairData> pair_map;
-
 	int cell_size;
 	int large_object_min_surface;
 
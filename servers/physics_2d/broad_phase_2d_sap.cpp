@@ -0,0 +1,583 @@
+/*************************************************************************/
+/*  broad_phase_2d_sap.cpp                                               */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2019 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2019 Godot Engine contributors (cf. AUTHORS.md)    */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#include "broad_phase_2d_sap.h"
+
+BroadPhase2DSAP::Pair *BroadPhase2DSAP::_find_pair(uint64_t p_key) const {
+
+	uint32_t slot = _pair_slot(p_key);
+	while (pairs[slot].key) {
+		if (pairs[slot].key == p_key)
+			return &pairs[slot];
+		slot = (slot + 1) & pair_mask;
+	}
+	return NULL;
+}
+
+void BroadPhase2DSAP::_grow_pairs() {
+
+	Pair *old_pairs = pairs;
+	uint32_t old_size = pair_mask + 1;
+
+	pair_mask = old_size * 2 - 1;
+	pairs = memnew_arr(Pair, pair_mask + 1);
+	for (uint32_t i = 0; i <= pair_mask; i++)
+		pairs[i].key = 0;
+
+	for (uint32_t i = 0; i < old_size; i++) {
+		if (!old_pairs[i].key)
+			continue;
+		uint32_t slot = _pair_slot(old_pairs[i].key);
+		while (pairs[slot].key)
+			slot = (slot + 1) & pair_mask;
+		pairs[slot] = old_pairs[i];
+	}
+
+	memdelete_arr(old_pairs);
+}
+
+void BroadPhase2DSAP::_add_pair(uint32_t p_a, uint32_t p_b) {
+
+	const Element &a = elements[p_a];
+	const Element &b = elements[p_b];
+
+	if (a.owner == b.owner || (a._static && b._static))
+		return;
+
+	if ((pair_count + 1) * 2 > pair_mask + 1)
+		_grow_pairs();
+
+	uint64_t key = _pair_key(p_a, p_b);
+	uint32_t slot = _pair_slot(key);
+	while (pairs[slot].key) {
+		if (pairs[slot].key == key)
+			return;
+		slot = (slot + 1) & pair_mask;
+	}
+
+	Pair &pair = pairs[slot];
+	pair.key = key;
+	pair.ud = NULL;
+	pair.pending = true;
+	pair_count++;
+	pending_pairs.push_back(key);
+}
+
+void BroadPhase2DSAP::_remove_pair(uint32_t p_a, uint32_t p_b) {
+
+	uint64_t key = _pair_key(p_a, p_b);
+
+	Pair *pair = _find_pair(key);
+	if (!pair)
+		return;
+
+	bool pending = pair->pending;
+	void *ud = pair->ud;
+
+	// backward shift deletion
+	uint32_t hole = pair - pairs;
+	uint32_t slot = hole;
+	while (true) {
+		slot = (slot + 1) & pair_mask;
+		if (!pairs[slot].key)
+			break;
+		uint32_t home = _pair_slot(pairs[slot].key);
+		// move the entry into the hole unless its home lies cyclically in (hole, slot]
+		if (((slot - home) & pair_mask) >= ((slot - hole) & pair_mask)) {
+			pairs[hole] = pairs[slot];
+			hole = slot;
+		}
+	}
+	pairs[hole].key = 0;
+	pair_count--;
+
+	if (!pending && unpair_callback) {
+		const Element &a = elements[p_a];
+		const Element &b = elements[p_b];
+		unpair_callback(a.owner, a.subindex, b.owner, b.subindex, ud, unpair_userdata);
+	}
+}
+
+void BroadPhase2DSAP::_flush_pairs(uint32_t p_elem) {
+
+	// Pairs are only reported once the operation is done, so the transient
+	// overlaps found while sorting in a new element never reach the callbacks.
+	for (int i = 0; i < pending_pairs.size(); i++) {
+
+		uint64_t key = pending_pairs[i];
+
+		Pair *pair = _find_pair(key);
+		if (!pair || !pair->pending)
+			continue;
+
+		uint32_t a = key >> 32;
+		uint32_t b = key & 0xFFFFFFFF;
+		if (b == p_elem)
+			SWAP(a, b);
+
+		pair->pending = false;
+		if (pair_callback) {
+			const Element &ea = elements[a];
+			const Element &eb = elements[b];
+			pair->ud = pair_callback(ea.owner, ea.subindex, eb.owner, eb.subindex, pair_userdata);
+		}
+	}
+
+	pending_pairs.clear();
+}
+
+void BroadPhase2DSAP::_sort_min_down(int p_axis, uint32_t p_ep, bool p_update) {
+
+	Endpoint *eps = axis[p_axis].ptrw();
+	Element *elems = elements.ptrw();
+	Endpoint ep = eps[p_ep];
+	uint32_t elem = ep.data >> 1;
+
+	while (p_ep > 0 && eps[p_ep - 1].value > ep.value) {
+
+		const Endpoint &prev = eps[p_ep - 1];
+		uint32_t other = prev.data >> 1;
+
+		if (prev.data & 1) {
+			// starts overlapping along this axis
+			if (p_update && _overlap(elems[elem], elems[other], p_axis ^ 1))
+				_add_pair(elem, other);
+			elems[other].max_ep[p_axis]++;
+		} else {
+			elems[other].min_ep[p_axis]++;
+		}
+
+		eps[p_ep] = prev;
+		p_ep--;
+	}
+
+	eps[p_ep] = ep;
+	elems[elem].min_ep[p_axis] = p_ep;
+}
+
+void BroadPhase2DSAP::_sort_min_up(int p_axis, uint32_t p_ep, bool p_update) {
+
+	Endpoint *eps = axis[p_axis].ptrw();
+	Element *elems = elements.ptrw();
+	uint32_t count = axis[p_axis].size();
+	Endpoint ep = eps[p_ep];
+	uint32_t elem = ep.data >> 1;
+
+	// at equal values max endpoints sort first, so touching elements don't overlap
+	while (p_ep + 1 < count) {
+
+		const Endpoint &next = eps[p_ep + 1];
+		uint32_t other = next.data >> 1;
+
+		if (other == elem || next.value > ep.value || (next.value == ep.value && !(next.data & 1)))
+			break;
+
+		if (next.data & 1) {
+			// stops overlapping along this axis
+			if (p_update)
+				_remove_pair(elem, other);
+			elems[other].max_ep[p_axis]--;
+		} else {
+			elems[other].min_ep[p_axis]--;
+		}
+
+		eps[p_ep] = next;
+		p_ep++;
+	}
+
+	eps[p_ep] = ep;
+	elems[elem].min_ep[p_axis] = p_ep;
+}
+
+void BroadPhase2DSAP::_sort_max_down(int p_axis, uint32_t p_ep, bool p_update) {
+
+	Endpoint *eps = axis[p_axis].ptrw();
+	Element *elems = elements.ptrw();
+	Endpoint ep = eps[p_ep];
+	uint32_t elem = ep.data >> 1;
+
+	while (p_ep > 0) {
+
+		const Endpoint &prev = eps[p_ep - 1];
+		uint32_t other = prev.data >> 1;
+
+		if (other == elem || prev.value < ep.value || (prev.value == ep.value && (prev.data & 1)))
+			break;
+
+		if (prev.data & 1) {
+			elems[other].max_ep[p_axis]++;
+		} else {
+			// stops overlapping along this axis
+			if (p_update)
+				_remove_pair(elem, other);
+			elems[other].min_ep[p_axis]++;
+		}
+
+		eps[p_ep] = prev;
+		p_ep--;
+	}
+
+	eps[p_ep] = ep;
+	elems[elem].max_ep[p_axis] = p_ep;
+}
+
+void BroadPhase2DSAP::_sort_max_up(int p_axis, uint32_t p_ep, bool p_update) {
+
+	Endpoint *eps = axis[p_axis].ptrw();
+	Element *elems = elements.ptrw();
+	uint32_t count = axis[p_axis].size();
+	Endpoint ep = eps[p_ep];
+	uint32_t elem = ep.data >> 1;
+
+	while (p_ep + 1 < count && eps[p_ep + 1].value < ep.value) {
+
+		const Endpoint &next = eps[p_ep + 1];
+		uint32_t other = next.data >> 1;
+
+		if (next.data & 1) {
+			elems[other].max_ep[p_axis]--;
+		} else {
+			// starts overlapping along this axis
+			if (p_update && _overlap(elems[elem], elems[other], p_axis ^ 1))
+				_add_pair(elem, other);
+			elems[other].min_ep[p_axis]--;
+		}
+
+		eps[p_ep] = next;
+		p_ep++;
+	}
+
+	eps[p_ep] = ep;
+	elems[elem].max_ep[p_axis] = p_ep;
+}
+
+void BroadPhase2DSAP::_insert(uint32_t p_elem) {
+
+	// Endpoints are appended past everything else and sorted down. The y axis
+	// goes first without reporting, since the element can't overlap anything
+	// along x yet; sorting x then finds every pair.
+	const Rect2 &aabb = elements[p_elem].aabb;
+
+	for (int i = 1; i >= 0; i--) {
+
+		uint32_t base = axis[i].size();
+		Endpoint ep;
+		ep.value = aabb.position[i];
+		ep.data = p_elem << 1;
+		axis[i].push_back(ep);
+		ep.value = aabb.position[i] + aabb.size[i];
+		ep.data |= 1;
+		axis[i].push_back(ep);
+
+		Element &e = elements.write[p_elem];
+		e.min_ep[i] = base;
+		e.max_ep[i] = base + 1;
+
+		_sort_min_down(i, base, i == 0);
+		_sort_max_down(i, base + 1, i == 0);
+	}
+
+	elements.write[p_elem].in_sap = true;
+
+	if (aabb.size.x > max_extent)
+		max_extent = aabb.size.x;
+}
+
+void BroadPhase2DSAP::_erase(uint32_t p_elem) {
+
+	// Moves the endpoints past everything else, the max first so the min
+	// crosses the max of every element it was overlapping along x.
+	for (int i = 0; i < 2; i++) {
+
+		Element &e = elements.write[p_elem];
+		axis[i].write[e.max_ep[i]].value = Math_INF;
+		_sort_max_up(i, e.max_ep[i], false);
+		axis[i].write[e.min_ep[i]].value = Math_INF;
+		_sort_min_up(i, e.min_ep[i], i == 0);
+
+		axis[i].resize(axis[i].size() - 2);
+	}
+
+	Element &e = elements.write[p_elem];
+	e.in_sap = false;
+
+	if (e.aabb.size.x >= max_extent)
+		max_extent_dirty = true;
+}
+
+void BroadPhase2DSAP::_update_max_extent() {
+
+	max_extent = 0;
+	const Element *elems = elements.ptr();
+	for (int i = 0; i < elements.size(); i++) {
+		if (elems[i].in_sap && elems[i].aabb.size.x > max_extent)
+			max_extent = elems[i].aabb.size.x;
+	}
+	max_extent_dirty = false;
+}
+
+BroadPhase2DSAP::ID BroadPhase2DSAP::create(CollisionObject2DSW *p_object, int p_subindex) {
+
+	uint32_t idx;
+	if (free_elements.size()) {
+		idx = free_elements[free_elements.size() - 1];
+		free_elements.resize(free_elements.size() - 1);
+	} else {
+		idx = elements.size();
+		elements.resize(idx + 1);
+	}
+
+	Element &e = elements.write[idx];
+	e.owner = p_object;
+	e.subindex = p_subindex;
+	e._static = false;
+	e.used = true;
+	e.in_sap = false;
+	e.aabb = Rect2();
+
+	return idx + 1;
+}
+
+void BroadPhase2DSAP::move(ID p_id, const Rect2 &p_aabb) {
+
+	uint32_t idx = p_id - 1;
+	ERR_FAIL_COND(idx >= (uint32_t)elements.size() || !elements[idx].used);
+
+	Element &e = elements.write[idx];
+
+	if (p_aabb == e.aabb)
+		return;
+
+	Rect2 old_aabb = e.aabb;
+	e.aabb = p_aabb;
+
+	if (p_aabb == Rect2()) {
+		_erase(idx);
+	} else if (!e.in_sap) {
+		_insert(idx);
+	} else {
+
+		for (int i = 0; i < 2; i++) {
+
+			real_t old_min = old_aabb.position[i];
+			real_t old_max = old_min + old_aabb.size[i];
+			real_t new_min = p_aabb.position[i];
+			real_t new_max = new_min + p_aabb.size[i];
+
+			uint32_t min_ep = elements[idx].min_ep[i];
+			uint32_t max_ep = elements[idx].max_ep[i];
+			axis[i].write[min_ep].value = new_min;
+			axis[i].write[max_ep].value = new_max;
+
+			// the order keeps each endpoint from having to cross its pair
+			if (new_min < old_min)
+				_sort_min_down(i, min_ep, true);
+			if (new_max > old_max)
+				_sort_max_up(i, max_ep, true);
+			if (new_min > old_min)
+				_sort_min_up(i, elements[idx].min_ep[i], true);
+			if (new_max < old_max)
+				_sort_max_down(i, elements[idx].max_ep[i], true);
+		}
+
+		if (p_aabb.size.x > max_extent)
+			max_extent = p_aabb.size.x;
+		else if (old_aabb.size.x >= max_extent && p_aabb.size.x < old_aabb.size.x)
+			max_extent_dirty = true;
+	}
+
+	_flush_pairs(idx);
+}
+
+void BroadPhase2DSAP::set_static(ID p_id, bool p_static) {
+
+	uint32_t idx = p_id - 1;
+	ERR_FAIL_COND(idx >= (uint32_t)elements.size() || !elements[idx].used);
+
+	Element &e = elements.write[idx];
+
+	if (e._static == p_static)
+		return;
+
+	bool in_sap = e.in_sap;
+	if (in_sap)
+		_erase(idx);
+
+	elements.write[idx]._static = p_static;
+
+	if (in_sap) {
+		_insert(idx);
+		_flush_pairs(idx);
+	}
+}
+
+void BroadPhase2DSAP::remove(ID p_id) {
+
+	uint32_t idx = p_id - 1;
+	ERR_FAIL_COND(idx >= (uint32_t)elements.size() || !elements[idx].used);
+
+	if (elements[idx].in_sap)
+		_erase(idx);
+
+	Element &e = elements.write[idx];
+	e.used = false;
+	e.owner = NULL;
+	e.aabb = Rect2();
+	free_elements.push_back(idx);
+}
+
+CollisionObject2DSW *BroadPhase2DSAP::get_object(ID p_id) const {
+
+	uint32_t idx = p_id - 1;
+	ERR_FAIL_COND_V(idx >= (uint32_t)elements.size() || !elements[idx].used, NULL);
+	return elements[idx].owner;
+}
+
+bool BroadPhase2DSAP::is_static(ID p_id) const {
+
+	uint32_t idx = p_id - 1;
+	ERR_FAIL_COND_V(idx >= (uint32_t)elements.size() || !elements[idx].used, false);
+	return elements[idx]._static;
+}
+
+int BroadPhase2DSAP::get_subindex(ID p_id) const {
+
+	uint32_t idx = p_id - 1;
+	ERR_FAIL_COND_V(idx >= (uint32_t)elements.size() || !elements[idx].used, -1);
+	return elements[idx].subindex;
+}
+
+template <bool use_segment>
+int BroadPhase2DSAP::_cull(const Rect2 &p_aabb, const Point2 &p_from, const Point2 &p_to, CollisionObject2DSW **p_results, int p_max_results, int *p_result_indices) {
+
+	if (max_extent_dirty)
+		_update_max_extent();
+
+	// Any element touching the query starts at most max_extent before it,
+	// so only the min endpoints from there to the end of the query are visited.
+	const Endpoint *eps = axis[0].ptr();
+	const Element *elems = elements.ptr();
+	int count = axis[0].size();
+
+	real_t from = p_aabb.position.x - max_extent;
+	real_t to = p_aabb.position.x + p_aabb.size.x;
+
+	int lo = 0;
+	int hi = count;
+	while (lo < hi) {
+		int mid = (lo + hi) >> 1;
+		if (eps[mid].value < from)
+			lo = mid + 1;
+		else
+			hi = mid;
+	}
+
+	int cullcount = 0;
+
+	for (int i = lo; i < count && cullcount < p_max_results; i++) {
+
+		const Endpoint &ep = eps[i];
+		if (ep.value > to)
+			break;
+		if (ep.data & 1)
+			continue;
+
+		const Element &e = elems[ep.data >> 1];
+
+		if (use_segment) {
+			if (!e.aabb.intersects_segment(p_from, p_to))
+				continue;
+		} else {
+			if (!p_aabb.intersects(e.aabb))
+				continue;
+		}
+
+		p_results[cullcount] = e.owner;
+		p_result_indices[cullcount] = e.subindex;
+		cullcount++;
+	}
+
+	return cullcount;
+}
+
+int BroadPhase2DSAP::cull_segment(const Vector2 &p_from, const Vector2 &p_to, CollisionObject2DSW **p_results, int p_max_results, int *p_result_indices) {
+
+	Rect2 aabb(p_from, Vector2());
+	aabb.expand_to(p_to);
+
+	return _cull<true>(aabb, p_from, p_to, p_results, p_max_results, p_result_indices);
+}
+
+int BroadPhase2DSAP::cull_aabb(const Rect2 &p_aabb, CollisionObject2DSW **p_results, int p_max_results, int *p_result_indices) {
+
+	return _cull<false>(p_aabb, Point2(), Point2(), p_results, p_max_results, p_result_indices);
+}
+
+void BroadPhase2DSAP::set_pair_callback(PairCallback p_pair_callback, void *p_userdata) {
+
+	pair_callback = p_pair_callback;
+	pair_userdata = p_userdata;
+}
+
+void BroadPhase2DSAP::set_unpair_callback(UnpairCallback p_unpair_callback, void *p_userdata) {
+
+	unpair_callback = p_unpair_callback;
+	unpair_userdata = p_userdata;
+}
+
+void BroadPhase2DSAP::update() {
+}
+
+BroadPhase2DSW *BroadPhase2DSAP::_create() {
+
+	return memnew(BroadPhase2DSAP);
+}
+
+BroadPhase2DSAP::BroadPhase2DSAP() {
+
+	pair_mask = 1023;
+	pair_count = 0;
+	pairs = memnew_arr(Pair, pair_mask + 1);
+	for (uint32_t i = 0; i <= pair_mask; i++)
+		pairs[i].key = 0;
+
+	max_extent = 0;
+	max_extent_dirty = false;
+
+	pair_callback = NULL;
+	pair_userdata = NULL;
+	unpair_callback = NULL;
+	unpair_userdata = NULL;
+}
+
+BroadPhase2DSAP::~BroadPhase2DSAP() {
+
+	memdelete_arr(pairs);
+}
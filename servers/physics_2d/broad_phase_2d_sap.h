@@ -0,0 +1,147 @@
+/*************************************************************************/
+/*  broad_phase_2d_sap.h                                                 */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2019 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2019 Godot Engine contributors (cf. AUTHORS.md)    */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#ifndef BROAD_PHASE_2D_SAP_H
+#define BROAD_PHASE_2D_SAP_H
+
+#include "broad_phase_2d_sw.h"
+#include "core/hashfuncs.h"
+#include "core/vector.h"
+
+/* Sweep and prune broadphase.
+
+   Every element keeps a min and a max endpoint in a sorted list per axis.
+   Moving an element only swaps its endpoints with the neighbours it crosses,
+   and every crossing of a min and a max endpoint is where a pair starts or
+   stops overlapping, so pairs are found without any spatial lookup.
+   Overlap between two elements is decided by comparing endpoint indices. */
+
+class BroadPhase2DSAP : public BroadPhase2DSW {
+
+	struct Endpoint {
+
+		real_t value;
+		uint32_t data; // element index << 1, lowest bit set for max endpoints
+	};
+
+	struct Element {
+
+		CollisionObject2DSW *owner;
+		int subindex;
+		bool _static;
+		bool used;
+		bool in_sap;
+		Rect2 aabb;
+		uint32_t min_ep[2];
+		uint32_t max_ep[2];
+	};
+
+	struct Pair {
+
+		uint64_t key; // 0 marks an empty slot
+		void *ud;
+		bool pending; // added during the current operation, pair callback not called yet
+	};
+
+	Vector<Element> elements;
+	Vector<uint32_t> free_elements;
+	Vector<Endpoint> axis[2];
+
+	// Open addressing with linear probing, erasing shifts the following
+	// entries back so no tombstones pile up under constant pair churn.
+	Pair *pairs;
+	uint32_t pair_mask;
+	uint32_t pair_count;
+	Vector<uint64_t> pending_pairs;
+
+	real_t max_extent; // widest element along x, bounds how far back culls must scan
+	bool max_extent_dirty;
+
+	PairCallback pair_callback;
+	void *pair_userdata;
+	UnpairCallback unpair_callback;
+	void *unpair_userdata;
+
+	static _FORCE_INLINE_ uint64_t _pair_key(uint32_t p_a, uint32_t p_b) {
+		return p_a < p_b ? ((uint64_t(p_a) << 32) | p_b) : ((uint64_t(p_b) << 32) | p_a);
+	}
+
+	_FORCE_INLINE_ bool _overlap(const Element &p_a, const Element &p_b, int p_axis) const {
+		return p_a.min_ep[p_axis] < p_b.max_ep[p_axis] && p_b.min_ep[p_axis] < p_a.max_ep[p_axis];
+	}
+
+	_FORCE_INLINE_ uint32_t _pair_slot(uint64_t p_key) const {
+		return hash_one_uint64(p_key) & pair_mask;
+	}
+
+	Pair *_find_pair(uint64_t p_key) const;
+	void _grow_pairs();
+
+	void _add_pair(uint32_t p_a, uint32_t p_b);
+	void _remove_pair(uint32_t p_a, uint32_t p_b);
+	void _flush_pairs(uint32_t p_elem);
+
+	void _sort_min_down(int p_axis, uint32_t p_ep, bool p_update);
+	void _sort_min_up(int p_axis, uint32_t p_ep, bool p_update);
+	void _sort_max_down(int p_axis, uint32_t p_ep, bool p_update);
+	void _sort_max_up(int p_axis, uint32_t p_ep, bool p_update);
+
+	void _insert(uint32_t p_elem);
+	void _erase(uint32_t p_elem);
+	void _update_max_extent();
+
+	template <bool use_segment>
+	int _cull(const Rect2 &p_aabb, const Point2 &p_from, const Point2 &p_to, CollisionObject2DSW **p_results, int p_max_results, int *p_result_indices);
+
+public:
+	virtual ID create(CollisionObject2DSW *p_object, int p_subindex = 0);
+	virtual void move(ID p_id, const Rect2 &p_aabb);
+	virtual void set_static(ID p_id, bool p_static);
+	virtual void remove(ID p_id);
+
+	virtual CollisionObject2DSW *get_object(ID p_id) const;
+	virtual bool is_static(ID p_id) const;
+	virtual int get_subindex(ID p_id) const;
+
+	virtual int cull_segment(const Vector2 &p_from, const Vector2 &p_to, CollisionObject2DSW **p_results, int p_max_results, int *p_result_indices = NULL);
+	virtual int cull_aabb(const Rect2 &p_aabb, CollisionObject2DSW **p_results, int p_max_results, int *p_result_indices = NULL);
+
+	virtual void set_pair_callback(PairCallback p_pair_callback, void *p_userdata);
+	virtual void set_unpair_callback(UnpairCallback p_unpair_callback, void *p_userdata);
+
+	virtual void update();
+
+	static BroadPhase2DSW *_create();
+
+	BroadPhase2DSAP();
+	~BroadPhase2DSAP();
+};
+
+#endif // BROAD_PHASE_2D_SAP_H
@@ -31,6 +31,7 @@
 #include "physics_2d_server_sw.h"
 #include "broad_phase_2d_basic.h"
 #include "broad_phase_2d_hash_grid.h"
+#include "broad_phase_2d_sap.h"
 #include "collision_solver_2d_sw.h"
 #include "core/os/os.h"
 #include "core/project_settings.h"
@@ -763,7 +764,7 @@ Physics2DServerSW::CCDMode Physics2DServerSW::body_get_continuous_collision_dete
 	return body->get_continuous_collision_detection_mode();
 }
 
-void Physics2DServerSW::body_attach_object_instance_id(RID p_body, uint32_t p_ID) {
+void Physics2DServerSW::body_attach_object_instance_id(RID p_body, ObjectID p_ID) {
 
 	Body2DSW *body = body_owner.get(p_body);
 	ERR_FAIL_COND(!body);
@@ -771,7 +772,7 @@ void Physics2DServerSW::body_attach_object_instance_id(RID p_body, uint32_t p_ID
 	body->set_instance_id(p_ID);
 };
 
-uint32_t Physics2DServerSW::body_get_object_instance_id(RID p_body) const {
+ObjectID Physics2DServerSW::body_get_object_instance_id(RID p_body) const {
 
 	Body2DSW *body = body_owner.get(p_body);
 	ERR_FAIL_COND_V(!body, 0);
@@ -779,7 +780,7 @@ uint32_t Physics2DServerSW::body_get_object_instance_id(RID p_body) const {
 	return body->get_instance_id();
 };
 
-void Physics2DServerSW::body_attach_canvas_instance_id(RID p_body, uint32_t p_ID) {
+void Physics2DServerSW::body_attach_canvas_instance_id(RID p_body, ObjectID p_ID) {
 
 	Body2DSW *body = body_owner.get(p_body);
 	ERR_FAIL_COND(!body);
@@ -787,7 +788,7 @@ void Physics2DServerSW::body_attach_canvas_instance_id(RID p_body, uint32_t p_ID
 	body->set_canvas_instance_id(p_ID);
 };
 
-uint32_t Physics2DServerSW::body_get_canvas_instance_id(RID p_body) const {
+ObjectID Physics2DServerSW::body_get_canvas_instance_id(RID p_body) const {
 
 	Body2DSW *body = body_owner.get(p_body);
 	ERR_FAIL_COND_V(!body, 0);
@@ -1443,7 +1444,12 @@ Physics2DServerSW *Physics2DServerSW::singletonsw = NULL;
 Physics2DServerSW::Physics2DServerSW() {
 
 	singletonsw = this;
-	BroadPhase2DSW::create_func = BroadPhase2DHashGrid::_create;
+	int broadphase = GLOBAL_DEF_RST("physics/2d/broadphase", 0);
+	ProjectSettings::get_singleton()->set_custom_property_info("physics/2d/broadphase", PropertyInfo(Variant::INT, "physics/2d/broadphase", PROPERTY_HINT_ENUM, "HashGrid,SweepAndPrune"));
+	if (broadphase == 1)
+		BroadPhase2DSW::create_func = BroadPhase2DSAP::_create;
+	else
+		BroadPhase2DSW::create_func = BroadPhase2DHashGrid::_create;
 	//BroadPhase2DSW::create_func=BroadPhase2DBasic::_create;
 
 	active = true;
@@ -193,6 +193,141 @@ bool Physics2DDirectSpaceStateSW::intersect_ray(const Vector2 &p_from, const Vec
 	return true;
 }
 
+// Segment test against one shape of an object, the point is returned in global space.
+_FORCE_INLINE_ static bool _intersect_segment_shape(const CollisionObject2DSW *p_object, int p_shape, const Vector2 &p_begin, const Vector2 &p_end, Vector2 &r_point, Vector2 &r_normal) {
+
+	Transform2D inv_xform = p_object->get_shape_inv_transform(p_shape) * p_object->get_inv_transform();
+
+	Vector2 local_from = inv_xform.xform(p_begin);
+	Vector2 local_to = inv_xform.xform(p_end);
+
+	const Shape2DSW *shape = p_object->get_shape(p_shape);
+
+	Vector2 shape_point, shape_normal;
+
+	if (!shape->intersect_segment(local_from, local_to, shape_point, shape_normal))
+		return false;
+
+	Transform2D xform = p_object->get_transform() * p_object->get_shape_transform(p_shape);
+	r_point = xform.xform(shape_point);
+	r_normal = inv_xform.basis_xform_inv(shape_normal).normalized();
+	return true;
+}
+
+void Physics2DDirectSpaceStateSW::_ray_batch_job(uint32_t p_index, RayBatch *p_batch) {
+
+	const Vector2 &begin = p_batch->from[p_index];
+	const Vector2 &end = p_batch->to[p_index];
+	Vector2 normal = (end - begin).normalized();
+
+	bool collided = false;
+	Vector2 res_point, res_normal;
+	int res_shape = -1;
+	const CollisionObject2DSW *res_obj = NULL;
+	real_t min_d = 1e10;
+
+	for (int i = p_batch->ray_offsets[p_index]; i < p_batch->ray_offsets[p_index + 1]; i++) {
+
+		const RayCandidate &c = p_batch->candidates[i];
+		Vector2 shape_point, shape_normal;
+
+		if (_intersect_segment_shape(c.object, c.shape, begin, end, shape_point, shape_normal)) {
+
+			real_t ld = normal.dot(shape_point);
+
+			if (ld < min_d) {
+
+				min_d = ld;
+				res_point = shape_point;
+				res_normal = shape_normal;
+				res_shape = c.shape;
+				res_obj = c.object;
+				collided = true;
+			}
+		}
+	}
+
+	p_batch->hits[p_index] = collided;
+	p_batch->hit_objects[p_index] = res_obj;
+	if (!collided)
+		return;
+
+	RayResult &r = p_batch->results[p_index];
+	r.normal = res_normal;
+	r.position = res_point;
+	r.shape = res_shape;
+}
+
+int Physics2DDirectSpaceStateSW::intersect_rays_batch(const Vector2 *p_from, const Vector2 *p_to, int p_count, RayResult *r_results, bool *r_hits, const Set<RID> &p_exclude, uint32_t p_collision_mask, bool p_collide_with_bodies, bool p_collide_with_areas) {
+
+	ERR_FAIL_COND_V(space->locked, 0);
+
+	// The broadphase reuses the space's result buffers, so culling stays on this
+	// thread. The filtered candidates are then tested against their shapes in parallel.
+	ray_candidates.resize(0);
+	ray_offsets.resize(p_count + 1);
+	ray_hit_objects.resize(p_count);
+
+	for (int i = 0; i < p_count; i++) {
+
+		ray_offsets.write[i] = ray_candidates.size();
+
+		int amount = space->broadphase->cull_segment(p_from[i], p_to[i], space->intersection_query_results, Space2DSW::INTERSECTION_QUERY_MAX, space->intersection_query_subindex_results);
+
+		for (int j = 0; j < amount; j++) {
+
+			CollisionObject2DSW *col_obj = space->intersection_query_results[j];
+
+			if (!_can_collide_with(col_obj, p_collision_mask, p_collide_with_bodies, p_collide_with_areas))
+				continue;
+
+			if (p_exclude.has(col_obj->get_self()))
+				continue;
+
+			RayCandidate c;
+			c.object = col_obj;
+			c.shape = space->intersection_query_subindex_results[j];
+			ray_candidates.push_back(c);
+		}
+	}
+	ray_offsets.write[p_count] = ray_candidates.size();
+
+	RayBatch batch;
+	batch.from = p_from;
+	batch.to = p_to;
+	batch.results = r_results;
+	batch.hits = r_hits;
+	batch.hit_objects = ray_hit_objects.ptrw();
+	batch.candidates = ray_candidates.ptr();
+	batch.ray_offsets = ray_offsets.ptr();
+
+	int thread_count = space->get_solver_thread_count() > 0 ? space->get_solver_thread_count() : -1;
+
+	if (thread_count != 1 && !work_pool.is_initialized()) {
+		work_pool.init();
+	}
+
+	work_pool.do_work(p_count, this, &Physics2DDirectSpaceStateSW::_ray_batch_job, &batch, thread_count);
+
+	// Shape metadata are Variants, they are copied here rather than from the workers.
+	int hit_count = 0;
+	for (int i = 0; i < p_count; i++) {
+
+		if (!r_hits[i])
+			continue;
+
+		hit_count++;
+		const CollisionObject2DSW *obj = ray_hit_objects[i];
+		RayResult &r = r_results[i];
+		r.collider_id = obj->get_instance_id();
+		r.collider = r.collider_id != 0 ? ObjectDB::get_instance(r.collider_id) : NULL;
+		r.metadata = obj->get_shape_metadata(r.shape);
+		r.rid = obj->get_self();
+	}
+
+	return hit_count;
+}
+
 int Physics2DDirectSpaceStateSW::intersect_shape(const RID &p_shape, const Transform2D &p_xform, const Vector2 &p_motion, real_t p_margin, ShapeResult *r_results, int p_result_max, const Set<RID> &p_exclude, uint32_t p_collision_mask, bool p_collide_with_bodies, bool p_collide_with_areas) {
 
 	if (p_result_max <= 0)
@@ -1293,6 +1428,7 @@ void Space2DSW::set_param(Physics2DServer::SpaceParameter p_param, real_t p_valu
 		case Physics2DServer::SPACE_PARAM_BODY_TIME_TO_SLEEP: body_time_to_sleep = p_value; break;
 		case Physics2DServer::SPACE_PARAM_CONSTRAINT_DEFAULT_BIAS: constraint_bias = p_value; break;
 		case Physics2DServer::SPACE_PARAM_TEST_MOTION_MIN_CONTACT_DEPTH: test_motion_min_contact_depth = p_value; break;
+		case Physics2DServer::SPACE_PARAM_SOLVER_THREAD_COUNT: solver_thread_count = MAX(int(p_value), 0); break;
 	}
 }
 
@@ -1308,6 +1444,7 @@ real_t Space2DSW::get_param(Physics2DServer::SpaceParameter p_param) const {
 		case Physics2DServer::SPACE_PARAM_BODY_TIME_TO_SLEEP: return body_time_to_sleep;
 		case Physics2DServer::SPACE_PARAM_CONSTRAINT_DEFAULT_BIAS: return constraint_bias;
 		case Physics2DServer::SPACE_PARAM_TEST_MOTION_MIN_CONTACT_DEPTH: return test_motion_min_contact_depth;
+		case Physics2DServer::SPACE_PARAM_SOLVER_THREAD_COUNT: return solver_thread_count;
 	}
 	return 0;
 }
@@ -1351,6 +1488,8 @@ Space2DSW::Space2DSW() {
 	body_angular_velocity_sleep_threshold = GLOBAL_DEF("physics/2d/sleep_threshold_angular", (8.0 / 180.0 * Math_PI));
 	body_time_to_sleep = GLOBAL_DEF("physics/2d/time_before_sleep", 0.5);
 	ProjectSettings::get_singleton()->set_custom_property_info("physics/2d/time_before_sleep", PropertyInfo(Variant::REAL, "physics/2d/time_before_sleep", PROPERTY_HINT_RANGE, "0,5,0.01,or_greater"));
+	solver_thread_count = MAX(int(GLOBAL_DEF("physics/2d/solver_thread_count", 1)), 0);
+	ProjectSettings::get_singleton()->set_custom_property_info("physics/2d/solver_thread_count", PropertyInfo(Variant::INT, "physics/2d/solver_thread_count", PROPERTY_HINT_RANGE, "0,64,1"));
 
 	broadphase = BroadPhase2DSW::create_func();
 	broadphase->set_pair_callback(_broadphase_pair, this);
@@ -57,6 +57,18 @@ void Step2DSW::_populate_island(Body2DSW *p_body, Body2DSW **p_island, Constrain
 	}
 }
 
+bool Step2DSW::_is_island_setup_thread_safe(Constraint2DSW *p_island) const {
+
+	Constraint2DSW *ci = p_island;
+	while (ci) {
+		if (!ci->is_setup_thread_safe())
+			return false;
+		ci = ci->get_island_next();
+	}
+
+	return true;
+}
+
 bool Step2DSW::_setup_island(Constraint2DSW *p_island, real_t p_delta) {
 
 	Constraint2DSW *ci = p_island;
@@ -94,6 +106,17 @@ void Step2DSW::_solve_island(Constraint2DSW *p_island, int p_iterations, real_t
 	}
 }
 
+void Step2DSW::_setup_island_job(uint32_t p_index, IslandStepData *p_data) {
+
+	int island = threaded_setup_islands[p_index];
+	p_data->removed_root[island] = _setup_island(constraint_islands[island], p_data->delta);
+}
+
+void Step2DSW::_solve_island_job(uint32_t p_index, IslandStepData *p_data) {
+
+	_solve_island(constraint_islands[p_index], p_data->iterations, p_data->delta);
+}
+
 void Step2DSW::_check_suspend(Body2DSW *p_island, real_t p_delta) {
 
 	bool can_sleep = true;
@@ -217,12 +240,64 @@ void Step2DSW::step(Space2DSW *p_space, real_t p_delta, int p_iterations) {
 
 	/* SETUP CONSTRAINT ISLANDS */
 
+	//islands don't share dynamic bodies, so they can be set up and solved in parallel
+	int thread_count = p_space->get_solver_thread_count() > 0 ? p_space->get_solver_thread_count() : -1;
+	bool threaded = thread_count != 1 && !p_space->is_debugging_contacts(); //debug contacts are written to the space
+
+	IslandStepData step_data;
+	step_data.delta = p_delta;
+	step_data.iterations = p_iterations;
+	step_data.removed_root = NULL;
+
+	if (threaded) {
+
+		if (!work_pool.is_initialized()) {
+			work_pool.init();
+		}
+
+		int count = 0;
+		for (Constraint2DSW *ci = constraint_island_list; ci; ci = ci->get_island_list_next()) {
+			count++;
+		}
+
+		threaded = count > 1 && work_pool.get_thread_count() > 0;
+
+		if (threaded) {
+			constraint_islands.resize(count);
+			threaded_setup_islands.resize(count);
+			island_removed_root.resize(count);
+			Constraint2DSW **islands = constraint_islands.ptrw();
+			int *setup_islands = threaded_setup_islands.ptrw();
+			step_data.removed_root = island_removed_root.ptrw();
+
+			int setup_count = 0;
+			int idx = 0;
+			for (Constraint2DSW *ci = constraint_island_list; ci; ci = ci->get_island_list_next()) {
+
+				islands[idx] = ci;
+
+				if (_is_island_setup_thread_safe(ci)) {
+					setup_islands[setup_count++] = idx;
+				} else {
+					step_data.removed_root[idx] = _setup_island(ci, p_delta);
+				}
+
+				idx++;
+			}
+
+			work_pool.do_work(setup_count, this, &Step2DSW::_setup_island_job, &step_data, thread_count);
+		}
+	}
+
 	{
 		Constraint2DSW *ci = constraint_island_list;
 		Constraint2DSW *prev_ci = NULL;
+		int island_index = 0;
 		while (ci) {
 
-			if (_setup_island(ci, p_delta)) {
+			bool removed_root = threaded ? step_data.removed_root[island_index++] : _setup_island(ci, p_delta);
+
+			if (removed_root) {
 
 				//removed the root from the island graph because it is not to be processed
 
@@ -263,7 +338,15 @@ void Step2DSW::step(Space2DSW *p_space, real_t p_delta, int p_iterations) {
 
 	/* SOLVE CONSTRAINT ISLANDS */
 
-	{
+	if (threaded) {
+		//setup may have removed island roots
+		int count = 0;
+		for (Constraint2DSW *ci = constraint_island_list; ci; ci = ci->get_island_list_next()) {
+			constraint_islands.write[count++] = ci;
+		}
+
+		work_pool.do_work(count, this, &Step2DSW::_solve_island_job, &step_data, thread_count);
+	} else {
 		Constraint2DSW *ci = constraint_island_list;
 		while (ci) {
 			//iterating each island separatedly improves cache efficiency
@@ -314,3 +397,8 @@ Step2DSW::Step2DSW() {
 
 	_step = 1;
 }
+
+Step2DSW::~Step2DSW() {
+
+	work_pool.finish();
+}
@@ -33,18 +33,35 @@
 
 #include "space_2d_sw.h"
 
+#include "core/os/thread_work_pool.h"
+
 class Step2DSW {
 
 	uint64_t _step;
 
+	struct IslandStepData {
+		real_t delta;
+		int iterations;
+		uint8_t *removed_root;
+	};
+
+	ThreadWorkPool work_pool;
+	Vector<Constraint2DSW *> constraint_islands;
+	Vector<int> threaded_setup_islands;
+	Vector<uint8_t> island_removed_root;
+
 	void _populate_island(Body2DSW *p_body, Body2DSW **p_island, Constraint2DSW **p_constraint_island);
+	bool _is_island_setup_thread_safe(Constraint2DSW *p_island) const;
 	bool _setup_island(Constraint2DSW *p_island, real_t p_delta);
 	void _solve_island(Constraint2DSW *p_island, int p_iterations, real_t p_delta);
+	void _setup_island_job(uint32_t p_index, IslandStepData *p_data);
+	void _solve_island_job(uint32_t p_index, IslandStepData *p_data);
 	void _check_suspend(Body2DSW *p_island, real_t p_delta);
 
 public:
 	void step(Space2DSW *p_space, real_t p_delta, int p_iterations);
 	Step2DSW();
+	~Step2DSW();
 };
 
 #endif // STEP_2D_SW_H
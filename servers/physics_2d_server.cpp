@@ -290,6 +290,79 @@ Dictionary Physics2DDirectSpaceState::_intersect_ray(const Vector2 &p_from, cons
 	return d;
 }
 
+Dictionary Physics2DDirectSpaceState::_intersect_rays_batch(const PoolVector<Vector2> &p_from, const PoolVector<Vector2> &p_to, const Vector<RID> &p_exclude, uint32_t p_layers, bool p_collide_with_bodies, bool p_collide_with_areas) {
+
+	ERR_FAIL_COND_V(p_from.size() != p_to.size(), Dictionary());
+
+	int count = p_from.size();
+	Set<RID> exclude;
+	for (int i = 0; i < p_exclude.size(); i++)
+		exclude.insert(p_exclude[i]);
+
+	Vector<RayResult> results;
+	Vector<bool> hits;
+	results.resize(count);
+	hits.resize(count);
+
+	PoolVector<Vector2>::Read rf = p_from.read();
+	PoolVector<Vector2>::Read rt = p_to.read();
+	int hit_count = intersect_rays_batch(rf.ptr(), rt.ptr(), count, results.ptrw(), hits.ptrw(), exclude, p_layers, p_collide_with_bodies, p_collide_with_areas);
+
+	PoolVector<uint8_t> hit;
+	PoolVector<Vector2> positions;
+	PoolVector<Vector2> normals;
+	PoolVector<int> shapes;
+	Array collider_ids;
+	Array rids;
+	Array metadata;
+	hit.resize(count);
+	positions.resize(count);
+	normals.resize(count);
+	shapes.resize(count);
+	collider_ids.resize(count);
+	rids.resize(count);
+	metadata.resize(count);
+
+	{
+		PoolVector<uint8_t>::Write wh = hit.write();
+		PoolVector<Vector2>::Write wp = positions.write();
+		PoolVector<Vector2>::Write wn = normals.write();
+		PoolVector<int>::Write ws = shapes.write();
+
+		for (int i = 0; i < count; i++) {
+			if (hits[i]) {
+				const RayResult &r = results[i];
+				wh[i] = 1;
+				wp[i] = r.position;
+				wn[i] = r.normal;
+				ws[i] = r.shape;
+				collider_ids[i] = r.collider_id;
+				rids[i] = r.rid;
+				metadata[i] = r.metadata;
+			} else {
+				wh[i] = 0;
+				wp[i] = Vector2();
+				wn[i] = Vector2();
+				ws[i] = -1;
+				collider_ids[i] = 0;
+				rids[i] = RID();
+			}
+		}
+	}
+
+	Dictionary d;
+	d["hit_count"] = hit_count;
+	d["hit"] = hit;
+	d["position"] = positions;
+	d["normal"] = normals;
+	d["shape"] = shapes;
+	d["collider_id"] = collider_ids;
+	d["rid"] = rids;
+	d["metadata"] = metadata;
+
+	return d;
+}
+
 Array Physics2DDirectSpaceState::_intersect_shape(const Ref<Physics2DShapeQueryParameters> &p_shape_query, int p_max_results) {
 
 	ERR_FAIL_COND_V(!p_shape_query.is_valid(), Array());
@@ -409,6 +482,17 @@ Dictionary Physics2DDirectSpaceState::_get_rest_info(const Ref<Physics2DShapeQue
 	return r;
 }
 
+int Physics2DDirectSpaceState::intersect_rays_batch(const Vector2 *p_from, const Vector2 *p_to, int p_count, RayResult *r_results, bool *r_hits, const Set<RID> &p_exclude, uint32_t p_collision_layer, bool p_collide_with_bodies, bool p_collide_with_areas) {
+
+	int hit_count = 0;
+	for (int i = 0; i < p_count; i++) {
+		r_hits[i] = intersect_ray(p_from[i], p_to[i], r_results[i], p_exclude, p_collision_layer, p_collide_with_bodies, p_collide_with_areas);
+		if (r_hits[i])
+			hit_count++;
+	}
+	return hit_count;
+}
+
 Physics2DDirectSpaceState::Physics2DDirectSpaceState() {
 }
 
@@ -417,6 +501,7 @@ void Physics2DDirectSpaceState::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("intersect_point", "point", "max_results", "exclude", "collision_layer", "collide_with_bodies", "collide_with_areas"), &Physics2DDirectSpaceState::_intersect_point, DEFVAL(32), DEFVAL(Array()), DEFVAL(0x7FFFFFFF), DEFVAL(true), DEFVAL(false));
 	ClassDB::bind_method(D_METHOD("intersect_point_on_canvas", "point", "canvas_instance_id", "max_results", "exclude", "collision_layer", "collide_with_bodies", "collide_with_areas"), &Physics2DDirectSpaceState::_intersect_point_on_canvas, DEFVAL(32), DEFVAL(Array()), DEFVAL(0x7FFFFFFF), DEFVAL(true), DEFVAL(false));
 	ClassDB::bind_method(D_METHOD("intersect_ray", "from", "to", "exclude", "collision_layer", "collide_with_bodies", "collide_with_areas"), &Physics2DDirectSpaceState::_intersect_ray, DEFVAL(Array()), DEFVAL(0x7FFFFFFF), DEFVAL(true), DEFVAL(false));
+	ClassDB::bind_method(D_METHOD("intersect_rays_batch", "from", "to", "exclude", "collision_layer", "collide_with_bodies", "collide_with_areas"), &Physics2DDirectSpaceState::_intersect_rays_batch, DEFVAL(Array()), DEFVAL(0x7FFFFFFF), DEFVAL(true), DEFVAL(false));
 	ClassDB::bind_method(D_METHOD("intersect_shape", "shape", "max_results"), &Physics2DDirectSpaceState::_intersect_shape, DEFVAL(32));
 	ClassDB::bind_method(D_METHOD("cast_motion", "shape"), &Physics2DDirectSpaceState::_cast_motion);
 	ClassDB::bind_method(D_METHOD("collide_shape", "shape", "max_results"), &Physics2DDirectSpaceState::_collide_shape, DEFVAL(32));
@@ -694,6 +779,7 @@ void Physics2DServer::_bind_methods() {
 	BIND_ENUM_CONSTANT(SPACE_PARAM_BODY_TIME_TO_SLEEP);
 	BIND_ENUM_CONSTANT(SPACE_PARAM_CONSTRAINT_DEFAULT_BIAS);
 	BIND_ENUM_CONSTANT(SPACE_PARAM_TEST_MOTION_MIN_CONTACT_DEPTH);
+	BIND_ENUM_CONSTANT(SPACE_PARAM_SOLVER_THREAD_COUNT);
 
 	BIND_ENUM_CONSTANT(SHAPE_LINE);
 	BIND_ENUM_CONSTANT(SHAPE_RAY);
@@ -732,6 +818,7 @@ void Physics2DServer::_bind_methods() {
 	BIND_ENUM_CONSTANT(BODY_PARAM_GRAVITY_SCALE);
 	BIND_ENUM_CONSTANT(BODY_PARAM_LINEAR_DAMP);
 	BIND_ENUM_CONSTANT(BODY_PARAM_ANGULAR_DAMP);
+	BIND_ENUM_CONSTANT(BODY_PARAM_CCD_MOTION_THRESHOLD);
 	BIND_ENUM_CONSTANT(BODY_PARAM_MAX);
 
 	BIND_ENUM_CONSTANT(BODY_STATE_TRANSFORM);
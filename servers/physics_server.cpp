@@ -283,6 +283,75 @@ Dictionary PhysicsDirectSpaceState::_intersect_ray(const Vector3 &p_from, const
 	return d;
 }
 
+Dictionary PhysicsDirectSpaceState::_intersect_rays_batch(const PoolVector<Vector3> &p_from, const PoolVector<Vector3> &p_to, const Vector<RID> &p_exclude, uint32_t p_collision_mask, bool p_collide_with_bodies, bool p_collide_with_areas) {
+
+	ERR_FAIL_COND_V(p_from.size() != p_to.size(), Dictionary());
+
+	int count = p_from.size();
+	Set<RID> exclude;
+	for (int i = 0; i < p_exclude.size(); i++)
+		exclude.insert(p_exclude[i]);
+
+	Vector<RayResult> results;
+	Vector<bool> hits;
+	results.resize(count);
+	hits.resize(count);
+
+	PoolVector<Vector3>::Read rf = p_from.read();
+	PoolVector<Vector3>::Read rt = p_to.read();
+	int hit_count = intersect_rays_batch(rf.ptr(), rt.ptr(), count, results.ptrw(), hits.ptrw(), exclude, p_collision_mask, p_collide_with_bodies, p_collide_with_areas);
+
+	PoolVector<uint8_t> hit;
+	PoolVector<Vector3> positions;
+	PoolVector<Vector3> normals;
+	PoolVector<int> shapes;
+	Array collider_ids;
+	Array rids;
+	hit.resize(count);
+	positions.resize(count);
+	normals.resize(count);
+	shapes.resize(count);
+	collider_ids.resize(count);
+	rids.resize(count);
+
+	{
+		PoolVector<uint8_t>::Write wh = hit.write();
+		PoolVector<Vector3>::Write wp = positions.write();
+		PoolVector<Vector3>::Write wn = normals.write();
+		PoolVector<int>::Write ws = shapes.write();
+
+		for (int i = 0; i < count; i++) {
+			if (hits[i]) {
+				const RayResult &r = results[i];
+				wh[i] = 1;
+				wp[i] = r.position;
+				wn[i] = r.normal;
+				ws[i] = r.shape;
+				collider_ids[i] = r.collider_id;
+				rids[i] = r.rid;
+			} else {
+				wh[i] = 0;
+				wp[i] = Vector3();
+				wn[i] = Vector3();
+				ws[i] = -1;
+				collider_ids[i] = 0;
+				rids[i] = RID();
+			}
+		}
+	}
+
+	Dictionary d;
+	d["hit_count"] = hit_count;
+	d["hit"] = hit;
+	d["position"] = positions;
+	d["normal"] = normals;
+	d["shape"] = shapes;
+	d["collider_id"] = collider_ids;
+	d["rid"] = rids;
+
+	return d;
+}
+
 Array PhysicsDirectSpaceState::_intersect_shape(const Ref<PhysicsShapeQueryParameters> &p_shape_query, int p_max_results) {
 
 	ERR_FAIL_COND_V(!p_shape_query.is_valid(), Array());
@@ -356,12 +425,24 @@ Dictionary PhysicsDirectSpaceState::_get_rest_info(const Ref<PhysicsShapeQueryPa
 	return r;
 }
 
+int PhysicsDirectSpaceState::intersect_rays_batch(const Vector3 *p_from, const Vector3 *p_to, int p_count, RayResult *r_results, bool *r_hits, const Set<RID> &p_exclude, uint32_t p_collision_mask, bool p_collide_with_bodies, bool p_collide_with_areas) {
+
+	int hit_count = 0;
+	for (int i = 0; i < p_count; i++) {
+		r_hits[i] = intersect_ray(p_from[i], p_to[i], r_results[i], p_exclude, p_collision_mask, p_collide_with_bodies, p_collide_with_areas);
+		if (r_hits[i])
+			hit_count++;
+	}
+	return hit_count;
+}
+
 PhysicsDirectSpaceState::PhysicsDirectSpaceState() {
 }
 
 void PhysicsDirectSpaceState::_bind_methods() {
 
 	ClassDB::bind_method(D_METHOD("intersect_ray", "from", "to", "exclude", "collision_mask", "collide_with_bodies", "collide_with_areas"), &PhysicsDirectSpaceState::_intersect_ray, DEFVAL(Array()), DEFVAL(0x7FFFFFFF), DEFVAL(true), DEFVAL(false));
+	ClassDB::bind_method(D_METHOD("intersect_rays_batch", "from", "to", "exclude", "collision_mask", "collide_with_bodies", "collide_with_areas"), &PhysicsDirectSpaceState::_intersect_rays_batch, DEFVAL(Array()), DEFVAL(0x7FFFFFFF), DEFVAL(true), DEFVAL(false));
 	ClassDB::bind_method(D_METHOD("intersect_shape", "shape", "max_results"), &PhysicsDirectSpaceState::_intersect_shape, DEFVAL(32));
 	ClassDB::bind_method(D_METHOD("cast_motion", "shape", "motion"), &PhysicsDirectSpaceState::_cast_motion);
 	ClassDB::bind_method(D_METHOD("collide_shape", "shape", "max_results"), &PhysicsDirectSpaceState::_collide_shape, DEFVAL(32));
@@ -419,6 +500,11 @@ void PhysicsServer::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("space_set_param", "space", "param", "value"), &PhysicsServer::space_set_param);
 	ClassDB::bind_method(D_METHOD("space_get_param", "space", "param"), &PhysicsServer::space_get_param);
 	ClassDB::bind_method(D_METHOD("space_get_direct_state", "space"), &PhysicsServer::space_get_direct_state);
+	ClassDB::bind_method(D_METHOD("space_set_history_size", "space", "ticks"), &PhysicsServer::space_set_history_size);
+	ClassDB::bind_method(D_METHOD("space_get_history_size", "space"), &PhysicsServer::space_get_history_size);
+	ClassDB::bind_method(D_METHOD("space_get_history_tick", "space"), &PhysicsServer::space_get_history_tick);
+	ClassDB::bind_method(D_METHOD("space_get_direct_state_at_tick", "space", "tick"), &PhysicsServer::space_get_direct_state_at_tick);
+	ClassDB::bind_method(D_METHOD("space_get_info", "space", "info"), &PhysicsServer::space_get_info);
 
 	ClassDB::bind_method(D_METHOD("area_create"), &PhysicsServer::area_create);
 	ClassDB::bind_method(D_METHOD("area_set_space", "area", "space"), &PhysicsServer::area_set_space);
@@ -518,6 +604,9 @@ void PhysicsServer::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("body_set_omit_force_integration", "body", "enable"), &PhysicsServer::body_set_omit_force_integration);
 	ClassDB::bind_method(D_METHOD("body_is_omitting_force_integration", "body"), &PhysicsServer::body_is_omitting_force_integration);
 
+	ClassDB::bind_method(D_METHOD("body_set_record_history", "body", "enable"), &PhysicsServer::body_set_record_history);
+	ClassDB::bind_method(D_METHOD("body_is_recording_history", "body"), &PhysicsServer::body_is_recording_history);
+
 	ClassDB::bind_method(D_METHOD("body_set_force_integration_callback", "body", "receiver", "method", "userdata"), &PhysicsServer::body_set_force_integration_callback, DEFVAL(Variant()));
 
 	ClassDB::bind_method(D_METHOD("body_set_ray_pickable", "body", "enable"), &PhysicsServer::body_set_ray_pickable);
@@ -686,6 +775,7 @@ void PhysicsServer::_bind_methods() {
 	BIND_ENUM_CONSTANT(BODY_PARAM_GRAVITY_SCALE);
 	BIND_ENUM_CONSTANT(BODY_PARAM_LINEAR_DAMP);
 	BIND_ENUM_CONSTANT(BODY_PARAM_ANGULAR_DAMP);
+	BIND_ENUM_CONSTANT(BODY_PARAM_CCD_MOTION_THRESHOLD);
 	BIND_ENUM_CONSTANT(BODY_PARAM_MAX);
 
 	BIND_ENUM_CONSTANT(BODY_STATE_TRANSFORM);
@@ -701,6 +791,15 @@ void PhysicsServer::_bind_methods() {
 	BIND_ENUM_CONSTANT(INFO_COLLISION_PAIRS);
 	BIND_ENUM_CONSTANT(INFO_ISLAND_COUNT);
 
+	BIND_ENUM_CONSTANT(SPACE_INFO_ACTIVE_OBJECTS);
+	BIND_ENUM_CONSTANT(SPACE_INFO_SLEEPING_OBJECTS);
+	BIND_ENUM_CONSTANT(SPACE_INFO_COLLISION_PAIRS);
+	BIND_ENUM_CONSTANT(SPACE_INFO_ISLAND_COUNT);
+	BIND_ENUM_CONSTANT(SPACE_INFO_BROADPHASE_TIME_USEC);
+	BIND_ENUM_CONSTANT(SPACE_INFO_NARROWPHASE_TIME_USEC);
+	BIND_ENUM_CONSTANT(SPACE_INFO_SOLVER_TIME_USEC);
+	BIND_ENUM_CONSTANT(SPACE_INFO_INTEGRATE_TIME_USEC);
+
 	BIND_ENUM_CONSTANT(SPACE_PARAM_CONTACT_RECYCLE_RADIUS);
 	BIND_ENUM_CONSTANT(SPACE_PARAM_CONTACT_MAX_SEPARATION);
 	BIND_ENUM_CONSTANT(SPACE_PARAM_BODY_MAX_ALLOWED_PENETRATION);
@@ -710,6 +809,8 @@ void PhysicsServer::_bind_methods() {
 	BIND_ENUM_CONSTANT(SPACE_PARAM_BODY_ANGULAR_VELOCITY_DAMP_RATIO);
 	BIND_ENUM_CONSTANT(SPACE_PARAM_CONSTRAINT_DEFAULT_BIAS);
 	BIND_ENUM_CONSTANT(SPACE_PARAM_TEST_MOTION_MIN_CONTACT_DEPTH);
+	BIND_ENUM_CONSTANT(SPACE_PARAM_SOLVER_THREAD_COUNT);
+	BIND_ENUM_CONSTANT(SPACE_PARAM_CONTACT_CACHE_THRESHOLD);
 
 	BIND_ENUM_CONSTANT(BODY_AXIS_LINEAR_X);
 	BIND_ENUM_CONSTANT(BODY_AXIS_LINEAR_Y);
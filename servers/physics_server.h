@@ -146,6 +146,7 @@ class PhysicsDirectSpaceState : public Object {
 
 private:
 	Dictionary _intersect_ray(const Vector3 &p_from, const Vector3 &p_to, const Vector<RID> &p_exclude = Vector<RID>(), uint32_t p_collision_mask = 0, bool p_collide_with_bodies = true, bool p_collide_with_areas = false);
+	Dictionary _intersect_rays_batch(const PoolVector<Vector3> &p_from, const PoolVector<Vector3> &p_to, const Vector<RID> &p_exclude = Vector<RID>(), uint32_t p_collision_mask = 0, bool p_collide_with_bodies = true, bool p_collide_with_areas = false);
 	Array _intersect_shape(const Ref<PhysicsShapeQueryParameters> &p_shape_query, int p_max_results = 32);
 	Array _cast_motion(const Ref<PhysicsShapeQueryParameters> &p_shape_query, const Vector3 &p_motion);
 	Array _collide_shape(const Ref<PhysicsShapeQueryParameters> &p_shape_query, int p_max_results = 32);
@@ -176,6 +177,8 @@ public:
 	};
 
 	virtual bool intersect_ray(const Vector3 &p_from, const Vector3 &p_to, RayResult &r_result, const Set<RID> &p_exclude = Set<RID>(), uint32_t p_collision_mask = 0xFFFFFFFF, bool p_collide_with_bodies = true, bool p_collide_with_areas = false, bool p_pick_ray = false) = 0;
+	// Casts p_count rays, r_hits[i] tells whether r_results[i] is valid. Returns the number of hits.
+	virtual int intersect_rays_batch(const Vector3 *p_from, const Vector3 *p_to, int p_count, RayResult *r_results, bool *r_hits, const Set<RID> &p_exclude = Set<RID>(), uint32_t p_collision_mask = 0xFFFFFFFF, bool p_collide_with_bodies = true, bool p_collide_with_areas = false);
 
 	virtual int intersect_shape(const RID &p_shape, const Transform &p_xform, float p_margin, ShapeResult *r_results, int p_result_max, const Set<RID> &p_exclude = Set<RID>(), uint32_t p_collision_mask = 0xFFFFFFFF, bool p_collide_with_bodies = true, bool p_collide_with_areas = false) = 0;
 
@@ -274,7 +277,9 @@ public:
 		SPACE_PARAM_BODY_TIME_TO_SLEEP,
 		SPACE_PARAM_BODY_ANGULAR_VELOCITY_DAMP_RATIO,
 		SPACE_PARAM_CONSTRAINT_DEFAULT_BIAS,
-		SPACE_PARAM_TEST_MOTION_MIN_CONTACT_DEPTH
+		SPACE_PARAM_TEST_MOTION_MIN_CONTACT_DEPTH,
+		SPACE_PARAM_SOLVER_THREAD_COUNT,
+		SPACE_PARAM_CONTACT_CACHE_THRESHOLD
 	};
 
 	virtual void space_set_param(RID p_space, SpaceParameter p_param, real_t p_value) = 0;
@@ -283,10 +288,32 @@ public:
 	// this function only works on physics process, errors and returns null otherwise
 	virtual PhysicsDirectSpaceState *space_get_direct_state(RID p_space) = 0;
 
+	// transforms of bodies recording history are kept for the last ticks, for lag compensation
+	virtual void space_set_history_size(RID p_space, int p_ticks) = 0;
+	virtual int space_get_history_size(RID p_space) const = 0;
+	virtual uint64_t space_get_history_tick(RID p_space) const = 0;
+	// same as space_get_direct_state, but queries see recording bodies where they were at p_tick
+	virtual PhysicsDirectSpaceState *space_get_direct_state_at_tick(RID p_space, uint64_t p_tick) = 0;
+
 	virtual void space_set_debug_contacts(RID p_space, int p_max_contacts) = 0;
 	virtual Vector<Vector3> space_get_contacts(RID p_space) const = 0;
 	virtual int space_get_contact_count(RID p_space) const = 0;
 
+	enum SpaceInfo {
+
+		SPACE_INFO_ACTIVE_OBJECTS,
+		SPACE_INFO_SLEEPING_OBJECTS,
+		SPACE_INFO_COLLISION_PAIRS,
+		SPACE_INFO_ISLAND_COUNT,
+		SPACE_INFO_BROADPHASE_TIME_USEC,
+		SPACE_INFO_NARROWPHASE_TIME_USEC,
+		SPACE_INFO_SOLVER_TIME_USEC,
+		SPACE_INFO_INTEGRATE_TIME_USEC,
+	};
+
+	// counts and stage timings of the last step of a space
+	virtual int space_get_info(RID p_space, SpaceInfo p_info) = 0;
+
 	//missing space parameters
 
 	/* AREA API */
@@ -385,8 +412,8 @@ public:
 
 	virtual void body_set_shape_disabled(RID p_body, int p_shape_idx, bool p_disabled) = 0;
 
-	virtual void body_attach_object_instance_id(RID p_body, uint32_t p_ID) = 0;
-	virtual uint32_t body_get_object_instance_id(RID p_body) const = 0;
+	virtual void body_attach_object_instance_id(RID p_body, ObjectID p_ID) = 0;
+	virtual ObjectID body_get_object_instance_id(RID p_body) const = 0;
 
 	virtual void body_set_enable_continuous_collision_detection(RID p_body, bool p_enable) = 0;
 	virtual bool body_is_continuous_collision_detection_enabled(RID p_body) const = 0;
@@ -408,6 +435,7 @@ public:
 		BODY_PARAM_GRAVITY_SCALE,
 		BODY_PARAM_LINEAR_DAMP,
 		BODY_PARAM_ANGULAR_DAMP,
+		BODY_PARAM_CCD_MOTION_THRESHOLD,
 		BODY_PARAM_MAX,
 	};
 
@@ -472,6 +500,9 @@ public:
 	virtual void body_set_omit_force_integration(RID p_body, bool p_omit) = 0;
 	virtual bool body_is_omitting_force_integration(RID p_body) const = 0;
 
+	virtual void body_set_record_history(RID p_body, bool p_enable) = 0;
+	virtual bool body_is_recording_history(RID p_body) const = 0;
+
 	virtual void body_set_force_integration_callback(RID p_body, Object *p_receiver, const StringName &p_method, const Variant &p_udata = Variant()) = 0;
 
 	virtual void body_set_ray_pickable(RID p_body, bool p_enable) = 0;
@@ -834,5 +865,6 @@ VARIANT_ENUM_CAST(PhysicsServer::G6DOFJointAxisParam);
 VARIANT_ENUM_CAST(PhysicsServer::G6DOFJointAxisFlag);
 VARIANT_ENUM_CAST(PhysicsServer::AreaBodyStatus);
 VARIANT_ENUM_CAST(PhysicsServer::ProcessInfo);
+VARIANT_ENUM_CAST(PhysicsServer::SpaceInfo);
 
 #endif
@@ -80,6 +80,19 @@ static void _debugger_get_resource_usage(List<ScriptDebuggerRemote::ResourceUsag
 		}
 		r_usage->push_back(usage);
 	}
+
+	List<VS::VideoMemoryInfo> vinfo;
+	VS::get_singleton()->video_memory_debug_usage(&vinfo);
+
+	for (List<VS::VideoMemoryInfo>::Element *E = vinfo.front(); E; E = E->next()) {
+
+		ScriptDebuggerRemote::ResourceUsage usage;
+		usage.vram = E->get().bytes;
+		usage.id = E->get().rid;
+		usage.type = E->get().type;
+		usage.format = E->get().format;
+		r_usage->push_back(usage);
+	}
 }
 
 ShaderTypes *shader_types = NULL;
@@ -0,0 +1,257 @@
+/*************************************************************************/
+/*  occlusion_buffer.cpp                                                 */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2019 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2019 Godot Engine contributors (cf. AUTHORS.md)    */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#include "occlusion_buffer.h"
+
+bool OcclusionBuffer::_project(const Vector3 &p_point, Vector3 &r_screen) const {
+
+	const real_t(*m)[4] = view_projection.matrix;
+
+	real_t w = m[0][3] * p_point.x + m[1][3] * p_point.y + m[2][3] * p_point.z + m[3][3];
+	if (w <= CMP_EPSILON) {
+		return false; //behind the camera
+	}
+
+	real_t inv_w = 1.0 / w;
+	real_t x = (m[0][0] * p_point.x + m[1][0] * p_point.y + m[2][0] * p_point.z + m[3][0]) * inv_w;
+	real_t y = (m[0][1] * p_point.x + m[1][1] * p_point.y + m[2][1] * p_point.z + m[3][1]) * inv_w;
+	real_t z = (m[0][2] * p_point.x + m[1][2] * p_point.y + m[2][2] * p_point.z + m[3][2]) * inv_w;
+
+	r_screen.x = (x * 0.5 + 0.5) * width;
+	r_screen.y = (0.5 - y * 0.5) * height;
+	r_screen.z = z * 0.5 + 0.5;
+	return true;
+}
+
+void OcclusionBuffer::_rasterize_triangle(const Vector3 &p_a, const Vector3 &p_b, const Vector3 &p_c) {
+
+	float area = (p_b.x - p_a.x) * (p_c.y - p_a.y) - (p_b.y - p_a.y) * (p_c.x - p_a.x);
+	if (Math::absf(area) < CMP_EPSILON) {
+		return;
+	}
+
+	int min_x = MAX(0, int(Math::floor(MIN(p_a.x, MIN(p_b.x, p_c.x)))));
+	int max_x = MIN(width - 1, int(Math::floor(MAX(p_a.x, MAX(p_b.x, p_c.x)))));
+	int min_y = MAX(0, int(Math::floor(MIN(p_a.y, MIN(p_b.y, p_c.y)))));
+	int max_y = MIN(height - 1, int(Math::floor(MAX(p_a.y, MAX(p_b.y, p_c.y)))));
+
+	if (min_x > max_x || min_y > max_y) {
+		return;
+	}
+
+	float inv_area = 1.0 / area;
+	float *d = depth.ptrw();
+
+	// Pixels are sampled at their center, barycentrics come from the edge functions.
+	for (int y = min_y; y <= max_y; y++) {
+
+		float py = y + 0.5;
+		float *row = &d[y * width];
+
+		for (int x = min_x; x <= max_x; x++) {
+
+			float px = x + 0.5;
+			float w0 = ((p_c.x - p_b.x) * (py - p_b.y) - (p_c.y - p_b.y) * (px - p_b.x)) * inv_area;
+			float w1 = ((p_a.x - p_c.x) * (py - p_c.y) - (p_a.y - p_c.y) * (px - p_c.x)) * inv_area;
+			float w2 = 1.0 - w0 - w1;
+
+			if (w0 < 0 || w1 < 0 || w2 < 0) {
+				continue;
+			}
+
+			float z = w0 * p_a.z + w1 * p_b.z + w2 * p_c.z;
+			if (z < row[x]) {
+				row[x] = z;
+			}
+		}
+	}
+}
+
+void OcclusionBuffer::_build_levels() {
+
+	float *d = depth.ptrw();
+
+	for (int i = 1; i < level_count; i++) {
+
+		const Level &src = levels[i - 1];
+		const Level &dst = levels[i];
+
+		for (int y = 0; y < dst.height; y++) {
+
+			int y0 = y * 2;
+			int y1 = MIN(y0 + 1, src.height - 1);
+			const float *row0 = &d[src.offset + y0 * src.width];
+			const float *row1 = &d[src.offset + y1 * src.width];
+			float *out = &d[dst.offset + y * dst.width];
+
+			for (int x = 0; x < dst.width; x++) {
+
+				int x0 = x * 2;
+				int x1 = MIN(x0 + 1, src.width - 1);
+				out[x] = MAX(MAX(row0[x0], row0[x1]), MAX(row1[x0], row1[x1]));
+			}
+		}
+	}
+}
+
+void OcclusionBuffer::begin(const CameraMatrix &p_projection, const Transform &p_cam_transform, int p_width) {
+
+	real_t aspect = p_projection.get_aspect();
+
+	width = MAX(p_width, 8);
+	height = CLAMP(int(width / (aspect > CMP_EPSILON ? aspect : 1.0)), 8, width * 4);
+	view_projection = p_projection * CameraMatrix(p_cam_transform.affine_inverse());
+	has_occluders = false;
+
+	int w = width;
+	int h = height;
+	int offset = 0;
+	level_count = 0;
+
+	while (level_count < MAX_LEVELS) {
+
+		levels[level_count].width = w;
+		levels[level_count].height = h;
+		levels[level_count].offset = offset;
+		level_count++;
+		offset += w * h;
+
+		if (w == 1 && h == 1) {
+			break;
+		}
+		w = MAX(1, (w + 1) / 2);
+		h = MAX(1, (h + 1) / 2);
+	}
+
+	depth.resize(offset);
+
+	float *d = depth.ptrw();
+	for (int i = 0; i < width * height; i++) {
+		d[i] = 1.0;
+	}
+}
+
+void OcclusionBuffer::add_box(const AABB &p_box, const Transform &p_xform) {
+
+	Vector3 points[8];
+	for (int i = 0; i < 8; i++) {
+		if (!_project(p_xform.xform(p_box.get_endpoint(i)), points[i])) {
+			return; //crosses the camera plane, not worth clipping
+		}
+	}
+
+	// Corner indices are bit patterns along the three axes, so each face is a cycle of four of them.
+	static const int faces[6][4] = {
+		{ 0, 1, 3, 2 },
+		{ 4, 5, 7, 6 },
+		{ 0, 1, 5, 4 },
+		{ 2, 3, 7, 6 },
+		{ 0, 2, 6, 4 },
+		{ 1, 3, 7, 5 },
+	};
+
+	for (int i = 0; i < 6; i++) {
+		const int *f = faces[i];
+		_rasterize_triangle(points[f[0]], points[f[1]], points[f[2]]);
+		_rasterize_triangle(points[f[0]], points[f[2]], points[f[3]]);
+	}
+
+	has_occluders = true;
+}
+
+void OcclusionBuffer::end() {
+
+	if (has_occluders) {
+		_build_levels();
+	}
+}
+
+bool OcclusionBuffer::is_occluded(const AABB &p_aabb) const {
+
+	if (!has_occluders) {
+		return false;
+	}
+
+	Vector3 min(1e20, 1e20, 1e20);
+	Vector3 max(-1e20, -1e20, -1e20);
+
+	for (int i = 0; i < 8; i++) {
+
+		Vector3 p;
+		if (!_project(p_aabb.get_endpoint(i), p)) {
+			return false;
+		}
+		min.x = MIN(min.x, p.x);
+		min.y = MIN(min.y, p.y);
+		min.z = MIN(min.z, p.z);
+		max.x = MAX(max.x, p.x);
+		max.y = MAX(max.y, p.y);
+	}
+
+	int x0 = MAX(0, int(Math::floor(min.x)));
+	int x1 = MIN(width - 1, int(Math::floor(max.x)));
+	int y0 = MAX(0, int(Math::floor(min.y)));
+	int y1 = MIN(height - 1, int(Math::floor(max.y)));
+
+	if (x0 > x1 || y0 > y1) {
+		return false; //off screen, frustum culling already decided about it
+	}
+
+	// Go down the pyramid until the rectangle spans at most 2x2 texels.
+	int level = 0;
+	while (level < level_count - 1 && (x1 - x0 > 1 || y1 - y0 > 1)) {
+		x0 >>= 1;
+		x1 >>= 1;
+		y0 >>= 1;
+		y1 >>= 1;
+		level++;
+	}
+
+	const Level &l = levels[level];
+	const float *d = &depth.ptr()[l.offset];
+
+	for (int y = y0; y <= y1; y++) {
+		for (int x = x0; x <= x1; x++) {
+			if (d[y * l.width + x] >= min.z) {
+				return false;
+			}
+		}
+	}
+
+	return true;
+}
+
+OcclusionBuffer::OcclusionBuffer() {
+
+	level_count = 0;
+	width = 0;
+	height = 0;
+	has_occluders = false;
+}
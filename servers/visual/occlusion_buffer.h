@@ -0,0 +1,83 @@
+/*************************************************************************/
+/*  occlusion_buffer.h                                                   */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2019 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2019 Godot Engine contributors (cf. AUTHORS.md)    */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#ifndef OCCLUSION_BUFFER_H
+#define OCCLUSION_BUFFER_H
+
+#include "core/math/aabb.h"
+#include "core/math/camera_matrix.h"
+#include "core/math/transform.h"
+#include "core/vector.h"
+
+/**
+	Small CPU depth buffer used to reject instances hidden behind occluders.
+
+	Occluders are rasterized as solid boxes, then a pyramid of maximum depths is
+	built so that each occludee bounding box can be tested against a handful of
+	texels. Depth is the normalized device Z remapped to [0, 1], larger is farther.
+*/
+class OcclusionBuffer {
+
+	enum {
+		MAX_LEVELS = 16
+	};
+
+	struct Level {
+		int width;
+		int height;
+		int offset;
+	};
+
+	Vector<float> depth;
+	Level levels[MAX_LEVELS];
+	int level_count;
+
+	int width;
+	int height;
+
+	CameraMatrix view_projection;
+	bool has_occluders;
+
+	bool _project(const Vector3 &p_point, Vector3 &r_screen) const;
+	void _rasterize_triangle(const Vector3 &p_a, const Vector3 &p_b, const Vector3 &p_c);
+	void _build_levels();
+
+public:
+	void begin(const CameraMatrix &p_projection, const Transform &p_cam_transform, int p_width);
+	void add_box(const AABB &p_box, const Transform &p_xform);
+	void end();
+
+	bool is_empty() const { return !has_occluders; }
+	bool is_occluded(const AABB &p_aabb) const;
+
+	OcclusionBuffer();
+};
+
+#endif // OCCLUSION_BUFFER_H
@@ -34,6 +34,7 @@
 #include "core/math/camera_matrix.h"
 #include "servers/visual_server.h"
 
+#include "core/local_vector.h"
 #include "core/self_list.h"
 
 class RasterizerScene {
@@ -113,6 +114,7 @@ public:
 		bool redraw_if_visible : 4;
 
 		float depth; //used for sorting
+		float lod_error_limit; //largest mesh LOD error allowed for the last camera that culled it, relative to its size
 
 		SelfList<InstanceBase> dependency_item;
 
@@ -130,6 +132,7 @@ public:
 			receive_shadows = true;
 			visible = true;
 			depth_layer = 0;
+			lod_error_limit = 0;
 			layer_mask = 1;
 			baked_light = false;
 			redraw_if_visible = false;
@@ -166,6 +169,8 @@ public:
 	virtual void set_scene_pass(uint64_t p_pass) = 0;
 	virtual void set_debug_draw_mode(VS::ViewportDebugDraw p_debug_draw) = 0;
 
+	virtual void video_memory_debug_usage(List<VS::VideoMemoryInfo> *r_info) {}
+
 	virtual bool free(RID p_rid) = 0;
 
 	virtual ~RasterizerScene() {}
@@ -240,6 +245,9 @@ public:
 	virtual void shader_set_default_texture_param(RID p_shader, const StringName &p_name, RID p_texture) = 0;
 	virtual RID shader_get_default_texture_param(RID p_shader, const StringName &p_name) const = 0;
 
+	virtual PoolIntArray shader_get_compiled_variants(RID p_shader) const = 0;
+	virtual void shader_precompile_variants(RID p_shader, const PoolIntArray &p_variants) = 0;
+
 	/* COMMON MATERIAL API */
 
 	virtual RID material_create() = 0;
@@ -266,7 +274,7 @@ public:
 
 	virtual RID mesh_create() = 0;
 
-	virtual void mesh_add_surface(RID p_mesh, uint32_t p_format, VS::PrimitiveType p_primitive, const PoolVector<uint8_t> &p_array, int p_vertex_count, const PoolVector<uint8_t> &p_index_array, int p_index_count, const AABB &p_aabb, const Vector<PoolVector<uint8_t> > &p_blend_shapes = Vector<PoolVector<uint8_t> >(), const Vector<AABB> &p_bone_aabbs = Vector<AABB>()) = 0;
+	virtual void mesh_add_surface(RID p_mesh, uint32_t p_format, VS::PrimitiveType p_primitive, const PoolVector<uint8_t> &p_array, int p_vertex_count, const PoolVector<uint8_t> &p_index_array, int p_index_count, const AABB &p_aabb, const Vector<PoolVector<uint8_t> > &p_blend_shapes = Vector<PoolVector<uint8_t> >(), const Vector<AABB> &p_bone_aabbs = Vector<AABB>(), const Rect2 &p_uv_range = Rect2(0, 0, 1, 1)) = 0;
 
 	virtual void mesh_set_blend_shape_count(RID p_mesh, int p_amount) = 0;
 	virtual int mesh_get_blend_shape_count(RID p_mesh) const = 0;
@@ -275,6 +283,7 @@ public:
 	virtual VS::BlendShapeMode mesh_get_blend_shape_mode(RID p_mesh) const = 0;
 
 	virtual void mesh_surface_update_region(RID p_mesh, int p_surface, int p_offset, const PoolVector<uint8_t> &p_data) = 0;
+	virtual void mesh_surface_set_lods(RID p_mesh, int p_surface, const Vector<PoolVector<uint8_t> > &p_lod_indices, const Vector<float> &p_lod_errors) = 0;
 
 	virtual void mesh_surface_set_material(RID p_mesh, int p_surface, RID p_material) = 0;
 	virtual RID mesh_surface_get_material(RID p_mesh, int p_surface) const = 0;
@@ -289,6 +298,7 @@ public:
 	virtual VS::PrimitiveType mesh_surface_get_primitive_type(RID p_mesh, int p_surface) const = 0;
 
 	virtual AABB mesh_surface_get_aabb(RID p_mesh, int p_surface) const = 0;
+	virtual Rect2 mesh_surface_get_uv_range(RID p_mesh, int p_surface) const = 0;
 	virtual Vector<PoolVector<uint8_t> > mesh_surface_get_blend_shapes(RID p_mesh, int p_surface) const = 0;
 	virtual Vector<AABB> mesh_surface_get_skeleton_aabb(RID p_mesh, int p_surface) const = 0;
 
@@ -323,6 +333,7 @@ public:
 	virtual Color multimesh_instance_get_custom_data(RID p_multimesh, int p_index) const = 0;
 
 	virtual void multimesh_set_as_bulk_array(RID p_multimesh, const PoolVector<float> &p_array) = 0;
+	virtual void multimesh_set_as_bulk_array_range(RID p_multimesh, int p_from_instance, const PoolVector<float> &p_array) = 0;
 
 	virtual void multimesh_set_visible_instances(RID p_multimesh, int p_visible) = 0;
 	virtual int multimesh_get_visible_instances(RID p_multimesh) const = 0;
@@ -352,6 +363,7 @@ public:
 	virtual int skeleton_get_bone_count(RID p_skeleton) const = 0;
 	virtual void skeleton_bone_set_transform(RID p_skeleton, int p_bone, const Transform &p_transform) = 0;
 	virtual Transform skeleton_bone_get_transform(RID p_skeleton, int p_bone) const = 0;
+	virtual void skeleton_set_bone_transforms(RID p_skeleton, const PoolVector<float> &p_transforms) = 0;
 	virtual void skeleton_bone_set_transform_2d(RID p_skeleton, int p_bone, const Transform2D &p_transform) = 0;
 	virtual Transform2D skeleton_bone_get_transform_2d(RID p_skeleton, int p_bone) const = 0;
 	virtual void skeleton_set_base_transform_2d(RID p_skeleton, const Transform2D &p_base_transform) = 0;
@@ -569,6 +581,8 @@ public:
 	virtual void canvas_light_occluder_set_polylines(RID p_occluder, const PoolVector<Vector2> &p_lines) = 0;
 
 	virtual VS::InstanceType get_base_type(RID p_rid) const = 0;
+	virtual void video_memory_debug_usage(List<VS::VideoMemoryInfo> *r_info) {}
+
 	virtual bool free(RID p_rid) = 0;
 
 	virtual bool has_os_feature(const String &p_feature) const = 0;
@@ -843,7 +857,7 @@ public:
 		bool update_when_visible;
 		//VS::MaterialBlendMode blend_mode;
 		int light_mask;
-		Vector<Command *> commands;
+		LocalVector<Command *> commands;
 		mutable bool custom_rect;
 		mutable bool rect_dirty;
 		mutable Rect2 rect;
@@ -1067,10 +1081,12 @@ public:
 		VS::CanvasOccluderPolygonCullMode cull_cache;
 
 		LightOccluderInstance *next;
+		LightOccluderInstance *candidate_next_ptr;
 
 		LightOccluderInstance() {
 			enabled = true;
 			next = NULL;
+			candidate_next_ptr = NULL;
 			light_mask = 1;
 			cull_cache = VS::CANVAS_OCCLUDER_POLYGON_CULL_DISABLED;
 		}
@@ -1104,6 +1120,7 @@ public:
 	virtual void restore_render_target() = 0;
 	virtual void clear_render_target(const Color &p_color) = 0;
 	virtual void blit_render_target_to_screen(RID p_render_target, const Rect2 &p_screen_rect, int p_screen = 0) = 0;
+	virtual void blit_render_target_to_current(RID p_render_target, float p_sharpness) = 0;
 	virtual void output_lens_distorted_to_screen(RID p_render_target, const Rect2 &p_screen_rect, float p_k1, float p_k2, const Vector2 &p_eye_center, float p_oversample) = 0;
 	virtual void end_frame(bool p_swap_buffers) = 0;
 	virtual void finalize() = 0;
@@ -57,9 +57,9 @@ void _collect_ysort_children(VisualServerCanvas::Item *p_canvas_item, Transform2
 	for (int i = 0; i < child_item_count; i++) {
 		if (r_items) {
 			r_items[r_index] = child_items[i];
-			child_items[i]->ysort_xform = p_transform;
-			child_items[i]->ysort_pos = p_transform.xform(child_items[i]->xform.elements[2]);
 		}
+		child_items[i]->ysort_xform = p_transform;
+		child_items[i]->ysort_pos = p_transform.xform(child_items[i]->xform.elements[2]);
 
 		r_index++;
 
@@ -68,6 +68,51 @@ void _collect_ysort_children(VisualServerCanvas::Item *p_canvas_item, Transform2
 	}
 }
 
+// Y-sorted children rarely move far between frames, so the order from the previous
+// frame is almost sorted already. Fix it up with an insertion sort, and fall back to a
+// full sort when too many items moved at once (e.g. a camera jump or a big rebuild).
+#define YSORT_FIXUP_MAX_MOVES_PER_ITEM 4
+
+void _sort_ysort_children(VisualServerCanvas::Item **p_items, int p_count) {
+
+	VisualServerCanvas::ItemPtrSort compare;
+	int moves_left = p_count * YSORT_FIXUP_MAX_MOVES_PER_ITEM;
+
+	for (int i = 1; i < p_count; i++) {
+
+		VisualServerCanvas::Item *item = p_items[i];
+		int j = i;
+		while (j > 0 && compare(item, p_items[j - 1])) {
+			p_items[j] = p_items[j - 1];
+			j--;
+			moves_left--;
+		}
+		p_items[j] = item;
+
+		if (moves_left < 0) {
+			SortArray<VisualServerCanvas::Item *, VisualServerCanvas::ItemPtrSort> sorter;
+			sorter.sort(p_items, p_count);
+			return;
+		}
+	}
+}
+
+// Leaf items that end up fully outside the clip rect contribute nothing, so they can be
+// dropped before the draw loops. Anything with children or side effects is always kept.
+_FORCE_INLINE_ bool _is_ysort_child_culled(VisualServerCanvas::Item *p_item, const Transform2D &p_parent_xform, const Rect2 &p_clip_rect) {
+
+	if (!p_item->visible)
+		return true;
+
+	if (p_item->child_items.size() || p_item->copy_back_buffer || p_item->vp_render || p_item->update_when_visible)
+		return false;
+
+	Rect2 global_rect = (p_parent_xform * p_item->ysort_xform * p_item->xform).xform(p_item->get_rect());
+	global_rect.position += p_clip_rect.position;
+
+	return !p_clip_rect.intersects(global_rect);
+}
+
 void _mark_ysort_dirty(VisualServerCanvas::Item *ysort_owner, RID_Owner<VisualServerCanvas::Item> &canvas_item_owner) {
 	while (ysort_owner && ysort_owner->sort_y) {
 		ysort_owner->ysort_children_count = -1;
@@ -125,16 +170,30 @@ void VisualServerCanvas::_render_canvas_item(Item *p_canvas_item, const Transfor
 		if (ci->ysort_children_count == -1) {
 			ci->ysort_children_count = 0;
 			_collect_ysort_children(ci, Transform2D(), NULL, ci->ysort_children_count);
-		}
 
-		child_item_count = ci->ysort_children_count;
-		child_items = (Item **)alloca(child_item_count * sizeof(Item *));
+			ci->ysort_children.resize(ci->ysort_children_count);
+			int i = 0;
+			_collect_ysort_children(ci, Transform2D(), ci->ysort_children.ptrw(), i);
 
-		int i = 0;
-		_collect_ysort_children(ci, Transform2D(), child_items, i);
+			SortArray<Item *, ItemPtrSort> sorter;
+			sorter.sort(ci->ysort_children.ptrw(), ci->ysort_children_count);
+		} else {
+			// Only refresh the positions, the list itself is still valid.
+			int i = 0;
+			_collect_ysort_children(ci, Transform2D(), NULL, i);
 
-		SortArray<Item *, ItemPtrSort> sorter;
-		sorter.sort(child_items, child_item_count);
+			_sort_ysort_children(ci->ysort_children.ptrw(), ci->ysort_children_count);
+		}
+
+		Item **sorted_items = ci->ysort_children.ptrw();
+		child_items = (Item **)alloca(ci->ysort_children_count * sizeof(Item *));
+		child_item_count = 0;
+
+		for (int i = 0; i < ci->ysort_children_count; i++) {
+			if (_is_ysort_child_culled(sorted_items[i], xform, p_clip_rect))
+				continue;
+			child_items[child_item_count++] = sorted_items[i];
+		}
 	}
 
 	if (ci->z_relative)
@@ -872,6 +931,9 @@ void VisualServerCanvas::canvas_item_set_sort_children_by_y(RID p_item, bool p_e
 	Item *canvas_item = canvas_item_owner.getornull(p_item);
 	ERR_FAIL_COND(!canvas_item);
 
+	// Mark before and after the change, so the y-sort owner above is also notified when disabling.
+	_mark_ysort_dirty(canvas_item, canvas_item_owner);
+
 	canvas_item->sort_y = p_enable;
 
 	_mark_ysort_dirty(canvas_item, canvas_item_owner);
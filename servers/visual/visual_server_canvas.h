@@ -53,6 +53,7 @@ public:
 		Vector2 ysort_pos;
 
 		Vector<Item *> child_items;
+		Vector<Item *> ysort_children; // kept in last frame's order, so re-sorting is mostly a no-op
 
 		Item() {
 			children_order_dirty = true;
@@ -32,6 +32,7 @@
 
 #include "core/io/marshalls.h"
 #include "core/os/os.h"
+#include "core/os/trace.h"
 #include "core/project_settings.h"
 #include "core/sort_array.h"
 #include "visual_server_canvas.h"
@@ -94,8 +95,11 @@ void VisualServerRaster::request_frame_drawn_callback(Object *p_where, const Str
 
 void VisualServerRaster::draw(bool p_swap_buffers, double frame_step) {
 
+	MemoryTagScope tag_scope(MEMORY_TAG_RENDERING);
+	TRACE_SCOPE("VisualServer::draw");
+
 	//needs to be done before changes is reset to 0, to not force the editor to redraw
-	VS::get_singleton()->emit_signal("frame_pre_draw");
+	VS::get_singleton()->emit_signal(SNAME("frame_pre_draw"));
 
 	changes = 0;
 
@@ -123,7 +127,7 @@ void VisualServerRaster::draw(bool p_swap_buffers, double frame_step) {
 
 		frame_drawn_callbacks.pop_front();
 	}
-	VS::get_singleton()->emit_signal("frame_post_draw");
+	VS::get_singleton()->emit_signal(SNAME("frame_post_draw"));
 }
 void VisualServerRaster::sync() {
 }
@@ -146,6 +150,12 @@ void VisualServerRaster::finish() {
 
 /* STATUS INFORMATION */
 
+void VisualServerRaster::video_memory_debug_usage(List<VideoMemoryInfo> *r_info) {
+
+	VSG::storage->video_memory_debug_usage(r_info);
+	VSG::scene_render->video_memory_debug_usage(r_info);
+}
+
 int VisualServerRaster::get_render_info(RenderInfo p_info) {
 
 	return VSG::storage->get_render_info(p_info);
@@ -168,6 +168,7 @@ public:
 	BIND1RC(String, texture_get_path, RID)
 	BIND1(texture_set_shrink_all_x2_on_set_data, bool)
 	BIND1(texture_debug_usage, List<TextureInfo> *)
+	virtual void video_memory_debug_usage(List<VideoMemoryInfo> *r_info);
 
 	BIND1(textures_keep_original, bool)
 
@@ -192,6 +193,9 @@ public:
 	BIND3(shader_set_default_texture_param, RID, const StringName &, RID)
 	BIND2RC(RID, shader_get_default_texture_param, RID, const StringName &)
 
+	BIND1RC(PoolIntArray, shader_get_compiled_variants, RID)
+	BIND2(shader_precompile_variants, RID, const PoolIntArray &)
+
 	/* COMMON MATERIAL API */
 
 	BIND0R(RID, material_create)
@@ -211,7 +215,7 @@ public:
 
 	BIND0R(RID, mesh_create)
 
-	BIND10(mesh_add_surface, RID, uint32_t, PrimitiveType, const PoolVector<uint8_t> &, int, const PoolVector<uint8_t> &, int, const AABB &, const Vector<PoolVector<uint8_t> > &, const Vector<AABB> &)
+	BIND11(mesh_add_surface, RID, uint32_t, PrimitiveType, const PoolVector<uint8_t> &, int, const PoolVector<uint8_t> &, int, const AABB &, const Vector<PoolVector<uint8_t> > &, const Vector<AABB> &, const Rect2 &)
 
 	BIND2(mesh_set_blend_shape_count, RID, int)
 	BIND1RC(int, mesh_get_blend_shape_count, RID)
@@ -220,6 +224,7 @@ public:
 	BIND1RC(BlendShapeMode, mesh_get_blend_shape_mode, RID)
 
 	BIND4(mesh_surface_update_region, RID, int, int, const PoolVector<uint8_t> &)
+	BIND4(mesh_surface_set_lods, RID, int, const Vector<PoolVector<uint8_t> > &, const Vector<float> &)
 
 	BIND3(mesh_surface_set_material, RID, int, RID)
 	BIND2RC(RID, mesh_surface_get_material, RID, int)
@@ -234,6 +239,7 @@ public:
 	BIND2RC(PrimitiveType, mesh_surface_get_primitive_type, RID, int)
 
 	BIND2RC(AABB, mesh_surface_get_aabb, RID, int)
+	BIND2RC(Rect2, mesh_surface_get_uv_range, RID, int)
 	BIND2RC(Vector<PoolVector<uint8_t> >, mesh_surface_get_blend_shapes, RID, int)
 	BIND2RC(Vector<AABB>, mesh_surface_get_skeleton_aabb, RID, int)
 
@@ -267,6 +273,7 @@ public:
 	BIND2RC(Color, multimesh_instance_get_custom_data, RID, int)
 
 	BIND2(multimesh_set_as_bulk_array, RID, const PoolVector<float> &)
+	BIND3(multimesh_set_as_bulk_array_range, RID, int, const PoolVector<float> &)
 
 	BIND2(multimesh_set_visible_instances, RID, int)
 	BIND1RC(int, multimesh_get_visible_instances, RID)
@@ -293,6 +300,7 @@ public:
 	BIND1RC(int, skeleton_get_bone_count, RID)
 	BIND3(skeleton_bone_set_transform, RID, int, const Transform &)
 	BIND2RC(Transform, skeleton_bone_get_transform, RID, int)
+	BIND2(skeleton_set_bone_transforms, RID, const PoolVector<float> &)
 	BIND3(skeleton_bone_set_transform_2d, RID, int, const Transform2D &)
 	BIND2RC(Transform2D, skeleton_bone_get_transform_2d, RID, int)
 	BIND2(skeleton_set_base_transform_2d, RID, const Transform2D &)
@@ -481,6 +489,11 @@ public:
 	BIND2(viewport_set_hdr, RID, bool)
 	BIND2(viewport_set_usage, RID, ViewportUsage)
 
+	BIND2(viewport_set_render_scale, RID, float)
+	BIND2(viewport_set_render_scale_sharpness, RID, float)
+	BIND4(viewport_set_dynamic_render_scale, RID, bool, float, float)
+	BIND1RC(float, viewport_get_current_render_scale, RID)
+
 	BIND2R(int, viewport_get_render_info, RID, ViewportRenderInfo)
 	BIND2(viewport_set_debug_draw, RID, ViewportDebugDraw)
 
@@ -535,6 +548,7 @@ public:
 	BIND2(instance_set_scenario, RID, RID) // from can be mesh, light, poly, area and portal so far.
 	BIND2(instance_set_layer_mask, RID, uint32_t)
 	BIND2(instance_set_transform, RID, const Transform &)
+	BIND2(instances_set_transforms, const Vector<RID> &, const PoolVector<float> &)
 	BIND2(instance_attach_object_instance_id, RID, ObjectID)
 	BIND3(instance_set_blend_shape_weight, RID, int, float)
 	BIND3(instance_set_surface_material, RID, int, RID)
@@ -29,7 +29,10 @@
 /*************************************************************************/
 
 #include "visual_server_scene.h"
+#include "core/engine.h"
 #include "core/os/os.h"
+#include "core/os/threaded_array_processor.h"
+#include "core/project_settings.h"
 #include "visual_server_globals.h"
 #include "visual_server_raster.h"
 #include <new>
@@ -247,6 +250,8 @@ RID VisualServerScene::scenario_create() {
 	RID scenario_rid = scenario_owner.make_rid(scenario);
 	scenario->self = scenario_rid;
 
+	scenario->octree.set_use_bvh(scenario_use_bvh);
+	scenario->octree.set_bvh_fat_margin(scenario_bvh_margin);
 	scenario->octree.set_pair_callback(_instance_pair, this);
 	scenario->octree.set_unpair_callback(_instance_unpair, this);
 	scenario->reflection_probe_shadow_atlas = VSG::scene_render->shadow_atlas_create();
@@ -569,12 +574,9 @@ void VisualServerScene::instance_set_layer_mask(RID p_instance, uint32_t p_mask)
 
 	instance->layer_mask = p_mask;
 }
-void VisualServerScene::instance_set_transform(RID p_instance, const Transform &p_transform) {
-
-	Instance *instance = instance_owner.get(p_instance);
-	ERR_FAIL_COND(!instance);
+void VisualServerScene::_instance_set_transform(Instance *p_instance, const Transform &p_transform) {
 
-	if (instance->transform == p_transform)
+	if (p_instance->transform == p_transform)
 		return; //must be checked to avoid worst evil
 
 #ifdef DEBUG_ENABLED
@@ -590,8 +592,41 @@ void VisualServerScene::instance_set_transform(RID p_instance, const Transform &
 	}
 
 #endif
-	instance->transform = p_transform;
-	_instance_queue_update(instance, true);
+	p_instance->transform = p_transform;
+	_instance_queue_update(p_instance, true);
+}
+
+void VisualServerScene::instance_set_transform(RID p_instance, const Transform &p_transform) {
+
+	Instance *instance = instance_owner.get(p_instance);
+	ERR_FAIL_COND(!instance);
+
+	_instance_set_transform(instance, p_transform);
+}
+
+void VisualServerScene::instances_set_transforms(const Vector<RID> &p_instances, const PoolVector<float> &p_transforms) {
+
+	int count = p_instances.size();
+	ERR_FAIL_COND(p_transforms.size() != count * 12);
+
+	const RID *rids = p_instances.ptr();
+	PoolVector<float>::Read r = p_transforms.read();
+	const float *data = r.ptr();
+
+	for (int i = 0; i < count; i++) {
+
+		Instance *instance = instance_owner.getornull(rids[i]);
+		ERR_CONTINUE(!instance);
+
+		const float *src = &data[i * 12];
+		Transform xform;
+		xform.basis.elements[0] = Vector3(src[0], src[1], src[2]);
+		xform.basis.elements[1] = Vector3(src[4], src[5], src[6]);
+		xform.basis.elements[2] = Vector3(src[8], src[9], src[10]);
+		xform.origin = Vector3(src[3], src[7], src[11]);
+
+		_instance_set_transform(instance, xform);
+	}
 }
 void VisualServerScene::instance_attach_object_instance_id(RID p_instance, ObjectID p_ID) {
 
@@ -847,6 +882,11 @@ void VisualServerScene::instance_geometry_set_flag(RID p_instance, VS::InstanceF
 
 			instance->redraw_if_visible = p_enabled;
 
+		} break;
+		case VS::INSTANCE_FLAG_OCCLUDER: {
+
+			instance->occluder = p_enabled;
+
 		} break;
 		default: {}
 	}
@@ -880,6 +920,26 @@ void VisualServerScene::instance_geometry_set_draw_range(RID p_instance, float p
 void VisualServerScene::instance_geometry_set_as_instance_lod(RID p_instance, RID p_as_lod_of_instance) {
 }
 
+// Whether geometry inside p_aabb can end up in the shadow map of p_light. Omni and spot
+// shadows only contain what lies within the light range, which is often much smaller
+// than the light AABB used for pairing (a sphere inside its bounding cube).
+static bool _light_range_intersects_aabb(const VisualServerScene::Instance *p_light, const AABB &p_aabb) {
+
+	if (VSG::storage->light_get_type(p_light->base) == VS::LIGHT_DIRECTIONAL)
+		return true;
+
+	Vector3 scale = p_light->transform.basis.get_scale().abs();
+	real_t range = VSG::storage->light_get_param(p_light->base, VS::LIGHT_PARAM_RANGE) * MAX(scale.x, MAX(scale.y, scale.z));
+
+	const Vector3 &center = p_light->transform.origin;
+	Vector3 closest(
+			CLAMP(center.x, p_aabb.position.x, p_aabb.position.x + p_aabb.size.x),
+			CLAMP(center.y, p_aabb.position.y, p_aabb.position.y + p_aabb.size.y),
+			CLAMP(center.z, p_aabb.position.z, p_aabb.position.z + p_aabb.size.z));
+
+	return closest.distance_squared_to(center) <= range * range;
+}
+
 void VisualServerScene::_update_instance(Instance *p_instance) {
 
 	p_instance->version++;
@@ -912,11 +972,19 @@ void VisualServerScene::_update_instance(Instance *p_instance) {
 	if ((1 << p_instance->base_type) & VS::INSTANCE_GEOMETRY_MASK) {
 
 		InstanceGeometryData *geom = static_cast<InstanceGeometryData *>(p_instance->base_data);
-		//make sure lights are updated if it casts shadow
+		//make sure lights are updated if it casts shadow, as long as the update can change what the shadow looks like
+		//(lightmap capture refreshes queue updates without touching the geometry)
+
+		if (geom->can_cast_shadows && (p_instance->update_aabb || p_instance->update_materials)) {
+			AABB new_aabb = p_instance->transform.xform(p_instance->aabb);
 
-		if (geom->can_cast_shadows) {
 			for (List<Instance *>::Element *E = geom->lighting.front(); E; E = E->next()) {
 				InstanceLightData *light = static_cast<InstanceLightData *>(E->get()->base_data);
+				if (light->shadow_dirty)
+					continue;
+				//both where it was and where it is now, so the old shadow gets cleared too
+				if (!_light_range_intersects_aabb(E->get(), p_instance->transformed_aabb) && !_light_range_intersects_aabb(E->get(), new_aabb))
+					continue;
 				light->shadow_dirty = true;
 			}
 		}
@@ -1283,6 +1351,198 @@ void VisualServerScene::_update_instance_lightmap_captures(Instance *p_instance)
 	}
 }
 
+void VisualServerScene::_cull_instance_geometry(uint32_t p_index, CullGeometryData *p_data) {
+
+	Instance *ins = instance_cull_result[p_index];
+	uint8_t flags = 0;
+
+	if ((p_data->camera_layer_mask & ins->layer_mask) == 0 || !ins->visible) {
+
+		//failure
+	} else if (ins->base_type == VS::INSTANCE_LIGHT || ins->base_type == VS::INSTANCE_REFLECTION_PROBE || ins->base_type == VS::INSTANCE_GI_PROBE) {
+
+		flags = CULL_FLAG_SERIAL;
+
+	} else if (((1 << ins->base_type) & VS::INSTANCE_GEOMETRY_MASK) && ins->cast_shadows != VS::SHADOW_CASTING_SETTING_SHADOWS_ONLY) {
+
+		flags = CULL_FLAG_KEEP;
+
+		if (ins->redraw_if_visible || ins->base_type == VS::INSTANCE_PARTICLES) {
+			flags |= CULL_FLAG_SERIAL;
+		}
+
+		InstanceGeometryData *geom = static_cast<InstanceGeometryData *>(ins->base_data);
+
+		if (geom->lighting_dirty) {
+			int l = 0;
+			//only called when lights AABB enter/exit this geometry
+			ins->light_instances.resize(geom->lighting.size());
+
+			for (List<Instance *>::Element *E = geom->lighting.front(); E; E = E->next()) {
+
+				InstanceLightData *light = static_cast<InstanceLightData *>(E->get()->base_data);
+
+				ins->light_instances.write[l++] = light->instance;
+			}
+
+			geom->lighting_dirty = false;
+		}
+
+		if (geom->reflection_dirty) {
+			int l = 0;
+			//only called when reflection probe AABB enter/exit this geometry
+			ins->reflection_probe_instances.resize(geom->reflection_probes.size());
+
+			for (List<Instance *>::Element *E = geom->reflection_probes.front(); E; E = E->next()) {
+
+				InstanceReflectionProbeData *reflection_probe = static_cast<InstanceReflectionProbeData *>(E->get()->base_data);
+
+				ins->reflection_probe_instances.write[l++] = reflection_probe->instance;
+			}
+
+			geom->reflection_dirty = false;
+		}
+
+		if (geom->gi_probes_dirty) {
+			int l = 0;
+			//only called when reflection probe AABB enter/exit this geometry
+			ins->gi_probe_instances.resize(geom->gi_probes.size());
+
+			for (List<Instance *>::Element *E = geom->gi_probes.front(); E; E = E->next()) {
+
+				InstanceGIProbeData *gi_probe = static_cast<InstanceGIProbeData *>(E->get()->base_data);
+
+				ins->gi_probe_instances.write[l++] = gi_probe->probe_instance;
+			}
+
+			geom->gi_probes_dirty = false;
+		}
+
+		ins->depth = p_data->near_plane.distance_to(ins->transform.origin);
+		ins->depth_layer = CLAMP(int(ins->depth * 16 / p_data->z_far), 0, 15);
+
+		if (p_data->lod_scale > 0) {
+			// projected size of the bounds diagonal, a mesh LOD is usable if its relative error stays below one threshold on screen
+			float screen_size = ins->transformed_aabb.size.length() * p_data->lod_scale;
+			if (!p_data->lod_orthogonal) {
+				screen_size /= MAX(ins->depth, 0.001);
+			}
+			ins->lod_error_limit = screen_size > CMP_EPSILON ? 1.0 / screen_size : 1e20;
+		} else {
+			ins->lod_error_limit = 0;
+		}
+	}
+
+	instance_cull_flags[p_index] = flags;
+}
+
+void VisualServerScene::_cull_shadow_caster(uint32_t p_index, CullShadowData *p_data) {
+
+	Instance *instance = instance_shadow_cull_result[p_index];
+	uint8_t flags = 0;
+
+	if (instance->visible && ((1 << instance->base_type) & VS::INSTANCE_GEOMETRY_MASK)) {
+
+		InstanceGeometryData *geom = static_cast<InstanceGeometryData *>(instance->base_data);
+		if (geom->can_cast_shadows) {
+			flags = CULL_FLAG_KEEP;
+			if (geom->material_is_animated) {
+				flags |= CULL_FLAG_ANIMATED;
+			}
+
+			instance->depth = p_data->near_plane.distance_to(instance->transform.origin);
+			instance->depth_layer = 0;
+		}
+	}
+
+	instance_shadow_cull_flags[p_index] = flags;
+}
+
+int VisualServerScene::_cull_shadow_casters(int p_cull_count, const Plane &p_near_plane, bool *r_animated_material_found) {
+
+	CullShadowData cull_data;
+	cull_data.near_plane = p_near_plane;
+
+	if (thread_cull_enabled && p_cull_count >= thread_cull_min_instances) {
+		thread_process_array(p_cull_count, this, &VisualServerScene::_cull_shadow_caster, &cull_data);
+	} else {
+		for (int i = 0; i < p_cull_count; i++) {
+			_cull_shadow_caster(i, &cull_data);
+		}
+	}
+
+	//compact keeping cull order, so shadow render lists are the same regardless of thread count
+	int keep_count = 0;
+	for (int i = 0; i < p_cull_count; i++) {
+
+		uint8_t flags = instance_shadow_cull_flags[i];
+		if (!(flags & CULL_FLAG_KEEP)) {
+			continue;
+		}
+
+		if (r_animated_material_found && (flags & CULL_FLAG_ANIMATED)) {
+			*r_animated_material_found = true;
+		}
+
+		instance_shadow_cull_result[keep_count++] = instance_shadow_cull_result[i];
+	}
+
+	return keep_count;
+}
+
+int VisualServerScene::_cull_light_shadow_casters(InstanceLightData *p_light, int p_pass, Scenario *p_scenario, const Plane *p_planes, int p_plane_count, const Plane &p_near_plane, bool *r_animated_material_found) {
+
+	if (p_light->shadow_casters_version != scene_version) {
+		p_light->shadow_casters_version = scene_version;
+		p_light->shadow_casters_valid = 0;
+		p_light->shadow_casters_animated = 0;
+	}
+
+	uint32_t pass_bit = 1 << p_pass;
+
+	if (p_light->shadow_casters_valid & pass_bit) {
+		// already culled for another shadow atlas (split screen, other viewports), only depth needs to be set again
+		const LocalVector<Instance *> &casters = p_light->shadow_casters[p_pass];
+		int cull_count = casters.size();
+
+		for (int i = 0; i < cull_count; i++) {
+
+			Instance *instance = casters[i];
+			instance->depth = p_near_plane.distance_to(instance->transform.origin);
+			instance->depth_layer = 0;
+			instance_shadow_cull_result[i] = instance;
+		}
+
+		if (r_animated_material_found && (p_light->shadow_casters_animated & pass_bit)) {
+			*r_animated_material_found = true;
+		}
+
+		return cull_count;
+	}
+
+	int cull_count = p_scenario->octree.cull_convex(p_planes, p_plane_count, instance_shadow_cull_result, MAX_INSTANCE_CULL, VS::INSTANCE_GEOMETRY_MASK);
+
+	bool animated_material_found = false;
+	cull_count = _cull_shadow_casters(cull_count, p_near_plane, &animated_material_found);
+
+	LocalVector<Instance *> &casters = p_light->shadow_casters[p_pass];
+	casters.resize(cull_count);
+	Instance **casters_ptr = casters.ptrw();
+	for (int i = 0; i < cull_count; i++) {
+		casters_ptr[i] = instance_shadow_cull_result[i];
+	}
+
+	p_light->shadow_casters_valid |= pass_bit;
+	if (animated_material_found) {
+		p_light->shadow_casters_animated |= pass_bit;
+		if (r_animated_material_found) {
+			*r_animated_material_found = true;
+		}
+	}
+
+	return cull_count;
+}
+
 bool VisualServerScene::_light_instance_update_shadow(Instance *p_instance, const Transform p_cam_transform, const CameraMatrix &p_cam_projection, bool p_cam_orthogonal, RID p_shadow_atlas, Scenario *p_scenario) {
 
 	InstanceLightData *light = static_cast<InstanceLightData *>(p_instance->base_data);
@@ -1372,6 +1632,22 @@ bool VisualServerScene::_light_instance_update_shadow(Instance *p_instance, cons
 
 			float first_radius = 0.0;
 
+			// Far splits can be reused from an earlier frame if they would be rendered from the exact same place,
+			// as long as nothing else (another camera, a reflection probe) rendered this light in between.
+			uint64_t frame = Engine::get_singleton()->get_frames_drawn();
+			if (light->directional_update_frame != frame) {
+				light->directional_shared = light->directional_updates_in_frame > 1;
+				light->directional_update_frame = frame;
+				light->directional_updates_in_frame = 0;
+			}
+			light->directional_updates_in_frame++;
+			if (light->directional_updates_in_frame > 1) {
+				light->directional_shared = true;
+			}
+
+			bool can_reuse_splits = directional_shadow_split_update_interval > 1 && !light->directional_shared && light->split_cache_basis == light_transform.basis;
+			light->split_cache_basis = light_transform.basis;
+
 			for (int i = 0; i < splits; i++) {
 
 				// setup a camera matrix for that range!
@@ -1492,41 +1768,48 @@ bool VisualServerScene::_light_instance_update_shadow(Instance *p_instance, cons
 					}
 				}
 
+				if (i > 0) {
+					InstanceLightData::DirectionalSplitCache &cache = light->split_cache[i];
+					Rect2 rect(x_min_cam, y_min_cam, x_max_cam - x_min_cam, y_max_cam - y_min_cam);
+
+					if (can_reuse_splits && cache.frame && frame - cache.frame < (uint64_t)directional_shadow_split_update_interval && cache.rect == rect && cache.z_min == z_min_cam && cache.split_far == distances[i + 1]) {
+						continue; // still valid, keep what was rendered last time
+					}
+
+					cache.frame = frame;
+					cache.rect = rect;
+					cache.z_min = z_min_cam;
+					cache.split_far = distances[i + 1];
+				}
+
 				//now that we now all ranges, we can proceed to make the light frustum planes, for culling octree
 
-				Vector<Plane> light_frustum_planes;
-				light_frustum_planes.resize(6);
+				SmallVector<Plane, 6> light_frustum_planes;
 
 				//right/left
-				light_frustum_planes.write[0] = Plane(x_vec, x_max);
-				light_frustum_planes.write[1] = Plane(-x_vec, -x_min);
+				light_frustum_planes.push_back(Plane(x_vec, x_max));
+				light_frustum_planes.push_back(Plane(-x_vec, -x_min));
 				//top/bottom
-				light_frustum_planes.write[2] = Plane(y_vec, y_max);
-				light_frustum_planes.write[3] = Plane(-y_vec, -y_min);
+				light_frustum_planes.push_back(Plane(y_vec, y_max));
+				light_frustum_planes.push_back(Plane(-y_vec, -y_min));
 				//near/far
-				light_frustum_planes.write[4] = Plane(z_vec, z_max + 1e6);
-				light_frustum_planes.write[5] = Plane(-z_vec, -z_min); // z_min is ok, since casters further than far-light plane are not needed
+				light_frustum_planes.push_back(Plane(z_vec, z_max + 1e6));
+				light_frustum_planes.push_back(Plane(-z_vec, -z_min)); // z_min is ok, since casters further than far-light plane are not needed
 
-				int cull_count = p_scenario->octree.cull_convex(light_frustum_planes, instance_shadow_cull_result, MAX_INSTANCE_CULL, VS::INSTANCE_GEOMETRY_MASK);
+				int cull_count = p_scenario->octree.cull_convex(light_frustum_planes.ptr(), light_frustum_planes.size(), instance_shadow_cull_result, MAX_INSTANCE_CULL, VS::INSTANCE_GEOMETRY_MASK);
 
 				// a pre pass will need to be needed to determine the actual z-near to be used
 
 				Plane near_plane(light_transform.origin, -light_transform.basis.get_axis(2));
 
+				cull_count = _cull_shadow_casters(cull_count, near_plane, NULL);
+
 				for (int j = 0; j < cull_count; j++) {
 
 					float min, max;
 					Instance *instance = instance_shadow_cull_result[j];
-					if (!instance->visible || !((1 << instance->base_type) & VS::INSTANCE_GEOMETRY_MASK) || !static_cast<InstanceGeometryData *>(instance->base_data)->can_cast_shadows) {
-						cull_count--;
-						SWAP(instance_shadow_cull_result[j], instance_shadow_cull_result[cull_count]);
-						j--;
-						continue;
-					}
 
 					instance->transformed_aabb.project_range_in_plane(Plane(z_vec, 0), min, max);
-					instance->depth = near_plane.distance_to(instance->transform.origin);
-					instance->depth_layer = 0;
 					if (max > z_max)
 						z_max = max;
 				}
@@ -1563,33 +1846,16 @@ bool VisualServerScene::_light_instance_update_shadow(Instance *p_instance, cons
 					float radius = VSG::storage->light_get_param(p_instance->base, VS::LIGHT_PARAM_RANGE);
 
 					float z = i == 0 ? -1 : 1;
-					Vector<Plane> planes;
-					planes.resize(5);
-					planes.write[0] = light_transform.xform(Plane(Vector3(0, 0, z), radius));
-					planes.write[1] = light_transform.xform(Plane(Vector3(1, 0, z).normalized(), radius));
-					planes.write[2] = light_transform.xform(Plane(Vector3(-1, 0, z).normalized(), radius));
-					planes.write[3] = light_transform.xform(Plane(Vector3(0, 1, z).normalized(), radius));
-					planes.write[4] = light_transform.xform(Plane(Vector3(0, -1, z).normalized(), radius));
-
-					int cull_count = p_scenario->octree.cull_convex(planes, instance_shadow_cull_result, MAX_INSTANCE_CULL, VS::INSTANCE_GEOMETRY_MASK);
-					Plane near_plane(light_transform.origin, light_transform.basis.get_axis(2) * z);
-
-					for (int j = 0; j < cull_count; j++) {
+					SmallVector<Plane, 6> planes;
+					planes.push_back(light_transform.xform(Plane(Vector3(0, 0, z), radius)));
+					planes.push_back(light_transform.xform(Plane(Vector3(1, 0, z).normalized(), radius)));
+					planes.push_back(light_transform.xform(Plane(Vector3(-1, 0, z).normalized(), radius)));
+					planes.push_back(light_transform.xform(Plane(Vector3(0, 1, z).normalized(), radius)));
+					planes.push_back(light_transform.xform(Plane(Vector3(0, -1, z).normalized(), radius)));
 
-						Instance *instance = instance_shadow_cull_result[j];
-						if (!instance->visible || !((1 << instance->base_type) & VS::INSTANCE_GEOMETRY_MASK) || !static_cast<InstanceGeometryData *>(instance->base_data)->can_cast_shadows) {
-							cull_count--;
-							SWAP(instance_shadow_cull_result[j], instance_shadow_cull_result[cull_count]);
-							j--;
-						} else {
-							if (static_cast<InstanceGeometryData *>(instance->base_data)->material_is_animated) {
-								animated_material_found = true;
-							}
+					Plane near_plane(light_transform.origin, light_transform.basis.get_axis(2) * z);
 
-							instance->depth = near_plane.distance_to(instance->transform.origin);
-							instance->depth_layer = 0;
-						}
-					}
+					int cull_count = _cull_light_shadow_casters(light, i, p_scenario, planes.ptr(), planes.size(), near_plane, &animated_material_found);
 
 					VSG::scene_render->light_instance_set_shadow_transform(light->instance, CameraMatrix(), light_transform, radius, 0, i);
 					VSG::scene_render->render_shadow(light->instance, p_shadow_atlas, i, (RasterizerScene::InstanceBase **)instance_shadow_cull_result, cull_count);
@@ -1625,24 +1891,8 @@ bool VisualServerScene::_light_instance_update_shadow(Instance *p_instance, cons
 
 					Vector<Plane> planes = cm.get_projection_planes(xform);
 
-					int cull_count = p_scenario->octree.cull_convex(planes, instance_shadow_cull_result, MAX_INSTANCE_CULL, VS::INSTANCE_GEOMETRY_MASK);
-
 					Plane near_plane(xform.origin, -xform.basis.get_axis(2));
-					for (int j = 0; j < cull_count; j++) {
-
-						Instance *instance = instance_shadow_cull_result[j];
-						if (!instance->visible || !((1 << instance->base_type) & VS::INSTANCE_GEOMETRY_MASK) || !static_cast<InstanceGeometryData *>(instance->base_data)->can_cast_shadows) {
-							cull_count--;
-							SWAP(instance_shadow_cull_result[j], instance_shadow_cull_result[cull_count]);
-							j--;
-						} else {
-							if (static_cast<InstanceGeometryData *>(instance->base_data)->material_is_animated) {
-								animated_material_found = true;
-							}
-							instance->depth = near_plane.distance_to(instance->transform.origin);
-							instance->depth_layer = 0;
-						}
-					}
+					int cull_count = _cull_light_shadow_casters(light, i, p_scenario, planes.ptr(), planes.size(), near_plane, &animated_material_found);
 
 					VSG::scene_render->light_instance_set_shadow_transform(light->instance, cm, xform, radius, 0, i);
 					VSG::scene_render->render_shadow(light->instance, p_shadow_atlas, i, (RasterizerScene::InstanceBase **)instance_shadow_cull_result, cull_count);
@@ -1662,24 +1912,8 @@ bool VisualServerScene::_light_instance_update_shadow(Instance *p_instance, cons
 			cm.set_perspective(angle * 2.0, 1.0, 0.01, radius);
 
 			Vector<Plane> planes = cm.get_projection_planes(light_transform);
-			int cull_count = p_scenario->octree.cull_convex(planes, instance_shadow_cull_result, MAX_INSTANCE_CULL, VS::INSTANCE_GEOMETRY_MASK);
-
 			Plane near_plane(light_transform.origin, -light_transform.basis.get_axis(2));
-			for (int j = 0; j < cull_count; j++) {
-
-				Instance *instance = instance_shadow_cull_result[j];
-				if (!instance->visible || !((1 << instance->base_type) & VS::INSTANCE_GEOMETRY_MASK) || !static_cast<InstanceGeometryData *>(instance->base_data)->can_cast_shadows) {
-					cull_count--;
-					SWAP(instance_shadow_cull_result[j], instance_shadow_cull_result[cull_count]);
-					j--;
-				} else {
-					if (static_cast<InstanceGeometryData *>(instance->base_data)->material_is_animated) {
-						animated_material_found = true;
-					}
-					instance->depth = near_plane.distance_to(instance->transform.origin);
-					instance->depth_layer = 0;
-				}
-			}
+			int cull_count = _cull_light_shadow_casters(light, 0, p_scenario, planes.ptr(), planes.size(), near_plane, &animated_material_found);
 
 			VSG::scene_render->light_instance_set_shadow_transform(light->instance, cm, light_transform, radius, 0, 0);
 			VSG::scene_render->render_shadow(light->instance, p_shadow_atlas, 0, (RasterizerScene::InstanceBase **)instance_shadow_cull_result, cull_count);
@@ -1725,7 +1959,7 @@ void VisualServerScene::render_camera(RID p_camera, RID p_scenario, Size2 p_view
 		} break;
 	}
 
-	_prepare_scene(camera->transform, camera_matrix, ortho, camera->env, camera->visible_layers, p_scenario, p_shadow_atlas, RID());
+	_prepare_scene(camera->transform, camera_matrix, ortho, camera->env, camera->visible_layers, p_scenario, p_shadow_atlas, RID(), p_viewport_size.height);
 	_render_scene(camera->transform, camera_matrix, ortho, camera->env, p_scenario, p_shadow_atlas, RID(), -1);
 #endif
 }
@@ -1804,17 +2038,72 @@ void VisualServerScene::render_camera(Ref<ARVRInterface> &p_interface, ARVRInter
 		mono_transform *= apply_z_shift;
 
 		// now prepare our scene with our adjusted transform projection matrix
-		_prepare_scene(mono_transform, combined_matrix, false, camera->env, camera->visible_layers, p_scenario, p_shadow_atlas, RID());
+		_prepare_scene(mono_transform, combined_matrix, false, camera->env, camera->visible_layers, p_scenario, p_shadow_atlas, RID(), p_viewport_size.height);
 	} else if (p_eye == ARVRInterface::EYE_MONO) {
 		// For mono render, prepare as per usual
-		_prepare_scene(cam_transform, camera_matrix, false, camera->env, camera->visible_layers, p_scenario, p_shadow_atlas, RID());
+		_prepare_scene(cam_transform, camera_matrix, false, camera->env, camera->visible_layers, p_scenario, p_shadow_atlas, RID(), p_viewport_size.height);
 	}
 
 	// And render our scene...
 	_render_scene(cam_transform, camera_matrix, false, camera->env, p_scenario, p_shadow_atlas, RID(), -1);
 };
 
-void VisualServerScene::_prepare_scene(const Transform p_cam_transform, const CameraMatrix &p_cam_projection, bool p_cam_orthogonal, RID p_force_environment, uint32_t p_visible_layers, RID p_scenario, RID p_shadow_atlas, RID p_reflection_probe) {
+void VisualServerScene::_cull_occluded_instance(uint32_t p_index, OcclusionBuffer *p_buffer) {
+
+	Instance *ins = instance_cull_result[p_index];
+	instance_cull_flags[p_index] = (!ins->occluder && p_buffer->is_occluded(ins->transformed_aabb)) ? CULL_FLAG_OCCLUDED : 0;
+}
+
+void VisualServerScene::_cull_occluded_instances(const Transform &p_cam_transform, const CameraMatrix &p_cam_projection) {
+
+	occlusion_buffer.begin(p_cam_projection, p_cam_transform, occlusion_buffer_width);
+
+	for (int i = 0; i < instance_cull_count; i++) {
+
+		Instance *ins = instance_cull_result[i];
+		if (!ins->occluder)
+			continue;
+
+		AABB box = ins->aabb;
+		if (ins->extra_margin)
+			box.grow_by(-ins->extra_margin); //the margin only enlarges the culling volume
+
+		if (box.size.x <= 0 || box.size.y <= 0 || box.size.z <= 0)
+			continue;
+
+		occlusion_buffer.add_box(box, ins->transform);
+	}
+
+	occlusion_buffer.end();
+
+	if (occlusion_buffer.is_empty())
+		return;
+
+	if (thread_cull_enabled && instance_cull_count >= thread_cull_min_instances) {
+		thread_process_array(instance_cull_count, this, &VisualServerScene::_cull_occluded_instance, &occlusion_buffer);
+	} else {
+		for (int i = 0; i < instance_cull_count; i++) {
+			_cull_occluded_instance(i, &occlusion_buffer);
+		}
+	}
+
+	int keep_count = 0;
+
+	for (int i = 0; i < instance_cull_count; i++) {
+
+		Instance *ins = instance_cull_result[i];
+
+		if (instance_cull_flags[i] & CULL_FLAG_OCCLUDED) {
+			ins->last_render_pass = 0; // make invalid
+		} else {
+			instance_cull_result[keep_count++] = ins;
+		}
+	}
+
+	instance_cull_count = keep_count;
+}
+
+void VisualServerScene::_prepare_scene(const Transform p_cam_transform, const CameraMatrix &p_cam_projection, bool p_cam_orthogonal, RID p_force_environment, uint32_t p_visible_layers, RID p_scenario, RID p_shadow_atlas, RID p_reflection_probe, float p_screen_height) {
 	// Note, in stereo rendering:
 	// - p_cam_transform will be a transform in the middle of our two eyes
 	// - p_cam_projection is a wider frustrum that encompasses both eyes
@@ -1853,18 +2142,38 @@ void VisualServerScene::_prepare_scene(const Transform p_cam_transform, const Ca
 
 	/* STEP 4 - REMOVE FURTHER CULLED OBJECTS, ADD LIGHTS */
 
-	for (int i = 0; i < instance_cull_count; i++) {
+	//geometry is classified in parallel, as it only touches the instance itself
+	CullGeometryData cull_data;
+	cull_data.camera_layer_mask = camera_layer_mask;
+	cull_data.near_plane = near_plane;
+	cull_data.z_far = z_far;
+	cull_data.lod_scale = 0;
+	cull_data.lod_orthogonal = p_cam_orthogonal;
+	if (mesh_lod_threshold > 0 && p_screen_height > 0) {
+		cull_data.lod_scale = p_cam_projection.matrix[1][1] * p_screen_height * 0.5 / mesh_lod_threshold;
+	}
 
-		Instance *ins = instance_cull_result[i];
+	if (thread_cull_enabled && instance_cull_count >= thread_cull_min_instances) {
+		thread_process_array(instance_cull_count, this, &VisualServerScene::_cull_instance_geometry, &cull_data);
+	} else {
+		for (int i = 0; i < instance_cull_count; i++) {
+			_cull_instance_geometry(i, &cull_data);
+		}
+	}
 
-		bool keep = false;
+	//anything touching shared state is processed here, in cull order, so results are deterministic
+	int keep_count = 0;
+
+	for (int i = 0; i < instance_cull_count; i++) {
 
-		if ((camera_layer_mask & ins->layer_mask) == 0) {
+		Instance *ins = instance_cull_result[i];
+		uint8_t flags = instance_cull_flags[i];
 
-			//failure
-		} else if (ins->base_type == VS::INSTANCE_LIGHT && ins->visible) {
+		if (!(flags & CULL_FLAG_SERIAL)) {
+			//nothing else to do
+		} else if (ins->base_type == VS::INSTANCE_LIGHT) {
 
-			if (ins->visible && light_cull_count < MAX_LIGHTS_CULLED) {
+			if (light_cull_count < MAX_LIGHTS_CULLED) {
 
 				InstanceLightData *light = static_cast<InstanceLightData *>(ins->base_data);
 
@@ -1879,9 +2188,9 @@ void VisualServerScene::_prepare_scene(const Transform p_cam_transform, const Ca
 					light_cull_count++;
 				}
 			}
-		} else if (ins->base_type == VS::INSTANCE_REFLECTION_PROBE && ins->visible) {
+		} else if (ins->base_type == VS::INSTANCE_REFLECTION_PROBE) {
 
-			if (ins->visible && reflection_probe_cull_count < MAX_REFLECTION_PROBES_CULLED) {
+			if (reflection_probe_cull_count < MAX_REFLECTION_PROBES_CULLED) {
 
 				InstanceReflectionProbeData *reflection_probe = static_cast<InstanceReflectionProbeData *>(ins->base_data);
 
@@ -1908,18 +2217,14 @@ void VisualServerScene::_prepare_scene(const Transform p_cam_transform, const Ca
 				}
 			}
 
-		} else if (ins->base_type == VS::INSTANCE_GI_PROBE && ins->visible) {
+		} else if (ins->base_type == VS::INSTANCE_GI_PROBE) {
 
 			InstanceGIProbeData *gi_probe = static_cast<InstanceGIProbeData *>(ins->base_data);
 			if (!gi_probe->update_element.in_list()) {
 				gi_probe_update_list.add(&gi_probe->update_element);
 			}
 
-		} else if (((1 << ins->base_type) & VS::INSTANCE_GEOMETRY_MASK) && ins->visible && ins->cast_shadows != VS::SHADOW_CASTING_SETTING_SHADOWS_ONLY) {
-
-			keep = true;
-
-			InstanceGeometryData *geom = static_cast<InstanceGeometryData *>(ins->base_data);
+		} else {
 
 			if (ins->redraw_if_visible) {
 				VisualServerRaster::redraw_request();
@@ -1929,75 +2234,33 @@ void VisualServerScene::_prepare_scene(const Transform p_cam_transform, const Ca
 				//particles visible? process them
 				if (VSG::storage->particles_is_inactive(ins->base)) {
 					//but if nothing is going on, don't do it.
-					keep = false;
+					flags &= ~CULL_FLAG_KEEP;
 				} else {
 					VSG::storage->particles_request_process(ins->base);
 					//particles visible? request redraw
 					VisualServerRaster::redraw_request();
 				}
 			}
-
-			if (geom->lighting_dirty) {
-				int l = 0;
-				//only called when lights AABB enter/exit this geometry
-				ins->light_instances.resize(geom->lighting.size());
-
-				for (List<Instance *>::Element *E = geom->lighting.front(); E; E = E->next()) {
-
-					InstanceLightData *light = static_cast<InstanceLightData *>(E->get()->base_data);
-
-					ins->light_instances.write[l++] = light->instance;
-				}
-
-				geom->lighting_dirty = false;
-			}
-
-			if (geom->reflection_dirty) {
-				int l = 0;
-				//only called when reflection probe AABB enter/exit this geometry
-				ins->reflection_probe_instances.resize(geom->reflection_probes.size());
-
-				for (List<Instance *>::Element *E = geom->reflection_probes.front(); E; E = E->next()) {
-
-					InstanceReflectionProbeData *reflection_probe = static_cast<InstanceReflectionProbeData *>(E->get()->base_data);
-
-					ins->reflection_probe_instances.write[l++] = reflection_probe->instance;
-				}
-
-				geom->reflection_dirty = false;
-			}
-
-			if (geom->gi_probes_dirty) {
-				int l = 0;
-				//only called when reflection probe AABB enter/exit this geometry
-				ins->gi_probe_instances.resize(geom->gi_probes.size());
-
-				for (List<Instance *>::Element *E = geom->gi_probes.front(); E; E = E->next()) {
-
-					InstanceGIProbeData *gi_probe = static_cast<InstanceGIProbeData *>(E->get()->base_data);
-
-					ins->gi_probe_instances.write[l++] = gi_probe->probe_instance;
-				}
-
-				geom->gi_probes_dirty = false;
-			}
-
-			ins->depth = near_plane.distance_to(ins->transform.origin);
-			ins->depth_layer = CLAMP(int(ins->depth * 16 / z_far), 0, 15);
 		}
 
-		if (!keep) {
+		if (!(flags & CULL_FLAG_KEEP)) {
 			// remove, no reason to keep
-			instance_cull_count--;
-			SWAP(instance_cull_result[i], instance_cull_result[instance_cull_count]);
-			i--;
 			ins->last_render_pass = 0; // make invalid
 		} else {
 
 			ins->last_render_pass = render_pass;
+			instance_cull_result[keep_count++] = ins;
 		}
 	}
 
+	instance_cull_count = keep_count;
+
+	/* STEP 4.5 - REMOVE OCCLUDED GEOMETRY */
+
+	if (occlusion_culling_enabled) {
+		_cull_occluded_instances(p_cam_transform, p_cam_projection);
+	}
+
 	/* STEP 5 - PROCESS LIGHTS */
 
 	RID *directional_light_ptr = &light_instance_cull_result[light_cull_count];
@@ -2035,6 +2298,17 @@ void VisualServerScene::_prepare_scene(const Transform p_cam_transform, const Ca
 
 		for (int i = 0; i < directional_shadow_count; i++) {
 
+			InstanceLightData *light = static_cast<InstanceLightData *>(lights_with_shadow[i]->base_data);
+
+			// the place of each light in the directional shadow texture depends on its index and on the light count
+			uint32_t slot = (uint32_t(i) << 8) | uint32_t(directional_shadow_count);
+			if (light->split_cache_slot != slot) {
+				light->split_cache_slot = slot;
+				for (int j = 0; j < 4; j++) {
+					light->split_cache[j].frame = 0;
+				}
+			}
+
 			_light_instance_update_shadow(lights_with_shadow[i], p_cam_transform, p_cam_projection, p_cam_orthogonal, p_shadow_atlas, scenario);
 		}
 	}
@@ -2234,7 +2508,8 @@ bool VisualServerScene::_render_reflection_probe_step(Instance *p_instance, int
 			shadow_atlas = scenario->reflection_probe_shadow_atlas;
 		}
 
-		_prepare_scene(xform, cm, false, RID(), VSG::storage->reflection_probe_get_cull_mask(p_instance->base), p_instance->scenario->self, shadow_atlas, reflection_probe->instance);
+		//probe resolution isn't known here, so probes are rendered at full mesh detail
+		_prepare_scene(xform, cm, false, RID(), VSG::storage->reflection_probe_get_cull_mask(p_instance->base), p_instance->scenario->self, shadow_atlas, reflection_probe->instance, 0);
 		_render_scene(xform, cm, false, RID(), p_instance->scenario->self, shadow_atlas, reflection_probe->instance, p_step);
 
 	} else {
@@ -3161,14 +3436,28 @@ void VisualServerScene::render_probes() {
 			} break;
 			case VS::REFLECTION_PROBE_UPDATE_ALWAYS: {
 
-				int step = 0;
+				if (reflection_probe_update_always_steps <= 0) {
+					int step = 0;
+					bool done = false;
+					while (!done) {
+						done = _render_reflection_probe_step(ref_probe->self()->owner, step);
+						step++;
+					}
+
+					reflection_probe_render_list.remove(ref_probe);
+					break;
+				}
+
+				//spread the faces and roughness passes over several frames, resuming where the last frame stopped
 				bool done = false;
-				while (!done) {
-					done = _render_reflection_probe_step(ref_probe->self()->owner, step);
-					step++;
+				for (int i = 0; i < reflection_probe_update_always_steps && !done; i++) {
+					done = _render_reflection_probe_step(ref_probe->self()->owner, ref_probe->self()->render_step);
+					ref_probe->self()->render_step++;
 				}
 
-				reflection_probe_render_list.remove(ref_probe);
+				if (done) {
+					reflection_probe_render_list.remove(ref_probe);
+				}
 			} break;
 		}
 
@@ -3424,6 +3713,8 @@ void VisualServerScene::_update_dirty_instance(Instance *p_instance) {
 
 void VisualServerScene::update_dirty_instances() {
 
+	scene_version++;
+
 	VSG::storage->update_dirty_resources();
 
 	while (_instance_update_list.first()) {
@@ -3488,7 +3779,26 @@ VisualServerScene::VisualServerScene() {
 	probe_bake_thread_exit = false;
 #endif
 
+	thread_cull_enabled = GLOBAL_DEF("rendering/threads/thread_culling", true);
+	thread_cull_min_instances = MAX(1, int(GLOBAL_DEF("rendering/threads/thread_culling_min_instances", 4096)));
+	directional_shadow_split_update_interval = MAX(1, int(GLOBAL_DEF("rendering/quality/directional_shadow/far_split_update_interval", 1)));
+	ProjectSettings::get_singleton()->set_custom_property_info("rendering/quality/directional_shadow/far_split_update_interval", PropertyInfo(Variant::INT, "rendering/quality/directional_shadow/far_split_update_interval", PROPERTY_HINT_RANGE, "1,16,1"));
+	reflection_probe_update_always_steps = MAX(0, int(GLOBAL_DEF("rendering/quality/reflections/update_always_steps_per_frame", 0)));
+	ProjectSettings::get_singleton()->set_custom_property_info("rendering/quality/reflections/update_always_steps_per_frame", PropertyInfo(Variant::INT, "rendering/quality/reflections/update_always_steps_per_frame", PROPERTY_HINT_RANGE, "0,16,1"));
+	mesh_lod_threshold = GLOBAL_DEF("rendering/quality/mesh_lod/threshold_pixels", 1.0);
+	ProjectSettings::get_singleton()->set_custom_property_info("rendering/quality/mesh_lod/threshold_pixels", PropertyInfo(Variant::REAL, "rendering/quality/mesh_lod/threshold_pixels", PROPERTY_HINT_RANGE, "0,16,0.01"));
+	ProjectSettings::get_singleton()->set_custom_property_info("rendering/threads/thread_culling_min_instances", PropertyInfo(Variant::INT, "rendering/threads/thread_culling_min_instances", PROPERTY_HINT_RANGE, "1,65536,1"));
+
+	occlusion_culling_enabled = GLOBAL_DEF("rendering/quality/occlusion_culling/enabled", false);
+	occlusion_buffer_width = GLOBAL_DEF("rendering/quality/occlusion_culling/buffer_width", 256);
+	ProjectSettings::get_singleton()->set_custom_property_info("rendering/quality/occlusion_culling/buffer_width", PropertyInfo(Variant::INT, "rendering/quality/occlusion_culling/buffer_width", PROPERTY_HINT_RANGE, "64,1024,1"));
+
+	scenario_use_bvh = GLOBAL_DEF("rendering/quality/spatial_partitioning/use_bvh", false);
+	scenario_bvh_margin = GLOBAL_DEF("rendering/quality/spatial_partitioning/bvh_expand_margin", 0.1);
+	ProjectSettings::get_singleton()->set_custom_property_info("rendering/quality/spatial_partitioning/bvh_expand_margin", PropertyInfo(Variant::REAL, "rendering/quality/spatial_partitioning/bvh_expand_margin", PROPERTY_HINT_RANGE, "0,10,0.001"));
+
 	render_pass = 1;
+	scene_version = 1;
 	singleton = this;
 }
 
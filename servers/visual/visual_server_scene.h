@@ -35,10 +35,13 @@
 
 #include "core/math/geometry.h"
 #include "core/math/octree.h"
+#include "core/math/spatial_index.h"
 #include "core/os/semaphore.h"
 #include "core/os/thread.h"
 #include "core/self_list.h"
+#include "core/small_vector.h"
 #include "servers/arvr/arvr_interface.h"
+#include "servers/visual/occlusion_buffer.h"
 
 class VisualServerScene {
 public:
@@ -52,6 +55,7 @@ public:
 	};
 
 	uint64_t render_pass;
+	uint64_t scene_version; // bumped every time dirty instances are flushed, culling done in between can be reused
 
 	static VisualServerScene *singleton;
 
@@ -120,7 +124,7 @@ public:
 		VS::ScenarioDebugMode debug;
 		RID self;
 
-		Octree<Instance, true> octree;
+		SpatialIndex<Instance, true> octree;
 
 		List<Instance *> directional_lights;
 		RID environment;
@@ -172,6 +176,8 @@ public:
 		float extra_margin;
 		uint32_t object_ID;
 
+		bool occluder; // hides what is behind its AABB, see OcclusionBuffer
+
 		float lod_begin;
 		float lod_end;
 		float lod_begin_hysteresis;
@@ -209,6 +215,7 @@ public:
 
 			object_ID = 0;
 			visible = true;
+			occluder = false;
 
 			lod_begin = 0;
 			lod_end = 0;
@@ -234,6 +241,7 @@ public:
 
 	SelfList<Instance>::List _instance_update_list;
 	void _instance_queue_update(Instance *p_instance, bool p_update_aabb, bool p_update_materials = false);
+	void _instance_set_transform(Instance *p_instance, const Transform &p_transform);
 
 	struct InstanceGeometryData : public InstanceBaseData {
 
@@ -303,12 +311,47 @@ public:
 
 		Instance *baked_light;
 
+		// Directional shadow splits past the first one may be kept from a previous frame.
+		struct DirectionalSplitCache {
+			uint64_t frame; // frame the split was last rendered in, 0 if never
+			Rect2 rect; // light space rect it was rendered with
+			float z_min;
+			float split_far;
+		};
+
+		DirectionalSplitCache split_cache[4];
+		Basis split_cache_basis;
+		uint32_t split_cache_slot; // shadowed directional light index and count the cache was rendered with
+		uint64_t directional_update_frame;
+		int directional_updates_in_frame;
+		bool directional_shared; // updated from more than one camera per frame, the shadow texture doesn't keep its content
+
+		// Omni and spot shadow casters per shadow pass, shared by every shadow atlas (viewports, reflection probes)
+		// that redraws this light while the scene stays unchanged.
+		LocalVector<Instance *> shadow_casters[6];
+		uint64_t shadow_casters_version; // scene_version the casters were culled in
+		uint32_t shadow_casters_valid; // bit per pass
+		uint32_t shadow_casters_animated; // bit per pass
+
 		InstanceLightData() {
 
 			shadow_dirty = true;
 			D = NULL;
 			last_version = 0;
 			baked_light = NULL;
+
+			for (int i = 0; i < 4; i++) {
+				split_cache[i].frame = 0;
+				split_cache[i].z_min = 0;
+				split_cache[i].split_far = 0;
+			}
+			split_cache_slot = 0;
+			directional_update_frame = 0;
+			directional_updates_in_frame = 0;
+			directional_shared = false;
+			shadow_casters_version = 0;
+			shadow_casters_valid = 0;
+			shadow_casters_animated = 0;
 		}
 	};
 
@@ -437,6 +480,8 @@ public:
 	int instance_cull_count;
 	Instance *instance_cull_result[MAX_INSTANCE_CULL];
 	Instance *instance_shadow_cull_result[MAX_INSTANCE_CULL]; //used for generating shadowmaps
+	uint8_t instance_cull_flags[MAX_INSTANCE_CULL];
+	uint8_t instance_shadow_cull_flags[MAX_INSTANCE_CULL];
 	Instance *light_cull_result[MAX_LIGHTS_CULLED];
 	RID light_instance_cull_result[MAX_LIGHTS_CULLED];
 	int light_cull_count;
@@ -444,6 +489,44 @@ public:
 	RID reflection_probe_instance_cull_result[MAX_REFLECTION_PROBES_CULLED];
 	int reflection_probe_cull_count;
 
+	enum {
+		CULL_FLAG_KEEP = 1,
+		CULL_FLAG_SERIAL = 2, //needs to touch shared state, processed after the parallel pass
+		CULL_FLAG_ANIMATED = 4,
+		CULL_FLAG_OCCLUDED = 8,
+	};
+
+	struct CullGeometryData {
+		uint32_t camera_layer_mask;
+		Plane near_plane;
+		float z_far;
+		float lod_scale; //on screen size of one unit at distance one, in LOD threshold units; 0 disables mesh LOD
+		bool lod_orthogonal;
+	};
+
+	struct CullShadowData {
+		Plane near_plane;
+	};
+
+	bool thread_cull_enabled;
+	float mesh_lod_threshold;
+	bool scenario_use_bvh;
+	float scenario_bvh_margin;
+	int thread_cull_min_instances;
+	int directional_shadow_split_update_interval;
+	int reflection_probe_update_always_steps;
+
+	bool occlusion_culling_enabled;
+	int occlusion_buffer_width;
+	OcclusionBuffer occlusion_buffer;
+
+	void _cull_instance_geometry(uint32_t p_index, CullGeometryData *p_data);
+	void _cull_occluded_instance(uint32_t p_index, OcclusionBuffer *p_buffer);
+	void _cull_occluded_instances(const Transform &p_cam_transform, const CameraMatrix &p_cam_projection);
+	void _cull_shadow_caster(uint32_t p_index, CullShadowData *p_data);
+	int _cull_shadow_casters(int p_cull_count, const Plane &p_near_plane, bool *r_animated_material_found);
+	int _cull_light_shadow_casters(InstanceLightData *p_light, int p_pass, Scenario *p_scenario, const Plane *p_planes, int p_plane_count, const Plane &p_near_plane, bool *r_animated_material_found);
+
 	RID_Owner<Instance> instance_owner;
 
 	// from can be mesh, light,  area and portal so far.
@@ -453,6 +536,7 @@ public:
 	virtual void instance_set_scenario(RID p_instance, RID p_scenario); // from can be mesh, light, poly, area and portal so far.
 	virtual void instance_set_layer_mask(RID p_instance, uint32_t p_mask);
 	virtual void instance_set_transform(RID p_instance, const Transform &p_transform);
+	virtual void instances_set_transforms(const Vector<RID> &p_instances, const PoolVector<float> &p_transforms);
 	virtual void instance_attach_object_instance_id(RID p_instance, ObjectID p_ID);
 	virtual void instance_set_blend_shape_weight(RID p_instance, int p_shape, float p_weight);
 	virtual void instance_set_surface_material(RID p_instance, int p_surface, RID p_material);
@@ -485,7 +569,7 @@ public:
 
 	_FORCE_INLINE_ bool _light_instance_update_shadow(Instance *p_instance, const Transform p_cam_transform, const CameraMatrix &p_cam_projection, bool p_cam_orthogonal, RID p_shadow_atlas, Scenario *p_scenario);
 
-	void _prepare_scene(const Transform p_cam_transform, const CameraMatrix &p_cam_projection, bool p_cam_orthogonal, RID p_force_environment, uint32_t p_visible_layers, RID p_scenario, RID p_shadow_atlas, RID p_reflection_probe);
+	void _prepare_scene(const Transform p_cam_transform, const CameraMatrix &p_cam_projection, bool p_cam_orthogonal, RID p_force_environment, uint32_t p_visible_layers, RID p_scenario, RID p_shadow_atlas, RID p_reflection_probe, float p_screen_height);
 	void _render_scene(const Transform p_cam_transform, const CameraMatrix &p_cam_projection, bool p_cam_orthogonal, RID p_force_environment, RID p_scenario, RID p_shadow_atlas, RID p_reflection_probe, int p_reflection_probe_pass);
 	void render_empty_scene(RID p_scenario, RID p_shadow_atlas);
 
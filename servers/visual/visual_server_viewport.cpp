@@ -66,6 +66,8 @@ void VisualServerViewport::_draw_viewport(Viewport *p_viewport, ARVRInterface::E
 
 		if (p_viewport->use_arvr && arvr_interface.is_valid()) {
 			VSG::scene->render_camera(arvr_interface, p_eye, p_viewport->camera, p_viewport->scenario, p_viewport->size, p_viewport->shadow_atlas);
+		} else if (p_viewport->current_render_scale < 1.0) {
+			_render_camera_scaled(p_viewport);
 		} else {
 			VSG::scene->render_camera(p_viewport->camera, p_viewport->scenario, p_viewport->size, p_viewport->shadow_atlas);
 		}
@@ -143,9 +145,9 @@ void VisualServerViewport::_draw_viewport(Viewport *p_viewport, ARVRInterface::E
 		if (lights_with_shadow) {
 			//update shadows if any
 
-			RasterizerCanvas::LightOccluderInstance *occluders = NULL;
+			RasterizerCanvas::LightOccluderInstance *occluder_candidates = NULL;
 
-			//make list of occluders
+			//make list of occluders that may cast shadows for any light
 			for (Map<RID, Viewport::CanvasData>::Element *E = p_viewport->canvas_map.front(); E; E = E->next()) {
 
 				VisualServerCanvas::Canvas *canvas = static_cast<VisualServerCanvas::Canvas *>(E->get().canvas);
@@ -158,15 +160,29 @@ void VisualServerViewport::_draw_viewport(Viewport *p_viewport, ARVRInterface::E
 					F->get()->xform_cache = xf * F->get()->xform;
 					if (shadow_rect.intersects_transformed(F->get()->xform_cache, F->get()->aabb_cache)) {
 
-						F->get()->next = occluders;
-						occluders = F->get();
+						F->get()->candidate_next_ptr = occluder_candidates;
+						occluder_candidates = F->get();
 					}
 				}
 			}
-			//update the light shadowmaps with them
+			//update the light shadowmaps, each one only with the occluders it can actually see
 			RasterizerCanvas::Light *light = lights_with_shadow;
 			while (light) {
 
+				Rect2 light_rect = light->xform_cache.xform(light->rect_cache);
+				RasterizerCanvas::LightOccluderInstance *occluders = NULL;
+
+				for (RasterizerCanvas::LightOccluderInstance *occluder = occluder_candidates; occluder; occluder = occluder->candidate_next_ptr) {
+
+					if (!(light->item_shadow_mask & occluder->light_mask))
+						continue;
+					if (!light_rect.intersects_transformed(occluder->xform_cache, occluder->aabb_cache))
+						continue;
+
+					occluder->next = occluders;
+					occluders = occluder;
+				}
+
 				VSG::canvas_render->canvas_light_shadow_buffer_update(light->shadow_buffer, light->xform_cache.affine_inverse(), light->item_shadow_mask, light->radius_cache / 1000.0, light->radius_cache * 1.1, occluders, &light->shadow_matrix_cache);
 				light = light->shadows_next_ptr;
 			}
@@ -242,6 +258,61 @@ void VisualServerViewport::_draw_viewport(Viewport *p_viewport, ARVRInterface::E
 	}
 }
 
+void VisualServerViewport::_render_camera_scaled(Viewport *p_viewport) {
+
+	Size2i scaled_size = (Size2(p_viewport->size.x, p_viewport->size.y) * p_viewport->current_render_scale).floor();
+	scaled_size.x = MAX(scaled_size.x, 1);
+	scaled_size.y = MAX(scaled_size.y, 1);
+	VSG::storage->render_target_set_size(p_viewport->scaled_render_target, scaled_size.x, scaled_size.y);
+
+	VSG::rasterizer->set_current_render_target(p_viewport->scaled_render_target);
+	VSG::rasterizer->clear_render_target(p_viewport->transparent_bg ? Color(0, 0, 0, 0) : clear_color);
+	VSG::scene->render_camera(p_viewport->camera, p_viewport->scenario, scaled_size, p_viewport->shadow_atlas);
+
+	// the upscaled 3D covers the whole viewport, canvas layers are then drawn on top at native resolution
+	VSG::rasterizer->set_current_render_target(p_viewport->render_target);
+	VSG::rasterizer->blit_render_target_to_current(p_viewport->scaled_render_target, p_viewport->render_scale_sharpness);
+}
+
+#define RENDER_SCALE_STEP 0.05
+#define RENDER_SCALE_COOLDOWN_FRAMES 8
+
+void VisualServerViewport::_update_render_scale(Viewport *p_viewport, float p_gpu_msec) {
+
+	if (!p_viewport->dynamic_render_scale) {
+		p_viewport->current_render_scale = p_viewport->render_scale;
+		return;
+	}
+
+	// GPU timings arrive a few frames late, so give every change time to show up before reacting again
+	if (p_viewport->dynamic_render_scale_cooldown > 0) {
+		p_viewport->dynamic_render_scale_cooldown--;
+		return;
+	}
+
+	if (p_gpu_msec <= 0.0) {
+		return; //no timings from this driver
+	}
+
+	// fragment cost follows the pixel count, which goes with the square of the scale
+	float desired = p_viewport->current_render_scale * Math::sqrt(p_viewport->dynamic_render_scale_target_msec / p_gpu_msec);
+	desired = CLAMP(desired, p_viewport->dynamic_render_scale_min, p_viewport->render_scale);
+
+	float delta = desired - p_viewport->current_render_scale;
+	if (delta < -RENDER_SCALE_STEP) {
+		// over budget, drop fast
+		delta = MAX(delta, -RENDER_SCALE_STEP * 4);
+	} else if (delta > RENDER_SCALE_STEP * 2) {
+		// under budget by a margin, recover slowly so we don't oscillate around the target
+		delta = RENDER_SCALE_STEP;
+	} else {
+		return;
+	}
+
+	p_viewport->current_render_scale = CLAMP(p_viewport->current_render_scale + delta, p_viewport->dynamic_render_scale_min, p_viewport->render_scale);
+	p_viewport->dynamic_render_scale_cooldown = RENDER_SCALE_COOLDOWN_FRAMES;
+}
+
 void VisualServerViewport::draw_viewports() {
 	// get our arvr interface in case we need it
 	Ref<ARVRInterface> arvr_interface = ARVRServer::get_singleton()->get_primary_interface();
@@ -256,6 +327,17 @@ void VisualServerViewport::draw_viewports() {
 	//sort viewports
 	active_viewports.sort_custom<ViewportSort>();
 
+	// the timings are for the whole frame, so every viewport with a dynamic scale shares one budget
+	uint64_t gpu_usec = 0;
+	gpu_usec += VSG::storage->get_render_info(VS::INFO_GPU_SHADOWS_TIME_USEC);
+	gpu_usec += VSG::storage->get_render_info(VS::INFO_GPU_OPAQUE_TIME_USEC);
+	gpu_usec += VSG::storage->get_render_info(VS::INFO_GPU_ALPHA_TIME_USEC);
+	gpu_usec += VSG::storage->get_render_info(VS::INFO_GPU_SSAO_TIME_USEC);
+	gpu_usec += VSG::storage->get_render_info(VS::INFO_GPU_SSR_TIME_USEC);
+	gpu_usec += VSG::storage->get_render_info(VS::INFO_GPU_POST_PROCESS_TIME_USEC); //includes glow
+	gpu_usec += VSG::storage->get_render_info(VS::INFO_GPU_CANVAS_TIME_USEC);
+	float gpu_msec = gpu_usec / 1000.0;
+
 	//draw viewports
 	for (int i = 0; i < active_viewports.size(); i++) {
 
@@ -274,6 +356,11 @@ void VisualServerViewport::draw_viewports() {
 
 		VSG::storage->render_target_clear_used(vp->render_target);
 
+		_update_render_scale(vp, gpu_msec);
+		if (vp->current_render_scale >= 1.0 || (vp->use_arvr && arvr_interface.is_valid())) {
+			VSG::storage->render_target_set_size(vp->scaled_render_target, 0, 0); //release it while unused
+		}
+
 		if (vp->use_arvr && arvr_interface.is_valid()) {
 			// override our size, make sure it matches our required size
 			Size2 size = arvr_interface->get_render_targetsize();
@@ -337,6 +424,7 @@ RID VisualServerViewport::viewport_create() {
 	viewport->hide_scenario = false;
 	viewport->hide_canvas = false;
 	viewport->render_target = VSG::storage->render_target_create();
+	viewport->scaled_render_target = VSG::storage->render_target_create();
 	viewport->shadow_atlas = VSG::scene_render->shadow_atlas_create();
 
 	return rid;
@@ -419,6 +507,7 @@ void VisualServerViewport::viewport_set_vflip(RID p_viewport, bool p_enable) {
 	ERR_FAIL_COND(!viewport);
 
 	VSG::storage->render_target_set_flag(viewport->render_target, RasterizerStorage::RENDER_TARGET_VFLIP, p_enable);
+	VSG::storage->render_target_set_flag(viewport->scaled_render_target, RasterizerStorage::RENDER_TARGET_VFLIP, p_enable);
 }
 
 RID VisualServerViewport::viewport_get_texture(RID p_viewport) const {
@@ -468,6 +557,7 @@ void VisualServerViewport::viewport_set_keep_3d_linear(RID p_viewport, bool p_ke
 
 	viewport->keep_3d_linear = p_keep_3d_linear;
 	VSG::storage->render_target_set_flag(viewport->render_target, RasterizerStorage::RENDER_TARGET_KEEP_3D_LINEAR, p_keep_3d_linear);
+	VSG::storage->render_target_set_flag(viewport->scaled_render_target, RasterizerStorage::RENDER_TARGET_KEEP_3D_LINEAR, p_keep_3d_linear);
 }
 
 void VisualServerViewport::viewport_attach_camera(RID p_viewport, RID p_camera) {
@@ -525,6 +615,7 @@ void VisualServerViewport::viewport_set_transparent_background(RID p_viewport, b
 	ERR_FAIL_COND(!viewport);
 
 	VSG::storage->render_target_set_flag(viewport->render_target, RasterizerStorage::RENDER_TARGET_TRANSPARENT, p_enabled);
+	VSG::storage->render_target_set_flag(viewport->scaled_render_target, RasterizerStorage::RENDER_TARGET_TRANSPARENT, p_enabled);
 	viewport->transparent_bg = p_enabled;
 }
 
@@ -569,6 +660,7 @@ void VisualServerViewport::viewport_set_msaa(RID p_viewport, VS::ViewportMSAA p_
 	ERR_FAIL_COND(!viewport);
 
 	VSG::storage->render_target_set_msaa(viewport->render_target, p_msaa);
+	VSG::storage->render_target_set_msaa(viewport->scaled_render_target, p_msaa);
 }
 
 void VisualServerViewport::viewport_set_hdr(RID p_viewport, bool p_enabled) {
@@ -577,6 +669,7 @@ void VisualServerViewport::viewport_set_hdr(RID p_viewport, bool p_enabled) {
 	ERR_FAIL_COND(!viewport);
 
 	VSG::storage->render_target_set_flag(viewport->render_target, RasterizerStorage::RENDER_TARGET_HDR, p_enabled);
+	VSG::storage->render_target_set_flag(viewport->scaled_render_target, RasterizerStorage::RENDER_TARGET_HDR, p_enabled);
 }
 
 void VisualServerViewport::viewport_set_usage(RID p_viewport, VS::ViewportUsage p_usage) {
@@ -615,6 +708,48 @@ void VisualServerViewport::viewport_set_usage(RID p_viewport, VS::ViewportUsage
 			viewport->disable_3d_by_usage = false;
 		} break;
 	}
+
+	VSG::storage->render_target_set_flag(viewport->scaled_render_target, RasterizerStorage::RENDER_TARGET_NO_3D_EFFECTS, p_usage == VS::VIEWPORT_USAGE_3D_NO_EFFECTS);
+}
+
+void VisualServerViewport::viewport_set_render_scale(RID p_viewport, float p_scale) {
+
+	Viewport *viewport = viewport_owner.getornull(p_viewport);
+	ERR_FAIL_COND(!viewport);
+
+	viewport->render_scale = CLAMP(p_scale, 0.1, 1.0);
+	viewport->current_render_scale = viewport->dynamic_render_scale ? MIN(viewport->current_render_scale, viewport->render_scale) : viewport->render_scale;
+}
+
+void VisualServerViewport::viewport_set_render_scale_sharpness(RID p_viewport, float p_sharpness) {
+
+	Viewport *viewport = viewport_owner.getornull(p_viewport);
+	ERR_FAIL_COND(!viewport);
+
+	viewport->render_scale_sharpness = CLAMP(p_sharpness, 0.0, 1.0);
+}
+
+void VisualServerViewport::viewport_set_dynamic_render_scale(RID p_viewport, bool p_enabled, float p_target_frame_msec, float p_min_scale) {
+
+	Viewport *viewport = viewport_owner.getornull(p_viewport);
+	ERR_FAIL_COND(!viewport);
+	ERR_FAIL_COND(p_target_frame_msec <= 0.0);
+
+	viewport->dynamic_render_scale = p_enabled;
+	viewport->dynamic_render_scale_target_msec = p_target_frame_msec;
+	viewport->dynamic_render_scale_min = CLAMP(p_min_scale, 0.1, 1.0);
+	viewport->dynamic_render_scale_cooldown = 0;
+	if (!p_enabled) {
+		viewport->current_render_scale = viewport->render_scale;
+	}
+}
+
+float VisualServerViewport::viewport_get_current_render_scale(RID p_viewport) const {
+
+	const Viewport *viewport = viewport_owner.getornull(p_viewport);
+	ERR_FAIL_COND_V(!viewport, 1.0);
+
+	return viewport->current_render_scale;
 }
 
 int VisualServerViewport::viewport_get_render_info(RID p_viewport, VS::ViewportRenderInfo p_info) {
@@ -643,6 +778,7 @@ bool VisualServerViewport::free(RID p_rid) {
 		Viewport *viewport = viewport_owner.getornull(p_rid);
 
 		VSG::storage->free(viewport->render_target);
+		VSG::storage->free(viewport->scaled_render_target);
 		VSG::scene_render->free(viewport->shadow_atlas);
 
 		while (viewport->canvas_map.front()) {
@@ -56,6 +56,16 @@ public:
 		RID render_target;
 		RID render_target_texture;
 
+		/* 3D is drawn into scaled_render_target at current_render_scale and upscaled, 2D stays native */
+		RID scaled_render_target;
+		float render_scale;
+		float render_scale_sharpness;
+		float current_render_scale;
+		bool dynamic_render_scale;
+		float dynamic_render_scale_target_msec;
+		float dynamic_render_scale_min;
+		int dynamic_render_scale_cooldown;
+
 		int viewport_to_screen;
 		Rect2 viewport_to_screen_rect;
 
@@ -123,6 +133,13 @@ public:
 				render_info[i] = 0;
 			}
 			use_arvr = false;
+			render_scale = 1.0;
+			render_scale_sharpness = 0.5;
+			current_render_scale = 1.0;
+			dynamic_render_scale = false;
+			dynamic_render_scale_target_msec = 16.0;
+			dynamic_render_scale_min = 0.5;
+			dynamic_render_scale_cooldown = 0;
 		}
 	};
 
@@ -148,6 +165,8 @@ public:
 private:
 	Color clear_color;
 	void _draw_viewport(Viewport *p_viewport, ARVRInterface::Eyes p_eye = ARVRInterface::EYE_MONO);
+	void _render_camera_scaled(Viewport *p_viewport);
+	void _update_render_scale(Viewport *p_viewport, float p_gpu_msec);
 
 public:
 	RID viewport_create();
@@ -191,6 +210,11 @@ public:
 	void viewport_set_hdr(RID p_viewport, bool p_enabled);
 	void viewport_set_usage(RID p_viewport, VS::ViewportUsage p_usage);
 
+	void viewport_set_render_scale(RID p_viewport, float p_scale);
+	void viewport_set_render_scale_sharpness(RID p_viewport, float p_sharpness);
+	void viewport_set_dynamic_render_scale(RID p_viewport, bool p_enabled, float p_target_frame_msec, float p_min_scale);
+	float viewport_get_current_render_scale(RID p_viewport) const;
+
 	virtual int viewport_get_render_info(RID p_viewport, VS::ViewportRenderInfo p_info);
 	virtual void viewport_set_debug_draw(RID p_viewport, VS::ViewportDebugDraw p_draw);
 
@@ -39,7 +39,14 @@ void VisualServerWrapMT::thread_exit() {
 
 void VisualServerWrapMT::thread_draw(bool p_swap_buffers, double frame_step) {
 
-	if (!atomic_decrement(&draw_pending)) {
+	bool skip = atomic_decrement(&draw_pending) != 0;
+
+	if (max_frames_in_flight > 1) {
+		//pipelined frames are throttled by the main thread, so every queued frame is drawn
+		visual_server->draw(p_swap_buffers, frame_step);
+		atomic_decrement(&frames_in_flight);
+		frame_semaphore->post();
+	} else if (!skip) {
 
 		visual_server->draw(p_swap_buffers, frame_step);
 	}
@@ -91,11 +98,32 @@ void VisualServerWrapMT::sync() {
 	}
 }
 
+void VisualServerWrapMT::sync_frame() {
+
+	uint64_t sync_begin = OS::get_singleton()->get_ticks_usec();
+
+	if (create_thread && max_frames_in_flight > 1) {
+
+		//only wait for the render thread once it falls too many frames behind
+		while (frames_in_flight >= (uint32_t)max_frames_in_flight) {
+			frame_semaphore->wait();
+		}
+	} else {
+
+		sync();
+	}
+
+	frame_sync_usec = OS::get_singleton()->get_ticks_usec() - sync_begin;
+}
+
 void VisualServerWrapMT::draw(bool p_swap_buffers, double frame_step) {
 
 	if (create_thread) {
 
 		atomic_increment(&draw_pending);
+		if (max_frames_in_flight > 1) {
+			atomic_increment(&frames_in_flight);
+		}
 		command_queue.push(this, &VisualServerWrapMT::thread_draw, p_swap_buffers, frame_step);
 	} else {
 
@@ -181,6 +209,16 @@ VisualServerWrapMT::VisualServerWrapMT(VisualServer *p_contained, bool p_create_
 	alloc_mutex = Mutex::create();
 	pool_max_size = GLOBAL_GET("memory/limits/multithreaded_server/rid_pool_prealloc");
 
+	max_frames_in_flight = GLOBAL_DEF("rendering/threads/max_frames_in_flight", 1);
+	ProjectSettings::get_singleton()->set_custom_property_info("rendering/threads/max_frames_in_flight", PropertyInfo(Variant::INT, "rendering/threads/max_frames_in_flight", PROPERTY_HINT_RANGE, "1,3,1"));
+	max_frames_in_flight = CLAMP(max_frames_in_flight, 1, 3);
+	frames_in_flight = 0;
+	frame_semaphore = p_create_thread ? Semaphore::create() : NULL;
+	if (!frame_semaphore) {
+		max_frames_in_flight = 1;
+	}
+	frame_sync_usec = 0;
+
 	if (!p_create_thread) {
 		server_thread = Thread::get_caller_id();
 	} else {
@@ -192,5 +230,8 @@ VisualServerWrapMT::~VisualServerWrapMT() {
 
 	memdelete(visual_server);
 	memdelete(alloc_mutex);
+	if (frame_semaphore) {
+		memdelete(frame_semaphore);
+	}
 	//finish();
 }
@@ -55,6 +55,10 @@ class VisualServerWrapMT : public VisualServer {
 	bool create_thread;
 
 	uint64_t draw_pending;
+	int max_frames_in_flight;
+	uint32_t frames_in_flight;
+	Semaphore *frame_semaphore;
+	uint64_t frame_sync_usec;
 	void thread_draw(bool p_swap_buffers, double frame_step);
 	void thread_flush();
 
@@ -104,6 +108,7 @@ public:
 	FUNC1RC(String, texture_get_path, RID)
 	FUNC1(texture_set_shrink_all_x2_on_set_data, bool)
 	FUNC1(texture_debug_usage, List<TextureInfo> *)
+	FUNC1(video_memory_debug_usage, List<VideoMemoryInfo> *)
 
 	FUNC1(textures_keep_original, bool)
 
@@ -128,6 +133,9 @@ public:
 	FUNC3(shader_set_default_texture_param, RID, const StringName &, RID)
 	FUNC2RC(RID, shader_get_default_texture_param, RID, const StringName &)
 
+	FUNC1RC(PoolIntArray, shader_get_compiled_variants, RID)
+	FUNC2(shader_precompile_variants, RID, const PoolIntArray &)
+
 	/* COMMON MATERIAL API */
 
 	FUNCRID(material)
@@ -147,7 +155,7 @@ public:
 
 	FUNCRID(mesh)
 
-	FUNC10(mesh_add_surface, RID, uint32_t, PrimitiveType, const PoolVector<uint8_t> &, int, const PoolVector<uint8_t> &, int, const AABB &, const Vector<PoolVector<uint8_t> > &, const Vector<AABB> &)
+	FUNC11(mesh_add_surface, RID, uint32_t, PrimitiveType, const PoolVector<uint8_t> &, int, const PoolVector<uint8_t> &, int, const AABB &, const Vector<PoolVector<uint8_t> > &, const Vector<AABB> &, const Rect2 &)
 
 	FUNC2(mesh_set_blend_shape_count, RID, int)
 	FUNC1RC(int, mesh_get_blend_shape_count, RID)
@@ -156,6 +164,7 @@ public:
 	FUNC1RC(BlendShapeMode, mesh_get_blend_shape_mode, RID)
 
 	FUNC4(mesh_surface_update_region, RID, int, int, const PoolVector<uint8_t> &)
+	FUNC4(mesh_surface_set_lods, RID, int, const Vector<PoolVector<uint8_t> > &, const Vector<float> &)
 
 	FUNC3(mesh_surface_set_material, RID, int, RID)
 	FUNC2RC(RID, mesh_surface_get_material, RID, int)
@@ -170,6 +179,7 @@ public:
 	FUNC2RC(PrimitiveType, mesh_surface_get_primitive_type, RID, int)
 
 	FUNC2RC(AABB, mesh_surface_get_aabb, RID, int)
+	FUNC2RC(Rect2, mesh_surface_get_uv_range, RID, int)
 	FUNC2RC(Vector<PoolVector<uint8_t> >, mesh_surface_get_blend_shapes, RID, int)
 	FUNC2RC(Vector<AABB>, mesh_surface_get_skeleton_aabb, RID, int)
 
@@ -203,6 +213,7 @@ public:
 	FUNC2RC(Color, multimesh_instance_get_custom_data, RID, int)
 
 	FUNC2(multimesh_set_as_bulk_array, RID, const PoolVector<float> &)
+	FUNC3(multimesh_set_as_bulk_array_range, RID, int, const PoolVector<float> &)
 
 	FUNC2(multimesh_set_visible_instances, RID, int)
 	FUNC1RC(int, multimesh_get_visible_instances, RID)
@@ -229,6 +240,7 @@ public:
 	FUNC1RC(int, skeleton_get_bone_count, RID)
 	FUNC3(skeleton_bone_set_transform, RID, int, const Transform &)
 	FUNC2RC(Transform, skeleton_bone_get_transform, RID, int)
+	FUNC2(skeleton_set_bone_transforms, RID, const PoolVector<float> &)
 	FUNC3(skeleton_bone_set_transform_2d, RID, int, const Transform2D &)
 	FUNC2RC(Transform2D, skeleton_bone_get_transform_2d, RID, int)
 	FUNC2(skeleton_set_base_transform_2d, RID, const Transform2D &)
@@ -408,6 +420,11 @@ public:
 	FUNC2(viewport_set_hdr, RID, bool)
 	FUNC2(viewport_set_usage, RID, ViewportUsage)
 
+	FUNC2(viewport_set_render_scale, RID, float)
+	FUNC2(viewport_set_render_scale_sharpness, RID, float)
+	FUNC4(viewport_set_dynamic_render_scale, RID, bool, float, float)
+	FUNC1RC(float, viewport_get_current_render_scale, RID)
+
 	//this passes directly to avoid stalling, but it's pretty dangerous, so don't call after freeing a viewport
 	virtual int viewport_get_render_info(RID p_viewport, ViewportRenderInfo p_info) {
 		return visual_server->viewport_get_render_info(p_viewport, p_info);
@@ -457,6 +474,7 @@ public:
 	FUNC2(instance_set_scenario, RID, RID) // from can be mesh, light, poly, area and portal so far.
 	FUNC2(instance_set_layer_mask, RID, uint32_t)
 	FUNC2(instance_set_transform, RID, const Transform &)
+	FUNC2(instances_set_transforms, const Vector<RID> &, const PoolVector<float> &)
 	FUNC2(instance_attach_object_instance_id, RID, ObjectID)
 	FUNC3(instance_set_blend_shape_weight, RID, int, float)
 	FUNC3(instance_set_surface_material, RID, int, RID)
@@ -588,12 +606,16 @@ public:
 	virtual void finish();
 	virtual void draw(bool p_swap_buffers, double frame_step);
 	virtual void sync();
+	virtual void sync_frame();
 	FUNC0RC(bool, has_changed)
 
 	/* RENDER INFO */
 
 	//this passes directly to avoid stalling
 	virtual int get_render_info(RenderInfo p_info) {
+		if (p_info == INFO_FRAME_SYNC_TIME_USEC) {
+			return frame_sync_usec;
+		}
 		return visual_server->get_render_info(p_info);
 	}
 
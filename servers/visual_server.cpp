@@ -83,6 +83,23 @@ Array VisualServer::_texture_debug_usage_bind() {
 	return arr;
 }
 
+Array VisualServer::_video_memory_debug_usage_bind() {
+
+	List<VideoMemoryInfo> list;
+	video_memory_debug_usage(&list);
+	Array arr;
+	for (const List<VideoMemoryInfo>::Element *E = list.front(); E; E = E->next()) {
+
+		Dictionary dict;
+		dict["rid"] = E->get().rid;
+		dict["type"] = E->get().type;
+		dict["format"] = E->get().format;
+		dict["bytes"] = E->get().bytes;
+		arr.push_back(dict);
+	}
+	return arr;
+}
+
 Array VisualServer::_shader_get_param_list_bind(RID p_shader) const {
 
 	List<PropertyInfo> l;
@@ -124,6 +141,24 @@ Array VisualServer::_instances_cull_convex_bind(const Array &p_convex, RID p_sce
 	return to_array(ids);
 }
 
+void VisualServer::_instances_set_transforms_bind(const Array &p_instances, const PoolVector<float> &p_transforms) {
+
+	Vector<RID> instances;
+	instances.resize(p_instances.size());
+	for (int i = 0; i < p_instances.size(); ++i) {
+		Variant v = p_instances[i];
+		ERR_FAIL_COND(v.get_type() != Variant::_RID);
+		instances.write[i] = v;
+	}
+
+	instances_set_transforms(instances, p_transforms);
+}
+
+void VisualServer::sync_frame() {
+
+	sync();
+}
+
 RID VisualServer::get_test_texture() {
 
 	if (test_texture.is_valid()) {
@@ -343,7 +378,81 @@ RID VisualServer::get_white_texture() {
 #define SMALL_VEC2 Vector2(0.00001, 0.00001)
 #define SMALL_VEC3 Vector3(0.00001, 0.00001, 0.00001)
 
-Error VisualServer::_surface_set_data(Array p_arrays, uint32_t p_format, uint32_t *p_offsets, uint32_t p_stride, PoolVector<uint8_t> &r_vertex_array, int p_vertex_array_len, PoolVector<uint8_t> &r_index_array, int p_index_array_len, AABB &r_aabb, Vector<AABB> &r_bone_aabb) {
+// Octahedral normal encoding: the normal is projected onto an octahedron and
+// unfolded into a square, the tangent is stored as an angle around the normal.
+// Both fit in two 16-bit words (10 bits per normal axis, 11 bits for the angle
+// and one bit for the binormal sign).
+
+static float _octahedral_hemisphere(uint16_t p_x, uint16_t p_y) {
+
+	// Decided on the integer code rather than the decoded z, so the CPU and
+	// the shaders always pick the same basis for normals close to z = 0.
+	return ABS(2 * (p_x & 0x3FF) - 1023) + ABS(2 * (p_y & 0x3FF) - 1023) <= 1023 ? 1.0 : -1.0;
+}
+
+static void _octahedral_tangent_basis(const Vector3 &p_normal, float p_sign, Vector3 &r_b1, Vector3 &r_b2) {
+
+	// Orthonormal basis around the normal (Duff et al. 2017).
+	float s = p_sign;
+	float a = -1.0 / (s + p_normal.z);
+	float b = p_normal.x * p_normal.y * a;
+	r_b1 = Vector3(1.0 + s * p_normal.x * p_normal.x * a, s * b, -s * p_normal.x);
+	r_b2 = Vector3(b, s + p_normal.y * p_normal.y * a, -p_normal.y);
+}
+
+static Vector3 _octahedral_decode_normal(uint16_t p_x, uint16_t p_y) {
+
+	Vector2 f = Vector2((p_x & 0x3FF) / 1023.0, (p_y & 0x3FF) / 1023.0) * 2.0 - Vector2(1, 1);
+	Vector3 n = Vector3(f.x, f.y, 1.0 - Math::abs(f.x) - Math::abs(f.y));
+	float t = MAX(-n.z, 0.0);
+	n.x += n.x >= 0.0 ? -t : t;
+	n.y += n.y >= 0.0 ? -t : t;
+	return n.normalized();
+}
+
+static void _octahedral_encode(const Vector3 &p_normal, const Plane &p_tangent, uint16_t *r_words) {
+
+	Vector3 n = p_normal;
+	float l1 = Math::abs(n.x) + Math::abs(n.y) + Math::abs(n.z);
+	if (l1 == 0.0) {
+		n = Vector3(0, 0, 1);
+		l1 = 1.0;
+	}
+	n /= l1;
+
+	Vector2 f = Vector2(n.x, n.y);
+	if (n.z < 0.0) {
+		f = Vector2((1.0 - Math::abs(n.y)) * (n.x >= 0.0 ? 1.0 : -1.0), (1.0 - Math::abs(n.x)) * (n.y >= 0.0 ? 1.0 : -1.0));
+	}
+
+	uint16_t x = CLAMP(int(Math::round((f.x * 0.5 + 0.5) * 1023.0)), 0, 1023);
+	uint16_t y = CLAMP(int(Math::round((f.y * 0.5 + 0.5) * 1023.0)), 0, 1023);
+
+	// The tangent angle is measured against the basis of the *decoded* normal,
+	// so the shader reconstructs exactly the same frame.
+	Vector3 b1, b2;
+	_octahedral_tangent_basis(_octahedral_decode_normal(x, y), _octahedral_hemisphere(x, y), b1, b2);
+	Vector3 tangent = p_tangent.normal;
+	float angle = Math::atan2(tangent.dot(b2), tangent.dot(b1));
+	uint16_t a = CLAMP(int(Math::round((angle / Math_PI * 0.5 + 0.5) * 2047.0)), 0, 2047);
+	uint16_t sign = p_tangent.d < 0.0 ? 1 : 0;
+
+	r_words[0] = x | ((a & 0x3F) << 10);
+	r_words[1] = y | ((a >> 6) << 10) | (sign << 15);
+}
+
+static void _octahedral_decode(const uint16_t *p_words, Vector3 &r_normal, Plane &r_tangent) {
+
+	r_normal = _octahedral_decode_normal(p_words[0], p_words[1]);
+
+	Vector3 b1, b2;
+	_octahedral_tangent_basis(r_normal, _octahedral_hemisphere(p_words[0], p_words[1]), b1, b2);
+	uint16_t a = (p_words[0] >> 10) | (((p_words[1] >> 10) & 0x1F) << 6);
+	float angle = (a / 2047.0 * 2.0 - 1.0) * Math_PI;
+	r_tangent = Plane(b1 * Math::cos(angle) + b2 * Math::sin(angle), (p_words[1] & 0x8000) ? -1.0 : 1.0);
+}
+
+Error VisualServer::_surface_set_data(Array p_arrays, uint32_t p_format, uint32_t *p_offsets, uint32_t p_stride, PoolVector<uint8_t> &r_vertex_array, int p_vertex_array_len, PoolVector<uint8_t> &r_index_array, int p_index_array_len, AABB &r_aabb, Vector<AABB> &r_bone_aabb, Rect2 &r_uv_range) {
 
 	PoolVector<uint8_t>::Write vw = r_vertex_array.write();
 
@@ -420,7 +529,39 @@ Error VisualServer::_surface_set_data(Array p_arrays, uint32_t p_format, uint32_
 					// setting vertices means regenerating the AABB
 					AABB aabb;
 
-					if (p_format & ARRAY_COMPRESS_VERTEX) {
+					if (p_format & ARRAY_FLAG_USE_QUANTIZED_VERTICES) {
+
+						for (int i = 0; i < p_vertex_array_len; i++) {
+
+							if (i == 0) {
+
+								aabb = AABB(src[i], SMALL_VEC3);
+							} else {
+
+								aabb.expand_to(src[i]);
+							}
+						}
+
+						// positions are stored as unsigned normalized shorts relative to the AABB
+						Vector3 scale;
+						for (int j = 0; j < 3; j++) {
+							scale[j] = aabb.size[j] > 0 ? 65535.0 / aabb.size[j] : 0.0;
+						}
+
+						for (int i = 0; i < p_vertex_array_len; i++) {
+
+							Vector3 q = (src[i] - aabb.position) * scale;
+							uint16_t vector[4] = {
+								(uint16_t)CLAMP(int(Math::round(q.x)), 0, 65535),
+								(uint16_t)CLAMP(int(Math::round(q.y)), 0, 65535),
+								(uint16_t)CLAMP(int(Math::round(q.z)), 0, 65535),
+								0
+							};
+
+							copymem(&vw[p_offsets[ai] + i * p_stride], vector, sizeof(uint16_t) * 4);
+						}
+
+					} else if (p_format & ARRAY_COMPRESS_VERTEX) {
 
 						for (int i = 0; i < p_vertex_array_len; i++) {
 
@@ -470,7 +611,29 @@ Error VisualServer::_surface_set_data(Array p_arrays, uint32_t p_format, uint32_
 
 				// setting vertices means regenerating the AABB
 
-				if (p_format & ARRAY_COMPRESS_NORMAL) {
+				if (p_format & ARRAY_FLAG_USE_OCTAHEDRAL_NORMALS) {
+
+					// the tangent is packed together with the normal
+					PoolVector<real_t> tangents;
+					if (p_format & ARRAY_FORMAT_TANGENT) {
+						ERR_FAIL_COND_V(p_arrays[VS::ARRAY_TANGENT].get_type() != Variant::POOL_REAL_ARRAY, ERR_INVALID_PARAMETER);
+						tangents = p_arrays[VS::ARRAY_TANGENT];
+						ERR_FAIL_COND_V(tangents.size() != p_vertex_array_len * 4, ERR_INVALID_PARAMETER);
+					}
+
+					PoolVector<real_t>::Read tread = tangents.read();
+					const real_t *tsrc = tread.ptr();
+
+					for (int i = 0; i < p_vertex_array_len; i++) {
+
+						Plane tangent = tsrc ? Plane(tsrc[i * 4 + 0], tsrc[i * 4 + 1], tsrc[i * 4 + 2], tsrc[i * 4 + 3]) : Plane(1, 0, 0, 1);
+						uint16_t words[2];
+						_octahedral_encode(src[i], tangent, words);
+
+						copymem(&vw[p_offsets[ai] + i * p_stride], words, 4);
+					}
+
+				} else if (p_format & ARRAY_COMPRESS_NORMAL) {
 
 					for (int i = 0; i < p_vertex_array_len; i++) {
 
@@ -496,6 +659,10 @@ Error VisualServer::_surface_set_data(Array p_arrays, uint32_t p_format, uint32_
 
 			case VS::ARRAY_TANGENT: {
 
+				if (p_format & ARRAY_FLAG_USE_OCTAHEDRAL_NORMALS) {
+					break; // already encoded together with the normal
+				}
+
 				ERR_FAIL_COND_V(p_arrays[ai].get_type() != Variant::POOL_REAL_ARRAY, ERR_INVALID_PARAMETER);
 
 				PoolVector<real_t> array = p_arrays[ai];
@@ -579,7 +746,41 @@ Error VisualServer::_surface_set_data(Array p_arrays, uint32_t p_format, uint32_
 
 				const Vector2 *src = read.ptr();
 
-				if (p_format & ARRAY_COMPRESS_TEX_UV) {
+				if (p_format & ARRAY_FLAG_USE_QUANTIZED_UV) {
+
+					Rect2 range;
+					for (int i = 0; i < p_vertex_array_len; i++) {
+
+						if (i == 0) {
+							range = Rect2(src[i], Vector2());
+						} else {
+							range.expand_to(src[i]);
+						}
+					}
+
+					Vector2 scale;
+					for (int j = 0; j < 2; j++) {
+						if (range.size[j] > 0) {
+							scale[j] = 65535.0 / range.size[j];
+						} else {
+							range.size[j] = 1.0;
+							scale[j] = 0.0;
+						}
+					}
+
+					for (int i = 0; i < p_vertex_array_len; i++) {
+
+						Vector2 q = (src[i] - range.position) * scale;
+						uint16_t uv[2] = {
+							(uint16_t)CLAMP(int(Math::round(q.x)), 0, 65535),
+							(uint16_t)CLAMP(int(Math::round(q.y)), 0, 65535)
+						};
+						copymem(&vw[p_offsets[ai] + i * p_stride], uv, 2 * 2);
+					}
+
+					r_uv_range = range;
+
+				} else if (p_format & ARRAY_COMPRESS_TEX_UV) {
 
 					for (int i = 0; i < p_vertex_array_len; i++) {
 
@@ -829,7 +1030,7 @@ uint32_t VisualServer::mesh_surface_make_offsets_from_format(uint32_t p_format,
 					elem_size = 3;
 				}
 
-				if (p_format & ARRAY_COMPRESS_VERTEX) {
+				if (p_format & (ARRAY_COMPRESS_VERTEX | ARRAY_FLAG_USE_QUANTIZED_VERTICES)) {
 					elem_size *= sizeof(int16_t);
 				} else {
 					elem_size *= sizeof(float);
@@ -842,7 +1043,7 @@ uint32_t VisualServer::mesh_surface_make_offsets_from_format(uint32_t p_format,
 			} break;
 			case VS::ARRAY_NORMAL: {
 
-				if (p_format & ARRAY_COMPRESS_NORMAL) {
+				if (p_format & (ARRAY_COMPRESS_NORMAL | ARRAY_FLAG_USE_OCTAHEDRAL_NORMALS)) {
 					elem_size = sizeof(uint32_t);
 				} else {
 					elem_size = sizeof(float) * 3;
@@ -851,7 +1052,9 @@ uint32_t VisualServer::mesh_surface_make_offsets_from_format(uint32_t p_format,
 			} break;
 
 			case VS::ARRAY_TANGENT: {
-				if (p_format & ARRAY_COMPRESS_TANGENT) {
+				if (p_format & ARRAY_FLAG_USE_OCTAHEDRAL_NORMALS) {
+					elem_size = 0; // packed with the normal
+				} else if (p_format & ARRAY_COMPRESS_TANGENT) {
 					elem_size = sizeof(uint32_t);
 				} else {
 					elem_size = sizeof(float) * 4;
@@ -867,7 +1070,7 @@ uint32_t VisualServer::mesh_surface_make_offsets_from_format(uint32_t p_format,
 				}
 			} break;
 			case VS::ARRAY_TEX_UV: {
-				if (p_format & ARRAY_COMPRESS_TEX_UV) {
+				if (p_format & (ARRAY_COMPRESS_TEX_UV | ARRAY_FLAG_USE_QUANTIZED_UV)) {
 					elem_size = sizeof(uint32_t);
 				} else {
 					elem_size = sizeof(float) * 2;
@@ -991,6 +1194,24 @@ void VisualServer::mesh_add_surface_from_arrays(RID p_mesh, PrimitiveType p_prim
 		}
 	}
 
+	const uint32_t extended_compress = ARRAY_FLAG_USE_QUANTIZED_VERTICES | ARRAY_FLAG_USE_OCTAHEDRAL_NORMALS | ARRAY_FLAG_USE_QUANTIZED_UV;
+	if (p_compress_format & extended_compress) {
+		// Blend shapes are stored in the same layout as the base surface and
+		// would need their own quantization ranges, 2D vertices go through the
+		// canvas shaders, which don't decode these formats.
+		Variant::Type vertex_type = p_arrays[VS::ARRAY_VERTEX].get_type();
+		bool is_2d = vertex_type == Variant::POOL_VECTOR2_ARRAY || (vertex_type != Variant::POOL_VECTOR3_ARRAY && (p_compress_format & ARRAY_FLAG_USE_2D_VERTICES));
+		if (p_blend_shapes.size() || is_2d) {
+			p_compress_format &= ~extended_compress;
+		}
+		if (!(format & VS::ARRAY_FORMAT_NORMAL)) {
+			p_compress_format &= ~ARRAY_FLAG_USE_OCTAHEDRAL_NORMALS;
+		}
+		if (!(format & VS::ARRAY_FORMAT_TEX_UV)) {
+			p_compress_format &= ~ARRAY_FLAG_USE_QUANTIZED_UV;
+		}
+	}
+
 	uint32_t offsets[VS::ARRAY_MAX];
 
 	int total_elem_size = 0;
@@ -1019,7 +1240,7 @@ void VisualServer::mesh_add_surface_from_arrays(RID p_mesh, PrimitiveType p_prim
 					elem_size = (p_compress_format & ARRAY_FLAG_USE_2D_VERTICES) ? 2 : 3;
 				}
 
-				if (p_compress_format & ARRAY_COMPRESS_VERTEX) {
+				if (p_compress_format & (ARRAY_COMPRESS_VERTEX | ARRAY_FLAG_USE_QUANTIZED_VERTICES)) {
 					elem_size *= sizeof(int16_t);
 				} else {
 					elem_size *= sizeof(float);
@@ -1033,7 +1254,7 @@ void VisualServer::mesh_add_surface_from_arrays(RID p_mesh, PrimitiveType p_prim
 			} break;
 			case VS::ARRAY_NORMAL: {
 
-				if (p_compress_format & ARRAY_COMPRESS_NORMAL) {
+				if (p_compress_format & (ARRAY_COMPRESS_NORMAL | ARRAY_FLAG_USE_OCTAHEDRAL_NORMALS)) {
 					elem_size = sizeof(uint32_t);
 				} else {
 					elem_size = sizeof(float) * 3;
@@ -1042,7 +1263,9 @@ void VisualServer::mesh_add_surface_from_arrays(RID p_mesh, PrimitiveType p_prim
 			} break;
 
 			case VS::ARRAY_TANGENT: {
-				if (p_compress_format & ARRAY_COMPRESS_TANGENT) {
+				if (p_compress_format & ARRAY_FLAG_USE_OCTAHEDRAL_NORMALS) {
+					elem_size = 0; // packed with the normal
+				} else if (p_compress_format & ARRAY_COMPRESS_TANGENT) {
 					elem_size = sizeof(uint32_t);
 				} else {
 					elem_size = sizeof(float) * 4;
@@ -1058,7 +1281,7 @@ void VisualServer::mesh_add_surface_from_arrays(RID p_mesh, PrimitiveType p_prim
 				}
 			} break;
 			case VS::ARRAY_TEX_UV: {
-				if (p_compress_format & ARRAY_COMPRESS_TEX_UV) {
+				if (p_compress_format & (ARRAY_COMPRESS_TEX_UV | ARRAY_FLAG_USE_QUANTIZED_UV)) {
 					elem_size = sizeof(uint32_t);
 				} else {
 					elem_size = sizeof(float) * 2;
@@ -1146,8 +1369,9 @@ void VisualServer::mesh_add_surface_from_arrays(RID p_mesh, PrimitiveType p_prim
 
 	AABB aabb;
 	Vector<AABB> bone_aabb;
+	Rect2 uv_range(0, 0, 1, 1);
 
-	Error err = _surface_set_data(p_arrays, format, offsets, total_elem_size, vertex_array, array_len, index_array, index_array_len, aabb, bone_aabb);
+	Error err = _surface_set_data(p_arrays, format, offsets, total_elem_size, vertex_array, array_len, index_array, index_array_len, aabb, bone_aabb, uv_range);
 
 	if (err) {
 		ERR_EXPLAIN("Invalid array format for surface");
@@ -1163,7 +1387,7 @@ void VisualServer::mesh_add_surface_from_arrays(RID p_mesh, PrimitiveType p_prim
 		PoolVector<uint8_t> noindex;
 
 		AABB laabb;
-		Error err2 = _surface_set_data(p_blend_shapes[i], format & ~ARRAY_FORMAT_INDEX, offsets, total_elem_size, vertex_array_shape, array_len, noindex, 0, laabb, bone_aabb);
+		Error err2 = _surface_set_data(p_blend_shapes[i], format & ~ARRAY_FORMAT_INDEX, offsets, total_elem_size, vertex_array_shape, array_len, noindex, 0, laabb, bone_aabb, uv_range);
 		aabb.merge_with(laabb);
 		if (err2) {
 			ERR_EXPLAIN("Invalid blend shape array format for surface");
@@ -1173,10 +1397,10 @@ void VisualServer::mesh_add_surface_from_arrays(RID p_mesh, PrimitiveType p_prim
 		blend_shape_data.push_back(vertex_array_shape);
 	}
 
-	mesh_add_surface(p_mesh, format, p_primitive, vertex_array, array_len, index_array, index_array_len, aabb, blend_shape_data, bone_aabb);
+	mesh_add_surface(p_mesh, format, p_primitive, vertex_array, array_len, index_array, index_array_len, aabb, blend_shape_data, bone_aabb, uv_range);
 }
 
-Array VisualServer::_get_array_from_surface(uint32_t p_format, PoolVector<uint8_t> p_vertex_data, int p_vertex_len, PoolVector<uint8_t> p_index_data, int p_index_len) const {
+Array VisualServer::_get_array_from_surface(uint32_t p_format, PoolVector<uint8_t> p_vertex_data, int p_vertex_len, PoolVector<uint8_t> p_index_data, int p_index_len, const AABB &p_aabb, const Rect2 &p_uv_range) const {
 
 	uint32_t offsets[ARRAY_MAX];
 
@@ -1201,7 +1425,7 @@ Array VisualServer::_get_array_from_surface(uint32_t p_format, PoolVector<uint8_
 					elem_size = 3;
 				}
 
-				if (p_format & ARRAY_COMPRESS_VERTEX) {
+				if (p_format & (ARRAY_COMPRESS_VERTEX | ARRAY_FLAG_USE_QUANTIZED_VERTICES)) {
 					elem_size *= sizeof(int16_t);
 				} else {
 					elem_size *= sizeof(float);
@@ -1214,7 +1438,7 @@ Array VisualServer::_get_array_from_surface(uint32_t p_format, PoolVector<uint8_
 			} break;
 			case VS::ARRAY_NORMAL: {
 
-				if (p_format & ARRAY_COMPRESS_NORMAL) {
+				if (p_format & (ARRAY_COMPRESS_NORMAL | ARRAY_FLAG_USE_OCTAHEDRAL_NORMALS)) {
 					elem_size = sizeof(uint32_t);
 				} else {
 					elem_size = sizeof(float) * 3;
@@ -1223,7 +1447,9 @@ Array VisualServer::_get_array_from_surface(uint32_t p_format, PoolVector<uint8_
 			} break;
 
 			case VS::ARRAY_TANGENT: {
-				if (p_format & ARRAY_COMPRESS_TANGENT) {
+				if (p_format & ARRAY_FLAG_USE_OCTAHEDRAL_NORMALS) {
+					elem_size = 0; // packed with the normal
+				} else if (p_format & ARRAY_COMPRESS_TANGENT) {
 					elem_size = sizeof(uint32_t);
 				} else {
 					elem_size = sizeof(float) * 4;
@@ -1239,7 +1465,7 @@ Array VisualServer::_get_array_from_surface(uint32_t p_format, PoolVector<uint8_
 				}
 			} break;
 			case VS::ARRAY_TEX_UV: {
-				if (p_format & ARRAY_COMPRESS_TEX_UV) {
+				if (p_format & (ARRAY_COMPRESS_TEX_UV | ARRAY_FLAG_USE_QUANTIZED_UV)) {
 					elem_size = sizeof(uint32_t);
 				} else {
 					elem_size = sizeof(float) * 2;
@@ -1344,7 +1570,17 @@ Array VisualServer::_get_array_from_surface(uint32_t p_format, PoolVector<uint8_
 					PoolVector<Vector3> arr_3d;
 					arr_3d.resize(p_vertex_len);
 
-					if (p_format & ARRAY_COMPRESS_VERTEX) {
+					if (p_format & ARRAY_FLAG_USE_QUANTIZED_VERTICES) {
+
+						PoolVector<Vector3>::Write w = arr_3d.write();
+						const Vector3 scale = p_aabb.size / 65535.0;
+
+						for (int j = 0; j < p_vertex_len; j++) {
+
+							const uint16_t *v = (const uint16_t *)&r[j * total_elem_size + offsets[i]];
+							w[j] = p_aabb.position + Vector3(v[0], v[1], v[2]) * scale;
+						}
+					} else if (p_format & ARRAY_COMPRESS_VERTEX) {
 
 						PoolVector<Vector3>::Write w = arr_3d.write();
 
@@ -1372,7 +1608,16 @@ Array VisualServer::_get_array_from_surface(uint32_t p_format, PoolVector<uint8_
 				PoolVector<Vector3> arr;
 				arr.resize(p_vertex_len);
 
-				if (p_format & ARRAY_COMPRESS_NORMAL) {
+				if (p_format & ARRAY_FLAG_USE_OCTAHEDRAL_NORMALS) {
+
+					PoolVector<Vector3>::Write w = arr.write();
+
+					for (int j = 0; j < p_vertex_len; j++) {
+
+						const uint16_t *v = (const uint16_t *)&r[j * total_elem_size + offsets[i]];
+						w[j] = _octahedral_decode_normal(v[0], v[1]);
+					}
+				} else if (p_format & ARRAY_COMPRESS_NORMAL) {
 
 					PoolVector<Vector3>::Write w = arr.write();
 					const float multiplier = 1.f / 127.f;
@@ -1399,7 +1644,21 @@ Array VisualServer::_get_array_from_surface(uint32_t p_format, PoolVector<uint8_
 			case VS::ARRAY_TANGENT: {
 				PoolVector<float> arr;
 				arr.resize(p_vertex_len * 4);
-				if (p_format & ARRAY_COMPRESS_TANGENT) {
+				if (p_format & ARRAY_FLAG_USE_OCTAHEDRAL_NORMALS) {
+					PoolVector<float>::Write w = arr.write();
+
+					for (int j = 0; j < p_vertex_len; j++) {
+
+						const uint16_t *v = (const uint16_t *)&r[j * total_elem_size + offsets[VS::ARRAY_NORMAL]];
+						Vector3 normal;
+						Plane tangent;
+						_octahedral_decode(v, normal, tangent);
+						w[j * 4 + 0] = tangent.normal.x;
+						w[j * 4 + 1] = tangent.normal.y;
+						w[j * 4 + 2] = tangent.normal.z;
+						w[j * 4 + 3] = tangent.d;
+					}
+				} else if (p_format & ARRAY_COMPRESS_TANGENT) {
 					PoolVector<float>::Write w = arr.write();
 
 					for (int j = 0; j < p_vertex_len; j++) {
@@ -1455,7 +1714,17 @@ Array VisualServer::_get_array_from_surface(uint32_t p_format, PoolVector<uint8_
 				PoolVector<Vector2> arr;
 				arr.resize(p_vertex_len);
 
-				if (p_format & ARRAY_COMPRESS_TEX_UV) {
+				if (p_format & ARRAY_FLAG_USE_QUANTIZED_UV) {
+
+					PoolVector<Vector2>::Write w = arr.write();
+					const Vector2 scale = p_uv_range.size / 65535.0;
+
+					for (int j = 0; j < p_vertex_len; j++) {
+
+						const uint16_t *v = (const uint16_t *)&r[j * total_elem_size + offsets[i]];
+						w[j] = p_uv_range.position + Vector2(v[0], v[1]) * scale;
+					}
+				} else if (p_format & ARRAY_COMPRESS_TEX_UV) {
 
 					PoolVector<Vector2>::Write w = arr.write();
 
@@ -1611,7 +1880,7 @@ Array VisualServer::mesh_surface_get_arrays(RID p_mesh, int p_surface) const {
 
 	uint32_t format = mesh_surface_get_format(p_mesh, p_surface);
 
-	return _get_array_from_surface(format, vertex_data, vertex_len, index_data, index_len);
+	return _get_array_from_surface(format, vertex_data, vertex_len, index_data, index_len, mesh_surface_get_aabb(p_mesh, p_surface), mesh_surface_get_uv_range(p_mesh, p_surface));
 }
 
 Array VisualServer::mesh_surface_get_blend_shape_arrays(RID p_mesh, int p_surface) const {
@@ -1628,7 +1897,7 @@ Array VisualServer::mesh_surface_get_blend_shape_arrays(RID p_mesh, int p_surfac
 		Array blend_shape_array;
 		blend_shape_array.resize(blend_shape_data.size());
 		for (int i = 0; i < blend_shape_data.size(); i++) {
-			blend_shape_array.set(i, _get_array_from_surface(format, blend_shape_data[i], vertex_len, index_data, index_len));
+			blend_shape_array.set(i, _get_array_from_surface(format, blend_shape_data[i], vertex_len, index_data, index_len, mesh_surface_get_aabb(p_mesh, p_surface), mesh_surface_get_uv_range(p_mesh, p_surface)));
 		}
 
 		return blend_shape_array;
@@ -1678,6 +1947,7 @@ void VisualServer::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("texture_set_shrink_all_x2_on_set_data", "shrink"), &VisualServer::texture_set_shrink_all_x2_on_set_data);
 
 	ClassDB::bind_method(D_METHOD("texture_debug_usage"), &VisualServer::_texture_debug_usage_bind);
+	ClassDB::bind_method(D_METHOD("video_memory_debug_usage"), &VisualServer::_video_memory_debug_usage_bind);
 	ClassDB::bind_method(D_METHOD("textures_keep_original", "enable"), &VisualServer::textures_keep_original);
 #ifndef _3D_DISABLED
 	ClassDB::bind_method(D_METHOD("sky_create"), &VisualServer::sky_create);
@@ -1689,6 +1959,8 @@ void VisualServer::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("shader_get_param_list", "shader"), &VisualServer::_shader_get_param_list_bind);
 	ClassDB::bind_method(D_METHOD("shader_set_default_texture_param", "shader", "name", "texture"), &VisualServer::shader_set_default_texture_param);
 	ClassDB::bind_method(D_METHOD("shader_get_default_texture_param", "shader", "name"), &VisualServer::shader_get_default_texture_param);
+	ClassDB::bind_method(D_METHOD("shader_get_compiled_variants", "shader"), &VisualServer::shader_get_compiled_variants);
+	ClassDB::bind_method(D_METHOD("shader_precompile_variants", "shader", "variants"), &VisualServer::shader_precompile_variants);
 
 	ClassDB::bind_method(D_METHOD("material_create"), &VisualServer::material_create);
 	ClassDB::bind_method(D_METHOD("material_set_shader", "shader_material", "shader"), &VisualServer::material_set_shader);
@@ -1720,6 +1992,7 @@ void VisualServer::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("mesh_surface_get_format", "mesh", "surface"), &VisualServer::mesh_surface_get_format);
 	ClassDB::bind_method(D_METHOD("mesh_surface_get_primitive_type", "mesh", "surface"), &VisualServer::mesh_surface_get_primitive_type);
 	ClassDB::bind_method(D_METHOD("mesh_surface_get_aabb", "mesh", "surface"), &VisualServer::mesh_surface_get_aabb);
+	ClassDB::bind_method(D_METHOD("mesh_surface_get_uv_range", "mesh", "surface"), &VisualServer::mesh_surface_get_uv_range);
 	ClassDB::bind_method(D_METHOD("mesh_surface_get_skeleton_aabb", "mesh", "surface"), &VisualServer::_mesh_surface_get_skeleton_aabb_bind);
 	ClassDB::bind_method(D_METHOD("mesh_remove_surface", "mesh", "index"), &VisualServer::mesh_remove_surface);
 	ClassDB::bind_method(D_METHOD("mesh_get_surface_count", "mesh"), &VisualServer::mesh_get_surface_count);
@@ -1743,6 +2016,7 @@ void VisualServer::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("multimesh_set_visible_instances", "multimesh", "visible"), &VisualServer::multimesh_set_visible_instances);
 	ClassDB::bind_method(D_METHOD("multimesh_get_visible_instances", "multimesh"), &VisualServer::multimesh_get_visible_instances);
 	ClassDB::bind_method(D_METHOD("multimesh_set_as_bulk_array", "multimesh", "array"), &VisualServer::multimesh_set_as_bulk_array);
+	ClassDB::bind_method(D_METHOD("multimesh_set_as_bulk_array_range", "multimesh", "from_instance", "array"), &VisualServer::multimesh_set_as_bulk_array_range);
 #ifndef _3D_DISABLED
 	ClassDB::bind_method(D_METHOD("immediate_create"), &VisualServer::immediate_create);
 	ClassDB::bind_method(D_METHOD("immediate_begin", "immediate", "primitive", "texture"), &VisualServer::immediate_begin, DEFVAL(RID()));
@@ -1764,6 +2038,7 @@ void VisualServer::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("skeleton_get_bone_count", "skeleton"), &VisualServer::skeleton_get_bone_count);
 	ClassDB::bind_method(D_METHOD("skeleton_bone_set_transform", "skeleton", "bone", "transform"), &VisualServer::skeleton_bone_set_transform);
 	ClassDB::bind_method(D_METHOD("skeleton_bone_get_transform", "skeleton", "bone"), &VisualServer::skeleton_bone_get_transform);
+	ClassDB::bind_method(D_METHOD("skeleton_set_bone_transforms", "skeleton", "transforms"), &VisualServer::skeleton_set_bone_transforms);
 	ClassDB::bind_method(D_METHOD("skeleton_bone_set_transform_2d", "skeleton", "bone", "transform"), &VisualServer::skeleton_bone_set_transform_2d);
 	ClassDB::bind_method(D_METHOD("skeleton_bone_get_transform_2d", "skeleton", "bone"), &VisualServer::skeleton_bone_get_transform_2d);
 
@@ -1896,6 +2171,10 @@ void VisualServer::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("viewport_set_msaa", "viewport", "msaa"), &VisualServer::viewport_set_msaa);
 	ClassDB::bind_method(D_METHOD("viewport_set_hdr", "viewport", "enabled"), &VisualServer::viewport_set_hdr);
 	ClassDB::bind_method(D_METHOD("viewport_set_usage", "viewport", "usage"), &VisualServer::viewport_set_usage);
+	ClassDB::bind_method(D_METHOD("viewport_set_render_scale", "viewport", "scale"), &VisualServer::viewport_set_render_scale);
+	ClassDB::bind_method(D_METHOD("viewport_set_render_scale_sharpness", "viewport", "sharpness"), &VisualServer::viewport_set_render_scale_sharpness);
+	ClassDB::bind_method(D_METHOD("viewport_set_dynamic_render_scale", "viewport", "enabled", "target_frame_msec", "min_scale"), &VisualServer::viewport_set_dynamic_render_scale);
+	ClassDB::bind_method(D_METHOD("viewport_get_current_render_scale", "viewport"), &VisualServer::viewport_get_current_render_scale);
 	ClassDB::bind_method(D_METHOD("viewport_get_render_info", "viewport", "info"), &VisualServer::viewport_get_render_info);
 	ClassDB::bind_method(D_METHOD("viewport_set_debug_draw", "viewport", "draw"), &VisualServer::viewport_set_debug_draw);
 
@@ -1935,6 +2214,7 @@ void VisualServer::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("instance_set_scenario", "instance", "scenario"), &VisualServer::instance_set_scenario);
 	ClassDB::bind_method(D_METHOD("instance_set_layer_mask", "instance", "mask"), &VisualServer::instance_set_layer_mask);
 	ClassDB::bind_method(D_METHOD("instance_set_transform", "instance", "transform"), &VisualServer::instance_set_transform);
+	ClassDB::bind_method(D_METHOD("instances_set_transforms", "instances", "transforms"), &VisualServer::_instances_set_transforms_bind);
 	ClassDB::bind_method(D_METHOD("instance_attach_object_instance_id", "instance", "id"), &VisualServer::instance_attach_object_instance_id);
 	ClassDB::bind_method(D_METHOD("instance_set_blend_shape_weight", "instance", "shape", "weight"), &VisualServer::instance_set_blend_shape_weight);
 	ClassDB::bind_method(D_METHOD("instance_set_surface_material", "instance", "surface", "material"), &VisualServer::instance_set_surface_material);
@@ -2117,6 +2397,9 @@ void VisualServer::_bind_methods() {
 	BIND_ENUM_CONSTANT(ARRAY_COMPRESS_INDEX);
 	BIND_ENUM_CONSTANT(ARRAY_FLAG_USE_2D_VERTICES);
 	BIND_ENUM_CONSTANT(ARRAY_FLAG_USE_16_BIT_BONES);
+	BIND_ENUM_CONSTANT(ARRAY_FLAG_USE_QUANTIZED_VERTICES);
+	BIND_ENUM_CONSTANT(ARRAY_FLAG_USE_OCTAHEDRAL_NORMALS);
+	BIND_ENUM_CONSTANT(ARRAY_FLAG_USE_QUANTIZED_UV);
 	BIND_ENUM_CONSTANT(ARRAY_COMPRESS_DEFAULT);
 
 	BIND_ENUM_CONSTANT(PRIMITIVE_POINTS);
@@ -2214,6 +2497,7 @@ void VisualServer::_bind_methods() {
 
 	BIND_ENUM_CONSTANT(INSTANCE_FLAG_USE_BAKED_LIGHT);
 	BIND_ENUM_CONSTANT(INSTANCE_FLAG_DRAW_NEXT_FRAME_IF_VISIBLE);
+	BIND_ENUM_CONSTANT(INSTANCE_FLAG_OCCLUDER);
 	BIND_ENUM_CONSTANT(INSTANCE_FLAG_MAX);
 
 	BIND_ENUM_CONSTANT(SHADOW_CASTING_SETTING_OFF);
@@ -2251,6 +2535,22 @@ void VisualServer::_bind_methods() {
 	BIND_ENUM_CONSTANT(INFO_VIDEO_MEM_USED);
 	BIND_ENUM_CONSTANT(INFO_TEXTURE_MEM_USED);
 	BIND_ENUM_CONSTANT(INFO_VERTEX_MEM_USED);
+	BIND_ENUM_CONSTANT(INFO_2D_BATCHES_IN_FRAME);
+	BIND_ENUM_CONSTANT(INFO_FRAME_SYNC_TIME_USEC);
+	BIND_ENUM_CONSTANT(INFO_REDUNDANT_STATE_CHANGES_IN_FRAME);
+	BIND_ENUM_CONSTANT(INFO_GPU_SHADOWS_TIME_USEC);
+	BIND_ENUM_CONSTANT(INFO_GPU_OPAQUE_TIME_USEC);
+	BIND_ENUM_CONSTANT(INFO_GPU_ALPHA_TIME_USEC);
+	BIND_ENUM_CONSTANT(INFO_GPU_SSAO_TIME_USEC);
+	BIND_ENUM_CONSTANT(INFO_GPU_SSR_TIME_USEC);
+	BIND_ENUM_CONSTANT(INFO_GPU_POST_PROCESS_TIME_USEC);
+	BIND_ENUM_CONSTANT(INFO_GPU_GLOW_TIME_USEC);
+	BIND_ENUM_CONSTANT(INFO_GPU_CANVAS_TIME_USEC);
+	BIND_ENUM_CONSTANT(INFO_RENDER_TARGET_MEM_USED);
+	BIND_ENUM_CONSTANT(INFO_SHADOW_MEM_USED);
+	BIND_ENUM_CONSTANT(INFO_REFLECTION_MEM_USED);
+	BIND_ENUM_CONSTANT(INFO_GI_PROBE_MEM_USED);
+	BIND_ENUM_CONSTANT(INFO_MULTIMESH_MEM_USED);
 
 	BIND_ENUM_CONSTANT(FEATURE_SHADERS);
 	BIND_ENUM_CONSTANT(FEATURE_MULTITHREADED);
@@ -2367,6 +2667,7 @@ VisualServer::VisualServer() {
 
 	//ERR_FAIL_COND(singleton);
 	singleton = this;
+	null_mode = false;
 
 	GLOBAL_DEF_RST("rendering/vram_compression/import_bptc", false);
 	GLOBAL_DEF_RST("rendering/vram_compression/import_s3tc", true);
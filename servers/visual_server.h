@@ -49,10 +49,11 @@ class VisualServer : public Object {
 	static VisualServer *singleton;
 
 	int mm_policy;
+	bool null_mode;
 
 	void _camera_set_orthogonal(RID p_camera, float p_size, float p_z_near, float p_z_far);
 	void _canvas_item_add_style_box(RID p_item, const Rect2 &p_rect, const Rect2 &p_source, RID p_texture, const Vector<float> &p_margins, const Color &p_modulate = Color(1, 1, 1));
-	Array _get_array_from_surface(uint32_t p_format, PoolVector<uint8_t> p_vertex_data, int p_vertex_len, PoolVector<uint8_t> p_index_data, int p_index_len) const;
+	Array _get_array_from_surface(uint32_t p_format, PoolVector<uint8_t> p_vertex_data, int p_vertex_len, PoolVector<uint8_t> p_index_data, int p_index_len, const AABB &p_aabb, const Rect2 &p_uv_range) const;
 
 protected:
 	RID _make_test_cube();
@@ -61,7 +62,7 @@ protected:
 	RID white_texture;
 	RID test_material;
 
-	Error _surface_set_data(Array p_arrays, uint32_t p_format, uint32_t *p_offsets, uint32_t p_stride, PoolVector<uint8_t> &r_vertex_array, int p_vertex_array_len, PoolVector<uint8_t> &r_index_array, int p_index_array_len, AABB &r_aabb, Vector<AABB> &r_bone_aabb);
+	Error _surface_set_data(Array p_arrays, uint32_t p_format, uint32_t *p_offsets, uint32_t p_stride, PoolVector<uint8_t> &r_vertex_array, int p_vertex_array_len, PoolVector<uint8_t> &r_index_array, int p_index_array_len, AABB &r_aabb, Vector<AABB> &r_bone_aabb, Rect2 &r_uv_range);
 
 	static VisualServer *(*create_func)();
 	static void _bind_methods();
@@ -165,6 +166,18 @@ public:
 	virtual void texture_debug_usage(List<TextureInfo> *r_info) = 0;
 	Array _texture_debug_usage_bind();
 
+	struct VideoMemoryInfo {
+		RID rid;
+		String type;
+		String format;
+		int bytes;
+	};
+
+	// Video memory held by meshes, render targets, atlases and other GPU
+	// buffers; textures are reported by texture_debug_usage().
+	virtual void video_memory_debug_usage(List<VideoMemoryInfo> *r_info) = 0;
+	Array _video_memory_debug_usage_bind();
+
 	virtual void textures_keep_original(bool p_enable) = 0;
 
 	virtual void texture_set_proxy(RID p_proxy, RID p_base) = 0;
@@ -195,6 +208,9 @@ public:
 	virtual void shader_set_default_texture_param(RID p_shader, const StringName &p_name, RID p_texture) = 0;
 	virtual RID shader_get_default_texture_param(RID p_shader, const StringName &p_name) const = 0;
 
+	virtual PoolIntArray shader_get_compiled_variants(RID p_shader) const = 0;
+	virtual void shader_precompile_variants(RID p_shader, const PoolIntArray &p_variants) = 0;
+
 	/* COMMON MATERIAL API */
 
 	enum {
@@ -258,6 +274,9 @@ public:
 		ARRAY_FLAG_USE_2D_VERTICES = ARRAY_COMPRESS_INDEX << 1,
 		ARRAY_FLAG_USE_16_BIT_BONES = ARRAY_COMPRESS_INDEX << 2,
 		ARRAY_FLAG_USE_DYNAMIC_UPDATE = ARRAY_COMPRESS_INDEX << 3,
+		ARRAY_FLAG_USE_QUANTIZED_VERTICES = ARRAY_COMPRESS_INDEX << 4,
+		ARRAY_FLAG_USE_OCTAHEDRAL_NORMALS = ARRAY_COMPRESS_INDEX << 5,
+		ARRAY_FLAG_USE_QUANTIZED_UV = ARRAY_COMPRESS_INDEX << 6,
 
 		ARRAY_COMPRESS_DEFAULT = ARRAY_COMPRESS_NORMAL | ARRAY_COMPRESS_TANGENT | ARRAY_COMPRESS_COLOR | ARRAY_COMPRESS_TEX_UV | ARRAY_COMPRESS_TEX_UV2 | ARRAY_COMPRESS_WEIGHTS
 
@@ -281,7 +300,7 @@ public:
 	/// Returns stride
 	virtual uint32_t mesh_surface_make_offsets_from_format(uint32_t p_format, int p_vertex_len, int p_index_len, uint32_t *r_offsets) const;
 	virtual void mesh_add_surface_from_arrays(RID p_mesh, PrimitiveType p_primitive, const Array &p_arrays, const Array &p_blend_shapes = Array(), uint32_t p_compress_format = ARRAY_COMPRESS_DEFAULT);
-	virtual void mesh_add_surface(RID p_mesh, uint32_t p_format, PrimitiveType p_primitive, const PoolVector<uint8_t> &p_array, int p_vertex_count, const PoolVector<uint8_t> &p_index_array, int p_index_count, const AABB &p_aabb, const Vector<PoolVector<uint8_t> > &p_blend_shapes = Vector<PoolVector<uint8_t> >(), const Vector<AABB> &p_bone_aabbs = Vector<AABB>()) = 0;
+	virtual void mesh_add_surface(RID p_mesh, uint32_t p_format, PrimitiveType p_primitive, const PoolVector<uint8_t> &p_array, int p_vertex_count, const PoolVector<uint8_t> &p_index_array, int p_index_count, const AABB &p_aabb, const Vector<PoolVector<uint8_t> > &p_blend_shapes = Vector<PoolVector<uint8_t> >(), const Vector<AABB> &p_bone_aabbs = Vector<AABB>(), const Rect2 &p_uv_range = Rect2(0, 0, 1, 1)) = 0;
 
 	virtual void mesh_set_blend_shape_count(RID p_mesh, int p_amount) = 0;
 	virtual int mesh_get_blend_shape_count(RID p_mesh) const = 0;
@@ -295,6 +314,7 @@ public:
 	virtual BlendShapeMode mesh_get_blend_shape_mode(RID p_mesh) const = 0;
 
 	virtual void mesh_surface_update_region(RID p_mesh, int p_surface, int p_offset, const PoolVector<uint8_t> &p_data) = 0;
+	virtual void mesh_surface_set_lods(RID p_mesh, int p_surface, const Vector<PoolVector<uint8_t> > &p_lod_indices, const Vector<float> &p_lod_errors) = 0;
 
 	virtual void mesh_surface_set_material(RID p_mesh, int p_surface, RID p_material) = 0;
 	virtual RID mesh_surface_get_material(RID p_mesh, int p_surface) const = 0;
@@ -312,6 +332,7 @@ public:
 	virtual PrimitiveType mesh_surface_get_primitive_type(RID p_mesh, int p_surface) const = 0;
 
 	virtual AABB mesh_surface_get_aabb(RID p_mesh, int p_surface) const = 0;
+	virtual Rect2 mesh_surface_get_uv_range(RID p_mesh, int p_surface) const = 0;
 	virtual Vector<PoolVector<uint8_t> > mesh_surface_get_blend_shapes(RID p_mesh, int p_surface) const = 0;
 	virtual Vector<AABB> mesh_surface_get_skeleton_aabb(RID p_mesh, int p_surface) const = 0;
 	Array _mesh_surface_get_skeleton_aabb_bind(RID p_mesh, int p_surface) const;
@@ -363,6 +384,7 @@ public:
 	virtual Color multimesh_instance_get_custom_data(RID p_multimesh, int p_index) const = 0;
 
 	virtual void multimesh_set_as_bulk_array(RID p_multimesh, const PoolVector<float> &p_array) = 0;
+	virtual void multimesh_set_as_bulk_array_range(RID p_multimesh, int p_from_instance, const PoolVector<float> &p_array) = 0;
 
 	virtual void multimesh_set_visible_instances(RID p_multimesh, int p_visible) = 0;
 	virtual int multimesh_get_visible_instances(RID p_multimesh) const = 0;
@@ -390,6 +412,7 @@ public:
 	virtual int skeleton_get_bone_count(RID p_skeleton) const = 0;
 	virtual void skeleton_bone_set_transform(RID p_skeleton, int p_bone, const Transform &p_transform) = 0;
 	virtual Transform skeleton_bone_get_transform(RID p_skeleton, int p_bone) const = 0;
+	virtual void skeleton_set_bone_transforms(RID p_skeleton, const PoolVector<float> &p_transforms) = 0;
 	virtual void skeleton_bone_set_transform_2d(RID p_skeleton, int p_bone, const Transform2D &p_transform) = 0;
 	virtual Transform2D skeleton_bone_get_transform_2d(RID p_skeleton, int p_bone) const = 0;
 	virtual void skeleton_set_base_transform_2d(RID p_skeleton, const Transform2D &p_base_transform) = 0;
@@ -670,6 +693,11 @@ public:
 	virtual void viewport_set_hdr(RID p_viewport, bool p_enabled) = 0;
 	virtual void viewport_set_usage(RID p_viewport, ViewportUsage p_usage) = 0;
 
+	virtual void viewport_set_render_scale(RID p_viewport, float p_scale) = 0;
+	virtual void viewport_set_render_scale_sharpness(RID p_viewport, float p_sharpness) = 0;
+	virtual void viewport_set_dynamic_render_scale(RID p_viewport, bool p_enabled, float p_target_frame_msec, float p_min_scale) = 0;
+	virtual float viewport_get_current_render_scale(RID p_viewport) const = 0;
+
 	enum ViewportRenderInfo {
 
 		VIEWPORT_RENDER_INFO_OBJECTS_IN_FRAME,
@@ -812,6 +840,7 @@ public:
 	virtual void instance_set_scenario(RID p_instance, RID p_scenario) = 0; // from can be mesh, light, poly, area and portal so far.
 	virtual void instance_set_layer_mask(RID p_instance, uint32_t p_mask) = 0;
 	virtual void instance_set_transform(RID p_instance, const Transform &p_transform) = 0;
+	virtual void instances_set_transforms(const Vector<RID> &p_instances, const PoolVector<float> &p_transforms) = 0; // 12 floats per instance, same layout as multimesh bulk arrays
 	virtual void instance_attach_object_instance_id(RID p_instance, ObjectID p_ID) = 0;
 	virtual void instance_set_blend_shape_weight(RID p_instance, int p_shape, float p_weight) = 0;
 	virtual void instance_set_surface_material(RID p_instance, int p_surface, RID p_material) = 0;
@@ -834,10 +863,12 @@ public:
 	Array _instances_cull_aabb_bind(const AABB &p_aabb, RID p_scenario = RID()) const;
 	Array _instances_cull_ray_bind(const Vector3 &p_from, const Vector3 &p_to, RID p_scenario = RID()) const;
 	Array _instances_cull_convex_bind(const Array &p_convex, RID p_scenario = RID()) const;
+	void _instances_set_transforms_bind(const Array &p_instances, const PoolVector<float> &p_transforms);
 
 	enum InstanceFlags {
 		INSTANCE_FLAG_USE_BAKED_LIGHT,
 		INSTANCE_FLAG_DRAW_NEXT_FRAME_IF_VISIBLE,
+		INSTANCE_FLAG_OCCLUDER,
 		INSTANCE_FLAG_MAX
 	};
 
@@ -987,6 +1018,7 @@ public:
 
 	virtual void draw(bool p_swap_buffers = true, double frame_step = 0.0) = 0;
 	virtual void sync() = 0;
+	virtual void sync_frame();
 	virtual bool has_changed() const = 0;
 	virtual void init() = 0;
 	virtual void finish() = 0;
@@ -1005,6 +1037,22 @@ public:
 		INFO_VIDEO_MEM_USED,
 		INFO_TEXTURE_MEM_USED,
 		INFO_VERTEX_MEM_USED,
+		INFO_2D_BATCHES_IN_FRAME,
+		INFO_FRAME_SYNC_TIME_USEC,
+		INFO_REDUNDANT_STATE_CHANGES_IN_FRAME,
+		INFO_GPU_SHADOWS_TIME_USEC,
+		INFO_GPU_OPAQUE_TIME_USEC,
+		INFO_GPU_ALPHA_TIME_USEC,
+		INFO_GPU_SSAO_TIME_USEC,
+		INFO_GPU_SSR_TIME_USEC,
+		INFO_GPU_POST_PROCESS_TIME_USEC,
+		INFO_GPU_GLOW_TIME_USEC,
+		INFO_GPU_CANVAS_TIME_USEC,
+		INFO_RENDER_TARGET_MEM_USED,
+		INFO_SHADOW_MEM_USED,
+		INFO_REFLECTION_MEM_USED,
+		INFO_GI_PROBE_MEM_USED,
+		INFO_MULTIMESH_MEM_USED,
 	};
 
 	virtual int get_render_info(RenderInfo p_info) = 0;
@@ -1041,6 +1089,10 @@ public:
 
 	virtual bool is_low_end() const = 0;
 
+	// Headless servers: scene nodes and resource loaders skip all render-only work.
+	void set_null_mode(bool p_enable) { null_mode = p_enable; }
+	_FORCE_INLINE_ bool is_null_mode() const { return null_mode; }
+
 	VisualServer();
 	virtual ~VisualServer();
 };